@@ -0,0 +1,40 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bench_main.cpp
+ * @brief The entry point of `aevum_bench`.
+ * @details Results are written as JSON unless another `--benchmark_format` is given, so that
+ * runs can be stored and compared over time (e.g. with Google Benchmark's `compare.py`). Logging
+ * is limited to warnings so that it does not distort the measurements.
+ */
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+#include "aevum/util/log/logger.hpp"
+#include "ycsb.hpp"
+
+int main(int argc, char **argv) {
+    aevum::util::log::Logger::set_level(aevum::util::log::LogLevel::WARN);
+
+    std::vector<char *> args(argv, argv + argc);
+    bool has_format = false;
+    for (const char *arg : args) {
+        if (std::strncmp(arg, "--benchmark_format", 18) == 0) has_format = true;
+    }
+    static char json_format[] = "--benchmark_format=json";
+    if (!has_format) args.push_back(json_format);
+    int count = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    aevum::bench::register_ycsb_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    aevum::bench::shutdown_ycsb_benchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
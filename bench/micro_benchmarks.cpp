@@ -0,0 +1,354 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file micro_benchmarks.cpp
+ * @brief Micro-benchmarks of the kernels on the request path: JSON conversion, the primary and
+ * secondary indexes, `_id` generation, hashing, and the concurrency primitives.
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/field_dictionary.hpp"
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/db/index/secondary_indexer.hpp"
+#include "aevum/util/concurrency/bounded_queue.hpp"
+#include "aevum/util/concurrency/concurrent_queue.hpp"
+#include "aevum/util/concurrency/rw_spinlock.hpp"
+#include "aevum/util/concurrency/spinlock.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
+#include "aevum/util/hash/djb2.hpp"
+#include "aevum/util/hash/fnv1a.hpp"
+#include "aevum/util/memory/object_pool.hpp"
+#include "aevum/util/uuid/v4.hpp"
+
+namespace aevum::bench {
+
+namespace {
+
+/// A document of the size and shape of a typical application record.
+constexpr std::string_view MICRO_SAMPLE_JSON =
+    R"({"_id":"2f1c6d0e-8b4a-4c3e-9f6d-5a7b8c9d0e1f","name":"Ada Lovelace","age":36,)"
+    R"("active":true,"score":98.5,"tags":["math","poetry","engines"],)"
+    R"("address":{"street":"12 St James's Square","city":"London","zip":"SW1Y 4JH"},)"
+    R"("bio":"Wrote the first algorithm intended to be carried out by a machine."})";
+
+/**
+ * @brief Parses a JSON document, aborting the benchmark if it is invalid.
+ * @param json The JSON.
+ * @return The document.
+ */
+aevum::bson::doc::Document micro_parse(std::string_view json) {
+    aevum::bson::doc::Document doc;
+    if (!aevum::bson::json::parse(json, doc).ok()) std::abort();
+    return doc;
+}
+
+/**
+ * @brief Builds documents with an `_id` of `doc<i>` and an `age` field.
+ * @param count The number of documents.
+ * @return The documents.
+ */
+std::vector<aevum::bson::doc::Document> micro_documents(size_t count) {
+    std::vector<aevum::bson::doc::Document> docs;
+    docs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        docs.push_back(micro_parse(R"({"_id":"doc)" + std::to_string(i) + R"(","age":)" +
+                                   std::to_string(i % 100) + "}"));
+    }
+    return docs;
+}
+
+void BM_JsonParse(benchmark::State &state) {
+    for (auto _ : state) {
+        aevum::bson::doc::Document doc;
+        benchmark::DoNotOptimize(aevum::bson::json::parse(MICRO_SAMPLE_JSON, doc));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * MICRO_SAMPLE_JSON.size()));
+}
+BENCHMARK(BM_JsonParse);
+
+void BM_JsonToString(benchmark::State &state) {
+    const aevum::bson::doc::Document doc = micro_parse(MICRO_SAMPLE_JSON);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aevum::bson::json::to_string(doc));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * MICRO_SAMPLE_JSON.size()));
+}
+BENCHMARK(BM_JsonToString);
+
+void BM_DocumentCopy(benchmark::State &state) {
+    const aevum::bson::doc::Document doc = micro_parse(MICRO_SAMPLE_JSON);
+    for (auto _ : state) {
+        aevum::bson::doc::Document copy(doc);
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+BENCHMARK(BM_DocumentCopy);
+
+void BM_FieldDictionaryEncode(benchmark::State &state) {
+    const aevum::bson::doc::Document doc = micro_parse(MICRO_SAMPLE_JSON);
+    aevum::bson::doc::FieldDictionary dict;
+    std::string encoded;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dict.encode(doc, encoded));
+    }
+    state.counters["encoded_bytes"] = static_cast<double>(encoded.size());
+    state.counters["bson_bytes"] = static_cast<double>(doc.length());
+}
+BENCHMARK(BM_FieldDictionaryEncode);
+
+void BM_FieldDictionaryDecode(benchmark::State &state) {
+    const aevum::bson::doc::Document doc = micro_parse(MICRO_SAMPLE_JSON);
+    aevum::bson::doc::FieldDictionary dict;
+    std::string encoded;
+    if (!dict.encode(doc, encoded)) std::abort();
+    const auto *data = reinterpret_cast<const uint8_t *>(encoded.data());
+    for (auto _ : state) {
+        aevum::bson::doc::Document decoded(dict.decode(data, encoded.size()));
+        benchmark::DoNotOptimize(decoded.get());
+    }
+}
+BENCHMARK(BM_FieldDictionaryDecode);
+
+/**
+ * @brief Adds a document to and removes it from a secondary index holding `state.range(0)`
+ * documents; the argument `state.range(1)` selects a hash (0) or ordered (1) index.
+ */
+void BM_SecondaryIndexUpdate(benchmark::State &state) {
+    const auto type = state.range(1) == 0 ? aevum::db::index::IndexType::HASH
+                                          : aevum::db::index::IndexType::ORDERED;
+    aevum::db::index::SecondaryIndexer indexer;
+    indexer.add_indexed_field("bench", "age", type);
+    const std::vector<aevum::bson::doc::Document> docs =
+        micro_documents(static_cast<size_t>(state.range(0)) + 1);
+    for (size_t i = 1; i < docs.size(); ++i) indexer.update_custom_index("bench", docs[i], true);
+
+    for (auto _ : state) {
+        indexer.update_custom_index("bench", docs[0], true);
+        indexer.update_custom_index("bench", docs[0], false);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SecondaryIndexUpdate)
+    ->ArgNames({"documents", "ordered"})
+    ->ArgsProduct({{1000, 100000}, {0, 1}});
+
+/**
+ * @brief Looks documents up by `_id` in a primary index holding `state.range(0)` documents.
+ */
+void BM_PrimaryIndexGet(benchmark::State &state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    aevum::db::index::PrimaryIndexer indexer;
+    const std::vector<aevum::bson::doc::Document> docs = micro_documents(count);
+    std::vector<std::string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back("doc" + std::to_string(i));
+        indexer.add_document_to_primary_index("bench", ids.back(), docs[i]);
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        // A stride coprime with the count visits every document in an order the cache cannot
+        // predict.
+        next = (next + 7919) % count;
+        benchmark::DoNotOptimize(indexer.get_document_by_id("bench", ids[next]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrimaryIndexGet)->ArgName("documents")->Arg(1000)->Arg(100000)->Arg(1000000);
+
+/**
+ * @brief Visits every document of a primary index holding `state.range(0)` documents in chunks
+ * of borrowed pointers.
+ */
+void BM_PrimaryIndexForEachChunk(benchmark::State &state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    aevum::db::index::PrimaryIndexer indexer;
+    const std::vector<aevum::bson::doc::Document> docs = micro_documents(count);
+    for (size_t i = 0; i < count; ++i) {
+        indexer.add_document_to_primary_index("bench", "doc" + std::to_string(i), docs[i]);
+    }
+
+    for (auto _ : state) {
+        size_t visited = 0;
+        indexer.for_each_chunk("bench", 1024, [&](const auto &chunk) {
+            visited += chunk.size();
+            return true;
+        });
+        benchmark::DoNotOptimize(visited);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_PrimaryIndexForEachChunk)->ArgName("documents")->Arg(1000)->Arg(100000);
+
+void BM_GenerateV4(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aevum::util::uuid::generate_v4());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenerateV4);
+
+void BM_Djb2(benchmark::State &state) {
+    const std::string data(static_cast<size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aevum::util::hash::djb2(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Djb2)->ArgName("bytes")->RangeMultiplier(8)->Range(8, 4096);
+
+void BM_Fnv1a(benchmark::State &state) {
+    const std::string data(static_cast<size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aevum::util::hash::fnv1a_64(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Fnv1a)->ArgName("bytes")->RangeMultiplier(8)->Range(8, 4096);
+
+/**
+ * @brief Measures the round trip of one empty task through a `ThreadPool`: enqueue, run on a
+ * worker, and wait for its future.
+ */
+void BM_ThreadPoolRoundTrip(benchmark::State &state) {
+    aevum::util::concurrency::ThreadPool pool("Bench", static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        pool.enqueue([] {}).get();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreadPoolRoundTrip)->ArgName("workers")->Arg(1)->Arg(4)->UseRealTime();
+
+/**
+ * @brief Measures the throughput of a `ThreadPool` on batches of 1024 empty tasks, enqueued
+ * before any is waited for.
+ */
+void BM_ThreadPoolEnqueueBatch(benchmark::State &state) {
+    constexpr size_t BATCH = 1024;
+    aevum::util::concurrency::ThreadPool pool("Bench", static_cast<size_t>(state.range(0)));
+    std::vector<std::future<void>> futures;
+    futures.reserve(BATCH);
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH; ++i) futures.push_back(pool.enqueue([] {}));
+        for (auto &future : futures) future.get();
+        futures.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH));
+}
+BENCHMARK(BM_ThreadPoolEnqueueBatch)->ArgName("workers")->Arg(1)->Arg(4)->UseRealTime();
+
+/**
+ * @brief Measures `ThreadPool::parallel_for` summing `state.range(0)` integers in chunks chosen by
+ * the pool, which shows the fork-join overhead at small sizes and the scaling at large ones.
+ */
+void BM_ThreadPoolParallelFor(benchmark::State &state) {
+    aevum::util::concurrency::ThreadPool pool("Bench", 4);
+    const std::vector<int64_t> values(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        std::atomic<int64_t> sum{0};
+        pool.parallel_for(0, values.size(), 0, [&](size_t begin, size_t end) {
+            int64_t local = 0;
+            for (size_t i = begin; i < end; ++i) local += values[i];
+            sum.fetch_add(local, std::memory_order_relaxed);
+        });
+        benchmark::DoNotOptimize(sum.load());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ThreadPoolParallelFor)->ArgName("items")->Arg(1024)->Arg(1 << 20)->UseRealTime();
+
+/**
+ * @brief Pushes to and pops from a `ConcurrentQueue` shared by all benchmark threads.
+ */
+void BM_ConcurrentQueuePushPop(benchmark::State &state) {
+    static aevum::util::concurrency::ConcurrentQueue<int> queue;
+    for (auto _ : state) {
+        queue.push(1);
+        benchmark::DoNotOptimize(queue.try_pop());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ConcurrentQueuePushPop)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * @brief Pushes to and pops from a `BoundedQueue` shared by all benchmark threads.
+ */
+void BM_BoundedQueuePushPop(benchmark::State &state) {
+    static aevum::util::concurrency::BoundedQueue<int> queue(1024);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queue.try_push(1));
+        benchmark::DoNotOptimize(queue.try_pop());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_BoundedQueuePushPop)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * @brief Takes and releases a lock shared by all benchmark threads around a tiny critical section.
+ * @tparam Lock The lock type.
+ */
+template <typename Lock>
+void BM_LockExclusive(benchmark::State &state) {
+    static Lock lock;
+    static uint64_t counter = 0;
+    for (auto _ : state) {
+        std::lock_guard<Lock> guard(lock);
+        benchmark::DoNotOptimize(++counter);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockExclusive, std::mutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockExclusive, aevum::util::concurrency::Spinlock)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/**
+ * @brief Takes and releases a reader lock shared by all benchmark threads around a tiny read.
+ * @tparam Lock The reader-writer lock type.
+ */
+template <typename Lock>
+void BM_LockShared(benchmark::State &state) {
+    static Lock lock;
+    static uint64_t value = 1;
+    for (auto _ : state) {
+        std::shared_lock<Lock> guard(lock);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockShared, std::shared_mutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockShared, aevum::util::concurrency::RWSpinlock)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/**
+ * @brief Acquires and releases an object of an `ObjectPool` shared by all benchmark threads.
+ */
+void BM_ObjectPoolAcquireRelease(benchmark::State &state) {
+    static aevum::util::memory::ObjectPool<std::string> pool;
+    for (auto _ : state) {
+        std::string *object = pool.acquire();
+        benchmark::DoNotOptimize(object);
+        pool.release(object);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectPoolAcquireRelease)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
+
+}  // namespace aevum::bench
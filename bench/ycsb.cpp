@@ -0,0 +1,358 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file ycsb.cpp
+ * @brief Implements the YCSB-style macro-benchmarks.
+ * @details Every collection size gets a table `usertable_<records>` of YCSB records: an `_id` of
+ * `user<n>`, a sequence number `seq` equal to `n` under an ordered index, and ten 100-byte string
+ * fields. Tables are loaded on first use and shared by the workloads, which run in the order
+ * they are registered, so the inserts of workloads D and E grow the table for those after them,
+ * as in YCSB's own recommended sequence.
+ */
+#include "ycsb.hpp"
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aevum/bson/builder.hpp"
+#include "aevum/db/core/core.hpp"
+#include "aevum/util/hash/fnv1a.hpp"
+#include "aevum/util/metrics/latency_histogram.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+
+namespace aevum::bench {
+
+namespace {
+
+/// The string fields of a YCSB record.
+constexpr int YCSB_FIELD_COUNT = 10;
+/// The length of each string field.
+constexpr size_t YCSB_FIELD_LENGTH = 100;
+/// The documents inserted per `insert_many` while a table is loaded.
+constexpr size_t YCSB_LOAD_BATCH = 1000;
+/// The longest range read by a scan of workload E; lengths are uniform in `[1, max]`.
+constexpr int64_t YCSB_MAX_SCAN_LENGTH = 100;
+
+/**
+ * @struct YcsbWorkload
+ * @brief The operation mix of a YCSB core workload; the proportions add up to one.
+ */
+struct YcsbWorkload {
+    /// The workload's letter.
+    const char *name;
+    /// Reads of one record by `_id`.
+    double read;
+    /// Updates of one field of one record.
+    double update;
+    /// Inserts of a new record.
+    double insert;
+    /// Reads of a short range of records in `seq` order.
+    double scan;
+    /// Reads of one record followed by an update of it.
+    double read_modify_write;
+    /// `true` if the most recently inserted records are the most popular, rather than a fixed
+    /// scrambled set.
+    bool latest;
+};
+
+/// The core workloads of YCSB.
+constexpr YcsbWorkload YCSB_WORKLOADS[] = {
+    {"A", 0.50, 0.50, 0.00, 0.00, 0.00, false},  // Update heavy: session stores.
+    {"B", 0.95, 0.05, 0.00, 0.00, 0.00, false},  // Read mostly: photo tagging.
+    {"C", 1.00, 0.00, 0.00, 0.00, 0.00, false},  // Read only: user profile caches.
+    {"D", 0.95, 0.00, 0.05, 0.00, 0.00, true},   // Read latest: status updates.
+    {"E", 0.00, 0.00, 0.05, 0.95, 0.00, false},  // Short ranges: threaded conversations.
+    {"F", 0.50, 0.00, 0.00, 0.00, 0.50, false},  // Read, modify, write: user databases.
+};
+
+/**
+ * @struct YcsbTable
+ * @brief A loaded table of YCSB records.
+ */
+struct YcsbTable {
+    /// The collection.
+    std::string name;
+    /// The key of the next record to insert; all keys below it exist.
+    std::atomic<uint64_t> next_key;
+    /// Chooses the records an operation touches.
+    ZipfianGenerator zipfian;
+};
+
+/**
+ * @struct YcsbDatabase
+ * @brief The database the YCSB benchmarks run against, shared by all of them.
+ */
+struct YcsbDatabase {
+    /// The data directory.
+    std::string directory;
+    /// `true` if the directory was created by this run and is removed at its end.
+    bool owns_directory{false};
+    /// The engine.
+    std::unique_ptr<aevum::db::Core> core;
+    /// The loaded tables, by number of records.
+    std::map<uint64_t, std::unique_ptr<YcsbTable>> tables;
+    /// Guards `core` and `tables`.
+    std::mutex mutex;
+};
+
+/**
+ * @brief Returns the database of the run.
+ * @return The database.
+ */
+YcsbDatabase &ycsb_database() {
+    static YcsbDatabase database;
+    return database;
+}
+
+/**
+ * @brief Parses a comma-separated list of positive integers from the environment.
+ * @param name The environment variable.
+ * @param fallback The list used if the variable is unset or holds no positive integer.
+ * @return The integers.
+ */
+std::vector<uint64_t> environment_list(const char *name, std::vector<uint64_t> fallback) {
+    const char *value = std::getenv(name);
+    if (!value) return fallback;
+    std::vector<uint64_t> list;
+    const char *cursor = value;
+    while (*cursor) {
+        char *end = nullptr;
+        unsigned long long parsed = std::strtoull(cursor, &end, 10);
+        if (end == cursor) {
+            ++cursor;
+            continue;
+        }
+        if (parsed > 0) list.push_back(parsed);
+        cursor = end;
+    }
+    return list.empty() ? fallback : list;
+}
+
+/**
+ * @brief Returns the `_id` of a record.
+ * @param key The key of the record.
+ * @return `user<key>`.
+ */
+std::string ycsb_id(uint64_t key) { return "user" + std::to_string(key); }
+
+/**
+ * @brief Returns the query that selects one record.
+ * @param key The key of the record.
+ * @return The JSON query on `_id`.
+ */
+std::string ycsb_id_query(uint64_t key) { return R"({"_id":")" + ycsb_id(key) + R"("})"; }
+
+/**
+ * @brief Builds a field value; records differ in content so that compression cannot collapse
+ * them.
+ * @param key The key of the record.
+ * @param field The index of the field.
+ * @return A string of `YCSB_FIELD_LENGTH` letters.
+ */
+std::string ycsb_field_value(uint64_t key, int field) {
+    std::string value(YCSB_FIELD_LENGTH, 'a');
+    uint64_t state = aevum::util::hash::fnv1a_64(std::to_string(key * 31 + field));
+    for (char &c : value) {
+        c = static_cast<char>('a' + state % 26);
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return value;
+}
+
+/**
+ * @brief Builds a YCSB record.
+ * @param key The key of the record.
+ * @return The document.
+ */
+aevum::bson::doc::Document ycsb_record(uint64_t key) {
+    aevum::bson::Builder builder;
+    builder.append_string("_id", ycsb_id(key)).append_int64("seq", static_cast<int64_t>(key));
+    for (int field = 0; field < YCSB_FIELD_COUNT; ++field) {
+        std::string name = "field" + std::to_string(field);
+        builder.append_string(name.c_str(), ycsb_field_value(key, field));
+    }
+    return builder.finalize();
+}
+
+/**
+ * @brief Opens the database if needed and returns a table of the given size, loading it first
+ * if no workload has used it yet.
+ * @param records The number of records.
+ * @return The table.
+ */
+YcsbTable &ycsb_table(uint64_t records) {
+    YcsbDatabase &database = ycsb_database();
+    std::lock_guard<std::mutex> lock(database.mutex);
+    if (!database.core) {
+        if (const char *directory = std::getenv("AEVUM_BENCH_DIR")) {
+            database.directory = directory;
+            std::filesystem::create_directories(database.directory);
+        } else {
+            char pattern[] = "/tmp/aevum_bench_XXXXXX";
+            if (!mkdtemp(pattern)) throw std::runtime_error("Failed to create a data directory");
+            database.directory = pattern;
+            database.owns_directory = true;
+        }
+        database.core = std::make_unique<aevum::db::Core>(database.directory);
+    }
+    auto &table = database.tables[records];
+    if (table) return *table;
+
+    const std::string name = "usertable_" + std::to_string(records);
+    for (uint64_t first = 0; first < records; first += YCSB_LOAD_BATCH) {
+        std::vector<aevum::bson::doc::Document> batch;
+        for (uint64_t key = first; key < std::min(records, first + YCSB_LOAD_BATCH); ++key) {
+            batch.push_back(ycsb_record(key));
+        }
+        (void)database.core->insert_many(name, std::move(batch),
+                                         aevum::db::storage::Durability::NONE);
+    }
+    (void)database.core->create_index(name, "seq", aevum::db::index::IndexType::ORDERED);
+    table = std::unique_ptr<YcsbTable>(new YcsbTable{name, {records}, ZipfianGenerator(records)});
+    return *table;
+}
+
+/**
+ * @brief Chooses the record an operation reads or updates.
+ * @param workload The workload.
+ * @param table The table.
+ * @param rng The random engine of the calling thread.
+ * @return The key of an existing record.
+ */
+uint64_t choose_key(const YcsbWorkload &workload, const YcsbTable &table, std::mt19937_64 &rng) {
+    if (!workload.latest) return table.zipfian.next_scrambled(rng);
+    uint64_t newest = table.next_key.load(std::memory_order_relaxed) - 1;
+    uint64_t age = table.zipfian.next(rng);
+    return age > newest ? 0 : newest - age;
+}
+
+/**
+ * @brief Runs a YCSB workload against a table of a given size.
+ * @details Each iteration is one operation. Besides the throughput, the counters report the
+ * median and 99th percentile latency of the operations, averaged over the client threads.
+ * @param state The benchmark state.
+ * @param workload The workload.
+ * @param records The number of records of the table.
+ */
+void run_ycsb_workload(benchmark::State &state, const YcsbWorkload &workload, uint64_t records) {
+    YcsbTable &table = ycsb_table(records);
+    aevum::db::Core &core = *ycsb_database().core;
+    std::mt19937_64 rng(0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(state.thread_index()));
+    std::uniform_real_distribution<double> operation(0.0, 1.0);
+    std::uniform_int_distribution<int> field(0, YCSB_FIELD_COUNT - 1);
+    std::uniform_int_distribution<int64_t> scan_length(1, YCSB_MAX_SCAN_LENGTH);
+    aevum::util::metrics::LatencyHistogram latency;
+
+    for (auto _ : state) {
+        aevum::util::time::Stopwatch stopwatch;
+        double draw = operation(rng);
+        if ((draw -= workload.read) < 0) {
+            uint64_t key = choose_key(workload, table, rng);
+            benchmark::DoNotOptimize(core.find(table.name, ycsb_id_query(key)));
+        } else if ((draw -= workload.update) < 0) {
+            uint64_t key = choose_key(workload, table, rng);
+            int updated = field(rng);
+            std::string update = R"({"$set":{"field)" + std::to_string(updated) + R"(":")" +
+                                 ycsb_field_value(key + 1, updated) + R"("}})";
+            benchmark::DoNotOptimize(core.update(table.name, ycsb_id_query(key), update));
+        } else if ((draw -= workload.insert) < 0) {
+            uint64_t key = table.next_key.fetch_add(1, std::memory_order_relaxed);
+            benchmark::DoNotOptimize(core.insert(table.name, ycsb_record(key)));
+        } else if ((draw -= workload.scan) < 0) {
+            std::string query = R"({"seq":{"$gte":)" +
+                                std::to_string(choose_key(workload, table, rng)) + "}}";
+            benchmark::DoNotOptimize(
+                core.find(table.name, query, R"({"seq":1})", "{}", scan_length(rng)));
+        } else {
+            uint64_t key = choose_key(workload, table, rng);
+            std::string query = ycsb_id_query(key);
+            benchmark::DoNotOptimize(core.find(table.name, query));
+            int updated = field(rng);
+            std::string update = R"({"$set":{"field)" + std::to_string(updated) + R"(":")" +
+                                 ycsb_field_value(key + 1, updated) + R"("}})";
+            benchmark::DoNotOptimize(core.update(table.name, query, update));
+        }
+        latency.record(stopwatch);
+    }
+
+    auto snapshot = latency.snapshot();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50_us"] = benchmark::Counter(static_cast<double>(snapshot.percentile(0.5)),
+                                                  benchmark::Counter::kAvgThreads);
+    state.counters["p99_us"] = benchmark::Counter(static_cast<double>(snapshot.percentile(0.99)),
+                                                  benchmark::Counter::kAvgThreads);
+    state.counters["records"] = benchmark::Counter(static_cast<double>(table.next_key.load()),
+                                                   benchmark::Counter::kAvgThreads);
+}
+
+}  // namespace
+
+ZipfianGenerator::ZipfianGenerator(uint64_t items, double theta)
+    : items_(items > 0 ? items : 1), theta_(theta), alpha_(1.0 / (1.0 - theta)), zeta_n_(0.0) {
+    for (uint64_t i = 1; i <= items_; ++i) {
+        zeta_n_ += 1.0 / std::pow(static_cast<double>(i), theta_);
+    }
+    double zeta_2 = 1.0 + 1.0 / std::pow(2.0, theta_);
+    eta_ = (1.0 - std::pow(2.0 / static_cast<double>(items_), 1.0 - theta_)) /
+           (1.0 - zeta_2 / zeta_n_);
+}
+
+uint64_t ZipfianGenerator::next(std::mt19937_64 &rng) const {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double uz = u * zeta_n_;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + std::pow(0.5, theta_)) return items_ > 1 ? 1 : 0;
+    auto item = static_cast<uint64_t>(static_cast<double>(items_) *
+                                      std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return item < items_ ? item : items_ - 1;
+}
+
+uint64_t ZipfianGenerator::next_scrambled(std::mt19937_64 &rng) const {
+    uint64_t rank = next(rng);
+    return aevum::util::hash::fnv1a_64(
+               std::string_view(reinterpret_cast<const char *>(&rank), sizeof(rank))) %
+           items_;
+}
+
+void register_ycsb_benchmarks() {
+    const std::vector<uint64_t> sizes = environment_list("AEVUM_BENCH_RECORDS", {10000, 100000});
+    const std::vector<uint64_t> threads = environment_list("AEVUM_BENCH_THREADS", {1, 4});
+    for (uint64_t records : sizes) {
+        for (const YcsbWorkload &workload : YCSB_WORKLOADS) {
+            std::string name = std::string("BM_Ycsb") + workload.name + "/records:" +
+                               std::to_string(records);
+            auto *benchmark = benchmark::RegisterBenchmark(
+                name.c_str(), [&workload, records](benchmark::State &state) {
+                    run_ycsb_workload(state, workload, records);
+                });
+            benchmark->UseRealTime();
+            for (uint64_t count : threads) benchmark->Threads(static_cast<int>(count));
+        }
+    }
+}
+
+void shutdown_ycsb_benchmarks() {
+    YcsbDatabase &database = ycsb_database();
+    std::lock_guard<std::mutex> lock(database.mutex);
+    database.tables.clear();
+    database.core.reset();
+    if (database.owns_directory) {
+        std::error_code error;
+        std::filesystem::remove_all(database.directory, error);
+    }
+}
+
+}  // namespace aevum::bench
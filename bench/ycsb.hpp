@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file ycsb.hpp
+ * @brief Declares the YCSB-style macro-benchmarks, which drive a `Core` with the core workloads
+ * A to F of the Yahoo! Cloud Serving Benchmark.
+ * @details The workloads are registered at runtime, once per configured collection size and
+ * thread count, since both are read from the environment rather than fixed at compile time:
+ *
+ * - `AEVUM_BENCH_RECORDS`: comma-separated collection sizes (default `10000,100000`).
+ * - `AEVUM_BENCH_THREADS`: comma-separated client thread counts (default `1,4`).
+ * - `AEVUM_BENCH_DIR`: the data directory (default a fresh directory under `/tmp`, removed when
+ *   the run ends).
+ */
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @namespace aevum::bench
+ * @brief The benchmark suite of `aevum_bench`.
+ */
+namespace aevum::bench {
+
+/**
+ * @class ZipfianGenerator
+ * @brief Draws integers in `[0, items)` with a Zipfian distribution of skew `theta`.
+ *
+ * @details This is the generator of Gray et al., "Quickly Generating Billion-Record Synthetic
+ * Databases", which YCSB uses: item 0 is the most popular, and with the default skew of 0.99
+ * about a fifth of the draws hit the hottest 1% of the items. Construction sums `items` terms;
+ * drawing is constant time.
+ */
+class ZipfianGenerator {
+  public:
+    /**
+     * @brief Constructs a generator.
+     * @param items The number of items (at least one).
+     * @param theta The skew, in `(0, 1)`.
+     */
+    explicit ZipfianGenerator(uint64_t items, double theta = 0.99);
+
+    /**
+     * @brief Draws an item.
+     * @param rng The random engine of the calling thread.
+     * @return An item in `[0, items)`.
+     */
+    [[nodiscard]] uint64_t next(std::mt19937_64 &rng) const;
+
+    /**
+     * @brief Draws an item and scatters it over the key space, so that the popular items are not
+     * the adjacent first ones (YCSB's scrambled Zipfian).
+     * @param rng The random engine of the calling thread.
+     * @return An item in `[0, items)`.
+     */
+    [[nodiscard]] uint64_t next_scrambled(std::mt19937_64 &rng) const;
+
+  private:
+    /// The number of items.
+    uint64_t items_;
+    /// The skew.
+    double theta_;
+    /// `1 / (1 - theta)`.
+    double alpha_;
+    /// The generalized harmonic number of `items_`.
+    double zeta_n_;
+    /// The correction factor of the approximation.
+    double eta_;
+};
+
+/**
+ * @brief Registers one benchmark per YCSB workload, collection size, and thread count.
+ * @details Must be called after `benchmark::Initialize` and before the benchmarks run.
+ */
+void register_ycsb_benchmarks();
+
+/**
+ * @brief Closes the database of the YCSB benchmarks and removes its directory if it was created
+ * by the run.
+ */
+void shutdown_ycsb_benchmarks();
+
+}  // namespace aevum::bench
@@ -60,12 +60,12 @@ check_and_install_deps() {
     # Detect package manager
     if command -v pacman &> /dev/null; then
         echo "Detected Arch Linux (pacman)"
-        sudo pacman -S --noconfirm base-devel rustup cmake ninja ccache
+        sudo pacman -S --noconfirm base-devel rustup cmake ninja ccache snappy zstd
         rustup default stable
     elif command -v apt-get &> /dev/null; then
         echo "Detected Debian/Ubuntu (apt-get)"
         sudo apt-get update
-        sudo apt-get install -y build-essential curl cmake ninja-build ccache
+        sudo apt-get install -y build-essential curl cmake ninja-build ccache libsnappy-dev libzstd-dev
         # Install Rust via rustup if not available via apt
         if ! command -v rustc &> /dev/null; then
             curl --proto '=https' --tlsv1.2 -sSf https://sh.rustup.rs | sh -s -- -y
@@ -74,7 +74,7 @@ check_and_install_deps() {
     elif command -v dnf &> /dev/null; then
         echo "Detected Fedora/RHEL (dnf)"
         sudo dnf groupinstall -y "Development Tools"
-        sudo dnf install -y cmake rust cargo ninja-build ccache
+        sudo dnf install -y cmake rust cargo ninja-build ccache snappy-devel libzstd-devel
     else
         echo "Error: Unknown package manager. Please install C/C++ compilers, Rust, CMake, Ninja, and ccache manually."
         exit 1
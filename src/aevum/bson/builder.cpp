@@ -33,7 +33,7 @@ Builder::Builder() = default;
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_string(const char *key, std::string_view value) {
-    BSON_APPEND_UTF8(document_.get(), key, value.data());
+    BSON_APPEND_UTF8(document_.get_mutable(), key, value.data());
     return *this;
 }
 
@@ -44,7 +44,7 @@ Builder &Builder::append_string(const char *key, std::string_view value) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_int32(const char *key, int32_t value) {
-    BSON_APPEND_INT32(document_.get(), key, value);
+    BSON_APPEND_INT32(document_.get_mutable(), key, value);
     return *this;
 }
 
@@ -55,7 +55,7 @@ Builder &Builder::append_int32(const char *key, int32_t value) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_int64(const char *key, int64_t value) {
-    BSON_APPEND_INT64(document_.get(), key, value);
+    BSON_APPEND_INT64(document_.get_mutable(), key, value);
     return *this;
 }
 
@@ -66,7 +66,7 @@ Builder &Builder::append_int64(const char *key, int64_t value) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_double(const char *key, double value) {
-    BSON_APPEND_DOUBLE(document_.get(), key, value);
+    BSON_APPEND_DOUBLE(document_.get_mutable(), key, value);
     return *this;
 }
 
@@ -77,7 +77,7 @@ Builder &Builder::append_double(const char *key, double value) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_bool(const char *key, bool value) {
-    BSON_APPEND_BOOL(document_.get(), key, value);
+    BSON_APPEND_BOOL(document_.get_mutable(), key, value);
     return *this;
 }
 
@@ -87,7 +87,7 @@ Builder &Builder::append_bool(const char *key, bool value) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_null(const char *key) {
-    BSON_APPEND_NULL(document_.get(), key);
+    BSON_APPEND_NULL(document_.get_mutable(), key);
     return *this;
 }
 
@@ -101,7 +101,7 @@ Builder &Builder::append_null(const char *key) {
  * @return A reference to `*this` to enable fluent method chaining.
  */
 Builder &Builder::append_document(const char *key, const doc::Document &sub_document) {
-    BSON_APPEND_DOCUMENT(document_.get(), key, sub_document.get());
+    BSON_APPEND_DOCUMENT(document_.get_mutable(), key, sub_document.get());
     return *this;
 }
 
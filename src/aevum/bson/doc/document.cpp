@@ -36,41 +36,35 @@ Document::Document(bson_t *b) noexcept : bson_(b) {}
 
 /**
  * @brief Destructor that deallocates the managed BSON document.
- * @details This is the core of the RAII implementation. If the internal `bson_` pointer is valid
- * (not null), `bson_destroy` is called to free all associated memory. The pointer is then nullified
- * to prevent dangling pointer issues.
+ * @details This is the core of the RAII implementation. The document drops its reference to the
+ * buffer, and the last document referring to it calls `bson_destroy` to free all associated
+ * memory, together with the reference count.
  */
-Document::~Document() {
-    if (bson_) {
-        bson_destroy(bson_);
-        bson_ = nullptr;
-    }
-}
+Document::~Document() { drop_reference(); }
 
 /**
- * @brief Copy constructor that performs a deep copy of another `Document`.
- * @details This method creates a new, independent `Document` by invoking `bson_copy()`. This
- * function from `libbson` allocates new memory and performs a byte-for-byte duplication of the
- * source document's serialized data, ensuring no shared state between the two `Document` objects.
+ * @brief Copy constructor that shares the buffer of another `Document`.
+ * @details No BSON data is copied; `add_reference` accounts for the new document. Copying a null
+ * document yields a null document.
  * @param other The constant reference to the `Document` to be copied.
  */
-Document::Document(const Document &other) { bson_ = bson_copy(other.bson_); }
+Document::Document(const Document &other)
+    : bson_(other.bson_), refs_(other.bson_ ? other.add_reference() : nullptr) {}
 
 /**
- * @brief Copy assignment operator that replaces the current document with a deep copy of another.
- * @details This operator ensures safe assignment by first checking for self-assignment to prevent
- * unnecessary work and logical errors. If the current `Document` already manages data, that data
- * is destroyed via `bson_destroy`. Subsequently, a new deep copy of the `other` document is created
- * using `bson_copy`, and the internal pointer is updated to manage the new copy.
+ * @brief Copy assignment operator that replaces the current document with a share of another.
+ * @details This operator ensures safe assignment by first checking for self-assignment. The new
+ * reference is taken before the old one is dropped, so that assigning a document that already
+ * shares this document's buffer never destroys it.
  * @param other The constant reference to the `Document` from which to copy.
  * @return A reference to the modified `Document` (`*this`).
  */
 Document &Document::operator=(const Document &other) & {
     if (this != &other) {
-        if (bson_) {
-            bson_destroy(bson_);
-        }
-        bson_ = bson_copy(other.bson_);
+        SharedCount *count = other.bson_ ? other.add_reference() : nullptr;
+        drop_reference();
+        bson_ = other.bson_;
+        refs_.store(count, std::memory_order_relaxed);
     }
     return *this;
 }
@@ -79,32 +73,88 @@ Document &Document::operator=(const Document &other) & {
  * @brief Move constructor that transfers ownership of the underlying `bson_t` from another
  * `Document`.
  * @details This operation provides an efficient, no-copy mechanism for transferring a BSON
- * document. It uses `std::exchange` to atomically take the `bson_` pointer from the `other`
- * `Document` and replace it with `nullptr`. This leaves the `other` `Document` in a valid but empty
- * state, correctly transferring ownership and preventing any double-free errors.
+ * document. The buffer and its reference count, if any, are taken from the `other` `Document`,
+ * which is left in a valid but null state, so the count does not change.
  * @param other The rvalue-reference to the `Document` from which the resource will be moved.
  */
-Document::Document(Document &&other) noexcept { std::swap(bson_, other.bson_); }
+Document::Document(Document &&other) noexcept
+    : bson_(std::exchange(other.bson_, nullptr)),
+      refs_(other.refs_.exchange(nullptr, std::memory_order_relaxed)) {}
 
 /**
  * @brief Move assignment operator that transfers ownership of the underlying `bson_t`.
  * @details This operator provides safe and efficient resource transfer. It first checks for
- * self-assignment. If different, it deallocates its currently managed `bson_t` (if any) and then
- * takes ownership of the `other` document's resource using `std::exchange`. The `other` document
- * is subsequently nullified.
+ * self-assignment. If different, it drops its reference to its current buffer (if any) and then
+ * takes over the buffer and reference count of the `other` document, which is nullified.
  * @param other The rvalue-reference to the `Document` from which the resource will be moved.
  * @return A reference to the modified `Document` (`*this`).
  */
 Document &Document::operator=(Document &&other) & noexcept {
     if (this != &other) {
-        if (bson_) {
-            bson_destroy(bson_);
-        }
+        drop_reference();
         bson_ = std::exchange(other.bson_, nullptr);
+        refs_.store(other.refs_.exchange(nullptr, std::memory_order_relaxed),
+                    std::memory_order_relaxed);
     }
     return *this;
 }
 
+/**
+ * @brief Retrieves a mutable pointer to the buffer, copying it first if it is shared.
+ * @details A reference count left at one means every copy is gone, so the count is freed and the
+ * buffer is modified in place. Otherwise the buffer is copied while this document still holds
+ * its reference, and the reference is dropped afterwards.
+ * @return The buffer, referred to by no other document, or `nullptr` for a null document.
+ */
+bson_t *Document::get_mutable() {
+    SharedCount *count = refs_.load(std::memory_order_acquire);
+    if (count == nullptr) return bson_;
+    if (count->refs.load(std::memory_order_acquire) == 1) {
+        delete count;
+        refs_.store(nullptr, std::memory_order_relaxed);
+        return bson_;
+    }
+    bson_t *copy = bson_copy(bson_);
+    drop_reference();
+    bson_ = copy;
+    return bson_;
+}
+
+/**
+ * @brief Adds a reference to the buffer on behalf of a new copy.
+ * @details The source document holds a reference of its own, so the count cannot drop to zero
+ * while it is incremented. The first copy allocates the count with two references, one for the
+ * source and one for the copy; if another thread publishes a count first, that one is used.
+ * @return The incremented count.
+ */
+Document::SharedCount *Document::add_reference() const {
+    SharedCount *count = refs_.load(std::memory_order_acquire);
+    if (count == nullptr) {
+        auto *fresh = new SharedCount(2);
+        if (refs_.compare_exchange_strong(count, fresh, std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+            return fresh;
+        }
+        delete fresh;
+    }
+    count->refs.fetch_add(1, std::memory_order_relaxed);
+    return count;
+}
+
+/**
+ * @brief Drops this document's reference to its buffer and leaves the document null.
+ * @details The buffer and its count are destroyed by whichever document drops the last reference,
+ * after acquiring the writes of every other owner.
+ */
+void Document::drop_reference() noexcept {
+    SharedCount *count = refs_.exchange(nullptr, std::memory_order_relaxed);
+    if (bson_ && (count == nullptr || count->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+        bson_destroy(bson_);
+        delete count;
+    }
+    bson_ = nullptr;
+}
+
 /**
  * @brief Retrieves the total size of the serialized BSON document in bytes.
  * @details This function safely accesses the `len` field of the internal `bson_t` structure. If
@@ -127,9 +177,23 @@ bool Document::empty() const noexcept { return length() <= 5; }
  * @brief Releases ownership of the underlying `bson_t` and returns it.
  * @details After calling this, the `Document` object is left in a null state and
  *          is no longer responsible for destroying the BSON data. The caller
- *          takes full ownership and must eventually call `bson_destroy`.
+ *          takes full ownership and must eventually call `bson_destroy`. `get_mutable` first
+ *          makes the buffer this document's alone, copying it if it is shared.
  * @return The raw pointer to the `bson_t` object.
  */
-bson_t *Document::release() noexcept { return std::exchange(bson_, nullptr); }
+bson_t *Document::release() {
+    bson_t *unique = get_mutable();
+    bson_ = nullptr;
+    return unique;
+}
+
+/**
+ * @brief Checks whether another document refers to the same buffer.
+ * @return `true` if the buffer's reference count exceeds one.
+ */
+bool Document::shared() const noexcept {
+    SharedCount *count = refs_.load(std::memory_order_acquire);
+    return count != nullptr && count->refs.load(std::memory_order_acquire) > 1;
+}
 
 }  // namespace aevum::bson::doc
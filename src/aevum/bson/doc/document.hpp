@@ -15,6 +15,7 @@
 #pragma once
 
 #include <bson/bson.h>
+#include <atomic>
 #include <cstdint>
 
 /**
@@ -35,10 +36,17 @@ namespace aevum::bson::doc {
  * data is deterministically and automatically deallocated via `bson_destroy` when a `Document`
  * instance goes out of scope. This design eradicates a major class of memory leaks.
  *
- * The class provides a complete, modern C++ interface, including deep-copy semantics for copy
- * construction and assignment, and efficient, ownership-transfer semantics for move construction
- * and assignment. This allows `Document` objects to be used seamlessly and safely within standard
- * C++ containers and algorithms.
+ * Copies share the BSON buffer of their source: the first copy of a document allocates an
+ * atomic reference count, and every further copy only increments it, so documents can be handed
+ * from the indexes to scans, lookups, and write batches without copying their bytes. A shared
+ * buffer is immutable. `get_mutable` gives write access, copying the buffer first if any other
+ * document still refers to it; new documents are best assembled with `aevum::bson::Builder`.
+ * Moves transfer ownership without touching the count. This allows `Document` objects to be used
+ * seamlessly and safely within standard C++ containers and algorithms.
+ *
+ * As with any standard type, distinct `Document` objects may be used from different threads
+ * concurrently, even if they share a buffer, and a single object may be read (and copied) by
+ * several threads at once.
  */
 class Document {
   public:
@@ -71,19 +79,18 @@ class Document {
     ~Document();
 
     /**
-     * @brief Copy constructor. Performs a deep, byte-for-byte copy of the BSON data.
-     * @details This constructor creates a completely independent new `Document` by calling
-     * `bson_copy()`, which allocates new memory and duplicates the entire content of the `other`
-     * document.
+     * @brief Copy constructor. Shares the BSON buffer of another document.
+     * @details No BSON data is copied: the new document refers to the buffer of `other` and
+     * increments its reference count, allocating the count if `other` was not shared yet.
      * @param other The source `Document` from which to create a copy.
      */
     Document(const Document &other);
 
     /**
-     * @brief Copy assignment operator. Replaces this document with a deep copy of another.
-     * @details This operator provides safe assignment by first checking for self-assignment. If
-     * this `Document` already manages a `bson_t`, that memory is safely destroyed before a deep
-     * copy of the `other` document's data is created and assigned. The lvalue-ref-qualifier `&`
+     * @brief Copy assignment operator. Replaces this document with a share of another.
+     * @details This operator provides safe assignment by first checking for self-assignment. The
+     * buffer of `other` is shared as by the copy constructor before this document releases its
+     * own, which is destroyed if no other document refers to it. The lvalue-ref-qualifier `&`
      * prevents assignment to rvalues.
      * @param other The source `Document` to copy from.
      * @return A reference to this instance (`*this`) after the copy.
@@ -114,17 +121,20 @@ class Document {
     /**
      * @brief Retrieves a mutable raw pointer to the underlying `bson_t` structure.
      * @details This function provides an escape hatch for interoperability with C-style `libbson`
-     * functions that require a non-const `bson_t*` (e.g., for appending elements). The caller
-     * should not deallocate this pointer, as its lifetime is still managed by the `Document` class.
+     * functions that require a non-const `bson_t*` (e.g., for appending elements). If the buffer
+     * is shared with other documents, it is copied first, so that they never observe the change.
+     * The caller should not deallocate this pointer, as its lifetime is still managed by the
+     * `Document` class.
      * @return A raw pointer to the internal `bson_t`, or `nullptr` if the document is in a null
      * state.
      */
-    [[nodiscard]] bson_t *get() noexcept { return bson_; }
+    [[nodiscard]] bson_t *get_mutable();
 
     /**
      * @brief Retrieves a read-only raw pointer to the underlying `bson_t` structure.
      * @details This accessor is essential for interoperating with `libbson` functions that perform
-     * read-only operations and thus accept a `const bson_t*`.
+     * read-only operations and thus accept a `const bson_t*`. It never copies, whether or not the
+     * buffer is shared.
      * @return A `const` raw pointer to the internal `bson_t`, or `nullptr` if the document is null.
      */
     [[nodiscard]] const bson_t *get() const noexcept { return bson_; }
@@ -151,18 +161,56 @@ class Document {
      * @brief Releases ownership of the underlying `bson_t` and returns it.
      * @details After calling this, the `Document` object is left in a null state and
      *          is no longer responsible for destroying the BSON data. The caller
-     *          takes full ownership and must eventually call `bson_destroy`.
+     *          takes full ownership and must eventually call `bson_destroy`. A shared buffer
+     *          is copied, so the returned one is never referred to by another document.
      * @return The raw pointer to the `bson_t` object.
      */
-    [[nodiscard]] bson_t *release() noexcept;
+    [[nodiscard]] bson_t *release();
+
+    /**
+     * @brief Checks whether the buffer is currently shared with another document.
+     * @return `true` if another `Document` refers to the same buffer.
+     */
+    [[nodiscard]] bool shared() const noexcept;
 
   private:
+    /**
+     * @struct SharedCount
+     * @brief The reference count of a shared buffer, allocated by its first copy.
+     */
+    struct SharedCount {
+        explicit SharedCount(uint32_t initial) noexcept : refs(initial) {}
+
+        /// The number of documents that refer to the buffer.
+        std::atomic<uint32_t> refs;
+    };
+
+    /**
+     * @brief Adds a reference to the buffer on behalf of a new copy.
+     * @details The count is allocated on first use and published with a compare-and-swap, since
+     * a `const` document may be copied by several threads at once.
+     * @return The count of the buffer, already incremented.
+     */
+    SharedCount *add_reference() const;
+
+    /**
+     * @brief Drops this document's reference, destroying the buffer if it was the last one,
+     * and leaves the document null.
+     */
+    void drop_reference() noexcept;
+
     /**
      * @var bson_
      * @brief A raw pointer to the heap-allocated `bson_t` object whose lifetime is exclusively
      * managed by this `Document` instance. It is initialized to `nullptr`.
      */
     bson_t *bson_{nullptr};
+
+    /**
+     * @var refs_
+     * @brief The reference count of the buffer, or `nullptr` while no copy has been made.
+     */
+    mutable std::atomic<SharedCount *> refs_{nullptr};
 };
 
 }  // namespace aevum::bson::doc
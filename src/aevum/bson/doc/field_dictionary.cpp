@@ -0,0 +1,358 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file field_dictionary.cpp
+ * @brief Implements the field-name dictionary encoding of BSON documents.
+ * @details The codec walks the raw BSON bytes itself instead of using `bson_iter_t`, because it
+ * copies every value verbatim and only needs to know where each value ends. Both directions check
+ * every length against the bytes available, so that a corrupt stored value is rejected instead of
+ * being read past its end.
+ */
+#include "aevum/bson/doc/field_dictionary.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+namespace aevum::bson::doc {
+
+namespace {
+
+/// The deepest nesting of documents and arrays the codec follows.
+constexpr int MAX_DICTIONARY_NESTING = 100;
+
+/// The result of `dictionary_value_size` for a malformed value.
+constexpr size_t MALFORMED_VALUE = std::numeric_limits<size_t>::max();
+
+/// The bytes that start every encoded document: a zero BSON length and the format version.
+constexpr size_t ENCODED_PREFIX_SIZE = 5;
+
+/// Reads a little-endian 32-bit integer.
+uint32_t read_le32(const uint8_t *data) noexcept {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return BSON_UINT32_FROM_LE(value);
+}
+
+/// Appends an unsigned integer as a LEB128 varint.
+void append_varint(std::string &out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/// Reads a LEB128 varint of at most five bytes, advancing `data`.
+bool read_varint(const uint8_t *&data, const uint8_t *end, uint32_t &value) noexcept {
+    value = 0;
+    for (int shift = 0; shift < 35 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the size of the value of an element that is not a document or an array.
+ * @param type The BSON type of the element.
+ * @param value The first byte of the value.
+ * @param available The bytes available from `value` on.
+ * @return The size of the value in bytes, or `MALFORMED_VALUE` if it does not fit or the type is
+ *         unknown.
+ */
+size_t dictionary_value_size(uint8_t type, const uint8_t *value, size_t available) noexcept {
+    size_t size = MALFORMED_VALUE;
+    switch (type) {
+        case BSON_TYPE_UNDEFINED:
+        case BSON_TYPE_NULL:
+        case BSON_TYPE_MINKEY:
+        case BSON_TYPE_MAXKEY:
+            size = 0;
+            break;
+        case BSON_TYPE_BOOL:
+            size = 1;
+            break;
+        case BSON_TYPE_INT32:
+            size = 4;
+            break;
+        case BSON_TYPE_DOUBLE:
+        case BSON_TYPE_DATE_TIME:
+        case BSON_TYPE_TIMESTAMP:
+        case BSON_TYPE_INT64:
+            size = 8;
+            break;
+        case BSON_TYPE_OID:
+            size = 12;
+            break;
+        case BSON_TYPE_DECIMAL128:
+            size = 16;
+            break;
+        case BSON_TYPE_UTF8:
+        case BSON_TYPE_CODE:
+        case BSON_TYPE_SYMBOL:
+            if (available >= 4 && read_le32(value) >= 1) size = 4 + size_t{read_le32(value)};
+            break;
+        case BSON_TYPE_BINARY:
+            if (available >= 5) size = 5 + size_t{read_le32(value)};
+            break;
+        case BSON_TYPE_DBPOINTER:
+            if (available >= 4 && read_le32(value) >= 1) size = 16 + size_t{read_le32(value)};
+            break;
+        case BSON_TYPE_CODEWSCOPE:
+            if (available >= 4 && read_le32(value) >= 14) size = read_le32(value);
+            break;
+        case BSON_TYPE_REGEX: {
+            const void *pattern_end = std::memchr(value, 0, available);
+            if (pattern_end == nullptr) break;
+            size_t pattern = static_cast<const uint8_t *>(pattern_end) - value + 1;
+            const void *options_end = std::memchr(value + pattern, 0, available - pattern);
+            if (options_end != nullptr) {
+                size = static_cast<const uint8_t *>(options_end) - value + 1;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return size <= available ? size : MALFORMED_VALUE;
+}
+
+/**
+ * @brief Encodes the elements of a BSON document or array.
+ * @tparam IdOf A callable `bool(std::string_view name, uint32_t &id)`.
+ * @param doc The first byte of the document.
+ * @param available The bytes available from `doc` on.
+ * @param array `true` if the document is an array, whose element names are left out.
+ * @param depth The nesting depth of the document.
+ * @param id_of Looks up the id of a name; returning `false` fails the encoding.
+ * @param out Receives the encoded elements and their terminating zero byte.
+ * @return `true` if the document was well-formed and all names had ids.
+ */
+template <typename IdOf>
+bool encode_dictionary_fields(const uint8_t *doc, size_t available, bool array, int depth,
+                              IdOf &id_of, std::string &out) {
+    if (depth > MAX_DICTIONARY_NESTING || available < 5) return false;
+    size_t length = read_le32(doc);
+    if (length < 5 || length > available || doc[length - 1] != 0) return false;
+
+    const uint8_t *p = doc + 4;
+    const uint8_t *end = doc + length - 1;
+    while (p < end) {
+        uint8_t type = *p++;
+        if (type == 0) return false;
+        const void *name_end = std::memchr(p, 0, static_cast<size_t>(end - p));
+        if (name_end == nullptr) return false;
+        std::string_view name(reinterpret_cast<const char *>(p),
+                              static_cast<const uint8_t *>(name_end) - p);
+        p = static_cast<const uint8_t *>(name_end) + 1;
+
+        out.push_back(static_cast<char>(type));
+        if (!array) {
+            uint32_t id;
+            if (!id_of(name, id)) return false;
+            append_varint(out, id);
+        }
+
+        size_t remaining = static_cast<size_t>(end - p);
+        if (type == BSON_TYPE_DOCUMENT || type == BSON_TYPE_ARRAY) {
+            if (!encode_dictionary_fields(p, remaining, type == BSON_TYPE_ARRAY, depth + 1, id_of,
+                                          out)) {
+                return false;
+            }
+            p += read_le32(p);
+        } else {
+            size_t size = dictionary_value_size(type, p, remaining);
+            if (size == MALFORMED_VALUE) return false;
+            out.append(reinterpret_cast<const char *>(p), size);
+            p += size;
+        }
+    }
+    out.push_back('\0');
+    return true;
+}
+
+/**
+ * @brief Decodes encoded elements back into a BSON document or array.
+ * @param p The first encoded element; advanced past the terminating zero byte.
+ * @param end The end of the encoded data.
+ * @param array `true` if the elements belong to an array, whose names are regenerated.
+ * @param depth The nesting depth of the document.
+ * @param names The names of the dictionary, indexed by id.
+ * @param out Receives the BSON document, including its length.
+ * @return `true` if the elements were well-formed and all ids were known.
+ */
+bool decode_dictionary_fields(const uint8_t *&p, const uint8_t *end, bool array, int depth,
+                              const std::deque<std::string> &names, std::string &out) {
+    if (depth > MAX_DICTIONARY_NESTING) return false;
+    size_t start = out.size();
+    out.append(4, '\0');
+
+    uint32_t index = 0;
+    while (true) {
+        if (p >= end) return false;
+        uint8_t type = *p++;
+        if (type == 0) break;
+
+        out.push_back(static_cast<char>(type));
+        if (array) {
+            char digits[16];
+            auto written = std::to_chars(digits, digits + sizeof(digits), index++);
+            out.append(digits, written.ptr);
+        } else {
+            uint32_t id;
+            if (!read_varint(p, end, id) || id >= names.size()) return false;
+            out += names[id];
+        }
+        out.push_back('\0');
+
+        if (type == BSON_TYPE_DOCUMENT || type == BSON_TYPE_ARRAY) {
+            if (!decode_dictionary_fields(p, end, type == BSON_TYPE_ARRAY, depth + 1, names,
+                                          out)) {
+                return false;
+            }
+        } else {
+            size_t size = dictionary_value_size(type, p, static_cast<size_t>(end - p));
+            if (size == MALFORMED_VALUE) return false;
+            out.append(reinterpret_cast<const char *>(p), size);
+            p += size;
+        }
+    }
+    out.push_back('\0');
+
+    uint32_t length = BSON_UINT32_TO_LE(static_cast<uint32_t>(out.size() - start));
+    std::memcpy(&out[start], &length, sizeof(length));
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructs a dictionary from persisted names.
+ * @param names The names, indexed by id.
+ */
+FieldDictionary::FieldDictionary(const std::vector<std::string> &names)
+    : names_(names.begin(), names.end()), persisted_(names.size()) {
+    ids_.reserve(names_.size());
+    for (size_t id = 0; id < names_.size(); ++id) {
+        ids_.emplace(names_[id], static_cast<uint32_t>(id));
+    }
+}
+
+/**
+ * @brief Checks whether a stored value starts with the prefix of an encoded document.
+ * @param data The value.
+ * @param length The size of the value in bytes.
+ * @return `true` if the value is an encoded document.
+ */
+bool FieldDictionary::is_encoded(const uint8_t *data, size_t length) noexcept {
+    return length >= ENCODED_PREFIX_SIZE && read_le32(data) == 0 &&
+           data[4] == FORMAT_VERSION;
+}
+
+/**
+ * @brief Encodes a document, assigning ids to new names under the exclusive lock only.
+ * @param doc The document.
+ * @param out Receives the encoded document.
+ * @return `false` if the document is not well-formed BSON.
+ */
+bool FieldDictionary::encode(const Document &doc, std::string &out) {
+    bool missing = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (encode_locked(doc, false, out, missing)) return true;
+    }
+    if (!missing) return false;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return encode_locked(doc, true, out, missing);
+}
+
+/**
+ * @brief Encodes a document while the caller holds the lock.
+ * @param doc The document.
+ * @param assign `true` to assign ids to unknown names.
+ * @param out Receives the encoded document.
+ * @param missing Set to `true` if an unknown name was met without `assign`.
+ * @return `true` if the document was encoded.
+ */
+bool FieldDictionary::encode_locked(const Document &doc, bool assign, std::string &out,
+                                    bool &missing) {
+    out.assign(4, '\0');
+    out.push_back(static_cast<char>(FORMAT_VERSION));
+    if (doc.get() == nullptr) return false;
+
+    auto id_of = [&](std::string_view name, uint32_t &id) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            id = it->second;
+            return true;
+        }
+        if (!assign) {
+            missing = true;
+            return false;
+        }
+        id = static_cast<uint32_t>(names_.size());
+        names_.emplace_back(name);
+        ids_.emplace(names_.back(), id);
+        return true;
+    };
+    return encode_dictionary_fields(bson_get_data(doc.get()), doc.length(), false, 0, id_of,
+                                    out);
+}
+
+/**
+ * @brief Decodes an encoded document back into BSON under the shared lock.
+ * @param data The encoded document.
+ * @param length Its size in bytes.
+ * @return The decoded document, or `nullptr` if the data is corrupt.
+ */
+bson_t *FieldDictionary::decode(const uint8_t *data, size_t length) const {
+    if (!is_encoded(data, length)) return nullptr;
+    const uint8_t *p = data + ENCODED_PREFIX_SIZE;
+    const uint8_t *end = data + length;
+
+    std::string out;
+    out.reserve(length * 2);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (!decode_dictionary_fields(p, end, false, 0, names_, out)) return nullptr;
+    }
+    if (p != end) return nullptr;
+    return bson_new_from_data(reinterpret_cast<const uint8_t *>(out.data()), out.size());
+}
+
+/**
+ * @brief Returns the number of assigned ids.
+ * @return The number of names.
+ */
+size_t FieldDictionary::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+/**
+ * @brief Returns a copy of the names, indexed by id.
+ * @return The names.
+ */
+std::vector<std::string> FieldDictionary::names() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return std::vector<std::string>(names_.begin(), names_.end());
+}
+
+/**
+ * @brief Raises the number of ids known to be persisted.
+ * @param size The number of ids persisted.
+ */
+void FieldDictionary::mark_persisted(size_t size) noexcept {
+    size_t current = persisted_.load(std::memory_order_relaxed);
+    while (current < size &&
+           !persisted_.compare_exchange_weak(current, size, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace aevum::bson::doc
@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file field_dictionary.hpp
+ * @brief Declares `FieldDictionary`, a compact storage encoding of BSON documents that replaces
+ * field names by numeric ids.
+ * @details The documents of a collection usually repeat the same field names, and BSON spells out
+ * every name in every document. A `FieldDictionary` assigns each name of a collection a small id
+ * once, and encodes documents with the ids in place of the names. Array indexes, which BSON also
+ * stores as names (`"0"`, `"1"`, ...), are left out entirely and restored on decoding. Values are
+ * copied byte for byte, so decoding reproduces the original BSON exactly.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::bson::doc {
+
+/**
+ * @class FieldDictionary
+ * @brief An append-only mapping between the field names of a collection and their ids, together
+ * with the encoder and decoder that use it.
+ *
+ * @details An encoded document starts with four zero bytes, which no BSON document can start
+ * with since its length is at least five, followed by `FORMAT_VERSION`. Each element is then its
+ * BSON type byte, the varint id of its name unless it belongs to an array, and its value. Embedded
+ * documents and arrays are encoded in the same way, and every element list ends with a zero type
+ * byte, so that no lengths need to be stored.
+ *
+ * Ids are never reassigned, so a document encoded once stays decodable for the lifetime of the
+ * dictionary, and a dictionary persisted at any point decodes every document encoded before it.
+ * `persisted_size` and `mark_persisted` let the owner tell whether newly assigned ids still
+ * have to be written out. All methods are thread-safe.
+ */
+class FieldDictionary {
+  public:
+    /// The version byte that follows the zero prefix of an encoded document.
+    static constexpr uint8_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Constructs an empty dictionary.
+     */
+    FieldDictionary() = default;
+
+    /**
+     * @brief Constructs a dictionary from persisted names.
+     * @param names The names, indexed by id. The dictionary counts them as persisted.
+     */
+    explicit FieldDictionary(const std::vector<std::string> &names);
+
+    FieldDictionary(const FieldDictionary &) = delete;
+    FieldDictionary &operator=(const FieldDictionary &) = delete;
+
+    /**
+     * @brief Checks whether a stored value is an encoded document rather than plain BSON.
+     * @param data The value.
+     * @param length The size of the value in bytes.
+     * @return `true` if the value starts with the prefix of an encoded document.
+     */
+    [[nodiscard]] static bool is_encoded(const uint8_t *data, size_t length) noexcept;
+
+    /**
+     * @brief Encodes a document, assigning ids to names seen for the first time.
+     * @details The document is first encoded under a shared lock. Only if it contains a name
+     * without an id is it encoded again under an exclusive lock, which assigns the missing ids.
+     * @param doc The document.
+     * @param out Receives the encoded document, replacing its previous contents.
+     * @return `false` if the document is not well-formed BSON.
+     */
+    [[nodiscard]] bool encode(const Document &doc, std::string &out);
+
+    /**
+     * @brief Decodes an encoded document back into BSON.
+     * @param data The encoded document, as produced by `encode`.
+     * @param length Its size in bytes.
+     * @return The decoded document, owned by the caller, or `nullptr` if the data is corrupt or
+     *         refers to an id the dictionary does not know.
+     */
+    [[nodiscard]] bson_t *decode(const uint8_t *data, size_t length) const;
+
+    /**
+     * @brief Returns the number of assigned ids.
+     * @return The number of names in the dictionary.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Returns a copy of the names, indexed by id.
+     * @return The names.
+     */
+    [[nodiscard]] std::vector<std::string> names() const;
+
+    /**
+     * @brief Returns the number of ids known to be persisted by the owner.
+     * @return The largest size passed to `mark_persisted`, or given to the constructor.
+     */
+    [[nodiscard]] size_t persisted_size() const noexcept {
+        return persisted_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Records that the first ids of the dictionary have been persisted.
+     * @param size The number of ids persisted. Smaller values than a previous one are ignored.
+     */
+    void mark_persisted(size_t size) noexcept;
+
+  private:
+    /**
+     * @brief Encodes a document with the ids assigned so far, or assigning the missing ones.
+     * @param doc The document.
+     * @param assign `true` to assign ids to unknown names; the caller holds the exclusive lock.
+     *        Otherwise the caller holds the shared lock and an unknown name fails the encoding.
+     * @param out Receives the encoded document.
+     * @param missing Set to `true` if the encoding failed because of an unknown name.
+     * @return `true` if the document was encoded.
+     */
+    bool encode_locked(const Document &doc, bool assign, std::string &out, bool &missing);
+
+    /// Guards `names_` and `ids_`.
+    mutable std::shared_mutex mutex_;
+    /// The names, indexed by id. A deque, so that the views in `ids_` stay valid as it grows.
+    std::deque<std::string> names_;
+    /// The id of each name, keyed by views into `names_`.
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    /// The number of ids persisted by the owner.
+    std::atomic<size_t> persisted_{0};
+};
+
+}  // namespace aevum::bson::doc
@@ -0,0 +1,671 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file matcher.cpp
+ * @brief Implements the native BSON query matcher.
+ * @details Queries are parsed with simdjson rather than libbson, because libbson interprets
+ * extended JSON (`{"$oid": ...}`, `{"$numberLong": ...}`) that the Rust engine treats as plain
+ * JSON, and would thereby change what a query means. Each compiled test mirrors a `Test` of the
+ * Rust `query::plan` module.
+ */
+#include "aevum/bson/doc/matcher.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <simdjson.h>
+
+namespace aevum::bson::doc {
+
+namespace {
+
+/**
+ * @brief Checks whether a JSON text contains the integer literal `-0` outside of a string.
+ * @details serde_json reads `-0` as the double `-0.0` to preserve its sign, whereas simdjson
+ * reads it as the integer `0`; the two differ under equality, so such queries are left to Rust.
+ * @param json The JSON text.
+ * @return `true` if the text contains a bare `-0` that is not the start of `-0.`/`-0e`.
+ */
+bool has_negative_zero_integer(std::string_view json) {
+    bool in_string = false;
+    for (size_t i = 0; i < json.size(); ++i) {
+        char c = json[i];
+        if (in_string) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                in_string = false;
+            }
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == '-' && i + 1 < json.size() && json[i + 1] == '0') {
+            char next = i + 2 < json.size() ? json[i + 2] : '\0';
+            if (next != '.' && next != 'e' && next != 'E') return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Collects the members of a JSON object by key, in byte order.
+ * @details This is the view the Rust engine has of an object: `serde_json::Map` keeps its keys
+ * sorted and lets the last of several equal keys win.
+ * @param object The object.
+ * @return The members, by key.
+ */
+std::map<std::string_view, simdjson::dom::element> sorted_members(simdjson::dom::object object) {
+    std::map<std::string_view, simdjson::dom::element> members;
+    for (auto member : object) members[member.key] = member.value;
+    return members;
+}
+
+}  // namespace
+
+/**
+ * @struct MatcherCompiler
+ * @brief Translates a parsed JSON query into the tests of a `Matcher`.
+ */
+struct MatcherCompiler {
+    using Outcome = Matcher::Outcome;
+    using Relation = Matcher::Relation;
+    using Scalar = Matcher::Scalar;
+    using Test = Matcher::Test;
+    using TestType = Matcher::TestType;
+    using ValueClass = Matcher::ValueClass;
+
+    /**
+     * @brief Reads a scalar JSON value.
+     * @param element The value.
+     * @param out Receives the scalar.
+     * @param text Receives the value of a string.
+     * @return `false` if the value is an array or an object.
+     */
+    static bool read_scalar(simdjson::dom::element element, Scalar &out, std::string &text) {
+        switch (element.type()) {
+            case simdjson::dom::element_type::INT64:
+                out.cls = ValueClass::INTEGER;
+                out.integer = element.get_int64().value_unsafe();
+                out.number = static_cast<double>(out.integer);
+                return true;
+            case simdjson::dom::element_type::UINT64:
+                // simdjson only reports integers above INT64_MAX as unsigned.
+                out.cls = ValueClass::INTEGER;
+                out.integer_overflows = true;
+                out.number = static_cast<double>(element.get_uint64().value_unsafe());
+                return true;
+            case simdjson::dom::element_type::DOUBLE:
+                out.cls = ValueClass::FLOAT;
+                out.number = element.get_double().value_unsafe();
+                return true;
+            case simdjson::dom::element_type::STRING:
+                out.cls = ValueClass::STRING;
+                text = std::string(element.get_string().value_unsafe());
+                return true;
+            case simdjson::dom::element_type::BOOL:
+                out.cls = ValueClass::BOOL;
+                out.boolean = element.get_bool().value_unsafe();
+                return true;
+            case simdjson::dom::element_type::NULL_VALUE:
+                out.cls = ValueClass::NUL;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Recognizes a parameter placeholder of a query template.
+     * @param element The value.
+     * @param parameters The names of the template's placeholders, extended with a new name, or
+     *        `nullptr` if the query is not a template.
+     * @param out Receives the index of the parameter.
+     * @return `true` if the value is an object `{"$param": "<name>"}` of a template.
+     */
+    static bool read_placeholder(simdjson::dom::element element,
+                                 std::vector<std::string> *parameters, Test &out) {
+        simdjson::dom::object object;
+        std::string_view name;
+        if (parameters == nullptr || element.get_object().get(object) != simdjson::SUCCESS ||
+            object.size() != 1 || object["$param"].get_string().get(name) != simdjson::SUCCESS) {
+            return false;
+        }
+        auto it = std::find(parameters->begin(), parameters->end(), name);
+        if (it == parameters->end()) it = parameters->emplace(it, name);
+        out.parameter = static_cast<int32_t>(it - parameters->begin());
+        return true;
+    }
+
+    /**
+     * @brief Compiles one operator and its operand, as `Test::compile` does in Rust.
+     * @details In a template, the operand of an equality or a comparison may be a placeholder;
+     * a comparison is then typed when it is bound.
+     * @param op The operator name.
+     * @param target The operand.
+     * @param parameters The placeholders of a template, or `nullptr`.
+     * @param out Receives the test.
+     * @return `NOTHING` if no value can satisfy the condition, `UNSUPPORTED` for an equality
+     *         with a document or an array, or for an `$all` or `$in` element that is one.
+     */
+    static Outcome compile_operator(std::string_view op, simdjson::dom::element target,
+                                    std::vector<std::string> *parameters, Test &out) {
+        if (op == "$eq" || op == "$ne") {
+            out.type = op == "$eq" ? TestType::EQUALS : TestType::NOT_EQUALS;
+            if (read_placeholder(target, parameters, out)) return Outcome::OK;
+            return read_scalar(target, out.operand, out.text) ? Outcome::OK
+                                                               : Outcome::UNSUPPORTED;
+        }
+        if (op == "$all" || op == "$in") {
+            simdjson::dom::array elements;
+            if (target.get_array().get(elements) != simdjson::SUCCESS || elements.size() == 0) {
+                return Outcome::NOTHING;
+            }
+            out.type = op == "$all" ? TestType::CONTAINS_ALL : TestType::IN;
+            for (auto element : elements) {
+                Test &test = out.elements.emplace_back();
+                if (!read_scalar(element, test.operand, test.text)) return Outcome::UNSUPPORTED;
+            }
+            if (out.type == TestType::IN) {
+                // Sorted once, so that each document is tested with a binary search.
+                std::sort(out.elements.begin(), out.elements.end(),
+                          [](const Test &a, const Test &b) {
+                              return Matcher::compare_scalars(a.operand, a.text, b.operand,
+                                                              b.text) < 0;
+                          });
+            }
+            return Outcome::OK;
+        }
+        if (op == "$type") {
+            std::string_view name;
+            if (target.get_string().get(name) != simdjson::SUCCESS) return Outcome::NOTHING;
+            out.type = TestType::IS_TYPE;
+            out.type_mask = type_mask(name);
+            return out.type_mask != 0 ? Outcome::OK : Outcome::NOTHING;
+        }
+        if (op == "$gt") {
+            out.relation = Relation::GT;
+        } else if (op == "$gte") {
+            out.relation = Relation::GTE;
+        } else if (op == "$lt") {
+            out.relation = Relation::LT;
+        } else if (op == "$lte") {
+            out.relation = Relation::LTE;
+        } else {
+            return Outcome::NOTHING;
+        }
+        if (read_placeholder(target, parameters, out)) {
+            out.type = TestType::COMPARE_NUMBER;
+            return Outcome::OK;
+        }
+        if (!read_scalar(target, out.operand, out.text)) return Outcome::NOTHING;
+        switch (out.operand.cls) {
+            case ValueClass::INTEGER:
+            case ValueClass::FLOAT:
+                out.type = TestType::COMPARE_NUMBER;
+                return Outcome::OK;
+            case ValueClass::STRING:
+                out.type = TestType::COMPARE_STRING;
+                return Outcome::OK;
+            default:
+                return Outcome::NOTHING;
+        }
+    }
+
+    /**
+     * @brief Resolves a `$type` operand to the value classes it accepts.
+     * @param name The type name.
+     * @return A mask of `ValueClass` bits, or 0 for an unknown name.
+     */
+    static uint8_t type_mask(std::string_view name) {
+        auto bit = [](ValueClass cls) {
+            return static_cast<uint8_t>(1u << static_cast<int>(cls));
+        };
+        if (name == "string") return bit(ValueClass::STRING);
+        if (name == "number" || name == "int" || name == "float" || name == "double") {
+            return bit(ValueClass::INTEGER) | bit(ValueClass::FLOAT);
+        }
+        if (name == "boolean" || name == "bool") return bit(ValueClass::BOOL);
+        if (name == "array") return bit(ValueClass::ARRAY);
+        if (name == "object") return bit(ValueClass::OBJECT);
+        if (name == "null") return bit(ValueClass::NUL);
+        return 0;
+    }
+
+    /**
+     * @brief Compiles the condition on one field.
+     * @param condition The condition: a literal, an operator map, or a template's placeholder.
+     * @param parameters The placeholders of a template, or `nullptr`.
+     * @param out Receives the tests.
+     * @return The outcome of the first test that is not `OK`, or `OK`.
+     */
+    static Outcome compile_condition(simdjson::dom::element condition,
+                                     std::vector<std::string> *parameters,
+                                     std::vector<Test> &out) {
+        Test placeholder;
+        if (read_placeholder(condition, parameters, placeholder)) {
+            placeholder.type = TestType::EQUALS;
+            out.push_back(std::move(placeholder));
+            return Outcome::OK;
+        }
+        simdjson::dom::object operators;
+        if (condition.get_object().get(operators) == simdjson::SUCCESS) {
+            auto members = sorted_members(operators);
+            // As in Rust, an object is an operator map if its first key starts with '$'.
+            if (members.empty() || members.begin()->first.substr(0, 1) != "$") {
+                return Outcome::UNSUPPORTED;
+            }
+            Outcome outcome = Outcome::OK;
+            for (const auto &[op, target] : members) {
+                Test test;
+                Outcome result = compile_operator(op, target, parameters, test);
+                if (result == Outcome::NOTHING) return result;
+                if (result == Outcome::UNSUPPORTED) outcome = result;
+                out.push_back(std::move(test));
+            }
+            return outcome;
+        }
+        Test test;
+        test.type = TestType::EQUALS;
+        if (!read_scalar(condition, test.operand, test.text)) return Outcome::UNSUPPORTED;
+        out.push_back(std::move(test));
+        return Outcome::OK;
+    }
+};
+
+/**
+ * @brief Compiles a JSON query.
+ * @param query_json The query.
+ * @return The compiled query, or `std::nullopt` if it must be evaluated by the Rust engine.
+ */
+std::optional<Matcher> Matcher::compile(std::string_view query_json) {
+    return compile(query_json, nullptr);
+}
+
+/**
+ * @brief Compiles a query template, whose values may be parameter placeholders.
+ * @param template_json The template.
+ * @return The compiled template, or `std::nullopt` if the Rust engine must evaluate it.
+ */
+std::optional<Matcher> Matcher::compile_template(std::string_view template_json) {
+    std::vector<std::string> parameters;
+    auto matcher = compile(template_json, &parameters);
+    if (matcher) matcher->parameters_ = std::move(parameters);
+    return matcher;
+}
+
+/**
+ * @brief Substitutes values for the placeholders of a compiled template.
+ * @details A value is accepted if `compile` would have read it as the same scalar from the
+ * bound query's JSON: a string, a finite double, an integer, a boolean, or null. A comparison
+ * takes the type of its operand here; one whose operand is neither a number nor a string would
+ * make the whole query match nothing, which is left to `compile` to decide along with the order
+ * of the conditions.
+ * @param params The values, by parameter name.
+ * @return The bound query, or `std::nullopt`.
+ */
+std::optional<Matcher> Matcher::bind(const Document &params) const {
+    Matcher bound = *this;
+    bound.parameters_.clear();
+    if (parameters_.empty()) return bound;
+    const bson_t *raw = params.get();
+    if (raw == nullptr) return std::nullopt;
+    for (auto &field : bound.fields_) {
+        for (auto &test : field.tests) {
+            if (test.parameter < 0) continue;
+            bson_iter_t iter;
+            const std::string &name = parameters_[static_cast<size_t>(test.parameter)];
+            if (!bson_iter_init_find(&iter, raw, name.c_str())) return std::nullopt;
+            switch (bson_iter_type(&iter)) {
+                case BSON_TYPE_DOUBLE:
+                case BSON_TYPE_UTF8:
+                case BSON_TYPE_INT32:
+                case BSON_TYPE_INT64:
+                case BSON_TYPE_BOOL:
+                case BSON_TYPE_NULL:
+                    break;
+                default:
+                    return std::nullopt;
+            }
+            Scalar value = classify(iter);
+            if (value.cls == ValueClass::OBJECT) return std::nullopt;
+            test.text = std::string(value.string);
+            value.string = {};
+            test.operand = value;
+            test.parameter = -1;
+            if (test.type == TestType::COMPARE_NUMBER || test.type == TestType::COMPARE_STRING) {
+                if (value.cls == ValueClass::STRING) {
+                    test.type = TestType::COMPARE_STRING;
+                } else if (value.cls == ValueClass::INTEGER || value.cls == ValueClass::FLOAT) {
+                    test.type = TestType::COMPARE_NUMBER;
+                } else {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+    return bound;
+}
+
+/**
+ * @brief Compiles a query or a query template.
+ * @details The query's fields and operators are visited in the order of `serde_json::Map`, and
+ * the first unsatisfiable condition makes the whole query match nothing, as in Rust.
+ * @param query_json The query.
+ * @param parameters The placeholders of a template, or `nullptr`.
+ * @return The compiled query, or `std::nullopt` if it must be evaluated by the Rust engine.
+ */
+std::optional<Matcher> Matcher::compile(std::string_view query_json,
+                                        std::vector<std::string> *parameters) {
+    if (has_negative_zero_integer(query_json)) return std::nullopt;
+
+    simdjson::dom::parser parser;
+    simdjson::dom::element root;
+    if (parser.parse(query_json.data(), query_json.size()).get(root) != simdjson::SUCCESS) {
+        return std::nullopt;
+    }
+    simdjson::dom::object query;
+    if (root.get_object().get(query) != simdjson::SUCCESS) return std::nullopt;
+
+    Matcher matcher;
+    auto members = sorted_members(query);
+    if (members.empty()) return matcher;
+
+    // An unsatisfiable condition makes the whole query match nothing, even alongside conditions
+    // that only the Rust engine could evaluate.
+    bool supported = true;
+    for (const auto &[field, condition] : members) {
+        FieldTests tests{std::string(field), {}, {}};
+        for (size_t start = 0;;) {
+            size_t end = field.find('.', start);
+            std::string_view name = field.substr(start, end - start);
+            // Past the top level, `$` names are members of extended JSON objects, such as the
+            // `$oid` of an ObjectId, which only the Rust decoder produces.
+            if (start > 0 && !name.empty() && name.front() == '$') supported = false;
+            tests.path.emplace_back(name);
+            if (end == std::string_view::npos) break;
+            start = end + 1;
+        }
+        Outcome outcome = MatcherCompiler::compile_condition(condition, parameters, tests.tests);
+        if (outcome == Outcome::NOTHING) {
+            matcher.kind_ = Kind::NOTHING;
+            matcher.fields_.clear();
+            return matcher;
+        }
+        if (outcome == Outcome::UNSUPPORTED) supported = false;
+        matcher.fields_.push_back(std::move(tests));
+    }
+    if (!supported) return std::nullopt;
+    matcher.kind_ = Kind::FIELDS;
+    return matcher;
+}
+
+/**
+ * @brief Evaluates the query against a document.
+ * @details Each field is looked up with `find_value`.
+ * @param doc The document.
+ * @return `true` if every field is present and satisfies all of its tests.
+ */
+bool Matcher::matches(const Document &doc) const {
+    if (kind_ != Kind::FIELDS) return kind_ == Kind::ALL;
+    const bson_t *raw = doc.get();
+    if (!raw) return false;
+
+    for (const auto &field : fields_) {
+        bson_iter_t found;
+        if (!find_value(raw, field.path, found)) return false;
+        Scalar value = classify(found);
+        for (const auto &test : field.tests) {
+            bool holds = test.type == TestType::CONTAINS_ALL ? contains_all(test, found)
+                                                              : evaluate(test, value);
+            if (!holds) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Locates the value of a field in a document.
+ * @details Each level is walked with one pass of a `bson_iter_t`, keeping the last element with
+ * the name, and the path only continues into an embedded document, as `serde_json::Value::get`
+ * only looks into objects.
+ * @param raw The document.
+ * @param path The names along the field's path.
+ * @param value Receives an iterator positioned on the value.
+ * @return `true` if the path leads to a value.
+ */
+bool Matcher::find_value(const bson_t *raw, const std::vector<std::string> &path,
+                         bson_iter_t &value) {
+    bson_iter_t iter;
+    if (!bson_iter_init(&iter, raw)) return false;
+    for (size_t level = 0; level < path.size(); ++level) {
+        const std::string &name = path[level];
+        bool present = false;
+        while (bson_iter_next(&iter)) {
+            if (bson_iter_key_len(&iter) == name.size() &&
+                std::memcmp(bson_iter_key(&iter), name.data(), name.size()) == 0) {
+                value = iter;
+                present = true;
+            }
+        }
+        if (!present) return false;
+        if (level + 1 < path.size() &&
+            (!BSON_ITER_HOLDS_DOCUMENT(&value) || !bson_iter_recurse(&value, &iter))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Evaluates a `CONTAINS_ALL` test against a stored value.
+ * @details Each element of the test must equal some element of the array, under the strict
+ * equality of `equals_operand`; the order and any further elements do not matter.
+ * @param test The test.
+ * @param value An iterator positioned on the value.
+ * @return `true` if the value is an array holding every element of the test.
+ */
+bool Matcher::contains_all(const Test &test, const bson_iter_t &value) {
+    bson_iter_t element;
+    if (!BSON_ITER_HOLDS_ARRAY(&value) || !bson_iter_recurse(&value, &element)) return false;
+    std::vector<Scalar> stored;
+    while (bson_iter_next(&element)) stored.push_back(classify(element));
+    for (const auto &wanted : test.elements) {
+        if (std::none_of(stored.begin(), stored.end(), [&](const Scalar &candidate) {
+                return equals_operand(wanted, candidate);
+            })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Evaluates an `IN` test against a stored value.
+ * @details The Rust engine hashes the elements of an `$in` list; here they are kept sorted and
+ * searched by bisection, which needs no hash that agrees with `equals_operand` and allocates
+ * nothing per document.
+ * @param test The test.
+ * @param value The stored value.
+ * @return `true` if the value equals one of the test's elements.
+ */
+bool Matcher::is_in(const Test &test, const Scalar &value) {
+    auto it = std::lower_bound(test.elements.begin(), test.elements.end(), value,
+                               [](const Test &element, const Scalar &stored) {
+                                   return compare_scalars(element.operand, element.text, stored,
+                                                          stored.string) < 0;
+                               });
+    return it != test.elements.end() &&
+           compare_scalars(it->operand, it->text, value, value.string) == 0;
+}
+
+/**
+ * @brief Orders two scalars by value class, then by value.
+ * @details Doubles compare numerically, so `0.0` and `-0.0` are equivalent as under equality;
+ * queries hold no NaN, and stored non-finite doubles are `OBJECT`s. Arrays and objects carry no
+ * value and compare by class alone, which no operand shares.
+ * @param a The first scalar.
+ * @param a_text The value of `a` if it is a string.
+ * @param b The second scalar.
+ * @param b_text The value of `b` if it is a string.
+ * @return A negative value, zero, or a positive value as `a` sorts before, with, or after `b`.
+ */
+int Matcher::compare_scalars(const Scalar &a, std::string_view a_text, const Scalar &b,
+                             std::string_view b_text) {
+    if (a.cls != b.cls) return a.cls < b.cls ? -1 : 1;
+    switch (a.cls) {
+        case ValueClass::BOOL:
+            return static_cast<int>(a.boolean) - static_cast<int>(b.boolean);
+        case ValueClass::INTEGER:
+            if (a.integer_overflows != b.integer_overflows) return a.integer_overflows ? 1 : -1;
+            // Only operands overflow, so no stored integer is ever found equivalent to one.
+            if (a.integer_overflows) return 0;
+            return a.integer < b.integer ? -1 : (b.integer < a.integer ? 1 : 0);
+        case ValueClass::FLOAT:
+            return a.number < b.number ? -1 : (b.number < a.number ? 1 : 0);
+        case ValueClass::STRING:
+            return a_text.compare(b_text);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads a BSON element as the Rust decoder would see it.
+ * @details The mapping follows the Rust BSON decoder: symbols are strings; undefined, DBPointer,
+ * code with scope, and Decimal128 decode to `null`; binary data, ObjectIds, dates, regular
+ * expressions, code, timestamps, the min and max keys, and non-finite doubles decode to extended
+ * JSON objects.
+ * @param iter An iterator positioned on the element.
+ * @return The element's value class and, for a scalar, its value.
+ */
+Matcher::Scalar Matcher::classify(const bson_iter_t &iter) {
+    Scalar value;
+    uint32_t length = 0;
+    switch (bson_iter_type(&iter)) {
+        case BSON_TYPE_DOUBLE:
+            value.number = bson_iter_double(&iter);
+            value.cls = std::isfinite(value.number) ? ValueClass::FLOAT : ValueClass::OBJECT;
+            break;
+        case BSON_TYPE_UTF8: {
+            const char *s = bson_iter_utf8(&iter, &length);
+            value.cls = ValueClass::STRING;
+            value.string = std::string_view(s, length);
+            break;
+        }
+        case BSON_TYPE_SYMBOL: {
+            const char *s = bson_iter_symbol(&iter, &length);
+            value.cls = ValueClass::STRING;
+            value.string = std::string_view(s, length);
+            break;
+        }
+        case BSON_TYPE_INT32:
+            value.cls = ValueClass::INTEGER;
+            value.integer = bson_iter_int32(&iter);
+            value.number = static_cast<double>(value.integer);
+            break;
+        case BSON_TYPE_INT64:
+            value.cls = ValueClass::INTEGER;
+            value.integer = bson_iter_int64(&iter);
+            value.number = static_cast<double>(value.integer);
+            break;
+        case BSON_TYPE_BOOL:
+            value.cls = ValueClass::BOOL;
+            value.boolean = bson_iter_bool(&iter);
+            break;
+        case BSON_TYPE_NULL:
+        case BSON_TYPE_UNDEFINED:
+        case BSON_TYPE_DBPOINTER:
+        case BSON_TYPE_CODEWSCOPE:
+        case BSON_TYPE_DECIMAL128:
+            value.cls = ValueClass::NUL;
+            break;
+        case BSON_TYPE_ARRAY:
+            value.cls = ValueClass::ARRAY;
+            break;
+        default:
+            value.cls = ValueClass::OBJECT;
+            break;
+    }
+    return value;
+}
+
+/**
+ * @brief Evaluates one condition against a stored value.
+ * @param test The condition.
+ * @param value The stored value.
+ * @return `true` if the value satisfies the condition.
+ */
+bool Matcher::evaluate(const Test &test, const Scalar &value) {
+    switch (test.type) {
+        case TestType::EQUALS:
+            return equals_operand(test, value);
+        case TestType::NOT_EQUALS:
+            return !equals_operand(test, value);
+        case TestType::COMPARE_NUMBER: {
+            if (value.cls != ValueClass::INTEGER && value.cls != ValueClass::FLOAT) return false;
+            double field = value.number;
+            double target = test.operand.number;
+            switch (test.relation) {
+                case Relation::GT:
+                    return field > target;
+                case Relation::GTE:
+                    return field >= target;
+                case Relation::LT:
+                    return field < target;
+                case Relation::LTE:
+                default:
+                    return field <= target;
+            }
+        }
+        case TestType::COMPARE_STRING: {
+            if (value.cls != ValueClass::STRING) return false;
+            int order = value.string.compare(test.text);
+            switch (test.relation) {
+                case Relation::GT:
+                    return order > 0;
+                case Relation::GTE:
+                    return order >= 0;
+                case Relation::LT:
+                    return order < 0;
+                case Relation::LTE:
+                default:
+                    return order <= 0;
+            }
+        }
+        case TestType::IN:
+            return is_in(test, value);
+        case TestType::IS_TYPE:
+        default:
+            return (test.type_mask >> static_cast<int>(value.cls)) & 1u;
+    }
+}
+
+/**
+ * @brief Compares a stored value with the operand of a test.
+ * @details Integers and doubles never compare equal, as with `serde_json::Number`.
+ * @param test The test.
+ * @param value The stored value.
+ * @return `true` if both have the same value class and value.
+ */
+bool Matcher::equals_operand(const Test &test, const Scalar &value) {
+    const Scalar &operand = test.operand;
+    if (operand.cls != value.cls) return false;
+    switch (operand.cls) {
+        case ValueClass::NUL:
+            return true;
+        case ValueClass::BOOL:
+            return operand.boolean == value.boolean;
+        case ValueClass::INTEGER:
+            return !operand.integer_overflows && operand.integer == value.integer;
+        case ValueClass::FLOAT:
+            return operand.number == value.number;
+        case ValueClass::STRING:
+            return value.string == test.text;
+        default:
+            return false;
+    }
+}
+
+}  // namespace aevum::bson::doc
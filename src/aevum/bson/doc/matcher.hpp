@@ -0,0 +1,262 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file matcher.hpp
+ * @brief Declares `Matcher`, a native evaluator for simple queries over stored BSON documents.
+ * @details Lending documents to the Rust query engine costs a decode of every document into a
+ * `serde_json::Value` before a single predicate is checked. Most queries, however, are nothing but
+ * equality and range comparisons of fields with scalars, which can be answered by looking the
+ * fields up in the BSON buffer directly. `Matcher` compiles such a query once and
+ * evaluates it in place with `bson_iter_t`; any other query is left to the Rust engine.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::bson::doc {
+
+struct MatcherCompiler;
+
+/**
+ * @class Matcher
+ * @brief A compiled query that is matched against BSON documents without leaving C++.
+ *
+ * @details A `Matcher` reproduces the semantics of the Rust matcher exactly, including its
+ * corner cases: a query field must be present, integers and doubles are distinct for equality
+ * but compare numerically under `$gt`, `$gte`, `$lt`, and `$lte`, an unknown operator or an
+ * unusable operand matches nothing, and a stored value is seen as the JSON value the Rust BSON
+ * decoder would produce for it (an ObjectId or a date, for instance, is an object). A field may
+ * be a dotted path such as `"address.city"`, which leads through embedded documents but not into
+ * arrays. Supported are conditions that are scalar literals or operator maps of `$eq`, `$ne`,
+ * `$gt`, `$gte`, `$lt`, `$lte`, `$type`, and `$all` and `$in` with scalar elements. `compile`
+ * declines anything else, such as a literal document or array, or a path through a value the Rust
+ * decoder only sees as an object (a segment starting with `$`), which the caller then hands to the
+ * Rust engine.
+ *
+ * The conformance cases in `src/aevum/ffi/tests/conformance/matcher_cases.json` pin down the
+ * semantics both engines must share.
+ *
+ * A `Matcher` is immutable once compiled and may be used from any number of threads.
+ */
+class Matcher {
+  public:
+    /**
+     * @brief Compiles a JSON query.
+     * @param query_json The query, as sent to the Rust engine.
+     * @return The compiled query, or `std::nullopt` if the query is not valid JSON or uses a
+     *         construct only the Rust engine supports.
+     */
+    [[nodiscard]] static std::optional<Matcher> compile(std::string_view query_json);
+
+    /**
+     * @brief Compiles a query template, whose values may be parameter placeholders.
+     * @details A placeholder is an object `{"$param": "<name>"}` standing for a scalar: the
+     * literal value of a field, or the operand of `$eq`, `$ne`, `$gt`, `$gte`, `$lt`, or `$lte`.
+     * Outside of a template, such an object is an operator map like any other, which matches
+     * nothing.
+     * @param template_json The template.
+     * @return The compiled template, to be completed by `bind`, or `std::nullopt` as for
+     *         `compile`.
+     */
+    [[nodiscard]] static std::optional<Matcher> compile_template(std::string_view template_json);
+
+    /**
+     * @brief Substitutes values for the placeholders of a compiled template.
+     * @details Only the operands of the tests are replaced, so binding costs a copy of the
+     * compiled tests rather than a parse of the query.
+     * @param params A document holding the value of each parameter under its name.
+     * @return The query `compile` would produce from the template with the values written in, or
+     *         `std::nullopt` if a parameter is missing or its value is not a scalar its test can
+     *         take, in which case the caller compiles the bound query itself.
+     */
+    [[nodiscard]] std::optional<Matcher> bind(const Document &params) const;
+
+    /**
+     * @brief Evaluates the query against a document.
+     * @details The document's fields are read in place; nothing is copied or allocated. If a
+     * document repeats a field, its last occurrence is used, as the Rust decoder does.
+     * @param doc The document, typically owned by the primary index.
+     * @return `true` if the document satisfies the query.
+     */
+    [[nodiscard]] bool matches(const Document &doc) const;
+
+    /**
+     * @brief Returns whether the query matches every document, as an empty query does.
+     * @return `true` if `matches` never returns `false`.
+     */
+    [[nodiscard]] bool matches_everything() const noexcept { return kind_ == Kind::ALL; }
+
+  private:
+    /// The overall shape of a compiled query.
+    enum class Kind : uint8_t { ALL, NOTHING, FIELDS };
+
+    /// The kind of JSON value a BSON element decodes to; see `classify`.
+    enum class ValueClass : uint8_t { NUL, BOOL, INTEGER, FLOAT, STRING, ARRAY, OBJECT };
+
+    /// The kind of a compiled condition.
+    enum class TestType : uint8_t {
+        EQUALS,
+        NOT_EQUALS,
+        COMPARE_NUMBER,
+        COMPARE_STRING,
+        IS_TYPE,
+        CONTAINS_ALL,
+        IN
+    };
+
+    /// A relational operator.
+    enum class Relation : uint8_t { GT, GTE, LT, LTE };
+
+    /**
+     * @struct Scalar
+     * @brief A scalar operand of the query, or a stored value as the Rust decoder sees it.
+     */
+    struct Scalar {
+        /// The kind of value; `ARRAY` and `OBJECT` carry no contents.
+        ValueClass cls = ValueClass::NUL;
+        /// The value of a `BOOL`.
+        bool boolean = false;
+        /// The value of an `INTEGER` that fits in an `int64_t`.
+        int64_t integer = 0;
+        /// `true` for an `INTEGER` above `INT64_MAX`, which no stored integer can equal.
+        bool integer_overflows = false;
+        /// The value of a `FLOAT`, or of an `INTEGER` converted to `double`.
+        double number = 0.0;
+        /// The value of a stored `STRING`, pointing into the document. The string operand of a
+        /// `Test` is held in `Test::text` instead.
+        std::string_view string;
+    };
+
+    /**
+     * @struct Test
+     * @brief One compiled condition on the value of a field.
+     */
+    struct Test {
+        /// The kind of condition.
+        TestType type = TestType::EQUALS;
+        /// The operator of a `COMPARE_*` test.
+        Relation relation = Relation::GT;
+        /// The operand of an `EQUALS`, `NOT_EQUALS`, or `COMPARE_*` test.
+        Scalar operand;
+        /// The value of a `STRING` operand.
+        std::string text;
+        /// For an `IS_TYPE` test, the accepted `ValueClass`es as a bit mask.
+        uint8_t type_mask = 0;
+        /// For a `CONTAINS_ALL` test, one `EQUALS` test per element the array must hold. For an
+        /// `IN` test, one per element the value may equal, sorted by `compare_scalars`.
+        std::vector<Test> elements;
+        /// The index in `parameters_` of the placeholder supplying `operand`, or -1 if the
+        /// operand was given in the query.
+        int32_t parameter = -1;
+    };
+
+    /**
+     * @struct FieldTests
+     * @brief The conditions on one field, which must be present and satisfy all.
+     */
+    struct FieldTests {
+        /// The field name, or a dotted path.
+        std::string field;
+        /// The names along `field`, split at its dots.
+        std::vector<std::string> path;
+        /// The conditions.
+        std::vector<Test> tests;
+    };
+
+    /// The result of compiling part of a query.
+    enum class Outcome : uint8_t { OK, NOTHING, UNSUPPORTED };
+
+    Matcher() = default;
+
+    /**
+     * @brief Compiles a query or, if `parameters` is given, a query template.
+     * @param query_json The query.
+     * @param parameters Receives the names of the template's placeholders, or `nullptr` to
+     *        compile a plain query.
+     * @return The compiled query, or `std::nullopt` if the Rust engine must evaluate it.
+     */
+    [[nodiscard]] static std::optional<Matcher> compile(std::string_view query_json,
+                                                        std::vector<std::string> *parameters);
+
+    /**
+     * @brief Reads a BSON element as the Rust decoder would see it.
+     * @param iter An iterator positioned on the element.
+     * @return The element's value class and, for a scalar, its value.
+     */
+    [[nodiscard]] static Scalar classify(const bson_iter_t &iter);
+
+    /**
+     * @brief Evaluates one condition against a stored value.
+     * @param test The condition.
+     * @param value The value, as returned by `classify`.
+     * @return `true` if the value satisfies the condition.
+     */
+    [[nodiscard]] static bool evaluate(const Test &test, const Scalar &value);
+
+    /**
+     * @brief Evaluates a `CONTAINS_ALL` test against a stored value.
+     * @param test The test.
+     * @param value An iterator positioned on the value.
+     * @return `true` if the value is an array holding an element equal to each of the test's.
+     */
+    [[nodiscard]] static bool contains_all(const Test &test, const bson_iter_t &value);
+
+    /**
+     * @brief Evaluates an `IN` test against a stored value.
+     * @param test The test.
+     * @param value The value, as returned by `classify`.
+     * @return `true` if the value equals one of the test's elements.
+     */
+    [[nodiscard]] static bool is_in(const Test &test, const Scalar &value);
+
+    /**
+     * @brief Orders two scalars by value class, then by value.
+     * @details A stored value is equivalent to an operand under this order exactly when
+     * `equals_operand` holds for them. Integers above `INT64_MAX` sort after all others.
+     * @param a The first scalar.
+     * @param a_text The value of `a` if it is a string.
+     * @param b The second scalar.
+     * @param b_text The value of `b` if it is a string.
+     * @return A negative value, zero, or a positive value as `a` sorts before, with, or after `b`.
+     */
+    [[nodiscard]] static int compare_scalars(const Scalar &a, std::string_view a_text,
+                                             const Scalar &b, std::string_view b_text);
+
+    /**
+     * @brief Locates the value of a field in a document.
+     * @param raw The document.
+     * @param path The names along the field's path.
+     * @param value Receives an iterator positioned on the value.
+     * @return `true` if the path leads to a value through embedded documents.
+     */
+    [[nodiscard]] static bool find_value(const bson_t *raw, const std::vector<std::string> &path,
+                                         bson_iter_t &value);
+
+    /**
+     * @brief Returns whether a stored value equals the operand of a test as `serde_json::Value`s.
+     * @param test The test whose operand is compared.
+     * @param value The stored value, as returned by `classify`.
+     * @return `true` if both have the same value class and value.
+     */
+    [[nodiscard]] static bool equals_operand(const Test &test, const Scalar &value);
+
+    /// The overall shape of the query.
+    Kind kind_ = Kind::ALL;
+    /// The conditions of a `FIELDS` query.
+    std::vector<FieldTests> fields_;
+    /// The names of the placeholders of a compiled template, by `Test::parameter`.
+    std::vector<std::string> parameters_;
+
+    /// Builds `Matcher`s from parsed JSON; defined in `matcher.cpp`.
+    friend struct MatcherCompiler;
+};
+
+}  // namespace aevum::bson::doc
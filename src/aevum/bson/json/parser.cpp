@@ -13,10 +13,141 @@
 
 #include <bson/bson.h>
 
+#include <cstdint>
+#include <limits>
+#include <string>
+
 #include "aevum/util/log/logger.hpp"
 
 namespace aevum::bson::json {
 
+namespace {
+
+/**
+ * @brief Checks whether a DOM value can be converted without libbson's JSON reader.
+ * @param element The value to check, with everything nested in it.
+ * @return `false` if the value holds an integer beyond Int64, a key containing NUL, or a key
+ *         starting with `$`, which libbson gives a special meaning.
+ */
+bool is_plain_dom(const simdjson::dom::element &element) {
+    switch (element.type()) {
+        case simdjson::dom::element_type::OBJECT: {
+            simdjson::dom::object object;
+            if (element.get_object().get(object) != simdjson::SUCCESS) return false;
+            for (auto field : object) {
+                if (!field.key.empty() && field.key.front() == '$') return false;
+                if (field.key.find('\0') != std::string_view::npos) return false;
+                if (!is_plain_dom(field.value)) return false;
+            }
+            return true;
+        }
+        case simdjson::dom::element_type::ARRAY: {
+            simdjson::dom::array array;
+            if (element.get_array().get(array) != simdjson::SUCCESS) return false;
+            for (auto value : array) {
+                if (!is_plain_dom(value)) return false;
+            }
+            return true;
+        }
+        case simdjson::dom::element_type::UINT64:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool append_dom_members(bson_t *bson, const simdjson::dom::object &object);
+bool append_dom_items(bson_t *bson, const simdjson::dom::array &array);
+
+/**
+ * @brief Appends a DOM value accepted by `is_plain_dom` to a BSON document.
+ * @param bson The document to append to.
+ * @param key The key of the element.
+ * @param element The value.
+ * @return `false` if libbson refused the element, which happens when the document grows too large.
+ */
+bool append_dom_value(bson_t *bson, std::string_view key, const simdjson::dom::element &element) {
+    const char *k = key.data();
+    const int k_len = static_cast<int>(key.size());
+    switch (element.type()) {
+        case simdjson::dom::element_type::OBJECT: {
+            simdjson::dom::object object;
+            bson_t child;
+            return element.get_object().get(object) == simdjson::SUCCESS &&
+                   bson_append_document_begin(bson, k, k_len, &child) &&
+                   append_dom_members(&child, object) &&
+                   bson_append_document_end(bson, &child);
+        }
+        case simdjson::dom::element_type::ARRAY: {
+            simdjson::dom::array array;
+            bson_t child;
+            return element.get_array().get(array) == simdjson::SUCCESS &&
+                   bson_append_array_begin(bson, k, k_len, &child) &&
+                   append_dom_items(&child, array) && bson_append_array_end(bson, &child);
+        }
+        case simdjson::dom::element_type::STRING: {
+            std::string_view value;
+            return element.get_string().get(value) == simdjson::SUCCESS &&
+                   bson_append_utf8(bson, k, k_len, value.data(), static_cast<int>(value.size()));
+        }
+        case simdjson::dom::element_type::INT64: {
+            int64_t value = 0;
+            if (element.get_int64().get(value) != simdjson::SUCCESS) return false;
+            if (value >= std::numeric_limits<int32_t>::min() &&
+                value <= std::numeric_limits<int32_t>::max()) {
+                return bson_append_int32(bson, k, k_len, static_cast<int32_t>(value));
+            }
+            return bson_append_int64(bson, k, k_len, value);
+        }
+        case simdjson::dom::element_type::DOUBLE: {
+            double value = 0.0;
+            return element.get_double().get(value) == simdjson::SUCCESS &&
+                   bson_append_double(bson, k, k_len, value);
+        }
+        case simdjson::dom::element_type::BOOL: {
+            bool value = false;
+            return element.get_bool().get(value) == simdjson::SUCCESS &&
+                   bson_append_bool(bson, k, k_len, value);
+        }
+        case simdjson::dom::element_type::NULL_VALUE:
+            return bson_append_null(bson, k, k_len);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Appends every member of a DOM object to a BSON document, in order.
+ * @param bson The document to append to.
+ * @param object The object whose members are appended.
+ * @return `false` if any member could not be appended.
+ */
+bool append_dom_members(bson_t *bson, const simdjson::dom::object &object) {
+    for (auto field : object) {
+        if (!append_dom_value(bson, field.key, field.value)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends every item of a DOM array to a BSON array, keyed `"0"`, `"1"`, and so on.
+ * @param bson The array to append to.
+ * @param array The array whose items are appended.
+ * @return `false` if any item could not be appended.
+ */
+bool append_dom_items(bson_t *bson, const simdjson::dom::array &array) {
+    uint32_t index = 0;
+    for (auto value : array) {
+        char buffer[16];
+        const char *key = nullptr;
+        size_t key_len = bson_uint32_to_string(index++, &key, buffer, sizeof buffer);
+        if (!append_dom_value(bson, std::string_view(key, key_len), value)) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 /**
  * @brief Parses a JSON string and converts it into a BSON document.
  * @details This function serves as the primary deserialization mechanism from JSON to BSON.
@@ -47,7 +178,7 @@ aevum::util::Status parse(std::string_view json_str, aevum::bson::doc::Document
             "BSON-JSON-Parser: Failed to parse JSON string. Error in domain " +
             std::to_string(error.domain) + " with code " + std::to_string(error.code) + ": " +
             error.message;
-        aevum::util::log::Logger::warn(error_message);
+        AEVUM_LOG_WARN(error_message);
         return aevum::util::Status::InvalidArgument(error.message);
     }
 
@@ -55,4 +186,29 @@ aevum::util::Status parse(std::string_view json_str, aevum::bson::doc::Document
     return aevum::util::Status::OK();
 }
 
+/**
+ * @brief Converts a parsed `simdjson` DOM element into a BSON document.
+ * @details The element is checked with `is_plain_dom` first, so a document is either built
+ * entirely from the DOM or entirely by `parse`, and never partially by both.
+ * @param element The parsed JSON value.
+ * @param[out] doc Receives the BSON document on success.
+ * @return `aevum::util::Status::OK()` on success, or `aevum::util::Status::InvalidArgument`.
+ */
+aevum::util::Status from_dom(const simdjson::dom::element &element,
+                             aevum::bson::doc::Document &doc) {
+    simdjson::dom::object object;
+    if (element.get_object().get(object) != simdjson::SUCCESS || !is_plain_dom(element)) {
+        return parse(simdjson::to_string(element), doc);
+    }
+
+    bson_t *b = bson_new();
+    if (!append_dom_members(b, object)) {
+        bson_destroy(b);
+        AEVUM_LOG_WARN("BSON-JSON-Parser: Document exceeds the maximum BSON size.");
+        return aevum::util::Status::InvalidArgument("Document exceeds the maximum BSON size");
+    }
+    doc = aevum::bson::doc::Document(b);
+    return aevum::util::Status::OK();
+}
+
 }  // namespace aevum::bson::json
@@ -13,6 +13,8 @@
  */
 #pragma once
 
+#include <simdjson.h>
+
 #include <string_view>
 
 #include "aevum/bson/doc/document.hpp"
@@ -51,4 +53,25 @@ namespace aevum::bson::json {
  */
 [[nodiscard]] aevum::util::Status parse(std::string_view json, aevum::bson::doc::Document &out_doc);
 
+/**
+ * @brief Converts an already parsed `simdjson` DOM element into a BSON `Document`.
+ *
+ * @details The server parses every request with `simdjson`; this builds the BSON of a document
+ * carried by the request straight from that DOM, instead of serializing it back to JSON text for
+ * `parse` to read a second time. The result is the same as `parse` on the element's JSON:
+ * integers that fit become Int32 and the others Int64, other numbers become doubles, and
+ * repeated keys are kept in order.
+ *
+ * Anything the direct conversion does not model is handed to `parse` instead: a root that is not
+ * an object, integers beyond the range of Int64, keys containing NUL, and keys starting with `$`,
+ * which libbson reads as extended JSON type wrappers such as `{"$date": ...}`.
+ *
+ * @param element The parsed JSON value; the parser that produced it must still be alive.
+ * @param out_doc An output parameter that receives the BSON document on success.
+ * @return Returns `Status::OK()` on success.
+ * @return On failure, returns `Status::InvalidArgument` with a description of the problem.
+ */
+[[nodiscard]] aevum::util::Status from_dom(const simdjson::dom::element &element,
+                                           aevum::bson::doc::Document &out_doc);
+
 }  // namespace aevum::bson::json
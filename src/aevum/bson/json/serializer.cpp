@@ -5,38 +5,378 @@
 /**
  * @file serializer.cpp
  * @brief Implements the BSON-to-JSON serialization functionality.
- * @details This file contains the implementation for converting a `bson_t` object,
- * as wrapped by the `aevum::bson::doc::Document` class, into its canonical
- * string representation in standard (relaxed) JSON format.
+ * @details Documents are written straight into the caller's string by a serializer of its own,
+ * which produces the Relaxed Extended JSON of libbson's `bson_as_relaxed_extended_json` for the
+ * types the engine stores: strings, numbers, booleans, nulls, nested documents and arrays,
+ * ObjectIds, and dates. Strings are scanned 16 bytes at a time for the bytes that need escaping
+ * and copied in runs, and numbers are formatted with `std::to_chars`. A document holding any
+ * other type, or a string that is not valid UTF-8, is handed to libbson instead, so the output
+ * of the rare cases is libbson's own.
  */
 #include "aevum/bson/json/serializer.hpp"
 
 #include <bson/bson.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <ctime>
 #include <memory>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "aevum/util/log/logger.hpp"
 
 namespace aevum::bson::json {
 
+namespace {
+
+/// The lowercase hexadecimal digits.
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+/// The last millisecond of year 9999, beyond which relaxed dates are written as numbers.
+constexpr int64_t MAX_ISO_DATE_MS = 253402300799999LL;
+
+/**
+ * @brief Returns the length of the leading run of bytes that are copied to JSON unchanged.
+ * @details A byte ends the run if it is a control character, a quote, a backslash, or not ASCII.
+ * With SSE2 the bytes are tested 16 at a time: one signed comparison with 0x20 catches both the
+ * control characters and the bytes from 0x80 up, which are negative as signed bytes.
+ * @param data The bytes.
+ * @param size The number of bytes.
+ * @return The length of the run.
+ */
+size_t plain_prefix(const char *data, size_t size) noexcept {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(0x20);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i special = _mm_or_si128(_mm_cmplt_epi8(bytes, space),
+                                       _mm_or_si128(_mm_cmpeq_epi8(bytes, quote),
+                                                    _mm_cmpeq_epi8(bytes, backslash)));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+#endif
+    for (; i < size; ++i) {
+        auto c = static_cast<unsigned char>(data[i]);
+        if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\') break;
+    }
+    return i;
+}
+
+/**
+ * @brief Returns the length of a well-formed UTF-8 sequence.
+ * @details Overlong encodings, surrogates, and code points above U+10FFFF are rejected.
+ * @param data The bytes, starting at a byte from 0x80 up.
+ * @param size The number of bytes available.
+ * @return The length of the sequence, 2 to 4, or 0 if it is malformed.
+ */
+size_t utf8_sequence(const unsigned char *data, size_t size) noexcept {
+    unsigned char lead = data[0];
+    size_t length = 0;
+    uint32_t code = 0;
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+        code = lead & 0x1fU;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        code = lead & 0x0fU;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        code = lead & 0x07U;
+    } else {
+        return 0;
+    }
+    if (length > size) return 0;
+    for (size_t i = 1; i < length; ++i) {
+        if ((data[i] & 0xc0U) != 0x80U) return 0;
+        code = (code << 6) | (data[i] & 0x3fU);
+    }
+    if ((length == 3 && code < 0x800) || (length == 4 && code < 0x10000) || code > 0x10ffff ||
+        (code >= 0xd800 && code <= 0xdfff)) {
+        return 0;
+    }
+    return length;
+}
+
+/**
+ * @brief Appends a string as a quoted JSON string.
+ * @details Quotes, backslashes, and control characters are escaped as libbson escapes them; the
+ * runs between them are appended whole.
+ * @param text The string.
+ * @param out The string to append to.
+ * @return `false` if `text` is not valid UTF-8; `out` is then partly written.
+ */
+bool append_quoted(std::string_view text, std::string &out) {
+    out += '"';
+    const char *data = text.data();
+    size_t size = text.size();
+    size_t i = 0;
+    while (i < size) {
+        size_t run = plain_prefix(data + i, size - i);
+        out.append(data + i, run);
+        i += run;
+        if (i == size) break;
+        auto c = static_cast<unsigned char>(data[i]);
+        if (c >= 0x80) {
+            size_t length = utf8_sequence(reinterpret_cast<const unsigned char *>(data + i),
+                                          size - i);
+            if (length == 0) return false;
+            out.append(data + i, length);
+            i += length;
+            continue;
+        }
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default: {
+                const char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4],
+                                        HEX_DIGITS[c & 0x0f]};
+                out.append(escape, sizeof(escape));
+                break;
+            }
+        }
+        ++i;
+    }
+    out += '"';
+    return true;
+}
+
+/**
+ * @brief Appends an integer in decimal.
+ * @param value The integer.
+ * @param out The string to append to.
+ */
+void append_integer(int64_t value, std::string &out) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+/**
+ * @brief Appends a double as Relaxed Extended JSON.
+ * @details A finite value is written in its shortest form that reads back exactly, with `.0`
+ * added when the form would otherwise read as an integer. NaN and the infinities, which JSON has
+ * no numbers for, are wrapped in `$numberDouble`.
+ * @param value The double.
+ * @param out The string to append to.
+ */
+void append_double(double value, std::string &out) {
+    if (std::isnan(value)) {
+        out += R"({ "$numberDouble" : "NaN" })";
+        return;
+    }
+    if (std::isinf(value)) {
+        out += value > 0 ? R"({ "$numberDouble" : "Infinity" })"
+                         : R"({ "$numberDouble" : "-Infinity" })";
+        return;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    std::string_view digits(buffer, static_cast<size_t>(result.ptr - buffer));
+    out.append(digits);
+    if (digits.find_first_not_of("0123456789-") == std::string_view::npos) out += ".0";
+}
+
+/**
+ * @brief Appends a number of digits of a value, zero-padded.
+ * @param value The value.
+ * @param width The number of digits.
+ * @param out The string to append to.
+ */
+void append_padded(int64_t value, int width, std::string &out) {
+    char buffer[8];
+    for (int i = width - 1; i >= 0; --i) {
+        buffer[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(buffer, static_cast<size_t>(width));
+}
+
+/**
+ * @brief Appends a date as Relaxed Extended JSON.
+ * @details Dates from 1970 to 9999 are written as ISO-8601 strings in UTC, with milliseconds
+ * only when there are any; others as `$numberLong` milliseconds.
+ * @param ms The milliseconds since the Unix epoch.
+ * @param out The string to append to.
+ */
+void append_date(int64_t ms, std::string &out) {
+    if (ms < 0 || ms > MAX_ISO_DATE_MS) {
+        out += R"({ "$date" : { "$numberLong" : ")";
+        append_integer(ms, out);
+        out += R"(" } })";
+        return;
+    }
+    time_t seconds = static_cast<time_t>(ms / 1000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    out += R"({ "$date" : ")";
+    append_padded(utc.tm_year + 1900, 4, out);
+    out += '-';
+    append_padded(utc.tm_mon + 1, 2, out);
+    out += '-';
+    append_padded(utc.tm_mday, 2, out);
+    out += 'T';
+    append_padded(utc.tm_hour, 2, out);
+    out += ':';
+    append_padded(utc.tm_min, 2, out);
+    out += ':';
+    append_padded(utc.tm_sec, 2, out);
+    if (int64_t millis = ms % 1000; millis != 0) {
+        out += '.';
+        append_padded(millis, 3, out);
+    }
+    out += R"(Z" })";
+}
+
+bool append_container(const uint8_t *data, uint32_t length, bool array, std::string &out);
+
 /**
- * @brief Converts a BSON document into its canonical JSON string representation.
- * @details This function serves as the primary serialization mechanism from BSON to JSON.
- * It leverages the `bson_as_canonical_extended_json` function from the underlying
- * `libbson` library, which produces a standardized, human-readable JSON string.
- * The memory allocated by `libbson` for the resulting string is safely managed using
- * a `std::unique_ptr` with a custom deleter (`bson_free`), ensuring that there are
- * no memory leaks even in the case of exceptions.
- *
+ * @brief Appends the value an iterator is on as Relaxed Extended JSON.
+ * @param iter The iterator.
+ * @param out The string to append to.
+ * @return `false` if the value is of a type the serializer leaves to libbson, or holds a string
+ *         that is not valid UTF-8.
+ */
+bool append_value(const bson_iter_t &iter, std::string &out) {
+    switch (bson_iter_type(&iter)) {
+        case BSON_TYPE_UTF8: {
+            uint32_t length = 0;
+            const char *text = bson_iter_utf8(&iter, &length);
+            return append_quoted(std::string_view(text, length), out);
+        }
+        case BSON_TYPE_INT32:
+            append_integer(bson_iter_int32(&iter), out);
+            return true;
+        case BSON_TYPE_INT64:
+            append_integer(bson_iter_int64(&iter), out);
+            return true;
+        case BSON_TYPE_DOUBLE:
+            append_double(bson_iter_double(&iter), out);
+            return true;
+        case BSON_TYPE_BOOL:
+            out += bson_iter_bool(&iter) ? "true" : "false";
+            return true;
+        case BSON_TYPE_NULL:
+            out += "null";
+            return true;
+        case BSON_TYPE_DOCUMENT:
+        case BSON_TYPE_ARRAY: {
+            uint32_t length = 0;
+            const uint8_t *data = nullptr;
+            bool array = bson_iter_type(&iter) == BSON_TYPE_ARRAY;
+            if (array) {
+                bson_iter_array(&iter, &length, &data);
+            } else {
+                bson_iter_document(&iter, &length, &data);
+            }
+            return append_container(data, length, array, out);
+        }
+        case BSON_TYPE_OID: {
+            char hex[25];
+            bson_oid_to_string(bson_iter_oid(&iter), hex);
+            out += R"({ "$oid" : ")";
+            out.append(hex, 24);
+            out += R"(" })";
+            return true;
+        }
+        case BSON_TYPE_DATE_TIME:
+            append_date(bson_iter_date_time(&iter), out);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Appends a document or an array as Relaxed Extended JSON, spaced as libbson spaces it.
+ * @param data The BSON of the container.
+ * @param length The length of the BSON.
+ * @param array `true` to write an array, whose keys are dropped.
+ * @param out The string to append to.
+ * @return `false` if an element cannot be written; `out` is then partly written.
+ */
+bool append_container(const uint8_t *data, uint32_t length, bool array, std::string &out) {
+    bson_iter_t iter;
+    if (!bson_iter_init_from_data(&iter, data, length)) return false;
+    out += array ? "[ " : "{ ";
+    bool first = true;
+    while (bson_iter_next(&iter)) {
+        if (!first) out += ", ";
+        first = false;
+        if (!array) {
+            uint32_t key_length = bson_iter_key_len(&iter);
+            if (!append_quoted(std::string_view(bson_iter_key(&iter), key_length), out)) {
+                return false;
+            }
+            out += " : ";
+        }
+        if (!append_value(iter, out)) return false;
+    }
+    out += array ? " ]" : " }";
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Converts a BSON document into its Relaxed Extended JSON string representation.
  * @param doc The `aevum::bson::doc::Document` to be serialized.
  * @return A `std::string` containing the JSON representation of the document. If the
  *         input document is empty or if the serialization process fails, an empty
  *         JSON object `"{}"` is returned as a safe fallback.
  */
 std::string to_string(const aevum::bson::doc::Document &doc) {
+    std::string json;
+    append_json(doc, json);
+    return json;
+}
+
+/**
+ * @brief Appends the JSON representation of a BSON document to a string.
+ * @details The document is written in place by the serializer of this file. If it holds
+ * anything the serializer leaves to libbson, what was written is dropped and the string from
+ * `bson_as_relaxed_extended_json` is copied in instead; an empty document or a failed
+ * serialization appends `"{}"`, as `to_string` returns.
+ * @param doc The `aevum::bson::doc::Document` to be serialized.
+ * @param out The string the JSON is appended to.
+ */
+void append_json(const aevum::bson::doc::Document &doc, std::string &out) {
     if (doc.empty() || !doc.get()) {
-        return "{}";
+        out += "{}";
+        return;
     }
 
+    size_t start = out.size();
+    if (append_container(bson_get_data(doc.get()), doc.get()->len, false, out)) return;
+    out.resize(start);
+
     size_t len;
     // Use a smart pointer with a custom deleter to ensure the C-style string from bson_as_json is
     // always freed.
@@ -44,13 +384,14 @@ std::string to_string(const aevum::bson::doc::Document &doc) {
         bson_as_relaxed_extended_json(doc.get(), &len), &bson_free);
 
     if (!json_str) {
-        aevum::util::log::Logger::error(
+        AEVUM_LOG_ERROR(
             "BSON-JSON-Serializer: Failed to serialize BSON Document to JSON string. The operation "
             "returned a null pointer.");
-        return "{}";  // Return an empty JSON object on failure.
+        out += "{}";  // Append an empty JSON object on failure.
+        return;
     }
 
-    return {json_str.get(), len};
+    out.append(json_str.get(), len);
 }
 
 }  // namespace aevum::bson::json
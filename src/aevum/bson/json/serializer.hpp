@@ -21,9 +21,9 @@ namespace aevum::bson::json {
 /**
  * @brief Serializes a BSON `Document` into its Relaxed Extended JSON string representation.
  *
- * @details This function provides a safe and convenient C++ wrapper for `libbson`'s serialization
- * capabilities. It takes a BSON `Document` and converts its binary data into a human-readable
- * string. The function specifically uses the "Relaxed Extended JSON" format, which balances
+ * @details This function converts a BSON `Document`'s binary data into a human-readable string,
+ * with the text libbson's `bson_as_relaxed_extended_json` produces but without its intermediate
+ * buffer. The function specifically uses the "Relaxed Extended JSON" format, which balances
  * readability with type fidelity. This format represents standard JSON types (strings, numbers,
  * booleans) directly, while using a special `{"$type": "value"}` syntax for BSON-specific types
  * (e.g., `{"$oid": "..."}` for ObjectIds, `{"$date": {"$numberLong": "..."}}` for UTC datetimes).
@@ -37,4 +37,17 @@ namespace aevum::bson::json {
  */
 [[nodiscard]] std::string to_string(const aevum::bson::doc::Document &doc);
 
+/**
+ * @brief Appends the Relaxed Extended JSON of a BSON `Document` to a string.
+ *
+ * @details This produces the same text as `to_string`, written straight into `out`: strings are
+ * escaped in runs and numbers formatted in place, with no allocation beyond the growth of `out`.
+ * Callers that assemble many documents into one message, such as a result set, reserve `out`
+ * once and write the whole message, envelope included, in one pass.
+ *
+ * @param doc The document to serialize.
+ * @param out The string to append to.
+ */
+void append_json(const aevum::bson::doc::Document &doc, std::string &out);
+
 }  // namespace aevum::bson::json
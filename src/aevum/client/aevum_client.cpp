@@ -11,8 +11,46 @@
  */
 #include "aevum/client/aevum_client.hpp"
 
+#include <bson/bson.h>
+
+#include "aevum/bson/builder.hpp"
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "simdjson.h"
+
 namespace aevum::client {
 
+namespace {
+
+/**
+ * @brief Checks whether a response is a replica's refusal of a read it is too stale to serve.
+ * @param response The JSON response.
+ * @return `true` if the response carries `"code":"stale_replica"`.
+ */
+bool is_stale_replica_response(std::string_view response) {
+    if (response.find("stale_replica") == std::string_view::npos) return false;
+    simdjson::dom::parser parser;
+    simdjson::dom::element reply;
+    std::string_view code;
+    return parser.parse(response).get(reply) == simdjson::SUCCESS &&
+           reply["code"].get_string().get(code) == simdjson::SUCCESS && code == "stale_replica";
+}
+
+/**
+ * @brief Checks whether a response reports success.
+ * @param response The JSON response.
+ * @return `true` if the response carries `"status":"ok"`.
+ */
+bool is_ok_response(std::string_view response) {
+    simdjson::dom::parser parser;
+    simdjson::dom::element reply;
+    std::string_view status;
+    return parser.parse(response).get(reply) == simdjson::SUCCESS &&
+           reply["status"].get_string().get(status) == simdjson::SUCCESS && status == "ok";
+}
+
+}  // namespace
+
 /**
  * @brief Constructs an `AevumClient` instance, initializing connection parameters and credentials.
  * @details This constructor initializes the underlying `net::client::Connection` object with the
@@ -39,30 +77,135 @@ bool AevumClient::connect() { return conn_.connect_server(); }
  */
 void AevumClient::disconnect() {
     if (conn_.is_connected()) {
-        (void)conn_.send_request(build_payload("exit", "", ""));
+        (void)exchange(build_payload("exit", "", ""));
         conn_.disconnect_server();
     }
 }
 
 /**
- * @brief A private helper to construct the standardized JSON payload for any request.
+ * @brief Switches the connection to the binary BSON protocol.
+ * @return `true` if the server accepted the protocol.
+ */
+bool AevumClient::use_bson_protocol() { return conn_.negotiate_bson(); }
+
+/**
+ * @brief Negotiates compression with the default threshold and zstd level.
+ * @param compressor The compressor.
+ * @param dictionary A zstd dictionary, or empty.
+ * @return `true` if the server agreed.
+ */
+bool AevumClient::use_compression(net::WireCompressor compressor, std::string_view dictionary) {
+    return conn_.negotiate_compression(compressor, 1024, 3, dictionary);
+}
+
+/**
+ * @brief Configures where reads go.
+ * @details The replicas are created unconnected; each connects on its first read.
+ * @param preference Where reads go.
+ * @param replicas The host and port of each replica.
+ * @param max_staleness_ms The staleness a read accepts, in milliseconds, or 0.
+ */
+void AevumClient::set_read_preference(ReadPreference preference,
+                                      const std::vector<std::pair<std::string, int>> &replicas,
+                                      int64_t max_staleness_ms) {
+    read_preference_ = preference;
+    max_staleness_ms_ = max_staleness_ms;
+    replicas_.clear();
+    next_replica_ = 0;
+    for (const auto &[host, port] : replicas) {
+        replicas_.push_back(std::make_unique<AevumClient>(host, port, api_key_));
+    }
+}
+
+/**
+ * @brief Returns the next replica in turn, switched to the BSON protocol if this client is.
+ * @details A replica that refuses the BSON protocol stays on JSON; the string-based reads still
+ * work through it.
+ * @return The replica.
+ */
+AevumClient &AevumClient::next_replica() {
+    AevumClient &replica = *replicas_[next_replica_++ % replicas_.size()];
+    if (conn_.bson_mode() && !replica.conn_.bson_mode()) (void)replica.use_bson_protocol();
+    return replica;
+}
+
+/**
+ * @brief Sends a read request according to the read preference.
+ * @details Each replica is tried at most once, starting with the next in turn. A replica whose
+ * connection failed or that answered `stale_replica` is skipped. With `SECONDARY_PREFERRED` the
+ * primary serves the read if no replica did; with `SECONDARY` the last replica's response is
+ * returned.
+ * @param action The action.
+ * @param collection The target collection name.
+ * @param extra_fields The action-specific fields.
+ * @return The JSON response.
+ */
+std::string AevumClient::read(std::string_view action, std::string_view collection,
+                              const std::string &extra_fields) {
+    if (read_preference_ == ReadPreference::PRIMARY || replicas_.empty() || in_transaction_) {
+        return exchange(build_payload(action, collection, extra_fields));
+    }
+
+    std::string replica_fields = extra_fields;
+    if (max_staleness_ms_ > 0) {
+        replica_fields += R"(,"maxStalenessMs":)" + std::to_string(max_staleness_ms_);
+    }
+    std::string response;
+    for (size_t attempt = 0; attempt < replicas_.size(); ++attempt) {
+        AevumClient &replica = next_replica();
+        response = replica.exchange(replica.build_payload(action, collection, replica_fields));
+        if (replica.conn_.is_connected() && !is_stale_replica_response(response)) return response;
+    }
+    if (read_preference_ == ReadPreference::SECONDARY) return response;
+    return exchange(build_payload(action, collection, extra_fields));
+}
+
+/**
+ * @brief Sends a JSON request in the connection's protocol and returns the JSON response.
+ * @details The connection is established first, so that a reconnect has renegotiated the
+ * protocol before the payload is encoded. Transport errors are reported by the connection as JSON
+ * in either protocol, and are recognized by the connection having been closed.
+ * @param payload The JSON request payload.
+ * @return The JSON response.
+ */
+std::string AevumClient::exchange(std::string_view payload) {
+    if (!conn_.connect_server() || !conn_.bson_mode()) return conn_.send_request(payload);
+
+    aevum::bson::doc::Document request;
+    if (!aevum::bson::json::parse(payload, request).ok()) {
+        return R"({"status":"error","message":"Invalid JSON request"})";
+    }
+    const bson_t *request_bson = request.get();
+    std::string response = conn_.send_request(
+        {reinterpret_cast<const char *>(bson_get_data(request_bson)), request_bson->len});
+    if (!conn_.is_connected()) return response;
+
+    bson_t *reply = bson_new_from_data(reinterpret_cast<const uint8_t *>(response.data()),
+                                       response.size());
+    if (!reply) return R"({"status":"error","message":"Invalid BSON response"})";
+    return aevum::bson::json::to_string(aevum::bson::doc::Document(reply));
+}
+
+/**
+ * @brief Constructs the standardized JSON payload for any request.
  * @details This function is central to client communication. It programmatically builds a JSON
  * string, ensuring all requests adhere to the server's expected format. It always includes the
  * `auth` and `action` fields. The `collection` field and any `extra_fields` are conditionally
  * included only if they are not empty, resulting in a clean and efficient payload.
+ * @param api_key The API key that authenticates the request.
  * @param action The specific database action being requested (e.g., "insert", "find").
  * @param collection The target collection for the action.
  * @param extra_fields A pre-formatted string containing additional JSON key-value pairs specific
  *        to the action (e.g., `"query":{...}, "sort":{...}`).
  * @return A complete, valid JSON payload as a `std::string`.
  */
-std::string AevumClient::build_payload(std::string_view action, std::string_view collection,
-                                       std::string_view extra_fields) const {
+std::string make_request_payload(std::string_view api_key, std::string_view action,
+                                 std::string_view collection, std::string_view extra_fields) {
     std::string payload = "{";
-    payload.reserve(128 + api_key_.length() + action.length() + collection.length() +
+    payload.reserve(128 + api_key.length() + action.length() + collection.length() +
                     extra_fields.length());
 
-    payload += "\"auth\":\"" + api_key_ + "\",";
+    payload += "\"auth\":\"" + std::string(api_key) + "\",";
     payload += "\"action\":\"" + std::string(action) + "\"";
 
     if (!collection.empty()) {
@@ -78,15 +221,50 @@ std::string AevumClient::build_payload(std::string_view action, std::string_view
     return payload;
 }
 
+/**
+ * @brief Constructs the JSON payload of a request authenticated with this client's API key.
+ * @param action The specific database action being requested.
+ * @param collection The target collection for the action.
+ * @param extra_fields Additional, pre-formatted JSON fields.
+ * @return A complete, valid JSON payload as a `std::string`.
+ */
+std::string AevumClient::build_payload(std::string_view action, std::string_view collection,
+                                       std::string_view extra_fields) const {
+    if (!in_transaction_) return make_request_payload(api_key_, action, collection, extra_fields);
+    // A tagged request is refused by a connection without a transaction, so a write is never
+    // applied outside of the transaction it was meant for.
+    std::string fields(extra_fields);
+    if (!fields.empty()) fields += ",";
+    fields += R"("txn":true)";
+    return make_request_payload(api_key_, action, collection, fields);
+}
+
 /**
  * @brief Packages and sends a document insertion request to the server.
  * @param collection The name of the collection into which the document will be inserted.
  * @param doc_json The JSON string of the document to insert.
+ * @param durability The requested durability level, or empty for the server's default.
  * @return The server's response, typically indicating success and the new document's `_id`.
  */
-std::string AevumClient::insert(std::string_view collection, std::string_view doc_json) {
+std::string AevumClient::insert(std::string_view collection, std::string_view doc_json,
+                                std::string_view durability) {
     std::string extra = "\"data\":" + std::string(doc_json);
-    return conn_.send_request(build_payload("insert", collection, extra));
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return exchange(build_payload("insert", collection, extra));
+}
+
+/**
+ * @brief Packages and sends a bulk document insertion request to the server.
+ * @param collection The name of the collection into which the documents will be inserted.
+ * @param docs_json The JSON array of documents to insert.
+ * @param durability The requested durability level, or empty for the server's default.
+ * @return The server's response, holding the inserted count and a result per document.
+ */
+std::string AevumClient::insert_many(std::string_view collection, std::string_view docs_json,
+                                     std::string_view durability) {
+    std::string extra = "\"data\":" + std::string(docs_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return exchange(build_payload("insert_many", collection, extra));
 }
 
 /**
@@ -105,7 +283,240 @@ std::string AevumClient::find(std::string_view collection, std::string_view quer
     extra += R"("limit":)" + std::to_string(limit) + ",";
     extra += R"("skip":)" + std::to_string(skip);
 
-    return conn_.send_request(build_payload("find", collection, extra));
+    return read("find", collection, extra);
+}
+
+/**
+ * @brief Packages and sends a find request that opens a cursor.
+ * @param collection The collection to query.
+ * @param query_json The query filter criteria.
+ * @param batch_size The maximum number of documents per batch.
+ * @param sort_json The sort order specification.
+ * @param limit The maximum number of results over all batches.
+ * @param skip The number of results to skip.
+ * @return The server's response, holding the cursor id and the first batch.
+ */
+std::string AevumClient::open_cursor(std::string_view collection, std::string_view query_json,
+                                     int64_t batch_size, std::string_view sort_json,
+                                     int64_t limit, int64_t skip) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("sort":)" + std::string(sort_json) + ",";
+    extra += R"("limit":)" + std::to_string(limit) + ",";
+    extra += R"("skip":)" + std::to_string(skip) + ",";
+    extra += R"("batchSize":)" + std::to_string(batch_size);
+    return exchange(build_payload("find", collection, extra));
+}
+
+/**
+ * @brief Packages and sends a request for the next batch of a cursor.
+ * @param cursor_id The id of the cursor.
+ * @param batch_size The maximum number of documents in the batch.
+ * @return The server's response, holding the next batch.
+ */
+std::string AevumClient::get_more(int64_t cursor_id, int64_t batch_size) {
+    std::string extra = R"("cursor":)" + std::to_string(cursor_id);
+    if (batch_size > 0) extra += R"(,"batchSize":)" + std::to_string(batch_size);
+    return exchange(build_payload("getMore", "", extra));
+}
+
+/**
+ * @brief Packages and sends a request to discard a cursor.
+ * @param cursor_id The id of the cursor.
+ * @return The server's response.
+ */
+std::string AevumClient::kill_cursor(int64_t cursor_id) {
+    return exchange(build_payload("killCursor", "", R"("cursor":)" + std::to_string(cursor_id)));
+}
+
+/**
+ * @brief Packages and sends a request to prepare a query template.
+ * @param collection The collection to query.
+ * @param query_json The query template.
+ * @param sort_json The sort order specification.
+ * @param projection_json The projection.
+ * @return The server's response, holding the statement id.
+ */
+std::string AevumClient::prepare(std::string_view collection, std::string_view query_json,
+                                 std::string_view sort_json, std::string_view projection_json) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("sort":)" + std::string(sort_json) + ",";
+    extra += R"("projection":)" + std::string(projection_json);
+    return exchange(build_payload("prepare", collection, extra));
+}
+
+/**
+ * @brief Packages and sends a request to run a prepared query.
+ * @param statement The id of the prepared query.
+ * @param params_json The values of the parameters.
+ * @param limit The maximum number of results.
+ * @param skip The number of results to skip.
+ * @return The server's response, holding the results.
+ */
+std::string AevumClient::execute(int64_t statement, std::string_view params_json, int64_t limit,
+                                 int64_t skip) {
+    std::string extra = R"("statement":)" + std::to_string(statement) + ",";
+    extra += R"("params":)" + std::string(params_json) + ",";
+    extra += R"("limit":)" + std::to_string(limit) + ",";
+    extra += R"("skip":)" + std::to_string(skip);
+    return exchange(build_payload("execute", "", extra));
+}
+
+/**
+ * @brief Packages and sends a request to discard a prepared query.
+ * @param statement The id of the prepared query.
+ * @return The server's response.
+ */
+std::string AevumClient::close_statement(int64_t statement) {
+    return exchange(
+        build_payload("closeStatement", "", R"("statement":)" + std::to_string(statement)));
+}
+
+/**
+ * @brief Packages and sends a request for the changes that follow a resume token.
+ * @param after The resume token.
+ * @param collection Only the changes of this collection, or empty for all.
+ * @param limit The most changes returned.
+ * @param max_wait_ms The longest wait for a change, in milliseconds.
+ * @return The server's response.
+ */
+std::string AevumClient::watch(int64_t after, std::string_view collection, int64_t limit,
+                               int64_t max_wait_ms) {
+    std::string extra = R"("after":)" + std::to_string(after) + R"(,"limit":)" +
+                        std::to_string(limit) + R"(,"max_wait_ms":)" +
+                        std::to_string(max_wait_ms);
+    return exchange(build_payload("watch", collection, extra));
+}
+
+/**
+ * @brief Finds documents in a collection and returns them as BSON, routed by the read preference.
+ * @param collection The collection to query.
+ * @param query The query filter criteria.
+ * @param sort The sort order specification.
+ * @param limit The maximum number of results to return.
+ * @param skip The number of results to skip.
+ * @param out Receives the matched documents.
+ * @return The outcome of the request.
+ */
+aevum::util::Status AevumClient::find_documents(std::string_view collection,
+                                                const aevum::bson::doc::Document &query,
+                                                const aevum::bson::doc::Document &sort,
+                                                int64_t limit, int64_t skip,
+                                                std::vector<aevum::bson::doc::Document> &out) {
+    return find_documents(collection, query, sort, aevum::bson::doc::Document(), limit, skip,
+                          out);
+}
+
+/**
+ * @brief Finds documents in a collection, keeping only some of their fields, and returns them as
+ * BSON, routed by the read preference.
+ * @details Follows the same rules as the string-based reads: a replica that fails or is too stale
+ * is skipped, and the primary serves the read under `SECONDARY_PREFERRED` if no replica did.
+ * @param collection The collection to query.
+ * @param query The query filter criteria.
+ * @param sort The sort order specification.
+ * @param projection The fields to include or exclude.
+ * @param limit The maximum number of results to return.
+ * @param skip The number of results to skip.
+ * @param out Receives the matched documents.
+ * @return The outcome of the request.
+ */
+aevum::util::Status AevumClient::find_documents(std::string_view collection,
+                                                const aevum::bson::doc::Document &query,
+                                                const aevum::bson::doc::Document &sort,
+                                                const aevum::bson::doc::Document &projection,
+                                                int64_t limit, int64_t skip,
+                                                std::vector<aevum::bson::doc::Document> &out) {
+    if (read_preference_ == ReadPreference::PRIMARY || replicas_.empty() || in_transaction_) {
+        return fetch_documents(collection, query, sort, projection, limit, skip, 0, out);
+    }
+    aevum::util::Status status;
+    for (size_t attempt = 0; attempt < replicas_.size(); ++attempt) {
+        AevumClient &replica = next_replica();
+        status = replica.fetch_documents(collection, query, sort, projection, limit, skip,
+                                         max_staleness_ms_, out);
+        if (status.ok() || status.code() == aevum::util::StatusCode::kInvalidArgument) {
+            return status;
+        }
+    }
+    if (read_preference_ == ReadPreference::SECONDARY) return status;
+    return fetch_documents(collection, query, sort, projection, limit, skip, 0, out);
+}
+
+/**
+ * @brief Sends a BSON `find` and copies the matched documents out of the response.
+ * @details The request is built directly as BSON. The `data` array of the response holds the
+ * documents as the server stored them; each is copied into its own `Document`.
+ * @param collection The collection to query.
+ * @param query The query filter criteria.
+ * @param sort The sort order specification.
+ * @param projection The fields to include or exclude, or an empty document.
+ * @param limit The maximum number of results to return.
+ * @param skip The number of results to skip.
+ * @param max_staleness_ms The `maxStalenessMs` of the request, or 0 to send none.
+ * @param out Receives the matched documents.
+ * @return The outcome of the request.
+ */
+aevum::util::Status AevumClient::fetch_documents(std::string_view collection,
+                                                 const aevum::bson::doc::Document &query,
+                                                 const aevum::bson::doc::Document &sort,
+                                                 const aevum::bson::doc::Document &projection,
+                                                 int64_t limit, int64_t skip,
+                                                 int64_t max_staleness_ms,
+                                                 std::vector<aevum::bson::doc::Document> &out) {
+    out.clear();
+    if (!conn_.connect_server() || !conn_.bson_mode()) {
+        return aevum::util::Status::NotSupported("find_documents requires the BSON protocol");
+    }
+
+    aevum::bson::Builder builder;
+    builder.append_string("auth", api_key_)
+        .append_string("action", "find")
+        .append_string("collection", collection)
+        .append_document("query", query)
+        .append_document("sort", sort)
+        .append_int64("limit", limit)
+        .append_int64("skip", skip);
+    if (!projection.empty()) builder.append_document("projection", projection);
+    if (max_staleness_ms > 0) builder.append_int64("maxStalenessMs", max_staleness_ms);
+    aevum::bson::doc::Document request = builder.finalize();
+    const bson_t *request_bson = request.get();
+    std::string response = conn_.send_request(
+        {reinterpret_cast<const char *>(bson_get_data(request_bson)), request_bson->len});
+    if (!conn_.is_connected()) return aevum::util::Status::IOError(response);
+
+    bson_t reply;
+    if (!bson_init_static(&reply, reinterpret_cast<const uint8_t *>(response.data()),
+                          response.size())) {
+        return aevum::util::Status::Corruption("Invalid BSON response");
+    }
+    bson_iter_t iter;
+    if (bson_iter_init_find(&iter, &reply, "status") && BSON_ITER_HOLDS_UTF8(&iter) &&
+        std::string_view(bson_iter_utf8(&iter, nullptr)) != "ok") {
+        std::string message = "find failed";
+        if (bson_iter_init_find(&iter, &reply, "message") && BSON_ITER_HOLDS_UTF8(&iter)) {
+            message = bson_iter_utf8(&iter, nullptr);
+        }
+        if (bson_iter_init_find(&iter, &reply, "code") && BSON_ITER_HOLDS_UTF8(&iter) &&
+            std::string_view(bson_iter_utf8(&iter, nullptr)) == "stale_replica") {
+            return aevum::util::Status::IOError(message);
+        }
+        return aevum::util::Status::InvalidArgument(message);
+    }
+
+    bson_iter_t documents;
+    if (!bson_iter_init_find(&iter, &reply, "data") || !BSON_ITER_HOLDS_ARRAY(&iter) ||
+        !bson_iter_recurse(&iter, &documents)) {
+        return aevum::util::Status::Corruption("Response carries no 'data' array");
+    }
+    while (bson_iter_next(&documents)) {
+        if (!BSON_ITER_HOLDS_DOCUMENT(&documents)) continue;
+        uint32_t length = 0;
+        const uint8_t *data = nullptr;
+        bson_iter_document(&documents, &length, &data);
+        bson_t *copy = bson_new_from_data(data, length);
+        if (copy) out.emplace_back(copy);
+    }
+    return aevum::util::Status::OK();
 }
 
 /**
@@ -113,24 +524,45 @@ std::string AevumClient::find(std::string_view collection, std::string_view quer
  * @param collection The collection where the update will occur.
  * @param query_json The filter to select which documents to update.
  * @param update_json The update operations to apply.
+ * @param durability The requested durability level, or empty for the server's default.
  * @return The server's response, typically indicating the number of documents modified.
  */
 std::string AevumClient::update(std::string_view collection, std::string_view query_json,
-                                std::string_view update_json) {
+                                std::string_view update_json, std::string_view durability) {
     std::string extra = R"("query":)" + std::string(query_json) + ",";
     extra += R"("update":)" + std::string(update_json);
-    return conn_.send_request(build_payload("update", collection, extra));
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return exchange(build_payload("update", collection, extra));
+}
+
+/**
+ * @brief Packages and sends an upsert request.
+ * @param collection The collection where the upsert will occur.
+ * @param query_json The filter to select which documents to update.
+ * @param document_json The update, or the document to insert if nothing matches.
+ * @param durability The requested durability level, or empty for the server's default.
+ * @return The server's response, with the number of documents updated or the inserted `_id`.
+ */
+std::string AevumClient::upsert(std::string_view collection, std::string_view query_json,
+                                std::string_view document_json, std::string_view durability) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("data":)" + std::string(document_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return exchange(build_payload("upsert", collection, extra));
 }
 
 /**
  * @brief Packages and sends a document removal request.
  * @param collection The collection from which to remove documents.
  * @param query_json The filter to select which documents to remove.
+ * @param durability The requested durability level, or empty for the server's default.
  * @return The server's response, typically indicating the number of documents removed.
  */
-std::string AevumClient::remove(std::string_view collection, std::string_view query_json) {
+std::string AevumClient::remove(std::string_view collection, std::string_view query_json,
+                                std::string_view durability) {
     std::string extra = R"("query":)" + std::string(query_json);
-    return conn_.send_request(build_payload("delete", collection, extra));
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return exchange(build_payload("delete", collection, extra));
 }
 
 /**
@@ -141,7 +573,114 @@ std::string AevumClient::remove(std::string_view collection, std::string_view qu
  */
 std::string AevumClient::count(std::string_view collection, std::string_view query_json) {
     std::string extra = R"("query":)" + std::string(query_json);
-    return conn_.send_request(build_payload("count", collection, extra));
+    return read("count", collection, extra);
+}
+
+/**
+ * @brief Packages and sends an aggregation request.
+ * @param collection The collection to aggregate.
+ * @param pipeline_json The JSON array of pipeline stages.
+ * @return The server's response.
+ */
+std::string AevumClient::aggregate(std::string_view collection, std::string_view pipeline_json) {
+    std::string extra = R"("pipeline":)" + std::string(pipeline_json);
+    return read("aggregate", collection, extra);
+}
+
+/**
+ * @brief Packages and sends a query plan request.
+ * @param collection The collection the query targets.
+ * @param query_json The filter whose plan should be reported.
+ * @param sort_json The sort order whose plan should be reported.
+ * @return The server's response, containing the chosen plan.
+ */
+std::string AevumClient::explain(std::string_view collection, std::string_view query_json,
+                                 std::string_view sort_json) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("sort":)" + std::string(sort_json);
+    return exchange(build_payload("explain", collection, extra));
+}
+
+/**
+ * @brief Packages and sends an index creation request.
+ * @param collection The collection to index.
+ * @param field The field to index.
+ * @param type The index type ("hash", "ordered", "columnar", or "text").
+ * @param expire_after_seconds The time-to-live of a TTL index, if it is one.
+ * @param sparse `true` for a sparse index.
+ * @param partial_filter_json The filter of a partial index, or empty.
+ * @return The server's response.
+ */
+std::string AevumClient::create_index(std::string_view collection, std::string_view field,
+                                      std::string_view type,
+                                      std::optional<int64_t> expire_after_seconds, bool sparse,
+                                      std::string_view partial_filter_json) {
+    std::string extra = R"("field":")" + std::string(field) + R"(",)";
+    extra += R"("type":")" + std::string(type) + R"(")";
+    if (expire_after_seconds) {
+        extra += R"(,"expire_after_seconds":)" + std::to_string(*expire_after_seconds);
+    }
+    if (sparse) extra += R"(,"sparse":true)";
+    if (!partial_filter_json.empty()) {
+        extra += R"(,"partial_filter":)" + std::string(partial_filter_json);
+    }
+    return exchange(build_payload("create_index", collection, extra));
+}
+
+/**
+ * @brief Starts an online backup of the server's data directory.
+ * @param path The directory on the server to write to.
+ * @param incremental `true` to copy only the blocks modified since the backup in `path`.
+ * @return The server's JSON response.
+ */
+std::string AevumClient::backup(std::string_view path, bool incremental) {
+    // The path is encoded by the serializer, which escapes it, and spliced in without braces.
+    std::string fields = aevum::bson::json::to_string(aevum::bson::Builder()
+                                                          .append_string("path", path)
+                                                          .append_bool("incremental", incremental)
+                                                          .finalize());
+    return exchange(build_payload("backup", "", fields.substr(1, fields.size() - 2)));
+}
+
+/**
+ * @brief Requests the progress of the server's current or last backup.
+ * @return The server's JSON response.
+ */
+std::string AevumClient::backup_status() {
+    return exchange(build_payload("backup_status", "", ""));
+}
+
+/**
+ * @brief Opens a transaction on this client's connection.
+ * @return The server's JSON response.
+ */
+std::string AevumClient::begin_transaction() {
+    std::string response = exchange(build_payload("begin", "", ""));
+    in_transaction_ = is_ok_response(response);
+    return response;
+}
+
+/**
+ * @brief Commits the open transaction. The transaction ends whatever the outcome.
+ * @param durability The requested durability level, or empty for the server's default.
+ * @return The server's JSON response.
+ */
+std::string AevumClient::commit_transaction(std::string_view durability) {
+    std::string extra;
+    if (!durability.empty()) extra = R"("durability":")" + std::string(durability) + "\"";
+    std::string response = exchange(build_payload("commit", "", extra));
+    in_transaction_ = false;
+    return response;
+}
+
+/**
+ * @brief Discards the open transaction.
+ * @return The server's JSON response.
+ */
+std::string AevumClient::abort_transaction() {
+    std::string response = exchange(build_payload("abort", "", ""));
+    in_transaction_ = false;
+    return response;
 }
 
 }  // namespace aevum::client
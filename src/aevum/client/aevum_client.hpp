@@ -13,13 +13,47 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
+#include "aevum/bson/doc/document.hpp"
 #include "aevum/client/net/connection.hpp"
+#include "aevum/util/status.hpp"
 
 namespace aevum::client {
 
+/**
+ * @brief Constructs a standardized JSON request payload.
+ * @details Shared by `AevumClient` and `AsyncAevumClient`. The payload always holds `auth` and
+ * `action`; `collection` and `extra_fields` are included only if they are not empty.
+ * @param api_key The API key that authenticates the request.
+ * @param action The database action (e.g., "insert", "find").
+ * @param collection The target collection name.
+ * @param extra_fields Additional, pre-formatted JSON fields (e.g., `"query":{...}`).
+ * @return A complete JSON request payload.
+ */
+[[nodiscard]] std::string make_request_payload(std::string_view api_key, std::string_view action,
+                                               std::string_view collection,
+                                               std::string_view extra_fields);
+
+/**
+ * @enum ReadPreference
+ * @brief Where an `AevumClient` sends `find`, `count`, and `aggregate` requests.
+ */
+enum class ReadPreference {
+    /// Every request goes to the primary.
+    PRIMARY,
+    /// Reads go to the replicas in turn, and to the primary if none of them can serve one.
+    SECONDARY_PREFERRED,
+    /// Reads go to the replicas only; a read none of them can serve fails.
+    SECONDARY,
+};
+
 /**
  * @class AevumClient
  * @brief Provides a simplified, high-level API for all client-side interactions with an AevumDB
@@ -61,14 +95,69 @@ class AevumClient {
      */
     void disconnect();
 
+    /**
+     * @brief Switches the connection to the binary BSON protocol.
+     * @details Requests and responses then travel as BSON documents. The string-based methods
+     * behave as before: their JSON payloads are converted to BSON before they are sent, and the
+     * responses back to JSON. `find_documents` additionally receives the matched documents
+     * without any JSON conversion.
+     * @return `true` if the server accepted the protocol; otherwise the client stays on JSON.
+     */
+    [[nodiscard]] bool use_bson_protocol();
+
+    /**
+     * @brief Compresses the frames of the connection above a size (see `wire_compression.hpp`).
+     * @details lz4 suits clients that wait on each response, zstd those that move result sets
+     * in bulk, especially with a dictionary trained on their documents that the server holds
+     * too. Like `use_bson_protocol`, it should be called before `login`.
+     * @param compressor The compressor, or `net::WireCompressor::NONE` to stop compressing.
+     * @param dictionary A zstd dictionary made by `zstd --train`, or empty.
+     * @return `true` if the server agreed; otherwise frames are sent uncompressed.
+     */
+    [[nodiscard]] bool use_compression(net::WireCompressor compressor,
+                                       std::string_view dictionary = {});
+
+    /**
+     * @brief Routes reads to read replicas of the server.
+     * @details `find`, `count`, `aggregate`, and `find_documents` are sent to the replicas in
+     * turn, with the same API key and, on a BSON connection, over the BSON protocol. A replica
+     * that cannot be reached, or that is further behind its primary than `max_staleness_ms`, is
+     * skipped. Writes, cursors, and every other request always go to the server the client was
+     * constructed with.
+     * @param preference Where reads go.
+     * @param replicas The host and port of each replica; connected to on first use.
+     * @param max_staleness_ms The staleness a read accepts, in milliseconds, sent as
+     * `maxStalenessMs`; 0 accepts any replica that has caught up once.
+     */
+    void set_read_preference(ReadPreference preference,
+                             const std::vector<std::pair<std::string, int>> &replicas = {},
+                             int64_t max_staleness_ms = 0);
+
     /**
      * @brief Sends a request to insert a new document into a collection.
      * @param collection The name of the target collection.
      * @param doc_json A `std::string_view` containing the JSON representation of the document to
      * insert.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
      * @return A `std::string` containing the raw JSON response from the server.
      */
-    [[nodiscard]] std::string insert(std::string_view collection, std::string_view doc_json);
+    [[nodiscard]] std::string insert(std::string_view collection, std::string_view doc_json,
+                                     std::string_view durability = "");
+
+    /**
+     * @brief Sends a request to insert a batch of documents into a collection in one round-trip.
+     * @details The server validates the batch in parallel and persists it in a single storage
+     * transaction. The response carries the number of inserted documents and, in input order,
+     * the `_id` or error message of every document.
+     * @param collection The name of the target collection.
+     * @param docs_json A JSON string containing an array of the documents to insert.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string insert_many(std::string_view collection, std::string_view docs_json,
+                                          std::string_view durability = "");
 
     /**
      * @brief Sends a request to find documents in a collection based on a complex query.
@@ -85,23 +174,170 @@ class AevumClient {
                                    std::string_view sort_json = "{}", int64_t limit = 0,
                                    int64_t skip = 0);
 
+    /**
+     * @brief Sends a find request that returns its results in batches through a cursor.
+     * @details The response has the form `{"status":"ok", "cursor":<id>, "data":[...]}` and holds
+     * the first batch. While `cursor` is not 0, `get_more` returns the following batches.
+     * Cursors that are not read for `cursorTimeoutSec` are discarded by the server.
+     * @param collection The name of the target collection.
+     * @param query_json The JSON string defining the filter criteria.
+     * @param batch_size The maximum number of documents per batch; must be positive.
+     * @param sort_json The JSON string defining the sort order.
+     * @param limit The maximum number of documents over all batches, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string open_cursor(std::string_view collection,
+                                          std::string_view query_json, int64_t batch_size,
+                                          std::string_view sort_json = "{}", int64_t limit = 0,
+                                          int64_t skip = 0);
+
+    /**
+     * @brief Requests the next batch of a cursor opened by `open_cursor`.
+     * @param cursor_id The id returned by the previous batch.
+     * @param batch_size The maximum number of documents in the batch, or 0 for the server's
+     * default.
+     * @return A `std::string` containing the server's raw JSON response, of the same form as that
+     * of `open_cursor`; `cursor` is 0 once the results are exhausted.
+     */
+    [[nodiscard]] std::string get_more(int64_t cursor_id, int64_t batch_size = 0);
+
+    /**
+     * @brief Discards a cursor that is no longer needed before it is exhausted.
+     * @param cursor_id The id of the cursor.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string kill_cursor(int64_t cursor_id);
+
+    /**
+     * @brief Prepares a query template to be run repeatedly by `execute`.
+     * @details Constants of the template may be placeholders `{"$param": "<name>"}`. The server
+     * parses and compiles the template once, and answers `{"status":"ok", "statement":<id>}`.
+     * @param collection The name of the target collection.
+     * @param query_json The query template.
+     * @param sort_json The sort order.
+     * @param projection_json The projection.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string prepare(std::string_view collection, std::string_view query_json,
+                                      std::string_view sort_json = "{}",
+                                      std::string_view projection_json = "{}");
+
+    /**
+     * @brief Runs a prepared query with a set of parameters.
+     * @details The response has the form of that of `find`. A statement the server no longer
+     * knows, for instance after a restart, is answered with `"code":"unknown_statement"`, upon
+     * which the query must be prepared again.
+     * @param statement The id returned by `prepare`.
+     * @param params_json A JSON object holding the value of each parameter under its name.
+     * @param limit The maximum number of documents to return, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string execute(int64_t statement, std::string_view params_json = "{}",
+                                      int64_t limit = 0, int64_t skip = 0);
+
+    /**
+     * @brief Discards a prepared query that is no longer needed.
+     * @param statement The id returned by `prepare`.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string close_statement(int64_t statement);
+
+    /**
+     * @brief Requests the changes that follow a resume token from the change log.
+     * @details The server holds the request for up to `max_wait_ms` if no change follows `after`
+     * yet, so a consumer tails the log by calling `watch` in a loop with the `resume_token` of
+     * each response.
+     * @param after The resume token: the sequence number of the last change already seen, or 0.
+     * @param collection Only the changes of this collection, or empty for all.
+     * @param limit The most changes returned.
+     * @param max_wait_ms The longest wait for a change, in milliseconds.
+     * @return A `std::string` containing the server's raw JSON response, with the `changes` and
+     * the next `resume_token`.
+     */
+    [[nodiscard]] std::string watch(int64_t after, std::string_view collection = {},
+                                    int64_t limit = 1000, int64_t max_wait_ms = 0);
+
+    /**
+     * @brief Finds documents in a collection and returns them as BSON.
+     * @details Requires the BSON protocol (see `use_bson_protocol`). The server writes the stored
+     * bytes of the matched documents to the socket and the client copies them out of the
+     * response, so neither side converts them to or from JSON.
+     * @param collection The name of the target collection.
+     * @param query The filter criteria.
+     * @param sort The sort order; an empty document for no sort.
+     * @param limit The maximum number of documents to return, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @param out Receives the matched documents, in result order.
+     * @return `OK` on success; `NotSupported` without the BSON protocol; `IOError` if the
+     * request failed; `InvalidArgument` with the server's message if it rejected the query.
+     */
+    [[nodiscard]] aevum::util::Status find_documents(std::string_view collection,
+                                                     const aevum::bson::doc::Document &query,
+                                                     const aevum::bson::doc::Document &sort,
+                                                     int64_t limit, int64_t skip,
+                                                     std::vector<aevum::bson::doc::Document> &out);
+
+    /**
+     * @brief Finds documents in a collection, keeping only some of their fields, and returns them
+     * as BSON.
+     * @details As the overload without a projection; the server applies `projection` before it
+     * writes the documents.
+     * @param collection The name of the target collection.
+     * @param query The filter criteria.
+     * @param sort The sort order; an empty document for no sort.
+     * @param projection The fields to include or exclude; an empty document for whole documents.
+     * @param limit The maximum number of documents to return, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @param out Receives the matched documents, in result order.
+     * @return As the overload without a projection.
+     */
+    [[nodiscard]] aevum::util::Status find_documents(std::string_view collection,
+                                                     const aevum::bson::doc::Document &query,
+                                                     const aevum::bson::doc::Document &sort,
+                                                     const aevum::bson::doc::Document &projection,
+                                                     int64_t limit, int64_t skip,
+                                                     std::vector<aevum::bson::doc::Document> &out);
+
     /**
      * @brief Sends a request to update documents in a collection that match a given query.
      * @param collection The name of the target collection.
      * @param query_json The JSON string defining the filter for documents to be updated.
      * @param update_json The JSON string specifying the update operations to apply.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
      * @return A `std::string` containing the server's raw JSON response.
      */
     [[nodiscard]] std::string update(std::string_view collection, std::string_view query_json,
-                                     std::string_view update_json);
+                                     std::string_view update_json,
+                                     std::string_view durability = "");
+
+    /**
+     * @brief Sends a request to update the documents matching a query, or to insert a document
+     * if none does, as one atomic operation on the server.
+     * @param collection The name of the target collection.
+     * @param query_json The JSON string defining the filter for documents to be updated.
+     * @param document_json The update to apply to the matches, or the document to insert.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
+     * @return A `std::string` containing the server's raw JSON response, with `updated_count` or
+     * `upserted_id`.
+     */
+    [[nodiscard]] std::string upsert(std::string_view collection, std::string_view query_json,
+                                     std::string_view document_json,
+                                     std::string_view durability = "");
 
     /**
      * @brief Sends a request to remove documents from a collection that match a given query.
      * @param collection The name of the target collection.
      * @param query_json The JSON string defining the filter for documents to be removed.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
      * @return A `std::string` containing the server's raw JSON response.
      */
-    [[nodiscard]] std::string remove(std::string_view collection, std::string_view query_json);
+    [[nodiscard]] std::string remove(std::string_view collection, std::string_view query_json,
+                                     std::string_view durability = "");
 
     /**
      * @brief Sends a request to count the number of documents in a collection that match a query.
@@ -112,11 +348,153 @@ class AevumClient {
      */
     [[nodiscard]] std::string count(std::string_view collection, std::string_view query_json);
 
+    /**
+     * @brief Sends a request to run an aggregation pipeline over a collection on the server.
+     * @param collection The name of the target collection.
+     * @param pipeline_json The JSON array of stages (`$match`, `$group`, `$sort`, `$skip`,
+     * `$limit`, `$project`, `$count`).
+     * @return A `std::string` containing the server's raw JSON response, typically an object with a
+     * "data" field holding the results.
+     */
+    [[nodiscard]] std::string aggregate(std::string_view collection,
+                                        std::string_view pipeline_json);
+
+    /**
+     * @brief Sends a request to report the access path the server would use for a query.
+     * @param collection The name of the target collection.
+     * @param query_json The JSON string defining the filter criteria to plan.
+     * @param sort_json The JSON string defining the sort order to plan (optional).
+     * @return A `std::string` containing the server's raw JSON response, typically an object with a
+     * "plan" field.
+     */
+    [[nodiscard]] std::string explain(std::string_view collection, std::string_view query_json,
+                                      std::string_view sort_json = "{}");
+
+    /**
+     * @brief Sends a request to create a secondary index on a field of a collection.
+     * @details Requires the `ADMIN` role.
+     * @param collection The name of the target collection.
+     * @param field The top-level field to index.
+     * @param type The index type: "hash" (equality only), "ordered" (equality, ranges, and
+     * sorting), "columnar" (equality and numeric ranges filtered over a dense column), or "text"
+     * (`$text` searches ranked by relevance).
+     * @param expire_after_seconds For an "ordered" index, makes it a TTL index: documents are
+     * deleted this many seconds after the time, in seconds since the Unix epoch, in `field`.
+     * @param sparse `true` to index only the documents that have `field`.
+     * @param partial_filter_json A JSON query object; if not empty, only the documents matching
+     * it are indexed.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string create_index(
+        std::string_view collection, std::string_view field, std::string_view type = "hash",
+        std::optional<int64_t> expire_after_seconds = std::nullopt, bool sparse = false,
+        std::string_view partial_filter_json = {});
+
+    /**
+     * @brief Starts an online backup of the server's data directory.
+     * @details Requires the `ADMIN` role. The server copies the files in the background, on its
+     * own filesystem, while writes continue; poll `backup_status` for the outcome.
+     * @param path The directory on the server to write to: missing or empty for a full backup,
+     *        or holding a complete backup for an incremental one.
+     * @param incremental `true` to copy only the blocks modified since the backup in `path`.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string backup(std::string_view path, bool incremental = false);
+
+    /**
+     * @brief Requests the progress of the server's current or last backup.
+     * @details Requires the `ADMIN` role.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string backup_status();
+
+    /**
+     * @brief Opens a transaction on this client's connection.
+     * @details Until `commit_transaction` or `abort_transaction`, the writes of `insert`,
+     * `insert_many`, `update`, and `remove` are staged on the server and `find` reads through
+     * them; reads go to the primary whatever the read preference. The requests are tagged as
+     * part of the transaction, so if the connection is lost and re-established meanwhile, the
+     * server refuses them instead of applying them on their own.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string begin_transaction();
+
+    /**
+     * @brief Commits the open transaction; its writes become visible together or not at all.
+     * @details A response with `"retryable":true` reports that a concurrent write committed to
+     * a document of the transaction first, or that the transaction was lost with its connection;
+     * the transaction should then be run again from `begin_transaction`.
+     * @param durability The durability level to request (`"none"`, `"journal"`, or `"fsync"`), or
+     * an empty string to use the server's default.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string commit_transaction(std::string_view durability = "");
+
+    /**
+     * @brief Discards the open transaction and its staged writes.
+     * @return A `std::string` containing the server's raw JSON response.
+     */
+    [[nodiscard]] std::string abort_transaction();
+
   private:
+    /**
+     * @brief Sends a JSON request in the connection's protocol and returns the JSON response.
+     * @details On a BSON connection the payload is converted to BSON and the response back to
+     * JSON; otherwise both are passed through unchanged.
+     * @param payload The JSON request payload.
+     * @return The JSON response.
+     */
+    [[nodiscard]] std::string exchange(std::string_view payload);
+
+    /**
+     * @brief Sends a read request according to the read preference.
+     * @param action The action: `find`, `count`, or `aggregate`.
+     * @param collection The target collection name.
+     * @param extra_fields The action-specific fields.
+     * @return The JSON response of the replica or primary that served the read.
+     */
+    [[nodiscard]] std::string read(std::string_view action, std::string_view collection,
+                                   const std::string &extra_fields);
+
+    /**
+     * @brief Returns the next replica in turn, switched to the BSON protocol if this client is.
+     * @return The replica.
+     */
+    AevumClient &next_replica();
+
+    /**
+     * @brief Sends a BSON `find` and copies the matched documents out of the response.
+     * @param collection The name of the target collection.
+     * @param query The filter criteria.
+     * @param sort The sort order; an empty document for no sort.
+     * @param projection The projection; an empty document for whole documents.
+     * @param limit The maximum number of documents to return, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @param max_staleness_ms The `maxStalenessMs` of the request, or 0 to send none.
+     * @param out Receives the matched documents, in result order.
+     * @return As `find_documents`, and `IOError` if a replica is too stale to serve the read.
+     */
+    [[nodiscard]] aevum::util::Status fetch_documents(
+        std::string_view collection, const aevum::bson::doc::Document &query,
+        const aevum::bson::doc::Document &sort, const aevum::bson::doc::Document &projection,
+        int64_t limit, int64_t skip, int64_t max_staleness_ms,
+        std::vector<aevum::bson::doc::Document> &out);
+
     /// The underlying network connection manager responsible for all TCP communication.
     net::client::Connection conn_;
     /// The API key used for authenticating all outgoing requests.
     std::string api_key_;
+    /// Where reads go.
+    ReadPreference read_preference_{ReadPreference::PRIMARY};
+    /// The read replicas, used in turn.
+    std::vector<std::unique_ptr<AevumClient>> replicas_;
+    /// The index of the replica the next read tries first.
+    size_t next_replica_{0};
+    /// The `maxStalenessMs` sent with reads routed to replicas, or 0.
+    int64_t max_staleness_ms_{0};
+    /// `true` while a transaction is open; requests are then tagged with `txn` and reads go to
+    /// the primary.
+    bool in_transaction_{false};
 
   public:  // Public for shell/CLI usage
     /**
@@ -140,9 +518,7 @@ class AevumClient {
      * @param payload The complete JSON request payload string.
      * @return The raw JSON response string from the server.
      */
-    [[nodiscard]] std::string send_request(std::string_view payload) {
-        return conn_.send_request(payload);
-    }
+    [[nodiscard]] std::string send_request(std::string_view payload) { return exchange(payload); }
 };
 
 }  // namespace aevum::client
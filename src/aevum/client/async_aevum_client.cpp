@@ -0,0 +1,520 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file async_aevum_client.cpp
+ * @brief Implements `AsyncAevumClient`, the pooled, pipelined, asynchronous client.
+ */
+#include "aevum/client/async_aevum_client.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "aevum/client/aevum_client.hpp"
+#include "aevum/client/net/framing.hpp"
+
+namespace aevum::client {
+
+using aevum::net::FrameDecoder;
+
+namespace {
+
+/// The largest response the client accepts.
+constexpr size_t ASYNC_MAX_RESPONSE_SIZE = size_t{1} << 30;
+/// The number of bytes received from a socket per `recv`.
+constexpr size_t ASYNC_RECEIVE_CHUNK_SIZE = 65536;
+
+/// Completes requests that could not be sent because the server was unreachable.
+constexpr std::string_view CONNECT_ERROR =
+    R"({"status":"error","message":"Connection Failure: Unable to establish connection to AevumDB server."})";
+/// Completes requests whose connection failed before they were answered.
+constexpr std::string_view CONNECTION_LOST_ERROR =
+    R"({"status":"error","message":"Connection Error: Connection to the server was lost."})";
+/// Completes requests that are still in flight when the client is destroyed.
+constexpr std::string_view CLIENT_CLOSED_ERROR =
+    R"({"status":"error","message":"Connection Error: The client was closed."})";
+
+/**
+ * @brief Opens a blocking TCP connection with Nagle's algorithm disabled.
+ * @details Pipelined requests are small and latency-bound, so they are sent immediately instead
+ * of being coalesced.
+ * @param host The IPv4 address of the server.
+ * @param port The TCP port of the server.
+ * @return The connected socket, or -1.
+ */
+int open_pipelined_socket(const std::string &host, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in server_addr{};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &server_addr.sin_addr) <= 0 ||
+        connect(fd, reinterpret_cast<struct sockaddr *>(&server_addr), sizeof(server_addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+}  // namespace
+
+/**
+ * @brief One TCP connection, its reader thread, and its outstanding requests.
+ * @details Requests are added to `pending` before they are written, so a response can never
+ * arrive for an unknown request. `write_mutex` keeps frames from interleaving on the socket;
+ * `mutex` guards `pending` and `broken`. The socket is shut down when the session fails, which
+ * wakes the reader, and closed only once the reader has been joined, so the descriptor cannot be
+ * reused while the reader still uses it.
+ */
+struct AsyncAevumClient::Session {
+    /// Closes the socket.
+    ~Session() {
+        if (fd >= 0) close(fd);
+    }
+
+    /// The connected socket.
+    int fd{-1};
+    /// The slot's count of requests in flight, shared by all of the slot's sessions.
+    std::atomic<size_t> *in_flight{nullptr};
+    /// The maximum size of `pending`.
+    size_t max_pipeline_depth{0};
+    /// Serializes writes to the socket.
+    std::mutex write_mutex;
+    /// The buffer request frames are assembled in; guarded by `write_mutex`.
+    std::string outbound;
+    /// Guards `pending` and `broken`.
+    std::mutex mutex;
+    /// Signalled whenever `pending` shrinks or the session fails.
+    std::condition_variable drained;
+    /// The callbacks of the requests in flight, by request id.
+    std::map<uint64_t, Callback> pending;
+    /// `true` once the socket has failed; no request is added after that.
+    bool broken{false};
+    /// Receives the responses.
+    std::thread reader;
+    /// `true` once `reader` has finished and can be joined without blocking.
+    std::atomic<bool> finished{false};
+};
+
+/**
+ * @brief A position in the pool.
+ * @details A failed session is retired rather than destroyed, since its reader may still be
+ * running the callbacks of its failed requests; it is joined once it has finished.
+ */
+struct AsyncAevumClient::Slot {
+    /// Guards `session` and `retired`.
+    std::mutex mutex;
+    /// The current session, or null before the first request.
+    std::shared_ptr<Session> session;
+    /// Failed sessions whose reader has not been joined yet.
+    std::vector<std::shared_ptr<Session>> retired;
+    /// The number of requests in flight on this slot's sessions.
+    std::atomic<size_t> in_flight{0};
+};
+
+/**
+ * @brief Constructs a client with an empty pool of `options.pool_size` slots (at least one).
+ * @param host The IPv4 address of the AevumDB server.
+ * @param port The TCP port of the server.
+ * @param api_key The API key that authenticates every request.
+ * @param options The pool configuration.
+ */
+AsyncAevumClient::AsyncAevumClient(std::string host, int port, std::string api_key,
+                                   AsyncClientOptions options)
+    : host_(std::move(host)), port_(port), api_key_(std::move(api_key)), options_(options) {
+    if (options_.pool_size == 0) options_.pool_size = 1;
+    if (options_.max_pipeline_depth == 0) options_.max_pipeline_depth = 1;
+    slots_.reserve(options_.pool_size);
+    for (size_t i = 0; i < options_.pool_size; ++i) slots_.push_back(std::make_unique<Slot>());
+}
+
+/**
+ * @brief Fails every session and joins its reader.
+ */
+AsyncAevumClient::~AsyncAevumClient() {
+    for (auto &slot : slots_) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->session) slot->retired.push_back(std::move(slot->session));
+        for (auto &session : slot->retired) {
+            fail_session(*session, CLIENT_CLOSED_ERROR);
+            if (session->reader.joinable()) session->reader.join();
+        }
+        slot->retired.clear();
+    }
+}
+
+/**
+ * @brief Sends a request and returns a future for its response.
+ * @param payload The JSON request object.
+ * @return The future.
+ */
+std::future<std::string> AsyncAevumClient::send(std::string payload) {
+    auto promise = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> future = promise->get_future();
+    send(std::move(payload),
+         [promise](std::string response) { promise->set_value(std::move(response)); });
+    return future;
+}
+
+/**
+ * @brief Sends a request and invokes a callback with its response.
+ * @details The request is tagged with the next request id and queued on the least loaded
+ * connection. If that connection already has `max_pipeline_depth` requests in flight, the call
+ * blocks until one of them is answered. A failed write fails the whole session, completing this
+ * and every other outstanding request on it with an error; the next request reconnects.
+ * @param payload The JSON request object.
+ * @param callback Invoked exactly once with the response.
+ */
+void AsyncAevumClient::send(std::string payload, Callback callback) {
+    uint64_t request_id = next_request_id_.fetch_add(1, std::memory_order_relaxed);
+    aevum::net::tag_request_id(payload, std::to_string(request_id));
+
+    Slot &slot = pick_slot();
+    std::shared_ptr<Session> session = acquire_session(slot);
+    if (!session) {
+        callback(std::string(CONNECT_ERROR));
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(session->mutex);
+        session->drained.wait(lock, [&] {
+            return session->broken || session->pending.size() < session->max_pipeline_depth;
+        });
+        if (session->broken) {
+            lock.unlock();
+            callback(std::string(CONNECTION_LOST_ERROR));
+            return;
+        }
+        slot.in_flight.fetch_add(1, std::memory_order_relaxed);
+        session->pending.emplace(request_id, std::move(callback));
+    }
+
+    std::lock_guard<std::mutex> write_lock(session->write_mutex);
+    session->outbound.clear();
+    aevum::net::append_frame(session->outbound, payload);
+    size_t sent = 0;
+    while (sent < session->outbound.size()) {
+        ssize_t n = ::send(session->fd, session->outbound.data() + sent,
+                           session->outbound.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            fail_session(*session, CONNECTION_LOST_ERROR);
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+/**
+ * @brief Sends an insert request.
+ * @param collection The name of the target collection.
+ * @param doc_json The JSON document to insert.
+ * @param durability The durability level, or empty for the server's default.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::insert(std::string_view collection,
+                                                  std::string_view doc_json,
+                                                  std::string_view durability) {
+    std::string extra = "\"data\":" + std::string(doc_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return send(make_request_payload(api_key_, "insert", collection, extra));
+}
+
+/**
+ * @brief Sends an insert_many request.
+ * @param collection The name of the target collection.
+ * @param docs_json The JSON array of documents to insert.
+ * @param durability The durability level, or empty for the server's default.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::insert_many(std::string_view collection,
+                                                       std::string_view docs_json,
+                                                       std::string_view durability) {
+    std::string extra = "\"data\":" + std::string(docs_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return send(make_request_payload(api_key_, "insert_many", collection, extra));
+}
+
+/**
+ * @brief Sends a find request.
+ * @param collection The name of the target collection.
+ * @param query_json The filter criteria.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of documents to return.
+ * @param skip The number of documents to skip.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::find(std::string_view collection,
+                                                std::string_view query_json,
+                                                std::string_view sort_json, int64_t limit,
+                                                int64_t skip) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("sort":)" + std::string(sort_json) + ",";
+    extra += R"("limit":)" + std::to_string(limit) + ",";
+    extra += R"("skip":)" + std::to_string(skip);
+    return send(make_request_payload(api_key_, "find", collection, extra));
+}
+
+/**
+ * @brief Sends a find request that opens a cursor.
+ * @param collection The name of the target collection.
+ * @param query_json The filter criteria.
+ * @param batch_size The maximum number of documents per batch.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of documents over all batches.
+ * @param skip The number of documents to skip.
+ * @return A future for the first batch.
+ */
+std::future<std::string> AsyncAevumClient::open_cursor(std::string_view collection,
+                                                       std::string_view query_json,
+                                                       int64_t batch_size,
+                                                       std::string_view sort_json, int64_t limit,
+                                                       int64_t skip) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("sort":)" + std::string(sort_json) + ",";
+    extra += R"("limit":)" + std::to_string(limit) + ",";
+    extra += R"("skip":)" + std::to_string(skip) + ",";
+    extra += R"("batchSize":)" + std::to_string(batch_size);
+    return send(make_request_payload(api_key_, "find", collection, extra));
+}
+
+/**
+ * @brief Sends a request for the next batch of a cursor.
+ * @param cursor_id The id of the cursor.
+ * @param batch_size The maximum number of documents in the batch.
+ * @return A future for the batch.
+ */
+std::future<std::string> AsyncAevumClient::get_more(int64_t cursor_id, int64_t batch_size) {
+    std::string extra = R"("cursor":)" + std::to_string(cursor_id);
+    if (batch_size > 0) extra += R"(,"batchSize":)" + std::to_string(batch_size);
+    return send(make_request_payload(api_key_, "getMore", "", extra));
+}
+
+/**
+ * @brief Sends a request to discard a cursor.
+ * @param cursor_id The id of the cursor.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::kill_cursor(int64_t cursor_id) {
+    std::string extra = R"("cursor":)" + std::to_string(cursor_id);
+    return send(make_request_payload(api_key_, "killCursor", "", extra));
+}
+
+/**
+ * @brief Sends an update request.
+ * @param collection The name of the target collection.
+ * @param query_json The filter selecting the documents.
+ * @param update_json The update to apply.
+ * @param durability The durability level, or empty for the server's default.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::update(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view update_json,
+                                                  std::string_view durability) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("update":)" + std::string(update_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return send(make_request_payload(api_key_, "update", collection, extra));
+}
+
+/**
+ * @brief Sends an upsert request.
+ * @param collection The name of the target collection.
+ * @param query_json The filter selecting the documents.
+ * @param document_json The update, or the document to insert.
+ * @param durability The durability level, or empty for the server's default.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::upsert(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view document_json,
+                                                  std::string_view durability) {
+    std::string extra = R"("query":)" + std::string(query_json) + ",";
+    extra += R"("data":)" + std::string(document_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return send(make_request_payload(api_key_, "upsert", collection, extra));
+}
+
+/**
+ * @brief Sends a delete request.
+ * @param collection The name of the target collection.
+ * @param query_json The filter selecting the documents.
+ * @param durability The durability level, or empty for the server's default.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::remove(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view durability) {
+    std::string extra = R"("query":)" + std::string(query_json);
+    if (!durability.empty()) extra += R"(,"durability":")" + std::string(durability) + "\"";
+    return send(make_request_payload(api_key_, "delete", collection, extra));
+}
+
+/**
+ * @brief Sends a count request.
+ * @param collection The name of the target collection.
+ * @param query_json The filter criteria.
+ * @return A future for the response.
+ */
+std::future<std::string> AsyncAevumClient::count(std::string_view collection,
+                                                 std::string_view query_json) {
+    std::string extra = R"("query":)" + std::string(query_json);
+    return send(make_request_payload(api_key_, "count", collection, extra));
+}
+
+/**
+ * @brief Returns the number of requests sent but not yet answered.
+ * @return The sum over all slots.
+ */
+size_t AsyncAevumClient::in_flight() const noexcept {
+    size_t total = 0;
+    for (const auto &slot : slots_) total += slot->in_flight.load(std::memory_order_relaxed);
+    return total;
+}
+
+/**
+ * @brief Returns the slot with the fewest requests in flight.
+ * @details The counts are read without synchronization, so concurrent senders may pick the same
+ * slot; the pipeline depth bounds the imbalance.
+ * @return The slot.
+ */
+AsyncAevumClient::Slot &AsyncAevumClient::pick_slot() {
+    Slot *best = slots_.front().get();
+    size_t best_load = best->in_flight.load(std::memory_order_relaxed);
+    for (size_t i = 1; i < slots_.size() && best_load > 0; ++i) {
+        size_t load = slots_[i]->in_flight.load(std::memory_order_relaxed);
+        if (load < best_load) {
+            best = slots_[i].get();
+            best_load = load;
+        }
+    }
+    return *best;
+}
+
+/**
+ * @brief Returns the live session of a slot, connecting a new one if necessary.
+ * @details Retired sessions whose reader has finished are joined first. A failed current session
+ * is retired, and a connection is attempted up to `connect_attempts` times, `reconnect_delay_ms`
+ * apart.
+ * @param slot The slot.
+ * @return The session, or null.
+ */
+std::shared_ptr<AsyncAevumClient::Session> AsyncAevumClient::acquire_session(Slot &slot) {
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    for (auto it = slot.retired.begin(); it != slot.retired.end();) {
+        if ((*it)->finished.load(std::memory_order_acquire)) {
+            (*it)->reader.join();
+            it = slot.retired.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (slot.session) {
+        std::lock_guard<std::mutex> session_lock(slot.session->mutex);
+        if (!slot.session->broken) return slot.session;
+    }
+    if (slot.session) slot.retired.push_back(std::move(slot.session));
+
+    int fd = -1;
+    for (int attempt = 0; attempt < std::max(options_.connect_attempts, 1); ++attempt) {
+        if (attempt > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(options_.reconnect_delay_ms));
+        }
+        fd = open_pipelined_socket(host_, port_);
+        if (fd >= 0) break;
+    }
+    if (fd < 0) return nullptr;
+
+    auto session = std::make_shared<Session>();
+    session->fd = fd;
+    session->in_flight = &slot.in_flight;
+    session->max_pipeline_depth = options_.max_pipeline_depth;
+    // The slot keeps the session alive until the reader has been joined.
+    Session *raw = session.get();
+    session->reader = std::thread([raw] { read_responses(*raw); });
+    slot.session = session;
+    return session;
+}
+
+/**
+ * @brief Receives and dispatches the responses of a session until its socket fails.
+ * @details Each response is matched to its request by the id it is tagged with. A response
+ * without a tag, which the server only sends right before it closes the connection (e.g. when
+ * it rejects a connection or an oversized request), completes the oldest request.
+ * @param session The session.
+ */
+void AsyncAevumClient::read_responses(Session &session) {
+    FrameDecoder decoder(ASYNC_MAX_RESPONSE_SIZE, FrameDecoder::Mode::FRAMED);
+    std::string_view response;
+    for (;;) {
+        FrameDecoder::Result result = decoder.next(response);
+        if (result == FrameDecoder::Result::MESSAGE) {
+            std::string tag(aevum::net::find_request_id(response));
+            uint64_t request_id = tag.empty() ? 0 : std::strtoull(tag.c_str(), nullptr, 10);
+            Callback callback;
+            {
+                std::lock_guard<std::mutex> lock(session.mutex);
+                auto it = tag.empty() ? session.pending.begin() : session.pending.find(request_id);
+                if (it != session.pending.end()) {
+                    callback = std::move(it->second);
+                    session.pending.erase(it);
+                    session.in_flight->fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+            session.drained.notify_all();
+            if (callback) callback(std::string(response));
+            continue;
+        }
+        if (result == FrameDecoder::Result::TOO_LARGE) break;
+
+        char *space = decoder.prepare(ASYNC_RECEIVE_CHUNK_SIZE);
+        ssize_t n = recv(session.fd, space, ASYNC_RECEIVE_CHUNK_SIZE, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        decoder.commit(static_cast<size_t>(n));
+    }
+    fail_session(session, CONNECTION_LOST_ERROR);
+    session.finished.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Marks a session as failed and completes its outstanding requests with an error.
+ * @details Idempotent. The socket is shut down, not closed, so that the reader wakes up and the
+ * descriptor stays reserved until the session is destroyed. The callbacks run after the session
+ * mutex is released.
+ * @param session The session.
+ * @param error The JSON error passed to the callbacks.
+ */
+void AsyncAevumClient::fail_session(Session &session, std::string_view error) {
+    std::map<uint64_t, Callback> failed;
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        if (!session.broken) {
+            session.broken = true;
+            shutdown(session.fd, SHUT_RDWR);
+        }
+        failed.swap(session.pending);
+        session.in_flight->fetch_sub(failed.size(), std::memory_order_relaxed);
+    }
+    session.drained.notify_all();
+    for (auto &[request_id, callback] : failed) callback(std::string(error));
+}
+
+}  // namespace aevum::client
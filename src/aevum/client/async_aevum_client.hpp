@@ -0,0 +1,273 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file async_aevum_client.hpp
+ * @brief Declares `AsyncAevumClient`, a thread-safe client that keeps many requests in flight
+ * over a small pool of pipelined connections.
+ * @details `AevumClient` sends one request at a time over one blocking connection, so an
+ * application server needs a client per thread and still waits out a full round-trip per request.
+ * `AsyncAevumClient` is shared by all threads instead. Every request is tagged with a request id
+ * (see `net::find_request_id`) and written to the least loaded connection of the pool without
+ * waiting for earlier responses; a reader thread per connection matches each response to its
+ * request by id and completes the request's future or invokes its callback.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aevum::client {
+
+/**
+ * @struct AsyncClientOptions
+ * @brief The configuration of an `AsyncAevumClient`.
+ */
+struct AsyncClientOptions {
+    /// The number of connections in the pool.
+    size_t pool_size = 4;
+    /// The most requests in flight on one connection; further requests wait for a response.
+    size_t max_pipeline_depth = 256;
+    /// How many times a connection is attempted before a request fails.
+    int connect_attempts = 3;
+    /// The delay between two connection attempts, in milliseconds.
+    int reconnect_delay_ms = 100;
+};
+
+/**
+ * @class AsyncAevumClient
+ * @brief A pooled, pipelined, asynchronous client for an AevumDB server.
+ *
+ * @details Connections are opened on first use and reopened automatically when they fail; the
+ * requests in flight on a failed connection complete with a JSON error, while later requests go
+ * to a new connection. Responses are the server's JSON responses, tagged with the `requestId`
+ * they were correlated by.
+ *
+ * All methods are thread-safe. Callbacks run on the reader thread of the connection, however, so
+ * they must not block, wait for another request's future, or destroy the client.
+ */
+class AsyncAevumClient {
+  public:
+    /// Receives the JSON response of a request.
+    using Callback = std::function<void(std::string)>;
+
+    /**
+     * @brief Constructs a client. No connection is opened until the first request.
+     * @param host The IPv4 address of the AevumDB server.
+     * @param port The TCP port of the server.
+     * @param api_key The API key that authenticates every request.
+     * @param options The pool configuration.
+     */
+    AsyncAevumClient(std::string host, int port, std::string api_key,
+                     AsyncClientOptions options = {});
+
+    /**
+     * @brief Closes every connection and waits for the reader threads.
+     * @details Requests still in flight complete with an error.
+     */
+    ~AsyncAevumClient();
+
+    AsyncAevumClient(const AsyncAevumClient &) = delete;
+    AsyncAevumClient &operator=(const AsyncAevumClient &) = delete;
+
+    /**
+     * @brief Sends a pre-constructed JSON request.
+     * @param payload The JSON request object; it is tagged with a request id before it is sent.
+     * @return A future that receives the JSON response.
+     */
+    [[nodiscard]] std::future<std::string> send(std::string payload);
+
+    /**
+     * @brief Sends a pre-constructed JSON request and invokes a callback with its response.
+     * @param payload The JSON request object.
+     * @param callback Invoked exactly once with the JSON response, or with a JSON error if the
+     * request could not be completed.
+     */
+    void send(std::string payload, Callback callback);
+
+    /**
+     * @brief Inserts a document into a collection.
+     * @param collection The name of the target collection.
+     * @param doc_json The JSON document to insert.
+     * @param durability The durability level to request, or empty for the server's default.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> insert(std::string_view collection,
+                                                  std::string_view doc_json,
+                                                  std::string_view durability = "");
+
+    /**
+     * @brief Inserts an array of documents into a collection in one request.
+     * @param collection The name of the target collection.
+     * @param docs_json The JSON array of documents to insert.
+     * @param durability The durability level to request, or empty for the server's default.
+     * @return A future that receives the server's response, which reports each document.
+     */
+    [[nodiscard]] std::future<std::string> insert_many(std::string_view collection,
+                                                       std::string_view docs_json,
+                                                       std::string_view durability = "");
+
+    /**
+     * @brief Finds documents in a collection.
+     * @param collection The name of the target collection.
+     * @param query_json The filter criteria.
+     * @param sort_json The sort order.
+     * @param limit The maximum number of documents to return, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> find(std::string_view collection,
+                                                std::string_view query_json,
+                                                std::string_view sort_json = "{}",
+                                                int64_t limit = 0, int64_t skip = 0);
+
+    /**
+     * @brief Finds documents in a collection through a cursor, as `AevumClient::open_cursor`.
+     * @details Cursors belong to the API key rather than to a connection, so their batches may
+     * be requested over any connection of the pool.
+     * @param collection The name of the target collection.
+     * @param query_json The filter criteria.
+     * @param batch_size The maximum number of documents per batch; must be positive.
+     * @param sort_json The sort order.
+     * @param limit The maximum number of documents over all batches, or 0 for no limit.
+     * @param skip The number of documents to skip.
+     * @return A future that receives the first batch and the cursor's id.
+     */
+    [[nodiscard]] std::future<std::string> open_cursor(std::string_view collection,
+                                                       std::string_view query_json,
+                                                       int64_t batch_size,
+                                                       std::string_view sort_json = "{}",
+                                                       int64_t limit = 0, int64_t skip = 0);
+
+    /**
+     * @brief Requests the next batch of a cursor opened by `open_cursor`.
+     * @param cursor_id The id returned by the previous batch.
+     * @param batch_size The maximum number of documents in the batch, or 0 for the server's
+     * default.
+     * @return A future that receives the batch; `cursor` is 0 once the results are exhausted.
+     */
+    [[nodiscard]] std::future<std::string> get_more(int64_t cursor_id, int64_t batch_size = 0);
+
+    /**
+     * @brief Discards a cursor that is no longer needed before it is exhausted.
+     * @param cursor_id The id of the cursor.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> kill_cursor(int64_t cursor_id);
+
+    /**
+     * @brief Updates the documents of a collection that match a query.
+     * @param collection The name of the target collection.
+     * @param query_json The filter selecting the documents.
+     * @param update_json The update to apply.
+     * @param durability The durability level to request, or empty for the server's default.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> update(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view update_json,
+                                                  std::string_view durability = "");
+
+    /**
+     * @brief Updates the documents of a collection that match a query, or inserts a document if
+     * none does.
+     * @param collection The name of the target collection.
+     * @param query_json The filter selecting the documents.
+     * @param document_json The update to apply, or the document to insert.
+     * @param durability The durability level to request, or empty for the server's default.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> upsert(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view document_json,
+                                                  std::string_view durability = "");
+
+    /**
+     * @brief Removes the documents of a collection that match a query.
+     * @param collection The name of the target collection.
+     * @param query_json The filter selecting the documents.
+     * @param durability The durability level to request, or empty for the server's default.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> remove(std::string_view collection,
+                                                  std::string_view query_json,
+                                                  std::string_view durability = "");
+
+    /**
+     * @brief Counts the documents of a collection that match a query.
+     * @param collection The name of the target collection.
+     * @param query_json The filter criteria.
+     * @return A future that receives the server's response.
+     */
+    [[nodiscard]] std::future<std::string> count(std::string_view collection,
+                                                 std::string_view query_json);
+
+    /**
+     * @brief Returns the number of requests sent but not yet answered.
+     * @return The requests in flight over all connections.
+     */
+    [[nodiscard]] size_t in_flight() const noexcept;
+
+  private:
+    /**
+     * @struct Session
+     * @brief One TCP connection, its reader thread, and its outstanding requests.
+     */
+    struct Session;
+
+    /**
+     * @struct Slot
+     * @brief A position in the pool: the current session and the failed ones not yet joined.
+     */
+    struct Slot;
+
+    /**
+     * @brief Returns the slot with the fewest requests in flight.
+     * @return The slot.
+     */
+    Slot &pick_slot();
+
+    /**
+     * @brief Returns the live session of a slot, connecting a new one if necessary.
+     * @param slot The slot.
+     * @return The session, or null if the server could not be reached.
+     */
+    std::shared_ptr<Session> acquire_session(Slot &slot);
+
+    /**
+     * @brief Receives and dispatches the responses of a session until its socket fails.
+     * @param session The session.
+     */
+    static void read_responses(Session &session);
+
+    /**
+     * @brief Marks a session as failed and completes its outstanding requests with an error.
+     * @param session The session.
+     * @param error The JSON error passed to the callbacks.
+     */
+    static void fail_session(Session &session, std::string_view error);
+
+    /// The IPv4 address of the server.
+    std::string host_;
+    /// The TCP port of the server.
+    int port_;
+    /// The API key that authenticates every request.
+    std::string api_key_;
+    /// The pool configuration.
+    AsyncClientOptions options_;
+    /// The pool.
+    std::vector<std::unique_ptr<Slot>> slots_;
+    /// The id the next request is tagged with.
+    std::atomic<uint64_t> next_request_id_{1};
+};
+
+}  // namespace aevum::client
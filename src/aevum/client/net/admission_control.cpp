@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file admission_control.cpp
+ * @brief Implements the `AdmissionController`.
+ */
+#include "aevum/client/net/admission_control.hpp"
+
+#include <algorithm>
+
+namespace aevum::net::server {
+
+/**
+ * @brief Gives the slot back to the controller, if the ticket holds one.
+ */
+void AdmissionController::Ticket::release() noexcept {
+    if (controller_ == nullptr) return;
+    controller_->release(index_);
+    controller_ = nullptr;
+}
+
+/**
+ * @brief Constructs a controller with a set of limits per class.
+ * @param limits The limits, indexed by `RequestClass`.
+ */
+AdmissionController::AdmissionController(
+    const std::array<AdmissionLimits, REQUEST_CLASS_COUNT> &limits) {
+    for (size_t i = 0; i < REQUEST_CLASS_COUNT; ++i) {
+        lanes_[i].limits = limits[i];
+        lanes_[i].limits.running = std::max<size_t>(1, limits[i].running);
+    }
+}
+
+/**
+ * @brief Admits a request, waiting for a slot of its class if need be.
+ * @details A request whose deadline has already passed, typically after waiting for a worker,
+ * is dropped without taking a slot.
+ * @param request_class The class of the request.
+ * @param deadline The deadline of the request.
+ * @param ticket Receives the slot.
+ * @return The outcome.
+ */
+AdmissionController::Outcome AdmissionController::admit(RequestClass request_class,
+                                                        Clock::time_point deadline,
+                                                        Ticket &ticket) {
+    auto index = static_cast<size_t>(request_class);
+    Lane &lane = lanes_[index];
+    std::unique_lock<std::mutex> lock(lane.mutex);
+    if (Clock::now() >= deadline) {
+        ++lane.stats.expired;
+        return Outcome::EXPIRED;
+    }
+    if (lane.stats.running >= lane.limits.running) {
+        if (lane.stats.queued >= lane.limits.queued) {
+            ++lane.stats.shed;
+            return Outcome::SHED;
+        }
+        ++lane.stats.queued;
+        bool freed = lane.slot_freed.wait_until(
+            lock, deadline, [&] { return lane.stats.running < lane.limits.running; });
+        --lane.stats.queued;
+        if (!freed) {
+            ++lane.stats.expired;
+            return Outcome::EXPIRED;
+        }
+        ++lane.stats.waited;
+    }
+    ++lane.stats.running;
+    ++lane.stats.admitted;
+    ticket = Ticket();
+    ticket.controller_ = this;
+    ticket.index_ = index;
+    return Outcome::ADMITTED;
+}
+
+/**
+ * @brief Returns a snapshot of the counters of a class.
+ * @param request_class The class.
+ * @return The counters.
+ */
+AdmissionStats AdmissionController::stats(RequestClass request_class) const {
+    const Lane &lane = lanes_[static_cast<size_t>(request_class)];
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    return lane.stats;
+}
+
+/**
+ * @brief Releases a slot of a class and wakes a request waiting for one.
+ * @param index The class.
+ */
+void AdmissionController::release(size_t index) noexcept {
+    Lane &lane = lanes_[index];
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        --lane.stats.running;
+    }
+    lane.slot_freed.notify_one();
+}
+
+}  // namespace aevum::net::server
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file admission_control.hpp
+ * @brief Declares the `AdmissionController`, which limits how many requests of each class run at
+ * once.
+ * @details Every request the server runs occupies a worker thread until it is answered, whether
+ * it is a lookup by `_id` or a scan of a whole collection. Without limits, a burst of scans takes
+ * every worker and the lookups queue behind them. Requests are therefore classified as point
+ * operations, scans, or administrative requests, and each class runs within its own concurrency
+ * limit, with a bounded number of requests waiting for a slot. A request that would exceed the
+ * bound is refused at once as "server busy", and a waiting request whose deadline passes is
+ * dropped, so that the cheap requests keep their latency when the server is overloaded.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+namespace aevum::net::server {
+
+/**
+ * @enum RequestClass
+ * @brief The classes of requests that are admitted separately.
+ */
+enum class RequestClass : uint8_t {
+    /// Requests that touch a few documents: inserts, and reads and writes by `_id`.
+    POINT = 0,
+    /// Requests that may read a whole collection: queries on other fields, and aggregations.
+    SCAN = 1,
+    /// Index and schema changes, user management, backups, and diagnostics.
+    ADMIN = 2,
+};
+
+/// The number of request classes.
+inline constexpr size_t REQUEST_CLASS_COUNT = 3;
+
+/**
+ * @brief Converts a request class to its name.
+ * @param request_class The class.
+ * @return `"point"`, `"scan"`, or `"admin"`.
+ */
+constexpr std::string_view to_string(RequestClass request_class) noexcept {
+    switch (request_class) {
+        case RequestClass::POINT:
+            return "point";
+        case RequestClass::SCAN:
+            return "scan";
+        case RequestClass::ADMIN:
+            return "admin";
+    }
+    return "point";
+}
+
+/**
+ * @struct AdmissionLimits
+ * @brief The limits of one request class.
+ */
+struct AdmissionLimits {
+    /// The most requests of the class that run at once.
+    size_t running{1};
+    /// The most requests of the class that wait for a slot; further ones are refused.
+    size_t queued{0};
+};
+
+/**
+ * @struct AdmissionStats
+ * @brief A snapshot of the counters of one request class.
+ */
+struct AdmissionStats {
+    /// Requests that ran.
+    uint64_t admitted{0};
+    /// Requests that ran after waiting for a slot.
+    uint64_t waited{0};
+    /// Requests refused because the class's queue was full.
+    uint64_t shed{0};
+    /// Requests dropped because their deadline passed before they could run.
+    uint64_t expired{0};
+    /// Requests running now.
+    uint64_t running{0};
+    /// Requests waiting now.
+    uint64_t queued{0};
+};
+
+/**
+ * @class AdmissionController
+ * @brief Admits requests within the concurrency limit of their class.
+ *
+ * @details Each class has its own lock, so admitting a point operation never waits for the
+ * bookkeeping of scans. A request that finds its class at the limit waits, on the worker thread
+ * that received it, until a slot frees up or its deadline passes. Since waiting requests hold
+ * workers, the queue bounds are what keep the scans and the administrative requests from taking
+ * every worker. The class is thread-safe.
+ */
+class AdmissionController {
+  public:
+    /// The clock of the deadlines.
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @enum Outcome
+     * @brief The outcome of a request for admission.
+     */
+    enum class Outcome : uint8_t {
+        /// The request holds a slot until its ticket is destroyed.
+        ADMITTED,
+        /// The class's queue is full; the request must be refused as "server busy".
+        SHED,
+        /// The request's deadline passed before a slot freed up.
+        EXPIRED,
+    };
+
+    /**
+     * @class Ticket
+     * @brief The slot of an admitted request, released when the ticket is destroyed.
+     */
+    class Ticket {
+      public:
+        Ticket() = default;
+        ~Ticket() { release(); }
+        Ticket(const Ticket &) = delete;
+        Ticket &operator=(const Ticket &) = delete;
+        Ticket(Ticket &&other) noexcept : controller_(other.controller_), index_(other.index_) {
+            other.controller_ = nullptr;
+        }
+        Ticket &operator=(Ticket &&other) noexcept {
+            if (this != &other) {
+                release();
+                controller_ = other.controller_;
+                index_ = other.index_;
+                other.controller_ = nullptr;
+            }
+            return *this;
+        }
+
+      private:
+        friend class AdmissionController;
+
+        /**
+         * @brief Gives the slot back to the controller, if the ticket holds one.
+         */
+        void release() noexcept;
+
+        /// The controller of the slot, or `nullptr` if the ticket holds none.
+        AdmissionController *controller_{nullptr};
+        /// The class of the slot.
+        size_t index_{0};
+    };
+
+    /**
+     * @brief Constructs a controller with a set of limits per class.
+     * @param limits The limits, indexed by `RequestClass`; a running limit of 0 is raised to 1.
+     */
+    explicit AdmissionController(const std::array<AdmissionLimits, REQUEST_CLASS_COUNT> &limits);
+
+    AdmissionController(const AdmissionController &) = delete;
+    AdmissionController &operator=(const AdmissionController &) = delete;
+
+    /**
+     * @brief Admits a request, waiting for a slot of its class if need be.
+     * @param request_class The class of the request.
+     * @param deadline The time after which the request is no longer worth running.
+     * @param ticket Receives the slot if the request is admitted.
+     * @return The outcome.
+     */
+    [[nodiscard]] Outcome admit(RequestClass request_class, Clock::time_point deadline,
+                                Ticket &ticket);
+
+    /**
+     * @brief Returns a snapshot of the counters of a class.
+     * @param request_class The class.
+     * @return The counters.
+     */
+    [[nodiscard]] AdmissionStats stats(RequestClass request_class) const;
+
+  private:
+    /// The state of one request class.
+    struct Lane {
+        /// Guards all members below.
+        mutable std::mutex mutex;
+        /// Signalled when a slot frees up.
+        std::condition_variable slot_freed;
+        /// The limits of the class.
+        AdmissionLimits limits;
+        /// The counters of the class, including the current running and waiting counts.
+        AdmissionStats stats;
+    };
+
+    /**
+     * @brief Releases a slot of a class and wakes a request waiting for one.
+     * @param index The class.
+     */
+    void release(size_t index) noexcept;
+
+    /// The lanes, indexed by `RequestClass`.
+    std::array<Lane, REQUEST_CLASS_COUNT> lanes_;
+};
+
+}  // namespace aevum::net::server
@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bson_wire.cpp
+ * @brief Implements the reply encoding of the binary BSON wire protocol.
+ */
+#include "aevum/client/net/bson_wire.hpp"
+
+#include <bson/bson.h>
+#include <cstdint>
+
+#include "aevum/client/net/framing.hpp"
+
+namespace aevum::net {
+
+namespace {
+
+/// The terminators of the `data` array and of the envelope.
+constexpr char REPLY_TRAILER[2] = {'\0', '\0'};
+/// The encoding of an empty BSON document, sent in place of a null document.
+constexpr char EMPTY_BSON_DOCUMENT[5] = {5, 0, 0, 0, 0};
+
+/**
+ * @brief Appends a 32-bit integer in little-endian byte order, as BSON stores them.
+ * @param out The buffer to append to.
+ * @param value The value to append.
+ */
+void append_int32_le(std::string &out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>(value >> shift));
+}
+
+/**
+ * @brief Appends a 32-bit integer in big-endian byte order, as frame lengths are stored.
+ * @param out The buffer to append to.
+ * @param value The value to append.
+ */
+void append_int32_be(std::string &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>(value >> shift));
+}
+
+}  // namespace
+
+/**
+ * @brief Encodes the reply for a result set.
+ * @details The element keys are written first, so that `element_headers_` is not reallocated
+ * while buffers point into it. The layout of the frame is:
+ * `[frame length][envelope length][0x02 "status" 3 "ok"][0x04 "data" array length]`
+ * `([0x03 "i"][document i])... [0x00][0x00]`.
+ * @param documents The documents to return, in order.
+ */
+DocumentsReply::DocumentsReply(const std::vector<aevum::bson::doc::Document> &documents) {
+    std::vector<size_t> key_offsets;
+    key_offsets.reserve(documents.size() + 1);
+    size_t array_size = 4 + 1;  // The array's length prefix and terminator.
+    for (size_t i = 0; i < documents.size(); ++i) {
+        key_offsets.push_back(element_headers_.size());
+        element_headers_.push_back(static_cast<char>(BSON_TYPE_DOCUMENT));
+        element_headers_ += std::to_string(i);
+        element_headers_.push_back('\0');
+        const bson_t *doc = documents[i].get();
+        array_size += doc ? doc->len : sizeof(EMPTY_BSON_DOCUMENT);
+    }
+    key_offsets.push_back(element_headers_.size());
+    array_size += element_headers_.size();
+
+    constexpr std::string_view status_element("\x02status\0\x03\0\0\0ok\0", 15);
+    constexpr std::string_view data_key("\x04" "data\0", 6);
+    size_t envelope_size = 4 + status_element.size() + data_key.size() + array_size + 1;
+    append_int32_be(head_, static_cast<uint32_t>(envelope_size));
+    append_int32_le(head_, static_cast<uint32_t>(envelope_size));
+    head_ += status_element;
+    head_ += data_key;
+    append_int32_le(head_, static_cast<uint32_t>(array_size));
+
+    buffers_.reserve(2 * documents.size() + 2);
+    buffers_.push_back({head_.data(), head_.size()});
+    for (size_t i = 0; i < documents.size(); ++i) {
+        buffers_.push_back({element_headers_.data() + key_offsets[i],
+                            key_offsets[i + 1] - key_offsets[i]});
+        const bson_t *doc = documents[i].get();
+        if (doc) {
+            buffers_.push_back(
+                {const_cast<uint8_t *>(bson_get_data(doc)), static_cast<size_t>(doc->len)});
+        } else {
+            buffers_.push_back(
+                {const_cast<char *>(EMPTY_BSON_DOCUMENT), sizeof(EMPTY_BSON_DOCUMENT)});
+        }
+    }
+    buffers_.push_back({const_cast<char *>(REPLY_TRAILER), sizeof(REPLY_TRAILER)});
+    size_ = FRAME_HEADER_SIZE + envelope_size;
+}
+
+/**
+ * @brief Copies an embedded document or array out of a BSON document.
+ * @param parent The document containing the field.
+ * @param key The name of the field.
+ * @param out Receives a copy of the field's value.
+ * @return `true` if the field exists and holds a document or an array.
+ */
+bool copy_subdocument(const bson_t *parent, const char *key, aevum::bson::doc::Document &out) {
+    bson_iter_t iter;
+    if (!parent || !bson_iter_init_find(&iter, parent, key)) return false;
+
+    uint32_t length = 0;
+    const uint8_t *data = nullptr;
+    if (BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+        bson_iter_document(&iter, &length, &data);
+    } else if (BSON_ITER_HOLDS_ARRAY(&iter)) {
+        bson_iter_array(&iter, &length, &data);
+    } else {
+        return false;
+    }
+    bson_t *copy = bson_new_from_data(data, length);
+    if (!copy) return false;
+    out = aevum::bson::doc::Document(copy);
+    return true;
+}
+
+}  // namespace aevum::net
@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bson_wire.hpp
+ * @brief Declares the pieces of the binary BSON wire protocol shared by the server and client.
+ * @details A connection starts in JSON. A client that sends the framed request
+ * `{"action":"hello","protocol":"bson"}` and receives `{"status":"ok","protocol":"bson"}` has
+ * switched the connection to BSON: from then on, every frame in both directions carries a single
+ * BSON document with the same fields as its JSON counterpart. Result sets are then transferred as
+ * the documents' stored bytes, which `DocumentsReply` lets the server write to the socket with
+ * `sendmsg` without assembling them into a contiguous buffer.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <sys/uio.h>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::net {
+
+/// The protocol name that switches a connection to BSON.
+constexpr std::string_view BSON_PROTOCOL = "bson";
+
+/// The request a client sends to switch its connection to BSON.
+constexpr std::string_view BSON_HELLO_REQUEST = R"({"action":"hello","protocol":"bson"})";
+
+/**
+ * @class DocumentsReply
+ * @brief The framed reply `{"status": "ok", "data": [documents]}` as a list of buffers.
+ *
+ * @details The frame header, the envelope and array headers, and the array key of every element
+ * are encoded into two small strings owned by the reply; the documents themselves are referenced
+ * in place through `bson_get_data`. The reply must therefore not outlive the documents.
+ */
+class DocumentsReply {
+  public:
+    /**
+     * @brief Encodes the reply for a result set.
+     * @param documents The documents to return, in order.
+     */
+    explicit DocumentsReply(const std::vector<aevum::bson::doc::Document> &documents);
+
+    DocumentsReply(const DocumentsReply &) = delete;
+    DocumentsReply &operator=(const DocumentsReply &) = delete;
+
+    /**
+     * @brief Returns the buffers that make up the frame, in order.
+     * @return The buffers, which reference this reply and the documents.
+     */
+    [[nodiscard]] const std::vector<struct iovec> &buffers() const noexcept { return buffers_; }
+
+    /**
+     * @brief Returns the size of the frame, including its length prefix.
+     * @return The total size of all buffers.
+     */
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+  private:
+    /// The frame length, the envelope length, the `status` element, and the `data` array header.
+    std::string head_;
+    /// The type byte and decimal key of every array element, back to back.
+    std::string element_headers_;
+    /// The buffers of the frame.
+    std::vector<struct iovec> buffers_;
+    /// The total size of the frame.
+    size_t size_{0};
+};
+
+/**
+ * @brief Copies an embedded document or array out of a BSON document.
+ * @param parent The document containing the field.
+ * @param key The name of the field.
+ * @param out Receives a copy of the field's value.
+ * @return `true` if the field exists and holds a document or an array.
+ */
+[[nodiscard]] bool copy_subdocument(const bson_t *parent, const char *key,
+                                    aevum::bson::doc::Document &out);
+
+}  // namespace aevum::net
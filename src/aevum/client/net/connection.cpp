@@ -12,20 +12,35 @@
 #include "aevum/client/net/connection.hpp"
 
 #include <arpa/inet.h>
+#include <cerrno>
 #include <cstring>
 #include <stdexcept>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "aevum/client/net/bson_wire.hpp"
+
 namespace aevum::net::client {
 
+namespace {
+
+/// The largest response the client accepts.
+constexpr size_t MAX_RESPONSE_SIZE = size_t{1} << 30;
+/// The number of bytes received from the socket per `recv`.
+constexpr size_t RESPONSE_CHUNK_SIZE = 65536;
+
+}  // namespace
+
 /**
  * @brief Constructs a `Connection` object, initializing the server endpoint details.
  * @param host The hostname or IPv4 address of the server to connect to. This value is moved.
  * @param port The target TCP port number on the server.
  */
 Connection::Connection(std::string host, int port)
-    : host_(std::move(host)), port_(port), socket_fd_(-1) {}
+    : host_(std::move(host)),
+      port_(port),
+      socket_fd_(-1),
+      inbound_(MAX_RESPONSE_SIZE, FrameDecoder::Mode::FRAMED) {}
 
 /**
  * @brief Destroys the `Connection` object, ensuring the socket is gracefully closed.
@@ -42,6 +57,7 @@ Connection::~Connection() { disconnect_server(); }
  * 2. Configures the `sockaddr_in` struct with the server's address family, port, and IP address.
  *    It uses `inet_pton` to convert the string IP address to the required binary format.
  * 3. Attempts to connect to the server using `connect`.
+ * 4. If the BSON protocol or compression was requested, negotiates them again with `send_hello`.
  * If any step fails, the socket is cleaned up, and the function returns `false`.
  * @return `true` if the connection is successfully established or already exists; `false`
  * otherwise.
@@ -69,9 +85,105 @@ bool Connection::connect_server() {
         return false;
     }
 
+    if (bson_requested_ || compression_requested_ != WireCompressor::NONE) return send_hello();
+    return true;
+}
+
+/**
+ * @brief Sends the "hello" request and sets the connection up from the response.
+ * @details A server that only speaks JSON keeps the connection on JSON, and one that does not
+ * know or grant the compressor keeps it uncompressed. The dictionary is used only if the server
+ * echoes its id. The response itself is never compressed, since the server switches after
+ * queueing it.
+ * @return `false` if the connection was lost.
+ */
+bool Connection::send_hello() {
+    std::string hello = R"({"action":"hello")";
+    if (bson_requested_) hello.append(R"(,"protocol":")").append(BSON_PROTOCOL).append("\"");
+    if (compression_requested_ != WireCompressor::NONE) {
+        hello.append(R"(,"compression":")")
+            .append(wire_compressor_name(compression_requested_))
+            .append("\"");
+        if (dictionary_ != nullptr) {
+            hello.append(R"(,"dictionary":)").append(std::to_string(dictionary_->id()));
+        }
+    }
+    hello.append("}");
+
+    std::string response = exchange(hello);
+    if (!is_connected()) return false;
+    bson_mode_ = response.find(R"("protocol":"bson")") != std::string::npos;
+    WireCompressor granted = parse_wire_compressor(hello_field(response, "compression"));
+    if (granted == WireCompressor::NONE || granted != compression_requested_) {
+        codec_.reset();
+        return true;
+    }
+    std::shared_ptr<const WireDictionary> dictionary;
+    if (dictionary_ != nullptr &&
+        hello_field(response, "dictionary") == std::to_string(dictionary_->id())) {
+        dictionary = dictionary_;
+    }
+    if (!codec_
+             .configure(granted, compression_threshold_, compression_level_,
+                        std::move(dictionary), nullptr)
+             .ok()) {
+        // The server compresses from now on, so the connection is unusable without a codec.
+        disconnect_server();
+        return false;
+    }
+    inbound_.accept_compressed(true);
     return true;
 }
 
+/**
+ * @brief Switches the connection to the binary BSON protocol.
+ * @details Connects first if necessary; `connect_server()` performs the negotiation. On an
+ * established JSON connection the "hello" request is sent right away.
+ * @return `true` if the connection now speaks BSON.
+ */
+bool Connection::negotiate_bson() {
+    bson_requested_ = true;
+    if (!is_connected()) return connect_server() && bson_mode_;
+    if (!bson_mode_) (void)send_hello();
+    return bson_mode_;
+}
+
+/**
+ * @brief Asks the server to compress the frames of the connection.
+ * @details The compressor and dictionary are checked first, so that a request this build cannot
+ * honor leaves the connection as it was. A BSON connection, and a compressed one that should
+ * stop compressing, are re-established, since the server only changes them at setup.
+ * @param compressor The compressor, or `WireCompressor::NONE`.
+ * @param threshold The smallest request payload compressed.
+ * @param level The zstd compression level.
+ * @param dictionary A zstd dictionary, or empty.
+ * @return `true` if the connection now uses the compressor.
+ */
+bool Connection::negotiate_compression(WireCompressor compressor, size_t threshold, int level,
+                                       std::string_view dictionary) {
+    if (!wire_compressor_available(compressor)) return false;
+    std::shared_ptr<const WireDictionary> digested;
+    if (!dictionary.empty() && (compressor != WireCompressor::ZSTD ||
+                                !WireDictionary::load(dictionary, level, digested).ok())) {
+        return false;
+    }
+    compression_requested_ = compressor;
+    compression_threshold_ = threshold;
+    compression_level_ = level;
+    dictionary_ = std::move(digested);
+
+    if (!is_connected()) {
+        if (!connect_server()) return false;
+    } else if (bson_mode_ || (compressor == WireCompressor::NONE &&
+                              codec_.compressor() != WireCompressor::NONE)) {
+        disconnect_server();
+        if (!connect_server()) return false;
+    } else if (compressor != WireCompressor::NONE && !send_hello()) {
+        return false;
+    }
+    return codec_.compressor() == compressor;
+}
+
 /**
  * @brief Closes the active socket connection.
  * @details This function checks if the `socket_fd_` is valid (>= 0) before attempting to `close()`
@@ -83,6 +195,10 @@ void Connection::disconnect_server() {
         close(socket_fd_);
         socket_fd_ = -1;
     }
+    bson_mode_ = false;
+    codec_.reset();
+    // Bytes of an unfinished response are meaningless on the next connection.
+    inbound_ = FrameDecoder(MAX_RESPONSE_SIZE, FrameDecoder::Mode::FRAMED);
 }
 
 /**
@@ -94,10 +210,8 @@ bool Connection::is_connected() const noexcept { return socket_fd_ >= 0; }
 /**
  * @brief Transmits a request to the server and retrieves the response.
  * @details This function first ensures a connection is active by calling `connect_server()`. If
- * the connection fails, it returns a descriptive JSON error. It then sends the entire `payload`
- * over the socket. Following the send, it blocks and waits to `recv` the server's response into a
- * fixed-size buffer. If any network operation fails, the connection is terminated, and an
- * appropriate JSON error is returned.
+ * the connection fails, it returns a descriptive JSON error. It then hands the payload to
+ * `exchange`, which sends it as one frame and receives the framed response.
  * @param payload The data to be sent to the server.
  * @return A `std::string` containing the server's response or a JSON error object.
  */
@@ -107,27 +221,68 @@ std::string Connection::send_request(std::string_view payload) {
             return R"({"status":"error","message":"Connection Failure: Unable to establish connection to AevumDB server."})";
         }
     }
+    return exchange(payload);
+}
 
-    ssize_t bytes_sent = send(socket_fd_, payload.data(), payload.length(), 0);
-    if (bytes_sent < 0) {
-        disconnect_server();
-        return R"({"status":"error","message":"Network Error: Failed to send data to server."})";
+/**
+ * @brief Sends a framed payload on the connected socket and receives the framed response.
+ * @details It frames the `payload`, compressed if the connection negotiated compression and it
+ * is large enough, and sends all of it, continuing after partial writes. It then blocks in
+ * `recv` until the decoder holds a complete response frame, which it decompresses if it is
+ * flagged. If any network operation fails, the connection is terminated, and an appropriate JSON
+ * error is returned.
+ * @param payload The data to be sent to the server.
+ * @return A `std::string` containing the server's response or a JSON error object.
+ */
+std::string Connection::exchange(std::string_view payload) {
+    outbound_.clear();
+    if (codec_.compress(payload, deflated_)) {
+        append_frame(outbound_, deflated_, true);
+    } else {
+        append_frame(outbound_, payload);
+    }
+    size_t sent = 0;
+    while (sent < outbound_.size()) {
+        ssize_t bytes_sent =
+            send(socket_fd_, outbound_.data() + sent, outbound_.size() - sent, MSG_NOSIGNAL);
+        if (bytes_sent < 0 && errno == EINTR) continue;
+        if (bytes_sent < 0) {
+            disconnect_server();
+            return R"({"status":"error","message":"Network Error: Failed to send data to server."})";
+        }
+        sent += static_cast<size_t>(bytes_sent);
     }
 
-    char buffer[16384];
-    std::memset(buffer, 0, sizeof(buffer));
+    std::string_view response;
+    for (;;) {
+        FrameDecoder::Result result = inbound_.next(response);
+        if (result == FrameDecoder::Result::MESSAGE) {
+            if (!inbound_.compressed()) return std::string(response);
+            std::string inflated;
+            if (!codec_.decompress(response, MAX_RESPONSE_SIZE, inflated).ok()) {
+                disconnect_server();
+                return R"({"status":"error","message":"Network Error: Received a corrupt compressed response."})";
+            }
+            return inflated;
+        }
+        if (result == FrameDecoder::Result::TOO_LARGE) {
+            disconnect_server();
+            return R"({"status":"error","message":"Network Error: Response exceeds the maximum size."})";
+        }
 
-    ssize_t bytes_read = recv(socket_fd_, buffer, sizeof(buffer) - 1, 0);
-    if (bytes_read <= 0) {
-        disconnect_server();
-        // A return value of 0 from recv indicates a graceful shutdown by the peer.
-        if (bytes_read == 0) {
-            return R"({"status":"error","message":"Connection Error: Connection was closed by the server."})";
+        char *space = inbound_.prepare(RESPONSE_CHUNK_SIZE);
+        ssize_t bytes_read = recv(socket_fd_, space, RESPONSE_CHUNK_SIZE, 0);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read <= 0) {
+            disconnect_server();
+            // A return value of 0 from recv indicates a graceful shutdown by the peer.
+            if (bytes_read == 0) {
+                return R"({"status":"error","message":"Connection Error: Connection was closed by the server."})";
+            }
+            return R"({"status":"error","message":"Network Error: Failed to receive response from server."})";
         }
-        return R"({"status":"error","message":"Network Error: Failed to receive response from server."})";
+        inbound_.commit(static_cast<size_t>(bytes_read));
     }
-
-    return std::string(buffer, bytes_read);
 }
 
 }  // namespace aevum::net::client
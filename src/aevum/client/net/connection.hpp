@@ -13,9 +13,13 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
 #include <string_view>
 
+#include "aevum/client/net/framing.hpp"
+#include "aevum/client/net/wire_compression.hpp"
+
 namespace aevum::net::client {
 
 /**
@@ -84,15 +88,76 @@ class Connection {
      * @brief Sends a request payload to the server and blocks until a response is received.
      * @details This is the primary method for client-server communication. If not currently
      * connected, it will first attempt to establish a connection via `connect_server()`. It then
-     * sends the provided payload and waits to receive a response from the server into a fixed-size
-     * buffer. In case of any send or receive error, it automatically disconnects.
+     * sends the provided payload as a length-prefixed frame and receives until the framed
+     * response is complete, however many segments it spans. In case of any send or receive
+     * error, it automatically disconnects.
      * @param payload A `std::string_view` representing the complete request data to be sent.
      * @return A `std::string` containing the raw response from the server. If a connection, send,
      *         or receive error occurs, a JSON-formatted error message is returned.
      */
     [[nodiscard]] std::string send_request(std::string_view payload);
 
+    /**
+     * @brief Switches the connection to the binary BSON protocol (see `bson_wire.hpp`).
+     * @details The request is remembered, so a connection re-established by `connect_server()`
+     * negotiates the protocol again before it is used. Once negotiated, `send_request` payloads
+     * and responses are BSON documents instead of JSON text.
+     * @return `true` if the server accepted the BSON protocol; `false` if it is unreachable or
+     * only speaks JSON, in which case the connection stays on JSON.
+     */
+    [[nodiscard]] bool negotiate_bson();
+
+    /**
+     * @brief Reports whether the connection currently speaks the BSON protocol.
+     * @return `true` if payloads and responses are BSON documents.
+     */
+    [[nodiscard]] bool bson_mode() const noexcept { return bson_mode_; }
+
+    /**
+     * @brief Asks the server to compress the frames of the connection (see
+     * `wire_compression.hpp`).
+     * @details As with `negotiate_bson`, the request is remembered and negotiated again by every
+     * new connection. An established JSON connection negotiates right away; a BSON connection,
+     * which no longer reads "hello" requests, is re-established, so this should be called before
+     * a session is opened with `login`.
+     * @param compressor `WireCompressor::LZ4` for latency-bound traffic, `WireCompressor::ZSTD`
+     *        for bulk traffic, or `WireCompressor::NONE` to stop asking.
+     * @param threshold The smallest request payload compressed, in bytes.
+     * @param level The zstd compression level.
+     * @param dictionary A zstd dictionary made by `zstd --train`, or empty. It is used only if
+     *        the server holds the same one.
+     * @return `true` if the server agreed to the compressor; `false` if it is unreachable, did
+     *         not agree, or the compressor or dictionary cannot be used by this build, in which
+     *         case frames are sent uncompressed.
+     */
+    [[nodiscard]] bool negotiate_compression(aevum::net::WireCompressor compressor,
+                                             size_t threshold = 1024, int level = 3,
+                                             std::string_view dictionary = {});
+
+    /**
+     * @brief Returns the compressor the current connection negotiated.
+     * @return The compressor, or `WireCompressor::NONE`.
+     */
+    [[nodiscard]] aevum::net::WireCompressor compression() const noexcept {
+        return codec_.compressor();
+    }
+
   private:
+    /**
+     * @brief Sends the "hello" request for the requested protocol and compression.
+     * @details Both are negotiated by a single request, and the connection is set up from the
+     * response.
+     * @return `false` if the connection was lost.
+     */
+    bool send_hello();
+
+    /**
+     * @brief Sends a framed payload on the connected socket and receives the framed response.
+     * @param payload The payload to send.
+     * @return The response payload, or a JSON error object after which the socket is closed.
+     */
+    [[nodiscard]] std::string exchange(std::string_view payload);
+
     /// The hostname or IP address of the remote AevumDB server.
     std::string host_;
     /// The TCP port number of the remote AevumDB server.
@@ -100,6 +165,26 @@ class Connection {
     /// The underlying file descriptor for the client socket. A value of -1 indicates a disconnected
     /// state.
     int socket_fd_;
+    /// The buffer a request frame is assembled in, reused across requests.
+    std::string outbound_;
+    /// Reassembles the framed responses; its buffer is reused across responses.
+    FrameDecoder inbound_;
+    /// `true` if the BSON protocol should be negotiated on every new connection.
+    bool bson_requested_{false};
+    /// `true` while the current connection speaks the BSON protocol.
+    bool bson_mode_{false};
+    /// The compressor to negotiate on every new connection.
+    aevum::net::WireCompressor compression_requested_{aevum::net::WireCompressor::NONE};
+    /// The smallest request payload compressed.
+    size_t compression_threshold_{0};
+    /// The zstd compression level.
+    int compression_level_{0};
+    /// The zstd dictionary offered to the server, or null.
+    std::shared_ptr<const aevum::net::WireDictionary> dictionary_;
+    /// Compresses the requests and decompresses the responses of the current connection.
+    aevum::net::WireCodec codec_;
+    /// The compressed payload of the last request, whose capacity the next one reuses.
+    std::string deflated_;
 };
 
 }  // namespace aevum::net::client
@@ -0,0 +1,247 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file framing.cpp
+ * @brief Implements the length-prefixed message framing and the `FrameDecoder`.
+ */
+#include "aevum/client/net/framing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace aevum::net {
+
+/**
+ * @brief Appends a framed message to a buffer.
+ * @details The length is written most significant byte first, so that the first byte of any
+ * message below 16 MiB is zero, which is what `FrameDecoder` uses to tell frames from bare JSON.
+ * @param out The buffer to append to.
+ * @param payload The message payload.
+ * @param compressed `true` to set the compression flag of the length.
+ */
+void append_frame(std::string &out, std::string_view payload, bool compressed) {
+    auto length = static_cast<uint32_t>(payload.size()) | (compressed ? COMPRESSED_FRAME_FLAG : 0);
+    char header[FRAME_HEADER_SIZE] = {
+        static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+        static_cast<char>(length >> 8), static_cast<char>(length)};
+    out.reserve(out.size() + FRAME_HEADER_SIZE + payload.size());
+    out.append(header, FRAME_HEADER_SIZE);
+    out.append(payload);
+}
+
+/**
+ * @brief Returns the request id a JSON message is tagged with.
+ * @details Whitespace is allowed around the braces, key, and colon, as produced by any JSON
+ * serializer.
+ * @param message The JSON message.
+ * @return The digits of the id, or an empty view.
+ */
+std::string_view find_request_id(std::string_view message) {
+    constexpr std::string_view key = "\"requestId\"";
+    auto skip_space = [&](size_t pos) {
+        while (pos < message.size() && std::strchr(" \t\r\n", message[pos]) && message[pos]) {
+            ++pos;
+        }
+        return pos;
+    };
+    size_t pos = skip_space(0);
+    if (pos >= message.size() || message[pos] != '{') return {};
+    pos = skip_space(pos + 1);
+    if (message.compare(pos, key.size(), key) != 0) return {};
+    pos = skip_space(pos + key.size());
+    if (pos >= message.size() || message[pos] != ':') return {};
+    size_t begin = skip_space(pos + 1);
+    size_t end = begin;
+    while (end < message.size() && message[end] >= '0' && message[end] <= '9') ++end;
+    return message.substr(begin, end - begin);
+}
+
+/**
+ * @brief Tags a JSON object with a request id, as its first field.
+ * @details An empty object receives the field alone, without a trailing comma.
+ * @param message The JSON object.
+ * @param request_id The digits of the id.
+ */
+void tag_request_id(std::string &message, std::string_view request_id) {
+    if (message.empty() || message.front() != '{') return;
+    size_t next = message.find_first_not_of(" \t\r\n", 1);
+    bool empty = next != std::string::npos && message[next] == '}';
+    std::string tag = "\"requestId\":" + std::string(request_id);
+    if (!empty) tag += ",";
+    message.insert(1, tag);
+}
+
+/**
+ * @brief Constructs an empty decoder.
+ * @param max_message_size The largest payload accepted, in bytes.
+ * @param mode The encoding of the stream, or `Mode::AUTO` to detect it.
+ */
+FrameDecoder::FrameDecoder(size_t max_message_size, Mode mode)
+    : max_message_size_(max_message_size), mode_(mode) {}
+
+/**
+ * @brief Returns writable space at the end of the buffer.
+ * @details The bytes of consumed messages are dropped by moving the unconsumed tail to the
+ * front. All offsets kept by the decoder are relative to `consumed_`, so none has to be
+ * adjusted. The buffer at least doubles when it grows, so receiving a large message costs
+ * amortized constant time per byte.
+ * @param size The number of bytes about to be received.
+ * @return The address to receive into.
+ */
+char *FrameDecoder::prepare(size_t size) {
+    if (consumed_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + consumed_, size_ - consumed_);
+        size_ -= consumed_;
+        consumed_ = 0;
+    }
+    if (buffer_.size() < size_ + size) {
+        buffer_.resize(std::max(size_ + size, buffer_.size() * 2));
+    }
+    return buffer_.data() + size_;
+}
+
+/**
+ * @brief Marks received bytes as buffered and, in `Mode::AUTO`, detects the encoding.
+ * @param size The number of bytes received.
+ */
+void FrameDecoder::commit(size_t size) {
+    size_ += size;
+    if (mode_ == Mode::AUTO && buffered() > 0) {
+        mode_ = buffer_[consumed_] == '\0' ? Mode::FRAMED : Mode::JSON;
+    }
+}
+
+/**
+ * @brief Takes the next complete message out of the buffer and resets the JSON scanner.
+ * @param message Receives the payload on `Result::MESSAGE`.
+ * @return The result of the search.
+ */
+FrameDecoder::Result FrameDecoder::next(std::string_view &message) {
+    Result result = locate();
+    if (result != Result::MESSAGE) return result;
+
+    message = std::string_view(buffer_.data() + consumed_ + message_begin_, message_size_);
+    consumed_ += message_span_;
+    compressed_ = message_compressed_;
+    located_ = false;
+    scan_offset_ = 0;
+    scan_depth_ = 0;
+    scan_in_string_ = false;
+    scan_escaped_ = false;
+    return result;
+}
+
+/**
+ * @brief Checks whether a complete message is buffered, without consuming it.
+ * @return The result `next` would return.
+ */
+FrameDecoder::Result FrameDecoder::peek() { return locate(); }
+
+/**
+ * @brief Locates the next message in the buffer.
+ * @details The outcome is cached until the message is consumed, so `peek` followed by `next`
+ * examines the buffer once.
+ * - In `Mode::FRAMED`, the message is complete once its header and `length` payload bytes are
+ *   buffered. A length above `max_message_size_` is `TOO_LARGE` as soon as the header arrives.
+ *   Once compressed frames are accepted, the flag bit is taken off the length first.
+ * - In `Mode::JSON`, whitespace between messages is skipped and the scanner resumed. Input that
+ *   does not start with `{` is returned as one message, as it was received. More than
+ *   `max_message_size_` bytes without the end of the object is `TOO_LARGE`.
+ * @return The result of the search.
+ */
+FrameDecoder::Result FrameDecoder::locate() {
+    if (located_) return Result::MESSAGE;
+    if (mode_ == Mode::AUTO || buffered() == 0) return Result::NEED_MORE;
+
+    const char *data = buffer_.data() + consumed_;
+    if (mode_ == Mode::FRAMED) {
+        if (buffered() < FRAME_HEADER_SIZE) return Result::NEED_MORE;
+        const auto *header = reinterpret_cast<const unsigned char *>(data);
+        size_t length = (size_t{header[0]} << 24) | (size_t{header[1]} << 16) |
+                        (size_t{header[2]} << 8) | size_t{header[3]};
+        message_compressed_ = accept_compressed_ && (length & COMPRESSED_FRAME_FLAG) != 0;
+        if (message_compressed_) length &= ~size_t{COMPRESSED_FRAME_FLAG};
+        if (length > max_message_size_) return Result::TOO_LARGE;
+        if (buffered() < FRAME_HEADER_SIZE + length) return Result::NEED_MORE;
+        message_begin_ = FRAME_HEADER_SIZE;
+        message_size_ = length;
+        message_span_ = FRAME_HEADER_SIZE + length;
+        located_ = true;
+        return Result::MESSAGE;
+    }
+
+    if (scan_offset_ == 0) {
+        while (buffered() > 0) {
+            char c = buffer_[consumed_];
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') break;
+            ++consumed_;
+        }
+        if (buffered() == 0) return Result::NEED_MORE;
+        if (buffer_[consumed_] != '{') {
+            message_begin_ = 0;
+            message_compressed_ = false;
+            message_size_ = buffered();
+            message_span_ = buffered();
+            located_ = true;
+            return Result::MESSAGE;
+        }
+    }
+
+    if (!scan_json()) {
+        return buffered() > max_message_size_ ? Result::TOO_LARGE : Result::NEED_MORE;
+    }
+    message_begin_ = 0;
+    message_compressed_ = false;
+    message_size_ = scan_offset_;
+    message_span_ = scan_offset_;
+    located_ = true;
+    return Result::MESSAGE;
+}
+
+/**
+ * @brief Advances the JSON scanner over the unscanned bytes.
+ * @details Braces and brackets inside string literals are ignored, and so is a quote preceded
+ * by a backslash. The object ends when the depth returns to zero.
+ * @return `true` once the end of the current object has been found; `scan_offset_` then holds
+ * the object's size.
+ */
+bool FrameDecoder::scan_json() {
+    const char *data = buffer_.data() + consumed_;
+    size_t available = buffered();
+    for (; scan_offset_ < available; ++scan_offset_) {
+        char c = data[scan_offset_];
+        if (scan_in_string_) {
+            if (scan_escaped_) {
+                scan_escaped_ = false;
+            } else if (c == '\\') {
+                scan_escaped_ = true;
+            } else if (c == '"') {
+                scan_in_string_ = false;
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                scan_in_string_ = true;
+                break;
+            case '{':
+            case '[':
+                ++scan_depth_;
+                break;
+            case '}':
+            case ']':
+                if (scan_depth_ > 0 && --scan_depth_ == 0) {
+                    ++scan_offset_;
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+}  // namespace aevum::net
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file framing.hpp
+ * @brief Declares the message framing shared by the network server and client.
+ * @details TCP delivers a byte stream, not messages, so a request may arrive in several segments
+ * and several pipelined requests may arrive in one. A framed message is a 4-byte, big-endian
+ * payload length followed by the payload. `FrameDecoder` reassembles such messages from the bytes
+ * read off a socket into a growable buffer that is reused across messages. For clients that send
+ * bare JSON instead, it can also delimit each top-level JSON object with an incremental scanner.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace aevum::net {
+
+/// The size of the length prefix of a framed message.
+constexpr size_t FRAME_HEADER_SIZE = 4;
+
+/// The bit of the length prefix that marks a compressed payload, on a connection that negotiated
+/// compression (see `wire_compression.hpp`).
+constexpr uint32_t COMPRESSED_FRAME_FLAG = 0x80000000U;
+
+/**
+ * @brief Appends a framed message, its length prefix followed by the payload, to a buffer.
+ * @param out The buffer to append to.
+ * @param payload The message payload, shorter than 4 GiB, or 2 GiB if compressed.
+ * @param compressed `true` to flag the payload as compressed (see `COMPRESSED_FRAME_FLAG`).
+ */
+void append_frame(std::string &out, std::string_view payload, bool compressed = false);
+
+/**
+ * @brief Returns the request id a JSON message is tagged with.
+ * @details A client that pipelines requests may tag each one with `"requestId":<unsigned integer>`
+ * as the first field of the object; the server then tags the response with the same id, so that
+ * responses can be correlated with their requests. Only the first field is examined, so a
+ * `requestId` field inside a document cannot be mistaken for the tag.
+ * @param message The JSON message.
+ * @return The digits of the id, or an empty view if the message is not tagged.
+ */
+[[nodiscard]] std::string_view find_request_id(std::string_view message);
+
+/**
+ * @brief Tags a JSON object with a request id, as its first field.
+ * @param message The JSON object, which must begin with `{`; left unchanged otherwise.
+ * @param request_id The digits of the id.
+ */
+void tag_request_id(std::string &message, std::string_view request_id);
+
+/**
+ * @class FrameDecoder
+ * @brief Splits the bytes received on a connection into complete messages.
+ *
+ * @details Received bytes are written into the decoder's buffer with `prepare` and `commit`, and
+ * complete messages are taken out with `next`. Consumed bytes are discarded lazily, when more
+ * space is prepared, so the buffer's capacity is kept across messages and a burst of pipelined
+ * messages costs a single compaction.
+ *
+ * In `Mode::AUTO` the encoding is decided by the first byte of the stream: a zero byte (the high
+ * byte of the length of any message below 16 MiB) selects `Mode::FRAMED`, anything else
+ * `Mode::JSON`. In `Mode::JSON` every top-level JSON object is a message; its end is found by a
+ * scanner that tracks nesting depth and string literals and resumes where it stopped, so each
+ * byte is examined only once however many segments the object spans. Input that does not begin
+ * with `{` is passed on as it was received, so that the request parser can reject it.
+ *
+ * The class is not thread-safe; a connection is only ever decoded by one thread at a time.
+ */
+class FrameDecoder {
+  public:
+    /**
+     * @enum Mode
+     * @brief The encoding of the messages on the stream.
+     */
+    enum class Mode : uint8_t {
+        /// Decided by the first byte received.
+        AUTO = 0,
+        /// Length-prefixed frames.
+        FRAMED = 1,
+        /// Bare JSON objects.
+        JSON = 2
+    };
+
+    /**
+     * @enum Result
+     * @brief The outcome of `next`.
+     */
+    enum class Result : uint8_t {
+        /// A complete message was returned.
+        MESSAGE = 0,
+        /// No complete message is buffered yet.
+        NEED_MORE = 1,
+        /// The next message exceeds the size limit; the stream cannot be decoded any further.
+        TOO_LARGE = 2
+    };
+
+    /**
+     * @brief Constructs an empty decoder.
+     * @param max_message_size The largest payload accepted, in bytes.
+     * @param mode The encoding of the stream, or `Mode::AUTO` to detect it.
+     */
+    explicit FrameDecoder(size_t max_message_size, Mode mode = Mode::AUTO);
+
+    /**
+     * @brief Returns writable space for at least `size` bytes at the end of the buffer.
+     * @details Compacts the buffer first if messages have been consumed. The pointer is valid
+     * until the next call to any non-const method.
+     * @param size The number of bytes about to be received.
+     * @return The address to receive into.
+     */
+    [[nodiscard]] char *prepare(size_t size);
+
+    /**
+     * @brief Marks bytes written into the space returned by `prepare` as received.
+     * @param size The number of bytes actually received (at most the prepared size).
+     */
+    void commit(size_t size);
+
+    /**
+     * @brief Takes the next complete message out of the buffer.
+     * @param message Receives the payload on `Result::MESSAGE`. The view is valid until the next
+     *        call to any non-const method.
+     * @return Whether a message was returned, more bytes are needed, or the stream is unusable.
+     */
+    [[nodiscard]] Result next(std::string_view &message);
+
+    /**
+     * @brief Checks whether a complete message is buffered, without consuming it.
+     * @return The result `next` would return.
+     */
+    [[nodiscard]] Result peek();
+
+    /**
+     * @brief Returns the encoding of the stream.
+     * @return The configured or detected mode; `Mode::AUTO` until the first byte is received.
+     */
+    [[nodiscard]] Mode mode() const noexcept { return mode_; }
+
+    /**
+     * @brief Accepts frames flagged with `COMPRESSED_FRAME_FLAG` from now on.
+     * @details Until then, a flagged length exceeds any size limit and is `Result::TOO_LARGE`.
+     * @param accept `true` once the connection has negotiated compression.
+     */
+    void accept_compressed(bool accept) noexcept { accept_compressed_ = accept; }
+
+    /**
+     * @brief Reports whether the message last returned by `next` was flagged as compressed.
+     * @return `true` if its payload must be decompressed.
+     */
+    [[nodiscard]] bool compressed() const noexcept { return compressed_; }
+
+    /**
+     * @brief Returns the number of received bytes not yet consumed.
+     * @return The buffered size.
+     */
+    [[nodiscard]] size_t buffered() const noexcept { return size_ - consumed_; }
+
+  private:
+    /**
+     * @brief Locates the next message and records it in `message_begin_` and `message_size_`.
+     * @return The result of the search.
+     */
+    Result locate();
+
+    /**
+     * @brief Advances the JSON scanner over the unscanned bytes.
+     * @return `true` once the end of the current object has been found.
+     */
+    bool scan_json();
+
+    /// The largest payload accepted.
+    size_t max_message_size_;
+    /// The encoding of the stream.
+    Mode mode_;
+    /// The received bytes. Only the first `size_` are valid.
+    std::string buffer_;
+    /// The number of valid bytes in `buffer_`.
+    size_t size_{0};
+    /// The number of bytes at the front of `buffer_` that belong to consumed messages.
+    size_t consumed_{0};
+    /// `true` if `message_begin_` and `message_size_` describe a located message.
+    bool located_{false};
+    /// The offset, from `consumed_`, of the located message's payload.
+    size_t message_begin_{0};
+    /// The size of the located message's payload.
+    size_t message_size_{0};
+    /// The number of bytes, from `consumed_`, that occupy the located message including framing.
+    size_t message_span_{0};
+    /// `true` if frames may be flagged with `COMPRESSED_FRAME_FLAG`.
+    bool accept_compressed_{false};
+    /// `true` if the located message is flagged as compressed.
+    bool message_compressed_{false};
+    /// `true` if the message last returned by `next` is flagged as compressed.
+    bool compressed_{false};
+
+    /// JSON scanner: the offset, from `consumed_`, of the next byte to examine.
+    size_t scan_offset_{0};
+    /// JSON scanner: the current nesting depth of objects and arrays.
+    size_t scan_depth_{0};
+    /// JSON scanner: `true` inside a string literal.
+    bool scan_in_string_{false};
+    /// JSON scanner: `true` if the previous byte in a string literal was a backslash.
+    bool scan_escaped_{false};
+};
+
+}  // namespace aevum::net
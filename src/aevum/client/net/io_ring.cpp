@@ -0,0 +1,234 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file io_ring.cpp
+ * @brief Implements `IoRing` on the raw `io_uring` system calls.
+ */
+#include "aevum/client/net/io_ring.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_io_uring_setup) && defined(IORING_ENTER_EXT_ARG)
+#define AEVUM_HAVE_IO_URING 1
+#endif
+#endif
+
+#if !defined(AEVUM_HAVE_IO_URING)
+struct io_uring_sqe {};
+struct io_uring_cqe {};
+#endif
+
+namespace aevum::net::server {
+
+#if defined(AEVUM_HAVE_IO_URING)
+
+namespace {
+
+/**
+ * @brief Calls `io_uring_enter`.
+ * @param fd The ring.
+ * @param to_submit The number of queued operations to submit.
+ * @param min_complete The number of completions to wait for.
+ * @param flags The `IORING_ENTER_*` flags.
+ * @param arg The extended argument, or null.
+ * @param arg_size The size of `arg`.
+ * @return The number of operations submitted, or -1 with `errno` set.
+ */
+int ring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg,
+               size_t arg_size) {
+    return static_cast<int>(
+        syscall(SYS_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size));
+}
+
+/// Reads an index of a queue that the kernel advances.
+unsigned load_acquire(const unsigned *index) { return __atomic_load_n(index, __ATOMIC_ACQUIRE); }
+
+/// Publishes an index of a queue that the kernel reads.
+void store_release(unsigned *index, unsigned value) {
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+}  // namespace
+
+/**
+ * @brief Unmaps the queues and closes the ring.
+ */
+IoRing::~IoRing() {
+    if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+    if (rings_ != nullptr) munmap(rings_, rings_size_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+/**
+ * @brief Creates the ring and maps its queues.
+ * @details The server needs a single mapping for both rings (5.4), completions that are never
+ * dropped when the queue overflows (5.5), and a timeout passed to `io_uring_enter` (5.11). A
+ * kernel lacking one of them is reported as not supporting `io_uring` at all.
+ * @param entries The size of the submission queue.
+ * @param completions The size of the completion queue.
+ * @return `aevum::util::Status::OK()`, or `NotSupported`.
+ */
+aevum::util::Status IoRing::open(unsigned entries, unsigned completions) {
+    struct io_uring_params params {};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = std::max(completions, entries);
+    int fd = static_cast<int>(syscall(SYS_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        return aevum::util::Status::NotSupported("io_uring_setup failed: " +
+                                                 std::string(std::strerror(errno)));
+    }
+    fd_ = fd;
+    const unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+    if ((params.features & required) != required) {
+        return aevum::util::Status::NotSupported("the kernel's io_uring lacks required features");
+    }
+
+    rings_size_ = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                           params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    void *rings = mmap(nullptr, rings_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd_, IORING_OFF_SQ_RING);
+    if (rings == MAP_FAILED) {
+        return aevum::util::Status::NotSupported("cannot map the io_uring queues: " +
+                                                 std::string(std::strerror(errno)));
+    }
+    rings_ = rings;
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return aevum::util::Status::NotSupported("cannot map the io_uring entries: " +
+                                                 std::string(std::strerror(errno)));
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    auto *base = static_cast<char *>(rings_);
+    sq_head_ = reinterpret_cast<unsigned *>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(base + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(base + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(base + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned *>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(base + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(base + params.cq_off.cqes);
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Submits an `IORING_OP_RECV` into a buffer.
+ * @param fd The socket.
+ * @param buffer Where to receive the data.
+ * @param length The capacity of `buffer`.
+ * @param user_data Identifies the operation's completion.
+ * @return `true` if the operation was submitted.
+ */
+bool IoRing::receive(int fd, void *buffer, size_t length, uint64_t user_data) {
+    io_uring_sqe sqe{};
+    sqe.opcode = IORING_OP_RECV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<uint64_t>(buffer);
+    sqe.len = static_cast<uint32_t>(length);
+    sqe.user_data = user_data;
+    return submit(sqe);
+}
+
+/**
+ * @brief Submits a one-shot `IORING_OP_POLL_ADD` for `POLLIN`.
+ * @param fd The descriptor.
+ * @param user_data Identifies the operation's completion.
+ * @return `true` if the operation was submitted.
+ */
+bool IoRing::poll_readable(int fd, uint64_t user_data) {
+    io_uring_sqe sqe{};
+    sqe.opcode = IORING_OP_POLL_ADD;
+    sqe.fd = fd;
+    sqe.poll32_events = POLLIN;
+    sqe.user_data = user_data;
+    return submit(sqe);
+}
+
+/**
+ * @brief Queues an operation and submits it to the kernel.
+ * @details The queue is drained by every call, so the entry is always free. If the kernel
+ * refuses the submission, the entry is taken back, so that it cannot be submitted later with a
+ * buffer its owner has released in the meantime.
+ * @param sqe The operation.
+ * @return `true` if the kernel accepted it.
+ */
+bool IoRing::submit(const io_uring_sqe &sqe) {
+    std::lock_guard<std::mutex> lock(submit_mutex_);
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & sq_mask_;
+    sqes_[index] = sqe;
+    sq_array_[index] = index;
+    store_release(sq_tail_, tail + 1);
+    int submitted;
+    do {
+        submitted = ring_enter(fd_, 1, 0, 0, nullptr, 0);
+    } while (submitted < 0 && errno == EINTR);
+    if (submitted == 1) return true;
+    if (load_acquire(sq_head_) == tail) store_release(sq_tail_, tail);
+    return false;
+}
+
+/**
+ * @brief Waits for completions and reaps them.
+ * @details The timeout is passed with `IORING_ENTER_EXT_ARG`, so no timeout operation has to be
+ * queued. Completions are copied out and the queue's head published once for the whole batch.
+ * @param out Receives the completions.
+ * @param timeout_ms The longest time to wait for the first completion.
+ * @return The number of completions reaped.
+ */
+size_t IoRing::wait(std::vector<Completion> &out, int timeout_ms) {
+    struct __kernel_timespec timeout {};
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+    struct io_uring_getevents_arg arg {};
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+    if (*cq_head_ == load_acquire(cq_tail_)) {
+        (void)ring_enter(fd_, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                         sizeof(arg));
+    }
+
+    unsigned head = *cq_head_;
+    unsigned tail = load_acquire(cq_tail_);
+    for (unsigned i = head; i != tail; ++i) {
+        const io_uring_cqe &cqe = cqes_[i & cq_mask_];
+        out.push_back({cqe.user_data, cqe.res});
+    }
+    store_release(cq_head_, tail);
+    return tail - head;
+}
+
+#else
+
+IoRing::~IoRing() = default;
+
+aevum::util::Status IoRing::open(unsigned, unsigned) {
+    return aevum::util::Status::NotSupported("io_uring is not available on this platform");
+}
+
+bool IoRing::receive(int, void *, size_t, uint64_t) { return false; }
+
+bool IoRing::poll_readable(int, uint64_t) { return false; }
+
+size_t IoRing::wait(std::vector<Completion> &, int) { return 0; }
+
+bool IoRing::submit(const io_uring_sqe &) { return false; }
+
+#endif
+
+}  // namespace aevum::net::server
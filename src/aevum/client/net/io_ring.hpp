@@ -0,0 +1,138 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file io_ring.hpp
+ * @brief Declares `IoRing`, a minimal `io_uring` instance through which an event loop receives
+ * from its connections.
+ * @details With `epoll`, a connection costs a wake-up, a `recv` per chunk, a `recv` that fails
+ * with `EAGAIN`, and an `epoll_ctl` to re-arm it. With a ring, the receive itself is submitted:
+ * the kernel completes it once data has arrived, straight into the connection's buffer, and the
+ * completions of every connection of the loop are reaped by one `io_uring_enter`. The ring is
+ * driven with the raw system calls and only supports the few operations the server submits, so
+ * that no library is needed. Kernels older than 5.11, and hosts where `io_uring` is disabled,
+ * fail `open`, and the server falls back to `epoll`.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "aevum/util/status.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace aevum::net::server {
+
+/**
+ * @class IoRing
+ * @brief A submission and a completion queue shared with the kernel.
+ *
+ * @details Submissions may come from any thread; they are serialized by a mutex and handed to the
+ * kernel at once, so an operation never waits in the queue. Completions must be reaped by a
+ * single thread, the event loop's. A buffer handed to `receive` must stay valid until the
+ * operation's completion has been reaped.
+ */
+class IoRing {
+  public:
+    /**
+     * @struct Completion
+     * @brief The outcome of one submitted operation.
+     */
+    struct Completion {
+        /// The value the operation was submitted with.
+        uint64_t user_data;
+        /// The result of the operation: a byte count, or a negated `errno`.
+        int32_t result;
+    };
+
+    IoRing() = default;
+
+    /**
+     * @brief Unmaps the queues and closes the ring, which cancels the pending operations.
+     */
+    ~IoRing();
+
+    IoRing(const IoRing &) = delete;
+    IoRing &operator=(const IoRing &) = delete;
+
+    /**
+     * @brief Creates the ring.
+     * @param entries The size of the submission queue.
+     * @param completions The size of the completion queue, at least the number of operations
+     *        that may be pending at once; further completions are buffered by the kernel.
+     * @return `aevum::util::Status::OK()`, or `NotSupported` if the kernel cannot create a ring
+     *         with the features the server relies on.
+     */
+    [[nodiscard]] aevum::util::Status open(unsigned entries, unsigned completions);
+
+    /**
+     * @brief Submits a receive from a socket.
+     * @param fd The socket, which should be in blocking mode; the kernel then waits for data
+     *        rather than failing with `EAGAIN`.
+     * @param buffer Where to receive the data.
+     * @param length The capacity of `buffer`.
+     * @param user_data Identifies the operation's completion.
+     * @return `true` if the operation was submitted.
+     */
+    bool receive(int fd, void *buffer, size_t length, uint64_t user_data);
+
+    /**
+     * @brief Submits a one-shot wait for a descriptor to become readable.
+     * @param fd The descriptor.
+     * @param user_data Identifies the operation's completion.
+     * @return `true` if the operation was submitted.
+     */
+    bool poll_readable(int fd, uint64_t user_data);
+
+    /**
+     * @brief Waits for completions and reaps them.
+     * @param out Receives the completions, which are appended.
+     * @param timeout_ms The longest time to wait for the first completion.
+     * @return The number of completions reaped; 0 on timeout, interruption, or error.
+     */
+    size_t wait(std::vector<Completion> &out, int timeout_ms);
+
+  private:
+    /**
+     * @brief Queues an operation and submits it to the kernel.
+     * @param sqe The operation.
+     * @return `true` if the kernel accepted it.
+     */
+    bool submit(const io_uring_sqe &sqe);
+
+    /// The ring's file descriptor.
+    int fd_{-1};
+    /// The mapping of both queues' rings.
+    void *rings_{nullptr};
+    /// The size of `rings_`.
+    size_t rings_size_{0};
+    /// The mapping of the submission queue entries.
+    io_uring_sqe *sqes_{nullptr};
+    /// The size of `sqes_`.
+    size_t sqes_size_{0};
+    /// The submission queue's head, advanced by the kernel.
+    unsigned *sq_head_{nullptr};
+    /// The submission queue's tail, advanced by `submit`.
+    unsigned *sq_tail_{nullptr};
+    /// The mask of submission queue indexes.
+    unsigned sq_mask_{0};
+    /// The submission queue's indirection array.
+    unsigned *sq_array_{nullptr};
+    /// The completion queue's head, advanced by `wait`.
+    unsigned *cq_head_{nullptr};
+    /// The completion queue's tail, advanced by the kernel.
+    unsigned *cq_tail_{nullptr};
+    /// The mask of completion queue indexes.
+    unsigned cq_mask_{0};
+    /// The completion queue entries.
+    io_uring_cqe *cqes_{nullptr};
+    /// Serializes submissions.
+    std::mutex submit_mutex_;
+};
+
+}  // namespace aevum::net::server
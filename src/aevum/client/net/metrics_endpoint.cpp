@@ -0,0 +1,153 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file metrics_endpoint.cpp
+ * @brief Implements `MetricsEndpoint`.
+ */
+#include "aevum/client/net/metrics_endpoint.hpp"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+#include "aevum/util/metrics/prometheus_text.hpp"
+
+namespace aevum::net::server {
+
+namespace {
+
+/// The most bytes of a request the endpoint reads; scrape requests are a few hundred.
+constexpr size_t MAX_METRICS_REQUEST_SIZE = 8192;
+/// How long a scrape connection may take to send its request or receive the response.
+constexpr int METRICS_SOCKET_TIMEOUT_SEC = 5;
+
+/**
+ * @brief Sends a complete HTTP response on a blocking socket.
+ * @param fd The socket.
+ * @param status The status line after the version, e.g. `"200 OK"`.
+ * @param content_type The `Content-Type` of the body.
+ * @param body The body.
+ */
+void send_http_response(int fd, std::string_view status, std::string_view content_type,
+                        std::string_view body) {
+    std::string response = "HTTP/1.1 " + std::string(status) +
+                           "\r\nContent-Type: " + std::string(content_type) +
+                           "\r\nContent-Length: " + std::to_string(body.size()) +
+                           "\r\nConnection: close\r\n\r\n";
+    response.append(body);
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+}  // namespace
+
+MetricsEndpoint::MetricsEndpoint(int port, Renderer render)
+    : port_(port), render_(std::move(render)) {}
+
+MetricsEndpoint::~MetricsEndpoint() { stop(); }
+
+void MetricsEndpoint::start() {
+    socket_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_fd_ < 0) {
+        throw std::runtime_error("Failed to create metrics socket: " +
+                                 std::string(strerror(errno)));
+    }
+    int opt = 1;
+    (void)setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port_);
+    if (bind(socket_fd_, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(socket_fd_, 16) < 0) {
+        std::string error = strerror(errno);
+        close(socket_fd_);
+        socket_fd_ = -1;
+        throw std::runtime_error("Failed to listen for metrics scrapes on port " +
+                                 std::to_string(port_) + ": " + error);
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MetricsEndpoint::serve, this);
+    AEVUM_LOG_INFO("Network: Serving Prometheus metrics on port " + std::to_string(port_) +
+                   " at /metrics.");
+}
+
+/**
+ * @brief Closes the listening socket and joins the thread.
+ * @details Shutting the socket down wakes the thread from `accept`, which then sees
+ * `running_` cleared and exits.
+ */
+void MetricsEndpoint::stop() {
+    if (!running_.exchange(false)) return;
+    shutdown(socket_fd_, SHUT_RDWR);
+    if (thread_.joinable()) thread_.join();
+    close(socket_fd_);
+    socket_fd_ = -1;
+}
+
+void MetricsEndpoint::serve() {
+    aevum::util::concurrency::set_current_thread_name("Metrics");
+    while (running_) {
+        int fd = accept4(socket_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (!running_) break;
+            if (errno != EINTR && errno != ECONNABORTED) {
+                AEVUM_LOG_WARN("Network: accept() on the metrics port failed: " +
+                               std::string(strerror(errno)));
+            }
+            continue;
+        }
+        struct timeval timeout{};
+        timeout.tv_sec = METRICS_SOCKET_TIMEOUT_SEC;
+        (void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        (void)setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        answer(fd);
+        close(fd);
+    }
+}
+
+/**
+ * @brief Reads one HTTP request from a connection and sends the response.
+ * @details Only the request line matters: the headers are read up to the blank line that ends
+ * them, so the client is not reset while still sending, and then ignored. `GET /metrics`, with
+ * or without a query string, is answered with the rendered text and anything else with 404.
+ */
+void MetricsEndpoint::answer(int fd) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < MAX_METRICS_REQUEST_SIZE) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    std::string_view line(request);
+    line = line.substr(0, line.find("\r\n"));
+    if (line.rfind("GET /metrics ", 0) != 0 && line.rfind("GET /metrics?", 0) != 0) {
+        send_http_response(fd, "404 Not Found", "text/plain", "Not Found\n");
+        return;
+    }
+    send_http_response(fd, "200 OK", aevum::util::metrics::PrometheusText::CONTENT_TYPE,
+                       render_());
+}
+
+}  // namespace aevum::net::server
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file metrics_endpoint.hpp
+ * @brief Declares `MetricsEndpoint`, a minimal HTTP listener that serves `GET /metrics` for
+ * Prometheus scrapers.
+ * @details Scrapers speak HTTP, not the framed JSON protocol of the `Server`, and poll every few
+ * seconds, so the endpoint is a separate port served by one blocking thread. It answers nothing
+ * but the metrics text; every other request gets a 404.
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace aevum::net::server {
+
+/**
+ * @class MetricsEndpoint
+ * @brief Serves the text produced by a renderer at `GET /metrics` on a TCP port.
+ *
+ * @details Connections are accepted and answered one at a time, each with a single
+ * `Connection: close` response, under a short timeout so that a stalled client cannot hold the
+ * thread. The endpoint requires no authentication; it is disabled unless a port is configured,
+ * and should only be reachable from the monitoring network.
+ */
+class MetricsEndpoint {
+  public:
+    /// Produces the body of a response; called on the endpoint's thread for every scrape.
+    using Renderer = std::function<std::string()>;
+
+    /**
+     * @brief Constructs a stopped endpoint.
+     * @param port The TCP port to listen on.
+     * @param render Produces the metrics text.
+     */
+    MetricsEndpoint(int port, Renderer render);
+
+    /**
+     * @brief Stops the endpoint if it is running.
+     */
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint &) = delete;
+    MetricsEndpoint &operator=(const MetricsEndpoint &) = delete;
+
+    /**
+     * @brief Binds the port and starts the thread that serves it.
+     * @throws `std::runtime_error` if the socket cannot be created, bound, or listened on.
+     */
+    void start();
+
+    /**
+     * @brief Closes the listening socket and joins the thread. Idempotent.
+     */
+    void stop();
+
+  private:
+    /**
+     * @brief The body of the endpoint's thread: accepts and answers connections until stopped.
+     */
+    void serve();
+
+    /**
+     * @brief Reads one HTTP request from a connection and sends the response.
+     * @param fd The connected socket; closed by the caller.
+     */
+    void answer(int fd);
+
+    /// The TCP port to listen on.
+    int port_;
+    /// Produces the metrics text.
+    Renderer render_;
+    /// The listening socket, or -1 when stopped.
+    int socket_fd_{-1};
+    /// `true` between `start` and `stop`.
+    std::atomic<bool> running_{false};
+    /// The thread that runs `serve`.
+    std::thread thread_;
+};
+
+}  // namespace aevum::net::server
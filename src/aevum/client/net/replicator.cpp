@@ -0,0 +1,340 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file replicator.cpp
+ * @brief Implements the `Replicator`, which keeps a read replica in step with its primary.
+ */
+#include "aevum/client/net/replicator.hpp"
+
+#include <bson/bson.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "aevum/client/aevum_client.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+#include "simdjson.h"
+
+namespace aevum::net::server {
+
+namespace {
+
+/// The wait before retrying a failed connection or batch, in milliseconds.
+constexpr int64_t RETRY_PAUSE_MS = 1000;
+/// The most `_id`s fetched from the primary by one query.
+constexpr size_t FETCH_CHUNK = 1000;
+
+/**
+ * @brief Returns the current time of the steady clock in milliseconds.
+ * @return The milliseconds since the clock's epoch.
+ */
+int64_t steady_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Builds the filter `{"_id": {"$in": [ids...]}}`.
+ * @param ids The `_id`s.
+ * @param integer_ids `true` if the `_id`s are the decimal keys of an integer-keyed collection,
+ *        which are matched as the integers they are.
+ * @return The filter.
+ */
+aevum::bson::doc::Document id_filter(const std::vector<std::string> &ids, bool integer_ids) {
+    bson_t *query = bson_new();
+    bson_t id_doc;
+    bson_t in_array;
+    bson_append_document_begin(query, "_id", -1, &id_doc);
+    bson_append_array_begin(&id_doc, "$in", -1, &in_array);
+    char index_buffer[16];
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const char *index_key = nullptr;
+        bson_uint32_to_string(static_cast<uint32_t>(i), &index_key, index_buffer,
+                              sizeof(index_buffer));
+        if (integer_ids) {
+            bson_append_int64(&in_array, index_key, -1, std::stoll(ids[i]));
+        } else {
+            bson_append_utf8(&in_array, index_key, -1, ids[i].data(),
+                             static_cast<int>(ids[i].size()));
+        }
+    }
+    bson_append_array_end(&id_doc, &in_array);
+    bson_append_document_end(query, &id_doc);
+    return aevum::bson::doc::Document(query);
+}
+
+/**
+ * @struct CollectionBatch
+ * @brief The changes of one collection in a batch, as applied by `Core::apply_replicated`.
+ */
+struct CollectionBatch {
+    /// The name of the collection.
+    std::string collection;
+    /// `true` if the collection is integer-keyed, whose `_id`s are kept as decimal keys.
+    bool integer_ids = false;
+    /// The changed `_id`s whose last record in the batch is not a deletion.
+    std::vector<std::string> changed_ids;
+    /// The current versions of `changed_ids` on the primary.
+    std::vector<aevum::bson::doc::Document> docs;
+    /// The `_id`s to remove: those deleted last in the batch, and those the primary no longer has.
+    std::vector<std::string> deleted_ids;
+};
+
+}  // namespace
+
+/**
+ * @brief Starts replicating from the configured primary.
+ * @param core The local engine.
+ * @param config The primary and the pull settings.
+ */
+Replicator::Replicator(db::Core &core, ReplicationConfig config)
+    : core_(core),
+      config_(std::move(config)),
+      apply_pool_("Replicate", config_.apply_threads > 0
+                                   ? static_cast<size_t>(config_.apply_threads)
+                                   : std::max(1u, std::thread::hardware_concurrency())),
+      thread_(&Replicator::run, this) {}
+
+/**
+ * @brief Stops the replication thread.
+ */
+Replicator::~Replicator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ * @brief Returns the time since the replica last held every change of the primary.
+ * @return The staleness in milliseconds, or -1.
+ */
+int64_t Replicator::staleness_ms() const noexcept {
+    int64_t caught_up = caught_up_ms_.load(std::memory_order_acquire);
+    return caught_up < 0 ? -1 : std::max<int64_t>(0, steady_now_ms() - caught_up);
+}
+
+/**
+ * @brief Returns a snapshot of the progress of the replicator.
+ * @return The snapshot.
+ */
+ReplicationStats Replicator::stats() const noexcept {
+    ReplicationStats stats;
+    stats.resume_token = resume_token_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.documents_applied = documents_applied_.load(std::memory_order_relaxed);
+    stats.documents_deleted = documents_deleted_.load(std::memory_order_relaxed);
+    stats.errors = errors_.load(std::memory_order_relaxed);
+    stats.staleness_ms = staleness_ms();
+    return stats;
+}
+
+/**
+ * @brief Waits before a retry, unless the replicator is stopping.
+ * @param milliseconds How long to wait.
+ * @return `false` if the replicator is stopping.
+ */
+bool Replicator::pause(int64_t milliseconds) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !stop_cv_.wait_for(lock, std::chrono::milliseconds(milliseconds),
+                              [&]() { return stop_; });
+}
+
+/**
+ * @brief The body of the replication thread.
+ * @details Connects to the primary, switches the connection to the BSON protocol, and pulls
+ * batches until the replicator is stopped. A `watch` waits on the primary for at most
+ * `poll_wait_ms`, so a stop request is seen within that time.
+ */
+void Replicator::run() {
+    aevum::util::concurrency::set_current_thread_name("Replicator");
+    uint64_t token = core_.replication_token();
+    if (token == 0) token = core_.change_log_stats().last_sequence;
+    resume_token_.store(token, std::memory_order_relaxed);
+
+    std::string primary = config_.primary_host + ":" + std::to_string(config_.primary_port);
+    AEVUM_LOG_INFO("Replicator: Replicating from " + primary + " after sequence number " +
+                   std::to_string(token) + ".");
+    aevum::client::AevumClient client(config_.primary_host, config_.primary_port,
+                                      config_.primary_auth);
+    bool connected = false;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_) return;
+        }
+        if (!connected) {
+            connected = client.connect() && client.use_bson_protocol();
+            if (!connected) {
+                AEVUM_LOG_WARN("Replicator: Cannot reach the primary at " + primary +
+                               " over the BSON protocol; retrying.");
+                if (!pause(RETRY_PAUSE_MS)) return;
+                continue;
+            }
+        }
+        if (!replicate_batch(client)) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            if (!pause(RETRY_PAUSE_MS)) return;
+        }
+    }
+}
+
+/**
+ * @brief Pulls and applies one batch of the primary's change log.
+ * @details The records are reduced to the last operation on each `_id`. The documents whose last
+ * operation is not a deletion are fetched from the primary, a collection at a time, and any the
+ * primary no longer has are deleted as well; a later record will describe whatever happened to
+ * them. The collections are then applied in parallel on `apply_pool_`, and the resume token is
+ * stored only once all of them have committed.
+ * @param client The connection to the primary.
+ * @return `true` if the batch was applied.
+ */
+bool Replicator::replicate_batch(aevum::client::AevumClient &client) {
+    uint64_t token = resume_token_.load(std::memory_order_relaxed);
+    int batch_size = std::max(config_.batch_size, 1);
+    std::string response = client.watch(static_cast<int64_t>(token), {}, batch_size,
+                                        std::max(config_.poll_wait_ms, 0));
+    int64_t received_ms = steady_now_ms();
+
+    simdjson::dom::parser parser;
+    simdjson::dom::element reply;
+    std::string_view status;
+    if (parser.parse(response).get(reply) != simdjson::SUCCESS ||
+        reply["status"].get_string().get(status) != simdjson::SUCCESS) {
+        AEVUM_LOG_WARN("Replicator: Malformed watch response from the primary.");
+        return false;
+    }
+    if (status != "ok") {
+        std::string_view message = "unknown error";
+        (void)reply["message"].get_string().get(message);
+        AEVUM_LOG_ERROR("Replicator: The primary rejected watch: " + std::string(message));
+        if (message.find("trimmed") != std::string_view::npos) {
+            AEVUM_LOG_FATAL("Replicator: This replica has fallen behind the primary's change log "
+                            "and must be rebuilt from a copy of the primary.");
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        return false;
+    }
+
+    uint64_t next_token = token;
+    simdjson::dom::array changes;
+    if (reply["resume_token"].get_uint64().get(next_token) != simdjson::SUCCESS ||
+        reply["changes"].get_array().get(changes) != simdjson::SUCCESS) {
+        AEVUM_LOG_WARN("Replicator: Watch response without changes or resume token.");
+        return false;
+    }
+
+    // The last operation on each `_id`, per collection, and the integer-keyed collections.
+    std::map<std::string, std::unordered_map<std::string, bool>, std::less<>> last_deleted;
+    std::unordered_set<std::string> integer_keyed;
+    size_t record_count = 0;
+    for (simdjson::dom::element change : changes) {
+        std::string_view collection, text_id, op;
+        int64_t integer_id = 0;
+        if (change["collection"].get_string().get(collection) != simdjson::SUCCESS ||
+            change["op"].get_string().get(op) != simdjson::SUCCESS) {
+            continue;
+        }
+        std::string id;
+        if (change["_id"].get_string().get(text_id) == simdjson::SUCCESS) {
+            id = text_id;
+        } else if (change["_id"].get_int64().get(integer_id) == simdjson::SUCCESS) {
+            id = std::to_string(integer_id);
+            integer_keyed.emplace(collection);
+        } else {
+            continue;
+        }
+        last_deleted[std::string(collection)][std::move(id)] = op == "delete";
+        ++record_count;
+    }
+
+    std::vector<CollectionBatch> batches;
+    batches.reserve(last_deleted.size());
+    for (auto &[collection, ids] : last_deleted) {
+        CollectionBatch batch;
+        batch.collection = collection;
+        batch.integer_ids = integer_keyed.count(collection) > 0;
+        for (auto &[id, deleted] : ids) {
+            (deleted ? batch.deleted_ids : batch.changed_ids).push_back(id);
+        }
+        for (size_t first = 0; first < batch.changed_ids.size(); first += FETCH_CHUNK) {
+            size_t last = std::min(first + FETCH_CHUNK, batch.changed_ids.size());
+            std::vector<std::string> chunk(batch.changed_ids.begin() + first,
+                                           batch.changed_ids.begin() + last);
+            std::vector<aevum::bson::doc::Document> fetched;
+            auto fetch_status =
+                client.find_documents(collection, id_filter(chunk, batch.integer_ids),
+                                      aevum::bson::doc::Document(), 0, 0, fetched);
+            if (!fetch_status.ok()) {
+                AEVUM_LOG_WARN("Replicator: Failed to fetch changed documents of '" + collection +
+                               "' from the primary: " + fetch_status.to_string());
+                return false;
+            }
+            std::move(fetched.begin(), fetched.end(), std::back_inserter(batch.docs));
+        }
+
+        std::unordered_set<std::string> found;
+        for (const auto &doc : batch.docs) {
+            bson_iter_t iter;
+            if (bson_iter_init_find(&iter, doc.get(), "_id")) {
+                std::string id = db::index::PrimaryIndexer::to_id_key(iter);
+                if (!id.empty()) found.insert(std::move(id));
+            }
+        }
+        for (const auto &id : batch.changed_ids) {
+            if (found.count(id) == 0) batch.deleted_ids.push_back(id);
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    std::atomic<bool> failed{false};
+    apply_pool_.parallel_for(0, batches.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            CollectionBatch &batch = batches[i];
+            size_t stored = batch.docs.size();
+            auto apply_status =
+                core_.apply_replicated(batch.collection, std::move(batch.docs), batch.deleted_ids);
+            if (!apply_status.ok()) {
+                AEVUM_LOG_WARN("Replicator: Failed to apply changes to '" + batch.collection +
+                               "': " + apply_status.to_string());
+                failed.store(true, std::memory_order_relaxed);
+                continue;
+            }
+            documents_applied_.fetch_add(stored, std::memory_order_relaxed);
+            documents_deleted_.fetch_add(batch.deleted_ids.size(), std::memory_order_relaxed);
+        }
+    });
+    if (failed.load(std::memory_order_relaxed)) return false;
+
+    if (next_token != token) {
+        if (auto store_status = core_.store_replication_token(next_token); !store_status.ok()) {
+            AEVUM_LOG_WARN("Replicator: Failed to store the resume token: " +
+                           store_status.to_string());
+        }
+        resume_token_.store(next_token, std::memory_order_relaxed);
+    }
+    if (record_count > 0) batches_.fetch_add(1, std::memory_order_relaxed);
+    if (changes.size() < static_cast<size_t>(batch_size)) {
+        caught_up_ms_.store(received_ms, std::memory_order_release);
+    }
+    return true;
+}
+
+}  // namespace aevum::net::server
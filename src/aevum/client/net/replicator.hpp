@@ -0,0 +1,168 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file replicator.hpp
+ * @brief Declares the `Replicator`, which keeps a read replica in step with its primary.
+ * @details A replica pulls its primary's change log with `watch` requests over the BSON protocol.
+ * The records name the documents that changed but carry no contents, so for each batch the
+ * replicator fetches the current version of every changed document with one `_id` `$in` query
+ * per collection and applies the results, in parallel across collections, through
+ * `Core::apply_replicated`. Applying the primary's current state rather than replaying
+ * operations makes every batch idempotent: a batch reapplied after a crash converges to the same
+ * documents.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "aevum/db/core/core.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
+
+namespace aevum::client {
+class AevumClient;
+}
+
+namespace aevum::net::server {
+
+/**
+ * @struct ReplicationConfig
+ * @brief Where a replica's primary is and how the replica pulls from it.
+ */
+struct ReplicationConfig {
+    /// The host of the primary, or empty if this server is a primary.
+    std::string primary_host;
+    /// The port of the primary.
+    int primary_port{55001};
+    /// The API key the replica authenticates with on the primary.
+    std::string primary_auth;
+    /// The most change records pulled per batch.
+    int batch_size{1000};
+    /// How long a `watch` request waits on the primary for new changes, in milliseconds.
+    int poll_wait_ms{1000};
+    /// The threads applying the collections of a batch; 0 for one per hardware thread.
+    int apply_threads{0};
+};
+
+/**
+ * @struct ReplicationStats
+ * @brief A snapshot of the progress of a `Replicator`, as reported by the `metrics` action.
+ */
+struct ReplicationStats {
+    /// The resume token of the last applied batch.
+    uint64_t resume_token = 0;
+    /// The batches applied.
+    uint64_t batches = 0;
+    /// The documents stored.
+    uint64_t documents_applied = 0;
+    /// The documents removed.
+    uint64_t documents_deleted = 0;
+    /// The batches that failed and were retried.
+    uint64_t errors = 0;
+    /// The time since the replica last held every change of the primary, in milliseconds, or -1
+    /// if it never has.
+    int64_t staleness_ms = -1;
+};
+
+/**
+ * @class Replicator
+ * @brief Pulls the primary's change log on a thread of its own and applies it to the local
+ * `Core`.
+ *
+ * @details The position in the primary's log is stored with `Core::store_replication_token`
+ * after each batch. A replica starting without a stored position resumes from its own change
+ * log's last sequence number, which is the primary's position if the data directory was copied
+ * from the primary, and 0 for an empty one. A batch that fails is retried after a pause; a
+ * position the primary has already trimmed stops replication with an error, since the replica
+ * can then only be rebuilt from a copy of the primary.
+ *
+ * The replica has caught up when a `watch` returns fewer records than it asked for; the
+ * staleness is the time since the last batch that caught up was applied.
+ */
+class Replicator {
+  public:
+    /**
+     * @brief Starts replicating from the configured primary.
+     * @param core The local engine. It must outlive the replicator.
+     * @param config The primary and the pull settings.
+     */
+    Replicator(db::Core &core, ReplicationConfig config);
+
+    /**
+     * @brief Stops the replication thread, letting a batch in progress finish.
+     */
+    ~Replicator();
+
+    // The replicator owns a thread that refers back to it, so it is neither copyable nor movable.
+    Replicator(const Replicator &) = delete;
+    Replicator &operator=(const Replicator &) = delete;
+    Replicator(Replicator &&) = delete;
+    Replicator &operator=(Replicator &&) = delete;
+
+    /**
+     * @brief Returns the time since the replica last held every change of the primary.
+     * @return The staleness in milliseconds, or -1 if the replica has never caught up.
+     */
+    [[nodiscard]] int64_t staleness_ms() const noexcept;
+
+    /**
+     * @brief Returns a snapshot of the progress of the replicator.
+     * @return The snapshot.
+     */
+    [[nodiscard]] ReplicationStats stats() const noexcept;
+
+  private:
+    /// The local engine.
+    db::Core &core_;
+    /// The primary and the pull settings.
+    ReplicationConfig config_;
+    /// The workers applying the collections of a batch in parallel.
+    aevum::util::concurrency::ThreadPool apply_pool_;
+
+    /// Guards `stop_`.
+    std::mutex mutex_;
+    /// Signaled when the replicator is stopping.
+    std::condition_variable stop_cv_;
+    /// `true` once the destructor has asked the thread to exit.
+    bool stop_{false};
+
+    /// The counters of `ReplicationStats`, advanced by the replication thread.
+    std::atomic<uint64_t> resume_token_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> documents_applied_{0};
+    std::atomic<uint64_t> documents_deleted_{0};
+    std::atomic<uint64_t> errors_{0};
+    /// The steady-clock time, in milliseconds, of the last batch that caught up, or -1.
+    std::atomic<int64_t> caught_up_ms_{-1};
+
+    /// The replication thread; started last, once every other member is initialized.
+    std::thread thread_;
+
+    /**
+     * @brief The body of the replication thread.
+     */
+    void run();
+
+    /**
+     * @brief Pulls and applies one batch of the primary's change log.
+     * @param client The connection to the primary, speaking the BSON protocol.
+     * @return `true` if the batch was applied, `false` if it must be retried after a pause.
+     */
+    bool replicate_batch(aevum::client::AevumClient &client);
+
+    /**
+     * @brief Waits before a retry, unless the replicator is stopping.
+     * @param milliseconds How long to wait.
+     * @return `false` if the replicator is stopping.
+     */
+    bool pause(int64_t milliseconds);
+};
+
+}  // namespace aevum::net::server
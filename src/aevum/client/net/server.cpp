@@ -4,92 +4,766 @@
 
 /**
  * @file server.cpp
- * @brief Implements the AevumDB multi-threaded TCP network server.
+ * @brief Implements the AevumDB event-driven TCP network server.
  * @details This file contains the concrete implementation of the `Server` class, including the
- * logic for initializing the listening socket, accepting client connections, and dispatching them
- * to worker threads. It also implements the core request processing pipeline, which uses `simdjson`
- * for high-performance parsing and delegates database operations to the `db::Core` engine.
+ * logic for initializing the listening socket, accepting client connections, multiplexing them
+ * over `epoll` or `io_uring` event loops, and dispatching their requests to worker threads. It
+ * also implements the core request processing pipeline, which uses `simdjson` for
+ * high-performance parsing and delegates database operations to the `db::Core` engine.
  */
 #include "aevum/client/net/server.hpp"
 
 #include <algorithm>
+#include <array>
 #include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <netinet/tcp.h>
 #include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <vector>
 
+#include "aevum/bson/builder.hpp"
 #include "aevum/bson/json/parser.hpp"
 #include "aevum/bson/json/serializer.hpp"
-#include "aevum/util/defer.hpp"
+#include "aevum/client/net/bson_wire.hpp"
+#include "aevum/client/net/io_ring.hpp"
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/db/storage/storage_options.hpp"
+#include "aevum/util/crypto/secure_random.hpp"
+#include "aevum/util/crypto/sha256.hpp"
 #include "aevum/util/log/logger.hpp"
+#include "aevum/util/memory/scratch_memory.hpp"
+#include "aevum/util/metrics/prometheus_text.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+#include "aevum/util/time/timestamp.hpp"
 #include "simdjson.h"
 
 namespace aevum::net::server {
 
+using aevum::net::append_frame;
+using aevum::net::FrameDecoder;
+
+namespace {
+
+/// The maximum number of readiness events an event loop handles per `epoll_wait`.
+constexpr int EPOLL_BATCH_SIZE = 256;
+/// How long an event loop waits for events before it checks for idle connections.
+constexpr int EPOLL_TICK_MS = 1000;
+/// The number of bytes received from a socket per `recv`.
+constexpr size_t RECEIVE_BUFFER_SIZE = 16384;
+/// The size of the submission queue of an event loop's ring. Every operation is submitted as soon
+/// as it is queued, so the queue never holds more than one.
+constexpr unsigned RING_ENTRIES = 64;
+/// The `user_data` of the wait on an event loop's `eventfd`; connections are numbered from 1.
+constexpr uint64_t WAKE_USER_DATA = 0;
+/// The queued responses of a connection are sent once they hold this many bytes, rather than
+/// after the last buffered request.
+constexpr size_t RESPONSE_BATCH_BYTES = 256 * 1024;
+
+/// Parsers whose buffers have grown beyond this many bytes are freed rather than pooled.
+constexpr size_t MAX_POOLED_PARSER_CAPACITY = 4 * 1024 * 1024;
+/// The longest a `watch` request waits for a change, in milliseconds. The request holds a worker
+/// for as long as it waits.
+constexpr int64_t MAX_WATCH_WAIT_MS = 30000;
+/// The most changes one `watch` response carries.
+constexpr int64_t MAX_WATCH_BATCH = 10000;
+/// The number of random bytes in a session token.
+constexpr size_t SESSION_TOKEN_SIZE = 32;
+
+/**
+ * @brief Decides whether a released `simdjson` parser is pooled.
+ * @details A parser keeps the buffers it has grown to, so a reused one parses requests of a size
+ * it has seen before without allocating. One that has grown beyond `MAX_POOLED_PARSER_CAPACITY`
+ * for an unusually large request is freed instead, so that a single bulk insert does not pin its
+ * buffers for the life of the server.
+ * @param parser The parser.
+ * @return `true` to keep the parser.
+ */
+bool keep_pooled_parser(simdjson::dom::parser &parser) {
+    return parser.capacity() <= MAX_POOLED_PARSER_CAPACITY;
+}
+
+/**
+ * @brief Resolves the number of request workers of a configuration.
+ * @param config The configuration.
+ * @return `worker_threads`, or one per hardware thread if it is 0.
+ */
+size_t worker_thread_count(const ConnectionPoolConfig &config) {
+    return config.worker_threads > 0
+               ? static_cast<size_t>(config.worker_threads)
+               : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Resolves the limits of the request classes of a configuration.
+ * @details Point operations may take every worker by default, scans half of them, and
+ * administrative requests two; each class may have a quarter of the workers waiting. Since a
+ * waiting request holds its worker, scans and administrative requests together never take every
+ * worker unless they are configured to.
+ * @param config The configuration, whose zero limits take the defaults above.
+ * @return The limits, indexed by `RequestClass`.
+ */
+std::array<AdmissionLimits, REQUEST_CLASS_COUNT> admission_limits(
+    const ConnectionPoolConfig &config) {
+    size_t workers = worker_thread_count(config);
+    auto or_default = [](int configured, size_t fallback) {
+        return configured > 0 ? static_cast<size_t>(configured) : std::max<size_t>(1, fallback);
+    };
+    size_t queued = or_default(config.max_queued_requests, workers / 4);
+    std::array<AdmissionLimits, REQUEST_CLASS_COUNT> limits;
+    limits[static_cast<size_t>(RequestClass::POINT)] = {
+        or_default(config.max_point_requests, workers), queued};
+    limits[static_cast<size_t>(RequestClass::SCAN)] = {
+        or_default(config.max_scan_requests, workers / 2), queued};
+    limits[static_cast<size_t>(RequestClass::ADMIN)] = {
+        or_default(config.max_admin_requests, 2), queued};
+    return limits;
+}
+
+/**
+ * @brief Times a request from its arrival and records the latency, once the request is known to
+ * be authenticated, in the histograms of its action and collection.
+ * @details A request that is rejected before `identify` is not recorded, so unauthenticated
+ * clients cannot add names to the histogram families.
+ */
+class RequestLatencyScope {
+  public:
+    RequestLatencyScope(aevum::util::metrics::HistogramFamily &actions,
+                        aevum::util::metrics::HistogramFamily &collections)
+        : actions_(actions), collections_(collections) {}
+
+    ~RequestLatencyScope() {
+        if (action_) action_->record(stopwatch_);
+        if (collection_) collection_->record(stopwatch_);
+    }
+
+    RequestLatencyScope(const RequestLatencyScope &) = delete;
+    RequestLatencyScope &operator=(const RequestLatencyScope &) = delete;
+
+    /**
+     * @brief Names the histograms the request is recorded in.
+     * @param action The action of the request.
+     * @param collection The collection of the request, or empty for none.
+     */
+    void identify(std::string_view action, std::string_view collection) {
+        action_ = &actions_.get(action);
+        if (!collection.empty()) collection_ = &collections_.get(collection);
+    }
+
+  private:
+    aevum::util::metrics::HistogramFamily &actions_;
+    aevum::util::metrics::HistogramFamily &collections_;
+    aevum::util::metrics::LatencyHistogram *action_{nullptr};
+    aevum::util::metrics::LatencyHistogram *collection_{nullptr};
+    aevum::util::time::Stopwatch stopwatch_;
+};
+
+/**
+ * @brief Builds the latency summary of each histogram of a family.
+ * @param family The histograms.
+ * @return A document with one subdocument per name, holding the count, the mean, the p50, p90,
+ *         p99, and p99.9 percentiles, and the maximum, in microseconds.
+ */
+aevum::bson::doc::Document latency_summaries(const aevum::util::metrics::HistogramFamily &family) {
+    aevum::bson::Builder summaries;
+    family.for_each([&](std::string_view name, const auto &snapshot) {
+        double mean = snapshot.count == 0 ? 0.0
+                                          : static_cast<double>(snapshot.sum_us) /
+                                                static_cast<double>(snapshot.count);
+        auto summary = aevum::bson::Builder()
+                           .append_int64("count", static_cast<int64_t>(snapshot.count))
+                           .append_double("mean_us", mean)
+                           .append_int64("p50_us", static_cast<int64_t>(snapshot.percentile(0.5)))
+                           .append_int64("p90_us", static_cast<int64_t>(snapshot.percentile(0.9)))
+                           .append_int64("p99_us", static_cast<int64_t>(snapshot.percentile(0.99)))
+                           .append_int64("p999_us",
+                                         static_cast<int64_t>(snapshot.percentile(0.999)))
+                           .append_int64("max_us", static_cast<int64_t>(snapshot.max_us))
+                           .finalize();
+        summaries.append_document(std::string(name).c_str(), summary);
+    });
+    return summaries.finalize();
+}
+
+/**
+ * @brief Builds the summary of the wire compression of every connection.
+ * @param stats The counters.
+ * @return A document with the connections that negotiated compression, and for responses sent
+ *         and requests received, the frames, the bytes before and after, their ratio (0 while
+ *         nothing was compressed), and the CPU time spent, in microseconds.
+ */
+aevum::bson::doc::Document compression_summary(const aevum::net::CompressionStats &stats) {
+    auto ratio = [](uint64_t larger, uint64_t smaller) {
+        return smaller == 0 ? 0.0 : static_cast<double>(larger) / static_cast<double>(smaller);
+    };
+    uint64_t sent_before = stats.bytes_before_compression.load();
+    uint64_t sent_after = stats.bytes_after_compression.load();
+    uint64_t received_before = stats.bytes_before_decompression.load();
+    uint64_t received_after = stats.bytes_after_decompression.load();
+    return aevum::bson::Builder()
+        .append_int64("connections", static_cast<int64_t>(stats.connections.load()))
+        .append_document(
+            "sent",
+            aevum::bson::Builder()
+                .append_int64("frames", static_cast<int64_t>(stats.frames_compressed.load()))
+                .append_int64("incompressible",
+                              static_cast<int64_t>(stats.frames_incompressible.load()))
+                .append_int64("bytes_in", static_cast<int64_t>(sent_before))
+                .append_int64("bytes_out", static_cast<int64_t>(sent_after))
+                .append_double("ratio", ratio(sent_before, sent_after))
+                .append_int64("cpu_us", static_cast<int64_t>(stats.compress_cpu_ns.load() / 1000))
+                .finalize())
+        .append_document(
+            "received",
+            aevum::bson::Builder()
+                .append_int64("frames", static_cast<int64_t>(stats.frames_decompressed.load()))
+                .append_int64("bytes_in", static_cast<int64_t>(received_before))
+                .append_int64("bytes_out", static_cast<int64_t>(received_after))
+                .append_double("ratio", ratio(received_after, received_before))
+                .append_int64("cpu_us",
+                              static_cast<int64_t>(stats.decompress_cpu_ns.load() / 1000))
+                .finalize())
+        .finalize();
+}
+
+/**
+ * @brief Renders the progress of a backup for the `backup` and `backup_status` actions.
+ * @param status The progress.
+ * @return The JSON object.
+ */
+std::string backup_status_json(const aevum::db::storage::BackupStatus &status) {
+    auto as_int64 = [](uint64_t value) { return static_cast<int64_t>(value); };
+    aevum::bson::Builder backup;
+    backup.append_string("state", aevum::db::storage::to_string(status.state));
+    if (status.state != aevum::db::storage::BackupState::IDLE) {
+        backup.append_string("destination", status.destination)
+            .append_bool("incremental", status.incremental)
+            .append_string("backup_id", status.backup_id)
+            .append_int64("files_total", as_int64(status.files_total))
+            .append_int64("files_copied", as_int64(status.files_copied))
+            .append_int64("bytes_copied", as_int64(status.bytes_copied))
+            .append_string("started", aevum::util::time::to_iso8601(status.started_unix_ms));
+    }
+    if (status.finished_unix_ms > 0) {
+        backup.append_string("finished", aevum::util::time::to_iso8601(status.finished_unix_ms));
+    }
+    if (!status.error.empty()) backup.append_string("error", status.error);
+    return aevum::bson::json::to_string(backup.finalize());
+}
+
+/**
+ * @brief Renders an operation profile as an entry of the `profile` action.
+ * @details The shape and sort are JSON objects themselves and are embedded as subdocuments; a
+ * shape that is not an object, such as that of an invalid query, is kept as a string.
+ * @param profile The profile.
+ * @return The JSON object.
+ */
+std::string profile_entry_json(const aevum::db::query::OperationProfile &profile) {
+    aevum::bson::Builder phases;
+    for (size_t i = 0; i < aevum::db::query::PROFILE_PHASE_COUNT; ++i) {
+        auto phase = static_cast<aevum::db::query::ProfilePhase>(i);
+        phases.append_int64(std::string(aevum::db::query::to_string(phase)).c_str(),
+                            static_cast<int64_t>(profile.phase_us[i]));
+    }
+    aevum::bson::Builder entry;
+    entry.append_string("ts", aevum::util::time::to_iso8601(profile.end_unix_ms))
+        .append_string("op", profile.op)
+        .append_string("collection", profile.collection);
+    aevum::bson::doc::Document shape;
+    if (aevum::bson::json::parse(profile.shape, shape).ok()) {
+        entry.append_document("shape", shape);
+    } else {
+        entry.append_string("shape", profile.shape);
+    }
+    aevum::bson::doc::Document sort;
+    if (!profile.sort.empty() && aevum::bson::json::parse(profile.sort, sort).ok()) {
+        entry.append_document("sort", sort);
+    }
+    entry.append_string("plan", aevum::db::query::to_string(profile.plan))
+        .append_int64("examined", static_cast<int64_t>(profile.examined))
+        .append_int64("returned", static_cast<int64_t>(profile.returned))
+        .append_int64("total_us", static_cast<int64_t>(profile.total_us))
+        .append_document("phases_us", phases.finalize());
+    return aevum::bson::json::to_string(entry.finalize());
+}
+
+/**
+ * @brief Checks whether an action writes documents, which a read replica only takes from its
+ * primary.
+ * @param action The action.
+ * @return `true` for `insert`, `insert_many`, `update`, `upsert`, and `delete`.
+ */
+bool is_document_write(std::string_view action) noexcept {
+    return action == "insert" || action == "insert_many" || action == "update" ||
+           action == "upsert" || action == "delete";
+}
+
+/**
+ * @brief Checks a read against the staleness bound it asked for.
+ * @param replicator The replicator of a read replica, or `nullptr` on a primary, which is never
+ *        stale.
+ * @param max_staleness_ms The `maxStalenessMs` of the request; 0 or less for no bound.
+ * @return An empty string if the read may proceed, or the `stale_replica` error response.
+ */
+std::string stale_replica_error(const Replicator *replicator, int64_t max_staleness_ms) {
+    if (replicator == nullptr || max_staleness_ms <= 0) return {};
+    int64_t staleness_ms = replicator->staleness_ms();
+    if (staleness_ms >= 0 && staleness_ms <= max_staleness_ms) return {};
+    return R"({"status":"error", "code":"stale_replica", "staleness_ms":)" +
+           std::to_string(staleness_ms) +
+           R"(, "message":"The replica is further behind its primary than maxStalenessMs"})";
+}
+
+/**
+ * @brief Checks whether a query selects documents by `_id` alone, through the primary index.
+ * @param query The `query` of the request.
+ * @return `true` if the query has a top-level `_id` that is a value, or an object of `$eq` and
+ *         `$in` operators only.
+ */
+bool is_point_query(simdjson::dom::element query) {
+    simdjson::dom::element id;
+    if (!query.is_object() || query["_id"].get(id) != simdjson::SUCCESS) return false;
+    if (!id.is_object()) return true;
+    simdjson::dom::object operators = id.get_object().value_unsafe();
+    if (operators.size() == 0) return false;
+    for (auto field : operators) {
+        if (field.key != "$eq" && field.key != "$in") return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Assigns a request to the class it is admitted in.
+ * @details `watch` is exempt, since it waits for changes by design and would otherwise hold a
+ * slot for as long as it waits.
+ * @param action The action of the request.
+ * @param request The request.
+ * @return The class, or no value for a request that is admitted without limit.
+ */
+std::optional<RequestClass> classify_request(std::string_view action,
+                                             simdjson::dom::element request) {
+    if (action == "watch") return std::nullopt;
+    if (action == "insert" || action == "getMore" || action == "killCursor" ||
+        action == "begin" || action == "commit" || action == "abort" ||
+        action == "backup_status" || action == "prepare" || action == "closeStatement") {
+        return RequestClass::POINT;
+    }
+    if (action == "find" || action == "count" || action == "update" || action == "delete" ||
+        action == "upsert") {
+        simdjson::dom::element query;
+        bool point = request["query"].get(query) == simdjson::SUCCESS && is_point_query(query);
+        return point ? RequestClass::POINT : RequestClass::SCAN;
+    }
+    if (action == "insert_many" || action == "aggregate" || action == "explain" ||
+        action == "execute") {
+        return RequestClass::SCAN;
+    }
+    return RequestClass::ADMIN;
+}
+
+/**
+ * @brief Checks whether the query of a BSON `find` selects documents by `_id` alone.
+ * @param request The request.
+ * @return `true` under the same rule as `is_point_query`.
+ */
+bool is_bson_point_query(const bson_t *request) {
+    bson_iter_t root, id;
+    if (!bson_iter_init(&root, request) || !bson_iter_find_descendant(&root, "query._id", &id)) {
+        return false;
+    }
+    if (!BSON_ITER_HOLDS_DOCUMENT(&id)) return true;
+    bson_iter_t operators;
+    if (!bson_iter_recurse(&id, &operators)) return false;
+    bool any = false;
+    while (bson_iter_next(&operators)) {
+        std::string_view key = bson_iter_key(&operators);
+        if (key != "$eq" && key != "$in") return false;
+        any = true;
+    }
+    return any;
+}
+
+/**
+ * @brief Computes the time after which a request is no longer worth starting.
+ * @param received_ms The steady time, in milliseconds, at which the request was received.
+ * @param timeout_sec The `request_timeout_sec` of the server.
+ * @param max_time_ms The `maxTimeMS` of the request; 0 or less for none.
+ * @return The earlier of the two bounds.
+ */
+AdmissionController::Clock::time_point request_deadline(int64_t received_ms, int timeout_sec,
+                                                        int64_t max_time_ms) {
+    int64_t budget_ms = static_cast<int64_t>(std::max(timeout_sec, 1)) * 1000;
+    if (max_time_ms > 0) budget_ms = std::min(budget_ms, max_time_ms);
+    return AdmissionController::Clock::time_point(
+        std::chrono::milliseconds(received_ms + budget_ms));
+}
+
+/**
+ * @brief Renders the response to a request that was not admitted.
+ * @param outcome The outcome of the admission; `SHED` or `EXPIRED`.
+ * @return The `server_busy` or `deadline_exceeded` error response.
+ */
+std::string admission_error(AdmissionController::Outcome outcome) {
+    if (outcome == AdmissionController::Outcome::EXPIRED) {
+        return R"({"status":"error", "code":"deadline_exceeded", )"
+               R"("message":"The request's deadline passed before it could run"})";
+    }
+    return R"({"status":"error", "code":"server_busy", "message":"Server busy; retry later"})";
+}
+
+/**
+ * @brief Renders a record of the change log as an entry of the `watch` action.
+ * @param change The record.
+ * @param integer_id `true` if the record's collection is integer-keyed, so that its `_id` is
+ *        rendered as the number it is rather than as its key string.
+ * @return The JSON object.
+ */
+std::string change_entry_json(const aevum::db::Change &change, bool integer_id) {
+    aevum::bson::Builder builder;
+    builder.append_int64("seq", static_cast<int64_t>(change.sequence))
+        .append_string("op", aevum::db::change_type_name(change.type))
+        .append_string("collection", change.collection);
+    int64_t id = 0;
+    auto [end, ec] = std::from_chars(change.id.data(), change.id.data() + change.id.size(), id);
+    if (integer_id && ec == std::errc() && end == change.id.data() + change.id.size()) {
+        builder.append_int64("_id", id);
+    } else {
+        builder.append_string("_id", change.id);
+    }
+    return aevum::bson::json::to_string(builder.finalize());
+}
+
+/**
+ * @brief Renders the entry of an inserted document in an insert response.
+ * @param id The key of the document's `_id`.
+ * @param integer_id `true` if the collection is integer-keyed, whose `_id`s are numbers.
+ * @return `{"status":"ok", "_id":...}`.
+ */
+std::string inserted_json(const std::string &id, bool integer_id) {
+    return integer_id ? R"({"status":"ok", "_id":)" + id + "}"
+                      : R"({"status":"ok", "_id":")" + id + R"("})";
+}
+
+/**
+ * @brief Returns the current time of the steady clock in milliseconds, from the `CoarseClock`.
+ * @return The milliseconds since the clock's epoch.
+ */
+int64_t steady_now_ms() { return aevum::util::time::CoarseClock::steady_ms(); }
+
+/**
+ * @brief Reads a string field of a BSON document.
+ * @param doc The document.
+ * @param key The name of the field.
+ * @return The value, or an empty view if the field is missing or not a string. The view points
+ * into `doc`.
+ */
+std::string_view bson_wire_string(const bson_t *doc, const char *key) {
+    bson_iter_t iter;
+    if (!bson_iter_init_find(&iter, doc, key) || !BSON_ITER_HOLDS_UTF8(&iter)) return {};
+    uint32_t length = 0;
+    const char *value = bson_iter_utf8(&iter, &length);
+    return {value, length};
+}
+
+/**
+ * @brief Reads an integer field of a BSON document.
+ * @param doc The document.
+ * @param key The name of the field.
+ * @return The value converted to 64 bits, or 0 if the field is missing or not numeric.
+ */
+int64_t bson_wire_int64(const bson_t *doc, const char *key) {
+    bson_iter_t iter;
+    if (!bson_iter_init_find(&iter, doc, key) || !BSON_ITER_HOLDS_NUMBER(&iter)) return 0;
+    return bson_iter_as_int64(&iter);
+}
+
+/**
+ * @brief Serializes an embedded document of a BSON request as JSON for the core.
+ * @param request The request.
+ * @param key The name of the field.
+ * @return The field as JSON, or `{}` if it is missing or not a document.
+ */
+std::string bson_wire_subdocument_json(const bson_t *request, const char *key) {
+    aevum::bson::doc::Document field;
+    if (!aevum::net::copy_subdocument(request, key, field)) return "{}";
+    return aevum::bson::json::to_string(field);
+}
+
+/**
+ * @brief Appends a JSON array of documents to a response.
+ * @details The response is grown once, to an estimate from the BSON sizes of the documents,
+ * rather than repeatedly as the documents are appended.
+ * @param docs The documents.
+ * @param out The response to append to.
+ */
+void append_documents_json(const std::vector<aevum::bson::doc::Document> &docs,
+                           std::string &out) {
+    size_t estimate = out.size() + 2;
+    for (const auto &doc : docs) estimate += doc.length() + doc.length() / 2 + 1;
+    out.reserve(estimate);
+    out += "[";
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (i > 0) out += ",";
+        aevum::bson::json::append_json(docs[i], out);
+    }
+    out += "]";
+}
+
+/**
+ * @brief Formats a batch of a cursor as a JSON response.
+ * @param cursor_id The id of the cursor, or 0 if the batch is the last.
+ * @param batch The documents of the batch.
+ * @return `{"status":"ok", "cursor":<id>, "data":[...]}`.
+ */
+std::string cursor_batch_response(int64_t cursor_id,
+                                  const std::vector<aevum::bson::doc::Document> &batch) {
+    std::string response = R"({"status":"ok", "cursor":)" + std::to_string(cursor_id) +
+                           R"(, "data":)";
+    append_documents_json(batch, response);
+    response += "}";
+    return response;
+}
+
+/**
+ * @brief Builds the result cache key of a read.
+ * @details The query, sort, and projection are the minified serializations of the parsed
+ * request, so requests that differ only in whitespace share an entry. The fields are separated
+ * by NUL bytes, which cannot occur in a collection name or in serialized JSON.
+ * @param action The action, `find` or `count`.
+ * @param collection The name of the collection.
+ * @param query_json The filter.
+ * @param sort_json The sort order.
+ * @param projection_json The projection.
+ * @param limit The result limit.
+ * @param skip The number of matches skipped.
+ * @return The key, allocated from the thread's scratch memory.
+ */
+std::pmr::string result_cache_key(std::string_view action, std::string_view collection,
+                                  std::string_view query_json, std::string_view sort_json,
+                                  std::string_view projection_json, int64_t limit, int64_t skip) {
+    std::pmr::string key(&aevum::util::memory::scratch_memory());
+    key.reserve(action.size() + collection.size() + query_json.size() + sort_json.size() +
+                projection_json.size() + 48);
+    key.append(action).push_back('\0');
+    key.append(collection).push_back('\0');
+    key.append(query_json).push_back('\0');
+    key.append(sort_json).push_back('\0');
+    key.append(projection_json).push_back('\0');
+    key.append(std::to_string(limit)).push_back('\0');
+    key.append(std::to_string(skip));
+    return key;
+}
+
+}  // namespace
+
+/**
+ * @brief The state of one accepted client connection.
+ * @details `busy` is set by the I/O thread when it dispatches requests and cleared by the worker
+ * once the responses are sent, right before it re-arms the connection. Both happen under `mutex`,
+ * so that the idle sweep never closes a connection that a worker still uses.
+ */
+struct Server::ClientConnection {
+    /**
+     * @brief Constructs the state of a new connection.
+     * @param max_request_size The largest request the decoder accepts.
+     */
+    explicit ClientConnection(size_t max_request_size) : decoder(max_request_size) {}
+
+    /// The connected socket, in non-blocking mode, or in blocking mode for a ring's receives.
+    int fd{-1};
+    /// The number of the connection, which identifies its receives on a ring.
+    uint64_t id{0};
+    /// The client's IP address, for the per-IP connection limit.
+    std::string peer_ip;
+    /// Reassembles the requests received on the socket.
+    FrameDecoder decoder;
+    /// Queues and sends the responses. Only touched by the worker serving the connection.
+    SocketWriter writer;
+    /// Compresses the responses and decompresses the requests once the client has negotiated
+    /// compression. The codec and both buffers are only touched by the worker serving the
+    /// connection.
+    aevum::net::WireCodec codec;
+    /// The compressed payload of the last response, whose capacity the next one reuses.
+    std::string deflated;
+    /// The decompressed payload of the request being served.
+    std::string inflated;
+    /// `true` once the client has switched the connection to BSON bodies. Only touched by the
+    /// worker serving the connection.
+    bool bson_mode{false};
+    /// Guards `busy` and `last_active_ms`.
+    std::mutex mutex;
+    /// `true` while a worker is processing a request of this connection.
+    bool busy{false};
+    /// The steady time, in milliseconds, of the last request or response.
+    int64_t last_active_ms{0};
+    /// The steady time, in milliseconds, from which the deadline of the request being served is
+    /// counted: when the connection was handed to a worker, or when the worker finished the
+    /// request before it. Only touched by the worker serving the connection.
+    int64_t received_ms{0};
+    /// The transaction opened by `begin`, or null. Only touched by the worker serving the
+    /// connection; a transaction still open when the connection is released is dropped with it,
+    /// which aborts it, since its writes were only staged.
+    std::unique_ptr<aevum::db::Transaction> transaction;
+    /// The token of the session opened by `login`, or empty. The session fields are only
+    /// touched by the worker serving the connection, and end with it.
+    std::string session_token;
+    /// The role verified by `login`.
+    aevum::db::auth::UserRole session_role{aevum::db::auth::UserRole::NONE};
+    /// The API key verified by `login`, which owns the cursors and prepared queries the
+    /// session's requests open, as it would own those of its requests without a session.
+    std::string session_owner;
+};
+
+/**
+ * @brief An `epoll` instance or an `io_uring`, the thread that waits on it, and the connections
+ * it watches.
+ */
+struct Server::EventLoop {
+    /// The `epoll` instance, or -1 if the loop runs on `ring`.
+    int epoll_fd{-1};
+    /// The ring, or null if the loop runs on `epoll_fd`.
+    std::unique_ptr<IoRing> ring;
+    /// An `eventfd` watched by `epoll_fd` or `ring`, written to by `stop()` to wake the thread.
+    int wake_fd{-1};
+    /// The I/O thread running `run_event_loop`.
+    std::thread thread;
+    /// Guards `connections`.
+    std::mutex mutex;
+    /// The connections of this loop, keyed by socket.
+    std::unordered_map<int, std::shared_ptr<ClientConnection>> connections;
+    /// The connections with a receive pending on `ring`, keyed by id. They are kept alive until
+    /// the receive completes, even once released, since the kernel writes into their decoder.
+    std::unordered_map<uint64_t, std::shared_ptr<ClientConnection>> receiving;
+};
+
 /**
  * @brief Constructs a `Server`, linking it to the database core and specifying a port.
+ * @details The result cache, if enabled, registers with the core's memory budget with the lowest
+ * rank, so that it is shrunk before any collection is evicted. The zstd dictionary offered to
+ * clients is digested once here; if it cannot be loaded, clients negotiate zstd without it.
  * @param db_core A reference to the database engine that will handle all requests.
  * @param port The port on which the server will listen for connections.
+ * @param config The connection limits and thread counts.
+ * @param replicator The replicator if this server is a read replica, or `nullptr`.
+ * @param router The shard router if this server is a router, or `nullptr`.
  */
-Server::Server(db::Core &db_core, int port) : db_core_(db_core), port_(port) {
+Server::Server(db::Core &db_core, int port, ConnectionPoolConfig config,
+               const Replicator *replicator, ShardRouter *router)
+    : conn_config_(config),
+      db_core_(db_core),
+      replicator_(replicator),
+      router_(router),
+      port_(port),
+      result_cache_(static_cast<size_t>(std::max(config.result_cache_mb, 0)) << 20),
+      admission_(admission_limits(config)),
+      json_parsers_(aevum::util::memory::ObjectPool<simdjson::dom::parser>::DEFAULT_CAPACITY,
+                    keep_pooled_parser) {
     metrics_.startup_timestamp = std::time(nullptr);
+    if (result_cache_.enabled()) {
+        aevum::db::MemoryReclaimer cache;
+        cache.name = "result cache";
+        cache.rank = 0;
+        cache.usage = [this]() { return result_cache_.stats().bytes; };
+        cache.reclaim = [this](size_t bytes) { return result_cache_.shrink(bytes); };
+        result_cache_reclaimer_ = db_core_.memory_budget().add_reclaimer(std::move(cache));
+    }
+    if (config.wire_compression && !config.wire_compression_dictionary.empty()) {
+        std::ifstream file(config.wire_compression_dictionary, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+        auto status = file ? aevum::net::WireDictionary::load(
+                                 bytes, config.wire_compression_level, wire_dictionary_)
+                           : aevum::util::Status::IOError("cannot read the file");
+        if (!status.ok()) {
+            AEVUM_LOG_WARN("Network: Compression dictionary '" +
+                           config.wire_compression_dictionary + "' not loaded: " +
+                           status.to_string() + ". Clients use zstd without it.");
+        }
+    }
 }
 
 /**
  * @brief Destroys the `Server`, ensuring a graceful stop.
  * @details If the server is running, this destructor invokes `stop()` to ensure all sockets
- * are closed and all threads are joined, preventing resource leaks.
+ * are closed and all threads are joined, preventing resource leaks. The result cache is
+ * unregistered from the memory budget before it is destroyed.
  */
 Server::~Server() {
     if (is_running_) {
         stop();
     }
+    if (result_cache_reclaimer_ != 0) {
+        db_core_.memory_budget().remove_reclaimer(result_cache_reclaimer_);
+    }
 }
 
 /**
  * @brief Gracefully stops the server and cleans up all network resources.
  * @details This function is thread-safe. It uses an atomic `exchange` to ensure the shutdown
- * sequence is executed only once. It shuts down and closes the main server socket, then iterates
- * through all active client sockets, shutting them down and closing them to unblock any worker
- * threads waiting on `recv`. Finally, it joins all worker threads to ensure they have exited
- * cleanly.
+ * sequence is executed only once. It shuts down and closes the main server socket, wakes every
+ * event loop through its `eventfd` and joins its I/O thread, and destroys the worker pool, which
+ * lets the requests in progress finish. Only then are the remaining client sockets closed, since
+ * no thread can touch them anymore. On a ring, the sockets are shut down first and the pending
+ * receives reaped, so that the kernel is done with the connections' buffers when they are freed.
  */
 void Server::stop() {
     if (!is_running_.exchange(false)) {
         return;
     }
-    aevum::util::log::Logger::info("Network: Shutdown sequence initiated...");
+    AEVUM_LOG_INFO("Network: Shutdown sequence initiated...");
 
     if (server_socket_fd_ != -1) {
         shutdown(server_socket_fd_, SHUT_RDWR);
         close(server_socket_fd_);
         server_socket_fd_ = -1;
     }
+    metrics_endpoint_.reset();
 
-    {
-        std::lock_guard<std::mutex> lock(client_sockets_mutex_);
-        aevum::util::log::Logger::debug("Network: Closing " +
-                                        std::to_string(client_sockets_.size()) +
-                                        " active client connections.");
-        for (int client_socket : client_sockets_) {
-            shutdown(client_socket, SHUT_RDWR);
-            close(client_socket);
-        }
-        client_sockets_.clear();
+    AEVUM_LOG_DEBUG("Network: Joining " + std::to_string(event_loops_.size()) + " I/O threads.");
+    for (auto &loop : event_loops_) {
+        eventfd_write(loop->wake_fd, 1);
+        if (loop->thread.joinable()) loop->thread.join();
     }
+    request_workers_.reset();
 
-    aevum::util::log::Logger::debug("Network: Joining " + std::to_string(worker_threads_.size()) +
-                                    " worker threads.");
-    for (auto &t : worker_threads_) {
-        if (t.joinable()) {
-            t.join();
+    for (auto &loop : event_loops_) {
+        AEVUM_LOG_DEBUG("Network: Closing " + std::to_string(loop->connections.size()) +
+                        " active client connections.");
+        for (auto &[fd, conn] : loop->connections) shutdown(fd, SHUT_RDWR);
+        if (loop->ring) {
+            std::vector<IoRing::Completion> completions;
+            for (int wait = 0; wait < 10 && !loop->receiving.empty(); ++wait) {
+                completions.clear();
+                loop->ring->wait(completions, 100);
+                for (const auto &completion : completions) {
+                    loop->receiving.erase(completion.user_data);
+                }
+            }
+            loop->ring.reset();
+            loop->receiving.clear();
         }
+        for (auto &[fd, conn] : loop->connections) close(fd);
+        loop->connections.clear();
+        close(loop->wake_fd);
+        if (loop->epoll_fd >= 0) close(loop->epoll_fd);
     }
-    aevum::util::log::Logger::info("Network: Server has been stopped successfully.");
+    event_loops_.clear();
+    metrics_.active_connections = 0;
+    connections_per_ip_.clear();
+    AEVUM_LOG_INFO("Network: Server has been stopped successfully.");
 }
 
 /**
@@ -99,8 +773,12 @@ void Server::stop() {
  * 2. Sets the `SO_REUSEADDR` socket option to allow for quick server restarts.
  * 3. Binds the socket to the specified port on all available network interfaces (`INADDR_ANY`).
  * 4. Puts the socket into a listening state with a connection backlog.
- * 5. Enters a `while` loop that blocks on `accept()`, waiting for new clients. For each accepted
- *    connection, a new worker thread is spawned to handle it.
+ * 5. Creates the event loops and their I/O threads, and the request worker pool. With
+ *    `IoBackend::IO_URING`, a ring is created for every loop first; if any of them fails, every
+ *    loop uses `epoll`.
+ * 6. Enters a `while` loop that blocks on `accept()`, waiting for new clients. Each accepted
+ *    connection is checked against the connection limits, switched to non-blocking mode unless
+ *    the loops use rings, and registered with the next event loop in round-robin order.
  * @throws `std::runtime_error` If any part of the socket setup fails.
  */
 void Server::run() {
@@ -116,24 +794,22 @@ void Server::run() {
 
     // Enable TCP keepalive to detect dead connections
     if (setsockopt(server_socket_fd_, SOL_SOCKET, SO_KEEPALIVE, &opt, sizeof(opt))) {
-        aevum::util::log::Logger::warn("Failed to set SO_KEEPALIVE: " +
-                                       std::string(strerror(errno)));
+        AEVUM_LOG_WARN("Failed to set SO_KEEPALIVE: " + std::string(strerror(errno)));
     }
 
     // Disable Nagle's algorithm for low latency
     if (setsockopt(server_socket_fd_, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt))) {
-        aevum::util::log::Logger::warn("Failed to set TCP_NODELAY: " +
-                                       std::string(strerror(errno)));
+        AEVUM_LOG_WARN("Failed to set TCP_NODELAY: " + std::string(strerror(errno)));
     }
 
     // Increase socket buffer sizes for better throughput
     int rcvbufsize = 262144;  // 256KB
     int sndbufsize = 262144;  // 256KB
     if (setsockopt(server_socket_fd_, SOL_SOCKET, SO_RCVBUF, &rcvbufsize, sizeof(rcvbufsize))) {
-        aevum::util::log::Logger::warn("Failed to set SO_RCVBUF: " + std::string(strerror(errno)));
+        AEVUM_LOG_WARN("Failed to set SO_RCVBUF: " + std::string(strerror(errno)));
     }
     if (setsockopt(server_socket_fd_, SOL_SOCKET, SO_SNDBUF, &sndbufsize, sizeof(sndbufsize))) {
-        aevum::util::log::Logger::warn("Failed to set SO_SNDBUF: " + std::string(strerror(errno)));
+        AEVUM_LOG_WARN("Failed to set SO_SNDBUF: " + std::string(strerror(errno)));
     }
 
     struct sockaddr_in server_addr{};
@@ -146,145 +822,817 @@ void Server::run() {
                                  ": " + std::string(strerror(errno)));
     }
 
-    if (listen(server_socket_fd_, 128) < 0) {
+    if (listen(server_socket_fd_, SOMAXCONN) < 0) {
         throw std::runtime_error("Failed to listen on server socket: " +
                                  std::string(strerror(errno)));
     }
 
+    size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t io_threads = conn_config_.io_threads > 0
+                            ? static_cast<size_t>(conn_config_.io_threads)
+                            : std::max<size_t>(1, hardware_threads / 4);
+    size_t worker_threads = worker_thread_count(conn_config_);
+    request_workers_ = std::make_unique<aevum::util::concurrency::ThreadPool>(
+        "Request", worker_threads, conn_config_.pin_worker_threads);
+
+    // A loop has at most one receive pending per connection; the kernel buffers any excess.
+    std::vector<std::unique_ptr<IoRing>> rings;
+    if (conn_config_.io_backend == IoBackend::IO_URING) {
+        auto completions = static_cast<unsigned>(
+            std::max(conn_config_.max_connections_total, 1) / io_threads + RING_ENTRIES);
+        for (size_t i = 0; i < io_threads; ++i) {
+            auto ring = std::make_unique<IoRing>();
+            aevum::util::Status status = ring->open(RING_ENTRIES, completions);
+            if (!status.ok()) {
+                AEVUM_LOG_WARN("Network: io_uring is unavailable (" + status.message() +
+                               "); falling back to epoll.");
+                rings.clear();
+                break;
+            }
+            rings.push_back(std::move(ring));
+        }
+    }
+
     is_running_ = true;
-    aevum::util::log::Logger::info("Network: Server is listening on port " + std::to_string(port_));
+    for (size_t i = 0; i < io_threads; ++i) {
+        auto loop = std::make_unique<EventLoop>();
+        loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (!rings.empty()) {
+            loop->ring = std::move(rings[i]);
+        } else {
+            loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        }
+        if ((!loop->ring && loop->epoll_fd < 0) || loop->wake_fd < 0) {
+            throw std::runtime_error("Failed to create event loop: " +
+                                     std::string(strerror(errno)));
+        }
+        if (loop->ring) {
+            if (!loop->ring->poll_readable(loop->wake_fd, WAKE_USER_DATA)) {
+                throw std::runtime_error("Failed to create event loop: cannot watch its eventfd");
+            }
+        } else {
+            struct epoll_event wake{};
+            wake.events = EPOLLIN;
+            wake.data.fd = loop->wake_fd;
+            epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &wake);
+        }
+        loop->thread = std::thread(&Server::run_event_loop, this, std::ref(*loop));
+        event_loops_.push_back(std::move(loop));
+    }
+    uses_rings_ = !event_loops_.empty() && event_loops_.front()->ring != nullptr;
+    AEVUM_LOG_INFO("Network: Server is listening on port " + std::to_string(port_) + " with " +
+                   std::to_string(io_threads) + (uses_rings_ ? " io_uring" : " epoll") +
+                   " I/O threads and " + std::to_string(worker_threads) + " request workers.");
+    if (conn_config_.metrics_port > 0) {
+        metrics_endpoint_ = std::make_unique<MetricsEndpoint>(
+            conn_config_.metrics_port, [this] { return metrics_prometheus(); });
+        metrics_endpoint_->start();
+    }
 
     while (is_running_) {
-        int client_socket = accept(server_socket_fd_, nullptr, nullptr);
+        struct sockaddr_in peer_addr{};
+        socklen_t peer_len = sizeof(peer_addr);
+        int client_socket = accept4(server_socket_fd_, (struct sockaddr *)&peer_addr, &peer_len,
+                                    uses_rings_ ? SOCK_CLOEXEC : SOCK_NONBLOCK | SOCK_CLOEXEC);
         if (client_socket < 0) {
-            if (is_running_)
-                aevum::util::log::Logger::warn("Network: accept() call failed or was interrupted.");
+            if (!is_running_) break;
+            AEVUM_LOG_WARN("Network: accept() call failed or was interrupted: " +
+                           std::string(strerror(errno)));
+            // Out of descriptors: back off instead of spinning on the pending connection.
+            if (errno == EMFILE || errno == ENFILE) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+
+        char peer_ip[INET_ADDRSTRLEN] = {};
+        inet_ntop(AF_INET, &peer_addr.sin_addr, peer_ip, sizeof(peer_ip));
+        if (!admit_connection(peer_ip)) {
+            std::string response = R"({"status":"error","message":"Too many connections"})";
+            (void)send(client_socket, response.data(), response.size(),
+                       MSG_NOSIGNAL | MSG_DONTWAIT);
+            close(client_socket);
             continue;
         }
 
-        aevum::util::log::Logger::info(
-            "Network: Accepted new client connection. Spawning worker thread.");
-        worker_threads_.emplace_back(&Server::handle_client, this, client_socket);
+        auto conn = std::make_shared<ClientConnection>(
+            static_cast<size_t>(conn_config_.max_request_size_bytes));
+        conn->fd = client_socket;
+        conn->id = next_connection_id_++;
+        conn->peer_ip = peer_ip;
+        conn->last_active_ms = steady_now_ms();
+        conn->writer.attach(client_socket,
+                            static_cast<size_t>(std::max(conn_config_.zero_copy_threshold_kb, 0))
+                                << 10,
+                            &send_stats_);
+
+        EventLoop &loop = *event_loops_[next_event_loop_++ % event_loops_.size()];
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.connections.emplace(client_socket, conn);
+        }
+        bool registered;
+        if (loop.ring) {
+            registered = submit_receive(loop, conn);
+        } else {
+            struct epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.fd = client_socket;
+            registered = epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, client_socket, &event) == 0;
+        }
+        if (!registered) {
+            AEVUM_LOG_WARN("Network: Failed to register client connection: " +
+                           std::string(strerror(errno)));
+            release_connection(loop, conn);
+            continue;
+        }
+        AEVUM_LOG_DEBUG("Network: Accepted new client connection from " + conn->peer_ip + ".");
     }
 }
 
 /**
- * @brief Manages the lifecycle of a single client connection.
- * @details This function runs in its own thread. It first registers the client socket in a
- * global list for tracking. It then enters a loop, blocking on `recv()` for incoming data.
- * Each received payload is processed, and the response is sent back. The loop breaks if `recv()`
- * indicates a disconnection or error. A `defer` block ensures the socket is closed and removed
- * from the list upon exiting the function, regardless of how it exits.
- * @param client_socket The file descriptor for the connected client.
+ * @brief Checks `max_connections_total` and `max_connections_per_ip` and, if neither is reached,
+ * counts the new connection against both.
+ * @param peer_ip The address of the client.
+ * @return `true` if the connection is admitted.
  */
-void Server::handle_client(int client_socket) {
-    {
-        std::lock_guard<std::mutex> lock(client_sockets_mutex_);
-        client_sockets_.push_back(client_socket);
+bool Server::admit_connection(const std::string &peer_ip) {
+    std::lock_guard<std::mutex> lock(connection_limits_mutex_);
+    if (metrics_.active_connections >= conn_config_.max_connections_total) {
+        AEVUM_LOG_WARN("Network: Rejected connection from " + peer_ip + ": the limit of " +
+                       std::to_string(conn_config_.max_connections_total) +
+                       " connections is reached.");
+        return false;
     }
+    int &from_ip = connections_per_ip_[peer_ip];
+    if (from_ip >= conn_config_.max_connections_per_ip) {
+        AEVUM_LOG_WARN("Network: Rejected connection from " + peer_ip +
+                       ": the per-address limit of " +
+                       std::to_string(conn_config_.max_connections_per_ip) +
+                       " connections is reached.");
+        return false;
+    }
+    ++from_ip;
+    ++metrics_.active_connections;
+    return true;
+}
 
-    AEVUM_DEFER([&]() {
-        aevum::util::log::Logger::info("Network: Client disconnected. Cleaning up resources.");
-        close(client_socket);
-        std::lock_guard<std::mutex> lock(client_sockets_mutex_);
-        client_sockets_.erase(
-            std::remove(client_sockets_.begin(), client_sockets_.end(), client_socket),
-            client_sockets_.end());
-    });
+/**
+ * @brief Closes a connection, forgets it, and releases its share of the connection limits.
+ * @details Closing the socket also removes it from the `epoll` instance. A receive pending on a
+ * ring holds the socket open, so on a ring the socket is shut down first, which completes the
+ * receive. Releasing a connection twice, as its receive completes after the idle sweep released
+ * it, has no effect. The caller must be the only thread using the connection: its I/O thread
+ * while it is idle, or its worker while it is busy.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ */
+void Server::release_connection(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        auto it = loop.connections.find(conn->fd);
+        if (it == loop.connections.end() || it->second != conn) return;
+        loop.connections.erase(it);
+    }
+    if (loop.ring) shutdown(conn->fd, SHUT_RDWR);
+    close(conn->fd);
 
-    // Maximum allowed request size: 8MB
-    constexpr size_t MAX_REQUEST_SIZE = 8388608;
-    char buffer[16384];
+    std::lock_guard<std::mutex> lock(connection_limits_mutex_);
+    auto it = connections_per_ip_.find(conn->peer_ip);
+    if (it != connections_per_ip_.end() && --it->second <= 0) connections_per_ip_.erase(it);
+    --metrics_.active_connections;
+    AEVUM_LOG_DEBUG("Network: Client " + conn->peer_ip + " disconnected. Cleaning up resources.");
+}
 
+/**
+ * @brief The body of an I/O thread.
+ * @details Blocks in `epoll_wait` for at most `EPOLL_TICK_MS`, handles every ready connection
+ * with `read_request`, and closes idle connections at most once per tick. A loop on a ring
+ * blocks in `IoRing::wait` instead and hands every completed receive to `complete_receive`; the
+ * connection is forgotten by `receiving` even when the server is stopping, so that `stop()` only
+ * waits for the receives still pending. The thread exits when `stop()` clears `is_running_` and
+ * writes to the loop's `eventfd`.
+ * @param loop The event loop the thread runs.
+ */
+void Server::run_event_loop(EventLoop &loop) {
+    std::vector<struct epoll_event> events(loop.ring ? 0 : EPOLL_BATCH_SIZE);
+    std::vector<IoRing::Completion> completions;
+    int64_t last_sweep_ms = steady_now_ms();
     while (is_running_) {
-        std::memset(buffer, 0, sizeof(buffer));
-        ssize_t bytes_read = recv(client_socket, buffer, sizeof(buffer) - 1, 0);
-
-        if (bytes_read <= 0) break;
-
-        // Validate request size to prevent memory exhaustion attacks
-        if (bytes_read > static_cast<ssize_t>(MAX_REQUEST_SIZE)) {
-            aevum::util::log::Logger::warn("Network: Received oversized request (" +
-                                           std::to_string(bytes_read) +
-                                           " bytes). Rejecting to prevent memory exhaustion.");
-            std::string error_response = R"({"status":"error","message":"Request too large"})";
-            send(client_socket, error_response.c_str(), error_response.length(), 0);
+        if (loop.ring) {
+            completions.clear();
+            loop.ring->wait(completions, EPOLL_TICK_MS);
+            for (const auto &completion : completions) {
+                if (completion.user_data == WAKE_USER_DATA) continue;
+                std::shared_ptr<ClientConnection> conn;
+                {
+                    std::lock_guard<std::mutex> lock(loop.mutex);
+                    auto it = loop.receiving.find(completion.user_data);
+                    if (it == loop.receiving.end()) continue;
+                    conn = std::move(it->second);
+                    loop.receiving.erase(it);
+                }
+                if (is_running_) complete_receive(loop, conn, completion.result);
+            }
+        }
+
+        int ready = loop.ring ? 0
+                              : epoll_wait(loop.epoll_fd, events.data(), EPOLL_BATCH_SIZE,
+                                           EPOLL_TICK_MS);
+        if (ready < 0 && errno != EINTR) {
+            AEVUM_LOG_ERROR("Network: epoll_wait failed: " + std::string(strerror(errno)));
             break;
         }
 
-        std::string_view request(buffer, bytes_read);
+        for (int i = 0; i < ready && is_running_; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == loop.wake_fd) continue;
 
-        if (request.find("\"action\":\"exit\"") != std::string_view::npos) {
-            aevum::util::log::Logger::info(
-                "Network: Client sent 'exit' command. Closing connection gracefully.");
-            std::string response = R"({"status":"ok","message":"Goodbye"})";
-            // Retry loop for send to handle partial writes
-            size_t sent = 0;
-            while (sent < response.length()) {
-                ssize_t n =
-                    send(client_socket, response.c_str() + sent, response.length() - sent, 0);
-                if (n < 0) {
-                    aevum::util::log::Logger::warn("Network: Failed to send response: " +
-                                                   std::string(strerror(errno)));
-                    break;
-                }
-                sent += n;
+            std::shared_ptr<ClientConnection> conn;
+            {
+                std::lock_guard<std::mutex> lock(loop.mutex);
+                auto it = loop.connections.find(fd);
+                if (it != loop.connections.end()) conn = it->second;
             }
-            break;
+            if (conn) read_request(loop, conn);
         }
 
-        std::string response = process_request(request);
-        // Retry loop for send to handle partial writes
-        size_t sent = 0;
-        while (sent < response.length()) {
-            ssize_t n = send(client_socket, response.c_str() + sent, response.length() - sent, 0);
-            if (n < 0) {
-                aevum::util::log::Logger::warn("Network: Failed to send response: " +
-                                               std::string(strerror(errno)));
-                break;
+        int64_t now_ms = steady_now_ms();
+        if (now_ms - last_sweep_ms >= EPOLL_TICK_MS) {
+            last_sweep_ms = now_ms;
+            close_idle_connections(loop);
+        }
+    }
+}
+
+/**
+ * @brief Receives data from a readable connection and dispatches the buffered requests to the
+ * worker pool.
+ * @details Bytes are received straight into the connection's `FrameDecoder`, in chunks of
+ * `RECEIVE_BUFFER_SIZE`, until the socket has no more data or a complete request is buffered.
+ * A partial request re-arms the connection to wait for the rest. Otherwise the requests are
+ * handed to a worker by `dispatch_requests`.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ */
+void Server::read_request(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    FrameDecoder::Result state = FrameDecoder::Result::NEED_MORE;
+    while (state == FrameDecoder::Result::NEED_MORE) {
+        char *space = conn->decoder.prepare(RECEIVE_BUFFER_SIZE);
+        ssize_t bytes_read = recv(conn->fd, space, RECEIVE_BUFFER_SIZE, 0);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            (void)rearm(loop, conn);
+            return;
+        }
+        if (bytes_read <= 0) {
+            release_connection(loop, conn);
+            return;
+        }
+        conn->decoder.commit(static_cast<size_t>(bytes_read));
+        metrics_.total_bytes_received += static_cast<uint64_t>(bytes_read);
+        state = conn->decoder.peek();
+    }
+    dispatch_requests(loop, conn);
+}
+
+/**
+ * @brief Handles a completed receive of a connection on a ring.
+ * @details A connection the idle sweep released while the receive was pending is dropped here,
+ * whatever the receive returned. `EINTR` and `EAGAIN` submit the receive again.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ * @param result The result of the receive.
+ */
+void Server::complete_receive(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn,
+                              int result) {
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        auto it = loop.connections.find(conn->fd);
+        if (it == loop.connections.end() || it->second != conn) return;
+    }
+    if (result == -EINTR || result == -EAGAIN) {
+        if (!submit_receive(loop, conn)) release_connection(loop, conn);
+        return;
+    }
+    if (result <= 0) {
+        release_connection(loop, conn);
+        return;
+    }
+    conn->decoder.commit(static_cast<size_t>(result));
+    metrics_.total_bytes_received += static_cast<uint64_t>(result);
+    if (conn->decoder.peek() == FrameDecoder::Result::NEED_MORE) {
+        if (!submit_receive(loop, conn)) release_connection(loop, conn);
+        return;
+    }
+    dispatch_requests(loop, conn);
+}
+
+/**
+ * @brief Submits a receive of up to `RECEIVE_BUFFER_SIZE` bytes into a connection's decoder.
+ * @details The connection is added to `receiving` before the submission, since the receive may
+ * complete before `submit` returns, and removed again if the submission fails.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ * @return `true` if the receive was submitted.
+ */
+bool Server::submit_receive(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    char *space = conn->decoder.prepare(RECEIVE_BUFFER_SIZE);
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        loop.receiving[conn->id] = conn;
+    }
+    if (loop.ring->receive(conn->fd, space, RECEIVE_BUFFER_SIZE, conn->id)) return true;
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    loop.receiving.erase(conn->id);
+    return false;
+}
+
+/**
+ * @brief Marks a connection busy and hands it to a worker.
+ * @details The connection stays disarmed, with no `epoll` interest and no receive pending,
+ * until the worker has answered every buffered request.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ */
+void Server::dispatch_requests(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    {
+        std::lock_guard<std::mutex> lock(conn->mutex);
+        conn->busy = true;
+        conn->last_active_ms = steady_now_ms();
+        conn->received_ms = conn->last_active_ms;
+    }
+    // Nothing waits for the task, so an exception is logged here instead of ending the daemon.
+    request_workers_->submit([this, &loop, conn]() {
+        try {
+            serve_requests(loop, conn);
+        } catch (const std::exception &e) {
+            AEVUM_LOG_ERROR("Network: Request processing failed: " + std::string(e.what()));
+            ++metrics_.total_errors;
+            release_connection(loop, conn);
+        }
+    });
+}
+
+/**
+ * @brief Queues a response in the encoding the client uses.
+ * @details Clients that frame their requests get framed responses; clients that send bare JSON
+ * get the bare response. The frame header is sent as a buffer of its own, so the payload is not
+ * copied. The responses queued to pipelined requests are sent together, once they hold
+ * `RESPONSE_BATCH_BYTES` or when `serve_requests` runs out of buffered requests. On a connection
+ * that negotiated compression, a response that compresses is swapped with the connection's
+ * compression buffer, so the buffer inherits the response's capacity and the next response is
+ * compressed without allocating.
+ * @param conn The connection.
+ * @param response The response payload.
+ * @return `false` if the queue had to be flushed and the flush failed.
+ */
+bool Server::send_response(ClientConnection &conn, std::string response) {
+    bool framed = conn.decoder.mode() == FrameDecoder::Mode::FRAMED;
+    bool compressed = framed && conn.codec.compress(response, conn.deflated);
+    if (compressed) response.swap(conn.deflated);
+    conn.writer.queue(std::move(response), framed, compressed);
+    return conn.writer.queued_bytes() < RESPONSE_BATCH_BYTES || flush_responses(conn);
+}
+
+/**
+ * @brief Answers a "hello" request.
+ * @details Only framed connections can carry binary bodies or compressed frames; others stay on
+ * plain JSON. A compressor is granted if `wire_compression` is on and it is compiled in, and the
+ * dictionary if the client names the id of the one the server holds; the response echoes what
+ * was granted. The decoder accepts compressed frames from the next request on.
+ * @param conn The connection.
+ * @param request The "hello" request.
+ * @return `false` if a flush failed.
+ */
+bool Server::serve_hello(ClientConnection &conn, std::string_view request) {
+    bool framed = conn.decoder.mode() == FrameDecoder::Mode::FRAMED;
+    bool bson = framed && request.find("\"protocol\":\"bson\"") != std::string_view::npos;
+    std::string response = bson ? R"({"status":"ok","protocol":"bson")"
+                                : R"({"status":"ok","protocol":"json")";
+
+    std::string_view asked = aevum::net::hello_field(request, "compression");
+    auto compressor = aevum::net::WireCompressor::NONE;
+    std::shared_ptr<const aevum::net::WireDictionary> dictionary;
+    if (!asked.empty()) {
+        compressor = aevum::net::parse_wire_compressor(asked);
+        if (!framed || !conn_config_.wire_compression ||
+            !aevum::net::wire_compressor_available(compressor)) {
+            compressor = aevum::net::WireCompressor::NONE;
+        }
+        if (compressor == aevum::net::WireCompressor::ZSTD && wire_dictionary_ != nullptr &&
+            aevum::net::hello_field(request, "dictionary") ==
+                std::to_string(wire_dictionary_->id())) {
+            dictionary = wire_dictionary_;
+        }
+        response.append(R"(,"compression":")")
+            .append(aevum::net::wire_compressor_name(compressor))
+            .append("\"");
+        if (dictionary != nullptr) {
+            response.append(",\"dictionary\":").append(std::to_string(dictionary->id()));
+        }
+    }
+    response.append("}");
+
+    bool sent = send_response(conn, std::move(response));
+    conn.bson_mode = bson;
+    if (compressor != aevum::net::WireCompressor::NONE &&
+        conn.codec
+            .configure(compressor,
+                       static_cast<size_t>(std::max(conn_config_.wire_compression_min_bytes, 0)),
+                       conn_config_.wire_compression_level, std::move(dictionary),
+                       &compression_stats_)
+            .ok()) {
+        conn.decoder.accept_compressed(true);
+        ++compression_stats_.connections;
+    }
+    return sent;
+}
+
+/**
+ * @brief Sends the responses queued on a connection and counts their bytes.
+ * @param conn The connection.
+ * @return `true` if every response was sent completely.
+ */
+bool Server::flush_responses(ClientConnection &conn) {
+    size_t bytes = conn.writer.queued_bytes();
+    if (!conn.writer.flush(conn_config_.request_timeout_sec * 1000)) return false;
+    metrics_.total_bytes_sent += bytes;
+    return true;
+}
+
+/**
+ * @brief Processes the buffered requests of a connection on a worker thread.
+ * @details Requests are taken from the decoder and answered one after another, in order, until
+ * no complete request is left; the queued responses are then sent together and the connection
+ * re-armed. A `watch`, which may wait for changes for seconds, first sends the responses queued
+ * before it. The request views point into the
+ * decoder's buffer, which the I/O thread does not touch while the connection is busy, so they are
+ * processed without being copied. An "exit" command is answered with a goodbye message and closes
+ * the connection, as does a request above `max_request_size_bytes` (the stream cannot be resynced
+ * after it) or a response that cannot be sent within `request_timeout_sec`. A "hello" request
+ * asking for the BSON protocol switches a framed connection to BSON bodies, whose requests are
+ * answered by `serve_bson_request` from then on; one asking for compression makes the requests
+ * flagged as compressed be decompressed into the connection's buffer first, as is a request
+ * that cannot be decompressed, which closes the connection.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ */
+void Server::serve_requests(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    std::string_view request;
+    for (;;) {
+        FrameDecoder::Result result = conn->decoder.next(request);
+        if (result == FrameDecoder::Result::NEED_MORE) break;
+        if (result == FrameDecoder::Result::TOO_LARGE) {
+            AEVUM_LOG_WARN("Network: Received a request above " +
+                           std::to_string(conn_config_.max_request_size_bytes) +
+                           " bytes. Rejecting it to prevent memory exhaustion.");
+            ++metrics_.total_errors;
+            (void)send_response(*conn, R"({"status":"error","message":"Request too large"})");
+            (void)flush_responses(*conn);
+            release_connection(loop, conn);
+            return;
+        }
+        ++metrics_.total_requests;
+
+        if (conn->decoder.compressed()) {
+            auto status = conn->codec.decompress(
+                request, static_cast<size_t>(conn_config_.max_request_size_bytes), conn->inflated);
+            if (!status.ok()) {
+                AEVUM_LOG_WARN("Network: Rejecting a compressed request: " + status.message());
+                ++metrics_.total_errors;
+                (void)send_response(
+                    *conn, R"({"status":"error","message":"Invalid compressed request"})");
+                (void)flush_responses(*conn);
+                release_connection(loop, conn);
+                return;
             }
-            sent += n;
+            request = conn->inflated;
         }
+
+        if (conn->bson_mode) {
+            if (!serve_bson_request(*conn, request)) {
+                (void)flush_responses(*conn);
+                release_connection(loop, conn);
+                return;
+            }
+            conn->received_ms = steady_now_ms();
+            continue;
+        }
+
+        if (request.find("\"action\":\"exit\"") != std::string_view::npos) {
+            AEVUM_LOG_INFO("Network: Client sent 'exit' command. Closing connection gracefully.");
+            (void)send_response(*conn, R"({"status":"ok","message":"Goodbye"})");
+            (void)flush_responses(*conn);
+            release_connection(loop, conn);
+            return;
+        }
+
+        if (request.find("\"action\":\"hello\"") != std::string_view::npos) {
+            if (!serve_hello(*conn, request)) {
+                ++metrics_.total_errors;
+                release_connection(loop, conn);
+                return;
+            }
+            continue;
+        }
+
+        if (conn->writer.queued_bytes() > 0 &&
+            request.find("\"action\":\"watch\"") != std::string_view::npos &&
+            !flush_responses(*conn)) {
+            ++metrics_.total_errors;
+            release_connection(loop, conn);
+            return;
+        }
+
+        // Pipelining clients correlate responses through the id their request is tagged with.
+        std::string response = process_request(*conn, request);
+        std::string_view request_id = aevum::net::find_request_id(request);
+        if (!request_id.empty()) aevum::net::tag_request_id(response, request_id);
+
+        if (!send_response(*conn, std::move(response))) {
+            ++metrics_.total_errors;
+            release_connection(loop, conn);
+            return;
+        }
+        conn->received_ms = steady_now_ms();
+    }
+    if (!flush_responses(*conn)) {
+        ++metrics_.total_errors;
+        release_connection(loop, conn);
+        return;
+    }
+    (void)rearm(loop, conn);
+}
+
+/**
+ * @brief Answers a request received on a connection that speaks the BSON protocol.
+ * @details The request is validated in place, without copying the frame. A `find` is
+ * authenticated and run here, and its result set is sent as a `DocumentsReply`, after the queued
+ * responses, so the matched documents go from their buffers to the socket without being
+ * serialized or copied, and a large result set without being copied into the kernel either,
+ * unless the connection compresses it, which needs it gathered into one buffer first. The
+ * other actions are rare enough on bulk paths that they share the JSON dispatcher: the request
+ * is serialized to relaxed extended JSON, which preserves every value the dispatcher reads.
+ * @param conn The connection.
+ * @param request The BSON request document.
+ * @return `false` if the connection must be closed, after "exit" or a failed send.
+ */
+bool Server::serve_bson_request(ClientConnection &conn, std::string_view request) {
+    bson_t frame;
+    if (!bson_init_static(&frame, reinterpret_cast<const uint8_t *>(request.data()),
+                          request.size()) ||
+        !bson_validate(&frame, BSON_VALIDATE_NONE, nullptr)) {
+        ++metrics_.total_errors;
+        return send_bson_response(conn, R"({"status":"error","message":"Invalid BSON request"})");
+    }
+
+    std::string_view action = bson_wire_string(&frame, "action");
+    if (action == "exit") {
+        AEVUM_LOG_INFO("Network: Client sent 'exit' command. Closing connection gracefully.");
+        (void)send_bson_response(conn, R"({"status":"ok","message":"Goodbye"})");
+        return false;
+    }
+
+    // Cursor batches are small by design, so they share the JSON path as well, as does every
+    // request of a router, which gathers its answers from the shards, and every request within
+    // a transaction, which is read through it.
+    if (action != "find" || bson_wire_int64(&frame, "batchSize") > 0 || router_ != nullptr ||
+        conn.transaction) {
+        if (action == "watch" && !flush_responses(conn)) {
+            ++metrics_.total_errors;
+            return false;
+        }
+        bson_t *copy = bson_copy(&frame);
+        std::string json = aevum::bson::json::to_string(aevum::bson::doc::Document(copy));
+        return send_bson_response(conn, process_request(conn, json));
+    }
+
+    RequestLatencyScope latency(metrics_.action_latency, metrics_.collection_latency);
+    std::string_view owner;  // A single-batch `find` opens no cursor to own.
+    auto role = authorize(conn, bson_wire_string(&frame, "auth"),
+                          bson_wire_string(&frame, "session"), owner);
+    if (role == aevum::db::auth::UserRole::NONE) {
+        AEVUM_LOG_WARN("Network: Authentication failed for request with action 'find'.");
+        return send_bson_response(conn, R"({"status":"error", "message":"Authentication failed"})");
+    }
+    latency.identify(action, bson_wire_string(&frame, "collection"));
+    AdmissionController::Ticket ticket;
+    auto outcome = admission_.admit(
+        is_bson_point_query(&frame) ? RequestClass::POINT : RequestClass::SCAN,
+        request_deadline(conn.received_ms, conn_config_.request_timeout_sec,
+                         bson_wire_int64(&frame, "maxTimeMS")),
+        ticket);
+    if (outcome != AdmissionController::Outcome::ADMITTED) {
+        return send_bson_response(conn, admission_error(outcome));
+    }
+    if (std::string error =
+            stale_replica_error(replicator_, bson_wire_int64(&frame, "maxStalenessMs"));
+        !error.empty()) {
+        return send_bson_response(conn, error);
+    }
+
+    auto docs = db_core_.find(bson_wire_string(&frame, "collection"),
+                              bson_wire_subdocument_json(&frame, "query"),
+                              bson_wire_subdocument_json(&frame, "sort"),
+                              bson_wire_subdocument_json(&frame, "projection"),
+                              bson_wire_int64(&frame, "limit"), bson_wire_int64(&frame, "skip"));
+    aevum::net::DocumentsReply reply(docs);
+    if (conn.codec.compressor() != aevum::net::WireCompressor::NONE &&
+        reply.size() - FRAME_HEADER_SIZE >=
+            static_cast<size_t>(std::max(conn_config_.wire_compression_min_bytes, 0))) {
+        // Compressed, the result set costs fewer bytes on the wire than the copy that gathers it.
+        std::string body;
+        body.reserve(reply.size());
+        size_t skip = FRAME_HEADER_SIZE;
+        for (const struct iovec &buffer : reply.buffers()) {
+            size_t dropped = std::min(skip, buffer.iov_len);
+            body.append(static_cast<const char *>(buffer.iov_base) + dropped,
+                        buffer.iov_len - dropped);
+            skip -= dropped;
+        }
+        if (!send_response(conn, std::move(body))) {
+            ++metrics_.total_errors;
+            return false;
+        }
+        return true;
+    }
+    if (!flush_responses(conn) ||
+        !conn.writer.send(reply.buffers(), reply.size(), conn_config_.request_timeout_sec * 1000)) {
+        ++metrics_.total_errors;
+        return false;
+    }
+    metrics_.total_bytes_sent += reply.size();
+    return true;
+}
+
+/**
+ * @brief Converts a JSON response to BSON and sends it as one frame.
+ * @details A response that is not valid JSON, such as an error message quoting malformed input,
+ * is replaced by a generic error so that the client always receives a BSON document.
+ * @param conn The connection.
+ * @param response The JSON response.
+ * @return `true` if the response was sent completely.
+ */
+bool Server::send_bson_response(ClientConnection &conn, std::string_view response) {
+    aevum::bson::doc::Document reply;
+    if (!aevum::bson::json::parse(response, reply).ok()) {
+        reply = aevum::bson::Builder()
+                    .append_string("status", "error")
+                    .append_string("message", "Response could not be encoded as BSON")
+                    .finalize();
+    }
+    const bson_t *bytes = reply.get();
+    return send_response(
+        conn, std::string(reinterpret_cast<const char *>(bson_get_data(bytes)), bytes->len));
+}
+
+/**
+ * @brief Marks a connection idle and re-enables its read notifications, or on a ring submits its
+ * next receive.
+ * @details Both happen under the connection's mutex, so the idle sweep cannot close the socket
+ * between the two.
+ * @param loop The event loop of the connection.
+ * @param conn The connection.
+ * @return `true` on success; on failure the connection is released.
+ */
+bool Server::rearm(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn) {
+    int ret;
+    {
+        std::lock_guard<std::mutex> lock(conn->mutex);
+        conn->busy = false;
+        conn->last_active_ms = steady_now_ms();
+        if (loop.ring) {
+            ret = submit_receive(loop, conn) ? 0 : -1;
+        } else {
+            struct epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.fd = conn->fd;
+            ret = epoll_ctl(loop.epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+        }
+    }
+    if (ret < 0) {
+        release_connection(loop, conn);
+        return false;
     }
+    return true;
+}
+
+/**
+ * @brief Closes the connections of an event loop that have been idle for longer than
+ * `max_idle_timeout_sec`.
+ * @details Runs on the loop's I/O thread. Connections with a request in progress are skipped.
+ * A timeout of zero or less disables the sweep.
+ * @param loop The event loop.
+ */
+void Server::close_idle_connections(EventLoop &loop) {
+    if (conn_config_.max_idle_timeout_sec <= 0) return;
+    int64_t deadline_ms = steady_now_ms() - int64_t{conn_config_.max_idle_timeout_sec} * 1000;
+
+    std::vector<std::shared_ptr<ClientConnection>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        candidates.reserve(loop.connections.size());
+        for (const auto &[fd, conn] : loop.connections) candidates.push_back(conn);
+    }
+    for (const auto &conn : candidates) {
+        {
+            std::lock_guard<std::mutex> lock(conn->mutex);
+            if (conn->busy || conn->last_active_ms > deadline_ms) continue;
+        }
+        AEVUM_LOG_INFO("Network: Closing connection from " + conn->peer_ip + " after " +
+                       std::to_string(conn_config_.max_idle_timeout_sec) +
+                       " seconds of inactivity.");
+        release_connection(loop, conn);
+    }
+}
+
+/**
+ * @brief Verifies an API key once and opens a session on the connection.
+ * @details The token is 32 bytes from the system's secure generator, in hexadecimal, so that it
+ * cannot be guessed from the tokens of other connections.
+ * @param conn The connection.
+ * @param auth_key The API key of the request.
+ * @return The response, holding the token and the role.
+ */
+std::string Server::open_session(ClientConnection &conn, std::string_view auth_key) {
+    auto role = db_core_.login(auth_key);
+    if (role == aevum::db::auth::UserRole::NONE) {
+        AEVUM_LOG_WARN("Network: Login failed from " + conn.peer_ip + ".");
+        return R"({"status":"error", "message":"Authentication failed"})";
+    }
+    conn.session_token =
+        aevum::util::crypto::to_hex(aevum::util::crypto::secure_random_bytes(SESSION_TOKEN_SIZE));
+    conn.session_role = role;
+    conn.session_owner = std::string(auth_key);
+    AEVUM_LOG_INFO("Network: Opened a session with role " +
+                   std::string(aevum::db::auth::to_string(role)) + " for " + conn.peer_ip + ".");
+    return R"({"status":"ok", "session":")" + conn.session_token + R"(", "role":")" +
+           std::string(aevum::db::auth::to_string(role)) + R"("})";
+}
+
+/**
+ * @brief Authorizes a request by its session token or, without one, by its API key.
+ * @details A request with a session is authorized from the connection's state alone: the token
+ * is compared in constant time, and the role and owner are those verified by `login`. A
+ * request without one is authenticated by `Core::authenticate`, as before sessions.
+ * @param conn The connection the request was received on.
+ * @param auth_key The `auth` field of the request, or empty.
+ * @param session The `session` field of the request, or empty.
+ * @param owner Receives the API key that owns the request's cursors and prepared queries.
+ * @return The role of the request, or `UserRole::NONE` if it is not authorized.
+ */
+aevum::db::auth::UserRole Server::authorize(const ClientConnection &conn,
+                                            std::string_view auth_key, std::string_view session,
+                                            std::string_view &owner) {
+    if (session.empty()) {
+        owner = auth_key;
+        return db_core_.authenticate(auth_key);
+    }
+    if (conn.session_token.empty() ||
+        !aevum::util::crypto::constant_time_equal(session, conn.session_token)) {
+        return aevum::db::auth::UserRole::NONE;
+    }
+    owner = conn.session_owner;
+    return conn.session_role;
 }
 
 /**
  * @brief Parses, authenticates, and dispatches a client's JSON request.
  * @details This function is the core of the server's application logic.
  * 1.  It uses `simdjson` to parse the request for maximum performance.
- * 2.  It extracts the `auth` key and authenticates the user via `db_core_`.
+ * 2.  It authorizes the request by its `session` token, or by its `auth` key via `db_core_`;
+ *     `login` and `logout` open and close the connection's session.
  * 3.  If authenticated, it checks for permissions for the requested `action`.
  * 4.  It extracts the action and all relevant parameters (collection, query, data, etc.).
  * 5.  It calls the corresponding method on the `db_core_` instance.
  * 6.  It formats the result from the core (e.g., status, data, count) into a JSON response string.
+ * Every authenticated request, except `watch`, is admitted by `admission_` in its class before
+ * it runs, and is refused as `server_busy` or `deadline_exceeded` if it cannot be. It is then
+ * offered to `process_transaction_request`, which serves the transaction actions and the
+ * requests of a transaction.
+ * @param conn The connection the request was received on.
  * @param request The JSON request from the client.
  * @return A JSON response string to be sent back to the client.
  */
-std::string Server::process_request(std::string_view request) {
+std::string Server::process_request(ClientConnection &conn, std::string_view request) {
     // Health check endpoint - responds immediately without authentication
     // Useful for load balancers and monitoring systems
     if (request == R"({"action":"health"})" || request == "{\"action\":\"health\"}") {
         return R"({"status":"ok","message":"AevumDB is healthy"})";
     }
 
-    // Generate hash of request for deduplication
-    std::hash<std::string_view> hasher;
-    std::string request_hash = std::to_string(hasher(request));
-
-    // Check request cache for duplicates
-    std::string cached_response;
-    if (request_cache_.get_cached_response(request_hash, cached_response)) {
-        aevum::util::log::Logger::debug("Network: Request deduplicated from cache.");
-        return cached_response;
-    }
-
-    simdjson::dom::parser parser;
+    // The scratch memory of this request is reclaimed when it returns, after everything using it.
+    aevum::util::memory::ScratchScope scratch_scope;
+    RequestLatencyScope latency(metrics_.action_latency, metrics_.collection_latency);
+    // The DOM lives in the parser's buffers, so the lease must outlive every use of `doc`.
+    auto parser = json_parsers_.borrow();
     simdjson::dom::element doc;
     try {
-        doc = parser.parse(request);
+        doc = parser->parse(request);
     } catch (const simdjson::simdjson_error &e) {
-        aevum::util::log::Logger::warn("Network: Received malformed JSON request. Details: " +
-                                       std::string(e.what()));
+        AEVUM_LOG_WARN("Network: Received malformed JSON request. Details: " +
+                       std::string(e.what()));
         return R"({"status":"error", "message":"Invalid JSON request"})";
     }
 
@@ -298,36 +1646,142 @@ std::string Server::process_request(std::string_view request) {
         return R"({"status":"ok","message":"AevumDB is healthy"})";
     }
 
-    if (doc["auth"].get_string().get(auth_key) != simdjson::SUCCESS) {
+    // A request of a session carries its token instead of the API key.
+    std::string_view session;
+    (void)doc["session"].get_string().get(session);
+    if (session.empty() && doc["auth"].get_string().get(auth_key) != simdjson::SUCCESS) {
         return R"({"status":"error", "message":"'auth' field is missing or not a string"})";
     }
+    if (action == "login") return open_session(conn, auth_key);
 
-    auto role = db_core_.authenticate(auth_key);
+    auto role = authorize(conn, auth_key, session, auth_key);
     if (role == aevum::db::auth::UserRole::NONE) {
-        aevum::util::log::Logger::warn("Network: Authentication failed for request with action '" +
-                                       std::string(action) + "'.");
+        AEVUM_LOG_WARN("Network: Authentication failed for request with action '" +
+                       std::string(action) + "'.");
         return R"({"status":"error", "message":"Authentication failed"})";
     }
-    aevum::util::log::Logger::debug("Network: Authenticated request for action '" +
-                                    std::string(action) + "' with role " +
-                                    std::string(aevum::db::auth::to_string(role)) + ".");
+    if (action == "logout") {
+        conn.session_token.clear();
+        conn.session_owner.clear();
+        conn.session_role = aevum::db::auth::UserRole::NONE;
+        return R"({"status":"ok"})";
+    }
+    AEVUM_LOG_DEBUG("Network: Authenticated request for action '" + std::string(action) +
+                    "' with role " + std::string(aevum::db::auth::to_string(role)) + ".");
 
     (void)doc["collection"].get_string().get(collection);
+    latency.identify(action, collection);
+
+    // Each class of request runs within its own limit; the ticket holds the slot until the
+    // response is built.
+    AdmissionController::Ticket ticket;
+    std::optional<RequestClass> request_class = classify_request(action, doc);
+    // A prepared query is classified by its template, which the request does not carry.
+    if (action == "execute") {
+        int64_t statement = 0;
+        (void)doc["statement"].get_int64().get(statement);
+        auto prepared = db_core_.prepared_query(statement, auth_key);
+        if (prepared && prepared->point) request_class = RequestClass::POINT;
+    }
+    if (request_class) {
+        int64_t max_time_ms = 0;
+        (void)doc["maxTimeMS"].get_int64().get(max_time_ms);
+        auto outcome = admission_.admit(
+            *request_class,
+            request_deadline(conn.received_ms, conn_config_.request_timeout_sec, max_time_ms),
+            ticket);
+        if (outcome != AdmissionController::Outcome::ADMITTED) return admission_error(outcome);
+    }
+
+    // Writes may ask for a durability level other than the configured default.
+    std::string_view durability_str = "default";
+    (void)doc["durability"].get_string().get(durability_str);
+    auto durability = aevum::db::storage::durability_from_string(durability_str);
+    if (!durability) {
+        return R"({"status":"error", "message":"'durability' must be none, journal or fsync"})";
+    }
+
+    // A read replica takes documents from its primary only, and serves reads within the
+    // staleness they allow.
+    if (replicator_ != nullptr && is_document_write(action)) {
+        return R"({"status":"error", "code":"read_replica", )"
+               R"("message":"This server is a read replica; send writes to the primary"})";
+    }
+    if (action == "find" || action == "count" || action == "aggregate") {
+        int64_t max_staleness_ms = 0;
+        (void)doc["maxStalenessMs"].get_int64().get(max_staleness_ms);
+        if (std::string error = stale_replica_error(replicator_, max_staleness_ms);
+            !error.empty()) {
+            return error;
+        }
+    }
+
+    if (auto response = process_transaction_request(conn, action, collection, doc, *durability)) {
+        return *std::move(response);
+    }
+
+    // A router answers data requests from its shards.
+    if (router_ != nullptr) {
+        if (auto routed = router_->route(action, collection, doc, role)) return *std::move(routed);
+    }
 
     if (action == "insert") {
         aevum::bson::doc::Document bson_doc;
-        if (auto status = aevum::bson::json::parse(simdjson::to_string(doc["data"]), bson_doc);
-            !status.ok()) {
-            std::string response =
-                R"({"status":"error", "message":"Invalid BSON data for insert"})";
-            request_cache_.cache_response(request_hash, response);
-            return response;
+        simdjson::dom::element data;
+        if (doc["data"].get(data) != simdjson::SUCCESS ||
+            !aevum::bson::json::from_dom(data, bson_doc).ok()) {
+            return R"({"status":"error", "message":"Invalid BSON data for insert"})";
         }
-        auto [status, id] = db_core_.insert(collection, std::move(bson_doc));
+        auto [status, id] = db_core_.insert(collection, std::move(bson_doc), *durability);
         std::string response =
-            status.ok() ? R"({"status":"ok", "_id":")" + id + R"("})"
+            status.ok() ? inserted_json(id, db_core_.key_format(collection) ==
+                                                aevum::db::storage::KeyFormat::INT64)
                         : R"({"status":"error", "message":")" + status.message() + R"("})";
-        request_cache_.cache_response(request_hash, response);
+        return response;
+    } else if (action == "insert_many") {
+        simdjson::dom::array data_array;
+        if (doc["data"].get_array().get(data_array) != simdjson::SUCCESS) {
+            return R"({"status":"error", "message":"'data' must be an array for insert_many"})";
+        }
+
+        // Documents that fail to parse are reported in place; the rest go to the core together.
+        std::vector<std::string> entries;
+        std::vector<aevum::bson::doc::Document> bson_docs;
+        std::vector<size_t> positions;
+        for (simdjson::dom::element element : data_array) {
+            aevum::bson::doc::Document bson_doc;
+            if (!element.is_object() ||
+                !aevum::bson::json::from_dom(element, bson_doc).ok()) {
+                entries.emplace_back(
+                    R"({"status":"error", "message":"Invalid BSON data for insert"})");
+                continue;
+            }
+            positions.push_back(entries.size());
+            entries.emplace_back();
+            bson_docs.push_back(std::move(bson_doc));
+        }
+
+        auto results = db_core_.insert_many(collection, std::move(bson_docs), *durability);
+        bool integer_id = db_core_.key_format(collection) == aevum::db::storage::KeyFormat::INT64;
+        size_t inserted = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &[status, id] = results[i];
+            if (status.ok()) {
+                entries[positions[i]] = inserted_json(id, integer_id);
+                ++inserted;
+            } else {
+                entries[positions[i]] =
+                    R"({"status":"error", "message":")" + status.message() + R"("})";
+            }
+        }
+
+        std::string response =
+            R"({"status":"ok", "inserted":)" + std::to_string(inserted) + R"(, "results":[)";
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i > 0) response += ",";
+            response += entries[i];
+        }
+        response += "]}";
         return response;
     } else if (action == "find") {
         std::string query_json = "{}", sort_json = "{}", projection_json = "{}";
@@ -340,91 +1794,326 @@ std::string Server::process_request(std::string_view request) {
         (void)doc["limit"].get_int64().get(limit_val);
         (void)doc["skip"].get_int64().get(skip_val);
 
-        auto docs = db_core_.find(collection, query_json, sort_json, projection_json,
-                                  static_cast<int64_t>(limit_val), static_cast<int64_t>(skip_val));
-        std::string result_json = "[";
-        for (size_t i = 0; i < docs.size(); ++i) {
-            result_json += aevum::bson::json::to_string(docs[i]);
-            if (i < docs.size() - 1) result_json += ",";
+        // A batch size opens a cursor; its batches are not cached, since they advance it.
+        int64_t batch_size = 0;
+        if (doc["batchSize"].get_int64().get(batch_size) == simdjson::SUCCESS && batch_size > 0) {
+            int64_t cursor_id = 0;
+            std::vector<aevum::bson::doc::Document> batch;
+            db_core_.open_cursor(collection, query_json, sort_json, projection_json,
+                                 static_cast<int64_t>(limit_val), static_cast<int64_t>(skip_val),
+                                 static_cast<size_t>(batch_size), auth_key, cursor_id, batch);
+            return cursor_batch_response(cursor_id, batch);
         }
-        result_json += "]";
-        std::string response = R"({"status":"ok", "data":)" + result_json + "}";
-        request_cache_.cache_response(request_hash, response);
-        return response;
+
+        // The generation is read before the query runs, so a write that lands in between leaves
+        // the entry stale rather than wrongly current.
+        std::pmr::string cache_key = result_cache_key(action, collection, query_json, sort_json,
+                                                      projection_json, limit_val, skip_val);
+        uint64_t generation = db_core_.write_generation(collection);
+        return shared_read(cache_key, generation, [&](bool &) {
+            auto docs =
+                db_core_.find(collection, query_json, sort_json, projection_json,
+                              static_cast<int64_t>(limit_val), static_cast<int64_t>(skip_val));
+            std::string response = R"({"status":"ok", "data":)";
+            append_documents_json(docs, response);
+            response += "}";
+            return response;
+        });
+    } else if (action == "getMore") {
+        int64_t cursor_id = 0, batch_size = 0;
+        if (doc["cursor"].get_int64().get(cursor_id) != simdjson::SUCCESS) {
+            return R"({"status":"error", "message":"'cursor' must be an integer for getMore"})";
+        }
+        (void)doc["batchSize"].get_int64().get(batch_size);
+        std::vector<aevum::bson::doc::Document> batch;
+        auto status = db_core_.get_more(cursor_id, auth_key,
+                                        batch_size > 0 ? static_cast<size_t>(batch_size) : 0,
+                                        batch);
+        if (!status.ok()) {
+            return R"({"status":"error", "message":")" + status.message() + R"("})";
+        }
+        return cursor_batch_response(cursor_id, batch);
+    } else if (action == "killCursor") {
+        int64_t cursor_id = 0;
+        if (doc["cursor"].get_int64().get(cursor_id) != simdjson::SUCCESS) {
+            return R"({"status":"error", "message":"'cursor' must be an integer for killCursor"})";
+        }
+        bool killed = db_core_.kill_cursor(cursor_id, auth_key);
+        return R"({"status":"ok", "killed":)" + std::string(killed ? "1" : "0") + "}";
+    } else if (action == "prepare") {
+        if (collection.empty() || !doc["query"].is_object()) {
+            return R"({"status":"error", )"
+                   R"("message":"'collection' and 'query' are required for prepare"})";
+        }
+        std::string sort_json = "{}", projection_json = "{}";
+        if (doc["sort"].is_object()) sort_json = simdjson::to_string(doc["sort"]);
+        if (doc["projection"].is_object()) projection_json = simdjson::to_string(doc["projection"]);
+        int64_t statement = 0;
+        auto status = db_core_.prepare(collection, simdjson::to_string(doc["query"]), sort_json,
+                                       projection_json, auth_key, statement);
+        if (!status.ok()) {
+            return R"({"status":"error", "message":")" + status.message() + R"("})";
+        }
+        return R"({"status":"ok", "statement":)" + std::to_string(statement) + "}";
+    } else if (action == "execute") {
+        int64_t statement = 0, limit_val = 0, skip_val = 0;
+        if (doc["statement"].get_int64().get(statement) != simdjson::SUCCESS) {
+            return R"({"status":"error", "message":"'statement' must be an integer for execute"})";
+        }
+        auto prepared = db_core_.prepared_query(statement, auth_key);
+        if (!prepared) {
+            return R"({"status":"error", "code":"unknown_statement", )"
+                   R"("message":"Statement not found; prepare it again"})";
+        }
+        aevum::bson::doc::Document params;
+        std::string params_json = "{}";
+        simdjson::dom::element params_dom;
+        if (doc["params"].get(params_dom) == simdjson::SUCCESS) {
+            if (!params_dom.is_object() || !aevum::bson::json::from_dom(params_dom, params).ok()) {
+                return R"({"status":"error", "message":"'params' must be an object for execute"})";
+            }
+            params_json = simdjson::to_string(params_dom);
+        }
+        (void)doc["limit"].get_int64().get(limit_val);
+        (void)doc["skip"].get_int64().get(skip_val);
+
+        // A statement id is never reused, so it stands for the template in the cache key.
+        std::pmr::string cache_key =
+            result_cache_key(action, prepared->collection, params_json,
+                             std::to_string(statement), "", limit_val, skip_val);
+        uint64_t generation = db_core_.write_generation(prepared->collection);
+        return shared_read(cache_key, generation, [&](bool &cacheable) {
+            std::vector<aevum::bson::doc::Document> docs;
+            auto status = db_core_.find(*prepared, params, limit_val, skip_val, docs);
+            if (!status.ok()) {
+                cacheable = false;
+                return R"({"status":"error", "message":")" + status.message() + R"("})";
+            }
+            std::string response = R"({"status":"ok", "data":)";
+            append_documents_json(docs, response);
+            response += "}";
+            return response;
+        });
+    } else if (action == "closeStatement") {
+        int64_t statement = 0;
+        if (doc["statement"].get_int64().get(statement) != simdjson::SUCCESS) {
+            return R"({"status":"error", )"
+                   R"("message":"'statement' must be an integer for closeStatement"})";
+        }
+        bool closed = db_core_.close_prepared(statement, auth_key);
+        return R"({"status":"ok", "closed":)" + std::string(closed ? "1" : "0") + "}";
     } else if (action == "update") {
         std::string query_json = "{}", update_json = "{}";
         if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
         if (doc["update"].is_object()) update_json = simdjson::to_string(doc["update"]);
-        auto [status, count] = db_core_.update(collection, query_json, update_json);
+        auto [status, count] = db_core_.update(collection, query_json, update_json, *durability);
         std::string response =
             status.ok() ? R"({"status":"ok", "updated_count":)" + std::to_string(count) + "}"
                         : R"({"status":"error", "message":")" + status.message() + R"("})";
-        request_cache_.cache_response(request_hash, response);
         return response;
+    } else if (action == "upsert") {
+        std::string query_json = "{}";
+        if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
+        aevum::bson::doc::Document bson_doc;
+        simdjson::dom::element data;
+        if (doc["data"].get(data) != simdjson::SUCCESS ||
+            !aevum::bson::json::from_dom(data, bson_doc).ok()) {
+            return R"({"status":"error", "message":"Invalid BSON data for upsert"})";
+        }
+        auto [status, result] = db_core_.upsert(collection, query_json, bson_doc, *durability);
+        if (!status.ok()) {
+            return R"({"status":"error", "message":")" + status.message() + R"("})";
+        }
+        if (!result.inserted_id.empty()) {
+            return R"({"status":"ok", "upserted_id":")" + result.inserted_id + R"("})";
+        }
+        return R"({"status":"ok", "updated_count":)" + std::to_string(result.updated) + "}";
     } else if (action == "count") {
         std::string query_json = "{}";
         if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
-        int count = db_core_.count(collection, query_json);
-        std::string response = R"({"status":"ok", "count":)" + std::to_string(count) + "}";
-        request_cache_.cache_response(request_hash, response);
+        std::pmr::string cache_key =
+            result_cache_key(action, collection, query_json, "", "", 0, 0);
+        uint64_t generation = db_core_.write_generation(collection);
+        return shared_read(cache_key, generation, [&](bool &) {
+            int count = db_core_.count(collection, query_json);
+            return R"({"status":"ok", "count":)" + std::to_string(count) + "}";
+        });
+    } else if (action == "aggregate") {
+        if (!doc["pipeline"].is_array()) {
+            return R"({"status":"error", "message":"'pipeline' must be an array for aggregate"})";
+        }
+        std::string pipeline_json = simdjson::to_string(doc["pipeline"]);
+        std::pmr::string cache_key =
+            result_cache_key(action, collection, pipeline_json, "", "", 0, 0);
+        uint64_t generation = db_core_.write_generation(collection);
+        return shared_read(cache_key, generation, [&](bool &cacheable) {
+            std::string results;
+            auto status = db_core_.aggregate(collection, pipeline_json, results);
+            if (!status.ok()) {
+                cacheable = false;
+                return R"({"status":"error", "message":")" + status.message() + R"("})";
+            }
+            return R"({"status":"ok", "data":)" + results + "}";
+        });
+    } else if (action == "explain") {
+        std::string query_json = "{}", sort_json = "{}";
+        if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
+        if (doc["sort"].is_object()) sort_json = simdjson::to_string(doc["sort"]);
+        auto plan = db_core_.explain(collection, query_json, sort_json);
+        std::string response =
+            R"({"status":"ok", "plan":)" + aevum::bson::json::to_string(plan) + "}";
         return response;
     } else if (action == "delete") {
         std::string query_json = "{}";
         if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
-        auto [status, count] = db_core_.remove(collection, query_json);
+        auto [status, count] = db_core_.remove(collection, query_json, *durability);
         std::string response =
             status.ok() ? R"({"status":"ok", "deleted_count":)" + std::to_string(count) + "}"
                         : R"({"status":"error", "message":")" + status.message() + R"("})";
-        request_cache_.cache_response(request_hash, response);
+        return response;
+    } else if (action == "watch") {
+        // Change stream - long-polls the change log from a resume token
+        int64_t after = 0, limit = 1000, max_wait_ms = 0;
+        (void)doc["after"].get_int64().get(after);
+        (void)doc["limit"].get_int64().get(limit);
+        (void)doc["max_wait_ms"].get_int64().get(max_wait_ms);
+        if (after < 0 || limit <= 0) {
+            return R"({"status":"error", )"
+                   R"("message":"'after' must not be negative and 'limit' must be positive"})";
+        }
+        std::vector<aevum::db::Change> changes;
+        uint64_t resume_token = 0;
+        auto status = db_core_.watch(
+            static_cast<uint64_t>(after), collection,
+            static_cast<size_t>(std::min(limit, MAX_WATCH_BATCH)),
+            std::chrono::milliseconds(std::clamp<int64_t>(max_wait_ms, 0, MAX_WATCH_WAIT_MS)),
+            changes, resume_token);
+        if (!status.ok()) {
+            return R"({"status":"error", "message":")" + status.message() + R"("})";
+        }
+        std::string response = R"({"status":"ok","resume_token":)" +
+                               std::to_string(resume_token) + R"(,"changes":[)";
+        for (size_t i = 0; i < changes.size(); ++i) {
+            if (i > 0) response += ',';
+            response += change_entry_json(changes[i], db_core_.key_format(changes[i].collection) ==
+                                                          aevum::db::storage::KeyFormat::INT64);
+        }
+        response += "]}";
         return response;
     } else if (action == "set_schema") {
         if (role != aevum::db::auth::UserRole::ADMIN) {
-            aevum::util::log::Logger::warn(
-                "Network: Denied 'set_schema' action due to insufficient permissions.");
+            AEVUM_LOG_WARN("Network: Denied 'set_schema' action due to insufficient permissions.");
             return R"({"status":"error", "message":"Permission denied"})";
         }
         aevum::bson::doc::Document schema_doc;
-        if (auto status = aevum::bson::json::parse(simdjson::to_string(doc["schema"]), schema_doc);
-            !status.ok()) {
+        simdjson::dom::element schema;
+        if (doc["schema"].get(schema) != simdjson::SUCCESS ||
+            !aevum::bson::json::from_dom(schema, schema_doc).ok()) {
             return R"({"status":"error", "message":"Invalid BSON schema"})";
         }
         auto status = db_core_.set_schema(collection, schema_doc);
         return status.ok() ? R"({"status":"ok"})"
                            : R"({"status":"error", "message":")" + status.message() + R"("})";
+    } else if (action == "create_index") {
+        if (role != aevum::db::auth::UserRole::ADMIN) {
+            AEVUM_LOG_WARN(
+                "Network: Denied 'create_index' action due to insufficient permissions.");
+            return R"({"status":"error", "message":"Permission denied"})";
+        }
+        std::string_view field;
+        if (doc["field"].get_string().get(field) != simdjson::SUCCESS || field.empty()) {
+            return R"({"status":"error", "message":"'field' is required for create_index"})";
+        }
+        std::string_view type_str = "hash";
+        (void)doc["type"].get_string().get(type_str);
+        auto type = aevum::db::index::index_type_from_string(type_str);
+        if (!type) {
+            return R"({"status":"error", )"
+                   R"("message":"'type' must be 'hash', 'ordered', 'columnar', or 'text'"})";
+        }
+        std::optional<int64_t> expire_after_seconds;
+        if (int64_t seconds = 0;
+            doc["expire_after_seconds"].get_int64().get(seconds) == simdjson::SUCCESS) {
+            expire_after_seconds = seconds;
+        }
+        aevum::db::index::IndexOptions options;
+        (void)doc["sparse"].get_bool().get(options.sparse);
+        if (auto partial_filter = doc["partial_filter"];
+            partial_filter.error() == simdjson::SUCCESS) {
+            if (!partial_filter.is_object()) {
+                return R"({"status":"error", "message":"'partial_filter' must be an object"})";
+            }
+            options.partial_filter = simdjson::to_string(partial_filter);
+        }
+        auto status =
+            db_core_.create_index(collection, field, *type, expire_after_seconds, options);
+        return status.ok() ? R"({"status":"ok"})"
+                           : R"({"status":"error", "message":")" + status.message() + R"("})";
     } else if (action == "metrics") {
         // Metrics endpoint - returns operational metrics for monitoring
         if (role != aevum::db::auth::UserRole::ADMIN) {
-            aevum::util::log::Logger::warn(
-                "Network: Denied 'metrics' action due to insufficient permissions.");
+            AEVUM_LOG_WARN("Network: Denied 'metrics' action due to insufficient permissions.");
             return R"({"status":"error", "message":"Permission denied"})";
         }
 
-        auto uptime = std::time(nullptr) - metrics_.startup_timestamp;
-        std::string metrics_json = R"({"status":"ok","metrics":{)"
-                                   R"("total_requests":)" +
-                                   std::to_string(metrics_.total_requests.load()) +
-                                   ","
-                                   R"("total_errors":)" +
-                                   std::to_string(metrics_.total_errors.load()) +
-                                   ","
-                                   R"("active_connections":)" +
-                                   std::to_string(metrics_.active_connections.load()) +
-                                   ","
-                                   R"("bytes_received":)" +
-                                   std::to_string(metrics_.total_bytes_received.load()) +
-                                   ","
-                                   R"("bytes_sent":)" +
-                                   std::to_string(metrics_.total_bytes_sent.load()) +
-                                   ","
-                                   R"("uptime_seconds":)" +
-                                   std::to_string(uptime) + "}}";
-
-        return metrics_json;
+        return R"({"status":"ok","metrics":)" + metrics_json() + "}";
+    } else if (action == "profile") {
+        // Slow operation log - returns the profiles of recent slow operations, newest first
+        if (role != aevum::db::auth::UserRole::ADMIN) {
+            AEVUM_LOG_WARN("Network: Denied 'profile' action due to insufficient permissions.");
+            return R"({"status":"error", "message":"Permission denied"})";
+        }
+        int64_t threshold_ms = 0;
+        if (doc["slowOpThresholdMs"].get_int64().get(threshold_ms) == simdjson::SUCCESS) {
+            db_core_.slow_operation_log().set_threshold_ms(threshold_ms);
+            AEVUM_LOG_INFO("Network: Slow operation threshold set to " +
+                           std::to_string(threshold_ms) + " ms.");
+        }
+
+        std::string response = R"({"status":"ok","threshold_ms":)" +
+                               std::to_string(db_core_.slow_operation_log().threshold_ms()) +
+                               R"(,"profile":[)";
+        bool first = true;
+        for (const auto &profile : db_core_.profile(collection)) {
+            if (!first) response += ',';
+            first = false;
+            response += profile_entry_json(profile);
+        }
+        response += "]}";
+        return response;
+    } else if (action == "backup") {
+        // Online backup - copies the data directory in the background while writes continue
+        if (role != aevum::db::auth::UserRole::ADMIN) {
+            AEVUM_LOG_WARN("Network: Denied 'backup' action due to insufficient permissions.");
+            return R"({"status":"error", "message":"Permission denied"})";
+        }
+        std::string_view path;
+        if (doc["path"].get_string().get(path) != simdjson::SUCCESS || path.empty()) {
+            return R"({"status":"error", "message":"'path' is required for backup"})";
+        }
+        bool incremental = false;
+        (void)doc["incremental"].get_bool().get(incremental);
+        auto status = db_core_.start_backup(std::string(path), incremental);
+        if (!status.ok()) {
+            return aevum::bson::json::to_string(aevum::bson::Builder()
+                                                    .append_string("status", "error")
+                                                    .append_string("message", status.message())
+                                                    .finalize());
+        }
+        return R"({"status":"ok", "backup":)" + backup_status_json(db_core_.backup_status()) +
+               "}";
+    } else if (action == "backup_status") {
+        if (role != aevum::db::auth::UserRole::ADMIN) {
+            AEVUM_LOG_WARN(
+                "Network: Denied 'backup_status' action due to insufficient permissions.");
+            return R"({"status":"error", "message":"Permission denied"})";
+        }
+        return R"({"status":"ok", "backup":)" + backup_status_json(db_core_.backup_status()) +
+               "}";
     } else if (action == "config") {
         // Configuration endpoint - returns connection pool settings
         if (role != aevum::db::auth::UserRole::ADMIN) {
-            aevum::util::log::Logger::warn(
-                "Network: Denied 'config' action due to insufficient permissions.");
+            AEVUM_LOG_WARN("Network: Denied 'config' action due to insufficient permissions.");
             return R"({"status":"error", "message":"Permission denied"})";
         }
 
@@ -442,13 +2131,18 @@ std::string Server::process_request(std::string_view request) {
                                   std::to_string(conn_config_.max_request_size_bytes / 1048576) +
                                   ","
                                   R"("request_timeout_sec":)" +
-                                  std::to_string(conn_config_.request_timeout_sec) + "}}";
+                                  std::to_string(conn_config_.request_timeout_sec) +
+                                  ","
+                                  R"("result_cache_mb":)" +
+                                  std::to_string(conn_config_.result_cache_mb) +
+                                  ","
+                                  R"("metrics_port":)" +
+                                  std::to_string(conn_config_.metrics_port) + "}}";
 
         return config_json;
     } else if (action == "create_user") {
         if (role != aevum::db::auth::UserRole::ADMIN) {
-            aevum::util::log::Logger::warn(
-                "Network: Denied 'create_user' action due to insufficient permissions.");
+            AEVUM_LOG_WARN("Network: Denied 'create_user' action due to insufficient permissions.");
             return R"({"status":"error", "message":"Permission denied"})";
         }
         std::string_view new_key;
@@ -471,11 +2165,593 @@ std::string Server::process_request(std::string_view request) {
     }
 
     std::string response = R"({"status":"error", "message":"Unknown action"})";
-    aevum::util::log::Logger::warn("Network: Received request with unknown action.");
-
-    // Cache response for deduplication before returning
-    request_cache_.cache_response(request_hash, response);
+    AEVUM_LOG_WARN("Network: Received request with unknown action.");
     return response;
 }
 
+/**
+ * @brief Serves the transaction actions, and the data actions of a connection that has a
+ * transaction open.
+ * @details A transaction is bound to the connection rather than to a storage session: its writes
+ * are staged in `ClientConnection::transaction` and written by `Core::commit` in one storage
+ * transaction, so an open transaction holds no lock and no WiredTiger resource between requests.
+ * A commit that loses a race to a concurrent write is reported with the `write_conflict` code and
+ * `"retryable":true`; the client runs the transaction again from `begin`. A transaction ends with
+ * its `commit`, whatever the outcome, or with `abort`. Clients tag the requests of a transaction
+ * with `"txn":true`, and a tagged request on a connection without one is refused as
+ * `transaction_aborted`, also retryable, rather than applied outside of the transaction.
+ * @param conn The connection.
+ * @param action The action of the request.
+ * @param collection The collection of the request.
+ * @param doc The parsed request.
+ * @param durability The durability level of a `commit`.
+ * @return The response, or `std::nullopt` for an action the transaction does not concern.
+ */
+std::optional<std::string> Server::process_transaction_request(
+    ClientConnection &conn, std::string_view action, std::string_view collection,
+    simdjson::dom::element doc, aevum::db::storage::Durability durability) {
+    if (action == "begin") {
+        if (router_ != nullptr || replicator_ != nullptr) {
+            return R"({"status":"error", "message":"Transactions are only served by a primary"})";
+        }
+        if (conn.transaction) {
+            return R"({"status":"error", "message":"A transaction is already open"})";
+        }
+        conn.transaction = std::make_unique<aevum::db::Transaction>();
+        return R"({"status":"ok"})";
+    }
+    // A request tagged with `txn` belongs to a transaction; without one, the transaction was
+    // dropped with an earlier connection the client has since replaced.
+    if (!conn.transaction) {
+        bool tagged = false;
+        if (doc["txn"].get_bool().get(tagged) == simdjson::SUCCESS && tagged) {
+            return R"({"status":"error", "code":"transaction_aborted", "retryable":true, )"
+                   R"("message":"The transaction ended when its connection closed"})";
+        }
+    }
+    if (action == "commit" || action == "abort") {
+        if (!conn.transaction) {
+            return R"({"status":"error", "message":"No transaction is open"})";
+        }
+        std::unique_ptr<aevum::db::Transaction> txn = std::move(conn.transaction);
+        if (action == "abort") return R"({"status":"ok"})";
+        size_t writes = txn->write_count();
+        auto status = db_core_.commit(*txn, durability);
+        if (status.code() == aevum::util::StatusCode::kConflict) {
+            return R"({"status":"error", "code":"write_conflict", "retryable":true, "message":")" +
+                   status.message() + R"("})";
+        }
+        if (!status.ok()) {
+            return R"({"status":"error", "message":")" + status.message() + R"("})";
+        }
+        return R"({"status":"ok", "committed_count":)" + std::to_string(writes) + "}";
+    }
+    if (!conn.transaction) return std::nullopt;
+    aevum::db::Transaction &txn = *conn.transaction;
+
+    if (action == "insert") {
+        aevum::bson::doc::Document bson_doc;
+        simdjson::dom::element data;
+        if (doc["data"].get(data) != simdjson::SUCCESS ||
+            !aevum::bson::json::from_dom(data, bson_doc).ok()) {
+            return R"({"status":"error", "message":"Invalid BSON data for insert"})";
+        }
+        auto [status, id] = db_core_.insert(txn, collection, std::move(bson_doc));
+        return status.ok() ? inserted_json(id, db_core_.key_format(collection) ==
+                                                   aevum::db::storage::KeyFormat::INT64)
+                           : R"({"status":"error", "message":")" + status.message() + R"("})";
+    } else if (action == "insert_many") {
+        simdjson::dom::array data_array;
+        if (doc["data"].get_array().get(data_array) != simdjson::SUCCESS) {
+            return R"({"status":"error", "message":"'data' must be an array for insert_many"})";
+        }
+        bool integer_id = db_core_.key_format(collection) == aevum::db::storage::KeyFormat::INT64;
+        size_t inserted = 0;
+        std::string entries;
+        for (simdjson::dom::element element : data_array) {
+            if (!entries.empty()) entries += ",";
+            aevum::bson::doc::Document bson_doc;
+            if (!element.is_object() ||
+                !aevum::bson::json::from_dom(element, bson_doc).ok()) {
+                entries += R"({"status":"error", "message":"Invalid BSON data for insert"})";
+                continue;
+            }
+            auto [status, id] = db_core_.insert(txn, collection, std::move(bson_doc));
+            if (status.ok()) {
+                entries += inserted_json(id, integer_id);
+                ++inserted;
+            } else {
+                entries += R"({"status":"error", "message":")" + status.message() + R"("})";
+            }
+        }
+        return R"({"status":"ok", "inserted":)" + std::to_string(inserted) + R"(, "results":[)" +
+               entries + "]}";
+    } else if (action == "find") {
+        int64_t batch_size = 0;
+        if (doc["batchSize"].get_int64().get(batch_size) == simdjson::SUCCESS && batch_size > 0) {
+            return R"({"status":"error", "message":"Cursors are not supported in a transaction"})";
+        }
+        std::string query_json = "{}", sort_json = "{}", projection_json = "{}";
+        int64_t limit_val = 0, skip_val = 0;
+        if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
+        if (doc["sort"].is_object()) sort_json = simdjson::to_string(doc["sort"]);
+        if (doc["projection"].is_object()) projection_json = simdjson::to_string(doc["projection"]);
+        (void)doc["limit"].get_int64().get(limit_val);
+        (void)doc["skip"].get_int64().get(skip_val);
+        // Results read through a transaction are never cached, since no one else sees them.
+        auto docs = db_core_.find(txn, collection, query_json, sort_json, projection_json,
+                                  limit_val, skip_val);
+        std::string response = R"({"status":"ok", "data":)";
+        append_documents_json(docs, response);
+        response += "}";
+        return response;
+    } else if (action == "update") {
+        std::string query_json = "{}", update_json = "{}";
+        if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
+        if (doc["update"].is_object()) update_json = simdjson::to_string(doc["update"]);
+        auto [status, count] = db_core_.update(txn, collection, query_json, update_json);
+        return status.ok()
+                   ? R"({"status":"ok", "updated_count":)" + std::to_string(count) + "}"
+                   : R"({"status":"error", "message":")" + status.message() + R"("})";
+    } else if (action == "delete") {
+        std::string query_json = "{}";
+        if (doc["query"].is_object()) query_json = simdjson::to_string(doc["query"]);
+        auto [status, count] = db_core_.remove(txn, collection, query_json);
+        return status.ok()
+                   ? R"({"status":"ok", "deleted_count":)" + std::to_string(count) + "}"
+                   : R"({"status":"error", "message":")" + status.message() + R"("})";
+    } else if (action == "upsert" || action == "count" || action == "aggregate" ||
+               action == "getMore" || action == "execute") {
+        return R"({"status":"error", "message":"')" + std::string(action) +
+               R"(' is not supported in a transaction"})";
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Answers a cacheable read from the result cache, an identical read in flight, or `run`.
+ * @param key The result cache key of the read.
+ * @param generation The write generation of the collection.
+ * @param run Runs the read.
+ * @return The response.
+ */
+std::string Server::shared_read(std::string_view key, uint64_t generation,
+                                const std::function<std::string(bool &cacheable)> &run) {
+    std::string response;
+    if (result_cache_.get(key, generation, response)) return response;
+    auto shared = read_flights_.run(key, generation, [&] {
+        bool cacheable = true;
+        std::string computed = run(cacheable);
+        if (cacheable) result_cache_.put(key, generation, computed);
+        return computed;
+    });
+    return *shared;
+}
+
+/**
+ * @brief Renders the server's metrics as the JSON object of the `metrics` action.
+ * @details The counters of the server keep their flat keys. The latencies, the plan counts, and
+ * the storage engine's statistics are built as BSON subdocuments, since their keys are
+ * collection names and WiredTiger descriptions that need escaping, and serialized together.
+ * @return The JSON object.
+ */
+std::string Server::metrics_json() {
+    auto uptime = std::time(nullptr) - static_cast<std::time_t>(metrics_.startup_timestamp);
+    auto cache_stats = result_cache_.stats();
+    auto flight_stats = read_flights_.stats();
+    aevum::db::ExecutionStats execution = db_core_.execution_stats();
+
+    aevum::bson::Builder plans;
+    for (size_t i = 0; i < aevum::db::query::PLAN_TYPE_COUNT; ++i) {
+        auto type = static_cast<aevum::db::query::PlanType>(i);
+        plans.append_int64(std::string(aevum::db::query::to_string(type)).c_str(),
+                           static_cast<int64_t>(execution.plans[i]));
+    }
+    aevum::bson::Builder wiredtiger;
+    for (const auto &[description, value] : db_core_.engine_statistics()) {
+        wiredtiger.append_int64(description.c_str(), value);
+    }
+    aevum::bson::Builder index_builds;
+    for (const auto &build : db_core_.index_builds()) {
+        std::string name = build.collection + "." + build.field;
+        index_builds.append_document(
+            name.c_str(),
+            aevum::bson::Builder()
+                .append_string("type", aevum::db::index::to_string(build.type))
+                .append_int64("documents", static_cast<int64_t>(build.documents))
+                .append_int64("scanned", static_cast<int64_t>(build.scanned))
+                .append_int64("concurrent_writes", static_cast<int64_t>(build.concurrent_writes))
+                .finalize());
+    }
+
+    aevum::db::TtlStats ttl_stats = db_core_.ttl_stats();
+
+    auto as_int64 = [](uint64_t value) { return static_cast<int64_t>(value); };
+    aevum::db::MemoryUsage memory_usage = db_core_.memory_usage();
+    aevum::bson::Builder memory_collections;
+    for (const auto &[name, usage] : memory_usage.collections) {
+        memory_collections.append_document(
+            name.c_str(), aevum::bson::Builder()
+                              .append_int64("documents", as_int64(usage.documents))
+                              .append_int64("indexes", as_int64(usage.indexes))
+                              .finalize());
+    }
+    aevum::bson::Builder memory;
+    memory.append_int64("limit", as_int64(memory_usage.budget.limit))
+        .append_int64("used", as_int64(memory_usage.documents + memory_usage.indexes +
+                                       cache_stats.bytes))
+        .append_int64("documents", as_int64(memory_usage.documents))
+        .append_int64("indexes", as_int64(memory_usage.indexes))
+        .append_int64("result_cache", as_int64(cache_stats.bytes))
+        .append_int64("passes", as_int64(memory_usage.budget.passes))
+        .append_int64("over_budget", as_int64(memory_usage.budget.over_budget))
+        .append_int64("reclaimed_bytes", as_int64(memory_usage.budget.reclaimed_bytes))
+        .append_int64("evictions", as_int64(memory_usage.evictions))
+        .append_int64("unloaded_collections", as_int64(memory_usage.unloaded))
+        .append_document("collections", memory_collections.finalize());
+    aevum::bson::Builder ttl;
+    ttl.append_int64("passes", as_int64(ttl_stats.passes))
+        .append_int64("batches", as_int64(ttl_stats.batches))
+        .append_int64("deleted", as_int64(ttl_stats.deleted))
+        .append_int64("failures", as_int64(ttl_stats.failures))
+        .append_int64("last_pass_us", as_int64(ttl_stats.last_pass_us))
+        .append_int64("last_pass_deleted", as_int64(ttl_stats.last_pass_deleted));
+    aevum::db::IndexImageStats image_stats = db_core_.index_image_stats();
+    aevum::bson::Builder index_images;
+    index_images.append_bool("enabled", image_stats.enabled)
+        .append_int64("loaded", as_int64(image_stats.loaded))
+        .append_int64("rejected", as_int64(image_stats.rejected))
+        .append_int64("passes", as_int64(image_stats.passes))
+        .append_int64("written", as_int64(image_stats.written))
+        .append_int64("bytes_written", as_int64(image_stats.bytes_written))
+        .append_int64("failures", as_int64(image_stats.failures))
+        .append_int64("last_pass_us", as_int64(image_stats.last_pass_us));
+    aevum::bson::Builder network;
+    network
+        .append_string("io_backend",
+                       uses_rings_ ? "io_uring" : "epoll")
+        .append_int64("batched_sends", as_int64(send_stats_.batches.load()))
+        .append_int64("batched_responses", as_int64(send_stats_.batched_responses.load()))
+        .append_int64("zero_copy_sends", as_int64(send_stats_.zero_copy_sends.load()))
+        .append_int64("zero_copy_bytes", as_int64(send_stats_.zero_copy_bytes.load()))
+        .append_int64("zero_copy_copied", as_int64(send_stats_.zero_copy_copied.load()))
+        .append_document("compression", compression_summary(compression_stats_));
+    aevum::db::ChangeLogStats log_stats = db_core_.change_log_stats();
+    aevum::bson::Builder change_log;
+    change_log.append_int64("last_sequence", as_int64(log_stats.last_sequence))
+        .append_int64("first_sequence", as_int64(log_stats.first_sequence))
+        .append_int64("retained", as_int64(log_stats.retained))
+        .append_int64("trimmed", as_int64(log_stats.trimmed));
+    aevum::bson::Builder replication;
+    replication.append_string("role", replicator_ != nullptr ? "replica" : "primary");
+    if (replicator_ != nullptr) {
+        ReplicationStats replica = replicator_->stats();
+        replication.append_int64("resume_token", as_int64(replica.resume_token))
+            .append_int64("batches", as_int64(replica.batches))
+            .append_int64("documents_applied", as_int64(replica.documents_applied))
+            .append_int64("documents_deleted", as_int64(replica.documents_deleted))
+            .append_int64("errors", as_int64(replica.errors))
+            .append_int64("staleness_ms", replica.staleness_ms);
+    }
+    aevum::bson::Builder sharding;
+    sharding.append_int64("shards", as_int64(router_ != nullptr ? router_->shard_count() : 0));
+    if (router_ != nullptr) {
+        ShardRouterStats routed = router_->stats();
+        sharding.append_int64("targeted", as_int64(routed.targeted))
+            .append_int64("scattered", as_int64(routed.scattered))
+            .append_int64("shard_requests", as_int64(routed.shard_requests))
+            .append_int64("shard_errors", as_int64(routed.shard_errors));
+    }
+    aevum::bson::Builder admission;
+    for (size_t i = 0; i < REQUEST_CLASS_COUNT; ++i) {
+        auto request_class = static_cast<RequestClass>(i);
+        AdmissionStats lane = admission_.stats(request_class);
+        admission.append_document(
+            std::string(to_string(request_class)).c_str(),
+            aevum::bson::Builder()
+                .append_int64("admitted", as_int64(lane.admitted))
+                .append_int64("waited", as_int64(lane.waited))
+                .append_int64("shed", as_int64(lane.shed))
+                .append_int64("expired", as_int64(lane.expired))
+                .append_int64("running", as_int64(lane.running))
+                .append_int64("queued", as_int64(lane.queued))
+                .finalize());
+    }
+    aevum::bson::doc::Document metrics =
+        aevum::bson::Builder()
+            .append_int64("total_requests", as_int64(metrics_.total_requests.load()))
+            .append_int64("total_errors", as_int64(metrics_.total_errors.load()))
+            .append_int64("active_connections", metrics_.active_connections.load())
+            .append_int64("bytes_received", as_int64(metrics_.total_bytes_received.load()))
+            .append_int64("bytes_sent", as_int64(metrics_.total_bytes_sent.load()))
+            .append_int64("uptime_seconds", static_cast<int64_t>(uptime))
+            .append_int64("result_cache_hits", as_int64(cache_stats.hits))
+            .append_int64("result_cache_misses", as_int64(cache_stats.misses))
+            .append_int64("result_cache_evictions", as_int64(cache_stats.evictions))
+            .append_int64("result_cache_entries", as_int64(cache_stats.entries))
+            .append_int64("result_cache_bytes", as_int64(cache_stats.bytes))
+            .append_int64("coalesced_reads", as_int64(flight_stats.followers))
+            .append_document("action_latency", latency_summaries(metrics_.action_latency))
+            .append_document("collection_latency",
+                             latency_summaries(metrics_.collection_latency))
+            .append_document("query_plans", plans.finalize())
+            .append_int64("ffi_calls", as_int64(execution.ffi_calls))
+            .append_int64("ffi_time_us", as_int64(execution.ffi_us))
+            .append_int64("storage_operations", as_int64(execution.storage.operations))
+            .append_int64("storage_time_us", as_int64(execution.storage.busy_us))
+            .append_int64("durability_waits", as_int64(execution.storage.durability_waits))
+            .append_int64("durability_wait_us", as_int64(execution.storage.durability_wait_us))
+            .append_document("index_builds", index_builds.finalize())
+            .append_document("memory", memory.finalize())
+            .append_document("ttl", ttl.finalize())
+            .append_document("index_images", index_images.finalize())
+            .append_document("network", network.finalize())
+            .append_document("change_log", change_log.finalize())
+            .append_document("replication", replication.finalize())
+            .append_document("sharding", sharding.finalize())
+            .append_document("admission", admission.finalize())
+            .append_document("wiredtiger", wiredtiger.finalize())
+            .finalize();
+    return aevum::bson::json::to_string(metrics);
+}
+
+/**
+ * @brief Renders the server's metrics in the Prometheus text format.
+ * @details Counters are exposed in their base units: bytes, and seconds for durations. The
+ * WiredTiger statistics are exposed as gauges, since some of them, such as the bytes in the
+ * cache, go down as well as up; their names are derived from WiredTiger's descriptions.
+ * @return The text exposition.
+ */
+std::string Server::metrics_prometheus() {
+    using aevum::util::metrics::PrometheusText;
+    auto cache_stats = result_cache_.stats();
+    auto flight_stats = read_flights_.stats();
+    aevum::db::ExecutionStats execution = db_core_.execution_stats();
+    auto as_int64 = [](uint64_t value) { return static_cast<int64_t>(value); };
+    auto as_seconds = [](uint64_t micros) { return static_cast<double>(micros) / 1e6; };
+
+    PrometheusText out;
+    auto counter = [&](std::string_view name, std::string_view help, int64_t value) {
+        out.family(name, "counter", help);
+        out.sample(name, {}, value);
+    };
+    auto seconds = [&](std::string_view name, std::string_view help, uint64_t micros) {
+        out.family(name, "counter", help);
+        out.sample(name, {}, as_seconds(micros));
+    };
+
+    counter("aevum_requests_total", "Requests received.",
+            as_int64(metrics_.total_requests.load()));
+    counter("aevum_errors_total", "Requests and sends that failed.",
+            as_int64(metrics_.total_errors.load()));
+    counter("aevum_received_bytes_total", "Bytes received from clients.",
+            as_int64(metrics_.total_bytes_received.load()));
+    counter("aevum_sent_bytes_total", "Bytes sent to clients.",
+            as_int64(metrics_.total_bytes_sent.load()));
+    out.family("aevum_active_connections", "gauge", "Open client connections.");
+    out.sample("aevum_active_connections", {},
+               static_cast<int64_t>(metrics_.active_connections.load()));
+    out.family("aevum_start_time_seconds", "gauge", "Start time of the server since the epoch.");
+    out.sample("aevum_start_time_seconds", {}, as_int64(metrics_.startup_timestamp));
+
+    counter("aevum_result_cache_hits_total", "Result cache lookups that returned a result.",
+            as_int64(cache_stats.hits));
+    counter("aevum_result_cache_misses_total", "Result cache lookups that found no fresh result.",
+            as_int64(cache_stats.misses));
+    counter("aevum_result_cache_evictions_total", "Result cache entries evicted for space.",
+            as_int64(cache_stats.evictions));
+    out.family("aevum_result_cache_entries", "gauge", "Entries held by the result cache.");
+    out.sample("aevum_result_cache_entries", {}, as_int64(cache_stats.entries));
+    out.family("aevum_result_cache_bytes", "gauge", "Bytes held by the result cache.");
+    out.sample("aevum_result_cache_bytes", {}, as_int64(cache_stats.bytes));
+    counter("aevum_coalesced_reads_total",
+            "Reads answered by an identical read in flight instead of running.",
+            as_int64(flight_stats.followers));
+
+    // One family per counter, each labelled by request class.
+    std::array<AdmissionStats, REQUEST_CLASS_COUNT> lanes;
+    for (size_t i = 0; i < REQUEST_CLASS_COUNT; ++i) {
+        lanes[i] = admission_.stats(static_cast<RequestClass>(i));
+    }
+    auto per_class = [&](std::string_view name, std::string_view type, std::string_view help,
+                         uint64_t AdmissionStats::*field) {
+        out.family(name, type, help);
+        for (size_t i = 0; i < REQUEST_CLASS_COUNT; ++i) {
+            out.sample(name, {{"class", to_string(static_cast<RequestClass>(i))}},
+                       as_int64(lanes[i].*field));
+        }
+    };
+    per_class("aevum_admitted_requests_total", "counter", "Requests admitted to run.",
+              &AdmissionStats::admitted);
+    per_class("aevum_shed_requests_total", "counter",
+              "Requests refused as server busy because their class's queue was full.",
+              &AdmissionStats::shed);
+    per_class("aevum_expired_requests_total", "counter",
+              "Requests dropped because their deadline passed while they waited.",
+              &AdmissionStats::expired);
+    per_class("aevum_queued_requests", "gauge", "Requests waiting for a slot of their class.",
+              &AdmissionStats::queued);
+
+    out.family("aevum_request_duration_seconds", "histogram",
+               "Latency of authenticated requests by action.");
+    metrics_.action_latency.for_each([&](std::string_view name, const auto &snapshot) {
+        out.histogram("aevum_request_duration_seconds", "action", name, snapshot);
+    });
+    out.family("aevum_collection_request_duration_seconds", "histogram",
+               "Latency of authenticated requests by collection.");
+    metrics_.collection_latency.for_each([&](std::string_view name, const auto &snapshot) {
+        out.histogram("aevum_collection_request_duration_seconds", "collection", name, snapshot);
+    });
+
+    out.family("aevum_query_plans_total", "counter", "Queries planned, by plan type.");
+    for (size_t i = 0; i < aevum::db::query::PLAN_TYPE_COUNT; ++i) {
+        auto type = static_cast<aevum::db::query::PlanType>(i);
+        out.sample("aevum_query_plans_total", {{"plan", aevum::db::query::to_string(type)}},
+                   as_int64(execution.plans[i]));
+    }
+    counter("aevum_ffi_calls_total", "Calls into the Rust query FFI.",
+            as_int64(execution.ffi_calls));
+    seconds("aevum_ffi_seconds_total", "Time spent in the Rust query FFI.", execution.ffi_us);
+    counter("aevum_storage_operations_total", "Storage operations that held a session.",
+            as_int64(execution.storage.operations));
+    seconds("aevum_storage_seconds_total", "Time spent in storage sessions.",
+            execution.storage.busy_us);
+    counter("aevum_durability_waits_total", "Writes that waited for a journal flush.",
+            as_int64(execution.storage.durability_waits));
+    seconds("aevum_durability_wait_seconds_total", "Time spent waiting for journal flushes.",
+            execution.storage.durability_wait_us);
+
+    std::vector<aevum::db::index::IndexBuildProgress> builds = db_core_.index_builds();
+    out.family("aevum_index_build_documents", "gauge",
+               "Documents to scan by index builds in flight.");
+    for (const auto &build : builds) {
+        out.sample("aevum_index_build_documents",
+                   {{"collection", build.collection}, {"field", build.field}},
+                   static_cast<int64_t>(build.documents));
+    }
+    out.family("aevum_index_build_scanned_documents", "gauge",
+               "Documents scanned by index builds in flight.");
+    for (const auto &build : builds) {
+        out.sample("aevum_index_build_scanned_documents",
+                   {{"collection", build.collection}, {"field", build.field}},
+                   static_cast<int64_t>(build.scanned));
+    }
+
+    aevum::db::MemoryUsage memory = db_core_.memory_usage();
+    out.family("aevum_memory_limit_bytes", "gauge",
+               "Memory budget of the documents, indexes, and result cache, or 0 for none.");
+    out.sample("aevum_memory_limit_bytes", {}, as_int64(memory.budget.limit));
+    out.family("aevum_memory_bytes", "gauge", "Estimated memory held, by layer.");
+    out.sample("aevum_memory_bytes", {{"layer", "documents"}}, as_int64(memory.documents));
+    out.sample("aevum_memory_bytes", {{"layer", "indexes"}}, as_int64(memory.indexes));
+    out.sample("aevum_memory_bytes", {{"layer", "result_cache"}}, as_int64(cache_stats.bytes));
+    out.family("aevum_collection_memory_bytes", "gauge",
+               "Estimated memory held by resident collections, by layer.");
+    for (const auto &[name, usage] : memory.collections) {
+        out.sample("aevum_collection_memory_bytes", {{"collection", name}, {"layer", "documents"}},
+                   as_int64(usage.documents));
+        out.sample("aevum_collection_memory_bytes", {{"collection", name}, {"layer", "indexes"}},
+                   as_int64(usage.indexes));
+    }
+    counter("aevum_memory_reclaimed_bytes_total", "Bytes freed to stay within the memory budget.",
+            as_int64(memory.budget.reclaimed_bytes));
+    counter("aevum_memory_evictions_total",
+            "Collections evicted from memory to stay within the memory budget.",
+            as_int64(memory.evictions));
+    out.family("aevum_unloaded_collections", "gauge",
+               "User collections served from storage until they are loaded.");
+    out.sample("aevum_unloaded_collections", {}, as_int64(memory.unloaded));
+
+    aevum::db::TtlStats ttl = db_core_.ttl_stats();
+    counter("aevum_ttl_passes_total", "Passes of the TTL sweeper.", as_int64(ttl.passes));
+    counter("aevum_ttl_batches_total", "Delete batches committed by the TTL sweeper.",
+            as_int64(ttl.batches));
+    counter("aevum_ttl_deleted_documents_total", "Documents deleted by the TTL sweeper.",
+            as_int64(ttl.deleted));
+    counter("aevum_ttl_failures_total", "Delete batches of the TTL sweeper that failed.",
+            as_int64(ttl.failures));
+    out.family("aevum_ttl_last_pass_seconds", "gauge", "Duration of the last TTL sweeper pass.");
+    out.sample("aevum_ttl_last_pass_seconds", {}, as_seconds(ttl.last_pass_us));
+
+    aevum::db::IndexImageStats images = db_core_.index_image_stats();
+    counter("aevum_index_images_loaded_total", "Collections loaded from their index image.",
+            as_int64(images.loaded));
+    counter("aevum_index_images_rejected_total",
+            "Index images discarded as invalid or outdated.", as_int64(images.rejected));
+    counter("aevum_index_images_written_total", "Index images written by the image writer.",
+            as_int64(images.written));
+    counter("aevum_index_images_written_bytes_total",
+            "Bytes of the index images written by the image writer.",
+            as_int64(images.bytes_written));
+    counter("aevum_index_images_failures_total", "Index images that could not be written.",
+            as_int64(images.failures));
+
+    counter("aevum_batched_sends_total", "Sends that carried the responses of several requests.",
+            as_int64(send_stats_.batches.load()));
+    counter("aevum_batched_responses_total", "Responses sent together with others.",
+            as_int64(send_stats_.batched_responses.load()));
+    counter("aevum_zero_copy_sends_total", "Responses sent with MSG_ZEROCOPY.",
+            as_int64(send_stats_.zero_copy_sends.load()));
+    counter("aevum_zero_copy_sent_bytes_total", "Bytes sent with MSG_ZEROCOPY.",
+            as_int64(send_stats_.zero_copy_bytes.load()));
+    counter("aevum_zero_copy_copied_total",
+            "Zero-copy sends the kernel copied, which disable zero copy for their connection.",
+            as_int64(send_stats_.zero_copy_copied.load()));
+    counter("aevum_wire_compression_connections_total",
+            "Connections that negotiated lz4 or zstd compression.",
+            as_int64(compression_stats_.connections.load()));
+    counter("aevum_wire_compressed_frames_total", "Responses sent compressed.",
+            as_int64(compression_stats_.frames_compressed.load()));
+    counter("aevum_wire_incompressible_frames_total",
+            "Responses above the compression threshold sent as they were, since they did not "
+            "shrink.",
+            as_int64(compression_stats_.frames_incompressible.load()));
+    counter("aevum_wire_compression_input_bytes_total", "Bytes of responses before compression.",
+            as_int64(compression_stats_.bytes_before_compression.load()));
+    counter("aevum_wire_compression_output_bytes_total", "Bytes of responses after compression.",
+            as_int64(compression_stats_.bytes_after_compression.load()));
+    seconds("aevum_wire_compression_cpu_seconds_total", "CPU time spent compressing responses.",
+            compression_stats_.compress_cpu_ns.load() / 1000);
+    counter("aevum_wire_decompressed_frames_total", "Compressed requests received.",
+            as_int64(compression_stats_.frames_decompressed.load()));
+    counter("aevum_wire_decompression_input_bytes_total",
+            "Bytes of compressed requests as received.",
+            as_int64(compression_stats_.bytes_before_decompression.load()));
+    counter("aevum_wire_decompression_output_bytes_total",
+            "Bytes of compressed requests after decompression.",
+            as_int64(compression_stats_.bytes_after_decompression.load()));
+    seconds("aevum_wire_decompression_cpu_seconds_total",
+            "CPU time spent decompressing requests.",
+            compression_stats_.decompress_cpu_ns.load() / 1000);
+
+    aevum::db::ChangeLogStats change_log = db_core_.change_log_stats();
+    out.family("aevum_change_log_last_sequence", "gauge",
+               "Sequence number of the newest visible change record.");
+    out.sample("aevum_change_log_last_sequence", {}, as_int64(change_log.last_sequence));
+    out.family("aevum_change_log_retained_records", "gauge", "Change records retained.");
+    out.sample("aevum_change_log_retained_records", {}, as_int64(change_log.retained));
+    counter("aevum_change_log_trimmed_records_total",
+            "Change records removed to keep the log within its capacity.",
+            as_int64(change_log.trimmed));
+
+    if (replicator_ != nullptr) {
+        ReplicationStats replica = replicator_->stats();
+        out.family("aevum_replication_resume_token", "gauge",
+                   "Sequence number of the primary's change log applied up to.");
+        out.sample("aevum_replication_resume_token", {}, as_int64(replica.resume_token));
+        counter("aevum_replication_batches_total", "Change log batches applied from the primary.",
+                as_int64(replica.batches));
+        counter("aevum_replication_documents_applied_total",
+                "Documents stored from the primary.", as_int64(replica.documents_applied));
+        counter("aevum_replication_documents_deleted_total",
+                "Documents removed after the primary.", as_int64(replica.documents_deleted));
+        counter("aevum_replication_errors_total",
+                "Replication batches that failed and were retried.", as_int64(replica.errors));
+        out.family("aevum_replication_staleness_seconds", "gauge",
+                   "Time since the replica last held every change of the primary; -1 if never.");
+        out.sample("aevum_replication_staleness_seconds", {},
+                   replica.staleness_ms < 0 ? -1.0 : replica.staleness_ms / 1000.0);
+    }
+
+    if (router_ != nullptr) {
+        ShardRouterStats routed = router_->stats();
+        counter("aevum_sharding_targeted_requests_total",
+                "Requests routed to some of the shards only.", as_int64(routed.targeted));
+        counter("aevum_sharding_scattered_requests_total", "Requests scattered to every shard.",
+                as_int64(routed.scattered));
+        counter("aevum_sharding_shard_requests_total", "Requests sent to shards.",
+                as_int64(routed.shard_requests));
+        counter("aevum_sharding_shard_errors_total",
+                "Shard requests that failed or were answered with an error.",
+                as_int64(routed.shard_errors));
+    }
+
+    for (const auto &[description, value] : db_core_.engine_statistics()) {
+        std::string name = PrometheusText::metric_name("aevum_wiredtiger_", description);
+        out.family(name, "gauge", "WiredTiger statistic '" + description + "'.");
+        out.sample(name, {}, value);
+    }
+    return out.text();
+}
+
 }  // namespace aevum::net::server
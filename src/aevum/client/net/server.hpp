@@ -4,36 +4,114 @@
 
 /**
  * @file server.hpp
- * @brief Declares the `Server` class, a multi-threaded TCP network server for AevumDB.
+ * @brief Declares the `Server` class, an event-driven TCP network server for AevumDB.
  * @details This header defines the main server component responsible for accepting and handling
  * client connections. The `Server` class encapsulates the logic for socket binding, listening,
- * and dispatching incoming connections to a pool of worker threads for concurrent processing.
+ * multiplexing connections over `epoll` or `io_uring` event loops, and dispatching their requests
+ * to a pool of worker threads for concurrent processing.
  */
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "aevum/client/net/admission_control.hpp"
+#include "aevum/client/net/framing.hpp"
+#include "aevum/client/net/metrics_endpoint.hpp"
+#include "aevum/client/net/replicator.hpp"
+#include "aevum/client/net/shard_router.hpp"
+#include "aevum/client/net/socket_writer.hpp"
+#include "aevum/client/net/wire_compression.hpp"
 #include "aevum/db/core/core.hpp"
-#include "aevum/util/deduplication/request_cache.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
+#include "aevum/util/cache/result_cache.hpp"
+#include "aevum/util/cache/single_flight.hpp"
+#include "aevum/util/memory/object_pool.hpp"
+#include "aevum/util/metrics/latency_histogram.hpp"
+#include "simdjson.h"
 
 namespace aevum::net::server {
 
+/**
+ * @enum IoBackend
+ * @brief How the event loops wait for and receive the requests of their connections.
+ */
+enum class IoBackend : uint8_t {
+    /// Readiness notifications from `epoll`, followed by `recv` calls.
+    EPOLL = 0,
+    /// Receives submitted to an `io_uring` and completed by the kernel; `epoll` is used instead
+    /// if the kernel does not support it.
+    IO_URING = 1,
+};
+
+/**
+ * @struct ConnectionPoolConfig
+ * @brief Connection limits and threading of the `Server`.
+ * @details Manages connection pooling limits, idle timeouts, and per-IP rate limiting. The
+ * defaults are used unless the daemon's configuration file overrides them.
+ */
+struct ConnectionPoolConfig {
+    int max_connections_total{1000};      ///< Total concurrent connections allowed
+    int max_connections_per_ip{100};      ///< Max connections from a single IP
+    int max_idle_timeout_sec{300};        ///< Connection idle timeout in seconds
+    int max_request_size_bytes{8388608};  ///< Max request size (8MB)
+    int request_timeout_sec{30};  ///< Send timeout, and the longest a request may wait to run
+    int io_threads{0};      ///< Event loop threads; 0 for a quarter of the hardware threads
+    int worker_threads{0};  ///< Request worker threads; 0 for one per hardware thread
+    bool pin_worker_threads{false};  ///< Pin each request worker to its own CPU
+    int max_point_requests{0};  ///< Point operations run at once; 0 for one per worker
+    int max_scan_requests{0};   ///< Scans run at once; 0 for half the workers
+    int max_admin_requests{0};  ///< Administrative requests run at once; 0 for two
+    int max_queued_requests{0};  ///< Requests per class waiting to run; 0 for a quarter of workers
+    int result_cache_mb{64};  ///< Memory for cached find and count results; 0 disables the cache
+    int metrics_port{0};  ///< Port serving Prometheus metrics at `GET /metrics`; 0 disables it
+    IoBackend io_backend{IoBackend::EPOLL};  ///< How event loops receive requests
+    int zero_copy_threshold_kb{256};  ///< Sends from this size use `MSG_ZEROCOPY`; 0 disables it
+    bool wire_compression{true};  ///< Grant the lz4 or zstd compression a client asks for
+    int wire_compression_min_bytes{1024};  ///< Responses from this size are sent compressed
+    int wire_compression_level{3};         ///< zstd level of compressed responses
+    std::string wire_compression_dictionary;  ///< zstd dictionary file offered to clients, or empty
+};
+
 /**
  * @class Server
  * @brief Manages the full lifecycle of the AevumDB network server, handling client connections
  * and dispatching requests to the core database engine.
  *
- * @details This class implements a robust, multi-threaded TCP server. Upon calling `run()`, it
- * establishes a listening socket on a specified port. It then enters a loop, accepting new client
- * connections and spawning a dedicated `std::thread` for each one. This architecture allows for
- * concurrent handling of multiple clients.
+ * @details This class implements a reactor-style TCP server. Upon calling `run()`, it establishes
+ * a listening socket on a specified port and starts a small, fixed number of I/O threads, each
+ * running an event loop over its share of the connections, together with a
+ * `util::concurrency::ThreadPool` of request workers. The calling thread accepts connections,
+ * enforces the limits of `ConnectionPoolConfig`, and assigns each connection to an event loop in
+ * turn. When a connection becomes readable, its event loop receives the data into the
+ * connection's `FrameDecoder` and, once a request is complete, hands the connection to a worker,
+ * which answers every buffered request in order and re-arms the connection. Requests are
+ * length-prefixed frames (see `framing.hpp`), or bare JSON objects for older clients, so they may
+ * span any number of segments and may be pipelined. A framed connection may switch to binary
+ * BSON bodies with a "hello" request (see `bson_wire.hpp`). Connections are
+ * registered with `EPOLLONESHOT`, so each one has at most one request in flight and responses
+ * are sent in request order. The number of threads is therefore independent of the number of
+ * connections.
  *
- * The server ensures graceful shutdown via the `stop()` method, which closes all active sockets and
- * joins all worker threads. Thread-safe management of client connections is handled using a
- * `std::mutex`.
+ * With `IoBackend::IO_URING`, an event loop submits a receive into the decoder of each idle
+ * connection to its `IoRing` instead, and reaps the completions of all of them with one system
+ * call; as with `EPOLLONESHOT`, a connection has no receive pending while a worker serves it.
+ * The responses to the requests a worker finds buffered together are sent together by its
+ * `SocketWriter`, and large ones with `MSG_ZEROCOPY`. A client may also negotiate lz4 or zstd
+ * compression in its "hello" request (see `wire_compression.hpp`); its large frames are then
+ * compressed in both directions by a `WireCodec` of the connection.
+ *
+ * The server ensures graceful shutdown via the `stop()` method, which stops accepting, joins the
+ * event loops, drains the worker pool, and closes all remaining connections.
  */
 class Server {
   public:
@@ -42,8 +120,16 @@ class Server {
      * @param db_core A reference to the active `aevum::db::Core` engine, which will be used to
      *        process all authenticated client requests.
      * @param port The TCP port number on which the server will listen for incoming connections.
+     * @param config The connection limits and thread counts.
+     * @param replicator The replicator if this server is a read replica, or `nullptr`. A replica
+     *        rejects document writes and honors the `maxStalenessMs` of reads. It must outlive
+     *        the server.
+     * @param router The shard router if this server is a router, or `nullptr`. A router answers
+     *        data requests from its shards and keeps users and metrics for itself. It must
+     *        outlive the server.
      */
-    Server(db::Core &db_core, int port);
+    Server(db::Core &db_core, int port, ConnectionPoolConfig config = {},
+           const Replicator *replicator = nullptr, ShardRouter *router = nullptr);
 
     /**
      * @brief Destroys the `Server` object, ensuring a graceful shutdown if it is still running.
@@ -59,9 +145,10 @@ class Server {
 
     /**
      * @brief Starts the server's main execution loop.
-     * @details This method initializes and binds the listening socket, then enters a blocking
-     * loop to `accept()` new client connections. Each accepted connection is immediately
-     * dispatched to a new worker thread running `handle_client`.
+     * @details This method initializes and binds the listening socket, starts the event loops and
+     * the worker pool, then enters a blocking loop to `accept()` new client connections. Each
+     * accepted connection that is within the configured limits is registered with one of the
+     * event loops.
      * @throws `std::runtime_error` if socket creation, option setting, binding, or listening fails.
      */
     void run();
@@ -69,22 +156,156 @@ class Server {
     /**
      * @brief Initiates a graceful shutdown of the server.
      * @details This method is thread-safe. It sets an atomic flag to terminate the `run()` loop,
-     * forcefully shuts down the main listening socket to unblock the `accept()` call, closes all
-     * active client sockets, and waits for all worker threads to complete execution by joining
-     * them.
+     * forcefully shuts down the main listening socket to unblock the `accept()` call, wakes and
+     * joins the event loops, waits for the requests in progress to complete, and closes all
+     * client sockets.
      */
     void stop();
 
   private:
     /**
-     * @brief The dedicated function for handling all communication with a single connected client.
-     * @details This method runs in a separate thread for each client. It enters a loop, blocking on
-     * `recv()` to wait for requests. Upon receiving data, it dispatches it to `process_request` and
-     * sends the returned response back to the client. The loop terminates if the client disconnects
-     * or sends an "exit" command.
-     * @param client_socket The file descriptor for the connected client's socket.
+     * @struct ClientConnection
+     * @brief The state of one accepted client connection.
      */
-    void handle_client(int client_socket);
+    struct ClientConnection;
+
+    /**
+     * @struct EventLoop
+     * @brief An `epoll` instance or an `io_uring`, the thread that waits on it, and the
+     * connections it watches.
+     */
+    struct EventLoop;
+
+    /**
+     * @brief The body of an I/O thread.
+     * @details Waits for readiness events or completed receives of its connections, reads each
+     * request and dispatches it, and once per second closes the connections idle for longer than
+     * `max_idle_timeout_sec`.
+     * @param loop The event loop the thread runs.
+     */
+    void run_event_loop(EventLoop &loop);
+
+    /**
+     * @brief Receives data from a readable connection and dispatches its requests.
+     * @details Runs on the connection's I/O thread. Once at least one complete request is
+     * buffered, `serve_requests` is scheduled on the worker pool. A closed or failed connection is
+     * released; a partial request or a spurious wake-up re-arms the connection.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     */
+    void read_request(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Handles the completion of a receive submitted to an event loop's ring.
+     * @details Runs on the connection's I/O thread. The received bytes are committed to the
+     * decoder; a partial request submits the next receive, and a complete one is dispatched as
+     * by `read_request`. A closed or failed connection is released.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     * @param result The result of the receive: a byte count, or a negated `errno`.
+     */
+    void complete_receive(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn,
+                          int result);
+
+    /**
+     * @brief Submits a receive into a connection's decoder to its event loop's ring.
+     * @details The connection is kept alive by the loop until the receive completes, since the
+     * kernel writes into its buffer.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     * @return `true` if the receive was submitted.
+     */
+    bool submit_receive(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Marks a connection busy and schedules `serve_requests` on the worker pool.
+     * @param loop The event loop of the connection.
+     * @param conn The connection, with at least one complete request buffered.
+     */
+    void dispatch_requests(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Processes the buffered requests of a connection in order and sends the responses.
+     * @details This replaces the former per-connection thread body. The connection is released
+     * after an "exit" command, an oversized request, or a failed send, and re-armed otherwise.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     */
+    void serve_requests(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Queues a response, framed if the client frames its requests.
+     * @details The queue is flushed once it holds `RESPONSE_BATCH_BYTES`, and otherwise by
+     * `flush_responses` once the buffered requests have been served.
+     * @param conn The connection.
+     * @param response The response payload.
+     * @return `false` if a flush failed.
+     */
+    bool send_response(ClientConnection &conn, std::string response);
+
+    /**
+     * @brief Answers a "hello" request, which negotiates the protocol and the compression.
+     * @details The response is queued before the codec is configured, so that the client can
+     * read it whatever it asked for.
+     * @param conn The connection.
+     * @param request The "hello" request.
+     * @return `false` if a flush failed.
+     */
+    bool serve_hello(ClientConnection &conn, std::string_view request);
+
+    /**
+     * @brief Sends the responses queued on a connection.
+     * @param conn The connection.
+     * @return `true` if every response was sent completely.
+     */
+    bool flush_responses(ClientConnection &conn);
+
+    /**
+     * @brief Answers a request received on a connection that speaks the BSON protocol.
+     * @details `find` is served natively and its result set is written with `sendmsg` straight
+     * from the documents' buffers. Every other action is transcoded to JSON, handed to
+     * `process_request`, and its response converted back to BSON.
+     * @param conn The connection.
+     * @param request The BSON request document.
+     * @return `false` if the connection must be closed, after "exit" or a failed send.
+     */
+    bool serve_bson_request(ClientConnection &conn, std::string_view request);
+
+    /**
+     * @brief Converts a JSON response to BSON and sends it as one frame.
+     * @param conn The connection.
+     * @param response The JSON response.
+     * @return `true` if the response was sent completely.
+     */
+    bool send_bson_response(ClientConnection &conn, std::string_view response);
+
+    /**
+     * @brief Re-enables read notifications for a connection once its request has been served.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     * @return `true` on success; on failure the connection is released.
+     */
+    bool rearm(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Checks the connection limits for a new client and counts it if they allow it.
+     * @param peer_ip The address of the client.
+     * @return `true` if the connection is admitted.
+     */
+    bool admit_connection(const std::string &peer_ip);
+
+    /**
+     * @brief Closes a connection, forgets it, and releases its share of the connection limits.
+     * @param loop The event loop of the connection.
+     * @param conn The connection.
+     */
+    void release_connection(EventLoop &loop, const std::shared_ptr<ClientConnection> &conn);
+
+    /**
+     * @brief Closes the connections of an event loop that have been idle for too long.
+     * @param loop The event loop.
+     */
+    void close_idle_connections(EventLoop &loop);
 
     /**
      * @brief The central request processing and dispatching logic.
@@ -92,22 +313,97 @@ class Server {
      * `simdjson` for high performance, authenticates the request using the `db_core_`, checks
      * permissions, and then calls the appropriate `db_core_` method (e.g., `insert`, `find`).
      * Finally, it serializes the result of the database operation into a JSON response string.
+     * The parser is borrowed from `json_parsers_`, and documents carried by the request are
+     * converted to BSON straight from its DOM (see `aevum::bson::json::from_dom`).
+     * @param conn The connection the request was received on, which holds its transaction.
      * @param request The raw JSON request data received from the client.
      * @return A `std::string` containing the JSON-formatted response to be sent to the client.
      */
-    std::string process_request(std::string_view request);
+    std::string process_request(ClientConnection &conn, std::string_view request);
+
+    /**
+     * @brief Serves `login`: verifies the request's API key once and opens a session on the
+     * connection.
+     * @details The key is checked with the key derivation function (see `Core::login`). On
+     * success, a random token is bound to the connection with the user's role, and the
+     * connection's later requests that carry it as `session` are authorized from the connection
+     * alone. A new login replaces the connection's session.
+     * @param conn The connection.
+     * @param auth_key The API key of the request.
+     * @return The response, holding the token and the role.
+     */
+    std::string open_session(ClientConnection &conn, std::string_view auth_key);
+
+    /**
+     * @brief Authorizes a request by its session token or, without one, by its API key.
+     * @details A session token is compared with the connection's own in constant time, with no
+     * hashing and no lock; a token opened on another connection is refused.
+     * @param conn The connection the request was received on.
+     * @param auth_key The `auth` field of the request, or empty.
+     * @param session The `session` field of the request, or empty.
+     * @param owner Receives the API key that owns the cursors and prepared queries of the
+     *        request.
+     * @return The role of the request, or `UserRole::NONE` if it is not authorized.
+     */
+    aevum::db::auth::UserRole authorize(const ClientConnection &conn, std::string_view auth_key,
+                                        std::string_view session, std::string_view &owner);
+
+    /**
+     * @brief Serves the transaction actions, and the data actions of a connection that has a
+     * transaction open.
+     * @details `begin` opens a transaction on the connection, `abort` drops it, and `commit`
+     * applies it through `Core::commit`, reporting a conflict as a retryable `write_conflict`
+     * error. While a transaction is open, `insert`, `insert_many`, `find`, `update`, and
+     * `delete` are staged in or read through it, and the data actions it cannot serve are
+     * refused. A request tagged `"txn":true` on a connection without a transaction is refused as
+     * `transaction_aborted`.
+     * @param conn The connection.
+     * @param action The action of the request.
+     * @param collection The collection of the request.
+     * @param doc The parsed request.
+     * @param durability The durability level of a `commit`.
+     * @return The response, or `std::nullopt` if the request is served as usual.
+     */
+    std::optional<std::string> process_transaction_request(
+        ClientConnection &conn, std::string_view action, std::string_view collection,
+        simdjson::dom::element doc, aevum::db::storage::Durability durability);
+
+    /**
+     * @brief Answers a cacheable read from the result cache, from an identical read in flight,
+     * or by running it.
+     * @details Reads that miss the cache are coalesced by `read_flights_`: while one runs, the
+     * requests with the same key and write generation wait for it and receive its response, so a
+     * burst of identical reads arriving as their cached result goes stale runs the query once.
+     * The first reader caches the response before the others are released, if `run` allows it.
+     * Coalescing applies whether or not the cache is enabled.
+     * @param key The result cache key of the read (see `result_cache_key`).
+     * @param generation The write generation of the collection, read before the lookup.
+     * @param run Runs the read and returns its response; it sets its argument to `false` if the
+     *        response must not be cached, such as an error.
+     * @return The response.
+     */
+    std::string shared_read(std::string_view key, uint64_t generation,
+                            const std::function<std::string(bool &cacheable)> &run);
 
     /**
-     * @brief Configuration structure for connection pool settings.
-     * @details Manages connection pooling limits, idle timeouts, and per-IP rate limiting.
+     * @brief Renders the server's metrics as the JSON object of the `metrics` action.
+     * @details Holds the request, error, byte, and connection counters, the result cache's
+     * counters, the latency percentiles of each action and collection, the plans chosen by the
+     * query planner, the time spent in the Rust FFI and in the storage engine, and a selection
+     * of WiredTiger's statistics.
+     * @return The JSON object.
      */
-    struct ConnectionPoolConfig {
-        int max_connections_total{1000};      ///< Total concurrent connections allowed
-        int max_connections_per_ip{100};      ///< Max connections from a single IP
-        int max_idle_timeout_sec{300};        ///< Connection idle timeout in seconds
-        int max_request_size_bytes{8388608};  ///< Max request size (8MB)
-        int request_timeout_sec{30};          ///< Request processing timeout
-    } conn_config_;
+    std::string metrics_json();
+
+    /**
+     * @brief Renders the same metrics as `metrics_json` in the Prometheus text format.
+     * @details Latencies are exposed as histograms, in seconds, labelled by action or collection.
+     * @return The text exposition served by `metrics_endpoint_`.
+     */
+    std::string metrics_prometheus();
+
+    /// Connection pool settings: limits, idle timeouts, and per-IP rate limiting.
+    ConnectionPoolConfig conn_config_;
 
     /**
      * @brief Metrics collection structure for monitoring and observability.
@@ -120,26 +416,59 @@ class Server {
         std::atomic<uint64_t> total_bytes_sent{0};
         std::atomic<int> active_connections{0};
         uint64_t startup_timestamp{0};
+        /// The latency of authenticated requests, by action.
+        aevum::util::metrics::HistogramFamily action_latency{64};
+        /// The latency of authenticated requests that name a collection, by collection.
+        aevum::util::metrics::HistogramFamily collection_latency{256};
     } metrics_;
 
     /// A reference to the central database engine instance.
     db::Core &db_core_;
+    /// The replicator of a read replica, or `nullptr` on a primary.
+    const Replicator *replicator_;
+    /// The shard router of a router, or `nullptr` on a server holding its own data.
+    ShardRouter *router_;
     /// The TCP port number on which the server listens.
     int port_;
     /// The file descriptor for the main server listening socket.
     int server_socket_fd_{-1};
-    /// An atomic flag used to signal the server's main loop and worker threads to terminate.
+    /// An atomic flag used to signal the server's main loop and I/O threads to terminate.
     std::atomic<bool> is_running_{false};
 
-    /// A vector to manage the `std::thread` objects for all active client connections.
-    std::vector<std::thread> worker_threads_;
-    /// A vector to store the file descriptors of all active client sockets, for cleanup during
-    /// shutdown.
-    std::vector<int> client_sockets_;
-    /// A mutex to provide thread-safe access to the `client_sockets_` vector.
-    std::mutex client_sockets_mutex_;
-    /// Request deduplication cache to handle retried requests idempotently
-    aevum::util::deduplication::RequestCache request_cache_{1000};
+    /// The event loops, each run by its own I/O thread.
+    std::vector<std::unique_ptr<EventLoop>> event_loops_;
+    /// The event loop the next accepted connection is assigned to.
+    size_t next_event_loop_{0};
+    /// `true` if the event loops run on rings rather than `epoll`; set by `run()`.
+    bool uses_rings_{false};
+    /// The id of the next accepted connection, which identifies its receives on a ring.
+    uint64_t next_connection_id_{1};
+    /// The counters of the connections' `SocketWriter`s.
+    SendStats send_stats_;
+    /// The counters of the connections' `WireCodec`s.
+    aevum::net::CompressionStats compression_stats_;
+    /// The zstd dictionary of `wire_compression_dictionary`, or null.
+    std::shared_ptr<const aevum::net::WireDictionary> wire_dictionary_;
+    /// The pool that processes requests.
+    std::unique_ptr<aevum::util::concurrency::ThreadPool> request_workers_;
+    /// The number of open connections per client address, for `max_connections_per_ip`.
+    std::unordered_map<std::string, int> connections_per_ip_;
+    /// Guards `connections_per_ip_` and the admission check on `metrics_.active_connections`.
+    std::mutex connection_limits_mutex_;
+    /// The results of recent `find` and `count` requests, validated by the collections' write
+    /// generations (see `db::Core::write_generation`).
+    aevum::util::cache::ResultCache result_cache_;
+    /// The id under which `result_cache_` is registered with the core's memory budget, or 0.
+    uint64_t result_cache_reclaimer_{0};
+    /// Coalesces identical `find`, `count`, and `aggregate` reads that miss `result_cache_`.
+    aevum::util::cache::SingleFlight read_flights_;
+    /// Limits the point operations, scans, and administrative requests that run at once.
+    AdmissionController admission_;
+    /// Parsers kept between requests, so that a worker reuses the buffers a parser has already
+    /// grown instead of allocating them for every request.
+    aevum::util::memory::ObjectPool<simdjson::dom::parser> json_parsers_;
+    /// Serves `metrics_prometheus` while the server runs, if `metrics_port` is set.
+    std::unique_ptr<MetricsEndpoint> metrics_endpoint_;
 };
 
 }  // namespace aevum::net::server
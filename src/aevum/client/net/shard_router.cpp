@@ -0,0 +1,1051 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file shard_router.cpp
+ * @brief Implements the `ShardRouter`, which spreads the collections of a router over its shards.
+ */
+#include "aevum/client/net/shard_router.hpp"
+
+#include <bson/bson.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+#include "aevum/bson/builder.hpp"
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/client/aevum_client.hpp"
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/util/hash/fnv1a.hpp"
+#include "aevum/util/log/logger.hpp"
+#include "aevum/util/uuid/v4.hpp"
+
+namespace aevum::net::server {
+
+namespace {
+
+/// The shard key of collections without a configured one.
+const std::string DEFAULT_SHARD_KEY = "_id";
+
+/**
+ * @brief Appends a string to a JSON text as a quoted, escaped JSON string.
+ * @param out The JSON text.
+ * @param text The string.
+ */
+void append_json_string(std::string &out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Formats an error response.
+ * @param message The message.
+ * @return `{"status":"error", "message":...}`.
+ */
+std::string error_response(std::string_view message) {
+    std::string response = R"({"status":"error", "message":)";
+    append_json_string(response, message);
+    response += "}";
+    return response;
+}
+
+/**
+ * @brief Renders a shard key value as the bytes its shard is hashed from.
+ * @details Numbers are rendered by value, so that `1`, `1.0`, and an unsigned `1` share a shard,
+ * and each kind of value has its own prefix, so that `"1"` and `1` need not.
+ * @param value The value, or `nullptr` for a missing key, which is rendered as `null`.
+ * @return The bytes.
+ */
+std::string keyed_value(const simdjson::dom::element *value) {
+    if (value == nullptr) return "z";
+    switch (value->type()) {
+        case simdjson::dom::element_type::STRING:
+            return "s" + std::string(value->get_string().value_unsafe());
+        case simdjson::dom::element_type::INT64:
+            return "n" + std::to_string(value->get_int64().value_unsafe());
+        case simdjson::dom::element_type::UINT64:
+            return "n" + std::to_string(value->get_uint64().value_unsafe());
+        case simdjson::dom::element_type::DOUBLE: {
+            double number = value->get_double().value_unsafe();
+            if (std::isfinite(number) && std::trunc(number) == number &&
+                std::fabs(number) < 9.2e18) {
+                return "n" + std::to_string(static_cast<int64_t>(number));
+            }
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.17g", number);
+            return std::string("d") + text;
+        }
+        case simdjson::dom::element_type::BOOL:
+            return value->get_bool().value_unsafe() ? "b1" : "b0";
+        case simdjson::dom::element_type::NULL_VALUE:
+            return "z";
+        default:
+            return "o" + simdjson::to_string(*value);
+    }
+}
+
+/**
+ * @brief Maps the rendered bytes of a shard key value to a shard.
+ * @param keyed The bytes, from `keyed_value`.
+ * @param shards The number of shards.
+ * @return The index of the shard.
+ */
+size_t pick_shard(std::string_view keyed, size_t shards) {
+    return static_cast<size_t>(aevum::util::hash::fnv1a_64(keyed) % shards);
+}
+
+/**
+ * @brief Reads the status of a response.
+ * @param parser The parser to use.
+ * @param response The JSON response.
+ * @param reply Receives the parsed response.
+ * @return The error message, or an empty string if the status is `ok`.
+ */
+std::string response_error(simdjson::dom::parser &parser, const std::string &response,
+                           simdjson::dom::element &reply) {
+    std::string_view status;
+    if (parser.parse(response).get(reply) != simdjson::SUCCESS ||
+        reply["status"].get_string().get(status) != simdjson::SUCCESS) {
+        return "Malformed response";
+    }
+    if (status == "ok") return {};
+    std::string_view message = "Unknown error";
+    (void)reply["message"].get_string().get(message);
+    return message.empty() ? std::string("Unknown error") : std::string(message);
+}
+
+/**
+ * @brief Reads a number from a response field as an integer.
+ * @param value The field.
+ * @return The integer, or 0 if the field is not a number.
+ */
+int64_t number_of(const simdjson::dom::element &value) {
+    int64_t integer = 0;
+    if (value.get_int64().get(integer) == simdjson::SUCCESS) return integer;
+    double number = 0;
+    if (value.get_double().get(number) == simdjson::SUCCESS) return static_cast<int64_t>(number);
+    return 0;
+}
+
+/**
+ * @struct SortField
+ * @brief One field of a sort order.
+ */
+struct SortField {
+    /// The field path.
+    std::string path;
+    /// `true` for a descending order.
+    bool descending = false;
+};
+
+/**
+ * @brief Reads a sort specification.
+ * @param sort The specification, as `{field: 1 | -1, ...}`.
+ * @return The fields, in priority order.
+ */
+std::vector<SortField> sort_fields(const aevum::bson::doc::Document &sort) {
+    std::vector<SortField> fields;
+    bson_iter_t iter;
+    if (!bson_iter_init(&iter, sort.get())) return fields;
+    while (bson_iter_next(&iter)) {
+        double direction = 1;
+        if (BSON_ITER_HOLDS_INT32(&iter)) direction = bson_iter_int32(&iter);
+        if (BSON_ITER_HOLDS_INT64(&iter)) direction = static_cast<double>(bson_iter_int64(&iter));
+        if (BSON_ITER_HOLDS_DOUBLE(&iter)) direction = bson_iter_double(&iter);
+        fields.push_back({bson_iter_key(&iter), direction < 0});
+    }
+    return fields;
+}
+
+/**
+ * @brief Builds the keys a document sorts by.
+ * @param doc The document.
+ * @param fields The sort order.
+ * @return The key of each field; a missing field sorts as `null`.
+ */
+std::vector<aevum::db::index::IndexKey> sort_keys(const aevum::bson::doc::Document &doc,
+                                                  const std::vector<SortField> &fields) {
+    std::vector<aevum::db::index::IndexKey> keys(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        bson_iter_t value;
+        if (aevum::db::index::find_field_path(doc, fields[i].path, value)) {
+            keys[i] = aevum::db::index::make_index_key(value);
+        }
+    }
+    return keys;
+}
+
+/**
+ * @brief Gathers the results of several shards into one page.
+ * @details Without a sort order the runs are concatenated in shard order. With one, each run is
+ * already sorted by its shard, and they are merged with a heap of the runs' heads, taking the
+ * lower shard first among equal keys; the merge stops once the page is complete.
+ * @param runs The results of each shard.
+ * @param fields The sort order; empty for none.
+ * @param skip The number of results to skip.
+ * @param limit The most results returned, or 0 for no limit.
+ * @return The documents of the page, in order.
+ */
+std::vector<const aevum::bson::doc::Document *> gather(
+    const std::vector<std::vector<aevum::bson::doc::Document>> &runs,
+    const std::vector<SortField> &fields, size_t skip, size_t limit) {
+    size_t wanted = limit > 0 ? skip + limit : std::numeric_limits<size_t>::max();
+    std::vector<const aevum::bson::doc::Document *> page;
+    size_t taken = 0;
+    auto take = [&](const aevum::bson::doc::Document &doc) {
+        if (taken++ >= skip) page.push_back(&doc);
+        return taken < wanted;
+    };
+
+    if (fields.empty()) {
+        for (const auto &run : runs) {
+            for (const auto &doc : run) {
+                if (!take(doc)) return page;
+            }
+        }
+        return page;
+    }
+
+    std::vector<std::vector<std::vector<aevum::db::index::IndexKey>>> keys(runs.size());
+    for (size_t r = 0; r < runs.size(); ++r) {
+        size_t needed = std::min(runs[r].size(), wanted);
+        keys[r].reserve(needed);
+        for (size_t i = 0; i < needed; ++i) keys[r].push_back(sort_keys(runs[r][i], fields));
+    }
+    // Orders heads so that the smallest key, then the lowest shard, is on top of the heap.
+    auto after = [&](const std::pair<size_t, size_t> &a, const std::pair<size_t, size_t> &b) {
+        const auto &ka = keys[a.first][a.second];
+        const auto &kb = keys[b.first][b.second];
+        for (size_t f = 0; f < fields.size(); ++f) {
+            if (ka[f] < kb[f]) return fields[f].descending;
+            if (kb[f] < ka[f]) return !fields[f].descending;
+        }
+        return a.first > b.first;
+    };
+    std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>,
+                        decltype(after)>
+        heads(after);
+    for (size_t r = 0; r < runs.size(); ++r) {
+        if (!keys[r].empty()) heads.emplace(r, 0);
+    }
+    while (!heads.empty()) {
+        auto [run, position] = heads.top();
+        heads.pop();
+        if (!take(runs[run][position])) break;
+        if (position + 1 < keys[run].size()) heads.emplace(run, position + 1);
+    }
+    return page;
+}
+
+/**
+ * @brief Formats a page of documents as a `find` or `aggregate` response.
+ * @param page The documents.
+ * @return `{"status":"ok", "data":[...]}`.
+ */
+std::string data_response(const std::vector<const aevum::bson::doc::Document *> &page) {
+    std::string response = R"({"status":"ok", "data":[)";
+    for (size_t i = 0; i < page.size(); ++i) {
+        if (i > 0) response += ",";
+        aevum::bson::json::append_json(*page[i], response);
+    }
+    response += "]}";
+    return response;
+}
+
+/**
+ * @brief Gives a document without an `_id` a new one.
+ * @details The shard of a document sharded on `_id` depends on its `_id`, so the router
+ * generates it instead of leaving it to the shard.
+ * @param doc_json The minified document, which receives the `_id` as its first field.
+ * @return The new `_id`.
+ */
+std::string assign_id(std::string &doc_json) {
+    std::string id = aevum::util::uuid::generate_v4();
+    std::string with_id = R"({"_id":)";
+    append_json_string(with_id, id);
+    with_id += doc_json.size() > 2 ? "," + doc_json.substr(1) : "}";
+    doc_json = std::move(with_id);
+    return id;
+}
+
+/**
+ * @brief Converts an optional JSON object of a request to BSON.
+ * @param request The request.
+ * @param field The name of the object.
+ * @param out Receives the object, or stays empty if the request has none.
+ * @return `false` if the field is present but is not an object that converts.
+ */
+bool object_field(const simdjson::dom::element &request, const char *field,
+                  aevum::bson::doc::Document &out) {
+    simdjson::dom::element value;
+    if (request[field].get(value) != simdjson::SUCCESS || value.is_null()) return true;
+    return value.is_object() && aevum::bson::json::from_dom(value, out).ok();
+}
+
+/**
+ * @brief Returns the name of the only operator of an aggregation stage.
+ * @param stage The stage.
+ * @param body Receives the operand of the operator.
+ * @return The operator, or an empty string if the stage is not an object with one field.
+ */
+std::string_view stage_operator(const simdjson::dom::element &stage,
+                                simdjson::dom::element &body) {
+    simdjson::dom::object object;
+    if (stage.get_object().get(object) != simdjson::SUCCESS || object.size() != 1) return {};
+    for (auto field : object) {
+        body = field.value;
+        return field.key;
+    }
+    return {};
+}
+
+}  // namespace
+
+/**
+ * @brief Creates a router over the configured shards.
+ * @param config The shards and shard keys.
+ */
+ShardRouter::ShardRouter(ShardingConfig config)
+    : config_(std::move(config)),
+      scatter_pool_("Scatter", std::max<size_t>(config_.shards.size(), 1)) {
+    for (const auto &[host, port] : config_.shards) {
+        auto shard = std::make_unique<Shard>();
+        shard->host = host;
+        shard->port = port;
+        shard->address = host + ":" + std::to_string(port);
+        shards_.push_back(std::move(shard));
+    }
+    AEVUM_LOG_INFO("ShardRouter: Routing requests over " + std::to_string(shards_.size()) +
+                   " shards.");
+}
+
+/**
+ * @brief Closes the connections to the shards.
+ */
+ShardRouter::~ShardRouter() {
+    for (auto &shard : shards_) {
+        for (auto &client : shard->idle) client->disconnect();
+    }
+}
+
+/**
+ * @brief Returns the shard key of a collection.
+ * @param collection The name of the collection.
+ * @return The configured key, or `_id`.
+ */
+const std::string &ShardRouter::shard_key(std::string_view collection) const {
+    auto it = config_.shard_keys.find(std::string(collection));
+    return it != config_.shard_keys.end() ? it->second : DEFAULT_SHARD_KEY;
+}
+
+/**
+ * @brief Returns the shard a shard key value belongs to.
+ * @param value The value, or `nullptr` for a missing key.
+ * @return The index of the shard.
+ */
+size_t ShardRouter::shard_of(const simdjson::dom::element *value) const {
+    return pick_shard(keyed_value(value), shards_.size());
+}
+
+/**
+ * @brief Returns a snapshot of the counters of the router.
+ * @return The snapshot.
+ */
+ShardRouterStats ShardRouter::stats() const noexcept {
+    ShardRouterStats stats;
+    stats.targeted = targeted_.load(std::memory_order_relaxed);
+    stats.scattered = scattered_.load(std::memory_order_relaxed);
+    stats.shard_requests = shard_requests_.load(std::memory_order_relaxed);
+    stats.shard_errors = shard_errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief Takes an idle connection to a shard, or opens a new one.
+ * @details New connections ask for the BSON protocol, so that `find` receives the shards' stored
+ * documents without a JSON round trip. A shard that refuses it is still used over JSON, except
+ * by `find`, which reports the error.
+ * @param shard The index of the shard.
+ * @return The connection.
+ */
+std::unique_ptr<aevum::client::AevumClient> ShardRouter::acquire(size_t shard) {
+    Shard &target = *shards_[shard];
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        if (!target.idle.empty()) {
+            auto client = std::move(target.idle.back());
+            target.idle.pop_back();
+            return client;
+        }
+    }
+    auto client = std::make_unique<aevum::client::AevumClient>(target.host, target.port,
+                                                               config_.shard_auth);
+    if (!client->use_bson_protocol()) {
+        AEVUM_LOG_WARN("ShardRouter: Shard " + target.address +
+                       " is unreachable or does not speak the BSON protocol.");
+    }
+    return client;
+}
+
+/**
+ * @brief Returns a connection to the idle connections of its shard, or closes it.
+ * @param shard The index of the shard.
+ * @param client The connection.
+ */
+void ShardRouter::release(size_t shard, std::unique_ptr<aevum::client::AevumClient> client) {
+    Shard &target = *shards_[shard];
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        if (target.idle.size() < static_cast<size_t>(std::max(config_.connections_per_shard, 0))) {
+            target.idle.push_back(std::move(client));
+            return;
+        }
+    }
+    client->disconnect();
+}
+
+/**
+ * @brief Returns the shards a filter can match documents on.
+ * @details A filter pins the shard key with a plain value, `{$eq: value}`, or `{$in: [...]}`;
+ * an embedded document without operators is an exact match and pins it too. Any other filter,
+ * including one that constrains the key only inside `$and` or `$or`, reaches every shard.
+ * @param key The shard key.
+ * @param query The filter.
+ * @return The shards in ascending order.
+ */
+std::vector<size_t> ShardRouter::target_shards(const std::string &key,
+                                               const simdjson::dom::element &query) const {
+    std::vector<size_t> all(shards_.size());
+    std::iota(all.begin(), all.end(), 0);
+    simdjson::dom::element value;
+    if (!query.is_object() || query[key].get(value) != simdjson::SUCCESS) return all;
+    if (value.is_array()) return all;
+    if (!value.is_object()) return {shard_of(&value)};
+
+    simdjson::dom::object operators = value.get_object().value_unsafe();
+    bool has_operator = false;
+    for (auto field : operators) has_operator = has_operator || field.key.substr(0, 1) == "$";
+    if (!has_operator) return {shard_of(&value)};
+
+    simdjson::dom::element equal;
+    simdjson::dom::array candidates;
+    std::vector<size_t> targets;
+    if (operators["$eq"].get(equal) == simdjson::SUCCESS && !equal.is_object()) {
+        targets.push_back(shard_of(&equal));
+    } else if (operators["$in"].get_array().get(candidates) == simdjson::SUCCESS) {
+        for (simdjson::dom::element candidate : candidates) {
+            if (candidate.is_object() || candidate.is_array()) return all;
+            targets.push_back(shard_of(&candidate));
+        }
+    } else {
+        return all;
+    }
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    return targets;
+}
+
+/**
+ * @brief Returns the shards the `query` of a request can match documents on.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The shards in ascending order; every shard if the request has no `query`.
+ */
+std::vector<size_t> ShardRouter::query_targets(std::string_view collection,
+                                               const simdjson::dom::element &request) const {
+    simdjson::dom::element query;
+    if (request["query"].get(query) == simdjson::SUCCESS) {
+        return target_shards(shard_key(collection), query);
+    }
+    std::vector<size_t> all(shards_.size());
+    std::iota(all.begin(), all.end(), 0);
+    return all;
+}
+
+/**
+ * @brief Counts a request as targeted or scattered.
+ * @param targets The shards it goes to.
+ */
+void ShardRouter::note_targets(const std::vector<size_t> &targets) noexcept {
+    if (targets.size() < shards_.size()) {
+        targeted_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        scattered_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Sends one payload per shard, in parallel.
+ * @param targets The shards.
+ * @param payloads The JSON payload for each of `targets`.
+ * @return The JSON response of each of `targets`.
+ */
+std::vector<std::string> ShardRouter::scatter(const std::vector<size_t> &targets,
+                                              const std::vector<std::string> &payloads) {
+    std::vector<std::string> responses(targets.size());
+    shard_requests_.fetch_add(targets.size(), std::memory_order_relaxed);
+    scatter_pool_.parallel_for(0, targets.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto client = acquire(targets[i]);
+            responses[i] = client->send_request(payloads[i]);
+            release(targets[i], std::move(client));
+        }
+    });
+    return responses;
+}
+
+/**
+ * @brief Sends the same payload to several shards, in parallel.
+ * @param targets The shards.
+ * @param payload The JSON payload.
+ * @return The JSON response of each of `targets`.
+ */
+std::vector<std::string> ShardRouter::scatter(const std::vector<size_t> &targets,
+                                              const std::string &payload) {
+    return scatter(targets, std::vector<std::string>(targets.size(), payload));
+}
+
+/**
+ * @brief Finds the error among the responses of a scatter.
+ * @param targets The shards the responses came from.
+ * @param responses The JSON responses.
+ * @param parser The parser to use.
+ * @return The first error response, with the shard named in its message, or `std::nullopt`.
+ */
+std::optional<std::string> ShardRouter::first_error(const std::vector<size_t> &targets,
+                                                    const std::vector<std::string> &responses,
+                                                    simdjson::dom::parser &parser) {
+    for (size_t i = 0; i < responses.size(); ++i) {
+        simdjson::dom::element reply;
+        std::string message = response_error(parser, responses[i], reply);
+        if (message.empty()) continue;
+        shard_errors_.fetch_add(1, std::memory_order_relaxed);
+        AEVUM_LOG_WARN("ShardRouter: Shard " + shards_[targets[i]]->address +
+                       " failed a request: " + message);
+        return error_response("Shard " + shards_[targets[i]]->address + ": " + message);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Builds the payload of a request forwarded to the shards.
+ * @param action The action.
+ * @param collection The collection.
+ * @param request The original request.
+ * @param overrides Fields to replace or add, as pre-formatted JSON values.
+ * @return The JSON payload.
+ */
+std::string ShardRouter::forward_payload(
+    std::string_view action, std::string_view collection, const simdjson::dom::element &request,
+    const std::vector<std::pair<std::string_view, std::string>> &overrides) const {
+    std::string extra;
+    auto append_field = [&](std::string_view key, std::string_view value) {
+        if (!extra.empty()) extra += ',';
+        append_json_string(extra, key);
+        extra += ':';
+        extra += value;
+    };
+    simdjson::dom::object fields;
+    if (request.get_object().get(fields) == simdjson::SUCCESS) {
+        for (auto field : fields) {
+            if (field.key == "auth" || field.key == "session" || field.key == "action" ||
+                field.key == "collection" || field.key == "requestId") {
+                continue;
+            }
+            bool overridden = std::any_of(overrides.begin(), overrides.end(),
+                                          [&](const auto &o) { return o.first == field.key; });
+            if (!overridden) append_field(field.key, simdjson::to_string(field.value));
+        }
+    }
+    for (const auto &[key, value] : overrides) append_field(key, value);
+    return aevum::client::make_request_payload(config_.shard_auth, action, collection, extra);
+}
+
+/**
+ * @brief Answers a request from the shards, if its action is routed.
+ * @param action The action of the request.
+ * @param collection The collection of the request.
+ * @param request The parsed request.
+ * @param role The role of the authenticated caller.
+ * @return The JSON response, or `std::nullopt` if the router itself serves the action.
+ */
+std::optional<std::string> ShardRouter::route(std::string_view action,
+                                              std::string_view collection,
+                                              const simdjson::dom::element &request,
+                                              db::auth::UserRole role) {
+    if (action == "insert") return route_insert(collection, request);
+    if (action == "insert_many") return route_insert_many(collection, request);
+    if (action == "find") {
+        int64_t batch_size = 0;
+        if (request["batchSize"].get_int64().get(batch_size) == simdjson::SUCCESS &&
+            batch_size > 0) {
+            return error_response("Cursors are not supported through a shard router");
+        }
+        return route_find(collection, request);
+    }
+    if (action == "getMore" || action == "killCursor" || action == "watch" ||
+        action == "prepare" || action == "execute" || action == "closeStatement") {
+        return error_response("'" + std::string(action) +
+                              "' is not supported through a shard router");
+    }
+    if (action == "count") return route_count(action, collection, request, "count");
+    if (action == "delete") return route_count(action, collection, request, "deleted_count");
+    if (action == "update") {
+        const std::string &key = shard_key(collection);
+        simdjson::dom::object update;
+        if (request["update"].get_object().get(update) == simdjson::SUCCESS) {
+            for (auto field : update) {
+                bool modifies_key = field.key == key;
+                simdjson::dom::object targets;
+                if (field.key.substr(0, 1) == "$" &&
+                    field.value.get_object().get(targets) == simdjson::SUCCESS) {
+                    for (auto target : targets) {
+                        modifies_key = modifies_key || target.key == key ||
+                                       target.key.substr(0, key.size() + 1) == key + ".";
+                    }
+                }
+                if (modifies_key) {
+                    return error_response("An update through a shard router may not modify the "
+                                          "shard key '" + key + "'");
+                }
+            }
+        }
+        return route_count(action, collection, request, "updated_count");
+    }
+    if (action == "upsert") return route_upsert(collection, request);
+    if (action == "explain") return route_explain(collection, request);
+    if (action == "aggregate") return route_aggregate(collection, request);
+    if (action == "create_index" || action == "set_schema") {
+        if (role != db::auth::UserRole::ADMIN) {
+            AEVUM_LOG_WARN("Network: Denied '" + std::string(action) +
+                           "' action due to insufficient permissions.");
+            return error_response("Permission denied");
+        }
+        return route_broadcast(action, collection, request);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Routes an `insert` to the shard of its document.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The shard's response.
+ */
+std::string ShardRouter::route_insert(std::string_view collection,
+                                      const simdjson::dom::element &request) {
+    simdjson::dom::object data;
+    if (request["data"].get_object().get(data) != simdjson::SUCCESS) {
+        return error_response("Invalid BSON data for insert");
+    }
+    const std::string &key = shard_key(collection);
+    simdjson::dom::element value;
+    bool has_key = data[key].get(value) == simdjson::SUCCESS;
+    if (has_key && value.is_array()) {
+        return error_response("The shard key '" + key + "' must not hold an array");
+    }
+
+    std::string data_json = simdjson::to_string(data);
+    size_t shard = shard_of(has_key ? &value : nullptr);
+    if (!has_key && key == DEFAULT_SHARD_KEY) {
+        shard = pick_shard("s" + assign_id(data_json), shards_.size());
+    }
+    targeted_.fetch_add(1, std::memory_order_relaxed);
+    return scatter({shard}, forward_payload("insert", collection, request, {{"data", data_json}}))
+        .front();
+}
+
+/**
+ * @brief Routes the documents of an `insert_many` to their shards.
+ * @details Each shard receives one `insert_many` with its documents, in their original order,
+ * and the per-document results are put back in the order of the request.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The combined response.
+ */
+std::string ShardRouter::route_insert_many(std::string_view collection,
+                                           const simdjson::dom::element &request) {
+    simdjson::dom::array data;
+    if (request["data"].get_array().get(data) != simdjson::SUCCESS) {
+        return error_response("'data' must be an array for insert_many");
+    }
+    const std::string &key = shard_key(collection);
+    std::vector<std::string> entries;
+    std::vector<std::vector<size_t>> positions(shards_.size());
+    std::vector<std::string> batches(shards_.size());
+    for (simdjson::dom::element element : data) {
+        simdjson::dom::object doc;
+        simdjson::dom::element value;
+        if (element.get_object().get(doc) != simdjson::SUCCESS) {
+            entries.push_back(error_response("Invalid BSON data for insert"));
+            continue;
+        }
+        bool has_key = doc[key].get(value) == simdjson::SUCCESS;
+        if (has_key && value.is_array()) {
+            entries.push_back(error_response("The shard key '" + key + "' must not hold an array"));
+            continue;
+        }
+        std::string doc_json = simdjson::to_string(doc);
+        size_t shard = shard_of(has_key ? &value : nullptr);
+        if (!has_key && key == DEFAULT_SHARD_KEY) {
+            shard = pick_shard("s" + assign_id(doc_json), shards_.size());
+        }
+        batches[shard] += batches[shard].empty() ? "[" : ",";
+        batches[shard] += doc_json;
+        positions[shard].push_back(entries.size());
+        entries.emplace_back();
+    }
+
+    std::vector<size_t> targets;
+    std::vector<std::string> payloads;
+    for (size_t shard = 0; shard < shards_.size(); ++shard) {
+        if (positions[shard].empty()) continue;
+        targets.push_back(shard);
+        payloads.push_back(forward_payload("insert_many", collection, request,
+                                           {{"data", batches[shard] + "]"}}));
+    }
+    note_targets(targets);
+    std::vector<std::string> responses = scatter(targets, payloads);
+
+    simdjson::dom::parser parser;
+    for (size_t t = 0; t < targets.size(); ++t) {
+        const std::vector<size_t> &slots = positions[targets[t]];
+        simdjson::dom::element reply;
+        simdjson::dom::array results;
+        std::string message = response_error(parser, responses[t], reply);
+        if (message.empty() && reply["results"].get_array().get(results) != simdjson::SUCCESS) {
+            message = "Malformed response";
+        }
+        if (!message.empty()) {
+            shard_errors_.fetch_add(1, std::memory_order_relaxed);
+            std::string entry =
+                error_response("Shard " + shards_[targets[t]]->address + ": " + message);
+            for (size_t slot : slots) entries[slot] = entry;
+            continue;
+        }
+        size_t i = 0;
+        for (simdjson::dom::element result : results) {
+            if (i < slots.size()) entries[slots[i++]] = simdjson::to_string(result);
+        }
+    }
+
+    int64_t inserted = 0;
+    for (const auto &entry : entries) {
+        if (entry.rfind(R"({"status":"ok")", 0) == 0) ++inserted;
+    }
+    std::string response =
+        R"({"status":"ok", "inserted":)" + std::to_string(inserted) + R"(, "results":[)";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i > 0) response += ",";
+        response += entries[i];
+    }
+    response += "]}";
+    return response;
+}
+
+/**
+ * @brief Routes a `find` to the shards of its filter and gathers the results.
+ * @details Each shard returns up to `skip + limit` documents over the BSON protocol, sorted by
+ * the request's sort order; the router merges them and applies `skip` and `limit` itself. A
+ * projection is applied by the shards, so it must keep the fields the results are sorted by.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The combined response.
+ */
+std::string ShardRouter::route_find(std::string_view collection,
+                                    const simdjson::dom::element &request) {
+    aevum::bson::doc::Document query, sort, projection;
+    if (!object_field(request, "query", query) || !object_field(request, "sort", sort) ||
+        !object_field(request, "projection", projection)) {
+        return error_response("'query', 'sort', and 'projection' must be objects");
+    }
+    int64_t limit = 0, skip = 0;
+    (void)request["limit"].get_int64().get(limit);
+    (void)request["skip"].get_int64().get(skip);
+    limit = std::max<int64_t>(limit, 0);
+    skip = std::max<int64_t>(skip, 0);
+
+    std::vector<size_t> targets = query_targets(collection, request);
+    note_targets(targets);
+
+    std::vector<std::vector<aevum::bson::doc::Document>> runs(targets.size());
+    std::vector<aevum::util::Status> statuses(targets.size());
+    shard_requests_.fetch_add(targets.size(), std::memory_order_relaxed);
+    int64_t shard_limit = limit > 0 ? limit + skip : 0;
+    scatter_pool_.parallel_for(0, targets.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto client = acquire(targets[i]);
+            statuses[i] = client->find_documents(collection, query, sort, projection, shard_limit,
+                                                 0, runs[i]);
+            release(targets[i], std::move(client));
+        }
+    });
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (statuses[i].ok()) continue;
+        shard_errors_.fetch_add(1, std::memory_order_relaxed);
+        return error_response("Shard " + shards_[targets[i]]->address + ": " +
+                              statuses[i].message());
+    }
+    return data_response(gather(runs, sort_fields(sort), static_cast<size_t>(skip),
+                                static_cast<size_t>(limit)));
+}
+
+/**
+ * @brief Routes a request answered with a count to the shards of its filter and sums the counts.
+ * @param action The action: `count`, `update`, or `delete`.
+ * @param collection The collection.
+ * @param request The request.
+ * @param count_field The field of the response holding the count.
+ * @return The combined response.
+ */
+std::string ShardRouter::route_count(std::string_view action, std::string_view collection,
+                                     const simdjson::dom::element &request,
+                                     const char *count_field) {
+    std::vector<size_t> targets = query_targets(collection, request);
+    note_targets(targets);
+    std::vector<std::string> responses =
+        scatter(targets, forward_payload(action, collection, request));
+
+    simdjson::dom::parser parser;
+    if (auto error = first_error(targets, responses, parser)) return *error;
+    int64_t total = 0;
+    for (const auto &response : responses) {
+        simdjson::dom::element reply;
+        if (parser.parse(response).get(reply) != simdjson::SUCCESS) continue;
+        simdjson::dom::element count;
+        if (reply[count_field].get(count) == simdjson::SUCCESS) total += number_of(count);
+    }
+    return R"({"status":"ok", ")" + std::string(count_field) + R"(":)" + std::to_string(total) +
+           "}";
+}
+
+/**
+ * @brief Routes an `upsert` to the one shard its filter pins.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The shard's response.
+ */
+std::string ShardRouter::route_upsert(std::string_view collection,
+                                      const simdjson::dom::element &request) {
+    const std::string &key = shard_key(collection);
+    simdjson::dom::element query;
+    std::vector<size_t> targets;
+    if (request["query"].get(query) == simdjson::SUCCESS) targets = target_shards(key, query);
+    if (targets.size() != 1 || query[key].error() != simdjson::SUCCESS) {
+        return error_response("An upsert through a shard router needs an equality on the shard "
+                              "key '" + key + "' in its query");
+    }
+    simdjson::dom::element value;
+    if (request["data"][key].get(value) == simdjson::SUCCESS &&
+        (value.is_array() || shard_of(&value) != targets.front())) {
+        return error_response("An upsert through a shard router may not move a document to "
+                              "another shard by changing its shard key '" + key + "'");
+    }
+    targeted_.fetch_add(1, std::memory_order_relaxed);
+    return scatter(targets, forward_payload("upsert", collection, request)).front();
+}
+
+/**
+ * @brief Routes an `explain` to the shards of its filter and lists their plans.
+ * @param collection The collection.
+ * @param request The request.
+ * @return `{"status":"ok", "shards":[{"shard":"host:port", "plan":{...}}, ...]}`.
+ */
+std::string ShardRouter::route_explain(std::string_view collection,
+                                       const simdjson::dom::element &request) {
+    std::vector<size_t> targets = query_targets(collection, request);
+    std::vector<std::string> responses =
+        scatter(targets, forward_payload("explain", collection, request));
+
+    simdjson::dom::parser parser;
+    if (auto error = first_error(targets, responses, parser)) return *error;
+    std::string response = R"({"status":"ok", "shards":[)";
+    for (size_t i = 0; i < responses.size(); ++i) {
+        simdjson::dom::element reply, plan;
+        if (i > 0) response += ",";
+        response += R"({"shard":)";
+        append_json_string(response, shards_[targets[i]]->address);
+        response += R"(, "plan":)";
+        bool parsed = parser.parse(responses[i]).get(reply) == simdjson::SUCCESS &&
+                      reply["plan"].get(plan) == simdjson::SUCCESS;
+        response += parsed ? simdjson::to_string(plan) : "null";
+        response += "}";
+    }
+    response += "]}";
+    return response;
+}
+
+/**
+ * @brief Routes an `aggregate` to one shard, or splits it across the shards.
+ * @details A pipeline whose first `$match` pins the shard key to one shard runs there whole.
+ * Otherwise its leading `$match` and `$project` stages run on the shards of the first `$match`,
+ * together with the `$sort` and a `$limit` of `skip + limit` that follow them, and the router
+ * merges the results and applies `$skip` and `$limit`, or sums the counts of a final `$count`.
+ * @param collection The collection.
+ * @param request The request.
+ * @return The combined response.
+ */
+std::string ShardRouter::route_aggregate(std::string_view collection,
+                                         const simdjson::dom::element &request) {
+    simdjson::dom::array pipeline;
+    if (request["pipeline"].get_array().get(pipeline) != simdjson::SUCCESS) {
+        return error_response("'pipeline' must be an array for aggregate");
+    }
+    const std::string &key = shard_key(collection);
+    std::vector<size_t> targets(shards_.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    simdjson::dom::element first, body;
+    if (pipeline.at(0).get(first) == simdjson::SUCCESS && stage_operator(first, body) == "$match") {
+        targets = target_shards(key, body);
+    }
+    if (targets.size() == 1) {
+        targeted_.fetch_add(1, std::memory_order_relaxed);
+        return scatter(targets, forward_payload("aggregate", collection, request)).front();
+    }
+
+    std::string pushed = "[";
+    auto push = [&](const std::string &stage) {
+        if (pushed.size() > 1) pushed += ",";
+        pushed += stage;
+    };
+    aevum::bson::doc::Document sort;
+    std::string count_name;
+    bool in_prefix = true;
+    bool sorted = false;
+    size_t skip = 0;
+    std::optional<size_t> limit;
+    for (simdjson::dom::element stage : pipeline) {
+        std::string_view name = stage_operator(stage, body);
+        if (in_prefix && (name == "$match" || name == "$project")) {
+            push(simdjson::to_string(stage));
+            continue;
+        }
+        in_prefix = false;
+        int64_t amount = 0;
+        if (name == "$sort" && !sorted && skip == 0 && !limit && count_name.empty() &&
+            body.is_object() && aevum::bson::json::from_dom(body, sort).ok()) {
+            sorted = true;
+        } else if ((name == "$skip" || name == "$limit") && count_name.empty() &&
+                   body.get_int64().get(amount) == simdjson::SUCCESS && amount >= 0) {
+            size_t n = static_cast<size_t>(amount);
+            if (name == "$skip") {
+                skip += n;
+                if (limit) limit = *limit > n ? *limit - n : 0;
+            } else {
+                limit = limit ? std::min(*limit, n) : n;
+            }
+        } else if (name == "$count" && count_name.empty() && !sorted && skip == 0 && !limit &&
+                   body.is_string()) {
+            count_name = std::string(body.get_string().value_unsafe());
+        } else {
+            return error_response("The '" + std::string(name) +
+                                  "' stage needs a pipeline on one shard: across shards only "
+                                  "$match and $project, then $sort, $skip, $limit, or $count, "
+                                  "are supported");
+        }
+    }
+    if (sorted) push(R"({"$sort":)" + aevum::bson::json::to_string(sort) + "}");
+    if (limit) push(R"({"$limit":)" + std::to_string(skip + *limit) + "}");
+    if (!count_name.empty()) {
+        std::string count_stage = R"({"$count":)";
+        append_json_string(count_stage, count_name);
+        push(count_stage + "}");
+    }
+    pushed += "]";
+
+    note_targets(targets);
+    std::vector<std::string> responses =
+        scatter(targets, forward_payload("aggregate", collection, request, {{"pipeline", pushed}}));
+    simdjson::dom::parser parser;
+    if (auto error = first_error(targets, responses, parser)) return *error;
+
+    std::vector<std::vector<aevum::bson::doc::Document>> runs(targets.size());
+    for (size_t i = 0; i < responses.size(); ++i) {
+        simdjson::dom::element reply;
+        simdjson::dom::array results;
+        if (parser.parse(responses[i]).get(reply) != simdjson::SUCCESS ||
+            reply["data"].get_array().get(results) != simdjson::SUCCESS) {
+            continue;
+        }
+        for (simdjson::dom::element result : results) {
+            aevum::bson::doc::Document doc;
+            if (aevum::bson::json::from_dom(result, doc).ok()) runs[i].push_back(std::move(doc));
+        }
+    }
+
+    if (!count_name.empty()) {
+        int64_t total = 0;
+        bool counted = false;
+        for (const auto &run : runs) {
+            for (const auto &doc : run) {
+                bson_iter_t iter;
+                if (!bson_iter_init_find(&iter, doc.get(), count_name.c_str())) continue;
+                counted = true;
+                if (BSON_ITER_HOLDS_INT32(&iter)) total += bson_iter_int32(&iter);
+                if (BSON_ITER_HOLDS_INT64(&iter)) total += bson_iter_int64(&iter);
+                if (BSON_ITER_HOLDS_DOUBLE(&iter)) {
+                    total += static_cast<int64_t>(bson_iter_double(&iter));
+                }
+            }
+        }
+        if (!counted) return R"({"status":"ok", "data":[]})";
+        aevum::bson::doc::Document count =
+            aevum::bson::Builder().append_int64(count_name.c_str(), total).finalize();
+        return data_response({&count});
+    }
+    return data_response(gather(runs, sort_fields(sort), skip, limit ? *limit : 0));
+}
+
+/**
+ * @brief Sends a request to every shard, as for `create_index` and `set_schema`.
+ * @param action The action.
+ * @param collection The collection.
+ * @param request The request.
+ * @return `{"status":"ok"}`, or the first shard's error.
+ */
+std::string ShardRouter::route_broadcast(std::string_view action, std::string_view collection,
+                                         const simdjson::dom::element &request) {
+    std::vector<size_t> targets(shards_.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    note_targets(targets);
+    std::vector<std::string> responses =
+        scatter(targets, forward_payload(action, collection, request));
+    simdjson::dom::parser parser;
+    if (auto error = first_error(targets, responses, parser)) return *error;
+    return R"({"status":"ok"})";
+}
+
+}  // namespace aevum::net::server
@@ -0,0 +1,277 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file shard_router.hpp
+ * @brief Declares the `ShardRouter`, which spreads the collections of a router over its shards.
+ * @details A router is an `aevumd` whose configuration names a list of shards, themselves plain
+ * `aevumd` instances. Every document lives on exactly one shard, chosen by hashing the value of
+ * its collection's shard key. The router keeps users, metrics, and the profiler for itself and
+ * answers every data request from the shards: a request whose filter pins the shard key to one
+ * or a few values goes to those shards only, and any other request is scattered to every shard,
+ * in parallel, and the answers are gathered into one. Sorted results are merged from the shards'
+ * sorted streams in the order of the Rust comparator, so `sort` with `limit` only asks each shard
+ * for `skip + limit` documents.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/auth/role.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
+#include "simdjson.h"
+
+namespace aevum::client {
+class AevumClient;
+}
+
+namespace aevum::net::server {
+
+/**
+ * @struct ShardingConfig
+ * @brief The shards of a router and how collections are spread over them.
+ */
+struct ShardingConfig {
+    /// The host and port of every shard, in shard order; empty if this server is not a router.
+    /// The order decides which shard a hash maps to, so it must not change once data is written.
+    std::vector<std::pair<std::string, int>> shards;
+    /// The shard key of each collection; collections not listed are sharded on `_id`.
+    std::unordered_map<std::string, std::string> shard_keys;
+    /// The API key the router authenticates with on the shards.
+    std::string shard_auth;
+    /// The idle connections kept per shard.
+    int connections_per_shard{8};
+};
+
+/**
+ * @struct ShardRouterStats
+ * @brief A snapshot of the counters of a `ShardRouter`, as reported by the `metrics` action.
+ */
+struct ShardRouterStats {
+    /// The requests sent to some of the shards only.
+    uint64_t targeted = 0;
+    /// The requests scattered to every shard.
+    uint64_t scattered = 0;
+    /// The requests sent to shards, counting each shard once.
+    uint64_t shard_requests = 0;
+    /// The shard requests that failed or were answered with an error.
+    uint64_t shard_errors = 0;
+};
+
+/**
+ * @class ShardRouter
+ * @brief Routes the data requests of a router to its shards and gathers their answers.
+ *
+ * @details The shard of a document is `fnv1a_64(value) % shards` of its shard key's value, with
+ * numbers keyed by value, so that `1` and `1.0` land together, and a missing key hashed as
+ * `null`. The actions are routed as follows:
+ * - `insert` and `insert_many` go to the shard of each document. A document without an `_id` is
+ *   given one by the router when `_id` is the shard key. A shard key holding an array is refused.
+ * - `find`, `count`, `update`, `delete`, and `explain` go to the shards of a filter that pins the
+ *   shard key with an equality, `$eq`, or `$in`, and to every shard otherwise. Results are
+ *   concatenated in shard order or, with a `sort`, merged; counts are summed.
+ * - `upsert` needs a filter that pins the shard key to one value.
+ * - `update` may not modify the shard key, since that would move the document between shards.
+ * - `aggregate` runs on one shard when its first `$match` pins the shard key. Across shards only
+ *   `$match` and `$project` stages are pushed down; they may be followed by `$sort`, `$skip`,
+ *   and `$limit`, applied while merging, or by one `$count`, summed.
+ * - `create_index` and `set_schema` go to every shard.
+ * - Cursors (`batchSize`, `getMore`, `killCursor`) and `watch` are refused.
+ * Every other action is left to the router itself.
+ */
+class ShardRouter {
+  public:
+    /**
+     * @brief Creates a router over the configured shards; connections are opened on first use.
+     * @param config The shards and shard keys.
+     */
+    explicit ShardRouter(ShardingConfig config);
+
+    /**
+     * @brief Closes the connections to the shards.
+     */
+    ~ShardRouter();
+
+    ShardRouter(const ShardRouter &) = delete;
+    ShardRouter &operator=(const ShardRouter &) = delete;
+    ShardRouter(ShardRouter &&) = delete;
+    ShardRouter &operator=(ShardRouter &&) = delete;
+
+    /**
+     * @brief Answers a request from the shards, if its action is routed.
+     * @param action The action of the request.
+     * @param collection The collection of the request.
+     * @param request The parsed request.
+     * @param role The role of the authenticated caller.
+     * @return The JSON response, or `std::nullopt` if the router itself serves the action.
+     */
+    [[nodiscard]] std::optional<std::string> route(std::string_view action,
+                                                   std::string_view collection,
+                                                   const simdjson::dom::element &request,
+                                                   db::auth::UserRole role);
+
+    /**
+     * @brief Returns the shard key of a collection.
+     * @param collection The name of the collection.
+     * @return The configured key, or `_id`.
+     */
+    [[nodiscard]] const std::string &shard_key(std::string_view collection) const;
+
+    /**
+     * @brief Returns the shard a shard key value belongs to.
+     * @param value The value, or `nullptr` for a missing key.
+     * @return The index of the shard.
+     */
+    [[nodiscard]] size_t shard_of(const simdjson::dom::element *value) const;
+
+    /**
+     * @brief Returns the number of shards.
+     * @return The number of shards.
+     */
+    [[nodiscard]] size_t shard_count() const noexcept { return shards_.size(); }
+
+    /**
+     * @brief Returns a snapshot of the counters of the router.
+     * @return The snapshot.
+     */
+    [[nodiscard]] ShardRouterStats stats() const noexcept;
+
+  private:
+    /**
+     * @struct Shard
+     * @brief A shard and its idle connections.
+     */
+    struct Shard {
+        /// The host of the shard.
+        std::string host;
+        /// The port of the shard.
+        int port = 0;
+        /// `host:port`, for messages.
+        std::string address;
+        /// Guards `idle`.
+        std::mutex mutex;
+        /// Connections not in use, negotiated to the BSON protocol.
+        std::vector<std::unique_ptr<aevum::client::AevumClient>> idle;
+    };
+
+    /// The shards and the settings.
+    ShardingConfig config_;
+    /// The shards, in shard order.
+    std::vector<std::unique_ptr<Shard>> shards_;
+    /// The workers sending the requests of a scatter in parallel.
+    aevum::util::concurrency::ThreadPool scatter_pool_;
+
+    std::atomic<uint64_t> targeted_{0};
+    std::atomic<uint64_t> scattered_{0};
+    std::atomic<uint64_t> shard_requests_{0};
+    std::atomic<uint64_t> shard_errors_{0};
+
+    /**
+     * @brief Takes an idle connection to a shard, or opens a new one.
+     * @param shard The index of the shard.
+     * @return The connection.
+     */
+    std::unique_ptr<aevum::client::AevumClient> acquire(size_t shard);
+
+    /**
+     * @brief Returns a connection to the idle connections of its shard, or closes it.
+     * @param shard The index of the shard.
+     * @param client The connection.
+     */
+    void release(size_t shard, std::unique_ptr<aevum::client::AevumClient> client);
+
+    /**
+     * @brief Returns the shards a filter can match documents on.
+     * @param key The shard key.
+     * @param query The filter.
+     * @return The shards in ascending order; every shard unless the filter pins the key.
+     */
+    [[nodiscard]] std::vector<size_t> target_shards(const std::string &key,
+                                                    const simdjson::dom::element &query) const;
+
+    /**
+     * @brief Returns the shards the `query` of a request can match documents on.
+     * @param collection The collection.
+     * @param request The request.
+     * @return The shards in ascending order; every shard if the request has no `query`.
+     */
+    [[nodiscard]] std::vector<size_t> query_targets(std::string_view collection,
+                                                    const simdjson::dom::element &request) const;
+
+    /**
+     * @brief Counts a request as targeted or scattered.
+     * @param targets The shards it goes to.
+     */
+    void note_targets(const std::vector<size_t> &targets) noexcept;
+
+    /**
+     * @brief Sends one payload per shard, in parallel.
+     * @param targets The shards.
+     * @param payloads The JSON payload for each of `targets`.
+     * @return The JSON response of each of `targets`.
+     */
+    std::vector<std::string> scatter(const std::vector<size_t> &targets,
+                                     const std::vector<std::string> &payloads);
+
+    /**
+     * @brief Sends the same payload to several shards, in parallel.
+     * @param targets The shards.
+     * @param payload The JSON payload.
+     * @return The JSON response of each of `targets`.
+     */
+    std::vector<std::string> scatter(const std::vector<size_t> &targets,
+                                     const std::string &payload);
+
+    /**
+     * @brief Finds the error among the responses of a scatter.
+     * @param targets The shards the responses came from.
+     * @param responses The JSON responses.
+     * @param parser The parser to use.
+     * @return The first error response, with the shard named in its message, or `std::nullopt`.
+     */
+    std::optional<std::string> first_error(const std::vector<size_t> &targets,
+                                           const std::vector<std::string> &responses,
+                                           simdjson::dom::parser &parser);
+
+    /**
+     * @brief Builds the payload of a request forwarded to the shards.
+     * @param action The action.
+     * @param collection The collection.
+     * @param request The original request, whose fields other than `auth`, `action`,
+     *        `collection`, and `requestId` are copied.
+     * @param overrides Fields to replace or add, as pre-formatted JSON values.
+     * @return The JSON payload.
+     */
+    [[nodiscard]] std::string forward_payload(
+        std::string_view action, std::string_view collection,
+        const simdjson::dom::element &request,
+        const std::vector<std::pair<std::string_view, std::string>> &overrides = {}) const;
+
+    /// The routes of the individual actions; see the class description.
+    std::string route_insert(std::string_view collection, const simdjson::dom::element &request);
+    std::string route_insert_many(std::string_view collection,
+                                  const simdjson::dom::element &request);
+    std::string route_find(std::string_view collection, const simdjson::dom::element &request);
+    std::string route_count(std::string_view action, std::string_view collection,
+                            const simdjson::dom::element &request, const char *count_field);
+    std::string route_upsert(std::string_view collection, const simdjson::dom::element &request);
+    std::string route_explain(std::string_view collection, const simdjson::dom::element &request);
+    std::string route_aggregate(std::string_view collection,
+                                const simdjson::dom::element &request);
+    std::string route_broadcast(std::string_view action, std::string_view collection,
+                                const simdjson::dom::element &request);
+};
+
+}  // namespace aevum::net::server
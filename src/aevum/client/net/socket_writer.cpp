@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file socket_writer.cpp
+ * @brief Implements `SocketWriter`.
+ */
+#include "aevum/client/net/socket_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::net::server {
+
+namespace {
+
+/**
+ * @brief Waits for a socket to report the events asked for.
+ * @param fd The socket.
+ * @param events The events to wait for; `POLLERR` is always reported.
+ * @param timeout_ms The longest time to wait.
+ * @return The events reported, or 0 on timeout or failure.
+ */
+short wait_for(int fd, short events, int timeout_ms) {
+    struct pollfd ready{};
+    ready.fd = fd;
+    ready.events = events;
+    int n;
+    do {
+        n = poll(&ready, 1, timeout_ms);
+    } while (n < 0 && errno == EINTR);
+    return n > 0 ? ready.revents : 0;
+}
+
+}  // namespace
+
+/**
+ * @brief Binds the writer to a socket and sets `SO_ZEROCOPY` on it if requested.
+ * @details A kernel older than 4.14 refuses the option, and the writer then copies as usual.
+ * @param fd The connected socket.
+ * @param zero_copy_threshold The smallest send made with `MSG_ZEROCOPY`, or 0.
+ * @param stats The counters to update.
+ */
+void SocketWriter::attach(int fd, size_t zero_copy_threshold, SendStats *stats) {
+    fd_ = fd;
+    stats_ = stats;
+    zero_copy_threshold_ = 0;
+    if (zero_copy_threshold == 0) return;
+    int enable = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0) {
+        zero_copy_threshold_ = zero_copy_threshold;
+    }
+}
+
+/**
+ * @brief Queues a response, with its length prefix if the connection is framed.
+ * @param response The response payload.
+ * @param framed `true` to prefix it with its length.
+ * @param compressed `true` to set the compression flag of the length.
+ */
+void SocketWriter::queue(std::string response, bool framed, bool compressed) {
+    Pending pending;
+    auto length =
+        static_cast<uint32_t>(response.size()) | (compressed ? COMPRESSED_FRAME_FLAG : 0);
+    pending.header[0] = static_cast<char>(length >> 24);
+    pending.header[1] = static_cast<char>(length >> 16);
+    pending.header[2] = static_cast<char>(length >> 8);
+    pending.header[3] = static_cast<char>(length);
+    pending.framed = framed;
+    pending.body = std::move(response);
+    queued_bytes_ += pending.body.size();
+    pending_.push_back(std::move(pending));
+}
+
+/**
+ * @brief Sends the queued responses with a single list of buffers.
+ * @details The queue keeps its capacity, so a connection that pipelines allocates it once.
+ * @param timeout_ms The longest time to wait for the socket or the kernel.
+ * @return `true` if every response was sent.
+ */
+bool SocketWriter::flush(int timeout_ms) {
+    if (pending_.empty()) return true;
+    std::vector<struct iovec> buffers;
+    buffers.reserve(pending_.size() * 2);
+    size_t size = 0;
+    for (Pending &pending : pending_) {
+        if (pending.framed) {
+            buffers.push_back({pending.header, FRAME_HEADER_SIZE});
+            size += FRAME_HEADER_SIZE;
+        }
+        if (!pending.body.empty()) buffers.push_back({pending.body.data(), pending.body.size()});
+        size += pending.body.size();
+    }
+    if (pending_.size() > 1 && stats_ != nullptr) {
+        ++stats_->batches;
+        stats_->batched_responses += pending_.size();
+    }
+    bool sent = write(std::move(buffers), size, timeout_ms);
+    pending_.clear();
+    queued_bytes_ = 0;
+    return sent;
+}
+
+/**
+ * @brief Flushes the queued responses, then sends a list of buffers.
+ * @param buffers The buffers to send.
+ * @param size The total size of `buffers`.
+ * @param timeout_ms The longest time to wait for the socket or the kernel.
+ * @return `true` if everything was sent.
+ */
+bool SocketWriter::send(std::vector<struct iovec> buffers, size_t size, int timeout_ms) {
+    if (!flush(timeout_ms)) return false;
+    return write(std::move(buffers), size, timeout_ms);
+}
+
+/**
+ * @brief Writes a list of buffers with `sendmsg`.
+ * @details At most `IOV_MAX` buffers are passed per call. After a partial write the list is
+ * advanced past the sent bytes, and a full send buffer is waited on with `poll`. A list of at
+ * least the zero-copy threshold is sent with `MSG_ZEROCOPY`, which the kernel numbers call by
+ * call; if it runs out of memory to pin the pages (`ENOBUFS`), the rest of the list is copied.
+ * @param buffers The buffers, consumed by the call.
+ * @param size The total size of `buffers`.
+ * @param timeout_ms The longest time to wait for the socket or the kernel.
+ * @return `true` if every byte was sent and, with zero copy, released by the kernel.
+ */
+bool SocketWriter::write(std::vector<struct iovec> buffers, size_t size, int timeout_ms) {
+    bool zero_copy = zero_copy_threshold_ > 0 && size >= zero_copy_threshold_;
+    size_t next = 0;
+    while (next < buffers.size()) {
+        struct msghdr message{};
+        message.msg_iov = buffers.data() + next;
+        message.msg_iovlen = std::min<size_t>(buffers.size() - next, IOV_MAX);
+        int flags = MSG_NOSIGNAL | MSG_DONTWAIT | (zero_copy ? MSG_ZEROCOPY : 0);
+        ssize_t n = sendmsg(fd_, &message, flags);
+        if (n >= 0) {
+            if (zero_copy) ++zero_copy_issued_;
+            auto remaining = static_cast<size_t>(n);
+            while (next < buffers.size() && remaining >= buffers[next].iov_len) {
+                remaining -= buffers[next].iov_len;
+                ++next;
+            }
+            if (remaining > 0) {
+                buffers[next].iov_base = static_cast<char *>(buffers[next].iov_base) + remaining;
+                buffers[next].iov_len -= remaining;
+            }
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (errno == ENOBUFS && zero_copy) {
+            zero_copy = false;
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            AEVUM_LOG_WARN("Network: Failed to send response: " + std::string(strerror(errno)));
+            return false;
+        }
+        if ((wait_for(fd_, POLLOUT, timeout_ms) & POLLOUT) == 0) {
+            AEVUM_LOG_WARN("Network: Timed out sending response to a client.");
+            return false;
+        }
+    }
+    if (zero_copy_issued_ == zero_copy_released_) return true;
+    if (stats_ != nullptr) {
+        ++stats_->zero_copy_sends;
+        stats_->zero_copy_bytes += size;
+    }
+    return await_zero_copy(timeout_ms);
+}
+
+/**
+ * @brief Reads the completion notifications of zero-copy sends from the socket's error queue.
+ * @details Each notification releases a range of calls. One flagged as copied means that the
+ * route cannot transmit from user pages, such as the loopback device, so the pinning was wasted;
+ * zero copy is then turned off for the connection, as the kernel's documentation advises. If the
+ * wait times out, the kernel may still read the buffers; they stay mapped by the process, so at
+ * worst a dead client receives altered bytes, and the caller closes the connection anyway.
+ * @param timeout_ms The longest time to wait for a notification.
+ * @return `true` once every call has been released.
+ */
+bool SocketWriter::await_zero_copy(int timeout_ms) {
+    while (zero_copy_released_ != zero_copy_issued_) {
+        char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+        struct msghdr message{};
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        if (recvmsg(fd_, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+            if ((wait_for(fd_, 0, timeout_ms) & POLLERR) == 0) {
+                AEVUM_LOG_WARN("Network: Timed out waiting for a zero-copy send to complete.");
+                return false;
+            }
+            continue;
+        }
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            bool recverr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                           (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+            if (!recverr) continue;
+            struct sock_extended_err error;
+            std::memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+            if (error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+            zero_copy_released_ += error.ee_data - error.ee_info + 1;
+            if ((error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0 && zero_copy_threshold_ > 0) {
+                zero_copy_threshold_ = 0;
+                if (stats_ != nullptr) ++stats_->zero_copy_copied;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace aevum::net::server
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file socket_writer.hpp
+ * @brief Declares `SocketWriter`, which sends the responses of a connection in batches and
+ * large ones without copying them into the kernel.
+ * @details Responses to pipelined requests are queued and written together by one `sendmsg`,
+ * each as its own buffer, rather than by one `send` per response. A batch or result set of at
+ * least the zero-copy threshold is sent with `MSG_ZEROCOPY`: the kernel transmits from the
+ * response's own pages instead of copying them into socket buffers, and reports on the socket's
+ * error queue once it no longer needs them. The writer waits for that report before it returns,
+ * so the caller may free the response as usual.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "aevum/client/net/framing.hpp"
+
+namespace aevum::net::server {
+
+/**
+ * @struct SendStats
+ * @brief The counters of the writers of every connection of a server.
+ */
+struct SendStats {
+    /// The `sendmsg` batches that carried more than one response.
+    std::atomic<uint64_t> batches{0};
+    /// The responses sent as part of such a batch.
+    std::atomic<uint64_t> batched_responses{0};
+    /// The batches and result sets sent with `MSG_ZEROCOPY`.
+    std::atomic<uint64_t> zero_copy_sends{0};
+    /// The bytes sent with `MSG_ZEROCOPY`.
+    std::atomic<uint64_t> zero_copy_bytes{0};
+    /// The zero-copy sends the kernel reported to have copied after all, which turns zero copy
+    /// off for their connection.
+    std::atomic<uint64_t> zero_copy_copied{0};
+};
+
+/**
+ * @class SocketWriter
+ * @brief Queues and sends the responses of one connection.
+ *
+ * @details The writer is used by the worker serving its connection only, and is not
+ * thread-safe. Every send is non-blocking; a full socket buffer is waited on with `poll`, for at
+ * most the timeout per wait, so the socket itself may be in blocking mode.
+ */
+class SocketWriter {
+  public:
+    SocketWriter() = default;
+
+    SocketWriter(const SocketWriter &) = delete;
+    SocketWriter &operator=(const SocketWriter &) = delete;
+
+    /**
+     * @brief Binds the writer to a socket and enables zero copy on it if requested.
+     * @param fd The connected socket.
+     * @param zero_copy_threshold The smallest send made with `MSG_ZEROCOPY`, or 0 to never use
+     *        it. It is also not used if the socket refuses `SO_ZEROCOPY`.
+     * @param stats The counters to update, which must outlive the writer.
+     */
+    void attach(int fd, size_t zero_copy_threshold, SendStats *stats);
+
+    /**
+     * @brief Queues a response.
+     * @param response The response payload, which the writer takes.
+     * @param framed `true` to prefix it with its length (see `framing.hpp`).
+     * @param compressed `true` to flag the frame as compressed (see `wire_compression.hpp`).
+     */
+    void queue(std::string response, bool framed, bool compressed = false);
+
+    /**
+     * @brief Returns the payload bytes of the queued responses.
+     * @return The sum of their sizes, without the frame headers.
+     */
+    [[nodiscard]] size_t queued_bytes() const noexcept { return queued_bytes_; }
+
+    /**
+     * @brief Sends the queued responses, in order, and empties the queue.
+     * @param timeout_ms The longest time to wait for the socket to become writable, or for the
+     *        kernel to release the buffers of a zero-copy send.
+     * @return `true` if every response was sent.
+     */
+    bool flush(int timeout_ms);
+
+    /**
+     * @brief Sends a list of buffers, after the queued responses.
+     * @param buffers The buffers to send, in order.
+     * @param size The total size of `buffers`.
+     * @param timeout_ms As for `flush`.
+     * @return `true` if every response and buffer was sent.
+     */
+    bool send(std::vector<struct iovec> buffers, size_t size, int timeout_ms);
+
+  private:
+    /**
+     * @struct Pending
+     * @brief A queued response.
+     */
+    struct Pending {
+        /// The length prefix, with the compression flag, if `framed`.
+        char header[FRAME_HEADER_SIZE];
+        /// `true` if `header` is sent before `body`.
+        bool framed;
+        /// The payload.
+        std::string body;
+    };
+
+    /**
+     * @brief Writes a list of buffers with `sendmsg`, with `MSG_ZEROCOPY` if they are large
+     * enough, and waits for the kernel to release them.
+     * @param buffers The buffers, consumed by the call.
+     * @param size The total size of `buffers`.
+     * @param timeout_ms As for `flush`.
+     * @return `true` if every byte was sent and, with zero copy, released.
+     */
+    bool write(std::vector<struct iovec> buffers, size_t size, int timeout_ms);
+
+    /**
+     * @brief Reads the socket's error queue until every zero-copy send has been released.
+     * @param timeout_ms The longest time to wait for a notification.
+     * @return `true` once the kernel holds no buffer of a zero-copy send.
+     */
+    bool await_zero_copy(int timeout_ms);
+
+    /// The socket.
+    int fd_{-1};
+    /// The smallest send made with `MSG_ZEROCOPY`; 0 once zero copy is off.
+    size_t zero_copy_threshold_{0};
+    /// The counters to update.
+    SendStats *stats_{nullptr};
+    /// The queued responses, in order.
+    std::vector<Pending> pending_;
+    /// The payload bytes of `pending_`.
+    size_t queued_bytes_{0};
+    /// The `MSG_ZEROCOPY` calls made on the socket, which the kernel numbers from 0.
+    uint32_t zero_copy_issued_{0};
+    /// The number of leading `MSG_ZEROCOPY` calls the kernel has released.
+    uint32_t zero_copy_released_{0};
+};
+
+}  // namespace aevum::net::server
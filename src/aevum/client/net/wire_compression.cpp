@@ -0,0 +1,339 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file wire_compression.cpp
+ * @brief Implements `WireCodec` and `WireDictionary` on lz4 and zstd.
+ */
+#include "aevum/client/net/wire_compression.hpp"
+
+#include <ctime>
+#include <utility>
+
+#if defined(AEVUM_HAVE_LZ4)
+#include <lz4.h>
+#endif
+#if defined(AEVUM_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace aevum::net {
+
+namespace {
+
+/// The size of the uncompressed size that precedes the compressed bytes.
+constexpr size_t UNCOMPRESSED_SIZE_BYTES = 4;
+
+/**
+ * @brief Reads the CPU time of the calling thread.
+ * @details Compression runs on the calling thread from start to end, so its CPU time is the
+ * difference of two readings, whatever else the process does meanwhile.
+ * @return The time, in nanoseconds.
+ */
+uint64_t thread_cpu_ns() noexcept {
+    struct timespec now{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the name of a compressor.
+ * @param compressor The compressor.
+ * @return Its name in the "hello" request.
+ */
+std::string_view wire_compressor_name(WireCompressor compressor) noexcept {
+    switch (compressor) {
+        case WireCompressor::LZ4:
+            return "lz4";
+        case WireCompressor::ZSTD:
+            return "zstd";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * @brief Parses the name of a compressor.
+ * @param name The name.
+ * @return The compressor, or `WireCompressor::NONE`.
+ */
+WireCompressor parse_wire_compressor(std::string_view name) noexcept {
+    if (name == "lz4") return WireCompressor::LZ4;
+    if (name == "zstd") return WireCompressor::ZSTD;
+    return WireCompressor::NONE;
+}
+
+/**
+ * @brief Reports whether a compressor was compiled in.
+ * @param compressor The compressor.
+ * @return `true` if it can be negotiated.
+ */
+bool wire_compressor_available(WireCompressor compressor) noexcept {
+    switch (compressor) {
+        case WireCompressor::LZ4:
+#if defined(AEVUM_HAVE_LZ4)
+            return true;
+#else
+            return false;
+#endif
+        case WireCompressor::ZSTD:
+#if defined(AEVUM_HAVE_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Returns the value of a field of a "hello" message.
+ * @param message The JSON message.
+ * @param key The name of the field.
+ * @return The string's characters or the number's digits, or an empty view.
+ */
+std::string_view hello_field(std::string_view message, std::string_view key) {
+    std::string pattern;
+    pattern.reserve(key.size() + 3);
+    pattern.append(1, '"').append(key).append("\":");
+    size_t at = message.find(pattern);
+    if (at == std::string_view::npos) return {};
+    size_t begin = at + pattern.size();
+    if (begin < message.size() && message[begin] == '"') {
+        size_t end = message.find('"', ++begin);
+        return end == std::string_view::npos ? std::string_view{}
+                                             : message.substr(begin, end - begin);
+    }
+    size_t end = begin;
+    while (end < message.size() && message[end] >= '0' && message[end] <= '9') ++end;
+    return message.substr(begin, end - begin);
+}
+
+/**
+ * @brief Digests a zstd dictionary for compression at a level and for decompression.
+ * @param bytes The dictionary.
+ * @param level The compression level.
+ * @param out Receives the dictionary.
+ * @return `aevum::util::Status::OK()`, `NotSupported`, or `InvalidArgument`.
+ */
+aevum::util::Status WireDictionary::load(std::string_view bytes, int level,
+                                         std::shared_ptr<const WireDictionary> &out) {
+#if defined(AEVUM_HAVE_ZSTD)
+    // A raw-content dictionary has no id to recognize it by.
+    uint32_t id = ZSTD_getDictID_fromDict(bytes.data(), bytes.size());
+    if (id == 0) {
+        return aevum::util::Status::InvalidArgument("not a zstd dictionary (no dictionary id)");
+    }
+    std::shared_ptr<WireDictionary> dictionary(new WireDictionary());
+    dictionary->id_ = id;
+    dictionary->compression_ = ZSTD_createCDict(bytes.data(), bytes.size(), level);
+    dictionary->decompression_ = ZSTD_createDDict(bytes.data(), bytes.size());
+    if (dictionary->compression_ == nullptr || dictionary->decompression_ == nullptr) {
+        return aevum::util::Status::InvalidArgument("zstd could not digest the dictionary");
+    }
+    out = std::move(dictionary);
+    return aevum::util::Status::OK();
+#else
+    (void)bytes;
+    (void)level;
+    (void)out;
+    return aevum::util::Status::NotSupported("zstd is not compiled in");
+#endif
+}
+
+/**
+ * @brief Frees the digested dictionary.
+ */
+WireDictionary::~WireDictionary() {
+#if defined(AEVUM_HAVE_ZSTD)
+    ZSTD_freeCDict(compression_);
+    ZSTD_freeDDict(decompression_);
+#endif
+}
+
+/**
+ * @brief Frees the compression state and contexts.
+ */
+WireCodec::~WireCodec() { reset(); }
+
+/**
+ * @brief Frees the compression state and contexts and turns the codec off.
+ */
+void WireCodec::reset() noexcept {
+#if defined(AEVUM_HAVE_ZSTD)
+    ZSTD_freeCCtx(zstd_compression_);
+    ZSTD_freeDCtx(zstd_decompression_);
+#endif
+    zstd_compression_ = nullptr;
+    zstd_decompression_ = nullptr;
+    lz4_state_.reset();
+    dictionary_.reset();
+    compressor_ = WireCompressor::NONE;
+}
+
+/**
+ * @brief Selects the compressor and allocates the state it reuses for every frame.
+ * @param compressor The compressor, or `WireCompressor::NONE`.
+ * @param threshold The smallest payload compressed.
+ * @param level The zstd compression level.
+ * @param dictionary The zstd dictionary, or null.
+ * @param stats The counters to update, or null.
+ * @return `aevum::util::Status::OK()`, or `NotSupported`.
+ */
+aevum::util::Status WireCodec::configure(WireCompressor compressor, size_t threshold, int level,
+                                         std::shared_ptr<const WireDictionary> dictionary,
+                                         CompressionStats *stats) {
+    reset();
+    if (!wire_compressor_available(compressor)) {
+        return aevum::util::Status::NotSupported(std::string(wire_compressor_name(compressor)) +
+                                                 " is not compiled in");
+    }
+    threshold_ = threshold;
+    level_ = level;
+    stats_ = stats;
+#if defined(AEVUM_HAVE_LZ4)
+    if (compressor == WireCompressor::LZ4) {
+        size_t words = (static_cast<size_t>(LZ4_sizeofState()) + 7) / 8;
+        lz4_state_.reset(new uint64_t[words]);
+    }
+#endif
+#if defined(AEVUM_HAVE_ZSTD)
+    if (compressor == WireCompressor::ZSTD) {
+        zstd_compression_ = ZSTD_createCCtx();
+        zstd_decompression_ = ZSTD_createDCtx();
+        if (zstd_compression_ == nullptr || zstd_decompression_ == nullptr) {
+            reset();
+            return aevum::util::Status::NotSupported("zstd could not allocate its contexts");
+        }
+    }
+#endif
+    if (compressor == WireCompressor::ZSTD) dictionary_ = std::move(dictionary);
+    compressor_ = compressor;
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Compresses a payload into a frame body.
+ * @details The body is sized for the compressor's worst case, compressed into, and cut to the
+ * compressed size. A payload that does not shrink by at least its uncompressed-size prefix is
+ * sent as it is, which costs the receiver nothing.
+ * @param payload The payload.
+ * @param body Receives the body.
+ * @return `true` if `body` holds the compressed frame's payload.
+ */
+bool WireCodec::compress(std::string_view payload, std::string &body) {
+    if (compressor_ == WireCompressor::NONE || payload.size() < threshold_ ||
+        payload.size() > UINT32_MAX) {
+        return false;
+    }
+    uint64_t start = thread_cpu_ns();
+    size_t compressed = 0;
+#if defined(AEVUM_HAVE_LZ4)
+    if (compressor_ == WireCompressor::LZ4 && payload.size() <= LZ4_MAX_INPUT_SIZE) {
+        int bound = LZ4_compressBound(static_cast<int>(payload.size()));
+        body.resize(UNCOMPRESSED_SIZE_BYTES + static_cast<size_t>(bound));
+        int n = LZ4_compress_fast_extState(lz4_state_.get(), payload.data(),
+                                           body.data() + UNCOMPRESSED_SIZE_BYTES,
+                                           static_cast<int>(payload.size()), bound, 1);
+        compressed = n > 0 ? static_cast<size_t>(n) : 0;
+    }
+#endif
+#if defined(AEVUM_HAVE_ZSTD)
+    if (compressor_ == WireCompressor::ZSTD) {
+        body.resize(UNCOMPRESSED_SIZE_BYTES + ZSTD_compressBound(payload.size()));
+        char *out = body.data() + UNCOMPRESSED_SIZE_BYTES;
+        size_t capacity = body.size() - UNCOMPRESSED_SIZE_BYTES;
+        size_t n = dictionary_ != nullptr
+                       ? ZSTD_compress_usingCDict(zstd_compression_, out, capacity, payload.data(),
+                                                  payload.size(), dictionary_->compression_)
+                       : ZSTD_compressCCtx(zstd_compression_, out, capacity, payload.data(),
+                                           payload.size(), level_);
+        compressed = ZSTD_isError(n) ? 0 : n;
+    }
+#endif
+    bool shrunk = compressed > 0 && compressed + UNCOMPRESSED_SIZE_BYTES < payload.size();
+    if (stats_ != nullptr) {
+        stats_->compress_cpu_ns += thread_cpu_ns() - start;
+        if (shrunk) {
+            ++stats_->frames_compressed;
+            stats_->bytes_before_compression += payload.size();
+            stats_->bytes_after_compression += compressed + UNCOMPRESSED_SIZE_BYTES;
+        } else {
+            ++stats_->frames_incompressible;
+        }
+    }
+    if (!shrunk) return false;
+
+    auto size = static_cast<uint32_t>(payload.size());
+    body[0] = static_cast<char>(size >> 24);
+    body[1] = static_cast<char>(size >> 16);
+    body[2] = static_cast<char>(size >> 8);
+    body[3] = static_cast<char>(size);
+    body.resize(UNCOMPRESSED_SIZE_BYTES + compressed);
+    return true;
+}
+
+/**
+ * @brief Decompresses a frame body.
+ * @details The uncompressed size is checked against the limit before anything is allocated, so
+ * a small frame cannot make the receiver reserve gigabytes, and the decompressor must produce
+ * exactly that size.
+ * @param body The frame's payload.
+ * @param max_size The largest uncompressed size accepted.
+ * @param payload Receives the uncompressed payload.
+ * @return `aevum::util::Status::OK()`, or `Corruption`.
+ */
+aevum::util::Status WireCodec::decompress(std::string_view body, size_t max_size,
+                                          std::string &payload) {
+    if (compressor_ == WireCompressor::NONE) {
+        return aevum::util::Status::Corruption("compressed frame on an uncompressed connection");
+    }
+    if (body.size() < UNCOMPRESSED_SIZE_BYTES) {
+        return aevum::util::Status::Corruption("truncated compressed frame");
+    }
+    const auto *header = reinterpret_cast<const unsigned char *>(body.data());
+    size_t size = (size_t{header[0]} << 24) | (size_t{header[1]} << 16) |
+                  (size_t{header[2]} << 8) | size_t{header[3]};
+    if (size > max_size) {
+        return aevum::util::Status::Corruption("compressed frame exceeds the maximum size");
+    }
+    std::string_view compressed = body.substr(UNCOMPRESSED_SIZE_BYTES);
+    uint64_t start = thread_cpu_ns();
+    payload.resize(size);
+    bool intact = false;
+#if defined(AEVUM_HAVE_LZ4)
+    if (compressor_ == WireCompressor::LZ4 && compressed.size() <= INT32_MAX) {
+        int n = LZ4_decompress_safe(compressed.data(), payload.data(),
+                                    static_cast<int>(compressed.size()), static_cast<int>(size));
+        intact = n >= 0 && static_cast<size_t>(n) == size;
+    }
+#endif
+#if defined(AEVUM_HAVE_ZSTD)
+    if (compressor_ == WireCompressor::ZSTD) {
+        size_t n = dictionary_ != nullptr
+                       ? ZSTD_decompress_usingDDict(zstd_decompression_, payload.data(), size,
+                                                    compressed.data(), compressed.size(),
+                                                    dictionary_->decompression_)
+                       : ZSTD_decompressDCtx(zstd_decompression_, payload.data(), size,
+                                             compressed.data(), compressed.size());
+        intact = !ZSTD_isError(n) && n == size;
+    }
+#endif
+#if !defined(AEVUM_HAVE_LZ4) && !defined(AEVUM_HAVE_ZSTD)
+    (void)compressed;
+#endif
+    if (!intact) return aevum::util::Status::Corruption("compressed frame is corrupt");
+    if (stats_ != nullptr) {
+        stats_->decompress_cpu_ns += thread_cpu_ns() - start;
+        ++stats_->frames_decompressed;
+        stats_->bytes_before_decompression += body.size();
+        stats_->bytes_after_decompression += size;
+    }
+    return aevum::util::Status::OK();
+}
+
+}  // namespace aevum::net
@@ -0,0 +1,235 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file wire_compression.hpp
+ * @brief Declares the compression of frames between the server and its clients.
+ * @details A client asks for a compressor in its "hello" request, e.g.
+ * `{"action":"hello","compression":"zstd","dictionary":<id>}`, and the server answers with the
+ * compressor it agreed to, `"compression":"none"` if it has none in common with the client, and
+ * the dictionary id if it holds the same zstd dictionary. From then on, either side may send any
+ * frame whose payload is at least its threshold compressed: the high bit of the length prefix is
+ * set (see `COMPRESSED_FRAME_FLAG`), and the payload is the uncompressed size, 4 bytes
+ * big-endian, followed by the compressed bytes. Smaller frames, and frames that do not shrink,
+ * are sent as they are. lz4 compresses and decompresses at several GB/s and suits latency-bound
+ * traffic; zstd compresses verbose result sets far better, and with a dictionary trained on the
+ * documents even small ones.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "aevum/util/status.hpp"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace aevum::net {
+
+/**
+ * @enum WireCompressor
+ * @brief The compressors a connection may negotiate.
+ */
+enum class WireCompressor : uint8_t {
+    /// Frames are sent as they are.
+    NONE = 0,
+    /// lz4, for latency-bound traffic.
+    LZ4 = 1,
+    /// zstd, optionally with a dictionary, for bulk traffic.
+    ZSTD = 2
+};
+
+/**
+ * @brief Returns the name of a compressor, as used in the "hello" request.
+ * @param compressor The compressor.
+ * @return `"none"`, `"lz4"`, or `"zstd"`.
+ */
+[[nodiscard]] std::string_view wire_compressor_name(WireCompressor compressor) noexcept;
+
+/**
+ * @brief Parses the name of a compressor.
+ * @param name The name.
+ * @return The compressor, or `WireCompressor::NONE` if the name is unknown.
+ */
+[[nodiscard]] WireCompressor parse_wire_compressor(std::string_view name) noexcept;
+
+/**
+ * @brief Reports whether a compressor was compiled in.
+ * @param compressor The compressor.
+ * @return `true` if the build links its library; always `true` for `WireCompressor::NONE`.
+ */
+[[nodiscard]] bool wire_compressor_available(WireCompressor compressor) noexcept;
+
+/**
+ * @brief Returns the value of a field of a "hello" request or response.
+ * @details The messages are flat JSON objects written by the server and client themselves, so
+ * the field is located by its quoted name, as the server locates the request's action.
+ * @param message The JSON message.
+ * @param key The name of the field.
+ * @return The string's characters or the number's digits, or an empty view if it is absent.
+ */
+[[nodiscard]] std::string_view hello_field(std::string_view message, std::string_view key);
+
+/**
+ * @struct CompressionStats
+ * @brief The counters of the codecs of every connection of a server.
+ */
+struct CompressionStats {
+    /// The connections that negotiated a compressor.
+    std::atomic<uint64_t> connections{0};
+    /// The frames sent compressed.
+    std::atomic<uint64_t> frames_compressed{0};
+    /// Their payload bytes before compression.
+    std::atomic<uint64_t> bytes_before_compression{0};
+    /// Their payload bytes after compression.
+    std::atomic<uint64_t> bytes_after_compression{0};
+    /// The frames at least the threshold that were sent as they are, because they did not shrink.
+    std::atomic<uint64_t> frames_incompressible{0};
+    /// The CPU time spent compressing, in nanoseconds, including incompressible frames.
+    std::atomic<uint64_t> compress_cpu_ns{0};
+    /// The compressed frames received.
+    std::atomic<uint64_t> frames_decompressed{0};
+    /// Their payload bytes as received.
+    std::atomic<uint64_t> bytes_before_decompression{0};
+    /// Their payload bytes after decompression.
+    std::atomic<uint64_t> bytes_after_decompression{0};
+    /// The CPU time spent decompressing, in nanoseconds.
+    std::atomic<uint64_t> decompress_cpu_ns{0};
+};
+
+/**
+ * @class WireDictionary
+ * @brief A zstd dictionary, digested once and shared by every connection that uses it.
+ *
+ * @details A dictionary is made by `zstd --train` from samples of the traffic, such as the
+ * documents of the collections that bulk clients read. Both sides must hold the same one; they
+ * recognize it by the id zstd stores in it. The digested forms are read-only, so connections on
+ * any thread use them at once.
+ */
+class WireDictionary {
+  public:
+    /**
+     * @brief Digests a dictionary.
+     * @param bytes The dictionary, as written by `zstd --train`.
+     * @param level The compression level it is digested for.
+     * @param out Receives the dictionary.
+     * @return `aevum::util::Status::OK()`, `NotSupported` without zstd, or `InvalidArgument` if
+     *         the bytes are not a zstd dictionary.
+     */
+    [[nodiscard]] static aevum::util::Status load(std::string_view bytes, int level,
+                                                  std::shared_ptr<const WireDictionary> &out);
+
+    ~WireDictionary();
+
+    WireDictionary(const WireDictionary &) = delete;
+    WireDictionary &operator=(const WireDictionary &) = delete;
+
+    /**
+     * @brief Returns the id zstd stores in the dictionary.
+     * @return The id, never 0.
+     */
+    [[nodiscard]] uint32_t id() const noexcept { return id_; }
+
+  private:
+    friend class WireCodec;
+
+    WireDictionary() = default;
+
+    /// The id of the dictionary.
+    uint32_t id_{0};
+    /// The dictionary digested for compression.
+    ZSTD_CDict_s *compression_{nullptr};
+    /// The dictionary digested for decompression.
+    ZSTD_DDict_s *decompression_{nullptr};
+};
+
+/**
+ * @class WireCodec
+ * @brief Compresses and decompresses the frames of one connection.
+ *
+ * @details The compression state of lz4 and the contexts of zstd are allocated when the codec
+ * is configured and reused by every frame, so a frame costs no allocation beyond its output
+ * buffer, which the caller may reuse as well. The codec is used by one thread at a time.
+ */
+class WireCodec {
+  public:
+    WireCodec() = default;
+    ~WireCodec();
+
+    WireCodec(const WireCodec &) = delete;
+    WireCodec &operator=(const WireCodec &) = delete;
+
+    /**
+     * @brief Selects the compressor of the connection and allocates its state.
+     * @param compressor The negotiated compressor, or `WireCompressor::NONE` to turn it off.
+     * @param threshold The smallest payload compressed, in bytes.
+     * @param level The zstd compression level; ignored by lz4.
+     * @param dictionary The zstd dictionary both sides hold, or null.
+     * @param stats The counters to update, or null.
+     * @return `aevum::util::Status::OK()`, or `NotSupported` if the compressor is not compiled
+     *         in, in which case the codec is off.
+     */
+    [[nodiscard]] aevum::util::Status configure(WireCompressor compressor, size_t threshold,
+                                                int level,
+                                                std::shared_ptr<const WireDictionary> dictionary,
+                                                CompressionStats *stats);
+
+    /**
+     * @brief Turns the codec off and frees its state, as for a new connection.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns the compressor of the connection.
+     * @return The compressor, `WireCompressor::NONE` while the codec is off.
+     */
+    [[nodiscard]] WireCompressor compressor() const noexcept { return compressor_; }
+
+    /**
+     * @brief Compresses a payload if it is large enough and shrinks.
+     * @param payload The payload.
+     * @param body Receives the compressed frame's payload; its capacity is reused.
+     * @return `true` if `body` should be sent instead of `payload`, with the frame flagged as
+     *         compressed.
+     */
+    bool compress(std::string_view payload, std::string &body);
+
+    /**
+     * @brief Decompresses the payload of a frame flagged as compressed.
+     * @param body The frame's payload.
+     * @param max_size The largest uncompressed size accepted.
+     * @param payload Receives the uncompressed payload; its capacity is reused.
+     * @return `aevum::util::Status::OK()`, or `Corruption` if the body is corrupt, claims more
+     *         than `max_size` bytes, or arrives while the codec is off.
+     */
+    [[nodiscard]] aevum::util::Status decompress(std::string_view body, size_t max_size,
+                                                 std::string &payload);
+
+  private:
+    /// The compressor of the connection.
+    WireCompressor compressor_{WireCompressor::NONE};
+    /// The smallest payload compressed.
+    size_t threshold_{0};
+    /// The zstd compression level.
+    int level_{0};
+    /// The zstd dictionary, or null.
+    std::shared_ptr<const WireDictionary> dictionary_;
+    /// The counters to update, or null.
+    CompressionStats *stats_{nullptr};
+    /// The lz4 compression state, 8-byte aligned as lz4 requires.
+    std::unique_ptr<uint64_t[]> lz4_state_;
+    /// The zstd compression context.
+    ZSTD_CCtx_s *zstd_compression_{nullptr};
+    /// The zstd decompression context.
+    ZSTD_DCtx_s *zstd_decompression_{nullptr};
+};
+
+}  // namespace aevum::net
@@ -6,20 +6,47 @@
  * @file auth_manager.cpp
  * @brief Implements the high-concurrency `AuthManager` class for handling user authentication.
  * @details This file provides the concrete implementations for the methods declared in
- * `auth_manager.hpp`. It leverages a `std::shared_mutex` to achieve a highly efficient
- * reader-writer lock pattern, optimizing for frequent authentication checks while ensuring safe,
- * atomic updates to the credential cache.
+ * `auth_manager.hpp`. It leverages an `RWSpinlock` to achieve a highly efficient reader-writer
+ * lock pattern, optimizing for frequent authentication checks while ensuring safe, atomic updates
+ * to the credential cache.
  */
 #include "aevum/db/auth/auth_manager.hpp"
 
 #include <mutex>
 #include <shared_mutex>
 
+#include "aevum/util/crypto/secure_random.hpp"
+#include "aevum/util/crypto/sha256.hpp"
 #include "aevum/util/hash/djb2.hpp"
 #include "aevum/util/log/logger.hpp"
 
 namespace aevum::db::auth {
 
+namespace {
+
+/// The length of a verifier's salt, in bytes.
+constexpr size_t KDF_SALT_SIZE = 16;
+
+}  // namespace
+
+/**
+ * @brief Creates the credential of a new user, with a fresh salt.
+ * @details The salt comes from the system's secure generator, so that two users with the same
+ * key have different verifiers.
+ * @param raw_key The plain-text API key of the user.
+ * @param role The role of the user.
+ * @return The credential.
+ */
+Credential make_credential(std::string_view raw_key, UserRole role) {
+    Credential credential;
+    credential.role = role;
+    credential.kdf_salt = aevum::util::crypto::secure_random_bytes(KDF_SALT_SIZE);
+    credential.kdf_iterations = KDF_ITERATIONS;
+    credential.kdf_key = aevum::util::crypto::pbkdf2_sha256(
+        raw_key, credential.kdf_salt, KDF_ITERATIONS, aevum::util::crypto::SHA256_DIGEST_SIZE);
+    return credential;
+}
+
 /**
  * @brief Validates a raw, plain-text API key by hashing and checking it against the in-memory
  * cache.
@@ -36,6 +63,10 @@ namespace aevum::db::auth {
  * `UserRole` is returned. If no match is found after scanning the cache, `UserRole::NONE` is
  * returned to signify authentication failure.
  *
+ * The raw key is a transition path for users created before verifiers, and for clients that
+ * cannot keep a session: with `require_sessions_`, a user that has a verifier is refused here,
+ * since a DJB2 match would otherwise bypass its PBKDF2 check.
+ *
  * @param raw_key A `std::string_view` representing the untrusted, plain-text API key from a client.
  * @return The `UserRole` associated with the key if the authentication is successful;
  *         `UserRole::NONE` if the key is empty, unknown, or invalid.
@@ -52,12 +83,14 @@ UserRole AuthManager::authenticate(std::string_view raw_key) const {
 
     // Acquire a shared (read) lock to allow for maximum concurrency during authentication checks.
     // This lock allows multiple threads to read from the auth_cache_ simultaneously.
-    std::shared_lock<std::shared_mutex> read_lock(rw_lock_);
+    std::shared_lock<aevum::util::concurrency::RWSpinlock> read_lock(rw_lock_);
 
     auto it = auth_cache_.find(hashed_attempt);
     if (it != auth_cache_.end()) {
-        // A matching hashed key was found; return its associated privilege level.
-        return it->second;
+        // A matching hashed key was found; return its associated privilege level, unless the
+        // user has a verifier and must prove its key through `login`.
+        if (require_sessions_ && !it->second.kdf_key.empty()) return UserRole::NONE;
+        return it->second.role;
     }
 
     // If the loop completes without a match, the key is not in the cache.
@@ -80,8 +113,45 @@ UserRole AuthManager::authenticate(std::string_view raw_key) const {
 void AuthManager::add_user(std::string hashed_key, UserRole role) {
     // Acquire a unique (exclusive) lock for writing. This blocks all other read and write
     // operations, ensuring the atomicity of the cache modification.
-    std::unique_lock<std::shared_mutex> write_lock(rw_lock_);
-    auth_cache_.emplace(std::move(hashed_key), role);
+    std::unique_lock<aevum::util::concurrency::RWSpinlock> write_lock(rw_lock_);
+    auth_cache_.emplace(std::move(hashed_key), Credential{role, {}, {}, 0});
+}
+
+/**
+ * @brief Adds a user with the verifier of its credential.
+ * @param hashed_key The DJB2-hashed representation of the user's API key.
+ * @param credential The role and verifier of the user.
+ */
+void AuthManager::add_user(std::string hashed_key, Credential credential) {
+    std::unique_lock<aevum::util::concurrency::RWSpinlock> write_lock(rw_lock_);
+    auth_cache_.emplace(std::move(hashed_key), std::move(credential));
+}
+
+/**
+ * @brief Verifies a raw API key with the key derivation function, for a session.
+ * @details The DJB2 hash only locates the user: the credential is copied out under the shared
+ * lock, and the key is then derived with the user's salt and iterations and compared with the
+ * verifier in constant time. A user without a verifier is accepted on the DJB2 match, as its
+ * requests are.
+ * @param raw_key The plain-text API key submitted by the client.
+ * @return The role of the user, or `UserRole::NONE` if the key does not verify.
+ */
+UserRole AuthManager::login(std::string_view raw_key) const {
+    if (raw_key.empty()) return UserRole::NONE;
+    std::string hashed_attempt = aevum::util::hash::djb2_string(raw_key);
+    Credential credential;
+    {
+        std::shared_lock<aevum::util::concurrency::RWSpinlock> read_lock(rw_lock_);
+        auto it = auth_cache_.find(hashed_attempt);
+        if (it == auth_cache_.end()) return UserRole::NONE;
+        credential = it->second;
+    }
+    if (credential.kdf_key.empty()) return credential.role;
+    std::string derived = aevum::util::crypto::pbkdf2_sha256(
+        raw_key, credential.kdf_salt, credential.kdf_iterations, credential.kdf_key.size());
+    return aevum::util::crypto::constant_time_equal(derived, credential.kdf_key)
+               ? credential.role
+               : UserRole::NONE;
 }
 
 /**
@@ -94,7 +164,7 @@ void AuthManager::add_user(std::string hashed_key, UserRole role) {
  */
 bool AuthManager::empty() const noexcept {
     // Acquire a shared (read) lock to safely check the cache's size.
-    std::shared_lock<std::shared_mutex> read_lock(rw_lock_);
+    std::shared_lock<aevum::util::concurrency::RWSpinlock> read_lock(rw_lock_);
     return auth_cache_.empty();
 }
 
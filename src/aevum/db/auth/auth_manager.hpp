@@ -14,12 +14,13 @@
  */
 #pragma once
 
-#include <shared_mutex>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 
 #include "aevum/db/auth/role.hpp"
+#include "aevum/util/concurrency/rw_spinlock.hpp"
 
 /**
  * @namespace aevum::db::auth
@@ -28,17 +29,50 @@
  */
 namespace aevum::db::auth {
 
+/// The PBKDF2 iterations of the verifiers of new users.
+constexpr uint32_t KDF_ITERATIONS = 100000;
+
+/// The most PBKDF2 iterations a stored verifier may ask for; a larger count is treated as damage,
+/// since a single `login` would otherwise hold a worker for minutes.
+constexpr int64_t MAX_KDF_ITERATIONS = 10000000;
+
+/**
+ * @struct Credential
+ * @brief The role of a user and the verifier its `login` is checked against.
+ * @details Users created before verifiers were introduced have an empty `kdf_key`; their logins
+ * are checked against the DJB2 hash of their key alone, as their requests are.
+ */
+struct Credential {
+    /// The role of the user.
+    UserRole role{UserRole::NONE};
+    /// The random salt of the verifier, as raw bytes.
+    std::string kdf_salt;
+    /// The PBKDF2-HMAC-SHA-256 of the key with `kdf_salt`, as raw bytes, or empty.
+    std::string kdf_key;
+    /// The PBKDF2 iterations of `kdf_key`.
+    uint32_t kdf_iterations{0};
+};
+
+/**
+ * @brief Creates the credential of a new user, with a fresh salt.
+ * @details This runs the key derivation function once, which is deliberately slow.
+ * @param raw_key The plain-text API key of the user.
+ * @param role The role of the user.
+ * @return The credential.
+ */
+[[nodiscard]] Credential make_credential(std::string_view raw_key, UserRole role);
+
 /**
  * @class AuthManager
  * @brief A high-throughput, thread-safe manager for an in-memory cache of hashed API keys
  * and their associated user roles.
  *
  * @details The `AuthManager` serves as the gatekeeper for user authentication. It is designed for
- * high-concurrency environments where authentication checks are frequent. By employing a
- * `std::shared_mutex`, it optimizes for read-heavy workloads, allowing numerous `authenticate`
- * calls to proceed in parallel without contention. Write operations, such as adding a new user
- * via `add_user`, acquire an exclusive lock to ensure the atomicity and consistency of the
- * underlying cache.
+ * high-concurrency environments where authentication checks are frequent. By employing an
+ * `aevum::util::concurrency::RWSpinlock`, it optimizes for read-heavy workloads, allowing numerous
+ * `authenticate` calls to proceed in parallel without contention. Write operations, such as adding
+ * a new user via `add_user`, acquire an exclusive lock to ensure the atomicity and consistency of
+ * the underlying cache.
  *
  * To enhance security, all API keys are stored in a hashed representation within an
  * `std::unordered_map`. This prevents plain-text credentials from ever residing in memory
@@ -54,6 +88,13 @@ class AuthManager {
      */
     AuthManager() = default;
 
+    /**
+     * @brief Constructs an empty `AuthManager` that may require sessions.
+     * @param require_sessions `true` to refuse the raw key of every user with a PBKDF2 verifier
+     *        in `authenticate`, so that such users are only authorized through `login`.
+     */
+    explicit AuthManager(bool require_sessions) noexcept : require_sessions_(require_sessions) {}
+
     /**
      * @brief Default destructor.
      * @details Cleans up all resources held by the `AuthManager`, including the user cache.
@@ -86,7 +127,7 @@ class AuthManager {
      *        The view provides an efficient, non-owning reference to the key data.
      * @return The corresponding `UserRole` if the hashed key is found in the cache and is valid.
      * @return `UserRole::NONE` if the key is empty, not found, or otherwise invalid, effectively
-     *         denying access.
+     *         denying access, or if sessions are required and the user has a verifier.
      */
     [[nodiscard]] UserRole authenticate(std::string_view raw_key) const;
 
@@ -105,6 +146,23 @@ class AuthManager {
      */
     void add_user(std::string hashed_key, UserRole role);
 
+    /**
+     * @brief Adds a user with the verifier of its credential.
+     * @param hashed_key The DJB2-hashed representation of the user's API key.
+     * @param credential The role and verifier of the user.
+     */
+    void add_user(std::string hashed_key, Credential credential);
+
+    /**
+     * @brief Verifies a raw API key with the key derivation function, for a session.
+     * @details Unlike `authenticate`, this runs PBKDF2 over the key, which takes in the order of
+     * a hundred milliseconds, so that a connection pays for a strong check once and is then
+     * authorized from its session. The cache is only locked for the lookup, not the derivation.
+     * @param raw_key The plain-text API key submitted by the client.
+     * @return The role of the user, or `UserRole::NONE` if the key does not verify.
+     */
+    [[nodiscard]] UserRole login(std::string_view raw_key) const;
+
     /**
      * @brief Performs a thread-safe check to determine if the authentication cache is empty.
      * @details This function is useful for determining if the database needs to bootstrap a default
@@ -118,18 +176,24 @@ class AuthManager {
     /**
      * @var auth_cache_
      * @brief The core data structure for the authentication cache. It is an unordered map that
-     * provides average O(1) lookup time, mapping a DJB2-hashed API key string to a `UserRole` enum.
+     * provides average O(1) lookup time, mapping a DJB2-hashed API key string to the user's
+     * `Credential`.
      */
-    std::unordered_map<std::string, UserRole> auth_cache_;
+    std::unordered_map<std::string, Credential> auth_cache_;
 
     /**
      * @var rw_lock_
-     * @brief A mutable reader-writer mutex that provides granular, thread-safe access to
+     * @brief A mutable reader-writer spinlock that provides granular, thread-safe access to
      * `auth_cache_`. It allows multiple concurrent readers (`authenticate`, `empty`) but ensures
      * that writers (`add_user`) have exclusive access, preventing data races and ensuring cache
-     * integrity. It is marked `mutable` to allow locking within `const` member functions.
+     * integrity. A spinlock suits the single hash lookup it guards, which admits a reader with one
+     * atomic add instead of the internal lock of `std::shared_mutex`. It is marked `mutable` to
+     * allow locking within `const` member functions.
      */
-    mutable std::shared_mutex rw_lock_;
+    mutable aevum::util::concurrency::RWSpinlock rw_lock_;
+
+    /// `true` if a user with a verifier is refused its raw key and must open a session.
+    bool require_sessions_{false};
 };
 
 }  // namespace aevum::db::auth
@@ -57,13 +57,14 @@ bool has_permission(UserRole role, std::string_view action) noexcept {
     // The `UserRole::READ_WRITE` is permitted to execute the full suite of standard CRUD
     // operations.
     if (role == UserRole::READ_WRITE) {
-        return action == "find" || action == "count" || action == "insert" || action == "update" ||
-               action == "upsert" || action == "delete";
+        return action == "find" || action == "count" || action == "explain" ||
+               action == "insert" || action == "update" || action == "upsert" ||
+               action == "delete";
     }
 
     // The `UserRole::READ_ONLY` is restricted to non-mutating data query operations.
     if (role == UserRole::READ_ONLY) {
-        return action == "find" || action == "count";
+        return action == "find" || action == "count" || action == "explain";
     }
 
     // A fall-through case ensures that any future, unhandled roles will default to denying
@@ -0,0 +1,380 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file change_log.cpp
+ * @brief Implements `ChangeLog`, the capped log of document changes.
+ * @details A record is stored as the key `<sequence><type><collection>\x01<_id>`, the sequence
+ * number as 16 lowercase hexadecimal digits so that the byte-wise order of the keys is the order
+ * of the numbers, and the type as the character of its `ChangeType`.
+ */
+#include "aevum/db/core/change_log.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db {
+
+namespace {
+
+/// The number of hexadecimal digits of an encoded sequence number.
+constexpr size_t SEQUENCE_DIGITS = 16;
+/// Separates the collection from the `_id` in a key.
+constexpr char ID_SEPARATOR = '\x01';
+/// The most records one trimming transaction removes.
+constexpr size_t TRIM_BATCH = 4096;
+
+/**
+ * @brief Encodes a sequence number as the fixed-width prefix of a key.
+ * @param sequence The sequence number.
+ * @return The 16 hexadecimal digits.
+ */
+std::string encode_sequence(uint64_t sequence) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string out(SEQUENCE_DIGITS, '0');
+    for (size_t i = SEQUENCE_DIGITS; i-- > 0; sequence >>= 4) out[i] = DIGITS[sequence & 0xf];
+    return out;
+}
+
+/**
+ * @brief Decodes the sequence number at the start of a key.
+ * @param key The key.
+ * @return The sequence number, or `std::nullopt` if the key does not start with one.
+ */
+std::optional<uint64_t> decode_sequence(std::string_view key) {
+    if (key.size() < SEQUENCE_DIGITS) return std::nullopt;
+    uint64_t sequence = 0;
+    for (size_t i = 0; i < SEQUENCE_DIGITS; ++i) {
+        char c = key[i];
+        uint64_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint64_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<uint64_t>(c - 'a' + 10);
+        } else {
+            return std::nullopt;
+        }
+        sequence = (sequence << 4) | digit;
+    }
+    return sequence;
+}
+
+/**
+ * @brief Decodes a key into a record.
+ * @param key The key.
+ * @param change Receives the record.
+ * @return `false` if the key is malformed.
+ */
+bool decode_change(std::string_view key, Change &change) {
+    auto sequence = decode_sequence(key);
+    if (!sequence || key.size() < SEQUENCE_DIGITS + 1) return false;
+    char type = key[SEQUENCE_DIGITS];
+    if (type != static_cast<char>(ChangeType::INSERT) &&
+        type != static_cast<char>(ChangeType::UPDATE) &&
+        type != static_cast<char>(ChangeType::DELETE)) {
+        return false;
+    }
+    std::string_view rest = key.substr(SEQUENCE_DIGITS + 1);
+    size_t separator = rest.find(ID_SEPARATOR);
+    if (separator == std::string_view::npos) return false;
+    change.sequence = *sequence;
+    change.type = static_cast<ChangeType>(type);
+    change.collection.assign(rest.substr(0, separator));
+    change.id.assign(rest.substr(separator + 1));
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the name of a kind of change.
+ * @param type The kind of change.
+ * @return `"insert"`, `"update"`, or `"delete"`.
+ */
+const char *change_type_name(ChangeType type) noexcept {
+    switch (type) {
+        case ChangeType::INSERT:
+            return "insert";
+        case ChangeType::UPDATE:
+            return "update";
+        case ChangeType::DELETE:
+            return "delete";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Releases the numbers of the reservation.
+ */
+ChangeLog::Reservation::~Reservation() {
+    if (log_) log_->release(first_, committed_ ? used_ : 0);
+}
+
+/**
+ * @brief Takes over the numbers of another reservation, which is left empty.
+ * @param other The reservation.
+ */
+ChangeLog::Reservation::Reservation(Reservation &&other) noexcept
+    : log_(std::exchange(other.log_, nullptr)),
+      first_(other.first_),
+      count_(other.count_),
+      used_(other.used_),
+      committed_(other.committed_) {}
+
+/**
+ * @brief Appends the record of a change, under the next reserved number, to the key writes of the
+ * batch.
+ * @param key_writes The key writes of the batch.
+ * @param type The kind of change.
+ * @param collection The collection of the document.
+ * @param id The `_id` of the document.
+ */
+void ChangeLog::Reservation::append(std::vector<storage::KeyWrite> &key_writes, ChangeType type,
+                                    std::string_view collection, std::string_view id) {
+    if (!log_ || used_ == count_) return;
+    std::string key = encode_sequence(first_ + used_++);
+    key.reserve(SEQUENCE_DIGITS + 2 + collection.size() + id.size());
+    key.push_back(static_cast<char>(type));
+    key.append(collection).push_back(ID_SEPARATOR);
+    key.append(id);
+    key_writes.push_back({std::string(TABLE), std::move(key), false});
+}
+
+/**
+ * @brief Constructs a log over a store.
+ * @param storage The store holding `TABLE`.
+ * @param capacity The records retained, or 0 to record no changes.
+ */
+ChangeLog::ChangeLog(storage::WiredTigerStore &storage, size_t capacity)
+    : storage_(storage), capacity_(capacity) {}
+
+/**
+ * @brief Stops the trimmer thread and wakes every waiting reader.
+ */
+ChangeLog::~ChangeLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    trim_cv_.notify_all();
+    change_cv_.notify_all();
+    if (trimmer_.joinable()) trimmer_.join();
+}
+
+/**
+ * @brief Restores the sequence numbers from `TABLE` and starts the trimmer thread.
+ * @details The table is scanned once for its oldest and newest numbers and its size, so that
+ * numbering continues where it stopped and resume tokens handed out before a restart stay
+ * valid. A disabled log neither scans nor creates the table.
+ * @return `aevum::util::Status::OK()` on success, or the status of the failed scan.
+ */
+aevum::util::Status ChangeLog::open() {
+    if (!enabled()) return aevum::util::Status::OK();
+
+    uint64_t first = 0;
+    uint64_t last = 0;
+    uint64_t count = 0;
+    auto status = storage_.scan_keys(TABLE, [&](std::string_view key) {
+        auto sequence = decode_sequence(key);
+        if (!sequence) return true;
+        if (count++ == 0) first = *sequence;
+        last = *sequence;
+        return true;
+    });
+    if (!status.ok()) return status;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next_ = last + 1;
+        retained_ = count;
+        visible_.store(last);
+        first_retained_.store(count == 0 ? next_ : first);
+    }
+    trimmer_ = std::thread(&ChangeLog::run_trimmer, this);
+    AEVUM_LOG_INFO("ChangeLog: Restored " + std::to_string(count) +
+                   " change records; the last sequence number is " + std::to_string(last) + ".");
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Reserves the sequence numbers of a write batch.
+ * @param count The number of records the batch will append.
+ * @return The reservation; empty if the log is disabled or `count` is 0.
+ */
+ChangeLog::Reservation ChangeLog::reserve(size_t count) {
+    if (!enabled() || count == 0) return Reservation();
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t first = next_;
+    next_ += count;
+    in_flight_.emplace(first, count);
+    return Reservation(this, first, count);
+}
+
+/**
+ * @brief Ends a reservation and advances the visible horizon.
+ * @details The horizon is the number before the oldest reservation still in flight, or the last
+ * number reserved if there is none. Numbers of records that were never committed are simply
+ * absent from the table, so readers skip them.
+ * @param first The first reserved number.
+ * @param written The records committed under it.
+ */
+void ChangeLog::release(uint64_t first, uint64_t written) {
+    bool advanced;
+    bool overfull;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_.erase(first);
+        retained_ += written;
+        uint64_t horizon = in_flight_.empty() ? next_ - 1 : in_flight_.begin()->first - 1;
+        advanced = horizon > visible_.load(std::memory_order_relaxed);
+        if (advanced) visible_.store(horizon);
+        overfull = retained_ > capacity_ + capacity_ / 8;
+    }
+    if (advanced) change_cv_.notify_all();
+    if (overfull) trim_cv_.notify_one();
+}
+
+/**
+ * @brief Waits until a record newer than a resume token is visible.
+ * @param after The resume token.
+ * @param timeout The longest wait.
+ * @return `true` if a newer record is visible.
+ */
+bool ChangeLog::wait_for(uint64_t after, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    change_cv_.wait_for(lock, timeout, [&]() { return stop_ || visible_.load() > after; });
+    return visible_.load() > after;
+}
+
+/**
+ * @brief Reads the visible records that follow a resume token.
+ * @details The scan starts at the key of `after + 1` and stops at the visible horizon, the
+ * `limit`, or the end of the table. Whether the records following `after` are still retained is
+ * checked once the scan has finished, since the trimmer advances `first_retained_` before it
+ * removes any record: a scan that missed trimmed records always sees the advanced value.
+ * @param after The resume token.
+ * @param collection Only the records of this collection, or empty for all.
+ * @param limit The most records returned.
+ * @param out Receives the records, oldest first.
+ * @param resume_token Receives the token to pass on the next read.
+ * @return `aevum::util::Status::OK()` on success, `NotSupported` if the log is disabled,
+ *         `NotFound` if the records following `after` have been trimmed, or the status of the
+ *         failed scan.
+ */
+aevum::util::Status ChangeLog::read(uint64_t after, std::string_view collection, size_t limit,
+                                    std::vector<Change> &out, uint64_t &resume_token) {
+    if (!enabled()) return aevum::util::Status::NotSupported("The change log is disabled.");
+    resume_token = after;
+    uint64_t horizon = visible_.load();
+    if (after < horizon && limit > 0) {
+        bool limited = false;
+        Change change;
+        auto status = storage_.scan_keys(TABLE, encode_sequence(after + 1),
+                                         [&](std::string_view key) {
+            if (!decode_change(key, change)) return true;
+            if (change.sequence > horizon) return false;
+            resume_token = change.sequence;
+            if (!collection.empty() && change.collection != collection) return true;
+            out.push_back(change);
+            if (out.size() < limit) return true;
+            limited = true;
+            return false;
+        });
+        if (!status.ok()) return status;
+        if (!limited) resume_token = horizon;
+    }
+    if (after + 1 < first_retained_.load()) {
+        out.clear();
+        resume_token = after;
+        return aevum::util::Status::NotFound(
+            "The changes following resume token " + std::to_string(after) +
+            " have been trimmed; the oldest retained is " +
+            std::to_string(first_retained_.load()) + ".");
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Returns a snapshot of the state of the log.
+ * @return The snapshot.
+ */
+ChangeLogStats ChangeLog::stats() const noexcept {
+    ChangeLogStats stats;
+    stats.last_sequence = visible_.load();
+    stats.first_sequence = first_retained_.load();
+    stats.trimmed = trimmed_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.retained = retained_;
+    return stats;
+}
+
+/**
+ * @brief The body of the trimmer thread.
+ * @details Sleeps until the log has grown an eighth past its capacity, so that records are
+ * removed in large batches rather than one per write, then trims it back to the capacity.
+ */
+void ChangeLog::run_trimmer() {
+    aevum::util::concurrency::set_current_thread_name("ChangeLogTrim");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        trim_cv_.wait(lock, [&]() { return stop_ || retained_ > capacity_ + capacity_ / 8; });
+        if (stop_) return;
+        uint64_t excess = retained_ - capacity_;
+        lock.unlock();
+        bool trimmed = trim(excess);
+        lock.lock();
+        // Retry a failed trim later rather than spinning on the same error.
+        if (!trimmed) trim_cv_.wait_for(lock, std::chrono::seconds(1), [&]() { return stop_; });
+    }
+}
+
+/**
+ * @brief Removes the oldest records down to the capacity.
+ * @details The records are removed in transactions of at most `TRIM_BATCH` keys, so that
+ * trimming never holds a large transaction open against the writers appending to the table.
+ * Only visible records are removed; `first_retained_` is advanced past a batch before it is
+ * removed.
+ * @param excess The number of records to remove.
+ * @return `false` if the records could not all be removed.
+ */
+bool ChangeLog::trim(uint64_t excess) {
+    while (excess > 0) {
+        uint64_t horizon = visible_.load();
+        std::vector<storage::KeyWrite> removals;
+        uint64_t last = 0;
+        auto status = storage_.scan_keys(TABLE, [&](std::string_view key) {
+            auto sequence = decode_sequence(key);
+            if (sequence && *sequence > horizon) return false;
+            if (sequence) last = *sequence;
+            removals.push_back({std::string(TABLE), std::string(key), true});
+            return removals.size() < std::min<uint64_t>(excess, TRIM_BATCH);
+        });
+        if (!status.ok() || removals.empty()) {
+            if (!status.ok()) {
+                AEVUM_LOG_WARN("ChangeLog: Failed to scan for trimming: " + status.to_string());
+            }
+            return false;
+        }
+
+        if (last + 1 > first_retained_.load()) first_retained_.store(last + 1);
+        status = storage_.apply_batch(TABLE, {}, {}, removals, storage::Durability::NONE);
+        if (!status.ok()) {
+            AEVUM_LOG_WARN("ChangeLog: Failed to trim: " + status.to_string());
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            retained_ -= std::min<uint64_t>(retained_, removals.size());
+        }
+        trimmed_.fetch_add(removals.size(), std::memory_order_relaxed);
+        excess -= std::min<uint64_t>(excess, removals.size());
+    }
+    return true;
+}
+
+}  // namespace aevum::db
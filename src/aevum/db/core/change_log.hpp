@@ -0,0 +1,277 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file change_log.hpp
+ * @brief Declares `ChangeLog`, the capped log of document changes that `watch` consumers tail.
+ * @details Every insert, update, and remove appends one compact record per document to the
+ * `_oplog` table: a sequence number, the kind of change, the collection, and the `_id`. The
+ * records are key-only writes committed in the same transaction as the documents they describe,
+ * so the log never disagrees with the data. A consumer that has seen everything up to some
+ * sequence number asks for what followed it, and refetches the documents it cares about, instead
+ * of polling whole collections.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db {
+
+/**
+ * @enum ChangeType
+ * @brief The kind of change a record describes, stored as one character of its key.
+ */
+enum class ChangeType : char {
+    /// A document was inserted, or overwritten by an insert with the same `_id`.
+    INSERT = 'i',
+    /// A document was modified by an update.
+    UPDATE = 'u',
+    /// A document was removed.
+    DELETE = 'd',
+};
+
+/**
+ * @brief Returns the name of a kind of change, as reported by the `watch` action.
+ * @param type The kind of change.
+ * @return `"insert"`, `"update"`, or `"delete"`.
+ */
+[[nodiscard]] const char *change_type_name(ChangeType type) noexcept;
+
+/**
+ * @struct Change
+ * @brief One record of the change log.
+ */
+struct Change {
+    /// The sequence number, unique and increasing in commit order per collection.
+    uint64_t sequence = 0;
+    /// The kind of change.
+    ChangeType type = ChangeType::INSERT;
+    /// The collection of the document.
+    std::string collection;
+    /// The `_id` of the document.
+    std::string id;
+};
+
+/**
+ * @struct ChangeLogStats
+ * @brief A snapshot of the state of a `ChangeLog`, as reported by the `metrics` action.
+ */
+struct ChangeLogStats {
+    /// The sequence number of the newest record readers can see, 0 if there is none.
+    uint64_t last_sequence = 0;
+    /// The oldest sequence number still retained.
+    uint64_t first_sequence = 1;
+    /// The records retained.
+    uint64_t retained = 0;
+    /// The records removed to keep the log within its capacity.
+    uint64_t trimmed = 0;
+};
+
+/**
+ * @class ChangeLog
+ * @brief Assigns sequence numbers to changes, tracks which of them are committed, and serves
+ * them to readers from a resume token.
+ *
+ * @details Writers to different collections commit concurrently, so sequence numbers are not
+ * committed in order. A writer `reserve`s the numbers of its batch, `append`s the records to the
+ * batch's key writes, and releases the reservation once the batch has committed or failed.
+ * Readers only see records up to the last sequence number below every reservation still in
+ * flight, so a record can never appear behind a resume token a reader has already been given.
+ *
+ * The log keeps `capacity` records. A trimmer thread removes the oldest ones, in transactions of
+ * their own, once the log has grown an eighth past its capacity. A reader whose resume token
+ * predates the oldest retained record is told so rather than silently missing changes.
+ */
+class ChangeLog {
+  public:
+    /// The table holding the records.
+    static constexpr std::string_view TABLE = "_oplog";
+
+    /**
+     * @class Reservation
+     * @brief The sequence numbers of one write batch, released when it goes out of scope.
+     */
+    class Reservation {
+      public:
+        /**
+         * @brief Constructs a reservation of no numbers, as returned by a disabled log.
+         */
+        Reservation() = default;
+
+        /**
+         * @brief Releases the numbers, making the records visible if `commit` was called.
+         */
+        ~Reservation();
+
+        Reservation(const Reservation &) = delete;
+        Reservation &operator=(const Reservation &) = delete;
+        Reservation(Reservation &&other) noexcept;
+        Reservation &operator=(Reservation &&other) = delete;
+
+        /**
+         * @brief Appends the record of a change to the key writes of the batch.
+         * @details Has no effect once every reserved number has been used.
+         * @param key_writes The key writes of the batch.
+         * @param type The kind of change.
+         * @param collection The collection of the document.
+         * @param id The `_id` of the document.
+         */
+        void append(std::vector<storage::KeyWrite> &key_writes, ChangeType type,
+                    std::string_view collection, std::string_view id);
+
+        /**
+         * @brief Records that the batch carrying the records has committed.
+         */
+        void commit() noexcept { committed_ = true; }
+
+      private:
+        friend class ChangeLog;
+
+        Reservation(ChangeLog *log, uint64_t first, uint64_t count) noexcept
+            : log_(log), first_(first), count_(count) {}
+
+        /// The log, or `nullptr` if nothing was reserved.
+        ChangeLog *log_ = nullptr;
+        /// The first reserved number.
+        uint64_t first_ = 0;
+        /// The number of reserved numbers.
+        uint64_t count_ = 0;
+        /// The number of records appended.
+        uint64_t used_ = 0;
+        /// `true` once the batch has committed.
+        bool committed_ = false;
+    };
+
+    /**
+     * @brief Constructs a log over a store; `open` must be called once the store is initialized.
+     * @param storage The store holding `TABLE`. It must outlive the log.
+     * @param capacity The records retained, or 0 to record no changes.
+     */
+    ChangeLog(storage::WiredTigerStore &storage, size_t capacity);
+
+    /**
+     * @brief Stops the trimmer thread.
+     */
+    ~ChangeLog();
+
+    // The log owns a thread that refers back to it, so it is neither copyable nor movable.
+    ChangeLog(const ChangeLog &) = delete;
+    ChangeLog &operator=(const ChangeLog &) = delete;
+    ChangeLog(ChangeLog &&) = delete;
+    ChangeLog &operator=(ChangeLog &&) = delete;
+
+    /**
+     * @brief Restores the sequence numbers from `TABLE` and starts the trimmer thread.
+     * @return `aevum::util::Status::OK()` on success, or the status of the failed scan.
+     */
+    [[nodiscard]] aevum::util::Status open();
+
+    /**
+     * @brief Checks whether changes are recorded.
+     * @return `true` if the capacity is not 0.
+     */
+    [[nodiscard]] bool enabled() const noexcept { return capacity_ > 0; }
+
+    /**
+     * @brief Reserves the sequence numbers of a write batch.
+     * @param count The number of records the batch will append.
+     * @return The reservation; empty if the log is disabled or `count` is 0.
+     */
+    [[nodiscard]] Reservation reserve(size_t count);
+
+    /**
+     * @brief Waits until a record newer than a resume token is visible.
+     * @param after The resume token.
+     * @param timeout The longest wait.
+     * @return `true` if a newer record is visible, `false` on timeout or shutdown.
+     */
+    bool wait_for(uint64_t after, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Reads the visible records that follow a resume token.
+     * @param after The resume token: the sequence number of the last record already seen, or 0.
+     * @param collection Only the records of this collection, or empty for all.
+     * @param limit The most records returned.
+     * @param out Receives the records, oldest first.
+     * @param resume_token Receives the token to pass on the next read. It advances past records
+     *        skipped by the `collection` filter, so a filtered reader does not rescan them.
+     * @return `aevum::util::Status::OK()` on success, `NotSupported` if the log is disabled,
+     *         `NotFound` if records following `after` have been trimmed, or the status of the
+     *         failed scan.
+     */
+    [[nodiscard]] aevum::util::Status read(uint64_t after, std::string_view collection,
+                                           size_t limit, std::vector<Change> &out,
+                                           uint64_t &resume_token);
+
+    /**
+     * @brief Returns a snapshot of the state of the log.
+     * @return The snapshot.
+     */
+    [[nodiscard]] ChangeLogStats stats() const noexcept;
+
+  private:
+    /// The store holding `TABLE`.
+    storage::WiredTigerStore &storage_;
+    /// The records retained.
+    size_t capacity_;
+
+    /// Guards every field below up to `stop_`.
+    mutable std::mutex mutex_;
+    /// Signaled when `visible_` advances or the log is stopping.
+    std::condition_variable change_cv_;
+    /// Signaled when the log outgrows its capacity or is stopping.
+    std::condition_variable trim_cv_;
+    /// The next sequence number to reserve.
+    uint64_t next_ = 1;
+    /// The reservations in flight: first number to count.
+    std::map<uint64_t, uint64_t> in_flight_;
+    /// The records committed and not yet trimmed.
+    uint64_t retained_ = 0;
+    /// `true` once the destructor has asked the trimmer to exit.
+    bool stop_ = false;
+
+    /// The newest sequence number readers can see. Written under `mutex_`.
+    std::atomic<uint64_t> visible_{0};
+    /// The oldest sequence number not trimmed. Advanced by the trimmer before it removes records.
+    std::atomic<uint64_t> first_retained_{1};
+    /// The records trimmed.
+    std::atomic<uint64_t> trimmed_{0};
+
+    /// The trimmer thread, started by `open`.
+    std::thread trimmer_;
+
+    /**
+     * @brief Ends a reservation.
+     * @param first The first reserved number.
+     * @param written The records committed under it.
+     */
+    void release(uint64_t first, uint64_t written);
+
+    /**
+     * @brief The body of the trimmer thread.
+     */
+    void run_trimmer();
+
+    /**
+     * @brief Removes the oldest records down to the capacity.
+     * @param excess The number of records to remove.
+     * @return `false` if the records could not all be removed.
+     */
+    bool trim(uint64_t excess);
+};
+
+}  // namespace aevum::db
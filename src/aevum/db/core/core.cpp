@@ -12,521 +12,3688 @@
  */
 #include "aevum/db/core/core.hpp"
 
+#include <algorithm>
 #include <bson/bson.h>
-#include <memory>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <iterator>
+#include <memory_resource>
 #include <mutex>
 #include <shared_mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "aevum/bson/doc/matcher.hpp"
 #include "aevum/bson/json/parser.hpp"
 #include "aevum/bson/json/serializer.hpp"
 #include "aevum/db/ffi.hpp"
+#include "aevum/db/index/index_image.hpp"
+#include "aevum/db/query/pipeline.hpp"
+#include "aevum/db/query/projection.hpp"
+#include "aevum/db/query/update_patch.hpp"
+#include "aevum/db/timeseries/bucket_group.hpp"
+#include "aevum/util/concurrency/numa_topology.hpp"
+#include "aevum/util/crypto/sha256.hpp"
+#include "aevum/util/defer.hpp"
 #include "aevum/util/hash/djb2.hpp"
+#include "aevum/util/hash/wyhash.hpp"
 #include "aevum/util/log/logger.hpp"
+#include "aevum/util/memory/scratch_memory.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+#include "aevum/util/uuid/id_format.hpp"
 #include "aevum/util/uuid/v4.hpp"
 
 namespace aevum::db {
 
+namespace {
+
+/**
+ * @struct BorrowedBatch
+ * @brief The parallel pointer/length arrays lent to the zero-copy Rust FFI, together with the
+ * documents they were borrowed from.
+ * @details Position `i` of `data`/`lengths` describes the BSON buffer of `docs[i]`, so a position
+ * reported back by `rust_find_bson` resolves directly to the originating `Document`. The buffer
+ * arrays live in the thread's scratch memory, so a batch must be built inside a `ScratchScope`.
+ */
+struct BorrowedBatch {
+    /// Non-owning pointers to the documents in the primary index.
+    std::vector<const aevum::bson::doc::Document *> docs;
+    /// The raw BSON data pointer of each document.
+    std::pmr::vector<const uint8_t *> data{&aevum::util::memory::scratch_memory()};
+    /// The BSON length, in bytes, of each document.
+    std::pmr::vector<uint32_t> lengths{&aevum::util::memory::scratch_memory()};
+};
+
+/**
+ * @brief Builds the FFI buffer arrays for a set of borrowed documents.
+ * @param docs Non-owning pointers to the documents to lend.
+ * @return A `BorrowedBatch` that takes over `docs` and describes each document's buffer.
+ */
+BorrowedBatch make_borrowed_batch(std::vector<const aevum::bson::doc::Document *> docs) {
+    BorrowedBatch batch;
+    batch.data.reserve(docs.size());
+    batch.lengths.reserve(docs.size());
+    for (const auto *doc : docs) {
+        batch.data.push_back(bson_get_data(doc->get()));
+        batch.lengths.push_back(doc->length());
+    }
+    batch.docs = std::move(docs);
+    return batch;
+}
+
+/**
+ * @brief Makes a call into the Rust FFI and adds its duration to the execution counters.
+ * @param counters The counters of the calling `Core`.
+ * @param call The call, returning its FFI result.
+ * @return The result of `call`.
+ */
+template <typename Call>
+auto timed_ffi_call(ExecutionCounters &counters, Call &&call) {
+    aevum::util::time::Stopwatch stopwatch;
+    auto result = call();
+    counters.ffi_calls.fetch_add(1, std::memory_order_relaxed);
+    counters.ffi_us.fetch_add(stopwatch.elapsed_ns() / 1000, std::memory_order_relaxed);
+    return result;
+}
+
+/// The smallest number of candidates lent to the matcher at once during an ordered traversal.
+constexpr size_t MIN_SCAN_CHUNK = 256;
+
+/// The number of documents read from storage and lent to the matcher at once when an unloaded
+/// collection is scanned.
+constexpr size_t STORAGE_SCAN_BATCH = 1024;
+
+/// The smallest number of candidates that the native matcher spreads over the scan pool.
+constexpr size_t PARALLEL_SCAN_THRESHOLD = 4096;
+
+/// The number of candidates a thread of the scan pool claims at once.
+constexpr size_t PARALLEL_SCAN_GRAIN = 1024;
+
+/**
+ * @brief Checks whether a batch of candidates is worth matching on the scan pool.
+ * @param pool The scan pool, or `nullptr` if scans run on the calling thread only.
+ * @param candidates The number of candidates.
+ * @return `true` if the batch is split across the pool.
+ */
+bool scan_in_parallel(const aevum::util::concurrency::ThreadPool *pool, size_t candidates) {
+    return pool != nullptr && candidates >= PARALLEL_SCAN_THRESHOLD;
+}
+
+/**
+ * @brief Matches candidates natively on the scan pool, keeping their order.
+ * @details The candidates are split into chunks of `PARALLEL_SCAN_GRAIN`, claimed by the pool's
+ * workers and the calling thread. Each chunk collects its matches separately, and the chunks are
+ * concatenated in order, so the result is the same as that of a sequential scan.
+ * @param pool The scan pool.
+ * @param docs The candidates.
+ * @param matcher The matcher of the query.
+ * @return The candidates that match, in their original order.
+ */
+std::vector<const aevum::bson::doc::Document *> parallel_filter(
+    aevum::util::concurrency::ThreadPool &pool,
+    const std::vector<const aevum::bson::doc::Document *> &docs,
+    const aevum::bson::doc::Matcher &matcher) {
+    std::vector<std::vector<const aevum::bson::doc::Document *>> chunks(
+        (docs.size() + PARALLEL_SCAN_GRAIN - 1) / PARALLEL_SCAN_GRAIN);
+    pool.parallel_for(0, docs.size(), PARALLEL_SCAN_GRAIN, [&](size_t begin, size_t end) {
+        auto &matched = chunks[begin / PARALLEL_SCAN_GRAIN];
+        for (size_t i = begin; i < end; ++i) {
+            if (matcher.matches(*docs[i])) matched.push_back(docs[i]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto &chunk : chunks) total += chunk.size();
+    std::vector<const aevum::bson::doc::Document *> matched;
+    matched.reserve(total);
+    for (const auto &chunk : chunks) matched.insert(matched.end(), chunk.begin(), chunk.end());
+    return matched;
+}
+
+/**
+ * @brief Counts the candidates that match natively on the scan pool.
+ * @param pool The scan pool.
+ * @param docs The candidates.
+ * @param matcher The matcher of the query.
+ * @return The number of matching candidates.
+ */
+size_t parallel_count(aevum::util::concurrency::ThreadPool &pool,
+                      const std::vector<const aevum::bson::doc::Document *> &docs,
+                      const aevum::bson::doc::Matcher &matcher) {
+    std::atomic<size_t> total{0};
+    pool.parallel_for(0, docs.size(), PARALLEL_SCAN_GRAIN, [&](size_t begin, size_t end) {
+        size_t matched = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (matcher.matches(*docs[i])) ++matched;
+        }
+        total.fetch_add(matched, std::memory_order_relaxed);
+    });
+    return total.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether a sort specification requests no ordering at all.
+ * @param sort_json The JSON sort document.
+ * @return `true` if it parses to an empty document; `false` otherwise, including if it does not
+ *         parse.
+ */
+bool is_empty_sort(std::string_view sort_json) {
+    if (sort_json == "{}") return true;
+    aevum::bson::doc::Document sort_doc;
+    if (!aevum::bson::json::parse(sort_json, sort_doc).ok()) return false;
+    return sort_doc.empty();
+}
+
+/**
+ * @brief Selects the documents of a batch that a query returns.
+ * @details If the plan carries a native matcher, the documents are matched in place in C++. An
+ * unsorted query is then paginated right away and stops at `skip + limit` matches; a sorted one
+ * lends only the matches to `rust_find_bson`, with an empty query, to be ordered and paginated.
+ * A large batch without a limit to stop at, sorted or not, is matched across the scan pool by
+ * `parallel_filter`. Otherwise the whole batch is lent to `rust_find_bson`, which parallelizes
+ * on its own. Either way, the results are the same.
+ *
+ * @param counters The execution counters, for the time spent in the FFI.
+ * @param pool The scan pool, or `nullptr`.
+ * @param docs The candidate documents.
+ * @param plan The plan of the query, for its native matcher and, for a text search, the query
+ *        without `$text`.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return The selected documents, in result order.
+ */
+std::vector<const aevum::bson::doc::Document *> select_matches(
+    ExecutionCounters &counters, aevum::util::concurrency::ThreadPool *pool,
+    std::vector<const aevum::bson::doc::Document *> docs,
+    const aevum::db::query::QueryPlan &plan, const std::string &query_json,
+    const std::string &sort_json, int64_t limit, int64_t skip) {
+    aevum::db::query::PhaseTimer phase(aevum::db::query::ProfilePhase::MATCH);
+    aevum::db::query::ProfileScope::note_examined(docs.size());
+    // The same conversions the FFI call applies.
+    const int32_t limit32 = static_cast<int32_t>(limit);
+    const int32_t skip32 = static_cast<int32_t>(skip);
+    const char *query = plan.type == aevum::db::query::PlanType::TEXT_SEARCH
+                            ? plan.text_query.c_str()
+                            : query_json.c_str();
+
+    if (plan.matcher) {
+        const bool sorted = sort_json != "{}" && !is_empty_sort(sort_json);
+        const size_t to_skip = !sorted && skip32 > 0 ? static_cast<size_t>(skip32) : 0;
+        const size_t wanted = !sorted && limit32 > 0 ? static_cast<size_t>(limit32) : 0;
+        std::vector<const aevum::bson::doc::Document *> matched;
+        if (wanted == 0 && scan_in_parallel(pool, docs.size())) {
+            matched = parallel_filter(*pool, docs, *plan.matcher);
+            matched.erase(matched.begin(), matched.begin() + std::min(to_skip, matched.size()));
+        } else {
+            size_t skipped = 0;
+            for (const auto *doc : docs) {
+                if (!plan.matcher->matches(*doc)) continue;
+                if (skipped < to_skip) {
+                    ++skipped;
+                    continue;
+                }
+                matched.push_back(doc);
+                if (wanted > 0 && matched.size() >= wanted) break;
+            }
+        }
+        if (!sorted || matched.empty()) return matched;
+        docs = std::move(matched);
+        query = "{}";
+    }
+
+    aevum::util::memory::ScratchScope scratch;
+    BorrowedBatch batch = make_borrowed_batch(std::move(docs));
+    rust_index_result res = timed_ffi_call(counters, [&] {
+        return rust_find_bson(batch.data.data(), batch.lengths.data(), batch.docs.size(), query,
+                              sort_json.c_str(), limit32, skip32);
+    });
+    std::vector<const aevum::bson::doc::Document *> selected;
+    selected.reserve(res.len);
+    for (size_t i = 0; i < res.len; ++i) {
+        if (res.indices[i] < batch.docs.size()) selected.push_back(batch.docs[res.indices[i]]);
+    }
+    rust_free_index_result(res);
+    return selected;
+}
+
+/**
+ * @brief Counts the documents of a batch that satisfy a query.
+ * @details Uses the plan's native matcher if it has one, across the scan pool for a large batch,
+ * and `rust_count_bson` otherwise.
+ * @param counters The execution counters, for the time spent in the FFI.
+ * @param pool The scan pool, or `nullptr`.
+ * @param docs The candidate documents.
+ * @param plan The plan of the query, for its native matcher and, for a text search, the query
+ *        without `$text`.
+ * @param query_json The filter conditions.
+ * @return The number of matching documents.
+ */
+int count_matches(ExecutionCounters &counters, aevum::util::concurrency::ThreadPool *pool,
+                  std::vector<const aevum::bson::doc::Document *> docs,
+                  const aevum::db::query::QueryPlan &plan, const std::string &query_json) {
+    aevum::db::query::PhaseTimer phase(aevum::db::query::ProfilePhase::MATCH);
+    aevum::db::query::ProfileScope::note_examined(docs.size());
+    if (plan.matcher) {
+        if (plan.matcher->matches_everything()) return static_cast<int>(docs.size());
+        if (scan_in_parallel(pool, docs.size())) {
+            return static_cast<int>(parallel_count(*pool, docs, *plan.matcher));
+        }
+        return static_cast<int>(std::count_if(docs.begin(), docs.end(), [&](const auto *doc) {
+            return plan.matcher->matches(*doc);
+        }));
+    }
+    aevum::util::memory::ScratchScope scratch;
+    BorrowedBatch batch = make_borrowed_batch(std::move(docs));
+    return timed_ffi_call(counters, [&] {
+        const std::string &query = plan.type == aevum::db::query::PlanType::TEXT_SEARCH
+                                        ? plan.text_query
+                                        : query_json;
+        return rust_count_bson(batch.data.data(), batch.lengths.data(), batch.docs.size(),
+                               query.c_str());
+    });
+}
+
+/**
+ * @brief Removes a top-level `$text` operator from a JSON query.
+ * @details The update engine re-evaluates the query on the documents it is given, and knows no
+ * `$text`; the documents a text search selected have passed it already.
+ * @param query_json The query.
+ * @return The query without `$text`, or unchanged if it has none or cannot be parsed.
+ */
+std::string strip_text_search(std::string_view query_json) {
+    if (query_json.find("$text") == std::string_view::npos) return std::string(query_json);
+    aevum::bson::doc::Document query;
+    bson_iter_t iter;
+    if (!aevum::bson::json::parse(query_json, query).ok() ||
+        !bson_iter_init_find(&iter, query.get(), "$text")) {
+        return std::string(query_json);
+    }
+    bson_t *residual = bson_new();
+    bson_copy_to_excluding_noinit(query.get(), residual, "$text", nullptr);
+    return aevum::bson::json::to_string(aevum::bson::doc::Document(residual));
+}
+
+/**
+ * @brief Checks whether a plan can be executed against storage without loading the collection.
+ * @details A primary lookup reads at most one document, so its sort is irrelevant. A full scan
+ * can be streamed if the results need no ordering. Every other plan relies on an index.
+ * @param plan The plan to check.
+ * @param sort_json The JSON sort document of the query.
+ * @return `true` if `Core::find_in_storage` and `Core::count_in_storage` accept the plan.
+ */
+bool can_serve_from_storage(const aevum::db::query::QueryPlan &plan, std::string_view sort_json) {
+    if (plan.type == aevum::db::query::PlanType::PRIMARY_LOOKUP) return true;
+    return plan.type == aevum::db::query::PlanType::FULL_SCAN && plan.sort_field.empty() &&
+           is_empty_sort(sort_json);
+}
+
+/**
+ * @brief Stably orders documents by the ordered-index key of one of their fields.
+ * @details Documents with equal keys keep their relative order, in either direction. The Rust
+ * engine sorts with `par_sort_unstable_by`, but its comparator breaks ties by input position, so
+ * it yields the same order for equal keys.
+ * @param docs The documents to order, in place.
+ * @param field The top-level field to order by.
+ * @param descending `true` to order from the largest key down.
+ */
+void order_by_field(std::vector<const aevum::bson::doc::Document *> &docs,
+                    const std::string &field, bool descending) {
+    aevum::util::memory::ScratchScope scratch;
+    std::pmr::vector<std::pair<aevum::db::index::IndexKey, const aevum::bson::doc::Document *>>
+        keyed(&aevum::util::memory::scratch_memory());
+    keyed.reserve(docs.size());
+    for (const auto *doc : docs) {
+        keyed.emplace_back(aevum::db::index::make_field_key(*doc, field), doc);
+    }
+    std::stable_sort(keyed.begin(), keyed.end(), [descending](const auto &a, const auto &b) {
+        return descending ? b.first < a.first : a.first < b.first;
+    });
+    for (size_t i = 0; i < keyed.size(); ++i) {
+        docs[i] = keyed[i].second;
+    }
+}
+
+/**
+ * @brief Serializes a set of borrowed documents into a single JSON array string.
+ * @details Used only where the Rust engine still requires JSON input (the update path), and only
+ * for the documents that actually matched.
+ * @param docs The documents to serialize.
+ * @return A `std::string` containing the JSON array.
+ */
+std::string to_json_array(const std::vector<const aevum::bson::doc::Document *> &docs) {
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = 0; i < docs.size(); ++i) {
+        oss << aevum::bson::json::to_string(*docs[i]);
+        if (i < docs.size() - 1) oss << ",";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+/// The table holding the position of a replica in its primary's change log.
+constexpr const char *REPLICATION_TABLE = "_replication";
+/// The `_id` of the record of `REPLICATION_TABLE`.
+constexpr const char *REPLICATION_TOKEN_ID = "resume_token";
+
+/**
+ * @brief Extracts the key of a document's `_id`.
+ * @param doc The document to inspect.
+ * @return The key, as produced by `PrimaryIndexer::to_id_key`, or an empty string if the
+ *         document has neither a string nor an integer `_id`.
+ */
+std::string extract_id(const aevum::bson::doc::Document &doc) {
+    bson_iter_t iter;
+    if (bson_iter_init_find(&iter, doc.get(), "_id")) {
+        return aevum::db::index::PrimaryIndexer::to_id_key(iter);
+    }
+    return {};
+}
+
+/**
+ * @brief Returns the key of a document's `_id`, generating an `_id` first if it has none.
+ * @details A generated `_id` is prepended to the document, which is replaced in place. Only
+ * string `_id`s are generated, so a document of an integer-keyed collection must bring its own.
+ * @param doc The document to inspect and, if needed, rewrite.
+ * @param format The generator of a missing `_id`.
+ * @param key_format The key format of the collection.
+ * @param id_str Receives the key of the document's `_id`.
+ * @return `Status::OK()`, or `InvalidArgument` if the `_id` is missing from a document of an
+ *         integer-keyed collection or does not fit the collection's key format.
+ */
+aevum::util::Status ensure_id(aevum::bson::doc::Document &doc,
+                              aevum::util::uuid::IdFormat format,
+                              aevum::db::storage::KeyFormat key_format, std::string &id_str) {
+    bool integer_keys = key_format == aevum::db::storage::KeyFormat::INT64;
+    bson_iter_t iter;
+    if (bson_iter_init_find(&iter, doc.get(), "_id")) {
+        bool fits = integer_keys ? BSON_ITER_HOLDS_INT32(&iter) || BSON_ITER_HOLDS_INT64(&iter)
+                                 : BSON_ITER_HOLDS_UTF8(&iter);
+        if (!fits) {
+            return aevum::util::Status::InvalidArgument(integer_keys ? "_id must be an integer"
+                                                                     : "_id must be a string");
+        }
+        id_str = aevum::db::index::PrimaryIndexer::to_id_key(iter);
+        AEVUM_LOG_DEBUG("Core: Using provided _id '" + id_str + "' for insert.");
+        return aevum::util::Status::OK();
+    }
+    if (integer_keys) {
+        return aevum::util::Status::InvalidArgument(
+            "Documents of an integer-keyed collection need an integer _id");
+    }
+
+    id_str = aevum::util::uuid::generate(format);
+    AEVUM_LOG_DEBUG("Core: No _id provided. Generated new _id '" + id_str + "' for insert.");
+    bson_t *new_b = bson_new();
+    BSON_APPEND_UTF8(new_b, "_id", id_str.c_str());
+    bson_concat(new_b, doc.get());
+    doc = aevum::bson::doc::Document(new_b);
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Creates the pool that large native scans are spread over.
+ * @param threads The configured number of scan threads, or 0 for one per hardware thread.
+ * @return The pool, whose workers join the calling thread in a scan, or `nullptr` if scans run on
+ *         the calling thread alone.
+ */
+std::unique_ptr<aevum::util::concurrency::ThreadPool> make_scan_pool(size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 1) return nullptr;
+    return std::make_unique<aevum::util::concurrency::ThreadPool>("Scan", threads - 1);
+}
+
+/**
+ * @brief Builds the thread pools of the query engine.
+ * @details The engine's pools are process-wide and can only be built before its first query,
+ * so a second `Core` in the same process keeps the pools of the first.
+ * @param options The engine configuration.
+ */
+void configure_engine_pools(const CoreOptions &options) {
+    std::vector<uint32_t> cpus;
+    std::vector<size_t> node_sizes;
+    if (options.engine_numa_pools) {
+        for (const auto &node : aevum::util::concurrency::numa_node_cpus()) {
+            cpus.insert(cpus.end(), node.begin(), node.end());
+            node_sizes.push_back(node.size());
+        }
+        if (node_sizes.empty()) {
+            AEVUM_LOG_WARN("Core: The NUMA topology could not be read; the query engine runs on "
+                           "a single unpinned pool.");
+        }
+    }
+    if (rust_configure_pool(options.engine_threads, options.engine_thread_prefix.c_str(),
+                            cpus.data(), node_sizes.data(), node_sizes.size()) != 1) {
+        AEVUM_LOG_WARN("Core: The query engine's thread pools were already built; keeping them.");
+        return;
+    }
+    AEVUM_LOG_INFO("Core: Query engine running on " +
+                   (node_sizes.empty() ? std::string("a global pool")
+                                       : std::to_string(node_sizes.size()) + " NUMA node pools") +
+                   ".");
+}
+
+/**
+ * @brief Builds the status refusing an operation on a time-series collection.
+ * @param coll The name of the collection.
+ * @param operation The operation, in the plural (e.g. "updates").
+ * @return A `NotSupported` status.
+ */
+aevum::util::Status time_series_refusal(std::string_view coll, std::string_view operation) {
+    return aevum::util::Status::NotSupported("Time-series collection '" + std::string(coll) +
+                                             "' does not support " + std::string(operation));
+}
+
+/**
+ * @brief Runs the stages of an aggregation pipeline after its leading `$match` in Rust.
+ * @param counters The execution counters, for the time spent in the FFI.
+ * @param inputs The documents the stages run on, in order.
+ * @param rest_json The stages, as a JSON array.
+ * @param results Receives the results, as a JSON array.
+ * @return `OK`, `InvalidArgument` if a stage is invalid, or `Corruption`.
+ */
+aevum::util::Status run_pipeline(ExecutionCounters &counters,
+                                 std::vector<const aevum::bson::doc::Document *> inputs,
+                                 const std::string &rest_json, std::string &results) {
+    aevum::util::memory::ScratchScope scratch;
+    BorrowedBatch batch = make_borrowed_batch(std::move(inputs));
+    rust_aggregate_result res = timed_ffi_call(counters, [&] {
+        return rust_aggregate_bson(batch.data.data(), batch.lengths.data(), batch.docs.size(),
+                                   rest_json.c_str());
+    });
+    aevum::util::Status status = aevum::util::Status::OK();
+    if (res.error) {
+        status =
+            aevum::util::Status::InvalidArgument(std::string("Invalid pipeline: ") + res.error);
+    } else if (res.data) {
+        results = res.data;
+    } else {
+        status = aevum::util::Status::Corruption("The pipeline's results could not be returned");
+    }
+    rust_free_aggregate_result(res);
+    return status;
+}
+
+/**
+ * @brief Checks whether a table listed by the store holds a user collection.
+ * @details System collections, the change log, the replication position, index entry tables,
+ * which are read by the collection they belong to, and bucket tables, which are only ever scanned
+ * by range, are not user collections.
+ * @param name The name of the table.
+ * @return `true` if the table is a user collection.
+ */
+bool is_user_collection(const std::string &name) {
+    if (name == "_indexes" || name == "_schemas" || name == "_auth") return false;
+    if (name == ChangeLog::TABLE || name == REPLICATION_TABLE) return false;
+    return !index::IndexPersistor::is_entry_table(name) &&
+           !timeseries::TimeSeriesStore::is_bucket_table(name);
+}
+
+}  // namespace
+
 /**
  * @brief Constructs and initializes the `Core` database engine.
  * @details The constructor executes the critical startup sequence for the entire database. It
  * initializes the member subsystems in a specific order: `storage_`, `auth_manager_`,
- * `schema_manager_`, and `index_manager_`. It then invokes `storage_.init()` to prepare the
- * physical storage layer. A critical failure at this stage is considered fatal and will terminate
- * the application.
+ * `schema_manager_`, and `index_manager_`. It then builds the query engine's thread pools and
+ * invokes `storage_.init()` to prepare the physical storage layer. A critical failure at this
+ * stage is considered fatal and will terminate the application.
  *
- * Following storage initialization, it calls `load_all()` to populate the in-memory caches and
- * indexes from persisted data. Finally, it performs a security bootstrap check: if the
- * `auth_manager_` is empty after loading, it creates a default 'root' administrator user to
- * ensure the database is not left in an inaccessible state.
+ * Following storage initialization, it restores the change log's sequence numbers, against which
+ * the index images are checked, and calls `load_all()` to populate the in-memory caches and
+ * indexes from persisted data. Without a change log, any index image left by an earlier run is
+ * deleted, since the changes made since it was written are not recorded. Finally, it performs a
+ * security bootstrap check: if the `auth_manager_` is empty after loading, it creates a default
+ * 'root' administrator user to ensure the database is not left in an inaccessible state. The
+ * collections register with the memory budget, which only runs with a
+ * `CoreOptions::memory_budget_mb`, and the index image writer and the TTL sweeper are started
+ * last, unless their intervals disable them.
  *
  * @param data_dir The filesystem path that will be used by the `WiredTigerStore` for all
  *        database files.
+ * @param options The engine configuration, including that of the `WiredTigerStore`.
  */
-Core::Core(std::string data_dir)
-    : storage_(std::move(data_dir)),
-      auth_manager_(),
+Core::Core(std::string data_dir, CoreOptions options)
+    : storage_(std::move(data_dir), std::move(options.storage)),
+      auth_manager_(options.require_sessions),
       schema_manager_(storage_),
-      index_manager_(storage_) {
-    aevum::util::log::Logger::info("Core: Initializing database engine...");
-    aevum::util::log::Logger::debug("Core: Data directory set to '" + data_dir + "'.");
+      index_manager_(storage_),
+      change_log_(storage_, options.change_log_capacity),
+      time_series_(storage_, std::move(options.time_series_collections)),
+      may_unload_(options.lazy_load || options.memory_budget_mb > 0),
+      load_threads_(options.load_threads),
+      scan_pool_(make_scan_pool(options.scan_threads)),
+      cursors_(options.cursor_timeout_sec),
+      slow_ops_(options.slow_op_threshold_ms, options.profile_entries),
+      ttl_batch_size_(std::max<size_t>(options.ttl_batch_size, 1)),
+      ttl_batch_pause_(options.ttl_batch_pause_ms),
+      id_format_(options.id_format),
+      collection_id_formats_(std::move(options.collection_id_formats)),
+      transaction_max_writes_(options.transaction_max_writes),
+      transaction_max_bytes_(options.transaction_max_bytes),
+      backup_(storage_),
+      memory_budget_(std::make_unique<MemoryBudget>(
+          options.memory_budget_mb * 1024 * 1024,
+          std::chrono::milliseconds(std::max<int64_t>(options.memory_check_interval_ms, 1)))),
+      index_images_(options.index_images && options.change_log_capacity > 0) {
+    AEVUM_LOG_INFO("Core: Initializing database engine...");
+    AEVUM_LOG_DEBUG("Core: Data directory set to '" + data_dir + "'.");
+    configure_engine_pools(options);
 
     auto status = storage_.init();
     if (!status.ok()) {
-        aevum::util::log::Logger::fatal(
-            "Core: Failed to initialize persistence layer (WiredTiger). Status: " +
-            status.to_string());
+        AEVUM_LOG_FATAL("Core: Failed to initialize persistence layer (WiredTiger). Status: " +
+                        status.to_string());
         std::abort();  // A failure to initialize storage is a non-recoverable, fatal error.
     }
 
-    load_all();
+    if (auto log_status = change_log_.open(); !log_status.ok()) {
+        AEVUM_LOG_FATAL("Core: Failed to open the change log. Status: " + log_status.to_string());
+        std::abort();
+    }
+    if (!change_log_.enabled()) {
+        if (options.index_images) {
+            AEVUM_LOG_WARN("Core: Index images are disabled, as they require a change log.");
+        }
+        index::IndexImage::remove_all(storage_.base_path());
+    }
+
+    load_all(options.lazy_load);
+
+    // If the authentication database is empty, bootstrap a default admin user.
+    if (auth_manager_.empty()) {
+        AEVUM_LOG_WARN(
+            "Core: Security credentials not found. Bootstrapping default 'root' admin user.");
+        create_user("root", auth::UserRole::ADMIN);
+    }
+
+    MemoryReclaimer collections;
+    collections.name = "collections";
+    collections.rank = 10;
+    collections.usage = [this]() {
+        MemoryUsage usage = memory_usage();
+        return usage.documents + usage.indexes;
+    };
+    collections.reclaim = [this](size_t bytes) { return evict_collections(bytes); };
+    (void)memory_budget_->add_reclaimer(std::move(collections));
+
+    if (index_images_ && options.index_image_interval_sec > 0) {
+        image_writer_ = std::make_unique<IndexImageWriter>(
+            std::chrono::seconds(options.index_image_interval_sec),
+            [this](IndexImageWriter &writer) { write_index_images(&writer); });
+    }
+    if (options.ttl_sweep_interval_sec > 0) {
+        ttl_sweeper_ = std::make_unique<TtlSweeper>(
+            std::chrono::seconds(options.ttl_sweep_interval_sec),
+            [this](TtlSweeper &sweeper) { sweep_expired(sweeper); });
+    }
+
+    AEVUM_LOG_INFO("Core: Database engine is online and ready for operations.");
+}
+
+/**
+ * @brief Destroys the `Core` engine, ensuring a graceful shutdown.
+ * @details The memory budget, the TTL sweeper, and the index image writer are stopped first. The
+ * collections written to since their last image are then imaged, so that the next start loads
+ * them without reading storage, and the `_id` filters are stored so that it can answer lookups
+ * of absent `_id`s in collections it has not loaded yet.
+ */
+Core::~Core() {
+    AEVUM_LOG_INFO("Core: Shutting down database engine.");
+    memory_budget_.reset();
+    ttl_sweeper_.reset();
+    image_writer_.reset();
+    if (index_images_) {
+        try {
+            write_index_images(nullptr);
+        } catch (const std::exception &e) {
+            AEVUM_LOG_WARN(std::string("Core: Failed to write the index images: ") + e.what());
+        }
+    }
+    if (auto status = index_manager_.persist_id_filters(); !status.ok()) {
+        AEVUM_LOG_WARN("Core: Failed to store the _id filters. Status: " + status.to_string());
+    }
+}
+
+/**
+ * @brief Loads all system and user data from the persistent `WiredTigerStore` into the
+ * appropriate in-memory managers.
+ * @details This function is a critical part of the startup process. It lists all collections
+ * (tables) in the database and processes them in two stages:
+ * - The system collections are loaded first, on the calling thread, as a barrier: `_indexes`
+ *   (secondary index definitions, which loading a collection's indexes needs), then `_schemas`
+ *   and `_auth`. See `load_system_collection`.
+ * - `_index.*`: Persisted index entries, read as part of the collection they index.
+ * - `_oplog`: The change log, read by the `ChangeLog` itself.
+ * - `_replication`: The position of a replica in its primary's change log.
+ * - All other collections are treated as user data collections and handed to
+ *   `load_user_collections`, which loads them in parallel. With `lazy_load` set, they are only
+ *   recorded in `unloaded_` and loaded by `ensure_resident` on first use.
+ *
+ * @param lazy_load `true` to defer loading the user collections until first use.
+ */
+void Core::load_all(bool lazy_load) {
+    AEVUM_LOG_INFO("Core: Starting data loading sequence from persistence layer.");
+    auto started = std::chrono::steady_clock::now();
+    auto collections = storage_.list_collections();
+    AEVUM_LOG_DEBUG("Core: Discovered " + std::to_string(collections.size()) +
+                    " collections in storage.");
+
+    for (const char *system_name : {"_indexes", "_schemas", "_auth"}) {
+        if (std::find(collections.begin(), collections.end(), system_name) != collections.end()) {
+            load_system_collection(system_name);
+        }
+    }
+
+    std::vector<std::string> user_collections;
+    for (auto &name : collections) {
+        if (!is_user_collection(name)) continue;
+        if (lazy_load) {
+            AEVUM_LOG_DEBUG("Core: Deferring load of collection '" + name + "' until first use.");
+            unloaded_.insert(std::move(name));
+            continue;
+        }
+        user_collections.push_back(std::move(name));
+    }
+    load_user_collections(std::move(user_collections));
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+    AEVUM_LOG_INFO("Core: Data loading sequence complete in " + std::to_string(elapsed.count()) +
+                   " ms. " + std::to_string(unloaded_.size()) +
+                   " collections deferred until first use.");
+}
+
+/**
+ * @brief Loads one of the system collections into its manager.
+ * @details
+ * - `_indexes`: Loads secondary index definitions, and the `_id` filters stored at the last
+ *   shutdown, into the `IndexManager`.
+ * - `_schemas`: Loads schema definitions into the `SchemaManager`.
+ * - `_auth`: Loads user credentials into the `AuthManager`.
+ *
+ * @param name The name of the system collection.
+ */
+void Core::load_system_collection(const std::string &name) {
+    AEVUM_LOG_DEBUG("Core: Loading system collection '" + name + "'.");
+    if (name == "_indexes") {
+        auto index_status = index_manager_.load_all_index_definitions();
+        if (!index_status.ok()) {
+            AEVUM_LOG_WARN("Core: Failed to load index definitions. Status: " +
+                           index_status.to_string());
+        }
+        if (auto filter_status = index_manager_.load_id_filters(); !filter_status.ok()) {
+            AEVUM_LOG_WARN("Core: Failed to load _id filters. Status: " +
+                           filter_status.to_string());
+        }
+        return;
+    }
+
+    std::vector<aevum::bson::doc::Document> docs = storage_.load_collection(name);
+    AEVUM_LOG_DEBUG("Core: Loaded " + std::to_string(docs.size()) + " documents from collection '" +
+                    name + "'.");
+
+    if (name == "_schemas") {
+        for (const auto &doc : docs) {
+            bson_iter_t iter;
+            if (bson_iter_init_find(&iter, doc.get(), "collection") &&
+                BSON_ITER_HOLDS_UTF8(&iter)) {
+                std::string coll_name = bson_iter_utf8(&iter, nullptr);
+                schema_manager_.add_schema_to_cache(coll_name, aevum::bson::doc::Document(doc));
+            }
+        }
+        return;
+    }
+
+    for (const auto &doc : docs) {
+        bson_iter_t iter;
+        std::string key_hash;
+        auth::Credential credential;
+        auth::UserRole role = auth::UserRole::READ_ONLY;
+
+        if (bson_iter_init_find(&iter, doc.get(), "key_hash") && BSON_ITER_HOLDS_UTF8(&iter)) {
+            key_hash = bson_iter_utf8(&iter, nullptr);
+        }
+        if (bson_iter_init_find(&iter, doc.get(), "role") && BSON_ITER_HOLDS_UTF8(&iter)) {
+            std::string role_str = bson_iter_utf8(&iter, nullptr);
+            if (role_str == "ADMIN")
+                role = auth::UserRole::ADMIN;
+            else if (role_str == "READ_WRITE")
+                role = auth::UserRole::READ_WRITE;
+        }
+
+        // A user stored without a verifier logs in on its hash alone. A damaged verifier, or
+        // one whose iterations are out of range, is not downgraded to that: the user is kept
+        // with no role, so that every request of its key is refused and no default admin is
+        // bootstrapped in its place.
+        if (bson_iter_init_find(&iter, doc.get(), "kdf_key")) {
+            int64_t iterations = 0;
+            if (BSON_ITER_HOLDS_UTF8(&iter) &&
+                aevum::util::crypto::from_hex(bson_iter_utf8(&iter, nullptr),
+                                              credential.kdf_key) &&
+                bson_iter_init_find(&iter, doc.get(), "kdf_salt") && BSON_ITER_HOLDS_UTF8(&iter) &&
+                aevum::util::crypto::from_hex(bson_iter_utf8(&iter, nullptr),
+                                              credential.kdf_salt) &&
+                bson_iter_init_find(&iter, doc.get(), "kdf_iterations") &&
+                BSON_ITER_HOLDS_INT64(&iter)) {
+                iterations = bson_iter_int64(&iter);
+            }
+            if (credential.kdf_key.empty() || iterations < 1 ||
+                iterations > auth::MAX_KDF_ITERATIONS) {
+                AEVUM_LOG_WARN("Core: Refusing a user of '" + name +
+                               "' whose key verifier is damaged or out of range.");
+                role = auth::UserRole::NONE;
+                credential.kdf_key.clear();
+            } else {
+                credential.kdf_iterations = static_cast<uint32_t>(iterations);
+            }
+        }
+
+        if (!key_hash.empty()) {
+            credential.role = role;
+            auth_manager_.add_user(key_hash, std::move(credential));
+        }
+    }
+    AEVUM_LOG_INFO("Core: Security policies and user roles loaded into cache.");
+}
+
+/**
+ * @brief Loads user collections into the primary and secondary indexes in parallel.
+ * @details A `ThreadPool` of `load_threads_` workers (one per hardware thread by default) runs
+ * the load in two rounds, each ended by waiting on the futures of its tasks:
+ * 1. Every collection is split into `threads / collections` key ranges (at least one) using
+ *    `WiredTigerStore::sample_split_keys`, and each range is read and deserialized by its own
+ *    task, through its own pooled WiredTiger session. A single huge collection is therefore read
+ *    by every worker, and many small ones by one worker each.
+ * 2. Each collection's ranges are concatenated in key order and passed to
+ *    `IndexManager::load_collection_indexes`, which reads the persisted secondary index entries
+ *    and builds the primary index outside of its exclusive lock.
+ *
+ * With `CoreOptions::index_images`, a round comes first in which every collection is loaded
+ * from its image by a task of its own, and only the collections without a usable image go
+ * through the two rounds above.
+ *
+ * The tasks only touch storage, the change log, and the index manager, all of which are
+ * thread-safe; the collection locks are not needed since the engine is not yet serving requests.
+ * Waiting on the futures rethrows any exception raised by a task, which, like a storage failure
+ * in the constructor, is fatal.
+ * With a single thread, the collections are loaded one after another on the calling thread.
+ *
+ * @param names The names of the user collections to load.
+ */
+void Core::load_user_collections(std::vector<std::string> names) {
+    if (names.empty()) return;
+
+    size_t threads = load_threads_ != 0 ? load_threads_ : std::thread::hardware_concurrency();
+    if (index_images_) {
+        std::vector<char> imaged(names.size(), 0);
+        {
+            aevum::util::concurrency::ThreadPool pool(
+                "Loader", std::max<size_t>(1, std::min(threads, names.size())));
+            std::vector<std::future<void>> pending;
+            pending.reserve(names.size());
+            for (size_t i = 0; i < names.size(); ++i) {
+                pending.push_back(pool.enqueue(
+                    [this, &names, &imaged, i]() { imaged[i] = load_collection_image(names[i]); }));
+            }
+            for (auto &task : pending) task.get();
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (!imaged[i]) names[kept++] = std::move(names[i]);
+        }
+        names.resize(kept);
+        if (names.empty()) return;
+    }
+
+    if (threads <= 1) {
+        for (const auto &name : names) {
+            AEVUM_LOG_INFO("Core: Loading user collection '" + name + "'.");
+            index_manager_.load_collection_indexes(name, storage_.load_collection(name));
+        }
+        return;
+    }
+
+    struct CollectionLoad {
+        const std::string *name;
+        std::vector<std::string> splits;
+        std::vector<std::vector<aevum::bson::doc::Document>> ranges;
+    };
+    size_t partitions = std::max<size_t>(1, threads / names.size());
+    std::vector<CollectionLoad> loads(names.size());
+    size_t tasks = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        loads[i].name = &names[i];
+        loads[i].splits = storage_.sample_split_keys(names[i], partitions);
+        loads[i].ranges.resize(loads[i].splits.size() + 1);
+        tasks += loads[i].ranges.size();
+    }
+    threads = std::min(threads, tasks);
+    AEVUM_LOG_INFO("Core: Loading " + std::to_string(names.size()) + " user collections in " +
+                   std::to_string(tasks) + " key ranges on " + std::to_string(threads) +
+                   " threads.");
+
+    aevum::util::concurrency::ThreadPool pool("Loader", threads);
+    std::vector<std::future<void>> pending;
+    pending.reserve(tasks);
+    for (auto &load : loads) {
+        for (size_t r = 0; r < load.ranges.size(); ++r) {
+            pending.push_back(pool.enqueue([this, &load, r]() {
+                std::string_view lower = r == 0 ? std::string_view() : load.splits[r - 1];
+                std::string_view upper =
+                    r == load.splits.size() ? std::string_view() : load.splits[r];
+                load.ranges[r] = storage_.load_collection_range(*load.name, lower, upper);
+            }));
+        }
+    }
+    for (auto &task : pending) task.get();
+    pending.clear();
+
+    for (auto &load : loads) {
+        pending.push_back(pool.enqueue([this, &load]() {
+            std::vector<aevum::bson::doc::Document> docs = std::move(load.ranges.front());
+            for (size_t r = 1; r < load.ranges.size(); ++r) {
+                docs.insert(docs.end(), std::make_move_iterator(load.ranges[r].begin()),
+                            std::make_move_iterator(load.ranges[r].end()));
+            }
+            load.ranges.clear();
+            index_manager_.load_collection_indexes(*load.name, std::move(docs));
+        }));
+    }
+    for (auto &task : pending) task.get();
+}
+
+/**
+ * @brief Loads a user collection from its index image.
+ * @details The image must be valid, and its sequence number no newer than the change log's last
+ * one, which it would only be if it outlived the records it was stamped with. The records of the
+ * collection after that number name the documents changed since the image was written; they are
+ * read in batches, and their current versions read from storage. If the change log no longer
+ * holds all of them, the image is outdated. Such an image, or an invalid one, is deleted, and the
+ * writer images the collection again once it is loaded from storage.
+ *
+ * Once the collection is loaded, its write generation is recorded if the image held it exactly,
+ * so that the image is not written again before the collection changes.
+ * @param name The name of the collection.
+ * @return `true` if the collection was loaded from its image.
+ */
+bool Core::load_collection_image(const std::string &name) {
+    if (!index_images_) return false;
+    std::string path = index::IndexImage::path(storage_.base_path(), name);
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return false;
+
+    auto reject = [&](const std::string &reason) {
+        AEVUM_LOG_WARN("Core: Discarding the index image of collection '" + name + "': " +
+                       reason);
+        images_rejected_.fetch_add(1, std::memory_order_relaxed);
+        std::filesystem::remove(path, ec);
+        return false;
+    };
+    index::IndexImage image;
+    if (auto status = image.open(path, name); !status.ok()) return reject(status.to_string());
+    if (image.sequence() > change_log_.stats().last_sequence) {
+        return reject("it is ahead of the change log.");
+    }
+
+    static constexpr size_t CHANGE_BATCH = 4096;
+    std::unordered_set<std::string> changed;
+    std::vector<Change> changes;
+    uint64_t resume_token = image.sequence();
+    do {
+        changes.clear();
+        if (auto status = change_log_.read(resume_token, name, CHANGE_BATCH, changes, resume_token);
+            !status.ok()) {
+            return reject(status.to_string());
+        }
+        for (auto &change : changes) changed.insert(std::move(change.id));
+    } while (changes.size() == CHANGE_BATCH);
+
+    std::vector<aevum::bson::doc::Document> current;
+    current.reserve(changed.size());
+    for (const auto &id : changed) {
+        aevum::bson::doc::Document doc;
+        auto status = storage_.get(name, id, doc);
+        if (status.ok()) {
+            current.push_back(std::move(doc));
+        } else if (status.code() != aevum::util::StatusCode::kNotFound) {
+            AEVUM_LOG_WARN("Core: Cannot read document '" + id + "' of collection '" + name +
+                           "' changed since its index image. Status: " + status.to_string());
+            return false;
+        }
+    }
+
+    AEVUM_LOG_INFO("Core: Loading collection '" + name + "' from its index image of " +
+                   std::to_string(image.document_count()) + " documents, " +
+                   std::to_string(changed.size()) + " of them changed since.");
+    index_manager_.load_collection_image(name, image, changed, std::move(current));
+    images_loaded_.fetch_add(1, std::memory_order_relaxed);
+    if (changed.empty()) {
+        std::lock_guard<std::mutex> lock(image_mutex_);
+        image_generations_[name] = write_generation(name);
+    }
+    return true;
+}
+
+/**
+ * @brief Loads a collection into the primary and secondary indexes if it is unloaded.
+ * @details The common case, a collection that is already resident, is decided without the
+ * collection's lock. Otherwise its exclusive lock is taken and the check repeated, so that
+ * concurrent callers load the collection only once. The collection leaves `unloaded_` only once
+ * it is loaded, still under its exclusive lock.
+ *
+ * @param coll The name of the collection.
+ */
+void Core::ensure_resident(std::string_view coll) {
+    if (!is_unloaded(coll)) return;
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    load_resident_locked(coll);
+}
+
+/**
+ * @brief Loads a collection into the indexes if it is unloaded, under its exclusive lock.
+ * @param coll The name of the collection, whose lock the caller holds exclusively.
+ */
+void Core::load_resident_locked(std::string_view coll) {
+    if (!is_unloaded(coll)) return;
+    std::string name(coll);
+    AEVUM_LOG_INFO("Core: Loading collection '" + name + "' on first use.");
+    if (!load_collection_image(name)) {
+        index_manager_.load_collection_indexes(name, storage_.load_collection(name));
+    }
+    std::lock_guard<std::mutex> unloaded_lock(unloaded_mutex_);
+    unloaded_.erase(name);
+    evicted_.erase(name);
+}
+
+/**
+ * @brief Takes the shared lock of a collection, loading the collection first if it is unloaded.
+ * @details The collection is pinned from before it is loaded until the lock is taken, so the
+ * memory budget cannot evict it in between.
+ * @param coll The name of the collection.
+ * @return The shared lock, under which the collection is resident.
+ */
+std::shared_lock<std::shared_mutex> Core::lock_resident(std::string_view coll) {
+    if (!is_unloaded(coll)) {
+        std::shared_lock<std::shared_mutex> lock = read_lock(coll);
+        if (!is_unloaded(coll)) return lock;
+    }
+    pin_resident(coll);
+    AEVUM_DEFER([&]() { unpin_resident(coll); });
+    ensure_resident(coll);
+    return std::shared_lock<std::shared_mutex>(collection_lock(coll));
+}
+
+/**
+ * @brief Releases the shared lock of a collection, loads the collection, and takes the lock again.
+ * @details The collection is pinned as by `lock_resident`.
+ * @param coll The name of the collection.
+ * @param lock The caller's shared lock of the collection.
+ */
+void Core::relock_resident(std::string_view coll, std::shared_lock<std::shared_mutex> &lock) {
+    pin_resident(coll);
+    AEVUM_DEFER([&]() { unpin_resident(coll); });
+    lock.unlock();
+    ensure_resident(coll);
+    lock.lock();
+}
+
+/**
+ * @brief Keeps the memory budget from evicting a collection until `unpin_resident`.
+ * @param coll The name of the collection.
+ */
+void Core::pin_resident(std::string_view coll) {
+    if (!may_unload_) return;
+    std::lock_guard<std::mutex> lock(unloaded_mutex_);
+    ++pins_[std::string(coll)];
+}
+
+/**
+ * @brief Releases a pin of `pin_resident`.
+ * @param coll The name of the collection.
+ */
+void Core::unpin_resident(std::string_view coll) {
+    if (!may_unload_) return;
+    std::lock_guard<std::mutex> lock(unloaded_mutex_);
+    auto it = pins_.find(std::string(coll));
+    if (it != pins_.end() && --it->second == 0) pins_.erase(it);
+}
+
+/**
+ * @brief Evicts the least recently used user collections from the indexes.
+ * @details The resident user collections are visited in order of the time their lock was last
+ * looked up. Each is evicted under its exclusive lock, which is only tried, so that the budget
+ * never waits for a long write; a collection whose lock is busy is in use and skipped anyway,
+ * as is one pinned by a caller about to lock it. Evicting a collection drops its documents and
+ * index entries from memory and returns it to `unloaded_`; its index definitions, persisted
+ * entries, and `_id` filter are kept, so it is served from storage and loaded again as a
+ * collection deferred by `lazy_load`. Time-series collections hold no documents in memory and are
+ * never evicted.
+ * @param bytes The bytes to free.
+ * @return The estimated bytes freed.
+ */
+size_t Core::evict_collections(size_t bytes) {
+    std::vector<std::pair<int64_t, std::string>> candidates;
+    for (auto &name : storage_.list_collections()) {
+        if (!is_user_collection(name) || time_series_.options(name) || is_unloaded(name)) continue;
+        CollectionState *state = collection_states_.find(name);
+        int64_t last_used = state ? state->last_used.load(std::memory_order_relaxed) : 0;
+        candidates.emplace_back(last_used, std::move(name));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t freed = 0;
+    for (const auto &[last_used, name] : candidates) {
+        if (freed >= bytes) break;
+        // Looked up without `collection_lock`, which would stamp the collection as used.
+        std::unique_lock<std::shared_mutex> lock(collection_states_.find_or_add(name).lock,
+                                                 std::try_to_lock);
+        if (!lock.owns_lock()) continue;
+        {
+            std::lock_guard<std::mutex> unloaded_lock(unloaded_mutex_);
+            if (unloaded_.count(name) != 0 || pins_.count(name) != 0) continue;
+            unloaded_.insert(name);
+            evicted_.insert(name);
+        }
+        index::CollectionMemory memory = index_manager_.memory_usage(name);
+        index_manager_.unload_collection_indexes(name);
+        freed += memory.documents + memory.indexes;
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+        AEVUM_LOG_INFO("Core: Evicted collection '" + name + "' from memory, freeing about " +
+                       std::to_string(memory.documents + memory.indexes) + " bytes.");
+    }
+    return freed;
+}
+
+/**
+ * @brief Checks whether a collection is unloaded.
+ * @param coll The name of the collection.
+ * @return `true` if the collection's documents are only in storage.
+ */
+bool Core::is_unloaded(std::string_view coll) const {
+    if (!may_unload_) return false;
+    std::lock_guard<std::mutex> lock(unloaded_mutex_);
+    return unloaded_.count(std::string(coll)) != 0;
+}
+
+/**
+ * @brief Returns the reader-writer lock of a collection, creating it on first use.
+ * @details If collections can be unloaded, the lookup stamps the collection as used now for the
+ * memory budget. The stamp is only stored if it changed, so a collection under constant use is
+ * not written to on every request.
+ * @param coll The name of the collection.
+ * @return The collection's lock, which lives as long as the engine.
+ */
+std::shared_mutex &Core::collection_lock(std::string_view coll) const {
+    CollectionState *found = collection_states_.find(coll);
+    if (!found) {
+        found = &collection_states_.find_or_add(coll);
+        // Reads that found no collection under this name end before it is first written.
+        std::unique_lock<std::shared_mutex> barrier(absent_lock_);
+    }
+    CollectionState &state = *found;
+    if (may_unload_) {
+        int64_t now = aevum::util::time::CoarseClock::steady_ms();
+        if (state.last_used.load(std::memory_order_relaxed) != now) {
+            state.last_used.store(now, std::memory_order_relaxed);
+        }
+    }
+    return state.lock;
+}
+
+/**
+ * @brief Checks whether a collection has been registered by a write or is in storage.
+ * @param coll The name of the collection.
+ * @return `true` if the collection exists.
+ */
+bool Core::collection_exists(std::string_view coll) {
+    return collection_states_.find(coll) != nullptr || storage_.has_collection(coll);
+}
+
+/**
+ * @brief Takes the shared lock of a collection for a read, without registering a collection
+ * that does not exist.
+ * @details Client-supplied names of collections that do not exist would otherwise each add a
+ * `CollectionState` that is never freed. Such a read takes `absent_lock_` instead and checks
+ * again under it: a name registered since then gets its own lock, and one registered later waits
+ * in `collection_lock` for the read to end, so the read never overlaps a write of the collection.
+ * @param coll The name of the collection.
+ * @return The shared lock.
+ */
+std::shared_lock<std::shared_mutex> Core::read_lock(std::string_view coll) {
+    if (!collection_exists(coll)) {
+        std::shared_lock<std::shared_mutex> absent(absent_lock_);
+        if (!collection_exists(coll)) return absent;
+    }
+    return std::shared_lock<std::shared_mutex>(collection_lock(coll));
+}
+
+/**
+ * @brief Runs a query against an unloaded collection directly in storage.
+ * @details A primary lookup reads each listed document with `WiredTigerStore::get` and, unless the
+ * plan covers the query, confirms them with the matcher. A full scan streams the table in batches
+ * of `STORAGE_SCAN_BATCH` documents; each batch is matched by `select_matches` with a limit of
+ * however many matches are still wanted, and the matched documents are moved out of the batch
+ * before the next one is read. Memory use is therefore bounded by the batch size plus the result
+ * set.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan to execute.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return The matching documents in result order.
+ */
+std::vector<aevum::bson::doc::Document> Core::find_in_storage(std::string_view coll,
+                                                              const query::QueryPlan &plan,
+                                                              std::string_view query_json,
+                                                              std::string_view sort_json,
+                                                              int64_t limit, int64_t skip) {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    std::string q_str(query_json);
+    std::vector<aevum::bson::doc::Document> results;
+
+    if (plan.type == query::PlanType::PRIMARY_LOOKUP) {
+        std::vector<aevum::bson::doc::Document> docs = read_by_ids(coll, plan.ids);
+        if (plan.covered) {
+            // Only a single `_id` equality is covered.
+            query::ProfileScope::note_examined(docs.size());
+            if (skip <= 0) results = std::move(docs);
+            return results;
+        }
+        std::vector<const aevum::bson::doc::Document *> refs;
+        refs.reserve(docs.size());
+        for (const auto &doc : docs) refs.push_back(&doc);
+        for (const auto *match : select_matches(counters_, scan_pool_.get(), std::move(refs), plan,
+                                                q_str, std::string(sort_json), limit, skip)) {
+            results.push_back(std::move(docs[static_cast<size_t>(match - docs.data())]));
+        }
+        return results;
+    }
+
+    const size_t to_skip = skip > 0 ? static_cast<size_t>(skip) : 0;
+    const size_t wanted = limit > 0 ? to_skip + static_cast<size_t>(limit) : 0;
+    size_t scanned = 0;
+    auto status = storage_.scan_collection(
+        coll, STORAGE_SCAN_BATCH, [&](std::vector<aevum::bson::doc::Document> &docs) {
+            scanned += docs.size();
+            std::vector<const aevum::bson::doc::Document *> refs;
+            refs.reserve(docs.size());
+            for (const auto &doc : docs) refs.push_back(&doc);
+            size_t remaining = wanted > 0 ? wanted - results.size() : 0;
+            for (const auto *match :
+                 select_matches(counters_, scan_pool_.get(), std::move(refs), plan, q_str, "{}",
+                                static_cast<int64_t>(remaining), 0)) {
+                results.push_back(std::move(docs[static_cast<size_t>(match - docs.data())]));
+            }
+            return wanted == 0 || results.size() < wanted;
+        });
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("Core: Storage scan of collection '" + std::string(coll) +
+                        "' failed. Status: " + status.to_string());
+    }
+    AEVUM_LOG_DEBUG("Core: Streamed " + std::to_string(scanned) +
+                    " documents of unloaded collection '" + std::string(coll) + "' from storage.");
+
+    results.erase(results.begin(), results.begin() + std::min(to_skip, results.size()));
+    return results;
+}
+
+/**
+ * @brief Counts the matches of a query in an unloaded collection directly in storage.
+ * @details A primary lookup counts the documents read by `WiredTigerStore::get`; a full
+ * scan sums `count_matches` over batches of `STORAGE_SCAN_BATCH` documents streamed from the
+ * table.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan to execute.
+ * @param query_json The filter conditions.
+ * @return The number of matching documents.
+ */
+int Core::count_in_storage(std::string_view coll, const query::QueryPlan &plan,
+                           std::string_view query_json) {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    std::string q_str(query_json);
+    if (plan.type == query::PlanType::PRIMARY_LOOKUP) {
+        std::vector<aevum::bson::doc::Document> docs = read_by_ids(coll, plan.ids);
+        if (plan.covered) {
+            query::ProfileScope::note_examined(docs.size());
+            return static_cast<int>(docs.size());
+        }
+        std::vector<const aevum::bson::doc::Document *> refs;
+        refs.reserve(docs.size());
+        for (const auto &doc : docs) refs.push_back(&doc);
+        return count_matches(counters_, scan_pool_.get(), std::move(refs), plan, q_str);
+    }
+
+    int total = 0;
+    auto status = storage_.scan_collection(
+        coll, STORAGE_SCAN_BATCH, [&](std::vector<aevum::bson::doc::Document> &docs) {
+            std::vector<const aevum::bson::doc::Document *> refs;
+            refs.reserve(docs.size());
+            for (const auto &doc : docs) refs.push_back(&doc);
+            total += count_matches(counters_, scan_pool_.get(), std::move(refs), plan, q_str);
+            return true;
+        });
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("Core: Storage scan of collection '" + std::string(coll) +
+                        "' failed. Status: " + status.to_string());
+    }
+    return total;
+}
+
+/**
+ * @brief Reads documents of an unloaded collection by `_id` directly from storage.
+ * @details An `_id` that the collection's `_id` filter rules out is not read.
+ * @param coll The name of the collection.
+ * @param ids The `_id`s to read.
+ * @return The documents found, in the order of `ids`; missing `_id`s are skipped.
+ */
+std::vector<aevum::bson::doc::Document> Core::read_by_ids(std::string_view coll,
+                                                          const std::vector<std::string> &ids) {
+    std::vector<aevum::bson::doc::Document> docs;
+    docs.reserve(ids.size());
+    for (const auto &id : ids) {
+        if (!index_manager_.may_contain_id(coll, id)) continue;
+        aevum::bson::doc::Document doc;
+        if (storage_.get(coll, id, doc).ok()) docs.push_back(std::move(doc));
+    }
+    return docs;
+}
+
+/**
+ * @brief Parses a JSON query and sort and runs them through the query planner.
+ * @param coll The name of the collection to query.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @return The chosen plan, or a full-scan plan if the query cannot be parsed.
+ */
+query::QueryPlan Core::make_plan(std::string_view coll, std::string_view query_json,
+                                 std::string_view sort_json) {
+    query::PhaseTimer phase(query::ProfilePhase::PLAN);
+    aevum::bson::doc::Document query_doc;
+    if (!aevum::bson::json::parse(query_json, query_doc).ok()) {
+        return {};
+    }
+    aevum::bson::doc::Document sort_doc;
+    if (!aevum::bson::json::parse(sort_json, sort_doc).ok()) {
+        sort_doc = aevum::bson::doc::Document();
+    }
+    return make_plan(coll, query_doc, sort_doc, aevum::bson::doc::Matcher::compile(query_json));
+}
+
+/**
+ * @brief Runs a parsed query through the query planner.
+ * @details The matcher of a text search is compiled from the query without `$text`, which
+ * neither matcher supports.
+ * @param coll The name of the collection to query.
+ * @param query The parsed query.
+ * @param sort The parsed sort order.
+ * @param matcher The compiled query, or empty.
+ * @return The chosen plan.
+ */
+query::QueryPlan Core::make_plan(std::string_view coll, const aevum::bson::doc::Document &query,
+                                 const aevum::bson::doc::Document &sort,
+                                 std::optional<aevum::bson::doc::Matcher> matcher) {
+    query::QueryPlan plan = query::plan_query(coll, query, sort, index_manager_);
+    // The keys of an integer-keyed collection are the decimal strings of its `_id`s, which a
+    // string `_id` can equal, so there the matcher confirms the type of a looked-up `_id`.
+    if (plan.covered && storage_.key_format(coll) == storage::KeyFormat::INT64) {
+        plan.covered = false;
+    }
+    plan.matcher = plan.type == query::PlanType::TEXT_SEARCH
+                       ? aevum::bson::doc::Matcher::compile(plan.text_query)
+                       : std::move(matcher);
+    counters_.plans[static_cast<size_t>(plan.type)].fetch_add(1, std::memory_order_relaxed);
+    query::ProfileScope::note_plan(plan.type);
+    AEVUM_LOG_DEBUG("Core: Planned query on collection '" + std::string(coll) + "' as " +
+                    std::string(query::to_string(plan.type)) + ".");
+    return plan;
+}
+
+/**
+ * @brief Resolves a query plan to the candidate documents it designates.
+ * @details A primary lookup resolves each of its `_id`s. For an index probe, each predicate
+ * contributes the list of `_id`s stored under its key (hash index) or within its key range
+ * (ordered index); an `$in` predicate contributes the union of its elements' lists. The lists
+ * are intersected from the
+ * shortest upwards, so the work is bounded by the most selective index. Every surviving `_id` is
+ * resolved through the primary index, which also discards duplicates and any entry that the
+ * primary index no longer holds. A column scan hands its predicates to the columnar indexes,
+ * which select the candidates without walking a single document. A text search resolves the
+ * `_id`s its text indexes rank, in descending order of score.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan to execute.
+ * @param wanted For a text search, the number of best documents to resolve, or 0 for all.
+ * @return Non-owning pointers into the primary index; valid while the collection's lock is held.
+ */
+std::vector<const aevum::bson::doc::Document *> Core::collect_candidates(
+    std::string_view coll, const query::QueryPlan &plan, size_t wanted) const {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    switch (plan.type) {
+        case query::PlanType::PRIMARY_LOOKUP: {
+            std::vector<const aevum::bson::doc::Document *> candidates;
+            candidates.reserve(plan.ids.size());
+            for (const auto &id : plan.ids) {
+                if (const auto *doc = index_manager_.get_document_ref_by_id(coll, id)) {
+                    candidates.push_back(doc);
+                }
+            }
+            return candidates;
+        }
+        case query::PlanType::INDEX_PROBE: {
+            auto lookup = [&](const query::IndexPredicate &predicate) {
+                if (predicate.type == index::IndexType::ORDERED) {
+                    return index_manager_.get_ids_in_range(coll, predicate.field, predicate.range);
+                }
+                return index_manager_.get_ids_by_secondary_index(coll, predicate.field,
+                                                                 predicate.key);
+            };
+            std::vector<std::vector<std::string>> postings;
+            postings.reserve(plan.predicates.size());
+            for (const auto &predicate : plan.predicates) {
+                if (predicate.any_of.empty()) {
+                    postings.push_back(lookup(predicate));
+                    continue;
+                }
+                // Duplicates across the union are discarded when the ids are resolved below.
+                std::vector<std::string> &ids = postings.emplace_back();
+                for (const auto &point : predicate.any_of) {
+                    std::vector<std::string> found = lookup(point);
+                    ids.insert(ids.end(), std::make_move_iterator(found.begin()),
+                               std::make_move_iterator(found.end()));
+                }
+            }
+            std::sort(postings.begin(), postings.end(),
+                      [](const auto &a, const auto &b) { return a.size() < b.size(); });
+
+            std::vector<std::string> &ids = postings.front();
+            for (size_t i = 1; i < postings.size() && !ids.empty(); ++i) {
+                std::unordered_set<std::string_view> other(postings[i].begin(), postings[i].end());
+                ids.erase(std::remove_if(ids.begin(), ids.end(),
+                                         [&](const std::string &id) { return !other.count(id); }),
+                          ids.end());
+            }
+
+            std::vector<const aevum::bson::doc::Document *> candidates;
+            std::unordered_set<std::string_view> seen;
+            candidates.reserve(ids.size());
+            for (const auto &id : ids) {
+                if (!seen.insert(id).second) continue;
+                if (const auto *doc = index_manager_.get_document_ref_by_id(coll, id)) {
+                    candidates.push_back(doc);
+                }
+            }
+            return candidates;
+        }
+        case query::PlanType::COLUMN_SCAN:
+            return index_manager_.select_by_columns(coll, plan.column_predicates);
+        case query::PlanType::TEXT_SEARCH: {
+            std::vector<index::TextHit> hits =
+                index_manager_.search_text(coll, plan.text_search, wanted);
+            std::vector<const aevum::bson::doc::Document *> candidates;
+            candidates.reserve(hits.size());
+            for (const auto &hit : hits) {
+                if (const auto *doc = index_manager_.get_document_ref_by_id(coll, hit.id)) {
+                    candidates.push_back(doc);
+                }
+            }
+            return candidates;
+        }
+        case query::PlanType::INDEX_SCAN:
+        case query::PlanType::FULL_SCAN:
+        default:
+            return index_manager_.get_document_refs(coll);
+    }
+}
+
+/**
+ * @brief Runs a query through the zero-copy Rust FFI and returns borrowed pointers to the results.
+ * @details Only the candidate documents' BSON buffers are lent to `rust_find_bson`, which decodes,
+ * filters, sorts, and paginates them in place; a query the plan's native `Matcher` supports is
+ * filtered in C++ instead (see `select_matches`). The matcher is always given the complete query,
+ * so predicates already satisfied by an index are merely re-confirmed. A plan that covers the query
+ * on its own skips the FFI call entirely, and a plan whose sort is supplied by an ordered index is
+ * handed to `find_in_index_order`. The returned positions are resolved back to the borrowed
+ * documents. Nothing is serialized or copied.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan of the query.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return Non-owning pointers into the primary index; valid while the collection's lock is held.
+ */
+std::vector<const aevum::bson::doc::Document *> Core::find_matching_refs(
+    std::string_view coll, const query::QueryPlan &plan, std::string_view query_json,
+    std::string_view sort_json, int64_t limit, int64_t skip) const {
+    if (!plan.sort_field.empty()) {
+        return find_in_index_order(coll, plan, query_json, limit, skip);
+    }
+    // A text search with nothing else to match nor sort returns its best `skip + limit` hits.
+    size_t wanted = 0;
+    if (plan.type == query::PlanType::TEXT_SEARCH && limit > 0 && plan.matcher &&
+        plan.matcher->matches_everything() && is_empty_sort(sort_json)) {
+        wanted = static_cast<size_t>(limit) + static_cast<size_t>(std::max<int64_t>(skip, 0));
+    }
+    std::vector<const aevum::bson::doc::Document *> candidates =
+        collect_candidates(coll, plan, wanted);
+
+    if (plan.covered) {
+        // At most one document, which needs neither matching nor sorting.
+        query::ProfileScope::note_examined(candidates.size());
+        if (skip > 0) candidates.clear();
+        return candidates;
+    }
+
+    AEVUM_LOG_DEBUG("Core: Matching " + std::to_string(candidates.size()) +
+                    " BSON buffers from collection '" + std::string(coll) +
+                    (plan.matcher ? "' natively." : "' through FFI."));
+    return select_matches(counters_, scan_pool_.get(), std::move(candidates), plan,
+                          std::string(query_json), std::string(sort_json), limit, skip);
+}
+
+/**
+ * @brief Answers a query from the entries of its ordered index, without reading a document.
+ * @details The entries in the predicate's range are walked in the order the sort asks for, and
+ * ascending otherwise, which is the order `collect_candidates` yields them in. A string key is
+ * turned back into a UTF-8 value and a boolean key into a boolean, so each result is exactly the
+ * projection `apply_projection` would make of the document: `_id` first unless excluded, then
+ * the field. The keys of an integer-keyed collection are the decimal strings of its `_id`s,
+ * which are turned back into Int64 values, as every other path returns them.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan to execute.
+ * @param projection The parsed projection.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @param integer_keys `true` if the collection is integer-keyed.
+ * @return The projected results.
+ */
+std::vector<aevum::bson::doc::Document> Core::find_from_index(
+    std::string_view coll, const query::QueryPlan &plan,
+    const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip,
+    bool integer_keys) const {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    const query::IndexPredicate &predicate = plan.predicates.front();
+    std::vector<std::string> fields;
+    bool keep_id = true;
+    (void)query::included_fields(projection, fields, keep_id);
+
+    const size_t to_skip = skip > 0 ? static_cast<size_t>(skip) : 0;
+    const size_t wanted = limit > 0 ? static_cast<size_t>(limit) : 0;
+    size_t skipped = 0;
+    std::vector<aevum::bson::doc::Document> results;
+    index_manager_.scan_index_entries(
+        coll, predicate.field, predicate.range, plan.sort_descending,
+        [&](const index::IndexKey &key, const std::string &id) {
+            if (skipped < to_skip) {
+                ++skipped;
+                return true;
+            }
+            bson_t *out = bson_new();
+            int64_t integer_id = 0;
+            if (keep_id && integer_keys &&
+                std::from_chars(id.data(), id.data() + id.size(), integer_id).ec == std::errc()) {
+                bson_append_int64(out, "_id", 3, integer_id);
+            } else if (keep_id) {
+                bson_append_utf8(out, "_id", 3, id.data(), static_cast<int>(id.size()));
+            }
+            if (key.rank == index::KeyRank::STRING) {
+                bson_append_utf8(out, predicate.field.c_str(), -1, key.text.data(),
+                                 static_cast<int>(key.text.size()));
+            } else {
+                bson_append_bool(out, predicate.field.c_str(), -1, key.number != 0.0);
+            }
+            results.emplace_back(out);
+            return wanted == 0 || results.size() < wanted;
+        });
+    AEVUM_LOG_DEBUG("Core: Answered query on collection '" + std::string(coll) +
+                    "' from the entries of index '" + predicate.field + "'.");
+    return results;
+}
+
+/**
+ * @brief Runs a query whose sort order is supplied by an ordered index.
+ * @details Candidates are gathered into chunks in index order. Each full chunk is passed to
+ * `select_matches` with an empty sort and a limit of however many matches are still wanted, so
+ * the matcher stops early as well. The first chunk holds `skip + limit` candidates (at least
+ * `MIN_SCAN_CHUNK`) and every following chunk is twice as large, which keeps the number of FFI
+ * calls logarithmic when the filter is selective. Without a limit, every candidate is lent in a
+ * single call. Skipped matches are dropped at the end.
+ *
+ * @param coll The name of the collection to query.
+ * @param plan The plan to execute.
+ * @param query_json The filter conditions.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return Non-owning pointers into the primary index; valid while the collection's lock is held.
+ */
+std::vector<const aevum::bson::doc::Document *> Core::find_in_index_order(
+    std::string_view coll, const query::QueryPlan &plan, std::string_view query_json,
+    int64_t limit, int64_t skip) const {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    const size_t to_skip = skip > 0 ? static_cast<size_t>(skip) : 0;
+    const size_t wanted = limit > 0 ? to_skip + static_cast<size_t>(limit) : 0;
+    size_t chunk_size = wanted > 0 ? std::max(wanted, MIN_SCAN_CHUNK) : SIZE_MAX;
+
+    std::string q_str(query_json);
+    std::vector<const aevum::bson::doc::Document *> matches;
+    std::vector<const aevum::bson::doc::Document *> chunk;
+    size_t lent = 0;
+
+    auto flush = [&]() {
+        if (chunk.empty()) return;
+        size_t remaining = wanted > 0 ? wanted - matches.size() : 0;
+        lent += chunk.size();
+        for (const auto *match : select_matches(counters_, scan_pool_.get(), std::move(chunk),
+                                                plan, q_str, "{}",
+                                                static_cast<int64_t>(remaining), 0)) {
+            matches.push_back(match);
+        }
+        chunk.clear();
+        if (chunk_size <= SIZE_MAX / 2) chunk_size *= 2;
+    };
+    auto visit = [&](const aevum::bson::doc::Document *doc) {
+        chunk.push_back(doc);
+        if (chunk.size() >= chunk_size) flush();
+        return wanted == 0 || matches.size() < wanted;
+    };
+
+    if (plan.type == query::PlanType::INDEX_SCAN) {
+        index_manager_.scan_ordered_index(coll, plan.sort_field, index::KeyRange{},
+                                          plan.sort_descending, visit);
+    } else {
+        std::vector<const aevum::bson::doc::Document *> candidates =
+            collect_candidates(coll, plan);
+        order_by_field(candidates, plan.sort_field, plan.sort_descending);
+        for (const auto *doc : candidates) {
+            if (!visit(doc)) break;
+        }
+    }
+    if (wanted == 0 || matches.size() < wanted) flush();
+
+    AEVUM_LOG_DEBUG("Core: Lent " + std::to_string(lent) + " BSON buffers from collection '" +
+                    std::string(coll) + "' to FFI in the order of index '" + plan.sort_field +
+                    "'.");
+
+    matches.erase(matches.begin(), matches.begin() + std::min(to_skip, matches.size()));
+    return matches;
+}
+
+/**
+ * @brief Inserts a single document into a collection, ensuring data integrity and indexing.
+ * @details This is a write-locked operation. The workflow is as follows:
+ * 1. An exclusive lock is acquired on the collection's lock.
+ * 2. It checks for a pre-existing `_id`. If one is not found, a new UUIDv4 is generated and
+ *    prepended to the document.
+ * 3. The document is validated against the collection's schema via the `SchemaManager`.
+ * 4. The document is persisted to the `WiredTigerStore` without waiting for the journal, in one
+ *    transaction with its persisted secondary index entries.
+ * 5. The document is added to the primary and all relevant secondary indexes via the
+ * `IndexManager`.
+ * 6. The lock is released and the journal is flushed to the requested durability level.
+ *
+ * @param coll The name of the target collection.
+ * @param doc The `aevum::bson::doc::Document` to insert.
+ * @param durability How far the write is persisted before returning.
+ * @return A pair containing the operation status and the document's final `_id` string.
+ */
+std::pair<aevum::util::Status, std::string> Core::insert(std::string_view coll,
+                                                         aevum::bson::doc::Document doc,
+                                                         storage::Durability durability) {
+    if (time_series_.options(coll)) {
+        std::vector<aevum::bson::doc::Document> points;
+        points.push_back(std::move(doc));
+        return std::move(insert_points(coll, std::move(points), durability).front());
+    }
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    // Secondary index entries can only be maintained for a resident collection.
+    if (index_manager_.has_secondary_indexes(coll)) load_resident_locked(coll);
+    bump_write_generation(coll);
+    auto result = insert_locked(coll, std::move(doc));
+    if (!result.first.ok()) return result;
+
+    lock.unlock();
+    return {storage_.make_durable(durability), result.second};
+}
+
+/**
+ * @brief Inserts a document under the collection's exclusive lock; the body of `insert`.
+ * @details The document is persisted without waiting for the journal. A resident collection
+ * indexes it; an unloaded one only records its `_id` in its `_id` filter.
+ * @param coll The name of the target collection.
+ * @param doc The document to insert.
+ * @return The status of the insertion and the document's `_id`.
+ */
+std::pair<aevum::util::Status, std::string> Core::insert_locked(std::string_view coll,
+                                                                aevum::bson::doc::Document doc) {
+    AEVUM_LOG_DEBUG("Core: Beginning insert operation for collection '" + std::string(coll) + "'.");
+
+    std::string id_str;
+    if (auto status = ensure_id(doc, id_format(coll), storage_.key_format(coll), id_str);
+        !status.ok()) {
+        return {status, ""};
+    }
+
+    auto validation_status = schema_manager_.validate(coll, doc);
+    if (!validation_status.ok()) {
+        AEVUM_LOG_WARN("Core: Insert failed for collection '" + std::string(coll) +
+                       "' due to schema validation failure. Status: " +
+                       validation_status.to_string());
+        return {validation_status, ""};
+    }
+
+    // The document and its index entries are committed together. A document that overwrites an
+    // existing one retracts the entries of the previous image.
+    std::vector<storage::KeyWrite> entry_writes = index_manager_.index_entry_writes(
+        coll, index_manager_.get_document_ref_by_id(coll, id_str), &doc);
+    ChangeLog::Reservation changes = change_log_.reserve(1);
+    changes.append(entry_writes, ChangeType::INSERT, coll, id_str);
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.emplace_back(id_str, std::move(doc));
+    auto status = storage_.apply_batch(coll, puts, {}, entry_writes, storage::Durability::NONE);
+    doc = std::move(puts.front().second);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("Core: Insert failed for collection '" + std::string(coll) +
+                        "' during storage persistence. Status: " + status.to_string());
+        return {status, ""};
+    }
+    changes.commit();
+
+    // An unloaded collection picks the document up from storage when it is loaded; until then
+    // only its `_id` filter needs to learn about it.
+    if (!is_unloaded(coll)) {
+        index_manager_.add_document_to_indexes(coll, doc);
+    } else {
+        index_manager_.add_unloaded_ids(coll, {id_str});
+    }
+    AEVUM_LOG_INFO("Core: Successfully inserted document '" + id_str + "' into collection '" +
+                   std::string(coll) + "'.");
+    return {aevum::util::Status::OK(), id_str};
+}
+
+/**
+ * @brief Inserts a batch of documents into a collection with one storage transaction.
+ * @details This is a write-locked operation that amortizes every per-request cost of `insert`
+ * over the whole batch:
+ * 1. An exclusive lock is acquired on the collection's lock once.
+ * 2. Each document without an `_id` receives a generated UUIDv4, as in `insert`.
+ * 3. All documents are validated against the collection's schema in parallel by a single
+ *    `SchemaManager::validate_many` call. Invalid documents are reported and left out.
+ * 4. The valid documents are persisted with one `WiredTigerStore::apply_batch` transaction,
+ *    together with their persisted secondary index entries, so either all of them become
+ *    durable or none does.
+ * 5. They are added to the indexes under a single `IndexManager` lock.
+ * 6. The lock is released and the journal is flushed once to the requested durability level.
+ *
+ * @param coll The name of the target collection.
+ * @param docs The documents to insert. Ownership is taken by the function.
+ * @param durability How far the batch is persisted before returning.
+ * @return One pair per input document, in input order, holding its status and `_id`.
+ */
+std::vector<std::pair<aevum::util::Status, std::string>> Core::insert_many(
+    std::string_view coll, std::vector<aevum::bson::doc::Document> docs,
+    storage::Durability durability) {
+    if (time_series_.options(coll)) return insert_points(coll, std::move(docs), durability);
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    if (index_manager_.has_secondary_indexes(coll)) load_resident_locked(coll);
+    bump_write_generation(coll);
+    AEVUM_LOG_DEBUG("Core: Beginning bulk insert of " + std::to_string(docs.size()) +
+                    " documents into collection '" + std::string(coll) + "'.");
+
+    std::vector<std::pair<aevum::util::Status, std::string>> results;
+    results.reserve(docs.size());
+    aevum::util::uuid::IdFormat format = id_format(coll);
+    storage::KeyFormat key_format = storage_.key_format(coll);
+    for (auto &doc : docs) {
+        std::string id_str;
+        aevum::util::Status status = ensure_id(doc, format, key_format, id_str);
+        results.emplace_back(std::move(status), std::move(id_str));
+    }
+
+    std::vector<aevum::util::Status> validation = schema_manager_.validate_many(coll, docs);
+    // A document whose `_id` does not fit the collection's keys is refused like an invalid one.
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (!results[i].first.ok()) validation[i] = results[i].first;
+    }
+    // The index entries of every accepted document are computed before the documents move into
+    // the batch. A document repeating an `_id` of the batch replaces the earlier one.
+    std::vector<storage::KeyWrite> entry_writes;
+    std::unordered_map<std::string, const aevum::bson::doc::Document *> batch_images;
+    bool indexed = index_manager_.has_secondary_indexes(coll);
+    for (size_t i = 0; i < docs.size() && indexed; ++i) {
+        if (!validation[i].ok()) continue;
+        const std::string &id_str = results[i].second;
+        auto it = batch_images.find(id_str);
+        const aevum::bson::doc::Document *previous =
+            it != batch_images.end() ? it->second
+                                     : index_manager_.get_document_ref_by_id(coll, id_str);
+        auto writes = index_manager_.index_entry_writes(coll, previous, &docs[i]);
+        std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+        batch_images[id_str] = &docs[i];
+    }
+
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (!validation[i].ok()) {
+            results[i] = {validation[i], ""};
+            continue;
+        }
+        puts.emplace_back(results[i].second, std::move(docs[i]));
+    }
+
+    ChangeLog::Reservation changes = change_log_.reserve(puts.size());
+    for (const auto &put : puts) changes.append(entry_writes, ChangeType::INSERT, coll, put.first);
+    if (auto status =
+            storage_.apply_batch(coll, puts, {}, entry_writes, storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("Core: Bulk insert failed for collection '" + std::string(coll) +
+                        "' during storage persistence. Status: " + status.to_string());
+        for (auto &result : results) {
+            if (result.first.ok()) result = {status, ""};
+        }
+        return results;
+    }
+    changes.commit();
+
+    // The persisted documents are no longer needed by the batch and move into the indexes.
+    std::vector<aevum::bson::doc::Document> accepted;
+    accepted.reserve(puts.size());
+    for (auto &[id_str, doc] : puts) {
+        accepted.push_back(std::move(doc));
+    }
+    if (!is_unloaded(coll)) {
+        index_manager_.add_documents_to_indexes(coll, accepted);
+    } else {
+        std::vector<std::string> ids;
+        ids.reserve(puts.size());
+        for (const auto &put : puts) ids.push_back(put.first);
+        index_manager_.add_unloaded_ids(coll, ids);
+    }
+    AEVUM_LOG_INFO("Core: Successfully inserted " + std::to_string(accepted.size()) + " of " +
+                   std::to_string(docs.size()) + " documents into collection '" +
+                   std::string(coll) + "'.");
+
+    lock.unlock();
+    if (auto status = storage_.make_durable(durability); !status.ok()) {
+        for (auto &result : results) {
+            if (result.first.ok()) result.first = status;
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Performs an "upsert": updates the documents matching a query, or inserts the document if
+ * there are none.
+ * @details The whole operation runs under the collection's exclusive lock, so no concurrent write
+ * can slip in between the lookup and the write:
+ * 1. The query is planned once. On a collection that is not loaded yet, a primary lookup is
+ *    answered from storage (and usually by the `_id` filter alone); if nothing matches and the
+ *    collection has no secondary index, the document is inserted without loading it. Any other
+ *    case releases the lock, loads the collection, and starts over.
+ * 2. The candidates of the plan are matched in place, borrowing the primary index's documents, so
+ *    a lookup by `_id` or on an indexed field examines only the documents the index designates.
+ * 3. The matches are modified with `update_locked`, which persists and re-indexes only the
+ *    documents it changes, or, without any, the document is inserted with `insert_locked`.
+ *
+ * The journal is flushed to the requested durability level after the lock has been released.
+ * @param coll The target collection name.
+ * @param query_json A JSON query to find the documents to update.
+ * @param doc The update to apply to the matches, or the document to insert.
+ * @param durability How far the write is persisted before returning.
+ * @return The status of the operation and whether it updated or inserted.
+ */
+std::pair<aevum::util::Status, UpsertResult> Core::upsert(std::string_view coll,
+                                                          std::string_view query_json,
+                                                          const aevum::bson::doc::Document &doc,
+                                                          storage::Durability durability) {
+    query::ProfileScope profile(slow_ops_, "upsert", coll, query_json);
+    AEVUM_LOG_DEBUG("Core: Beginning upsert operation for collection '" + std::string(coll) + "'.");
+    UpsertResult result;
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "upserts"), result};
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    if (is_unloaded(coll)) {
+        query::QueryPlan plan = make_plan(coll, query_json, "{}");
+        if (plan.type == query::PlanType::PRIMARY_LOOKUP &&
+            !index_manager_.has_secondary_indexes(coll) &&
+            count_in_storage(coll, plan, query_json) == 0) {
+            bump_write_generation(coll);
+            auto [status, id] = insert_locked(coll, aevum::bson::doc::Document(doc));
+            if (!status.ok()) return {status, result};
+            result.inserted_id = std::move(id);
+            lock.unlock();
+            return {storage_.make_durable(durability), result};
+        }
+        load_resident_locked(coll);
+    }
+
+    bump_write_generation(coll);
+    std::vector<const aevum::bson::doc::Document *> matches =
+        find_matching_refs(coll, make_plan(coll, query_json, "{}"), query_json, "{}", 0, 0);
+    if (matches.empty()) {
+        AEVUM_LOG_DEBUG("Core: Upsert found no matching documents. Proceeding with insert path.");
+        auto [status, id] = insert_locked(coll, aevum::bson::doc::Document(doc));
+        if (!status.ok()) return {status, result};
+        result.inserted_id = std::move(id);
+    } else {
+        AEVUM_LOG_DEBUG("Core: Upsert found " + std::to_string(matches.size()) +
+                        " matching document(s). Proceeding with update path.");
+        auto [status, updated] =
+            update_locked(coll, matches, query_json, aevum::bson::json::to_string(doc));
+        if (!status.ok()) return {status, result};
+        result.updated = updated;
+    }
+
+    lock.unlock();
+    return {storage_.make_durable(durability), result};
+}
+
+/**
+ * @brief Counts documents in a collection matching a query via the Rust FFI.
+ * @details The cheapest answer the plan allows is taken. A query that matches everything is
+ * answered by the size of the primary index, and a single exact predicate on an ordered index
+ * (see `QueryPlan::index_only`) by the number of index entries in its range; neither touches a
+ * document. Otherwise only the candidates selected by the query planner are matched, natively if
+ * the plan has a `Matcher`, split across the scan pool when there are many of them, and through
+ * `rust_count_bson` otherwise. A plan that covers the query
+ * on its own is counted without calling into Rust at all. On a collection that has not been
+ * loaded yet, a primary lookup or full scan is counted directly in storage by
+ * `count_in_storage`; any other plan loads the collection first.
+ * @param coll The collection to query.
+ * @param query_json A JSON string representing the query criteria.
+ * @return The number of matching documents.
+ */
+int Core::count(std::string_view coll, std::string_view query_json) {
+    query::ProfileScope profile(slow_ops_, "count", coll, query_json);
+    int matched = count_matching(coll, query_json);
+    query::ProfileScope::note_returned(static_cast<size_t>(matched));
+    return matched;
+}
+
+/**
+ * @brief Counts the documents in a collection matching a query, taking the collection's lock.
+ * @details See `count` for the plans this chooses from.
+ */
+int Core::count_matching(std::string_view coll, std::string_view query_json) {
+    std::shared_lock<std::shared_mutex> lock = read_lock(coll);
+    if (time_series_.options(coll)) return count_time_series(coll, query_json);
+    query::QueryPlan plan = make_plan(coll, query_json, "{}");
+    if (is_unloaded(coll)) {
+        if (can_serve_from_storage(plan, "{}")) {
+            return count_in_storage(coll, plan, query_json);
+        }
+        relock_resident(coll, lock);
+    }
+    if (plan.type == query::PlanType::FULL_SCAN && plan.matcher &&
+        plan.matcher->matches_everything()) {
+        return static_cast<int>(index_manager_.document_count(coll));
+    }
+    if (plan.index_only) {
+        const query::IndexPredicate &predicate = plan.predicates.front();
+        return static_cast<int>(
+            index_manager_.count_in_range(coll, predicate.field, predicate.range));
+    }
+    std::vector<const aevum::bson::doc::Document *> candidates = collect_candidates(coll, plan);
+    if (plan.covered) {
+        query::ProfileScope::note_examined(candidates.size());
+        return static_cast<int>(candidates.size());
+    }
+
+    AEVUM_LOG_DEBUG("Core: Counting matches in collection '" + std::string(coll) +
+                    (plan.matcher ? "' natively." : "' through FFI."));
+    return count_matches(counters_, scan_pool_.get(), std::move(candidates), plan,
+                         std::string(query_json));
+}
+
+/**
+ * @brief Finds documents in a collection, delegating complex queries to the Rust FFI.
+ * @details This is a read-locked operation. The query planner selects the candidate documents
+ * from the primary index, from the secondary indexes, or from a full scan. A bare `_id` lookup is
+ * answered directly; for all other queries the candidates' raw BSON buffers are lent to the Rust
+ * FFI, which handles filtering, sorting, and pagination in place and returns only the positions
+ * of the results. The selected documents are then projected natively, without any JSON
+ * round-trip.
+ *
+ * On a collection that has not been loaded yet, a primary lookup or an unsorted full scan is
+ * answered directly from storage by `find_in_storage`, without loading the collection. Any other
+ * plan needs the indexes, so the collection is loaded first.
+ *
+ * A query that `query::index_covers_projection` accepts, unsorted or sorted on its index, is
+ * answered by `find_from_index` from the index entries alone, without touching a document.
+ *
+ * @return A vector of BSON documents that match the criteria.
+ */
+std::vector<aevum::bson::doc::Document> Core::find(std::string_view coll,
+                                                   std::string_view query_json,
+                                                   std::string_view sort_json,
+                                                   std::string_view projection_json, int64_t limit,
+                                                   int64_t skip) {
+    query::ProfileScope profile(slow_ops_, "find", coll, query_json, sort_json);
+    std::shared_lock<std::shared_mutex> lock = read_lock(coll);
+    AEVUM_LOG_DEBUG("Core: Beginning find operation for collection '" + std::string(coll) + "'.");
+
+    // A projection that fails to parse is treated as empty, matching the Rust engine's fallback.
+    // The common empty projection is recognized without being parsed.
+    aevum::bson::doc::Document projection_doc;
+    if (projection_json != "{}" &&
+        !aevum::bson::json::parse(projection_json, projection_doc).ok()) {
+        projection_doc = aevum::bson::doc::Document();
+    }
+
+    if (time_series_.options(coll)) {
+        return find_time_series(coll, query_json, sort_json, projection_doc, limit, skip);
+    }
+    return find_planned(
+        coll, [&] { return make_plan(coll, query_json, sort_json); }, query_json, sort_json,
+        projection_doc, limit, skip, lock);
+}
+
+/**
+ * @brief Runs a planned query on a collection whose lock the caller holds shared.
+ * @param coll The name of the collection.
+ * @param plan_query Plans the query.
+ * @param query_json The query.
+ * @param sort_json The sort order.
+ * @param projection The parsed projection.
+ * @param limit The maximum number of documents to return.
+ * @param skip The number of initial documents to skip.
+ * @param lock The shared lock of the collection.
+ * @return The matching documents.
+ */
+std::vector<aevum::bson::doc::Document> Core::find_planned(
+    std::string_view coll, const std::function<query::QueryPlan()> &plan_query,
+    std::string_view query_json, std::string_view sort_json,
+    const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip,
+    std::shared_lock<std::shared_mutex> &lock) {
+    // Documents read from storage for an unloaded collection are owned by `streamed`.
+    std::vector<aevum::bson::doc::Document> streamed;
+    std::vector<const aevum::bson::doc::Document *> matches;
+    query::QueryPlan plan = plan_query();
+    bool resident = true;
+    if (is_unloaded(coll)) {
+        if (can_serve_from_storage(plan, sort_json)) {
+            resident = false;
+            streamed = find_in_storage(coll, plan, query_json, sort_json, limit, skip);
+            matches.reserve(streamed.size());
+            for (const auto &doc : streamed) matches.push_back(&doc);
+        } else {
+            relock_resident(coll, lock);
+            // The indexes have only now been loaded.
+            plan = plan_query();
+        }
+    }
+    if (resident) {
+        if (query::index_covers_projection(plan, projection) &&
+            (is_empty_sort(sort_json) || plan.sort_field == plan.predicates.front().field)) {
+            std::vector<aevum::bson::doc::Document> results =
+                find_from_index(coll, plan, projection, limit, skip,
+                                storage_.key_format(coll) == storage::KeyFormat::INT64);
+            query::ProfileScope::note_returned(results.size());
+            return results;
+        }
+        matches = find_matching_refs(coll, plan, query_json, sort_json, limit, skip);
+    }
+
+    query::PhaseTimer phase(query::ProfilePhase::PARSE);
+    std::vector<aevum::bson::doc::Document> results;
+    results.reserve(matches.size());
+    for (const auto *match : matches) {
+        results.push_back(query::apply_projection(*match, projection));
+    }
+    query::ProfileScope::note_returned(results.size());
+    AEVUM_LOG_DEBUG("Core: Find operation completed, returning " + std::to_string(results.size()) +
+                    " documents.");
+    return results;
+}
+
+/**
+ * @brief Prepares a query template to be run repeatedly with different parameters.
+ * @param coll The name of the collection.
+ * @param query_json The query template.
+ * @param sort_json The sort order.
+ * @param projection_json The field projection.
+ * @param owner The API key of the client.
+ * @param prepared_id Receives the id of the prepared query.
+ * @return `OK`, `InvalidArgument`, or `NotSupported`.
+ */
+aevum::util::Status Core::prepare(std::string_view coll, std::string_view query_json,
+                                  std::string_view sort_json, std::string_view projection_json,
+                                  std::string_view owner, int64_t &prepared_id) {
+    if (time_series_.options(coll)) return time_series_refusal(coll, "prepared queries");
+    auto prepared = std::make_shared<query::PreparedQuery>();
+    aevum::util::Status status =
+        query::prepare_query(coll, owner, query_json, sort_json, projection_json, *prepared);
+    if (!status.ok()) return status;
+    prepared_id = prepared_.add(std::move(prepared));
+    if (prepared_id == 0) {
+        return aevum::util::Status::NotSupported(
+            "Too many prepared queries; close some before preparing more");
+    }
+    AEVUM_LOG_DEBUG("Core: Prepared query " + std::to_string(prepared_id) + " on collection '" +
+                    std::string(coll) + "'.");
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Looks up a query prepared by `prepare`.
+ * @param prepared_id The id of the prepared query.
+ * @param owner The API key of the client.
+ * @return The prepared query, or null.
+ */
+std::shared_ptr<const query::PreparedQuery> Core::prepared_query(int64_t prepared_id,
+                                                                 std::string_view owner) const {
+    return prepared_.get(prepared_id, owner);
+}
+
+/**
+ * @brief Runs a prepared query with a set of parameters.
+ * @details The bound query is serialized to JSON only for what still takes JSON: the slow
+ * operation log, the Rust engine if the native matcher cannot evaluate the query, and scans of
+ * unloaded collections. A compiled template whose parameters it cannot bind, such as a
+ * comparison with a boolean, is compiled again from the bound query, which keeps the exact
+ * semantics of `find`.
+ * @param prepared The prepared query.
+ * @param params The values of the parameters.
+ * @param limit The maximum number of documents to return.
+ * @param skip The number of initial documents to skip.
+ * @param results Receives the matching documents.
+ * @return `OK` or `InvalidArgument`.
+ */
+aevum::util::Status Core::find(const query::PreparedQuery &prepared,
+                               const aevum::bson::doc::Document &params, int64_t limit,
+                               int64_t skip, std::vector<aevum::bson::doc::Document> &results) {
+    aevum::bson::doc::Document query_doc;
+    aevum::util::Status status = query::bind_query(prepared, params, query_doc);
+    if (!status.ok()) return status;
+    std::string query_json = aevum::bson::json::to_string(query_doc);
+
+    std::string_view coll = prepared.collection;
+    query::ProfileScope profile(slow_ops_, "find", coll, query_json, prepared.sort_json);
+    std::shared_lock<std::shared_mutex> lock = read_lock(coll);
+    auto plan_bound = [&] {
+        query::PhaseTimer phase(query::ProfilePhase::PLAN);
+        std::optional<aevum::bson::doc::Matcher> matcher;
+        if (prepared.matcher) matcher = prepared.matcher->bind(params);
+        if (!matcher) matcher = aevum::bson::doc::Matcher::compile(query_json);
+        return make_plan(coll, query_doc, prepared.sort, std::move(matcher));
+    };
+    results = find_planned(coll, plan_bound, query_json, prepared.sort_json, prepared.projection,
+                           limit, skip, lock);
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Discards a prepared query.
+ * @param prepared_id The id of the prepared query.
+ * @param owner The API key of the client.
+ * @return `true` if the prepared query was discarded.
+ */
+bool Core::close_prepared(int64_t prepared_id, std::string_view owner) {
+    return prepared_.remove(prepared_id, owner);
+}
+
+/**
+ * @brief Runs a query and returns its first batch, keeping a cursor for the rest.
+ * @details A covered plan and an unsorted query keep the `_id`s of their candidates, to be
+ * matched batch by batch in `fill_cursor_batch`; skip and limit are then applied to the matches
+ * as they are found. A sorted query keeps the `_id`s of its results, to which
+ * `find_matching_refs` has already applied skip and limit. An unloaded collection is loaded
+ * first, since a cursor resolves its `_id`s through the primary index. The points of a
+ * time-series collection have no `_id`s to resolve, so all of its results are returned in the
+ * first batch, and no cursor is kept.
+ *
+ * @param coll The name of the collection.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param projection_json The field projection.
+ * @param limit The maximum number of documents over all batches.
+ * @param skip The number of matches to skip.
+ * @param batch_size The maximum number of documents in the first batch.
+ * @param owner The API key of the client.
+ * @param cursor_id Receives the id of the cursor, or 0.
+ * @param batch Receives the first batch.
+ */
+void Core::open_cursor(std::string_view coll, std::string_view query_json,
+                       std::string_view sort_json, std::string_view projection_json,
+                       int64_t limit, int64_t skip, size_t batch_size, std::string_view owner,
+                       int64_t &cursor_id, std::vector<aevum::bson::doc::Document> &batch) {
+    (void)cursors_.expire_idle();
+    if (time_series_.options(coll)) {
+        aevum::bson::doc::Document projection;
+        if (!aevum::bson::json::parse(projection_json, projection).ok()) {
+            projection = aevum::bson::doc::Document();
+        }
+        std::shared_lock<std::shared_mutex> lock(collection_lock(coll));
+        batch = find_time_series(coll, query_json, sort_json, projection, limit, skip);
+        cursor_id = 0;
+        return;
+    }
+    auto cursor = std::make_unique<query::Cursor>();
+    cursor->collection = std::string(coll);
+    cursor->owner = std::string(owner);
+    cursor->query_json = std::string(query_json);
+    if (!aevum::bson::json::parse(projection_json, cursor->projection).ok()) {
+        cursor->projection = aevum::bson::doc::Document();
+    }
+
+    std::shared_lock<std::shared_mutex> lock = lock_resident(coll);
+    query::QueryPlan plan = make_plan(coll, query_json, sort_json);
+    if (plan.type == query::PlanType::TEXT_SEARCH) cursor->query_json = plan.text_query;
+    std::vector<const aevum::bson::doc::Document *> refs;
+    if (!plan.covered && (!plan.sort_field.empty() || !is_empty_sort(sort_json))) {
+        refs = find_matching_refs(coll, plan, query_json, sort_json, limit, skip);
+        cursor->matched = true;
+    } else {
+        refs = collect_candidates(coll, plan);
+        cursor->matched = plan.covered;
+        if (plan.covered && skip > 0) refs.clear();
+        if (!plan.covered && skip > 0) cursor->skip = static_cast<size_t>(skip);
+        if (limit > 0) cursor->remaining = static_cast<size_t>(limit);
+    }
+    cursor->ids.reserve(refs.size());
+    for (const auto *ref : refs) cursor->ids.push_back(extract_id(*ref));
+    refs = {};
+
+    fill_cursor_batch(*cursor, batch_size, batch);
+    lock.unlock();
+
+    cursor_id = cursor->exhausted() ? 0 : cursors_.add(std::move(cursor));
+    AEVUM_LOG_DEBUG("Core: Opened cursor " + std::to_string(cursor_id) + " on collection '" +
+                    std::string(coll) + "', returning " + std::to_string(batch.size()) +
+                    " documents.");
+}
+
+/**
+ * @brief Returns the next batch of a cursor.
+ * @details The cursor is checked out of `cursors_` while the batch is produced, so it is never
+ * advanced by two requests at once, and put back afterwards unless it is exhausted.
+ * @param cursor_id The id of the cursor; set to 0 if the batch is the last.
+ * @param owner The API key of the client.
+ * @param batch_size The maximum number of documents in the batch.
+ * @param batch Receives the batch.
+ * @return `OK`, or `NotFound` if the cursor does not exist.
+ */
+aevum::util::Status Core::get_more(int64_t &cursor_id, std::string_view owner,
+                                   size_t batch_size,
+                                   std::vector<aevum::bson::doc::Document> &batch) {
+    (void)cursors_.expire_idle();
+    batch.clear();
+    std::unique_ptr<query::Cursor> cursor = cursors_.checkout(cursor_id, owner);
+    if (!cursor) {
+        return aevum::util::Status::NotFound("Cursor " + std::to_string(cursor_id) +
+                                             " not found");
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock = lock_resident(cursor->collection);
+        fill_cursor_batch(*cursor, batch_size, batch);
+    }
+    cursor_id = cursors_.checkin(cursor_id, std::move(cursor));
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Discards a cursor before it is exhausted.
+ * @param cursor_id The id of the cursor.
+ * @param owner The API key of the client.
+ * @return `true` if the cursor was discarded.
+ */
+bool Core::kill_cursor(int64_t cursor_id, std::string_view owner) {
+    return cursors_.kill(cursor_id, owner);
+}
+
+/**
+ * @brief Advances a cursor by up to one batch.
+ * @details Each step resolves a chunk of `_id`s through the primary index; `_id`s whose document
+ * has since been removed are dropped. The documents of a `matched` cursor are returned as they
+ * are. Otherwise the chunk, at least `MIN_SCAN_CHUNK` candidates so that selective filters do not
+ * cost one FFI call per document, is matched by the query's native `Matcher` or, if it has none,
+ * lent to `rust_find_bson`. Since an unsorted match preserves
+ * the order of its input, the cursor's position can be set just past the last match taken when
+ * the batch fills up, and the matches after it are found again by the next batch.
+ *
+ * @param cursor The cursor.
+ * @param batch_size The maximum number of documents to return, or 0 for the default.
+ * @param batch Receives the documents.
+ */
+void Core::fill_cursor_batch(query::Cursor &cursor, size_t batch_size,
+                             std::vector<aevum::bson::doc::Document> &batch) const {
+    batch.clear();
+    if (batch_size == 0) batch_size = query::DEFAULT_CURSOR_BATCH_SIZE;
+
+    const auto matcher =
+        cursor.matched ? std::nullopt : aevum::bson::doc::Matcher::compile(cursor.query_json);
+    std::vector<const aevum::bson::doc::Document *> chunk;
+    std::vector<size_t> chunk_positions;
+    while (batch.size() < batch_size && !cursor.exhausted()) {
+        size_t wanted = std::min(batch_size - batch.size(), cursor.remaining);
+        size_t span = cursor.matched ? wanted : std::max(wanted, MIN_SCAN_CHUNK);
+        size_t end = std::min(cursor.ids.size(), cursor.position + span);
+
+        chunk.clear();
+        chunk_positions.clear();
+        for (; cursor.position < end; ++cursor.position) {
+            const auto *doc = index_manager_.get_document_ref_by_id(cursor.collection,
+                                                                    cursor.ids[cursor.position]);
+            if (!doc) continue;
+            chunk.push_back(doc);
+            chunk_positions.push_back(cursor.position);
+        }
+
+        auto take = [&](const aevum::bson::doc::Document *doc) {
+            batch.push_back(query::apply_projection(*doc, cursor.projection));
+            if (cursor.remaining != SIZE_MAX) --cursor.remaining;
+        };
+        if (cursor.matched) {
+            for (const auto *doc : chunk) take(doc);
+            continue;
+        }
+        if (chunk.empty()) continue;
+
+        std::vector<size_t> hits;
+        if (matcher) {
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                if (matcher->matches(*chunk[i])) hits.push_back(i);
+            }
+        } else {
+            aevum::util::memory::ScratchScope scratch;
+            BorrowedBatch lent = make_borrowed_batch(chunk);
+            rust_index_result res = timed_ffi_call(counters_, [&] {
+                return rust_find_bson(lent.data.data(), lent.lengths.data(), lent.docs.size(),
+                                      cursor.query_json.c_str(), "{}", 0, 0);
+            });
+            for (size_t i = 0; i < res.len; ++i) {
+                if (res.indices[i] < lent.docs.size()) hits.push_back(res.indices[i]);
+            }
+            rust_free_index_result(res);
+        }
+        for (size_t hit : hits) {
+            if (cursor.skip > 0) {
+                --cursor.skip;
+                continue;
+            }
+            if (batch.size() >= batch_size || cursor.remaining == 0) {
+                // Resume at this match; it belongs to the next batch.
+                cursor.position = chunk_positions[hit];
+                break;
+            }
+            take(chunk[hit]);
+        }
+    }
+    if (cursor.remaining == 0) cursor.position = cursor.ids.size();
+}
+
+/**
+ * @brief Returns the write generation of a collection.
+ * @param coll The name of the collection.
+ * @return The generation of the collection's slot.
+ */
+uint64_t Core::write_generation(std::string_view coll) const noexcept {
+    return write_generations_[aevum::util::hash::wyhash(coll) % WRITE_GENERATION_SLOTS].load(
+        std::memory_order_acquire);
+}
+
+/**
+ * @brief Advances the write generation of a collection.
+ * @param coll The name of the collection.
+ */
+void Core::bump_write_generation(std::string_view coll) noexcept {
+    write_generations_[aevum::util::hash::wyhash(coll) % WRITE_GENERATION_SLOTS].fetch_add(
+        1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Returns the generator of the missing `_id`s of a collection.
+ * @param coll The name of the collection.
+ * @return The collection's override from `CoreOptions::collection_id_formats`, or
+ *         `CoreOptions::id_format`.
+ */
+aevum::util::uuid::IdFormat Core::id_format(std::string_view coll) const {
+    if (collection_id_formats_.empty()) return id_format_;
+    auto it = collection_id_formats_.find(std::string(coll));
+    return it == collection_id_formats_.end() ? id_format_ : it->second;
+}
+
+/**
+ * @brief Runs an aggregation pipeline, pushing its leading `$match` down to the query planner.
+ * @details The leading `$match` is planned exactly as a `find` query and its candidates are
+ * filtered by `select_matches`, so the executor only ever sees the matches; a pipeline without one
+ * sees every document. The matches' buffers stay borrowed from the primary index for the duration
+ * of the `rust_aggregate_bson` call, under the collection's shared lock. An unloaded collection
+ * is loaded first, since the pipeline has no plan that storage could serve on its own. A
+ * time-series collection is aggregated by `aggregate_time_series`.
+ * @param coll The name of the collection.
+ * @param pipeline_json A JSON array of pipeline stages.
+ * @param results Receives the JSON array of results.
+ * @return `InvalidArgument` if the pipeline is rejected, with the executor's explanation.
+ */
+aevum::util::Status Core::aggregate(std::string_view coll, std::string_view pipeline_json,
+                                    std::string &results) {
+    query::SplitPipeline pipeline;
+    if (auto status = query::split_pipeline(pipeline_json, pipeline); !status.ok()) {
+        return status;
+    }
+
+    if (time_series_.options(coll)) {
+        std::shared_lock<std::shared_mutex> lock(collection_lock(coll));
+        return aggregate_time_series(coll, pipeline, results);
+    }
+
+    std::shared_lock<std::shared_mutex> lock = lock_resident(coll);
+    query::QueryPlan plan = make_plan(coll, pipeline.match_json, "{}");
+    std::vector<const aevum::bson::doc::Document *> matches = collect_candidates(coll, plan);
+    if (!plan.covered) {
+        matches = select_matches(counters_, scan_pool_.get(), std::move(matches), plan,
+                                 pipeline.match_json, "{}", 0, 0);
+    }
+    AEVUM_LOG_DEBUG("Core: Aggregating " + std::to_string(matches.size()) +
+                    " documents of collection '" + std::string(coll) + "'.");
+    return run_pipeline(counters_, std::move(matches), pipeline.rest_json, results);
+}
+
+/**
+ * @brief Reports the access path the query planner chooses for a query.
+ * @details The query is planned and its candidate set gathered exactly as `find` would, but the
+ * matcher is not run. `candidates` is therefore the number of documents the matcher would have
+ * to examine, which can be compared with `total_documents` to judge the plan's selectivity.
+ * `sort_from_index` reports whether the sort is supplied by an ordered index, in which case a
+ * limited query may stop well before all candidates are examined. `statistics` shows what the
+ * cost model chose from: the collection's size, the plan's estimated cost, and for each predicate
+ * on an indexed field the estimated number of entries, whether the plan uses it, and the size of
+ * its index. A time-series collection is described by `explain_time_series` instead.
+ *
+ * @param coll The name of the collection.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @return A BSON document describing the plan.
+ */
+aevum::bson::doc::Document Core::explain(std::string_view coll, std::string_view query_json,
+                                         std::string_view sort_json) {
+    if (time_series_.options(coll)) {
+        std::shared_lock<std::shared_mutex> lock(collection_lock(coll));
+        return explain_time_series(coll, query_json);
+    }
+    std::shared_lock<std::shared_mutex> lock = lock_resident(coll);
+    query::QueryPlan plan = make_plan(coll, query_json, sort_json);
+    size_t candidates = collect_candidates(coll, plan).size();
+    size_t total = plan.type == query::PlanType::FULL_SCAN ||
+                           plan.type == query::PlanType::INDEX_SCAN
+                       ? candidates
+                       : index_manager_.document_count(coll);
+
+    std::string coll_str(coll);
+    std::string plan_str(query::to_string(plan.type));
+
+    bson_t *b = bson_new();
+    BSON_APPEND_UTF8(b, "collection", coll_str.c_str());
+    BSON_APPEND_UTF8(b, "plan", plan_str.c_str());
+
+    bson_t fields;
+    BSON_APPEND_ARRAY_BEGIN(b, "index_fields", &fields);
+    if (plan.type == query::PlanType::PRIMARY_LOOKUP) {
+        BSON_APPEND_UTF8(&fields, "0", "_id");
+    }
+    for (size_t i = 0; i < plan.predicates.size(); ++i) {
+        std::string key = std::to_string(i);
+        BSON_APPEND_UTF8(&fields, key.c_str(), plan.predicates[i].field.c_str());
+    }
+    std::vector<std::string_view> column_fields;
+    for (const auto &predicate : plan.column_predicates) {
+        if (std::find(column_fields.begin(), column_fields.end(), predicate.field) !=
+            column_fields.end()) {
+            continue;
+        }
+        std::string key = std::to_string(column_fields.size());
+        BSON_APPEND_UTF8(&fields, key.c_str(), predicate.field.c_str());
+        column_fields.push_back(predicate.field);
+    }
+    if (plan.type == query::PlanType::INDEX_SCAN) {
+        BSON_APPEND_UTF8(&fields, "0", plan.sort_field.c_str());
+    }
+    bson_append_array_end(b, &fields);
+    if (plan.type == query::PlanType::TEXT_SEARCH) {
+        BSON_APPEND_UTF8(b, "text_search", plan.text_search.c_str());
+    }
+
+    BSON_APPEND_BOOL(b, "covered", plan.covered);
+    BSON_APPEND_BOOL(b, "sort_from_index", !plan.sort_field.empty());
+    BSON_APPEND_INT64(b, "candidates", static_cast<int64_t>(candidates));
+    BSON_APPEND_INT64(b, "total_documents", static_cast<int64_t>(total));
+
+    index::CollectionStatistics collection = index_manager_.collection_statistics(coll);
+    bson_t statistics;
+    BSON_APPEND_DOCUMENT_BEGIN(b, "statistics", &statistics);
+    BSON_APPEND_INT64(&statistics, "documents", static_cast<int64_t>(collection.documents));
+    BSON_APPEND_DOUBLE(&statistics, "average_document_size", collection.average_size());
+    BSON_APPEND_DOUBLE(&statistics, "estimated_cost", plan.cost);
+    bson_t estimates;
+    BSON_APPEND_ARRAY_BEGIN(&statistics, "predicates", &estimates);
+    size_t estimate_count = 0;
+    auto append_estimate = [&](const query::IndexPredicate &predicate, bool used) {
+        index::IndexStatistics index_stats =
+            index_manager_.index_statistics(coll, predicate.field);
+        std::string key = std::to_string(estimate_count++);
+        bson_t estimate;
+        BSON_APPEND_DOCUMENT_BEGIN(&estimates, key.c_str(), &estimate);
+        BSON_APPEND_UTF8(&estimate, "field", predicate.field.c_str());
+        BSON_APPEND_BOOL(&estimate, "used", used);
+        BSON_APPEND_DOUBLE(&estimate, "estimated_entries", predicate.estimate);
+        BSON_APPEND_INT64(&estimate, "index_entries", static_cast<int64_t>(index_stats.entries));
+        BSON_APPEND_DOUBLE(&estimate, "distinct_keys", index_stats.distinct);
+        bson_append_document_end(&estimates, &estimate);
+    };
+    for (const auto &predicate : plan.predicates) append_estimate(predicate, true);
+    for (const auto &predicate : plan.dropped) append_estimate(predicate, false);
+    bson_append_array_end(&statistics, &estimates);
+    bson_append_document_end(b, &statistics);
+    return aevum::bson::doc::Document(b);
+}
+
+/**
+ * @brief Inserts points into a time-series collection; the time-series counterpart of
+ * `insert_many`.
+ * @details The points are validated against the collection's schema and handed to the
+ * `TimeSeriesStore` under the collection's exclusive lock, which appends them to their buckets
+ * and writes the buckets in one transaction. The journal is flushed once the lock is released.
+ * Points are not recorded in the change log.
+ * @param coll The name of a time-series collection.
+ * @param docs The points.
+ * @param durability How far the points are persisted before returning.
+ * @return One pair per point, in input order, holding its status and the key of its bucket.
+ */
+std::vector<std::pair<aevum::util::Status, std::string>> Core::insert_points(
+    std::string_view coll, std::vector<aevum::bson::doc::Document> docs,
+    storage::Durability durability) {
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    bump_write_generation(coll);
+    std::vector<aevum::util::Status> validation = schema_manager_.validate_many(coll, docs);
+    std::vector<std::pair<aevum::util::Status, std::string>> results(docs.size());
+    std::vector<aevum::bson::doc::Document> accepted;
+    std::vector<size_t> positions;
+    accepted.reserve(docs.size());
+    positions.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (!validation[i].ok()) {
+            results[i] = {validation[i], ""};
+            continue;
+        }
+        accepted.push_back(std::move(docs[i]));
+        positions.push_back(i);
+    }
+
+    std::vector<std::pair<aevum::util::Status, std::string>> stored =
+        time_series_.insert(coll, accepted);
+    size_t inserted = 0;
+    for (size_t k = 0; k < stored.size(); ++k) {
+        if (stored[k].first.ok()) ++inserted;
+        results[positions[k]] = std::move(stored[k]);
+    }
+    AEVUM_LOG_DEBUG("Core: Inserted " + std::to_string(inserted) + " of " +
+                    std::to_string(docs.size()) + " points into time-series collection '" +
+                    std::string(coll) + "'.");
+
+    lock.unlock();
+    if (inserted == 0) return results;
+    if (auto status = storage_.make_durable(durability); !status.ok()) {
+        for (auto &result : results) {
+            if (result.first.ok()) result.first = status;
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Plans a query on a time-series collection.
+ * @param coll The name of a time-series collection.
+ * @param query_json A JSON string for the filter conditions.
+ * @param plan Receives the plan.
+ * @param filter Receives the bucket filter of the query.
+ * @return `OK`, or `InvalidArgument` if the query is not a JSON object.
+ */
+aevum::util::Status Core::plan_time_series(std::string_view coll, std::string_view query_json,
+                                           query::QueryPlan &plan,
+                                           timeseries::BucketFilter &filter) {
+    query::PhaseTimer phase(query::ProfilePhase::PLAN);
+    aevum::bson::doc::Document query_doc;
+    if (!aevum::bson::json::parse(query_json, query_doc).ok()) {
+        return aevum::util::Status::InvalidArgument("The query is not a valid JSON object");
+    }
+    filter = timeseries::extract_filter(query_doc, *time_series_.options(coll));
+    plan = query::QueryPlan{};
+    plan.type = query::PlanType::BUCKET_SCAN;
+    plan.matcher = aevum::bson::doc::Matcher::compile(query_json);
+    counters_.plans[static_cast<size_t>(plan.type)].fetch_add(1, std::memory_order_relaxed);
+    query::ProfileScope::note_plan(plan.type);
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Builds the points of a time-series collection that pass a bucket filter.
+ * @param coll The name of a time-series collection.
+ * @param filter The bucket filter of the query.
+ * @param points Receives the points, in key order of their buckets.
+ * @param stats Receives what the scan read, if not null.
+ * @return `OK`, or the status of the failed scan.
+ */
+aevum::util::Status Core::read_points(std::string_view coll,
+                                      const timeseries::BucketFilter &filter,
+                                      std::vector<aevum::bson::doc::Document> &points,
+                                      timeseries::BucketScanStats *stats) {
+    query::PhaseTimer phase(query::ProfilePhase::FETCH);
+    const timeseries::TimeSeriesOptions &options = *time_series_.options(coll);
+    return time_series_.scan(
+        coll, filter,
+        [&](const timeseries::DecodedBucket &bucket) {
+            timeseries::materialize(bucket, options, filter, points);
+            return true;
+        },
+        stats);
+}
+
+/**
+ * @brief Finds the points of a time-series collection matching a query.
+ * @details The points of the buckets the query's bucket filter selects are built into documents
+ * and handed to `select_matches` as the candidates, so filtering, sorting, and pagination work
+ * as on any other collection. The caller holds the collection's lock shared.
+ * @param coll The name of a time-series collection.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param projection The parsed projection.
+ * @param limit The maximum number of points to return (0 for no limit).
+ * @param skip The number of initial matches to skip.
+ * @return The matching points, projected.
+ */
+std::vector<aevum::bson::doc::Document> Core::find_time_series(
+    std::string_view coll, std::string_view query_json, std::string_view sort_json,
+    const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip) {
+    query::QueryPlan plan;
+    timeseries::BucketFilter filter;
+    std::vector<aevum::bson::doc::Document> points;
+    aevum::util::Status status = plan_time_series(coll, query_json, plan, filter);
+    if (status.ok()) status = read_points(coll, filter, points);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("Core: Find on time-series collection '" + std::string(coll) +
+                        "' failed. Status: " + status.to_string());
+        return {};
+    }
+
+    std::vector<const aevum::bson::doc::Document *> candidates;
+    candidates.reserve(points.size());
+    for (const auto &point : points) candidates.push_back(&point);
+    std::vector<const aevum::bson::doc::Document *> matches =
+        select_matches(counters_, scan_pool_.get(), std::move(candidates), plan,
+                       std::string(query_json), std::string(sort_json), limit, skip);
+
+    query::PhaseTimer phase(query::ProfilePhase::PARSE);
+    std::vector<aevum::bson::doc::Document> results;
+    results.reserve(matches.size());
+    for (const auto *match : matches) {
+        results.push_back(query::apply_projection(*match, projection));
+    }
+    query::ProfileScope::note_returned(results.size());
+    return results;
+}
+
+/**
+ * @brief Counts the points of a time-series collection matching a query.
+ * @details A query that only selects a time range and a series is answered from the decoded
+ * timestamps alone; any other is matched on the points of the selected buckets. The caller holds
+ * the collection's lock shared.
+ * @param coll The name of a time-series collection.
+ * @param query_json The filter conditions.
+ * @return The number of matching points.
+ */
+int Core::count_time_series(std::string_view coll, std::string_view query_json) {
+    query::QueryPlan plan;
+    timeseries::BucketFilter filter;
+    aevum::util::Status status = plan_time_series(coll, query_json, plan, filter);
+    if (status.ok() && filter.exact) {
+        size_t matched = 0;
+        status = time_series_.scan(coll, filter, [&](const timeseries::DecodedBucket &bucket) {
+            matched += static_cast<size_t>(std::count_if(
+                bucket.times.begin(), bucket.times.end(),
+                [&](int64_t time) { return filter.admits(time); }));
+            return true;
+        });
+        if (status.ok()) return static_cast<int>(matched);
+    }
+    std::vector<aevum::bson::doc::Document> points;
+    if (status.ok()) status = read_points(coll, filter, points);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("Core: Count on time-series collection '" + std::string(coll) +
+                        "' failed. Status: " + status.to_string());
+        return 0;
+    }
+    std::vector<const aevum::bson::doc::Document *> candidates;
+    candidates.reserve(points.size());
+    for (const auto &point : points) candidates.push_back(&point);
+    return count_matches(counters_, scan_pool_.get(), std::move(candidates), plan,
+                         std::string(query_json));
+}
+
+/**
+ * @brief Runs an aggregation pipeline on a time-series collection.
+ * @details If the leading `$match` only selects a time range and a series, and the next stage is
+ * a `$group` that `timeseries::BucketGroup` supports, the group is folded directly from the
+ * decoded columns of the selected buckets, and only the groups are lent to the executor for the
+ * remaining stages. Otherwise the points of the selected buckets are built into documents,
+ * filtered by the `$match`, and lent to the executor with every remaining stage. A `$timeWindow`
+ * key, which the executor does not know, is only accepted in the first case. The caller holds the
+ * collection's lock shared.
+ * @param coll The name of a time-series collection.
+ * @param pipeline The pipeline, split at its leading `$match`.
+ * @param results Receives the results, as a JSON array.
+ * @return `OK` or `InvalidArgument`.
+ */
+aevum::util::Status Core::aggregate_time_series(std::string_view coll,
+                                                const query::SplitPipeline &pipeline,
+                                                std::string &results) {
+    query::QueryPlan plan;
+    timeseries::BucketFilter filter;
+    if (auto status = plan_time_series(coll, pipeline.match_json, plan, filter); !status.ok()) {
+        return status;
+    }
+
+    std::string rest_json = pipeline.rest_json;
+    std::optional<timeseries::BucketGroup> group;
+    if (filter.exact) {
+        group = timeseries::BucketGroup::compile(pipeline.rest_json, *time_series_.options(coll),
+                                                 rest_json);
+    }
+    std::vector<aevum::bson::doc::Document> inputs;
+    std::vector<const aevum::bson::doc::Document *> refs;
+    if (group) {
+        query::PhaseTimer phase(query::ProfilePhase::FETCH);
+        auto status = time_series_.scan(coll, filter, [&](const timeseries::DecodedBucket &bucket) {
+            group->add(bucket, filter);
+            return true;
+        });
+        if (!status.ok()) return status;
+        inputs = group->results();
+        for (const auto &input : inputs) refs.push_back(&input);
+    } else {
+        if (pipeline.rest_json.find(timeseries::TIME_WINDOW_OPERATOR) != std::string::npos) {
+            return aevum::util::Status::InvalidArgument(
+                "$timeWindow is only supported in a supported $group stage directly after a "
+                "$match on the time and meta fields alone");
+        }
+        if (auto status = read_points(coll, filter, inputs); !status.ok()) return status;
+        for (const auto &input : inputs) refs.push_back(&input);
+        refs = select_matches(counters_, scan_pool_.get(), std::move(refs), plan,
+                              pipeline.match_json, "{}", 0, 0);
+    }
+    AEVUM_LOG_DEBUG("Core: Aggregating " + std::to_string(refs.size()) +
+                    (group ? " groups" : " points") + " of time-series collection '" +
+                    std::string(coll) + "'.");
+    return run_pipeline(counters_, std::move(refs), rest_json, results);
+}
+
+/**
+ * @brief Describes the bucket scan of a query on a time-series collection.
+ * @details The points of the selected buckets are built as `find` would build them, and
+ * `candidates` is their number. `total_documents` is the number of points in the decoded buckets,
+ * and `buckets` reports how many records the time range selected, how many of those were decoded,
+ * and whether the bucket filter alone answers the query. The caller holds the collection's lock
+ * shared.
+ * @param coll The name of a time-series collection.
+ * @param query_json The filter conditions.
+ * @return A BSON document describing the plan.
+ */
+aevum::bson::doc::Document Core::explain_time_series(std::string_view coll,
+                                                     std::string_view query_json) {
+    query::QueryPlan plan;
+    timeseries::BucketFilter filter;
+    timeseries::BucketScanStats stats;
+    std::vector<aevum::bson::doc::Document> points;
+    aevum::util::Status status = plan_time_series(coll, query_json, plan, filter);
+    if (status.ok()) status = read_points(coll, filter, points, &stats);
+
+    std::string coll_str(coll);
+    std::string plan_str(query::to_string(plan.type));
+    bson_t *b = bson_new();
+    BSON_APPEND_UTF8(b, "collection", coll_str.c_str());
+    BSON_APPEND_UTF8(b, "plan", plan_str.c_str());
+    bson_t fields;
+    BSON_APPEND_ARRAY_BEGIN(b, "index_fields", &fields);
+    bson_append_array_end(b, &fields);
+    BSON_APPEND_BOOL(b, "covered", false);
+    BSON_APPEND_BOOL(b, "sort_from_index", false);
+    BSON_APPEND_INT64(b, "candidates", static_cast<int64_t>(points.size()));
+    BSON_APPEND_INT64(b, "total_documents", static_cast<int64_t>(stats.points));
+
+    bson_t buckets;
+    BSON_APPEND_DOCUMENT_BEGIN(b, "buckets", &buckets);
+    BSON_APPEND_INT64(&buckets, "read", static_cast<int64_t>(stats.buckets));
+    BSON_APPEND_INT64(&buckets, "decoded", static_cast<int64_t>(stats.decoded));
+    BSON_APPEND_INT64(&buckets, "min_time", filter.min_time);
+    BSON_APPEND_INT64(&buckets, "max_time", filter.max_time);
+    if (filter.has_meta) BSON_APPEND_UTF8(&buckets, "series", filter.meta.c_str());
+    BSON_APPEND_BOOL(&buckets, "exact", filter.exact);
+    bson_append_document_end(b, &buckets);
+    if (!status.ok()) BSON_APPEND_UTF8(b, "error", status.to_string().c_str());
+    return aevum::bson::doc::Document(b);
+}
+
+/**
+ * @brief Updates documents matching a query, persisting and re-indexing only the modified ones.
+ * @details This is a write-locked operation. The matching documents are first selected through
+ * the zero-copy find FFI, and only that subset is serialized and sent with the update query to
+ * `rust_update_delta`, which reports the position of every document it modified together with
+ * its post-update image. The before image is the borrowed matching document at that position.
+ * All images are parsed before anything is written; they are then stored together with a single
+ * `storage_.apply_batch`, so the update is persisted atomically, and each one is swapped into the
+ * indexes with `add_document_to_indexes`, which retracts the before image from the secondary
+ * indexes. The cost is therefore proportional to the number of modified documents rather than to
+ * the size of the collection.
+ *
+ * An update that would change a document's `_id` is not applied to that document, since the
+ * document is addressed by its original `_id` in both storage and the indexes.
+ *
+ * The journal is flushed to the requested durability level after the lock has been released.
+ *
+ * @return A pair containing the status and the number of documents modified; `NotFound` if the
+ * query matched nothing or every matched document failed validation.
+ */
+std::pair<aevum::util::Status, int> Core::update(std::string_view coll, std::string_view query_json,
+                                                 std::string_view update_json,
+                                                 storage::Durability durability) {
+    query::ProfileScope profile(slow_ops_, "update", coll, query_json);
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "updates"), 0};
+    if (!collection_exists(coll)) {
+        return {aevum::util::Status::NotFound("No documents were modified."), 0};
+    }
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    load_resident_locked(coll);
+    bump_write_generation(coll);
+    AEVUM_LOG_DEBUG("Core: Beginning update operation for collection '" + std::string(coll) +
+                    "'. Dispatching to FFI.");
+    std::vector<const aevum::bson::doc::Document *> matches =
+        find_matching_refs(coll, make_plan(coll, query_json, "{}"), query_json, "{}", 0, 0);
+    if (matches.empty()) {
+        AEVUM_LOG_WARN("Core: Update for collection '" + std::string(coll) +
+                       "' resulted in no matches or all validation failures.");
+        return {aevum::util::Status::NotFound("No documents were modified."), 0};
+    }
+
+    auto result = update_locked(coll, matches, query_json, update_json);
+    if (!result.first.ok()) return result;
+    if (result.second == 0) {
+        AEVUM_LOG_WARN("Core: Update for collection '" + std::string(coll) +
+                       "' resulted in no matches or all validation failures.");
+        return {aevum::util::Status::NotFound("No documents were modified."), 0};
+    }
+
+    lock.unlock();
+    return {storage_.make_durable(durability), result.second};
+}
+
+/**
+ * @brief Applies an update to matched documents under the collection's exclusive lock; the body
+ * of `update` once the matches are known.
+ * @details See `update`. The modified documents are persisted without waiting for the journal.
+ *
+ * A `$set`/`$inc` update of fixed-size fields is first tried as byte patches with
+ * `query::UpdatePatcher`, unless the collection has a schema to validate the images against or
+ * stores dictionary-encoded documents. Every document it applies to is written with
+ * `WT_CURSOR::modify` and patched in the primary index; its secondary index entries are
+ * rewritten only if the update touches an indexed field. The documents it does not apply to go
+ * through the Rust update engine, and both kinds commit in the same transaction.
+ * @param coll The name of the collection.
+ * @param matches The matching documents, borrowed from the primary index.
+ * @param query_json The filter conditions the documents matched.
+ * @param update_json The update to apply.
+ * @return The status and the number of documents modified.
+ */
+std::pair<aevum::util::Status, int> Core::update_locked(
+    std::string_view coll, const std::vector<const aevum::bson::doc::Document *> &matches,
+    std::string_view query_json, std::string_view update_json) {
+    std::optional<query::UpdatePatcher> patcher;
+    if (!storage_.uses_dictionary(coll) && !schema_manager_.get_schema(coll)) {
+        patcher = query::UpdatePatcher::compile(update_json);
+    }
+
+    // Patch what qualifies, and leave the rest to the update engine.
+    std::vector<storage::PatchWrite> patch_writes;
+    std::vector<aevum::bson::doc::Document> patched;
+    std::vector<storage::KeyWrite> entry_writes;
+    std::vector<const aevum::bson::doc::Document *> engine_matches;
+    size_t unchanged = 0;
+    bool reindex = false;
+    if (patcher) {
+        for (const std::string &path : index_manager_.indexed_paths(coll)) {
+            reindex = reindex || patcher->touches(path);
+        }
+        for (const auto *match : matches) {
+            storage::PatchWrite write;
+            aevum::bson::doc::Document after;
+            if (!patcher->apply(*match, after, write.patches)) {
+                engine_matches.push_back(match);
+                continue;
+            }
+            if (write.patches.empty()) {
+                ++unchanged;
+                continue;
+            }
+            if (reindex) {
+                auto writes = index_manager_.index_entry_writes(coll, match, &after);
+                std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+            }
+            write.id = extract_id(*match);
+            patch_writes.push_back(std::move(write));
+            patched.push_back(std::move(after));
+        }
+    }
+    const auto &engine_input = patcher ? engine_matches : matches;
+
+    std::vector<std::pair<size_t, aevum::bson::doc::Document>> images;
+    if (!engine_input.empty()) {
+        auto [images_status, engine_images] =
+            update_images(coll, engine_input, query_json, update_json);
+        if (!images_status.ok()) return {images_status, 0};
+        images = std::move(engine_images);
+    }
+    if (images.empty() && patch_writes.empty()) {
+        return {aevum::util::Status::OK(), static_cast<int>(unchanged)};
+    }
+
+    // Pair every post-update image with the `_id` of its before image, and collect the index
+    // entries the change retracts and adds.
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> delta;
+    delta.reserve(images.size());
+    for (auto &[position, after] : images) {
+        auto writes = index_manager_.index_entry_writes(coll, engine_input[position], &after);
+        std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+        delta.emplace_back(extract_id(*engine_input[position]), std::move(after));
+    }
+
+    AEVUM_LOG_DEBUG("Core: Writing " + std::to_string(delta.size()) + " modified and " +
+                    std::to_string(patch_writes.size()) +
+                    " patched documents to storage for collection '" + std::string(coll) + "'.");
+    query::PhaseTimer write_phase(query::ProfilePhase::WRITE);
+    ChangeLog::Reservation changes = change_log_.reserve(delta.size() + patch_writes.size());
+    for (const auto &change : delta) {
+        changes.append(entry_writes, ChangeType::UPDATE, coll, change.first);
+    }
+    for (const auto &write : patch_writes) {
+        changes.append(entry_writes, ChangeType::UPDATE, coll, write.id);
+    }
+    if (auto status = storage_.apply_batches(
+            {storage::CollectionBatch{coll, delta, {}, &patch_writes}}, entry_writes,
+            storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("Core: Storage write failed during update for collection '" +
+                        std::string(coll) + "'. No documents were modified. Status: " +
+                        status.to_string());
+        return {status, 0};
+    }
+    changes.commit();
+    for (const auto &[id_str, after] : delta) {
+        index_manager_.add_document_to_indexes(coll, after);
+    }
+    for (size_t i = 0; i < patch_writes.size(); ++i) {
+        index_manager_.patch_document(coll, patch_writes[i].id, patch_writes[i].patches,
+                                      patched[i], reindex);
+    }
+    size_t modified = delta.size() + patch_writes.size() + unchanged;
+    int affected_count = static_cast<int>(modified);
+    query::ProfileScope::note_returned(modified);
+
+    AEVUM_LOG_INFO("Core: Update operation completed for collection '" + std::string(coll) + "'. " +
+                   std::to_string(affected_count) + " documents modified.");
+    return {aevum::util::Status::OK(), affected_count};
+}
+
+/**
+ * @brief Computes the post-update images of matched documents with the Rust update engine.
+ * @details Only the matches are serialized for the engine, together with the collection's schema,
+ * which the engine validates the images against; it reports the positions of the documents it
+ * modified. An image whose `_id` differs from that of its document is dropped, since the
+ * document is addressed by its original `_id` in both storage and the indexes. The engine is
+ * given the query without its `$text` operator, if any.
+ * @param coll The name of the collection.
+ * @param matches The matching documents.
+ * @param query_json The filter conditions the documents matched.
+ * @param update_json The update to apply.
+ * @return The status and the position and new image of every modified document.
+ */
+std::pair<aevum::util::Status, std::vector<std::pair<size_t, aevum::bson::doc::Document>>>
+Core::update_images(std::string_view coll,
+                    const std::vector<const aevum::bson::doc::Document *> &matches,
+                    std::string_view query_json, std::string_view update_json) {
+    std::vector<std::pair<size_t, aevum::bson::doc::Document>> images;
+    // Only the matching subset is serialized for the Rust update engine.
+    std::string collection_json;
+    {
+        query::PhaseTimer phase(query::ProfilePhase::SERIALIZE);
+        collection_json = to_json_array(matches);
+    }
+
+    std::string q_str = strip_text_search(query_json);
+    std::string u_str(update_json);
+
+    // Retrieve the schema if one is set for this collection.
+    std::string schema_json = "";
+    auto schema_opt = schema_manager_.get_schema(coll);
+    if (schema_opt) {
+        schema_json = aevum::bson::json::to_string(*schema_opt);
+    }
+
+    rust_update_delta_result res = timed_ffi_call(counters_, [&] {
+        return rust_update_delta(collection_json.c_str(), q_str.c_str(), u_str.c_str(),
+                                 schema_json.c_str());
+    });
+    if (res.len == 0) {
+        rust_free_update_delta_result(res);
+        AEVUM_LOG_WARN("Core: Update for collection '" + std::string(coll) +
+                       "' matched documents, but none passed validation.");
+        return {aevum::util::Status::OK(), std::move(images)};
+    }
 
-    // If the authentication database is empty, bootstrap a default admin user.
-    if (auth_manager_.empty()) {
-        aevum::util::log::Logger::warn(
-            "Core: Security credentials not found. Bootstrapping default 'root' admin user.");
-        create_user("root", auth::UserRole::ADMIN);
+    query::PhaseTimer parse_phase(query::ProfilePhase::PARSE);
+    std::vector<uint32_t> positions(res.indices, res.indices + res.len);
+    aevum::bson::doc::Document images_doc;
+    auto parse_status = aevum::bson::json::parse(res.data ? res.data : "[]", images_doc);
+    // After parsing, we don't need the raw result from Rust anymore.
+    rust_free_update_delta_result(res);
+    if (!parse_status.ok()) {
+        AEVUM_LOG_ERROR("Core: Failed to parse updated documents JSON received from FFI. Status: " +
+                        parse_status.to_string());
+        return {parse_status, std::move(images)};
     }
 
-    aevum::util::log::Logger::info("Core: Database engine is online and ready for operations.");
+    images.reserve(positions.size());
+    bson_iter_t array_iter;
+    if (bson_iter_init(&array_iter, images_doc.get())) {
+        size_t i = 0;
+        while (bson_iter_next(&array_iter) && i < positions.size()) {
+            uint32_t position = positions[i++];
+            if (!BSON_ITER_HOLDS_DOCUMENT(&array_iter) || position >= matches.size()) continue;
+
+            const uint8_t *doc_data = nullptr;
+            uint32_t doc_len = 0;
+            bson_iter_document(&array_iter, &doc_len, &doc_data);
+            bson_t *b = bson_new_from_data(doc_data, doc_len);
+            if (!b) continue;
+
+            aevum::bson::doc::Document after(b);
+            std::string id_str = extract_id(*matches[position]);
+            if (id_str.empty() || extract_id(after) != id_str) {
+                AEVUM_LOG_WARN("Core: Skipping update of document '" + id_str +
+                               "' in collection '" + std::string(coll) +
+                               "' because it would change its _id.");
+                continue;
+            }
+            images.emplace_back(position, std::move(after));
+        }
+    }
+    return {aevum::util::Status::OK(), std::move(images)};
 }
 
 /**
- * @brief Destroys the `Core` engine, ensuring a graceful shutdown.
- */
-Core::~Core() { aevum::util::log::Logger::info("Core: Shutting down database engine."); }
-
-/**
- * @brief Loads all system and user data from the persistent `WiredTigerStore` into the
- * appropriate in-memory managers.
- * @details This function is a critical part of the startup process. It lists all collections
- * (tables) in the database and processes each one:
- * - `_indexes`: Loads secondary index definitions into the `IndexManager`.
- * - `_schemas`: Loads schema definitions into the `SchemaManager`.
- * - `_auth`: Loads user credentials into the `AuthManager`.
- * - All other collections are treated as user data collections, and `index_manager_.rebuild_index`
- *   is called to populate their primary and secondary indexes in memory.
+ * @brief Removes documents from a collection that match a given query.
+ * @details This write-locked operation first gathers the `_id`s of the documents to be deleted.
+ * When the plan alone answers the query, they are taken as they are: the `_id`s of a bare `_id`
+ * lookup, or the postings of an index-only predicate (see `QueryPlan::index_only`), neither of
+ * which touches a document. Otherwise a read-only, zero-copy `find` runs via the FFI and the `_id`
+ * of each returned document is read. All of them are then deleted from the `WiredTigerStore` in a
+ * single `apply_batch` transaction, and only once that has committed are they removed from every
+ * index by the `IndexManager` as one batch, which erases the `_id`s of each posting set together
+ * and the entries of an ordered range in one step. The journal is flushed to the requested
+ * durability level after the lock has been released.
+ *
+ * @return A pair containing the status and the number of documents successfully removed.
  */
-void Core::load_all() {
-    aevum::util::log::Logger::info("Core: Starting data loading sequence from persistence layer.");
-    auto collections = storage_.list_collections();
-    aevum::util::log::Logger::debug("Core: Discovered " + std::to_string(collections.size()) +
-                                    " collections in storage.");
-
-    for (const auto &name : collections) {
-        if (name == "_indexes") {
-            aevum::util::log::Logger::debug("Core: Loading system collection '_indexes'.");
-            auto index_status = index_manager_.load_all_index_definitions();
-            if (!index_status.ok()) {
-                aevum::util::log::Logger::warn("Core: Failed to load index definitions. Status: " +
-                                               index_status.to_string());
-            }
-            continue;
+std::pair<aevum::util::Status, int> Core::remove(std::string_view coll,
+                                                 std::string_view query_json,
+                                                 storage::Durability durability) {
+    query::ProfileScope profile(slow_ops_, "remove", coll, query_json);
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "removals"), 0};
+    if (!collection_exists(coll)) {
+        return {aevum::util::Status::NotFound("No documents matched the query."), 0};
+    }
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    load_resident_locked(coll);
+    bump_write_generation(coll);
+    AEVUM_LOG_DEBUG("Core: Beginning remove operation for collection '" + std::string(coll) + "'.");
+    query::QueryPlan plan = make_plan(coll, query_json, "{}");
+    std::vector<std::string> ids_to_remove;
+    if (plan.covered) {
+        for (const auto &id : plan.ids) {
+            if (index_manager_.get_document_ref_by_id(coll, id)) ids_to_remove.push_back(id);
         }
-
-        aevum::util::log::Logger::debug("Core: Loading data for collection '" + name + "'.");
-        std::vector<aevum::bson::doc::Document> docs = storage_.load_collection(name);
-        aevum::util::log::Logger::debug("Core: Loaded " + std::to_string(docs.size()) +
-                                        " documents from collection '" + name + "'.");
-
-        if (name == "_schemas") {
-            aevum::util::log::Logger::debug("Core: Processing system collection '_schemas'.");
-            for (const auto &doc : docs) {
-                bson_iter_t iter;
-                if (bson_iter_init_find(&iter, doc.get(), "collection") &&
-                    BSON_ITER_HOLDS_UTF8(&iter)) {
-                    std::string coll_name = bson_iter_utf8(&iter, nullptr);
-                    schema_manager_.add_schema_to_cache(coll_name, aevum::bson::doc::Document(doc));
-                }
+    } else if (plan.index_only) {
+        const query::IndexPredicate &predicate = plan.predicates.front();
+        ids_to_remove = index_manager_.get_ids_in_range(coll, predicate.field, predicate.range);
+    } else {
+        for (const auto *match : find_matching_refs(coll, plan, query_json, "{}", 0, 0)) {
+            std::string id_str = extract_id(*match);
+            if (!id_str.empty()) {
+                ids_to_remove.push_back(std::move(id_str));
             }
-            continue;
         }
+    }
 
-        if (name == "_auth") {
-            aevum::util::log::Logger::debug("Core: Processing system collection '_auth'.");
-            for (const auto &doc : docs) {
-                bson_iter_t iter;
-                std::string key_hash;
-                auth::UserRole role = auth::UserRole::READ_ONLY;
+    if (ids_to_remove.empty()) {
+        AEVUM_LOG_INFO("Core: Remove query for collection '" + std::string(coll) +
+                       "' matched 0 documents. No action taken.");
+        return {aevum::util::Status::NotFound("No documents matched the query."), 0};
+    }
+    AEVUM_LOG_DEBUG("Core: Identified " + std::to_string(ids_to_remove.size()) +
+                    " documents to remove from collection '" + std::string(coll) + "'.");
 
-                if (bson_iter_init_find(&iter, doc.get(), "key_hash") &&
-                    BSON_ITER_HOLDS_UTF8(&iter)) {
-                    key_hash = bson_iter_utf8(&iter, nullptr);
-                }
-                if (bson_iter_init_find(&iter, doc.get(), "role") && BSON_ITER_HOLDS_UTF8(&iter)) {
-                    std::string role_str = bson_iter_utf8(&iter, nullptr);
-                    if (role_str == "ADMIN")
-                        role = auth::UserRole::ADMIN;
-                    else if (role_str == "READ_WRITE")
-                        role = auth::UserRole::READ_WRITE;
-                }
+    query::PhaseTimer write_phase(query::ProfilePhase::WRITE);
+    auto [status, removed_count] = remove_ids_locked(coll, std::move(ids_to_remove));
+    if (!status.ok()) return {status, 0};
+    query::ProfileScope::note_returned(static_cast<size_t>(removed_count));
 
-                if (!key_hash.empty()) {
-                    auth_manager_.add_user(key_hash, role);
-                }
-            }
-            aevum::util::log::Logger::info(
-                "Core: Security policies and user roles loaded into cache.");
-            continue;
-        }
+    AEVUM_LOG_INFO("Core: Successfully removed " + std::to_string(removed_count) +
+                   " documents from collection '" + std::string(coll) + "'.");
 
-        // For all non-system collections, rebuild their indexes from the loaded documents.
-        aevum::util::log::Logger::info("Core: Rebuilding indexes for user collection '" + name +
-                                       "'.");
-        index_manager_.rebuild_index(name, docs);
-    }
-    aevum::util::log::Logger::info("Core: Data loading sequence complete.");
+    lock.unlock();
+    return {storage_.make_durable(durability), removed_count};
 }
 
 /**
- * @brief A helper function to fetch an entire collection from storage and serialize it to a JSON
- * array string.
- * @details This utility is primarily used to prepare data for the Rust FFI functions, which expect
- * datasets to be passed as a single JSON string. It loads all documents from the specified
- * collection and concatenates their JSON representations into a single string.
- * @param coll The name of the collection to fetch.
- * @return A `std::string` containing the JSON array of all documents.
+ * @brief Deletes documents by `_id` under the collection's exclusive lock.
+ * @details Only documents still present in the primary index are deleted and de-indexed. Holding
+ * the documents' handles keeps them alive after they leave the primary index.
+ * @param coll The name of the collection.
+ * @param ids The `_id`s to delete.
+ * @return The status and the number of documents deleted.
  */
-std::string Core::fetch_collection_as_json_array(std::string_view coll) {
-    aevum::util::log::Logger::debug("Core: Fetching all documents from collection '" +
-                                    std::string(coll) + "' from in-memory index for FFI.");
-    std::vector<aevum::bson::doc::Document> docs = index_manager_.get_all_documents(coll);
+std::pair<aevum::util::Status, int> Core::remove_ids_locked(std::string_view coll,
+                                                            std::vector<std::string> ids) {
+    std::vector<index::PrimaryIndexer::DocumentPtr> removed_docs;
+    std::vector<std::string> removed_ids;
+    std::vector<storage::KeyWrite> entry_writes;
+    removed_docs.reserve(ids.size());
+    removed_ids.reserve(ids.size());
+    for (auto &uuid : ids) {
+        auto target_doc = index_manager_.get_document_by_id(coll, uuid);
+        if (target_doc) {
+            auto writes = index_manager_.index_entry_writes(coll, target_doc.get(), nullptr);
+            std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+            removed_docs.push_back(std::move(target_doc));
+            removed_ids.push_back(std::move(uuid));
+        }
+    }
 
-    std::ostringstream oss;
-    oss << "[";
-    for (size_t i = 0; i < docs.size(); ++i) {
-        oss << aevum::bson::json::to_string(docs[i]);
-        if (i < docs.size() - 1) oss << ",";
+    ChangeLog::Reservation changes = change_log_.reserve(removed_ids.size());
+    for (const auto &id : removed_ids) changes.append(entry_writes, ChangeType::DELETE, coll, id);
+    if (auto status =
+            storage_.apply_batch(coll, {}, removed_ids, entry_writes, storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("Core: Storage write failed during remove for collection '" +
+                        std::string(coll) + "'. No documents were removed. Status: " +
+                        status.to_string());
+        return {status, 0};
     }
-    oss << "]";
-    return oss.str();
+    changes.commit();
+    index_manager_.remove_documents_from_indexes(coll, removed_docs);
+    return {aevum::util::Status::OK(), static_cast<int>(removed_docs.size())};
 }
 
 /**
- * @brief Inserts a single document into a collection, ensuring data integrity and indexing.
- * @details This is a write-locked operation. The workflow is as follows:
- * 1. An exclusive lock is acquired on the `rw_lock_`.
- * 2. It checks for a pre-existing `_id`. If one is not found, a new UUIDv4 is generated and
- *    prepended to the document.
- * 3. The document is validated against the collection's schema via the `SchemaManager`.
- * 4. The document is persisted to the `WiredTigerStore`.
- * 5. The document is added to the primary and all relevant secondary indexes via the
- * `IndexManager`.
- *
+ * @brief Stages the insertion of a document in a transaction.
+ * @details The document gets an `_id` and is validated as in `insert_locked`; the committed
+ * version of its `_id`, if any, is pinned as its base, so that `commit` detects an insert of the
+ * same `_id` by a concurrent writer.
+ * @param txn The transaction.
  * @param coll The name of the target collection.
- * @param doc The `aevum::bson::doc::Document` to insert.
- * @return A pair containing the operation status and the document's final `_id` string.
+ * @param doc The document to insert.
+ * @return The status of the validation and the document's `_id`.
  */
-std::pair<aevum::util::Status, std::string> Core::insert(std::string_view coll,
+std::pair<aevum::util::Status, std::string> Core::insert(Transaction &txn, std::string_view coll,
                                                          aevum::bson::doc::Document doc) {
-    std::unique_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug("Core: Beginning insert operation for collection '" +
-                                    std::string(coll) + "'.");
-
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "transactions"), ""};
+    pin_resident(coll);
+    AEVUM_DEFER([&]() { unpin_resident(coll); });
+    ensure_resident(coll);
     std::string id_str;
-    bson_iter_t iter;
-
-    if (bson_iter_init_find(&iter, doc.get(), "_id") && BSON_ITER_HOLDS_UTF8(&iter)) {
-        id_str = bson_iter_utf8(&iter, nullptr);
-        aevum::util::log::Logger::debug("Core: Using provided _id '" + id_str + "' for insert.");
-    } else {
-        id_str = aevum::util::uuid::generate_v4();
-        aevum::util::log::Logger::debug("Core: No _id provided. Generated new UUID '" + id_str +
-                                        "' for insert.");
+    if (auto status = ensure_id(doc, id_format(coll), storage_.key_format(coll), id_str);
+        !status.ok()) {
+        return {status, ""};
+    }
+    if (auto status = schema_manager_.validate(coll, doc); !status.ok()) return {status, ""};
+    const Transaction::Version *touched = txn.find(coll, id_str);
+    if (auto status = transaction_room(txn, touched && touched->written ? 0 : 1, doc.length());
+        !status.ok()) {
+        return {status, ""};
+    }
+    txn.pin(coll, id_str, index_manager_.get_document_by_id(coll, id_str));
+    txn.write(coll, id_str, std::make_unique<aevum::bson::doc::Document>(std::move(doc)));
+    return {aevum::util::Status::OK(), id_str};
+}
 
-        bson_t *new_b = bson_new();
-        BSON_APPEND_UTF8(new_b, "_id", id_str.c_str());
-        bson_concat(new_b, doc.get());
-        doc = aevum::bson::doc::Document(new_b);
+/**
+ * @brief Finds the documents matching a query as a transaction sees them.
+ * @details See `find_in_transaction`; the selected versions are projected into copies.
+ * @return The matching documents, in result order.
+ */
+std::vector<aevum::bson::doc::Document> Core::find(Transaction &txn, std::string_view coll,
+                                                   std::string_view query_json,
+                                                   std::string_view sort_json,
+                                                   std::string_view projection_json,
+                                                   int64_t limit, int64_t skip) {
+    query::ProfileScope profile(slow_ops_, "find", coll, query_json, sort_json);
+    aevum::bson::doc::Document projection_doc;
+    if (projection_json != "{}" &&
+        !aevum::bson::json::parse(projection_json, projection_doc).ok()) {
+        projection_doc = aevum::bson::doc::Document();
+    }
+    std::vector<aevum::bson::doc::Document> results;
+    for (const auto *match : find_in_transaction(txn, coll, query_json, sort_json, limit, skip)) {
+        results.push_back(query::apply_projection(*match, projection_doc));
     }
+    query::ProfileScope::note_returned(results.size());
+    return results;
+}
 
-    auto validation_status = schema_manager_.validate(coll, doc);
-    if (!validation_status.ok()) {
-        aevum::util::log::Logger::warn(
-            "Core: Insert failed for collection '" + std::string(coll) +
-            "' due to schema validation failure. Status: " + validation_status.to_string());
-        return {validation_status, ""};
+/**
+ * @brief Finds the documents matching a query as a transaction sees them; the body of the
+ * transactional `find`.
+ * @details Under the collection's shared lock, the committed matches are gathered through the
+ * query plan, leaving out every document the transaction has touched, and the transaction's own
+ * versions of those are added instead, so that a document it has changed or pinned is matched as
+ * the transaction sees it. The candidates are then filtered, sorted, and paginated as in
+ * `find_matching_refs`, and the committed ones among the results are pinned while the lock still
+ * guarantees that their handles are the versions that were matched.
+ * @param txn The transaction.
+ * @param coll The name of the collection.
+ * @param query_json The filter conditions.
+ * @param sort_json The sort order.
+ * @param limit The maximum number of results (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return The transaction's versions of the matches, in result order.
+ */
+std::vector<const aevum::bson::doc::Document *> Core::find_in_transaction(
+    Transaction &txn, std::string_view coll, std::string_view query_json,
+    std::string_view sort_json, int64_t limit, int64_t skip) {
+    std::shared_lock<std::shared_mutex> lock = lock_resident(coll);
+    query::QueryPlan plan = make_plan(coll, query_json, "{}");
+
+    const Transaction::Versions *touched = txn.versions(coll);
+    std::vector<const aevum::bson::doc::Document *> candidates;
+    for (const auto *doc : find_matching_refs(coll, plan, query_json, "{}", 0, 0)) {
+        if (touched && touched->count(extract_id(*doc)) != 0) continue;
+        candidates.push_back(doc);
+    }
+    if (touched) {
+        for (const auto &[id, version] : *touched) {
+            if (const auto *doc = version.current()) candidates.push_back(doc);
+        }
     }
 
-    auto status = storage_.put(coll, id_str, doc);
-    if (!status.ok()) {
-        aevum::util::log::Logger::error(
-            "Core: Insert failed for collection '" + std::string(coll) +
-            "' during storage persistence. Status: " + status.to_string());
-        return {status, ""};
+    std::vector<const aevum::bson::doc::Document *> selected =
+        select_matches(counters_, scan_pool_.get(), std::move(candidates), plan,
+                       std::string(query_json), std::string(sort_json), limit, skip);
+    for (auto &doc : selected) {
+        std::string id_str = extract_id(*doc);
+        if (txn.find(coll, id_str)) continue;
+        doc = txn.pin(coll, id_str, index_manager_.get_document_by_id(coll, id_str)).current();
     }
+    return selected;
+}
 
-    index_manager_.add_document_to_indexes(coll, doc);
-    aevum::util::log::Logger::info("Core: Successfully inserted document '" + id_str +
-                                   "' into collection '" + std::string(coll) + "'.");
-    return {aevum::util::Status::OK(), id_str};
+/**
+ * @brief Stages an update of the documents matching a query in a transaction.
+ * @details The matches are the transaction's versions, pinned by `find_in_transaction`, so the
+ * Rust update engine computes the new versions from what the transaction has seen.
+ * @return The status and the number of documents modified.
+ */
+std::pair<aevum::util::Status, int> Core::update(Transaction &txn, std::string_view coll,
+                                                 std::string_view query_json,
+                                                 std::string_view update_json) {
+    query::ProfileScope profile(slow_ops_, "update", coll, query_json);
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "transactions"), 0};
+    std::vector<const aevum::bson::doc::Document *> matches =
+        find_in_transaction(txn, coll, query_json, "{}", 0, 0);
+    if (matches.empty()) {
+        return {aevum::util::Status::NotFound("No documents were modified."), 0};
+    }
+    auto [status, images] = update_images(coll, matches, query_json, update_json);
+    if (!status.ok()) return {status, 0};
+    if (images.empty()) {
+        return {aevum::util::Status::NotFound("No documents were modified."), 0};
+    }
+    size_t new_writes = 0, new_bytes = 0;
+    for (const auto &[position, after] : images) {
+        const Transaction::Version *touched = txn.find(coll, extract_id(*matches[position]));
+        if (!touched || !touched->written) ++new_writes;
+        new_bytes += after.length();
+    }
+    if (auto room = transaction_room(txn, new_writes, new_bytes); !room.ok()) return {room, 0};
+    for (auto &[position, after] : images) {
+        txn.write(coll, extract_id(*matches[position]),
+                  std::make_unique<aevum::bson::doc::Document>(std::move(after)));
+    }
+    return {aevum::util::Status::OK(), static_cast<int>(images.size())};
 }
 
 /**
- * @brief Performs an "upsert": updates a document if it exists, otherwise inserts it.
- * @param coll The target collection name.
- * @param query_json A JSON query to find the document to upsert.
- * @param doc The document data to insert or use for updating.
- * @return `aevum::util::Status::OK()` on success, or an error status on failure.
- */
-aevum::util::Status Core::upsert(std::string_view coll, std::string_view query_json,
-                                 const aevum::bson::doc::Document &doc) {
-    aevum::util::log::Logger::debug("Core: Beginning upsert operation for collection '" +
-                                    std::string(coll) + "'.");
-    if (count(coll, query_json) > 0) {
-        aevum::util::log::Logger::debug(
-            "Core: Upsert found matching document(s). Proceeding with update path.");
-        std::string update_json = aevum::bson::json::to_string(doc);
-        return update(coll, query_json, update_json).first;
-    } else {
-        aevum::util::log::Logger::debug(
-            "Core: Upsert found no matching documents. Proceeding with insert path.");
-        aevum::bson::doc::Document doc_copy(doc);
-        return insert(coll, std::move(doc_copy)).first;
+ * @brief Stages the removal of the documents matching a query in a transaction.
+ * @return The status and the number of documents removed.
+ */
+std::pair<aevum::util::Status, int> Core::remove(Transaction &txn, std::string_view coll,
+                                                 std::string_view query_json) {
+    query::ProfileScope profile(slow_ops_, "remove", coll, query_json);
+    if (time_series_.options(coll)) return {time_series_refusal(coll, "transactions"), 0};
+    std::vector<const aevum::bson::doc::Document *> matches =
+        find_in_transaction(txn, coll, query_json, "{}", 0, 0);
+    if (matches.empty()) {
+        return {aevum::util::Status::NotFound("No documents matched the query."), 0};
+    }
+    // The `_id`s are read before the first write releases the version they are read from.
+    std::vector<std::string> ids;
+    ids.reserve(matches.size());
+    size_t new_writes = 0;
+    for (const auto *match : matches) {
+        ids.push_back(extract_id(*match));
+        const Transaction::Version *touched = txn.find(coll, ids.back());
+        if (!touched || !touched->written) ++new_writes;
     }
+    if (auto room = transaction_room(txn, new_writes, 0); !room.ok()) return {room, 0};
+    for (const auto &id : ids) txn.write(coll, id, nullptr);
+    return {aevum::util::Status::OK(), static_cast<int>(ids.size())};
 }
 
 /**
- * @brief Counts documents in a collection matching a query via the Rust FFI.
- * @param coll The collection to query.
- * @param query_json A JSON string representing the query criteria.
- * @return The number of matching documents.
+ * @brief Checks that a transaction may stage more writes within its limits.
+ * @details The size is that of the versions already staged plus the new ones, without deducting
+ * the versions the new ones replace, so a full transaction may refuse a rewrite that would fit.
+ * @param txn The transaction.
+ * @param new_writes The documents about to be written for the first time.
+ * @param new_bytes The size of the versions about to be staged.
+ * @return `aevum::util::Status::OK()`, or `InvalidArgument` naming the exceeded limit.
  */
-int Core::count(std::string_view coll, std::string_view query_json) {
-    std::shared_lock<std::shared_mutex> lock(rw_lock_);
-    std::string collection_json = fetch_collection_as_json_array(coll);
-    std::string q_str(query_json);
-    aevum::util::log::Logger::debug("Core: Dispatching count query to FFI for collection '" +
-                                    std::string(coll) + "'.");
-    return rust_count(collection_json.c_str(), q_str.c_str());
+aevum::util::Status Core::transaction_room(const Transaction &txn, size_t new_writes,
+                                           size_t new_bytes) const {
+    if (txn.write_count() + new_writes > transaction_max_writes_) {
+        return aevum::util::Status::InvalidArgument(
+            "The transaction would exceed its limit of " + std::to_string(transaction_max_writes_) +
+            " written documents; commit it and continue in a new transaction.");
+    }
+    if (txn.staged_bytes() + new_bytes > transaction_max_bytes_) {
+        return aevum::util::Status::InvalidArgument(
+            "The transaction would exceed its limit of " + std::to_string(transaction_max_bytes_) +
+            " staged bytes; commit it and continue in a new transaction.");
+    }
+    return aevum::util::Status::OK();
 }
 
 /**
- * @brief Finds documents in a collection, delegating complex queries to the Rust FFI.
- * @details This is a read-locked operation. It includes a critical optimization: if the query is a
- * simple lookup by `_id`, it serves the request directly from the high-speed primary index. For all
- * other queries, it serializes the entire collection to a JSON string and dispatches the find
- * operation to the Rust FFI, which handles filtering, sorting, and projection. The FFI result is
- * then parsed back into BSON documents.
+ * @brief Commits the writes of a transaction atomically.
+ * @details The workflow is as follows:
+ * 1. Every collection the transaction wrote to is locked exclusively, in name order, so that two
+ *    commits never wait for each other in a cycle, and loaded if it is unloaded. A collection the
+ *    memory budget evicted since the transaction read it is loaded with new handles, so its
+ *    written documents conflict.
+ * 2. The base of every written document is compared with the handle the primary index holds
+ *    now. Handles are never reused while the transaction pins them, so a different handle means
+ *    a concurrent write committed first, and the commit fails with `Conflict`.
+ * 3. The staged versions, the index entries they retract and add, and one change log record per
+ *    document are written in a single `apply_batches` transaction.
+ * 4. Only once that has committed are the in-memory indexes changed, collection by collection.
+ * 5. The locks are released and the journal is flushed to the requested durability level.
  *
- * @return A vector of BSON documents that match the criteria.
+ * @param txn The transaction; it is cleared whatever the outcome.
+ * @param durability How far the write is persisted before returning.
+ * @return The status of the commit.
  */
-std::vector<aevum::bson::doc::Document> Core::find(std::string_view coll,
-                                                   std::string_view query_json,
-                                                   std::string_view sort_json,
-                                                   std::string_view projection_json, int64_t limit,
-                                                   int64_t skip) {
-    std::shared_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug("Core: Beginning find operation for collection '" +
-                                    std::string(coll) + "'.");
-
-    aevum::bson::doc::Document query_doc;
-    if (aevum::bson::json::parse(query_json, query_doc).ok()) {
-        bson_iter_t iter;
-        if (bson_iter_init(&iter, query_doc.get()) && bson_iter_next(&iter) &&
-            std::string_view(bson_iter_key(&iter)) == "_id" && !bson_iter_next(&iter)) {
-            bson_iter_init_find(&iter, query_doc.get(), "_id");
-            if (BSON_ITER_HOLDS_UTF8(&iter)) {
-                std::string id_to_find = bson_iter_utf8(&iter, nullptr);
-                aevum::util::log::Logger::debug("Core: Find optimized for single _id lookup: '" +
-                                                id_to_find + "'.");
-                auto found_doc = index_manager_.get_document_by_id(coll, id_to_find);
-                if (found_doc) {
-                    return {std::move(*found_doc)};
-                }
-                return {};
+aevum::util::Status Core::commit(Transaction &txn, storage::Durability durability) {
+    AEVUM_DEFER([&]() { txn.clear(); });
+    if (txn.write_count() == 0) return aevum::util::Status::OK();
+
+    std::vector<std::pair<std::string_view, Transaction::Versions *>> written;
+    for (auto &[coll, versions] : txn.collections()) {
+        for (const auto &[id, version] : versions) {
+            if (!version.written) continue;
+            written.emplace_back(coll, &versions);
+            break;
+        }
+    }
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(written.size());
+    for (const auto &[coll, versions] : written) locks.emplace_back(collection_lock(coll));
+    for (const auto &[coll, versions] : written) load_resident_locked(coll);
+
+    size_t change_count = 0;
+    for (const auto &[coll, versions] : written) {
+        for (const auto &[id, version] : *versions) {
+            if (!version.written) continue;
+            if (index_manager_.get_document_by_id(coll, id) != version.base) {
+                AEVUM_LOG_INFO("Core: Transaction conflicts on document '" + id +
+                               "' of collection '" + std::string(coll) + "'.");
+                return aevum::util::Status::Conflict(
+                    "Document '" + id + "' of collection '" + std::string(coll) +
+                    "' was changed by a concurrent write; retry the transaction.");
+            }
+            if (version.base || version.staged) ++change_count;
+        }
+    }
+    for (const auto &[coll, versions] : written) bump_write_generation(coll);
+
+    // The documents are moved out of the transaction into the batches; the removed ones stay
+    // alive through their bases until they are de-indexed.
+    std::vector<std::vector<std::pair<std::string, aevum::bson::doc::Document>>> puts(
+        written.size());
+    std::vector<std::vector<std::string>> deletes(written.size());
+    std::vector<std::vector<index::PrimaryIndexer::DocumentPtr>> removed(written.size());
+    std::vector<storage::KeyWrite> entry_writes;
+    ChangeLog::Reservation changes = change_log_.reserve(change_count);
+    for (size_t i = 0; i < written.size(); ++i) {
+        std::string_view coll = written[i].first;
+        for (auto &[id, version] : *written[i].second) {
+            if (!version.written || (!version.base && !version.staged)) continue;
+            auto writes =
+                index_manager_.index_entry_writes(coll, version.base.get(), version.staged.get());
+            std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+            if (version.staged) {
+                changes.append(entry_writes, version.base ? ChangeType::UPDATE : ChangeType::INSERT,
+                               coll, id);
+                puts[i].emplace_back(id, std::move(*version.staged));
+            } else {
+                changes.append(entry_writes, ChangeType::DELETE, coll, id);
+                deletes[i].push_back(id);
+                removed[i].push_back(version.base);
             }
         }
     }
 
-    aevum::util::log::Logger::debug(
-        "Core: Complex find query detected. Dispatching to FFI for collection '" +
-        std::string(coll) + "'.");
-    std::string collection_json = fetch_collection_as_json_array(coll);
-
-    std::string q_str(query_json);
-    std::string s_str(sort_json);
-    std::string p_str(projection_json);
+    std::vector<storage::CollectionBatch> batches;
+    batches.reserve(written.size());
+    for (size_t i = 0; i < written.size(); ++i) {
+        batches.push_back(storage::CollectionBatch{written[i].first, puts[i], deletes[i]});
+    }
+    if (auto status = storage_.apply_batches(batches, entry_writes, storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("Core: Storage write failed during transaction commit. No documents were "
+                        "modified. Status: " +
+                        status.to_string());
+        return status;
+    }
+    changes.commit();
+
+    for (size_t i = 0; i < written.size(); ++i) {
+        std::string_view coll = written[i].first;
+        if (!removed[i].empty()) index_manager_.remove_documents_from_indexes(coll, removed[i]);
+        std::vector<aevum::bson::doc::Document> docs;
+        docs.reserve(puts[i].size());
+        for (auto &[id, doc] : puts[i]) docs.push_back(std::move(doc));
+        if (!docs.empty()) index_manager_.add_documents_to_indexes(coll, docs);
+    }
+    AEVUM_LOG_INFO("Core: Committed a transaction of " + std::to_string(change_count) +
+                   " writes to " + std::to_string(written.size()) + " collections.");
 
-    std::unique_ptr<char, decltype(&rust_free_string)> result_json_ptr(
-        rust_find(collection_json.c_str(), q_str.c_str(), s_str.c_str(), p_str.c_str(), limit,
-                  skip),
-        &rust_free_string);
-    std::string result_json = result_json_ptr ? result_json_ptr.get() : "[]";
+    locks.clear();
+    return storage_.make_durable(durability);
+}
 
-    std::vector<aevum::bson::doc::Document> results;
-    aevum::bson::doc::Document result_array_doc;
-    if (aevum::bson::json::parse(result_json, result_array_doc).ok()) {
-        bson_iter_t array_iter;
-        if (bson_iter_init(&array_iter, result_array_doc.get())) {
-            while (bson_iter_next(&array_iter)) {
-                if (BSON_ITER_HOLDS_DOCUMENT(&array_iter)) {
-                    const uint8_t *doc_data = nullptr;
-                    uint32_t doc_len = 0;
-                    bson_iter_document(&array_iter, &doc_len, &doc_data);
-
-                    bson_t *b = bson_new_from_data(doc_data, doc_len);
-                    if (b) results.emplace_back(b);
-                }
+/**
+ * @brief Deletes the expired documents of every TTL index.
+ * @details A batch takes the collection's lock exclusively only to look its `_id`s up in the
+ * ordered index and delete them, and its write is flushed to the default durability after the
+ * lock is released. A failed batch ends the pass over that index; the next pass retries it.
+ * @param sweeper The sweeper running the pass.
+ */
+void Core::sweep_expired(TtlSweeper &sweeper) {
+    for (const auto &ttl : index_manager_.ttl_indexes()) {
+        {
+            // Loading an evicted collection back for the sweep alone would undo the eviction.
+            std::lock_guard<std::mutex> unloaded_lock(unloaded_mutex_);
+            if (evicted_.count(ttl.collection) != 0) continue;
+        }
+        ensure_resident(ttl.collection);
+        auto now = static_cast<int64_t>(aevum::util::time::CoarseClock::now_unix_ms() / 1000);
+        index::KeyRange expired;
+        expired.lower = index::IndexKey::floor(index::KeyRank::NUMBER);
+        expired.upper = index::IndexKey{index::KeyRank::NUMBER,
+                                        static_cast<double>(now - ttl.expire_after_seconds), {}};
+        expired.upper_inclusive = true;
+
+        while (true) {
+            std::unique_lock<std::shared_mutex> lock(collection_lock(ttl.collection));
+            std::vector<std::string> ids = index_manager_.get_ids_in_range(
+                ttl.collection, ttl.field, expired, ttl_batch_size_);
+            if (ids.empty()) break;
+            bool last_batch = ids.size() < ttl_batch_size_;
+            // A document with several expired array elements has one entry for each.
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+            bump_write_generation(ttl.collection);
+            auto [status, removed] = remove_ids_locked(ttl.collection, std::move(ids));
+            lock.unlock();
+            if (status.ok()) status = storage_.make_durable(storage::Durability::DEFAULT);
+            sweeper.note_batch(static_cast<size_t>(removed), status.ok());
+            if (!status.ok()) {
+                AEVUM_LOG_ERROR("Core: TTL delete batch failed for '" + ttl.collection + "." +
+                                ttl.field + "'. Status: " + status.to_string());
+                break;
             }
+            AEVUM_LOG_DEBUG("Core: TTL index '" + ttl.collection + "." + ttl.field +
+                            "' expired " + std::to_string(removed) + " documents.");
+            if (last_batch) break;
+            if (!sweeper.pause(ttl_batch_pause_)) return;
         }
     }
-    aevum::util::log::Logger::debug("Core: Find operation completed, returning " +
-                                    std::to_string(results.size()) + " documents.");
-    return results;
 }
 
 /**
- * @brief Updates documents matching a query, synchronizing the entire collection state afterward.
- * @details This is a write-locked operation. It sends the entire collection and the update query to
- * the Rust FFI. The FFI returns a JSON string of the completely modified collection. This C++ side
- * then parses this new dataset and uses the `storage_.sync_collection` method to atomically
- * replace the old collection data in storage. Finally, the indexes are rebuilt.
- *
- * @return A pair containing the status and the number of documents in the newly synced collection.
+ * @brief Returns the counters of the TTL sweeper.
+ * @return The snapshot of the counters.
  */
-std::pair<aevum::util::Status, int> Core::update(std::string_view coll, std::string_view query_json,
-                                                 std::string_view update_json) {
-    std::unique_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug("Core: Beginning update operation for collection '" +
-                                    std::string(coll) + "'. Dispatching to FFI.");
-    std::string collection_json = fetch_collection_as_json_array(coll);
-
-    std::string q_str(query_json);
-    std::string u_str(update_json);
-
-    // Retrieve the schema if one is set for this collection.
-    std::string schema_json = "";
-    auto schema_opt = schema_manager_.get_schema(coll);
-    if (schema_opt) {
-        schema_json = aevum::bson::json::to_string(*schema_opt);
-    }
-
-    rust_update_result res =
-        rust_update(collection_json.c_str(), q_str.c_str(), u_str.c_str(), schema_json.c_str());
-
-    std::string updated_collection_json = res.data ? res.data : "";
-    int affected_count = res.modified_count;
+TtlStats Core::ttl_stats() const noexcept {
+    return ttl_sweeper_ ? ttl_sweeper_->stats() : TtlStats{};
+}
 
-    if (updated_collection_json.empty() || updated_collection_json == "[]") {
-        rust_free_update_result(res);
-        if (affected_count == 0) {
-            aevum::util::log::Logger::warn("Core: Update for collection '" + std::string(coll) +
-                                           "' resulted in no matches or all validation failures.");
-            return {aevum::util::Status::NotFound("No documents were modified."), 0};
+/**
+ * @brief Reads the changes that follow a resume token, waiting for one if there is none yet.
+ * @details No collection lock is taken: the change log only exposes committed records, and its
+ * resume tokens stay valid across writes. A filtered reader whose wait is ended by changes to
+ * other collections advances its token past them and waits again for what remains of
+ * `max_wait`.
+ * @param after The resume token.
+ * @param coll Only the changes of this collection, or empty for all.
+ * @param limit The most changes returned.
+ * @param max_wait The longest wait for a change.
+ * @param changes Receives the changes, oldest first.
+ * @param resume_token Receives the token to pass on the next call.
+ * @return The status of the read.
+ */
+aevum::util::Status Core::watch(uint64_t after, std::string_view coll, size_t limit,
+                                std::chrono::milliseconds max_wait, std::vector<Change> &changes,
+                                uint64_t &resume_token) {
+    auto deadline = std::chrono::steady_clock::now() + max_wait;
+    resume_token = after;
+    while (true) {
+        if (auto status = change_log_.read(resume_token, coll, limit, changes, resume_token);
+            !status.ok() || !changes.empty()) {
+            return status;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || !change_log_.wait_for(resume_token, remaining)) {
+            return aevum::util::Status::OK();
         }
     }
+}
 
-    aevum::bson::doc::Document new_collection_doc;
-    if (auto status = aevum::bson::json::parse(updated_collection_json, new_collection_doc);
-        !status.ok()) {
-        rust_free_update_result(res);
-        aevum::util::log::Logger::error(
-            "Core: Failed to parse updated collection JSON received from FFI. Status: " +
-            status.to_string());
-        return {status, 0};
-    }
-
-    // After parsing, we don't need the raw string from Rust anymore.
-    rust_free_update_result(res);
+/**
+ * @brief Returns the state of the change log.
+ * @return The snapshot.
+ */
+ChangeLogStats Core::change_log_stats() const noexcept { return change_log_.stats(); }
 
-    std::vector<std::pair<std::string, aevum::bson::doc::Document>> sync_batch;
-    std::vector<aevum::bson::doc::Document> index_batch;
+/**
+ * @brief Returns the counters of the index images.
+ * @return The counters of the writer, if it runs, with those of the loads.
+ */
+IndexImageStats Core::index_image_stats() const noexcept {
+    IndexImageStats stats = image_writer_ ? image_writer_->stats() : IndexImageStats{};
+    stats.enabled = index_images_;
+    stats.loaded = images_loaded_.load(std::memory_order_relaxed);
+    stats.rejected = images_rejected_.load(std::memory_order_relaxed);
+    return stats;
+}
 
-    bson_iter_t array_iter;
-    if (bson_iter_init(&array_iter, new_collection_doc.get())) {
-        while (bson_iter_next(&array_iter)) {
-            if (BSON_ITER_HOLDS_DOCUMENT(&array_iter)) {
-                const uint8_t *doc_data = nullptr;
-                uint32_t doc_len = 0;
-                bson_iter_document(&array_iter, &doc_len, &doc_data);
-
-                bson_t *b = bson_new_from_data(doc_data, doc_len);
-                if (b) {
-                    aevum::bson::doc::Document doc(b);
-                    bson_iter_t id_iter;
-                    if (bson_iter_init_find(&id_iter, doc.get(), "_id") &&
-                        BSON_ITER_HOLDS_UTF8(&id_iter)) {
-                        std::string id_str = bson_iter_utf8(&id_iter, nullptr);
-                        sync_batch.emplace_back(id_str, aevum::bson::doc::Document(doc));
-                        index_batch.push_back(std::move(doc));
-                    }
-                }
+/**
+ * @brief Writes the images of the resident user collections written to since their last image.
+ * @details The collection's lock is looked up without `collection_lock`, which would stamp the
+ * collection as used for the memory budget, and held shared only to capture the document
+ * handles and copy the index entries; the documents are immutable, so the image is written from
+ * the handles after the lock is released. The change log's last visible sequence number, taken
+ * under the lock, covers every change to the collection, since writers hold the lock
+ * exclusively until their records are released. Storage is synchronized before the image is
+ * published: an image holding changes that a crash then rolled back could never be recognized
+ * as outdated. Evicted and never-loaded collections keep their previous image.
+ * @param writer The writer running the pass, or `nullptr` at shutdown.
+ */
+void Core::write_index_images(IndexImageWriter *writer) {
+    for (const auto &name : storage_.list_collections()) {
+        if (writer != nullptr && writer->stopping()) return;
+        if (!is_user_collection(name) || time_series_.options(name)) continue;
+
+        uint64_t generation = 0;
+        uint64_t sequence = 0;
+        index::IndexImageContent content;
+        {
+            std::shared_lock<std::shared_mutex> lock(collection_states_.find_or_add(name).lock);
+            if (is_unloaded(name)) continue;
+            generation = write_generation(name);
+            {
+                std::lock_guard<std::mutex> images_lock(image_mutex_);
+                auto it = image_generations_.find(name);
+                if (it != image_generations_.end() && it->second == generation) continue;
             }
+            sequence = change_log_.stats().last_sequence;
+            content = index_manager_.capture_image(name);
         }
-    }
 
-    aevum::util::log::Logger::debug("Core: Synchronizing " + std::to_string(sync_batch.size()) +
-                                    " documents back to storage for collection '" +
-                                    std::string(coll) + "'.");
-    if (auto status = storage_.sync_collection(coll, sync_batch); !status.ok()) {
-        aevum::util::log::Logger::error(
-            "Core: Storage synchronization failed during update for collection '" +
-            std::string(coll) + "'. Status: " + status.to_string());
-        return {status, 0};
+        size_t bytes = 0;
+        auto status = storage_.make_durable(storage::Durability::FSYNC);
+        if (status.ok()) {
+            status = index::IndexImage::write(index::IndexImage::path(storage_.base_path(), name),
+                                              name, sequence, content, bytes);
+        }
+        if (writer != nullptr) writer->note_image(bytes, status.ok());
+        if (!status.ok()) {
+            AEVUM_LOG_WARN("Core: Failed to write the index image of collection '" + name +
+                           "'. Status: " + status.to_string());
+            continue;
+        }
+        std::lock_guard<std::mutex> images_lock(image_mutex_);
+        image_generations_[name] = generation;
+        AEVUM_LOG_DEBUG("Core: Wrote the index image of collection '" + name + "', " +
+                        std::to_string(content.documents.size()) + " documents in " +
+                        std::to_string(bytes) + " bytes.");
     }
-
-    aevum::util::log::Logger::debug("Core: Rebuilding indexes for collection '" +
-                                    std::string(coll) + "' post-update.");
-    index_manager_.rebuild_index(coll, index_batch);
-    aevum::util::log::Logger::info("Core: Update operation completed for collection '" +
-                                   std::string(coll) + "'. " + std::to_string(affected_count) +
-                                   " documents modified.");
-    return {aevum::util::Status::OK(), affected_count};
 }
 
 /**
- * @brief Removes documents from a collection that match a given query.
- * @details This write-locked operation first performs a read-only `find` via the FFI, projecting
- * only the `_id` field to efficiently gather the list of documents to be deleted. It then
- * iterates through this list of IDs, removing each document from the `WiredTigerStore` and
- * updating the `IndexManager` to remove it from all indexes.
- *
- * @return A pair containing the status and the number of documents successfully removed.
+ * @brief Applies a batch of documents replicated from a primary to a collection.
+ * @details The collection is loaded first, so that the previous image of every document is at
+ * hand to retract its index entries. The puts, deletions, index entries, and change records are
+ * committed by one `apply_batch`, after which the documents are indexed under one index lock and
+ * the deleted ones removed as one batch, exactly as by `insert_many` and `remove`. The journal is
+ * flushed to the default durability after the lock is released.
+ * @param coll The name of the collection.
+ * @param docs The documents to store.
+ * @param deleted_ids The `_id`s to remove.
+ * @return The status of the write.
  */
-std::pair<aevum::util::Status, int> Core::remove(std::string_view coll,
-                                                 std::string_view query_json) {
-    std::unique_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug("Core: Beginning remove operation for collection '" +
-                                    std::string(coll) + "'.");
-    std::string collection_json = fetch_collection_as_json_array(coll);
-
-    std::string q_str(query_json);
-
-    std::unique_ptr<char, decltype(&rust_free_string)> result_json_ptr(
-        rust_find(collection_json.c_str(), q_str.c_str(), "{}", "{\"_id\":1}", 0, 0),
-        &rust_free_string);
-
-    std::string result_json = result_json_ptr ? result_json_ptr.get() : "[]";
-
-    aevum::bson::doc::Document matching_docs_doc;
-    if (!aevum::bson::json::parse(result_json, matching_docs_doc).ok()) {
-        aevum::util::log::Logger::error(
-            "Core: Failed to parse _id list from FFI during remove for collection '" +
-            std::string(coll) + "'.");
-        return {aevum::util::Status::NotFound("No documents found to remove."), 0};
+aevum::util::Status Core::apply_replicated(std::string_view coll,
+                                           std::vector<aevum::bson::doc::Document> docs,
+                                           const std::vector<std::string> &deleted_ids) {
+    std::unique_lock<std::shared_mutex> lock(collection_lock(coll));
+    load_resident_locked(coll);
+    bump_write_generation(coll);
+
+    std::vector<storage::KeyWrite> entry_writes;
+    ChangeLog::Reservation changes = change_log_.reserve(docs.size() + deleted_ids.size());
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.reserve(docs.size());
+    for (auto &doc : docs) {
+        std::string id_str = extract_id(doc);
+        if (id_str.empty()) continue;
+        const auto *previous = index_manager_.get_document_ref_by_id(coll, id_str);
+        auto writes = index_manager_.index_entry_writes(coll, previous, &doc);
+        std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+        changes.append(entry_writes, previous ? ChangeType::UPDATE : ChangeType::INSERT, coll,
+                       id_str);
+        puts.emplace_back(std::move(id_str), std::move(doc));
     }
 
-    std::vector<std::string> ids_to_remove;
-    bson_iter_t array_iter;
-    if (bson_iter_init(&array_iter, matching_docs_doc.get())) {
-        while (bson_iter_next(&array_iter)) {
-            if (BSON_ITER_HOLDS_DOCUMENT(&array_iter)) {
-                bson_iter_t doc_iter;
-                bson_iter_recurse(&array_iter, &doc_iter);
-                if (bson_iter_find(&doc_iter, "_id") && BSON_ITER_HOLDS_UTF8(&doc_iter)) {
-                    ids_to_remove.emplace_back(bson_iter_utf8(&doc_iter, nullptr));
-                }
-            }
-        }
+    std::vector<index::PrimaryIndexer::DocumentPtr> removed_docs;
+    std::vector<std::string> removed_ids;
+    for (const auto &id_str : deleted_ids) {
+        auto target_doc = index_manager_.get_document_by_id(coll, id_str);
+        if (!target_doc) continue;
+        auto writes = index_manager_.index_entry_writes(coll, target_doc.get(), nullptr);
+        std::move(writes.begin(), writes.end(), std::back_inserter(entry_writes));
+        changes.append(entry_writes, ChangeType::DELETE, coll, id_str);
+        removed_docs.push_back(std::move(target_doc));
+        removed_ids.push_back(id_str);
     }
 
-    if (ids_to_remove.empty()) {
-        aevum::util::log::Logger::info("Core: Remove query for collection '" + std::string(coll) +
-                                       "' matched 0 documents. No action taken.");
-        return {aevum::util::Status::NotFound("No documents matched the query."), 0};
+    if (auto status =
+            storage_.apply_batch(coll, puts, removed_ids, entry_writes, storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("Core: Failed to apply a replicated batch to collection '" +
+                        std::string(coll) + "'. Status: " + status.to_string());
+        return status;
     }
-    aevum::util::log::Logger::debug("Core: Identified " + std::to_string(ids_to_remove.size()) +
-                                    " documents to remove from collection '" + std::string(coll) +
-                                    "'.");
-
-    int removed_count = 0;
-    for (const auto &uuid : ids_to_remove) {
-        auto target_doc_opt = index_manager_.get_document_by_id(coll, uuid);
-        if (target_doc_opt) {
-            if (auto status = storage_.remove(coll, uuid); !status.ok()) {
-                aevum::util::log::Logger::warn("Core: Failed to remove document '" + uuid +
-                                               "' from storage. Status: " + status.to_string());
-                continue;
-            }
-            index_manager_.remove_document_from_indexes(coll, *target_doc_opt);
-            removed_count++;
-        }
+    changes.commit();
+
+    std::vector<aevum::bson::doc::Document> stored;
+    stored.reserve(puts.size());
+    for (auto &put : puts) stored.push_back(std::move(put.second));
+    index_manager_.add_documents_to_indexes(coll, stored);
+    index_manager_.remove_documents_from_indexes(coll, removed_docs);
+
+    lock.unlock();
+    return storage_.make_durable(storage::Durability::DEFAULT);
+}
+
+/**
+ * @brief Reads the position of this replica in its primary's change log.
+ * @return The stored resume token, or 0.
+ */
+uint64_t Core::replication_token() {
+    aevum::bson::doc::Document doc;
+    if (!storage_.get(REPLICATION_TABLE, REPLICATION_TOKEN_ID, doc).ok()) return 0;
+    bson_iter_t iter;
+    if (bson_iter_init_find(&iter, doc.get(), "resume_token") && BSON_ITER_HOLDS_INT64(&iter)) {
+        return static_cast<uint64_t>(bson_iter_int64(&iter));
     }
+    return 0;
+}
 
-    aevum::util::log::Logger::info("Core: Successfully removed " + std::to_string(removed_count) +
-                                   " documents from collection '" + std::string(coll) + "'.");
-    return {aevum::util::Status::OK(), removed_count};
+/**
+ * @brief Stores the position of this replica in its primary's change log.
+ * @details The token is written at the default durability, so that a restarted replica resumes
+ * at most one batch behind, which it reapplies harmlessly.
+ * @param token The resume token.
+ * @return The status of the write.
+ */
+aevum::util::Status Core::store_replication_token(uint64_t token) {
+    bson_t *b = bson_new();
+    BSON_APPEND_UTF8(b, "_id", REPLICATION_TOKEN_ID);
+    BSON_APPEND_INT64(b, "resume_token", static_cast<int64_t>(token));
+    return storage_.put(REPLICATION_TABLE, REPLICATION_TOKEN_ID, aevum::bson::doc::Document(b));
 }
 
 /**
@@ -537,40 +3704,60 @@ std::pair<aevum::util::Status, int> Core::remove(std::string_view coll,
  */
 aevum::util::Status Core::set_schema(std::string_view coll,
                                      const aevum::bson::doc::Document &schema) {
-    aevum::util::log::Logger::info("Core: Setting/updating schema for collection '" +
-                                   std::string(coll) + "'.");
+    AEVUM_LOG_INFO("Core: Setting/updating schema for collection '" + std::string(coll) + "'.");
     return schema_manager_.set_schema(coll, schema);
 }
 
 /**
  * @brief Creates a new secondary index on a field within a collection.
+ * @details The index is built online by the `IndexManager` from the resident primary index. The
+ * collection's lock is only held exclusively to register the build and, at the end, to catch up
+ * with the writes made during the backfill and publish the index; queries and writes proceed in
+ * between.
  * @param coll The target collection name.
  * @param field The field to create an index on.
- * @return `Status::OK()` on success.
+ * @param type The physical organization of the index.
+ * @param expire_after_seconds The time-to-live of a TTL index, if it is one.
+ * @param options The options of a sparse or partial index.
+ * @return `Status::OK()` on success, or the error reported by the `IndexManager`.
  */
-aevum::util::Status Core::create_index(std::string_view coll, std::string_view field) {
-    aevum::util::log::Logger::info("Core: Creating index on field '" + std::string(field) +
-                                   "' for collection '" + std::string(coll) + "'.");
-    std::vector<aevum::bson::doc::Document> existing_docs = storage_.load_collection(coll);
-    return index_manager_.create_index(coll, field, existing_docs);
+aevum::util::Status Core::create_index(std::string_view coll, std::string_view field,
+                                       index::IndexType type,
+                                       std::optional<int64_t> expire_after_seconds,
+                                       const index::IndexOptions &options) {
+    if (time_series_.options(coll)) return time_series_refusal(coll, "indexes");
+    // The build scans the collection's documents, so it must not be evicted until it ends.
+    pin_resident(coll);
+    AEVUM_DEFER([&]() { unpin_resident(coll); });
+    ensure_resident(coll);
+    AEVUM_LOG_INFO("Core: Creating " + std::string(index::to_string(type)) + " index on field '" +
+                   std::string(field) + "' for collection '" + std::string(coll) + "'.");
+    return index_manager_.create_index(coll, field, type, collection_lock(coll),
+                                       expire_after_seconds, options);
 }
 
 /**
  * @brief Creates a new user and persists their credentials.
+ * @details Besides the DJB2 hash that authorizes its requests, the user is stored with a
+ * salted PBKDF2 verifier, which `login` checks.
  * @param raw_key The plain-text API key for the new user.
  * @param role The assigned role for the new user.
  * @return `Status::OK()` on success.
  */
 aevum::util::Status Core::create_user(std::string_view raw_key, auth::UserRole role) {
     std::string role_str(auth::to_string(role));
-    aevum::util::log::Logger::info("Core: Creating new user with role '" + role_str + "'.");
+    AEVUM_LOG_INFO("Core: Creating new user with role '" + role_str + "'.");
     std::string key_hash = aevum::util::hash::djb2_string(raw_key);
-    auth_manager_.add_user(key_hash, role);
+    auth::Credential credential = auth::make_credential(raw_key, role);
 
     bson_t *b = bson_new();
     BSON_APPEND_UTF8(b, "_id", aevum::util::uuid::generate_v4().c_str());
     BSON_APPEND_UTF8(b, "key_hash", key_hash.c_str());
     BSON_APPEND_UTF8(b, "role", role_str.c_str());
+    BSON_APPEND_UTF8(b, "kdf_salt", aevum::util::crypto::to_hex(credential.kdf_salt).c_str());
+    BSON_APPEND_UTF8(b, "kdf_key", aevum::util::crypto::to_hex(credential.kdf_key).c_str());
+    BSON_APPEND_INT64(b, "kdf_iterations", credential.kdf_iterations);
+    auth_manager_.add_user(key_hash, std::move(credential));
 
     return storage_.put("_auth", key_hash, aevum::bson::doc::Document(b));
 }
@@ -584,4 +3771,89 @@ auth::UserRole Core::authenticate(std::string_view raw_key) const {
     return auth_manager_.authenticate(raw_key);
 }
 
+/**
+ * @brief Verifies a user's raw API key with the key derivation function, to open a session.
+ * @param raw_key The plain-text API key.
+ * @return The `UserRole` if the key verifies, `UserRole::NONE` otherwise.
+ */
+auth::UserRole Core::login(std::string_view raw_key) const { return auth_manager_.login(raw_key); }
+
+/**
+ * @brief Returns how queries have been executed so far.
+ * @details The counters are read one by one without stopping queries, so the snapshot is
+ * consistent only to within the operations in flight.
+ * @return The snapshot of the execution counters and of the storage engine's time.
+ */
+ExecutionStats Core::execution_stats() const noexcept {
+    ExecutionStats stats;
+    for (size_t i = 0; i < query::PLAN_TYPE_COUNT; ++i) {
+        stats.plans[i] = counters_.plans[i].load(std::memory_order_relaxed);
+    }
+    stats.ffi_calls = counters_.ffi_calls.load(std::memory_order_relaxed);
+    stats.ffi_us = counters_.ffi_us.load(std::memory_order_relaxed);
+    stats.storage = storage_.stats();
+    return stats;
+}
+
+/**
+ * @brief Reports the progress of the index builds in flight.
+ * @return One entry per build, in the order they started.
+ */
+std::vector<index::IndexBuildProgress> Core::index_builds() const {
+    return index_manager_.index_builds();
+}
+
+/**
+ * @brief Starts an online backup of the data directory in the background.
+ * @param destination The directory to write to.
+ * @param incremental `true` to copy only the blocks modified since the destination's backup.
+ * @return `aevum::util::Status::OK()` once the backup is running, or why it cannot start.
+ */
+aevum::util::Status Core::start_backup(const std::string &destination, bool incremental) {
+    return backup_.start(destination, incremental);
+}
+
+/**
+ * @brief Reads a selection of the storage engine's own statistics.
+ * @return Pairs of statistic description and value.
+ */
+std::vector<std::pair<std::string, int64_t>> Core::engine_statistics() {
+    return storage_.engine_statistics();
+}
+
+/**
+ * @brief Estimates the memory held by the documents and indexes of the resident collections.
+ * @details The estimates are those of `IndexManager::memory_usage`, taken collection by
+ * collection without the collections' locks, so they may mix states of concurrent writes.
+ * @return The estimates, with the counters of the memory budget.
+ */
+MemoryUsage Core::memory_usage() {
+    MemoryUsage usage;
+    usage.budget = memory_budget_->stats();
+    usage.evictions = evictions_.load(std::memory_order_relaxed);
+    for (auto &name : storage_.list_collections()) {
+        if (!is_user_collection(name)) continue;
+        if (is_unloaded(name)) {
+            ++usage.unloaded;
+            continue;
+        }
+        index::CollectionMemory memory = index_manager_.memory_usage(name);
+        usage.documents += memory.documents;
+        usage.indexes += memory.indexes;
+        usage.collections.emplace_back(std::move(name), memory);
+    }
+    return usage;
+}
+
+/**
+ * @brief Returns the slow-operation profiles recorded for a collection.
+ * @details The profiles are copied out of the ring of `slow_ops_` under its own lock, so no
+ * collection lock is taken.
+ * @param coll The collection, or empty for every collection.
+ * @return The profiles, most recent first.
+ */
+std::vector<query::OperationProfile> Core::profile(std::string_view coll) const {
+    return slow_ops_.snapshot(coll);
+}
+
 }  // namespace aevum::db
@@ -11,17 +11,44 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "aevum/bson/doc/document.hpp"
 #include "aevum/db/auth/auth_manager.hpp"
+#include "aevum/db/core/change_log.hpp"
+#include "aevum/db/core/core_options.hpp"
+#include "aevum/db/core/execution_stats.hpp"
+#include "aevum/db/core/index_image_writer.hpp"
+#include "aevum/db/core/memory_budget.hpp"
+#include "aevum/db/core/transaction.hpp"
+#include "aevum/db/core/ttl_sweeper.hpp"
 #include "aevum/db/index/index_manager.hpp"
+#include "aevum/db/query/cursor.hpp"
+#include "aevum/db/query/pipeline.hpp"
+#include "aevum/db/query/planner.hpp"
+#include "aevum/db/query/prepared_query.hpp"
+#include "aevum/db/query/profile.hpp"
 #include "aevum/db/schema/schema_manager.hpp"
+#include "aevum/db/storage/hot_backup.hpp"
 #include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/db/timeseries/time_series_store.hpp"
+#include "aevum/util/concurrency/named_registry.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
 #include "aevum/util/status.hpp"
+#include "aevum/util/uuid/id_format.hpp"
 
 /**
  * @namespace aevum::db
@@ -30,6 +57,17 @@
  */
 namespace aevum::db {
 
+/**
+ * @struct UpsertResult
+ * @brief The outcome of `Core::upsert`.
+ */
+struct UpsertResult {
+    /// The number of matching documents that were modified; 0 if the document was inserted.
+    int updated = 0;
+    /// The `_id` of the inserted document; empty if the matches were updated instead.
+    std::string inserted_id;
+};
+
 /**
  * @class Core
  * @brief The central, coordinating class for the AevumDB engine, providing the main public API.
@@ -40,10 +78,26 @@ namespace aevum::db {
  * all database operations (e.g., `insert`, `find`, `update`, `remove`), acting as a facade that
  * routes requests to the appropriate subsystem or to the Rust FFI query engine.
  *
- * Thread safety for all database-wide operations is ensured at this level via a
- * `std::shared_mutex`, allowing for concurrent read operations (`find`, `count`) while serializing
- * write operations
- * (`insert`, `update`, etc.) to maintain data consistency across all subsystems.
+ * Thread safety is ensured at this level by a `std::shared_mutex` per collection, allowing for
+ * concurrent read operations (`find`, `count`) on a collection while serializing its write
+ * operations (`insert`, `update`, etc.) to maintain data consistency across all subsystems.
+ * Operations on different collections never wait for each other.
+ *
+ * A collection listed in `CoreOptions::time_series_collections` is not indexed at all: its points
+ * are stored in compressed buckets by a `timeseries::TimeSeriesStore`, and queries, counts, and
+ * aggregations read back only the buckets their time range and series select. Points can only be
+ * inserted; updates and removals are refused with `NotSupported`.
+ *
+ * With `CoreOptions::memory_budget_mb`, a `MemoryBudget` evicts the least recently used user
+ * collections from the indexes once the estimated memory exceeds the limit. An evicted collection
+ * is served from storage like one deferred by `CoreOptions::lazy_load`, and loaded again by the
+ * first request that needs its indexes.
+ *
+ * With `CoreOptions::index_images`, a collection is loaded from its `index::IndexImage` when it
+ * has a valid one: the documents and index entries are read from the mapped image, and only the
+ * documents the change log records as changed since are read from storage. An
+ * `IndexImageWriter` images the collections written to again at a fixed interval, and the
+ * destructor does so once more.
  */
 class Core {
   public:
@@ -54,8 +108,9 @@ class Core {
      * indexing, and then calls `load_all()` to populate these managers with data from disk. If no
      * users are found, it also bootstraps a default 'root' administrator.
      * @param data_dir The filesystem path where the `WiredTigerStore` will persist its data files.
+     * @param options The engine configuration, including that of the `WiredTigerStore`.
      */
-    explicit Core(std::string data_dir);
+    explicit Core(std::string data_dir, CoreOptions options = {});
 
     /**
      * @brief Destroys the `Core` engine, ensuring a graceful shutdown.
@@ -78,30 +133,59 @@ class Core {
      * to storage, and finally updates all relevant indexes.
      * @param coll The name of the target collection.
      * @param doc The `aevum::bson::doc::Document` to insert. Ownership is taken by the function.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the write lock is released, so concurrent writers share the flush.
      * @return A `std::pair` where the first element is the `aevum::util::Status` of the operation
      * and the second is the `std::string` `_id` of the inserted document.
      */
-    std::pair<aevum::util::Status, std::string> insert(std::string_view coll,
-                                                       aevum::bson::doc::Document doc);
+    std::pair<aevum::util::Status, std::string> insert(
+        std::string_view coll, aevum::bson::doc::Document doc,
+        storage::Durability durability = storage::Durability::DEFAULT);
 
     /**
-     * @brief Updates an existing document or inserts it if it does not exist (an "upsert"
-     * operation).
-     * @details This function first performs a `count` to determine if any documents match the
-     * query. If one or more matches exist, it delegates to `update`. Otherwise, it delegates to
-     * `insert`.
+     * @brief Inserts a batch of documents into a collection.
+     * @details This is a write-locked operation with the semantics of `insert` applied to every
+     * document, but with one lock acquisition, one parallel schema validation pass, one storage
+     * transaction, and one index update for the whole batch. Documents that fail validation are
+     * reported individually and do not prevent the others from being inserted; if the storage
+     * transaction fails, none of the documents is inserted.
+     * @param coll The name of the target collection.
+     * @param docs The documents to insert. Ownership is taken by the function.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the write lock is released, so concurrent writers share the flush.
+     * @return One `std::pair` per input document, in input order, holding the
+     * `aevum::util::Status` of that document and, on success, its `_id`.
+     */
+    std::vector<std::pair<aevum::util::Status, std::string>> insert_many(
+        std::string_view coll, std::vector<aevum::bson::doc::Document> docs,
+        storage::Durability durability = storage::Durability::DEFAULT);
+
+    /**
+     * @brief Updates existing documents or inserts one if none exists (an "upsert" operation).
+     * @details This is a write-locked operation that looks the query up and writes in one
+     * critical section, so two concurrent upserts of the same document cannot both insert it.
+     * The query is resolved by the planner, through the primary or a secondary index when it
+     * can be; the matches are modified as by `update`, and without any, `doc` is inserted as by
+     * `insert`. An upsert by `_id` that inserts into an unloaded collection without secondary
+     * indexes does not load it.
      * @param coll The name of the collection.
-     * @param query_json A JSON string query to find the document to upsert.
-     * @param doc The document data to use for the update or insertion.
-     * @return An `aevum::util::Status` indicating the outcome of the operation.
+     * @param query_json A JSON string query to find the documents to update.
+     * @param doc The update to apply to the matches, or the document to insert.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the write lock is released, so concurrent writers share the flush.
+     * @return The `aevum::util::Status` of the operation and an `UpsertResult` telling how many
+     * documents were updated or which `_id` was inserted.
      */
-    aevum::util::Status upsert(std::string_view coll, std::string_view query_json,
-                               const aevum::bson::doc::Document &doc);
+    std::pair<aevum::util::Status, UpsertResult> upsert(
+        std::string_view coll, std::string_view query_json, const aevum::bson::doc::Document &doc,
+        storage::Durability durability = storage::Durability::DEFAULT);
 
     /**
      * @brief Counts the number of documents in a collection that match a query.
-     * @details This is a read-locked operation that delegates its logic to the Rust FFI for high
-     * performance.
+     * @details This is a read-locked operation. An empty query is answered from the size of the
+     * primary index, and a single exact predicate on an ordered index from the index alone.
+     * Otherwise the query planner narrows the candidate documents using the primary or secondary
+     * indexes, and the matches among them are counted without copying them.
      * @param coll The name of the collection.
      * @param query_json A JSON string defining the filter criteria.
      * @return The integer count of matching documents.
@@ -110,10 +194,12 @@ class Core {
 
     /**
      * @brief Finds and retrieves documents from a collection matching a complex query.
-     * @details This is a read-locked operation. It first checks for a simple `_id`-only query,
-     * which can be served with high performance by the primary index. For all other complex
-     * queries, it fetches the entire collection and delegates the filtering, sorting, projection,
-     * and pagination to the high-performance Rust FFI query engine.
+     * @details This is a read-locked operation. The query planner chooses between a primary
+     * lookup, a secondary index probe, and a full scan to obtain the candidate documents. A bare
+     * `_id` lookup is answered by the primary index alone; otherwise the candidates' raw BSON
+     * buffers are lent to the Rust FFI query engine, which filters, sorts, and paginates them in
+     * place and reports the positions of the results. Projection is then applied natively to the
+     * selected documents only.
      * @param coll The name of the collection.
      * @param query_json A JSON string for the filter conditions.
      * @param sort_json A JSON string for the sort order.
@@ -126,31 +212,272 @@ class Core {
         std::string_view coll, std::string_view query_json, std::string_view sort_json = "{}",
         std::string_view projection_json = "{}", int64_t limit = 0, int64_t skip = 0);
 
+    /**
+     * @brief Runs a query and returns its first batch, keeping a cursor for the rest.
+     * @details The query is planned as in `find`. If the result order is the order of the
+     * candidates, which holds for every unsorted query, only the candidates' `_id`s are gathered
+     * here, and the matcher runs incrementally on each batch. A sorted query is matched in full,
+     * since its order is only known once every match is, and the cursor keeps the `_id`s of the
+     * sorted results. Either way no document is copied until it is returned, and the collection's
+     * lock is held for one batch at a time rather than for the whole result set.
+     * @param coll The name of the collection.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order.
+     * @param projection_json A JSON string for field projection.
+     * @param limit The maximum number of documents to return over all batches (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @param batch_size The maximum number of documents in the first batch.
+     * @param owner The API key of the client; only it may continue or kill the cursor.
+     * @param cursor_id Receives the id to pass to `get_more`, or 0 if the batch is the last.
+     * @param batch Receives the first batch.
+     */
+    void open_cursor(std::string_view coll, std::string_view query_json,
+                     std::string_view sort_json, std::string_view projection_json, int64_t limit,
+                     int64_t skip, size_t batch_size, std::string_view owner, int64_t &cursor_id,
+                     std::vector<aevum::bson::doc::Document> &batch);
+
+    /**
+     * @brief Returns the next batch of a cursor opened by `open_cursor`.
+     * @details Documents removed since the cursor was opened are skipped, and documents updated
+     * in the meantime are returned in their current version. An exhausted cursor is discarded.
+     * @param cursor_id The id of the cursor; set to 0 if the batch is the last.
+     * @param owner The API key of the client.
+     * @param batch_size The maximum number of documents in the batch.
+     * @param batch Receives the batch.
+     * @return `NotFound` if no idle cursor with this id belongs to `owner`, e.g. because it timed
+     * out, was exhausted, or is being read by another request.
+     */
+    [[nodiscard]] aevum::util::Status get_more(int64_t &cursor_id, std::string_view owner,
+                                               size_t batch_size,
+                                               std::vector<aevum::bson::doc::Document> &batch);
+
+    /**
+     * @brief Discards a cursor before it is exhausted.
+     * @param cursor_id The id of the cursor.
+     * @param owner The API key of the client.
+     * @return `true` if the cursor existed and was discarded.
+     */
+    bool kill_cursor(int64_t cursor_id, std::string_view owner);
+
+    /**
+     * @brief Prepares a query template to be run repeatedly with different parameters.
+     * @details The template, sort, and projection are parsed, and the template is compiled for
+     * the native matcher, once. The template's constants may be placeholders of the form
+     * `{"$param": "<name>"}`, bound by `find` for each run.
+     * @param coll The name of the collection.
+     * @param query_json The query template.
+     * @param sort_json The sort order.
+     * @param projection_json The field projection.
+     * @param owner The API key of the client; only it may run or close the prepared query.
+     * @param prepared_id Receives the id to pass to `prepared_query` and `close_prepared`.
+     * @return `OK`; `InvalidArgument` for a malformed template, sort, or projection; or
+     *         `NotSupported` if `query::MAX_PREPARED_QUERIES` are already prepared.
+     */
+    [[nodiscard]] aevum::util::Status prepare(std::string_view coll, std::string_view query_json,
+                                              std::string_view sort_json,
+                                              std::string_view projection_json,
+                                              std::string_view owner, int64_t &prepared_id);
+
+    /**
+     * @brief Looks up a query prepared by `prepare`.
+     * @param prepared_id The id of the prepared query.
+     * @param owner The API key of the client.
+     * @return The prepared query, or null if none with this id belongs to `owner`.
+     */
+    [[nodiscard]] std::shared_ptr<const query::PreparedQuery> prepared_query(
+        int64_t prepared_id, std::string_view owner) const;
+
+    /**
+     * @brief Runs a prepared query with a set of parameters.
+     * @details The parameters are substituted into the parsed template and into the compiled
+     * matcher, and the bound query is planned and run as by `find`; neither is parsed again.
+     * @param prepared The prepared query.
+     * @param params A document holding the value of each parameter under its name.
+     * @param limit The maximum number of documents to return.
+     * @param skip The number of initial documents to skip.
+     * @param results Receives the matching documents.
+     * @return `OK`, or `InvalidArgument` if a parameter has no value.
+     */
+    [[nodiscard]] aevum::util::Status find(const query::PreparedQuery &prepared,
+                                           const aevum::bson::doc::Document &params,
+                                           int64_t limit, int64_t skip,
+                                           std::vector<aevum::bson::doc::Document> &results);
+
+    /**
+     * @brief Discards a prepared query.
+     * @param prepared_id The id of the prepared query.
+     * @param owner The API key of the client.
+     * @return `true` if the prepared query existed and was discarded.
+     */
+    bool close_prepared(int64_t prepared_id, std::string_view owner);
+
+    /**
+     * @brief Returns the write generation of a collection.
+     * @details The generation advances with every insert, update, and remove on the collection,
+     * so a result computed after reading generation `g` is current for as long as the generation
+     * is still `g`. Collections share generations through a small fixed table, so a write may
+     * also advance the generation of an unrelated collection; that only costs a cache miss.
+     * @param coll The name of the collection.
+     * @return The current generation.
+     */
+    [[nodiscard]] uint64_t write_generation(std::string_view coll) const noexcept;
+
+    /**
+     * @brief Returns the key format of a collection, which decides the type of its `_id`s.
+     * @details An integer-keyed collection admits only integer `_id`s, which callers report as
+     * numbers; the `_id` strings this class hands out are then their decimal form.
+     * @param coll The name of the collection.
+     * @return The key format of the collection's table.
+     */
+    [[nodiscard]] storage::KeyFormat key_format(std::string_view coll) {
+        return storage_.key_format(coll);
+    }
+
+    /**
+     * @brief Runs an aggregation pipeline over a collection.
+     * @details This is a read-locked operation. A leading `$match` stage is planned and matched
+     * like a `find` query, so it is served by the indexes; the raw BSON buffers of its matches
+     * are then lent to the Rust pipeline executor, which runs the remaining stages and
+     * serializes only their results.
+     * @param coll The name of the collection.
+     * @param pipeline_json A JSON array of pipeline stages.
+     * @param results Receives the JSON array of results.
+     * @return `InvalidArgument` if the pipeline is malformed or uses an unsupported stage.
+     */
+    [[nodiscard]] aevum::util::Status aggregate(std::string_view coll,
+                                                std::string_view pipeline_json,
+                                                std::string &results);
+
+    /**
+     * @brief Reports the access path the query planner chooses for a query.
+     * @details This is a read-locked operation that plans the query and gathers its candidate
+     * set, but does not run the matcher. It allows operators to verify that frequent queries are
+     * served by indexes created with `create_index`.
+     * @param coll The name of the collection.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order.
+     * @return A document of the form `{"collection", "plan", "index_fields", "covered",
+     * "sort_from_index", "candidates", "total_documents"}`.
+     */
+    [[nodiscard]] aevum::bson::doc::Document explain(std::string_view coll,
+                                                     std::string_view query_json,
+                                                     std::string_view sort_json = "{}");
+
     /**
      * @brief Updates all documents in a collection that match a query.
-     * @details This is a write-locked operation. It delegates the update logic to the Rust FFI,
-     * receives the entire modified collection back, and then atomically synchronizes this new
-     * dataset to the `WiredTigerStore`, subsequently rebuilding the collection's indexes.
+     * @details This is a write-locked operation. Matching documents are selected through the
+     * zero-copy FFI, and only that subset is handed to the Rust update engine, which reports the
+     * documents it modified. Each modified document is written to the `WiredTigerStore` and
+     * swapped into the indexes individually, so the cost is proportional to the number of
+     * modified documents rather than to the size of the collection.
      * @param coll The name of the collection.
      * @param query_json A JSON query to select documents to update.
      * @param update_json A JSON document describing the modifications.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the write lock is released, so concurrent writers share the flush.
      * @return A `std::pair` containing the operation `Status` and the integer count of affected
      * documents.
      */
-    std::pair<aevum::util::Status, int> update(std::string_view coll, std::string_view query_json,
-                                               std::string_view update_json);
+    std::pair<aevum::util::Status, int> update(
+        std::string_view coll, std::string_view query_json, std::string_view update_json,
+        storage::Durability durability = storage::Durability::DEFAULT);
 
     /**
      * @brief Removes documents from a collection matching a query.
-     * @details This is a write-locked operation. It first uses the `find` FFI to get the `_id`s of
-     * all matching documents. It then iterates through these IDs, removing each document from the
-     * `WiredTigerStore` and all associated indexes.
+     * @details This is a write-locked operation. It first uses the zero-copy find FFI to select
+     * all matching documents and collect their `_id`s. It then iterates through these IDs,
+     * removing each document from the `WiredTigerStore` and all associated indexes.
      * @param coll The name of the collection.
      * @param query_json A JSON query to select documents for removal.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the write lock is released, so concurrent writers share the flush.
      * @return A `std::pair` containing the operation `Status` and the integer count of removed
      * documents.
      */
-    std::pair<aevum::util::Status, int> remove(std::string_view coll, std::string_view query_json);
+    std::pair<aevum::util::Status, int> remove(
+        std::string_view coll, std::string_view query_json,
+        storage::Durability durability = storage::Durability::DEFAULT);
+
+    /**
+     * @brief Stages the insertion of a document in a transaction.
+     * @details The document receives an `_id` and is validated as by `insert`, then pinned and
+     * staged in the transaction; nothing is written until `commit`.
+     * @param txn The transaction.
+     * @param coll The name of the target collection.
+     * @param doc The document to insert.
+     * @return The status of the validation and the document's `_id`; `InvalidArgument` also if
+     *         the transaction is full (see `CoreOptions::transaction_max_writes`).
+     */
+    std::pair<aevum::util::Status, std::string> insert(Transaction &txn, std::string_view coll,
+                                                       aevum::bson::doc::Document doc);
+
+    /**
+     * @brief Finds the documents matching a query as a transaction sees them.
+     * @details The committed matches of documents the transaction has not touched are combined
+     * with the transaction's own versions of the documents it has, and the whole is filtered,
+     * sorted, paginated, and projected as by `find`. Every returned document is pinned, so
+     * reading it again in the transaction returns the same version; documents committed by
+     * others since the transaction began may still appear in a later read (see `Transaction`).
+     * @param txn The transaction.
+     * @param coll The name of the collection.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order.
+     * @param projection_json A JSON string for field projection.
+     * @param limit The maximum number of documents to return.
+     * @param skip The number of initial documents to skip.
+     * @return The matching documents, in result order.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> find(
+        Transaction &txn, std::string_view coll, std::string_view query_json,
+        std::string_view sort_json = "{}", std::string_view projection_json = "{}",
+        int64_t limit = 0, int64_t skip = 0);
+
+    /**
+     * @brief Stages an update of the documents matching a query in a transaction.
+     * @details The matches are found as by the transactional `find`, and the Rust update engine
+     * computes their new versions, which are staged. As with `update`, a document whose `_id`
+     * would change is left as it is.
+     * @param txn The transaction.
+     * @param coll The name of the collection.
+     * @param query_json A JSON query to select documents to update.
+     * @param update_json A JSON document describing the modifications.
+     * @return The status and the number of documents modified; `NotFound` if nothing matched,
+     *         or `InvalidArgument` if staging the new versions would overfill the transaction,
+     *         in which case none is staged.
+     */
+    std::pair<aevum::util::Status, int> update(Transaction &txn, std::string_view coll,
+                                               std::string_view query_json,
+                                               std::string_view update_json);
+
+    /**
+     * @brief Stages the removal of the documents matching a query in a transaction.
+     * @param txn The transaction.
+     * @param coll The name of the collection.
+     * @param query_json A JSON query to select documents for removal.
+     * @return The status and the number of documents removed; `NotFound` if nothing matched,
+     *         or `InvalidArgument` if the removals would overfill the transaction, in which case
+     *         none is staged.
+     */
+    std::pair<aevum::util::Status, int> remove(Transaction &txn, std::string_view coll,
+                                               std::string_view query_json);
+
+    /**
+     * @brief Commits the writes of a transaction atomically.
+     * @details The written collections are locked exclusively in name order, and the base of
+     * every written document is compared with its committed version. If any differs, a
+     * concurrent write committed first and nothing is written. Otherwise every staged write of
+     * every collection is persisted in one `WiredTigerStore::apply_batches` transaction, together
+     * with its index entries and change log records, and only then applied to the in-memory
+     * indexes, so no reader sees part of the transaction. The transaction is cleared either way.
+     * @param txn The transaction.
+     * @param durability How far the write is persisted before the call returns. The journal is
+     * flushed after the locks are released.
+     * @return `aevum::util::Status::OK()` once committed, `Conflict` if a written document was
+     *         changed since the transaction pinned it, in which case the transaction may be
+     *         retried, or the status of a failed storage write.
+     */
+    [[nodiscard]] aevum::util::Status commit(
+        Transaction &txn, storage::Durability durability = storage::Durability::DEFAULT);
 
     /**
      * @brief Sets or updates the schema for a collection.
@@ -162,11 +489,30 @@ class Core {
 
     /**
      * @brief Creates a new secondary index on a field.
+     * @details This is a write-locked operation, since building the index replaces the entries
+     * that concurrent readers may be traversing. A `HASH` index answers equality predicates; an
+     * `ORDERED` index additionally answers `$gt`, `$gte`, `$lt`, and `$lte`, and supplies the
+     * result order of a sort on its field.
+     *
+     * A TTL index is an `ORDERED` index given `expire_after_seconds`: a document whose field
+     * holds a number of seconds since the Unix epoch is deleted by the TTL sweeper once that
+     * time plus `expire_after_seconds` has passed. For an array, the smallest element counts.
+     *
+     * A sparse index holds only the documents that have its field, and a partial index only
+     * those matching its `partial_filter`; the planner uses either only for a query whose
+     * matches it is known to hold.
      * @param coll The name of the collection.
      * @param field The field on which to create the index.
+     * @param type The physical organization of the index.
+     * @param expire_after_seconds The time-to-live of a TTL index, or `std::nullopt` for an
+     *        index that expires nothing.
+     * @param options Makes the index sparse or partial.
      * @return A `aevum::util::Status` indicating the outcome.
      */
-    aevum::util::Status create_index(std::string_view coll, std::string_view field);
+    aevum::util::Status create_index(std::string_view coll, std::string_view field,
+                                     index::IndexType type = index::IndexType::HASH,
+                                     std::optional<int64_t> expire_after_seconds = std::nullopt,
+                                     const index::IndexOptions &options = {});
 
     /**
      * @brief Creates a new user and persists their credentials.
@@ -183,6 +529,143 @@ class Core {
      */
     [[nodiscard]] auth::UserRole authenticate(std::string_view raw_key) const;
 
+    /**
+     * @brief Verifies a user's raw API key with the key derivation function, for `login`.
+     * @details This is deliberately slow, and is meant to be run once per session rather than
+     * once per request.
+     * @param raw_key The plain-text API key.
+     * @return The authenticated `UserRole`, or `UserRole::NONE` on failure.
+     */
+    [[nodiscard]] auth::UserRole login(std::string_view raw_key) const;
+
+    /**
+     * @brief Returns how queries have been executed so far: the plans chosen, and the time spent
+     * in the Rust FFI and in the storage engine.
+     * @return The snapshot of the counters.
+     */
+    [[nodiscard]] ExecutionStats execution_stats() const noexcept;
+
+    /**
+     * @brief Reports the progress of the index builds in flight.
+     * @return One entry per build started by `create_index` and not yet published.
+     */
+    [[nodiscard]] std::vector<index::IndexBuildProgress> index_builds() const;
+
+    /**
+     * @brief Returns the counters of the TTL sweeper.
+     * @return The snapshot of the counters, all zero if the sweeper is disabled.
+     */
+    [[nodiscard]] TtlStats ttl_stats() const noexcept;
+
+    /**
+     * @brief Reads the changes that follow a resume token, waiting for one if there is none yet.
+     * @details The changes are those recorded by `insert`, `update`, and `remove` in the change
+     * log (see `ChangeLog`). If none follows `after`, the call waits up to `max_wait` for one to
+     * be committed, so that a consumer tails the log with one request per batch of changes.
+     * @param after The resume token: the sequence number of the last change already seen, or 0.
+     * @param coll Only the changes of this collection, or empty for all.
+     * @param limit The most changes returned.
+     * @param max_wait The longest wait for a change, or 0 to return at once.
+     * @param changes Receives the changes, oldest first.
+     * @param resume_token Receives the token to pass on the next call.
+     * @return `aevum::util::Status::OK()` on success, even if the wait timed out with no change,
+     *         `NotSupported` if the change log is disabled, or `NotFound` if the changes following
+     *         `after` have already been trimmed.
+     */
+    [[nodiscard]] aevum::util::Status watch(uint64_t after, std::string_view coll, size_t limit,
+                                            std::chrono::milliseconds max_wait,
+                                            std::vector<Change> &changes,
+                                            uint64_t &resume_token);
+
+    /**
+     * @brief Returns the state of the change log.
+     * @return The snapshot.
+     */
+    [[nodiscard]] ChangeLogStats change_log_stats() const noexcept;
+
+    /**
+     * @brief Returns the counters of the index images.
+     * @return The snapshot of the counters, all zero if images are disabled.
+     */
+    [[nodiscard]] IndexImageStats index_image_stats() const noexcept;
+
+    /**
+     * @brief Applies a batch of documents replicated from a primary to a collection.
+     * @details The documents are the primary's current versions and overwrite any local version
+     * with the same `_id`; `deleted_ids` are removed. Both are written in one transaction under
+     * the collection's exclusive lock, without schema validation, which the primary already did,
+     * and recorded in the local change log.
+     * @param coll The name of the collection.
+     * @param docs The documents to store, each with a string `_id`.
+     * @param deleted_ids The `_id`s to remove, disjoint from those of `docs`.
+     * @return `aevum::util::Status::OK()` once the batch is committed and durable, or the status
+     *         of the failed write.
+     */
+    [[nodiscard]] aevum::util::Status apply_replicated(
+        std::string_view coll, std::vector<aevum::bson::doc::Document> docs,
+        const std::vector<std::string> &deleted_ids);
+
+    /**
+     * @brief Reads the position of this replica in its primary's change log.
+     * @return The last resume token stored by `store_replication_token`, or 0 if there is none.
+     */
+    [[nodiscard]] uint64_t replication_token();
+
+    /**
+     * @brief Stores the position of this replica in its primary's change log.
+     * @param token The resume token of the last applied batch.
+     * @return The status of the write.
+     */
+    [[nodiscard]] aevum::util::Status store_replication_token(uint64_t token);
+
+    /**
+     * @brief Starts an online backup of the data directory in the background.
+     * @details Writes continue while the files are copied (see `storage::HotBackup`).
+     * @param destination The directory to write to: missing or empty for a full backup, or
+     *        holding a complete backup for an incremental one.
+     * @param incremental `true` to copy only the blocks modified since the destination's backup.
+     * @return `aevum::util::Status::OK()` once the backup is running, or why it cannot start.
+     */
+    [[nodiscard]] aevum::util::Status start_backup(const std::string &destination,
+                                                   bool incremental);
+
+    /**
+     * @brief Returns the progress of the current or last backup.
+     * @return The snapshot.
+     */
+    [[nodiscard]] storage::BackupStatus backup_status() const { return backup_.status(); }
+
+    /**
+     * @brief Reads a selection of the storage engine's own statistics.
+     * @return Pairs of statistic description and value (see `WiredTigerStore::engine_statistics`).
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, int64_t>> engine_statistics();
+
+    /**
+     * @brief Estimates the memory held by the documents and indexes of the resident collections.
+     * @return The estimates, with the counters of the memory budget.
+     */
+    [[nodiscard]] MemoryUsage memory_usage();
+
+    /**
+     * @brief Returns the memory budget, e.g. to register another layer with it.
+     * @return The budget, which lives as long as the engine.
+     */
+    [[nodiscard]] MemoryBudget &memory_budget() noexcept { return *memory_budget_; }
+
+    /**
+     * @brief Returns the profiles of the slowest recent operations.
+     * @param coll Only the operations on this collection, or empty for all.
+     * @return The profiles, most recent first.
+     */
+    [[nodiscard]] std::vector<query::OperationProfile> profile(std::string_view coll = {}) const;
+
+    /**
+     * @brief Returns the log of slow operations, e.g. to change its threshold.
+     * @return The log.
+     */
+    [[nodiscard]] query::SlowOperationLog &slow_operation_log() noexcept { return slow_ops_; }
+
   private:
     /// Manages the physical storage layer via WiredTiger.
     storage::WiredTigerStore storage_;
@@ -192,30 +675,607 @@ class Core {
     schema::SchemaManager schema_manager_;
     /// Orchestrates primary and secondary document indexing.
     index::IndexManager index_manager_;
+    /// The log of the changes made by `insert`, `update`, and `remove`.
+    ChangeLog change_log_;
+    /// The buckets of the time-series collections of `CoreOptions::time_series_collections`.
+    timeseries::TimeSeriesStore time_series_;
+
+    /**
+     * @struct CollectionState
+     * @brief The state the engine keeps for each collection besides its indexes.
+     */
+    struct CollectionState {
+        /// Held shared by queries and exclusively by writes, so a slow write stalls only its own
+        /// collection.
+        std::shared_mutex lock;
+        /// The steady time, in milliseconds, at which the lock was last looked up; the recency by
+        /// which `evict_collections` picks collections.
+        std::atomic<int64_t> last_used{0};
+    };
+
+    /**
+     * @var collection_states_
+     * @brief The state of each collection, by name. The registry is read without locking, so
+     * looking a lock up never contends.
+     */
+    mutable aevum::util::concurrency::NamedRegistry<CollectionState> collection_states_;
+    /**
+     * @var absent_lock_
+     * @brief Held shared by reads of collections that do not exist, in place of a lock of their
+     * own, so that reading a name does not register it in `collection_states_`, which never
+     * shrinks. `collection_lock` takes it exclusively once when it registers a name, so such
+     * reads end before the new collection is first written.
+     */
+    mutable std::shared_mutex absent_lock_;
+
+    /// `true` if user collections can be in storage only, because they are loaded on first use
+    /// rather than at startup or because the memory budget may evict them.
+    bool may_unload_;
+    /// The user collections that exist in storage but are not in the indexes. Guarded by
+    /// `unloaded_mutex_`; a collection enters or leaves the set only under its exclusive lock.
+    std::unordered_set<std::string> unloaded_;
+    /// The collections of `unloaded_` that were evicted by the memory budget rather than never
+    /// loaded. Guarded by `unloaded_mutex_`.
+    std::unordered_set<std::string> evicted_;
+    /// The number of callers that need each collection to stay resident until they take its
+    /// lock, by name; the memory budget does not evict a pinned collection. Guarded by
+    /// `unloaded_mutex_`.
+    std::unordered_map<std::string, size_t> pins_;
+    /// Guards `unloaded_`, `evicted_`, and `pins_`.
+    mutable std::mutex unloaded_mutex_;
+    /// The number of collections the memory budget has evicted.
+    std::atomic<uint64_t> evictions_{0};
+    /// The number of threads that load user collections at startup, or 0 for one per hardware
+    /// thread.
+    size_t load_threads_;
+    /// The workers that join a query's thread in matching a large batch of candidates natively,
+    /// or `nullptr` if scans run on the query's thread alone.
+    std::unique_ptr<aevum::util::concurrency::ThreadPool> scan_pool_;
+    /// The open cursors of `open_cursor`.
+    query::CursorManager cursors_;
+    /// The queries of `prepare`.
+    query::PreparedQueryManager prepared_;
+    /// The number of slots in `write_generations_`.
+    static constexpr size_t WRITE_GENERATION_SLOTS = 64;
+    /// The write generations of the collections, by hash of the collection name. Advanced under
+    /// the write lock and read without it.
+    std::array<std::atomic<uint64_t>, WRITE_GENERATION_SLOTS> write_generations_{};
+    /// The counters of `execution_stats`, advanced by queries that otherwise change nothing.
+    mutable ExecutionCounters counters_;
+    /// The profiles of the operations that exceeded `CoreOptions::slow_op_threshold_ms`.
+    query::SlowOperationLog slow_ops_;
+    /// The most documents one TTL delete batch removes.
+    size_t ttl_batch_size_;
+    /// The wait between two TTL delete batches.
+    std::chrono::milliseconds ttl_batch_pause_;
+    /// The generator of missing `_id`s in collections without an override.
+    aevum::util::uuid::IdFormat id_format_;
+    /// The generators of missing `_id`s that differ from `id_format_`, by collection.
+    std::unordered_map<std::string, aevum::util::uuid::IdFormat> collection_id_formats_;
+    /// The most documents one transaction may write, from `CoreOptions::transaction_max_writes`.
+    size_t transaction_max_writes_;
+    /// The most bytes of versions one transaction may stage.
+    size_t transaction_max_bytes_;
+    /// The online backup of the data directory; its thread is joined before the store closes.
+    storage::HotBackup backup_;
+    /// The memory budget of `CoreOptions::memory_budget_mb`; the collections register with it, and
+    /// the server its result cache. Stopped first on destruction.
+    std::unique_ptr<MemoryBudget> memory_budget_;
+    /// `true` if collections are loaded from and imaged to index images.
+    bool index_images_ = false;
+    /// The write generation of each collection when its image was last written or loaded
+    /// unchanged, by name. Guarded by `image_mutex_`.
+    std::unordered_map<std::string, uint64_t> image_generations_;
+    /// Guards `image_generations_`.
+    std::mutex image_mutex_;
+    /// The collections loaded from their image, and the images discarded.
+    std::atomic<uint64_t> images_loaded_{0};
+    std::atomic<uint64_t> images_rejected_{0};
+    /// The thread writing index images, or `nullptr` if they are disabled or only written at
+    /// shutdown.
+    std::unique_ptr<IndexImageWriter> image_writer_;
+    /// The thread deleting expired documents, or `nullptr` if TTL sweeping is disabled. Declared
+    /// last, so that it is stopped before anything it uses is destroyed.
+    std::unique_ptr<TtlSweeper> ttl_sweeper_;
 
     /**
-     * @var rw_lock_
-     * @brief A top-level reader-writer mutex that provides thread-safe access to the entire
-     * database state, synchronizing all public API operations.
+     * @brief Advances the write generation of a collection. The caller holds the collection's lock
+     * for writing, so no reader can observe the write before it observes the new generation.
+     * @param coll The name of the collection.
+     */
+    void bump_write_generation(std::string_view coll) noexcept;
+
+    /**
+     * @brief Returns the generator of the missing `_id`s of a collection.
+     * @param coll The name of the collection.
+     * @return The collection's override, or the default format.
      */
-    mutable std::shared_mutex rw_lock_;
+    [[nodiscard]] aevum::util::uuid::IdFormat id_format(std::string_view coll) const;
 
     /**
      * @brief A private helper called during construction to load all persisted data.
      * @details This function loads all collections, schemas, indexes, and user authentication
      * data from the `WiredTigerStore` into the respective in-memory manager components.
+     * @param lazy_load `true` to defer loading the user collections until first use.
+     */
+    void load_all(bool lazy_load);
+
+    /**
+     * @brief Loads `_indexes`, `_schemas`, or `_auth` into the manager that owns it.
+     * @param name The name of the system collection.
+     */
+    void load_system_collection(const std::string &name);
+
+    /**
+     * @brief Loads user collections into the indexes on a pool of worker threads.
+     * @details Large collections are read as several key ranges concurrently. Must only be called
+     * before the engine serves requests.
+     * @param names The names of the collections to load.
+     */
+    void load_user_collections(std::vector<std::string> names);
+
+    /**
+     * @brief Loads a user collection from its index image, if it has a usable one.
+     * @details An image that fails validation, or whose sequence number is ahead of the change
+     * log or behind its oldest retained record, is deleted. The caller must exclude writers to
+     * the collection.
+     * @param name The name of the collection.
+     * @return `true` if the collection was loaded; `false` if it must be loaded from storage.
+     */
+    bool load_collection_image(const std::string &name);
+
+    /**
+     * @brief Writes the image of every resident user collection written to since its last
+     * image; the pass of the image writer, also run at shutdown.
+     * @details Each collection is captured under its shared lock, together with the change log's
+     * last visible sequence number. Storage is then synchronized, so that the changes up to that
+     * number survive a crash, and the image is written outside the lock.
+     * @param writer The writer running the pass, or `nullptr` at shutdown.
+     */
+    void write_index_images(IndexImageWriter *writer);
+
+    /**
+     * @brief Inserts a document; the body of `insert`, which holds the collection's exclusive lock
+     * and has made the collection resident if it has secondary indexes.
+     * @details The write is not flushed to the journal; the caller does so after releasing the
+     * lock.
+     * @param coll The name of the target collection.
+     * @param doc The document to insert.
+     * @return The status of the insertion and the document's `_id`.
+     */
+    std::pair<aevum::util::Status, std::string> insert_locked(std::string_view coll,
+                                                              aevum::bson::doc::Document doc);
+
+    /**
+     * @brief Applies an update to documents already known to match; the body of `update`, which
+     * holds the collection's exclusive lock on a resident collection.
+     * @details The write is not flushed to the journal; the caller does so after releasing the
+     * lock.
+     * @param coll The name of the collection.
+     * @param matches The matching documents, borrowed from the primary index; not empty.
+     * @param query_json The filter conditions the documents matched.
+     * @param update_json The update to apply.
+     * @return The status and the number of documents modified.
+     */
+    std::pair<aevum::util::Status, int> update_locked(
+        std::string_view coll, const std::vector<const aevum::bson::doc::Document *> &matches,
+        std::string_view query_json, std::string_view update_json);
+
+    /**
+     * @brief Computes the post-update images of matched documents with the Rust update engine.
+     * @details The images are validated against the collection's schema by the engine; an image
+     * that would change its document's `_id` is left out.
+     * @param coll The name of the collection.
+     * @param matches The matching documents; not empty.
+     * @param query_json The filter conditions the documents matched.
+     * @param update_json The update to apply.
+     * @return The status and, for every modified document, its position in `matches` and its new
+     *         image.
+     */
+    std::pair<aevum::util::Status, std::vector<std::pair<size_t, aevum::bson::doc::Document>>>
+    update_images(std::string_view coll,
+                  const std::vector<const aevum::bson::doc::Document *> &matches,
+                  std::string_view query_json, std::string_view update_json);
+
+    /**
+     * @brief Finds the documents matching a query as a transaction sees them; the body of the
+     * transactional `find`.
+     * @param txn The transaction, which pins every returned document.
+     * @param coll The name of the collection.
+     * @param query_json The filter conditions.
+     * @param sort_json The sort order.
+     * @param limit The maximum number of results (0 for no limit).
+     * @param skip The number of matches to skip.
+     * @return The transaction's versions of the matches, owned by the transaction.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> find_in_transaction(
+        Transaction &txn, std::string_view coll, std::string_view query_json,
+        std::string_view sort_json, int64_t limit, int64_t skip);
+
+    /**
+     * @brief Checks that a transaction may stage more writes within its limits.
+     * @param txn The transaction.
+     * @param new_writes The documents about to be written that the transaction has not written
+     *        yet.
+     * @param new_bytes The size of the versions about to be staged.
+     * @return `aevum::util::Status::OK()`, or `InvalidArgument` if the writes would exceed
+     *         `CoreOptions::transaction_max_writes` or `CoreOptions::transaction_max_bytes`.
+     */
+    [[nodiscard]] aevum::util::Status transaction_room(const Transaction &txn, size_t new_writes,
+                                                       size_t new_bytes) const;
+
+    /**
+     * @brief Deletes documents by `_id`; the body of `remove`, which holds the collection's
+     * exclusive lock on a resident collection.
+     * @details Only the `_id`s still in the primary index are deleted, from storage in one
+     * `apply_batch` transaction and then from the indexes as one batch. The write is not flushed
+     * to the journal; the caller does so after releasing the lock.
+     * @param coll The name of the collection.
+     * @param ids The `_id`s to delete.
+     * @return The status and the number of documents deleted.
+     */
+    std::pair<aevum::util::Status, int> remove_ids_locked(std::string_view coll,
+                                                          std::vector<std::string> ids);
+
+    /**
+     * @brief Deletes the expired documents of every TTL index; the pass of the TTL sweeper.
+     * @details The expired documents are the entries of the TTL index's ordered index from the
+     * smallest number up to the current time minus the index's time-to-live. They are deleted
+     * in batches of at most `ttl_batch_size_`, each looked up and deleted under one acquisition
+     * of the collection's exclusive lock and followed by a pause of `ttl_batch_pause_`, so a
+     * document updated meanwhile is judged by its new value and foreground writers wait for one
+     * small batch at most. A collection that was never loaded is loaded first; one the memory
+     * budget evicted is skipped until a request loads it again.
+     * @param sweeper The sweeper running the pass.
+     */
+    void sweep_expired(TtlSweeper &sweeper);
+
+    /**
+     * @brief Loads a collection into the primary and secondary indexes if it is unloaded.
+     * @details Acquires the collection's lock exclusively while loading, so the caller must not
+     * hold it. The memory budget may evict the collection again as soon as the lock is released;
+     * callers that need it resident under their own lock use `lock_resident` or
+     * `load_resident_locked`.
+     * @param coll The name of the collection.
+     */
+    void ensure_resident(std::string_view coll);
+
+    /**
+     * @brief Loads a collection into the indexes if it is unloaded, under its exclusive lock.
+     * @param coll The name of the collection, whose lock the caller holds exclusively.
+     */
+    void load_resident_locked(std::string_view coll);
+
+    /**
+     * @brief Takes the shared lock of a collection, loading the collection first if it is
+     * unloaded.
+     * @param coll The name of the collection.
+     * @return The shared lock, under which the collection is resident.
+     */
+    [[nodiscard]] std::shared_lock<std::shared_mutex> lock_resident(std::string_view coll);
+
+    /**
+     * @brief Releases the shared lock of a collection, loads the collection, and takes the lock
+     * again, under which the collection is then resident.
+     * @param coll The name of the collection.
+     * @param lock The caller's shared lock of the collection.
+     */
+    void relock_resident(std::string_view coll, std::shared_lock<std::shared_mutex> &lock);
+
+    /**
+     * @brief Keeps the memory budget from evicting a collection until `unpin_resident`.
+     * @param coll The name of the collection.
+     */
+    void pin_resident(std::string_view coll);
+
+    /**
+     * @brief Releases a pin of `pin_resident`.
+     * @param coll The name of the collection.
+     */
+    void unpin_resident(std::string_view coll);
+
+    /**
+     * @brief Evicts the least recently used user collections from the indexes; the reclaimer the
+     * collections register with the memory budget.
+     * @param bytes The bytes to free.
+     * @return The estimated bytes freed.
+     */
+    size_t evict_collections(size_t bytes);
+
+    /**
+     * @brief Returns the reader-writer lock of a collection.
+     * @details This registers the collection, for good; read paths use `read_lock`, so that only
+     * writes and index creation register new names.
+     * @param coll The name of the collection.
+     * @return The lock, created on first use.
+     */
+    [[nodiscard]] std::shared_mutex &collection_lock(std::string_view coll) const;
+
+    /**
+     * @brief Takes the shared lock of a collection for a read, without registering a collection
+     * that does not exist.
+     * @details A collection exists once it is registered by a write or listed in the storage
+     * catalog. The read of a collection that does not exist runs under `absent_lock_` and sees
+     * it empty.
+     * @param coll The name of the collection.
+     * @return The shared lock.
+     */
+    [[nodiscard]] std::shared_lock<std::shared_mutex> read_lock(std::string_view coll);
+
+    /**
+     * @brief Checks whether a collection has been registered by a write or is in storage.
+     * @param coll The name of the collection.
+     * @return `true` if the collection exists.
+     */
+    [[nodiscard]] bool collection_exists(std::string_view coll);
+
+    /**
+     * @brief Checks whether a collection is unloaded. The answer only changes under the
+     * collection's exclusive lock, so it holds for as long as the caller holds the lock.
+     * @param coll The name of the collection.
+     * @return `true` if the collection's documents are only in storage.
+     */
+    [[nodiscard]] bool is_unloaded(std::string_view coll) const;
+
+    /**
+     * @brief Runs a query against an unloaded collection directly in storage.
+     * @details Only plans accepted by `can_serve_from_storage` are supported: a primary lookup
+     * becomes a WiredTiger point read, and an unsorted full scan streams the table in batches,
+     * each lent to `rust_find_bson` until `skip + limit` matches are collected.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan`.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order (only applied to a primary lookup).
+     * @param limit The maximum number of documents to return (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @return The matching documents, owned by the caller, in result order.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> find_in_storage(
+        std::string_view coll, const query::QueryPlan &plan, std::string_view query_json,
+        std::string_view sort_json, int64_t limit, int64_t skip);
+
+    /**
+     * @brief Counts the matches of a query, taking the collection's lock; the body of `count`,
+     * which profiles it.
+     * @param coll The name of the collection to query.
+     * @param query_json A JSON string for the filter conditions.
+     * @return The number of matching documents.
+     */
+    [[nodiscard]] int count_matching(std::string_view coll, std::string_view query_json);
+
+    /**
+     * @brief Inserts points into a time-series collection; the time-series counterpart of
+     * `insert_many`.
+     * @param coll The name of a time-series collection.
+     * @param docs The points.
+     * @param durability How far the points are persisted before returning.
+     * @return One pair per point, in input order, holding its status and the key of its bucket.
+     */
+    [[nodiscard]] std::vector<std::pair<aevum::util::Status, std::string>> insert_points(
+        std::string_view coll, std::vector<aevum::bson::doc::Document> docs,
+        storage::Durability durability);
+
+    /**
+     * @brief Plans a query on a time-series collection.
+     * @details The plan is a `BUCKET_SCAN` with the query's native matcher, if it has one; the
+     * buckets to read are chosen by the filter extracted from the query's time and series
+     * predicates.
+     * @param coll The name of a time-series collection.
+     * @param query_json A JSON string for the filter conditions.
+     * @param plan Receives the plan.
+     * @param filter Receives the bucket filter of the query.
+     * @return `OK`, or `InvalidArgument` if the query is not a JSON object.
+     */
+    [[nodiscard]] aevum::util::Status plan_time_series(std::string_view coll,
+                                                       std::string_view query_json,
+                                                       query::QueryPlan &plan,
+                                                       timeseries::BucketFilter &filter);
+
+    /**
+     * @brief Builds the points of a time-series collection that pass a bucket filter.
+     * @param coll The name of a time-series collection.
+     * @param filter The bucket filter of the query.
+     * @param points Receives the points, in key order of their buckets.
+     * @param stats Receives what the scan read, if not null.
+     * @return `OK`, or the status of the failed scan.
+     */
+    [[nodiscard]] aevum::util::Status read_points(std::string_view coll,
+                                                  const timeseries::BucketFilter &filter,
+                                                  std::vector<aevum::bson::doc::Document> &points,
+                                                  timeseries::BucketScanStats *stats = nullptr);
+
+    /**
+     * @brief Finds the points of a time-series collection matching a query; the time-series
+     * counterpart of `find_planned`.
+     * @param coll The name of a time-series collection.
+     * @param query_json The filter conditions.
+     * @param sort_json The sort order.
+     * @param projection The parsed projection.
+     * @param limit The maximum number of points to return (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @return The matching points, projected.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> find_time_series(
+        std::string_view coll, std::string_view query_json, std::string_view sort_json,
+        const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip);
+
+    /**
+     * @brief Counts the points of a time-series collection matching a query.
+     * @param coll The name of a time-series collection.
+     * @param query_json The filter conditions.
+     * @return The number of matching points.
+     */
+    [[nodiscard]] int count_time_series(std::string_view coll, std::string_view query_json);
+
+    /**
+     * @brief Runs an aggregation pipeline on a time-series collection.
+     * @details See `aggregate`.
+     * @param coll The name of a time-series collection.
+     * @param pipeline The pipeline, split at its leading `$match`.
+     * @param results Receives the results, as a JSON array.
+     * @return `OK` or `InvalidArgument`.
+     */
+    [[nodiscard]] aevum::util::Status aggregate_time_series(std::string_view coll,
+                                                            const query::SplitPipeline &pipeline,
+                                                            std::string &results);
+
+    /**
+     * @brief Describes the bucket scan of a query on a time-series collection; see `explain`.
+     * @param coll The name of a time-series collection.
+     * @param query_json The filter conditions.
+     * @return A BSON document describing the plan.
+     */
+    [[nodiscard]] aevum::bson::doc::Document explain_time_series(std::string_view coll,
+                                                                 std::string_view query_json);
+
+    /**
+     * @brief Counts the matches of a query in an unloaded collection directly in storage.
+     * @details The storage counterpart of `count`, with the same plan restrictions as
+     * `find_in_storage`.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan`.
+     * @param query_json A JSON string for the filter conditions.
+     * @return The number of matching documents.
+     */
+    [[nodiscard]] int count_in_storage(std::string_view coll, const query::QueryPlan &plan,
+                                       std::string_view query_json);
+
+    /**
+     * @brief Reads documents of an unloaded collection by `_id` directly from storage.
+     * @param coll The name of the collection.
+     * @param ids The `_id`s to read.
+     * @return The documents found, in the order of `ids`; missing `_id`s are skipped.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> read_by_ids(
+        std::string_view coll, const std::vector<std::string> &ids);
+
+    /**
+     * @brief Parses a JSON query and runs it through the query planner.
+     * @param coll The name of the collection to query.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order.
+     * @return The chosen plan. A query that fails to parse is planned as a full scan, leaving its
+     * interpretation to the Rust engine. A sort that fails to parse is left to the matcher.
+     */
+    [[nodiscard]] query::QueryPlan make_plan(std::string_view coll, std::string_view query_json,
+                                             std::string_view sort_json);
+
+    /**
+     * @brief Runs a parsed query through the query planner.
+     * @details The caller accounts for the time spent, since it includes its own parsing.
+     * @param coll The name of the collection to query.
+     * @param query The parsed query.
+     * @param sort The parsed sort order.
+     * @param matcher The query compiled for the native matcher, or empty.
+     * @return The chosen plan, carrying `matcher`.
+     */
+    [[nodiscard]] query::QueryPlan make_plan(std::string_view coll,
+                                             const aevum::bson::doc::Document &query,
+                                             const aevum::bson::doc::Document &sort,
+                                             std::optional<aevum::bson::doc::Matcher> matcher);
+
+    /**
+     * @brief Runs a planned query on a collection whose lock the caller holds shared.
+     * @details This is the body of `find`, shared with the prepared `find`. The lock is released
+     * and taken again if an unloaded collection must be loaded, after which the query is planned
+     * again, since its indexes have only then been loaded.
+     * @param coll The name of the collection.
+     * @param plan Plans the query.
+     * @param query_json The query, for the Rust engine and the storage scan.
+     * @param sort_json The sort order.
+     * @param projection The parsed projection.
+     * @param limit The maximum number of documents to return.
+     * @param skip The number of initial documents to skip.
+     * @param lock The shared lock of the collection.
+     * @return The matching documents, projected.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> find_planned(
+        std::string_view coll, const std::function<query::QueryPlan()> &plan,
+        std::string_view query_json, std::string_view sort_json,
+        const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip,
+        std::shared_lock<std::shared_mutex> &lock);
+
+    /**
+     * @brief Resolves a query plan to the set of candidate documents it designates.
+     * @details A primary lookup yields at most one document. An index probe intersects the `_id`
+     * postings of its predicates, starting from the shortest, and resolves the survivors through
+     * the primary index. A text search yields the documents its text indexes rank, best first.
+     * An index scan or a full scan yields the whole collection. The caller must hold the
+     * collection's lock for as long as it dereferences the result.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan`.
+     * @param wanted For a text search, the number of best documents to yield, or 0 for all.
+     * @return Non-owning pointers into the primary index.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> collect_candidates(
+        std::string_view coll, const query::QueryPlan &plan, size_t wanted = 0) const;
+
+    /**
+     * @brief Runs a query through the zero-copy Rust FFI and returns the matching documents as
+     * borrowed pointers into the primary index.
+     * @details Only the BSON buffers of the candidate documents of the plan are lent to
+     * `rust_find_bson`, which reports back the positions of the results. No document is
+     * serialized or copied. The caller must hold the collection's lock (shared or exclusive) for
+     * as long as it dereferences the result.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan` for the query and sort.
+     * @param query_json A JSON string for the filter conditions.
+     * @param sort_json A JSON string for the sort order.
+     * @param limit The maximum number of documents to return (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @return Non-owning pointers to the matching documents, in result order.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> find_matching_refs(
+        std::string_view coll, const query::QueryPlan &plan, std::string_view query_json,
+        std::string_view sort_json, int64_t limit, int64_t skip) const;
+
+    /**
+     * @brief Answers a query from the entries of its ordered index, without reading a document.
+     * @details Only valid for a plan accepted by `query::index_covers_projection`, whose sort is
+     * absent or supplied by the same index. Each result is built from an entry's key and `_id`.
+     * The caller must hold the collection's lock.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan`.
+     * @param projection The parsed projection.
+     * @param limit The maximum number of documents to return (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @param integer_keys `true` if the collection is integer-keyed, so that each `_id` is
+     *        returned as an Int64 rather than as the decimal string of its key.
+     * @return The projected results, in result order.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> find_from_index(
+        std::string_view coll, const query::QueryPlan &plan,
+        const aevum::bson::doc::Document &projection, int64_t limit, int64_t skip,
+        bool integer_keys) const;
+
+    /**
+     * @brief Runs a query whose sort order is supplied by an ordered index.
+     * @details The candidates are produced in index order (by a scan of the index, or by ordering
+     * the candidates of an index probe on their keys) and lent to `rust_find_bson` in chunks,
+     * without a sort. Because the matcher preserves the order of its input, the matches arrive
+     * already sorted, and the traversal stops as soon as `skip + limit` of them are collected.
+     * The caller must hold the collection's lock for as long as it dereferences the result.
+     * @param coll The name of the collection to query.
+     * @param plan The plan produced by `make_plan`, with a non-empty `sort_field`.
+     * @param query_json A JSON string for the filter conditions.
+     * @param limit The maximum number of documents to return (0 for no limit).
+     * @param skip The number of initial matches to skip.
+     * @return Non-owning pointers to the matching documents, in result order.
      */
-    void load_all();
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> find_in_index_order(
+        std::string_view coll, const query::QueryPlan &plan, std::string_view query_json,
+        int64_t limit, int64_t skip) const;
 
     /**
-     * @brief Retrieves all documents from a collection and serializes them into a single JSON array
-     * string.
-     * @details This is a utility function used to prepare the entire dataset for processing by the
-     * Rust FFI.
-     * @param coll The name of the collection to fetch.
-     * @return A `std::string` containing the JSON array representation of the collection.
+     * @brief Advances a cursor by up to one batch.
+     * @details The caller must hold the lock of the cursor's collection. The returned documents
+     * are projected copies.
+     * @param cursor The cursor.
+     * @param batch_size The maximum number of documents to return.
+     * @param batch Receives the documents.
      */
-    [[nodiscard]] std::string fetch_collection_as_json_array(std::string_view coll);
+    void fill_cursor_batch(query::Cursor &cursor, size_t batch_size,
+                           std::vector<aevum::bson::doc::Document> &batch) const;
 };
 
 }  // namespace aevum::db
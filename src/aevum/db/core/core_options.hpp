@@ -0,0 +1,164 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file core_options.hpp
+ * @brief Defines `CoreOptions`, the configuration of the `Core` database engine.
+ * @details The options are read from the daemon's configuration file by `daemon::parse_config`
+ * and handed to the `Core` constructor, which passes the storage options on to the
+ * `WiredTigerStore`.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "aevum/db/storage/storage_options.hpp"
+#include "aevum/db/timeseries/time_series_options.hpp"
+#include "aevum/util/uuid/id_format.hpp"
+
+namespace aevum::db {
+
+/**
+ * @struct CoreOptions
+ * @brief The configuration of a `Core` instance.
+ */
+struct CoreOptions {
+    /// The configuration of the `WiredTigerStore`.
+    storage::StorageOptions storage;
+    /**
+     * @brief `true` to leave user collections in storage at startup and load each one into the
+     * primary and secondary indexes only when a request first needs them.
+     * @details Until then, `_id` lookups are answered with WiredTiger point reads, unsorted
+     * queries and counts stream the collection from a cursor, and inserts into an unindexed
+     * collection are written to storage only. Startup time and resident memory therefore scale
+     * with the collections in use rather than with the whole data directory.
+     */
+    bool lazy_load = false;
+    /**
+     * @brief `true` to refuse the raw API key of every user that has a PBKDF2 verifier, so that
+     * such users are only authorized through the session token of a `login`.
+     * @details By default a request may still carry the raw key, which is checked against its
+     * DJB2 hash only. That keeps the client libraries, replicas, and shard routers, which send
+     * their key with every request, working during the transition, but it also means the
+     * verifier does not protect a key whose hash is known.
+     */
+    bool require_sessions = false;
+    /**
+     * @brief The number of threads that load user collections at startup, or 0 for one per
+     * hardware thread.
+     * @details Each collection is read in key ranges so that a single large collection is split
+     * across the threads as well. A value of 1 loads the collections serially.
+     */
+    size_t load_threads = 0;
+    /**
+     * @brief The memory, in MiB, the documents and indexes of the resident collections and the
+     * result cache may hold together, or 0 for no limit.
+     * @details Every `memory_check_interval_ms`, the estimated sizes are summed. Over the limit,
+     * the result cache is shrunk first; if that is not enough, the least recently used user
+     * collections are evicted from the indexes and served from storage, as with `lazy_load`, until
+     * a request needs them indexed again. The WiredTiger cache is bounded by its own
+     * `cacheSizeMB` and is not counted.
+     */
+    size_t memory_budget_mb = 0;
+    /// The time, in milliseconds, between two checks of `memory_budget_mb`.
+    int64_t memory_check_interval_ms = 1000;
+    /**
+     * @brief `true` to keep an image of each resident user collection under the data directory
+     * and load collections from it rather than from storage.
+     * @details An image holds the documents and the hash and ordered index entries of one
+     * collection in a flat file that is memory-mapped when the collection is loaded; the changes
+     * made since it was written are read from the change log, so it requires a
+     * `change_log_capacity`. The resident collections written to since their last image are
+     * imaged again every `index_image_interval_sec` and at shutdown.
+     */
+    bool index_images = false;
+    /// The time, in seconds, between two passes of the image writer, or 0 to write images at
+    /// shutdown only.
+    int64_t index_image_interval_sec = 300;
+    /**
+     * @brief The number of threads that match the candidates of one query, or 0 for one per
+     * hardware thread.
+     * @details Queries and counts whose filter the native matcher supports split a batch of
+     * thousands of candidates into chunks matched concurrently, and merge the matches in order.
+     * A value of 1 matches every batch on the query's own thread.
+     */
+    size_t scan_threads = 0;
+    /**
+     * @brief The number of threads of the query engine's global pool, or 0 for one per hardware
+     * thread.
+     * @details The engine parallelizes the filtering, sorting, and grouping that the native
+     * matcher does not cover. With `engine_numa_pools`, each node's pool gets an equal share of
+     * the threads instead, or one thread per CPU of the node if this is 0.
+     */
+    size_t engine_threads = 0;
+    /// The prefix of the names of the query engine's threads, as shown by `top -H` or `gdb`.
+    std::string engine_thread_prefix = "Engine";
+    /**
+     * @brief `true` to give the query engine one pool per NUMA node, pinned to the node's CPUs.
+     * @details Each query is then parallelized on the pool of the node its thread is running on,
+     * so that it reads memory attached to that node rather than spreading over every socket. On
+     * a host with a single node, the pool is pinned to the CPUs available to the process.
+     */
+    bool engine_numa_pools = false;
+    /**
+     * @brief The time, in seconds, after which a cursor that is not read is discarded, or 0 to
+     * keep cursors until they are exhausted or killed.
+     */
+    int64_t cursor_timeout_sec = 600;
+    /**
+     * @brief The duration, in milliseconds, beyond which a `find`, `count`, `update`, or `remove`
+     * is kept in the slow operation log, 0 to keep every operation, or a negative value to
+     * disable the log.
+     */
+    int64_t slow_op_threshold_ms = 100;
+    /// The most slow operations kept; once the log is full, each one replaces the oldest.
+    size_t profile_entries = 128;
+    /**
+     * @brief The time, in seconds, between two passes of the TTL sweeper, or 0 to never delete
+     * expired documents.
+     * @details Each pass finds the expired documents of every TTL index through the index and
+     * deletes them in batches of `ttl_batch_size`.
+     */
+    int64_t ttl_sweep_interval_sec = 60;
+    /// The most documents one TTL delete batch removes under the collection's lock.
+    size_t ttl_batch_size = 500;
+    /// The time, in milliseconds, the TTL sweeper waits between two delete batches.
+    int64_t ttl_batch_pause_ms = 10;
+    /**
+     * @brief The change records kept for `watch` consumers, or 0 to record no changes.
+     * @details Every inserted, updated, or removed document adds one key-only record to the
+     * `_oplog` table in the same transaction; the oldest records are trimmed in the background.
+     */
+    size_t change_log_capacity = 1000000;
+    /**
+     * @brief The most documents one transaction may write before it is committed.
+     * @details A transaction stages its writes in memory until `commit`, so the limit bounds
+     * what one connection can hold; a write beyond it fails and leaves the transaction as it was.
+     */
+    size_t transaction_max_writes = 10000;
+    /// The most bytes of document versions one transaction may stage before it is committed.
+    size_t transaction_max_bytes = 64U << 20;
+    /**
+     * @brief The generator of the `_id` of inserted documents that have none.
+     * @details Random UUIDv4s spread inserts over the whole `_id` B-tree; UUIDv7s and
+     * ObjectId-style ids grow with time, so inserts fill the rightmost leaf pages and recent
+     * documents are stored together. Existing `_id`s are not affected by a change.
+     */
+    aevum::util::uuid::IdFormat id_format = aevum::util::uuid::IdFormat::UUID_V4;
+    /// The collections whose `_id`s are generated in another format than `id_format`.
+    std::unordered_map<std::string, aevum::util::uuid::IdFormat> collection_id_formats;
+    /**
+     * @brief The time-series collections, by name, with the fields and window of their buckets.
+     * @details The points inserted into such a collection are grouped by series and time window
+     * into buckets of compressed columns, each stored as a single record of the `_buckets.<name>`
+     * table, instead of one document per point. The bucket span of a collection must not change
+     * once points have been inserted, or time-range queries can miss the existing buckets.
+     */
+    std::unordered_map<std::string, timeseries::TimeSeriesOptions> time_series_collections;
+};
+
+}  // namespace aevum::db
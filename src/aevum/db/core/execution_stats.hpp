@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file execution_stats.hpp
+ * @brief Defines the counters of how `Core` executes queries, and their snapshot.
+ * @details The counters tell whether queries use the indexes they were meant to, and whether a
+ * slow request spends its time in the Rust FFI or in the storage engine.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "aevum/db/query/planner.hpp"
+#include "aevum/db/storage/wiredtiger_store.hpp"
+
+namespace aevum::db {
+
+/**
+ * @struct ExecutionCounters
+ * @brief The live counters of query execution, updated with relaxed atomic increments.
+ */
+struct ExecutionCounters {
+    /// The queries planned, by `query::PlanType`.
+    std::array<std::atomic<uint64_t>, query::PLAN_TYPE_COUNT> plans{};
+    /// The calls into the Rust FFI that filter, sort, count, aggregate, or update documents.
+    std::atomic<uint64_t> ffi_calls{0};
+    /// The time spent in those calls, in microseconds.
+    std::atomic<uint64_t> ffi_us{0};
+};
+
+/**
+ * @struct ExecutionStats
+ * @brief A snapshot of the execution counters of a `Core`.
+ */
+struct ExecutionStats {
+    /// The queries planned, by `query::PlanType`.
+    std::array<uint64_t, query::PLAN_TYPE_COUNT> plans{};
+    /// The calls into the Rust FFI.
+    uint64_t ffi_calls{0};
+    /// The time spent in the Rust FFI, in microseconds.
+    uint64_t ffi_us{0};
+    /// The time spent in the storage engine.
+    storage::StorageStats storage;
+};
+
+}  // namespace aevum::db
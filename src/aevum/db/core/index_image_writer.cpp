@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_image_writer.cpp
+ * @brief Implements `IndexImageWriter`, the background thread that keeps the index images
+ * current.
+ */
+#include "aevum/db/core/index_image_writer.hpp"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db {
+
+/**
+ * @brief Starts the writer thread.
+ * @param interval The time from the end of one pass to the start of the next.
+ * @param pass The pass, called on the writer thread.
+ */
+IndexImageWriter::IndexImageWriter(std::chrono::milliseconds interval,
+                                   std::function<void(IndexImageWriter &)> pass)
+    : interval_(interval), pass_(std::move(pass)), thread_(&IndexImageWriter::run, this) {}
+
+/**
+ * @brief Stops the writer thread.
+ * @details A pass in progress sees the request at its next `stopping` check and returns.
+ */
+IndexImageWriter::~IndexImageWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ * @brief Checks whether the writer is stopping.
+ * @return `true` once the destructor has run.
+ */
+bool IndexImageWriter::stopping() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stop_;
+}
+
+/**
+ * @brief Records the outcome of writing an image.
+ * @param bytes The size of the image.
+ * @param ok `false` if the image could not be written.
+ */
+void IndexImageWriter::note_image(size_t bytes, bool ok) noexcept {
+    if (!ok) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    written_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the counters of the writer.
+ * @return The snapshot of the counters.
+ */
+IndexImageStats IndexImageWriter::stats() const noexcept {
+    IndexImageStats stats;
+    stats.passes = passes_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    stats.last_pass_us = last_pass_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief The body of the writer thread.
+ * @details Each round waits for `interval_`, then runs the pass and records its duration. An
+ * exception thrown by the pass is logged and ends only that pass.
+ */
+void IndexImageWriter::run() {
+    aevum::util::concurrency::set_current_thread_name("ImageWriter");
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_cv_.wait_for(lock, interval_, [&]() { return stop_; })) return;
+        }
+        auto started = std::chrono::steady_clock::now();
+        try {
+            pass_(*this);
+        } catch (const std::exception &e) {
+            AEVUM_LOG_ERROR(std::string("IndexImageWriter: Pass failed: ") + e.what());
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started);
+        last_pass_us_.store(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        passes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace aevum::db
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_image_writer.hpp
+ * @brief Declares `IndexImageWriter`, the background thread that keeps the index images of the
+ * collections current.
+ * @details A collection is loaded from its image (see `index::IndexImage`) plus the changes the
+ * change log holds since the image was written, so the older an image, the more documents the
+ * next load re-reads from storage, and once the change log has been trimmed past the image, the
+ * image is of no use at all. The writer wakes up periodically and hands each pass to the `Core`,
+ * which images again the collections written to since their last image.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace aevum::db {
+
+/**
+ * @struct IndexImageStats
+ * @brief The counters of the index images, as reported by the `metrics` action.
+ */
+struct IndexImageStats {
+    /// `true` if collections are loaded from and imaged to index images.
+    bool enabled = false;
+    /// The passes of the writer completed.
+    uint64_t passes = 0;
+    /// The images written.
+    uint64_t written = 0;
+    /// The bytes of the images written.
+    uint64_t bytes_written = 0;
+    /// The images that could not be written.
+    uint64_t failures = 0;
+    /// The duration of the last pass, in microseconds.
+    uint64_t last_pass_us = 0;
+    /// The collections loaded from their image.
+    uint64_t loaded = 0;
+    /// The images found invalid or outdated and discarded.
+    uint64_t rejected = 0;
+};
+
+/**
+ * @class IndexImageWriter
+ * @brief Runs a pass over the resident collections at a fixed interval on a thread of its own.
+ *
+ * @details The pass itself is supplied by the owner. It reports each image with `note_image` and
+ * checks `stopping` between two images, so that a pass in progress ends promptly at shutdown.
+ */
+class IndexImageWriter {
+  public:
+    /**
+     * @brief Starts the writer thread.
+     * @param interval The time from the end of one pass to the start of the next.
+     * @param pass The pass, called on the writer thread.
+     */
+    IndexImageWriter(std::chrono::milliseconds interval,
+                     std::function<void(IndexImageWriter &)> pass);
+
+    /**
+     * @brief Stops the writer, waiting for the image in progress to be written, and joins its
+     * thread.
+     */
+    ~IndexImageWriter();
+
+    // The writer owns a thread that refers back to it, so it is neither copyable nor movable.
+    IndexImageWriter(const IndexImageWriter &) = delete;
+    IndexImageWriter &operator=(const IndexImageWriter &) = delete;
+    IndexImageWriter(IndexImageWriter &&) = delete;
+    IndexImageWriter &operator=(IndexImageWriter &&) = delete;
+
+    /**
+     * @brief Checks whether the writer is stopping.
+     * @return `true` if the pass in progress should end.
+     */
+    [[nodiscard]] bool stopping();
+
+    /**
+     * @brief Records the outcome of writing an image.
+     * @param bytes The size of the image.
+     * @param ok `false` if the image could not be written.
+     */
+    void note_image(size_t bytes, bool ok) noexcept;
+
+    /**
+     * @brief Returns the counters of the writer.
+     * @details `enabled`, `loaded`, and `rejected` are left to the owner.
+     * @return The snapshot of the counters.
+     */
+    [[nodiscard]] IndexImageStats stats() const noexcept;
+
+  private:
+    /// The time between passes.
+    std::chrono::milliseconds interval_;
+    /// The pass.
+    std::function<void(IndexImageWriter &)> pass_;
+
+    /// Guards `stop_`.
+    std::mutex mutex_;
+    /// Signaled when the writer is stopping.
+    std::condition_variable stop_cv_;
+    /// `true` once the destructor has asked the thread to exit.
+    bool stop_{false};
+
+    /// The counters of `IndexImageStats`, advanced by the writer thread and read by any thread.
+    std::atomic<uint64_t> passes_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> last_pass_us_{0};
+
+    /// The writer thread; started last, once every other member is initialized.
+    std::thread thread_;
+
+    /**
+     * @brief The body of the writer thread.
+     */
+    void run();
+};
+
+}  // namespace aevum::db
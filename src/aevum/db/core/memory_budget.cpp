@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file memory_budget.cpp
+ * @brief Implements `MemoryBudget`, the background thread that keeps the in-memory layers within
+ * their limit.
+ */
+#include "aevum/db/core/memory_budget.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db {
+
+/**
+ * @brief Starts the budget's thread if it has a limit.
+ * @param limit_bytes The most bytes the reclaimers may hold, or 0 for no limit.
+ * @param interval The time from the end of one pass to the start of the next.
+ */
+MemoryBudget::MemoryBudget(size_t limit_bytes, std::chrono::milliseconds interval)
+    : limit_(limit_bytes), interval_(interval) {
+    if (limit_ > 0) thread_ = std::thread(&MemoryBudget::run, this);
+}
+
+/**
+ * @brief Stops the budget's thread.
+ * @details A pass in progress runs to its end.
+ */
+MemoryBudget::~MemoryBudget() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ * @brief Registers a layer.
+ * @param reclaimer The layer.
+ * @return The id to unregister it with.
+ */
+uint64_t MemoryBudget::add_reclaimer(MemoryReclaimer reclaimer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t id = next_id_++;
+    reclaimers_.emplace_back(id, std::move(reclaimer));
+    return id;
+}
+
+/**
+ * @brief Unregisters a layer.
+ * @details Once this returns, no pass calls the layer's functions any longer.
+ * @param id The id returned by `add_reclaimer`.
+ */
+void MemoryBudget::remove_reclaimer(uint64_t id) {
+    std::lock_guard<std::mutex> pass(pass_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    reclaimers_.erase(std::remove_if(reclaimers_.begin(), reclaimers_.end(),
+                                     [&](const auto &entry) { return entry.first == id; }),
+                      reclaimers_.end());
+}
+
+/**
+ * @brief Runs a pass on the calling thread.
+ * @details The sizes of all layers are summed first. If the sum exceeds the limit, the layers are
+ * asked for the excess in order of rank, layers of equal rank in order of registration, until
+ * the bytes they report freed cover it. The sizes are estimates and the layers keep changing
+ * meanwhile, so a pass does not check the sum again; the next one does.
+ * @return The bytes freed.
+ */
+size_t MemoryBudget::enforce() {
+    std::lock_guard<std::mutex> pass(pass_mutex_);
+    // A copy, since layers may be added while the pass runs.
+    std::vector<MemoryReclaimer> layers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        layers.reserve(reclaimers_.size());
+        for (const auto &[id, reclaimer] : reclaimers_) layers.push_back(reclaimer);
+    }
+    std::stable_sort(layers.begin(), layers.end(),
+                     [](const auto &a, const auto &b) { return a.rank < b.rank; });
+
+    size_t used = 0;
+    for (const auto &layer : layers) used += layer.usage();
+    used_.store(used, std::memory_order_relaxed);
+    passes_.fetch_add(1, std::memory_order_relaxed);
+    if (limit_ == 0 || used <= limit_) return 0;
+
+    over_budget_.fetch_add(1, std::memory_order_relaxed);
+    size_t excess = used - limit_;
+    size_t reclaimed = 0;
+    for (const auto &layer : layers) {
+        if (reclaimed >= excess) break;
+        if (!layer.reclaim) continue;
+        size_t freed = layer.reclaim(excess - reclaimed);
+        if (freed > 0) {
+            AEVUM_LOG_INFO("MemoryBudget: Reclaimed " + std::to_string(freed) + " bytes from the " +
+                           layer.name + ".");
+        }
+        reclaimed += freed;
+    }
+    reclaimed_bytes_.fetch_add(reclaimed, std::memory_order_relaxed);
+    if (reclaimed < excess) {
+        AEVUM_LOG_WARN("MemoryBudget: Only " + std::to_string(reclaimed) + " of the " +
+                       std::to_string(excess) + " bytes over the limit could be reclaimed.");
+    }
+    return reclaimed;
+}
+
+/**
+ * @brief Returns the counters of the budget.
+ * @return The snapshot of the counters.
+ */
+MemoryBudgetStats MemoryBudget::stats() const noexcept {
+    MemoryBudgetStats stats;
+    stats.limit = limit_;
+    stats.used = used_.load(std::memory_order_relaxed);
+    stats.passes = passes_.load(std::memory_order_relaxed);
+    stats.over_budget = over_budget_.load(std::memory_order_relaxed);
+    stats.reclaimed_bytes = reclaimed_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief The body of the budget's thread.
+ * @details Each round waits for `interval_` and runs a pass. An exception thrown by a layer is
+ * logged and ends only that pass.
+ */
+void MemoryBudget::run() {
+    aevum::util::concurrency::set_current_thread_name("MemoryBudget");
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_cv_.wait_for(lock, interval_, [&]() { return stop_; })) return;
+        }
+        try {
+            (void)enforce();
+        } catch (const std::exception &e) {
+            AEVUM_LOG_ERROR(std::string("MemoryBudget: Pass failed: ") + e.what());
+        }
+    }
+}
+
+}  // namespace aevum::db
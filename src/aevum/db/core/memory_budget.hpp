@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file memory_budget.hpp
+ * @brief Declares `MemoryBudget`, the background thread that keeps the in-memory layers of the
+ * server within a configured size.
+ * @details The primary index holds every document of a resident collection, and the secondary
+ * indexes and the result cache grow with it, so without a bound the process grows until the host
+ * kills it. Each layer that can give memory back registers a `MemoryReclaimer` that reports its
+ * size and frees a requested amount. The budget sums the reports at a fixed interval and, once the
+ * sum exceeds the limit, asks the reclaimers for the excess in order of rank, so that caches are
+ * emptied before collections are evicted.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "aevum/db/index/index_statistics.hpp"
+
+namespace aevum::db {
+
+/**
+ * @struct MemoryReclaimer
+ * @brief A layer whose memory counts against a `MemoryBudget`.
+ */
+struct MemoryReclaimer {
+    /// The name of the layer, for the log.
+    std::string name;
+    /// The order in which the layers are asked to shrink, lowest first.
+    int rank = 0;
+    /// Returns the bytes the layer holds.
+    std::function<size_t()> usage;
+    /// Frees at least the given number of bytes if it can, and returns the bytes freed.
+    std::function<size_t(size_t)> reclaim;
+};
+
+/**
+ * @struct MemoryBudgetStats
+ * @brief The counters of a `MemoryBudget`, as reported by the `metrics` action.
+ */
+struct MemoryBudgetStats {
+    /// The limit, in bytes, or 0 for none.
+    size_t limit = 0;
+    /// The bytes the reclaimers held at the last pass.
+    size_t used = 0;
+    /// The passes completed.
+    uint64_t passes = 0;
+    /// The passes that found the reclaimers over the limit.
+    uint64_t over_budget = 0;
+    /// The bytes the reclaimers reported freed.
+    uint64_t reclaimed_bytes = 0;
+};
+
+/**
+ * @struct MemoryUsage
+ * @brief What the collections of a `Core` hold in memory, as reported by the `metrics` action.
+ */
+struct MemoryUsage {
+    /// The counters of the budget.
+    MemoryBudgetStats budget;
+    /// The estimated memory of each resident user collection, by name.
+    std::vector<std::pair<std::string, index::CollectionMemory>> collections;
+    /// The sum of the collections' `documents`.
+    size_t documents = 0;
+    /// The sum of the collections' `indexes`.
+    size_t indexes = 0;
+    /// The user collections that are only in storage.
+    size_t unloaded = 0;
+    /// The collections the budget has evicted from the indexes.
+    uint64_t evictions = 0;
+};
+
+/**
+ * @class MemoryBudget
+ * @brief Checks the size of the registered layers at a fixed interval on a thread of its own.
+ *
+ * @details The thread only runs if the budget has a limit. Reclaimers are called on it without
+ * any lock of the budget's but `pass_mutex_`, which `remove_reclaimer` takes as well, so a
+ * reclaimer may take its owner's locks, and its owner can unregister it and then destroy what it
+ * refers to. The class is thread-safe.
+ */
+class MemoryBudget {
+  public:
+    /**
+     * @brief Starts the budget's thread if it has a limit.
+     * @param limit_bytes The most bytes the reclaimers may hold, or 0 for no limit.
+     * @param interval The time from the end of one pass to the start of the next.
+     */
+    MemoryBudget(size_t limit_bytes, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Stops the thread, waiting for a pass in progress to end, and joins it.
+     */
+    ~MemoryBudget();
+
+    // The budget owns a thread that refers back to it, so it is neither copyable nor movable.
+    MemoryBudget(const MemoryBudget &) = delete;
+    MemoryBudget &operator=(const MemoryBudget &) = delete;
+    MemoryBudget(MemoryBudget &&) = delete;
+    MemoryBudget &operator=(MemoryBudget &&) = delete;
+
+    /**
+     * @brief Registers a layer, taken into account from the next pass on.
+     * @param reclaimer The layer.
+     * @return The id to unregister it with.
+     */
+    uint64_t add_reclaimer(MemoryReclaimer reclaimer);
+
+    /**
+     * @brief Unregisters a layer, waiting for a pass in progress to end.
+     * @param id The id returned by `add_reclaimer`.
+     */
+    void remove_reclaimer(uint64_t id);
+
+    /**
+     * @brief Runs a pass on the calling thread.
+     * @return The bytes freed, 0 if the layers are within the limit.
+     */
+    size_t enforce();
+
+    /**
+     * @brief Returns the counters of the budget.
+     * @return The snapshot of the counters.
+     */
+    [[nodiscard]] MemoryBudgetStats stats() const noexcept;
+
+  private:
+    /// The limit, in bytes, or 0 for none.
+    size_t limit_;
+    /// The time between passes.
+    std::chrono::milliseconds interval_;
+
+    /// Guards `reclaimers_`, `next_id_`, and `stop_`.
+    std::mutex mutex_;
+    /// Held for the duration of a pass.
+    std::mutex pass_mutex_;
+    /// Signaled when the budget is stopping.
+    std::condition_variable stop_cv_;
+    /// `true` once the destructor has asked the thread to exit.
+    bool stop_{false};
+    /// The registered layers with their ids, in order of registration.
+    std::vector<std::pair<uint64_t, MemoryReclaimer>> reclaimers_;
+    /// The id of the next registered layer.
+    uint64_t next_id_{1};
+
+    /// The counters of `MemoryBudgetStats`, advanced by the passes and read by any thread.
+    std::atomic<size_t> used_{0};
+    std::atomic<uint64_t> passes_{0};
+    std::atomic<uint64_t> over_budget_{0};
+    std::atomic<uint64_t> reclaimed_bytes_{0};
+
+    /// The budget's thread, if it has a limit; started last, once every other member is
+    /// initialized.
+    std::thread thread_;
+
+    /**
+     * @brief The body of the budget's thread.
+     */
+    void run();
+};
+
+}  // namespace aevum::db
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file transaction.cpp
+ * @brief Implements `Transaction`, the private state of a multi-document transaction.
+ */
+#include "aevum/db/core/transaction.hpp"
+
+#include <utility>
+
+namespace aevum::db {
+
+/**
+ * @brief Looks up the documents touched in a collection.
+ * @param coll The name of the collection.
+ * @return The touched documents, or `nullptr` if there are none.
+ */
+const Transaction::Versions *Transaction::versions(std::string_view coll) const {
+    auto it = collections_.find(coll);
+    return it == collections_.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Looks up a touched document.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @return The state of the document, or `nullptr` if it is not touched.
+ */
+const Transaction::Version *Transaction::find(std::string_view coll, std::string_view id) const {
+    const Versions *touched = versions(coll);
+    if (!touched) return nullptr;
+    auto it = touched->find(std::string(id));
+    return it == touched->end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Pins a document at its committed version; a document pinned before keeps its base.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @param base The committed version, or null if the document does not exist.
+ * @return The state of the document.
+ */
+const Transaction::Version &Transaction::pin(std::string_view coll, const std::string &id,
+                                             index::PrimaryIndexer::DocumentPtr base) {
+    auto it = collections_.find(coll);
+    if (it == collections_.end()) it = collections_.emplace(std::string(coll), Versions{}).first;
+    auto [version, inserted] = it->second.try_emplace(id);
+    if (inserted) version->second.base = std::move(base);
+    return version->second;
+}
+
+/**
+ * @brief Stages a new version of a pinned document; a document that is not pinned is ignored.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @param doc The new version, or null to delete the document.
+ */
+void Transaction::write(std::string_view coll, const std::string &id,
+                        std::unique_ptr<aevum::bson::doc::Document> doc) {
+    auto it = collections_.find(coll);
+    if (it == collections_.end()) return;
+    auto version = it->second.find(id);
+    if (version == it->second.end()) return;
+    if (!version->second.written) ++write_count_;
+    if (version->second.staged) staged_bytes_ -= version->second.staged->length();
+    if (doc) staged_bytes_ += doc->length();
+    version->second.staged = std::move(doc);
+    version->second.written = true;
+}
+
+/**
+ * @brief Forgets every pinned and staged document, releasing the pinned handles.
+ */
+void Transaction::clear() noexcept {
+    collections_.clear();
+    write_count_ = 0;
+    staged_bytes_ = 0;
+}
+
+}  // namespace aevum::db
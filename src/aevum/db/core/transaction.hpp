@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file transaction.hpp
+ * @brief Declares `Transaction`, the private state of a multi-document transaction.
+ * @details A transaction is driven by the `Core` methods that take one: its writes are staged
+ * here, invisible to everyone else, until `Core::commit` applies all of them in one storage
+ * transaction and only then to the in-memory indexes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/util/hash/string_hash.hpp"
+
+namespace aevum::db {
+
+/**
+ * @class Transaction
+ * @brief The documents a transaction has read or written, by collection and `_id`.
+ *
+ * @details Every document a transaction touches is pinned at its first access: the transaction
+ * keeps the handle of the committed version it saw, its base, and from then on reads that version,
+ * or the version it wrote itself, whatever other writers commit in the meantime. Writes replace
+ * the version privately. `Core::commit` accepts the transaction only if the base of every
+ * document it wrote is still the committed version, so of two transactions writing the same
+ * document the first to commit wins and the other fails with a `kConflict` status.
+ *
+ * This is read-stable, optimistic concurrency rather than snapshot isolation: there is no
+ * snapshot taken at the start. A document is read as committed when it is first touched, which
+ * may be after other transactions committed, so two documents read at different times may come
+ * from different points in time, and a query repeated in the transaction also matches the
+ * documents inserted by others since (phantoms). Only the documents the transaction writes are
+ * validated at commit; those it only read are not.
+ *
+ * A transaction belongs to one connection and is not thread-safe.
+ */
+class Transaction {
+  public:
+    /**
+     * @struct Version
+     * @brief The state of one document within the transaction.
+     */
+    struct Version {
+        /// The committed version the transaction first saw, or null if there was none.
+        index::PrimaryIndexer::DocumentPtr base;
+        /// The version the transaction wrote, or null if it deleted the document.
+        std::unique_ptr<aevum::bson::doc::Document> staged;
+        /// `true` once the transaction has written the document.
+        bool written = false;
+
+        /**
+         * @brief Returns the version the transaction reads.
+         * @return The staged version once written, the base otherwise; null if the document does
+         *         not exist for the transaction.
+         */
+        [[nodiscard]] const aevum::bson::doc::Document *current() const noexcept {
+            return written ? staged.get() : base.get();
+        }
+    };
+
+    /// The touched documents of one collection, by `_id`.
+    using Versions = std::unordered_map<std::string, Version, aevum::util::hash::StringHash>;
+    /// The touched collections, in name order, which is the order `Core::commit` locks them in.
+    using Collections = std::map<std::string, Versions, std::less<>>;
+
+    Transaction() = default;
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+
+    /**
+     * @brief Looks up the documents touched in a collection.
+     * @param coll The name of the collection.
+     * @return The touched documents, or `nullptr` if the transaction has not touched any.
+     */
+    [[nodiscard]] const Versions *versions(std::string_view coll) const;
+
+    /**
+     * @brief Looks up a touched document.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     * @return The state of the document, or `nullptr` if the transaction has not touched it.
+     */
+    [[nodiscard]] const Version *find(std::string_view coll, std::string_view id) const;
+
+    /**
+     * @brief Pins a document at its committed version, unless it is already pinned.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     * @param base The committed version, or null if the document does not exist.
+     * @return The state of the document, which keeps the first base pinned.
+     */
+    const Version &pin(std::string_view coll, const std::string &id,
+                       index::PrimaryIndexer::DocumentPtr base);
+
+    /**
+     * @brief Stages a new version of a pinned document.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document; it must have been pinned.
+     * @param doc The new version, or null to delete the document.
+     */
+    void write(std::string_view coll, const std::string &id,
+               std::unique_ptr<aevum::bson::doc::Document> doc);
+
+    /**
+     * @brief Returns the touched collections for `Core::commit`, which moves the staged versions
+     * out of them.
+     */
+    [[nodiscard]] Collections &collections() noexcept { return collections_; }
+
+    /**
+     * @brief Returns the number of documents the transaction has written.
+     */
+    [[nodiscard]] size_t write_count() const noexcept { return write_count_; }
+
+    /**
+     * @brief Returns the size, in bytes, of the versions the transaction has staged.
+     */
+    [[nodiscard]] size_t staged_bytes() const noexcept { return staged_bytes_; }
+
+    /**
+     * @brief Forgets every pinned and staged document, as an abort or a finished commit does.
+     */
+    void clear() noexcept;
+
+  private:
+    /// The touched documents, by collection.
+    Collections collections_;
+    /// The number of documents written.
+    size_t write_count_ = 0;
+    /// The size of the staged versions.
+    size_t staged_bytes_ = 0;
+};
+
+}  // namespace aevum::db
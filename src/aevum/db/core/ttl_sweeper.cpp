@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file ttl_sweeper.cpp
+ * @brief Implements `TtlSweeper`, the background thread that deletes expired documents.
+ */
+#include "aevum/db/core/ttl_sweeper.hpp"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db {
+
+/**
+ * @brief Starts the sweeper thread.
+ * @param interval The time from the end of one pass to the start of the next.
+ * @param pass The pass, called on the sweeper thread.
+ */
+TtlSweeper::TtlSweeper(std::chrono::milliseconds interval,
+                       std::function<void(TtlSweeper &)> pass)
+    : interval_(interval), pass_(std::move(pass)), thread_(&TtlSweeper::run, this) {}
+
+/**
+ * @brief Stops the sweeper thread.
+ * @details A pass in progress sees the request at its next `pause` and returns.
+ */
+TtlSweeper::~TtlSweeper() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ * @brief Waits between two batches of a pass, unless the sweeper is stopping.
+ * @param duration How long to wait.
+ * @return `false` if the sweeper is stopping.
+ */
+bool TtlSweeper::pause(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !stop_cv_.wait_for(lock, duration, [&]() { return stop_; });
+}
+
+/**
+ * @brief Records the outcome of a delete batch.
+ * @param deleted The number of documents the batch deleted.
+ * @param ok `false` if the batch failed.
+ */
+void TtlSweeper::note_batch(size_t deleted, bool ok) noexcept {
+    if (!ok) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    deleted_.fetch_add(deleted, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the counters of the sweeper.
+ * @return The snapshot of the counters.
+ */
+TtlStats TtlSweeper::stats() const noexcept {
+    TtlStats stats;
+    stats.passes = passes_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.deleted = deleted_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    stats.last_pass_us = last_pass_us_.load(std::memory_order_relaxed);
+    stats.last_pass_deleted = last_pass_deleted_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief The body of the sweeper thread.
+ * @details Each round waits for `interval_`, then runs the pass and records its duration and the
+ * documents it deleted. An exception thrown by the pass is logged and ends only that pass.
+ */
+void TtlSweeper::run() {
+    aevum::util::concurrency::set_current_thread_name("TtlSweeper");
+    while (pause(interval_)) {
+        uint64_t deleted_before = deleted_.load(std::memory_order_relaxed);
+        auto started = std::chrono::steady_clock::now();
+        try {
+            pass_(*this);
+        } catch (const std::exception &e) {
+            AEVUM_LOG_ERROR(std::string("TtlSweeper: Pass failed: ") + e.what());
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started);
+        last_pass_us_.store(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        last_pass_deleted_.store(deleted_.load(std::memory_order_relaxed) - deleted_before,
+                                 std::memory_order_relaxed);
+        passes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace aevum::db
@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file ttl_sweeper.hpp
+ * @brief Declares `TtlSweeper`, the background thread that deletes expired documents.
+ * @details The documents of a collection with a TTL index expire a fixed number of seconds after
+ * the time in the indexed field. The sweeper wakes up periodically and hands each pass to the
+ * `Core`, which finds the expired documents through the ordered index and deletes them in small
+ * batches, pausing between batches through `pause` so that foreground writers to the collection
+ * are never held off for long.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace aevum::db {
+
+/**
+ * @struct TtlStats
+ * @brief The counters of a `TtlSweeper`, as reported by the `metrics` action.
+ */
+struct TtlStats {
+    /// The passes completed.
+    uint64_t passes = 0;
+    /// The delete batches committed.
+    uint64_t batches = 0;
+    /// The documents deleted.
+    uint64_t deleted = 0;
+    /// The delete batches that failed.
+    uint64_t failures = 0;
+    /// The duration of the last pass, in microseconds.
+    uint64_t last_pass_us = 0;
+    /// The documents deleted by the last pass.
+    uint64_t last_pass_deleted = 0;
+};
+
+/**
+ * @class TtlSweeper
+ * @brief Runs a pass over the TTL indexes at a fixed interval on a thread of its own.
+ *
+ * @details The pass itself is supplied by the owner. It reports the batches it deletes with
+ * `note_batch` and waits between them with `pause`, which returns `false` once the sweeper is
+ * stopping so that a pass in progress ends promptly at shutdown.
+ */
+class TtlSweeper {
+  public:
+    /**
+     * @brief Starts the sweeper thread.
+     * @param interval The time from the end of one pass to the start of the next.
+     * @param pass The pass, called on the sweeper thread.
+     */
+    TtlSweeper(std::chrono::milliseconds interval, std::function<void(TtlSweeper &)> pass);
+
+    /**
+     * @brief Stops the sweeper, waiting for a pass in progress to end, and joins its thread.
+     */
+    ~TtlSweeper();
+
+    // The sweeper owns a thread that refers back to it, so it is neither copyable nor movable.
+    TtlSweeper(const TtlSweeper &) = delete;
+    TtlSweeper &operator=(const TtlSweeper &) = delete;
+    TtlSweeper(TtlSweeper &&) = delete;
+    TtlSweeper &operator=(TtlSweeper &&) = delete;
+
+    /**
+     * @brief Waits between two batches of a pass.
+     * @param duration How long to wait.
+     * @return `false` if the sweeper is stopping and the pass should end.
+     */
+    [[nodiscard]] bool pause(std::chrono::milliseconds duration);
+
+    /**
+     * @brief Records the outcome of a delete batch.
+     * @param deleted The number of documents the batch deleted.
+     * @param ok `false` if the batch failed.
+     */
+    void note_batch(size_t deleted, bool ok) noexcept;
+
+    /**
+     * @brief Returns the counters of the sweeper.
+     * @return The snapshot of the counters.
+     */
+    [[nodiscard]] TtlStats stats() const noexcept;
+
+  private:
+    /// The time between passes.
+    std::chrono::milliseconds interval_;
+    /// The pass.
+    std::function<void(TtlSweeper &)> pass_;
+
+    /// Guards `stop_`.
+    std::mutex mutex_;
+    /// Signaled when the sweeper is stopping.
+    std::condition_variable stop_cv_;
+    /// `true` once the destructor has asked the thread to exit.
+    bool stop_{false};
+
+    /// The counters of `TtlStats`, advanced by the sweeper thread and read by any thread.
+    std::atomic<uint64_t> passes_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> deleted_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> last_pass_us_{0};
+    std::atomic<uint64_t> last_pass_deleted_{0};
+
+    /// The sweeper thread; started last, once every other member is initialized.
+    std::thread thread_;
+
+    /**
+     * @brief The body of the sweeper thread.
+     */
+    void run();
+};
+
+}  // namespace aevum::db
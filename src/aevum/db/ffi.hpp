@@ -13,6 +13,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 extern "C" {
@@ -29,6 +30,48 @@ struct rust_update_result {
     int32_t modified_count;
 };
 
+/**
+ * @struct rust_update_delta_result
+ * @brief Represents the modified documents returned by the `rust_update_delta` function.
+ */
+struct rust_update_delta_result {
+    /** @brief A pointer to an array of `len` positions into the caller's input array. Owned by
+     * Rust; null when `len` is zero. */
+    uint32_t *indices;
+    /** @brief A pointer to a null-terminated JSON array with the post-update image of each
+     * position, in order. Owned by Rust. */
+    char *data;
+    /** @brief The number of modified documents. */
+    size_t len;
+};
+
+/**
+ * @struct rust_index_result
+ * @brief Represents the positions returned by the zero-copy `rust_find_bson` and
+ * `rust_validate_bson` functions.
+ */
+struct rust_index_result {
+    /** @brief A pointer to an array of `len` positions into the caller's document array. Owned by
+     * Rust; null when `len` is zero. */
+    uint32_t *indices;
+    /** @brief The number of positions in `indices`. */
+    size_t len;
+};
+
+/**
+ * @struct rust_aggregate_result
+ * @brief Represents the outcome of the `rust_aggregate_bson` function. Exactly one of the two
+ * pointers is non-null.
+ */
+struct rust_aggregate_result {
+    /** @brief A pointer to a null-terminated JSON array of the pipeline's results, or null if the
+     * pipeline was rejected. Owned by Rust. */
+    char *data;
+    /** @brief A pointer to a null-terminated description of what is wrong with the pipeline, or
+     * null on success. Owned by Rust. */
+    char *error;
+};
+
 /**
  * @brief Validates a JSON document against a JSON schema query.
  * @param doc A null-terminated JSON string of the document.
@@ -64,6 +107,20 @@ char *rust_find(const char *data, const char *query, const char *sort, const cha
 rust_update_result rust_update(const char *data, const char *query, const char *update_doc,
                                const char *schema);
 
+/**
+ * @brief Executes an update operation on a dataset and reports only the modified documents.
+ * @details Position `indices[i]` of the input array was modified, and element `i` of the JSON
+ * array in `data` is its post-update image. Documents that did not match, or whose update failed
+ * schema validation, are not reported.
+ * @param data A JSON array of documents.
+ * @param query The query to select documents for update.
+ * @param update_doc The update specification.
+ * @param schema The schema to validate against (can be empty string).
+ * @return A `rust_update_delta_result` that MUST be freed via `rust_free_update_delta_result`.
+ */
+rust_update_delta_result rust_update_delta(const char *data, const char *query,
+                                           const char *update_doc, const char *schema);
+
 /**
  * @brief Deletes matching documents from a dataset.
  * @return A pointer to the modified JSON array. MUST be freed via rust_free_string.
@@ -82,4 +139,103 @@ void rust_free_string(char *s);
  */
 void rust_free_update_result(rust_update_result res);
 
+/**
+ * @brief Deallocates the resources within a `rust_update_delta_result`.
+ * @param res The result struct to free.
+ */
+void rust_free_update_delta_result(rust_update_delta_result res);
+
+/**
+ * @brief Counts the BSON documents in a borrowed buffer array that match a query.
+ * @details The buffers are read in place for the duration of the call; nothing is copied or
+ * serialized to JSON.
+ * @param docs An array of `num_docs` pointers to BSON document data (e.g., `bson_get_data`).
+ * @param lens An array of `num_docs` document lengths in bytes.
+ * @param num_docs The number of documents in both arrays.
+ * @param query A null-terminated JSON string of the query object.
+ * @return The number of matching documents.
+ */
+int32_t rust_count_bson(const uint8_t *const *docs, const uint32_t *lens, size_t num_docs,
+                        const char *query);
+
+/**
+ * @brief Filters, sorts, and paginates a borrowed BSON buffer array, returning result positions.
+ * @details Instead of re-encoded documents, this returns the positions of the results within
+ * `docs`, in result order, so the caller can hand out the documents it already owns. Projection
+ * is not applied.
+ * @param docs An array of `num_docs` pointers to BSON document data.
+ * @param lens An array of `num_docs` document lengths in bytes.
+ * @param num_docs The number of documents in both arrays.
+ * @param query A null-terminated JSON string of the query object.
+ * @param sort A null-terminated JSON string of the sort specification.
+ * @param limit The maximum number of positions to return (0 for no limit).
+ * @param skip The number of matches to skip.
+ * @return A `rust_index_result` that MUST be freed via rust_free_index_result.
+ */
+rust_index_result rust_find_bson(const uint8_t *const *docs, const uint32_t *lens, size_t num_docs,
+                                 const char *query, const char *sort, int32_t limit,
+                                 int32_t skip);
+
+/**
+ * @brief Validates a borrowed BSON buffer array against a schema in a single, parallel call.
+ * @param docs An array of `num_docs` pointers to BSON document data.
+ * @param lens An array of `num_docs` document lengths in bytes.
+ * @param num_docs The number of documents in both arrays.
+ * @param schema A null-terminated JSON string of the schema query.
+ * @return A `rust_index_result` listing the positions of the invalid documents in ascending order
+ * (empty if all are valid). It MUST be freed via rust_free_index_result.
+ */
+rust_index_result rust_validate_bson(const uint8_t *const *docs, const uint32_t *lens,
+                                     size_t num_docs, const char *schema);
+
+/**
+ * @brief Runs an aggregation pipeline over a borrowed BSON buffer array.
+ * @details The buffers are read in place; only the results of the pipeline are serialized.
+ * Supported stages are `$match`, `$group`, `$sort`, `$skip`, `$limit`, `$project`, and `$count`.
+ * @param docs An array of `num_docs` pointers to BSON document data.
+ * @param lens An array of `num_docs` document lengths in bytes.
+ * @param num_docs The number of documents in both arrays.
+ * @param pipeline A null-terminated JSON array of pipeline stages.
+ * @return A `rust_aggregate_result` that MUST be freed via rust_free_aggregate_result.
+ */
+rust_aggregate_result rust_aggregate_bson(const uint8_t *const *docs, const uint32_t *lens,
+                                         size_t num_docs, const char *pipeline);
+
+/**
+ * @brief Deallocates the strings within a `rust_aggregate_result`.
+ * @param res The result struct to free.
+ */
+void rust_free_aggregate_result(rust_aggregate_result res);
+
+/**
+ * @brief Deallocates the position array within a `rust_index_result`.
+ * @param res The result struct to free.
+ */
+void rust_free_index_result(rust_index_result res);
+
+/**
+ * @brief Builds the query engine's thread pools: a global pool and, optionally, one pool per NUMA
+ * node whose threads are pinned to the node's CPUs.
+ * @details Must be called before any other function of the engine, which otherwise builds a
+ * default global pool on its first parallel operation. With node pools, each call runs on the
+ * pool of the node the calling thread is running on, unless `rust_set_pool_node` selects one.
+ * @param threads The threads of the global pool, or 0 for one per CPU. Node pools get an equal
+ * share each, or one thread per CPU of the node if `threads` is 0.
+ * @param name_prefix The prefix of the thread names, or null for `Engine`.
+ * @param cpus The CPU ids of all nodes, node after node.
+ * @param node_sizes The number of CPU ids of each node.
+ * @param num_nodes The number of nodes, or 0 for the global pool alone.
+ * @return 1 if the pools were built, 0 if they had already been built.
+ */
+int32_t rust_configure_pool(size_t threads, const char *name_prefix, const uint32_t *cpus,
+                            const size_t *node_sizes, size_t num_nodes);
+
+/**
+ * @brief Selects the NUMA node whose pool runs the calling thread's subsequent engine calls.
+ * @param node A node index as passed to `rust_configure_pool`, or -1 to follow the CPU the thread
+ * is running on, the default.
+ * @return The previous selection, to be restored when the scoped query is done.
+ */
+int32_t rust_set_pool_node(int32_t node);
+
 }  // extern "C"
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bloom_filter.cpp
+ * @brief Implements `BloomFilter`, the blocked Bloom filter of negative key lookups.
+ * @details The bit a key sets in each word of its block is chosen from the lower half of its hash
+ * multiplied by a per-word odd constant, as in the split block Bloom filters of Apache Parquet,
+ * here with 64-bit words so that a block fills a cache line.
+ */
+#include "aevum/db/index/bloom_filter.hpp"
+
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The odd multipliers deriving the bit of each word of a block from a key's hash.
+constexpr uint32_t LANE_SALTS[BloomFilter::BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+/// Identifies the encoding written by `BloomFilter::serialize`, and its version. Version 2 hashes
+/// keys with wyhash; filters of version 1 hashed them differently and are not read back.
+constexpr std::string_view FORMAT_TAG = "AEBF2";
+
+/**
+ * @brief Computes the bits a key sets in the words of its block.
+ * @details The loop has no dependencies between lanes and is vectorized by the compiler.
+ * @param hash The hash of the key.
+ * @param masks Receives one single-bit mask per word.
+ */
+inline void lane_masks(uint64_t hash, uint64_t (&masks)[BloomFilter::BLOCK_WORDS]) noexcept {
+    uint32_t low = static_cast<uint32_t>(hash);
+    for (size_t i = 0; i < BloomFilter::BLOCK_WORDS; ++i) {
+        masks[i] = uint64_t{1} << ((low * LANE_SALTS[i]) >> 26);
+    }
+}
+
+/**
+ * @brief Appends an unsigned integer in little-endian byte order.
+ * @param out The buffer.
+ * @param value The value.
+ */
+void append_u64(std::string &out, uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+/**
+ * @brief Reads an unsigned integer in little-endian byte order.
+ * @param bytes The buffer, at least 8 bytes long.
+ * @return The value.
+ */
+uint64_t read_u64(const char *bytes) noexcept {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+    }
+    return value;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructs an empty filter sized for a number of keys.
+ * @param expected_keys The number of keys expected.
+ */
+BloomFilter::BloomFilter(size_t expected_keys)
+    : blocks_(expected_keys / BLOCK_KEYS + 1, Block{}) {}
+
+/**
+ * @brief Hashes a key.
+ * @details wyhash mixes both halves of its result, which select the block and the bits within
+ * it, and unlike the standard library's hash it is the same in every build, so a stored filter
+ * stays valid across compilers and platforms.
+ * @param key The key.
+ * @return The hash.
+ */
+uint64_t BloomFilter::hash(std::string_view key) noexcept {
+    return aevum::util::hash::wyhash(key);
+}
+
+/**
+ * @brief Adds a key by setting one bit in every word of its block.
+ * @param hash The hash of the key.
+ */
+void BloomFilter::insert(uint64_t hash) noexcept {
+    if (blocks_.empty()) return;
+    uint64_t masks[BLOCK_WORDS];
+    lane_masks(hash, masks);
+    Block &block = blocks_[block_of(hash)];
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        block.words[i] |= masks[i];
+    }
+    ++size_;
+}
+
+/**
+ * @brief Tests whether every bit of a key is set in its block.
+ * @details The words are tested without branching, so the whole probe is a handful of vector
+ * instructions on one cache line.
+ * @param hash The hash of the key.
+ * @return `false` only if the key was never added.
+ */
+bool BloomFilter::may_contain(uint64_t hash) const noexcept {
+    if (blocks_.empty()) return true;
+    uint64_t masks[BLOCK_WORDS];
+    lane_masks(hash, masks);
+    const Block &block = blocks_[block_of(hash)];
+    uint64_t missing = 0;
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        missing |= masks[i] & ~block.words[i];
+    }
+    return missing == 0;
+}
+
+/**
+ * @brief Encodes the filter for storage.
+ * @return The encoded filter.
+ */
+std::string BloomFilter::serialize() const {
+    std::string out(FORMAT_TAG);
+    out.reserve(FORMAT_TAG.size() + 16 + blocks_.size() * sizeof(Block));
+    append_u64(out, size_);
+    append_u64(out, blocks_.size());
+    for (const auto &block : blocks_) {
+        for (uint64_t word : block.words) append_u64(out, word);
+    }
+    return out;
+}
+
+/**
+ * @brief Decodes a filter written by `serialize`.
+ * @param bytes The encoded filter.
+ * @return The filter, or `std::nullopt` if the tag or the length does not match.
+ */
+std::optional<BloomFilter> BloomFilter::deserialize(std::string_view bytes) {
+    size_t header = FORMAT_TAG.size() + 16;
+    if (bytes.size() < header || bytes.substr(0, FORMAT_TAG.size()) != FORMAT_TAG) {
+        return std::nullopt;
+    }
+    const char *cursor = bytes.data() + FORMAT_TAG.size();
+    uint64_t size = read_u64(cursor);
+    uint64_t block_count = read_u64(cursor + 8);
+    cursor += 16;
+    if (block_count == 0 || (bytes.size() - header) / sizeof(Block) != block_count ||
+        (bytes.size() - header) % sizeof(Block) != 0) {
+        return std::nullopt;
+    }
+
+    BloomFilter filter;
+    filter.blocks_.resize(block_count);
+    for (auto &block : filter.blocks_) {
+        for (auto &word : block.words) {
+            word = read_u64(cursor);
+            cursor += 8;
+        }
+    }
+    filter.size_ = size;
+    return filter;
+}
+
+}  // namespace aevum::db::index
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bloom_filter.hpp
+ * @brief Declares `BloomFilter`, a blocked Bloom filter that answers most negative key lookups
+ * without touching the structure holding the keys.
+ * @details A classic Bloom filter sets and tests bits scattered over the whole bit array, so a
+ * probe costs one cache miss per hash function. A blocked filter first selects one 64-byte block
+ * from the key's hash and confines all of the key's bits to it, one bit in each of the block's
+ * eight 64-bit words, so a probe costs a single cache line. The eight lanes are computed with the
+ * same multiply and shift, which compilers turn into vector instructions.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aevum::db::index {
+
+/**
+ * @class BloomFilter
+ * @brief A set of keys that can report false positives but never false negatives.
+ *
+ * @details Keys are added and probed by a 64-bit hash, as returned by `hash`. The filter is sized
+ * for a number of keys when it is constructed, with `BITS_PER_KEY` bits per key, which keeps the
+ * false positive rate below one percent up to that number. Keys cannot be removed: a key that has
+ * left the underlying set keeps its bits, so it can only cause a false positive. Once more keys
+ * than the filter was sized for have been added (`is_overfull`), its owner rebuilds it from the
+ * underlying set or discards it.
+ *
+ * The class is not thread-safe; its owner guards it with the lock of the set it summarizes.
+ */
+class BloomFilter {
+  public:
+    /// The number of 64-bit words in a block, and of bits set per key.
+    static constexpr size_t BLOCK_WORDS = 8;
+    /// The number of bits of the filter per key it is sized for.
+    static constexpr size_t BITS_PER_KEY = 16;
+
+    /**
+     * @brief Constructs a filter that reports every key as possibly present.
+     * @details Used as the stand-in for a filter that has not been built; `insert` has no effect.
+     */
+    BloomFilter() = default;
+
+    /**
+     * @brief Constructs an empty filter sized for a number of keys.
+     * @param expected_keys The number of keys the filter is expected to hold; at least one block
+     *        is allocated.
+     */
+    explicit BloomFilter(size_t expected_keys);
+
+    /**
+     * @brief Hashes a key for `insert` and `may_contain`.
+     * @param key The key.
+     * @return The hash.
+     */
+    [[nodiscard]] static uint64_t hash(std::string_view key) noexcept;
+
+    /**
+     * @brief Adds a key.
+     * @param hash The hash of the key.
+     */
+    void insert(uint64_t hash) noexcept;
+
+    /**
+     * @brief Tests whether a key may have been added.
+     * @param hash The hash of the key.
+     * @return `false` only if the key was never added.
+     */
+    [[nodiscard]] bool may_contain(uint64_t hash) const noexcept;
+
+    /**
+     * @brief Returns the number of keys added, counting repeated keys every time.
+     * @return The number of `insert` calls since construction.
+     */
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Returns the number of keys the filter is sized for.
+     * @return The capacity; 0 for a default-constructed filter.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return blocks_.size() * BLOCK_KEYS; }
+
+    /**
+     * @brief Checks whether more keys were added than the filter is sized for.
+     * @return `true` if the false positive rate has grown past its design point.
+     */
+    [[nodiscard]] bool is_overfull() const noexcept { return size_ > capacity(); }
+
+    /**
+     * @brief Encodes the filter for storage.
+     * @return A format tag, the number of keys and blocks, and the blocks' words, in
+     *         little-endian byte order.
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * @brief Decodes a filter written by `serialize`.
+     * @param bytes The encoded filter.
+     * @return The filter, or `std::nullopt` if `bytes` is not a complete encoding of one.
+     */
+    [[nodiscard]] static std::optional<BloomFilter> deserialize(std::string_view bytes);
+
+  private:
+    /// The number of keys a block is sized for.
+    static constexpr size_t BLOCK_KEYS = BLOCK_WORDS * 64 / BITS_PER_KEY;
+
+    /**
+     * @struct Block
+     * @brief The bits of the keys that hash to it, on a cache line of its own.
+     */
+    struct alignas(64) Block {
+        uint64_t words[BLOCK_WORDS];
+    };
+
+    /**
+     * @brief Selects the block of a key.
+     * @param hash The hash of the key.
+     * @return The index of the block, from the upper half of the hash.
+     */
+    [[nodiscard]] size_t block_of(uint64_t hash) const noexcept {
+        return static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32);
+    }
+
+    /// The blocks of the filter.
+    std::vector<Block> blocks_;
+    /// The number of keys added.
+    size_t size_ = 0;
+};
+
+}  // namespace aevum::db::index
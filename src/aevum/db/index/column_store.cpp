@@ -0,0 +1,426 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file column_store.cpp
+ * @brief Implements the `ColumnStore` and its selection kernels.
+ * @details A selection bitmap holds one bit per row, row `i` being bit `i % 64` of word `i / 64`.
+ * The kernels produce one word per 64 rows: with AVX2, four doubles or eight codes are compared
+ * per instruction and the lane masks gathered with `movemask`; with NEON, two doubles or four
+ * codes, with the lane masks weighted and summed. Without either, the portable loop is written
+ * so that the compiler can vectorize it. Build with `AEVUM_NATIVE_ARCH` to enable AVX2 on x86.
+ */
+#include "aevum/db/index/column_store.hpp"
+
+#include <bson/bson.h>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The number of rows covered by one bitmap word.
+constexpr size_t ROWS_PER_WORD = 64;
+
+/**
+ * @brief Returns the number of bitmap words covering a number of rows.
+ * @param rows The number of rows.
+ * @return The number of 64-bit words.
+ */
+size_t bitmap_words(size_t rows) {
+    return (rows + ROWS_PER_WORD - 1) / ROWS_PER_WORD;
+}
+
+/**
+ * @brief Sets the bit of every value in `[lower, upper]`; NaN is in no interval.
+ * @param values The column.
+ * @param rows The number of values.
+ * @param lower The inclusive lower bound.
+ * @param upper The inclusive upper bound.
+ * @param bits Receives `bitmap_words(rows)` words.
+ */
+void select_number_range(const double *values, size_t rows, double lower, double upper,
+                         uint64_t *bits) {
+    const size_t full_words = rows / ROWS_PER_WORD;
+#if defined(__AVX2__)
+    const __m256d lo = _mm256_set1_pd(lower);
+    const __m256d hi = _mm256_set1_pd(upper);
+    for (size_t w = 0; w < full_words; ++w) {
+        const double *block = values + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; j += 4) {
+            __m256d v = _mm256_loadu_pd(block + j);
+            __m256d in = _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ),
+                                       _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+            word |= static_cast<uint64_t>(_mm256_movemask_pd(in)) << j;
+        }
+        bits[w] = word;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const float64x2_t lo = vdupq_n_f64(lower);
+    const float64x2_t hi = vdupq_n_f64(upper);
+    const uint64_t weights_init[2] = {1, 2};
+    const uint64x2_t weights = vld1q_u64(weights_init);
+    for (size_t w = 0; w < full_words; ++w) {
+        const double *block = values + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; j += 2) {
+            float64x2_t v = vld1q_f64(block + j);
+            uint64x2_t in = vandq_u64(vcgeq_f64(v, lo), vcleq_f64(v, hi));
+            word |= vaddvq_u64(vandq_u64(in, weights)) << j;
+        }
+        bits[w] = word;
+    }
+#else
+    for (size_t w = 0; w < full_words; ++w) {
+        const double *block = values + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; ++j) {
+            word |= static_cast<uint64_t>((block[j] >= lower) & (block[j] <= upper)) << j;
+        }
+        bits[w] = word;
+    }
+#endif
+    if (full_words * ROWS_PER_WORD < rows) {
+        uint64_t word = 0;
+        for (size_t i = full_words * ROWS_PER_WORD; i < rows; ++i) {
+            word |= static_cast<uint64_t>((values[i] >= lower) & (values[i] <= upper))
+                    << (i % ROWS_PER_WORD);
+        }
+        bits[full_words] = word;
+    }
+}
+
+/**
+ * @brief Sets the bit of every code equal to `code`.
+ * @param codes The column.
+ * @param rows The number of codes.
+ * @param code The code to select.
+ * @param bits Receives `bitmap_words(rows)` words.
+ */
+void select_code(const uint32_t *codes, size_t rows, uint32_t code, uint64_t *bits) {
+    const size_t full_words = rows / ROWS_PER_WORD;
+#if defined(__AVX2__)
+    const __m256i wanted = _mm256_set1_epi32(static_cast<int>(code));
+    for (size_t w = 0; w < full_words; ++w) {
+        const uint32_t *block = codes + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; j += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + j));
+            __m256 eq = _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, wanted));
+            word |= static_cast<uint64_t>(_mm256_movemask_ps(eq)) << j;
+        }
+        bits[w] = word;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint32x4_t wanted = vdupq_n_u32(code);
+    const uint32_t weights_init[4] = {1, 2, 4, 8};
+    const uint32x4_t weights = vld1q_u32(weights_init);
+    for (size_t w = 0; w < full_words; ++w) {
+        const uint32_t *block = codes + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; j += 4) {
+            uint32x4_t eq = vceqq_u32(vld1q_u32(block + j), wanted);
+            word |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(eq, weights))) << j;
+        }
+        bits[w] = word;
+    }
+#else
+    for (size_t w = 0; w < full_words; ++w) {
+        const uint32_t *block = codes + w * ROWS_PER_WORD;
+        uint64_t word = 0;
+        for (size_t j = 0; j < ROWS_PER_WORD; ++j) {
+            word |= static_cast<uint64_t>(block[j] == code) << j;
+        }
+        bits[w] = word;
+    }
+#endif
+    if (full_words * ROWS_PER_WORD < rows) {
+        uint64_t word = 0;
+        for (size_t i = full_words * ROWS_PER_WORD; i < rows; ++i) {
+            word |= static_cast<uint64_t>(codes[i] == code) << (i % ROWS_PER_WORD);
+        }
+        bits[full_words] = word;
+    }
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero word.
+ * @param word The word.
+ * @return The bit index.
+ */
+unsigned lowest_bit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Finds the last element of a document with a given key.
+ * @param doc The document.
+ * @param field The key.
+ * @param found Receives an iterator positioned on the element.
+ * @return `true` if the document has the field.
+ */
+bool find_last_field(const aevum::bson::doc::Document &doc, const std::string &field,
+                     bson_iter_t &found) {
+    bson_iter_t iter;
+    if (doc.empty() || !doc.get() || !bson_iter_init(&iter, doc.get())) return false;
+    bool present = false;
+    while (bson_iter_next(&iter)) {
+        if (bson_iter_key_len(&iter) == field.size() &&
+            std::memcmp(bson_iter_key(&iter), field.data(), field.size()) == 0) {
+            found = iter;
+            present = true;
+        }
+    }
+    return present;
+}
+
+}  // namespace
+
+/**
+ * @brief Builds the table of a collection.
+ * @details Documents without an `_id` cannot be in the primary index and are skipped.
+ * @param fields The fields with a columnar index.
+ * @param documents Every document of the collection.
+ * @return The table.
+ */
+ColumnStore::Table ColumnStore::build_table(const std::vector<std::string> &fields,
+                                            const DocumentHandles &documents) {
+    Table table;
+    for (const auto &field : fields) {
+        Column &column = table.columns[field];
+        column.numbers.reserve(documents.size());
+        column.strings.reserve(documents.size());
+    }
+    table.ids.reserve(documents.size());
+    table.documents.reserve(documents.size());
+    table.rows.reserve(documents.size());
+    for (const auto &[id, doc] : documents) {
+        if (id.empty() || !doc) continue;
+        if (!table.rows.emplace(id, static_cast<uint32_t>(table.ids.size())).second) continue;
+        table.ids.push_back(id);
+        table.documents.push_back(doc);
+        for (auto &[field, column] : table.columns) {
+            column.numbers.push_back(NAN);
+            column.strings.push_back(0);
+        }
+        fill_row(table, table.ids.size() - 1, *doc);
+    }
+    return table;
+}
+
+/**
+ * @brief Replaces the table of a collection.
+ * @param coll The name of the collection.
+ * @param table The new table.
+ */
+void ColumnStore::install_table(const std::string &coll, Table table) {
+    if (table.columns.empty()) {
+        tables_.erase(coll);
+        return;
+    }
+    tables_[coll] = std::move(table);
+}
+
+/**
+ * @brief Drops the table of a collection.
+ * @param coll The name of the collection.
+ */
+void ColumnStore::clear_table(const std::string &coll) {
+    tables_.erase(coll);
+}
+
+/**
+ * @brief Checks whether a collection has a table.
+ * @param coll The name of the collection.
+ * @return `true` if the collection has a columnar index.
+ */
+bool ColumnStore::has_table(const std::string &coll) const {
+    return tables_.count(coll) != 0;
+}
+
+/**
+ * @brief Estimates the memory held by the table of a collection.
+ * @details Each row is charged its `_id` twice, for `ids` and the key of `rows`, a document
+ * handle, and a hash node; each column its values and each dictionary entry its string and node.
+ * @param coll The name of the collection.
+ * @return The estimate, in bytes.
+ */
+size_t ColumnStore::memory_bytes(const std::string &coll) const {
+    constexpr size_t NODE_BYTES = 64;
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return 0;
+    const Table &table = it->second;
+    size_t bytes = 0;
+    for (const auto &id : table.ids) bytes += 2 * id.capacity() + sizeof(DocumentPtr) + NODE_BYTES;
+    for (const auto &[field, column] : table.columns) {
+        bytes += column.numbers.capacity() * sizeof(double) +
+                 column.strings.capacity() * sizeof(uint32_t);
+        for (const auto &[text, code] : column.codes) bytes += text.capacity() + NODE_BYTES;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Adds a document to a collection's table, or replaces the row of its `_id`.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @param doc The document.
+ */
+void ColumnStore::upsert(const std::string &coll, const std::string &id, DocumentPtr doc) {
+    auto it = tables_.find(coll);
+    if (it == tables_.end() || id.empty() || !doc) return;
+    Table &table = it->second;
+
+    auto [slot, inserted] = table.rows.emplace(id, static_cast<uint32_t>(table.ids.size()));
+    size_t row = slot->second;
+    if (inserted) {
+        table.ids.push_back(id);
+        table.documents.push_back(doc);
+        for (auto &[field, column] : table.columns) {
+            column.numbers.push_back(NAN);
+            column.strings.push_back(0);
+        }
+    } else {
+        table.documents[row] = doc;
+        for (auto &[field, column] : table.columns) {
+            column.numbers[row] = NAN;
+            column.strings[row] = 0;
+        }
+    }
+    fill_row(table, row, *doc);
+}
+
+/**
+ * @brief Removes a document from a collection's table.
+ * @details The last row is moved into the removed one, so the columns stay dense.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ */
+void ColumnStore::remove(const std::string &coll, const std::string &id) {
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return;
+    Table &table = it->second;
+    auto slot = table.rows.find(id);
+    if (slot == table.rows.end()) return;
+
+    size_t row = slot->second;
+    size_t last = table.ids.size() - 1;
+    table.rows.erase(slot);
+    if (row != last) {
+        table.ids[row] = std::move(table.ids[last]);
+        table.documents[row] = std::move(table.documents[last]);
+        for (auto &[field, column] : table.columns) {
+            column.numbers[row] = column.numbers[last];
+            column.strings[row] = column.strings[last];
+        }
+        table.rows[table.ids[row]] = static_cast<uint32_t>(row);
+    }
+    table.ids.pop_back();
+    table.documents.pop_back();
+    for (auto &[field, column] : table.columns) {
+        column.numbers.pop_back();
+        column.strings.pop_back();
+    }
+}
+
+/**
+ * @brief Selects the documents that satisfy every predicate.
+ * @details A string that is not in a column's dictionary is held by no row, so its predicate
+ * selects nothing without scanning. Predicates on fields without a column are ignored, which
+ * only widens the selection.
+ * @param coll The name of the collection.
+ * @param predicates The predicates.
+ * @return Non-owning pointers to the selected documents, in row order.
+ */
+std::vector<const aevum::bson::doc::Document *> ColumnStore::select(
+    const std::string &coll, const std::vector<ColumnPredicate> &predicates) const {
+    std::vector<const aevum::bson::doc::Document *> selected;
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return selected;
+    const Table &table = it->second;
+    const size_t rows = table.ids.size();
+    const size_t words = bitmap_words(rows);
+
+    std::vector<uint64_t> selection(words, ~uint64_t{0});
+    if (rows % ROWS_PER_WORD != 0) {
+        selection[words - 1] = (uint64_t{1} << (rows % ROWS_PER_WORD)) - 1;
+    }
+    std::vector<uint64_t> bits(words);
+    for (const auto &predicate : predicates) {
+        auto column = table.columns.find(predicate.field);
+        if (column == table.columns.end()) continue;
+        if (predicate.test == ColumnTest::STRING_EQUALS) {
+            auto code = column->second.codes.find(predicate.text);
+            if (code == column->second.codes.end()) return selected;
+            select_code(column->second.strings.data(), rows, code->second, bits.data());
+        } else {
+            select_number_range(column->second.numbers.data(), rows, predicate.lower,
+                                predicate.upper, bits.data());
+        }
+        for (size_t w = 0; w < words; ++w) selection[w] &= bits[w];
+    }
+
+    for (size_t w = 0; w < words; ++w) {
+        for (uint64_t word = selection[w]; word != 0; word &= word - 1) {
+            selected.push_back(table.documents[w * ROWS_PER_WORD + lowest_bit(word)].get());
+        }
+    }
+    return selected;
+}
+
+/**
+ * @brief Writes the values of a document into one row of every column.
+ * @param table The table.
+ * @param row The row.
+ * @param doc The document.
+ */
+void ColumnStore::fill_row(Table &table, size_t row, const aevum::bson::doc::Document &doc) {
+    for (auto &[field, column] : table.columns) {
+        bson_iter_t iter;
+        if (!find_last_field(doc, field, iter)) continue;
+        switch (bson_iter_type(&iter)) {
+            case BSON_TYPE_DOUBLE: {
+                double value = bson_iter_double(&iter);
+                if (std::isfinite(value)) column.numbers[row] = value;
+                break;
+            }
+            case BSON_TYPE_INT32:
+                column.numbers[row] = bson_iter_int32(&iter);
+                break;
+            case BSON_TYPE_INT64:
+                column.numbers[row] = static_cast<double>(bson_iter_int64(&iter));
+                break;
+            case BSON_TYPE_UTF8:
+            case BSON_TYPE_SYMBOL: {
+                uint32_t length = 0;
+                const char *text = BSON_ITER_HOLDS_UTF8(&iter) ? bson_iter_utf8(&iter, &length)
+                                                              : bson_iter_symbol(&iter, &length);
+                auto code = column.codes.emplace(std::string(text, length),
+                                                 static_cast<uint32_t>(column.codes.size() + 1));
+                column.strings[row] = code.first->second;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+}  // namespace aevum::db::index
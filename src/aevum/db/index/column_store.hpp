@@ -0,0 +1,195 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file column_store.hpp
+ * @brief Declares the `ColumnStore`, which backs `COLUMNAR` secondary indexes with dense typed
+ * arrays.
+ * @details Filtering a large collection on a few hot fields through the matcher costs a walk of
+ * every document's BSON buffer. A columnar index instead keeps the values of its field in one
+ * contiguous array per collection, with one row per document, so a range predicate becomes a
+ * linear pass over `double`s that the kernels in `column_store.cpp` evaluate with AVX2 or NEON
+ * into a selection bitmap. The bitmaps of all columnar predicates of a query are intersected
+ * before a single document is touched.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/util/hash/string_hash.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @enum ColumnTest
+ * @brief The kinds of predicate a columnar index can evaluate.
+ */
+enum class ColumnTest : uint8_t {
+    /// The field is a number within a closed interval.
+    NUMBER_RANGE = 0,
+    /// The field is a string equal to a given one.
+    STRING_EQUALS = 1
+};
+
+/**
+ * @struct ColumnPredicate
+ * @brief A predicate of the query that is evaluated on a columnar index.
+ * @details A column selection is only ever a superset of the documents the matcher accepts: the
+ * matcher re-checks every selected document, so a predicate may be looser than the query (it is,
+ * for instance, blind to the difference between `1` and `1.0`) but must never be stricter.
+ */
+struct ColumnPredicate {
+    /// The field carrying a `COLUMNAR` index.
+    std::string field;
+    /// The kind of predicate.
+    ColumnTest test = ColumnTest::NUMBER_RANGE;
+    /// The inclusive lower bound of a `NUMBER_RANGE`.
+    double lower = -HUGE_VAL;
+    /// The inclusive upper bound of a `NUMBER_RANGE`.
+    double upper = HUGE_VAL;
+    /// The string a `STRING_EQUALS` predicate compares with.
+    std::string text;
+};
+
+/**
+ * @class ColumnStore
+ * @brief Holds the columnar indexes of every collection.
+ *
+ * @details Each collection with at least one columnar index has a table whose rows are its
+ * documents, held by the same immutable, refcounted handles as the primary index. Numeric values
+ * are kept as `double`, with NaN for a document whose field is missing or not a finite number;
+ * strings are dictionary-encoded into 32-bit codes, with 0 for a document whose field is not a
+ * string. A removed document's row is filled with the last row, so the arrays stay dense. The
+ * dictionary of a column only grows; it is compacted whenever the table is reloaded.
+ *
+ * Values are read as the Rust decoder sees them: the last occurrence of a repeated field counts,
+ * symbols are strings, and non-finite doubles, which the decoder turns into objects, are not
+ * numbers.
+ *
+ * The `ColumnStore` has no lock of its own: the `IndexManager` serializes writers with its
+ * reader-writer lock and lets readers select concurrently.
+ */
+class ColumnStore {
+  public:
+    /// A shared handle to an immutable document, as held by the primary index.
+    using DocumentPtr = std::shared_ptr<const aevum::bson::doc::Document>;
+    /// Documents with their `_id`s.
+    using DocumentHandles = std::vector<std::pair<std::string, DocumentPtr>>;
+
+    /**
+     * @struct Column
+     * @brief The values of one field, one per row.
+     */
+    struct Column {
+        /// The field's number, or NaN if it is not a number.
+        std::vector<double> numbers;
+        /// The dictionary code of the field's string, or 0 if it is not a string.
+        std::vector<uint32_t> strings;
+        /// The code of every string seen; codes start at 1.
+        std::unordered_map<std::string, uint32_t, aevum::util::hash::StringHash> codes;
+    };
+
+    /**
+     * @struct Table
+     * @brief The columnar indexes of one collection, as built by `build_table`.
+     */
+    struct Table {
+        /// The `_id` of each row.
+        std::vector<std::string> ids;
+        /// The document of each row.
+        std::vector<DocumentPtr> documents;
+        /// The row of each `_id`.
+        std::unordered_map<std::string, uint32_t, aevum::util::hash::StringHash> rows;
+        /// The indexed fields and their values.
+        std::unordered_map<std::string, Column> columns;
+    };
+
+    /**
+     * @brief Builds the table of a collection.
+     * @details This does not touch the store, so a table can be built without excluding readers
+     * and then swapped in with `install_table`.
+     * @param fields The fields with a columnar index.
+     * @param documents Every document of the collection.
+     * @return The table, with one row per document in the order of `documents`.
+     */
+    [[nodiscard]] static Table build_table(const std::vector<std::string> &fields,
+                                           const DocumentHandles &documents);
+
+    /**
+     * @brief Replaces the table of a collection.
+     * @param coll The name of the collection.
+     * @param table The new table; one without columns drops the collection's table.
+     */
+    void install_table(const std::string &coll, Table table);
+
+    /**
+     * @brief Drops the table of a collection.
+     * @param coll The name of the collection.
+     */
+    void clear_table(const std::string &coll);
+
+    /**
+     * @brief Checks whether a collection has a table.
+     * @param coll The name of the collection.
+     * @return `true` if at least one field of the collection has a columnar index.
+     */
+    [[nodiscard]] bool has_table(const std::string &coll) const;
+
+    /**
+     * @brief Estimates the memory held by the table of a collection.
+     * @param coll The name of the collection.
+     * @return The bytes of its `_id`s, columns, and dictionaries, or 0 if it has no table.
+     */
+    [[nodiscard]] size_t memory_bytes(const std::string &coll) const;
+
+    /**
+     * @brief Adds a document to a collection's table, or replaces the row of its `_id`.
+     * @details Has no effect if the collection has no table.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     * @param doc The document.
+     */
+    void upsert(const std::string &coll, const std::string &id, DocumentPtr doc);
+
+    /**
+     * @brief Removes a document from a collection's table.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     */
+    void remove(const std::string &coll, const std::string &id);
+
+    /**
+     * @brief Selects the documents that satisfy every predicate.
+     * @details Each predicate is evaluated over its column into a bitmap, the bitmaps are
+     * intersected word by word, and only the surviving rows are resolved to documents.
+     * @warning The pointers remain valid only while the caller excludes writers to the collection.
+     * @param coll The name of the collection.
+     * @param predicates The predicates, on fields with a columnar index.
+     * @return Non-owning pointers to the selected documents, in row order.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> select(
+        const std::string &coll, const std::vector<ColumnPredicate> &predicates) const;
+
+  private:
+    /**
+     * @brief Writes the values of a document into one row of every column.
+     * @param table The table.
+     * @param row The row, which must exist in every column.
+     * @param doc The document.
+     */
+    static void fill_row(Table &table, size_t row, const aevum::bson::doc::Document &doc);
+
+    /// The table of every collection that has one.
+    std::unordered_map<std::string, Table> tables_;
+};
+
+}  // namespace aevum::db::index
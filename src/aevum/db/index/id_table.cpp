@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file id_table.cpp
+ * @brief Implements the open-addressing `IdTable` of the primary index.
+ */
+#include "aevum/db/index/id_table.hpp"
+
+#include <utility>
+
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The smallest number of slots a non-empty table has.
+constexpr size_t MIN_ID_TABLE_CAPACITY = 16;
+
+/**
+ * @brief Returns the number of slots needed to hold a number of entries below the load limit.
+ * @param count The number of entries.
+ * @return A power of two of at least `MIN_ID_TABLE_CAPACITY`.
+ */
+size_t id_table_capacity_for(size_t count) {
+    size_t capacity = MIN_ID_TABLE_CAPACITY;
+    while (capacity / 4 * 3 < count) capacity *= 2;
+    return capacity;
+}
+
+}  // namespace
+
+/**
+ * @brief Hashes an `_id`.
+ * @param id The `_id`.
+ * @return The wyhash of `id`, whose low and high bits are both well mixed, as the shard and the
+ *         probe start need.
+ */
+uint64_t IdTable::hash(std::string_view id) noexcept {
+    return aevum::util::hash::wyhash(id);
+}
+
+/**
+ * @brief Looks up a document.
+ * @param id The `_id`.
+ * @param hash The hash of `id`.
+ * @return The document's handle, or null.
+ */
+const IdTable::DocumentPtr *IdTable::find(std::string_view id, uint64_t hash) const noexcept {
+    size_t slot = find_slot(id, hash);
+    return slot == npos ? nullptr : &slots_[slot].document;
+}
+
+/**
+ * @brief Inserts or replaces a document.
+ * @details The probe for an existing entry remembers the first deleted slot it passes, so that
+ * an insertion after erasures reuses it instead of lengthening the probe sequence.
+ * @param id The `_id`.
+ * @param hash The hash of `id`.
+ * @param document The document.
+ */
+void IdTable::insert_or_assign(std::string_view id, uint64_t hash, DocumentPtr document) {
+    if ((used_ + 1) * 4 > states_.size() * 3) rehash(id_table_capacity_for((size_ + 1) * 2));
+
+    size_t mask = states_.size() - 1;
+    size_t reusable = npos;
+    for (size_t i = probe_start(hash);; i = (i + 1) & mask) {
+        if (states_[i] == SlotState::EMPTY) {
+            if (reusable == npos) {
+                reusable = i;
+                ++used_;
+            }
+            break;
+        }
+        if (states_[i] == SlotState::DELETED) {
+            if (reusable == npos) reusable = i;
+            continue;
+        }
+        if (slots_[i].hash == hash && slots_[i].id == id) {
+            bytes_ -= slots_[i].document ? slots_[i].document->length() : 0;
+            bytes_ += document ? document->length() : 0;
+            slots_[i].document = std::move(document);
+            return;
+        }
+    }
+    states_[reusable] = SlotState::FULL;
+    slots_[reusable].hash = hash;
+    slots_[reusable].id.assign(id.data(), id.size());
+    bytes_ += document ? document->length() : 0;
+    slots_[reusable].document = std::move(document);
+    ++size_;
+}
+
+/**
+ * @brief Removes a document, leaving a deleted marker in its slot.
+ * @param id The `_id`.
+ * @param hash The hash of `id`.
+ * @return `true` if the `_id` was in the table.
+ */
+bool IdTable::erase(std::string_view id, uint64_t hash) noexcept {
+    size_t slot = find_slot(id, hash);
+    if (slot == npos) return false;
+    states_[slot] = SlotState::DELETED;
+    bytes_ -= slots_[slot].document ? slots_[slot].document->length() : 0;
+    slots_[slot].id.clear();
+    slots_[slot].document.reset();
+    --size_;
+    return true;
+}
+
+/**
+ * @brief Grows the table for an expected number of entries.
+ * @param count The number of entries expected.
+ */
+void IdTable::reserve(size_t count) {
+    size_t capacity = id_table_capacity_for(count);
+    if (capacity > states_.size()) rehash(capacity);
+}
+
+/**
+ * @brief Removes every entry and releases the slots.
+ */
+void IdTable::clear() noexcept {
+    states_ = {};
+    slots_ = {};
+    size_ = 0;
+    used_ = 0;
+    bytes_ = 0;
+    shift_ = 64;
+}
+
+/**
+ * @brief Returns the first slot of the probe sequence of a hash.
+ * @param hash The hash.
+ * @return The index of the slot.
+ */
+size_t IdTable::probe_start(uint64_t hash) const noexcept {
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ULL) >> shift_);
+}
+
+/**
+ * @brief Returns the slot holding an `_id`.
+ * @param id The `_id`.
+ * @param hash The hash of `id`.
+ * @return The index of the slot, or `npos`.
+ */
+size_t IdTable::find_slot(std::string_view id, uint64_t hash) const noexcept {
+    if (size_ == 0) return npos;
+    size_t mask = states_.size() - 1;
+    for (size_t i = probe_start(hash);; i = (i + 1) & mask) {
+        if (states_[i] == SlotState::EMPTY) return npos;
+        if (states_[i] == SlotState::FULL && slots_[i].hash == hash && slots_[i].id == id) {
+            return i;
+        }
+    }
+}
+
+/**
+ * @brief Moves every entry into a new array of slots, dropping the deleted markers.
+ * @param capacity The number of slots, a power of two.
+ */
+void IdTable::rehash(size_t capacity) {
+    std::vector<SlotState> states(capacity, SlotState::EMPTY);
+    std::vector<Slot> slots(capacity);
+    unsigned shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) --shift;
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < states_.size(); ++i) {
+        if (states_[i] != SlotState::FULL) continue;
+        size_t j = static_cast<size_t>((slots_[i].hash * 0x9E3779B97F4A7C15ULL) >> shift);
+        while (states[j] != SlotState::EMPTY) j = (j + 1) & mask;
+        states[j] = SlotState::FULL;
+        slots[j] = std::move(slots_[i]);
+    }
+    states_ = std::move(states);
+    slots_ = std::move(slots);
+    used_ = size_;
+    shift_ = shift;
+}
+
+}  // namespace aevum::db::index
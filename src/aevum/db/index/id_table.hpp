@@ -0,0 +1,173 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file id_table.hpp
+ * @brief Declares `IdTable`, the open-addressing hash table behind one shard of the primary
+ * index.
+ * @details A node-based `std::unordered_map<std::string, Document>` costs an allocation and a
+ * pointer chase per entry, and in C++17 can only be searched with a `std::string`, so every
+ * lookup by `std::string_view` first copies the key. `IdTable` keeps its slots in one contiguous
+ * array probed linearly, with a separate array of one-byte slot states so that a probe sequence
+ * mostly touches a single cache line, and it is searched by `std::string_view` with a hash the
+ * caller computes once.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @class IdTable
+ * @brief Maps `_id`s to refcounted, immutable documents.
+ *
+ * @details Documents are held as `std::shared_ptr<const Document>`, so a reader can take a handle
+ * that stays valid after the entry is overwritten or erased, and replacing a document never
+ * copies or moves the others. The table grows by doubling once three quarters of its slots are
+ * occupied or deleted; erased slots are marked deleted and reclaimed on the next growth.
+ *
+ * The class is not thread-safe; `PrimaryIndexer` guards each table with its shard's lock.
+ */
+class IdTable {
+  public:
+    /// A shared handle to an indexed document.
+    using DocumentPtr = std::shared_ptr<const aevum::bson::doc::Document>;
+
+    /**
+     * @brief Hashes an `_id` for `find`, `insert_or_assign`, and `erase`.
+     * @param id The `_id`.
+     * @return The hash.
+     */
+    [[nodiscard]] static uint64_t hash(std::string_view id) noexcept;
+
+    /**
+     * @brief Looks up a document.
+     * @param id The `_id`.
+     * @param hash The hash of `id`, as returned by `hash`.
+     * @return The document's handle, or null if the `_id` is not in the table. The pointer is
+     * valid until the table is next modified.
+     */
+    [[nodiscard]] const DocumentPtr *find(std::string_view id, uint64_t hash) const noexcept;
+
+    /**
+     * @brief Inserts a document, or replaces the document stored under the same `_id`.
+     * @param id The `_id`.
+     * @param hash The hash of `id`.
+     * @param document The document.
+     */
+    void insert_or_assign(std::string_view id, uint64_t hash, DocumentPtr document);
+
+    /**
+     * @brief Removes a document.
+     * @param id The `_id`.
+     * @param hash The hash of `id`.
+     * @return `true` if the `_id` was in the table.
+     */
+    bool erase(std::string_view id, uint64_t hash) noexcept;
+
+    /**
+     * @brief Grows the table so that it holds `count` entries without growing again.
+     * @param count The number of entries expected.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Removes every entry and releases the slots.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Returns the number of entries.
+     * @return The number of documents in the table.
+     */
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Returns the total size of the documents.
+     * @return The sum of the BSON lengths of the documents in the table, in bytes.
+     */
+    [[nodiscard]] size_t bytes() const noexcept { return bytes_; }
+
+    /**
+     * @brief Visits every entry, in slot order.
+     * @tparam Visit A callable taking `(const std::string &id, const DocumentPtr &document)`.
+     * @param visit The visitor; it must not modify the table.
+     */
+    template <typename Visit>
+    void for_each(Visit &&visit) const {
+        for (size_t i = 0; i < states_.size(); ++i) {
+            if (states_[i] == SlotState::FULL) visit(slots_[i].id, slots_[i].document);
+        }
+    }
+
+  private:
+    /// The state of a slot.
+    enum class SlotState : uint8_t {
+        /// Never used since the last growth; ends a probe sequence.
+        EMPTY = 0,
+        /// Holds an entry.
+        FULL = 1,
+        /// Held an entry that was erased; probe sequences continue past it.
+        DELETED = 2
+    };
+
+    /// An entry of the table.
+    struct Slot {
+        /// The hash of `id`, compared before the key itself.
+        uint64_t hash{0};
+        /// The `_id`.
+        std::string id;
+        /// The document.
+        DocumentPtr document;
+    };
+
+    /**
+     * @brief Returns the first slot of the probe sequence of a hash.
+     * @details The hash is spread by a Fibonacci multiplication and its high bits are used, since
+     * `PrimaryIndexer` picks the shard from the low bits of the same hash.
+     * @param hash The hash.
+     * @return The index of the slot.
+     */
+    [[nodiscard]] size_t probe_start(uint64_t hash) const noexcept;
+
+    /**
+     * @brief Returns the slot holding an `_id`.
+     * @param id The `_id`.
+     * @param hash The hash of `id`.
+     * @return The index of the slot, or `npos` if the `_id` is not in the table.
+     */
+    [[nodiscard]] size_t find_slot(std::string_view id, uint64_t hash) const noexcept;
+
+    /**
+     * @brief Moves every entry into a new array of slots.
+     * @param capacity The number of slots, a power of two.
+     */
+    void rehash(size_t capacity);
+
+    /// Returned by `find_slot` for a missing `_id`.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// The state of each slot.
+    std::vector<SlotState> states_;
+    /// The slots; the same size as `states_`.
+    std::vector<Slot> slots_;
+    /// The number of `FULL` slots.
+    size_t size_{0};
+    /// The number of `FULL` and `DELETED` slots.
+    size_t used_{0};
+    /// The sum of the BSON lengths of the documents.
+    size_t bytes_{0};
+    /// `64 - log2(capacity)`, the shift that maps a spread hash onto a slot.
+    unsigned shift_{64};
+};
+
+}  // namespace aevum::db::index
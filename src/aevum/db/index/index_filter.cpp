@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_filter.cpp
+ * @brief Implements the `IndexFilter` of sparse and partial secondary indexes.
+ */
+#include "aevum/db/index/index_filter.hpp"
+
+#include <bson/bson.h>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/db/index/index_key.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @brief Compiles the options of an index.
+ * @details The filter is parsed as the server parses queries, and compiled for the native
+ * matcher from the same text, so that both see the same query.
+ * @param index The name of the index.
+ * @param options The options.
+ * @return The filter, or `std::nullopt` if the partial filter cannot be compiled.
+ */
+std::optional<IndexFilter> IndexFilter::compile(std::string_view index,
+                                                const IndexOptions &options) {
+    IndexFilter filter;
+    filter.options_ = options;
+    filter.fields_ = split_index_fields(index);
+    if (options.partial_filter.empty()) return filter;
+
+    filter.matcher_ = aevum::bson::doc::Matcher::compile(options.partial_filter);
+    bson_iter_t iter;
+    if (!filter.matcher_ ||
+        !aevum::bson::json::parse(options.partial_filter, filter.filter_).ok() ||
+        !bson_iter_init(&iter, filter.filter_.get())) {
+        return std::nullopt;
+    }
+    while (bson_iter_next(&iter)) {
+        filter.filter_paths_.emplace_back(bson_iter_key(&iter), bson_iter_key_len(&iter));
+    }
+    return filter;
+}
+
+/**
+ * @brief Checks whether a document belongs in the index.
+ * @details The cheap test comes first: a sparse index looks its fields up before the filter is
+ * evaluated.
+ * @param doc The document.
+ * @return `true` if the document is to be indexed.
+ */
+bool IndexFilter::admits(const aevum::bson::doc::Document &doc) const {
+    if (options_.sparse) {
+        bool holds_field = false;
+        bson_iter_t value;
+        for (const auto &field : fields_) {
+            if (find_field_path(doc, field, value)) {
+                holds_field = true;
+                break;
+            }
+        }
+        if (!holds_field) return false;
+    }
+    return !matcher_ || matcher_->matches(doc);
+}
+
+}  // namespace aevum::db::index
@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_filter.hpp
+ * @brief Declares the options of sparse and partial secondary indexes, and the `IndexFilter`
+ * that decides which documents such an index holds.
+ * @details A field that most documents lack, or a query that only ever targets a small subset of
+ * the documents, makes an index over the whole collection pay for entries no query reads: an
+ * ordered index keys every missing field as null, and every write re-indexes every document. A
+ * sparse index skips the documents that hold none of its fields, and a partial index those that
+ * do not match its filter query. Either holds fewer entries and costs nothing to maintain for the
+ * documents it skips, but it can only serve a query whose matches it is known to hold.
+ */
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/matcher.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @struct IndexOptions
+ * @brief The options restricting the documents a secondary index holds.
+ */
+struct IndexOptions {
+    /// `true` to index only the documents that hold at least one of the index's fields.
+    bool sparse = false;
+    /// A query, as JSON, that a document must match to be indexed; empty to index every document.
+    std::string partial_filter;
+
+    /**
+     * @brief Checks whether the options restrict nothing.
+     * @return `true` for an index over every document.
+     */
+    [[nodiscard]] bool empty() const noexcept { return !sparse && partial_filter.empty(); }
+
+    /**
+     * @brief Compares two sets of options.
+     * @param other The options to compare with.
+     * @return `true` if both are sparse or neither is, and their filters are spelled alike.
+     */
+    [[nodiscard]] bool operator==(const IndexOptions &other) const noexcept {
+        return sparse == other.sparse && partial_filter == other.partial_filter;
+    }
+};
+
+/**
+ * @brief The options of the secondary indexes that have any.
+ * @details The structure is `collection_name -> {field_name -> IndexOptions}`; an index missing
+ * from it holds every document.
+ */
+using IndexOptionDefinitions =
+    std::unordered_map<std::string, std::unordered_map<std::string, IndexOptions>>;
+
+/**
+ * @class IndexFilter
+ * @brief The compiled options of a sparse or partial index.
+ *
+ * @details The partial filter is compiled for the native `Matcher`, which evaluates it against
+ * each document as it is indexed; a filter only the Rust engine can evaluate is refused. Which
+ * queries the index can serve is decided by the query planner from `fields`, `filter`, and
+ * `filter_paths`.
+ *
+ * An `IndexFilter` is immutable once compiled and may be used from any number of threads.
+ */
+class IndexFilter {
+  public:
+    /**
+     * @brief Compiles the options of an index.
+     * @param index The name of the index: a field path, or several joined by
+     *        `INDEX_FIELD_SEPARATOR`.
+     * @param options The options.
+     * @return The filter, or `std::nullopt` if the partial filter is not a JSON object or uses a
+     *         construct the native matcher does not support.
+     */
+    [[nodiscard]] static std::optional<IndexFilter> compile(std::string_view index,
+                                                            const IndexOptions &options);
+
+    /**
+     * @brief Checks whether a document belongs in the index.
+     * @param doc The document.
+     * @return `true` if the document holds one of the index's fields, should the index be sparse,
+     *         and matches its partial filter, should it have one.
+     */
+    [[nodiscard]] bool admits(const aevum::bson::doc::Document &doc) const;
+
+    /**
+     * @brief Returns the options the filter was compiled from.
+     * @return The options.
+     */
+    [[nodiscard]] const IndexOptions &options() const noexcept { return options_; }
+
+    /**
+     * @brief Returns the field paths the index covers.
+     * @return The paths, in index order.
+     */
+    [[nodiscard]] const std::vector<std::string> &fields() const noexcept { return fields_; }
+
+    /**
+     * @brief Returns the parsed partial filter.
+     * @return The filter document; empty if the index has none.
+     */
+    [[nodiscard]] const aevum::bson::doc::Document &filter() const noexcept { return filter_; }
+
+    /**
+     * @brief Returns the field paths the partial filter tests.
+     * @details A document whose values under these paths do not change keeps being admitted or
+     * not, so an update that touches none of them, nor the index's fields, leaves the index as
+     * it was.
+     * @return The top-level keys of the filter.
+     */
+    [[nodiscard]] const std::vector<std::string> &filter_paths() const noexcept {
+        return filter_paths_;
+    }
+
+  private:
+    IndexFilter() = default;
+
+    /// The options.
+    IndexOptions options_;
+    /// The field paths the index covers.
+    std::vector<std::string> fields_;
+    /// The partial filter, compiled; empty if the index has none.
+    std::optional<aevum::bson::doc::Matcher> matcher_;
+    /// The partial filter, parsed; empty if the index has none.
+    aevum::bson::doc::Document filter_;
+    /// The top-level keys of `filter_`.
+    std::vector<std::string> filter_paths_;
+};
+
+/// A shared handle to a compiled `IndexFilter`, which readers keep past the lock they found it
+/// under.
+using IndexFilterPtr = std::shared_ptr<const IndexFilter>;
+
+}  // namespace aevum::db::index
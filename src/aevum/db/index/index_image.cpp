@@ -0,0 +1,489 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_image.cpp
+ * @brief Implements `IndexImage`, the memory-mapped snapshot of a collection's documents and index
+ * entries.
+ * @details An image is laid out as follows, every integer in the byte order of the host that
+ * wrote it:
+ * - A 64-byte header: the magic `AEVUMIMG`, the format version, a byte order marker, the
+ *   sequence number, the document and index counts, the size and checksum of the body, and the
+ *   length of the collection name.
+ * - The collection name.
+ * - The body: each document as a 32-bit `_id` length, the `_id`, a 32-bit BSON length, and the
+ *   BSON bytes; then each index as its type byte, a 32-bit name length, the name, a 64-bit entry
+ *   count, and each entry as a 32-bit length and the encoded entry.
+ *
+ * The checksum chains `wyhash` over the body in blocks of `CHECKSUM_BLOCK` bytes, each block
+ * seeded with the hash of the previous ones, so that it is computed while the body is streamed
+ * out without holding it in memory.
+ */
+#include "aevum/db/index/index_image.hpp"
+
+#include <bson/bson.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "aevum/db/index/index_persistor.hpp"
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace fs = std::filesystem;
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The first bytes of every image.
+constexpr char MAGIC[8] = {'A', 'E', 'V', 'U', 'M', 'I', 'M', 'G'};
+/// The version of the layout described above.
+constexpr uint32_t VERSION = 1;
+/// Written in host order; read back as another value on a host of the other byte order.
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// The size of the header.
+constexpr size_t HEADER_SIZE = 64;
+/// The size of the blocks the checksum is chained over.
+constexpr size_t CHECKSUM_BLOCK = 1 << 20;
+
+/**
+ * @struct Header
+ * @brief The fields of the header, in file order.
+ */
+struct Header {
+    uint64_t sequence = 0;
+    uint64_t document_count = 0;
+    uint64_t index_count = 0;
+    uint64_t body_size = 0;
+    uint64_t checksum = 0;
+    uint32_t name_length = 0;
+};
+
+/**
+ * @brief Encodes a header.
+ * @param header The header.
+ * @return The `HEADER_SIZE` bytes of the header.
+ */
+std::string encode_header(const Header &header) {
+    std::string bytes(HEADER_SIZE, '\0');
+    char *out = bytes.data();
+    std::memcpy(out, MAGIC, sizeof(MAGIC));
+    std::memcpy(out + 8, &VERSION, 4);
+    std::memcpy(out + 12, &BYTE_ORDER_MARK, 4);
+    std::memcpy(out + 16, &header.sequence, 8);
+    std::memcpy(out + 24, &header.document_count, 8);
+    std::memcpy(out + 32, &header.index_count, 8);
+    std::memcpy(out + 40, &header.body_size, 8);
+    std::memcpy(out + 48, &header.checksum, 8);
+    std::memcpy(out + 56, &header.name_length, 4);
+    return bytes;
+}
+
+/**
+ * @brief Computes the checksum of a body.
+ * @param data The body.
+ * @param size The size of the body.
+ * @return The chained `wyhash` of the body's blocks.
+ */
+uint64_t body_checksum(const uint8_t *data, size_t size) {
+    uint64_t checksum = 0;
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_BLOCK) {
+        size_t length = std::min(CHECKSUM_BLOCK, size - offset);
+        checksum = aevum::util::hash::wyhash(
+            std::string_view(reinterpret_cast<const char *>(data) + offset, length), checksum);
+    }
+    return checksum;
+}
+
+/**
+ * @brief Builds the message of a failed system call.
+ * @param what What failed.
+ * @param path The file it failed on.
+ * @return The message, with the description of `errno`.
+ */
+std::string errno_message(const char *what, const std::string &path) {
+    return std::string(what) + " '" + path + "': " + std::strerror(errno);
+}
+
+/**
+ * @class ImageWriter
+ * @brief Streams the body of an image to a file, computing its checksum on the way.
+ */
+class ImageWriter {
+  public:
+    /**
+     * @brief Starts writing after the header and the name, which are written by `finish`.
+     * @param fd The open file.
+     * @param body_offset The offset of the body in the file.
+     */
+    ImageWriter(int fd, size_t body_offset) : fd_(fd), offset_(body_offset) {
+        block_.reserve(CHECKSUM_BLOCK);
+    }
+
+    /**
+     * @brief Appends bytes to the body.
+     * @param data The bytes.
+     * @param size The number of bytes.
+     */
+    void append(const void *data, size_t size) {
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0 && ok_) {
+            size_t length = std::min(size, CHECKSUM_BLOCK - block_.size());
+            block_.append(bytes, length);
+            bytes += length;
+            size -= length;
+            if (block_.size() == CHECKSUM_BLOCK) flush();
+        }
+    }
+
+    /// Appends a 32-bit length followed by the bytes it counts.
+    void append_sized(std::string_view bytes) {
+        auto length = static_cast<uint32_t>(bytes.size());
+        append(&length, sizeof(length));
+        append(bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief Writes the last block, then the header and the name in front of the body.
+     * @param header The header; its body size and checksum are filled in.
+     * @param collection The name of the collection.
+     * @return `true` if every write succeeded.
+     */
+    bool finish(Header &header, std::string_view collection) {
+        flush();
+        header.body_size = body_size_;
+        header.checksum = checksum_;
+        std::string front = encode_header(header);
+        front.append(collection);
+        return ok_ && write_at(front.data(), front.size(), 0);
+    }
+
+    /// The bytes of the file, header included, once `finish` has returned.
+    [[nodiscard]] size_t file_size() const noexcept { return offset_; }
+
+  private:
+    int fd_;
+    size_t offset_;
+    std::string block_;
+    size_t body_size_ = 0;
+    uint64_t checksum_ = 0;
+    bool ok_ = true;
+
+    /// Hashes and writes the pending block.
+    void flush() {
+        if (block_.empty() || !ok_) return;
+        checksum_ = aevum::util::hash::wyhash(block_, checksum_);
+        ok_ = write_at(block_.data(), block_.size(), offset_);
+        offset_ += block_.size();
+        body_size_ += block_.size();
+        block_.clear();
+    }
+
+    /// Writes bytes at an offset, retrying partial writes.
+    bool write_at(const char *data, size_t size, size_t offset) {
+        while (size > 0) {
+            ssize_t written = ::pwrite(fd_, data, size, static_cast<off_t>(offset));
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            data += written;
+            size -= static_cast<size_t>(written);
+            offset += static_cast<size_t>(written);
+        }
+        return true;
+    }
+};
+
+/**
+ * @class ImageReader
+ * @brief Reads the fields of a body, refusing to read past its end.
+ */
+class ImageReader {
+  public:
+    ImageReader(const uint8_t *data, size_t begin, size_t end)
+        : data_(data), position_(begin), end_(end) {}
+
+    /// Reads a fixed-size integer; returns `false` past the end.
+    template <typename T>
+    bool read(T &value) {
+        if (end_ - position_ < sizeof(T)) return false;
+        std::memcpy(&value, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return true;
+    }
+
+    /// Reads a 32-bit length and the bytes it counts; returns `false` past the end.
+    bool read_sized(std::string_view &bytes) {
+        uint32_t length = 0;
+        if (!read(length) || end_ - position_ < length) return false;
+        bytes = std::string_view(reinterpret_cast<const char *>(data_ + position_), length);
+        position_ += length;
+        return true;
+    }
+
+    /// The offset of the next field.
+    [[nodiscard]] size_t position() const noexcept { return position_; }
+
+  private:
+    const uint8_t *data_;
+    size_t position_;
+    size_t end_;
+};
+
+/**
+ * @brief Synchronizes a directory, so that the names created in it are durable.
+ * @param path The directory.
+ */
+void sync_directory(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return;
+    (void)::fsync(fd);
+    ::close(fd);
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the path of the image of a collection.
+ * @param data_dir The data directory.
+ * @param collection The name of the collection.
+ * @return The path of the image file.
+ */
+std::string IndexImage::path(std::string_view data_dir, std::string_view collection) {
+    static constexpr char HEX[] = "0123456789ABCDEF";
+    std::string name;
+    name.reserve(collection.size() + 4);
+    for (char c : collection) {
+        auto byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || c == '_' || c == '-' || c == '.') {
+            name += c;
+        } else {
+            name += '%';
+            name += HEX[byte >> 4];
+            name += HEX[byte & 0x0F];
+        }
+    }
+    return (fs::path(data_dir) / DIRECTORY / (name + ".img")).string();
+}
+
+/**
+ * @brief Writes the image of a collection.
+ * @details The documents are written from their handles and the entries encoded one at a time,
+ * so the image is never held in memory whole.
+ * @param path The path of the image.
+ * @param collection The name of the collection.
+ * @param sequence The sequence number to stamp the image with.
+ * @param content The documents and entries.
+ * @param bytes Receives the size of the image.
+ * @return `aevum::util::Status::OK()`, or an `IOError`.
+ */
+aevum::util::Status IndexImage::write(const std::string &path, std::string_view collection,
+                                      uint64_t sequence, const IndexImageContent &content,
+                                      size_t &bytes) {
+    fs::path directory = fs::path(path).parent_path();
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        return aevum::util::Status::IOError("Cannot create '" + directory.string() +
+                                            "': " + ec.message());
+    }
+
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return aevum::util::Status::IOError(errno_message("Cannot create", temporary));
+
+    Header header;
+    header.sequence = sequence;
+    header.document_count = content.documents.size();
+    header.index_count = content.indexes.size();
+    header.name_length = static_cast<uint32_t>(collection.size());
+    ImageWriter writer(fd, HEADER_SIZE + collection.size());
+    for (const auto &[id, document] : content.documents) {
+        writer.append_sized(id);
+        const bson_t *bson = document->get();
+        writer.append_sized(std::string_view(reinterpret_cast<const char *>(bson_get_data(bson)),
+                                             bson->len));
+    }
+    for (const auto &index : content.indexes) {
+        auto type = static_cast<uint8_t>(index.type);
+        writer.append(&type, sizeof(type));
+        writer.append_sized(index.field);
+        uint64_t count = index.type == IndexType::ORDERED ? index.ordered.size()
+                                                          : index.hash.size();
+        writer.append(&count, sizeof(count));
+        if (index.type == IndexType::ORDERED) {
+            for (const auto &[key, id] : index.ordered) {
+                writer.append_sized(IndexPersistor::encode_entry(key, id));
+            }
+        } else {
+            for (const auto &[key, id] : index.hash) {
+                writer.append_sized(IndexPersistor::encode_entry(key, id));
+            }
+        }
+    }
+
+    bool written = writer.finish(header, collection) && ::fsync(fd) == 0;
+    int saved_errno = errno;
+    ::close(fd);
+    if (!written) {
+        errno = saved_errno;
+        auto status = aevum::util::Status::IOError(errno_message("Cannot write", temporary));
+        ::unlink(temporary.c_str());
+        return status;
+    }
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        auto status = aevum::util::Status::IOError(errno_message("Cannot rename", temporary));
+        ::unlink(temporary.c_str());
+        return status;
+    }
+    sync_directory(directory.string());
+    bytes = writer.file_size();
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Removes every image under a data directory.
+ * @details Errors are ignored; an image that cannot be removed is still rejected by a later
+ * load if it is stale.
+ * @param data_dir The data directory.
+ */
+void IndexImage::remove_all(std::string_view data_dir) {
+    std::error_code ec;
+    fs::remove_all(fs::path(data_dir) / DIRECTORY, ec);
+}
+
+/**
+ * @brief Maps an image and validates it.
+ * @details The whole body is hashed, which also reads it into the page cache ahead of the load
+ * that follows.
+ * @param path The path of the image.
+ * @param collection The name of the expected collection.
+ * @return `aevum::util::Status::OK()`, an `IOError`, or `Corruption`.
+ */
+aevum::util::Status IndexImage::open(const std::string &path, std::string_view collection) {
+    if (auto status = file_.open(path); !status.ok()) return status;
+    auto corrupt = [&](const char *reason) {
+        return aevum::util::Status::Corruption("Index image '" + path + "' " + reason + ".");
+    };
+
+    const uint8_t *data = file_.data();
+    if (file_.size() < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return corrupt("has no valid header");
+    }
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    std::memcpy(&version, data + 8, 4);
+    std::memcpy(&byte_order, data + 12, 4);
+    if (version != VERSION || byte_order != BYTE_ORDER_MARK) {
+        return corrupt("was written in another format");
+    }
+    Header header;
+    std::memcpy(&header.sequence, data + 16, 8);
+    std::memcpy(&header.document_count, data + 24, 8);
+    std::memcpy(&header.index_count, data + 32, 8);
+    std::memcpy(&header.body_size, data + 40, 8);
+    std::memcpy(&header.checksum, data + 48, 8);
+    std::memcpy(&header.name_length, data + 56, 4);
+
+    size_t body_offset = HEADER_SIZE + header.name_length;
+    if (file_.size() < body_offset || file_.size() - body_offset != header.body_size) {
+        return corrupt("is truncated");
+    }
+    std::string_view name(reinterpret_cast<const char *>(data + HEADER_SIZE),
+                          header.name_length);
+    if (name != collection) return corrupt("belongs to another collection");
+    if (body_checksum(data + body_offset, header.body_size) != header.checksum) {
+        return corrupt("fails its checksum");
+    }
+
+    // Walks the sections once, so that the visits need no bounds checks of their own.
+    ImageReader reader(data, body_offset, file_.size());
+    std::string_view bytes;
+    for (uint64_t i = 0; i < header.document_count; ++i) {
+        if (!reader.read_sized(bytes) || !reader.read_sized(bytes)) {
+            return corrupt("has a truncated document");
+        }
+    }
+    sections_.clear();
+    for (uint64_t i = 0; i < header.index_count; ++i) {
+        uint8_t type = 0;
+        Section section{};
+        if (!reader.read(type) || !reader.read_sized(section.field) ||
+            !reader.read(section.count)) {
+            return corrupt("has a truncated index");
+        }
+        if (type != static_cast<uint8_t>(IndexType::HASH) &&
+            type != static_cast<uint8_t>(IndexType::ORDERED)) {
+            return corrupt("has an index of an unknown type");
+        }
+        section.type = static_cast<IndexType>(type);
+        section.offset = reader.position();
+        for (uint64_t e = 0; e < section.count; ++e) {
+            if (!reader.read_sized(bytes)) return corrupt("has a truncated index entry");
+        }
+        sections_.push_back(section);
+    }
+
+    sequence_ = header.sequence;
+    document_count_ = header.document_count;
+    documents_offset_ = body_offset;
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Visits the documents of the image.
+ * @param visit Called with the `_id` and the BSON bytes of each document.
+ */
+void IndexImage::for_each_document(
+    const std::function<void(std::string_view, const uint8_t *, size_t)> &visit) const {
+    ImageReader reader(file_.data(), documents_offset_, file_.size());
+    std::string_view id;
+    std::string_view bson;
+    for (size_t i = 0; i < document_count_; ++i) {
+        (void)reader.read_sized(id);
+        (void)reader.read_sized(bson);
+        visit(id, reinterpret_cast<const uint8_t *>(bson.data()), bson.size());
+    }
+}
+
+/**
+ * @brief Checks whether the image holds the entries of an index of a given type.
+ * @param field The name of the index.
+ * @param type The expected type.
+ * @return `true` if it does.
+ */
+bool IndexImage::has_index(std::string_view field, IndexType type) const {
+    for (const auto &section : sections_) {
+        if (section.field == field) return section.type == type;
+    }
+    return false;
+}
+
+/**
+ * @brief Visits the encoded entries of an index.
+ * @param field The name of the index.
+ * @param visit Called with each entry.
+ * @return The number of entries visited.
+ */
+size_t IndexImage::for_each_entry(std::string_view field,
+                                  const std::function<void(std::string_view)> &visit) const {
+    for (const auto &section : sections_) {
+        if (section.field != field) continue;
+        ImageReader reader(file_.data(), section.offset, file_.size());
+        std::string_view entry;
+        for (uint64_t e = 0; e < section.count; ++e) {
+            (void)reader.read_sized(entry);
+            visit(entry);
+        }
+        return section.count;
+    }
+    return 0;
+}
+
+}  // namespace aevum::db::index
@@ -0,0 +1,192 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_image.hpp
+ * @brief Declares `IndexImage`, a file holding a snapshot of the documents and index entries of
+ * one collection, which a restart maps instead of reading storage.
+ * @details Loading a collection from WiredTiger costs a cursor step, a page lookup, and often a
+ * decompression per document and per index entry. An image holds the same data in one flat,
+ * sequential file: each document's `_id` and BSON bytes, then the encoded entries of each `HASH`
+ * and `ORDERED` index, as `IndexPersistor::encode_entry` writes them. The file contains no
+ * pointers, only lengths, so it is read through a memory mapping at the speed of the page cache.
+ *
+ * An image is stamped with a change log sequence number. It holds every change of the collection
+ * up to that number, and possibly later ones; the changes it may lack are exactly the records of
+ * the collection the change log holds after it, which the loader re-reads from storage. The
+ * checksum of the body is verified before anything of the image is used.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/util/memory/mapped_file.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @struct IndexImageIndex
+ * @brief The entries of one secondary index, as written to an image.
+ */
+struct IndexImageIndex {
+    /// The name of the index.
+    std::string field;
+    /// The type of the index; `HASH` or `ORDERED`.
+    IndexType type = IndexType::HASH;
+    /// The entries of a `HASH` index.
+    HashEntries hash;
+    /// The entries of an `ORDERED` index, in ascending order.
+    OrderedEntries ordered;
+};
+
+/**
+ * @struct IndexImageContent
+ * @brief What an image of a collection holds, as captured from the indexes.
+ */
+struct IndexImageContent {
+    /// The documents of the collection with their `_id`s.
+    PrimaryIndexer::DocumentHandles documents;
+    /// The secondary indexes that have entries.
+    std::vector<IndexImageIndex> indexes;
+};
+
+/**
+ * @class IndexImage
+ * @brief A validated, read-only mapping of the image of one collection.
+ *
+ * @details The static functions name and write images; an instance maps one and walks its
+ * sections. The instance is not thread-safe, but its const members may be called concurrently.
+ */
+class IndexImage {
+  public:
+    /// The directory of the images, under the data directory.
+    static constexpr std::string_view DIRECTORY = "index-images";
+
+    /**
+     * @brief Returns the path of the image of a collection.
+     * @details The bytes of the name other than letters, digits, `_`, `-`, and `.` are written
+     * as `%XX`, so that every name maps to a distinct file name.
+     * @param data_dir The data directory.
+     * @param collection The name of the collection.
+     * @return `<data_dir>/index-images/<escaped name>.img`.
+     */
+    [[nodiscard]] static std::string path(std::string_view data_dir,
+                                          std::string_view collection);
+
+    /**
+     * @brief Writes the image of a collection, replacing the previous one atomically.
+     * @details The image is written to a temporary file, synchronized, and renamed over `path`,
+     * and the directory is synchronized, so a crash leaves either image whole.
+     * @param path The path of the image.
+     * @param collection The name of the collection.
+     * @param sequence The change log sequence number up to which `content` holds every change.
+     * @param content The documents and entries.
+     * @param bytes Receives the size of the image.
+     * @return `aevum::util::Status::OK()`, or an `IOError` if the file cannot be written.
+     */
+    [[nodiscard]] static aevum::util::Status write(const std::string &path,
+                                                   std::string_view collection, uint64_t sequence,
+                                                   const IndexImageContent &content,
+                                                   size_t &bytes);
+
+    /**
+     * @brief Removes every image under a data directory.
+     * @param data_dir The data directory.
+     */
+    static void remove_all(std::string_view data_dir);
+
+    IndexImage() = default;
+
+    /**
+     * @brief Maps an image and validates it.
+     * @details The header must match this build's format and byte order and name `collection`,
+     * the size must match the header, the checksum must match the body, and the sections must
+     * lie within the body.
+     * @param path The path of the image.
+     * @param collection The name of the collection the image must belong to.
+     * @return `aevum::util::Status::OK()`, an `IOError` if the file cannot be mapped, or
+     *         `Corruption` if it is not a valid image of `collection`.
+     */
+    [[nodiscard]] aevum::util::Status open(const std::string &path, std::string_view collection);
+
+    /**
+     * @brief Returns the sequence number the image was stamped with.
+     * @return The change log sequence number up to which the image holds every change.
+     */
+    [[nodiscard]] uint64_t sequence() const noexcept { return sequence_; }
+
+    /**
+     * @brief Returns the number of documents in the image.
+     * @return The document count.
+     */
+    [[nodiscard]] size_t document_count() const noexcept { return document_count_; }
+
+    /**
+     * @brief Returns the size of the image.
+     * @return The size of the file, in bytes.
+     */
+    [[nodiscard]] size_t size() const noexcept { return file_.size(); }
+
+    /**
+     * @brief Visits the documents of the image in the order they were written.
+     * @param visit Called with the `_id` and the BSON bytes of each document; the bytes stay
+     *        valid as long as the image.
+     */
+    void for_each_document(
+        const std::function<void(std::string_view, const uint8_t *, size_t)> &visit) const;
+
+    /**
+     * @brief Checks whether the image holds the entries of an index.
+     * @param field The name of the index.
+     * @param type The type the index must have.
+     * @return `true` if the image has an index named `field` of type `type`.
+     */
+    [[nodiscard]] bool has_index(std::string_view field, IndexType type) const;
+
+    /**
+     * @brief Visits the encoded entries of an index in the order they were written.
+     * @param field The name of the index.
+     * @param visit Called with each entry, as `IndexPersistor::encode_entry` produced it.
+     * @return The number of entries visited; 0 if the image has no such index.
+     */
+    size_t for_each_entry(std::string_view field,
+                          const std::function<void(std::string_view)> &visit) const;
+
+  private:
+    /**
+     * @struct Section
+     * @brief Where the entries of one index lie in the mapping.
+     */
+    struct Section {
+        /// The name of the index.
+        std::string_view field;
+        /// The type of the index.
+        IndexType type;
+        /// The number of entries.
+        uint64_t count;
+        /// The offset of the first entry in the mapping.
+        size_t offset;
+    };
+
+    /// The mapping of the file.
+    aevum::util::memory::MappedFile file_;
+    /// The sequence number of the header.
+    uint64_t sequence_ = 0;
+    /// The number of documents of the header.
+    size_t document_count_ = 0;
+    /// The offset of the first document in the mapping.
+    size_t documents_offset_ = 0;
+    /// The index sections, in file order.
+    std::vector<Section> sections_;
+};
+
+}  // namespace aevum::db::index
@@ -0,0 +1,262 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_key.cpp
+ * @brief Implements the type-aware key used by ordered secondary indexes.
+ * @details The conversions here must stay in lockstep with `ffi/src/bson/decoder.rs` and
+ * `ffi/src/query/comparator.rs`; otherwise an index scan could return documents in an order the
+ * Rust engine disagrees with.
+ */
+#include "aevum/db/index/index_key.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace aevum::db::index {
+
+/**
+ * @brief Returns the smallest key of a given rank.
+ * @details For `NUMBER` the payload is negative infinity, which never occurs in a stored key
+ * because non-finite doubles are ranked as `OBJECT`.
+ * @param rank The rank whose lower bound is requested.
+ * @return The floor key of `rank`.
+ */
+IndexKey IndexKey::floor(KeyRank rank) {
+    IndexKey key;
+    key.rank = rank;
+    if (rank == KeyRank::NUMBER) {
+        key.number = -std::numeric_limits<double>::infinity();
+    }
+    return key;
+}
+
+/**
+ * @brief Strict weak ordering of keys, following the Rust comparator.
+ * @param other The key to compare against.
+ * @return `true` if this key sorts before `other`.
+ */
+bool IndexKey::operator<(const IndexKey &other) const noexcept {
+    if (rank != other.rank) {
+        return rank < other.rank;
+    }
+    switch (rank) {
+        case KeyRank::BOOL:
+        case KeyRank::NUMBER:
+            return number < other.number;
+        case KeyRank::STRING:
+            return text < other.text;
+        default:
+            // Nulls, arrays, and objects are all equal within their rank.
+            return false;
+    }
+}
+
+/**
+ * @brief Narrows the lower bound of the range.
+ * @details When both bounds are equal, the exclusive one is the tighter.
+ * @param key The candidate lower bound.
+ * @param inclusive `true` if `key` itself is admitted.
+ */
+void KeyRange::tighten_lower(const IndexKey &key, bool inclusive) {
+    if (lower < key) {
+        lower = key;
+        lower_inclusive = inclusive;
+    } else if (!(key < lower) && !inclusive) {
+        lower_inclusive = false;
+    }
+}
+
+/**
+ * @brief Narrows the upper bound of the range.
+ * @details When both bounds are equal, the exclusive one is the tighter.
+ * @param key The candidate upper bound.
+ * @param inclusive `true` if `key` itself is admitted.
+ */
+void KeyRange::tighten_upper(const IndexKey &key, bool inclusive) {
+    if (!upper || key < *upper) {
+        upper = key;
+        upper_inclusive = inclusive;
+    } else if (!(*upper < key) && !inclusive) {
+        upper_inclusive = false;
+    }
+}
+
+/**
+ * @brief Checks whether the range can contain no key at all.
+ * @return `true` if the lower bound lies above the upper bound, or if they are equal and at least
+ *         one of them is exclusive.
+ */
+bool KeyRange::empty() const noexcept {
+    if (!upper) return false;
+    if (*upper < lower) return true;
+    if (lower < *upper) return false;
+    return !(lower_inclusive && upper_inclusive);
+}
+
+/**
+ * @brief Checks whether a key lies inside the range.
+ * @param key The key to test.
+ * @return `true` if `key` satisfies both bounds.
+ */
+bool KeyRange::contains(const IndexKey &key) const noexcept {
+    if (lower_inclusive ? key < lower : !(lower < key)) return false;
+    if (upper && (upper_inclusive ? *upper < key : !(key < *upper))) return false;
+    return true;
+}
+
+/**
+ * @brief Builds the `IndexKey` of the BSON value under an iterator.
+ * @param iter An iterator positioned on the value.
+ * @return The key of the value.
+ */
+IndexKey make_index_key(const bson_iter_t &iter) {
+    IndexKey key;
+    switch (bson_iter_type(&iter)) {
+        case BSON_TYPE_UTF8:
+        case BSON_TYPE_SYMBOL: {
+            uint32_t length = 0;
+            const char *str = BSON_ITER_HOLDS_UTF8(&iter) ? bson_iter_utf8(&iter, &length)
+                                                          : bson_iter_symbol(&iter, &length);
+            key.rank = KeyRank::STRING;
+            key.text.assign(str, length);
+            break;
+        }
+        case BSON_TYPE_INT32:
+            key.rank = KeyRank::NUMBER;
+            key.number = bson_iter_int32(&iter);
+            break;
+        case BSON_TYPE_INT64:
+            key.rank = KeyRank::NUMBER;
+            key.number = static_cast<double>(bson_iter_int64(&iter));
+            break;
+        case BSON_TYPE_DOUBLE: {
+            double value = bson_iter_double(&iter);
+            if (std::isfinite(value)) {
+                key.rank = KeyRank::NUMBER;
+                key.number = value;
+            } else {
+                key.rank = KeyRank::OBJECT;
+            }
+            break;
+        }
+        case BSON_TYPE_BOOL:
+            key.rank = KeyRank::BOOL;
+            key.number = bson_iter_bool(&iter) ? 1.0 : 0.0;
+            break;
+        case BSON_TYPE_NULL:
+        case BSON_TYPE_UNDEFINED:
+        case BSON_TYPE_DECIMAL128:
+        case BSON_TYPE_DBPOINTER:
+        case BSON_TYPE_CODEWSCOPE:
+            key.rank = KeyRank::NULL_VALUE;
+            break;
+        case BSON_TYPE_ARRAY:
+            key.rank = KeyRank::ARRAY;
+            break;
+        default:
+            key.rank = KeyRank::OBJECT;
+            break;
+    }
+    return key;
+}
+
+/**
+ * @brief Builds the `IndexKey` of a top-level field of a document.
+ * @details The whole document is walked, so that the last occurrence of a repeated field wins.
+ * @param doc The document to inspect.
+ * @param field The top-level field whose value is keyed.
+ * @return The key of the field's value, or a `NULL_VALUE` key if the field is missing.
+ */
+IndexKey make_field_key(const aevum::bson::doc::Document &doc, const std::string &field) {
+    bson_iter_t iter;
+    if (doc.empty() || !doc.get() || !bson_iter_init(&iter, doc.get())) {
+        return IndexKey{};
+    }
+    bson_iter_t last;
+    bool found = false;
+    while (bson_iter_next(&iter)) {
+        if (field == bson_iter_key(&iter)) {
+            last = iter;
+            found = true;
+        }
+    }
+    return found ? make_index_key(last) : IndexKey{};
+}
+
+/**
+ * @brief Splits the name of an index into the fields it covers.
+ * @param name The name of the index.
+ * @return The field paths in index order.
+ */
+std::vector<std::string> split_index_fields(std::string_view name) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t end = name.find(INDEX_FIELD_SEPARATOR, start);
+        fields.emplace_back(name.substr(start, end - start));
+        if (end == std::string_view::npos) return fields;
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Locates the value of a field path in a document.
+ * @details Each level is walked in full, so that the last occurrence of a repeated name wins.
+ * @param doc The document to inspect.
+ * @param path The field path.
+ * @param value Receives an iterator positioned on the value.
+ * @return `true` if the path leads to a value.
+ */
+bool find_field_path(const aevum::bson::doc::Document &doc, std::string_view path,
+                     bson_iter_t &value) {
+    bson_iter_t iter;
+    if (doc.empty() || !doc.get() || !bson_iter_init(&iter, doc.get())) return false;
+    size_t start = 0;
+    while (true) {
+        size_t end = path.find('.', start);
+        std::string_view name = path.substr(start, end - start);
+        bool found = false;
+        while (bson_iter_next(&iter)) {
+            if (bson_iter_key_len(&iter) == name.size() &&
+                std::memcmp(bson_iter_key(&iter), name.data(), name.size()) == 0) {
+                value = iter;
+                found = true;
+            }
+        }
+        if (!found) return false;
+        if (end == std::string_view::npos) return true;
+        if (!BSON_ITER_HOLDS_DOCUMENT(&value) || !bson_iter_recurse(&value, &iter)) return false;
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Builds the keys a document contributes to an ordered index on a field path.
+ * @param doc The document to inspect.
+ * @param path The indexed field path.
+ * @return The distinct keys, in ascending order.
+ */
+std::vector<IndexKey> make_path_keys(const aevum::bson::doc::Document &doc,
+                                     std::string_view path) {
+    bson_iter_t value;
+    if (!find_field_path(doc, path, value)) return {IndexKey{}};
+    std::vector<IndexKey> keys{make_index_key(value)};
+    bson_iter_t element;
+    if (!BSON_ITER_HOLDS_ARRAY(&value) || !bson_iter_recurse(&value, &element)) return keys;
+    while (bson_iter_next(&element)) {
+        keys.push_back(make_index_key(element));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const IndexKey &a, const IndexKey &b) {
+                               return !(a < b) && !(b < a);
+                           }),
+               keys.end());
+    return keys;
+}
+
+}  // namespace aevum::db::index
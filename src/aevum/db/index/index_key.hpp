@@ -0,0 +1,276 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_key.hpp
+ * @brief Defines the index types and the type-aware key used by ordered secondary indexes.
+ * @details A hash index keys its postings on a stringified value, which is sufficient for equality
+ * but orders `10` before `9` and cannot answer range predicates. An ordered index instead keys its
+ * entries on an `IndexKey`, whose ordering reproduces `compare_values` in
+ * `ffi/src/query/comparator.rs` for the value the Rust engine decodes from the same BSON element.
+ * An index range scan therefore visits documents in exactly the order the Rust engine would sort
+ * them.
+ */
+#pragma once
+
+#include <bson/bson.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @enum IndexType
+ * @brief Specifies the physical organization of a secondary index.
+ */
+enum class IndexType : uint8_t {
+    /// Postings keyed by the stringified value; supports equality lookups only.
+    HASH = 0,
+    /// Entries kept in `IndexKey` order; supports equality, ranges, and ordered traversal.
+    ORDERED = 1,
+    /// A dense typed column per collection (see `ColumnStore`); supports numeric ranges and
+    /// string equality, evaluated over all documents at once. Built from the documents on load.
+    COLUMNAR = 2,
+    /// Inverted posting lists of the field's words (see `TextIndex`); serves `$text` searches
+    /// ranked by BM25. Built from the documents on load.
+    TEXT = 3
+};
+
+/**
+ * @brief Converts an `IndexType` enumerator into its canonical string representation.
+ * @param type The index type to convert.
+ * @return `"hash"`, `"ordered"`, `"columnar"`, or `"text"`.
+ */
+[[nodiscard]] constexpr std::string_view to_string(IndexType type) noexcept {
+    switch (type) {
+        case IndexType::ORDERED:
+            return "ordered";
+        case IndexType::COLUMNAR:
+            return "columnar";
+        case IndexType::TEXT:
+            return "text";
+        case IndexType::HASH:
+        default:
+            return "hash";
+    }
+}
+
+/**
+ * @brief Parses the canonical string representation of an `IndexType`.
+ * @param name The string to parse (`"hash"`, `"ordered"`, `"columnar"`, or `"text"`).
+ * @return The parsed type, or `std::nullopt` if `name` is not recognized.
+ */
+[[nodiscard]] constexpr std::optional<IndexType> index_type_from_string(
+    std::string_view name) noexcept {
+    if (name == "hash") return IndexType::HASH;
+    if (name == "ordered") return IndexType::ORDERED;
+    if (name == "columnar") return IndexType::COLUMNAR;
+    if (name == "text") return IndexType::TEXT;
+    return std::nullopt;
+}
+
+/**
+ * @brief Checks whether an index type keeps per-document entries in the `SecondaryIndexer`.
+ * @details Columnar and text indexes are held by structures of their own, which are rebuilt
+ * from the documents on load rather than persisted entry by entry.
+ * @param type The index type.
+ * @return `true` for `HASH` and `ORDERED`.
+ */
+[[nodiscard]] constexpr bool has_entries(IndexType type) noexcept {
+    return type == IndexType::HASH || type == IndexType::ORDERED;
+}
+
+/**
+ * @brief The registered secondary index definitions of every collection.
+ * @details The structure is `collection_name -> {field_name -> IndexType}`.
+ */
+using IndexDefinitions =
+    std::unordered_map<std::string, std::unordered_map<std::string, IndexType>>;
+
+/**
+ * @brief The time-to-live of the `ORDERED` indexes that expire documents, in seconds.
+ * @details The structure is `collection_name -> {field_name -> expire_after_seconds}`. A document
+ * expires once the number of seconds since the Unix epoch in its indexed field, plus the index's
+ * time-to-live, is in the past.
+ */
+using TtlDefinitions = std::unordered_map<std::string, std::unordered_map<std::string, int64_t>>;
+
+/**
+ * @enum KeyRank
+ * @brief The type precedence of an `IndexKey`, mirroring `get_type_precedence` in the Rust
+ * comparator.
+ */
+enum class KeyRank : uint8_t {
+    NULL_VALUE = 0,
+    BOOL = 1,
+    NUMBER = 2,
+    STRING = 3,
+    ARRAY = 4,
+    OBJECT = 5
+};
+
+/**
+ * @struct IndexKey
+ * @brief A type-aware, totally ordered key for an ordered secondary index.
+ * @details Keys are ordered first by `rank`, then by `number` for booleans and numbers, and by
+ * `text` (byte-wise) for strings. All arrays compare equal to each other, as do all objects and
+ * all nulls, exactly as in the Rust comparator.
+ */
+struct IndexKey {
+    /// The type precedence of the key.
+    KeyRank rank = KeyRank::NULL_VALUE;
+    /// The numeric payload for `BOOL` (0 or 1) and `NUMBER` keys.
+    double number = 0.0;
+    /// The payload for `STRING` keys.
+    std::string text;
+
+    /**
+     * @brief Returns the smallest key of a given rank.
+     * @param rank The rank whose lower bound is requested.
+     * @return A key that is less than or equal to every key of `rank`.
+     */
+    [[nodiscard]] static IndexKey floor(KeyRank rank);
+
+    /**
+     * @brief Strict weak ordering of keys.
+     * @param other The key to compare against.
+     * @return `true` if this key sorts before `other`.
+     */
+    [[nodiscard]] bool operator<(const IndexKey &other) const noexcept;
+};
+
+/**
+ * @struct KeyRange
+ * @brief A contiguous interval of `IndexKey`s to scan in an ordered index.
+ * @details A default-constructed range covers every key.
+ */
+struct KeyRange {
+    /// The lower bound of the range. The default is the smallest possible key.
+    IndexKey lower;
+    /// `true` if keys equal to `lower` are part of the range.
+    bool lower_inclusive = true;
+    /// The upper bound of the range, or `std::nullopt` if the range is unbounded above.
+    std::optional<IndexKey> upper;
+    /// `true` if keys equal to `upper` are part of the range.
+    bool upper_inclusive = false;
+
+    /**
+     * @brief Narrows the lower bound of the range, keeping the tighter of the two bounds.
+     * @param key The candidate lower bound.
+     * @param inclusive `true` if `key` itself is admitted.
+     */
+    void tighten_lower(const IndexKey &key, bool inclusive);
+
+    /**
+     * @brief Narrows the upper bound of the range, keeping the tighter of the two bounds.
+     * @param key The candidate upper bound.
+     * @param inclusive `true` if `key` itself is admitted.
+     */
+    void tighten_upper(const IndexKey &key, bool inclusive);
+
+    /**
+     * @brief Checks whether the range can contain no key at all.
+     * @return `true` if the lower bound lies above the upper bound.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief Checks whether a key lies inside the range.
+     * @param key The key to test.
+     * @return `true` if `key` satisfies both bounds.
+     */
+    [[nodiscard]] bool contains(const IndexKey &key) const noexcept;
+};
+
+/**
+ * @brief Builds the `IndexKey` of the BSON value under an iterator.
+ * @details The mapping follows the BSON decoder of the Rust engine: strings and symbols become
+ * `STRING`; 32/64-bit integers and finite doubles become `NUMBER`; booleans become `BOOL`; null,
+ * undefined, decimal128, DBPointer, and code-with-scope become `NULL_VALUE`; arrays become `ARRAY`;
+ * every other type (including non-finite doubles, which are emitted as `$numberDouble` wrappers)
+ * becomes `OBJECT`.
+ * @param iter An iterator positioned on the value.
+ * @return The key of the value.
+ */
+[[nodiscard]] IndexKey make_index_key(const bson_iter_t &iter);
+
+/**
+ * @brief Builds the `IndexKey` of a top-level field of a document.
+ * @details A missing field yields a `NULL_VALUE` key, matching the Rust engine, which sorts a
+ * missing field as `null`. If the document repeats the field, its last occurrence is keyed, as
+ * the Rust decoder and the native matcher see it.
+ * @param doc The document to inspect.
+ * @param field The top-level field whose value is keyed.
+ * @return The key of the field's value.
+ */
+[[nodiscard]] IndexKey make_field_key(const aevum::bson::doc::Document &doc,
+                                      const std::string &field);
+
+/// Separates the fields of a compound index in its name, as in `"tenant,status"`.
+constexpr char INDEX_FIELD_SEPARATOR = ',';
+
+/// Separates the components of the key of a compound index entry.
+constexpr char COMPOUND_KEY_SEPARATOR = '\0';
+
+/**
+ * @brief Splits the name of an index into the fields it covers.
+ * @param name The name: a field path, or several joined by `INDEX_FIELD_SEPARATOR`.
+ * @return The field paths in index order. A single field yields a single path.
+ */
+[[nodiscard]] std::vector<std::string> split_index_fields(std::string_view name);
+
+/**
+ * @brief Checks whether an index name covers more than one field.
+ * @param name The name of the index.
+ * @return `true` if the name contains `INDEX_FIELD_SEPARATOR`.
+ */
+[[nodiscard]] constexpr bool is_compound_index(std::string_view name) noexcept {
+    return name.find(INDEX_FIELD_SEPARATOR) != std::string_view::npos;
+}
+
+/**
+ * @brief Locates the value of a field path in a document.
+ * @details A path is a top-level field, or several field names joined by `.` that lead through
+ * embedded documents, as in `"address.city"`. At every level the last occurrence of a repeated
+ * name is followed, as the Rust decoder and the native matcher see it. Arrays are not entered.
+ * @param doc The document to inspect.
+ * @param path The field path.
+ * @param value Receives an iterator positioned on the value.
+ * @return `true` if the path leads to a value, `false` if any of its fields is missing or a
+ *         field before the last one is not an embedded document.
+ */
+[[nodiscard]] bool find_field_path(const aevum::bson::doc::Document &doc, std::string_view path,
+                                   bson_iter_t &value);
+
+/**
+ * @brief Builds the keys a document contributes to an ordered index on a field path.
+ * @details A missing path yields a single `NULL_VALUE` key, as in `make_field_key`. An array
+ * yields its own `ARRAY` key followed by the key of every distinct element, so that ranges and
+ * `$all` on single elements find the document; every other value yields its key alone.
+ * @param doc The document to inspect.
+ * @param path The indexed field path.
+ * @return The distinct keys, in ascending order.
+ */
+[[nodiscard]] std::vector<IndexKey> make_path_keys(const aevum::bson::doc::Document &doc,
+                                                   std::string_view path);
+
+/**
+ * @brief The entries of a hash index on one field, as `(index key, _id)` pairs.
+ * @details The index key is the stringified value produced by `SecondaryIndexer::to_index_key`.
+ */
+using HashEntries = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief The entries of an ordered index on one field, as `(IndexKey, _id)` pairs.
+ */
+using OrderedEntries = std::vector<std::pair<IndexKey, std::string>>;
+
+}  // namespace aevum::db::index
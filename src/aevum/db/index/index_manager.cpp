@@ -12,13 +12,134 @@
  */
 #include "aevum/db/index/index_manager.hpp"
 
+#include <algorithm>
 #include <bson/bson.h>
+#include <iterator>
 #include <mutex>
 
 #include "aevum/util/log/logger.hpp"
 
 namespace aevum::db::index {
 
+namespace {
+
+/**
+ * @brief Encodes the entries a document contributes to an index as storage keys.
+ * @param type The type of the index.
+ * @param filter The filter of the index, or `nullptr`.
+ * @param doc The document.
+ * @param field The name of the index.
+ * @param id The `_id` of the document.
+ * @return The encoded entries in ascending order; empty if the index has no persisted entries
+ *         (`COLUMNAR` or `TEXT`), does not admit the document, or the document has no entry in
+ *         a hash index (its field is missing or of a type that is not indexed).
+ */
+std::vector<std::string> encode_document_entries(IndexType type, const IndexFilter *filter,
+                                                 const aevum::bson::doc::Document &doc,
+                                                 const std::string &field, const std::string &id) {
+    std::vector<std::string> entries;
+    if (filter && !filter->admits(doc)) return entries;
+    if (type == IndexType::ORDERED) {
+        for (const auto &key : make_path_keys(doc, field)) {
+            entries.push_back(IndexPersistor::encode_entry(key, id));
+        }
+    } else if (type == IndexType::HASH) {
+        for (const auto &key : SecondaryIndexer::hash_keys(doc, field)) {
+            entries.push_back(IndexPersistor::encode_entry(key, id));
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+/**
+ * @brief Checks that an index type can cover the fields an index is named after.
+ * @param collection The name of the collection.
+ * @param field The name of the index.
+ * @param type The type of the index.
+ * @return `OK()`, or `InvalidArgument` for an empty or repeated field, a compound index that is
+ *         not a hash index, or a columnar index on an embedded field.
+ */
+aevum::util::Status check_index_fields(const std::string &collection, const std::string &field,
+                                       IndexType type) {
+    std::vector<std::string> fields = split_index_fields(field);
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        const std::string &path = *it;
+        if (path.empty() || path.front() == '.' || path.back() == '.' ||
+            path.find("..") != std::string::npos || std::find(fields.begin(), it, path) != it) {
+            return aevum::util::Status::InvalidArgument("Invalid index field list '" + field +
+                                                        "' for collection '" + collection + "'.");
+        }
+    }
+    if (fields.size() > 1 && type != IndexType::HASH) {
+        return aevum::util::Status::InvalidArgument("Compound index '" + collection + "." + field +
+                                                    "' must be a hash index.");
+    }
+    if (fields.size() > 1 && type == IndexType::TEXT) {
+        return aevum::util::Status::InvalidArgument("Text index '" + collection + "." + field +
+                                                    "' must cover a single field.");
+    }
+    if (type == IndexType::COLUMNAR && field.find('.') != std::string::npos) {
+        return aevum::util::Status::InvalidArgument("Columnar index '" + collection + "." +
+                                                    field + "' must cover a top-level field.");
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Lists the fields of a collection that carry an index of a given type.
+ * @param fields The index definitions of the collection.
+ * @param type The type of index.
+ * @return The fields with an index of that type.
+ */
+std::vector<std::string> fields_of_type(const std::unordered_map<std::string, IndexType> &fields,
+                                        IndexType type) {
+    std::vector<std::string> matching;
+    for (const auto &[field, field_type] : fields) {
+        if (field_type == type) matching.push_back(field);
+    }
+    return matching;
+}
+
+/**
+ * @brief Decodes the entries of an index from an image, leaving out those of changed documents.
+ * @param image The image.
+ * @param field The name of the index.
+ * @param type The type of the index, `HASH` or `ORDERED`.
+ * @param changed The `_id`s whose entries are left out.
+ * @param hash Receives the entries of a `HASH` index.
+ * @param ordered Receives the entries of an `ORDERED` index, in the image's ascending order.
+ * @return The number of malformed entries skipped.
+ */
+size_t decode_image_entries(const IndexImage &image, const std::string &field, IndexType type,
+                            const std::unordered_set<std::string> &changed, HashEntries &hash,
+                            OrderedEntries &ordered) {
+    size_t malformed = 0;
+    std::string id;
+    if (type == IndexType::ORDERED) {
+        IndexKey key;
+        (void)image.for_each_entry(field, [&](std::string_view entry) {
+            if (!IndexPersistor::decode_entry(entry, key, id)) {
+                ++malformed;
+            } else if (changed.count(id) == 0) {
+                ordered.emplace_back(std::move(key), std::move(id));
+            }
+        });
+    } else {
+        std::string key;
+        (void)image.for_each_entry(field, [&](std::string_view entry) {
+            if (!IndexPersistor::decode_entry(entry, key, id)) {
+                ++malformed;
+            } else if (changed.count(id) == 0) {
+                hash.emplace_back(std::move(key), std::move(id));
+            }
+        });
+    }
+    return malformed;
+}
+
+}  // namespace
+
 /**
  * @brief Constructs an `IndexManager`, initializing its subsidiary components.
  * @param storage A reference to the `WiredTigerStore`, which is passed directly to the
@@ -29,21 +150,18 @@ IndexManager::IndexManager(aevum::db::storage::WiredTigerStore &storage)
 
 /**
  * @brief A robust helper function to extract the `_id` field from a BSON document as a string.
- * @details This utility safely inspects a BSON document for a UTF-8 encoded `_id` field. It is
- * used throughout the `IndexManager` to obtain the primary key required for index operations.
+ * @details This utility safely inspects a BSON document for a string or integer `_id` field and
+ * converts it with `PrimaryIndexer::to_id_key`. It is used throughout the `IndexManager` to
+ * obtain the primary key required for index operations.
  * @param doc The `aevum::bson::doc::Document` to inspect.
- * @return A `std::string` containing the `_id`. Returns an empty string if the document is null,
- *         empty, or if the `_id` field is missing or not a valid UTF-8 string.
+ * @return A `std::string` containing the `_id`'s key. Returns an empty string if the document is
+ *         null, empty, or if the `_id` field is missing or neither a string nor an integer.
  */
 std::string IndexManager::extract_id(const aevum::bson::doc::Document &doc) const {
     if (doc.empty() || !doc.get()) return "";
 
     bson_iter_t iter;
-    if (bson_iter_init_find(&iter, doc.get(), "_id") && BSON_ITER_HOLDS_UTF8(&iter)) {
-        uint32_t length;
-        const char *id_str = bson_iter_utf8(&iter, &length);
-        return std::string(id_str, length);
-    }
+    if (bson_iter_init_find(&iter, doc.get(), "_id")) return PrimaryIndexer::to_id_key(iter);
     return "";
 }
 
@@ -54,6 +172,8 @@ std::string IndexManager::extract_id(const aevum::bson::doc::Document &doc) cons
  * to the `PrimaryIndexer` and `SecondaryIndexer` to clear all of their existing index data for
  * the specified collection. Finally, it iterates through the provided `documents` and adds each
  * one back into the primary and secondary indexes, effectively repopulating them from scratch.
+ * The columnar and text indexes and the `_id` filter are then rebuilt from the repopulated
+ * primary index.
  *
  * @param collection The name of the collection whose indexes are being rebuilt.
  * @param documents A vector containing all documents currently in the collection.
@@ -61,16 +181,14 @@ std::string IndexManager::extract_id(const aevum::bson::doc::Document &doc) cons
 void IndexManager::rebuild_index(std::string_view collection,
                                  const std::vector<aevum::bson::doc::Document> &documents) {
     std::string coll_str(collection);
-    aevum::util::log::Logger::debug("IndexManager: Starting full index rebuild for collection '" +
-                                    coll_str + "'.");
+    AEVUM_LOG_DEBUG("IndexManager: Starting full index rebuild for collection '" + coll_str + "'.");
     // Acquire an exclusive write lock to ensure the entire rebuild process is atomic.
     std::unique_lock<std::shared_mutex> lock(rw_lock_);
 
     primary_indexer_.clear_collection_index(coll_str);
     secondary_indexer_.clear_collection_indexes(coll_str);
-    aevum::util::log::Logger::debug(
-        "IndexManager: Cleared all existing primary and secondary index data for '" + coll_str +
-        "'.");
+    AEVUM_LOG_DEBUG("IndexManager: Cleared all existing primary and secondary index data for '" +
+                    coll_str + "'.");
 
     for (const auto &doc : documents) {
         std::string id = extract_id(doc);
@@ -80,87 +198,899 @@ void IndexManager::rebuild_index(std::string_view collection,
         // This will update all relevant secondary indexes for the document.
         secondary_indexer_.update_custom_index(coll_str, doc, true);
     }
-    aevum::util::log::Logger::info(
-        "IndexManager: Successfully rebuilt all indexes for collection '" + coll_str + "' with " +
-        std::to_string(documents.size()) + " documents.");
+    rebuild_id_filter_locked(coll_str);
+    const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+    auto it_coll = definitions.find(coll_str);
+    std::unordered_map<std::string, IndexType> fields;
+    if (it_coll != definitions.end()) fields = it_coll->second;
+    column_store_.install_table(
+        coll_str, build_columns(coll_str, fields_of_type(fields, IndexType::COLUMNAR)));
+    text_index_.install_table(coll_str,
+                              build_text(coll_str, fields_of_type(fields, IndexType::TEXT)));
+    AEVUM_LOG_INFO("IndexManager: Successfully rebuilt all indexes for collection '" + coll_str +
+                   "' with " + std::to_string(documents.size()) + " documents.");
+}
+
+/**
+ * @brief Loads the primary index of a collection from its documents and its secondary indexes
+ * from their persisted entries.
+ * @details This replaces `rebuild_index` when a collection is loaded from storage. Reading an
+ * entry table costs one cursor step per entry and, for an ordered index, appends the entries to
+ * the sorted set in order, instead of extracting, keying, and inserting the field of every
+ * document. Indexes whose entries are missing are built from `documents` as `rebuild_index`
+ * would, and their tables are rewritten so that the next load finds them.
+ *
+ * The work is split in two phases. With only a snapshot of the collection's index definitions
+ * taken under the shared lock, the entry tables are read (or rebuilt) and the documents are moved
+ * into `PrimaryIndexer::DocumentEntries`; this is the storage-bound and allocation-heavy part. Only
+ * then is the exclusive lock acquired to install the results, so concurrent loads of different
+ * collections overlap everything but the installation. Columnar and text indexes, which are not
+ * persisted, are built from the primary index after it is installed and swapped in under the lock
+ * again.
+ * The collection's `_id` filter is built from the documents in the first phase, and replaces any
+ * filter restored by `load_id_filters`.
+ *
+ * @param collection The name of the collection whose indexes are being loaded.
+ * @param documents All documents currently in the collection.
+ */
+void IndexManager::load_collection_indexes(std::string_view collection,
+                                           std::vector<aevum::bson::doc::Document> documents) {
+    load_collection(collection, std::move(documents), nullptr, {}, 0);
+}
+
+/**
+ * @brief Loads the indexes of a collection from its image.
+ * @details Each document is copied out of the mapping into a buffer of its own. Referring to the
+ * mapping in place would tie the lifetime of the file to the last handle of any of its
+ * documents, and the primary index replaces documents by handle as they are updated, so the
+ * image could never be unmapped or rewritten.
+ * @param collection The name of the collection.
+ * @param image The validated image.
+ * @param changed The `_id`s of the documents changed since the image was written.
+ * @param current The current versions of the changed documents that still exist.
+ */
+void IndexManager::load_collection_image(std::string_view collection, const IndexImage &image,
+                                         const std::unordered_set<std::string> &changed,
+                                         std::vector<aevum::bson::doc::Document> current) {
+    std::vector<aevum::bson::doc::Document> documents;
+    documents.reserve(image.document_count() + current.size());
+    image.for_each_document([&](std::string_view id, const uint8_t *data, size_t size) {
+        if (changed.count(std::string(id)) != 0) return;
+        bson_t *bson = bson_new_from_data(data, size);
+        if (bson != nullptr) documents.emplace_back(bson);
+    });
+    size_t changed_from = documents.size();
+    documents.insert(documents.end(), std::make_move_iterator(current.begin()),
+                     std::make_move_iterator(current.end()));
+    current.clear();
+    load_collection(collection, std::move(documents), &image, changed, changed_from);
+}
+
+/**
+ * @brief Captures what the image of a collection holds.
+ * @param collection The name of the collection.
+ * @return The document handles and the copied entries.
+ */
+IndexImageContent IndexManager::capture_image(std::string_view collection) const {
+    std::string coll_str(collection);
+    IndexImageContent content;
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    content.documents = primary_indexer_.get_document_handles(collection);
+    const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+    auto it_coll = definitions.find(coll_str);
+    if (it_coll == definitions.end()) return content;
+    for (const auto &[field, type] : it_coll->second) {
+        if (!has_entries(type)) continue;
+        IndexImageIndex &index = content.indexes.emplace_back();
+        index.field = field;
+        index.type = type;
+        if (type == IndexType::ORDERED) {
+            secondary_indexer_.copy_entries(coll_str, field, index.ordered);
+        } else {
+            secondary_indexer_.copy_entries(coll_str, field, index.hash);
+        }
+    }
+    return content;
+}
+
+/**
+ * @brief Loads the indexes of a collection from its documents, its persisted entries, and
+ * optionally its image.
+ * @details An index the image holds takes its entries from the image, minus those of the changed
+ * documents, plus the entries computed from the current versions of these. An ordered index
+ * merges the latter into the image's sorted entries. Every other index is loaded as
+ * `load_collection_indexes` describes.
+ * @param collection The name of the collection.
+ * @param documents All documents of the collection.
+ * @param image The image, or `nullptr`.
+ * @param changed The `_id`s whose image entries are outdated.
+ * @param changed_from The position of the first current version of a changed document.
+ */
+void IndexManager::load_collection(std::string_view collection,
+                                   std::vector<aevum::bson::doc::Document> documents,
+                                   const IndexImage *image,
+                                   const std::unordered_set<std::string> &changed,
+                                   size_t changed_from) {
+    std::string coll_str(collection);
+    std::unordered_map<std::string, IndexType> fields;
+    std::unordered_map<std::string, IndexFilterPtr> filters;
+    {
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+        auto it_coll = definitions.find(coll_str);
+        if (it_coll != definitions.end()) fields = it_coll->second;
+        filters = secondary_indexer_.index_filters(coll_str);
+    }
+
+    struct LoadedIndex {
+        const std::string *field;
+        IndexType type;
+        HashEntries hash;
+        OrderedEntries ordered;
+    };
+    std::vector<LoadedIndex> loaded_indexes;
+    loaded_indexes.reserve(fields.size());
+    size_t restored = 0;
+    size_t imaged = 0;
+    std::vector<std::string> columnar = fields_of_type(fields, IndexType::COLUMNAR);
+    std::vector<std::string> text = fields_of_type(fields, IndexType::TEXT);
+    for (const auto &[field, type] : fields) {
+        // Columnar and text indexes have no persisted entries; they are built once the documents
+        // are in the primary index.
+        if (!has_entries(type)) continue;
+        LoadedIndex &index = loaded_indexes.emplace_back();
+        index.field = &field;
+        index.type = type;
+        auto it_filter = filters.find(field);
+        const IndexFilter *filter = it_filter == filters.end() ? nullptr : it_filter->second.get();
+        if (image != nullptr && image->has_index(field, type)) {
+            size_t malformed =
+                decode_image_entries(*image, field, type, changed, index.hash, index.ordered);
+            if (malformed > 0) {
+                AEVUM_LOG_WARN("IndexManager: Skipped " + std::to_string(malformed) +
+                               " malformed entries of index '" + coll_str + "." + field +
+                               "' in its image.");
+            }
+            size_t sorted = index.ordered.size();
+            std::vector<std::string> keys;
+            for (size_t i = changed_from; i < documents.size(); ++i) {
+                collect_field_entry(field, type, filter, documents[i], index.hash, index.ordered,
+                                    keys);
+            }
+            if (index.ordered.size() > sorted) {
+                auto middle = index.ordered.begin() + static_cast<std::ptrdiff_t>(sorted);
+                std::sort(middle, index.ordered.end());
+                std::inplace_merge(index.ordered.begin(), middle, index.ordered.end());
+            }
+            ++imaged;
+            continue;
+        }
+        bool loaded = type == IndexType::ORDERED
+                          ? index_persistor_.load_index_entries(coll_str, field, index.ordered)
+                          : index_persistor_.load_index_entries(coll_str, field, index.hash);
+        bool missing = index.hash.empty() && index.ordered.empty() && !documents.empty();
+        if (loaded && !missing) {
+            ++restored;
+            continue;
+        }
+
+        index.hash.clear();
+        index.ordered.clear();
+        std::vector<std::string> keys;
+        collect_field_entries(field, type, filter, documents, index.hash, index.ordered, keys);
+        if (keys.empty()) continue;
+        AEVUM_LOG_INFO("IndexManager: Building index '" + coll_str + "." + field +
+                       "' from documents, as its entries are not persisted.");
+        if (!index_persistor_.store_index_entries(coll_str, field, std::move(keys))) {
+            AEVUM_LOG_WARN("IndexManager: Index '" + coll_str + "." + field +
+                           "' will be rebuilt on next load.");
+        }
+    }
+
+    size_t document_count = documents.size();
+    PrimaryIndexer::DocumentEntries by_id;
+    by_id.reserve(document_count);
+    BloomFilter id_filter(2 * document_count);
+    for (auto &doc : documents) {
+        std::string id = extract_id(doc);
+        if (id.empty()) continue;
+        id_filter.insert(BloomFilter::hash(id));
+        by_id.emplace_back(std::move(id), std::move(doc));
+    }
+    documents.clear();
+
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    primary_indexer_.load_collection(coll_str, std::move(by_id));
+    id_filters_[coll_str] = std::move(id_filter);
+    secondary_indexer_.clear_collection_indexes(coll_str);
+    for (auto &index : loaded_indexes) {
+        if (index.type == IndexType::ORDERED) {
+            secondary_indexer_.load_entries(coll_str, *index.field, std::move(index.ordered));
+        } else {
+            secondary_indexer_.load_entries(coll_str, *index.field, std::move(index.hash));
+        }
+    }
+    lock.unlock();
+
+    if (!columnar.empty()) {
+        // The caller excludes writers to the collection, so the table cannot miss a change made
+        // between the two lock scopes.
+        ColumnStore::Table table = build_columns(coll_str, columnar);
+        lock.lock();
+        column_store_.install_table(coll_str, std::move(table));
+        lock.unlock();
+    }
+    if (!text.empty()) {
+        TextIndex::Table table = build_text(coll_str, text);
+        lock.lock();
+        text_index_.install_table(coll_str, std::move(table));
+        lock.unlock();
+    }
+
+    if (fields.empty()) {
+        AEVUM_LOG_INFO("IndexManager: Loaded " + std::to_string(document_count) +
+                       " documents into the primary index of '" + coll_str + "'.");
+        return;
+    }
+    std::string from_image =
+        image == nullptr ? "" : " took " + std::to_string(imaged) + " from its image,";
+    AEVUM_LOG_INFO("IndexManager: Loaded collection '" + coll_str + "' with " +
+                   std::to_string(document_count) + " documents;" + from_image + " restored " +
+                   std::to_string(restored) + " of " +
+                   std::to_string(fields.size() - columnar.size() - text.size()) +
+                   " secondary indexes from storage and built " + std::to_string(columnar.size()) +
+                   " columnar and " + std::to_string(text.size()) + " text indexes.");
+}
+
+/**
+ * @brief Releases the documents and index entries of a collection.
+ * @details The documents are freed once no reader holds their handles any longer. Writes to the
+ * collection while it is unloaded are added to its `_id` filter by `add_unloaded_ids`, so the
+ * filter stays exact.
+ * @param collection The name of the collection.
+ */
+void IndexManager::unload_collection_indexes(std::string_view collection) {
+    std::string coll_str(collection);
+    size_t document_count = primary_indexer_.document_count(collection);
+    {
+        std::unique_lock<std::shared_mutex> lock(rw_lock_);
+        primary_indexer_.clear_collection_index(coll_str);
+        secondary_indexer_.clear_collection_indexes(coll_str);
+        column_store_.clear_table(coll_str);
+        text_index_.install_table(coll_str, TextIndex::Table{});
+    }
+    AEVUM_LOG_INFO("IndexManager: Unloaded " + std::to_string(document_count) +
+                   " documents of collection '" + coll_str + "' from the indexes.");
+}
+
+/**
+ * @brief Computes the entries of an index on one field from a set of documents.
+ * @details Ordered entries are sorted before they are returned, so that they can be appended to
+ * the sorted set in order.
+ * @param field The indexed field.
+ * @param type The type of the index.
+ * @param filter The filter of the index, or `nullptr`.
+ * @param documents The documents to index.
+ * @param hash Receives the entries of a hash index.
+ * @param ordered Receives the entries of an ordered index.
+ * @param keys Receives the encoded entries.
+ */
+void IndexManager::collect_field_entries(const std::string &field, IndexType type,
+                                         const IndexFilter *filter,
+                                         const std::vector<aevum::bson::doc::Document> &documents,
+                                         HashEntries &hash, OrderedEntries &ordered,
+                                         std::vector<std::string> &keys) const {
+    if (!has_entries(type)) return;
+    keys.reserve(documents.size());
+    for (const auto &doc : documents) {
+        collect_field_entry(field, type, filter, doc, hash, ordered, keys);
+    }
+    std::sort(ordered.begin(), ordered.end());
+}
+
+/**
+ * @brief Computes the entries of an index on one field from one document.
+ * @param field The indexed field.
+ * @param type The type of the index.
+ * @param filter The filter of the index, or `nullptr`.
+ * @param doc The document to index.
+ * @param hash Receives the entry of a hash index.
+ * @param ordered Receives the entry of an ordered index.
+ * @param keys Receives the encoded entry.
+ */
+void IndexManager::collect_field_entry(const std::string &field, IndexType type,
+                                       const IndexFilter *filter,
+                                       const aevum::bson::doc::Document &doc, HashEntries &hash,
+                                       OrderedEntries &ordered,
+                                       std::vector<std::string> &keys) const {
+    if (filter && !filter->admits(doc)) return;
+    std::string id = extract_id(doc);
+    if (id.empty()) return;
+
+    if (type == IndexType::ORDERED) {
+        for (auto &key : make_path_keys(doc, field)) {
+            keys.push_back(IndexPersistor::encode_entry(key, id));
+            ordered.emplace_back(std::move(key), id);
+        }
+        return;
+    }
+
+    for (auto &key : SecondaryIndexer::hash_keys(doc, field)) {
+        keys.push_back(IndexPersistor::encode_entry(key, id));
+        hash.emplace_back(std::move(key), id);
+    }
+}
+
+/**
+ * @brief Computes the writes that keep the persisted index entries in step with a document
+ * change.
+ * @param collection The name of the collection.
+ * @param before The previous image of the document, or `nullptr`.
+ * @param after The new image of the document, or `nullptr`.
+ * @return One removal per stale entry and one insertion per new entry.
+ */
+std::vector<aevum::db::storage::KeyWrite> IndexManager::index_entry_writes(
+    std::string_view collection, const aevum::bson::doc::Document *before,
+    const aevum::bson::doc::Document *after) const {
+    std::vector<aevum::db::storage::KeyWrite> writes;
+    std::string coll_str(collection);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+
+    const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+    auto it_coll = definitions.find(coll_str);
+    if (it_coll == definitions.end()) return writes;
+
+    std::string before_id = before ? extract_id(*before) : "";
+    std::string after_id = after ? extract_id(*after) : "";
+    std::unordered_map<std::string, IndexFilterPtr> filters =
+        secondary_indexer_.index_filters(coll_str);
+    for (const auto &[field, type] : it_coll->second) {
+        auto it_filter = filters.find(field);
+        const IndexFilter *filter = it_filter == filters.end() ? nullptr : it_filter->second.get();
+        std::vector<std::string> old_entries;
+        std::vector<std::string> new_entries;
+        if (!before_id.empty()) {
+            old_entries = encode_document_entries(type, filter, *before, field, before_id);
+        }
+        if (!after_id.empty()) {
+            new_entries = encode_document_entries(type, filter, *after, field, after_id);
+        }
+        if (old_entries == new_entries) continue;
+
+        std::string table = IndexPersistor::entry_table(coll_str, field);
+        std::vector<std::string> stale;
+        std::vector<std::string> added;
+        std::set_difference(old_entries.begin(), old_entries.end(), new_entries.begin(),
+                            new_entries.end(), std::back_inserter(stale));
+        std::set_difference(new_entries.begin(), new_entries.end(), old_entries.begin(),
+                            old_entries.end(), std::back_inserter(added));
+        for (auto &entry : stale) writes.push_back({table, std::move(entry), true});
+        for (auto &entry : added) writes.push_back({table, std::move(entry), false});
+    }
+    return writes;
 }
 
 /**
- * @brief Creates a new secondary index on a field, backfills it with existing data, and persists
- * the definition.
- * @details This method orchestrates the entire process of introducing a new secondary index. It
- * first acquires an exclusive lock to check if the index already exists; if so, it returns
- * immediately. If not, it registers the new field with the `SecondaryIndexer`. It then triggers a
- * full `rebuild_index` to populate the new index with all existing documents. Finally, it calls
- * `persist_index_definitions` to ensure the new index configuration is saved durably.
+ * @brief Creates a new secondary index on a field, backfills it online, and persists the
+ * definition.
+ * @details Under the exclusive `writers` lock, the request is checked against the existing
+ * indexes and the builds in flight, and the build is registered, so that every later write to
+ * the collection lands in its side buffer through `note_build_write`. The lock is then dropped
+ * and the backfill runs concurrently with queries and writes: the documents are read as shared
+ * handles one shard at a time, which only briefly takes each shard's own lock, and their entries
+ * are written to the entry table with a sorted bulk load.
+ *
+ * The catch-up runs under `writers` held exclusively again. The entries of every `_id` in the
+ * side buffer are dropped from the scanned ones and recomputed from the document the primary
+ * index now holds, if any, and the difference is applied to the entry table in one transaction.
+ * Only then is the field registered with the `SecondaryIndexer`, together with the same entries,
+ * and `persist_index_definition` called. A crash before that point leaves an unreferenced entry
+ * table, which the next `create_index` on the field replaces. A `COLUMNAR` or `TEXT` index is
+ * handed to `create_columnar_index` or `create_text_index` without releasing `writers`.
  *
  * @param collection The name of the collection on which to create the index.
  * @param field The name of the field to be indexed.
- * @param existing_documents A vector of all documents currently in the collection, required for
- * backfilling.
- * @return `aevum::util::Status::OK()` on success. Returns an error status if the final persistence
- * step fails.
- */
-aevum::util::Status IndexManager::create_index(
-    std::string_view collection, std::string_view field,
-    const std::vector<aevum::bson::doc::Document> &existing_documents) {
+ * @param type The organization of the new index.
+ * @param writers The writer lock of the collection.
+ * @param expire_after_seconds The time-to-live of a TTL index, recorded when the index is
+ * published, or at once for an ordered index that already exists.
+ * @param options The options of a sparse or partial index, compiled into its `IndexFilter`
+ * before anything else is done.
+ * @return `aevum::util::Status::OK()` on success. Returns an error status if the entries or the
+ * definition cannot be persisted.
+ */
+aevum::util::Status IndexManager::create_index(std::string_view collection,
+                                               std::string_view field, IndexType type,
+                                               std::shared_mutex &writers,
+                                               std::optional<int64_t> expire_after_seconds,
+                                               const IndexOptions &options) {
     std::string coll_str(collection);
     std::string field_str(field);
-    aevum::util::log::Logger::debug("IndexManager: Request to create index on '" + coll_str + "." +
-                                    field_str + "'.");
+    AEVUM_LOG_DEBUG("IndexManager: Request to create index on '" + coll_str + "." + field_str +
+                    "'.");
 
+    if (auto status = check_index_fields(coll_str, field_str, type); !status.ok()) {
+        return status;
+    }
+    if (expire_after_seconds && (type != IndexType::ORDERED || *expire_after_seconds < 0)) {
+        return aevum::util::Status::InvalidArgument(
+            "TTL index '" + coll_str + "." + field_str +
+            "' must be an ordered index on one field with a non-negative expire_after_seconds.");
+    }
+    IndexFilterPtr filter;
+    if (!options.empty()) {
+        if (!has_entries(type)) {
+            return aevum::util::Status::InvalidArgument(
+                "A " + std::string(to_string(type)) + " index such as '" + coll_str + "." +
+                field_str + "' cannot be sparse or partial.");
+        }
+        auto compiled = IndexFilter::compile(field_str, options);
+        if (!compiled) {
+            return aevum::util::Status::InvalidArgument(
+                "Invalid partial_filter for index '" + coll_str + "." + field_str +
+                "': it must be a query object the native matcher supports.");
+        }
+        filter = std::make_shared<const IndexFilter>(std::move(*compiled));
+    }
+
+    std::unique_lock<std::shared_mutex> writers_lock(writers);
     {
-        // Scope for a write lock to modify the index field definitions.
-        std::unique_lock<std::shared_mutex> lock(rw_lock_);
-        if (secondary_indexer_.is_field_indexed(coll_str, field_str)) {
-            aevum::util::log::Logger::warn("IndexManager: Index on '" + coll_str + "." + field_str +
-                                           "' already exists. No action taken.");
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        if (auto existing = secondary_indexer_.get_index_type(coll_str, field_str)) {
+            if (*existing != type) {
+                return aevum::util::Status::InvalidArgument(
+                    "Index on '" + coll_str + "." + field_str + "' already exists with type '" +
+                    std::string(to_string(*existing)) + "'.");
+            }
+            IndexFilterPtr existing_filter = secondary_indexer_.index_filter(coll_str, field_str);
+            if (!(existing_filter ? existing_filter->options() == options : options.empty())) {
+                return aevum::util::Status::InvalidArgument(
+                    "Index on '" + coll_str + "." + field_str +
+                    "' already exists with different sparse or partial_filter options.");
+            }
+            if (expire_after_seconds) {
+                lock.unlock();
+                {
+                    std::unique_lock<std::shared_mutex> ttl_lock(rw_lock_);
+                    ttl_indexes_[coll_str][field_str] = *expire_after_seconds;
+                }
+                AEVUM_LOG_INFO("IndexManager: Set the time-to-live of '" + coll_str + "." +
+                               field_str + "' to " + std::to_string(*expire_after_seconds) +
+                               " seconds.");
+                return persist_index_definition(coll_str, field_str);
+            }
+            AEVUM_LOG_WARN("IndexManager: Index on '" + coll_str + "." + field_str +
+                           "' already exists. No action taken.");
             return aevum::util::Status::OK();  // Index already exists, operation is idempotent.
         }
-        secondary_indexer_.add_indexed_field(coll_str, field_str);
-        aevum::util::log::Logger::info("IndexManager: Registered new secondary index for '" +
-                                       coll_str + "." + field_str + "'.");
     }
+    if (type == IndexType::COLUMNAR) return create_columnar_index(coll_str, field_str);
+    if (type == IndexType::TEXT) return create_text_index(coll_str, field_str);
+
+    auto build = std::make_shared<IndexBuild>();
+    build->collection = coll_str;
+    build->field = field_str;
+    build->type = type;
+    build->documents.store(primary_indexer_.document_count(coll_str), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(builds_mutex_);
+        for (const auto &other : builds_) {
+            if (other->collection == coll_str && other->field == field_str) {
+                return aevum::util::Status::InvalidArgument(
+                    "Index on '" + coll_str + "." + field_str + "' is already being built.");
+            }
+        }
+        builds_.push_back(build);
+        active_builds_.store(builds_.size(), std::memory_order_release);
+    }
+    writers_lock.unlock();
+    AEVUM_LOG_INFO("IndexManager: Building " + std::string(to_string(type)) + " index on '" +
+                   coll_str + "." + field_str + "' in the background over " +
+                   std::to_string(build->documents.load(std::memory_order_relaxed)) +
+                   " documents.");
+
+    // Backfill from a shard-by-shard snapshot of the primary index and persist the entries.
+    HashEntries hash;
+    OrderedEntries ordered;
+    std::vector<std::string> keys;
+    keys.reserve(build->documents.load(std::memory_order_relaxed));
+    for (size_t shard = 0; shard < PrimaryIndexer::SHARD_COUNT; ++shard) {
+        PrimaryIndexer::DocumentHandles handles =
+            primary_indexer_.get_document_handles(coll_str, shard, shard + 1);
+        for (const auto &handle : handles) {
+            collect_field_entry(field_str, type, filter.get(), *handle.second, hash, ordered,
+                                keys);
+        }
+        build->scanned.fetch_add(handles.size(), std::memory_order_relaxed);
+    }
+    std::sort(ordered.begin(), ordered.end());
+    if (!index_persistor_.store_index_entries(coll_str, field_str, std::move(keys))) {
+        writers_lock.lock();
+        end_index_build(build);
+        return aevum::util::Status::IOError("Failed to persist the entries of index '" +
+                                            coll_str + "." + field_str + "'.");
+    }
+
+    // Catch up with the writes made meanwhile; no write is in flight while `writers` is held.
+    writers_lock.lock();
+    std::unordered_set<std::string> written = end_index_build(build);
+    std::string table = IndexPersistor::entry_table(coll_str, field_str);
+    std::vector<aevum::db::storage::KeyWrite> writes;
+    auto drop_written = [&](auto &entries) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&](const auto &entry) {
+                                         if (!written.count(entry.second)) return false;
+                                         writes.push_back({table,
+                                                           IndexPersistor::encode_entry(
+                                                               entry.first, entry.second),
+                                                           true});
+                                         return true;
+                                     }),
+                      entries.end());
+    };
+    drop_written(hash);
+    drop_written(ordered);
+
+    HashEntries fresh_hash;
+    OrderedEntries fresh_ordered;
+    std::vector<std::string> fresh_keys;
+    for (const auto &id : written) {
+        if (const auto *doc = primary_indexer_.get_document_ref(coll_str, id)) {
+            collect_field_entry(field_str, type, filter.get(), *doc, fresh_hash, fresh_ordered,
+                                fresh_keys);
+        }
+    }
+    for (auto &key : fresh_keys) writes.push_back({table, std::move(key), false});
+    if (!writes.empty() && !index_persistor_.write_index_entries(coll_str, writes)) {
+        return aevum::util::Status::IOError("Failed to persist the entries of index '" +
+                                            coll_str + "." + field_str + "'.");
+    }
+    hash.insert(hash.end(), std::make_move_iterator(fresh_hash.begin()),
+                std::make_move_iterator(fresh_hash.end()));
+    std::sort(fresh_ordered.begin(), fresh_ordered.end());
+    size_t merged = ordered.size();
+    ordered.insert(ordered.end(), std::make_move_iterator(fresh_ordered.begin()),
+                   std::make_move_iterator(fresh_ordered.end()));
+    std::inplace_merge(ordered.begin(), ordered.begin() + static_cast<std::ptrdiff_t>(merged),
+                       ordered.end());
+
+    {
+        std::unique_lock<std::shared_mutex> lock(rw_lock_);
+        secondary_indexer_.add_indexed_field(coll_str, field_str, type, filter);
+        if (expire_after_seconds) ttl_indexes_[coll_str][field_str] = *expire_after_seconds;
+        if (type == IndexType::ORDERED) {
+            secondary_indexer_.load_entries(coll_str, field_str, std::move(ordered));
+        } else {
+            secondary_indexer_.load_entries(coll_str, field_str, std::move(hash));
+        }
+    }
+    AEVUM_LOG_INFO("IndexManager: Registered new " + std::string(to_string(type)) +
+                   " secondary index for '" + coll_str + "." + field_str + "' after scanning " +
+                   std::to_string(build->scanned.load(std::memory_order_relaxed)) +
+                   " documents and catching up with " + std::to_string(written.size()) +
+                   " concurrent writes.");
+
+    // Persist the new index definition to durable storage.
+    return persist_index_definition(coll_str, field_str);
+}
+
+/**
+ * @brief Builds a `COLUMNAR` index from the primary index and persists its definition.
+ * @details Nothing is persisted but the definition; the columns are built from the primary
+ * index, whose documents the caller keeps from changing meanwhile.
+ * @param collection The name of the collection.
+ * @param field The indexed field.
+ * @return The status of persisting the definition.
+ */
+aevum::util::Status IndexManager::create_columnar_index(const std::string &collection,
+                                                        const std::string &field) {
+    std::vector<std::string> columnar{field};
+    {
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+        auto it_coll = definitions.find(collection);
+        if (it_coll != definitions.end()) {
+            for (auto &other : fields_of_type(it_coll->second, IndexType::COLUMNAR)) {
+                columnar.push_back(std::move(other));
+            }
+        }
+    }
+    ColumnStore::Table table = build_columns(collection, columnar);
+
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    secondary_indexer_.add_indexed_field(collection, field, IndexType::COLUMNAR);
+    column_store_.install_table(collection, std::move(table));
+    AEVUM_LOG_INFO("IndexManager: Registered new columnar index for '" + collection + "." + field +
+                   "' with " + std::to_string(primary_indexer_.document_count(collection)) +
+                   " documents.");
+    lock.unlock();
+    return persist_index_definition(collection, field);
+}
+
+/**
+ * @brief Builds a `TEXT` index from the primary index and persists its definition.
+ * @details As with `create_columnar_index`, only the definition is persisted. The collection's
+ * table is rebuilt with the new field and its other text fields, and replaces the old one.
+ * @param collection The name of the collection.
+ * @param field The indexed field.
+ * @return The status of persisting the definition.
+ */
+aevum::util::Status IndexManager::create_text_index(const std::string &collection,
+                                                    const std::string &field) {
+    std::vector<std::string> text{field};
+    {
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+        auto it_coll = definitions.find(collection);
+        if (it_coll != definitions.end()) {
+            for (auto &other : fields_of_type(it_coll->second, IndexType::TEXT)) {
+                text.push_back(std::move(other));
+            }
+        }
+    }
+    TextIndex::Table table = build_text(collection, text);
 
-    // Rebuild indexes to backfill the newly created index with existing data.
-    rebuild_index(collection, existing_documents);
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    secondary_indexer_.add_indexed_field(collection, field, IndexType::TEXT);
+    text_index_.install_table(collection, std::move(table));
+    AEVUM_LOG_INFO("IndexManager: Registered new text index for '" + collection + "." + field +
+                   "' with " + std::to_string(primary_indexer_.document_count(collection)) +
+                   " documents.");
+    lock.unlock();
+    return persist_index_definition(collection, field);
+}
+
+/**
+ * @brief Reports the progress of the index builds in flight.
+ * @return One entry per build.
+ */
+std::vector<IndexBuildProgress> IndexManager::index_builds() const {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    std::vector<IndexBuildProgress> progress;
+    progress.reserve(builds_.size());
+    for (const auto &build : builds_) {
+        progress.push_back({build->collection, build->field, build->type,
+                            build->documents.load(std::memory_order_relaxed),
+                            build->scanned.load(std::memory_order_relaxed),
+                            build->written.size()});
+    }
+    return progress;
+}
 
-    // Persist the updated index definitions to durable storage.
-    return persist_index_definitions();
+/**
+ * @brief Lists the indexes that expire documents.
+ * @return One entry per TTL index.
+ */
+std::vector<TtlIndex> IndexManager::ttl_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    std::vector<TtlIndex> indexes;
+    for (const auto &[collection, fields] : ttl_indexes_) {
+        for (const auto &[field, expire_after_seconds] : fields) {
+            indexes.push_back({collection, field, expire_after_seconds});
+        }
+    }
+    return indexes;
+}
+
+/**
+ * @brief Records a write in the side buffer of every build on its collection.
+ * @details Writers hold the collection's writer lock exclusively, which `create_index` also holds
+ * while registering and ending a build, so a write is either recorded or completed before the
+ * build starts.
+ * @param collection The name of the collection.
+ * @param id The `_id` of the written document.
+ */
+void IndexManager::note_build_write(const std::string &collection, const std::string &id) {
+    if (active_builds_.load(std::memory_order_acquire) == 0) return;
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    for (const auto &build : builds_) {
+        if (build->collection == collection) build->written.insert(id);
+    }
+}
+
+/**
+ * @brief Unregisters a build and hands over its side buffer.
+ * @param build The build.
+ * @return The `_id`s written since the build started.
+ */
+std::unordered_set<std::string> IndexManager::end_index_build(
+    const std::shared_ptr<IndexBuild> &build) {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    builds_.erase(std::remove(builds_.begin(), builds_.end(), build), builds_.end());
+    active_builds_.store(builds_.size(), std::memory_order_release);
+    return std::move(build->written);
 }
 
 /**
  * @brief Retrieves a document directly by its primary key (`_id`).
  * @details This is a high-performance query path that delegates directly to the `PrimaryIndexer`.
- * It acquires a shared read lock, allowing for high-concurrency lookups.
+ * `rw_lock_` is not taken: the `PrimaryIndexer` synchronizes its own shards, and only the
+ * secondary indexes need the manager's lock to stay consistent with each other.
  * @param collection The name of the collection.
  * @param id The unique `_id` of the document to retrieve.
- * @return An `std::optional` containing the document if found, otherwise `std::nullopt`.
+ * @return A shared handle to the document, or null if it is not found.
  */
-std::optional<aevum::bson::doc::Document> IndexManager::get_document_by_id(
-    std::string_view collection, std::string_view id) const {
-    // Acquire a shared (read) lock to allow concurrent lookups.
-    std::shared_lock<std::shared_mutex> lock(rw_lock_);
-    return primary_indexer_.get_document_by_id(std::string(collection), std::string(id));
+PrimaryIndexer::DocumentPtr IndexManager::get_document_by_id(std::string_view collection,
+                                                             std::string_view id) const {
+    return primary_indexer_.get_document_by_id(collection, id);
+}
+
+/**
+ * @brief Visits the documents of a collection in the primary index in chunks.
+ * @details Delegates to the `PrimaryIndexer` without taking `rw_lock_`; see
+ * `PrimaryIndexer::for_each_chunk` for the lifetime contract.
+ * @param collection The name of the collection.
+ * @param chunk_size The number of documents per chunk.
+ * @param visit The visitor.
+ * @return `false` if `visit` stopped the iteration, `true` otherwise.
+ */
+bool IndexManager::for_each_document_chunk(std::string_view collection, size_t chunk_size,
+                                           const PrimaryIndexer::ChunkVisitor &visit) const {
+    return primary_indexer_.for_each_chunk(collection, chunk_size, visit);
 }
 
 /**
- * @brief Retrieves all documents in a collection from the in-memory primary index.
- * @details This method provides a high-concurrency path for performing full collection scans.
- * It acquires a shared read lock and delegates the retrieval to the `PrimaryIndexer`.
+ * @brief Borrows read-only pointers to every document of a collection in the primary index.
+ * @details Delegates to the `PrimaryIndexer` without taking `rw_lock_`. No document is copied;
+ * see `PrimaryIndexer::get_document_refs` for the lifetime contract.
  * @param collection The name of the collection.
- * @return A vector of deep copies of all documents currently in the primary index.
+ * @return A vector of non-owning pointers into the primary index.
  */
-std::vector<aevum::bson::doc::Document> IndexManager::get_all_documents(
+std::vector<const aevum::bson::doc::Document *> IndexManager::get_document_refs(
     std::string_view collection) const {
+    return primary_indexer_.get_document_refs(collection);
+}
+
+/**
+ * @brief Returns the number of documents of a collection in the primary index.
+ * @param collection The name of the collection.
+ * @return The number of documents.
+ */
+size_t IndexManager::document_count(std::string_view collection) const {
+    return primary_indexer_.document_count(collection);
+}
+
+/**
+ * @brief Returns the number and total size of the documents of a collection.
+ * @param collection The name of the collection.
+ * @return The statistics.
+ */
+CollectionStatistics IndexManager::collection_statistics(std::string_view collection) const {
+    return primary_indexer_.collection_statistics(collection);
+}
+
+/**
+ * @brief Estimates the memory a collection holds in the indexes.
+ * @details A primary index entry is charged its `_id`, the shared handle and its control block,
+ * and a slot of the `IdTable`; a hash or ordered index entry its key, `_id`, and tree or list
+ * node. Both allowances assume short keys, so collections with long `_id`s or indexed strings
+ * hold somewhat more than reported.
+ * @param collection The name of the collection.
+ * @return The estimate.
+ */
+CollectionMemory IndexManager::memory_usage(std::string_view collection) const {
+    constexpr size_t PRIMARY_ENTRY_BYTES = 128;
+    constexpr size_t INDEX_ENTRY_BYTES = 96;
+    std::string coll_str(collection);
+    CollectionMemory memory;
+    CollectionStatistics documents = primary_indexer_.collection_statistics(collection);
+    memory.documents = documents.bytes + documents.documents * PRIMARY_ENTRY_BYTES;
+
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+    if (auto it = definitions.find(coll_str); it != definitions.end()) {
+        for (const auto &[field, type] : it->second) {
+            if (!has_entries(type)) continue;
+            memory.indexes +=
+                secondary_indexer_.statistics(coll_str, field).entries * INDEX_ENTRY_BYTES;
+        }
+    }
+    memory.indexes += column_store_.memory_bytes(coll_str) + text_index_.memory_bytes(coll_str);
+    return memory;
+}
+
+/**
+ * @brief Returns the statistics of a secondary index.
+ * @param collection The name of the collection.
+ * @param field The field carrying the index.
+ * @return A copy of the statistics.
+ */
+IndexStatistics IndexManager::index_statistics(std::string_view collection,
+                                               std::string_view field) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.statistics(std::string(collection), std::string(field));
+}
+
+/**
+ * @brief Estimates the number of entries of a hash index filed under a key.
+ * @param collection The name of the collection.
+ * @param field The field carrying a hash index.
+ * @param key The index key.
+ * @return The estimate.
+ */
+double IndexManager::estimate_equal(std::string_view collection, std::string_view field,
+                                    std::string_view key) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.estimate_equal(std::string(collection), std::string(field), key);
+}
+
+/**
+ * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys.
+ * @return The estimate.
+ */
+double IndexManager::estimate_range(std::string_view collection, std::string_view field,
+                                    const KeyRange &range) const {
     std::shared_lock<std::shared_mutex> lock(rw_lock_);
-    return primary_indexer_.get_all_documents(std::string(collection));
+    return secondary_indexer_.estimate_range(std::string(collection), std::string(field), range);
+}
+
+/**
+ * @brief Borrows a read-only pointer to a single document by its `_id`.
+ * @details Delegates to `PrimaryIndexer::get_document_ref` without taking `rw_lock_`.
+ * @param collection The name of the collection.
+ * @param id The unique `_id` of the document.
+ * @return A non-owning pointer into the primary index, or `nullptr` if not found.
+ */
+const aevum::bson::doc::Document *IndexManager::get_document_ref_by_id(std::string_view collection,
+                                                                       std::string_view id) const {
+    return primary_indexer_.get_document_ref(collection, id);
+}
+
+/**
+ * @brief Checks whether a collection may hold a document with a given `_id`.
+ * @param collection The name of the collection.
+ * @param id The `_id` to look for.
+ * @return `false` only if the collection's `_id` filter rules the `_id` out.
+ */
+bool IndexManager::may_contain_id(std::string_view collection, std::string_view id) const {
+    uint64_t hash = BloomFilter::hash(id);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    auto it = id_filters_.find(std::string(collection));
+    return it == id_filters_.end() || it->second.may_contain(hash);
+}
+
+/**
+ * @brief Adds the `_id`s of documents written to a collection that is not resident to its filter.
+ * @details Without a filter there is nothing to keep complete. An overfull filter is dropped
+ * rather than rebuilt, since the `_id`s of an unloaded collection are only in storage.
+ * @param collection The name of the collection.
+ * @param ids The `_id`s of the written documents.
+ */
+void IndexManager::add_unloaded_ids(std::string_view collection,
+                                    const std::vector<std::string> &ids) {
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    auto it = id_filters_.find(std::string(collection));
+    if (it == id_filters_.end()) return;
+    for (const auto &id : ids) {
+        it->second.insert(BloomFilter::hash(id));
+    }
+    if (it->second.is_overfull()) {
+        AEVUM_LOG_DEBUG("IndexManager: Dropping the overfull _id filter of unloaded collection '" +
+                        it->first + "'.");
+        id_filters_.erase(it);
+    }
+}
+
+/**
+ * @brief Rebuilds the `_id` filter of a collection from the `_id`s in its primary index.
+ * @param collection The name of the collection.
+ */
+void IndexManager::rebuild_id_filter_locked(const std::string &collection) {
+    BloomFilter filter(2 * primary_indexer_.document_count(collection));
+    for (const auto &[id, doc] : primary_indexer_.get_document_handles(collection)) {
+        filter.insert(BloomFilter::hash(id));
+    }
+    id_filters_[collection] = std::move(filter);
 }
 
 /**
  * @brief Retrieves documents by querying a secondary index with a key-value pair.
- * @details This is the primary method for leveraging secondary indexes. It delegates the query to
- * the `SecondaryIndexer` and acquires a shared read lock for concurrent execution.
+ * @details This is the primary method for leveraging secondary indexes. The `SecondaryIndexer`
+ * supplies the `_id`s stored under the key, and each one is resolved and copied from the
+ * `PrimaryIndexer`. A shared read lock is held throughout for concurrent execution.
  * @param collection The collection to search within.
  * @param field The indexed field to query.
  * @param value The value to match for the given field.
@@ -169,9 +1099,260 @@ std::vector<aevum::bson::doc::Document> IndexManager::get_all_documents(
  */
 std::vector<aevum::bson::doc::Document> IndexManager::get_documents_by_secondary_index(
     std::string_view collection, std::string_view field, std::string_view value) const {
+    std::string coll_str(collection);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    std::vector<aevum::bson::doc::Document> docs;
+    for (const auto &id : secondary_indexer_.get_ids_by_secondary_index(
+             coll_str, std::string(field), std::string(value))) {
+        if (const auto *doc = primary_indexer_.get_document_ref(coll_str, id)) {
+            docs.push_back(*doc);
+        }
+    }
+    return docs;
+}
+
+/**
+ * @brief Retrieves the `_id`s of the documents matching a key in a secondary index.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The collection to search within.
+ * @param field The indexed field to query.
+ * @param key The index key to match.
+ * @return The `_id`s of the matching documents.
+ */
+std::vector<std::string> IndexManager::get_ids_by_secondary_index(std::string_view collection,
+                                                                  std::string_view field,
+                                                                  std::string_view key) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.get_ids_by_secondary_index(std::string(collection),
+                                                         std::string(field), std::string(key));
+}
+
+/**
+ * @brief Checks whether a secondary index exists on a field of a collection.
+ * @param collection The name of the collection.
+ * @param field The field to check.
+ * @return `true` if the field is indexed.
+ */
+bool IndexManager::is_field_indexed(std::string_view collection, std::string_view field) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.is_field_indexed(std::string(collection), std::string(field));
+}
+
+/**
+ * @brief Checks whether a collection has any secondary index.
+ * @param collection The name of the collection.
+ * @return `true` if at least one field of the collection is indexed.
+ */
+bool IndexManager::has_secondary_indexes(std::string_view collection) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.has_indexes(std::string(collection));
+}
+
+/**
+ * @brief Lists the field paths the secondary indexes of a collection are built on.
+ * @param collection The name of the collection.
+ * @return The fields of every index, with compound indexes split into theirs, and the fields
+ *         the filters of partial indexes test.
+ */
+std::vector<std::string> IndexManager::indexed_paths(std::string_view collection) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    std::vector<std::string> paths;
+    std::string coll_str(collection);
+    const auto &definitions = secondary_indexer_.get_all_indexed_fields();
+    auto it = definitions.find(coll_str);
+    if (it == definitions.end()) return paths;
+    for (const auto &[name, type] : it->second) {
+        std::vector<std::string> fields = split_index_fields(name);
+        std::move(fields.begin(), fields.end(), std::back_inserter(paths));
+    }
+    for (const auto &[name, filter] : secondary_indexer_.index_filters(coll_str)) {
+        paths.insert(paths.end(), filter->filter_paths().begin(), filter->filter_paths().end());
+    }
+    return paths;
+}
+
+/**
+ * @brief Lists the filters of the sparse and partial indexes of a collection.
+ * @param collection The name of the collection.
+ * @return The filters, by index name.
+ */
+std::unordered_map<std::string, IndexFilterPtr> IndexManager::index_filters(
+    std::string_view collection) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.index_filters(std::string(collection));
+}
+
+/**
+ * @brief Looks up the type of the secondary index on a field of a collection.
+ * @param collection The name of the collection.
+ * @param field The field to check.
+ * @return The field's `IndexType`, or `std::nullopt` if it is not indexed.
+ */
+std::optional<IndexType> IndexManager::get_index_type(std::string_view collection,
+                                                      std::string_view field) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.get_index_type(std::string(collection), std::string(field));
+}
+
+/**
+ * @brief Checks whether an ordered index holds entries for the elements of an array.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @return `true` if the index is multikey.
+ */
+bool IndexManager::is_multikey(std::string_view collection, std::string_view field) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.is_multikey(std::string(collection), std::string(field));
+}
+
+/**
+ * @brief Lists the compound hash indexes of a collection.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The name of the collection.
+ * @return The names of the indexes.
+ */
+std::vector<std::string> IndexManager::get_compound_indexes(std::string_view collection) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.compound_indexes(std::string(collection));
+}
+
+/**
+ * @brief Retrieves the `_id`s of the documents whose key lies in a range of an ordered index.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to collect.
+ * @param limit The most entries to collect, or 0 for all of them.
+ * @return The `_id`s of the matching documents in ascending key order.
+ */
+std::vector<std::string> IndexManager::get_ids_in_range(std::string_view collection,
+                                                        std::string_view field,
+                                                        const KeyRange &range,
+                                                        size_t limit) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.get_ids_in_range(std::string(collection), std::string(field), range,
+                                               limit);
+}
+
+/**
+ * @brief Counts the documents whose key lies in a range of an ordered index.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to count.
+ * @return The number of documents in `range`.
+ */
+size_t IndexManager::count_in_range(std::string_view collection, std::string_view field,
+                                    const KeyRange &range) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return secondary_indexer_.count_in_range(std::string(collection), std::string(field), range);
+}
+
+/**
+ * @brief Visits the documents of an ordered index in key order.
+ * @details Entries are resolved through the `PrimaryIndexer` directly rather than through
+ * `get_document_ref_by_id`, which would try to re-acquire `rw_lock_` while it is already held.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to visit.
+ * @param descending `true` to visit from the largest key down.
+ * @param visit Called with each document; returning `false` ends the traversal.
+ */
+void IndexManager::scan_ordered_index(
+    std::string_view collection, std::string_view field, const KeyRange &range, bool descending,
+    const std::function<bool(const aevum::bson::doc::Document *)> &visit) const {
+    std::string coll_str(collection);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    secondary_indexer_.scan_ordered_index(
+        coll_str, std::string(field), range, descending,
+        [&](const IndexKey &, const std::string &id) {
+            const auto *doc = primary_indexer_.get_document_ref(coll_str, id);
+            return doc ? visit(doc) : true;
+        });
+}
+
+/**
+ * @brief Visits the entries of an ordered index in key order, without resolving any document.
+ * @details Acquires a shared read lock and delegates to the `SecondaryIndexer`.
+ * @param collection The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to visit.
+ * @param descending `true` to visit from the largest key down.
+ * @param visit Called with the key and `_id` of each entry; returning `false` ends the traversal.
+ */
+void IndexManager::scan_index_entries(
+    std::string_view collection, std::string_view field, const KeyRange &range, bool descending,
+    const std::function<bool(const IndexKey &, const std::string &)> &visit) const {
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    secondary_indexer_.scan_ordered_index(std::string(collection), std::string(field), range,
+                                          descending, visit);
+}
+
+/**
+ * @brief Selects the documents of a collection that satisfy predicates on columnar indexes.
+ * @details Falls back to every document of the collection if it has no columnar index, which
+ * can only happen when the plan was made against index definitions that have since changed.
+ * @param collection The name of the collection.
+ * @param predicates The predicates.
+ * @return Non-owning pointers to the selected documents.
+ */
+std::vector<const aevum::bson::doc::Document *> IndexManager::select_by_columns(
+    std::string_view collection, const std::vector<ColumnPredicate> &predicates) const {
+    std::string coll_str(collection);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    if (!column_store_.has_table(coll_str)) return primary_indexer_.get_document_refs(coll_str);
+    return column_store_.select(coll_str, predicates);
+}
+
+/**
+ * @brief Ranks the documents of a collection against a `$text` search.
+ * @param collection The name of the collection.
+ * @param text The search text.
+ * @param wanted The number of best documents to return, or 0 for all of them.
+ * @return The documents holding any term of the text, best first; empty if the collection has
+ *         no text index.
+ */
+std::vector<TextHit> IndexManager::search_text(std::string_view collection, std::string_view text,
+                                               size_t wanted) const {
+    std::string coll_str(collection);
+    std::shared_lock<std::shared_mutex> lock(rw_lock_);
+    return text_index_.search(coll_str, text, wanted);
+}
+
+/**
+ * @brief Checks whether a collection has a text index.
+ * @param collection The name of the collection.
+ * @return `true` if at least one of its fields has a `TEXT` index.
+ */
+bool IndexManager::has_text_index(std::string_view collection) const {
+    std::string coll_str(collection);
     std::shared_lock<std::shared_mutex> lock(rw_lock_);
-    return secondary_indexer_.get_documents_by_secondary_index(
-        std::string(collection), std::string(field), std::string(value));
+    return text_index_.has_table(coll_str);
+}
+
+/**
+ * @brief Builds the text indexes of a collection from the primary index.
+ * @param collection The name of the collection.
+ * @param fields The fields carrying a text index.
+ * @return The table; one without fields if `fields` is empty.
+ */
+TextIndex::Table IndexManager::build_text(const std::string &collection,
+                                          const std::vector<std::string> &fields) const {
+    if (fields.empty()) return {};
+    return TextIndex::build_table(fields, primary_indexer_.get_document_handles(collection));
+}
+
+/**
+ * @brief Builds the columnar indexes of a collection from the primary index.
+ * @param collection The name of the collection.
+ * @param fields The fields carrying a columnar index.
+ * @return The table.
+ */
+ColumnStore::Table IndexManager::build_columns(const std::string &collection,
+                                               const std::vector<std::string> &fields) const {
+    if (fields.empty()) return {};
+    return ColumnStore::build_table(fields, primary_indexer_.get_document_handles(collection));
 }
 
 /**
@@ -184,14 +1365,95 @@ std::vector<aevum::bson::doc::Document> IndexManager::get_documents_by_secondary
  */
 void IndexManager::add_document_to_indexes(std::string_view collection,
                                            const aevum::bson::doc::Document &doc) {
-    std::string id = extract_id(doc);
     std::string coll_str(collection);
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    index_document_locked(coll_str, doc);
+}
 
+/**
+ * @brief Adds a batch of documents to all relevant indexes under a single exclusive lock.
+ * @details Each document is indexed exactly as by `add_document_to_indexes`, in input order, so a
+ * later document with the same `_id` as an earlier one replaces it.
+ * @param collection The name of the collection.
+ * @param docs The documents to be added to the indexes.
+ */
+void IndexManager::add_documents_to_indexes(std::string_view collection,
+                                            const std::vector<aevum::bson::doc::Document> &docs) {
+    std::string coll_str(collection);
     std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    for (const auto &doc : docs) {
+        index_document_locked(coll_str, doc);
+    }
+}
+
+/**
+ * @brief Adds a document to the primary and secondary indexes; the caller holds `rw_lock_`.
+ * @details If the `_id` is already indexed, the previous image is first retracted from the
+ * secondary indexes, since an insert with an existing `_id` overwrites it. A collection with
+ * columnar indexes gets the primary index's handle of the new image in its columns, and one with
+ * text indexes has the new image tokenized into its posting lists. The `_id`
+ * is added to the collection's `_id` filter, which is built from the primary index if the
+ * collection has none yet or rebuilt once it is overfull.
+ * @param collection The name of the collection.
+ * @param doc The document to be added to the indexes.
+ */
+void IndexManager::index_document_locked(const std::string &collection,
+                                         const aevum::bson::doc::Document &doc) {
+    std::string id = extract_id(doc);
     if (!id.empty()) {
-        primary_indexer_.add_document_to_primary_index(coll_str, id, doc);
+        note_build_write(collection, id);
+        if (const auto *previous = primary_indexer_.get_document_ref(collection, id)) {
+            secondary_indexer_.update_custom_index(collection, *previous, false);
+        }
+        primary_indexer_.add_document_to_primary_index(collection, id, doc);
+        if (column_store_.has_table(collection)) {
+            column_store_.upsert(collection, id,
+                                 primary_indexer_.get_document_by_id(collection, id));
+        }
+        text_index_.upsert(collection, id, doc);
+        auto it_filter = id_filters_.find(collection);
+        if (it_filter == id_filters_.end()) {
+            rebuild_id_filter_locked(collection);
+        } else {
+            it_filter->second.insert(BloomFilter::hash(id));
+            if (it_filter->second.is_overfull()) rebuild_id_filter_locked(collection);
+        }
+    }
+    secondary_indexer_.update_custom_index(collection, doc, true);  // `true` for addition
+}
+
+/**
+ * @brief Applies an in-place update of a document to the indexes.
+ * @details Under the exclusive lock, the before image is retracted from the secondary indexes if
+ * `reindex` is set, the primary index's copy is patched, and the after image is then added. The
+ * `_id` is unchanged, so the `_id` filter needs no update.
+ * @param collection The name of the collection.
+ * @param id The `_id` of the document.
+ * @param patches The runs of bytes the update replaced.
+ * @param after The updated document.
+ * @param reindex Whether the update may have changed an indexed field.
+ */
+void IndexManager::patch_document(std::string_view collection, std::string_view id,
+                                  const std::vector<aevum::db::storage::ValuePatch> &patches,
+                                  const aevum::bson::doc::Document &after, bool reindex) {
+    std::string coll_str(collection);
+    std::string id_str(id);
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    note_build_write(coll_str, id_str);
+    const auto *previous = primary_indexer_.get_document_ref(collection, id);
+    if (!previous) {
+        index_document_locked(coll_str, after);
+        return;
+    }
+    if (reindex) secondary_indexer_.update_custom_index(coll_str, *previous, false);
+    (void)primary_indexer_.patch_document(collection, id, patches, after);
+    if (column_store_.has_table(coll_str)) {
+        column_store_.upsert(coll_str, id_str, primary_indexer_.get_document_by_id(collection, id));
+    }
+    if (reindex) {
+        text_index_.upsert(coll_str, id_str, after);
+        secondary_indexer_.update_custom_index(coll_str, after, true);
     }
-    secondary_indexer_.update_custom_index(coll_str, doc, true);  // `true` for addition
 }
 
 /**
@@ -209,46 +1471,163 @@ void IndexManager::remove_document_from_indexes(std::string_view collection,
 
     std::unique_lock<std::shared_mutex> lock(rw_lock_);
     if (!id.empty()) {
+        note_build_write(coll_str, id);
         primary_indexer_.remove_document_from_primary_index(coll_str, id);
+        column_store_.remove(coll_str, id);
+        text_index_.remove(coll_str, id);
     }
     secondary_indexer_.update_custom_index(coll_str, doc, false);  // `false` for removal
 }
 
+/**
+ * @brief Removes a batch of documents from all indexes under a single exclusive lock.
+ * @details Each `_id` leaves the primary index, the `ColumnStore`, and the `TextIndex` as with
+ * `remove_document_from_indexes`; the secondary indexes are then updated by one
+ * `SecondaryIndexer::remove_documents` call, which groups the removals per posting set and per
+ * ordered range.
+ * @param collection The name of the collection.
+ * @param docs The documents to be removed from the indexes.
+ */
+void IndexManager::remove_documents_from_indexes(
+    std::string_view collection, const std::vector<PrimaryIndexer::DocumentPtr> &docs) {
+    std::string coll_str(collection);
+    std::vector<const aevum::bson::doc::Document *> images;
+    images.reserve(docs.size());
+
+    std::unique_lock<std::shared_mutex> lock(rw_lock_);
+    for (const auto &doc : docs) {
+        if (!doc) continue;
+        std::string id = extract_id(*doc);
+        if (!id.empty()) {
+            note_build_write(coll_str, id);
+            primary_indexer_.remove_document_from_primary_index(coll_str, id);
+            column_store_.remove(coll_str, id);
+            text_index_.remove(coll_str, id);
+        }
+        images.push_back(doc.get());
+    }
+    secondary_indexer_.remove_documents(coll_str, images);
+}
+
 /**
  * @brief Loads all secondary index definitions from persistent storage into the `SecondaryIndexer`.
  * @details This function is critical for database startup. It acquires an exclusive lock on the
  * manager and invokes the `IndexPersistor` to read from the `_indexes` system collection and
- * populate the in-memory index configuration.
+ * populate the in-memory index configuration. The options of sparse and partial indexes are
+ * compiled into their filters; an index whose filter no longer compiles is dropped from memory,
+ * so that queries scan instead of trusting an index that may hold the wrong documents.
  * @return `aevum::util::Status::OK()` on success, or an `IOError` if the persistor fails.
  */
 aevum::util::Status IndexManager::load_all_index_definitions() {
     std::unique_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug("IndexManager: Loading all index definitions from persistor.");
-    bool success = index_persistor_.load_index_definitions(
-        secondary_indexer_.get_all_indexed_fields_mutable());
+    AEVUM_LOG_DEBUG("IndexManager: Loading all index definitions from persistor.");
+    IndexOptionDefinitions options;
+    auto &definitions = secondary_indexer_.get_all_indexed_fields_mutable();
+    bool success = index_persistor_.load_index_definitions(definitions, ttl_indexes_, options);
 
     if (!success) {
         return aevum::util::Status::IOError("Failed to load index definitions from storage.");
     }
+    for (const auto &[collection, fields] : options) {
+        for (const auto &[field, index_options] : fields) {
+            auto filter = IndexFilter::compile(field, index_options);
+            if (filter) {
+                secondary_indexer_.set_index_filter(
+                    collection, field, std::make_shared<const IndexFilter>(std::move(*filter)));
+                continue;
+            }
+            AEVUM_LOG_ERROR("IndexManager: Ignoring index '" + collection + "." + field +
+                            "', whose partial_filter cannot be compiled.");
+            definitions[collection].erase(field);
+            if (auto it = ttl_indexes_.find(collection); it != ttl_indexes_.end()) {
+                it->second.erase(field);
+            }
+        }
+    }
     return aevum::util::Status::OK();
 }
 
 /**
- * @brief Persists the current state of secondary index definitions to durable storage.
- * @details This private helper is a write operation that acquires an exclusive lock. It delegates
- * the task of serializing and writing the index metadata to the `IndexPersistor`.
- * @return `aevum::util::Status::OK()` on success, or an `IOError` if persistence fails.
+ * @brief Restores the `_id` filters stored at the last clean shutdown.
+ * @details Encodings that cannot be decoded are skipped; their collections simply have no filter.
+ * If the stored filters cannot be deleted, none is installed, since one could outlive a crash.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` if the persistor fails.
  */
-aevum::util::Status IndexManager::persist_index_definitions() {
-    // Acquire a write lock to prevent modifications to index definitions during persistence.
+aevum::util::Status IndexManager::load_id_filters() {
+    IndexPersistor::IdFilterImages images;
+    if (!index_persistor_.take_id_filters(images)) {
+        return aevum::util::Status::IOError("Failed to take the stored _id filters.");
+    }
+
     std::unique_lock<std::shared_mutex> lock(rw_lock_);
-    aevum::util::log::Logger::debug(
-        "IndexManager: Persisting current index definitions to storage.");
-    bool success =
-        index_persistor_.persist_index_definitions(secondary_indexer_.get_all_indexed_fields());
+    for (auto &[collection, image] : images) {
+        auto filter = BloomFilter::deserialize(image);
+        if (!filter) {
+            AEVUM_LOG_WARN("IndexManager: Ignoring the malformed _id filter of '" + collection +
+                           "'.");
+            continue;
+        }
+        id_filters_[collection] = std::move(*filter);
+    }
+    AEVUM_LOG_INFO("IndexManager: Restored " + std::to_string(id_filters_.size()) +
+                   " _id filters from storage.");
+    return aevum::util::Status::OK();
+}
 
-    if (!success) {
-        aevum::util::log::Logger::error("IndexManager: Failed to persist index definitions.");
+/**
+ * @brief Stores the `_id` filter of every collection that has one.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` if persistence fails.
+ */
+aevum::util::Status IndexManager::persist_id_filters() {
+    IndexPersistor::IdFilterImages images;
+    {
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        images.reserve(id_filters_.size());
+        for (const auto &[collection, filter] : id_filters_) {
+            images.emplace_back(collection, filter.serialize());
+        }
+    }
+    if (images.empty()) return aevum::util::Status::OK();
+    if (!index_persistor_.store_id_filters(images)) {
+        return aevum::util::Status::IOError("Failed to store the _id filters.");
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Persists the registered definition of one secondary index to durable storage.
+ * @details Only a shared lock is taken, to read the definition; the write itself touches one
+ * record of `_indexes`, so the cost of DDL does not grow with the number of indexes.
+ * @param collection The name of the collection.
+ * @param field The indexed field.
+ * @return `aevum::util::Status::OK()` on success, `NotFound` if the index is not registered, or
+ *         an `IOError` if persistence fails.
+ */
+aevum::util::Status IndexManager::persist_index_definition(const std::string &collection,
+                                                           const std::string &field) {
+    std::optional<IndexType> type;
+    std::optional<int64_t> expire_after_seconds;
+    IndexOptions options;
+    {
+        std::shared_lock<std::shared_mutex> lock(rw_lock_);
+        type = secondary_indexer_.get_index_type(collection, field);
+        if (auto filter = secondary_indexer_.index_filter(collection, field)) {
+            options = filter->options();
+        }
+        if (auto it_coll = ttl_indexes_.find(collection); it_coll != ttl_indexes_.end()) {
+            if (auto it = it_coll->second.find(field); it != it_coll->second.end()) {
+                expire_after_seconds = it->second;
+            }
+        }
+    }
+    if (!type) {
+        return aevum::util::Status::NotFound("Index on '" + collection + "." + field +
+                                             "' is not registered.");
+    }
+    if (!index_persistor_.store_index_definition(collection, field, *type, expire_after_seconds,
+                                                 options)) {
+        AEVUM_LOG_ERROR("IndexManager: Failed to persist the definition of index '" + collection +
+                        "." + field + "'.");
         return aevum::util::Status::IOError("Failed to persist index definitions.");
     }
     return aevum::util::Status::OK();
@@ -8,8 +8,8 @@
  * operations.
  * @details This header declares the high-level `IndexManager`, which serves as a unified facade
  * for interacting with both primary (`_id`-based) and secondary (field-based) indexes. It
- * coordinates the `PrimaryIndexer`, `SecondaryIndexer`, and `IndexPersistor` sub-components to
- * provide a cohesive and thread-safe indexing subsystem.
+ * coordinates the `PrimaryIndexer`, `SecondaryIndexer`, `ColumnStore`, `TextIndex`, and
+ * `IndexPersistor` sub-components to provide a cohesive and thread-safe indexing subsystem.
  */
 #pragma once
 
@@ -18,18 +18,60 @@
 #include "aevum/util/status.hpp"
 
 // Forward declarations for the constituent sub-components of the indexing system.
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "aevum/db/index/bloom_filter.hpp"
+#include "aevum/db/index/column_store.hpp"
+#include "aevum/db/index/index_image.hpp"
 #include "aevum/db/index/index_persistor.hpp"
 #include "aevum/db/index/primary_indexer.hpp"
 #include "aevum/db/index/secondary_indexer.hpp"
+#include "aevum/db/index/text_index.hpp"
 
 namespace aevum::db::index {
 
+/**
+ * @struct IndexBuildProgress
+ * @brief The state of an index that `IndexManager::create_index` is building in the background.
+ */
+struct IndexBuildProgress {
+    /// The indexed collection.
+    std::string collection;
+    /// The indexed field.
+    std::string field;
+    /// The type of the index.
+    IndexType type = IndexType::HASH;
+    /// The documents in the collection when the build started.
+    size_t documents = 0;
+    /// The documents scanned so far.
+    size_t scanned = 0;
+    /// The documents written since the build started, to be re-indexed when it catches up.
+    size_t concurrent_writes = 0;
+};
+
+/**
+ * @struct TtlIndex
+ * @brief An `ORDERED` index that expires the documents of its collection.
+ */
+struct TtlIndex {
+    /// The indexed collection.
+    std::string collection;
+    /// The indexed field, holding a number of seconds since the Unix epoch.
+    std::string field;
+    /// The number of seconds after the time in `field` at which a document expires.
+    int64_t expire_after_seconds = 0;
+};
+
 /**
  * @class IndexManager
  * @brief A high-level coordinator for primary and secondary indexing services, ensuring data
@@ -73,44 +115,240 @@ class IndexManager {
     void rebuild_index(std::string_view collection,
                        const std::vector<aevum::bson::doc::Document> &documents);
 
+    /**
+     * @brief Loads the indexes of a collection when it is brought into memory.
+     * @details The primary index is filled from `documents`, and every secondary index from its
+     * persisted entry table, so no document is re-indexed. An index whose table cannot be read,
+     * or is empty although the collection is not (for instance because it was created by a
+     * version that did not persist entries), is built from `documents` and its table rewritten.
+     * The entries are read and the primary index built before the exclusive lock is acquired, so
+     * several collections can be loaded concurrently. The caller must ensure that the index
+     * definitions of the collection do not change meanwhile.
+     * @param collection The name of the collection.
+     * @param documents All BSON documents of the collection; they are moved into the primary
+     *        index.
+     */
+    void load_collection_indexes(std::string_view collection,
+                                 std::vector<aevum::bson::doc::Document> documents);
+
+    /**
+     * @brief Loads the indexes of a collection from its image instead of storage.
+     * @details The documents of the image are copied out of the mapping into the primary index,
+     * and the entries of every `HASH` and `ORDERED` index the image holds are decoded from it,
+     * leaving out the documents changed since the image was written and adding the entries of
+     * their current versions. An index the image does not hold, for instance one created since,
+     * is restored from its entry table as by `load_collection_indexes`, and columnar and text
+     * indexes are built from the documents. The same locking requirements apply.
+     * @param collection The name of the collection.
+     * @param image The validated image of the collection.
+     * @param changed The `_id`s of the documents changed since the image was written.
+     * @param current The current versions of the documents of `changed` that still exist.
+     */
+    void load_collection_image(std::string_view collection, const IndexImage &image,
+                               const std::unordered_set<std::string> &changed,
+                               std::vector<aevum::bson::doc::Document> current);
+
+    /**
+     * @brief Captures what the image of a collection holds.
+     * @details The document handles are shared, not copied, and the entries of the `HASH` and
+     * `ORDERED` indexes are copied. The caller must exclude writers to the collection, so that
+     * the documents and the entries agree.
+     * @param collection The name of the collection.
+     * @return The documents and entries of the collection.
+     */
+    [[nodiscard]] IndexImageContent capture_image(std::string_view collection) const;
+
+    /**
+     * @brief Releases the documents and index entries of a collection, the reverse of
+     * `load_collection_indexes`.
+     * @details The index definitions, the persisted entries, and the collection's `_id` filter
+     * are kept, so the collection can be served from storage and loaded again later. The caller
+     * must hold the collection's lock exclusively.
+     * @param collection The name of the collection.
+     */
+    void unload_collection_indexes(std::string_view collection);
+
     /**
      * @brief Creates a new secondary index on a specified field and persists the definition.
-     * @details This method first checks if the index already exists. If not, it registers the new
-     * field for indexing, triggers a full `rebuild_index` to backfill existing data, and finally
-     * calls `persist_index_definitions` to save the new configuration to storage.
+     * @details A `HASH` or `ORDERED` index is built online. The build is registered under the
+     * exclusive `writers` lock, from which point every write to the collection records its `_id`
+     * in the build's side buffer. `writers` is then released, and the entries are computed from
+     * shared handles to the documents of the primary index, shard by shard, and bulk-loaded in
+     * sorted order into the index's entry table while readers and writers proceed. Finally,
+     * `writers` is taken exclusively again for a short catch-up: the entries of the recorded
+     * `_id`s are recomputed from their current documents and applied to the table, and the
+     * index is published together with its entries and its definition persisted. Until then,
+     * queries do not see it. Other indexes of the collection are left untouched. A `COLUMNAR` or
+     * `TEXT` index, which has no entry table, is built under `writers` held exclusively
+     * throughout.
+     *
+     * `field` is a field path such as `"address.city"`, or, for a compound `HASH` index, several
+     * paths joined by `INDEX_FIELD_SEPARATOR`, such as `"tenant,status"`. A `COLUMNAR` index
+     * covers a single top-level field, and a `TEXT` index a single field path.
      * @param collection The name of the target collection.
-     * @param field The document field on which to create the new index.
-     * @param existing_documents A comprehensive list of documents already in the collection,
-     *        required for backfilling the new index.
-     * @return An `aevum::util::Status` indicating the outcome of the persistence operation.
+     * @param field The field path, or list of paths, on which to create the new index.
+     * @param type The organization of the new index.
+     * @param writers The lock that writers to the collection hold exclusively. It must not be
+     *        held by the caller.
+     * @param expire_after_seconds For an `ORDERED` index on a single field, makes it a TTL index
+     *        whose documents expire this many seconds after the time in the field (see
+     *        `ttl_indexes`). Given for an existing ordered index, it sets or changes its
+     *        time-to-live without rebuilding it.
+     * @param options Makes the index sparse or partial (see `IndexFilter`). Not supported by a
+     *        `COLUMNAR` or `TEXT` index.
+     * @warning The collection must be resident for the duration of the call.
+     * @return An `aevum::util::Status` indicating the outcome of the persistence operations, or
+     * `InvalidArgument` if the field is already indexed with a different type or different
+     * options, is being indexed by another call, names fields the index type cannot cover, is
+     * given a partial filter the native matcher cannot compile, or is given a negative
+     * time-to-live or one for an index that is not a single-field ordered index.
      */
     [[nodiscard]] aevum::util::Status create_index(
-        std::string_view collection, std::string_view field,
-        const std::vector<aevum::bson::doc::Document> &existing_documents);
+        std::string_view collection, std::string_view field, IndexType type,
+        std::shared_mutex &writers, std::optional<int64_t> expire_after_seconds = std::nullopt,
+        const IndexOptions &options = {});
+
+    /**
+     * @brief Reports the progress of the index builds in flight.
+     * @return One entry per build, in the order they started.
+     */
+    [[nodiscard]] std::vector<IndexBuildProgress> index_builds() const;
+
+    /**
+     * @brief Lists the indexes that expire documents.
+     * @return One entry per TTL index.
+     */
+    [[nodiscard]] std::vector<TtlIndex> ttl_indexes() const;
 
     /**
      * @brief Retrieves a document directly from the primary index using its unique `_id`.
      * @details This method provides a highly optimized path for direct lookups, delegating the
-     * call to the `PrimaryIndexer`. It acquires a shared read lock.
+     * call to the `PrimaryIndexer`, which locks only the shard of the `_id`.
      * @param collection The name of the collection.
      * @param id The unique `_id` of the document to retrieve.
-     * @return An `std::optional` containing the `Document` if found, or `std::nullopt`.
+     * @return A shared handle to the immutable `Document`, or null if it does not exist.
      */
-    [[nodiscard]] std::optional<aevum::bson::doc::Document> get_document_by_id(
-        std::string_view collection, std::string_view id) const;
+    [[nodiscard]] PrimaryIndexer::DocumentPtr get_document_by_id(std::string_view collection,
+                                                                 std::string_view id) const;
 
     /**
-     * @brief Retrieves all documents in a collection from the in-memory primary index.
+     * @brief Visits the documents of a collection in the primary index in chunks.
+     * @details Delegates to `PrimaryIndexer::for_each_chunk`; no document is copied, and no more
+     * than a shard's worth of pointers is materialized at a time.
+     * @warning The pointers remain valid only while the caller excludes writers to the collection.
      * @param collection The name of the collection.
-     * @return A vector of BSON documents.
+     * @param chunk_size The number of documents per chunk.
+     * @param visit Called with each chunk; returning `false` stops the iteration.
+     * @return `false` if `visit` stopped the iteration, `true` otherwise.
      */
-    [[nodiscard]] std::vector<aevum::bson::doc::Document> get_all_documents(
+    bool for_each_document_chunk(std::string_view collection, size_t chunk_size,
+                                 const PrimaryIndexer::ChunkVisitor &visit) const;
+
+    /**
+     * @brief Borrows read-only pointers to every document of a collection in the primary index.
+     * @details A zero-copy view of the whole collection, used to hand the raw BSON buffers
+     * directly to the Rust query engine.
+     * @warning The pointers remain valid only while the caller excludes writers to the collection.
+     * @param collection The name of the collection.
+     * @return A vector of non-owning document pointers.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> get_document_refs(
         std::string_view collection) const;
 
+    /**
+     * @brief Returns the number of documents of a collection in the primary index.
+     * @param collection The name of the collection.
+     * @return The number of documents, without borrowing or copying any of them.
+     */
+    [[nodiscard]] size_t document_count(std::string_view collection) const;
+
+    /**
+     * @brief Returns the number and total size of the documents of a collection.
+     * @param collection The name of the collection.
+     * @return The statistics, read from the primary index.
+     */
+    [[nodiscard]] CollectionStatistics collection_statistics(std::string_view collection) const;
+
+    /**
+     * @brief Estimates the memory a collection holds in the indexes.
+     * @details The documents are counted at their BSON length plus a fixed allowance per primary
+     * index entry, hash and ordered indexes at a fixed allowance per entry, and columnar and text
+     * indexes by walking their tables. This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @return The estimate; zero for a collection that is not resident.
+     */
+    [[nodiscard]] CollectionMemory memory_usage(std::string_view collection) const;
+
+    /**
+     * @brief Returns the statistics of a secondary index.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field, or compound index name, carrying a hash or ordered index.
+     * @return A copy of the statistics, or empty ones if there is no such index.
+     */
+    [[nodiscard]] IndexStatistics index_statistics(std::string_view collection,
+                                                   std::string_view field) const;
+
+    /**
+     * @brief Estimates the number of entries of a hash index filed under a key.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field, or compound index name, carrying a `HASH` index.
+     * @param key The index key.
+     * @return The estimate, from the index's statistics.
+     */
+    [[nodiscard]] double estimate_equal(std::string_view collection, std::string_view field,
+                                        std::string_view key) const;
+
+    /**
+     * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys.
+     * @return The estimate, from the index's statistics.
+     */
+    [[nodiscard]] double estimate_range(std::string_view collection, std::string_view field,
+                                        const KeyRange &range) const;
+
+    /**
+     * @brief Borrows a read-only pointer to a single document by its `_id`.
+     * @details The zero-copy counterpart of `get_document_by_id`.
+     * @warning The pointer remains valid only while the caller excludes writers to the collection.
+     * @param collection The name of the collection.
+     * @param id The unique `_id` of the document.
+     * @return A non-owning pointer to the document, or `nullptr` if it does not exist.
+     */
+    [[nodiscard]] const aevum::bson::doc::Document *get_document_ref_by_id(
+        std::string_view collection, std::string_view id) const;
+
+    /**
+     * @brief Checks whether a collection may hold a document with a given `_id`.
+     * @details Probes the collection's `_id` filter, which is meant for collections that are not
+     * resident: a miss there saves a storage read, while the primary index of a resident
+     * collection answers a miss with a single probe of its own. This operation acquires a shared
+     * read lock.
+     * @param collection The name of the collection.
+     * @param id The `_id` to look for.
+     * @return `false` only if no document of the collection has this `_id`; `true` if it may, or
+     *         if the collection has no `_id` filter.
+     */
+    [[nodiscard]] bool may_contain_id(std::string_view collection, std::string_view id) const;
+
+    /**
+     * @brief Adds the `_id`s of documents written to a collection that is not resident.
+     * @details Such writes bypass `add_document_to_indexes`, so they are recorded here to keep the
+     * collection's `_id` filter, if it has one, complete. A filter that becomes overfull cannot be
+     * rebuilt without the collection's `_id`s and is discarded.
+     * @param collection The name of the collection.
+     * @param ids The `_id`s of the written documents.
+     */
+    void add_unloaded_ids(std::string_view collection, const std::vector<std::string> &ids);
+
     /**
      * @brief Retrieves all documents matching a specific value in a secondary index.
-     * @details Delegates to the `SecondaryIndexer` to perform an efficient, index-backed query.
-     * This operation acquires a shared read lock.
+     * @details Looks up the matching `_id`s in the `SecondaryIndexer` and resolves them through
+     * the `PrimaryIndexer`. This operation acquires a shared read lock.
      * @param collection The name of the collection.
      * @param field The indexed field to query.
      * @param value The value to match within the indexed field.
@@ -120,17 +358,218 @@ class IndexManager {
     [[nodiscard]] std::vector<aevum::bson::doc::Document> get_documents_by_secondary_index(
         std::string_view collection, std::string_view field, std::string_view value) const;
 
+    /**
+     * @brief Retrieves the `_id`s of all documents matching a specific value in a secondary index.
+     * @details Used by the query planner to build a candidate set without copying documents.
+     * This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The indexed field to query.
+     * @param key The index key to match, as produced by `SecondaryIndexer::to_index_key`.
+     * @return The `_id`s of the matching documents.
+     */
+    [[nodiscard]] std::vector<std::string> get_ids_by_secondary_index(std::string_view collection,
+                                                                      std::string_view field,
+                                                                      std::string_view key) const;
+
+    /**
+     * @brief Checks whether a secondary index exists on a field of a collection.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field to check.
+     * @return `true` if the field is indexed, `false` otherwise.
+     */
+    [[nodiscard]] bool is_field_indexed(std::string_view collection, std::string_view field) const;
+
+    /**
+     * @brief Checks whether a collection has any secondary index.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @return `true` if at least one field of the collection is indexed, `false` otherwise.
+     */
+    [[nodiscard]] bool has_secondary_indexes(std::string_view collection) const;
+
+    /**
+     * @brief Lists the field paths the secondary indexes of a collection are built on.
+     * @details A compound index contributes each of its fields. This operation acquires a shared
+     * read lock.
+     * @param collection The name of the collection.
+     * @return The paths, possibly with repetitions; empty if the collection has no index.
+     */
+    [[nodiscard]] std::vector<std::string> indexed_paths(std::string_view collection) const;
+
+    /**
+     * @brief Lists the filters of the sparse and partial indexes of a collection.
+     * @details The query planner uses an index that has a filter only for a query whose matches
+     * the filter is known to admit. This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @return The filters, by index name; empty if every index holds every document.
+     */
+    [[nodiscard]] std::unordered_map<std::string, IndexFilterPtr> index_filters(
+        std::string_view collection) const;
+
+    /**
+     * @brief Looks up the type of the secondary index on a field of a collection.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field to check.
+     * @return The field's `IndexType`, or `std::nullopt` if it is not indexed.
+     */
+    [[nodiscard]] std::optional<IndexType> get_index_type(std::string_view collection,
+                                                          std::string_view field) const;
+
+    /**
+     * @brief Checks whether an ordered index holds entries for the elements of an array.
+     * @details This operation acquires a shared read lock. See `SecondaryIndexer::is_multikey`.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @return `true` if the index has more entries than documents.
+     */
+    [[nodiscard]] bool is_multikey(std::string_view collection, std::string_view field) const;
+
+    /**
+     * @brief Lists the compound hash indexes of a collection.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @return The names of the indexes, each a list of fields joined by `INDEX_FIELD_SEPARATOR`.
+     */
+    [[nodiscard]] std::vector<std::string> get_compound_indexes(
+        std::string_view collection) const;
+
+    /**
+     * @brief Retrieves the `_id`s of the documents whose key lies in a range of an ordered index.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to collect.
+     * @param limit The most entries to collect, or 0 for all of them.
+     * @return The `_id`s of the matching documents in ascending key order.
+     */
+    [[nodiscard]] std::vector<std::string> get_ids_in_range(std::string_view collection,
+                                                            std::string_view field,
+                                                            const KeyRange &range,
+                                                            size_t limit = 0) const;
+
+    /**
+     * @brief Counts the documents whose key lies in a range of an ordered index.
+     * @details No `_id` is copied and no document is resolved. This operation acquires a shared
+     * read lock.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to count.
+     * @return The number of documents in `range`.
+     */
+    [[nodiscard]] size_t count_in_range(std::string_view collection, std::string_view field,
+                                        const KeyRange &range) const;
+
+    /**
+     * @brief Visits the documents of an ordered index in key order, stopping on request.
+     * @details Each index entry is resolved through the primary index before it is passed to
+     * `visit`. A shared read lock is held for the whole traversal, so `visit` must not call back
+     * into the `IndexManager`.
+     * @warning The pointers passed to `visit` remain valid only while the caller excludes writers
+     * to the collection.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to visit.
+     * @param descending `true` to visit from the largest key down.
+     * @param visit Called with each document; returning `false` ends the traversal.
+     */
+    void scan_ordered_index(
+        std::string_view collection, std::string_view field, const KeyRange &range,
+        bool descending,
+        const std::function<bool(const aevum::bson::doc::Document *)> &visit) const;
+
+    /**
+     * @brief Visits the entries of an ordered index in key order, without resolving documents.
+     * @details Each entry is passed as its key and `_id`. A shared read lock is held for the
+     * whole traversal, so `visit` must not call back into the `IndexManager`.
+     * @param collection The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to visit.
+     * @param descending `true` to visit from the largest key down.
+     * @param visit Called with each entry; returning `false` ends the traversal.
+     */
+    void scan_index_entries(
+        std::string_view collection, std::string_view field, const KeyRange &range,
+        bool descending,
+        const std::function<bool(const IndexKey &, const std::string &)> &visit) const;
+
+    /**
+     * @brief Selects the documents of a collection that satisfy predicates on columnar indexes.
+     * @details The predicates are evaluated over the columns and their selections intersected
+     * before any document is resolved (see `ColumnStore::select`). If the collection has no
+     * columnar index, every document is selected. This operation acquires a shared read lock.
+     * @warning The pointers remain valid only while the caller excludes writers to the collection.
+     * @param collection The name of the collection.
+     * @param predicates The predicates, on fields carrying a `COLUMNAR` index.
+     * @return Non-owning pointers to a superset of the documents satisfying every predicate.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> select_by_columns(
+        std::string_view collection, const std::vector<ColumnPredicate> &predicates) const;
+
+    /**
+     * @brief Ranks the documents of a collection against a `$text` search.
+     * @details The search reads the posting lists of the text's terms in every text index of the
+     * collection (see `TextIndex::search`). This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param text The search text.
+     * @param wanted The number of best documents to return, or 0 for all of them.
+     * @return The `_id`s of the documents holding any term of the text, with their BM25 scores,
+     *         best first; empty if the collection has no text index.
+     */
+    [[nodiscard]] std::vector<TextHit> search_text(std::string_view collection,
+                                                   std::string_view text, size_t wanted) const;
+
+    /**
+     * @brief Checks whether a collection has a text index.
+     * @details This operation acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @return `true` if at least one of its fields has a `TEXT` index.
+     */
+    [[nodiscard]] bool has_text_index(std::string_view collection) const;
+
     /**
      * @brief Atomically adds a new document to both the primary and all applicable secondary
      * indexes.
      * @details This is a write operation that should be invoked after a document has been
-     * successfully inserted into the storage engine.
+     * successfully inserted into the storage engine. If a document with the same `_id` is
+     * already indexed, its previous image is first removed from the secondary indexes so that no
+     * stale entry survives the overwrite.
      * @param collection The name of the collection where the document was inserted.
      * @param doc The BSON document to be added to the indexes.
      */
     void add_document_to_indexes(std::string_view collection,
                                  const aevum::bson::doc::Document &doc);
 
+    /**
+     * @brief Adds a batch of documents to the primary and secondary indexes under a single
+     * exclusive lock.
+     * @details Equivalent to calling `add_document_to_indexes` for each document in order, but the
+     * lock is acquired only once for the whole batch, so a bulk insert does not hand the lock back
+     * and forth with concurrent readers between documents.
+     * @param collection The name of the collection where the documents were inserted.
+     * @param docs The BSON documents to be added to the indexes.
+     */
+    void add_documents_to_indexes(std::string_view collection,
+                                  const std::vector<aevum::bson::doc::Document> &docs);
+
+    /**
+     * @brief Applies an in-place update of a document to the indexes.
+     * @details The counterpart of `add_document_to_indexes` for an update written as byte
+     * patches (see `PrimaryIndexer::patch_document`). The secondary indexes are touched only if
+     * `reindex` is set, since an update that changes no indexed field leaves their entries as
+     * they were, and so is the `TextIndex`; a collection with columnar indexes always gets the
+     * new image in its columns.
+     * @param collection The name of the collection.
+     * @param id The `_id` of the document.
+     * @param patches The runs of bytes the update replaced.
+     * @param after The updated document.
+     * @param reindex Whether the update may have changed an indexed field.
+     */
+    void patch_document(std::string_view collection, std::string_view id,
+                        const std::vector<aevum::db::storage::ValuePatch> &patches,
+                        const aevum::bson::doc::Document &after, bool reindex);
+
     /**
      * @brief Atomically removes a document from both the primary and all applicable secondary
      * indexes.
@@ -142,6 +581,34 @@ class IndexManager {
     void remove_document_from_indexes(std::string_view collection,
                                       const aevum::bson::doc::Document &doc);
 
+    /**
+     * @brief Atomically removes a batch of documents from the primary and all applicable
+     * secondary indexes.
+     * @details The bulk counterpart of `remove_document_from_indexes`, taking the exclusive lock
+     * once for the whole batch; see `SecondaryIndexer::remove_documents` for how the secondary
+     * removals are grouped. The handles keep the documents alive until they are de-indexed.
+     * @param collection The name of the collection from which the documents were removed.
+     * @param docs Handles to the indexed images of the removed documents.
+     */
+    void remove_documents_from_indexes(std::string_view collection,
+                                       const std::vector<PrimaryIndexer::DocumentPtr> &docs);
+
+    /**
+     * @brief Computes the writes that keep the persisted index entries in step with a document
+     * change.
+     * @details For every secondary index of the collection, the entry of the before image is
+     * removed and the entry of the after image inserted, unless the two are the same. The
+     * writes are meant to be committed in the same `WiredTigerStore::apply_batch` as the
+     * document change itself. This acquires a shared read lock.
+     * @param collection The name of the collection.
+     * @param before The previous image of the document, or `nullptr` for an insertion.
+     * @param after The new image of the document, or `nullptr` for a removal.
+     * @return The key writes, empty if the collection has no secondary index.
+     */
+    [[nodiscard]] std::vector<aevum::db::storage::KeyWrite> index_entry_writes(
+        std::string_view collection, const aevum::bson::doc::Document *before,
+        const aevum::bson::doc::Document *after) const;
+
     /**
      * @brief Loads all secondary index definitions from persistent storage into memory.
      * @details This method is a key part of the database startup sequence. It acquires an exclusive
@@ -150,11 +617,33 @@ class IndexManager {
      */
     [[nodiscard]] aevum::util::Status load_all_index_definitions();
 
+    /**
+     * @brief Restores the `_id` filters stored by `persist_id_filters` at the last shutdown.
+     * @details Called at startup, after the index definitions are loaded. The filters are deleted
+     * from storage as they are read (see `IndexPersistor::take_id_filters`), so a filter survives
+     * only a clean shutdown. They serve collections that are not yet resident; loading a
+     * collection replaces its filter with one built from its documents.
+     * @return An `aevum::util::Status` indicating whether the filters could be read and deleted.
+     */
+    [[nodiscard]] aevum::util::Status load_id_filters();
+
+    /**
+     * @brief Stores the `_id` filter of every collection that has one.
+     * @details Called at shutdown, once no more writes are accepted. This acquires a shared read
+     * lock.
+     * @return An `aevum::util::Status` indicating the outcome of the persistence operation.
+     */
+    [[nodiscard]] aevum::util::Status persist_id_filters();
+
   private:
     /// An instance of the primary indexer, responsible for `_id`-based lookups.
     PrimaryIndexer primary_indexer_;
     /// An instance of the secondary indexer, responsible for field-based lookups.
     SecondaryIndexer secondary_indexer_;
+    /// The dense columns of every `COLUMNAR` index.
+    ColumnStore column_store_;
+    /// The posting lists of every `TEXT` index.
+    TextIndex text_index_;
     /// A component responsible for reading and writing index metadata to durable storage.
     IndexPersistor index_persistor_;
 
@@ -167,19 +656,190 @@ class IndexManager {
     mutable std::shared_mutex rw_lock_;
 
     /**
-     * @brief Persists the current configuration of secondary indexes to durable storage.
-     * @details This private helper acquires an exclusive lock and delegates the serialization
-     * and storage task to the `IndexPersistor`.
+     * @var id_filters_
+     * @brief The `_id` filter of every collection known to hold no other `_id`s, by name.
+     * A resident collection gets one when it is loaded or first indexed, and it is rebuilt from
+     * the primary index when it becomes overfull. Guarded by `rw_lock_`.
+     */
+    std::unordered_map<std::string, BloomFilter> id_filters_;
+
+    /**
+     * @var ttl_indexes_
+     * @brief The time-to-live of every TTL index, persisted with the index definitions. Guarded
+     * by `rw_lock_`.
+     */
+    TtlDefinitions ttl_indexes_;
+
+    /**
+     * @brief Rebuilds the `_id` filter of a resident collection from its primary index.
+     * @details The filter is sized for twice the collection's documents. The caller must hold
+     * `rw_lock_` exclusively.
+     * @param collection The name of the collection.
+     */
+    void rebuild_id_filter_locked(const std::string &collection);
+
+    /**
+     * @struct IndexBuild
+     * @brief An index being built by `create_index`, with the side buffer of concurrent writes.
+     */
+    struct IndexBuild {
+        /// The indexed collection.
+        std::string collection;
+        /// The indexed field.
+        std::string field;
+        /// The type of the index.
+        IndexType type;
+        /// The documents in the collection when the build started.
+        std::atomic<size_t> documents{0};
+        /// The documents scanned so far.
+        std::atomic<size_t> scanned{0};
+        /// The `_id`s written since the build started. Guarded by `builds_mutex_`.
+        std::unordered_set<std::string> written;
+    };
+
+    /// Guards `builds_` and the side buffers of the builds.
+    mutable std::mutex builds_mutex_;
+    /// The index builds in flight, in the order they started.
+    std::vector<std::shared_ptr<IndexBuild>> builds_;
+    /// The size of `builds_`, read by writers without taking `builds_mutex_`.
+    std::atomic<size_t> active_builds_{0};
+
+    /**
+     * @brief Records a write in the side buffer of every build on its collection.
+     * @details Called by every write to the indexes; costs one atomic load while no index is
+     * being built.
+     * @param collection The name of the collection.
+     * @param id The `_id` of the written document.
+     */
+    void note_build_write(const std::string &collection, const std::string &id);
+
+    /**
+     * @brief Unregisters a build and hands over its side buffer.
+     * @param build The build.
+     * @return The `_id`s written since the build started.
+     */
+    std::unordered_set<std::string> end_index_build(const std::shared_ptr<IndexBuild> &build);
+
+    /**
+     * @brief Builds a `COLUMNAR` index from the primary index and persists its definition.
+     * @details The caller holds the collection's writer lock exclusively.
+     * @param collection The name of the collection.
+     * @param field The indexed field.
+     * @return The status of persisting the definition.
+     */
+    [[nodiscard]] aevum::util::Status create_columnar_index(const std::string &collection,
+                                                            const std::string &field);
+
+    /**
+     * @brief Builds a `TEXT` index from the primary index and persists its definition.
+     * @details The caller holds the collection's writer lock exclusively.
+     * @param collection The name of the collection.
+     * @param field The indexed field.
+     * @return The status of persisting the definition.
+     */
+    [[nodiscard]] aevum::util::Status create_text_index(const std::string &collection,
+                                                        const std::string &field);
+
+    /**
+     * @brief Persists the registered definition of one secondary index to durable storage.
+     * @details The type, time-to-live, and options are read under a shared lock and handed to the
+     * `IndexPersistor`, which writes that definition alone.
+     * @param collection The name of the collection.
+     * @param field The indexed field.
      * @return An `aevum::util::Status` indicating the outcome of the persistence operation.
      */
-    [[nodiscard]] aevum::util::Status persist_index_definitions();
+    [[nodiscard]] aevum::util::Status persist_index_definition(const std::string &collection,
+                                                               const std::string &field);
+
+    /**
+     * @brief Adds a document to the primary and secondary indexes without locking.
+     * @details The shared implementation of `add_document_to_indexes` and
+     * `add_documents_to_indexes`. The caller must hold `rw_lock_` exclusively.
+     * @param collection The name of the collection.
+     * @param doc The document to be added to the indexes.
+     */
+    void index_document_locked(const std::string &collection,
+                               const aevum::bson::doc::Document &doc);
+
+    /**
+     * @brief Builds the columnar indexes of a collection from the primary index.
+     * @details The document handles are read under the primary index's own shard locks, so
+     * `rw_lock_` is not needed until the result is installed with `ColumnStore::install_table`.
+     * The caller must exclude writers to the collection meanwhile.
+     * @param collection The name of the collection.
+     * @param fields The fields carrying a `COLUMNAR` index.
+     * @return The table; one without columns if `fields` is empty.
+     */
+    [[nodiscard]] ColumnStore::Table build_columns(const std::string &collection,
+                                                   const std::vector<std::string> &fields) const;
+
+    /**
+     * @brief Builds the text indexes of a collection from the primary index.
+     * @details Locking is as for `build_columns`; the result is installed with
+     * `TextIndex::install_table`.
+     * @param collection The name of the collection.
+     * @param fields The fields carrying a `TEXT` index.
+     * @return The table; one without fields if `fields` is empty.
+     */
+    [[nodiscard]] TextIndex::Table build_text(const std::string &collection,
+                                              const std::vector<std::string> &fields) const;
+
+    /**
+     * @brief Computes the entries of an index on one field from one document.
+     * @details Only the container matching `type` is filled, without sorting; `keys` receives
+     * the storage encoding of every entry. A document has several entries in a multikey or
+     * compound index, and none in a filtered index that does not admit it.
+     * @param field The name of the index.
+     * @param type The type of the index; not `COLUMNAR` or `TEXT`.
+     * @param filter The filter of the index, or `nullptr`.
+     * @param doc The document to index.
+     * @param hash Receives the entries of a `HASH` index.
+     * @param ordered Receives the entries of an `ORDERED` index.
+     * @param keys Receives the encoded entries.
+     */
+    void collect_field_entry(const std::string &field, IndexType type, const IndexFilter *filter,
+                             const aevum::bson::doc::Document &doc, HashEntries &hash,
+                             OrderedEntries &ordered, std::vector<std::string> &keys) const;
+
+    /**
+     * @brief Computes the entries of an index on one field from a set of documents.
+     * @details Only the container matching `type` is filled; `keys` receives the storage
+     * encoding of every entry.
+     * @param field The indexed field.
+     * @param type The type of the index.
+     * @param filter The filter of the index, or `nullptr`.
+     * @param documents The documents to index.
+     * @param hash Receives the entries of a `HASH` index.
+     * @param ordered Receives the entries of an `ORDERED` index, in ascending order.
+     * @param keys Receives the encoded entries, in no particular order.
+     */
+    void collect_field_entries(const std::string &field, IndexType type,
+                               const IndexFilter *filter,
+                               const std::vector<aevum::bson::doc::Document> &documents,
+                               HashEntries &hash, OrderedEntries &ordered,
+                               std::vector<std::string> &keys) const;
+
+    /**
+     * @brief Loads the indexes of a collection from its documents, its persisted entries, and
+     * optionally its image; the body of `load_collection_indexes` and `load_collection_image`.
+     * @param collection The name of the collection.
+     * @param documents All documents of the collection; they are moved into the primary index.
+     * @param image The image to take the entries of the indexes it holds from, or `nullptr`.
+     * @param changed The `_id`s whose entries in `image` are outdated; used with `image` only.
+     * @param changed_from The position in `documents` of the first current version of a document
+     *        of `changed`; every document from there on is one.
+     */
+    void load_collection(std::string_view collection,
+                         std::vector<aevum::bson::doc::Document> documents,
+                         const IndexImage *image, const std::unordered_set<std::string> &changed,
+                         size_t changed_from);
 
     /**
      * @brief A private helper to efficiently extract the string representation of a document's
      * `_id`.
      * @param doc The BSON document from which to extract the `_id`.
-     * @return The `_id` as a `std::string`, or an empty string if the `_id` is not found or is not
-     * a string.
+     * @return The `_id`'s key, as produced by `PrimaryIndexer::to_id_key`, or an empty string if
+     * the `_id` is not found or is neither a string nor an integer.
      */
     [[nodiscard]] std::string extract_id(const aevum::bson::doc::Document &doc) const;
 };
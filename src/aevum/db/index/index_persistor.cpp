@@ -12,83 +12,146 @@
  */
 #include "aevum/db/index/index_persistor.hpp"
 
+#include <algorithm>
 #include <bson/bson.h>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "aevum/bson/json/parser.hpp"
 #include "aevum/util/log/logger.hpp"
 
 namespace aevum::db::index {
 
+namespace {
+
+/// Escape byte of the entry encoding. Storage keys are NUL-terminated strings, so the bytes
+/// `0x00` and `0x01` of an encoded value are written as `0x01 0x02` and `0x01 0x03`.
+constexpr char ENTRY_ESCAPE = '\x01';
+/// Separates the encoded value from the `_id`. It sorts below every escaped or plain byte, so a
+/// value that is a prefix of another sorts first, as it does in `IndexKey` order.
+constexpr std::string_view ENTRY_SEPARATOR = "\x01\x01";
+
 /**
- * @brief Constructs an `IndexPersistor`, establishing a link to the database's storage layer.
- * @param storage A reference to the active `WiredTigerStore` instance that will be used for all
- *        persistence operations.
+ * @brief Appends bytes to an entry key, escaping the bytes that cannot appear in a storage key.
+ * @param out The key being built.
+ * @param bytes The bytes to append.
  */
-IndexPersistor::IndexPersistor(aevum::db::storage::WiredTigerStore &storage) : storage_(storage) {}
+void append_entry_bytes(std::string &out, std::string_view bytes) {
+    for (char c : bytes) {
+        if (c == '\0' || c == ENTRY_ESCAPE) {
+            out += ENTRY_ESCAPE;
+            out += static_cast<char>(c + 2);
+        } else {
+            out += c;
+        }
+    }
+}
 
 /**
- * @brief Serializes and persists the complete set of current index definitions to durable storage.
- * @details This function performs a "snapshot" and "replace" operation. It first completely clears
- * the `_indexes` system collection using `sync_collection` with an empty dataset. This ensures that
- * stale index definitions are removed. It then iterates through the provided `indexed_fields` map.
- * For each `collection`-`field` pair, it constructs a new BSON document of the form
- * `{ "collection": "...", "field": "..." }`. This document is then saved to the `_indexes`
- * collection using a composite key (e.g., "collection_name::field_name") to ensure uniqueness.
- *
- * @param indexed_fields A constant reference to the in-memory map representing the complete state
- *        of all secondary indexes (`collection_name -> {field1, field2, ...}`).
- * @return Returns `true` if the entire operation, including clearing and saving all definitions,
- *         completes without error. Returns `false` if any storage operation fails.
- */
-bool IndexPersistor::persist_index_definitions(
-    const std::unordered_map<std::string, std::unordered_set<std::string>> &indexed_fields) {
-    aevum::util::log::Logger::debug("IndexPersistor: Starting persistence of index definitions.");
-    // Atomically clear all previous index definitions to ensure a clean slate.
-    auto status = storage_.sync_collection("_indexes", {});
-    if (!status.ok()) {
-        aevum::util::log::Logger::error(
-            "IndexPersistor: Failed to clear old index definitions from storage. Status: " +
-            status.to_string());
-        return false;
+ * @brief Splits an entry key into its unescaped value and its `_id`.
+ * @param entry The storage key.
+ * @param value Receives the unescaped value bytes.
+ * @param id Receives the `_id`.
+ * @return `false` if the key is not a well-formed entry.
+ */
+bool split_entry(std::string_view entry, std::string &value, std::string &id) {
+    value.clear();
+    for (size_t i = 0; i < entry.size(); ++i) {
+        if (entry[i] != ENTRY_ESCAPE) {
+            value += entry[i];
+            continue;
+        }
+        if (++i == entry.size()) return false;
+        if (entry[i] == ENTRY_ESCAPE) {
+            id.assign(entry.substr(i + 1));
+            return true;
+        }
+        if (entry[i] != '\x02' && entry[i] != '\x03') return false;
+        value += static_cast<char>(entry[i] - 2);
     }
-    aevum::util::log::Logger::debug("IndexPersistor: Successfully cleared old index definitions.");
+    return false;
+}
 
-    bool overall_success = true;
-    int definition_count = 0;
+/**
+ * @brief Maps a double onto an unsigned integer with the same order, for byte-wise comparison.
+ * @details Negative zero is folded into positive zero first, since the two compare equal.
+ * @param number The finite double to map.
+ * @return The order-preserving image of `number`.
+ */
+uint64_t sortable_bits(double number) {
+    if (number == 0.0) number = 0.0;
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    return (bits & (1ULL << 63)) != 0 ? ~bits : bits | (1ULL << 63);
+}
 
-    for (const auto &[collection, fields] : indexed_fields) {
-        for (const auto &field : fields) {
-            // Dynamically construct a BSON document for each index metadata entry.
-            bson_t *b = bson_new();
-            bson_append_utf8(b, "collection", -1, collection.c_str(), -1);
-            bson_append_utf8(b, "field", -1, field.c_str(), -1);
+/**
+ * @brief Inverts `sortable_bits`.
+ * @param bits The order-preserving image of a double.
+ * @return The double.
+ */
+double from_sortable_bits(uint64_t bits) {
+    bits = (bits & (1ULL << 63)) != 0 ? bits & ~(1ULL << 63) : ~bits;
+    double number;
+    std::memcpy(&number, &bits, sizeof(number));
+    return number;
+}
 
-            aevum::bson::doc::Document doc(b);
+}  // namespace
 
-            // Use a composite key to uniquely identify each index definition document.
-            std::string meta_id = collection + "::" + field;
+/**
+ * @brief Constructs an `IndexPersistor`, establishing a link to the database's storage layer.
+ * @param storage A reference to the active `WiredTigerStore` instance that will be used for all
+ *        persistence operations.
+ */
+IndexPersistor::IndexPersistor(aevum::db::storage::WiredTigerStore &storage) : storage_(storage) {}
 
-            // Persist the newly created index definition document into the system collection.
-            auto put_status = storage_.put("_indexes", meta_id, doc);
-            if (!put_status.ok()) {
-                aevum::util::log::Logger::error(
-                    "IndexPersistor: Failed to persist index definition for '" + meta_id +
-                    "'. Status: " + put_status.to_string());
-                overall_success = false;
-            } else {
-                definition_count++;
-            }
-        }
+/**
+ * @brief Persists the definition of one index.
+ * @details The definition is a BSON document of the form
+ * `{ "collection": "...", "field": "...", "type": "hash" | "ordered" | "columnar" }`, with the
+ * `expire_after_seconds` of a TTL index, the `sparse` flag of a sparse index, and the
+ * `partial_filter` of a partial index (its JSON text), written under the composite key
+ * `collection_name::field_name` by a single-record `apply_batch`.
+ *
+ * @param collection The name of the indexed collection.
+ * @param field The indexed field.
+ * @param type The organization of the index.
+ * @param expire_after_seconds The time-to-live of a TTL index.
+ * @param options The options of a sparse or partial index.
+ * @return Returns `true` if the write committed, or `false` if the storage operation failed.
+ */
+bool IndexPersistor::store_index_definition(const std::string &collection,
+                                            const std::string &field, IndexType type,
+                                            std::optional<int64_t> expire_after_seconds,
+                                            const IndexOptions &options) {
+    std::string type_str(to_string(type));
+    bson_t *b = bson_new();
+    bson_append_utf8(b, "collection", -1, collection.c_str(), -1);
+    bson_append_utf8(b, "field", -1, field.c_str(), -1);
+    bson_append_utf8(b, "type", -1, type_str.c_str(), -1);
+    if (expire_after_seconds) {
+        bson_append_int64(b, "expire_after_seconds", -1, *expire_after_seconds);
+    }
+    if (options.sparse) bson_append_bool(b, "sparse", -1, true);
+    if (!options.partial_filter.empty()) {
+        bson_append_utf8(b, "partial_filter", -1, options.partial_filter.data(),
+                         static_cast<int>(options.partial_filter.size()));
     }
 
-    if (overall_success) {
-        aevum::util::log::Logger::info("IndexPersistor: Successfully persisted " +
-                                       std::to_string(definition_count) + " index definitions.");
-    } else {
-        aevum::util::log::Logger::error(
-            "IndexPersistor: One or more index definitions failed to persist.");
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.emplace_back(collection + "::" + field, aevum::bson::doc::Document(b));
+    auto status = storage_.apply_batch("_indexes", puts, {});
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to persist the definition of index '" +
+                        collection + "." + field + "'. Status: " + status.to_string());
+        return false;
     }
-    return overall_success;
+    AEVUM_LOG_DEBUG("IndexPersistor: Persisted the definition of index '" + collection + "." +
+                    field + "'.");
+    return true;
 }
 
 /**
@@ -96,19 +159,25 @@ bool IndexPersistor::persist_index_definitions(
  * and populates an in-memory map.
  * @details This function is a core part of the database startup sequence. It retrieves all
  * documents from the `_indexes` collection. For each document, it extracts the `collection` and
- * `field` string values. It then uses these values to populate the provided `indexed_fields` map,
- * effectively reconstructing the in-memory representation of the secondary index configuration.
+ * `field` string values, along with the optional `type` (defaulting to `hash` for definitions
+ * written by earlier versions), the optional `expire_after_seconds` of a TTL index, and the
+ * optional `sparse` and `partial_filter` of a filtered index. It then uses these values to
+ * populate the provided `indexed_fields` map, effectively reconstructing the in-memory
+ * representation of the secondary index configuration.
  *
  * @param indexed_fields A mutable reference to the `SecondaryIndexer`'s map, which will be
  *        populated with the loaded definitions.
+ * @param ttls Receives the time-to-live of the definitions that carry one.
+ * @param options Receives the options of the definitions of sparse and partial indexes.
  * @return Returns `true` upon successful completion of the loading process. This function currently
  *         always returns `true`, as failures to read individual documents are logged but do not
  *         halt the entire process. A more robust implementation might return `false` on parsing
  * errors.
  */
-bool IndexPersistor::load_index_definitions(
-    std::unordered_map<std::string, std::unordered_set<std::string>> &indexed_fields) {
-    aevum::util::log::Logger::debug("IndexPersistor: Loading index definitions from storage.");
+bool IndexPersistor::load_index_definitions(IndexDefinitions &indexed_fields,
+                                            TtlDefinitions &ttls,
+                                            IndexOptionDefinitions &options) {
+    AEVUM_LOG_DEBUG("IndexPersistor: Loading index definitions from storage.");
     std::vector<aevum::bson::doc::Document> docs = storage_.load_collection("_indexes");
     int loaded_count = 0;
 
@@ -118,6 +187,7 @@ bool IndexPersistor::load_index_definitions(
         bson_iter_t iter;
         std::string collection_name;
         std::string field_name;
+        IndexType type = IndexType::HASH;
 
         // Safely extract the 'collection' name from the BSON document.
         if (bson_iter_init_find(&iter, doc.get(), "collection") && BSON_ITER_HOLDS_UTF8(&iter)) {
@@ -129,15 +199,327 @@ bool IndexPersistor::load_index_definitions(
             field_name = bson_iter_utf8(&iter, nullptr);
         }
 
+        // Definitions persisted before index types were introduced are hash indexes.
+        if (bson_iter_init_find(&iter, doc.get(), "type") && BSON_ITER_HOLDS_UTF8(&iter)) {
+            auto parsed = index_type_from_string(bson_iter_utf8(&iter, nullptr));
+            if (parsed) type = *parsed;
+        }
+
         // If both fields were successfully extracted, populate the in-memory map.
         if (!collection_name.empty() && !field_name.empty()) {
-            indexed_fields[collection_name].insert(field_name);
+            indexed_fields[collection_name].emplace(field_name, type);
+            if (bson_iter_init_find(&iter, doc.get(), "expire_after_seconds") &&
+                BSON_ITER_HOLDS_INT64(&iter)) {
+                ttls[collection_name][field_name] = bson_iter_int64(&iter);
+            }
+            IndexOptions index_options;
+            if (bson_iter_init_find(&iter, doc.get(), "sparse") && BSON_ITER_HOLDS_BOOL(&iter)) {
+                index_options.sparse = bson_iter_bool(&iter);
+            }
+            if (bson_iter_init_find(&iter, doc.get(), "partial_filter") &&
+                BSON_ITER_HOLDS_UTF8(&iter)) {
+                uint32_t length = 0;
+                const char *filter = bson_iter_utf8(&iter, &length);
+                index_options.partial_filter.assign(filter, length);
+            }
+            if (!index_options.empty()) {
+                options[collection_name][field_name] = std::move(index_options);
+            }
             loaded_count++;
         }
     }
 
-    aevum::util::log::Logger::info("IndexPersistor: Loaded " + std::to_string(loaded_count) +
-                                   " index definitions from storage.");
+    AEVUM_LOG_INFO("IndexPersistor: Loaded " + std::to_string(loaded_count) +
+                   " index definitions from storage.");
+    return true;
+}
+
+/**
+ * @brief Returns the name of the table holding the entries of an index.
+ * @param collection The name of the indexed collection.
+ * @param field The indexed field.
+ * @return `_index.<collection>.<field>`.
+ */
+std::string IndexPersistor::entry_table(std::string_view collection, std::string_view field) {
+    std::string table(ENTRY_TABLE_PREFIX);
+    table.append(collection).append(".").append(field);
+    return table;
+}
+
+/**
+ * @brief Checks whether a table holds persisted index entries.
+ * @param table The name of the table.
+ * @return `true` if the name carries the entry-table prefix.
+ */
+bool IndexPersistor::is_entry_table(std::string_view table) {
+    return table.substr(0, ENTRY_TABLE_PREFIX.size()) == ENTRY_TABLE_PREFIX;
+}
+
+/**
+ * @brief Encodes an entry of a hash index as a storage key.
+ * @details The key is the escaped stringified value, the separator, and the `_id`.
+ * @param key The stringified value.
+ * @param id The `_id` of the indexed document.
+ * @return The storage key.
+ */
+std::string IndexPersistor::encode_entry(std::string_view key, std::string_view id) {
+    std::string entry;
+    entry.reserve(key.size() + ENTRY_SEPARATOR.size() + id.size());
+    append_entry_bytes(entry, key);
+    entry.append(ENTRY_SEPARATOR).append(id);
+    return entry;
+}
+
+/**
+ * @brief Encodes an entry of an ordered index as a storage key.
+ * @details The value is written as its `KeyRank` byte, followed for booleans and numbers by the
+ * eight big-endian bytes of `sortable_bits`, and for strings by the text itself. Nulls, arrays
+ * and objects have no payload, matching their equality within a rank. The escaped value is
+ * followed by the separator and the `_id`.
+ * @param key The key of the indexed value.
+ * @param id The `_id` of the indexed document.
+ * @return The storage key.
+ */
+std::string IndexPersistor::encode_entry(const IndexKey &key, std::string_view id) {
+    std::string value(1, static_cast<char>(key.rank));
+    if (key.rank == KeyRank::BOOL || key.rank == KeyRank::NUMBER) {
+        uint64_t bits = sortable_bits(key.number);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            value += static_cast<char>((bits >> shift) & 0xFF);
+        }
+    } else if (key.rank == KeyRank::STRING) {
+        value += key.text;
+    }
+
+    std::string entry;
+    entry.reserve(value.size() + ENTRY_SEPARATOR.size() + id.size() + 4);
+    append_entry_bytes(entry, value);
+    entry.append(ENTRY_SEPARATOR).append(id);
+    return entry;
+}
+
+/**
+ * @brief Decodes an entry of a hash index.
+ * @param entry The encoded entry.
+ * @param key Receives the stringified value.
+ * @param id Receives the `_id`.
+ * @return `false` if the entry has no separator, or an empty value or `_id`.
+ */
+bool IndexPersistor::decode_entry(std::string_view entry, std::string &key, std::string &id) {
+    return split_entry(entry, key, id) && !key.empty() && !id.empty();
+}
+
+/**
+ * @brief Decodes an entry of an ordered index.
+ * @details The reverse of the ordered `encode_entry`: the rank byte, then the eight bytes of
+ * `sortable_bits` for booleans and numbers or the text for strings.
+ * @param entry The encoded entry.
+ * @param key Receives the key.
+ * @param id Receives the `_id`.
+ * @return `false` if the entry is malformed or has an unknown rank.
+ */
+bool IndexPersistor::decode_entry(std::string_view entry, IndexKey &key, std::string &id) {
+    std::string value;
+    if (!split_entry(entry, value, id) || value.empty() || id.empty() ||
+        static_cast<uint8_t>(value[0]) > static_cast<uint8_t>(KeyRank::OBJECT)) {
+        return false;
+    }
+
+    key = IndexKey();
+    key.rank = static_cast<KeyRank>(value[0]);
+    if (key.rank == KeyRank::BOOL || key.rank == KeyRank::NUMBER) {
+        if (value.size() != 9) return false;
+        uint64_t bits = 0;
+        for (size_t i = 1; i < value.size(); ++i) {
+            bits = (bits << 8) | static_cast<uint8_t>(value[i]);
+        }
+        key.number = from_sortable_bits(bits);
+    } else if (key.rank == KeyRank::STRING) {
+        key.text = value.substr(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the persisted entries of a hash index.
+ * @param collection The name of the indexed collection.
+ * @param field The indexed field.
+ * @param entries Receives the `(index key, _id)` pairs.
+ * @return `true` on success, `false` if the table could not be read.
+ */
+bool IndexPersistor::load_index_entries(std::string_view collection, std::string_view field,
+                                        HashEntries &entries) {
+    std::string table = entry_table(collection, field);
+    size_t malformed = 0;
+    auto status = storage_.scan_keys(table, [&](std::string_view entry) {
+        std::string key;
+        std::string id;
+        if (decode_entry(entry, key, id)) {
+            entries.emplace_back(std::move(key), std::move(id));
+        } else {
+            ++malformed;
+        }
+        return true;
+    });
+    if (malformed > 0) {
+        AEVUM_LOG_WARN("IndexPersistor: Skipped " + std::to_string(malformed) +
+                       " malformed entries in '" + table + "'.");
+    }
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to read '" + table + "'. Status: " +
+                        status.to_string());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the persisted entries of an ordered index.
+ * @details The table is read in key order, which is the order of the entries.
+ * @param collection The name of the indexed collection.
+ * @param field The indexed field.
+ * @param entries Receives the `(IndexKey, _id)` pairs in ascending order.
+ * @return `true` on success, `false` if the table could not be read.
+ */
+bool IndexPersistor::load_index_entries(std::string_view collection, std::string_view field,
+                                        OrderedEntries &entries) {
+    std::string table = entry_table(collection, field);
+    size_t malformed = 0;
+    auto status = storage_.scan_keys(table, [&](std::string_view entry) {
+        IndexKey key;
+        std::string id;
+        if (decode_entry(entry, key, id)) {
+            entries.emplace_back(std::move(key), std::move(id));
+        } else {
+            ++malformed;
+        }
+        return true;
+    });
+    if (malformed > 0) {
+        AEVUM_LOG_WARN("IndexPersistor: Skipped " + std::to_string(malformed) +
+                       " malformed entries in '" + table + "'.");
+    }
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to read '" + table + "'. Status: " +
+                        status.to_string());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the persisted entries of an index.
+ * @details Dropping the table first guarantees that the bulk cursor, which requires an empty
+ * table, can be used. The keys are sorted byte-wise, which is the order WiredTiger compares
+ * string keys in, and duplicates are removed.
+ * @param collection The name of the indexed collection.
+ * @param field The indexed field.
+ * @param keys The encoded entries.
+ * @return `true` on success, `false` if the table could not be rewritten.
+ */
+bool IndexPersistor::store_index_entries(std::string_view collection, std::string_view field,
+                                         std::vector<std::string> keys) {
+    std::string table = entry_table(collection, field);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    auto status = storage_.drop_collection(table);
+    if (status.ok()) status = storage_.bulk_load_keys(table, keys);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to write '" + table + "'. Status: " +
+                        status.to_string());
+        return false;
+    }
+    AEVUM_LOG_INFO("IndexPersistor: Wrote " + std::to_string(keys.size()) + " entries to '" +
+                   table + "'.");
+    return true;
+}
+
+/**
+ * @brief Applies individual insertions and removals to the persisted entries of indexes.
+ * @details The writes travel in a `WiredTigerStore::apply_batch` of the collection that writes no
+ * document.
+ * @param collection The name of the indexed collection.
+ * @param writes The writes.
+ * @return `true` on success, `false` if the transaction failed.
+ */
+bool IndexPersistor::write_index_entries(std::string_view collection,
+                                         const std::vector<aevum::db::storage::KeyWrite> &writes) {
+    auto status = storage_.apply_batch(collection, {}, {}, writes);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to write " + std::to_string(writes.size()) +
+                        " index entries of '" + std::string(collection) + "'. Status: " +
+                        status.to_string());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stores the `_id` filters of collections in the `_indexes` system collection.
+ * @param filters The collection names and encoded filters.
+ * @return `true` if the batch committed.
+ */
+bool IndexPersistor::store_id_filters(const IdFilterImages &filters) {
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.reserve(filters.size());
+    for (const auto &[collection, image] : filters) {
+        bson_t *b = bson_new();
+        bson_append_utf8(b, "collection", -1, collection.c_str(), -1);
+        bson_append_binary(b, "id_filter", -1, BSON_SUBTYPE_BINARY,
+                           reinterpret_cast<const uint8_t *>(image.data()),
+                           static_cast<uint32_t>(image.size()));
+        std::string key = collection;
+        key.append(ID_FILTER_SUFFIX);
+        puts.emplace_back(std::move(key), aevum::bson::doc::Document(b));
+    }
+
+    auto status = storage_.apply_batch("_indexes", puts, {});
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to store " + std::to_string(filters.size()) +
+                        " _id filters. Status: " + status.to_string());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the `_id` filters stored in `_indexes` and deletes them in one transaction.
+ * @param filters Receives the collection names and encoded filters.
+ * @return `true` if the deletion committed.
+ */
+bool IndexPersistor::take_id_filters(IdFilterImages &filters) {
+    std::vector<std::string> deletes;
+    for (const auto &doc : storage_.load_collection("_indexes")) {
+        if (doc.empty() || !doc.get()) continue;
+
+        bson_iter_t iter;
+        if (!bson_iter_init_find(&iter, doc.get(), "id_filter") || !BSON_ITER_HOLDS_BINARY(&iter)) {
+            continue;
+        }
+        bson_subtype_t subtype;
+        uint32_t length = 0;
+        const uint8_t *data = nullptr;
+        bson_iter_binary(&iter, &subtype, &length, &data);
+        std::string image(reinterpret_cast<const char *>(data), length);
+
+        if (!bson_iter_init_find(&iter, doc.get(), "collection") || !BSON_ITER_HOLDS_UTF8(&iter)) {
+            continue;
+        }
+        std::string collection = bson_iter_utf8(&iter, nullptr);
+        std::string key = collection;
+        key.append(ID_FILTER_SUFFIX);
+        deletes.push_back(std::move(key));
+        filters.emplace_back(std::move(collection), std::move(image));
+    }
+    if (deletes.empty()) return true;
+
+    auto status = storage_.apply_batch("_indexes", {}, deletes);
+    if (!status.ok()) {
+        AEVUM_LOG_ERROR("IndexPersistor: Failed to delete the stored _id filters. Status: " +
+                        status.to_string());
+        return false;
+    }
     return true;
 }
 
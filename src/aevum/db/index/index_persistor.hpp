@@ -9,14 +9,20 @@
  * @details This header declares a crucial bridge between the in-memory index configuration and the
  * underlying `WiredTigerStore`. The `IndexPersistor` is responsible for ensuring that secondary
  * index metadata survives database restarts, allowing for the correct reconstruction of index
- * structures upon initialization.
+ * structures upon initialization. It also defines the on-disk format of the index entries
+ * themselves, which are kept in one key-only table per index so that the in-memory indexes can
+ * be restored at startup without re-reading and re-indexing every document.
  */
 #pragma once
 
+#include <optional>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "aevum/db/index/index_filter.hpp"
+#include "aevum/db/index/index_key.hpp"
 #include "aevum/db/storage/wiredtiger_store.hpp"
 
 namespace aevum::db::index {
@@ -31,6 +37,13 @@ namespace aevum::db::index {
  * collection into a storable format within a dedicated system collection (`_indexes`) in
  * WiredTiger. Conversely, it can read from this system collection to repopulate the in-memory
  * configuration when the database starts.
+ *
+ * The entries of the index on `field` of `collection` live in the table
+ * `_index.<collection>.<field>`, one key per `(value, _id)` pair and no value. The value is
+ * encoded so that the byte-wise order of the keys is the order of the index: ordered-index keys
+ * sort like `IndexKey`s, ties broken by `_id`. The table is written in the same transaction as
+ * the documents it indexes (see `WiredTigerStore::apply_batch`), so it never disagrees with the
+ * collection after a crash.
  */
 class IndexPersistor {
   public:
@@ -47,31 +60,168 @@ class IndexPersistor {
     ~IndexPersistor() = default;
 
     /**
-     * @brief Persists the provided set of index definitions to the `_indexes` system collection.
-     * @details This operation is typically destructive, clearing any pre-existing index
-     * definitions in storage before writing the new configuration. It iterates through the provided
-     * map, creating a distinct BSON document for each collection-field pair.
+     * @brief Persists the definition of one index to the `_indexes` system collection.
+     * @details The definition is written under its own key, `<collection>::<field>`, replacing
+     * the stored one if any. The other definitions are neither read nor written, so creating or
+     * changing an index costs one record write however many indexes exist.
      *
-     * @param indexed_fields A constant reference to a map where keys are collection names and
-     *        values are sets of indexed field names for that collection.
-     * @return `true` if all definitions are successfully written to storage, `false` otherwise.
+     * @param collection The name of the indexed collection.
+     * @param field The indexed field.
+     * @param type The organization of the index.
+     * @param expire_after_seconds The time-to-live of a TTL index, recorded as
+     *        `expire_after_seconds` in its definition.
+     * @param options The options of a sparse or partial index, recorded as `sparse` and
+     *        `partial_filter`.
+     * @return `true` if the definition is written to storage, `false` otherwise.
      */
-    [[nodiscard]] bool persist_index_definitions(
-        const std::unordered_map<std::string, std::unordered_set<std::string>> &indexed_fields);
+    [[nodiscard]] bool store_index_definition(const std::string &collection,
+                                              const std::string &field, IndexType type,
+                                              std::optional<int64_t> expire_after_seconds,
+                                              const IndexOptions &options = {});
 
     /**
      * @brief Loads all index definitions from the `_indexes` system collection in storage.
      * @details This method reads all documents from the `_indexes` table and uses their contents
      * to populate the provided `indexed_fields` map, effectively restoring the state of which
-     * fields are indexed for each collection.
+     * fields are indexed for each collection. Definitions written before index types existed
+     * carry no `type` field and are loaded as `HASH` indexes.
      *
      * @param indexed_fields A mutable reference to the map that will be populated with the loaded
      *        index definitions. Any existing content in the map may be cleared or merged.
+     * @param ttls Receives the time-to-live of the definitions that carry one.
+     * @param options Receives the options of the definitions of sparse and partial indexes.
      * @return `true` if the loading process completes successfully (even if no indexes are found),
      *         `false` if a storage-level error occurs.
      */
-    [[nodiscard]] bool load_index_definitions(
-        std::unordered_map<std::string, std::unordered_set<std::string>> &indexed_fields);
+    [[nodiscard]] bool load_index_definitions(IndexDefinitions &indexed_fields,
+                                              TtlDefinitions &ttls,
+                                              IndexOptionDefinitions &options);
+
+    /// The name prefix of the tables holding persisted index entries.
+    static constexpr std::string_view ENTRY_TABLE_PREFIX = "_index.";
+
+    /**
+     * @brief Returns the name of the table holding the entries of an index.
+     * @param collection The name of the indexed collection.
+     * @param field The indexed field.
+     * @return The table name, `_index.<collection>.<field>`.
+     */
+    [[nodiscard]] static std::string entry_table(std::string_view collection,
+                                                 std::string_view field);
+
+    /**
+     * @brief Checks whether a table holds persisted index entries rather than documents.
+     * @param table The name of the table.
+     * @return `true` if `table` starts with `ENTRY_TABLE_PREFIX`.
+     */
+    [[nodiscard]] static bool is_entry_table(std::string_view table);
+
+    /**
+     * @brief Encodes an entry of a hash index as a storage key.
+     * @param key The stringified value, as produced by `SecondaryIndexer::to_index_key`.
+     * @param id The `_id` of the indexed document.
+     * @return The storage key of the entry.
+     */
+    [[nodiscard]] static std::string encode_entry(std::string_view key, std::string_view id);
+
+    /**
+     * @brief Encodes an entry of an ordered index as a storage key.
+     * @details The byte-wise order of the encoded keys is the `(IndexKey, _id)` order of the
+     * entries.
+     * @param key The key of the indexed value.
+     * @param id The `_id` of the indexed document.
+     * @return The storage key of the entry.
+     */
+    [[nodiscard]] static std::string encode_entry(const IndexKey &key, std::string_view id);
+
+    /**
+     * @brief Decodes an entry of a hash index, the reverse of `encode_entry`.
+     * @param entry The encoded entry.
+     * @param key Receives the stringified value.
+     * @param id Receives the `_id` of the indexed document.
+     * @return `false` if the entry is malformed.
+     */
+    [[nodiscard]] static bool decode_entry(std::string_view entry, std::string &key,
+                                           std::string &id);
+
+    /**
+     * @brief Decodes an entry of an ordered index, the reverse of `encode_entry`.
+     * @param entry The encoded entry.
+     * @param key Receives the key of the indexed value.
+     * @param id Receives the `_id` of the indexed document.
+     * @return `false` if the entry is malformed.
+     */
+    [[nodiscard]] static bool decode_entry(std::string_view entry, IndexKey &key,
+                                           std::string &id);
+
+    /**
+     * @brief Loads the persisted entries of a hash index.
+     * @param collection The name of the indexed collection.
+     * @param field The indexed field.
+     * @param entries Receives the `(index key, _id)` pairs. Malformed keys are skipped.
+     * @return `true` if the table was read completely, `false` if a storage error occurred.
+     */
+    [[nodiscard]] bool load_index_entries(std::string_view collection, std::string_view field,
+                                          HashEntries &entries);
+
+    /**
+     * @brief Loads the persisted entries of an ordered index.
+     * @param collection The name of the indexed collection.
+     * @param field The indexed field.
+     * @param entries Receives the `(IndexKey, _id)` pairs in ascending order. Malformed keys are
+     *        skipped.
+     * @return `true` if the table was read completely, `false` if a storage error occurred.
+     */
+    [[nodiscard]] bool load_index_entries(std::string_view collection, std::string_view field,
+                                          OrderedEntries &entries);
+
+    /**
+     * @brief Replaces the persisted entries of an index.
+     * @details The entry table is dropped and re-created, then filled from the sorted keys with
+     * `WiredTigerStore::bulk_load_keys`.
+     * @param collection The name of the indexed collection.
+     * @param field The indexed field.
+     * @param keys The encoded entries, in any order. They are sorted in place.
+     * @return `true` if the table was rewritten, `false` if a storage error occurred.
+     */
+    [[nodiscard]] bool store_index_entries(std::string_view collection, std::string_view field,
+                                           std::vector<std::string> keys);
+
+    /**
+     * @brief Applies individual insertions and removals to the persisted entries of indexes.
+     * @details The writes are committed in one transaction, in order, so a removal followed by
+     * the insertion of the same key leaves the key in place.
+     * @param collection The name of the indexed collection.
+     * @param writes The writes, addressed to entry tables of the collection.
+     * @return `true` if the writes committed, `false` if a storage error occurred.
+     */
+    [[nodiscard]] bool write_index_entries(std::string_view collection,
+                                           const std::vector<aevum::db::storage::KeyWrite> &writes);
+
+    /// A collection name with the `BloomFilter::serialize` encoding of its `_id` filter.
+    using IdFilterImages = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Stores the `_id` filters of collections next to the index definitions.
+     * @details Each filter is written to `_indexes` as `{ "collection": "...", "id_filter":
+     * <binary> }` under the key `<collection>::#id_filter`, all in one transaction.
+     * @param filters The encoded filters.
+     * @return `true` if the batch committed, `false` if a storage error occurred.
+     */
+    [[nodiscard]] bool store_id_filters(const IdFilterImages &filters);
+
+    /**
+     * @brief Reads the stored `_id` filters and deletes them from storage.
+     * @details A stored filter is only valid as long as no document is written without being
+     * added to it, which a crash would break. Taking the filters out of storage when they are
+     * read means that one is found only after a clean shutdown has stored it.
+     * @param filters Receives the encoded filters.
+     * @return `true` if the filters were read and deleted; on `false`, `filters` must not be used.
+     */
+    [[nodiscard]] bool take_id_filters(IdFilterImages &filters);
+
+    /// The suffix of the `_indexes` keys of stored `_id` filters.
+    static constexpr std::string_view ID_FILTER_SUFFIX = "::#id_filter";
 
   private:
     /**
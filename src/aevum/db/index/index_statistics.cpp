@@ -0,0 +1,189 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_statistics.cpp
+ * @brief Implements `HyperLogLog` and the estimates of `IndexStatistics`.
+ */
+#include "aevum/db/index/index_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The share of an ordered index assumed to lie in a range when there is no histogram yet.
+constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3.0;
+
+/**
+ * @brief Checks whether two keys compare equal.
+ * @param a A key.
+ * @param b A key.
+ * @return `true` if neither sorts before the other.
+ */
+bool same_key(const IndexKey &a, const IndexKey &b) noexcept {
+    return !(a < b) && !(b < a);
+}
+
+/**
+ * @brief Checks whether a key lies below the lower bound of a range.
+ * @param range The range.
+ * @param key The key.
+ * @return `true` if the key, and every key before it, is outside the range.
+ */
+bool before_range(const KeyRange &range, const IndexKey &key) noexcept {
+    return range.lower_inclusive ? key < range.lower : !(range.lower < key);
+}
+
+/**
+ * @brief Checks whether a key lies above the upper bound of a range.
+ * @param range The range.
+ * @param key The key.
+ * @return `true` if the key, and every key after it, is outside the range.
+ */
+bool after_range(const KeyRange &range, const IndexKey &key) noexcept {
+    return range.upper && (range.upper_inclusive ? *range.upper < key : !(key < *range.upper));
+}
+
+/**
+ * @brief Estimates the share of a histogram bucket that a range overlaps in part.
+ * @details Between numeric bounds the share is interpolated linearly; any other bucket is assumed
+ * to be half covered.
+ * @param range The range.
+ * @param low The lower bound of the bucket.
+ * @param high The upper bound of the bucket.
+ * @return The share, between 0 and 1.
+ */
+double bucket_overlap(const KeyRange &range, const IndexKey &low, const IndexKey &high) noexcept {
+    if (low.rank != KeyRank::NUMBER || high.rank != KeyRank::NUMBER ||
+        !(low.number < high.number)) {
+        return 0.5;
+    }
+    double from = low.number;
+    double to = high.number;
+    if (range.lower.rank == KeyRank::NUMBER) from = std::max(from, range.lower.number);
+    if (range.upper && range.upper->rank == KeyRank::NUMBER) to = std::min(to, range.upper->number);
+    return std::clamp((to - from) / (high.number - low.number), 0.0, 1.0);
+}
+
+}  // namespace
+
+/**
+ * @brief Adds a key by its hash.
+ * @details The high `PRECISION` bits select the register; the position of the first set bit in
+ * the rest is its rank.
+ * @param hash A well-mixed 64-bit hash of the key.
+ */
+void HyperLogLog::add(uint64_t hash) noexcept {
+    size_t index = static_cast<size_t>(hash >> (64 - PRECISION));
+    uint64_t rest = hash << PRECISION;
+    auto rank = static_cast<uint8_t>(rest == 0 ? 64 - PRECISION + 1 : __builtin_clzll(rest) + 1);
+    uint8_t &current = registers_[index];
+    if (rank <= current) return;
+    if (current == 0) --zeros_;
+    inverse_sum_ += std::ldexp(1.0, -rank) - std::ldexp(1.0, -current);
+    current = rank;
+}
+
+/**
+ * @brief Estimates the number of distinct keys.
+ * @details The raw estimate is biased for small sets, where linear counting over the registers
+ * still at zero is used instead.
+ * @return The estimate.
+ */
+double HyperLogLog::estimate() const noexcept {
+    if (zeros_ == REGISTER_COUNT) return 0.0;
+    const double m = static_cast<double>(REGISTER_COUNT);
+    double raw = 0.7213 / (1.0 + 1.079 / m) * m * m / inverse_sum_;
+    if (raw <= 2.5 * m && zeros_ > 0) return m * std::log(m / static_cast<double>(zeros_));
+    return raw;
+}
+
+/**
+ * @brief Forgets every key.
+ */
+void HyperLogLog::clear() noexcept {
+    registers_.fill(0);
+    inverse_sum_ = static_cast<double>(REGISTER_COUNT);
+    zeros_ = REGISTER_COUNT;
+}
+
+/**
+ * @brief Estimates the number of entries of a hash index filed under a key.
+ * @param key The index key.
+ * @return The estimated number of entries; at least 1 for a key that is not a most common one,
+ *         which may have been added since they were counted.
+ */
+double IndexStatistics::estimate_equal(std::string_view key) const noexcept {
+    if (entries == 0) return 0.0;
+    double rest = static_cast<double>(entries);
+    double rest_keys = distinct;
+    for (const auto &value : most_common) {
+        if (value.key == key) return static_cast<double>(std::min(value.count, entries));
+        rest -= static_cast<double>(value.count);
+        rest_keys -= 1.0;
+    }
+    if (rest < 1.0 || rest_keys < 1.0) return 1.0;
+    return rest / rest_keys;
+}
+
+/**
+ * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+ * @details Adjacent buckets share their bound, so a bucket is skipped only if it lies wholly on
+ * one side of the range.
+ * @param range The range.
+ * @return The estimated number of entries, at most `entries`.
+ */
+double IndexStatistics::estimate_range(const KeyRange &range) const noexcept {
+    if (entries == 0 || range.empty()) return 0.0;
+    const auto total = static_cast<double>(entries);
+    bool point = range.upper && range.lower_inclusive && range.upper_inclusive &&
+                 same_key(range.lower, *range.upper);
+    double per_key = distinct >= 1.0 ? total / distinct : total;
+    if (histogram.size() < 2) return point ? per_key : total * DEFAULT_RANGE_SELECTIVITY;
+
+    double per_bucket = total / static_cast<double>(histogram.size() - 1);
+    double estimate = 0.0;
+    for (size_t i = 0; i + 1 < histogram.size(); ++i) {
+        const IndexKey &low = histogram[i];
+        const IndexKey &high = histogram[i + 1];
+        if (after_range(range, low) || before_range(range, high)) continue;
+        if (range.contains(low) && range.contains(high)) {
+            estimate += per_bucket;
+        } else if (!point) {
+            estimate += per_bucket * bucket_overlap(range, low, high);
+        }
+    }
+    if (point) estimate = std::max(estimate, per_key);
+    return std::min(estimate, total);
+}
+
+/**
+ * @brief Hashes an ordered index key for a `HyperLogLog`.
+ * @param key The key.
+ * @return The hash, seeded with the rank.
+ */
+uint64_t hash_index_key(const IndexKey &key) noexcept {
+    auto seed = static_cast<uint64_t>(key.rank);
+    switch (key.rank) {
+        case KeyRank::BOOL:
+        case KeyRank::NUMBER: {
+            double number = key.number == 0.0 ? 0.0 : key.number;
+            char bytes[sizeof(number)];
+            std::memcpy(bytes, &number, sizeof(number));
+            return aevum::util::hash::wyhash(std::string_view(bytes, sizeof(bytes)), seed);
+        }
+        case KeyRank::STRING:
+            return aevum::util::hash::wyhash(key.text, seed);
+        default:
+            return aevum::util::hash::wyhash(std::string_view(), seed);
+    }
+}
+
+}  // namespace aevum::db::index
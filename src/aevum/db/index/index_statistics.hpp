@@ -0,0 +1,179 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file index_statistics.hpp
+ * @brief Declares the statistics the query planner estimates the selectivity of indexes from.
+ * @details Once a query has predicates on several indexed fields, intersecting all of their
+ * postings is not always the cheapest path: one selective index followed by the matcher may cost
+ * less, and an index on a field that most documents share costs more than scanning the
+ * collection. `IndexStatistics` summarizes an index well enough to estimate how many entries a
+ * lookup yields, and `CollectionStatistics` how much a scan of the collection costs.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/db/index/index_key.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @class HyperLogLog
+ * @brief A fixed-size estimator of the number of distinct keys added to it.
+ *
+ * @details Each key's 64-bit hash selects one of `REGISTER_COUNT` registers with its high bits,
+ * and the register keeps the longest run of leading zeros seen in the remaining bits. The harmonic
+ * mean of the registers estimates the number of distinct hashes within about 2.3%, with linear
+ * counting for small sets. The sum the mean is taken over is kept up to date as registers grow,
+ * so `estimate` costs constant time. Keys cannot be removed; the owner rebuilds the sketch from
+ * the keys it still holds.
+ *
+ * The class is not thread-safe; its owner guards it with the lock of the set it summarizes.
+ */
+class HyperLogLog {
+  public:
+    /// The number of hash bits that select a register.
+    static constexpr unsigned PRECISION = 11;
+    /// The number of registers, one byte each.
+    static constexpr size_t REGISTER_COUNT = size_t{1} << PRECISION;
+
+    /**
+     * @brief Adds a key by its hash.
+     * @param hash A well-mixed 64-bit hash of the key.
+     */
+    void add(uint64_t hash) noexcept;
+
+    /**
+     * @brief Estimates the number of distinct keys added since the last `clear`.
+     * @return The estimate; 0 for an empty sketch.
+     */
+    [[nodiscard]] double estimate() const noexcept;
+
+    /**
+     * @brief Forgets every key.
+     */
+    void clear() noexcept;
+
+  private:
+    /// The longest run of leading zeros plus one seen per register, or 0.
+    std::array<uint8_t, REGISTER_COUNT> registers_{};
+    /// The sum of `2^-register` over all registers.
+    double inverse_sum_{static_cast<double>(REGISTER_COUNT)};
+    /// The number of registers still at 0.
+    size_t zeros_{REGISTER_COUNT};
+};
+
+/**
+ * @struct ValueCount
+ * @brief A key of a hash index with the number of entries filed under it.
+ */
+struct ValueCount {
+    /// The index key.
+    std::string key;
+    /// The number of entries.
+    size_t count = 0;
+};
+
+/**
+ * @struct IndexStatistics
+ * @brief A summary of the entries of one secondary index.
+ * @details `entries` is exact, since the index counts them as they come and go, and so is
+ * `distinct` for a hash index, which has one posting per key. For an ordered index, `distinct` is
+ * a `HyperLogLog` estimate. `most_common` and `histogram` are rebuilt from the entries once enough
+ * of them have changed since the last rebuild, so they describe the index as it was then.
+ */
+struct IndexStatistics {
+    /// The number of entries of a hash index's most common keys that are tracked.
+    static constexpr size_t MOST_COMMON_VALUES = 8;
+    /// The number of buckets of an ordered index's histogram.
+    static constexpr size_t HISTOGRAM_BUCKETS = 32;
+
+    /// The number of entries; a multikey index has more entries than documents.
+    size_t entries = 0;
+    /// The number of distinct keys.
+    double distinct = 0.0;
+    /// For a hash index, the keys with the most entries, most common first.
+    std::vector<ValueCount> most_common;
+    /**
+     * @brief For an ordered index, the bounds of an equi-depth histogram: the keys at which each
+     * successive `1 / (histogram.size() - 1)` of the entries begins, then the largest key. Empty
+     * until the first rebuild.
+     */
+    std::vector<IndexKey> histogram;
+    /// The number of entries added or removed since `most_common` or `histogram` was rebuilt.
+    size_t changes = 0;
+
+    /**
+     * @brief Checks whether `most_common` or `histogram` should be rebuilt.
+     * @return `true` once the changes since the last rebuild exceed a quarter of the entries.
+     */
+    [[nodiscard]] bool is_stale() const noexcept { return changes > entries / 4 + 16; }
+
+    /**
+     * @brief Estimates the number of entries of a hash index filed under a key.
+     * @details A most common key has its own count; any other key is assumed to have an equal
+     * share of the entries left over by the most common ones.
+     * @param key The index key.
+     * @return The estimated number of entries.
+     */
+    [[nodiscard]] double estimate_equal(std::string_view key) const noexcept;
+
+    /**
+     * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+     * @details Every histogram bucket the range covers counts in full, and a bucket it only
+     * overlaps counts in proportion, interpolated between numeric bounds and halved otherwise. A
+     * range that admits a single key is estimated at least at the average number of entries per
+     * key. Without a histogram, a third of the entries is assumed for any other range.
+     * @param range The range.
+     * @return The estimated number of entries.
+     */
+    [[nodiscard]] double estimate_range(const KeyRange &range) const noexcept;
+};
+
+/**
+ * @struct CollectionStatistics
+ * @brief The size of a collection, as the primary index holds it.
+ */
+struct CollectionStatistics {
+    /// The number of documents.
+    size_t documents = 0;
+    /// The total BSON length of the documents, in bytes.
+    size_t bytes = 0;
+
+    /**
+     * @brief Returns the average size of a document.
+     * @return The average BSON length in bytes, or 0 for an empty collection.
+     */
+    [[nodiscard]] double average_size() const noexcept {
+        return documents == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(documents);
+    }
+};
+
+/**
+ * @struct CollectionMemory
+ * @brief An estimate of the memory a collection holds in the indexes.
+ */
+struct CollectionMemory {
+    /// The bytes of the documents and of their entries in the primary index.
+    size_t documents = 0;
+    /// The bytes of the secondary, columnar, and text indexes.
+    size_t indexes = 0;
+};
+
+/**
+ * @brief Hashes an ordered index key for a `HyperLogLog`.
+ * @details Keys that compare equal hash equally: the payload that does not take part in the
+ * comparison of a rank is ignored, and `-0.0` hashes as `0.0`.
+ * @param key The key.
+ * @return The hash.
+ */
+[[nodiscard]] uint64_t hash_index_key(const IndexKey &key) noexcept;
+
+}  // namespace aevum::db::index
@@ -5,125 +5,336 @@
 /**
  * @file primary_indexer.cpp
  * @brief Implements the `PrimaryIndexer` class for managing high-speed, `_id`-based lookups.
- * @details This file provides the concrete implementations for the `PrimaryIndexer`'s methods.
- * It encapsulates the thread-safe logic for adding, retrieving, updating, and removing
- * documents from the in-memory primary index cache using a reader-writer lock pattern for
- * optimal concurrency.
+ * @details This file provides the concrete implementations for the `PrimaryIndexer`'s methods:
+ * the adding, retrieving, updating, and removing of documents in the shards of a collection,
+ * each under the reader-writer lock of its shard.
  */
 #include "aevum/db/index/primary_indexer.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
 #include <vector>
 
 namespace aevum::db::index {
 
 /**
- * @brief Retrieves a document from the primary index using its collection and unique ID.
- * @details This function is optimized for high-concurrency read access. It acquires a
- * `std::shared_lock`, allowing multiple threads to perform lookups simultaneously. The lookup
- * proceeds in two stages: first finding the map for the specified collection, then finding the
- * document by its `_id` within that map. If found, a deep copy of the document is returned.
+ * @brief Retrieves a shared handle to a document using its collection and unique ID.
+ * @details The collection is found without locking, and the document's shard is locked for
+ * reading only while its handle is copied, so concurrent readers of different shards touch no
+ * common cache line.
  *
  * @param coll The name of the collection to search within.
  * @param id The unique `_id` string of the document.
- * @return An `std::optional` containing a `aevum::bson::doc::Document` copy if the lookup is
- *         successful. If the collection or the specific document ID is not found, it returns
- *         `std::nullopt`.
+ * @return A handle to the document, or null if the collection or the `_id` is not found.
  */
-std::optional<aevum::bson::doc::Document> PrimaryIndexer::get_document_by_id(
-    const std::string &coll, const std::string &id) const {
-    // Acquire a shared (read) lock to allow for maximum concurrency during lookups.
-    std::shared_lock<std::shared_mutex> lock(primary_index_lock_);
-
-    auto it_coll = id_indexes_.find(coll);
-    if (it_coll != id_indexes_.end()) {
-        auto it_doc = it_coll->second.find(id);
-        if (it_doc != it_coll->second.end()) {
-            // A match was found. The Document is returned by value, creating a deep copy
-            // and ensuring the caller receives an independent object.
-            return it_doc->second;
-        }
+PrimaryIndexer::DocumentPtr PrimaryIndexer::get_document_by_id(std::string_view coll,
+                                                               std::string_view id) const {
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return nullptr;
+
+    uint64_t hash = IdTable::hash(id);
+    const Shard &shard = index->shards[shard_of(hash)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const DocumentPtr *document = shard.table.find(id, hash);
+    return document ? *document : nullptr;
+}
+
+/**
+ * @brief Converts the `_id` value under an iterator into its key.
+ * @param iter An iterator positioned on the `_id` value.
+ * @return The string, the decimal form of the integer, or an empty string for any other type.
+ */
+std::string PrimaryIndexer::to_id_key(const bson_iter_t &iter) {
+    if (BSON_ITER_HOLDS_UTF8(&iter)) {
+        uint32_t length;
+        const char *id = bson_iter_utf8(&iter, &length);
+        return std::string(id, length);
     }
-    // The document or collection was not found in the index.
-    return std::nullopt;
+    if (BSON_ITER_HOLDS_INT32(&iter)) return std::to_string(bson_iter_int32(&iter));
+    if (BSON_ITER_HOLDS_INT64(&iter)) return std::to_string(bson_iter_int64(&iter));
+    return "";
 }
 
 /**
- * @brief Retrieves all documents currently stored in the primary index for a given collection.
- * @details This function provides a mechanism for performing full collection scans in memory.
- * It acquires a shared read lock and iterates through all entries in the collection's nested map,
- * returning a vector of deep copies of all documents.
+ * @brief Visits the documents of a collection in chunks of borrowed pointers.
+ * @details The pointers of one shard are collected under its shared lock into a buffer that is
+ * reused across shards, and the lock is dropped before any full chunk is handed to `visit`, so a
+ * slow visitor never holds up a writer of another collection or a reader. Pointers left over at
+ * the end of a shard are carried into the next one, so every chunk but the last is full.
  *
  * @param coll The name of the collection.
- * @return A vector of BSON documents. Returns an empty vector if the collection does not exist.
+ * @param chunk_size The number of documents per chunk; 0 is treated as 1.
+ * @param visit The visitor.
+ * @param first_shard The first shard to visit.
+ * @param end_shard One past the last shard to visit.
+ * @return `false` if `visit` stopped the iteration, `true` otherwise.
  */
-std::vector<aevum::bson::doc::Document> PrimaryIndexer::get_all_documents(
-    const std::string &coll) const {
-    std::vector<aevum::bson::doc::Document> documents;
-    std::shared_lock<std::shared_mutex> lock(primary_index_lock_);
-
-    auto it_coll = id_indexes_.find(coll);
-    if (it_coll != id_indexes_.end()) {
-        for (const auto &[id, doc] : it_coll->second) {
-            documents.push_back(doc);
+bool PrimaryIndexer::for_each_chunk(std::string_view coll, size_t chunk_size,
+                                    const ChunkVisitor &visit, size_t first_shard,
+                                    size_t end_shard) const {
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return true;
+    if (chunk_size == 0) chunk_size = 1;
+    end_shard = std::min(end_shard, SHARD_COUNT);
+
+    DocumentChunk buffer;
+    DocumentChunk chunk;
+    chunk.reserve(chunk_size);
+    for (size_t s = first_shard; s < end_shard; ++s) {
+        const Shard &shard = index->shards[s];
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            buffer.reserve(buffer.size() + shard.table.size());
+            shard.table.for_each(
+                [&](const std::string &, const DocumentPtr &doc) { buffer.push_back(doc.get()); });
+        }
+        size_t offset = 0;
+        while (buffer.size() - offset >= chunk_size) {
+            chunk.assign(buffer.begin() + offset, buffer.begin() + offset + chunk_size);
+            offset += chunk_size;
+            if (!visit(chunk)) return false;
         }
+        buffer.erase(buffer.begin(), buffer.begin() + offset);
+    }
+    return buffer.empty() || visit(buffer);
+}
+
+/**
+ * @brief Borrows read-only pointers to every document stored for a given collection.
+ * @details The shared locks taken here only protect the traversal of the shards. The pointers
+ * address the documents themselves, not the slots that hold their handles, so they stay valid
+ * when a table grows; each stays valid until its entry is erased or overwritten, which the caller
+ * must prevent by excluding writers for the lifetime of the returned vector.
+ *
+ * @param coll The name of the collection.
+ * @return A vector of non-owning pointers into the index. Returns an empty vector if the
+ *         collection does not exist.
+ */
+std::vector<const aevum::bson::doc::Document *> PrimaryIndexer::get_document_refs(
+    std::string_view coll) const {
+    std::vector<const aevum::bson::doc::Document *> refs;
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return refs;
+
+    refs.reserve(document_count(coll));
+    for (const Shard &shard : index->shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        shard.table.for_each(
+            [&](const std::string &, const DocumentPtr &doc) { refs.push_back(doc.get()); });
+    }
+    return refs;
+}
+
+/**
+ * @brief Shares the handles of the documents stored for a given collection in a range of shards.
+ * @param coll The name of the collection.
+ * @param first_shard The first shard to read.
+ * @param end_shard One past the last shard to read.
+ * @return The `_id`s and handles of the documents.
+ */
+PrimaryIndexer::DocumentHandles PrimaryIndexer::get_document_handles(std::string_view coll,
+                                                                     size_t first_shard,
+                                                                     size_t end_shard) const {
+    DocumentHandles handles;
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return handles;
+    end_shard = std::min(end_shard, SHARD_COUNT);
+
+    if (first_shard == 0 && end_shard == SHARD_COUNT) handles.reserve(document_count(coll));
+    for (size_t s = first_shard; s < end_shard; ++s) {
+        const Shard &shard = index->shards[s];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        shard.table.for_each(
+            [&](const std::string &id, const DocumentPtr &doc) { handles.emplace_back(id, doc); });
+    }
+    return handles;
+}
+
+/**
+ * @brief Borrows a read-only pointer to a single document identified by its `_id`.
+ * @details Performs the same lookup as `get_document_by_id`, but hands back the address of the
+ * indexed `Document` instead of sharing ownership of it, which saves the reference count update.
+ *
+ * @param coll The name of the collection.
+ * @param id The unique identifier of the document.
+ * @return A non-owning pointer into the index, or `nullptr` if the document is not present.
+ */
+const aevum::bson::doc::Document *PrimaryIndexer::get_document_ref(std::string_view coll,
+                                                                   std::string_view id) const {
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return nullptr;
+
+    uint64_t hash = IdTable::hash(id);
+    const Shard &shard = index->shards[shard_of(hash)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const DocumentPtr *document = shard.table.find(id, hash);
+    return document ? document->get() : nullptr;
+}
+
+/**
+ * @brief Returns the number of documents in a collection.
+ * @details The shards are counted one at a time, so the sum is exact only while writers are
+ * excluded.
+ * @param coll The name of the collection.
+ * @return The number of indexed documents.
+ */
+size_t PrimaryIndexer::document_count(std::string_view coll) const {
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return 0;
+
+    size_t count = 0;
+    for (const Shard &shard : index->shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.table.size();
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the number and total size of the documents in a collection.
+ * @details As with `document_count`, the sums are exact only while writers are excluded.
+ * @param coll The name of the collection.
+ * @return The statistics.
+ */
+CollectionStatistics PrimaryIndexer::collection_statistics(std::string_view coll) const {
+    CollectionStatistics statistics;
+    const CollectionIndex *index = directory_.find(coll);
+    if (!index) return statistics;
+
+    for (const Shard &shard : index->shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        statistics.documents += shard.table.size();
+        statistics.bytes += shard.table.bytes();
     }
-    return documents;
+    return statistics;
 }
 
 /**
  * @brief Adds or updates a document entry in the primary index.
- * @details This is a write operation that requires exclusive access to the index. It acquires
- * a `std::unique_lock`, serializing this operation and blocking all other readers and writers.
- * The function uses `operator[]` on the nested maps, which conveniently handles both insertion
- * (if the key is new) and update (if the key already exists). The provided document is deep-copied
- * into the index.
+ * @details The copy into a new immutable handle happens before the shard's exclusive lock is
+ * acquired, so the lock is held only for the table insertion. The previous handle, if any, is
+ * released once the lock is dropped.
  *
  * @param coll The name of the collection.
  * @param id The unique `_id` of the document, which serves as the lookup key.
  * @param doc The `aevum::bson::doc::Document` to be indexed.
  */
-void PrimaryIndexer::add_document_to_primary_index(const std::string &coll, const std::string &id,
+void PrimaryIndexer::add_document_to_primary_index(std::string_view coll, std::string_view id,
                                                    const aevum::bson::doc::Document &doc) {
-    // Acquire a unique (exclusive) lock to ensure atomic modification of the index.
-    std::unique_lock<std::shared_mutex> lock(primary_index_lock_);
-    id_indexes_[coll][id] = doc;  // Performs a deep copy and insertion/update.
+    auto document = std::make_shared<const aevum::bson::doc::Document>(doc);
+    CollectionIndex &index = directory_.find_or_add(coll);
+
+    uint64_t hash = IdTable::hash(id);
+    Shard &shard = index.shards[shard_of(hash)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.table.insert_or_assign(id, hash, std::move(document));
+}
+
+/**
+ * @brief Applies byte patches to an indexed document, in place when no one else holds it.
+ * @details The use count of the handle is read under the shard's exclusive lock, so no reader can
+ * copy the handle while the bytes are being overwritten. A borrowed pointer does not count, but
+ * borrowers exclude writers to the collection. Copies of the document, such as the results of a
+ * `find` without projection, share its buffer without holding the handle, so a shared buffer is
+ * never overwritten either.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @param patches The runs of bytes to replace.
+ * @param after The patched document, installed as a new handle if the current one is shared.
+ * @return `false` if the document is not indexed.
+ */
+bool PrimaryIndexer::patch_document(std::string_view coll, std::string_view id,
+                                    const std::vector<storage::ValuePatch> &patches,
+                                    const aevum::bson::doc::Document &after) {
+    CollectionIndex *index = directory_.find(coll);
+    if (!index) return false;
+
+    uint64_t hash = IdTable::hash(id);
+    Shard &shard = index->shards[shard_of(hash)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    const DocumentPtr *document = shard.table.find(id, hash);
+    if (!document) return false;
+    if (document->use_count() == 1 && !(*document)->shared() &&
+        (*document)->length() == after.length()) {
+        auto *bytes = const_cast<uint8_t *>(bson_get_data((*document)->get()));
+        for (const auto &patch : patches) {
+            std::memcpy(bytes + patch.offset, patch.bytes.data(), patch.bytes.size());
+        }
+    } else {
+        shard.table.insert_or_assign(id, hash,
+                                     std::make_shared<const aevum::bson::doc::Document>(after));
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the primary index of a collection with prebuilt documents.
+ * @details The documents are distributed into new shard tables, presized for their share, before
+ * any lock is taken. Each shard is then swapped under its exclusive lock, and the previous tables
+ * are released after all locks are dropped.
+ * @param coll The name of the collection.
+ * @param documents The documents of the collection with their `_id`s.
+ */
+void PrimaryIndexer::load_collection(std::string_view coll, DocumentEntries documents) {
+    std::array<IdTable, SHARD_COUNT> tables;
+    for (IdTable &table : tables) table.reserve(documents.size() / SHARD_COUNT + 1);
+    for (auto &[id, doc] : documents) {
+        uint64_t hash = IdTable::hash(id);
+        tables[shard_of(hash)].insert_or_assign(
+            id, hash, std::make_shared<const aevum::bson::doc::Document>(std::move(doc)));
+    }
+    documents.clear();
+
+    CollectionIndex &index = directory_.find_or_add(coll);
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        std::unique_lock<std::shared_mutex> lock(index.shards[i].mutex);
+        std::swap(index.shards[i].table, tables[i]);
+    }
 }
 
 /**
  * @brief Removes a document from the primary index using its unique identifier.
- * @details This is a write operation that requires an exclusive lock to guarantee atomicity.
- * It first finds the map for the specified collection and then erases the document entry
- * corresponding to the given `_id`. If the collection or ID is not found, the operation has no
- * effect.
+ * @details Locks only the shard of the `_id`, exclusively. If the collection or ID is not found,
+ * the operation has no effect.
  *
  * @param coll The name of the collection from which to remove the document.
  * @param id The `_id` of the document to be removed.
  */
-void PrimaryIndexer::remove_document_from_primary_index(const std::string &coll,
-                                                        const std::string &id) {
-    // Acquire a unique (exclusive) lock for safe modification.
-    std::unique_lock<std::shared_mutex> lock(primary_index_lock_);
-    auto it_coll = id_indexes_.find(coll);
-    if (it_coll != id_indexes_.end()) {
-        // Erase the document from the inner map if it exists.
-        it_coll->second.erase(id);
+void PrimaryIndexer::remove_document_from_primary_index(std::string_view coll,
+                                                        std::string_view id) {
+    CollectionIndex *index = directory_.find(coll);
+    if (!index) return;
+
+    uint64_t hash = IdTable::hash(id);
+    Shard &shard = index->shards[shard_of(hash)];
+    DocumentPtr removed;
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (const DocumentPtr *document = shard.table.find(id, hash)) {
+        // The last reference may be released only once the lock is dropped.
+        removed = *document;
+        shard.table.erase(id, hash);
     }
 }
 
 /**
  * @brief Erases all primary index entries associated with a specific collection.
- * @details This is a destructive write operation that requires an exclusive lock. It removes the
- * entire nested map for the given collection, effectively clearing its primary index. This is
- * typically used when a collection is dropped or during a full rebuild.
+ * @details Each shard is emptied under its exclusive lock. The collection itself stays in the
+ * directory, since readers may be traversing it without a lock.
  *
  * @param coll The name of the collection whose primary index data should be completely cleared.
  */
-void PrimaryIndexer::clear_collection_index(const std::string &coll) {
-    // Acquire a unique (exclusive) lock to safely remove the entire collection entry.
-    std::unique_lock<std::shared_mutex> lock(primary_index_lock_);
-    id_indexes_.erase(coll);
+void PrimaryIndexer::clear_collection_index(std::string_view coll) {
+    CollectionIndex *index = directory_.find(coll);
+    if (!index) return;
+
+    for (Shard &shard : index->shards) {
+        IdTable released;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        std::swap(shard.table, released);
+    }
 }
 
 }  // namespace aevum::db::index
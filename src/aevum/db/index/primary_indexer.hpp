@@ -8,37 +8,61 @@
  * in-memory primary key (`_id`) index.
  * @details This header declares a component specialized for the most critical and frequent
  * type of lookup: direct retrieval of a document by its unique `_id`. The `PrimaryIndexer`
- * uses a hash map for near O(1) average-case complexity and is fully thread-safe for
- * high-concurrency environments.
+ * splits each collection into independently locked shards of open-addressing hash tables, so
+ * that concurrent point reads of different documents neither contend for a lock nor share the
+ * cache line of one.
  */
 #pragma once
 
-#include <optional>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "aevum/bson/doc/document.hpp"
+#include "aevum/db/index/id_table.hpp"
+#include "aevum/db/index/index_statistics.hpp"
+#include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/util/concurrency/named_registry.hpp"
 
 namespace aevum::db::index {
 
 /**
  * @class PrimaryIndexer
- * @brief Manages an in-memory, thread-safe hash map for direct `_id`-to-document lookups.
+ * @brief Manages an in-memory, thread-safe hash index for direct `_id`-to-document lookups.
  *
  * @details This class serves as the definitive, high-performance cache for mapping a document's
- * unique identifier (`_id`) to its full BSON representation. It maintains a two-level
- * `unordered_map` structure (`collection_name -> (document_id -> BSON_document)`), providing
- * an efficient mechanism to bypass full collection scans when a document's `_id` is known.
+ * unique identifier (`_id`) to its full BSON representation. Documents are held as refcounted,
+ * immutable `DocumentPtr`s: a point read returns a shared handle instead of a deep copy, and an
+ * update swaps the handle rather than mutating a document a reader may hold.
  *
- * To guarantee data integrity and support high-concurrency workloads, access to the index is
- * managed by a `std::shared_mutex`. This allows for numerous, simultaneous, non-blocking
- * read operations (`get_document_by_id`) while ensuring that all write operations
- * (`add`, `remove`, `clear`) are serialized and atomic.
+ * Collections are found in a `NamedRegistry`, which is read without any lock; a collection, once
+ * added, stays in it until the indexer is destroyed, and clearing it only empties its shards.
+ * Within a collection, an `_id` is assigned to one of `SHARD_COUNT` shards by its hash, and each
+ * shard has its own `std::shared_mutex`, aligned to a cache line of its own, guarding its
+ * `IdTable`. Lookups use `std::string_view` throughout and never allocate.
  */
 class PrimaryIndexer {
   public:
+    /// A shared handle to an indexed document.
+    using DocumentPtr = IdTable::DocumentPtr;
+    /// The documents of one collection, as `(_id, document)` pairs, for `load_collection`.
+    using DocumentEntries = std::vector<std::pair<std::string, aevum::bson::doc::Document>>;
+    /// Shared handles to documents together with their `_id`s.
+    using DocumentHandles = std::vector<std::pair<std::string, DocumentPtr>>;
+    /// A chunk of borrowed document pointers, as handed out by `for_each_chunk`.
+    using DocumentChunk = std::vector<const aevum::bson::doc::Document *>;
+    /// Visits one chunk of documents and returns `false` to stop the iteration.
+    using ChunkVisitor = std::function<bool(const DocumentChunk &)>;
+
+    /// The number of shards each collection is split into; a power of two.
+    static constexpr size_t SHARD_COUNT = 64;
+
     /**
      * @brief Constructs a new, empty `PrimaryIndexer`.
      */
@@ -49,74 +73,199 @@ class PrimaryIndexer {
      */
     ~PrimaryIndexer() = default;
 
+    PrimaryIndexer(const PrimaryIndexer &) = delete;
+    PrimaryIndexer &operator=(const PrimaryIndexer &) = delete;
+
     /**
-     * @brief Retrieves a deep copy of a document by its collection name and unique `_id`.
-     * @details This is the primary query method for this class. It performs a highly concurrent,
-     * read-locked lookup in the internal hash map.
+     * @brief Retrieves a shared handle to a document by its collection name and unique `_id`.
+     * @details This is the primary query method for this class. Only the shard of the `_id` is
+     * locked, for reading, and only for as long as the handle is copied.
      * @param coll The name of the collection in which to search.
      * @param id The unique `_id` string of the document to retrieve.
-     * @return An `std::optional<aevum::bson::doc::Document>` containing a deep copy of the
-     *         BSON document if a match is found.
-     * @return `std::nullopt` if the collection does not exist or if no document with the
-     *         specified `_id` is found in the index.
+     * @return A handle to the document, which stays valid however the index changes afterwards,
+     *         or null if the collection does not exist or holds no document with this `_id`.
+     */
+    [[nodiscard]] DocumentPtr get_document_by_id(std::string_view coll, std::string_view id) const;
+
+    /**
+     * @brief Converts the `_id` value under an iterator into the key it is indexed and stored by.
+     * @details A string is its own key and an Int32 or Int64 its decimal form, which an
+     * integer-keyed table stores as the integer. `Core` admits only string `_id`s into
+     * string-keyed collections and only integer `_id`s into integer-keyed ones, so no two
+     * documents of a collection share a key.
+     * @param iter An iterator positioned on the `_id` value.
+     * @return The key, or an empty string if the value is neither a string nor an integer.
+     */
+    [[nodiscard]] static std::string to_id_key(const bson_iter_t &iter);
+
+    /**
+     * @brief Visits the documents of a collection in chunks of borrowed pointers.
+     * @details The cursor-style counterpart of `get_document_refs`: instead of materializing a
+     * pointer to every document at once, at most one shard's worth of pointers is buffered, and
+     * `visit` is called for every `chunk_size` of them. Each shard is locked for reading only while
+     * its pointers are collected, never while `visit` runs. Disjoint shard ranges may be visited
+     * concurrently by different threads.
+     * @warning The same lifetime rules as `get_document_refs` apply to the pointers of a chunk.
+     * @param coll The name of the collection.
+     * @param chunk_size The number of documents per chunk; the last chunk may be shorter.
+     * @param visit Called with each chunk; returning `false` stops the iteration.
+     * @param first_shard The first shard to visit.
+     * @param end_shard One past the last shard to visit; clamped to `SHARD_COUNT`.
+     * @return `false` if `visit` stopped the iteration, `true` otherwise.
+     */
+    bool for_each_chunk(std::string_view coll, size_t chunk_size, const ChunkVisitor &visit,
+                        size_t first_shard = 0, size_t end_shard = SHARD_COUNT) const;
+
+    /**
+     * @brief Borrows read-only pointers to every document stored for a given collection.
+     * @details This performs no copies: the returned pointers address
+     * the `Document` instances owned by the index itself. This is what allows the raw BSON buffers
+     * to be handed to the Rust query engine in place.
+     * @warning The pointers are only valid for as long as no writer modifies this collection. The
+     *          caller must therefore hold a lock that excludes writers (such as the shared lock of
+     *          `Core`) for as long as it dereferences them.
+     * @param coll The name of the collection.
+     * @return A vector of non-owning document pointers, shard by shard in the index's iteration
+     *         order. Returns an empty vector if the collection does not exist.
+     */
+    [[nodiscard]] std::vector<const aevum::bson::doc::Document *> get_document_refs(
+        std::string_view coll) const;
+
+    /**
+     * @brief Shares the handles of every document stored for a given collection.
+     * @details Used to build side structures, such as columnar indexes, that hold the documents
+     * of the primary index by handle rather than by copy.
+     * Unlike borrowed pointers, the handles stay valid while writers change the collection, so a
+     * background index build reads them one shard range at a time without excluding writers.
+     * @param coll The name of the collection.
+     * @param first_shard The first shard to read.
+     * @param end_shard One past the last shard to read; clamped to `SHARD_COUNT`.
+     * @return The `_id`s and handles of the documents, shard by shard in the index's iteration
+     *         order. Returns an empty vector if the collection does not exist.
+     */
+    [[nodiscard]] DocumentHandles get_document_handles(std::string_view coll,
+                                                       size_t first_shard = 0,
+                                                       size_t end_shard = SHARD_COUNT) const;
+
+    /**
+     * @brief Borrows a read-only pointer to a single document by its `_id`.
+     * @details The non-copying counterpart of `get_document_by_id`, used by the query planner
+     * to resolve index candidates to the documents owned by the index.
+     * @warning The same lifetime rules as `get_document_refs` apply.
+     * @param coll The name of the collection.
+     * @param id The unique `_id` of the document.
+     * @return A non-owning pointer to the document, or `nullptr` if it is not in the index.
+     */
+    [[nodiscard]] const aevum::bson::doc::Document *get_document_ref(std::string_view coll,
+                                                                      std::string_view id) const;
+
+    /**
+     * @brief Returns the number of documents in a collection.
+     * @param coll The name of the collection.
+     * @return The number of indexed documents, or 0 if the collection does not exist.
      */
-    [[nodiscard]] std::optional<aevum::bson::doc::Document> get_document_by_id(
-        const std::string &coll, const std::string &id) const;
+    [[nodiscard]] size_t document_count(std::string_view coll) const;
 
     /**
-     * @brief Retrieves all documents currently stored in the primary index for a given collection.
+     * @brief Returns the number and total size of the documents in a collection.
+     * @details Each shard's table keeps both as documents come and go, so the shards are only
+     * summed, each under its read lock.
      * @param coll The name of the collection.
-     * @return A vector of BSON documents. Returns an empty vector if the collection does not exist.
+     * @return The statistics, empty if the collection does not exist.
      */
-    [[nodiscard]] std::vector<aevum::bson::doc::Document> get_all_documents(
-        const std::string &coll) const;
+    [[nodiscard]] CollectionStatistics collection_statistics(std::string_view coll) const;
 
     /**
      * @brief Adds a new document to the primary index or updates an existing one.
-     * @details This is a write operation that acquires an exclusive lock. If a document with the
-     * given `_id` already exists in the index, its value is overwritten with the new `doc`.
-     * If not, a new entry is created. The operation involves a deep copy of the document.
+     * @details The document is copied into a new immutable handle outside any lock; only the
+     * shard of the `_id` is then locked exclusively, to install the handle. Readers holding the
+     * previous handle keep their version.
      * @param coll The name of the collection.
      * @param id The unique `_id` of the document, which will serve as the key.
      * @param doc The BSON document to be indexed.
      */
-    void add_document_to_primary_index(const std::string &coll, const std::string &id,
+    void add_document_to_primary_index(std::string_view coll, std::string_view id,
                                        const aevum::bson::doc::Document &doc);
 
+    /**
+     * @brief Applies byte patches to an indexed document, in place when no one else holds it.
+     * @details Only the shard of the `_id` is locked exclusively. If the index holds the only
+     * handle to the document, the patches are copied over its bytes; otherwise a reader or a
+     * transaction may be looking at that version, and `after` is installed as a new handle.
+     * Either way the document then equals `after`.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     * @param patches The runs of bytes to replace; they must not change the document's length.
+     * @param after The patched document.
+     * @return `false` if the document is not indexed, in which case nothing is changed.
+     */
+    bool patch_document(std::string_view coll, std::string_view id,
+                        const std::vector<storage::ValuePatch> &patches,
+                        const aevum::bson::doc::Document &after);
+
+    /**
+     * @brief Replaces the primary index of a collection with prebuilt documents.
+     * @details The shard tables are built by the caller's thread without holding any lock and
+     * swapped in shard by shard, so loading a collection blocks other users of the index only for
+     * the swaps. A later entry replaces an earlier one with the same `_id`.
+     * @param coll The name of the collection.
+     * @param documents The documents of the collection with their `_id`s.
+     */
+    void load_collection(std::string_view coll, DocumentEntries documents);
+
     /**
      * @brief Atomically removes a document from the primary index using its `_id`.
-     * @details This write operation acquires an exclusive lock. If the specified document is found,
-     * it is erased from the index. If not found, the operation has no effect.
+     * @details Locks the shard of the `_id` exclusively. If the specified document is found, it
+     * is erased from the index. If not found, the operation has no effect.
      * @param coll The name of the collection.
      * @param id The `_id` of the document to remove.
      */
-    void remove_document_from_primary_index(const std::string &coll, const std::string &id);
+    void remove_document_from_primary_index(std::string_view coll, std::string_view id);
 
     /**
      * @brief Completely clears all primary index entries for a specific collection.
-     * @details This is a destructive write operation that acquires an exclusive lock. It is
-     * typically used when a collection is dropped or during a full index rebuild.
+     * @details Each shard is emptied under its exclusive lock. It is typically used when a
+     * collection is dropped or during a full index rebuild.
      * @param coll The name of the collection whose primary index is to be cleared.
      */
-    void clear_collection_index(const std::string &coll);
+    void clear_collection_index(std::string_view coll);
 
   private:
     /**
-     * @var id_indexes_
-     * @brief The core data structure for the primary index. It is a two-level hash map structured
-     * as: `std::unordered_map<CollectionName, std::unordered_map<DocumentID, BsonDocument>>`. This
-     * provides efficient, nested lookups by collection and then by ID.
+     * @struct Shard
+     * @brief A part of a collection's index with its own lock, on a cache line of its own.
+     */
+    struct alignas(64) Shard {
+        /// Guards `table`.
+        mutable std::shared_mutex mutex;
+        /// The documents of the shard.
+        IdTable table;
+    };
+
+    /**
+     * @struct CollectionIndex
+     * @brief The primary index of one collection.
+     */
+    struct CollectionIndex {
+        /// The shards of the collection.
+        std::array<Shard, SHARD_COUNT> shards;
+    };
+
+    /**
+     * @brief Returns the shard an `_id` belongs to.
+     * @param hash The `IdTable::hash` of the `_id`.
+     * @return The index of the shard.
      */
-    std::unordered_map<std::string, std::unordered_map<std::string, aevum::bson::doc::Document>>
-        id_indexes_;
+    [[nodiscard]] static size_t shard_of(uint64_t hash) noexcept {
+        return static_cast<size_t>(hash & (SHARD_COUNT - 1));
+    }
 
     /**
-     * @var primary_index_lock_
-     * @brief A reader-writer mutex that provides thread-safe access to the `id_indexes_` cache.
-     * It is marked `mutable` to permit locking within `const` member functions like
-     * `get_document_by_id`.
+     * @var directory_
+     * @brief The collections, by name. A collection is added when its first document is, and its
+     * shards may only be modified under their exclusive locks.
      */
-    mutable std::shared_mutex primary_index_lock_;
+    aevum::util::concurrency::NamedRegistry<CollectionIndex> directory_;
 };
 
 }  // namespace aevum::db::index
@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <bson/bson.h>
+#include <iterator>
 #include <mutex>
 #include <shared_mutex>
 
@@ -32,11 +33,11 @@ std::string SecondaryIndexer::get_doc_id(const aevum::bson::doc::Document &doc)
 }
 
 /**
- * @brief Extracts the value of a specified field from a BSON document and converts it into a
- * canonical string representation suitable for indexing.
- * @details This is a crucial utility function that enables the indexing of various BSON data types.
- * It iterates through the BSON document to find the specified `field`. If found, it checks the
- * field's type and converts its value into a `std::string`.
+ * @brief Converts the BSON value under an iterator into a canonical string representation
+ * suitable for indexing.
+ * @details This is the single source of truth for index key normalization, shared by the indexing
+ * path (`hash_keys`) and the query planner, so that a value probed at query time always
+ * produces the same key it was stored under.
  *
  * Supported types and their conversions:
  * - `BSON_TYPE_UTF8`: The raw string value is returned.
@@ -44,9 +45,33 @@ std::string SecondaryIndexer::get_doc_id(const aevum::bson::doc::Document &doc)
  *   standard string representation via `std::to_string`.
  * - `BSON_TYPE_BOOL`: The boolean is converted to either "true" or "false".
  *
- * If the field is not found, or if its type is not one of the supported types for indexing (e.g.,
- * an array, a sub-document), an empty string is returned, effectively preventing the field from
- * being indexed for that document.
+ * @param iter An iterator positioned on the value to convert.
+ * @return A `std::string` containing the canonical representation of the value. Returns an empty
+ *         string if the value is of an unsupported type (e.g., an array, a sub-document).
+ */
+std::string SecondaryIndexer::to_index_key(const bson_iter_t &iter) {
+    if (BSON_ITER_HOLDS_UTF8(&iter)) {
+        uint32_t length;
+        return std::string(bson_iter_utf8(&iter, &length), length);
+    } else if (BSON_ITER_HOLDS_INT32(&iter)) {
+        return std::to_string(bson_iter_int32(&iter));
+    } else if (BSON_ITER_HOLDS_INT64(&iter)) {
+        return std::to_string(bson_iter_int64(&iter));
+    } else if (BSON_ITER_HOLDS_DOUBLE(&iter)) {
+        return std::to_string(bson_iter_double(&iter));
+    } else if (BSON_ITER_HOLDS_BOOL(&iter)) {
+        return bson_iter_bool(&iter) ? "true" : "false";
+    }
+    return "";
+}
+
+/**
+ * @brief Extracts the value of a specified field from a BSON document and converts it into a
+ * canonical string representation suitable for indexing.
+ * @details It iterates through the BSON document to find the specified `field` and converts its
+ * value with `to_index_key`. If the field is not found, or if its type is not supported for
+ * indexing, an empty string is returned, effectively preventing the field from being indexed for
+ * that document.
  *
  * @param doc The BSON document to be inspected.
  * @param field The key of the field whose value is to be extracted.
@@ -59,35 +84,87 @@ std::string SecondaryIndexer::get_value_as_string(const aevum::bson::doc::Docume
 
     bson_iter_t iter;
     if (bson_iter_init_find(&iter, doc.get(), field.c_str())) {
-        if (BSON_ITER_HOLDS_UTF8(&iter)) {
-            uint32_t length;
-            return std::string(bson_iter_utf8(&iter, &length), length);
-        } else if (BSON_ITER_HOLDS_INT32(&iter)) {
-            return std::to_string(bson_iter_int32(&iter));
-        } else if (BSON_ITER_HOLDS_INT64(&iter)) {
-            return std::to_string(bson_iter_int64(&iter));
-        } else if (BSON_ITER_HOLDS_DOUBLE(&iter)) {
-            return std::to_string(bson_iter_double(&iter));
-        } else if (BSON_ITER_HOLDS_BOOL(&iter)) {
-            return bson_iter_bool(&iter) ? "true" : "false";
-        }
+        return to_index_key(iter);
     }
     return "";
 }
 
+/**
+ * @brief Computes the keys a document contributes to a hash index.
+ * @details The keys of each field are gathered in index order, and every key of the prefix so far
+ * is extended by every key of the next field. For a compound index that is one key per field, so
+ * the keys are exactly the prefixes.
+ * @param doc The document to inspect.
+ * @param index The name of the index.
+ * @return The distinct keys, in ascending order.
+ */
+std::vector<std::string> SecondaryIndexer::hash_keys(const aevum::bson::doc::Document &doc,
+                                                     const std::string &index) {
+    std::vector<std::string> fields = split_index_fields(index);
+    bool multikey = fields.size() == 1;
+    std::vector<std::string> keys;
+    std::vector<std::string> prefixes;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        bson_iter_t value;
+        if (!find_field_path(doc, fields[i], value)) break;
+        std::vector<std::string> parts;
+        bson_iter_t element;
+        if (multikey && BSON_ITER_HOLDS_ARRAY(&value) && bson_iter_recurse(&value, &element)) {
+            while (bson_iter_next(&element)) {
+                std::string part = to_index_key(element);
+                if (!part.empty()) parts.push_back(std::move(part));
+            }
+        } else if (std::string part = to_index_key(value); !part.empty()) {
+            parts.push_back(std::move(part));
+        }
+        if (parts.empty()) break;
+
+        if (i == 0) {
+            prefixes = std::move(parts);
+        } else {
+            for (auto &prefix : prefixes) (prefix += COMPOUND_KEY_SEPARATOR) += parts.front();
+        }
+        keys.insert(keys.end(), prefixes.begin(), prefixes.end());
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+/**
+ * @brief Joins the keys of the leading fields of a compound index into an index key.
+ * @param parts The keys of the fields, in index order.
+ * @return The joined key.
+ */
+std::string SecondaryIndexer::join_compound_key(const std::vector<std::string> &parts) {
+    std::string key;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (i > 0) key += COMPOUND_KEY_SEPARATOR;
+        key += parts[i];
+    }
+    return key;
+}
+
 /**
  * @brief Adds or removes a document from all applicable secondary indexes within a collection.
  * @details This function is the primary entry point for modifying the secondary index state. It
  * acquires an exclusive write lock to ensure atomic updates. The function first checks if any
  * fields are indexed for the given collection; if not, it returns immediately. It then extracts the
- * document's `_id` and iterates through all registered indexed fields. For each indexed field, it
- * extracts the corresponding value from the document, stringifies it, and then either appends
- * the document to the inverted index list or erases it based on the `add` flag.
+ * document's `_id` and iterates through all registered indexed fields. For each index, it computes
+ * the document's keys with `hash_keys`, and then either inserts the document's `_id` into the
+ * posting set of each key or erases it based on the `add` flag. A posting that becomes empty is
+ * dropped, so removed values do not linger as keys. For `ORDERED` fields, the document's
+ * `(IndexKey, _id)` entries from `make_path_keys` are inserted into or erased from the sorted set
+ * instead; a missing field is keyed as null so that every document is represented. `COLUMNAR`
+ * and `TEXT` fields are skipped, as the `IndexManager` keeps them in its `ColumnStore` and
+ * `TextIndex`, and so is, when it is added, every index whose `IndexFilter` does not admit the
+ * document. A removal is not filtered:
+ * the entries it looks for are simply not found.
  *
  * @param coll The name of the collection being modified.
  * @param doc The document to be added or removed from the indexes.
- * @param add If `true`, the document is added to the index. If `false`, it is removed by finding
- *        and erasing the entry with a matching `_id`.
+ * @param add If `true`, the document is added to the index. If `false`, its `_id` is erased from
+ *        the postings of its values.
  */
 void SecondaryIndexer::update_custom_index(const std::string &coll,
                                            const aevum::bson::doc::Document &doc, bool add) {
@@ -99,50 +176,270 @@ void SecondaryIndexer::update_custom_index(const std::string &coll,
     std::string doc_id = get_doc_id(doc);
     if (doc_id.empty()) return;
 
-    for (const auto &field : it_fields->second) {
-        std::string value_str = get_value_as_string(doc, field);
-        if (value_str.empty()) continue;
+    auto it_filters = add ? index_filters_.find(coll) : index_filters_.end();
+    for (const auto &[field, type] : it_fields->second) {
+        // Columnar and text indexes are maintained by the `ColumnStore` and the `TextIndex`.
+        if (!has_entries(type)) continue;
+        if (it_filters != index_filters_.end()) {
+            auto it_filter = it_filters->second.find(field);
+            if (it_filter != it_filters->second.end() && !it_filter->second->admits(doc)) continue;
+        }
+        if (type == IndexType::ORDERED) {
+            auto &entries = ordered_indexes_[coll][field];
+            OrderedStatistics &statistics = ordered_statistics_[coll][field];
+            size_t changed = 0;
+            for (auto &key : make_path_keys(doc, field)) {
+                uint64_t key_hash = add ? hash_index_key(key) : 0;
+                std::pair<IndexKey, std::string> entry(std::move(key), doc_id);
+                if (add) {
+                    if (entries.insert(std::move(entry)).second) {
+                        statistics.keys.add(key_hash);
+                        ++changed;
+                    }
+                } else {
+                    changed += entries.erase(entry);
+                }
+            }
+            statistics.note_changes(entries, changed);
+            continue;
+        }
 
-        auto &doc_vec = custom_indexes_[coll][field][value_str];
+        std::vector<std::string> keys = hash_keys(doc, field);
+        if (keys.empty()) continue;
 
+        HashIndex &index = custom_indexes_[coll][field];
+        size_t changed = 0;
+        for (auto &key : keys) {
+            if (add) {
+                index.keys.insert(BloomFilter::hash(key));
+                changed += index.postings[std::move(key)].insert(doc_id).second;
+            } else if (auto it = index.postings.find(key); it != index.postings.end()) {
+                changed += it->second.erase(doc_id);
+                if (it->second.empty()) index.postings.erase(it);
+            }
+        }
         if (add) {
-            doc_vec.push_back(doc);
+            index.statistics.entries += changed;
         } else {
-            doc_vec.erase(std::remove_if(doc_vec.begin(), doc_vec.end(),
-                                         [&](const aevum::bson::doc::Document &d) {
-                                             return get_doc_id(d) == doc_id;
-                                         }),
-                          doc_vec.end());
+            index.statistics.entries -= changed;
+        }
+        index.note_changes(changed);
+        if (add && (index.keys.capacity() == 0 || index.keys.is_overfull())) {
+            index.rebuild_filter();
+        }
+    }
+}
+
+/**
+ * @brief Removes a batch of documents from all applicable secondary indexes under one lock.
+ * @details The entries of all documents are gathered per index before anything is erased. For a
+ * `HASH` index the `_id`s are grouped by key, so each posting set is looked up once however many
+ * of its documents go. For an `ORDERED` index the entries are sorted in the set's own order and
+ * erased run by run: a run of entries that are adjacent in the set costs one lookup and one range
+ * erase, so deleting every document of a key range, as a range-predicate remove does, amounts to
+ * a single `erase(first, last)`. Entries that are not indexed are skipped.
+ *
+ * @param coll The name of the collection being modified.
+ * @param docs The documents to be removed; each must still be the indexed image.
+ */
+void SecondaryIndexer::remove_documents(
+    const std::string &coll, const std::vector<const aevum::bson::doc::Document *> &docs) {
+    std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
+
+    auto it_fields = indexed_fields_.find(coll);
+    if (it_fields == indexed_fields_.end() || docs.empty()) return;
+
+    std::vector<std::string> doc_ids;
+    doc_ids.reserve(docs.size());
+    for (const auto *doc : docs) doc_ids.push_back(get_doc_id(*doc));
+
+    for (const auto &[field, type] : it_fields->second) {
+        if (!has_entries(type)) continue;
+        if (type == IndexType::ORDERED) {
+            auto &entries = ordered_indexes_[coll][field];
+            OrderedEntryLess less;
+            std::vector<std::pair<IndexKey, std::string>> removed;
+            for (size_t i = 0; i < docs.size(); ++i) {
+                if (doc_ids[i].empty()) continue;
+                for (auto &key : make_path_keys(*docs[i], field)) {
+                    removed.emplace_back(std::move(key), doc_ids[i]);
+                }
+            }
+            std::sort(removed.begin(), removed.end(), less);
+            size_t size_before = entries.size();
+
+            auto same = [&less](const auto &a, const auto &b) {
+                return !less(a, b) && !less(b, a);
+            };
+            size_t next = 0;
+            while (next < removed.size()) {
+                auto first = entries.find(removed[next++]);
+                if (first == entries.end()) continue;
+                auto last = std::next(first);
+                while (next < removed.size() && last != entries.end() &&
+                       same(*last, removed[next])) {
+                    ++last;
+                    ++next;
+                }
+                entries.erase(first, last);
+            }
+            ordered_statistics_[coll][field].note_changes(entries, size_before - entries.size());
+            continue;
+        }
+
+        auto it_coll = custom_indexes_.find(coll);
+        if (it_coll == custom_indexes_.end()) continue;
+        auto it_index = it_coll->second.find(field);
+        if (it_index == it_coll->second.end()) continue;
+        auto &postings = it_index->second.postings;
+
+        std::unordered_map<std::string, std::vector<const std::string *>> by_key;
+        for (size_t i = 0; i < docs.size(); ++i) {
+            if (doc_ids[i].empty()) continue;
+            for (auto &key : hash_keys(*docs[i], field)) {
+                by_key[std::move(key)].push_back(&doc_ids[i]);
+            }
         }
+        size_t changed = 0;
+        for (const auto &[key, ids] : by_key) {
+            auto it = postings.find(key);
+            if (it == postings.end()) continue;
+            for (const auto *id : ids) changed += it->second.erase(*id);
+            if (it->second.empty()) postings.erase(it);
+        }
+        it_index->second.statistics.entries -= changed;
+        it_index->second.note_changes(changed);
+    }
+}
+
+/**
+ * @brief Rebuilds the key filter of a hash index from its postings.
+ */
+void SecondaryIndexer::HashIndex::rebuild_filter() {
+    keys = BloomFilter(2 * postings.size());
+    for (const auto &[key, ids] : postings) {
+        keys.insert(BloomFilter::hash(key));
+    }
+}
+
+/**
+ * @brief Recounts the most common keys of a hash index from its postings.
+ * @details The keys are ranked by the size of their postings with a partial sort of pointers, so
+ * no key is copied but the few that are kept.
+ */
+void SecondaryIndexer::HashIndex::rebuild_statistics() {
+    statistics.distinct = static_cast<double>(postings.size());
+    statistics.most_common.clear();
+    statistics.changes = 0;
+    if (postings.empty()) return;
+
+    std::vector<std::pair<size_t, const std::string *>> sizes;
+    sizes.reserve(postings.size());
+    for (const auto &[key, ids] : postings) sizes.emplace_back(ids.size(), &key);
+    size_t kept = std::min(IndexStatistics::MOST_COMMON_VALUES, sizes.size());
+    std::partial_sort(sizes.begin(), sizes.begin() + kept, sizes.end(),
+                      [](const auto &a, const auto &b) { return a.first > b.first; });
+    double average = static_cast<double>(statistics.entries) / statistics.distinct;
+    for (size_t i = 0; i < kept && static_cast<double>(sizes[i].first) > average; ++i) {
+        statistics.most_common.push_back({*sizes[i].second, sizes[i].first});
+    }
+}
+
+/**
+ * @brief Records entries added to or removed from a hash index.
+ * @details The number of keys is the number of postings, so it is always exact; the most common
+ * keys are recounted once the index has changed by a quarter since they last were.
+ * @param changed The number of entries added or removed.
+ */
+void SecondaryIndexer::HashIndex::note_changes(size_t changed) {
+    statistics.distinct = static_cast<double>(postings.size());
+    statistics.changes += changed;
+    if (statistics.is_stale()) rebuild_statistics();
+}
+
+/**
+ * @brief Rebuilds the histogram and the key sketch of an ordered index from its entries.
+ * @details A single walk in key order hashes each distinct key once into a fresh sketch and picks
+ * the key at every `1 / HISTOGRAM_BUCKETS` of the entries as a bucket bound, and the last key
+ * as the final bound.
+ * @param entries The entries of the index.
+ */
+void SecondaryIndexer::OrderedStatistics::rebuild(
+    const std::set<std::pair<IndexKey, std::string>, OrderedEntryLess> &entries) {
+    keys.clear();
+    statistics.entries = entries.size();
+    statistics.histogram.clear();
+    statistics.changes = 0;
+    if (entries.empty()) {
+        statistics.distinct = 0.0;
+        return;
+    }
+
+    size_t buckets = std::min(IndexStatistics::HISTOGRAM_BUCKETS, entries.size());
+    statistics.histogram.reserve(buckets + 1);
+    size_t position = 0;
+    size_t next_bound = 0;
+    const IndexKey *previous = nullptr;
+    for (const auto &entry : entries) {
+        if (!previous || *previous < entry.first) keys.add(hash_index_key(entry.first));
+        previous = &entry.first;
+        if (position == next_bound) {
+            statistics.histogram.push_back(entry.first);
+            next_bound = (statistics.histogram.size() * entries.size()) / buckets;
+        }
+        ++position;
     }
+    statistics.histogram.push_back(*previous);
+    statistics.distinct = std::min(keys.estimate(), static_cast<double>(entries.size()));
+}
+
+/**
+ * @brief Records entries added to or removed from an ordered index.
+ * @details The caller has added the keys of new entries to the sketch. Removals cannot be taken
+ * out of it, which the next rebuild, once the index has changed by a quarter, makes up for.
+ * @param entries The entries of the index after the change.
+ * @param changed The number of entries added or removed.
+ */
+void SecondaryIndexer::OrderedStatistics::note_changes(
+    const std::set<std::pair<IndexKey, std::string>, OrderedEntryLess> &entries,
+    size_t changed) {
+    statistics.entries = entries.size();
+    statistics.distinct = std::min(keys.estimate(), static_cast<double>(entries.size()));
+    statistics.changes += changed;
+    if (statistics.is_stale()) rebuild(entries);
 }
 
 /**
- * @brief Retrieves a list of documents that match a specific key-value pair in a secondary index.
+ * @brief Retrieves the `_id`s of the documents that match a specific key-value pair in a
+ * secondary index.
  * @details This function performs a highly concurrent, read-locked lookup. It traverses the
- * multi-level `custom_indexes_` map to locate the vector of documents associated with the
- * specified collection, field, and value.
- * @param coll The name of the collection to search.
+ * multi-level `custom_indexes_` map to the posting set of the specified collection, field, and
+ * value, and copies out its `_id`s. The cost is proportional to the number of matches, not to
+ * their size. A value the index's key filter rules out is not looked up in the postings.
+ *
+ * @param coll The collection to search.
  * @param field The indexed field to query.
- * @param value The stringified value to match within the index.
- * @return A `std::vector` of `aevum::bson::doc::Document` copies that match the query. If no
- *         index or value is found, an empty vector is returned.
+ * @param value The string representation of the value to look for.
+ * @return The `_id`s of the matching documents, or an empty vector if no match is found.
  */
-std::vector<aevum::bson::doc::Document> SecondaryIndexer::get_documents_by_secondary_index(
+std::vector<std::string> SecondaryIndexer::get_ids_by_secondary_index(
     const std::string &coll, const std::string &field, const std::string &value) const {
     std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
 
+    std::vector<std::string> ids;
     auto it_coll = custom_indexes_.find(coll);
     if (it_coll != custom_indexes_.end()) {
         auto it_field = it_coll->second.find(field);
-        if (it_field != it_coll->second.end()) {
-            auto it_val = it_field->second.find(value);
-            if (it_val != it_field->second.end()) {
-                return it_val->second;
+        if (it_field != it_coll->second.end() &&
+            it_field->second.keys.may_contain(BloomFilter::hash(value))) {
+            const auto &postings = it_field->second.postings;
+            auto it_val = postings.find(value);
+            if (it_val != postings.end()) {
+                ids.assign(it_val->second.begin(), it_val->second.end());
             }
         }
     }
-    return {};
+    return ids;
 }
 
 /**
@@ -161,16 +458,346 @@ bool SecondaryIndexer::is_field_indexed(const std::string &coll, const std::stri
     return false;
 }
 
+/**
+ * @brief Performs a thread-safe check to determine if a collection has any secondary index.
+ * @details This function performs a read-locked lookup in the `indexed_fields_` metadata map.
+ * @param coll The collection name.
+ * @return `true` if at least one field of `coll` is indexed.
+ */
+bool SecondaryIndexer::has_indexes(const std::string &coll) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it = indexed_fields_.find(coll);
+    return it != indexed_fields_.end() && !it->second.empty();
+}
+
+/**
+ * @brief Looks up the type of the index registered on a field.
+ * @details This function performs a read-locked lookup in the `indexed_fields_` metadata map.
+ * @param coll The collection name.
+ * @param field The field name to check.
+ * @return The field's `IndexType`, or `std::nullopt` if it is not indexed.
+ */
+std::optional<IndexType> SecondaryIndexer::get_index_type(const std::string &coll,
+                                                          const std::string &field) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = indexed_fields_.find(coll);
+    if (it_coll != indexed_fields_.end()) {
+        auto it_field = it_coll->second.find(field);
+        if (it_field != it_coll->second.end()) {
+            return it_field->second;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Checks whether an ordered index holds entries for the elements of an array.
+ * @details Every array contributes an `ARRAY` key of its own, so the index is multikey exactly
+ * when that rank is not empty; a single lookup tells.
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @return `true` if some document holds an array under the field.
+ */
+bool SecondaryIndexer::is_multikey(const std::string &coll, const std::string &field) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = ordered_indexes_.find(coll);
+    if (it_coll == ordered_indexes_.end()) return false;
+    auto it_field = it_coll->second.find(field);
+    if (it_field == it_coll->second.end()) return false;
+    auto it = it_field->second.lower_bound(IndexKey::floor(KeyRank::ARRAY));
+    return it != it_field->second.end() && it->first.rank == KeyRank::ARRAY;
+}
+
+/**
+ * @brief Lists the compound hash indexes of a collection.
+ * @details This function performs a read-locked scan of the collection's index definitions.
+ * @param coll The name of the collection.
+ * @return The names of the indexes.
+ */
+std::vector<std::string> SecondaryIndexer::compound_indexes(const std::string &coll) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    std::vector<std::string> names;
+    auto it = indexed_fields_.find(coll);
+    if (it == indexed_fields_.end()) return names;
+    for (const auto &[name, type] : it->second) {
+        if (type == IndexType::HASH && is_compound_index(name)) names.push_back(name);
+    }
+    return names;
+}
+
+/**
+ * @brief Retrieves the `_id`s of the documents whose key lies in a range of an ordered index.
+ * @param coll The collection to search.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to collect.
+ * @param limit The most entries to collect, or 0 for all of them.
+ * @return The `_id`s of the matching documents, in ascending key order.
+ */
+std::vector<std::string> SecondaryIndexer::get_ids_in_range(const std::string &coll,
+                                                            const std::string &field,
+                                                            const KeyRange &range,
+                                                            size_t limit) const {
+    std::vector<std::string> ids;
+    scan_ordered_index(coll, field, range, false, [&](const IndexKey &, const std::string &id) {
+        ids.push_back(id);
+        return limit == 0 || ids.size() < limit;
+    });
+    return ids;
+}
+
+/**
+ * @brief Counts the entries of an ordered index whose key lies in a range.
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to count.
+ * @return The number of entries in `range`.
+ */
+size_t SecondaryIndexer::count_in_range(const std::string &coll, const std::string &field,
+                                        const KeyRange &range) const {
+    size_t count = 0;
+    scan_ordered_index(coll, field, range, false, [&](const IndexKey &, const std::string &) {
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+/**
+ * @brief Visits the entries of an ordered index in key order.
+ * @details The bounds of `range` are located with logarithmic lookups on the sorted set, after
+ * which the entries in between are walked forwards or backwards. Nothing outside the range is
+ * touched, so a traversal that is stopped early costs only as much as the entries it visited.
+ *
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys to visit.
+ * @param descending `true` to visit from the largest key down.
+ * @param visit Called with the key and `_id` of each entry; returning `false` ends the traversal.
+ */
+void SecondaryIndexer::scan_ordered_index(
+    const std::string &coll, const std::string &field, const KeyRange &range, bool descending,
+    const std::function<bool(const IndexKey &, const std::string &)> &visit) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    if (range.empty()) return;
+
+    auto it_coll = ordered_indexes_.find(coll);
+    if (it_coll == ordered_indexes_.end()) return;
+    auto it_field = it_coll->second.find(field);
+    if (it_field == it_coll->second.end()) return;
+
+    const auto &entries = it_field->second;
+    auto first = range.lower_inclusive ? entries.lower_bound(range.lower)
+                                       : entries.upper_bound(range.lower);
+    auto last = !range.upper             ? entries.end()
+                : range.upper_inclusive ? entries.upper_bound(*range.upper)
+                                        : entries.lower_bound(*range.upper);
+
+    if (descending) {
+        for (auto it = std::make_reverse_iterator(last); it != std::make_reverse_iterator(first);
+             ++it) {
+            if (!visit(it->first, it->second)) return;
+        }
+    } else {
+        for (auto it = first; it != last; ++it) {
+            if (!visit(it->first, it->second)) return;
+        }
+    }
+}
+
+/**
+ * @brief Returns the statistics of a hash or ordered index.
+ * @param coll The name of the collection.
+ * @param field The field carrying the index.
+ * @return A copy of the statistics.
+ */
+IndexStatistics SecondaryIndexer::statistics(const std::string &coll,
+                                             const std::string &field) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    if (auto it_coll = custom_indexes_.find(coll); it_coll != custom_indexes_.end()) {
+        if (auto it = it_coll->second.find(field); it != it_coll->second.end()) {
+            return it->second.statistics;
+        }
+    }
+    if (auto it_coll = ordered_statistics_.find(coll); it_coll != ordered_statistics_.end()) {
+        if (auto it = it_coll->second.find(field); it != it_coll->second.end()) {
+            return it->second.statistics;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Estimates the number of entries of a hash index filed under a key.
+ * @param coll The name of the collection.
+ * @param field The field carrying a hash index.
+ * @param key The index key.
+ * @return The estimate.
+ */
+double SecondaryIndexer::estimate_equal(const std::string &coll, const std::string &field,
+                                        std::string_view key) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = custom_indexes_.find(coll);
+    if (it_coll == custom_indexes_.end()) return 0.0;
+    auto it = it_coll->second.find(field);
+    return it == it_coll->second.end() ? 0.0 : it->second.statistics.estimate_equal(key);
+}
+
+/**
+ * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param range The interval of keys.
+ * @return The estimate.
+ */
+double SecondaryIndexer::estimate_range(const std::string &coll, const std::string &field,
+                                        const KeyRange &range) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = ordered_statistics_.find(coll);
+    if (it_coll == ordered_statistics_.end()) return 0.0;
+    auto it = it_coll->second.find(field);
+    return it == it_coll->second.end() ? 0.0 : it->second.statistics.estimate_range(range);
+}
+
 /**
  * @brief Registers a new field to be indexed for a specific collection.
  * @details This write operation acquires an exclusive lock to safely modify the `indexed_fields_`
  * map.
  * @param coll The name of the collection.
  * @param field The name of the field to add to the set of indexed fields for that collection.
+ * @param type The organization of the new index.
+ * @param filter The filter of a sparse or partial index; null for an index over every document.
+ */
+void SecondaryIndexer::add_indexed_field(const std::string &coll, const std::string &field,
+                                         IndexType type, IndexFilterPtr filter) {
+    std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
+    indexed_fields_[coll].emplace(field, type);
+    if (filter) index_filters_[coll][field] = std::move(filter);
+}
+
+/**
+ * @brief Sets or clears the filter of a registered index.
+ * @param coll The name of the collection.
+ * @param field The indexed field.
+ * @param filter The filter, or null to clear it.
+ */
+void SecondaryIndexer::set_index_filter(const std::string &coll, const std::string &field,
+                                        IndexFilterPtr filter) {
+    std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
+    if (filter) {
+        index_filters_[coll][field] = std::move(filter);
+        return;
+    }
+    auto it_coll = index_filters_.find(coll);
+    if (it_coll == index_filters_.end()) return;
+    it_coll->second.erase(field);
+    if (it_coll->second.empty()) index_filters_.erase(it_coll);
+}
+
+/**
+ * @brief Looks up the filter of an index.
+ * @param coll The name of the collection.
+ * @param field The indexed field.
+ * @return The filter, or null.
+ */
+IndexFilterPtr SecondaryIndexer::index_filter(const std::string &coll,
+                                              const std::string &field) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = index_filters_.find(coll);
+    if (it_coll == index_filters_.end()) return nullptr;
+    auto it = it_coll->second.find(field);
+    return it == it_coll->second.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Lists the filters of the sparse and partial indexes of a collection.
+ * @param coll The name of the collection.
+ * @return The filters, by index name.
+ */
+std::unordered_map<std::string, IndexFilterPtr> SecondaryIndexer::index_filters(
+    const std::string &coll) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = index_filters_.find(coll);
+    if (it_coll == index_filters_.end()) return {};
+    return it_coll->second;
+}
+
+/**
+ * @brief Replaces the entries of a hash index with a precomputed set.
+ * @details The postings of the field are rebuilt from the pairs; any previous postings of the
+ * field are discarded. The key filter is then built from the distinct keys.
+ * @param coll The name of the collection.
+ * @param field The field carrying a hash index.
+ * @param entries The `(index key, _id)` pairs of the index.
  */
-void SecondaryIndexer::add_indexed_field(const std::string &coll, const std::string &field) {
+void SecondaryIndexer::load_entries(const std::string &coll, const std::string &field,
+                                    HashEntries entries) {
     std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
-    indexed_fields_[coll].insert(field);
+    HashIndex &index = custom_indexes_[coll][field];
+    index.postings.clear();
+    size_t count = 0;
+    for (auto &[key, id] : entries) {
+        count += index.postings[key].insert(std::move(id)).second;
+    }
+    index.rebuild_filter();
+    index.statistics.entries = count;
+    index.rebuild_statistics();
+}
+
+/**
+ * @brief Replaces the entries of an ordered index with a precomputed set.
+ * @details Every entry is inserted with the end of the set as its hint, which costs amortized
+ * constant time for entries arriving in order and stays correct, at logarithmic cost, for those
+ * that do not.
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param entries The `(IndexKey, _id)` pairs of the index.
+ */
+void SecondaryIndexer::load_entries(const std::string &coll, const std::string &field,
+                                    OrderedEntries entries) {
+    std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto &ordered = ordered_indexes_[coll][field];
+    ordered.clear();
+    for (auto &entry : entries) {
+        ordered.insert(ordered.end(), std::move(entry));
+    }
+    ordered_statistics_[coll][field].rebuild(ordered);
+}
+
+/**
+ * @brief Copies the entries of a hash index.
+ * @param coll The name of the collection.
+ * @param field The field carrying a hash index.
+ * @param entries Receives the `(index key, _id)` pairs; left empty if there is no such index.
+ */
+void SecondaryIndexer::copy_entries(const std::string &coll, const std::string &field,
+                                    HashEntries &entries) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = custom_indexes_.find(coll);
+    if (it_coll == custom_indexes_.end()) return;
+    auto it_field = it_coll->second.find(field);
+    if (it_field == it_coll->second.end()) return;
+    entries.reserve(entries.size() + it_field->second.statistics.entries);
+    for (const auto &[key, ids] : it_field->second.postings) {
+        for (const auto &id : ids) entries.emplace_back(key, id);
+    }
+}
+
+/**
+ * @brief Copies the entries of an ordered index.
+ * @param coll The name of the collection.
+ * @param field The field carrying an ordered index.
+ * @param entries Receives the `(IndexKey, _id)` pairs in ascending order; left empty if there is
+ *        no such index.
+ */
+void SecondaryIndexer::copy_entries(const std::string &coll, const std::string &field,
+                                    OrderedEntries &entries) const {
+    std::shared_lock<std::shared_mutex> lock(secondary_index_lock_);
+    auto it_coll = ordered_indexes_.find(coll);
+    if (it_coll == ordered_indexes_.end()) return;
+    auto it_field = it_coll->second.find(field);
+    if (it_field == it_coll->second.end()) return;
+    entries.reserve(entries.size() + it_field->second.size());
+    entries.insert(entries.end(), it_field->second.begin(), it_field->second.end());
 }
 
 /**
@@ -182,6 +809,8 @@ void SecondaryIndexer::add_indexed_field(const std::string &coll, const std::str
 void SecondaryIndexer::clear_collection_indexes(const std::string &coll) {
     std::unique_lock<std::shared_mutex> lock(secondary_index_lock_);
     custom_indexes_.erase(coll);
+    ordered_indexes_.erase(coll);
+    ordered_statistics_.erase(coll);
 }
 
 /**
@@ -191,8 +820,7 @@ void SecondaryIndexer::clear_collection_indexes(const std::string &coll) {
  * underlying data structure through its `const` nature in a concurrent context.
  * @return A constant reference to the `indexed_fields_` map.
  */
-const std::unordered_map<std::string, std::unordered_set<std::string>> &
-SecondaryIndexer::get_all_indexed_fields() const {
+const IndexDefinitions &SecondaryIndexer::get_all_indexed_fields() const {
     return indexed_fields_;
 }
 
@@ -203,8 +831,7 @@ SecondaryIndexer::get_all_indexed_fields() const {
  * responsible for ensuring external synchronization if this method is used in a concurrent context.
  * @return A mutable reference to the `indexed_fields_` map.
  */
-std::unordered_map<std::string, std::unordered_set<std::string>> &
-SecondaryIndexer::get_all_indexed_fields_mutable() {
+IndexDefinitions &SecondaryIndexer::get_all_indexed_fields_mutable() {
     return indexed_fields_;
 }
 
@@ -14,13 +14,22 @@
  */
 #pragma once
 
+#include <functional>
+#include <optional>
+#include <set>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "aevum/bson/doc/document.hpp"
+#include "aevum/db/index/bloom_filter.hpp"
+#include "aevum/db/index/index_filter.hpp"
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/db/index/index_statistics.hpp"
+#include "aevum/util/hash/string_hash.hpp"
 
 namespace aevum::db::index {
 
@@ -28,10 +37,24 @@ namespace aevum::db::index {
  * @class SecondaryIndexer
  * @brief Manages a sophisticated, in-memory inverted index for arbitrary document fields.
  *
- * @details This class is the powerhouse of secondary indexing in AevumDB. It maintains a
- * deeply nested data structure (`Collection -> Field -> Stringified Value -> List of Documents`)
- * that functions as an inverted index. This allows for extremely fast retrieval of all documents
- * that contain a specific value for an indexed field.
+ * @details This class is the powerhouse of secondary indexing in AevumDB. It maintains two kinds
+ * of index, selected per field by an `IndexType`:
+ * - `HASH`: a deeply nested data structure (`Collection -> Field -> Stringified Value -> Set of
+ *   _ids`) that functions as an inverted index. This allows for extremely fast retrieval of the
+ *   identities of all documents that contain a specific value for an indexed field. A
+ *   `BloomFilter` of the keys sits next to the postings, so a lookup of a value no document holds
+ *   is usually answered from one cache line.
+ * - `ORDERED`: a sorted set of `(IndexKey, _id)` entries per field, which additionally answers
+ *   range predicates and can be traversed in sort order.
+ *
+ * An index covers a field path (see `find_field_path`), so embedded fields such as
+ * `"address.city"` can be indexed like top-level ones. A single-field index is multikey: an array
+ * contributes an entry per element. A hash index may also be compound, covering several fields
+ * named together as `"tenant,status"`; it keeps an entry for every prefix of the field list, so
+ * that an equality on the leading fields alone is answered as well as one on all of them.
+ *
+ * An index with an `IndexFilter` is sparse or partial: a document the filter does not admit is
+ * given no entry, and keeps none once an update makes it leave the filter.
  *
  * It is engineered for a high-concurrency environment, using a `std::shared_mutex` to allow
  * parallel, non-blocking read operations (queries) while ensuring that write operations
@@ -59,26 +82,72 @@ class SecondaryIndexer {
      * @param coll The name of the collection to which the document belongs.
      * @param doc The BSON document being added to or removed from the collection.
      * @param add A boolean flag indicating the operation type: `true` to add the document to the
-     *        indexes, `false` to remove it.
+     *        indexes, `false` to remove it. A document is only added to the filtered indexes
+     *        whose `IndexFilter` admits it; removing one from an index it is not in does nothing.
      */
     void update_custom_index(const std::string &coll, const aevum::bson::doc::Document &doc,
                              bool add);
 
     /**
-     * @brief Retrieves all documents that match a specific value in a secondary index.
+     * @brief Removes a batch of documents from all applicable secondary indexes.
+     * @details Equivalent to `update_custom_index(coll, *doc, false)` for every document, but
+     * under a single exclusive lock, with the `_id`s of each `HASH` posting set erased together
+     * and the entries of each `ORDERED` index erased in contiguous ranges.
+     *
+     * @param coll The name of the collection to which the documents belong.
+     * @param docs The documents being removed from the collection.
+     */
+    void remove_documents(const std::string &coll,
+                          const std::vector<const aevum::bson::doc::Document *> &docs);
+
+    /**
+     * @brief Retrieves the `_id`s of all documents that match a specific value in a secondary
+     * index.
      * @details This method provides the primary query interface for the secondary index. It
-     * performs a highly concurrent, read-locked lookup to find all documents in a given collection
-     * that have a specific value for an indexed field.
+     * performs a highly concurrent, read-locked lookup of the posting set stored under `value`,
+     * skipped when the index's key filter rules the value out. The caller resolves the documents
+     * themselves through the primary index.
      *
      * @param coll The name of the collection to search within.
      * @param field The indexed field to query against.
-     * @param value The string representation of the value to match.
-     * @return A `std::vector` of BSON documents matching the criteria. If no matches are found, or
-     *         if the field is not indexed, an empty vector is returned.
+     * @param value The index key of the value to match, as produced by `to_index_key`.
+     * @return The `_id`s of the matching documents. If no matches are found, or if the field is not
+     *         indexed, an empty vector is returned.
      */
-    [[nodiscard]] std::vector<aevum::bson::doc::Document> get_documents_by_secondary_index(
+    [[nodiscard]] std::vector<std::string> get_ids_by_secondary_index(
         const std::string &coll, const std::string &field, const std::string &value) const;
 
+    /**
+     * @brief Converts the BSON value under an iterator into its secondary index key.
+     * @details This is the single normalization used both when documents are indexed and when a
+     * query value is looked up, so that the two always agree. Supported types are UTF8 String,
+     * Int32, Int64, Double, and Bool.
+     * @param iter An iterator positioned on the value to convert.
+     * @return The index key, or an empty string if the value's type is not supported for indexing.
+     */
+    [[nodiscard]] static std::string to_index_key(const bson_iter_t &iter);
+
+    /**
+     * @brief Computes the keys a document contributes to a hash index.
+     * @details For a single field, the key of its value, or of every element if it is an array.
+     * For a compound index, the keys of all prefixes of the field list whose fields hold an
+     * indexable scalar, each joined by `COMPOUND_KEY_SEPARATOR`; the prefixes end at the first
+     * field that does not. Compound keys do not enter arrays, since an equality never matches
+     * one.
+     * @param doc The document to inspect.
+     * @param index The name of the index.
+     * @return The distinct keys, in ascending order; empty if the document has no entry.
+     */
+    [[nodiscard]] static std::vector<std::string> hash_keys(const aevum::bson::doc::Document &doc,
+                                                            const std::string &index);
+
+    /**
+     * @brief Joins the keys of the leading fields of a compound index into an index key.
+     * @param parts The keys of the fields, as produced by `to_index_key`, in index order.
+     * @return The key under which `hash_keys` files documents with these values.
+     */
+    [[nodiscard]] static std::string join_compound_key(const std::vector<std::string> &parts);
+
     /**
      * @brief Performs a thread-safe check to determine if a field is indexed for a collection.
      * @param coll The name of the collection.
@@ -88,6 +157,112 @@ class SecondaryIndexer {
      */
     [[nodiscard]] bool is_field_indexed(const std::string &coll, const std::string &field) const;
 
+    /**
+     * @brief Performs a thread-safe check to determine if a collection has any secondary index.
+     * @param coll The name of the collection.
+     * @return `true` if at least one field of the collection is indexed.
+     */
+    [[nodiscard]] bool has_indexes(const std::string &coll) const;
+
+    /**
+     * @brief Looks up the type of the index registered on a field.
+     * @param coll The name of the collection.
+     * @param field The name of the field to check.
+     * @return The `IndexType` of the field's index, or `std::nullopt` if the field is not indexed.
+     */
+    [[nodiscard]] std::optional<IndexType> get_index_type(const std::string &coll,
+                                                          const std::string &field) const;
+
+    /**
+     * @brief Checks whether an ordered index holds entries for the elements of an array.
+     * @details Such an index has more entries than documents, so that neither the number of
+     * entries in a range nor their order stands for the documents any longer.
+     * @param coll The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @return `true` if some document holds an array under the field.
+     */
+    [[nodiscard]] bool is_multikey(const std::string &coll, const std::string &field) const;
+
+    /**
+     * @brief Lists the compound hash indexes of a collection.
+     * @param coll The name of the collection.
+     * @return The names of the indexes, as given to `add_indexed_field`.
+     */
+    [[nodiscard]] std::vector<std::string> compound_indexes(const std::string &coll) const;
+
+    /**
+     * @brief Retrieves the `_id`s of the documents whose key lies in a range of an ordered index.
+     * @param coll The name of the collection to search within.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to collect.
+     * @param limit The most entries to collect, or 0 for all of them.
+     * @return The `_id`s of the matching documents in ascending key order. Returns an empty vector
+     *         if the field has no ordered index.
+     */
+    [[nodiscard]] std::vector<std::string> get_ids_in_range(const std::string &coll,
+                                                            const std::string &field,
+                                                            const KeyRange &range,
+                                                            size_t limit = 0) const;
+
+    /**
+     * @brief Counts the entries of an ordered index whose key lies in a range.
+     * @details Nothing is copied; the entries in range are only walked.
+     * @param coll The name of the collection to search within.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to count.
+     * @return The number of entries in `range`, or 0 if the field has no ordered index.
+     */
+    [[nodiscard]] size_t count_in_range(const std::string &coll, const std::string &field,
+                                        const KeyRange &range) const;
+
+    /**
+     * @brief Visits the entries of an ordered index in key order, stopping on request.
+     * @details The read lock is held for the whole traversal, so `visit` must not call back into
+     * this indexer. Entries with equal keys are visited in `_id` order.
+     * @param coll The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys to visit.
+     * @param descending `true` to visit from the largest key down.
+     * @param visit Called with the key and `_id` of each entry; returning `false` ends the
+     *        traversal.
+     */
+    void scan_ordered_index(
+        const std::string &coll, const std::string &field, const KeyRange &range,
+        bool descending,
+        const std::function<bool(const IndexKey &, const std::string &)> &visit) const;
+
+    /**
+     * @brief Returns the statistics of a hash or ordered index.
+     * @details A copy taken under the read lock, for display.
+     * @param coll The name of the collection.
+     * @param field The field carrying the index.
+     * @return The statistics, or empty ones if the field has no hash or ordered index.
+     */
+    [[nodiscard]] IndexStatistics statistics(const std::string &coll,
+                                             const std::string &field) const;
+
+    /**
+     * @brief Estimates the number of entries of a hash index filed under a key.
+     * @details See `IndexStatistics::estimate_equal`; nothing is copied.
+     * @param coll The name of the collection.
+     * @param field The field carrying a `HASH` index.
+     * @param key The index key, as produced by `to_index_key`.
+     * @return The estimate, or 0 if the field has no hash index.
+     */
+    [[nodiscard]] double estimate_equal(const std::string &coll, const std::string &field,
+                                        std::string_view key) const;
+
+    /**
+     * @brief Estimates the number of entries of an ordered index whose key lies in a range.
+     * @details See `IndexStatistics::estimate_range`; nothing is copied.
+     * @param coll The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param range The interval of keys.
+     * @return The estimate, or 0 if the field has no ordered index.
+     */
+    [[nodiscard]] double estimate_range(const std::string &coll, const std::string &field,
+                                        const KeyRange &range) const;
+
     /**
      * @brief Registers a new field to be indexed for a collection.
      * @details This method exclusively modifies the index metadata, marking a field as "indexable".
@@ -95,8 +270,81 @@ class SecondaryIndexer {
      * The operation acquires an exclusive write lock.
      * @param coll The name of the collection.
      * @param field The name of the field to register for indexing.
+     * @param type The organization of the new index.
+     * @param filter The filter of a sparse or partial index, or null for an index over every
+     *        document.
+     */
+    void add_indexed_field(const std::string &coll, const std::string &field,
+                           IndexType type = IndexType::HASH, IndexFilterPtr filter = nullptr);
+
+    /**
+     * @brief Sets or clears the filter of a registered index.
+     * @details Used when the index definitions are loaded; the entries are not revisited. The
+     * operation acquires an exclusive write lock.
+     * @param coll The name of the collection.
+     * @param field The indexed field.
+     * @param filter The filter, or null for an index over every document.
+     */
+    void set_index_filter(const std::string &coll, const std::string &field,
+                          IndexFilterPtr filter);
+
+    /**
+     * @brief Looks up the filter of an index.
+     * @param coll The name of the collection.
+     * @param field The indexed field.
+     * @return The filter, or null if the index holds every document or does not exist.
+     */
+    [[nodiscard]] IndexFilterPtr index_filter(const std::string &coll,
+                                              const std::string &field) const;
+
+    /**
+     * @brief Lists the filters of the sparse and partial indexes of a collection.
+     * @param coll The name of the collection.
+     * @return The filter of each such index, by index name; empty if there is none.
+     */
+    [[nodiscard]] std::unordered_map<std::string, IndexFilterPtr> index_filters(
+        const std::string &coll) const;
+
+    /**
+     * @brief Replaces the entries of a hash index with a precomputed set.
+     * @details Used to restore an index from its persisted entries, or to fill a new one, without
+     * re-reading the documents. The operation acquires an exclusive write lock.
+     * @param coll The name of the collection.
+     * @param field The field carrying a `HASH` index.
+     * @param entries The `(index key, _id)` pairs of the index. They are consumed.
+     */
+    void load_entries(const std::string &coll, const std::string &field, HashEntries entries);
+
+    /**
+     * @brief Replaces the entries of an ordered index with a precomputed set.
+     * @details Entries given in ascending `(IndexKey, _id)` order, as they are read from storage,
+     * are appended in amortized constant time each. The operation acquires an exclusive write
+     * lock.
+     * @param coll The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param entries The `(IndexKey, _id)` pairs of the index. They are consumed.
+     */
+    void load_entries(const std::string &coll, const std::string &field, OrderedEntries entries);
+
+    /**
+     * @brief Copies the entries of a hash index, the reverse of `load_entries`.
+     * @details The operation acquires a shared read lock.
+     * @param coll The name of the collection.
+     * @param field The field carrying a `HASH` index.
+     * @param entries Receives the `(index key, _id)` pairs of the index, in no particular order.
+     */
+    void copy_entries(const std::string &coll, const std::string &field,
+                      HashEntries &entries) const;
+
+    /**
+     * @brief Copies the entries of an ordered index, the reverse of `load_entries`.
+     * @details The operation acquires a shared read lock.
+     * @param coll The name of the collection.
+     * @param field The field carrying an `ORDERED` index.
+     * @param entries Receives the `(IndexKey, _id)` pairs of the index, in ascending order.
      */
-    void add_indexed_field(const std::string &coll, const std::string &field);
+    void copy_entries(const std::string &coll, const std::string &field,
+                      OrderedEntries &entries) const;
 
     /**
      * @brief Atomically clears all secondary index entries for a specific collection.
@@ -112,8 +360,7 @@ class SecondaryIndexer {
      * of index definitions to persistent storage.
      * @return A constant reference to the internal map of collection-to-field mappings.
      */
-    [[nodiscard]] const std::unordered_map<std::string, std::unordered_set<std::string>> &
-    get_all_indexed_fields() const;
+    [[nodiscard]] const IndexDefinitions &get_all_indexed_fields() const;
 
     /**
      * @brief Provides mutable, thread-safe access to the map of all registered indexed fields.
@@ -122,28 +369,140 @@ class SecondaryIndexer {
      * Direct modification outside of this context is strongly discouraged.
      * @return A mutable reference to the internal map of collection-to-field mappings.
      */
-    [[nodiscard]] std::unordered_map<std::string, std::unordered_set<std::string>> &
-    get_all_indexed_fields_mutable();
+    [[nodiscard]] IndexDefinitions &get_all_indexed_fields_mutable();
 
   private:
     /**
      * @var indexed_fields_
-     * @brief Metadata map tracking which fields are indexed per collection.
-     * The structure is `collection_name -> {field1, field2, ...}`.
+     * @brief Metadata map tracking which fields are indexed per collection, and how.
+     * The structure is `collection_name -> {field -> IndexType}`.
+     */
+    IndexDefinitions indexed_fields_;
+
+    /**
+     * @var index_filters_
+     * @brief The filters of the sparse and partial indexes, by collection and index name. An
+     * index without an entry here holds every document.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, IndexFilterPtr>>
+        index_filters_;
+
+    /**
+     * @struct HashIndex
+     * @brief The entries of one `HASH` index.
      */
-    std::unordered_map<std::string, std::unordered_set<std::string>> indexed_fields_;
+    struct HashIndex {
+        /// The `_id`s of the documents filed under each key.
+        std::unordered_map<std::string,
+                           std::unordered_set<std::string, aevum::util::hash::StringHash>,
+                           aevum::util::hash::StringHash>
+            postings;
+        /// Every key added to `postings` since the filter was last built; see `rebuild_filter`.
+        BloomFilter keys;
+        /// The number of `_id`s in `postings`, its number of keys, and its most common keys.
+        IndexStatistics statistics;
+
+        /**
+         * @brief Rebuilds `keys` from the current keys of `postings`.
+         * @details The filter is sized for twice as many keys, so adding keys one at a time
+         * rebuilds it only when the index has doubled. Keys whose postings were emptied are
+         * dropped from it.
+         */
+        void rebuild_filter();
+
+        /**
+         * @brief Recounts the most common keys from `postings`.
+         * @details Only keys with more entries than the average are listed.
+         */
+        void rebuild_statistics();
+
+        /**
+         * @brief Records entries added or removed, and recounts the most common keys once
+         * enough have been.
+         * @param changed The number of entries added or removed.
+         */
+        void note_changes(size_t changed);
+    };
 
     /**
      * @var custom_indexes_
      * @brief The core multi-level inverted index data structure.
-     * It maps: `Collection Name -> Field Name -> Stringified Field Value -> Vector of BSON
-     * Documents`. This structure allows for rapid lookups based on field values.
+     * It maps: `Collection Name -> Field Name -> Stringified Field Value -> Set of _ids`. Postings
+     * hold only document identities, which resolve through the primary index, so the documents
+     * themselves are stored once no matter how many fields are indexed. The set makes removing a
+     * document from a posting a constant-time operation.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, HashIndex>> custom_indexes_;
+
+    /**
+     * @struct OrderedEntryLess
+     * @brief Orders ordered-index entries by key, then by `_id`, and allows lookups by key alone.
+     */
+    struct OrderedEntryLess {
+        using is_transparent = void;
+
+        bool operator()(const std::pair<IndexKey, std::string> &a,
+                        const std::pair<IndexKey, std::string> &b) const noexcept {
+            if (a.first < b.first) return true;
+            if (b.first < a.first) return false;
+            return a.second < b.second;
+        }
+        bool operator()(const std::pair<IndexKey, std::string> &a,
+                        const IndexKey &b) const noexcept {
+            return a.first < b;
+        }
+        bool operator()(const IndexKey &a,
+                        const std::pair<IndexKey, std::string> &b) const noexcept {
+            return a < b.first;
+        }
+    };
+
+    /**
+     * @var ordered_indexes_
+     * @brief The entries of every `ORDERED` index.
+     * It maps: `Collection Name -> Field Name -> Sorted Set of (IndexKey, _id)`. Every document
+     * of the collection has at least one entry per ordered field, as `make_path_keys` describes:
+     * a missing field is keyed as null, and an array adds one entry per distinct element.
      */
     std::unordered_map<
         std::string,
-        std::unordered_map<
-            std::string, std::unordered_map<std::string, std::vector<aevum::bson::doc::Document>>>>
-        custom_indexes_;
+        std::unordered_map<std::string,
+                           std::set<std::pair<IndexKey, std::string>, OrderedEntryLess>>>
+        ordered_indexes_;
+
+    /**
+     * @struct OrderedStatistics
+     * @brief The statistics of one `ORDERED` index.
+     */
+    struct OrderedStatistics {
+        /// The number of entries, the estimated number of keys, and the histogram.
+        IndexStatistics statistics;
+        /// The keys added since the last rebuild; removed keys stay until the next one.
+        HyperLogLog keys;
+
+        /**
+         * @brief Rebuilds the histogram and the key sketch from the entries.
+         * @param entries The entries of the index, in order.
+         */
+        void rebuild(const std::set<std::pair<IndexKey, std::string>, OrderedEntryLess> &entries);
+
+        /**
+         * @brief Records entries added or removed, and rebuilds once enough have been.
+         * @param entries The entries of the index after the change.
+         * @param changed The number of entries added or removed.
+         */
+        void note_changes(
+            const std::set<std::pair<IndexKey, std::string>, OrderedEntryLess> &entries,
+            size_t changed);
+    };
+
+    /**
+     * @var ordered_statistics_
+     * @brief The statistics of every `ORDERED` index, by collection and field, kept in step with
+     * `ordered_indexes_`.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, OrderedStatistics>>
+        ordered_statistics_;
 
     /**
      * @var secondary_index_lock_
@@ -155,10 +514,9 @@ class SecondaryIndexer {
     /**
      * @brief A robust internal helper to extract and stringify a field's value from a BSON
      * document.
-     * @details This utility is fundamental to the indexing process. It can handle various BSON
-     * data types (UTF8 String, Int32, Int64, Double, Bool) and convert them into a canonical
-     * string format suitable for use as a key in the `custom_indexes_` map. This normalization
-     * ensures consistent indexing across different data types.
+     * @details It locates the top-level field and delegates to `to_index_key` to convert its
+     * value into the canonical string format of the index keys. `get_doc_id` uses it to read the
+     * `_id`; indexed fields are keyed by `hash_keys`, which also follows paths and arrays.
      * @param doc The BSON document from which to extract the value.
      * @param field The name of the field whose value is to be extracted and stringified.
      * @return The string representation of the field's value. Returns an empty string if the
@@ -169,8 +527,8 @@ class SecondaryIndexer {
 
     /**
      * @brief A specialized helper to efficiently extract the `_id` of a document.
-     * @details This is used internally during index removal operations to uniquely identify and
-     *          locate the specific document to be erased from an index entry's vector.
+     * @details This is used internally to obtain the handle that is stored in, and erased from,
+     *          the index postings.
      * @param doc The BSON document whose `_id` is to be retrieved.
      * @return The `_id` as a string, or an empty string if it cannot be found.
      */
@@ -0,0 +1,398 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file text_index.cpp
+ * @brief Implements the `TextIndex`, its posting list encoding, and BM25 ranking.
+ */
+#include "aevum/db/index/text_index.hpp"
+
+#include <algorithm>
+#include <bson/bson.h>
+#include <cctype>
+#include <cmath>
+
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/util/string/case_conversion.hpp"
+#include "aevum/util/string/split.hpp"
+
+namespace aevum::db::index {
+
+namespace {
+
+/// The BM25 term frequency saturation.
+constexpr double BM25_K1 = 1.2;
+/// The BM25 document length normalization.
+constexpr double BM25_B = 0.75;
+/// The fewest removed ordinals a table is compacted for.
+constexpr size_t MIN_COMPACTION = 1024;
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ * @param out The buffer.
+ * @param value The value.
+ */
+void put_varint(std::string &out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint.
+ * @param data The buffer.
+ * @param pos The offset of the varint; advanced past it.
+ * @return The value.
+ */
+uint32_t get_varint(const std::string &data, size_t &pos) {
+    uint32_t value = 0;
+    for (int shift = 0; pos < data.size(); shift += 7) {
+        auto byte = static_cast<uint8_t>(data[pos++]);
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) break;
+    }
+    return value;
+}
+
+/**
+ * @brief Calls a function with every posting of a list, in ascending ordinal order.
+ * @param list The posting list.
+ * @param visit Called with the ordinal and the term frequency of each posting.
+ */
+template <typename Visit>
+void for_each_posting(const TextIndex::PostingList &list, Visit &&visit) {
+    size_t pos = 0;
+    uint32_t ordinal = 0;
+    for (uint32_t i = 0; i < list.count; ++i) {
+        ordinal += get_varint(list.bytes, pos);
+        uint32_t frequency = get_varint(list.bytes, pos);
+        visit(ordinal, frequency);
+    }
+}
+
+/**
+ * @brief Collects the terms of a field of a document.
+ * @param doc The document.
+ * @param field The field path.
+ * @return The terms of its string, or of the strings of its array; empty for any other value.
+ */
+std::vector<std::string> field_terms(const aevum::bson::doc::Document &doc,
+                                     const std::string &field) {
+    std::vector<std::string> terms;
+    bson_iter_t value;
+    if (!find_field_path(doc, field, value)) return terms;
+    auto add_string = [&](const bson_iter_t &element) {
+        uint32_t length = 0;
+        const char *text = bson_iter_utf8(&element, &length);
+        for (auto &term : TextIndex::tokenize(std::string_view(text, length))) {
+            terms.push_back(std::move(term));
+        }
+    };
+    if (BSON_ITER_HOLDS_UTF8(&value)) {
+        add_string(value);
+    } else if (BSON_ITER_HOLDS_ARRAY(&value)) {
+        bson_iter_t element;
+        if (bson_iter_recurse(&value, &element)) {
+            while (bson_iter_next(&element)) {
+                if (BSON_ITER_HOLDS_UTF8(&element)) add_string(element);
+            }
+        }
+    }
+    return terms;
+}
+
+}  // namespace
+
+/**
+ * @brief Appends a posting.
+ * @param ordinal The ordinal of the document.
+ * @param frequency The number of occurrences of the term.
+ */
+void TextIndex::PostingList::append(uint32_t ordinal, uint32_t frequency) {
+    put_varint(bytes, ordinal - last);
+    put_varint(bytes, frequency);
+    last = ordinal;
+    ++count;
+}
+
+/**
+ * @brief Splits a text into terms.
+ * @param text The text.
+ * @return The terms, with repetitions.
+ */
+std::vector<std::string> TextIndex::tokenize(std::string_view text) {
+    std::string lowered = aevum::util::string::to_lower(text);
+    for (char &c : lowered) {
+        auto byte = static_cast<unsigned char>(c);
+        if (byte < 0x80 && !std::isalnum(byte)) c = ' ';
+    }
+    std::vector<std::string> terms;
+    for (std::string_view term : aevum::util::string::split(lowered, ' ')) {
+        if (!term.empty()) terms.emplace_back(term);
+    }
+    return terms;
+}
+
+/**
+ * @brief Builds the table of a collection.
+ * @param fields The fields with a text index.
+ * @param documents Every document of the collection.
+ * @return The table.
+ */
+TextIndex::Table TextIndex::build_table(const std::vector<std::string> &fields,
+                                        const DocumentHandles &documents) {
+    Table table;
+    if (fields.empty()) return table;
+    for (const auto &field : fields) table.fields[field].lengths.reserve(documents.size());
+    table.ids.reserve(documents.size());
+    table.ordinals.reserve(documents.size());
+    for (const auto &[id, doc] : documents) {
+        if (doc) add_document(table, id, *doc);
+    }
+    return table;
+}
+
+/**
+ * @brief Replaces the table of a collection.
+ * @param coll The name of the collection.
+ * @param table The new table.
+ */
+void TextIndex::install_table(const std::string &coll, Table table) {
+    if (table.fields.empty()) {
+        tables_.erase(coll);
+        return;
+    }
+    tables_[coll] = std::move(table);
+}
+
+/**
+ * @brief Checks whether a collection has a table.
+ * @param coll The name of the collection.
+ * @return `true` if the collection has a text index.
+ */
+bool TextIndex::has_table(const std::string &coll) const { return tables_.count(coll) != 0; }
+
+/**
+ * @brief Estimates the memory held by the table of a collection.
+ * @details Each ordinal is charged its `_id` twice, for `ids` and the key of `ordinals`, and a
+ * hash node; each term its string, its encoded postings, and a node; and each field the term
+ * counts of its documents.
+ * @param coll The name of the collection.
+ * @return The estimate, in bytes.
+ */
+size_t TextIndex::memory_bytes(const std::string &coll) const {
+    constexpr size_t NODE_BYTES = 64;
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return 0;
+    const Table &table = it->second;
+    size_t bytes = 0;
+    for (const auto &id : table.ids) bytes += 2 * id.capacity() + NODE_BYTES;
+    for (const auto &[name, field] : table.fields) {
+        bytes += field.lengths.capacity() * sizeof(uint32_t);
+        for (const auto &[term, postings] : field.terms) {
+            bytes += term.capacity() + postings.bytes.capacity() + sizeof(PostingList) +
+                     NODE_BYTES;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Indexes a document, retiring the ordinal of its previous image.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ * @param doc The document.
+ */
+void TextIndex::upsert(const std::string &coll, const std::string &id,
+                       const aevum::bson::doc::Document &doc) {
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return;
+    remove(coll, id);
+    add_document(it->second, id, doc);
+}
+
+/**
+ * @brief Marks a document as removed, and compacts the table once half of it is.
+ * @param coll The name of the collection.
+ * @param id The `_id` of the document.
+ */
+void TextIndex::remove(const std::string &coll, const std::string &id) {
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return;
+    Table &table = it->second;
+    auto it_ordinal = table.ordinals.find(id);
+    if (it_ordinal == table.ordinals.end()) return;
+    uint32_t ordinal = it_ordinal->second;
+    table.ordinals.erase(it_ordinal);
+    table.ids[ordinal].clear();
+    ++table.removed;
+    for (auto &[name, field] : table.fields) {
+        uint32_t &length = field.lengths[ordinal];
+        if (length == 0) continue;
+        field.total_length -= length;
+        --field.documents;
+        length = 0;
+    }
+    if (table.removed >= MIN_COMPACTION && table.removed * 2 >= table.ids.size()) {
+        compact(table);
+    }
+}
+
+/**
+ * @brief Ranks the documents holding any term of a search text.
+ * @details Scores are accumulated in a dense array when the postings to read outnumber a
+ * sixteenth of the ordinals, and in a hash map otherwise, so that a rare term costs no more
+ * than its list.
+ * @param coll The name of the collection.
+ * @param text The search text.
+ * @param wanted The number of best documents to return, or 0 for all.
+ * @return The documents, best first.
+ */
+std::vector<TextHit> TextIndex::search(const std::string &coll, std::string_view text,
+                                       size_t wanted) const {
+    std::vector<TextHit> hits;
+    auto it = tables_.find(coll);
+    if (it == tables_.end()) return hits;
+    const Table &table = it->second;
+
+    std::vector<std::string> terms = tokenize(text);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    // The lists to read, with the field they belong to.
+    std::vector<std::pair<const Field *, const PostingList *>> lists;
+    size_t postings = 0;
+    for (const auto &[name, field] : table.fields) {
+        if (field.documents == 0) continue;
+        for (const auto &term : terms) {
+            auto it_term = field.terms.find(term);
+            if (it_term == field.terms.end()) continue;
+            lists.emplace_back(&field, &it_term->second);
+            postings += it_term->second.count;
+        }
+    }
+    if (lists.empty()) return hits;
+
+    const bool dense = postings * 16 >= table.ids.size();
+    std::vector<double> dense_scores(dense ? table.ids.size() : 0, 0.0);
+    std::unordered_map<uint32_t, double> sparse_scores;
+    if (!dense) sparse_scores.reserve(postings);
+    for (const auto &[field, list] : lists) {
+        const double documents = field->documents;
+        const double frequency = std::min<double>(list->count, documents);
+        const double idf = std::log(1.0 + (documents - frequency + 0.5) / (frequency + 0.5));
+        const double average_length = static_cast<double>(field->total_length) / documents;
+        for_each_posting(*list, [&](uint32_t ordinal, uint32_t term_frequency) {
+            uint32_t length = field->lengths[ordinal];
+            if (length == 0) return;  // Removed, or re-indexed under a newer ordinal.
+            double tf = term_frequency;
+            double score = idf * tf * (BM25_K1 + 1.0) /
+                           (tf + BM25_K1 * (1.0 - BM25_B + BM25_B * length / average_length));
+            if (dense) {
+                dense_scores[ordinal] += score;
+            } else {
+                sparse_scores[ordinal] += score;
+            }
+        });
+    }
+
+    std::vector<std::pair<double, uint32_t>> ranked;
+    if (dense) {
+        for (uint32_t ordinal = 0; ordinal < dense_scores.size(); ++ordinal) {
+            if (dense_scores[ordinal] > 0.0) ranked.emplace_back(dense_scores[ordinal], ordinal);
+        }
+    } else {
+        ranked.reserve(sparse_scores.size());
+        for (const auto &[ordinal, score] : sparse_scores) ranked.emplace_back(score, ordinal);
+    }
+    auto better = [](const auto &a, const auto &b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    if (wanted > 0 && wanted < ranked.size()) {
+        std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(wanted),
+                          ranked.end(), better);
+        ranked.resize(wanted);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), better);
+    }
+
+    hits.reserve(ranked.size());
+    for (const auto &[score, ordinal] : ranked) hits.push_back({table.ids[ordinal], score});
+    return hits;
+}
+
+/**
+ * @brief Adds a document to every field of a table under a new ordinal.
+ * @details A document that has no term in any field takes an ordinal all the same, so that the
+ * ordinals of a table always match its `ids`.
+ * @param table The table.
+ * @param id The `_id` of the document.
+ * @param doc The document.
+ */
+void TextIndex::add_document(Table &table, const std::string &id,
+                             const aevum::bson::doc::Document &doc) {
+    auto ordinal = static_cast<uint32_t>(table.ids.size());
+    table.ids.push_back(id);
+    table.ordinals[id] = ordinal;
+    for (auto &[name, field] : table.fields) {
+        std::vector<std::string> terms = field_terms(doc, name);
+        field.lengths.push_back(static_cast<uint32_t>(terms.size()));
+        if (terms.empty()) continue;
+        field.total_length += terms.size();
+        ++field.documents;
+        std::sort(terms.begin(), terms.end());
+        for (size_t i = 0; i < terms.size();) {
+            size_t end = i + 1;
+            while (end < terms.size() && terms[end] == terms[i]) ++end;
+            field.terms[terms[i]].append(ordinal, static_cast<uint32_t>(end - i));
+            i = end;
+        }
+    }
+}
+
+/**
+ * @brief Rewrites the posting lists of a table without its removed documents.
+ * @param table The table.
+ */
+void TextIndex::compact(Table &table) {
+    constexpr uint32_t REMOVED = UINT32_MAX;
+    std::vector<uint32_t> renumbered(table.ids.size(), REMOVED);
+    std::vector<std::string> ids;
+    ids.reserve(table.ids.size() - table.removed);
+    for (uint32_t ordinal = 0; ordinal < table.ids.size(); ++ordinal) {
+        if (table.ids[ordinal].empty()) continue;
+        renumbered[ordinal] = static_cast<uint32_t>(ids.size());
+        table.ordinals[table.ids[ordinal]] = renumbered[ordinal];
+        ids.push_back(std::move(table.ids[ordinal]));
+    }
+
+    for (auto &[name, field] : table.fields) {
+        std::vector<uint32_t> lengths(ids.size(), 0);
+        for (uint32_t ordinal = 0; ordinal < renumbered.size(); ++ordinal) {
+            if (renumbered[ordinal] == REMOVED) continue;
+            lengths[renumbered[ordinal]] = field.lengths[ordinal];
+        }
+        for (auto it = field.terms.begin(); it != field.terms.end();) {
+            PostingList compacted;
+            for_each_posting(it->second, [&](uint32_t ordinal, uint32_t frequency) {
+                uint32_t target = renumbered[ordinal];
+                if (target != REMOVED && lengths[target] != 0) compacted.append(target, frequency);
+            });
+            if (compacted.count == 0) {
+                it = field.terms.erase(it);
+                continue;
+            }
+            compacted.bytes.shrink_to_fit();
+            it->second = std::move(compacted);
+            ++it;
+        }
+        field.lengths = std::move(lengths);
+    }
+    table.ids = std::move(ids);
+    table.removed = 0;
+}
+
+}  // namespace aevum::db::index
@@ -0,0 +1,213 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file text_index.hpp
+ * @brief Declares the `TextIndex`, which backs `TEXT` secondary indexes with inverted posting
+ * lists ranked by BM25.
+ * @details Searching for words through `$regex` runs the expression on every document. A text
+ * index instead tokenizes its field once, when a document is indexed, and keeps for every term
+ * the list of documents holding it with the number of occurrences. A `$text` query then reads
+ * only the lists of its own terms and ranks the documents they name by their BM25 score, so its
+ * cost grows with the number of matches rather than with the size of the collection.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/util/hash/string_hash.hpp"
+
+namespace aevum::db::index {
+
+/**
+ * @struct TextHit
+ * @brief A document found by a text search.
+ */
+struct TextHit {
+    /// The `_id` of the document, as produced by `PrimaryIndexer::to_id_key`.
+    std::string id;
+    /// The BM25 score of the document, summed over the text indexes of the collection.
+    double score = 0.0;
+};
+
+/**
+ * @class TextIndex
+ * @brief Holds the text indexes of every collection.
+ *
+ * @details Each collection with at least one text index has a table in which every indexed
+ * document is numbered with an ordinal, in the order it was indexed. A field's value is split
+ * into terms by `tokenize`; a string is tokenized whole, and an array contributes each of its
+ * strings. Each term has a posting list of `(ordinal, term frequency)` pairs in ascending ordinal
+ * order, stored as the gap to the previous ordinal and the frequency, both as LEB128 varints, so
+ * that a posting usually takes two bytes.
+ *
+ * Since ordinals only grow, a re-indexed document is given a new ordinal and appended to the
+ * end of its lists. A removed document is only marked as such and skipped by searches; once
+ * half of the ordinals, and at least 1024, are removed, the lists are rewritten without them and
+ * the ordinals renumbered. The document frequency of a term, which BM25 weighs it by, counts the removed
+ * documents still in its list until then.
+ *
+ * The `TextIndex` has no lock of its own: the `IndexManager` serializes writers with its
+ * reader-writer lock and lets readers search concurrently.
+ */
+class TextIndex {
+  public:
+    /// A shared handle to an immutable document, as held by the primary index.
+    using DocumentPtr = std::shared_ptr<const aevum::bson::doc::Document>;
+    /// Documents with their `_id`s.
+    using DocumentHandles = std::vector<std::pair<std::string, DocumentPtr>>;
+
+    /**
+     * @struct PostingList
+     * @brief The documents holding a term, delta- and varint-encoded.
+     */
+    struct PostingList {
+        /// The encoded `(ordinal gap, term frequency)` pairs.
+        std::string bytes;
+        /// The ordinal of the last posting.
+        uint32_t last = 0;
+        /// The number of postings, removed documents included.
+        uint32_t count = 0;
+
+        /**
+         * @brief Appends a posting.
+         * @param ordinal The ordinal of the document; greater than that of every posting.
+         * @param frequency The number of occurrences of the term in the document.
+         */
+        void append(uint32_t ordinal, uint32_t frequency);
+    };
+
+    /**
+     * @struct Field
+     * @brief The inverted index of one field.
+     */
+    struct Field {
+        /// The posting list of every term.
+        std::unordered_map<std::string, PostingList, aevum::util::hash::StringHash> terms;
+        /// The number of terms of each document in the field, 0 for none or a removed document.
+        std::vector<uint32_t> lengths;
+        /// The sum of `lengths`.
+        uint64_t total_length = 0;
+        /// The number of documents with at least one term in the field.
+        uint32_t documents = 0;
+    };
+
+    /**
+     * @struct Table
+     * @brief The text indexes of one collection, as built by `build_table`.
+     */
+    struct Table {
+        /// The `_id` of each ordinal; empty for a removed document.
+        std::vector<std::string> ids;
+        /// The ordinal of each indexed `_id`.
+        std::unordered_map<std::string, uint32_t, aevum::util::hash::StringHash> ordinals;
+        /// The indexed fields and their inverted indexes.
+        std::unordered_map<std::string, Field> fields;
+        /// The number of removed ordinals.
+        size_t removed = 0;
+    };
+
+    /**
+     * @brief Splits a text into the terms it is indexed and searched under.
+     * @details The text is lowercased with `util::string::to_lower`; every ASCII character that
+     * is neither a letter nor a digit then separates terms, and the text is split on those
+     * separators with `util::string::split`. Bytes outside ASCII are kept, so a UTF-8 word stays
+     * one term, though only its ASCII letters are folded. No stemming is applied.
+     * @param text The text.
+     * @return The terms, in order of appearance, with repetitions.
+     */
+    [[nodiscard]] static std::vector<std::string> tokenize(std::string_view text);
+
+    /**
+     * @brief Builds the table of a collection.
+     * @details This does not touch the index, so a table can be built without excluding readers
+     * and then swapped in with `install_table`.
+     * @param fields The fields with a text index.
+     * @param documents Every document of the collection.
+     * @return The table, with the documents numbered in the order of `documents`.
+     */
+    [[nodiscard]] static Table build_table(const std::vector<std::string> &fields,
+                                           const DocumentHandles &documents);
+
+    /**
+     * @brief Replaces the table of a collection.
+     * @param coll The name of the collection.
+     * @param table The new table; one without fields drops the collection's table.
+     */
+    void install_table(const std::string &coll, Table table);
+
+    /**
+     * @brief Checks whether a collection has a table.
+     * @param coll The name of the collection.
+     * @return `true` if at least one field of the collection has a text index.
+     */
+    [[nodiscard]] bool has_table(const std::string &coll) const;
+
+    /**
+     * @brief Estimates the memory held by the table of a collection.
+     * @param coll The name of the collection.
+     * @return The bytes of its `_id`s, terms, and posting lists, or 0 if it has no table.
+     */
+    [[nodiscard]] size_t memory_bytes(const std::string &coll) const;
+
+    /**
+     * @brief Indexes a document of a collection, replacing its previous image if any.
+     * @details Has no effect if the collection has no table.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     * @param doc The document.
+     */
+    void upsert(const std::string &coll, const std::string &id,
+                const aevum::bson::doc::Document &doc);
+
+    /**
+     * @brief Removes a document from a collection's table.
+     * @param coll The name of the collection.
+     * @param id The `_id` of the document.
+     */
+    void remove(const std::string &coll, const std::string &id);
+
+    /**
+     * @brief Finds the documents holding any term of a search text, best first.
+     * @details Each document holding at least one of the text's distinct terms is scored with
+     * BM25 (`k1` = 1.2, `b` = 0.75) in every text index of the collection, and the scores are
+     * summed. Ties are broken by indexing order.
+     * @param coll The name of the collection.
+     * @param text The search text, tokenized as the indexed values are.
+     * @param wanted The number of best documents to return, or 0 for all of them.
+     * @return The documents, in descending order of score.
+     */
+    [[nodiscard]] std::vector<TextHit> search(const std::string &coll, std::string_view text,
+                                              size_t wanted) const;
+
+  private:
+    /**
+     * @brief Adds a document to every field of a table under a new ordinal.
+     * @param table The table.
+     * @param id The `_id` of the document.
+     * @param doc The document.
+     */
+    static void add_document(Table &table, const std::string &id,
+                             const aevum::bson::doc::Document &doc);
+
+    /**
+     * @brief Rewrites the posting lists of a table without its removed documents.
+     * @details The remaining documents are renumbered densely, in their previous order, so
+     * every list stays in ascending ordinal order.
+     * @param table The table.
+     */
+    static void compact(Table &table);
+
+    /// The table of every collection that has one.
+    std::unordered_map<std::string, Table> tables_;
+};
+
+}  // namespace aevum::db::index
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file cursor.cpp
+ * @brief Implements the `CursorManager`, the table of open server-side cursors.
+ */
+#include "aevum/db/query/cursor.hpp"
+
+#include "aevum/util/log/logger.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
+
+namespace aevum::db::query {
+
+namespace {
+
+/// The minimum interval between two sweeps for idle cursors.
+constexpr int64_t CURSOR_SWEEP_INTERVAL_MS = 1000;
+
+/**
+ * @brief Returns the current time of the steady clock in milliseconds, from the `CoarseClock`.
+ * @return The milliseconds since the clock's epoch.
+ */
+int64_t cursor_clock_ms() { return aevum::util::time::CoarseClock::steady_ms(); }
+
+}  // namespace
+
+/**
+ * @brief Constructs an empty manager.
+ * @param timeout_sec The idle time after which a cursor is discarded, or 0 for none.
+ */
+CursorManager::CursorManager(int64_t timeout_sec)
+    : timeout_ms_(timeout_sec > 0 ? timeout_sec * 1000 : 0) {}
+
+/**
+ * @brief Registers a new cursor under the next free id.
+ * @param cursor The cursor.
+ * @return The id assigned to the cursor.
+ */
+int64_t CursorManager::add(std::unique_ptr<Cursor> cursor) {
+    cursor->last_used_ms = cursor_clock_ms();
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t id = next_id_++;
+    cursors_.emplace(id, std::move(cursor));
+    return id;
+}
+
+/**
+ * @brief Takes a cursor out of the manager.
+ * @details A cursor presented with another API key stays where it is, so that guessing an id
+ * does not allow a client to read or disturb another client's results.
+ * @param id The id of the cursor.
+ * @param owner The API key presented with the request.
+ * @return The cursor, or null.
+ */
+std::unique_ptr<Cursor> CursorManager::checkout(int64_t id, std::string_view owner) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cursors_.find(id);
+    if (it == cursors_.end() || it->second->owner != owner) return nullptr;
+    std::unique_ptr<Cursor> cursor = std::move(it->second);
+    cursors_.erase(it);
+    return cursor;
+}
+
+/**
+ * @brief Returns a cursor taken out with `checkout`, unless it is exhausted.
+ * @param id The id of the cursor.
+ * @param cursor The cursor.
+ * @return `id`, or 0 if the cursor was exhausted.
+ */
+int64_t CursorManager::checkin(int64_t id, std::unique_ptr<Cursor> cursor) {
+    if (!cursor || cursor->exhausted()) return 0;
+    cursor->last_used_ms = cursor_clock_ms();
+    std::lock_guard<std::mutex> lock(mutex_);
+    cursors_.emplace(id, std::move(cursor));
+    return id;
+}
+
+/**
+ * @brief Discards a cursor.
+ * @param id The id of the cursor.
+ * @param owner The API key presented with the request.
+ * @return `true` if the cursor was discarded.
+ */
+bool CursorManager::kill(int64_t id, std::string_view owner) {
+    std::unique_ptr<Cursor> cursor = checkout(id, owner);
+    return cursor != nullptr;
+}
+
+/**
+ * @brief Discards the cursors that have been idle for longer than the timeout.
+ * @details The cursors are destroyed after the mutex is released, since freeing a large `_id`
+ * list takes a while.
+ * @return The number of cursors discarded.
+ */
+size_t CursorManager::expire_idle() {
+    if (timeout_ms_ == 0) return 0;
+    int64_t now_ms = cursor_clock_ms();
+    std::vector<std::unique_ptr<Cursor>> expired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (now_ms - last_sweep_ms_ < CURSOR_SWEEP_INTERVAL_MS) return 0;
+        last_sweep_ms_ = now_ms;
+        for (auto it = cursors_.begin(); it != cursors_.end();) {
+            if (now_ms - it->second->last_used_ms > timeout_ms_) {
+                expired.push_back(std::move(it->second));
+                it = cursors_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (!expired.empty()) {
+        AEVUM_LOG_INFO("Cursors: Discarded " + std::to_string(expired.size()) + " idle cursor(s).");
+    }
+    return expired.size();
+}
+
+/**
+ * @brief Returns the number of cursors held by the manager.
+ * @return The number of idle cursors.
+ */
+size_t CursorManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cursors_.size();
+}
+
+}  // namespace aevum::db::query
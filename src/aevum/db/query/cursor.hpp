@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file cursor.hpp
+ * @brief Declares the server-side cursors that return the results of a query in batches.
+ * @details A `find` that asks for a batch size opens a cursor instead of returning its whole
+ * result set. The cursor remembers the `_id`s still to be returned, not the documents, so an
+ * open cursor costs one string per remaining result; each batch is resolved through the primary
+ * index, matched, and projected only when the client asks for it. Open cursors are kept by a
+ * `CursorManager`, which hands them out by id and discards those left idle for too long.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+namespace aevum::db::query {
+
+/// The number of documents returned per batch when a request does not specify it.
+constexpr size_t DEFAULT_CURSOR_BATCH_SIZE = 1000;
+
+/**
+ * @struct Cursor
+ * @brief The position of a client in the result set of a query.
+ */
+struct Cursor {
+    /// The collection the query runs on.
+    std::string collection;
+    /// The API key that opened the cursor; only the same key may read or kill it.
+    std::string owner;
+    /// The filter, run on each batch of candidates unless `matched` is set.
+    std::string query_json;
+    /// The projection applied to every returned document.
+    aevum::bson::doc::Document projection;
+    /// The `_id`s of the candidates, or of the results if `matched` is set, in result order.
+    std::vector<std::string> ids;
+    /// The index in `ids` of the next candidate to examine.
+    size_t position{0};
+    /// `true` if `ids` already holds the filtered, sorted, and paginated results.
+    bool matched{false};
+    /// The number of matches still to be skipped. Only used if `matched` is not set.
+    size_t skip{0};
+    /// The number of results still to be returned, or `SIZE_MAX` for no limit.
+    size_t remaining{SIZE_MAX};
+    /// The steady time, in milliseconds, at which the cursor was last returned to its manager.
+    int64_t last_used_ms{0};
+
+    /**
+     * @brief Reports whether the cursor has nothing more to return.
+     * @return `true` once every candidate has been examined or the limit has been reached.
+     */
+    [[nodiscard]] bool exhausted() const noexcept {
+        return position >= ids.size() || remaining == 0;
+    }
+};
+
+/**
+ * @class CursorManager
+ * @brief Keeps the open cursors of the server, by id.
+ *
+ * @details A cursor is taken out of the manager by `checkout` for the duration of a batch and put
+ * back by `checkin`, so that two requests can never advance the same cursor at once; a cursor
+ * that is checked out is reported as not found. Cursors idle for longer than the timeout are
+ * discarded by `expire_idle`, which the `Core` calls on every cursor operation. The class is
+ * thread-safe.
+ */
+class CursorManager {
+  public:
+    /**
+     * @brief Constructs an empty manager.
+     * @param timeout_sec The idle time after which a cursor is discarded, or 0 to keep cursors
+     * until they are exhausted or killed.
+     */
+    explicit CursorManager(int64_t timeout_sec);
+
+    /**
+     * @brief Registers a new cursor.
+     * @param cursor The cursor, which must not be exhausted.
+     * @return The id assigned to the cursor, never 0.
+     */
+    [[nodiscard]] int64_t add(std::unique_ptr<Cursor> cursor);
+
+    /**
+     * @brief Takes a cursor out of the manager.
+     * @param id The id of the cursor.
+     * @param owner The API key presented with the request.
+     * @return The cursor, or null if no idle cursor with this id belongs to `owner`.
+     */
+    [[nodiscard]] std::unique_ptr<Cursor> checkout(int64_t id, std::string_view owner);
+
+    /**
+     * @brief Returns a cursor taken out with `checkout`, unless it is exhausted.
+     * @param id The id of the cursor.
+     * @param cursor The cursor.
+     * @return `id` if the cursor was put back, or 0 if it was exhausted and has been discarded.
+     */
+    int64_t checkin(int64_t id, std::unique_ptr<Cursor> cursor);
+
+    /**
+     * @brief Discards a cursor.
+     * @param id The id of the cursor.
+     * @param owner The API key presented with the request.
+     * @return `true` if an idle cursor with this id belonged to `owner` and was discarded.
+     */
+    bool kill(int64_t id, std::string_view owner);
+
+    /**
+     * @brief Discards the cursors that have been idle for longer than the timeout.
+     * @details The table is swept at most once per second, so the call is cheap when made on every
+     * cursor operation.
+     * @return The number of cursors discarded.
+     */
+    size_t expire_idle();
+
+    /**
+     * @brief Returns the number of cursors held by the manager.
+     * @return The number of idle cursors; cursors that are checked out are not counted.
+     */
+    [[nodiscard]] size_t size() const;
+
+  private:
+    /// The idle time after which a cursor is discarded, in milliseconds, or 0 for none.
+    int64_t timeout_ms_;
+    /// Guards all members below.
+    mutable std::mutex mutex_;
+    /// The idle cursors, by id.
+    std::unordered_map<int64_t, std::unique_ptr<Cursor>> cursors_;
+    /// The id assigned to the next cursor.
+    int64_t next_id_{1};
+    /// The steady time, in milliseconds, of the last sweep.
+    int64_t last_sweep_ms_{0};
+};
+
+}  // namespace aevum::db::query
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file pipeline.cpp
+ * @brief Implements the split of an aggregation pipeline at its leading `$match` stage.
+ * @details The pipeline is read with simdjson, like the request it arrived in, and its parts are
+ * re-serialized minified, so the `$match` query reaches the planner exactly as a `find` query
+ * would.
+ */
+#include "aevum/db/query/pipeline.hpp"
+
+#include <simdjson.h>
+
+namespace aevum::db::query {
+
+/**
+ * @brief Splits the leading `$match` stage off an aggregation pipeline.
+ * @details The first stage is taken off only if it is an object whose single field is `$match`
+ * with an object value. Anything else, including a malformed `$match`, stays in the remaining
+ * stages for the executor to accept or reject.
+ * @param pipeline_json The pipeline, as a JSON array of stages.
+ * @param out Receives the two parts.
+ * @return `InvalidArgument` if the pipeline is not a JSON array.
+ */
+aevum::util::Status split_pipeline(std::string_view pipeline_json, SplitPipeline &out) {
+    simdjson::dom::parser parser;
+    simdjson::dom::element root;
+    simdjson::dom::array stages;
+    if (parser.parse(pipeline_json.data(), pipeline_json.size()).get(root) != simdjson::SUCCESS ||
+        root.get_array().get(stages) != simdjson::SUCCESS) {
+        return aevum::util::Status::InvalidArgument("'pipeline' must be an array of stages");
+    }
+
+    out = SplitPipeline{};
+    std::string rest = "[";
+    bool first = true;
+    for (simdjson::dom::element stage : stages) {
+        simdjson::dom::object object;
+        simdjson::dom::element query;
+        if (first && stage.get_object().get(object) == simdjson::SUCCESS && object.size() == 1 &&
+            object["$match"].get(query) == simdjson::SUCCESS && query.is_object()) {
+            out.match_json = simdjson::to_string(query);
+            first = false;
+            continue;
+        }
+        first = false;
+        if (rest.size() > 1) rest += ",";
+        rest += simdjson::to_string(stage);
+    }
+    rest += "]";
+    out.rest_json = std::move(rest);
+    return aevum::util::Status::OK();
+}
+
+}  // namespace aevum::db::query
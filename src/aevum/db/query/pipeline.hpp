@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file pipeline.hpp
+ * @brief Declares the split of an aggregation pipeline into the part the query planner serves
+ * and the part the Rust pipeline executor runs.
+ * @details A pipeline that starts with `$match` is the most common shape of a rollup, and that
+ * stage is an ordinary query: the planner can answer it from the indexes and the matcher can
+ * filter the candidates before a single document is lent to Rust. Only the stages after it are
+ * handed to `rust_aggregate_bson`, which sees the matches as its input.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::query {
+
+/**
+ * @struct SplitPipeline
+ * @brief An aggregation pipeline with its leading `$match` stage taken off.
+ */
+struct SplitPipeline {
+    /// The query of the leading `$match` stage, or `{}` if the pipeline does not start with one.
+    std::string match_json = "{}";
+    /// The JSON array of the remaining stages.
+    std::string rest_json = "[]";
+};
+
+/**
+ * @brief Splits the leading `$match` stage off an aggregation pipeline.
+ * @details Only the shape needed for the split is checked here; the stages themselves are
+ * validated by the Rust executor, which reports the first invalid one.
+ * @param pipeline_json The pipeline, as a JSON array of stages.
+ * @param out Receives the two parts.
+ * @return `InvalidArgument` if the pipeline is not a JSON array.
+ */
+[[nodiscard]] aevum::util::Status split_pipeline(std::string_view pipeline_json,
+                                                 SplitPipeline &out);
+
+}  // namespace aevum::db::query
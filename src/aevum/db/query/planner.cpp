@@ -0,0 +1,932 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file planner.cpp
+ * @brief Implements the query planner that selects an access path for a query document.
+ * @details The equality semantics recognized here follow `matches_query` in
+ * `ffi/src/query/matcher.rs`: a nested object is an operator map only if its first key starts with
+ * `$`, and any other value is compared for exact equality. The range semantics follow
+ * `evaluate_operator` in `ffi/src/query/operators.rs`: `$gt`, `$gte`, `$lt`, and `$lte` compare
+ * numbers with numbers and strings with strings, and are false for any other pairing. Every index
+ * range built here is therefore confined to the rank of its operand.
+ */
+#include "aevum/db/query/planner.hpp"
+
+#include <algorithm>
+#include <bson/bson.h>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/db/index/secondary_indexer.hpp"
+#include "aevum/db/query/projection.hpp"
+
+namespace aevum::db::query {
+
+namespace {
+
+using aevum::db::index::ColumnPredicate;
+using aevum::db::index::ColumnTest;
+using aevum::db::index::IndexFilter;
+using aevum::db::index::IndexFilterPtr;
+using aevum::db::index::IndexKey;
+using aevum::db::index::IndexType;
+using aevum::db::index::KeyRange;
+using aevum::db::index::KeyRank;
+
+/**
+ * @brief Locates the value a top-level predicate requires its field to be equal to.
+ * @details Accepts a direct value (`{"f": v}`) or an operator map containing `$eq`
+ * (`{"f": {"$eq": v, ...}}`). Any other operator in the map is left to the matcher.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param value Receives an iterator positioned on the equality value.
+ * @return `true` if the predicate implies an equality, `false` otherwise.
+ */
+bool find_equality_value(const bson_iter_t &predicate, bson_iter_t &value) {
+    if (!BSON_ITER_HOLDS_DOCUMENT(&predicate)) {
+        value = predicate;
+        return true;
+    }
+
+    bson_iter_t child;
+    if (!bson_iter_recurse(&predicate, &child) || !bson_iter_next(&child) ||
+        bson_iter_key(&child)[0] != '$') {
+        // A plain sub-document is compared by deep equality, which no index key can represent.
+        return false;
+    }
+    do {
+        if (std::string_view(bson_iter_key(&child)) == "$eq") {
+            value = child;
+            return !BSON_ITER_HOLDS_DOCUMENT(&value);
+        }
+    } while (bson_iter_next(&child));
+    return false;
+}
+
+/**
+ * @brief Checks whether an equality value can be looked up in a secondary index.
+ * @param value An iterator positioned on the equality value.
+ * @return `true` for strings, 32/64-bit integers, and booleans.
+ */
+bool is_indexable(const bson_iter_t &value) {
+    return BSON_ITER_HOLDS_UTF8(&value) || BSON_ITER_HOLDS_INT32(&value) ||
+           BSON_ITER_HOLDS_INT64(&value) || BSON_ITER_HOLDS_BOOL(&value);
+}
+
+/**
+ * @brief Checks whether a key denotes a scalar that an ordered index can match by equality.
+ * @details Arrays and objects are excluded: they all share one key within their rank, so a lookup
+ * would degenerate into a scan of every array or object.
+ * @param key The key of the equality value.
+ * @return `true` for null, boolean, numeric, and string keys.
+ */
+bool is_scalar_key(const IndexKey &key) {
+    return key.rank <= KeyRank::STRING;
+}
+
+/**
+ * @brief Checks whether an equality on an ordered index selects exactly the keys it matches.
+ * @details Strings and booleans have one key per value. Numbers do not: the matcher distinguishes
+ * `1` from `1.0`, which share a key, and `null` also keys every missing field.
+ * @param key The key of the equality value.
+ * @return `true` for string and boolean keys.
+ */
+bool is_exact_equality_key(const IndexKey &key) {
+    return key.rank == KeyRank::STRING || key.rank == KeyRank::BOOL;
+}
+
+/**
+ * @brief Locates the array operand of an operator such as `$all` or `$in` in a top-level predicate.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param op The operator.
+ * @param elements Receives an iterator over the elements of the operand.
+ * @return `true` if the predicate is an operator map whose `op` operand is an array.
+ */
+bool find_array_operand(const bson_iter_t &predicate, std::string_view op,
+                        bson_iter_t &elements) {
+    bson_iter_t child;
+    if (!BSON_ITER_HOLDS_DOCUMENT(&predicate) || !bson_iter_recurse(&predicate, &child) ||
+        !bson_iter_next(&child) || bson_iter_key(&child)[0] != '$') {
+        return false;
+    }
+    do {
+        if (std::string_view(bson_iter_key(&child)) == op) {
+            return BSON_ITER_HOLDS_ARRAY(&child) && bson_iter_recurse(&child, &elements);
+        }
+    } while (bson_iter_next(&child));
+    return false;
+}
+
+/**
+ * @brief Turns one element of an `$all` or `$in` operand into an equality predicate.
+ * @details The predicate is never exact: on an ordered index `1` and `1.0` share a key, and on
+ * a multikey index an array holding the element is filed under its key as well.
+ * @param element An iterator positioned on the element.
+ * @param field The indexed field.
+ * @param type The type of the index on `field`: `HASH` or `ORDERED`.
+ * @return The predicate, or `std::nullopt` if the index cannot look the element up.
+ */
+std::optional<IndexPredicate> make_point_predicate(const bson_iter_t &element,
+                                                   std::string_view field, IndexType type) {
+    if (type == IndexType::ORDERED) {
+        IndexKey key = aevum::db::index::make_index_key(element);
+        if (!is_scalar_key(key)) return std::nullopt;
+        IndexPredicate probe{std::string(field), IndexType::ORDERED, {}, {}, false, {}};
+        probe.range.tighten_lower(key, true);
+        probe.range.tighten_upper(key, true);
+        return probe;
+    }
+    if (!is_indexable(element)) return std::nullopt;
+    std::string key = aevum::db::index::SecondaryIndexer::to_index_key(element);
+    if (key.empty()) return std::nullopt;
+    return IndexPredicate{std::string(field), IndexType::HASH, std::move(key), {}, false, {}};
+}
+
+/**
+ * @brief Turns the elements of an `$all` operand into predicates on a multikey index.
+ * @details A document matching `$all` holds every element in its array, and a single-field index
+ * files the document under each of them, so every element is a probe of its own. The probes are
+ * never exact: a scalar field equal to an element is filed under the same key but does not match.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param field The indexed field.
+ * @param type The type of the index on `field`: `HASH` or `ORDERED`.
+ * @param predicates Receives one predicate per element the index can look up.
+ */
+void add_all_predicates(const bson_iter_t &predicate, std::string_view field, IndexType type,
+                        std::vector<IndexPredicate> &predicates) {
+    bson_iter_t element;
+    if (!find_array_operand(predicate, "$all", element)) return;
+    while (bson_iter_next(&element)) {
+        if (auto probe = make_point_predicate(element, field, type)) {
+            predicates.push_back(std::move(*probe));
+        }
+    }
+}
+
+/**
+ * @brief Turns an `$in` operand into a union of equality predicates on an index.
+ * @details A document matching `$in` equals one of the elements and is filed under its key, so
+ * the union of the elements' postings holds every match. If the index cannot look up even one
+ * element, the union would miss its matches, and no predicate is produced.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param field The indexed field.
+ * @param type The type of the index on `field`: `HASH` or `ORDERED`.
+ * @param predicates Receives the union, if the operand is a non-empty array the index can serve.
+ */
+void add_in_predicate(const bson_iter_t &predicate, std::string_view field, IndexType type,
+                      std::vector<IndexPredicate> &predicates) {
+    bson_iter_t element;
+    if (!find_array_operand(predicate, "$in", element)) return;
+    IndexPredicate in{std::string(field), type, {}, {}, false, {}};
+    while (bson_iter_next(&element)) {
+        auto probe = make_point_predicate(element, field, type);
+        if (!probe) return;
+        in.any_of.push_back(std::move(*probe));
+    }
+    if (!in.any_of.empty()) predicates.push_back(std::move(in));
+}
+
+/**
+ * @brief Collects the `_id` keys of an `$in` operand on `_id`.
+ * @param predicate An iterator positioned on the `_id` element of the query.
+ * @param ids Receives the keys, as produced by `PrimaryIndexer::to_id_key`, sorted and without
+ *        duplicates.
+ * @return `true` if the operand is a non-empty array of strings and integers.
+ */
+bool collect_in_ids(const bson_iter_t &predicate, std::vector<std::string> &ids) {
+    bson_iter_t element;
+    if (!find_array_operand(predicate, "$in", element)) return false;
+    std::vector<std::string> found;
+    while (bson_iter_next(&element)) {
+        std::string id = aevum::db::index::PrimaryIndexer::to_id_key(element);
+        if (id.empty() && !BSON_ITER_HOLDS_UTF8(&element)) return false;
+        found.push_back(std::move(id));
+    }
+    if (found.empty()) return false;
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    ids = std::move(found);
+    return true;
+}
+
+/**
+ * @brief Narrows an index probe with the compound hash indexes the equalities of a query fit.
+ * @details A compound index keeps an entry for every prefix of its fields, so the longest prefix
+ * whose fields all carry an equality is looked up as one key.
+ * @param compound The names of the collection's compound hash indexes.
+ * @param equalities The index key of the equality on each field of the query that has one.
+ * @param predicates Receives one predicate per index with at least its first field pinned.
+ */
+void add_compound_predicates(const std::vector<std::string> &compound,
+                             const std::unordered_map<std::string, std::string> &equalities,
+                             std::vector<IndexPredicate> &predicates) {
+    for (const auto &name : compound) {
+        std::vector<std::string> parts;
+        for (const auto &field : aevum::db::index::split_index_fields(name)) {
+            auto it = equalities.find(field);
+            if (it == equalities.end()) break;
+            parts.push_back(it->second);
+        }
+        if (parts.empty()) continue;
+        predicates.push_back({name, IndexType::HASH,
+                              aevum::db::index::SecondaryIndexer::join_compound_key(parts),
+                              {},
+                              false,
+                              {}});
+    }
+}
+
+/**
+ * @brief Returns the smallest key of the rank following `rank`.
+ * @param rank A scalar rank.
+ * @return The exclusive upper bound of every key of `rank`.
+ */
+IndexKey next_rank_floor(KeyRank rank) {
+    return IndexKey::floor(static_cast<KeyRank>(static_cast<uint8_t>(rank) + 1));
+}
+
+/**
+ * @brief Checks whether every key of a range has a given rank.
+ * @param range A range whose lower bound has rank `rank`.
+ * @param rank A scalar rank.
+ * @return `true` if the range ends before the first key of the following rank.
+ */
+bool is_within_rank(const KeyRange &range, KeyRank rank) {
+    if (!range.upper) return false;
+    IndexKey ceiling = next_rank_floor(rank);
+    return *range.upper < ceiling || (!range.upper_inclusive && !(ceiling < *range.upper));
+}
+
+/**
+ * @brief Folds a top-level predicate on an ordered index into a key range.
+ * @details A direct value or `$eq` pins the range to a single key. Each range operator with a
+ * numeric or string operand narrows the range to that operand's rank and bound. Operators the
+ * index cannot express are ignored, which only widens the candidate set; the matcher re-checks
+ * every candidate.
+ *
+ * The range is exact when every key in it satisfies the predicate as the matcher evaluates it.
+ * That holds for string and boolean equalities and for every range operator, which the matcher
+ * applies to numbers and strings only, but not for numeric equalities: `1` and `1.0` share a key
+ * and yet differ to the matcher.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param range Receives the range of keys the field must lie in.
+ * @param exact Receives `true` if the range is exact.
+ * @return `true` if the predicate constrains the range at all, `false` otherwise.
+ */
+bool build_key_range(const bson_iter_t &predicate, KeyRange &range, bool &exact) {
+    exact = false;
+    if (!BSON_ITER_HOLDS_DOCUMENT(&predicate)) {
+        IndexKey key = aevum::db::index::make_index_key(predicate);
+        if (!is_scalar_key(key)) {
+            return false;
+        }
+        range.tighten_lower(key, true);
+        range.tighten_upper(key, true);
+        exact = is_exact_equality_key(key);
+        return true;
+    }
+
+    bson_iter_t child;
+    if (!bson_iter_recurse(&predicate, &child) || !bson_iter_next(&child) ||
+        bson_iter_key(&child)[0] != '$') {
+        return false;
+    }
+    bool constrained = false;
+    bool every_operator_exact = true;
+    do {
+        std::string_view op = bson_iter_key(&child);
+        IndexKey key = aevum::db::index::make_index_key(child);
+        if (op == "$eq") {
+            if (is_scalar_key(key)) {
+                range.tighten_lower(key, true);
+                range.tighten_upper(key, true);
+                constrained = true;
+            }
+            every_operator_exact = every_operator_exact && is_exact_equality_key(key);
+            continue;
+        }
+        if (key.rank != KeyRank::NUMBER && key.rank != KeyRank::STRING) {
+            every_operator_exact = false;
+            continue;
+        }
+        if (op == "$gt" || op == "$gte") {
+            range.tighten_lower(key, op == "$gte");
+            range.tighten_upper(next_rank_floor(key.rank), false);
+            constrained = true;
+        } else if (op == "$lt" || op == "$lte") {
+            range.tighten_lower(IndexKey::floor(key.rank), true);
+            range.tighten_upper(key, op == "$lte");
+            constrained = true;
+        } else {
+            every_operator_exact = false;
+        }
+    } while (bson_iter_next(&child));
+    exact = constrained && every_operator_exact;
+    return constrained;
+}
+
+/**
+ * @brief Checks whether a key range lies within another.
+ * @param inner The range that must be contained.
+ * @param outer The range that must contain it.
+ * @return `true` if every key of `inner` is a key of `outer`.
+ */
+bool range_within(const KeyRange &inner, const KeyRange &outer) {
+    if (inner.lower < outer.lower ||
+        (!(outer.lower < inner.lower) && inner.lower_inclusive && !outer.lower_inclusive)) {
+        return false;
+    }
+    if (!outer.upper) return true;
+    if (!inner.upper || *outer.upper < *inner.upper) return false;
+    return *inner.upper < *outer.upper || !inner.upper_inclusive || outer.upper_inclusive;
+}
+
+/**
+ * @brief Checks whether two query conditions are spelled alike.
+ * @details Scalars must have the same type and value; documents and arrays the same bytes. Any
+ * other value is conservatively taken to differ.
+ * @param a An iterator positioned on a condition.
+ * @param b An iterator positioned on another condition.
+ * @return `true` if the conditions are the same.
+ */
+bool same_condition(const bson_iter_t &a, const bson_iter_t &b) {
+    if (bson_iter_type(&a) != bson_iter_type(&b)) return false;
+    uint32_t a_length = 0;
+    uint32_t b_length = 0;
+    const uint8_t *a_data = nullptr;
+    const uint8_t *b_data = nullptr;
+    switch (bson_iter_type(&a)) {
+        case BSON_TYPE_DOCUMENT:
+            bson_iter_document(&a, &a_length, &a_data);
+            bson_iter_document(&b, &b_length, &b_data);
+            return a_length == b_length && std::memcmp(a_data, b_data, a_length) == 0;
+        case BSON_TYPE_ARRAY:
+            bson_iter_array(&a, &a_length, &a_data);
+            bson_iter_array(&b, &b_length, &b_data);
+            return a_length == b_length && std::memcmp(a_data, b_data, a_length) == 0;
+        case BSON_TYPE_UTF8: {
+            const char *a_string = bson_iter_utf8(&a, &a_length);
+            const char *b_string = bson_iter_utf8(&b, &b_length);
+            return a_length == b_length && std::memcmp(a_string, b_string, a_length) == 0;
+        }
+        case BSON_TYPE_INT32:
+            return bson_iter_int32(&a) == bson_iter_int32(&b);
+        case BSON_TYPE_INT64:
+            return bson_iter_int64(&a) == bson_iter_int64(&b);
+        case BSON_TYPE_DOUBLE:
+            return bson_iter_double(&a) == bson_iter_double(&b);
+        case BSON_TYPE_BOOL:
+            return bson_iter_bool(&a) == bson_iter_bool(&b);
+        case BSON_TYPE_NULL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Finds the last occurrence of a top-level key, the one the matcher sees.
+ * @param doc The document.
+ * @param key The key.
+ * @param found Receives an iterator positioned on the element.
+ * @return `true` if the key is present.
+ */
+bool find_last_key(const aevum::bson::doc::Document &doc, std::string_view key,
+                   bson_iter_t &found) {
+    bson_iter_t iter;
+    if (doc.empty() || !bson_iter_init(&iter, doc.get())) return false;
+    bool any = false;
+    while (bson_iter_next(&iter)) {
+        if (std::string_view(bson_iter_key(&iter), bson_iter_key_len(&iter)) == key) {
+            found = iter;
+            any = true;
+        }
+    }
+    return any;
+}
+
+/**
+ * @brief Checks whether a filtered index holds every document a query matches.
+ * @details A condition on a missing field is false, so a top-level condition on one of the fields
+ * of a sparse index, or on a path below one, implies that the document holds it. Each condition
+ * of a partial filter must be implied by the query's condition on the same key: either both are
+ * the same, or both fold into key ranges, the filter's exactly, and the query's lies within the
+ * filter's. Anything else is taken not to be implied, and the index is not used.
+ * @param query The parsed query document.
+ * @param filter The filter of the index.
+ * @return `true` if the index can serve the query.
+ */
+bool implies_filter(const aevum::bson::doc::Document &query, const IndexFilter &filter) {
+    bson_iter_t iter;
+    if (filter.options().sparse) {
+        bool holds_field = false;
+        if (!query.empty() && bson_iter_init(&iter, query.get())) {
+            while (!holds_field && bson_iter_next(&iter)) {
+                std::string_view key(bson_iter_key(&iter), bson_iter_key_len(&iter));
+                for (const auto &field : filter.fields()) {
+                    if (key.substr(0, field.size()) == field &&
+                        (key.size() == field.size() || key[field.size()] == '.')) {
+                        holds_field = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!holds_field) return false;
+    }
+
+    if (filter.filter().empty() || !bson_iter_init(&iter, filter.filter().get())) return true;
+    while (bson_iter_next(&iter)) {
+        bson_iter_t condition;
+        std::string_view key(bson_iter_key(&iter), bson_iter_key_len(&iter));
+        if (!find_last_key(query, key, condition)) return false;
+        if (same_condition(condition, iter)) continue;
+        KeyRange required;
+        KeyRange requested;
+        bool required_exact = false;
+        bool requested_exact = false;
+        if (!build_key_range(iter, required, required_exact) || !required_exact ||
+            !build_key_range(condition, requested, requested_exact) ||
+            !range_within(requested, required)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether an index can serve a query.
+ * @param filters The filters of the collection's sparse and partial indexes.
+ * @param name The name of the index.
+ * @param query The parsed query document.
+ * @return `true` if the index holds every document, or every one the query matches.
+ */
+bool index_serves(const std::unordered_map<std::string, IndexFilterPtr> &filters,
+                  const std::string &name, const aevum::bson::doc::Document &query) {
+    auto it = filters.find(name);
+    return it == filters.end() || implies_filter(query, *it->second);
+}
+
+/**
+ * @brief Reads a numeric operand as the `double` a columnar index compares it with.
+ * @param value An iterator positioned on the operand.
+ * @param number Receives the operand.
+ * @return `true` for 32/64-bit integers and finite doubles.
+ */
+bool read_column_number(const bson_iter_t &value, double &number) {
+    if (BSON_ITER_HOLDS_INT32(&value)) {
+        number = bson_iter_int32(&value);
+    } else if (BSON_ITER_HOLDS_INT64(&value)) {
+        number = static_cast<double>(bson_iter_int64(&value));
+    } else if (BSON_ITER_HOLDS_DOUBLE(&value)) {
+        number = bson_iter_double(&value);
+    } else {
+        return false;
+    }
+    return std::isfinite(number);
+}
+
+/**
+ * @brief Turns an equality value into a column predicate.
+ * @param field The field carrying a columnar index.
+ * @param value An iterator positioned on the equality value.
+ * @param predicates Receives the predicate, if the value is a number or a string.
+ */
+void add_column_equality(std::string_view field, const bson_iter_t &value,
+                         std::vector<ColumnPredicate> &predicates) {
+    double number;
+    if (read_column_number(value, number)) {
+        predicates.push_back({std::string(field), ColumnTest::NUMBER_RANGE,
+                              std::nextafter(number, -HUGE_VAL), std::nextafter(number, HUGE_VAL),
+                              {}});
+    } else if (BSON_ITER_HOLDS_UTF8(&value)) {
+        uint32_t length;
+        const char *text = bson_iter_utf8(&value, &length);
+        predicates.push_back({std::string(field), ColumnTest::STRING_EQUALS, -HUGE_VAL, HUGE_VAL,
+                              std::string(text, length)});
+    }
+}
+
+/**
+ * @brief Folds a top-level predicate on a columnar index into column predicates.
+ * @details A direct value or `$eq` that is a number or a string becomes an equality; the numeric
+ * range operators narrow a single interval. Every bound is widened by one ulp, since the Rust
+ * decoder may round a decimal literal differently from the parser that produced the BSON, and a
+ * column predicate must never be stricter than the matcher. Operators a column cannot express,
+ * including string ranges, are ignored.
+ * @param predicate An iterator positioned on a top-level query element.
+ * @param field The field carrying a columnar index.
+ * @param predicates Receives the column predicates.
+ */
+void build_column_predicates(const bson_iter_t &predicate, std::string_view field,
+                             std::vector<ColumnPredicate> &predicates) {
+    if (!BSON_ITER_HOLDS_DOCUMENT(&predicate)) {
+        add_column_equality(field, predicate, predicates);
+        return;
+    }
+
+    bson_iter_t child;
+    if (!bson_iter_recurse(&predicate, &child)) return;
+    // The map is only read as operators if every key is one, whatever order the matcher visits
+    // them in.
+    bson_iter_t probe = child;
+    bool any = false;
+    while (bson_iter_next(&probe)) {
+        if (bson_iter_key(&probe)[0] != '$') return;
+        any = true;
+    }
+    if (!any) return;
+
+    ColumnPredicate range{std::string(field), ColumnTest::NUMBER_RANGE, -HUGE_VAL, HUGE_VAL, {}};
+    bool constrained = false;
+    while (bson_iter_next(&child)) {
+        std::string_view op = bson_iter_key(&child);
+        if (op == "$eq") {
+            add_column_equality(field, child, predicates);
+            continue;
+        }
+        double number;
+        if (!read_column_number(child, number)) continue;
+        if (op == "$gt" || op == "$gte") {
+            range.lower = std::max(range.lower, std::nextafter(number, -HUGE_VAL));
+            constrained = true;
+        } else if (op == "$lt" || op == "$lte") {
+            range.upper = std::min(range.upper, std::nextafter(number, HUGE_VAL));
+            constrained = true;
+        }
+    }
+    if (constrained) predicates.push_back(std::move(range));
+}
+
+/**
+ * @brief Recognizes a sort that an ordered index can supply.
+ * @details Only a single-key sort with an integral direction of `1` or `-1` is eligible, which is
+ * exactly the form `compare_by_sort` in the Rust comparator honors. The comparator reads
+ * top-level fields, and a multikey index lists a document once per element, so neither an index
+ * on an embedded field nor a multikey one can supply the order, and neither can a sparse or
+ * partial index that may lack some of the query's matches.
+ * @param coll The name of the collection being queried.
+ * @param query The parsed query document.
+ * @param sort The parsed sort document.
+ * @param index_manager The index manager used to discover which fields are indexed.
+ * @param filters The filters of the collection's sparse and partial indexes.
+ * @param plan Receives `sort_field` and `sort_descending` if the sort is eligible.
+ */
+void plan_sort(std::string_view coll, const aevum::bson::doc::Document &query,
+               const aevum::bson::doc::Document &sort,
+               const aevum::db::index::IndexManager &index_manager,
+               const std::unordered_map<std::string, IndexFilterPtr> &filters, QueryPlan &plan) {
+    bson_iter_t iter;
+    if (sort.empty() || !bson_iter_init(&iter, sort.get()) || !bson_iter_next(&iter)) {
+        return;
+    }
+    std::string field = bson_iter_key(&iter);
+    int64_t direction = 0;
+    if (BSON_ITER_HOLDS_INT32(&iter)) {
+        direction = bson_iter_int32(&iter);
+    } else if (BSON_ITER_HOLDS_INT64(&iter)) {
+        direction = bson_iter_int64(&iter);
+    }
+    if ((direction != 1 && direction != -1) || bson_iter_next(&iter)) {
+        return;
+    }
+    if (field.find('.') == std::string::npos &&
+        index_manager.get_index_type(coll, field) == IndexType::ORDERED &&
+        !index_manager.is_multikey(coll, field) && index_serves(filters, field, query)) {
+        plan.sort_field = std::move(field);
+        plan.sort_descending = direction == -1;
+    }
+}
+
+/// The cost of matching a document, apart from its size.
+constexpr double MATCH_COST = 1.0;
+/// The cost of matching each byte of a document.
+constexpr double MATCH_COST_PER_BYTE = 1.0 / 256.0;
+/// The cost of reading an index entry of the most selective predicate.
+constexpr double ENTRY_COST = 0.1;
+/// The cost of reading an index entry of another predicate into the set it is intersected with.
+constexpr double INTERSECT_COST = 0.3;
+/// The cost of resolving a candidate `_id` through the primary index.
+constexpr double LOOKUP_COST = 0.5;
+
+/**
+ * @brief Estimates the number of index entries a predicate yields.
+ * @param coll The name of the collection being queried.
+ * @param predicate The predicate; an `$in` yields the sum of its elements.
+ * @param index_manager The index manager holding the statistics.
+ * @return The estimate.
+ */
+double estimate_predicate(std::string_view coll, const IndexPredicate &predicate,
+                          const aevum::db::index::IndexManager &index_manager) {
+    if (!predicate.any_of.empty()) {
+        double sum = 0.0;
+        for (const auto &point : predicate.any_of) {
+            sum += estimate_predicate(coll, point, index_manager);
+        }
+        return sum;
+    }
+    if (predicate.type == IndexType::ORDERED) {
+        return index_manager.estimate_range(coll, predicate.field, predicate.range);
+    }
+    return index_manager.estimate_equal(coll, predicate.field, predicate.key);
+}
+
+/**
+ * @brief Weighs an index probe against a narrower one and against a full scan.
+ * @details The predicates are sorted by their estimates. A probe over the first `n` of them reads
+ * the entries of the first, builds a set of those of each other one, and resolves and matches
+ * the candidates left, whose number assumes the predicates to be independent. `n` grows while
+ * that lowers the cost. A full scan matches every document.
+ * @param coll The name of the collection being queried.
+ * @param index_manager The index manager holding the statistics.
+ * @param keep_index `true` if the probe must not be replaced by a scan, because it can answer
+ *        the query from the index alone.
+ * @param plan The plan whose `predicates` are weighed; receives `dropped`, `collection`, and
+ *        `cost`, with `predicates` reduced to those taken, possibly none.
+ */
+void choose_predicates(std::string_view coll, const aevum::db::index::IndexManager &index_manager,
+                       bool keep_index, QueryPlan &plan) {
+    plan.collection = index_manager.collection_statistics(coll);
+    for (auto &predicate : plan.predicates) {
+        predicate.estimate = estimate_predicate(coll, predicate, index_manager);
+    }
+    std::stable_sort(plan.predicates.begin(), plan.predicates.end(),
+                     [](const IndexPredicate &a, const IndexPredicate &b) {
+                         return a.estimate < b.estimate;
+                     });
+
+    const auto documents = static_cast<double>(plan.collection.documents);
+    const double match = MATCH_COST + plan.collection.average_size() * MATCH_COST_PER_BYTE;
+    auto probe_cost = [&](size_t count) {
+        double cost = 0.0;
+        double candidates = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double entries = plan.predicates[i].estimate;
+            double yield = std::min(entries, documents);
+            if (i == 0) {
+                cost += entries * ENTRY_COST;
+                candidates = yield;
+            } else {
+                cost += entries * INTERSECT_COST;
+                candidates *= documents > 0.0 ? yield / documents : 0.0;
+            }
+        }
+        return cost + candidates * (LOOKUP_COST + match);
+    };
+
+    size_t taken = 1;
+    double cost = probe_cost(taken);
+    while (taken < plan.predicates.size()) {
+        double wider = probe_cost(taken + 1);
+        if (wider >= cost) break;
+        cost = wider;
+        ++taken;
+    }
+    double scan = documents * match;
+    if (!keep_index && scan < cost) {
+        taken = 0;
+        cost = scan;
+    }
+    plan.cost = cost;
+    plan.dropped.assign(std::make_move_iterator(plan.predicates.begin() + taken),
+                        std::make_move_iterator(plan.predicates.end()));
+    plan.predicates.resize(taken);
+}
+
+/**
+ * @brief Finds the search text of a query's `$text` operator.
+ * @details As with any other key, only the last `$text` of the query is seen by the matcher.
+ * @param query The parsed query document.
+ * @param text Receives the value of `$search`.
+ * @return `true` if the query has a top-level `$text` whose `$search` is a string.
+ */
+bool find_text_search(const aevum::bson::doc::Document &query, std::string &text) {
+    bson_iter_t iter;
+    if (query.empty() || !bson_iter_init(&iter, query.get())) return false;
+    bool found = false;
+    while (bson_iter_next(&iter)) {
+        if (std::strcmp(bson_iter_key(&iter), "$text") != 0) continue;
+        found = false;
+        bson_iter_t search;
+        if (BSON_ITER_HOLDS_DOCUMENT(&iter) && bson_iter_recurse(&iter, &search) &&
+            bson_iter_find(&search, "$search") && BSON_ITER_HOLDS_UTF8(&search)) {
+            uint32_t length = 0;
+            const char *value = bson_iter_utf8(&search, &length);
+            text.assign(value, length);
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Plans a `$text` search.
+ * @param query The parsed query document.
+ * @param text The search text.
+ * @return A `TEXT_SEARCH` plan whose `text_query` is `query` without `$text`.
+ */
+QueryPlan plan_text_search(const aevum::bson::doc::Document &query, std::string text) {
+    QueryPlan plan;
+    plan.type = PlanType::TEXT_SEARCH;
+    plan.text_search = std::move(text);
+    bson_t *residual = bson_new();
+    bson_copy_to_excluding_noinit(query.get(), residual, "$text", nullptr);
+    plan.text_query = aevum::bson::json::to_string(aevum::bson::doc::Document(residual));
+    return plan;
+}
+
+}  // namespace
+
+/**
+ * @brief Chooses an access path for a query document.
+ * @details Walks the top-level predicates once. A string `_id` equality, or an `$in` over string
+ * `_id`s, settles on a primary lookup; any other eligible predicate on an indexed field is
+ * collected for an index probe, or, on a columnar index, for a column scan. The equalities are also
+ * recorded, and afterwards matched against the compound hash indexes; the probe is then weighed by
+ * `choose_predicates`, which may narrow it or give it up for a scan. The sort is examined
+ * separately, since an ordered index can order a probe's candidates as well as drive a scan on its
+ * own. A sparse or partial index takes part only if the query implies its filter. A `$text` search
+ * on a collection with a text index is settled before any of this, as it outranks every other
+ * plan; on one without, `$text` is left to the matchers, which match no document with it.
+ * @param coll The name of the collection being queried.
+ * @param query The parsed query document.
+ * @param sort The parsed sort document (may be empty).
+ * @param index_manager The index manager used to discover which fields are indexed.
+ * @return The chosen `QueryPlan`.
+ */
+QueryPlan plan_query(std::string_view coll, const aevum::bson::doc::Document &query,
+                     const aevum::bson::doc::Document &sort,
+                     const aevum::db::index::IndexManager &index_manager) {
+    std::string text;
+    if (find_text_search(query, text) && index_manager.has_text_index(coll)) {
+        return plan_text_search(query, std::move(text));
+    }
+
+    QueryPlan plan;
+    std::unordered_map<std::string, IndexFilterPtr> filters = index_manager.index_filters(coll);
+    plan_sort(coll, query, sort, index_manager, filters, plan);
+    bson_iter_t iter;
+    if (query.empty() || !bson_iter_init(&iter, query.get())) {
+        if (!plan.sort_field.empty()) {
+            plan.type = PlanType::INDEX_SCAN;
+        }
+        return plan;
+    }
+
+    bool has_id = false;
+    bool id_is_direct = false;
+    size_t predicate_count = 0;
+    std::vector<std::string> compound = index_manager.get_compound_indexes(coll);
+    compound.erase(std::remove_if(compound.begin(), compound.end(),
+                                  [&](const std::string &name) {
+                                      return !index_serves(filters, name, query);
+                                  }),
+                   compound.end());
+    std::unordered_map<std::string, std::string> equalities;
+    while (bson_iter_next(&iter)) {
+        ++predicate_count;
+        std::string_view field = bson_iter_key(&iter);
+        if (field.empty() || field.front() == '$') {
+            continue;
+        }
+
+        if (!compound.empty()) {
+            // Only the last occurrence of a repeated field is seen by the matcher.
+            bson_iter_t value;
+            if (find_equality_value(iter, value) && is_indexable(value)) {
+                equalities[std::string(field)] =
+                    aevum::db::index::SecondaryIndexer::to_index_key(value);
+            } else {
+                equalities.erase(std::string(field));
+            }
+        }
+
+        if (field != "_id") {
+            std::optional<IndexType> type = index_manager.get_index_type(coll, field);
+            if (type && !filters.empty() && !index_serves(filters, std::string(field), query)) {
+                continue;
+            }
+            if (type == IndexType::TEXT) {
+                // A text index only serves `$text`; the field's own predicates go to the matcher.
+                continue;
+            }
+            if (type == IndexType::COLUMNAR) {
+                // Only the last occurrence of a repeated field is seen by the matcher.
+                auto &columns = plan.column_predicates;
+                columns.erase(std::remove_if(columns.begin(), columns.end(),
+                                             [&](const ColumnPredicate &column) {
+                                                 return column.field == field;
+                                             }),
+                              columns.end());
+                build_column_predicates(iter, field, columns);
+                continue;
+            }
+            if (type == IndexType::ORDERED) {
+                IndexPredicate predicate{
+                    std::string(field), IndexType::ORDERED, {}, {}, false, {}};
+                if (build_key_range(iter, predicate.range, predicate.exact)) {
+                    plan.predicates.push_back(std::move(predicate));
+                }
+                add_all_predicates(iter, field, IndexType::ORDERED, plan.predicates);
+                add_in_predicate(iter, field, IndexType::ORDERED, plan.predicates);
+                continue;
+            }
+            if (!type) {
+                continue;
+            }
+            add_all_predicates(iter, field, IndexType::HASH, plan.predicates);
+            add_in_predicate(iter, field, IndexType::HASH, plan.predicates);
+        }
+
+        bson_iter_t value;
+        if (!find_equality_value(iter, value)) {
+            if (field == "_id" && !has_id) {
+                has_id = collect_in_ids(iter, plan.ids);
+            }
+            continue;
+        }
+        if (field == "_id") {
+            std::string id = aevum::db::index::PrimaryIndexer::to_id_key(value);
+            if (!has_id && (!id.empty() || BSON_ITER_HOLDS_UTF8(&value))) {
+                plan.ids.assign(1, std::move(id));
+                has_id = true;
+                // An integer shares its key with its decimal string, so only a string `_id`
+                // identifies the document without the matcher checking the type.
+                id_is_direct = !BSON_ITER_HOLDS_DOCUMENT(&iter) && BSON_ITER_HOLDS_UTF8(&value);
+            }
+            continue;
+        }
+
+        if (!is_indexable(value)) {
+            continue;
+        }
+        std::string key = aevum::db::index::SecondaryIndexer::to_index_key(value);
+        if (!key.empty()) {
+            plan.predicates.push_back(
+                {std::string(field), IndexType::HASH, std::move(key), {}, false, {}});
+        }
+    }
+
+    add_compound_predicates(compound, equalities, plan.predicates);
+    if (!has_id && !plan.predicates.empty()) {
+        const IndexPredicate &only = plan.predicates.front();
+        bool index_only = predicate_count == 1 && plan.predicates.size() == 1 && only.exact &&
+                          !index_manager.is_multikey(coll, only.field);
+        choose_predicates(coll, index_manager, index_only, plan);
+    }
+
+    if (has_id || !plan.predicates.empty()) {
+        plan.column_predicates.clear();
+    }
+    if (has_id) {
+        plan.type = PlanType::PRIMARY_LOOKUP;
+        plan.predicates.clear();
+        // At most one candidate per listed `_id`; the matcher orders so few cheaply.
+        plan.sort_field.clear();
+        plan.sort_descending = false;
+        // Only a bare `{"_id": "..."}` is fully answered by the lookup; an operator map may carry
+        // further conditions on `_id` alongside `$eq`.
+        plan.covered = predicate_count == 1 && id_is_direct;
+    } else if (!plan.predicates.empty()) {
+        plan.type = PlanType::INDEX_PROBE;
+        const IndexPredicate &first = plan.predicates.front();
+        plan.index_only = predicate_count == 1 && plan.predicates.size() == 1 && first.exact &&
+                          !index_manager.is_multikey(coll, first.field);
+    } else if (!plan.column_predicates.empty()) {
+        plan.type = PlanType::COLUMN_SCAN;
+    } else if (!plan.sort_field.empty()) {
+        plan.type = PlanType::INDEX_SCAN;
+    }
+    return plan;
+}
+
+/**
+ * @brief Checks whether the entries of a plan's index alone can produce the projected results.
+ * @details `index_only` already guarantees a single exact predicate on an ordered index that is
+ * not multikey, so every entry in its range is a match, listed once.
+ * @param plan The plan chosen by `plan_query`.
+ * @param projection The parsed projection document.
+ * @return `true` if the query can be answered from index entries.
+ */
+bool index_covers_projection(const QueryPlan &plan, const aevum::bson::doc::Document &projection) {
+    if (plan.type != PlanType::INDEX_PROBE || !plan.index_only) return false;
+    const IndexPredicate &predicate = plan.predicates.front();
+    if (predicate.field.find('.') != std::string::npos) return false;
+    KeyRank rank = predicate.range.lower.rank;
+    if ((rank != KeyRank::STRING && rank != KeyRank::BOOL) ||
+        !is_within_rank(predicate.range, rank)) {
+        return false;
+    }
+    std::vector<std::string> fields;
+    bool keep_id = true;
+    return included_fields(projection, fields, keep_id) && fields.size() == 1 &&
+           fields.front() == predicate.field;
+}
+
+}  // namespace aevum::db::query
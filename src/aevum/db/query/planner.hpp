@@ -0,0 +1,219 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file planner.hpp
+ * @brief Declares the query planner that selects an access path for a query document.
+ * @details Before a query is handed to the Rust matcher, the planner inspects its top-level
+ * predicates and decides whether the candidate documents can be obtained from the primary index,
+ * from one or more secondary indexes, or only by scanning the whole collection. The matcher then
+ * only ever sees the candidate set. When the requested sort order is that of an ordered index,
+ * the planner also arranges for the candidates to be produced in that order, so that the matcher
+ * never has to sort them.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/matcher.hpp"
+#include "aevum/db/index/column_store.hpp"
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/db/index/index_manager.hpp"
+#include "aevum/db/index/index_statistics.hpp"
+
+namespace aevum::db::query {
+
+/**
+ * @enum PlanType
+ * @brief Enumerates the access paths the planner can choose for a query.
+ */
+enum class PlanType : uint8_t {
+    /// Every document of the collection is a candidate.
+    FULL_SCAN = 0,
+    /// The query pins `_id` to a string, or with `$in` to one of a few, so the candidates are
+    /// looked up by `_id`.
+    PRIMARY_LOOKUP = 1,
+    /// The candidates are the intersection of one or more secondary index postings.
+    INDEX_PROBE = 2,
+    /// Every document is a candidate, produced in the order of an ordered index on the sort field.
+    INDEX_SCAN = 3,
+    /// The candidates are the rows of one or more columnar indexes that satisfy their predicates.
+    COLUMN_SCAN = 4,
+    /// The candidates are the documents a `$text` search finds in the text indexes, best first.
+    TEXT_SEARCH = 5,
+    /// The candidates are the points of the time-series buckets the query's time range selects.
+    BUCKET_SCAN = 6
+};
+
+/// The number of `PlanType` enumerators, for tables indexed by plan type.
+constexpr size_t PLAN_TYPE_COUNT = 7;
+
+/**
+ * @brief Converts a `PlanType` enumerator into its canonical string representation.
+ * @param type The plan type to convert.
+ * @return A `std::string_view` literal naming the plan (e.g., "INDEX_PROBE").
+ */
+[[nodiscard]] constexpr std::string_view to_string(PlanType type) noexcept {
+    switch (type) {
+        case PlanType::PRIMARY_LOOKUP:
+            return "PRIMARY_LOOKUP";
+        case PlanType::INDEX_PROBE:
+            return "INDEX_PROBE";
+        case PlanType::INDEX_SCAN:
+            return "INDEX_SCAN";
+        case PlanType::COLUMN_SCAN:
+            return "COLUMN_SCAN";
+        case PlanType::TEXT_SEARCH:
+            return "TEXT_SEARCH";
+        case PlanType::BUCKET_SCAN:
+            return "BUCKET_SCAN";
+        case PlanType::FULL_SCAN:
+        default:
+            return "FULL_SCAN";
+    }
+}
+
+/**
+ * @struct IndexPredicate
+ * @brief A predicate of the query that can be answered by a secondary index.
+ * @details On a `HASH` index only equality is supported and `key` holds the stringified value.
+ * On an `ORDERED` index, equality and the range operators `$gt`, `$gte`, `$lt`, and `$lte` are
+ * folded into `range`. An `$in` predicate is a union instead: its candidates are those of any of
+ * the point predicates in `any_of`, and `key` and `range` are unused.
+ */
+struct IndexPredicate {
+    /// The indexed field the predicate constrains, or the name of a compound index.
+    std::string field;
+    /// The type of the index on `field`.
+    aevum::db::index::IndexType type = aevum::db::index::IndexType::HASH;
+    /// The index key of the value the field must equal, for a `HASH` index.
+    std::string key;
+    /// The interval of keys the field must lie in, for an `ORDERED` index.
+    aevum::db::index::KeyRange range;
+    /// `true` if every document in `range` satisfies the predicate, as the matcher evaluates it.
+    bool exact = false;
+    /// For an `$in` predicate, one equality predicate on `field` per element of the list.
+    std::vector<IndexPredicate> any_of;
+    /// The number of index entries the predicate is estimated to yield, from the statistics.
+    double estimate = 0.0;
+};
+
+/**
+ * @struct QueryPlan
+ * @brief The access path chosen for a query, as produced by `plan_query`.
+ */
+struct QueryPlan {
+    /// The chosen access path.
+    PlanType type = PlanType::FULL_SCAN;
+    /// The `_id`s to look up when `type` is `PRIMARY_LOOKUP`, sorted and without duplicates.
+    std::vector<std::string> ids;
+    /// The predicates to intersect when `type` is `INDEX_PROBE`, most selective first.
+    std::vector<IndexPredicate> predicates;
+    /// The predicates on indexed fields that the cost model left to the matcher.
+    std::vector<IndexPredicate> dropped;
+    /// The size of the collection, if the cost model was consulted.
+    aevum::db::index::CollectionStatistics collection;
+    /// The estimated cost of the chosen access path, in units of matching a small document.
+    double cost = 0.0;
+    /// The predicates to evaluate on columnar indexes when `type` is `COLUMN_SCAN`.
+    std::vector<aevum::db::index::ColumnPredicate> column_predicates;
+    /// The search text of the query's `$text` operator when `type` is `TEXT_SEARCH`.
+    std::string text_search;
+    /**
+     * @brief The query without its `$text` operator, as JSON, when `type` is `TEXT_SEARCH`.
+     * @details Neither matcher knows `$text`, so the candidates of a text search are matched
+     * against this instead of the query itself.
+     */
+    std::string text_query;
+    /**
+     * @brief `true` if the index lookup alone answers the whole query, so the candidates need
+     * not be re-checked by the matcher. This only holds for a query consisting of nothing but an
+     * `_id` equality; secondary index keys are stringified and can collide across types, so an
+     * index probe is always re-verified.
+     */
+    bool covered = false;
+    /**
+     * @brief `true` if the query is a single exact predicate on an ordered index that is not
+     * multikey, so the number of index entries in its range is the number of matches. Set only
+     * for an `INDEX_PROBE`; lets `Core::count` answer without resolving a single document.
+     */
+    bool index_only = false;
+    /**
+     * @brief The field whose ordered index supplies the sort order of the results, or an empty
+     * string if the matcher has to sort them itself.
+     */
+    std::string sort_field;
+    /// `true` if the results are sorted on `sort_field` in descending order.
+    bool sort_descending = false;
+    /**
+     * @brief The query compiled for the native matcher, or empty if only the Rust engine can
+     * evaluate it. Filled in by the caller of `plan_query`, which has the query's JSON text.
+     */
+    std::optional<aevum::bson::doc::Matcher> matcher;
+};
+
+/**
+ * @brief Chooses an access path for a query document.
+ * @details The predicates of the query document are considered one by one; a dotted field such
+ * as `"address.city"` is planned on an index covering that path, as the matchers resolve it.
+ * Equality may be written either as `{"f": v}` or as `{"f": {"$eq": v}}`; on fields with an
+ * ordered index, `$gt`, `$gte`, `$lt`, and `$lte` with a numeric or string operand are recognized
+ * as well, and `$all` probes the index once per element. An `$in` list is looked up one element
+ * at a time, and the postings are unioned; every element must be a value the index can look up.
+ * Equalities on the leading fields of a compound hash index are looked up as one key. The planner
+ * prefers, in this order:
+ * 0. A text search if the query has a top-level `{"$text": {"$search": "..."}}` and the collection
+ *    has a text index. Its candidates come ranked by relevance, so no other index and no sort
+ *    index is used; the rest of the query is left to the matcher through `text_query`.
+ * 1. A primary lookup if `_id` is compared with a string, or with `$in` to a list of strings.
+ * 2. An index probe over every recognized predicate on an indexed field. On a hash index the value
+ *    must be a non-empty string, an integer, or a boolean; doubles are excluded because their
+ *    stringified key is not canonical (`0.0` and `-0.0` compare equal but produce different
+ *    keys). Ordered indexes are type-aware and have no such restriction.
+ * 3. A column scan over every equality or numeric range on a field with a columnar index.
+ * 4. An index scan if the sort is on a single field with an ordered index.
+ * 5. A full scan otherwise.
+ *
+ * The index predicates of step 2 are then weighed by a cost model. Each is estimated from its
+ * index's statistics (see `IndexStatistics`), and the predicates are taken, most selective first,
+ * for as long as intersecting one more costs less than matching the candidates it would rule out.
+ * If even that probe costs more than matching every document of the collection, at the average
+ * document size, no index is used and the later steps apply. The predicates not taken are listed
+ * in `dropped`; the matcher evaluates them either way.
+ *
+ * Independently of the access path, a sort of the form `{"f": 1}` or `{"f": -1}` on a top-level
+ * field with an ordered index that is not multikey is recorded in `sort_field`, so that the caller
+ * can deliver the candidates in index order instead of asking the matcher to sort them.
+ *
+ * @param coll The name of the collection being queried.
+ * @param query The parsed query document.
+ * @param sort The parsed sort document (may be empty).
+ * @param index_manager The index manager used to discover which fields are indexed.
+ * @return The chosen `QueryPlan`.
+ */
+[[nodiscard]] QueryPlan plan_query(std::string_view coll, const aevum::bson::doc::Document &query,
+                                   const aevum::bson::doc::Document &sort,
+                                   const aevum::db::index::IndexManager &index_manager);
+
+/**
+ * @brief Checks whether the entries of a plan's index alone can produce the projected results.
+ * @details This holds for an `index_only` plan on a top-level field whose range keeps to string
+ * or boolean keys, with an inclusion projection of that field and, optionally, `_id`. Such keys
+ * give back the stored value exactly; a numeric key does not record whether the value was an
+ * integer or a double. Each result is then built from an index entry's key and `_id`, and no
+ * document is read. Whether the sort is one the index supplies is left to the caller.
+ * @param plan The plan chosen by `plan_query`.
+ * @param projection The parsed projection document (may be empty).
+ * @return `true` if the query can be answered from index entries.
+ */
+[[nodiscard]] bool index_covers_projection(const QueryPlan &plan,
+                                           const aevum::bson::doc::Document &projection);
+
+}  // namespace aevum::db::query
@@ -0,0 +1,261 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file prepared_query.cpp
+ * @brief Implements the preparation and binding of query templates, and the
+ * `PreparedQueryManager`.
+ */
+#include "aevum/db/query/prepared_query.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "aevum/bson/json/parser.hpp"
+
+namespace aevum::db::query {
+
+namespace {
+
+/// The key of a parameter placeholder.
+constexpr const char *PARAM_KEY = "$param";
+
+/**
+ * @brief Reads the parameter name of a placeholder.
+ * @param value An iterator positioned on a value of the template.
+ * @param name Receives the name if the value is a placeholder.
+ * @return `true` if the value is a document whose only field is `$param`, holding a non-empty
+ *         string.
+ */
+bool read_placeholder(const bson_iter_t &value, std::string_view &name) {
+    bson_iter_t inner;
+    if (!BSON_ITER_HOLDS_DOCUMENT(&value) || !bson_iter_recurse(&value, &inner) ||
+        !bson_iter_next(&inner) || std::strcmp(bson_iter_key(&inner), PARAM_KEY) != 0 ||
+        !BSON_ITER_HOLDS_UTF8(&inner)) {
+        return false;
+    }
+    uint32_t length = 0;
+    const char *text = bson_iter_utf8(&inner, &length);
+    name = std::string_view(text, length);
+    return !name.empty() && !bson_iter_next(&inner);
+}
+
+/**
+ * @brief Collects the parameters of a template and checks its placeholders.
+ * @param iter An iterator over a document or an array of the template, before its first element.
+ * @param parameters Receives the names of new parameters.
+ * @return `false` if a document uses `$param` other than as a well-formed placeholder.
+ */
+bool collect_parameters(bson_iter_t &iter, std::vector<std::string> &parameters) {
+    while (bson_iter_next(&iter)) {
+        if (std::strcmp(bson_iter_key(&iter), PARAM_KEY) == 0) return false;
+        if (!BSON_ITER_HOLDS_DOCUMENT(&iter) && !BSON_ITER_HOLDS_ARRAY(&iter)) continue;
+        std::string_view name;
+        if (read_placeholder(iter, name)) {
+            if (std::find(parameters.begin(), parameters.end(), name) == parameters.end()) {
+                parameters.emplace_back(name);
+            }
+            continue;
+        }
+        bson_iter_t child;
+        if (!bson_iter_recurse(&iter, &child) || !collect_parameters(child, parameters)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Copies a document or an array of a template, substituting its placeholders.
+ * @param iter An iterator over the template's document or array, before its first element.
+ * @param params The values of the parameters.
+ * @param out The document or array to append to.
+ * @param missing Receives the name of a parameter without a value.
+ * @return `false` if a parameter has no value.
+ */
+bool bind_elements(bson_iter_t &iter, const bson_t *params, bson_t *out,
+                   std::string &missing) {
+    while (bson_iter_next(&iter)) {
+        const char *key = bson_iter_key(&iter);
+        int key_length = static_cast<int>(bson_iter_key_len(&iter));
+        std::string_view name;
+        if (read_placeholder(iter, name)) {
+            bson_iter_t value;
+            std::string param(name);
+            if (params == nullptr || !bson_iter_init_find(&value, params, param.c_str())) {
+                missing = std::move(param);
+                return false;
+            }
+            bson_append_iter(out, key, key_length, &value);
+            continue;
+        }
+        bool is_document = BSON_ITER_HOLDS_DOCUMENT(&iter);
+        if (!is_document && !BSON_ITER_HOLDS_ARRAY(&iter)) {
+            bson_append_iter(out, key, key_length, &iter);
+            continue;
+        }
+        bson_iter_t child_iter;
+        bson_t child;
+        (void)bson_iter_recurse(&iter, &child_iter);
+        if (is_document) {
+            bson_append_document_begin(out, key, key_length, &child);
+        } else {
+            bson_append_array_begin(out, key, key_length, &child);
+        }
+        bool bound = bind_elements(child_iter, params, &child, missing);
+        if (is_document) {
+            bson_append_document_end(out, &child);
+        } else {
+            bson_append_array_end(out, &child);
+        }
+        if (!bound) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a template selects documents by `_id` alone.
+ * @param query The template.
+ * @return `true` if its `_id` is a value, a placeholder, or a map of `$eq` and `$in` only.
+ */
+bool selects_by_id(const bson_t *query) {
+    bson_iter_t id;
+    if (!bson_iter_init_find(&id, query, "_id")) return false;
+    std::string_view name;
+    if (!BSON_ITER_HOLDS_DOCUMENT(&id) || read_placeholder(id, name)) return true;
+    bson_iter_t operators;
+    if (!bson_iter_recurse(&id, &operators)) return false;
+    bool any = false;
+    while (bson_iter_next(&operators)) {
+        std::string_view key = bson_iter_key(&operators);
+        if (key != "$eq" && key != "$in") return false;
+        any = true;
+    }
+    return any;
+}
+
+}  // namespace
+
+/**
+ * @brief Parses and compiles a query template.
+ * @details The template is parsed as `Core::find` parses a query, so that a bound template
+ * means what the same query sent to `find` would. An empty sort is normalized to `{}`, which
+ * the query paths recognize without parsing it.
+ * @param collection The collection.
+ * @param owner The API key preparing the query.
+ * @param query_json The query template.
+ * @param sort_json The sort order.
+ * @param projection_json The projection.
+ * @param out Receives the prepared query.
+ * @return `OK` or `InvalidArgument`.
+ */
+aevum::util::Status prepare_query(std::string_view collection, std::string_view owner,
+                                  std::string_view query_json, std::string_view sort_json,
+                                  std::string_view projection_json, PreparedQuery &out) {
+    out.collection = std::string(collection);
+    out.owner = std::string(owner);
+    if (!aevum::bson::json::parse(query_json, out.query).ok()) {
+        return aevum::util::Status::InvalidArgument("'query' must be a JSON object");
+    }
+    if (!aevum::bson::json::parse(sort_json, out.sort).ok()) {
+        return aevum::util::Status::InvalidArgument("'sort' must be a JSON object");
+    }
+    if (!aevum::bson::json::parse(projection_json, out.projection).ok()) {
+        return aevum::util::Status::InvalidArgument("'projection' must be a JSON object");
+    }
+
+    bson_iter_t iter;
+    out.parameters.clear();
+    if (!bson_iter_init(&iter, out.query.get()) || !collect_parameters(iter, out.parameters)) {
+        return aevum::util::Status::InvalidArgument(
+            "A '$param' placeholder must be a document of that field alone, naming a parameter");
+    }
+    out.sort_json = out.sort.empty() ? "{}" : std::string(sort_json);
+    out.matcher = aevum::bson::doc::Matcher::compile_template(query_json);
+    out.point = selects_by_id(out.query.get());
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Substitutes parameters into the template of a prepared query.
+ * @details The template is walked once and copied into a new document, with each placeholder
+ * replaced by the parameter's value element.
+ * @param prepared The prepared query.
+ * @param params The values of the parameters.
+ * @param query Receives the bound query.
+ * @return `OK` or `InvalidArgument`.
+ */
+aevum::util::Status bind_query(const PreparedQuery &prepared,
+                               const aevum::bson::doc::Document &params,
+                               aevum::bson::doc::Document &query) {
+    bson_iter_t iter;
+    if (prepared.parameters.empty() || !bson_iter_init(&iter, prepared.query.get())) {
+        query = prepared.query;
+        return aevum::util::Status::OK();
+    }
+    bson_t *bound = bson_new();
+    std::string missing;
+    if (!bind_elements(iter, params.get(), bound, missing)) {
+        bson_destroy(bound);
+        return aevum::util::Status::InvalidArgument("Missing value for parameter '" + missing +
+                                                    "'");
+    }
+    query = aevum::bson::doc::Document(bound);
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Registers a prepared query under the next free id.
+ * @param prepared The prepared query.
+ * @return The id, or 0 if the manager is full.
+ */
+int64_t PreparedQueryManager::add(std::shared_ptr<const PreparedQuery> prepared) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queries_.size() >= MAX_PREPARED_QUERIES) return 0;
+    int64_t id = next_id_++;
+    queries_.emplace(id, std::move(prepared));
+    return id;
+}
+
+/**
+ * @brief Looks up a prepared query.
+ * @details A prepared query presented with another API key is reported as missing, so that
+ * guessing an id does not allow a client to run another client's query.
+ * @param id The id.
+ * @param owner The API key presented with the request.
+ * @return The prepared query, or null.
+ */
+std::shared_ptr<const PreparedQuery> PreparedQueryManager::get(int64_t id,
+                                                               std::string_view owner) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queries_.find(id);
+    if (it == queries_.end() || it->second->owner != owner) return nullptr;
+    return it->second;
+}
+
+/**
+ * @brief Discards a prepared query.
+ * @param id The id.
+ * @param owner The API key presented with the request.
+ * @return `true` if the prepared query was discarded.
+ */
+bool PreparedQueryManager::remove(int64_t id, std::string_view owner) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queries_.find(id);
+    if (it == queries_.end() || it->second->owner != owner) return false;
+    queries_.erase(it);
+    return true;
+}
+
+/**
+ * @brief Returns the number of prepared queries held by the manager.
+ * @return The number of prepared queries.
+ */
+size_t PreparedQueryManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queries_.size();
+}
+
+}  // namespace aevum::db::query
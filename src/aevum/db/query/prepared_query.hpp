@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file prepared_query.hpp
+ * @brief Declares prepared queries: query templates that are compiled once and run many times
+ * with different parameters.
+ * @details Clients tend to send the same query shapes with different constants. A `find` parses
+ * its query, sort, and projection on every request, and compiles the query for the native
+ * matcher. A prepared query does all of this once, for a template whose constants may be
+ * placeholders of the form `{"$param": "<name>"}`. Each execution then only substitutes the
+ * parameters into the parsed template and the compiled matcher, and plans the bound query.
+ * Prepared queries are kept by a `PreparedQueryManager`, which hands them out by id.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/matcher.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::query {
+
+/// The most prepared queries a server keeps at once.
+constexpr size_t MAX_PREPARED_QUERIES = 10000;
+
+/**
+ * @struct PreparedQuery
+ * @brief A query template with its sort and projection, parsed and compiled once.
+ */
+struct PreparedQuery {
+    /// The collection the query runs on.
+    std::string collection;
+    /// The API key that prepared the query; only the same key may run or close it.
+    std::string owner;
+    /// The query, with its placeholders as `{"$param": "<name>"}` documents.
+    aevum::bson::doc::Document query;
+    /// The names of the parameters, in order of first appearance.
+    std::vector<std::string> parameters;
+    /// The sort order as JSON, normalized to `{}` if it is empty.
+    std::string sort_json{"{}"};
+    /// The parsed sort order.
+    aevum::bson::doc::Document sort;
+    /// The parsed projection.
+    aevum::bson::doc::Document projection;
+    /// The template compiled for the native matcher, or empty if only the Rust engine can
+    /// evaluate it.
+    std::optional<aevum::bson::doc::Matcher> matcher;
+    /// `true` if the query selects documents by `_id` alone, as a primary lookup.
+    bool point{false};
+};
+
+/**
+ * @brief Parses and compiles a query template.
+ * @param collection The collection the query runs on.
+ * @param owner The API key preparing the query.
+ * @param query_json The query template.
+ * @param sort_json The sort order.
+ * @param projection_json The projection.
+ * @param out Receives the prepared query.
+ * @return `OK`, or `InvalidArgument` if the template, sort, or projection is not a JSON object,
+ *         or a placeholder does not name its parameter with a non-empty string.
+ */
+[[nodiscard]] aevum::util::Status prepare_query(std::string_view collection,
+                                                std::string_view owner,
+                                                std::string_view query_json,
+                                                std::string_view sort_json,
+                                                std::string_view projection_json,
+                                                PreparedQuery &out);
+
+/**
+ * @brief Substitutes parameters into the template of a prepared query.
+ * @details Each placeholder is replaced by the value of its parameter, whatever its type; the
+ * rest of the template is copied as it is.
+ * @param prepared The prepared query.
+ * @param params A document holding the value of each parameter under its name.
+ * @param query Receives the bound query.
+ * @return `OK`, or `InvalidArgument` naming the first parameter without a value.
+ */
+[[nodiscard]] aevum::util::Status bind_query(const PreparedQuery &prepared,
+                                             const aevum::bson::doc::Document &params,
+                                             aevum::bson::doc::Document &query);
+
+/**
+ * @class PreparedQueryManager
+ * @brief Keeps the prepared queries of the server, by id.
+ *
+ * @details A prepared query is immutable once added, so it is handed out as a shared pointer
+ * and runs without holding the manager's lock. Prepared queries live until they are closed or
+ * the server stops; the manager refuses new ones beyond `MAX_PREPARED_QUERIES`. The class is
+ * thread-safe.
+ */
+class PreparedQueryManager {
+  public:
+    /**
+     * @brief Registers a prepared query.
+     * @param prepared The prepared query.
+     * @return The id assigned to it, never 0, or 0 if the manager is full.
+     */
+    [[nodiscard]] int64_t add(std::shared_ptr<const PreparedQuery> prepared);
+
+    /**
+     * @brief Looks up a prepared query.
+     * @param id The id of the prepared query.
+     * @param owner The API key presented with the request.
+     * @return The prepared query, or null if none with this id belongs to `owner`.
+     */
+    [[nodiscard]] std::shared_ptr<const PreparedQuery> get(int64_t id,
+                                                           std::string_view owner) const;
+
+    /**
+     * @brief Discards a prepared query.
+     * @param id The id of the prepared query.
+     * @param owner The API key presented with the request.
+     * @return `true` if a prepared query with this id belonged to `owner` and was discarded.
+     */
+    bool remove(int64_t id, std::string_view owner);
+
+    /**
+     * @brief Returns the number of prepared queries held by the manager.
+     * @return The number of prepared queries.
+     */
+    [[nodiscard]] size_t size() const;
+
+  private:
+    /// Guards all members below.
+    mutable std::mutex mutex_;
+    /// The prepared queries, by id.
+    std::unordered_map<int64_t, std::shared_ptr<const PreparedQuery>> queries_;
+    /// The id assigned to the next prepared query.
+    int64_t next_id_{1};
+};
+
+}  // namespace aevum::db::query
@@ -0,0 +1,204 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file profile.cpp
+ * @brief Implements the slow operation log, `ProfileScope`, and `PhaseTimer`.
+ */
+#include "aevum/db/query/profile.hpp"
+
+#include <bson/bson.h>
+
+#include <string>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
+
+namespace aevum::db::query {
+
+namespace {
+
+/// The profile of the operation running on this thread, or null.
+thread_local ProfileScope *active_profile_scope = nullptr;
+
+/**
+ * @brief Checks whether a key is a logical operator, whose operands are queries themselves.
+ * @param key The key.
+ * @return `true` for `$and`, `$or`, and `$nor`.
+ */
+bool is_logical_operator(std::string_view key) {
+    return key == "$and" || key == "$or" || key == "$nor";
+}
+
+/**
+ * @brief Checks whether the value under an iterator is a document of operators, like
+ * `{"$gt": 1}`, rather than a literal document to compare with.
+ * @param iter The iterator, positioned on a document.
+ * @return `true` if the document's first key starts with `$`.
+ */
+bool holds_operator_document(const bson_iter_t *iter) {
+    bson_iter_t child;
+    if (!bson_iter_recurse(iter, &child) || !bson_iter_next(&child)) return false;
+    return bson_iter_key(&child)[0] == '$';
+}
+
+/**
+ * @brief Appends the shape of a query to a document under construction.
+ * @param query An iterator over the query's fields, before the first one.
+ * @param out The document receiving the shape.
+ */
+void append_query_shape(bson_iter_t *query, bson_t *out) {
+    while (bson_iter_next(query)) {
+        const char *key = bson_iter_key(query);
+        if (is_logical_operator(key) && BSON_ITER_HOLDS_ARRAY(query)) {
+            bson_t clauses;
+            bson_iter_t clause;
+            BSON_APPEND_ARRAY_BEGIN(out, key, &clauses);
+            if (bson_iter_recurse(query, &clause)) {
+                while (bson_iter_next(&clause)) {
+                    const char *index = bson_iter_key(&clause);
+                    bson_iter_t fields;
+                    if (BSON_ITER_HOLDS_DOCUMENT(&clause) && bson_iter_recurse(&clause, &fields)) {
+                        bson_t shape;
+                        BSON_APPEND_DOCUMENT_BEGIN(&clauses, index, &shape);
+                        append_query_shape(&fields, &shape);
+                        bson_append_document_end(&clauses, &shape);
+                    } else {
+                        BSON_APPEND_UTF8(&clauses, index, "?");
+                    }
+                }
+            }
+            bson_append_array_end(out, &clauses);
+        } else if (key[0] != '$' && BSON_ITER_HOLDS_DOCUMENT(query) &&
+                   holds_operator_document(query)) {
+            bson_t operators;
+            bson_iter_t operator_iter;
+            BSON_APPEND_DOCUMENT_BEGIN(out, key, &operators);
+            if (bson_iter_recurse(query, &operator_iter)) {
+                append_query_shape(&operator_iter, &operators);
+            }
+            bson_append_document_end(out, &operators);
+        } else {
+            BSON_APPEND_UTF8(out, key, "?");
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Reduces a JSON query to its shape.
+ * @details The query is parsed into BSON and its shape built as a new document, which keeps the
+ * field names escaped as the serializer escapes them. The operands of an operator document are
+ * visited with the same rules as a query, so the operators of `{"a": {"$gt": 1, "$lt": 9}}` are
+ * kept while their operands become `"?"`.
+ */
+std::string query_shape(std::string_view query_json) {
+    aevum::bson::doc::Document query;
+    if (!aevum::bson::json::parse(query_json, query).ok()) return "\"?\"";
+    bson_iter_t iter;
+    if (!bson_iter_init(&iter, query.get())) return "\"?\"";
+    bson_t *shape = bson_new();
+    append_query_shape(&iter, shape);
+    return aevum::bson::json::to_string(aevum::bson::doc::Document(shape));
+}
+
+SlowOperationLog::SlowOperationLog(int64_t threshold_ms, size_t capacity)
+    : threshold_ms_(threshold_ms), capacity_(capacity > 0 ? capacity : 1) {}
+
+void SlowOperationLog::record(OperationProfile profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.size() < capacity_) {
+        ring_.push_back(std::move(profile));
+        return;
+    }
+    ring_[next_] = std::move(profile);
+    next_ = (next_ + 1) % capacity_;
+}
+
+/**
+ * @brief Returns the kept profiles, most recent first.
+ * @details Until the ring is full, the most recent profile is the last one; afterwards it is the
+ * one before `next_`.
+ */
+std::vector<OperationProfile> SlowOperationLog::snapshot(std::string_view collection) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<OperationProfile> profiles;
+    profiles.reserve(ring_.size());
+    size_t newest = ring_.size() < capacity_ ? ring_.size() : next_;
+    for (size_t i = 0; i < ring_.size(); ++i) {
+        const OperationProfile &profile = ring_[(newest + ring_.size() - 1 - i) % ring_.size()];
+        if (collection.empty() || profile.collection == collection) profiles.push_back(profile);
+    }
+    return profiles;
+}
+
+/**
+ * @brief Starts profiling an operation, unless another one is already being profiled on this
+ * thread or profiling is disabled.
+ * @details Only views of the collection, query, and sort are kept; they are copied, the query
+ * reduced to a shape, only if the operation turns out to be slow.
+ */
+ProfileScope::ProfileScope(SlowOperationLog &log, std::string_view op,
+                           std::string_view collection, std::string_view query_json,
+                           std::string_view sort_json) {
+    int64_t threshold_ms = log.threshold_ms();
+    if (active_profile_scope || threshold_ms < 0) return;
+    log_ = &log;
+    threshold_ns_ = static_cast<uint64_t>(threshold_ms) * 1000000;
+    query_json_ = query_json;
+    sort_json_ = sort_json;
+    collection_ = collection;
+    profile_.op = op;
+    active_profile_scope = this;
+}
+
+ProfileScope::~ProfileScope() {
+    if (!log_) return;
+    active_profile_scope = nullptr;
+    uint64_t total_ns = stopwatch_.elapsed_ns();
+    if (total_ns < threshold_ns_) return;
+    close_phase(total_ns);
+    profile_.total_us = total_ns / 1000;
+    profile_.collection.assign(collection_);
+    profile_.shape = query_shape(query_json_);
+    if (!sort_json_.empty() && sort_json_ != "{}") profile_.sort.assign(sort_json_);
+    profile_.end_unix_ms = aevum::util::time::CoarseClock::now_unix_ms();
+    log_->record(std::move(profile_));
+}
+
+void ProfileScope::note_plan(PlanType plan) noexcept {
+    if (active_profile_scope) active_profile_scope->profile_.plan = plan;
+}
+
+void ProfileScope::note_examined(size_t documents) noexcept {
+    if (active_profile_scope) active_profile_scope->profile_.examined += documents;
+}
+
+void ProfileScope::note_returned(size_t documents) noexcept {
+    if (active_profile_scope) active_profile_scope->profile_.returned = documents;
+}
+
+void ProfileScope::close_phase(uint64_t now_ns) noexcept {
+    if (phase_ < PROFILE_PHASE_COUNT) {
+        profile_.phase_us[phase_] += (now_ns - phase_start_ns_) / 1000;
+    }
+    phase_start_ns_ = now_ns;
+}
+
+PhaseTimer::PhaseTimer(ProfilePhase phase) noexcept : scope_(active_profile_scope) {
+    if (!scope_) return;
+    scope_->close_phase(scope_->stopwatch_.elapsed_ns());
+    resumed_phase_ = scope_->phase_;
+    scope_->phase_ = static_cast<size_t>(phase);
+}
+
+PhaseTimer::~PhaseTimer() {
+    if (!scope_) return;
+    scope_->close_phase(scope_->stopwatch_.elapsed_ns());
+    scope_->phase_ = resumed_phase_;
+}
+
+}  // namespace aevum::db::query
@@ -0,0 +1,287 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file profile.hpp
+ * @brief Declares the slow operation log: execution profiles of the queries and writes that
+ * exceed a latency threshold, kept in a bounded ring.
+ * @details Every `find`, `count`, `update`, and `remove` of `Core` opens a `ProfileScope`, which
+ * makes an `OperationProfile` the calling thread's active profile. The code paths that run the
+ * operation add to it through static, allocation-free calls: `PhaseTimer` splits the elapsed time
+ * into phases, and the examined and returned document counts are noted as they are known. When
+ * the scope closes, the profile is kept only if the operation took longer than the threshold;
+ * only then is the query shape computed and anything allocated, so fast operations cost a few
+ * clock reads.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/db/query/planner.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+
+namespace aevum::db::query {
+
+/**
+ * @enum ProfilePhase
+ * @brief The phases an operation's time is split into.
+ */
+enum class ProfilePhase : uint8_t {
+    /// Parsing the query and sort and choosing a plan.
+    PLAN = 0,
+    /// Gathering the candidate documents from the indexes, or reading them from storage.
+    FETCH = 1,
+    /// Matching, sorting, and paginating the candidates, natively or in the Rust FFI.
+    MATCH = 2,
+    /// Serializing documents for the Rust FFI, such as the matches of an update.
+    SERIALIZE = 3,
+    /// Parsing the results of the Rust FFI and building the returned documents.
+    PARSE = 4,
+    /// Writing changes to storage and the indexes and waiting for their durability.
+    WRITE = 5
+};
+
+/// The number of `ProfilePhase` enumerators.
+constexpr size_t PROFILE_PHASE_COUNT = 6;
+
+/**
+ * @brief Converts a `ProfilePhase` into its name.
+ * @param phase The phase.
+ * @return The lowercase name of the phase (e.g., "fetch").
+ */
+[[nodiscard]] constexpr std::string_view to_string(ProfilePhase phase) noexcept {
+    switch (phase) {
+        case ProfilePhase::PLAN:
+            return "plan";
+        case ProfilePhase::FETCH:
+            return "fetch";
+        case ProfilePhase::MATCH:
+            return "match";
+        case ProfilePhase::SERIALIZE:
+            return "serialize";
+        case ProfilePhase::PARSE:
+            return "parse";
+        case ProfilePhase::WRITE:
+        default:
+            return "write";
+    }
+}
+
+/**
+ * @brief Reduces a JSON query to its shape: its fields and operators, with every value replaced
+ * by `"?"`.
+ * @details Queries that differ only in their values share a shape, so the slow operations of one
+ * query pattern can be grouped. The operands of `$and`, `$or`, and `$nor` are reduced in turn;
+ * the operand of any other operator, arrays included, is a single `"?"`.
+ * @param query_json The query.
+ * @return The shape as JSON, e.g. `{ "age" : { "$gt" : "?" } }`, or `"?"` if the query is not a
+ *         valid JSON object.
+ */
+[[nodiscard]] std::string query_shape(std::string_view query_json);
+
+/**
+ * @struct OperationProfile
+ * @brief The execution profile of one operation.
+ */
+struct OperationProfile {
+    /// The operation: `"find"`, `"count"`, `"update"`, `"upsert"`, or `"remove"`.
+    std::string_view op;
+    /// The collection.
+    std::string collection;
+    /// The shape of the query (see `query_shape`).
+    std::string shape;
+    /// The sort of a `find`, or empty.
+    std::string sort;
+    /// The plan chosen for the query.
+    PlanType plan{PlanType::FULL_SCAN};
+    /// The documents that were matched against the query.
+    uint64_t examined{0};
+    /// The documents returned, counted, or modified.
+    uint64_t returned{0};
+    /// The duration of the operation, in microseconds.
+    uint64_t total_us{0};
+    /// The time spent in each phase, in microseconds; the rest is unattributed.
+    std::array<uint64_t, PROFILE_PHASE_COUNT> phase_us{};
+    /// When the operation ended, in milliseconds since the epoch.
+    uint64_t end_unix_ms{0};
+};
+
+/**
+ * @class SlowOperationLog
+ * @brief A bounded ring of the profiles of slow operations.
+ *
+ * @details Once the ring is full, each new profile replaces the oldest one. The ring is guarded
+ * by a mutex that is only taken to add a profile, which happens only for slow operations, and
+ * to read the ring. The class is thread-safe.
+ */
+class SlowOperationLog {
+  public:
+    /**
+     * @brief Constructs an empty log.
+     * @param threshold_ms The duration beyond which an operation is kept, in milliseconds; 0
+     *        keeps every operation and a negative value none.
+     * @param capacity The most profiles kept (at least one).
+     */
+    SlowOperationLog(int64_t threshold_ms, size_t capacity);
+
+    SlowOperationLog(const SlowOperationLog &) = delete;
+    SlowOperationLog &operator=(const SlowOperationLog &) = delete;
+
+    /**
+     * @brief Returns the threshold.
+     * @return The threshold in milliseconds; negative if profiling is disabled.
+     */
+    [[nodiscard]] int64_t threshold_ms() const noexcept {
+        return threshold_ms_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Changes the threshold for the operations that start from now on.
+     * @param threshold_ms The new threshold in milliseconds; negative to disable profiling.
+     */
+    void set_threshold_ms(int64_t threshold_ms) noexcept {
+        threshold_ms_.store(threshold_ms, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds a profile, replacing the oldest one if the log is full.
+     * @param profile The profile.
+     */
+    void record(OperationProfile profile);
+
+    /**
+     * @brief Returns the kept profiles, most recent first.
+     * @param collection Only profiles of this collection, or empty for all.
+     * @return The profiles.
+     */
+    [[nodiscard]] std::vector<OperationProfile> snapshot(std::string_view collection = {}) const;
+
+  private:
+    /// The threshold, in milliseconds.
+    std::atomic<int64_t> threshold_ms_;
+    /// Guards `ring_` and `next_`.
+    mutable std::mutex mutex_;
+    /// The profiles; grows up to `capacity_` and is then overwritten in place.
+    std::vector<OperationProfile> ring_;
+    /// The slot the next profile is written to once the ring is full.
+    size_t next_{0};
+    /// The most profiles kept.
+    const size_t capacity_;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Profiles the operation running on the calling thread for as long as it lives.
+ *
+ * @details The outermost scope of a thread is the active one; a scope opened while another is
+ * active, such as by an operation that calls another, does nothing. A scope whose log is
+ * disabled does nothing either.
+ */
+class ProfileScope {
+  public:
+    /**
+     * @brief Starts profiling an operation.
+     * @param log The log the profile is added to if the operation is slow.
+     * @param op The name of the operation; a string literal.
+     * @param collection The collection; must outlive the scope.
+     * @param query_json The query; must outlive the scope.
+     * @param sort_json The sort, or empty; must outlive the scope.
+     */
+    ProfileScope(SlowOperationLog &log, std::string_view op, std::string_view collection,
+                 std::string_view query_json, std::string_view sort_json = {});
+
+    /**
+     * @brief Ends the profile and adds it to the log if the operation exceeded the threshold.
+     */
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    /**
+     * @brief Notes the plan chosen for the active operation, if any.
+     * @param plan The plan type.
+     */
+    static void note_plan(PlanType plan) noexcept;
+
+    /**
+     * @brief Adds to the documents the active operation matched against its query, if any.
+     * @param documents The number of documents.
+     */
+    static void note_examined(size_t documents) noexcept;
+
+    /**
+     * @brief Sets the documents the active operation returned, counted, or modified, if any.
+     * @param documents The number of documents.
+     */
+    static void note_returned(size_t documents) noexcept;
+
+  private:
+    friend class PhaseTimer;
+
+    /**
+     * @brief Adds the time since the current phase began to it.
+     * @param now_ns The time on the operation's stopwatch, in nanoseconds.
+     */
+    void close_phase(uint64_t now_ns) noexcept;
+
+    /// The log of slow operations, or null if this scope is inactive.
+    SlowOperationLog *log_{nullptr};
+    /// The collection of the operation; valid for the scope's lifetime.
+    std::string_view collection_;
+    /// The query of the operation; valid for the scope's lifetime.
+    std::string_view query_json_;
+    /// The sort of the operation; valid for the scope's lifetime.
+    std::string_view sort_json_;
+    /// The profile being collected.
+    OperationProfile profile_;
+    /// Measures the operation.
+    aevum::util::time::Stopwatch stopwatch_;
+    /// The phase time is currently attributed to, or `PROFILE_PHASE_COUNT` for none.
+    size_t phase_{PROFILE_PHASE_COUNT};
+    /// When the current phase began, in nanoseconds on `stopwatch_`.
+    uint64_t phase_start_ns_{0};
+    /// The log's threshold when the scope opened, in nanoseconds.
+    uint64_t threshold_ns_{0};
+};
+
+/**
+ * @class PhaseTimer
+ * @brief Attributes the time of the active operation to a phase for as long as it lives.
+ *
+ * @details Phases do not overlap: a timer interrupts the phase that was running when it was
+ * created and resumes it when destroyed, so each phase receives its exclusive time. Without an
+ * active `ProfileScope`, a timer does nothing.
+ */
+class PhaseTimer {
+  public:
+    /**
+     * @brief Starts attributing time to a phase.
+     * @param phase The phase.
+     */
+    explicit PhaseTimer(ProfilePhase phase) noexcept;
+
+    /**
+     * @brief Ends the phase and resumes the interrupted one.
+     */
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+  private:
+    /// The active scope when the timer was created, or null.
+    ProfileScope *scope_;
+    /// The phase that was interrupted.
+    size_t resumed_phase_{PROFILE_PHASE_COUNT};
+};
+
+}  // namespace aevum::db::query
@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file projection.cpp
+ * @brief Implements the native BSON field projection used by the zero-copy query path.
+ * @details The logic mirrors `ffi/src/query/projection.rs` element for element, operating on
+ * `bson_iter_t` instead of `serde_json::Value` so that projected results can be produced without
+ * leaving the BSON representation.
+ */
+#include "aevum/db/query/projection.hpp"
+
+#include <bson/bson.h>
+#include <string_view>
+
+namespace aevum::db::query {
+
+namespace {
+
+/**
+ * @brief Interprets a projection value as an explicit inclusion (`1` or `true`).
+ * @param iter An iterator positioned on a projection element.
+ * @return `true` if the element requests inclusion.
+ */
+bool is_included(const bson_iter_t &iter) {
+    switch (bson_iter_type(&iter)) {
+        case BSON_TYPE_INT32:
+            return bson_iter_int32(&iter) == 1;
+        case BSON_TYPE_INT64:
+            return bson_iter_int64(&iter) == 1;
+        case BSON_TYPE_BOOL:
+            return bson_iter_bool(&iter);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Interprets a projection value as an explicit exclusion (`0` or `false`).
+ * @param iter An iterator positioned on a projection element.
+ * @return `true` if the element requests exclusion.
+ */
+bool is_excluded(const bson_iter_t &iter) {
+    switch (bson_iter_type(&iter)) {
+        case BSON_TYPE_INT32:
+            return bson_iter_int32(&iter) == 0;
+        case BSON_TYPE_INT64:
+            return bson_iter_int64(&iter) == 0;
+        case BSON_TYPE_BOOL:
+            return !bson_iter_bool(&iter);
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Produces a new document containing only the fields selected by a projection.
+ * @details The mode is determined in a first pass over the projection. In inclusion mode, `_id`
+ * is emitted first (unless excluded) followed by each requested field in projection order; in
+ * exclusion mode, the source document is walked once and every non-excluded element is copied
+ * verbatim with `bson_append_iter`.
+ *
+ * @param doc The source document.
+ * @param projection The projection specification.
+ * @return The projected document.
+ */
+aevum::bson::doc::Document apply_projection(const aevum::bson::doc::Document &doc,
+                                            const aevum::bson::doc::Document &projection) {
+    if (projection.empty() || !doc.get()) {
+        return doc;
+    }
+
+    bson_iter_t proj_iter;
+    bool inclusion_mode = false;
+    if (bson_iter_init(&proj_iter, projection.get())) {
+        while (bson_iter_next(&proj_iter)) {
+            if (std::string_view(bson_iter_key(&proj_iter)) != "_id" && is_included(proj_iter)) {
+                inclusion_mode = true;
+                break;
+            }
+        }
+    }
+
+    bson_t *out = bson_new();
+    bson_iter_t doc_iter;
+
+    if (inclusion_mode) {
+        // `_id` is kept by default in inclusion mode unless it is explicitly excluded.
+        bool keep_id = true;
+        if (bson_iter_init_find(&proj_iter, projection.get(), "_id")) {
+            keep_id = !is_excluded(proj_iter);
+        }
+        if (keep_id && bson_iter_init_find(&doc_iter, doc.get(), "_id")) {
+            bson_append_iter(out, "_id", -1, &doc_iter);
+        }
+
+        if (bson_iter_init(&proj_iter, projection.get())) {
+            while (bson_iter_next(&proj_iter)) {
+                const char *key = bson_iter_key(&proj_iter);
+                if (std::string_view(key) == "_id" || !is_included(proj_iter)) continue;
+                if (bson_iter_init_find(&doc_iter, doc.get(), key)) {
+                    bson_append_iter(out, key, -1, &doc_iter);
+                }
+            }
+        }
+    } else if (bson_iter_init(&doc_iter, doc.get())) {
+        while (bson_iter_next(&doc_iter)) {
+            const char *key = bson_iter_key(&doc_iter);
+            if (bson_iter_init_find(&proj_iter, projection.get(), key) &&
+                is_excluded(proj_iter)) {
+                continue;
+            }
+            bson_append_iter(out, key, -1, &doc_iter);
+        }
+    }
+
+    return aevum::bson::doc::Document(out);
+}
+
+/**
+ * @brief Lists the fields an inclusion projection keeps.
+ * @param projection The projection specification.
+ * @param fields Receives the included fields other than `_id`, in projection order.
+ * @param keep_id Receives `true` if `_id` is kept.
+ * @return `true` if the projection is in inclusion mode.
+ */
+bool included_fields(const aevum::bson::doc::Document &projection,
+                     std::vector<std::string> &fields, bool &keep_id) {
+    fields.clear();
+    keep_id = true;
+    bson_iter_t iter;
+    if (projection.empty() || !bson_iter_init(&iter, projection.get())) return false;
+    while (bson_iter_next(&iter)) {
+        std::string_view key = bson_iter_key(&iter);
+        if (key != "_id" && is_included(iter)) fields.emplace_back(key);
+    }
+    if (bson_iter_init_find(&iter, projection.get(), "_id")) keep_id = !is_excluded(iter);
+    return !fields.empty();
+}
+
+}  // namespace aevum::db::query
@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file projection.hpp
+ * @brief Declares the native BSON field projection used by the zero-copy query path.
+ * @details When query results are returned straight from the primary index instead of being
+ * re-encoded by the Rust engine, the field projection that Rust would otherwise have applied must
+ * be performed on the C++ side. This header declares that stateless utility.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+
+/**
+ * @namespace aevum::db::query
+ * @brief Native C++ query-processing helpers that operate directly on BSON documents.
+ */
+namespace aevum::db::query {
+
+/**
+ * @brief Produces a new document containing only the fields selected by a projection.
+ * @details The semantics are identical to `apply_projection` in the Rust query engine so that
+ * results do not depend on which path served the query:
+ * - The projection is in *inclusion* mode if any key other than `_id` is set to `1` or `true`;
+ *   only the listed top-level fields are then copied.
+ * - Otherwise it is in *exclusion* mode, and every field is copied except those set to `0` or
+ *   `false`.
+ * - In inclusion mode, `_id` is always kept unless explicitly set to `0` or `false`.
+ *
+ * @param doc The source document. It is not modified.
+ * @param projection The projection specification (e.g., `{"name": 1, "_id": 0}`).
+ * @return A newly built `Document`. If `projection` is empty, a copy of `doc` that shares its
+ *         buffer is returned.
+ */
+[[nodiscard]] aevum::bson::doc::Document apply_projection(
+    const aevum::bson::doc::Document &doc, const aevum::bson::doc::Document &projection);
+
+/**
+ * @brief Lists the fields an inclusion projection keeps.
+ * @details Uses the same rules as `apply_projection`, which copies `_id` first and then the
+ * listed fields in projection order.
+ * @param projection The projection specification.
+ * @param fields Receives the included fields other than `_id`, in projection order.
+ * @param keep_id Receives `true` if `_id` is kept.
+ * @return `true` if the projection is in inclusion mode, `false` if every field not excluded is
+ *         kept (including for an empty projection).
+ */
+[[nodiscard]] bool included_fields(const aevum::bson::doc::Document &projection,
+                                   std::vector<std::string> &fields, bool &keep_id);
+
+}  // namespace aevum::db::query
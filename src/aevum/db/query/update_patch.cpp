@@ -0,0 +1,208 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file update_patch.cpp
+ * @brief Implements the `UpdatePatcher`.
+ */
+#include "aevum/db/query/update_patch.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/db/index/index_key.hpp"
+
+namespace aevum::db::query {
+
+namespace {
+
+/// Runs of changed bytes closer than this are merged into one patch, which costs fewer
+/// `WT_MODIFY` entries than it writes extra bytes.
+constexpr size_t PATCH_MERGE_GAP = 16;
+
+/**
+ * @brief Checks whether two field paths refer to the same value or one lies within the other.
+ * @param a A field path.
+ * @param b A field path.
+ * @return `true` if the paths are equal or one is a dotted prefix of the other.
+ */
+bool overlaps(std::string_view a, std::string_view b) noexcept {
+    if (a.size() > b.size()) std::swap(a, b);
+    return b.compare(0, a.size(), a) == 0 && (b.size() == a.size() || b[a.size()] == '.');
+}
+
+/**
+ * @brief Checks whether a field path can be patched.
+ * @param path The path.
+ * @return `false` for an empty name, a name starting with `$`, or a path within `_id`.
+ */
+bool patchable_path(std::string_view path) noexcept {
+    if (overlaps(path, "_id")) return false;
+    size_t start = 0;
+    while (true) {
+        size_t dot = path.find('.', start);
+        std::string_view name = path.substr(start, dot - start);
+        if (name.empty() || name.front() == '$') return false;
+        if (dot == std::string_view::npos) return true;
+        start = dot + 1;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Compiles an update into its field updates.
+ * @details The update is parsed as the server parses documents, so a JSON integer is a 32-bit
+ * integer if it fits and a 64-bit one otherwise.
+ * @param update_json The update document.
+ * @return The patcher, or `std::nullopt` if the update does not qualify.
+ */
+std::optional<UpdatePatcher> UpdatePatcher::compile(std::string_view update_json) {
+    aevum::bson::doc::Document update;
+    bson_iter_t op;
+    if (!aevum::bson::json::parse(update_json, update).ok() ||
+        !bson_iter_init(&op, update.get())) {
+        return std::nullopt;
+    }
+
+    UpdatePatcher patcher;
+    while (bson_iter_next(&op)) {
+        std::string_view name(bson_iter_key(&op), bson_iter_key_len(&op));
+        bool increment = name == "$inc";
+        bson_iter_t field;
+        if ((!increment && name != "$set") || !BSON_ITER_HOLDS_DOCUMENT(&op) ||
+            !bson_iter_recurse(&op, &field)) {
+            return std::nullopt;
+        }
+        while (bson_iter_next(&field)) {
+            FieldUpdate update_field;
+            update_field.path.assign(bson_iter_key(&field), bson_iter_key_len(&field));
+            update_field.increment = increment;
+            update_field.type = bson_iter_type(&field);
+            switch (update_field.type) {
+                case BSON_TYPE_DOUBLE:
+                    update_field.real = bson_iter_double(&field);
+                    break;
+                case BSON_TYPE_INT32:
+                    update_field.integer = bson_iter_int32(&field);
+                    break;
+                case BSON_TYPE_INT64:
+                    update_field.integer = bson_iter_int64(&field);
+                    break;
+                case BSON_TYPE_BOOL:
+                    if (increment) return std::nullopt;
+                    update_field.integer = bson_iter_bool(&field) ? 1 : 0;
+                    break;
+                default:
+                    return std::nullopt;
+            }
+            if (!patchable_path(update_field.path) || patcher.touches(update_field.path)) {
+                return std::nullopt;
+            }
+            patcher.fields_.push_back(std::move(update_field));
+        }
+    }
+    if (patcher.fields_.empty()) return std::nullopt;
+    return patcher;
+}
+
+/**
+ * @brief Applies the update to a copy of a document and collects the bytes that changed.
+ * @details Each value is overwritten in the copy with `bson_iter_overwrite_*`, which keeps the
+ * layout, and the copy is then compared with the original byte by byte. A copied `Document`
+ * shares the buffer of `before`, which the primary index and readers may hold, so the copy takes
+ * a private buffer with `get_mutable` before any value is overwritten.
+ * @param before The document.
+ * @param after Receives the updated document.
+ * @param patches Receives the runs of changed bytes.
+ * @return `false` if the document does not qualify.
+ */
+bool UpdatePatcher::apply(const aevum::bson::doc::Document &before,
+                          aevum::bson::doc::Document &after,
+                          std::vector<storage::ValuePatch> &patches) const {
+    after = before;
+    if (after.get_mutable() == nullptr) return false;
+    for (const auto &field : fields_) {
+        bson_iter_t iter;
+        if (!aevum::db::index::find_field_path(after, field.path, iter)) return false;
+        bool integer = field.type == BSON_TYPE_INT32 || field.type == BSON_TYPE_INT64;
+        switch (bson_iter_type(&iter)) {
+            case BSON_TYPE_DOUBLE: {
+                double value = field.type == BSON_TYPE_DOUBLE ? field.real
+                                                               : static_cast<double>(field.integer);
+                if (field.increment) {
+                    value += bson_iter_double(&iter);
+                } else if (field.type != BSON_TYPE_DOUBLE) {
+                    return false;
+                }
+                if (!std::isfinite(value)) return false;
+                bson_iter_overwrite_double(&iter, value);
+                break;
+            }
+            case BSON_TYPE_INT32: {
+                int64_t value = field.integer;
+                if (!integer ||
+                    (field.increment && __builtin_add_overflow(bson_iter_int32(&iter),
+                                                               field.integer, &value)) ||
+                    value < std::numeric_limits<int32_t>::min() ||
+                    value > std::numeric_limits<int32_t>::max()) {
+                    return false;
+                }
+                bson_iter_overwrite_int32(&iter, static_cast<int32_t>(value));
+                break;
+            }
+            case BSON_TYPE_INT64: {
+                int64_t value = field.integer;
+                if (!integer ||
+                    (field.increment && __builtin_add_overflow(bson_iter_int64(&iter),
+                                                               field.integer, &value))) {
+                    return false;
+                }
+                bson_iter_overwrite_int64(&iter, value);
+                break;
+            }
+            case BSON_TYPE_BOOL:
+                if (field.increment || field.type != BSON_TYPE_BOOL) return false;
+                bson_iter_overwrite_bool(&iter, field.integer != 0);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    patches.clear();
+    const uint8_t *old_bytes = bson_get_data(before.get());
+    const uint8_t *new_bytes = bson_get_data(after.get());
+    size_t length = before.length();
+    for (size_t i = 0; i < length;) {
+        if (old_bytes[i] == new_bytes[i]) {
+            ++i;
+            continue;
+        }
+        size_t end = i + 1;
+        for (size_t j = end; j < length && j - end < PATCH_MERGE_GAP; ++j) {
+            if (old_bytes[j] != new_bytes[j]) end = j + 1;
+        }
+        patches.push_back({i, std::string(reinterpret_cast<const char *>(new_bytes) + i,
+                                           end - i)});
+        i = end;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether the update may change the value of a field path.
+ * @param path A field path.
+ * @return `true` if the path overlaps one of the update's paths.
+ */
+bool UpdatePatcher::touches(std::string_view path) const noexcept {
+    for (const auto &field : fields_) {
+        if (overlaps(field.path, path)) return true;
+    }
+    return false;
+}
+
+}  // namespace aevum::db::query
@@ -0,0 +1,92 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file update_patch.hpp
+ * @brief Declares the `UpdatePatcher`, which applies `$set` and `$inc` updates of fixed-size
+ * fields as byte patches of the BSON documents.
+ * @details A counter increment changes eight bytes of a document, yet the update engine, which
+ * works on JSON, produces a whole new image that is parsed, stored, and re-indexed. When every
+ * field an update touches already exists with a fixed-size type that the new value keeps, the
+ * new document has the same layout as the old one and differs only in the bytes of those
+ * values. The `UpdatePatcher` computes those bytes natively, so that storage can write them with
+ * `WT_CURSOR::modify` and the primary index can patch its copy in place.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/storage/wiredtiger_store.hpp"
+
+namespace aevum::db::query {
+
+/**
+ * @class UpdatePatcher
+ * @brief A compiled `$set` and `$inc` update, applied to documents as byte patches.
+ *
+ * @details An update qualifies if it consists of `$set` and `$inc` operators only, whose paths do
+ * not overlap or touch `_id`, and whose values are doubles, 32- or 64-bit integers, or, for
+ * `$set`, booleans. A document then qualifies if every path leads to an existing value of the
+ * same family that can hold the result: a double stays a double, a 32-bit integer stays one
+ * unless the result overflows it, and a 64-bit integer keeps its width. Anything else is left to
+ * the update engine, which gives the same result except that a 64-bit integer holding a small
+ * value becomes a 32-bit one there.
+ */
+class UpdatePatcher {
+  public:
+    /**
+     * @brief Compiles an update.
+     * @param update_json The update document.
+     * @return The patcher, or `std::nullopt` if the update does not qualify.
+     */
+    [[nodiscard]] static std::optional<UpdatePatcher> compile(std::string_view update_json);
+
+    /**
+     * @brief Applies the update to a document.
+     * @param before The document.
+     * @param after Receives the updated document, of the same length.
+     * @param patches Receives the runs of bytes that differ, in ascending order of offset; none if
+     *        the update leaves the document as it was.
+     * @return `false` if the document does not qualify, in which case `after` and `patches` are
+     *         unspecified.
+     */
+    [[nodiscard]] bool apply(const aevum::bson::doc::Document &before,
+                             aevum::bson::doc::Document &after,
+                             std::vector<storage::ValuePatch> &patches) const;
+
+    /**
+     * @brief Checks whether the update may change the value of a field path.
+     * @param path A field path, such as that of an index.
+     * @return `true` if `path` is one of the update's paths, lies within one, or contains one.
+     */
+    [[nodiscard]] bool touches(std::string_view path) const noexcept;
+
+  private:
+    /**
+     * @struct FieldUpdate
+     * @brief One field of the update.
+     */
+    struct FieldUpdate {
+        /// The dotted path of the field.
+        std::string path;
+        /// `true` for `$inc`, `false` for `$set`.
+        bool increment{false};
+        /// The BSON type of the value: double, 32- or 64-bit integer, or boolean.
+        bson_type_t type{BSON_TYPE_EOD};
+        /// The value as an integer, for integers and booleans.
+        int64_t integer{0};
+        /// The value as a double, for doubles.
+        double real{0.0};
+    };
+
+    /// The fields of the update, in document order.
+    std::vector<FieldUpdate> fields_;
+};
+
+}  // namespace aevum::db::query
@@ -8,13 +8,17 @@
  * persistence.
  * @details This file provides the concrete implementations for the methods declared in
  * `schema_manager.hpp`. It orchestrates the interaction between the in-memory schema cache,
- * the persistent `WiredTigerStore`, and the Rust-based validation engine.
+ * the persistent `WiredTigerStore`, the native schema matchers, and the Rust-based validation
+ * engine that remains as their fallback.
  */
 #include "aevum/db/schema/schema_manager.hpp"
 
 #include <mutex>
 #include <shared_mutex>
+#include <string>
+#include <vector>
 
+#include "aevum/bson/json/serializer.hpp"
 #include "aevum/db/schema/validator.hpp"
 #include "aevum/util/log/logger.hpp"
 
@@ -36,9 +40,10 @@ SchemaManager::SchemaManager(aevum::db::storage::WiredTigerStore &storage) : sto
  * If no schema is found, the function returns `Status::OK()` immediately, as the absence of a
  * schema implies that any document is valid for that collection.
  *
- * If a schema is found, validation is delegated to the `validate_via_rust` function, which
- * handles the FFI call to the high-performance Rust validation core. A failure from the Rust
- * core results in a logged warning and an `InvalidArgument` status return.
+ * If a schema is found, the document is matched by the schema's compiled matcher without leaving
+ * C++. Only a schema that could not be compiled is delegated to the `validate_via_rust` function,
+ * which serializes both to JSON for the Rust validation core. As there, an empty document is never
+ * valid. A failure results in a logged warning and an `InvalidArgument` status return.
  *
  * @param collection A `std::string_view` identifying the name of the collection.
  * @param doc The `aevum::bson::doc::Document` to be validated.
@@ -50,8 +55,8 @@ SchemaManager::SchemaManager(aevum::db::storage::WiredTigerStore &storage) : sto
 aevum::util::Status SchemaManager::validate(std::string_view collection,
                                             const aevum::bson::doc::Document &doc) const {
     std::string coll_str(collection);
-    aevum::util::log::Logger::debug("SchemaManager: Performing schema validation for collection '" +
-                                    coll_str + "'.");
+    AEVUM_LOG_DEBUG("SchemaManager: Performing schema validation for collection '" + coll_str +
+                    "'.");
     // Acquire a shared (read) lock to enable concurrent schema validation checks.
     std::shared_lock<std::shared_mutex> lock(schemas_lock_);
 
@@ -59,27 +64,80 @@ aevum::util::Status SchemaManager::validate(std::string_view collection,
 
     // If no schema is registered for this collection, validation trivially passes.
     if (it == schemas_.end()) {
-        aevum::util::log::Logger::debug("SchemaManager: No schema found for collection '" +
-                                        coll_str + "'. Validation skipped (OK).");
+        AEVUM_LOG_DEBUG("SchemaManager: No schema found for collection '" + coll_str +
+                        "'. Validation skipped (OK).");
         return aevum::util::Status::OK();
     }
 
-    // Delegate the actual validation logic to the high-performance Rust FFI bridge.
-    bool is_valid = validate_via_rust(doc, it->second);
+    const CompiledSchema &compiled = it->second;
+    bool is_valid = compiled.matcher ? !doc.empty() && compiled.matcher->matches(doc)
+                                     : validate_via_rust(doc, compiled.schema);
 
     if (!is_valid) {
-        aevum::util::log::Logger::warn(
-            "SchemaManager: Document failed schema validation for collection '" + coll_str + "'.");
+        AEVUM_LOG_WARN("SchemaManager: Document failed schema validation for collection '" +
+                       coll_str + "'.");
         return aevum::util::Status::InvalidArgument(
             "Document does not conform to the collection's schema.");
     }
 
-    aevum::util::log::Logger::debug(
+    AEVUM_LOG_DEBUG(
         "SchemaManager: Document successfully validated against schema for collection '" +
         coll_str + "'.");
     return aevum::util::Status::OK();
 }
 
+/**
+ * @brief Validates a batch of BSON documents against the registered schema for their collection.
+ * @details The schema is looked up once under a shared lock. Without a schema, every document is
+ * trivially valid; otherwise each document is matched by the schema's compiled matcher, or, for a
+ * schema that could not be compiled, the whole batch is dispatched to `validate_many_via_rust`,
+ * which validates the documents in parallel within a single FFI call.
+ *
+ * @param collection A `std::string_view` identifying the name of the collection.
+ * @param docs The documents to be validated.
+ * @return One status per document, in input order: `OK()` for a valid document and
+ *         `InvalidArgument` for one that fails the collection's schema.
+ */
+std::vector<aevum::util::Status> SchemaManager::validate_many(
+    std::string_view collection, const std::vector<aevum::bson::doc::Document> &docs) const {
+    std::string coll_str(collection);
+    std::vector<aevum::util::Status> statuses(docs.size(), aevum::util::Status::OK());
+    std::shared_lock<std::shared_mutex> lock(schemas_lock_);
+
+    auto it = schemas_.find(coll_str);
+    if (it == schemas_.end()) {
+        AEVUM_LOG_DEBUG("SchemaManager: No schema found for collection '" + coll_str +
+                        "'. Batch validation skipped (OK).");
+        return statuses;
+    }
+
+    const CompiledSchema &compiled = it->second;
+    std::vector<bool> valid;
+    if (compiled.matcher) {
+        valid.reserve(docs.size());
+        for (const auto &doc : docs) {
+            valid.push_back(!doc.empty() && compiled.matcher->matches(doc));
+        }
+    } else {
+        valid = validate_many_via_rust(docs, compiled.schema);
+    }
+    size_t rejected = 0;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (!valid[i]) {
+            statuses[i] = aevum::util::Status::InvalidArgument(
+                "Document does not conform to the collection's schema.");
+            ++rejected;
+        }
+    }
+
+    if (rejected > 0) {
+        AEVUM_LOG_WARN("SchemaManager: " + std::to_string(rejected) + " of " +
+                       std::to_string(docs.size()) +
+                       " documents failed schema validation for collection '" + coll_str + "'.");
+    }
+    return statuses;
+}
+
 /**
  * @brief Persists a new or updated schema for a collection and updates the in-memory cache.
  * @details This function orchestrates the two-phase process of updating a schema. First, it
@@ -99,8 +157,7 @@ aevum::util::Status SchemaManager::validate(std::string_view collection,
 aevum::util::Status SchemaManager::set_schema(std::string_view collection,
                                               const aevum::bson::doc::Document &schema) {
     std::string coll_str(collection);
-    aevum::util::log::Logger::debug("SchemaManager: Setting schema for collection '" + coll_str +
-                                    "'.");
+    AEVUM_LOG_DEBUG("SchemaManager: Setting schema for collection '" + coll_str + "'.");
 
     // Transform simple "field": "type" schemas into "field": {"$type": "type"}
     // to correctly leverage the matches_query logic in the Rust core.
@@ -134,16 +191,16 @@ aevum::util::Status SchemaManager::set_schema(std::string_view collection,
     // Persist the schema to the dedicated `_schemas` system collection.
     auto status = storage_.put("_schemas", coll_str, persistent_schema);
     if (!status.ok()) {
-        aevum::util::log::Logger::error("SchemaManager: Failed to persist schema for collection '" +
-                                        coll_str + "'. Status: " + status.to_string());
+        AEVUM_LOG_ERROR("SchemaManager: Failed to persist schema for collection '" + coll_str +
+                        "'. Status: " + status.to_string());
         return status;
     }
 
     // After successful persistence, update the in-memory cache with the new schema.
     add_schema_to_cache(coll_str, std::move(final_schema));
 
-    aevum::util::log::Logger::info(
-        "SchemaManager: Successfully set and persisted schema for collection '" + coll_str + "'.");
+    AEVUM_LOG_INFO("SchemaManager: Successfully set and persisted schema for collection '" +
+                   coll_str + "'.");
     return aevum::util::Status::OK();
 }
 
@@ -158,30 +215,40 @@ std::optional<aevum::bson::doc::Document> SchemaManager::get_schema(
     std::shared_lock<std::shared_mutex> lock(schemas_lock_);
     auto it = schemas_.find(std::string(collection));
     if (it != schemas_.end()) {
-        return it->second;
+        return it->second.schema;
     }
     return std::nullopt;
 }
 
 /**
- * @brief Atomically adds a schema to the in-memory cache.
- * @details This function is designed for populating the `schemas_` map in a thread-safe manner.
- * It acquires a `std::unique_lock`, providing exclusive write access to the cache. This blocks
- * all other read and write operations until the insertion is complete, preventing data races.
- * It uses `insert_or_assign` with `std::move` to efficiently transfer ownership of the collection
- * name and schema document into the map, minimizing copies.
+ * @brief Compiles a schema and atomically adds it to the in-memory cache.
+ * @details The schema is compiled into a `Matcher` before any lock is taken, so that validation
+ * never has to parse it again. A schema the matcher does not support is cached without one and
+ * validated by the Rust core. The function then acquires a `std::unique_lock`, providing
+ * exclusive write access to the cache. This blocks all other read and write operations until the
+ * insertion is complete, preventing data races. It uses `insert_or_assign` with `std::move` to
+ * efficiently transfer ownership of the collection name and compiled schema into the map,
+ * minimizing copies.
  *
  * @param collection The collection name `std::string`, which will be moved.
  * @param schema The `aevum::bson::doc::Document` schema, which will be moved.
  */
 void SchemaManager::add_schema_to_cache(std::string collection, aevum::bson::doc::Document schema) {
-    aevum::util::log::Logger::debug("SchemaManager: Caching schema for collection '" + collection +
-                                    "'.");
+    AEVUM_LOG_DEBUG("SchemaManager: Caching schema for collection '" + collection + "'.");
+    CompiledSchema compiled{std::move(schema), std::nullopt};
+    if (!compiled.schema.empty()) {
+        compiled.matcher =
+            aevum::bson::doc::Matcher::compile(aevum::bson::json::to_string(compiled.schema));
+    }
+    if (!compiled.matcher) {
+        AEVUM_LOG_DEBUG("SchemaManager: Schema for collection '" + collection +
+                        "' is validated by the Rust core.");
+    }
     // Acquire an exclusive write lock to ensure the atomicity of the cache update.
     std::unique_lock<std::shared_mutex> lock(schemas_lock_);
 
     // Use insert_or_assign for efficient insertion or update, moving the resources into the map.
-    schemas_.insert_or_assign(std::move(collection), std::move(schema));
+    schemas_.insert_or_assign(std::move(collection), std::move(compiled));
 }
 
 }  // namespace aevum::db::schema
@@ -18,8 +18,10 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/matcher.hpp"
 #include "aevum/db/storage/wiredtiger_store.hpp"
 #include "aevum/util/status.hpp"
 
@@ -38,6 +40,11 @@ namespace aevum::db::schema {
  * This class is also responsible for the entire lifecycle of a schema, from its definition and
  * in-memory caching to its persistence in a dedicated `_schemas` system collection within the
  * `WiredTigerStore`.
+ *
+ * A schema is a query that every document of its collection must match. Each schema is compiled
+ * once, when it is cached, into an `aevum::bson::doc::Matcher` that checks documents directly in
+ * their BSON buffers. Only schemas using operators the matcher does not support are validated by
+ * the Rust core.
  */
 class SchemaManager {
   public:
@@ -63,9 +70,10 @@ class SchemaManager {
     /**
      * @brief Validates a given BSON document against the registered schema for its collection.
      * @details This function performs a highly concurrent, read-locked lookup for the collection's
-     * schema in the in-memory cache. If a schema is found, validation is dispatched to the
-     * `validate_via_rust` function. If no schema is registered for the collection, the document
-     * is considered trivially valid, and the operation succeeds.
+     * schema in the in-memory cache. If a schema is found, the document is checked by its compiled
+     * matcher, or by `validate_via_rust` if the schema could not be compiled. If no schema is
+     * registered for the collection, the document is considered trivially valid, and the
+     * operation succeeds.
      *
      * @param collection The name of the collection to which the document belongs.
      * @param doc The `aevum::bson::doc::Document` to be validated.
@@ -77,6 +85,21 @@ class SchemaManager {
     [[nodiscard]] aevum::util::Status validate(std::string_view collection,
                                                const aevum::bson::doc::Document &doc) const;
 
+    /**
+     * @brief Validates a batch of BSON documents against the registered schema for their
+     * collection.
+     * @details The batch counterpart of `validate`. The schema is looked up once under a shared
+     * lock, and all documents are checked by its compiled matcher or, if the schema could not be
+     * compiled, validated in parallel by a single `validate_many_via_rust` call.
+     *
+     * @param collection The name of the collection to which the documents belong.
+     * @param docs The documents to be validated.
+     * @return One status per document, in input order, with the same meaning as the result of
+     *         `validate`.
+     */
+    [[nodiscard]] std::vector<aevum::util::Status> validate_many(
+        std::string_view collection, const std::vector<aevum::bson::doc::Document> &docs) const;
+
     /**
      * @brief Defines or updates the schema for a specific collection and persists this change.
      * @details This is a write-locked operation that first persists the provided schema document
@@ -103,8 +126,9 @@ class SchemaManager {
     /**
      * @brief Adds a schema document to the in-memory cache.
      * @details This function is primarily intended for internal use during the database startup
-     * sequence to populate the cache from schemas loaded from the `_schemas` collection. It
-     * acquires an exclusive write lock to ensure the cache is updated atomically.
+     * sequence to populate the cache from schemas loaded from the `_schemas` collection. The
+     * schema is compiled before an exclusive write lock is acquired to update the cache
+     * atomically.
      *
      * @param collection The name of the collection, which will be moved into the cache map.
      * @param schema The BSON schema document, which will be moved into the cache map.
@@ -112,6 +136,17 @@ class SchemaManager {
     void add_schema_to_cache(std::string collection, aevum::bson::doc::Document schema);
 
   private:
+    /**
+     * @struct CompiledSchema
+     * @brief A cached schema together with its compiled form.
+     */
+    struct CompiledSchema {
+        /// The schema document, as set.
+        aevum::bson::doc::Document schema;
+        /// The schema compiled as a query; `std::nullopt` if it uses an unsupported operator.
+        std::optional<aevum::bson::doc::Matcher> matcher;
+    };
+
     /**
      * @var storage_
      * @brief A reference to the underlying persistent storage engine, used for all schema
@@ -122,9 +157,9 @@ class SchemaManager {
     /**
      * @var schemas_
      * @brief The in-memory cache for collection schemas. This hash map provides fast lookups
-     * from a collection name (`std::string`) to its corresponding BSON schema `Document`.
+     * from a collection name (`std::string`) to its corresponding schema and compiled matcher.
      */
-    std::unordered_map<std::string, aevum::bson::doc::Document> schemas_;
+    std::unordered_map<std::string, CompiledSchema> schemas_;
 
     /**
      * @var schemas_lock_
@@ -11,6 +11,9 @@
  */
 #include "aevum/db/schema/validator.hpp"
 
+#include <bson/bson.h>
+#include <cstdint>
+
 #include "aevum/bson/json/serializer.hpp"
 #include "aevum/db/ffi.hpp"  // For the rust_validate FFI function.
 
@@ -57,4 +60,52 @@ bool validate_via_rust(const aevum::bson::doc::Document &doc,
     return rust_validate(doc_json.c_str(), schema_json.c_str()) == 1;
 }
 
+/**
+ * @brief Validates a batch of documents by lending their BSON buffers to the Rust FFI.
+ * @details The schema is serialized to JSON once. Each non-empty document contributes its buffer
+ * to the pointer and length arrays handed to `rust_validate_bson`, which reports the positions of
+ * the documents that fail; those positions are mapped back to the input. Empty documents are
+ * never sent and are reported as invalid, matching `validate_via_rust`.
+ *
+ * @param docs The documents to be validated.
+ * @param schema The `aevum::bson::doc::Document` representing the validation rules.
+ * @return One validity flag per document, in input order.
+ */
+std::vector<bool> validate_many_via_rust(const std::vector<aevum::bson::doc::Document> &docs,
+                                         const aevum::bson::doc::Document &schema) noexcept {
+    std::vector<bool> valid(docs.size(), false);
+    if (schema.empty()) {
+        return valid;
+    }
+
+    // Only the non-empty documents are lent to Rust; `origin` maps their positions back.
+    std::vector<const uint8_t *> ptrs;
+    std::vector<uint32_t> lens;
+    std::vector<size_t> origin;
+    ptrs.reserve(docs.size());
+    lens.reserve(docs.size());
+    origin.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (docs[i].empty() || !docs[i].get()) continue;
+        ptrs.push_back(bson_get_data(docs[i].get()));
+        lens.push_back(static_cast<uint32_t>(docs[i].length()));
+        origin.push_back(i);
+        valid[i] = true;
+    }
+    if (ptrs.empty()) {
+        return valid;
+    }
+
+    std::string schema_json = aevum::bson::json::to_string(schema);
+    rust_index_result res =
+        rust_validate_bson(ptrs.data(), lens.data(), ptrs.size(), schema_json.c_str());
+    for (size_t i = 0; i < res.len; ++i) {
+        if (res.indices[i] < origin.size()) {
+            valid[origin[res.indices[i]]] = false;
+        }
+    }
+    rust_free_index_result(res);
+    return valid;
+}
+
 }  // namespace aevum::db::schema
@@ -12,6 +12,8 @@
  */
 #pragma once
 
+#include <vector>
+
 #include "aevum/bson/doc/document.hpp"
 
 namespace aevum::db::schema {
@@ -36,4 +38,19 @@ namespace aevum::db::schema {
 [[nodiscard]] bool validate_via_rust(const aevum::bson::doc::Document &doc,
                                      const aevum::bson::doc::Document &schema) noexcept;
 
+/**
+ * @brief Validates a batch of BSON documents against a BSON schema with a single FFI call.
+ * @details The raw BSON buffers of the documents are lent to `rust_validate_bson`, which checks
+ * them in parallel without serializing them to JSON; only the schema is converted. The verdict
+ * for each document is the same as `validate_via_rust` would give for it alone.
+ *
+ * @param docs The documents to be validated.
+ * @param schema The `aevum::bson::doc::Document` that defines the schema rules.
+ * @return One flag per document, in input order: `true` if the document conforms to the schema,
+ *         `false` if it violates it or is empty. Every flag is `false` if the schema is empty.
+ */
+[[nodiscard]] std::vector<bool> validate_many_via_rust(
+    const std::vector<aevum::bson::doc::Document> &docs,
+    const aevum::bson::doc::Document &schema) noexcept;
+
 }  // namespace aevum::db::schema
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file group_commit.cpp
+ * @brief Implements the `GroupCommitter`, which lets concurrent writers share journal flushes.
+ * @details The flusher thread owns a dedicated WiredTiger session, since sessions must not be
+ * shared between threads, and uses `WT_SESSION::log_flush` to write (`sync=off`) or write and
+ * synchronize (`sync=on`) the journal up to the latest commit.
+ */
+#include "aevum/db/storage/group_commit.hpp"
+
+#include <string>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db::storage {
+
+/**
+ * @brief Starts the flusher thread.
+ * @param conn The open WiredTiger connection.
+ * @param window How long the flusher waits for more writers after the first one arrives.
+ */
+GroupCommitter::GroupCommitter(WT_CONNECTION *conn, std::chrono::microseconds window)
+    : conn_(conn), window_(window), flusher_(&GroupCommitter::run, this) {}
+
+/**
+ * @brief Stops the flusher thread.
+ * @details The flusher drains every ticket drawn before the stop request, so no writer is left
+ * waiting.
+ */
+GroupCommitter::~GroupCommitter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    request_cv_.notify_one();
+    if (flusher_.joinable()) flusher_.join();
+}
+
+/**
+ * @brief Blocks until the transactions committed before the call are persisted at a level.
+ * @details The caller draws the next ticket and, for `FSYNC`, marks the pending flush as
+ * synchronous. It then sleeps until a flush that picked up its ticket has completed.
+ * @param level `JOURNAL` or `FSYNC`; other levels return immediately.
+ * @return `aevum::util::Status::OK()` once the level is reached, or the `IOError` of the failed
+ *         flush that covered the caller.
+ */
+aevum::util::Status GroupCommitter::wait(Durability level) {
+    if (level != Durability::JOURNAL && level != Durability::FSYNC) {
+        return aevum::util::Status::OK();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t ticket = ++requested_;
+    if (level == Durability::FSYNC) fsync_requested_ = true;
+    request_cv_.notify_one();
+
+    const uint64_t &reached = level == Durability::FSYNC ? synced_ : journaled_;
+    done_cv_.wait(lock, [&]() { return reached >= ticket || handled_ >= ticket; });
+    if (reached >= ticket) return aevum::util::Status::OK();
+    return failed_ >= ticket ? last_error_ : aevum::util::Status::OK();
+}
+
+/**
+ * @brief Returns the number of journal flushes issued so far.
+ * @return The number of flushes.
+ */
+uint64_t GroupCommitter::flush_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flushes_;
+}
+
+/**
+ * @brief The body of the flusher thread.
+ * @details Each round waits for an outstanding ticket, optionally lingers for `window_` to let
+ * more writers join, and then flushes the journal once on behalf of every ticket drawn so far.
+ * The lock is released during the flush, so new writers can queue up for the next round.
+ */
+void GroupCommitter::run() {
+    aevum::util::concurrency::set_current_thread_name("GroupCommit");
+#ifdef HAVE_WIREDTIGER
+    WT_SESSION *session = nullptr;
+    int open_ret = conn_->open_session(conn_, nullptr, nullptr, &session);
+    if (open_ret != 0) {
+        AEVUM_LOG_ERROR(std::string("GroupCommit: Failed to open flusher session. Error: ") +
+                        wiredtiger_strerror(open_ret));
+    }
+#endif
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        request_cv_.wait(lock, [&]() { return stop_ || requested_ > handled_; });
+        if (requested_ == handled_) break;  // Stopping with nothing left to flush.
+
+        if (window_.count() > 0 && !stop_) {
+            lock.unlock();
+            std::this_thread::sleep_for(window_);
+            lock.lock();
+        }
+
+        const uint64_t target = requested_;
+        const bool sync = fsync_requested_;
+        fsync_requested_ = false;
+        lock.unlock();
+
+        aevum::util::Status status = aevum::util::Status::OK();
+#ifdef HAVE_WIREDTIGER
+        int ret = session ? session->log_flush(session, sync ? "sync=on" : "sync=off") : open_ret;
+        if (ret != 0) {
+            status = aevum::util::Status::IOError(std::string("WT Log Flush failed: ") +
+                                                  wiredtiger_strerror(ret));
+            AEVUM_LOG_ERROR("GroupCommit: " + status.to_string());
+        }
+#endif
+
+        lock.lock();
+        ++flushes_;
+        handled_ = target;
+        if (status.ok()) {
+            journaled_ = target;
+            if (sync) synced_ = target;
+        } else {
+            failed_ = target;
+            last_error_ = status;
+        }
+        done_cv_.notify_all();
+    }
+    lock.unlock();
+
+#ifdef HAVE_WIREDTIGER
+    if (session) session->close(session, nullptr);
+#endif
+}
+
+}  // namespace aevum::db::storage
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file group_commit.hpp
+ * @brief Declares the `GroupCommitter`, which lets concurrent writers share journal flushes.
+ * @details Flushing WiredTiger's journal costs a `write` system call and, for synchronous
+ * commits, an `fsync`. When every writer flushes on its own, the flush rate caps the write rate.
+ * The group committer instead runs a single flusher thread: writers register the durability they
+ * need and wait, and each flush acknowledges every writer that registered before it started.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#ifdef HAVE_WIREDTIGER
+#include <wiredtiger.h>
+#else
+typedef struct __wt_connection WT_CONNECTION;
+typedef struct __wt_session WT_SESSION;
+#endif
+
+#include "aevum/db/storage/storage_options.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::storage {
+
+/**
+ * @class GroupCommitter
+ * @brief Batches the journal flushes of concurrent writers into shared `log_flush` calls.
+ *
+ * @details Each call to `wait` draws a ticket. The flusher thread repeatedly takes the highest
+ * ticket drawn so far, flushes the journal once (with `fsync` if any of those writers asked for
+ * it), and then acknowledges every ticket up to the one it took. Because a writer commits before
+ * drawing its ticket, a flush started after the ticket was drawn is guaranteed to cover it.
+ * Writers arriving while a flush is in progress are collected into the next one.
+ */
+class GroupCommitter {
+  public:
+    /**
+     * @brief Starts the flusher thread on a connection whose journal is enabled.
+     * @param conn The open WiredTiger connection. It must outlive the committer.
+     * @param window How long the flusher waits for more writers after the first one arrives.
+     */
+    GroupCommitter(WT_CONNECTION *conn, std::chrono::microseconds window);
+
+    /**
+     * @brief Acknowledges all outstanding writers with a final flush and joins the flusher thread.
+     */
+    ~GroupCommitter();
+
+    // The committer owns a thread and a WiredTiger session, so it is neither copyable nor movable.
+    GroupCommitter(const GroupCommitter &) = delete;
+    GroupCommitter &operator=(const GroupCommitter &) = delete;
+    GroupCommitter(GroupCommitter &&) = delete;
+    GroupCommitter &operator=(GroupCommitter &&) = delete;
+
+    /**
+     * @brief Blocks until every transaction committed before the call is persisted at the
+     * requested level.
+     * @param level `JOURNAL` to wait for the journal to reach the operating system, or `FSYNC` to
+     *        wait for it to reach stable storage. Other levels return immediately.
+     * @return `aevum::util::Status::OK()` once the level is reached, or an `IOError` if the flush
+     *         that was to cover the caller failed.
+     */
+    [[nodiscard]] aevum::util::Status wait(Durability level);
+
+    /**
+     * @brief Returns the number of journal flushes issued so far, successful or not.
+     * @details Together with the number of writers, this shows how well flushes are shared.
+     * @return The number of flushes.
+     */
+    [[nodiscard]] uint64_t flush_count() const;
+
+  private:
+    /// The connection the flusher opens its session on.
+    WT_CONNECTION *conn_;
+    /// How long the flusher lingers for more writers before flushing.
+    std::chrono::microseconds window_;
+
+    /// Guards every field below.
+    mutable std::mutex mutex_;
+    /// Signaled when a writer draws a ticket or the committer is stopping.
+    std::condition_variable request_cv_;
+    /// Signaled after every flush.
+    std::condition_variable done_cv_;
+    /// The last ticket drawn by a writer.
+    uint64_t requested_{0};
+    /// `true` if a writer that has not yet been picked up by a flush asked for `FSYNC`.
+    bool fsync_requested_{false};
+    /// The last ticket picked up by a flush, whether it succeeded or not.
+    uint64_t handled_{0};
+    /// Every ticket up to this one has reached the operating system.
+    uint64_t journaled_{0};
+    /// Every ticket up to this one has reached stable storage.
+    uint64_t synced_{0};
+    /// Every ticket up to this one was covered by a failed flush, unless it was covered by a
+    /// later successful one.
+    uint64_t failed_{0};
+    /// The number of flushes issued so far.
+    uint64_t flushes_{0};
+    /// The error returned by the most recent failed flush.
+    aevum::util::Status last_error_;
+    /// `true` once the destructor has asked the flusher to exit.
+    bool stop_{false};
+    /// The flusher thread.
+    std::thread flusher_;
+
+    /**
+     * @brief The body of the flusher thread.
+     */
+    void run();
+};
+
+}  // namespace aevum::db::storage
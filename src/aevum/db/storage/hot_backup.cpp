@@ -0,0 +1,464 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file hot_backup.cpp
+ * @brief Implements `HotBackup`, the online backup of the data directory.
+ */
+#include "aevum/db/storage/hot_backup.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <utility>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/defer.hpp"
+#include "aevum/util/log/logger.hpp"
+#include "aevum/util/time/timestamp.hpp"
+
+namespace aevum::db::storage {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// The bytes copied between two checks for cancellation.
+constexpr uint64_t COPY_CHUNK = 8 << 20;
+
+/// The granularity at which WiredTiger tracks modified blocks for incremental backups.
+constexpr const char *BLOCK_GRANULARITY = "16MB";
+
+/**
+ * @brief Formats the last system error of a file operation.
+ * @param what The operation.
+ * @param path The file.
+ * @return The message.
+ */
+std::string io_error(const char *what, const std::string &path) {
+    return std::string(what) + " '" + path + "': " + std::strerror(errno);
+}
+
+/**
+ * @brief Copies bytes between two open files at the same offsets.
+ * @details `copy_file_range` keeps the copy in the kernel and lets filesystems that can share
+ * blocks do so; where it is not available across the two files, the bytes go through a buffer.
+ * @param in The source file.
+ * @param out The target file.
+ * @param offset The first byte to copy.
+ * @param length The bytes to copy; the copy also stops at the end of the source.
+ * @param progress Called after each chunk with its size; returning `false` cancels the copy.
+ * @return `true` once copied, `false` on an error (with `errno` set) or cancellation.
+ */
+template <typename Progress>
+bool copy_bytes(int in, int out, uint64_t offset, uint64_t length, Progress &&progress) {
+    bool kernel_copy = true;
+    std::vector<char> buffer;
+    while (length > 0) {
+        size_t chunk = static_cast<size_t>(std::min(length, COPY_CHUNK));
+        ssize_t copied = -1;
+        if (kernel_copy) {
+            loff_t in_offset = static_cast<loff_t>(offset);
+            loff_t out_offset = static_cast<loff_t>(offset);
+            copied = ::copy_file_range(in, &in_offset, out, &out_offset, chunk, 0);
+            if (copied < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL ||
+                               errno == EOPNOTSUPP)) {
+                kernel_copy = false;
+                continue;
+            }
+        } else {
+            if (buffer.empty()) buffer.resize(COPY_CHUNK);
+            copied = ::pread(in, buffer.data(), chunk, static_cast<off_t>(offset));
+            for (ssize_t written = 0; copied > 0 && written < copied;) {
+                ssize_t n = ::pwrite(out, buffer.data() + written,
+                                     static_cast<size_t>(copied - written),
+                                     static_cast<off_t>(offset) + written);
+                if (n < 0) return false;
+                written += n;
+            }
+        }
+        if (copied < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (copied == 0) break;
+        offset += static_cast<uint64_t>(copied);
+        length -= static_cast<uint64_t>(copied);
+        if (!progress(static_cast<uint64_t>(copied))) {
+            errno = ECANCELED;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a file durably under its final name, through a temporary file and a rename.
+ * @param path The file.
+ * @param contents The contents.
+ * @return `true` on success.
+ */
+bool write_file_durably(const std::string &path, const std::string &contents) {
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool written = ::write(fd, contents.data(), contents.size()) ==
+                       static_cast<ssize_t>(contents.size()) &&
+                   ::fsync(fd) == 0;
+    ::close(fd);
+    return written && ::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @brief Synchronizes a directory, so that the names created in it are durable.
+ * @param path The directory.
+ */
+void sync_directory(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return;
+    (void)::fsync(fd);
+    ::close(fd);
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the name of a backup state, as reported by the `backup_status` action.
+ * @param state The state.
+ * @return `"idle"`, `"running"`, `"succeeded"`, or `"failed"`.
+ */
+const char *to_string(BackupState state) noexcept {
+    switch (state) {
+        case BackupState::RUNNING:
+            return "running";
+        case BackupState::SUCCEEDED:
+            return "succeeded";
+        case BackupState::FAILED:
+            return "failed";
+        case BackupState::IDLE:
+        default:
+            return "idle";
+    }
+}
+
+/**
+ * @brief Constructs an idle runner.
+ * @param storage The store to back up.
+ */
+HotBackup::HotBackup(WiredTigerStore &storage) : storage_(storage) {}
+
+/**
+ * @brief Cancels a backup in progress and joins its thread.
+ * @details The copy stops at its next chunk and the backup cursor is closed, releasing the
+ * checkpoint it pinned, before the store can be closed.
+ */
+HotBackup::~HotBackup() {
+    stop_.store(true, std::memory_order_relaxed);
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        thread = std::move(thread_);
+    }
+    if (thread.joinable()) thread.join();
+}
+
+/**
+ * @brief Starts a backup in the background.
+ * @param destination The directory to write to.
+ * @param incremental `true` to copy only the blocks modified since the destination's backup.
+ * @return `aevum::util::Status::OK()` once the backup is running, or why it cannot start.
+ */
+aevum::util::Status HotBackup::start(const std::string &destination, bool incremental) {
+#ifdef HAVE_WIREDTIGER
+    if (storage_.connection() == nullptr) {
+        return aevum::util::Status::NotSupported("The storage engine is not open");
+    }
+    if (destination.empty()) {
+        return aevum::util::Status::InvalidArgument("A backup needs a destination path");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (status_.state == BackupState::RUNNING) {
+        return aevum::util::Status::InvalidArgument("A backup is already running");
+    }
+
+    std::error_code ec;
+    fs::path target = fs::absolute(destination, ec).lexically_normal();
+    if (ec) return aevum::util::Status::InvalidArgument("Invalid destination: " + ec.message());
+    fs::path data = fs::absolute(storage_.base_path(), ec).lexically_normal();
+    auto inside = std::mismatch(data.begin(), data.end(), target.begin(), target.end());
+    if (inside.first == data.end() ||
+        (fs::exists(target, ec) && fs::equivalent(target, data, ec))) {
+        return aevum::util::Status::InvalidArgument(
+            "The destination must not be inside the data directory");
+    }
+    std::string source_id;
+    if (incremental) {
+        std::ifstream marker(target / MARKER);
+        if (!(marker >> source_id) || source_id.empty()) {
+            return aevum::util::Status::InvalidArgument(
+                "The destination holds no complete backup to extend; take a full backup");
+        }
+    } else if (fs::exists(target, ec) && !fs::is_empty(target, ec)) {
+        return aevum::util::Status::InvalidArgument(
+            "The destination of a full backup must be missing or empty");
+    } else if (!fs::create_directories(target, ec) && ec) {
+        return aevum::util::Status::IOError("Failed to create the backup directory: " +
+                                            ec.message());
+    }
+
+    // The previous backup's thread has recorded its result and is about to exit.
+    if (thread_.joinable()) thread_.join();
+    uint64_t now = aevum::util::time::now_unix_ms();
+    status_ = BackupStatus();
+    status_.state = BackupState::RUNNING;
+    status_.destination = target.string();
+    status_.incremental = incremental;
+    status_.backup_id = "aevum_" + std::to_string(now);
+    status_.started_unix_ms = now;
+    thread_ = std::thread(&HotBackup::run, this, status_.destination, incremental,
+                          std::move(source_id), status_.backup_id);
+    return aevum::util::Status::OK();
+#else
+    (void)destination;
+    (void)incremental;
+    return aevum::util::Status::NotSupported("WiredTiger support is disabled in this build");
+#endif
+}
+
+/**
+ * @brief Returns the progress of the current or last backup.
+ * @return The snapshot.
+ */
+BackupStatus HotBackup::status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return status_;
+}
+
+/**
+ * @brief Records bytes copied.
+ * @param bytes The bytes.
+ */
+void HotBackup::note_bytes(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.bytes_copied += bytes;
+}
+
+/**
+ * @brief Copies the files of a backup; the body of the backup thread.
+ * @details A checkpoint is taken first, so that a server running without a journal backs up its
+ * latest writes rather than those of its last periodic checkpoint.
+ * @param destination The directory to write to.
+ * @param incremental `true` for an incremental backup.
+ * @param source_id The backup id an incremental backup extends.
+ * @param backup_id The id of the new backup.
+ */
+void HotBackup::run(std::string destination, bool incremental, std::string source_id,
+                    std::string backup_id) {
+    aevum::util::concurrency::set_current_thread_name("Backup");
+    AEVUM_LOG_INFO(std::string("Backup: Starting ") + (incremental ? "an incremental" : "a full") +
+                   " backup into '" + destination + "'.");
+    aevum::util::Status result = aevum::util::Status::OK();
+#ifdef HAVE_WIREDTIGER
+    std::string marker = (fs::path(destination) / MARKER).string();
+    WT_SESSION *session = nullptr;
+    WT_CURSOR *cursor = nullptr;
+    WT_CONNECTION *conn = storage_.connection();
+    int ret = conn->open_session(conn, nullptr, nullptr, &session);
+    if (ret == 0) ret = session->checkpoint(session, nullptr);
+    if (ret == 0) {
+        std::string config = incremental ? "incremental=(src_id=\"" + source_id +
+                                               "\",this_id=\"" + backup_id + "\")"
+                                         : std::string("incremental=(enabled=true,granularity=") +
+                                               BLOCK_GRANULARITY + ",this_id=\"" + backup_id +
+                                               "\")";
+        ret = session->open_cursor(session, "backup:", nullptr, config.c_str(), &cursor);
+        if (ret != 0 && incremental) {
+            result = aevum::util::Status::InvalidArgument(
+                std::string("The backup in the destination can no longer be extended (") +
+                wiredtiger_strerror(ret) + "); take a full backup");
+        }
+    }
+    if (ret != 0 && result.ok()) {
+        result = aevum::util::Status::IOError(std::string("Failed to open the backup cursor: ") +
+                                              wiredtiger_strerror(ret));
+    }
+    if (result.ok()) {
+        // The copy is not a backup while it is being updated.
+        if (incremental) fs::remove(marker);
+        result = copy_files(cursor, destination, incremental);
+    }
+    if (result.ok()) {
+        sync_directory(destination);
+        if (!write_file_durably(marker, backup_id + "\n")) {
+            result = aevum::util::Status::IOError(io_error("Failed to write", marker));
+        }
+        sync_directory(destination);
+    }
+    if (cursor != nullptr) cursor->close(cursor);
+    if (session != nullptr) session->close(session, nullptr);
+#else
+    (void)destination;
+    (void)source_id;
+    (void)backup_id;
+    result = aevum::util::Status::NotSupported("WiredTiger support is disabled in this build");
+#endif
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.finished_unix_ms = aevum::util::time::now_unix_ms();
+    if (result.ok()) {
+        status_.state = BackupState::SUCCEEDED;
+        AEVUM_LOG_INFO("Backup: Completed backup '" + status_.backup_id + "': " +
+                       std::to_string(status_.files_copied) + " files, " +
+                       std::to_string(status_.bytes_copied) + " bytes.");
+    } else {
+        status_.state = BackupState::FAILED;
+        status_.error = result.message();
+        AEVUM_LOG_ERROR("Backup: Backup into '" + status_.destination +
+                        "' failed: " + result.to_string());
+    }
+}
+
+/**
+ * @brief Copies the files listed by an open backup cursor.
+ * @details The list is read in full first, so that the progress knows its total. In an
+ * incremental backup, WiredTiger reports each file as a list of modified ranges, or as a whole
+ * for files created since the previous backup, and files of the destination it no longer lists,
+ * such as dropped tables and removed journal files, are deleted.
+ * @param cursor The backup cursor.
+ * @param destination The directory to write to.
+ * @param incremental `true` to copy only the modified ranges of each file.
+ * @return `aevum::util::Status::OK()` once every file is copied, or the status of the failure.
+ */
+aevum::util::Status HotBackup::copy_files(WT_CURSOR *cursor, const std::string &destination,
+                                          bool incremental) {
+#ifdef HAVE_WIREDTIGER
+    std::vector<std::string> files;
+    int ret = 0;
+    while ((ret = cursor->next(cursor)) == 0) {
+        const char *name = nullptr;
+        if ((ret = cursor->get_key(cursor, &name)) != 0) break;
+        files.emplace_back(name);
+    }
+    if (ret != WT_NOTFOUND) {
+        return aevum::util::Status::IOError(std::string("Failed to list the backup files: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        status_.files_total = files.size();
+    }
+
+    if (incremental) {
+        std::set<std::string> listed(files.begin(), files.end());
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(destination, ec)) {
+            std::string name = entry.path().filename().string();
+            if (entry.is_regular_file(ec) && listed.count(name) == 0 && name != MARKER) {
+                fs::remove(entry.path(), ec);
+            }
+        }
+    }
+
+    WT_SESSION *session = cursor->session;
+    for (const auto &name : files) {
+        if (stop_.load(std::memory_order_relaxed)) {
+            return aevum::util::Status::IOError("The backup was cancelled by a shutdown");
+        }
+        std::string source = (fs::path(storage_.base_path()) / name).string();
+        std::string target = (fs::path(destination) / name).string();
+        if (!incremental) {
+            if (auto status = copy_file(source, target, 0, 0, true); !status.ok()) return status;
+        } else {
+            std::string config = "incremental=(file=" + name + ")";
+            WT_CURSOR *ranges = nullptr;
+            ret = session->open_cursor(session, nullptr, cursor, config.c_str(), &ranges);
+            if (ret != 0) {
+                return aevum::util::Status::IOError("Failed to read the modified ranges of '" +
+                                                    name + "': " + wiredtiger_strerror(ret));
+            }
+            AEVUM_DEFER([&]() { ranges->close(ranges); });
+            while ((ret = ranges->next(ranges)) == 0) {
+                uint64_t offset = 0, size = 0, type = 0;
+                if ((ret = ranges->get_key(ranges, &offset, &size, &type)) != 0) break;
+                bool whole = type == WT_BACKUP_FILE;
+                auto status =
+                    copy_file(source, target, whole ? 0 : offset, whole ? 0 : size, whole);
+                if (!status.ok()) return status;
+            }
+            if (ret != WT_NOTFOUND) {
+                return aevum::util::Status::IOError("Failed to read the modified ranges of '" +
+                                                    name + "': " + wiredtiger_strerror(ret));
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++status_.files_copied;
+    }
+    return aevum::util::Status::OK();
+#else
+    (void)cursor;
+    (void)destination;
+    (void)incremental;
+    return aevum::util::Status::NotSupported("WiredTiger support is disabled in this build");
+#endif
+}
+
+/**
+ * @brief Copies a range of a file, or all of it.
+ * @details A whole file is first offered to `FICLONE`, which shares its blocks copy-on-write on
+ * filesystems such as XFS and Btrfs and costs no I/O; the clone is a snapshot, unaffected by
+ * later writes to the source.
+ * @param source The path of the file in the data directory.
+ * @param target The path of the copy.
+ * @param offset The first byte of the range.
+ * @param length The length of the range, or 0 for everything from `offset` to the end.
+ * @param whole `true` to replace the copy with the whole file, allowing a clone.
+ * @return `aevum::util::Status::OK()` once copied, or an `IOError`.
+ */
+aevum::util::Status HotBackup::copy_file(const std::string &source, const std::string &target,
+                                         uint64_t offset, uint64_t length, bool whole) {
+    int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return aevum::util::Status::IOError(io_error("Failed to open", source));
+    AEVUM_DEFER([&]() { ::close(in); });
+    int out = ::open(target.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (whole ? O_TRUNC : 0), 0644);
+    if (out < 0) return aevum::util::Status::IOError(io_error("Failed to open", target));
+    AEVUM_DEFER([&]() { ::close(out); });
+
+    bool copied = false;
+#ifdef FICLONE
+    struct stat info;
+    if (whole && ::fstat(in, &info) == 0 && ::ioctl(out, FICLONE, in) == 0) {
+        note_bytes(static_cast<uint64_t>(info.st_size));
+        copied = true;
+    }
+#endif
+    if (!copied) {
+        uint64_t span = length > 0 ? length : std::numeric_limits<uint64_t>::max();
+        copied = copy_bytes(in, out, offset, span, [this](uint64_t bytes) {
+            note_bytes(bytes);
+            return !stop_.load(std::memory_order_relaxed);
+        });
+    }
+    if (!copied) {
+        if (errno == ECANCELED) {
+            return aevum::util::Status::IOError("The backup was cancelled by a shutdown");
+        }
+        return aevum::util::Status::IOError(io_error("Failed to copy", source));
+    }
+    if (::fsync(out) != 0) return aevum::util::Status::IOError(io_error("Failed to sync", target));
+    return aevum::util::Status::OK();
+}
+
+}  // namespace aevum::db::storage
@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file hot_backup.hpp
+ * @brief Declares `HotBackup`, which copies the data directory while the server keeps writing.
+ * @details A WiredTiger `backup:` cursor pins the last checkpoint and lists the files that make
+ * up a consistent copy of the database: the tables as of that checkpoint and the journal written
+ * since. While the cursor is open, WiredTiger keeps writing but never overwrites the blocks the
+ * checkpoint refers to, so the files can be copied at leisure without holding up any writer.
+ *
+ * Every backup also starts block modification tracking under a new backup id. An incremental
+ * backup names the id of the backup it extends and receives, for each file, only the ranges
+ * modified since, which are written over the previous copy in place.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::storage {
+
+/**
+ * @enum BackupState
+ * @brief The state of the last backup of a `HotBackup`.
+ */
+enum class BackupState {
+    /// No backup has been started since the server started.
+    IDLE,
+    /// A backup is copying files.
+    RUNNING,
+    /// The last backup completed.
+    SUCCEEDED,
+    /// The last backup failed or was cancelled.
+    FAILED,
+};
+
+/**
+ * @brief Returns the name of a backup state, as reported by the `backup_status` action.
+ * @param state The state.
+ * @return `"idle"`, `"running"`, `"succeeded"`, or `"failed"`.
+ */
+[[nodiscard]] const char *to_string(BackupState state) noexcept;
+
+/**
+ * @struct BackupStatus
+ * @brief The progress of the current or last backup.
+ */
+struct BackupStatus {
+    /// The state of the backup.
+    BackupState state = BackupState::IDLE;
+    /// The directory the backup is written to.
+    std::string destination;
+    /// `true` if only the blocks modified since the destination's previous backup are copied.
+    bool incremental = false;
+    /// The id under which the backup tracks block modifications for the next incremental one.
+    std::string backup_id;
+    /// The files the backup consists of.
+    uint64_t files_total = 0;
+    /// The files copied so far.
+    uint64_t files_copied = 0;
+    /// The bytes copied so far; cloned files count in full.
+    uint64_t bytes_copied = 0;
+    /// The start of the backup, in milliseconds since the Unix epoch.
+    uint64_t started_unix_ms = 0;
+    /// The end of the backup, in milliseconds since the Unix epoch, or 0 while it runs.
+    uint64_t finished_unix_ms = 0;
+    /// Why the backup failed, if it did.
+    std::string error;
+};
+
+/**
+ * @class HotBackup
+ * @brief Runs one online backup at a time, on a thread of its own.
+ *
+ * @details A full backup is written into a new or empty directory. Files are cloned with
+ * `FICLONE` where the destination's filesystem shares blocks copy-on-write with the source, and
+ * otherwise copied with `copy_file_range`, which stays in the kernel. Hard links are never used:
+ * WiredTiger rewrites its files in place, so a linked copy would change with the database.
+ *
+ * The destination receives an `AEVUM_BACKUP` file holding the backup id, written last. An
+ * incremental backup reads it to find the id to extend, removes it while the copy is being
+ * updated, and writes the new id once it completes, so a destination whose update was
+ * interrupted is recognizably not a backup and must be taken again in full. WiredTiger tracks
+ * modifications for the two most recent ids only, so every destination must be brought up to
+ * date in turn, or taken in full, before another is extended.
+ *
+ * A backup restores by starting `aevumd` on a copy of the destination.
+ */
+class HotBackup {
+  public:
+    /// The name of the file that marks a complete backup and holds its id.
+    static constexpr std::string_view MARKER = "AEVUM_BACKUP";
+
+    /**
+     * @brief Constructs an idle runner.
+     * @param storage The store to back up. It must outlive the runner.
+     */
+    explicit HotBackup(WiredTigerStore &storage);
+
+    /**
+     * @brief Cancels a backup in progress and joins its thread.
+     */
+    ~HotBackup();
+
+    // The runner owns a thread that refers back to it, so it is neither copyable nor movable.
+    HotBackup(const HotBackup &) = delete;
+    HotBackup &operator=(const HotBackup &) = delete;
+    HotBackup(HotBackup &&) = delete;
+    HotBackup &operator=(HotBackup &&) = delete;
+
+    /**
+     * @brief Starts a backup in the background.
+     * @param destination The directory to write to. A full backup needs it missing or empty; an
+     *        incremental one needs a complete backup in it.
+     * @param incremental `true` to copy only the blocks modified since the destination's backup.
+     * @return `aevum::util::Status::OK()` once the backup is running, `InvalidArgument` if a
+     *         backup is already running or the destination does not suit the kind of backup, or
+     *         `NotSupported` if the server has no storage engine.
+     */
+    [[nodiscard]] aevum::util::Status start(const std::string &destination, bool incremental);
+
+    /**
+     * @brief Returns the progress of the current or last backup.
+     * @return The snapshot.
+     */
+    [[nodiscard]] BackupStatus status() const;
+
+  private:
+    /// The store to back up.
+    WiredTigerStore &storage_;
+
+    /// Guards `status_` and `thread_`.
+    mutable std::mutex mutex_;
+    /// The progress of the current or last backup.
+    BackupStatus status_;
+    /// `true` once the destructor has asked the backup to stop.
+    std::atomic<bool> stop_{false};
+    /// The thread of the current or last backup.
+    std::thread thread_;
+
+    /**
+     * @brief Copies the files of a backup; the body of the backup thread.
+     * @param destination The directory to write to.
+     * @param incremental `true` for an incremental backup.
+     * @param source_id The backup id an incremental backup extends.
+     * @param backup_id The id of the new backup.
+     */
+    void run(std::string destination, bool incremental, std::string source_id,
+             std::string backup_id);
+
+    /**
+     * @brief Copies the files listed by an open backup cursor.
+     * @param cursor The backup cursor.
+     * @param destination The directory to write to.
+     * @param incremental `true` to copy only the modified ranges of each file.
+     * @return `aevum::util::Status::OK()` once every file is copied, or the status of the
+     *         failure.
+     */
+    aevum::util::Status copy_files(WT_CURSOR *cursor, const std::string &destination,
+                                   bool incremental);
+
+    /**
+     * @brief Copies a range of a file, or all of it.
+     * @param source The path of the file in the data directory.
+     * @param target The path of the copy.
+     * @param offset The first byte of the range.
+     * @param length The length of the range, or 0 for everything from `offset` to the end.
+     * @param whole `true` to replace the copy with the whole file, allowing a clone.
+     * @return `aevum::util::Status::OK()` once copied, or an `IOError`.
+     */
+    aevum::util::Status copy_file(const std::string &source, const std::string &target,
+                                  uint64_t offset, uint64_t length, bool whole);
+
+    /**
+     * @brief Records bytes copied.
+     * @param bytes The bytes.
+     */
+    void note_bytes(uint64_t bytes);
+};
+
+}  // namespace aevum::db::storage
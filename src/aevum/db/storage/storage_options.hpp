@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file storage_options.hpp
+ * @brief Defines the durability levels and the configuration of the `WiredTigerStore`.
+ * @details Every write to the store is committed to WiredTiger's in-memory state first. How far it
+ * is pushed towards the disk before the write is acknowledged is its durability level, which can
+ * be chosen per request so that bulk ingestion can trade durability for throughput while other
+ * collections keep synchronous commits. The remaining options size WiredTiger's cache and its
+ * eviction, and choose the compression, page layout, and key format of newly created tables, and
+ * whether the documents of user collections are stored with a field-name dictionary.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace aevum::db::storage {
+
+/**
+ * @enum Durability
+ * @brief How far a committed write is persisted before it is acknowledged.
+ */
+enum class Durability : uint8_t {
+    /// Use the store's configured default level.
+    DEFAULT = 0,
+    /// Acknowledge once committed in memory; the write is persisted by a later flush or checkpoint
+    /// and can be lost if the process crashes.
+    NONE = 1,
+    /// Acknowledge once the journal record has been written to the operating system; the write
+    /// survives a process crash but not a power failure.
+    JOURNAL = 2,
+    /// Acknowledge once the journal record has been flushed to stable storage with `fsync`.
+    FSYNC = 3
+};
+
+/**
+ * @brief Converts a `Durability` enumerator into its canonical string representation.
+ * @param durability The durability level to convert.
+ * @return `"default"`, `"none"`, `"journal"`, or `"fsync"`.
+ */
+[[nodiscard]] constexpr std::string_view to_string(Durability durability) noexcept {
+    switch (durability) {
+        case Durability::NONE:
+            return "none";
+        case Durability::JOURNAL:
+            return "journal";
+        case Durability::FSYNC:
+            return "fsync";
+        case Durability::DEFAULT:
+        default:
+            return "default";
+    }
+}
+
+/**
+ * @brief Parses the canonical string representation of a `Durability` level.
+ * @param name The string to parse (`"default"`, `"none"`, `"journal"`, or `"fsync"`).
+ * @return The parsed level, or `std::nullopt` if `name` is not recognized.
+ */
+[[nodiscard]] constexpr std::optional<Durability> durability_from_string(
+    std::string_view name) noexcept {
+    if (name == "default") return Durability::DEFAULT;
+    if (name == "none") return Durability::NONE;
+    if (name == "journal") return Durability::JOURNAL;
+    if (name == "fsync") return Durability::FSYNC;
+    return std::nullopt;
+}
+
+/**
+ * @enum BlockCompressor
+ * @brief The compressor WiredTiger applies to the blocks of new tables and to the journal.
+ * @details `SNAPPY` and `ZSTD` come from WiredTiger extensions, either built into the library
+ * (see `is_compressor_built_in`) or loaded from a shared object when the store is opened. A
+ * compressor that cannot be loaded is replaced by `NONE`; see `WiredTigerStore::init`.
+ */
+enum class BlockCompressor : uint8_t {
+    /// Blocks are stored uncompressed.
+    NONE = 0,
+    /// Fast compression with a moderate ratio.
+    SNAPPY = 1,
+    /// Slower compression with a higher ratio.
+    ZSTD = 2
+};
+
+/**
+ * @brief Converts a `BlockCompressor` enumerator into its canonical string representation.
+ * @param compressor The compressor to convert.
+ * @return `"none"`, `"snappy"`, or `"zstd"`, which are also WiredTiger's compressor names.
+ */
+[[nodiscard]] constexpr std::string_view to_string(BlockCompressor compressor) noexcept {
+    switch (compressor) {
+        case BlockCompressor::SNAPPY:
+            return "snappy";
+        case BlockCompressor::ZSTD:
+            return "zstd";
+        case BlockCompressor::NONE:
+        default:
+            return "none";
+    }
+}
+
+/**
+ * @brief Parses the canonical string representation of a `BlockCompressor`.
+ * @param name The string to parse (`"none"`, `"snappy"`, or `"zstd"`).
+ * @return The parsed compressor, or `std::nullopt` if `name` is not recognized.
+ */
+[[nodiscard]] constexpr std::optional<BlockCompressor> block_compressor_from_string(
+    std::string_view name) noexcept {
+    if (name == "none") return BlockCompressor::NONE;
+    if (name == "snappy") return BlockCompressor::SNAPPY;
+    if (name == "zstd") return BlockCompressor::ZSTD;
+    return std::nullopt;
+}
+
+/**
+ * @brief Checks whether this build's WiredTiger was configured with a compressor built in.
+ * @details This reflects what CMake found when it configured the build, which a WiredTiger
+ * library cached in `third_party/dist` need not match, so the store still probes the compressor
+ * when it opens.
+ * @param compressor The compressor to check.
+ * @return `true` if `compressor` is expected to be built in, and for `NONE`.
+ */
+[[nodiscard]] constexpr bool is_compressor_built_in(BlockCompressor compressor) noexcept {
+    switch (compressor) {
+        case BlockCompressor::SNAPPY:
+#ifdef AEVUM_HAVE_SNAPPY
+            return true;
+#else
+            return false;
+#endif
+        case BlockCompressor::ZSTD:
+#ifdef AEVUM_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        case BlockCompressor::NONE:
+        default:
+            return true;
+    }
+}
+
+/**
+ * @enum KeyFormat
+ * @brief The type of the keys of a collection's table, which holds its documents by `_id`.
+ */
+enum class KeyFormat : uint8_t {
+    /// String `_id`s, stored as NUL-terminated strings (`key_format=S`).
+    STRING = 0,
+    /// Integer `_id`s, stored as packed 64-bit integers (`key_format=q`) and ordered numerically.
+    INT64 = 1
+};
+
+/**
+ * @brief Converts a `KeyFormat` into its canonical string representation.
+ * @param format The key format to convert.
+ * @return `"string"` or `"int64"`.
+ */
+[[nodiscard]] constexpr std::string_view to_string(KeyFormat format) noexcept {
+    return format == KeyFormat::INT64 ? "int64" : "string";
+}
+
+/**
+ * @brief Parses the canonical string representation of a `KeyFormat`.
+ * @param name The string to parse (`"string"` or `"int64"`).
+ * @return The parsed format, or `std::nullopt` if `name` is not recognized.
+ */
+[[nodiscard]] constexpr std::optional<KeyFormat> key_format_from_string(
+    std::string_view name) noexcept {
+    if (name == "string") return KeyFormat::STRING;
+    if (name == "int64") return KeyFormat::INT64;
+    return std::nullopt;
+}
+
+/**
+ * @struct StorageOptions
+ * @brief The configuration of a `WiredTigerStore`.
+ */
+struct StorageOptions {
+    /// `true` to enable WiredTiger's write-ahead journal. Without it, `JOURNAL` and `FSYNC`
+    /// writes are only as durable as `NONE` until the connection is closed.
+    bool journal = true;
+    /// The level applied to writes that request `Durability::DEFAULT`.
+    Durability durability = Durability::JOURNAL;
+    /**
+     * @brief How long the group committer waits for more writers to arrive before flushing the
+     * journal. Writers that arrive while a flush is in progress always share the next one, so
+     * the default of zero adds no latency.
+     */
+    std::chrono::microseconds group_commit_window{0};
+
+    /// The size of WiredTiger's page cache, in megabytes.
+    uint64_t cache_size_mb = 128;
+    /// The number of eviction worker threads (1-20), or 0 to keep WiredTiger's default.
+    uint32_t eviction_threads = 0;
+    /// The cache usage, as a percentage, that eviction works to stay below (10-99), or 0 to keep
+    /// WiredTiger's default.
+    uint32_t eviction_target = 0;
+    /// The compressor of new tables and of the journal.
+    BlockCompressor block_compressor = BlockCompressor::NONE;
+    /// The maximum leaf page size of new tables, in kilobytes, or 0 to keep WiredTiger's default.
+    uint32_t leaf_page_max_kb = 0;
+    /// Per-collection overrides of `leaf_page_max_kb`, keyed by collection name.
+    std::unordered_map<std::string, uint32_t> collection_leaf_page_max_kb;
+    /**
+     * @brief The key formats of new collection tables other than `KeyFormat::STRING`, keyed by
+     * collection name. An existing table keeps the format it was created with.
+     */
+    std::unordered_map<std::string, KeyFormat> collection_key_formats;
+    /**
+     * @brief `true` to store the documents of user collections with their field names replaced
+     * by the ids of a per-collection `aevum::bson::doc::FieldDictionary`. Values already written
+     * in either form stay readable when the option is changed.
+     */
+    bool field_dictionary = false;
+};
+
+}  // namespace aevum::db::storage
@@ -13,6 +13,8 @@
  */
 #include "aevum/db/storage/wiredtiger_store.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <string>
 
@@ -27,35 +29,191 @@ namespace fs = std::filesystem;
 
 namespace aevum::db::storage {
 
+namespace {
+
+/// The system collection that holds the field dictionaries, next to the schemas.
+constexpr std::string_view FIELD_DICTIONARY_TABLE = "_schemas";
+
+/// The table listing every other table of the store, one key per table name.
+constexpr std::string_view CATALOG_TABLE = "_catalog";
+
+/// The `CATALOG_TABLE` key whose presence marks the catalog as complete; no table is unnamed.
+constexpr const char *CATALOG_COMPLETE_KEY = "";
+
+/// The prefix of the `FIELD_DICTIONARY_TABLE` key of a collection's dictionary.
+constexpr std::string_view FIELD_DICTIONARY_KEY_PREFIX = "$fields.";
+
+/**
+ * @brief Builds the record that persists a field dictionary.
+ * @details The record names its collection under `dictionary` rather than `collection`, so that
+ * loading `_schemas` does not take it for a schema.
+ * @param collection The name of the collection.
+ * @param names The names of the dictionary, indexed by id.
+ * @return The record, `{"dictionary": collection, "fields": [names...]}`.
+ */
+aevum::bson::doc::Document field_dictionary_record(std::string_view collection,
+                                                   const std::vector<std::string> &names) {
+    bson_t *record = bson_new();
+    bson_append_utf8(record, "dictionary", -1, collection.data(),
+                     static_cast<int>(collection.size()));
+    bson_t fields;
+    bson_append_array_begin(record, "fields", -1, &fields);
+    for (size_t i = 0; i < names.size(); ++i) {
+        std::string key = std::to_string(i);
+        bson_append_utf8(&fields, key.c_str(), static_cast<int>(key.size()), names[i].data(),
+                         static_cast<int>(names[i].size()));
+    }
+    bson_append_array_end(record, &fields);
+    return aevum::bson::doc::Document(record);
+}
+
+/// The number of keys `sample_split_keys` draws per requested range.
+constexpr size_t SPLIT_SAMPLES_PER_PARTITION = 64;
+
+/**
+ * @brief Parses the key of an `_id` in an integer-keyed table.
+ * @details Only the decimal form `std::to_string` produces is accepted, so that every integer
+ * has exactly one key.
+ * @param key The key.
+ * @param value Receives the integer.
+ * @return `true` if `key` is the canonical form of a 64-bit integer.
+ */
+bool parse_integer_key(std::string_view key, int64_t &value) {
+    std::string_view digits = !key.empty() && key.front() == '-' ? key.substr(1) : key;
+    // Neither leading zeros nor a negative zero.
+    if (digits.empty() || (digits.front() == '0' && key != "0")) return false;
+    auto [end, ec] = std::from_chars(key.data(), key.data() + key.size(), value);
+    return ec == std::errc() && end == key.data() + key.size();
+}
+
+/**
+ * @brief Picks every `samples.size() / partitions`-th key of a sample as a split key.
+ * @param samples The sampled keys; sorted and de-duplicated in place.
+ * @param partitions The desired number of ranges.
+ * @param to_key Converts a sampled key into the key string of the store's interface.
+ * @param splits Receives the split keys, unless the sample holds fewer distinct keys than ranges.
+ */
+template <typename Key, typename ToKey>
+void pick_split_keys(std::vector<Key> &samples, size_t partitions, ToKey to_key,
+                     std::vector<std::string> &splits) {
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+    if (samples.size() < partitions) return;
+    for (size_t i = 1; i < partitions; ++i) {
+        splits.push_back(to_key(samples[i * samples.size() / partitions]));
+    }
+}
+
+#ifdef HAVE_WIREDTIGER
+/**
+ * @brief Checks whether a cursor's table is keyed by 64-bit integers rather than strings.
+ * @param cursor The cursor.
+ * @return `true` for a table created with `key_format=q`.
+ */
+bool has_integer_keys(const WT_CURSOR *cursor) {
+    return cursor->key_format[0] == 'q';
+}
+
+/**
+ * @brief Sets the key of a cursor to an `_id`, in the form of the cursor's table.
+ * @details The string is borrowed by a string-keyed cursor until its next operation.
+ * @param cursor The cursor.
+ * @param id The key of the `_id`; the decimal form of an integer for an integer-keyed table.
+ * @return `false` if the table is integer-keyed and `id` is not the key of an integer.
+ */
+bool set_id_key(WT_CURSOR *cursor, const std::string &id) {
+    if (!has_integer_keys(cursor)) {
+        cursor->set_key(cursor, id.c_str());
+        return true;
+    }
+    int64_t value = 0;
+    if (!parse_integer_key(id, value)) return false;
+    cursor->set_key(cursor, value);
+    return true;
+}
+
+/**
+ * @brief Checks whether the key a cursor is positioned on lies below an exclusive upper bound.
+ * @param cursor The positioned cursor.
+ * @param integer_keys `true` if the table is integer-keyed.
+ * @param upper The bound of a string-keyed table.
+ * @param upper_value The bound of an integer-keyed table.
+ * @return `true` if the key is less than the bound.
+ */
+bool key_below(WT_CURSOR *cursor, bool integer_keys, std::string_view upper, int64_t upper_value) {
+    if (integer_keys) {
+        int64_t value = 0;
+        cursor->get_key(cursor, &value);
+        return value < upper_value;
+    }
+    const char *key = nullptr;
+    cursor->get_key(cursor, &key);
+    return std::string_view(key) < upper;
+}
+#endif
+
+/// The connection statistics `engine_statistics` reports, by WiredTiger description.
+constexpr std::string_view REPORTED_ENGINE_STATISTICS[] = {
+    "cache: bytes currently in the cache",
+    "cache: maximum bytes configured",
+    "cache: tracked dirty bytes in the cache",
+    "cache: bytes read into cache",
+    "cache: bytes written from cache",
+    "cache: pages read into cache",
+    "cache: pages written from cache",
+    "cache: pages evicted by application threads",
+    "connection: total read I/Os",
+    "connection: total write I/Os",
+    "log: log sync operations",
+    "log: log bytes written",
+    "transaction: transactions committed",
+    "transaction: transactions rolled back",
+    "transaction: transaction checkpoints",
+};
+
+}  // namespace
+
 /**
  * @brief Constructs a `WiredTigerStore` instance, setting the physical location for the database.
  * @param base_path The filesystem directory where the WiredTiger database files will be stored.
  *        This path is moved into the class member.
+ * @param options The journaling and durability configuration of the store.
  */
-WiredTigerStore::WiredTigerStore(std::string base_path) : base_path_(std::move(base_path)) {}
+WiredTigerStore::WiredTigerStore(std::string base_path, StorageOptions options)
+    : base_path_(std::move(base_path)), options_(options) {}
 
 /**
  * @brief Destructor for the `WiredTigerStore`.
  * @details Ensures a graceful shutdown of the database by explicitly closing the WiredTiger
  * connection if it is active. This is a critical step to prevent data corruption by ensuring
- * all cached data is flushed to disk.
+ * all cached data is flushed to disk. WiredTiger closes the pooled sessions along with the
+ * connection, so the pool only has to be released afterwards. The group committer is stopped
+ * first, since its flusher thread holds a session of its own.
  */
 WiredTigerStore::~WiredTigerStore() {
+    committer_.reset();
 #ifdef HAVE_WIREDTIGER
     if (conn_) {
-        aevum::util::log::Logger::info("WiredTiger: Closing database connection.");
+        AEVUM_LOG_INFO("WiredTiger: Closing database connection.");
+        // Closing the connection also closes every cached session and cursor.
         conn_->close(conn_, nullptr);
         conn_ = nullptr;
     }
 #endif
+    idle_sessions_.clear();
 }
 
 /**
  * @brief Initializes the WiredTiger storage engine.
  * @details This is the primary setup method. It first verifies that the specified `base_path_`
  * directory exists, creating it if necessary. It then invokes `wiredtiger_open` to either create
- * a new database or open an existing one at that location. Essential configuration parameters,
- * such as cache size and statistics, are provided during this call.
+ * a new database or open an existing one at that location, with the configuration built by
+ * `open_config`. If the journal is enabled, the group committer is started on the new connection.
+ *
+ * Whether the configured compressor exists is only known once WiredTiger tries to load it: a
+ * compressor that fails to load for the journal fails `wiredtiger_open`, and one that fails for
+ * tables is caught by `probe_compressor`. Either way the store warns and continues without
+ * compression, which then also applies to new tables.
  *
  * @return `aevum::util::Status::OK()` if the directory is created/verified and the WiredTiger
  *         connection is successfully opened.
@@ -64,33 +222,406 @@ WiredTigerStore::~WiredTigerStore() {
  */
 aevum::util::Status WiredTigerStore::init() {
 #ifdef HAVE_WIREDTIGER
-    aevum::util::log::Logger::debug("WiredTiger: Initializing storage at path: " + base_path_);
+    AEVUM_LOG_DEBUG("WiredTiger: Initializing storage at path: " + base_path_);
     if (!fs::exists(base_path_)) {
-        aevum::util::log::Logger::info(
-            "WiredTiger: Database directory not found. Creating new directory at " + base_path_);
+        AEVUM_LOG_INFO("WiredTiger: Database directory not found. Creating new directory at " +
+                       base_path_);
         std::error_code ec;
         if (!fs::create_directories(base_path_, ec)) {
             return aevum::util::Status::IOError("Failed to create db directory: " + ec.message());
         }
     }
 
-    // Attempt to open the WiredTiger database with a specific configuration.
-    // 'create' allows the database to be created if it doesn't exist.
-    int ret = wiredtiger_open(base_path_.c_str(), nullptr,
-                              "create,cache_size=128M,statistics=(fast)", &conn_);
+    std::string config = open_config();
+    AEVUM_LOG_DEBUG("WiredTiger: Opening with configuration: " + config);
+    int ret = wiredtiger_open(base_path_.c_str(), nullptr, config.c_str(), &conn_);
+    if (ret != 0 && options_.block_compressor != BlockCompressor::NONE) {
+        // The journal's compressor is resolved by `wiredtiger_open`, so a missing one fails here.
+        disable_compression(wiredtiger_strerror(ret));
+        config = open_config();
+        ret = wiredtiger_open(base_path_.c_str(), nullptr, config.c_str(), &conn_);
+    }
     if (ret != 0) {
         return aevum::util::Status::IOError(std::string("WT Open failed: ") +
                                             wiredtiger_strerror(ret));
     }
+    if (options_.block_compressor != BlockCompressor::NONE) {
+        if (auto probe = probe_compressor(); !probe.ok()) disable_compression(probe.message());
+    }
+
+    if (options_.journal) {
+        committer_ = std::make_unique<GroupCommitter>(conn_, options_.group_commit_window);
+        AEVUM_LOG_INFO("WiredTiger: Journal enabled with default durability '" +
+                       std::string(to_string(options_.durability)) + "'.");
+    }
+
+    if (auto status = load_catalog(); !status.ok()) return status;
 
-    aevum::util::log::Logger::info("WiredTiger: Storage engine initialized successfully.");
+    AEVUM_LOG_INFO("WiredTiger: Storage engine initialized successfully.");
     return aevum::util::Status::OK();
 #else
-    aevum::util::log::Logger::warn("WiredTiger support is disabled in this build.");
+    AEVUM_LOG_WARN("WiredTiger support is disabled in this build.");
     return aevum::util::Status::OK();  // Proceed without persistence
 #endif
 }
 
+/**
+ * @brief Checks that tables can be created with the configured block compressor.
+ * @details WiredTiger resolves a table's compressor only when the table is created, so a
+ * throwaway table is created with it and dropped again.
+ * @return `aevum::util::Status::OK()` if the compressor is usable, or an `IOError` with
+ *         WiredTiger's reason otherwise.
+ */
+aevum::util::Status WiredTigerStore::probe_compressor() {
+#ifdef HAVE_WIREDTIGER
+    WT_SESSION *session = nullptr;
+    int ret = conn_->open_session(conn_, nullptr, nullptr, &session);
+    if (ret != 0) return aevum::util::Status::IOError(wiredtiger_strerror(ret));
+    const char *uri = "table:_compressor_probe";
+    std::string config = "key_format=S,value_format=u,block_compressor=" +
+                         std::string(to_string(options_.block_compressor));
+    ret = session->create(session, uri, config.c_str());
+    if (ret == 0) session->drop(session, uri, "force=true");
+    session->close(session, nullptr);
+    if (ret != 0) return aevum::util::Status::IOError(wiredtiger_strerror(ret));
+#endif
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Falls back to uncompressed tables and journal after the configured compressor failed.
+ * @param reason Why the compressor cannot be used.
+ */
+void WiredTigerStore::disable_compression(const std::string &reason) {
+    AEVUM_LOG_WARN("WiredTiger: Block compressor '" +
+                   std::string(to_string(options_.block_compressor)) +
+                   "' is unavailable (" + reason + "); continuing without compression.");
+    options_.block_compressor = BlockCompressor::NONE;
+}
+
+/**
+ * @brief Builds the `wiredtiger_open` configuration string from the options.
+ * @details `create` allows the database to be created if it doesn't exist. Commits never flush the
+ * journal themselves (`transaction_sync=(enabled=false)`); the group committer does so for the
+ * writers that ask for it. Eviction settings left at zero are omitted, so WiredTiger's defaults
+ * apply. A compressor that was not built into the library is loaded as a shared extension from
+ * the library search path.
+ * @return The configuration string.
+ */
+std::string WiredTigerStore::open_config() const {
+    std::string config =
+        "create,cache_size=" + std::to_string(options_.cache_size_mb) + "MB,statistics=(fast)";
+    if (options_.eviction_threads > 0) {
+        std::string threads = std::to_string(options_.eviction_threads);
+        config += ",eviction=(threads_min=" + threads + ",threads_max=" + threads + ")";
+    }
+    if (options_.eviction_target > 0) {
+        config += ",eviction_target=" + std::to_string(options_.eviction_target);
+    }
+    if (options_.block_compressor != BlockCompressor::NONE &&
+        !is_compressor_built_in(options_.block_compressor)) {
+        config += ",extensions=[libwiredtiger_" +
+                  std::string(to_string(options_.block_compressor)) + ".so]";
+    }
+    if (options_.journal) {
+        config += ",log=(enabled=true";
+        if (options_.block_compressor != BlockCompressor::NONE) {
+            config += ",compressor=" + std::string(to_string(options_.block_compressor));
+        }
+        config += "),transaction_sync=(enabled=false)";
+    }
+    return config;
+}
+
+/**
+ * @brief Builds the `WT_SESSION::create` configuration string of a collection's table.
+ * @details A per-collection leaf page size takes precedence over the store-wide one, and a
+ * collection configured for integer keys is keyed by packed 64-bit integers.
+ * @param collection The name of the collection.
+ * @return The configuration string.
+ */
+std::string WiredTigerStore::table_config(std::string_view collection) const {
+    std::string config = configured_key_format(collection) == KeyFormat::INT64
+                             ? "key_format=q,value_format=u"
+                             : "key_format=S,value_format=u";
+    if (options_.block_compressor != BlockCompressor::NONE) {
+        config += ",block_compressor=" + std::string(to_string(options_.block_compressor));
+    }
+    uint32_t leaf_page_max_kb = options_.leaf_page_max_kb;
+    auto it = options_.collection_leaf_page_max_kb.find(std::string(collection));
+    if (it != options_.collection_leaf_page_max_kb.end()) leaf_page_max_kb = it->second;
+    if (leaf_page_max_kb > 0) {
+        config += ",leaf_page_max=" + std::to_string(leaf_page_max_kb) + "KB";
+    }
+    return config;
+}
+
+/**
+ * @brief Takes ownership of a cached session on behalf of a store.
+ * @param store The store whose pool the session is returned to.
+ * @param cached The leased session, or `nullptr` for an empty lease.
+ */
+WiredTigerStore::SessionLease::SessionLease(WiredTigerStore &store,
+                                            std::unique_ptr<CachedSession> cached)
+    : store_(store), cached_(std::move(cached)) {}
+
+/**
+ * @brief Returns the leased session to the pool of idle sessions of the store.
+ * @details The time the session was held is counted before it is returned, since waiting for
+ * the pool's mutex is not time spent in the storage engine.
+ */
+WiredTigerStore::SessionLease::~SessionLease() {
+    if (!cached_) return;
+    store_.operations_.fetch_add(1, std::memory_order_relaxed);
+    store_.busy_us_.fetch_add(busy_.elapsed_ns() / 1000, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(store_.sessions_mutex_);
+    store_.idle_sessions_.push_back(std::move(cached_));
+}
+
+/**
+ * @brief Returns the session's cursor on a collection's table, opening it on first use.
+ * @details The cursor is looked up by URI in the session's cursor cache. On a miss, the table is
+ * ensured to exist and a new cursor is opened and cached for the lifetime of the session.
+ * @param collection The collection whose table the cursor is opened on.
+ * @param cursor Receives the cursor on success.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` if the cursor cannot be opened.
+ */
+aevum::util::Status WiredTigerStore::SessionLease::cursor(
+    [[maybe_unused]] std::string_view collection, [[maybe_unused]] WT_CURSOR **cursor) {
+#ifdef HAVE_WIREDTIGER
+    std::string uri = store_.make_uri(collection);
+    auto it = cached_->cursors.find(uri);
+    if (it != cached_->cursors.end()) {
+        *cursor = it->second;
+        return aevum::util::Status::OK();
+    }
+
+    if (auto status = store_.ensure_table(cached_->session, collection); !status.ok()) {
+        return status;
+    }
+
+    WT_CURSOR *opened = nullptr;
+    int ret = cached_->session->open_cursor(cached_->session, uri.c_str(), nullptr, nullptr,
+                                            &opened);
+    if (ret != 0) return aevum::util::Status::IOError("WT Open Cursor failed for '" + uri + "'.");
+
+    cached_->cursors.emplace(std::move(uri), opened);
+    *cursor = opened;
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::NotSupported("WiredTiger support is disabled.");
+#endif
+}
+
+/**
+ * @brief Closes the session's cached cursor on a table, if it has one.
+ * @param uri The URI of the table.
+ */
+void WiredTigerStore::SessionLease::close_cursor([[maybe_unused]] const std::string &uri) {
+#ifdef HAVE_WIREDTIGER
+    auto it = cached_->cursors.find(uri);
+    if (it == cached_->cursors.end()) return;
+    it->second->close(it->second);
+    cached_->cursors.erase(it);
+#endif
+}
+
+/**
+ * @brief Leases an idle session to the calling thread, opening a new one if none is idle.
+ * @details The most recently returned session is reused first, since its cursors are the most
+ * likely to be warm. A new session is only opened when every pooled session is in use.
+ * @return The lease, which is empty if there is no connection or the session cannot be opened.
+ */
+WiredTigerStore::SessionLease WiredTigerStore::acquire_session() {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return SessionLease(*this, nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        if (!idle_sessions_.empty()) {
+            std::unique_ptr<CachedSession> cached = std::move(idle_sessions_.back());
+            idle_sessions_.pop_back();
+            return SessionLease(*this, std::move(cached));
+        }
+    }
+
+    auto cached = std::make_unique<CachedSession>();
+    int ret = conn_->open_session(conn_, nullptr, nullptr, &cached->session);
+    if (ret != 0 || !cached->session) {
+        AEVUM_LOG_ERROR(std::string("WiredTiger: Failed to open session. Error: ") +
+                        wiredtiger_strerror(ret));
+        return SessionLease(*this, nullptr);
+    }
+    AEVUM_LOG_DEBUG("WiredTiger: Opened a new pooled session.");
+    return SessionLease(*this, std::move(cached));
+#else
+    return SessionLease(*this, nullptr);
+#endif
+}
+
+/**
+ * @brief Checks whether new documents of a collection are encoded with a field dictionary.
+ * @param collection The name of the collection.
+ * @return `true` for user collections when the option is set.
+ */
+bool WiredTigerStore::uses_dictionary(std::string_view collection) const noexcept {
+    return options_.field_dictionary && !collection.empty() && collection.front() != '_';
+}
+
+/**
+ * @brief Returns the key format a collection's table is created with.
+ * @param collection The name of the collection.
+ * @return The configured format; system collections are always string-keyed.
+ */
+KeyFormat WiredTigerStore::configured_key_format(std::string_view collection) const {
+    if (collection.empty() || collection.front() == '_') return KeyFormat::STRING;
+    auto it = options_.collection_key_formats.find(std::string(collection));
+    return it == options_.collection_key_formats.end() ? KeyFormat::STRING : it->second;
+}
+
+/**
+ * @brief Returns the field dictionary of a collection, loading it on first use.
+ * @details The persisted record is read without holding `dictionaries_mutex_`, since `get` leases
+ * a session of its own. If two threads load the same dictionary at once, the first one stored is
+ * kept. A record that is missing yields an empty dictionary; one that cannot be read or holds a
+ * name that is not a string yields `nullptr`, so that no id is assigned twice.
+ * @param collection The name of the collection.
+ * @return The dictionary, or `nullptr` if the persisted one cannot be read.
+ */
+aevum::bson::doc::FieldDictionary *WiredTigerStore::dictionary(std::string_view collection) {
+    std::string name(collection);
+    {
+        std::lock_guard<std::mutex> lock(dictionaries_mutex_);
+        auto it = dictionaries_.find(name);
+        if (it != dictionaries_.end()) return it->second.get();
+    }
+
+    std::vector<std::string> names;
+    aevum::bson::doc::Document record;
+    std::string key = std::string(FIELD_DICTIONARY_KEY_PREFIX) + name;
+    auto status = get(FIELD_DICTIONARY_TABLE, key, record);
+    if (status.ok()) {
+        bson_iter_t iter;
+        bson_iter_t fields;
+        if (!bson_iter_init_find(&iter, record.get(), "fields") || !BSON_ITER_HOLDS_ARRAY(&iter) ||
+            !bson_iter_recurse(&iter, &fields)) {
+            AEVUM_LOG_ERROR("WiredTiger: The field dictionary of '" + name + "' is malformed.");
+            return nullptr;
+        }
+        while (bson_iter_next(&fields)) {
+            if (!BSON_ITER_HOLDS_UTF8(&fields)) {
+                AEVUM_LOG_ERROR("WiredTiger: The field dictionary of '" + name +
+                                "' holds a name that is not a string.");
+                return nullptr;
+            }
+            uint32_t length = 0;
+            const char *field = bson_iter_utf8(&fields, &length);
+            names.emplace_back(field, length);
+        }
+    } else if (status.code() != aevum::util::StatusCode::kNotFound) {
+        AEVUM_LOG_ERROR("WiredTiger: Cannot read the field dictionary of '" + name + "'. " +
+                        status.to_string());
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(dictionaries_mutex_);
+    auto [it, inserted] = dictionaries_.try_emplace(std::move(name));
+    if (inserted) it->second = std::make_unique<aevum::bson::doc::FieldDictionary>(names);
+    return it->second.get();
+}
+
+/**
+ * @brief Rebuilds a document from a stored value.
+ * @details Plain BSON is copied with `bson_new_from_data`; an encoded value is decoded with the
+ * collection's dictionary, which is looked up once per caller through `dict`.
+ * @param collection The name of the collection the value belongs to.
+ * @param data The value.
+ * @param size The size of the value in bytes.
+ * @param dict The cached dictionary of the collection, or `nullptr` before the first lookup.
+ * @return The document, or `nullptr` if the value is corrupt.
+ */
+bson_t *WiredTigerStore::decode_value(std::string_view collection, const void *data, size_t size,
+                                      aevum::bson::doc::FieldDictionary *&dict) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    if (!aevum::bson::doc::FieldDictionary::is_encoded(bytes, size)) {
+        return bson_new_from_data(bytes, size);
+    }
+    if (dict == nullptr) dict = dictionary(collection);
+    return dict != nullptr ? dict->decode(bytes, size) : nullptr;
+}
+
+/**
+ * @brief Waits until every transaction committed so far reaches a durability level.
+ * @details Without a journal there is nothing to flush, so every level is satisfied as soon as
+ * the transaction has committed.
+ * @param durability The requested level. `DEFAULT` is resolved to the configured level.
+ * @return `aevum::util::Status::OK()` once the level is reached, or the `IOError` of the failed
+ *         journal flush.
+ */
+aevum::util::Status WiredTigerStore::make_durable(Durability durability) {
+    if (durability == Durability::DEFAULT) durability = options_.durability;
+    if (durability == Durability::NONE || !committer_) return aevum::util::Status::OK();
+    aevum::util::time::Stopwatch waited;
+    aevum::util::Status status = committer_->wait(durability);
+    durability_waits_.fetch_add(1, std::memory_order_relaxed);
+    durability_wait_us_.fetch_add(waited.elapsed_ns() / 1000, std::memory_order_relaxed);
+    return status;
+}
+
+/**
+ * @brief Returns the time spent in the storage engine so far.
+ * @details The counters are read one by one, so a snapshot taken during an operation may count
+ * it in one of them and not yet in another.
+ * @return The snapshot of the store's counters.
+ */
+StorageStats WiredTigerStore::stats() const noexcept {
+    StorageStats stats;
+    stats.operations = operations_.load(std::memory_order_relaxed);
+    stats.busy_us = busy_us_.load(std::memory_order_relaxed);
+    stats.durability_waits = durability_waits_.load(std::memory_order_relaxed);
+    stats.durability_wait_us = durability_wait_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief Reads a selection of WiredTiger's connection statistics.
+ * @details A `statistics:` cursor is opened on a pooled session and walked once; each entry is
+ * kept if its description is one of `REPORTED_ENGINE_STATISTICS`. The cursor is closed rather
+ * than cached, since a statistics cursor holds a snapshot taken when it is opened.
+ * @return The selected statistics as description and value pairs.
+ */
+std::vector<std::pair<std::string, int64_t>> WiredTigerStore::engine_statistics() {
+    std::vector<std::pair<std::string, int64_t>> statistics;
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return statistics;
+    SessionLease lease = acquire_session();
+    if (!lease) return statistics;
+
+    WT_SESSION *session = lease.session();
+    WT_CURSOR *cursor = nullptr;
+    int ret = session->open_cursor(session, "statistics:", nullptr, nullptr, &cursor);
+    if (ret != 0) {
+        AEVUM_LOG_WARN(std::string("WiredTiger: Failed to open the statistics cursor. Error: ") +
+                       wiredtiger_strerror(ret));
+        return statistics;
+    }
+    AEVUM_DEFER([&]() { cursor->close(cursor); });
+
+    const char *description;
+    const char *printable;
+    int64_t value;
+    while (cursor->next(cursor) == 0) {
+        if (cursor->get_value(cursor, &description, &printable, &value) != 0) continue;
+        std::string_view name(description);
+        if (std::find(std::begin(REPORTED_ENGINE_STATISTICS), std::end(REPORTED_ENGINE_STATISTICS),
+                      name) != std::end(REPORTED_ENGINE_STATISTICS)) {
+            statistics.emplace_back(name, value);
+        }
+    }
+#endif
+    return statistics;
+}
+
 /**
  * @brief Constructs the standard WiredTiger URI for accessing a table.
  * @param collection The logical name of the collection.
@@ -103,8 +634,12 @@ std::string WiredTigerStore::make_uri(std::string_view collection) const {
 /**
  * @brief Ensures a table with the specified name exists within the database.
  * @details This is an idempotent operation. It attempts to create a table with the given name
- * using a default schema (`key_format=S` for string keys, `value_format=u` for raw byte values).
+ * using the configuration from `table_config` (string keys, raw byte values, and the configured
+ * compression and page size).
  * If the table already exists, WiredTiger returns `EEXIST`, which is handled as a success case.
+ * Either way the URI is added to the known-tables set, and later calls for the same table return
+ * immediately without issuing `session->create`. A table missing from `_catalog` is recorded
+ * there first.
  *
  * @param session An active `WT_SESSION` pointer.
  * @param collection The name of the collection/table to ensure exists.
@@ -118,17 +653,37 @@ aevum::util::Status WiredTigerStore::ensure_table([[maybe_unused]] WT_SESSION *s
     if (!session) return aevum::util::Status::Corruption("WT Session is null");
 
     std::string uri = make_uri(collection);
+    {
+        std::shared_lock<std::shared_mutex> lock(tables_mutex_);
+        if (known_tables_.count(uri) != 0) return aevum::util::Status::OK();
+    }
+
+    // The table is listed before it is created, so a crash in between lists a missing table,
+    // which the next `ensure_table` creates, rather than hiding an existing one.
+    bool listed = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(tables_mutex_);
+        listed = catalog_.count(std::string(collection)) != 0;
+    }
+    if (!listed) {
+        if (auto status = write_catalog(collection, false); !status.ok()) return status;
+        std::unique_lock<std::shared_mutex> lock(tables_mutex_);
+        catalog_.emplace(collection);
+    }
+
     // Create the table with a string key format and a raw byte array value format (for BSON).
-    int ret = session->create(session, uri.c_str(), "key_format=S,value_format=u");
+    int ret = session->create(session, uri.c_str(), table_config(collection).c_str());
 
     // EEXIST is not an error; it simply means the table was already there.
     if (ret != 0 && ret != EEXIST) {
-        aevum::util::log::Logger::error("WiredTiger: Failed to create table '" + uri +
-                                        "'. Error: " + wiredtiger_strerror(ret));
+        AEVUM_LOG_ERROR("WiredTiger: Failed to create table '" + uri + "'. Error: " +
+                        wiredtiger_strerror(ret));
         return aevum::util::Status::IOError(std::string("WT Create Table failed: ") +
                                             wiredtiger_strerror(ret));
     }
 
+    std::unique_lock<std::shared_mutex> lock(tables_mutex_);
+    known_tables_.insert(std::move(uri));
     return aevum::util::Status::OK();
 #else
     return aevum::util::Status::NotSupported("WiredTiger support is disabled.");
@@ -136,58 +691,208 @@ aevum::util::Status WiredTigerStore::ensure_table([[maybe_unused]] WT_SESSION *s
 }
 
 /**
- * @brief Scans database metadata to retrieve a list of all user-defined collection names.
- * @details This function opens a cursor on the special `metadata:` URI in WiredTiger, which lists
- * all internal and user-defined tables. It iterates through the metadata, filtering for entries
- * that are prefixed with "table:" and extracting the collection name.
+ * @brief Lists the tables of the store from the in-memory catalog.
+ * @details `catalog_` holds every table in `_catalog`, which `init` loaded and every creation
+ * and drop since has kept current, so WiredTiger's `metadata:` table is not scanned.
  *
- * @return A `std::vector<std::string>` containing the names of all collections.
+ * @return A `std::vector<std::string>` containing the names of all collections, sorted.
  */
 std::vector<std::string> WiredTigerStore::list_collections() {
     std::vector<std::string> collections;
-#ifdef HAVE_WIREDTIGER
-    if (!conn_) return collections;
+    {
+        std::shared_lock<std::shared_mutex> lock(tables_mutex_);
+        collections.assign(catalog_.begin(), catalog_.end());
+    }
+    std::sort(collections.begin(), collections.end());
+    return collections;
+}
 
-    WT_SESSION *session = nullptr;
-    conn_->open_session(conn_, nullptr, nullptr, &session);
-    AEVUM_DEFER([&]() {
-        if (session) session->close(session, nullptr);
-    });
+/**
+ * @brief Checks whether a collection is listed in the catalog.
+ * @param collection The name of the collection.
+ * @return `true` if it is.
+ */
+bool WiredTigerStore::has_collection(std::string_view collection) {
+    std::shared_lock<std::shared_mutex> lock(tables_mutex_);
+    return catalog_.count(std::string(collection)) != 0;
+}
 
+/**
+ * @brief Returns the key format of a collection's table.
+ * @details A table listed in the catalog is opened through the session's cached cursor, whose
+ * `key_format` is the one the table was created with; the answer is cached until the table is
+ * dropped. An unlisted collection is not created by asking.
+ * @param collection The name of the collection.
+ * @return The key format of the table, or the configured one if there is no table yet.
+ */
+KeyFormat WiredTigerStore::key_format(std::string_view collection) {
+#ifdef HAVE_WIREDTIGER
+    {
+        std::shared_lock<std::shared_mutex> lock(tables_mutex_);
+        auto it = key_formats_.find(std::string(collection));
+        if (it != key_formats_.end()) return it->second;
+        if (catalog_.count(std::string(collection)) == 0) return configured_key_format(collection);
+    }
+
+    SessionLease lease = acquire_session();
     WT_CURSOR *cursor = nullptr;
-    int ret = session->open_cursor(session, "metadata:", nullptr, nullptr, &cursor);
-    if (ret != 0) {
-        aevum::util::log::Logger::error(
-            "WiredTiger: Failed to open metadata cursor to list collections.");
-        return collections;
+    if (!lease || !lease.cursor(collection, &cursor).ok()) {
+        return configured_key_format(collection);
     }
+    KeyFormat format = has_integer_keys(cursor) ? KeyFormat::INT64 : KeyFormat::STRING;
+    std::unique_lock<std::shared_mutex> lock(tables_mutex_);
+    key_formats_[std::string(collection)] = format;
+    return format;
+#else
+    return configured_key_format(collection);
+#endif
+}
 
-    AEVUM_DEFER([&]() {
-        if (cursor) cursor->close(cursor);
-    });
+/**
+ * @brief Loads the `_catalog` table, migrating a data directory that predates it.
+ * @details If the catalog has no completion marker, the tables are listed from the `metadata:`
+ * cursor, as every startup did before, and written to the catalog with the marker in one
+ * transaction.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` on failure.
+ */
+aevum::util::Status WiredTigerStore::load_catalog() {
+#ifdef HAVE_WIREDTIGER
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+    WT_SESSION *session = lease.session();
+    std::string catalog_uri = make_uri(CATALOG_TABLE);
+    int ret = session->create(session, catalog_uri.c_str(), "key_format=S,value_format=u");
+    if (ret != 0 && ret != EEXIST) {
+        return aevum::util::Status::IOError(std::string("WT Create Catalog failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
 
-    const char *key;
+    // The catalog is read with a cursor of its own, which is closed before the lease ends so
+    // that the table is never held by a cached cursor.
+    WT_CURSOR *cursor = nullptr;
+    if ((ret = session->open_cursor(session, catalog_uri.c_str(), nullptr, nullptr, &cursor)) !=
+        0) {
+        return aevum::util::Status::IOError(std::string("WT Open Catalog failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    AEVUM_DEFER([&]() { cursor->close(cursor); });
+
+    std::unordered_set<std::string> tables;  // The names of the tables.
+    bool complete = false;
+    const char *key = nullptr;
     while ((ret = cursor->next(cursor)) == 0) {
         cursor->get_key(cursor, &key);
-        std::string_view s_key(key);
+        if (*key == '\0') {
+            complete = true;
+        } else {
+            tables.emplace(key);
+        }
+    }
+    if (ret != WT_NOTFOUND) {
+        return aevum::util::Status::IOError(std::string("WT Read Catalog failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
 
-        // Isolate user table URIs from other metadata entries.
-        // Check length before substr to prevent out_of_range exception
-        if (s_key.size() >= 6 && s_key.substr(0, 6) == "table:") {
-            collections.emplace_back(s_key.substr(6));
+    if (!complete) {
+        WT_CURSOR *metadata = nullptr;
+        ret = session->open_cursor(session, "metadata:", nullptr, nullptr, &metadata);
+        if (ret != 0) {
+            return aevum::util::Status::IOError(std::string("WT Open Metadata failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+        while ((ret = metadata->next(metadata)) == 0) {
+            metadata->get_key(metadata, &key);
+            std::string_view s_key(key);
+            if (s_key.size() > 6 && s_key.substr(0, 6) == "table:" && s_key != catalog_uri) {
+                tables.emplace(s_key.substr(6));
+            }
+        }
+        metadata->close(metadata);
+
+        WT_ITEM empty_value{};
+        if ((ret = session->begin_transaction(session, nullptr)) != 0) {
+            return aevum::util::Status::IOError(std::string("WT Begin Transaction failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+        for (const auto &name : tables) {
+            cursor->set_key(cursor, name.c_str());
+            cursor->set_value(cursor, &empty_value);
+            if ((ret = cursor->insert(cursor)) != 0) break;
+        }
+        if (ret == 0) {
+            cursor->set_key(cursor, CATALOG_COMPLETE_KEY);
+            cursor->set_value(cursor, &empty_value);
+            ret = cursor->insert(cursor);
+        }
+        if (ret == 0) ret = session->commit_transaction(session, nullptr);
+        if (ret != 0) {
+            session->rollback_transaction(session, nullptr);
+            return aevum::util::Status::IOError(std::string("WT Write Catalog failed: ") +
+                                                wiredtiger_strerror(ret));
         }
+        AEVUM_LOG_INFO("WiredTiger: Recorded " + std::to_string(tables.size()) +
+                       " existing tables in the catalog.");
     }
+
+    std::unique_lock<std::shared_mutex> lock(tables_mutex_);
+    known_tables_.insert(std::move(catalog_uri));
+    catalog_ = std::move(tables);
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
+/**
+ * @brief Inserts or removes the row of a table in `_catalog`.
+ * @details A new session is opened for the write, since the caller's may be inside a
+ * transaction that could still roll back after the table is created. Tables are created and
+ * dropped rarely, so the cost of opening a session and waiting for the journal is not felt.
+ * @param collection The name of the table.
+ * @param remove `true` to remove the row.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` on failure.
+ */
+aevum::util::Status WiredTigerStore::write_catalog([[maybe_unused]] std::string_view collection,
+                                                   [[maybe_unused]] bool remove) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+    WT_SESSION *session = nullptr;
+    int ret = conn_->open_session(conn_, nullptr, nullptr, &session);
+    if (ret != 0) return aevum::util::Status::IOError("WT Open Session failed");
+    // Closing the session closes its cursor as well.
+    AEVUM_DEFER([&]() { session->close(session, nullptr); });
+
+    std::string catalog_uri = make_uri(CATALOG_TABLE);
+    WT_CURSOR *cursor = nullptr;
+    if ((ret = session->open_cursor(session, catalog_uri.c_str(), nullptr, nullptr, &cursor)) ==
+        0) {
+        std::string key(collection);
+        cursor->set_key(cursor, key.c_str());
+        if (remove) {
+            ret = cursor->remove(cursor);
+            if (ret == WT_NOTFOUND) ret = 0;
+        } else {
+            WT_ITEM empty_value{};
+            cursor->set_value(cursor, &empty_value);
+            ret = cursor->insert(cursor);
+        }
+    }
+    if (ret != 0) {
+        AEVUM_LOG_ERROR("WiredTiger: Failed to update the catalog for '" +
+                        std::string(collection) + "'. Error: " + wiredtiger_strerror(ret));
+        return aevum::util::Status::IOError(std::string("WT Catalog Write failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    return make_durable(Durability::JOURNAL);
+#else
+    return aevum::util::Status::OK();  // No-op
 #endif
-    return collections;
 }
 
 /**
  * @brief Reads all key-value pairs from a collection's table and deserializes them into BSON
  * documents.
- * @details This function performs a full table scan. It opens a cursor on the specified
- * collection's table and iterates through every record. For each record, it retrieves the raw value
- * (a byte array) and uses `bson_new_from_data` to reconstruct it into a `bson_t`, which is then
- * wrapped in a `aevum::bson::doc::Document`.
+ * @details This function performs a full table scan by loading the unbounded key range.
  *
  * @param collection The name of the collection to load.
  * @return A `std::vector` of `aevum::bson::doc::Document`s. If the collection does not exist or is
@@ -195,111 +900,532 @@ std::vector<std::string> WiredTigerStore::list_collections() {
  */
 std::vector<aevum::bson::doc::Document> WiredTigerStore::load_collection(
     std::string_view collection) {
+    return load_collection_range(collection, {}, {});
+}
+
+/**
+ * @brief Reads the key-value pairs of a collection's table whose keys lie in `[lower, upper)` and
+ * deserializes them into BSON documents.
+ * @details The bounds of an integer-keyed table are integer keys and compared numerically. The
+ * session's cached cursor is positioned on the first key not less than `lower`
+ * (`search_near` may land on the preceding key, in which case it steps once), or on the first key
+ * of the table if `lower` is empty. For each record up to `upper`, the raw value (a byte array)
+ * is reconstructed by `decode_value` into a `bson_t`, which is then wrapped in a
+ * `aevum::bson::doc::Document`.
+ *
+ * @param collection The name of the collection to load.
+ * @param lower The inclusive lower bound, or empty for none.
+ * @param upper The exclusive upper bound, or empty for none.
+ * @return The documents of the range. If the collection does not exist or an error occurs, the
+ * documents read so far are returned.
+ */
+std::vector<aevum::bson::doc::Document> WiredTigerStore::load_collection_range(
+    [[maybe_unused]] std::string_view collection, [[maybe_unused]] std::string_view lower,
+    [[maybe_unused]] std::string_view upper) {
     std::vector<aevum::bson::doc::Document> documents;
 #ifdef HAVE_WIREDTIGER
-    if (!conn_) return documents;
+    SessionLease lease = acquire_session();
+    if (!lease) return documents;
 
-    WT_SESSION *session = nullptr;
-    conn_->open_session(conn_, nullptr, nullptr, &session);
-    AEVUM_DEFER([&]() {
-        if (session) session->close(session, nullptr);
-    });
-
-    if (auto status = ensure_table(session, collection); !status.ok()) {
-        aevum::util::log::Logger::error("WiredTiger: Cannot load collection '" +
-                                        std::string(collection) + "'. " + status.to_string());
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) {
+        AEVUM_LOG_ERROR("WiredTiger: Cannot load collection '" + std::string(collection) + "'. " +
+                        status.to_string());
         return documents;
     }
 
-    std::string uri = make_uri(collection);
-    WT_CURSOR *cursor = nullptr;
-    int ret = session->open_cursor(session, uri.c_str(), nullptr, nullptr, &cursor);
-    if (ret != 0) {
-        aevum::util::log::Logger::error("WiredTiger: Failed to open read cursor on table '" + uri +
-                                        "'.");
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    // The bounds of an integer-keyed table are compared as integers, in the table's order.
+    bool integer_keys = has_integer_keys(cursor);
+    int64_t upper_value = 0;
+    if (integer_keys && !upper.empty() && !parse_integer_key(upper, upper_value)) {
         return documents;
     }
 
-    AEVUM_DEFER([&]() {
-        if (cursor) cursor->close(cursor);
-    });
+    int ret;
+    if (lower.empty()) {
+        ret = cursor->next(cursor);
+    } else {
+        std::string lower_str(lower);
+        if (!set_id_key(cursor, lower_str)) return documents;
+        int exact = 0;
+        ret = cursor->search_near(cursor, &exact);
+        if (ret == 0 && exact < 0) ret = cursor->next(cursor);
+    }
 
-    const char *key;
     WT_ITEM value_item;
-    while ((ret = cursor->next(cursor)) == 0) {
-        cursor->get_key(cursor, &key);
+    aevum::bson::doc::FieldDictionary *dict = nullptr;
+    for (; ret == 0; ret = cursor->next(cursor)) {
+        if (!upper.empty() && !key_below(cursor, integer_keys, upper, upper_value)) break;
         cursor->get_value(cursor, &value_item);
 
         // Reconstruct the BSON document from the raw data stored in WiredTiger.
-        bson_t *b =
-            bson_new_from_data(static_cast<const uint8_t *>(value_item.data), value_item.size);
+        bson_t *b = decode_value(collection, value_item.data, value_item.size, dict);
         if (b) {
             documents.emplace_back(b);
         } else {
-            aevum::util::log::Logger::warn(
-                "WiredTiger: Failed to deserialize BSON document from collection '" +
-                std::string(collection) + "'.");
+            AEVUM_LOG_WARN("WiredTiger: Failed to deserialize BSON document from collection '" +
+                           std::string(collection) + "'.");
         }
     }
 #endif
     return documents;
 }
 
+/**
+ * @brief Picks keys that split a collection into ranges of roughly equal size.
+ * @details A dedicated `next_random=true` cursor is opened, since the configuration of a cursor
+ * cannot be changed once it is cached. `SPLIT_SAMPLES_PER_PARTITION` keys are drawn per range;
+ * the sample is sorted and de-duplicated, in the table's key order, and every `n / partitions`-th
+ * key becomes a split key.
+ * On a table holding fewer records than the sample size, the same keys are drawn repeatedly, so
+ * de-duplication naturally yields fewer split keys.
+ *
+ * @param collection The name of the collection.
+ * @param partitions The desired number of ranges.
+ * @return The split keys in ascending order; empty if the table cannot or need not be split.
+ */
+std::vector<std::string> WiredTigerStore::sample_split_keys(
+    [[maybe_unused]] std::string_view collection, [[maybe_unused]] size_t partitions) {
+    std::vector<std::string> splits;
+#ifdef HAVE_WIREDTIGER
+    if (partitions < 2) return splits;
+
+    SessionLease lease = acquire_session();
+    if (!lease) return splits;
+    if (auto status = ensure_table(lease.session(), collection); !status.ok()) return splits;
+
+    std::string uri = make_uri(collection);
+    WT_CURSOR *cursor = nullptr;
+    if (lease.session()->open_cursor(lease.session(), uri.c_str(), nullptr, "next_random=true",
+                                 &cursor) != 0) {
+        return splits;
+    }
+    AEVUM_DEFER([&]() { cursor->close(cursor); });
+
+    size_t sample_size = partitions * SPLIT_SAMPLES_PER_PARTITION;
+    if (has_integer_keys(cursor)) {
+        std::vector<int64_t> samples;
+        samples.reserve(sample_size);
+        int64_t key = 0;
+        for (size_t i = 0; i < sample_size && cursor->next(cursor) == 0; ++i) {
+            cursor->get_key(cursor, &key);
+            samples.push_back(key);
+        }
+        pick_split_keys(samples, partitions, [](int64_t k) { return std::to_string(k); }, splits);
+    } else {
+        std::vector<std::string> samples;
+        samples.reserve(sample_size);
+        const char *key;
+        for (size_t i = 0; i < sample_size && cursor->next(cursor) == 0; ++i) {
+            cursor->get_key(cursor, &key);
+            samples.emplace_back(key);
+        }
+        pick_split_keys(samples, partitions, [](std::string &k) { return std::move(k); }, splits);
+    }
+#endif
+    return splits;
+}
+
+/**
+ * @brief Streams the documents of a collection in batches.
+ * @details A cached cursor walks the table in key order. Each record is rebuilt into a
+ * `Document` as in `load_collection`, and every `batch_size` documents the batch is handed to
+ * `visit` and cleared. Records that fail to deserialize are skipped with a warning.
+ *
+ * @param collection The name of the collection to scan.
+ * @param batch_size The maximum number of documents per batch.
+ * @param visit Called with each non-empty batch; returning `false` ends the scan.
+ * @return `aevum::util::Status::OK()` on success, or the status of the failed operation.
+ */
+aevum::util::Status WiredTigerStore::scan_collection(
+    [[maybe_unused]] std::string_view collection, [[maybe_unused]] size_t batch_size,
+    [[maybe_unused]] const std::function<bool(std::vector<aevum::bson::doc::Document> &)>
+        &visit) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+    if (batch_size == 0) batch_size = 1;
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) return status;
+
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    std::vector<aevum::bson::doc::Document> batch;
+    batch.reserve(batch_size);
+    WT_ITEM value_item;
+    aevum::bson::doc::FieldDictionary *dict = nullptr;
+    int ret;
+    while ((ret = cursor->next(cursor)) == 0) {
+        cursor->get_value(cursor, &value_item);
+        bson_t *b = decode_value(collection, value_item.data, value_item.size, dict);
+        if (!b) {
+            AEVUM_LOG_WARN("WiredTiger: Failed to deserialize BSON document from collection '" +
+                           std::string(collection) + "'.");
+            continue;
+        }
+        batch.emplace_back(b);
+        if (batch.size() >= batch_size) {
+            lease.pause_timing();
+            if (!visit(batch)) return aevum::util::Status::OK();
+            lease.resume_timing();
+            batch.clear();
+        }
+    }
+    if (ret != WT_NOTFOUND) {
+        return aevum::util::Status::IOError(std::string("WT Cursor Next failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    if (!batch.empty()) {
+        lease.pause_timing();
+        visit(batch);
+    }
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
+/**
+ * @brief Reads a single document of a collection by its `_id` with a point lookup.
+ * @details The lookup is a `search` on the session's cached cursor, which costs one B-tree
+ * descent and usually no I/O for pages resident in WiredTiger's cache.
+ *
+ * @param collection The name of the collection.
+ * @param id The `_id` of the document.
+ * @param doc Receives the document on success.
+ * @return `aevum::util::Status::OK()` if found, `NotFound` if the key does not exist, `IOError`
+ *         if the lookup fails, or `Corruption` if the stored value cannot be decoded.
+ */
+aevum::util::Status WiredTigerStore::get([[maybe_unused]] std::string_view collection,
+                                         [[maybe_unused]] std::string_view id,
+                                         [[maybe_unused]] aevum::bson::doc::Document &doc) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) return status;
+
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    std::string id_str(id);
+    // An integer-keyed table cannot hold a key that is not an integer.
+    int ret = set_id_key(cursor, id_str) ? cursor->search(cursor) : WT_NOTFOUND;
+    if (ret == WT_NOTFOUND) {
+        return aevum::util::Status::NotFound("No document with _id '" + id_str + "'.");
+    }
+    if (ret != 0) {
+        return aevum::util::Status::IOError(std::string("WT Search failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+
+    WT_ITEM value_item;
+    cursor->get_value(cursor, &value_item);
+    aevum::bson::doc::FieldDictionary *dict = nullptr;
+    bson_t *b = decode_value(collection, value_item.data, value_item.size, dict);
+    if (!b) {
+        return aevum::util::Status::Corruption("Stored document '" + id_str +
+                                               "' is not valid BSON.");
+    }
+    doc = aevum::bson::doc::Document(b);
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::NotFound("WiredTiger support is disabled.");
+#endif
+}
+
+/**
+ * @brief Visits the keys of a table in ascending order.
+ * @details A cached cursor walks the table; only the keys are fetched, so no value is copied.
+ * @param table The name of the table to scan.
+ * @param visit Called with each key; returning `false` ends the scan.
+ * @return `aevum::util::Status::OK()` on success, or the status of the failed operation.
+ */
+aevum::util::Status WiredTigerStore::scan_keys(
+    std::string_view table, const std::function<bool(std::string_view)> &visit) {
+    return scan_keys(table, {}, visit);
+}
+
+/**
+ * @brief Visits the keys of a table in ascending order, starting at a lower bound.
+ * @details The cached cursor is positioned with `search_near`, stepping once if it lands on the
+ * preceding key, so the scan costs one descent of the tree however far into the table it starts.
+ * @param table The name of the table to scan.
+ * @param start The inclusive lower bound, or empty for none.
+ * @param visit Called with each key; returning `false` ends the scan.
+ * @return `aevum::util::Status::OK()` on success, or the status of the failed operation.
+ */
+aevum::util::Status WiredTigerStore::scan_keys(
+    [[maybe_unused]] std::string_view table, [[maybe_unused]] std::string_view start,
+    [[maybe_unused]] const std::function<bool(std::string_view)> &visit) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(table, &cursor); !status.ok()) return status;
+
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    const char *key;
+    int ret;
+    if (start.empty()) {
+        ret = cursor->next(cursor);
+    } else {
+        std::string start_str(start);
+        cursor->set_key(cursor, start_str.c_str());
+        int exact = 0;
+        ret = cursor->search_near(cursor, &exact);
+        if (ret == 0 && exact < 0) ret = cursor->next(cursor);
+    }
+    for (; ret == 0; ret = cursor->next(cursor)) {
+        cursor->get_key(cursor, &key);
+        lease.pause_timing();
+        if (!visit(key)) return aevum::util::Status::OK();
+        lease.resume_timing();
+    }
+    if (ret != WT_NOTFOUND) {
+        return aevum::util::Status::IOError(std::string("WT Cursor Next failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
+/**
+ * @brief Fills a new, empty key-only table from keys given in ascending order.
+ * @details WiredTiger only grants a `bulk` cursor on a table that is empty and not open
+ * elsewhere, so the cursor is opened outside the session's cursor cache and closed once all keys
+ * are appended; closing it is what completes the load. If it cannot be opened, the keys are
+ * written with the session's cached cursor inside one transaction.
+ *
+ * @param table The name of the table to fill.
+ * @param sorted_keys The keys, sorted byte-wise ascending and free of duplicates.
+ * @return `aevum::util::Status::OK()` on success, or an `IOError` if a write fails.
+ */
+aevum::util::Status WiredTigerStore::bulk_load_keys(
+    [[maybe_unused]] std::string_view table,
+    [[maybe_unused]] const std::vector<std::string> &sorted_keys) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+    WT_SESSION *session = lease.session();
+    if (auto status = ensure_table(session, table); !status.ok()) return status;
+
+    std::string uri = make_uri(table);
+    WT_ITEM empty_value{};
+    WT_CURSOR *bulk = nullptr;
+    int ret = session->open_cursor(session, uri.c_str(), nullptr, "bulk", &bulk);
+    if (ret == 0) {
+        for (const auto &key : sorted_keys) {
+            bulk->set_key(bulk, key.c_str());
+            bulk->set_value(bulk, &empty_value);
+            if ((ret = bulk->insert(bulk)) != 0) break;
+        }
+        int close_ret = bulk->close(bulk);
+        if (ret == 0) ret = close_ret;
+        if (ret != 0) {
+            AEVUM_LOG_ERROR("WiredTiger: Bulk load failed for table '" + uri + "'. Error: " +
+                            wiredtiger_strerror(ret));
+            return aevum::util::Status::IOError(std::string("WT Bulk Load failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+        AEVUM_LOG_DEBUG("WiredTiger: Bulk-loaded " + std::to_string(sorted_keys.size()) +
+                        " keys into '" + uri + "'.");
+        return aevum::util::Status::OK();
+    }
+
+    AEVUM_LOG_DEBUG("WiredTiger: Table '" + uri +
+                    "' cannot be bulk-loaded; inserting keys transactionally.");
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(table, &cursor); !status.ok()) return status;
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    if ((ret = session->begin_transaction(session, nullptr)) != 0) {
+        return aevum::util::Status::IOError(std::string("WT Begin Transaction failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    for (const auto &key : sorted_keys) {
+        cursor->set_key(cursor, key.c_str());
+        cursor->set_value(cursor, &empty_value);
+        if ((ret = cursor->insert(cursor)) != 0) {
+            session->rollback_transaction(session, nullptr);
+            return aevum::util::Status::IOError(std::string("WT Insert failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+    }
+    if ((ret = session->commit_transaction(session, nullptr)) != 0) {
+        return aevum::util::Status::IOError(std::string("WT Commit failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
+/**
+ * @brief Fills an empty collection from `_id`-sorted documents through a bulk cursor.
+ * @details The bulk cursor writes the leaf pages of the new table directly, so the load costs
+ * one sequential pass instead of a tree descent per document. A table that already has records
+ * refuses the bulk cursor, and is then written in one transaction.
+ * @param collection The name of the collection to fill.
+ * @param sorted_documents The `(_id, BSON bytes)` pairs in ascending `_id` order.
+ * @return `aevum::util::Status::OK()` on success, `InvalidArgument` for an empty document, or an
+ *         `IOError` if a write fails.
+ */
+aevum::util::Status WiredTigerStore::bulk_load_documents(
+    [[maybe_unused]] std::string_view collection,
+    [[maybe_unused]] const std::vector<std::pair<std::string, std::string_view>>
+        &sorted_documents) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+    for (const auto &[id, bytes] : sorted_documents) {
+        if (bytes.empty()) {
+            return aevum::util::Status::InvalidArgument("Document '" + id + "' is empty");
+        }
+    }
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+    WT_SESSION *session = lease.session();
+    if (auto status = ensure_table(session, collection); !status.ok()) return status;
+
+    std::string uri = make_uri(collection);
+    WT_ITEM value_item{};
+    WT_CURSOR *bulk = nullptr;
+    int ret = session->open_cursor(session, uri.c_str(), nullptr, "bulk", &bulk);
+    if (ret == 0) {
+        const std::string *invalid_id = nullptr;
+        for (const auto &[id, bytes] : sorted_documents) {
+            value_item.data = bytes.data();
+            value_item.size = bytes.size();
+            if (!set_id_key(bulk, id)) {
+                invalid_id = &id;
+                break;
+            }
+            bulk->set_value(bulk, &value_item);
+            if ((ret = bulk->insert(bulk)) != 0) break;
+        }
+        int close_ret = bulk->close(bulk);
+        if (ret == 0) ret = close_ret;
+        if (invalid_id) {
+            return aevum::util::Status::InvalidArgument("_id '" + *invalid_id +
+                                                        "' is not an integer");
+        }
+        if (ret != 0) {
+            AEVUM_LOG_ERROR("WiredTiger: Bulk load failed for table '" + uri + "'. Error: " +
+                            wiredtiger_strerror(ret));
+            return aevum::util::Status::IOError(std::string("WT Bulk Load failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+        AEVUM_LOG_DEBUG("WiredTiger: Bulk-loaded " + std::to_string(sorted_documents.size()) +
+                        " documents into '" + uri + "'.");
+        return aevum::util::Status::OK();
+    }
+
+    AEVUM_LOG_DEBUG("WiredTiger: Table '" + uri +
+                    "' cannot be bulk-loaded; inserting documents transactionally.");
+    WT_CURSOR *cursor = nullptr;
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) return status;
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
+
+    if ((ret = session->begin_transaction(session, nullptr)) != 0) {
+        return aevum::util::Status::IOError(std::string("WT Begin Transaction failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    for (const auto &[id, bytes] : sorted_documents) {
+        value_item.data = bytes.data();
+        value_item.size = bytes.size();
+        if (!set_id_key(cursor, id)) {
+            session->rollback_transaction(session, nullptr);
+            return aevum::util::Status::InvalidArgument("_id '" + id + "' is not an integer");
+        }
+        cursor->set_value(cursor, &value_item);
+        if ((ret = cursor->insert(cursor)) != 0) {
+            session->rollback_transaction(session, nullptr);
+            return aevum::util::Status::IOError(std::string("WT Insert failed: ") +
+                                                wiredtiger_strerror(ret));
+        }
+    }
+    if ((ret = session->commit_transaction(session, nullptr)) != 0) {
+        return aevum::util::Status::IOError(std::string("WT Commit failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    return aevum::util::Status::OK();
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
 /**
  * @brief Inserts a new record or updates an existing one (upsert) in a specified collection.
  * @details The function maps the document's `_id` to the table's key and the document's binary
  * BSON data to the table's value. It uses `cursor->insert()`, which in WiredTiger's default
- * configuration performs an upsert.
+ * configuration performs an upsert. A collection that uses a field dictionary is written through
+ * `apply_batch` instead, which encodes the document and persists new names transactionally.
  *
  * @param collection The name of the target collection.
  * @param id The unique identifier for the document, used as the primary key.
  * @param doc The `aevum::bson::doc::Document` to be written to storage.
+ * @param durability How far the write is persisted before returning.
  * @return `aevum::util::Status::OK()` on successful write, `IOError` on failure.
  */
 aevum::util::Status WiredTigerStore::put([[maybe_unused]] std::string_view collection,
                                          [[maybe_unused]] std::string_view id,
-                                         [[maybe_unused]] const aevum::bson::doc::Document &doc) {
+                                         [[maybe_unused]] const aevum::bson::doc::Document &doc,
+                                         [[maybe_unused]] Durability durability) {
 #ifdef HAVE_WIREDTIGER
     if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
     if (doc.empty() || !doc.get())
         return aevum::util::Status::InvalidArgument("Empty BSON document");
+    // A document that introduces a name must commit together with the dictionary record.
+    if (uses_dictionary(collection)) {
+        return apply_batch(collection, {{std::string(id), doc}}, {}, {}, durability);
+    }
 
-    WT_SESSION *session = nullptr;
-    conn_->open_session(conn_, nullptr, nullptr, &session);
-    AEVUM_DEFER([&]() {
-        if (session) session->close(session, nullptr);
-    });
-
-    if (auto status = ensure_table(session, collection); !status.ok()) return status;
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
 
-    std::string uri = make_uri(collection);
     WT_CURSOR *cursor = nullptr;
-    int ret = session->open_cursor(session, uri.c_str(), nullptr, nullptr, &cursor);
-    if (ret != 0) return aevum::util::Status::IOError("WT Open Cursor failed for '" + uri + "'.");
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) return status;
 
-    AEVUM_DEFER([&]() {
-        if (cursor) cursor->close(cursor);
-    });
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
 
+    std::string uri = make_uri(collection);
     const uint8_t *bson_data = bson_get_data(doc.get());
     WT_ITEM value_item;
     value_item.data = bson_data;
     value_item.size = doc.length();
 
     std::string id_str(id);
-    cursor->set_key(cursor, id_str.c_str());
+    if (!set_id_key(cursor, id_str)) {
+        return aevum::util::Status::InvalidArgument("_id '" + id_str + "' is not an integer");
+    }
     cursor->set_value(cursor, &value_item);
 
-    ret = cursor->insert(cursor);
+    int ret = cursor->insert(cursor);
     if (ret != 0) {
-        aevum::util::log::Logger::error("WiredTiger: Insert/update failed for key '" + id_str +
-                                        "' in table '" + uri +
-                                        "'. Error: " + wiredtiger_strerror(ret));
+        AEVUM_LOG_ERROR("WiredTiger: Insert/update failed for key '" + id_str + "' in table '" +
+                        uri + "'. Error: " + wiredtiger_strerror(ret));
         return aevum::util::Status::IOError(std::string("WT Insert failed: ") +
                                             wiredtiger_strerror(ret));
     }
 
-    return aevum::util::Status::OK();
+    return make_durable(durability);
 #else
     return aevum::util::Status::OK();  // No-op
 #endif
@@ -309,118 +1435,375 @@ aevum::util::Status WiredTigerStore::put([[maybe_unused]] std::string_view colle
  * @brief Removes a record from a collection table, identified by its key (`_id`).
  * @param collection The name of the target collection.
  * @param id The unique ID of the document to be removed.
+ * @param durability How far the removal is persisted before returning.
  * @return `aevum::util::Status::OK()` on success. `WT_NOTFOUND` is treated as success. Returns
  *         `IOError` if the underlying WiredTiger operation fails for other reasons.
  */
 aevum::util::Status WiredTigerStore::remove([[maybe_unused]] std::string_view collection,
-                                            [[maybe_unused]] std::string_view id) {
+                                            [[maybe_unused]] std::string_view id,
+                                            [[maybe_unused]] Durability durability) {
 #ifdef HAVE_WIREDTIGER
     if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
 
-    WT_SESSION *session = nullptr;
-    conn_->open_session(conn_, nullptr, nullptr, &session);
-    AEVUM_DEFER([&]() {
-        if (session) session->close(session, nullptr);
-    });
-
-    if (auto status = ensure_table(session, collection); !status.ok()) return status;
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
 
-    std::string uri = make_uri(collection);
     WT_CURSOR *cursor = nullptr;
-    int ret = session->open_cursor(session, uri.c_str(), nullptr, nullptr, &cursor);
-    if (ret != 0) return aevum::util::Status::IOError("WT Open Cursor failed for '" + uri + "'.");
+    if (auto status = lease.cursor(collection, &cursor); !status.ok()) return status;
 
-    AEVUM_DEFER([&]() {
-        if (cursor) cursor->close(cursor);
-    });
+    AEVUM_DEFER([&]() { cursor->reset(cursor); });
 
+    std::string uri = make_uri(collection);
     std::string id_str(id);
-    cursor->set_key(cursor, id_str.c_str());
+    // An integer-keyed table holds no key that is not an integer, so there is nothing to remove.
+    if (!set_id_key(cursor, id_str)) return aevum::util::Status::OK();
 
-    ret = cursor->remove(cursor);
+    int ret = cursor->remove(cursor);
     if (ret != 0 && ret != WT_NOTFOUND) {
-        aevum::util::log::Logger::error("WiredTiger: Remove failed for key '" + id_str +
-                                        "' in table '" + uri +
-                                        "'. Error: " + wiredtiger_strerror(ret));
+        AEVUM_LOG_ERROR("WiredTiger: Remove failed for key '" + id_str + "' in table '" + uri +
+                        "'. Error: " + wiredtiger_strerror(ret));
         return aevum::util::Status::IOError(std::string("WT Remove failed: ") +
                                             wiredtiger_strerror(ret));
     }
 
-    return aevum::util::Status::OK();
+    return make_durable(durability);
 #else
     return aevum::util::Status::OK();  // No-op
 #endif
 }
 
 /**
- * @brief Atomically replaces the entire content of a collection with a new set of documents.
- * @details This highly destructive but efficient method is used to synchronize the state of a
- * collection with an entirely new dataset (e.g., after an in-memory update operation from the
- * Rust FFI). It first forcibly drops the existing table, ignoring "not found" errors, then
- * re-creates it, and finally performs a bulk insert of all the new documents.
+ * @brief Applies a batch of upserts and deletions to a collection in a single transaction.
+ * @details All writes share one session and one cursor, and are bracketed by
+ * `begin_transaction`/`commit_transaction`, so either every record of the batch becomes durable or
+ * none does. Only the listed keys are written; the rest of the table is left untouched. The first
+ * failing write rolls the whole transaction back. As with `remove`, deleting a key that does not
+ * exist is not an error.
  *
- * @param collection The name of the collection to be synchronized.
- * @param documents The complete new dataset for the collection.
- * @return `aevum::util::Status::OK()` on success, `IOError` on failure.
+ * The cursors on the tables named by `key_writes` are all obtained before the transaction
+ * begins, since obtaining one may have to create its table, which WiredTiger does not allow
+ * inside a running transaction.
+ *
+ * For a collection that uses a field dictionary, the documents are encoded before they are
+ * written. If that assigned ids the persisted dictionary does not hold yet, the whole dictionary
+ * is rewritten in the same transaction, so that no committed document refers to an id whose name
+ * could be lost. Ids assigned by a batch that rolls back are persisted by the next one.
+ *
+ * @param collection The name of the target collection.
+ * @param puts The `(_id, document)` pairs to insert or overwrite.
+ * @param deletes The `_id`s of the records to remove, applied after `puts`.
+ * @param key_writes Key-only writes to other tables, applied last with empty values.
+ * @param durability How far the committed batch is persisted before returning.
+ * @return `aevum::util::Status::OK()` if the transaction committed, `InvalidArgument` if a document
+ *         in `puts` is empty or cannot be encoded, or `IOError` if any WiredTiger operation or
+ *         reading the field dictionary failed.
  */
-aevum::util::Status WiredTigerStore::sync_collection(
-    [[maybe_unused]] std::string_view collection,
-    [[maybe_unused]] const std::vector<std::pair<std::string, aevum::bson::doc::Document>>
-        &documents) {
+aevum::util::Status WiredTigerStore::apply_batch(
+    std::string_view collection,
+    const std::vector<std::pair<std::string, aevum::bson::doc::Document>> &puts,
+    const std::vector<std::string> &deletes, const std::vector<KeyWrite> &key_writes,
+    Durability durability) {
+    return apply_batches({CollectionBatch{collection, puts, deletes}}, key_writes, durability);
+}
+
+/**
+ * @brief Applies the batches of several collections in a single transaction.
+ * @details The body of `apply_batch`, generalized to several collections: the cursors of every
+ * collection, of the field dictionary, and of the key-only tables are all obtained first, then
+ * every batch is written in turn inside one transaction, and the field dictionaries that gained
+ * ids are rewritten in the same transaction before it commits.
+ *
+ * The patches of a batch are written with `WT_CURSOR::modify`, which WiredTiger only allows
+ * inside an explicit snapshot transaction such as this one. It records the changed bytes as a
+ * modify update rather than a new copy of the document, so a counter increment of a large
+ * document journals a few bytes. A patch of a missing document fails the transaction.
+ *
+ * @param batches The writes of each collection.
+ * @param key_writes Key-only writes to other tables, applied last with empty values.
+ * @param durability How far the committed transaction is persisted before returning.
+ * @return `aevum::util::Status::OK()` if the transaction committed, `InvalidArgument` if a document
+ *         is empty or cannot be encoded or a dictionary-encoded collection has patches, or
+ *         `IOError` if any WiredTiger operation or reading a field dictionary failed.
+ */
+aevum::util::Status WiredTigerStore::apply_batches(
+    [[maybe_unused]] const std::vector<CollectionBatch> &batches,
+    [[maybe_unused]] const std::vector<KeyWrite> &key_writes,
+    [[maybe_unused]] Durability durability) {
 #ifdef HAVE_WIREDTIGER
     if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+    size_t put_count = 0;
+    size_t delete_count = 0;
+    size_t patch_count = 0;
+    for (const auto &batch : batches) {
+        for (const auto &[id_str, doc] : batch.puts) {
+            if (doc.empty() || !doc.get()) {
+                return aevum::util::Status::InvalidArgument("Empty BSON document for '" + id_str +
+                                                            "'");
+            }
+        }
+        put_count += batch.puts.size();
+        delete_count += batch.deletes.size();
+        if (batch.patches && !batch.patches->empty()) {
+            // The offsets of a patch refer to plain BSON, not to an encoded document.
+            if (uses_dictionary(batch.collection)) {
+                return aevum::util::Status::InvalidArgument(
+                    "The documents of '" + std::string(batch.collection) +
+                    "' are dictionary-encoded and cannot be patched in place");
+            }
+            patch_count += batch.patches->size();
+        }
+    }
+    if (put_count == 0 && delete_count == 0 && patch_count == 0 && key_writes.empty()) {
+        return aevum::util::Status::OK();
+    }
 
-    std::string coll_str(collection);
-    aevum::util::log::Logger::debug("WiredTiger: Beginning full sync for collection '" + coll_str +
-                                    "'. " + std::to_string(documents.size()) +
-                                    " documents to be written.");
+    // The cursor and, if the collection encodes its documents, the field dictionary of a batch.
+    struct BatchTarget {
+        WT_CURSOR *cursor = nullptr;
+        aevum::bson::doc::FieldDictionary *dict = nullptr;
+    };
+    std::vector<BatchTarget> targets(batches.size());
+    for (size_t i = 0; i < batches.size(); ++i) {
+        if (batches[i].puts.empty() || !uses_dictionary(batches[i].collection)) continue;
+        targets[i].dict = dictionary(batches[i].collection);
+        if (!targets[i].dict) {
+            return aevum::util::Status::IOError("Cannot read the field dictionary of '" +
+                                                std::string(batches[i].collection) + "'.");
+        }
+    }
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
 
-    WT_SESSION *session = nullptr;
-    conn_->open_session(conn_, nullptr, nullptr, &session);
     AEVUM_DEFER([&]() {
-        if (session) session->close(session, nullptr);
+        for (auto &target : targets) {
+            if (target.cursor) target.cursor->reset(target.cursor);
+        }
     });
+    bool any_dictionary = false;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        if (auto status = lease.cursor(batches[i].collection, &targets[i].cursor); !status.ok()) {
+            return status;
+        }
+        any_dictionary = any_dictionary || targets[i].dict;
+    }
 
-    std::string uri = make_uri(collection);
+    WT_CURSOR *dictionary_cursor = nullptr;
+    if (any_dictionary) {
+        if (auto status = lease.cursor(FIELD_DICTIONARY_TABLE, &dictionary_cursor); !status.ok()) {
+            return status;
+        }
+    }
+    AEVUM_DEFER([&]() {
+        if (dictionary_cursor) dictionary_cursor->reset(dictionary_cursor);
+    });
 
-    int ret = session->drop(session, uri.c_str(), "force");
-    if (ret != 0 && ret != WT_NOTFOUND) {
-        aevum::util::log::Logger::error("WiredTiger: Drop table failed during sync for '" + uri +
-                                        "'. Error: " + wiredtiger_strerror(ret));
-        return aevum::util::Status::IOError(std::string("WT Drop failed: ") +
+    std::unordered_map<std::string, WT_CURSOR *> key_cursors;
+    AEVUM_DEFER([&]() {
+        for (auto &[table, key_cursor] : key_cursors) key_cursor->reset(key_cursor);
+    });
+    for (const auto &write : key_writes) {
+        if (key_cursors.count(write.table) != 0) continue;
+        WT_CURSOR *key_cursor = nullptr;
+        if (auto status = lease.cursor(write.table, &key_cursor); !status.ok()) return status;
+        key_cursors.emplace(write.table, key_cursor);
+    }
+
+    WT_SESSION *session = lease.session();
+    int ret = session->begin_transaction(session, nullptr);
+    if (ret != 0) {
+        return aevum::util::Status::IOError(std::string("WT Begin Transaction failed: ") +
                                             wiredtiger_strerror(ret));
     }
 
-    if (auto status = ensure_table(session, collection); !status.ok()) return status;
+    // Rolls back the open transaction and reports the write that caused it.
+    auto abort_batch = [&](const std::string &operation, const std::string &key,
+                           const std::string &table_uri) {
+        AEVUM_LOG_ERROR("WiredTiger: " + operation + " failed for " + key + " in table '" +
+                        table_uri + "'. Rolling back batch. Error: " + wiredtiger_strerror(ret));
+        session->rollback_transaction(session, nullptr);
+        return aevum::util::Status::IOError("WT " + operation +
+                                            " failed: " + wiredtiger_strerror(ret));
+    };
 
-    WT_CURSOR *cursor = nullptr;
-    ret = session->open_cursor(session, uri.c_str(), nullptr, nullptr, &cursor);
-    if (ret != 0) return aevum::util::Status::IOError("WT Open Cursor failed for '" + uri + "'.");
+    std::string encoded;
+    std::vector<WT_MODIFY> modifications;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        WT_CURSOR *cursor = targets[i].cursor;
+        aevum::bson::doc::FieldDictionary *dict = targets[i].dict;
+        for (const auto &[id_str, doc] : batches[i].puts) {
+            WT_ITEM value_item;
+            value_item.data = bson_get_data(doc.get());
+            value_item.size = doc.length();
+            if (dict) {
+                if (!dict->encode(doc, encoded)) {
+                    session->rollback_transaction(session, nullptr);
+                    return aevum::util::Status::InvalidArgument("Document '" + id_str +
+                                                                "' is not well-formed BSON.");
+                }
+                value_item.data = encoded.data();
+                value_item.size = encoded.size();
+            }
 
-    AEVUM_DEFER([&]() {
-        if (cursor) cursor->close(cursor);
-    });
+            if (!set_id_key(cursor, id_str)) {
+                session->rollback_transaction(session, nullptr);
+                return aevum::util::Status::InvalidArgument("_id '" + id_str +
+                                                            "' is not an integer");
+            }
+            cursor->set_value(cursor, &value_item);
+            if ((ret = cursor->insert(cursor)) != 0) {
+                return abort_batch("Insert", "key '" + id_str + "'",
+                                   make_uri(batches[i].collection));
+            }
+        }
 
-    for (const auto &[id_str, doc] : documents) {
-        if (doc.empty() || !doc.get()) continue;
+        if (batches[i].patches) {
+            for (const auto &patch : *batches[i].patches) {
+                modifications.clear();
+                for (const auto &run : patch.patches) {
+                    WT_MODIFY modification{};
+                    modification.data.data = run.bytes.data();
+                    modification.data.size = run.bytes.size();
+                    modification.offset = run.offset;
+                    modification.size = run.bytes.size();
+                    modifications.push_back(modification);
+                }
+                if (!set_id_key(cursor, patch.id)) {
+                    session->rollback_transaction(session, nullptr);
+                    return aevum::util::Status::InvalidArgument("_id '" + patch.id +
+                                                                "' is not an integer");
+                }
+                ret = cursor->modify(cursor, modifications.data(),
+                                     static_cast<int>(modifications.size()));
+                if (ret != 0) {
+                    return abort_batch("Modify", "key '" + patch.id + "'",
+                                       make_uri(batches[i].collection));
+                }
+            }
+        }
 
-        WT_ITEM value_item;
-        value_item.data = bson_get_data(doc.get());
-        value_item.size = doc.length();
+        for (const auto &id_str : batches[i].deletes) {
+            if (!set_id_key(cursor, id_str)) continue;
+            ret = cursor->remove(cursor);
+            if (ret != 0 && ret != WT_NOTFOUND) {
+                return abort_batch("Remove", "key '" + id_str + "'",
+                                   make_uri(batches[i].collection));
+            }
+        }
+    }
 
-        cursor->set_key(cursor, id_str.c_str());
-        cursor->set_value(cursor, &value_item);
+    WT_ITEM empty_value{};
+    for (const auto &write : key_writes) {
+        WT_CURSOR *key_cursor = key_cursors.at(write.table);
+        key_cursor->set_key(key_cursor, write.key.c_str());
+        if (write.remove) {
+            ret = key_cursor->remove(key_cursor);
+            if (ret != 0 && ret != WT_NOTFOUND) {
+                return abort_batch("Remove", "a key-only record", make_uri(write.table));
+            }
+        } else {
+            key_cursor->set_value(key_cursor, &empty_value);
+            if ((ret = key_cursor->insert(key_cursor)) != 0) {
+                return abort_batch("Insert", "a key-only record", make_uri(write.table));
+            }
+        }
+    }
 
-        ret = cursor->insert(cursor);
-        if (ret != 0) {
-            aevum::util::log::Logger::warn("WiredTiger: Insert failed during sync for ID '" +
-                                           id_str + "' in '" + uri + "'.");
+    // The names are read after every document is encoded, so they cover all the ids written.
+    std::vector<size_t> persisted_names(batches.size(), 0);
+    for (size_t i = 0; i < batches.size(); ++i) {
+        aevum::bson::doc::FieldDictionary *dict = targets[i].dict;
+        if (!dict || dict->size() <= dict->persisted_size()) continue;
+        std::vector<std::string> names = dict->names();
+        aevum::bson::doc::Document record = field_dictionary_record(batches[i].collection, names);
+        std::string key =
+            std::string(FIELD_DICTIONARY_KEY_PREFIX) + std::string(batches[i].collection);
+        WT_ITEM record_item;
+        record_item.data = bson_get_data(record.get());
+        record_item.size = record.length();
+        dictionary_cursor->set_key(dictionary_cursor, key.c_str());
+        dictionary_cursor->set_value(dictionary_cursor, &record_item);
+        if ((ret = dictionary_cursor->insert(dictionary_cursor)) != 0) {
+            return abort_batch("Insert", "the field dictionary",
+                               make_uri(FIELD_DICTIONARY_TABLE));
         }
+        persisted_names[i] = names.size();
     }
 
-    aevum::util::log::Logger::debug("WiredTiger: Sync completed for collection '" + coll_str +
-                                    "'.");
-    return aevum::util::Status::OK();
+    ret = session->commit_transaction(session, nullptr);
+    if (ret != 0) {
+        // A failed commit rolls the transaction back on its own.
+        AEVUM_LOG_ERROR("WiredTiger: Commit failed for a batch of " +
+                        std::to_string(batches.size()) +
+                        " collections. Error: " + wiredtiger_strerror(ret));
+        return aevum::util::Status::IOError(std::string("WT Commit failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+    for (size_t i = 0; i < batches.size(); ++i) {
+        if (persisted_names[i] > 0) targets[i].dict->mark_persisted(persisted_names[i]);
+    }
+
+    AEVUM_LOG_DEBUG("WiredTiger: Applied batch of " + std::to_string(put_count) + " puts, " +
+                    std::to_string(patch_count) + " patches, " +
+                    std::to_string(delete_count) + " deletes and " +
+                    std::to_string(key_writes.size()) + " key writes to " +
+                    std::to_string(batches.size()) + " collections.");
+    return make_durable(durability);
+#else
+    return aevum::util::Status::OK();  // No-op
+#endif
+}
+
+/**
+ * @brief Drops the table of a collection together with all of its records.
+ * @details WiredTiger refuses to drop a table while any session has a cursor open on it, so the
+ * cached cursor on the table is closed in the leased session and in every idle one before the
+ * drop. Sessions leased by other threads are left alone; if one of them holds a cursor on the
+ * table, the drop fails with `EBUSY`. On success the URI is removed from the known-tables set and
+ * from `_catalog`, so the next write re-creates the table. The `force` option makes dropping a
+ * missing table succeed.
+ *
+ * @param collection The collection to drop.
+ * @return `aevum::util::Status::OK()` on success, `IOError` on failure.
+ */
+aevum::util::Status WiredTigerStore::drop_collection(
+    [[maybe_unused]] std::string_view collection) {
+#ifdef HAVE_WIREDTIGER
+    if (!conn_) return aevum::util::Status::Corruption("WT Connection is null");
+
+    SessionLease lease = acquire_session();
+    if (!lease) return aevum::util::Status::IOError("WT Open Session failed");
+
+    std::string uri = make_uri(collection);
+    lease.close_cursor(uri);
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto &cached : idle_sessions_) {
+            auto it = cached->cursors.find(uri);
+            if (it == cached->cursors.end()) continue;
+            it->second->close(it->second);
+            cached->cursors.erase(it);
+        }
+    }
+
+    WT_SESSION *session = lease.session();
+    int ret = session->drop(session, uri.c_str(), "force");
+    if (ret != 0) {
+        AEVUM_LOG_ERROR("WiredTiger: Drop table failed for '" + uri + "'. Error: " +
+                        wiredtiger_strerror(ret));
+        return aevum::util::Status::IOError(std::string("WT Drop failed: ") +
+                                            wiredtiger_strerror(ret));
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(tables_mutex_);
+        known_tables_.erase(uri);
+        catalog_.erase(std::string(collection));
+        key_formats_.erase(std::string(collection));
+    }
+    AEVUM_LOG_INFO("WiredTiger: Dropped table '" + uri + "'.");
+    // A crash before the row is removed leaves a listed table that is created again, empty.
+    return write_catalog(collection, true);
 #else
     return aevum::util::Status::OK();  // No-op
 #endif
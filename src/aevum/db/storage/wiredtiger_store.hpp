@@ -13,8 +13,17 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -28,10 +37,86 @@ typedef struct __wt_cursor WT_CURSOR;
 #endif
 
 #include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/doc/field_dictionary.hpp"
+#include "aevum/db/storage/group_commit.hpp"
+#include "aevum/db/storage/storage_options.hpp"
 #include "aevum/util/status.hpp"
+#include "aevum/util/time/stopwatch.hpp"
 
 namespace aevum::db::storage {
 
+/**
+ * @struct KeyWrite
+ * @brief A key-only record that `WiredTigerStore::apply_batch` writes alongside a collection.
+ * @details Tables whose information lives entirely in their keys, such as the persisted entries
+ * of a secondary index, store an empty value. Carrying their writes in the batch of the
+ * collection they describe keeps both in one transaction.
+ */
+struct KeyWrite {
+    /// The table the key belongs to.
+    std::string table;
+    /// The key to insert or remove. It must not contain NUL bytes (`key_format=S`).
+    std::string key;
+    /// `true` to remove the key, `false` to insert it.
+    bool remove = false;
+};
+
+/**
+ * @struct ValuePatch
+ * @brief A run of bytes that replaces as many bytes of a stored document.
+ */
+struct ValuePatch {
+    /// The offset of the run within the document's BSON bytes.
+    size_t offset = 0;
+    /// The new bytes.
+    std::string bytes;
+};
+
+/**
+ * @struct PatchWrite
+ * @brief An in-place change of a stored document, written with `WT_CURSOR::modify`.
+ * @details Only the patched bytes reach the storage engine's update chain and journal, instead
+ * of the whole document. The patches must not change the document's length, and the collection
+ * must store plain BSON, not dictionary-encoded documents.
+ */
+struct PatchWrite {
+    /// The `_id` of the document.
+    std::string id;
+    /// The runs to replace, in any order and not overlapping.
+    std::vector<ValuePatch> patches;
+};
+
+/**
+ * @struct CollectionBatch
+ * @brief The writes to one collection within `WiredTigerStore::apply_batches`.
+ * @details The writes are borrowed, not copied; they must outlive the call.
+ */
+struct CollectionBatch {
+    /// The target collection.
+    std::string_view collection;
+    /// The `(_id, document)` pairs to insert or overwrite.
+    const std::vector<std::pair<std::string, aevum::bson::doc::Document>> &puts;
+    /// The `_id`s of the records to remove.
+    const std::vector<std::string> &deletes;
+    /// The documents to patch in place, applied after `puts` and before `deletes`, or null.
+    const std::vector<PatchWrite> *patches = nullptr;
+};
+
+/**
+ * @struct StorageStats
+ * @brief A snapshot of the time a `WiredTigerStore` has spent in the storage engine.
+ */
+struct StorageStats {
+    /// The operations that held a session.
+    uint64_t operations{0};
+    /// The time sessions were held, excluding the callbacks of scans, in microseconds.
+    uint64_t busy_us{0};
+    /// The writes that waited for the journal to be flushed.
+    uint64_t durability_waits{0};
+    /// The time spent waiting for journal flushes, in microseconds.
+    uint64_t durability_wait_us{0};
+};
+
 /**
  * @class WiredTigerStore
  * @brief Provides a modern C++ facade for interacting with the WiredTiger key-value store.
@@ -42,6 +127,21 @@ namespace aevum::db::storage {
  * "documents" into WiredTiger's native table and key-value pair semantics. All public methods
  * provide a clean, status-based error handling mechanism and are designed to work seamlessly with
  * the `aevum::bson::doc::Document` type for storing BSON data.
+ *
+ * WiredTiger sessions are not thread-safe, and opening a session, creating a table, and opening a
+ * cursor are metadata operations that can cost more than the B-tree write they precede. The store
+ * therefore keeps a pool of open sessions, each with the cursors it has already opened, and lends
+ * one to the calling thread for the duration of every operation. Tables known to exist are
+ * remembered, so `ensure_table` only reaches WiredTiger the first time a collection is touched.
+ *
+ * Every write takes a `Durability` level. Transactions are committed without flushing the
+ * journal; writers that need `JOURNAL` or `FSYNC` durability then wait on a `GroupCommitter`,
+ * which lets concurrent writers share a single `log_flush` instead of issuing one each.
+ *
+ * With `StorageOptions::field_dictionary` set, the documents of user collections are written
+ * encoded with a per-collection `FieldDictionary`, which is persisted in `_schemas` in the same
+ * transaction as the first document using a new name. Every read decodes such values back to
+ * BSON, whether or not the option is set, so callers never see the encoding.
  */
 class WiredTigerStore {
   public:
@@ -49,8 +149,9 @@ class WiredTigerStore {
      * @brief Constructs a `WiredTigerStore` instance associated with a specific filesystem path.
      * @param base_path The root directory path where WiredTiger will create and manage its data
      * files. This path will be created if it does not already exist.
+     * @param options The journaling and durability configuration of the store.
      */
-    explicit WiredTigerStore(std::string base_path);
+    explicit WiredTigerStore(std::string base_path, StorageOptions options = {});
 
     /**
      * @brief Destroys the `WiredTigerStore`, ensuring a graceful shutdown of the underlying
@@ -71,8 +172,9 @@ class WiredTigerStore {
      * @brief Initializes the WiredTiger storage engine and opens the database connection.
      * @details This method must be called before any other operations can be performed. It ensures
      * the base data directory exists and then calls `wiredtiger_open` to either create a new
-     * database at that path or open an existing one. It also configures essential parameters
-     * like cache size.
+     * database at that path or open an existing one. The cache size, eviction, and journal are
+     * configured from the options, and the group committer is started if the journal is enabled.
+     * A block compressor that cannot be loaded is replaced by no compression, with a warning.
      * @return `aevum::util::Status::OK()` on successful initialization.
      * @return `aevum::util::Status::IOError` if the directory cannot be created or if
      *         `wiredtiger_open` fails.
@@ -81,12 +183,31 @@ class WiredTigerStore {
 
     /**
      * @brief Retrieves a list of all user-defined collection names from the database.
-     * @details This function queries the special `metadata:` table within WiredTiger to discover
-     * all user-created tables, filtering out internal WiredTiger tables.
-     * @return A `std::vector<std::string>` containing the names of all collections.
+     * @details The names are read from the in-memory copy of the `_catalog` table, which `init`
+     * loads, so listing costs no storage access however many tables exist. The catalog itself
+     * is not listed.
+     * @return A `std::vector<std::string>` containing the names of all collections, sorted.
      */
     [[nodiscard]] std::vector<std::string> list_collections();
 
+    /**
+     * @brief Checks whether a collection has a table, from the in-memory copy of `_catalog`.
+     * @param collection The name of the collection.
+     * @return `true` if the collection is listed in the catalog.
+     */
+    [[nodiscard]] bool has_collection(std::string_view collection);
+
+    /**
+     * @brief Returns the key format of a collection's table.
+     * @details The keys of every method taking an `_id` are strings; those of an integer-keyed
+     * table are the decimal form of the integer, which is converted at the cursor. The format of
+     * an existing table, which is the one it was created with, is read once and cached. A
+     * collection without a table reports the format its table would be created with.
+     * @param collection The name of the collection.
+     * @return The key format.
+     */
+    [[nodiscard]] KeyFormat key_format(std::string_view collection);
+
     /**
      * @brief Loads and deserializes all documents from a specified collection.
      * @details This function opens a cursor on the collection's table and iterates through every
@@ -99,6 +220,110 @@ class WiredTigerStore {
     [[nodiscard]] std::vector<aevum::bson::doc::Document> load_collection(
         std::string_view collection);
 
+    /**
+     * @brief Loads and deserializes the documents of a collection whose keys lie in a range.
+     * @details The cursor is positioned with `search_near` on `lower` and walks forward until it
+     * reaches `upper`, so disjoint ranges can be loaded concurrently, each through its own
+     * session. Together with `sample_split_keys` this partitions the load of a large collection.
+     * @param collection The name of the collection to load.
+     * @param lower The smallest key to load, inclusive, or an empty string for the first key.
+     * @param upper The key at which to stop, exclusive, or an empty string for no bound.
+     * @return The documents in the range, in key order.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> load_collection_range(
+        std::string_view collection, std::string_view lower, std::string_view upper);
+
+    /**
+     * @brief Picks keys that split a collection into ranges of roughly equal size.
+     * @details Keys are sampled with a `next_random` cursor, which descends the B-tree to a random
+     * leaf instead of reading the table, so sampling is cheap even for very large collections.
+     * The returned keys are the quantiles of the sample. A collection with too few distinct keys
+     * to be split yields fewer keys, possibly none.
+     * @param collection The name of the collection.
+     * @param partitions The desired number of ranges.
+     * @return At most `partitions - 1` distinct split keys in ascending order.
+     */
+    [[nodiscard]] std::vector<std::string> sample_split_keys(std::string_view collection,
+                                                             size_t partitions);
+
+    /**
+     * @brief Streams the documents of a collection in batches.
+     * @details The table is read with a single cursor, and at most `batch_size` documents are
+     * held in memory at a time, so a collection can be scanned regardless of its size. The batch
+     * is handed to `visit` by reference and may be consumed (e.g. moved from) by it.
+     * @param collection The name of the collection to scan.
+     * @param batch_size The maximum number of documents per batch (at least 1).
+     * @param visit Called with each non-empty batch; returning `false` ends the scan.
+     * @return `aevum::util::Status::OK()` once the scan completes or `visit` stops it, or the
+     *         status of the failed cursor operation.
+     */
+    [[nodiscard]] aevum::util::Status scan_collection(
+        std::string_view collection, size_t batch_size,
+        const std::function<bool(std::vector<aevum::bson::doc::Document> &)> &visit);
+
+    /**
+     * @brief Reads a single document of a collection by its `_id` with a point lookup.
+     * @param collection The name of the collection.
+     * @param id The `_id` of the document.
+     * @param doc Receives the document on success.
+     * @return `aevum::util::Status::OK()` if the document was found, `NotFound` if it does not
+     *         exist, or an `IOError`/`Corruption` status if it cannot be read.
+     */
+    [[nodiscard]] aevum::util::Status get(std::string_view collection, std::string_view id,
+                                          aevum::bson::doc::Document &doc);
+
+    /**
+     * @brief Visits the keys of a table in ascending order.
+     * @details Values are not read. Used for key-only tables written through `KeyWrite`s.
+     * @param table The name of the table to scan. A missing table is created empty.
+     * @param visit Called with each key; returning `false` ends the scan.
+     * @return `aevum::util::Status::OK()` once the scan completes or `visit` stops it, or the
+     *         status of the failed cursor operation.
+     */
+    [[nodiscard]] aevum::util::Status scan_keys(std::string_view table,
+                                                const std::function<bool(std::string_view)> &visit);
+
+    /**
+     * @brief Visits the keys of a table in ascending order, starting at a lower bound.
+     * @param table The name of the table to scan. A missing table is created empty.
+     * @param start The inclusive lower bound, or empty to start at the first key.
+     * @param visit Called with each key; returning `false` ends the scan.
+     * @return `aevum::util::Status::OK()` once the scan completes or `visit` stops it, or the
+     *         status of the failed cursor operation.
+     */
+    [[nodiscard]] aevum::util::Status scan_keys(std::string_view table, std::string_view start,
+                                                const std::function<bool(std::string_view)> &visit);
+
+    /**
+     * @brief Fills a new, empty key-only table from keys given in ascending order.
+     * @details The keys are appended through a WiredTiger bulk cursor, which builds the B-tree
+     * leaf pages directly instead of descending the tree once per key. If the table cannot be
+     * bulk-loaded (for instance because it already has records), the keys are inserted in a
+     * single ordinary transaction instead.
+     * @param table The name of the table to fill.
+     * @param sorted_keys The keys, sorted byte-wise ascending and free of duplicates.
+     * @return `aevum::util::Status::OK()` on success, or an `IOError` if a write fails.
+     */
+    [[nodiscard]] aevum::util::Status bulk_load_keys(std::string_view table,
+                                                     const std::vector<std::string> &sorted_keys);
+
+    /**
+     * @brief Fills an empty collection from documents given in ascending `_id` order.
+     * @details Like `bulk_load_keys`, the records are appended through a WiredTiger bulk cursor,
+     * falling back to a single ordinary transaction if the table cannot be bulk-loaded. The
+     * documents are written as plain BSON, bypassing the field dictionary, which every read
+     * accepts. Secondary indexes are not maintained; they are built afterwards.
+     * @param collection The name of the collection to fill.
+     * @param sorted_documents The `(_id, BSON bytes)` pairs, sorted ascending by `_id` in the
+     *        table's key order (numerically for an integer-keyed table, byte-wise otherwise) and
+     *        free of duplicate ids. The bytes must stay valid for the duration of the call.
+     * @return `aevum::util::Status::OK()` on success, `InvalidArgument` if a document is empty
+     *         or an `_id` does not fit the table's keys, or an `IOError` if a write fails.
+     */
+    [[nodiscard]] aevum::util::Status bulk_load_documents(
+        std::string_view collection,
+        const std::vector<std::pair<std::string, std::string_view>> &sorted_documents);
+
     /**
      * @brief Inserts a new document or updates an existing one in a collection.
      * @details This function performs an "upsert" operation. It uses the provided `id` as the key.
@@ -107,35 +332,105 @@ class WiredTigerStore {
      * @param collection The target collection.
      * @param id The unique identifier for the document, used as the primary key in storage.
      * @param doc The `aevum::bson::doc::Document` to be stored.
-     * @return `aevum::util::Status::OK()` on success, or an `IOError` if the write operation fails.
+     * @param durability How far the write is persisted before returning. `DEFAULT` applies the
+     *        store's configured level.
+     * @return `aevum::util::Status::OK()` on success, or an `IOError` if the write operation or
+     *         the journal flush fails.
      */
     [[nodiscard]] aevum::util::Status put(std::string_view collection, std::string_view id,
-                                          const aevum::bson::doc::Document &doc);
+                                          const aevum::bson::doc::Document &doc,
+                                          Durability durability = Durability::DEFAULT);
 
     /**
      * @brief Removes a document from a collection using its unique identifier.
      * @param collection The target collection.
      * @param id The unique ID of the document to be removed.
+     * @param durability How far the write is persisted before returning. `DEFAULT` applies the
+     *        store's configured level.
      * @return `aevum::util::Status::OK()` on successful removal or if the key was not found.
-     *         Returns an `IOError` if the removal operation fails for other reasons.
+     *         Returns an `IOError` if the removal operation or the journal flush fails.
      */
-    [[nodiscard]] aevum::util::Status remove(std::string_view collection, std::string_view id);
+    [[nodiscard]] aevum::util::Status remove(std::string_view collection, std::string_view id,
+                                             Durability durability = Durability::DEFAULT);
 
     /**
-     * @brief Atomically replaces the entire content of a collection with a new set of documents.
-     * @details This powerful operation first drops the existing table for the collection and then
-     * re-creates it. It subsequently performs a bulk insert of all the provided documents. This is
-     * highly efficient for performing wholesale updates on a collection's data, as returned by
-     * the Rust FFI update/delete operations.
-     * @param collection The target collection to be synchronized.
-     * @param documents A vector of `std::pair<std::string, Document>` representing the complete
-     *        new content for the collection, where the first element is the document ID (key) and
-     *        the second is the document itself (value).
-     * @return `aevum::util::Status::OK()` on success, or an `IOError` on failure.
+     * @brief Applies a batch of upserts and deletions to a collection in a single transaction.
+     * @details Every write of the batch goes through one cursor inside one WiredTiger transaction,
+     * so the batch is applied atomically and costs exactly one record write per entry, however
+     * large the collection is. Key-only writes to other tables, such as secondary index entries,
+     * are committed in the same transaction. If any write fails, the transaction is rolled back
+     * and every table is left as it was.
+     * @param collection The target collection.
+     * @param puts The `(_id, document)` pairs to insert or overwrite.
+     * @param deletes The `_id`s of the records to remove. Missing keys are ignored.
+     * @param key_writes Key-only writes to other tables, applied after `puts` and `deletes`.
+     *        Removing a missing key is ignored.
+     * @param durability How far the write is persisted before returning. `DEFAULT` applies the
+     *        store's configured level.
+     * @return `aevum::util::Status::OK()` if the batch committed, `InvalidArgument` if a document
+     *         in `puts` is empty, or an `IOError` if the transaction failed and was rolled back or
+     *         the journal flush failed after the commit.
      */
-    [[nodiscard]] aevum::util::Status sync_collection(
+    [[nodiscard]] aevum::util::Status apply_batch(
         std::string_view collection,
-        const std::vector<std::pair<std::string, aevum::bson::doc::Document>> &documents);
+        const std::vector<std::pair<std::string, aevum::bson::doc::Document>> &puts,
+        const std::vector<std::string> &deletes, const std::vector<KeyWrite> &key_writes = {},
+        Durability durability = Durability::DEFAULT);
+
+    /**
+     * @brief Applies the batches of several collections in a single transaction.
+     * @details The multi-collection form of `apply_batch`, for a transaction that writes to more
+     * than one collection: every batch and every key-only write commits together or not at all.
+     * @param batches The writes of each collection; a collection appears at most once.
+     * @param key_writes Key-only writes to other tables, applied after every batch.
+     * @param durability How far the write is persisted before returning. `DEFAULT` applies the
+     *        store's configured level.
+     * @return The same statuses as `apply_batch`.
+     */
+    [[nodiscard]] aevum::util::Status apply_batches(const std::vector<CollectionBatch> &batches,
+                                                    const std::vector<KeyWrite> &key_writes = {},
+                                                    Durability durability = Durability::DEFAULT);
+
+    /**
+     * @brief Drops the table of a collection together with all of its records.
+     * @details The cached cursors on the table are closed in every idle session first, since
+     * WiredTiger refuses to drop a table with open cursors, and the table is forgotten by the
+     * known-tables set so that a later write re-creates it. Dropping a collection that does not
+     * exist succeeds.
+     * @param collection The collection to drop.
+     * @return `aevum::util::Status::OK()` on success, or an `IOError` if the drop fails (for
+     *         instance because another thread is using the table at the same time).
+     */
+    [[nodiscard]] aevum::util::Status drop_collection(std::string_view collection);
+
+    /**
+     * @brief Waits until every transaction committed so far reaches a durability level.
+     * @details The write methods call this themselves after committing. Callers that serialize
+     * their writes under a lock of their own should instead write with `Durability::NONE` and
+     * call this after releasing the lock, so that the journal flush of one writer can be shared
+     * with the writers queued behind it.
+     * @param durability The requested level. `DEFAULT` is resolved to the configured level.
+     * @return `aevum::util::Status::OK()` once the level is reached (immediately for `NONE` or if
+     *         the journal is disabled), or an `IOError` if the journal flush failed.
+     */
+    [[nodiscard]] aevum::util::Status make_durable(Durability durability = Durability::DEFAULT);
+
+    /**
+     * @brief Returns the time spent in the storage engine so far.
+     * @return The snapshot of the store's counters.
+     */
+    [[nodiscard]] StorageStats stats() const noexcept;
+
+    /**
+     * @brief Reads a selection of WiredTiger's connection statistics.
+     * @details The connection is opened with `statistics=(fast)`, so the statistics are
+     * maintained at little cost; this reads the cache, I/O, and transaction counters an operator
+     * needs to tell a cold cache or a saturated journal from a slow query. Statistics the linked
+     * WiredTiger version does not have are omitted.
+     * @return The statistics as pairs of WiredTiger's description (e.g. `"cache: bytes currently
+     *         in the cache"`) and value; empty if the store is not open.
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, int64_t>> engine_statistics();
 
     /**
      * @brief Provides direct, low-level access to the raw WiredTiger connection pointer.
@@ -146,16 +441,209 @@ class WiredTigerStore {
      */
     [[nodiscard]] WT_CONNECTION *connection() const { return conn_; }
 
+    /**
+     * @brief Returns the directory holding the database files.
+     * @return The path given at construction.
+     */
+    [[nodiscard]] const std::string &base_path() const noexcept { return base_path_; }
+
+    /**
+     * @brief Checks whether new documents of a collection are written with a field dictionary.
+     * @param collection The name of the collection.
+     * @return `true` if `StorageOptions::field_dictionary` is set and the collection is not a
+     *         system collection, whose names start with an underscore.
+     */
+    [[nodiscard]] bool uses_dictionary(std::string_view collection) const noexcept;
+
   private:
+    /**
+     * @struct CachedSession
+     * @brief An open WiredTiger session together with the cursors it has opened, keyed by URI.
+     */
+    struct CachedSession {
+        /// The open session.
+        WT_SESSION *session{nullptr};
+        /// The cursors opened on `session`, keyed by table URI. They are reset, not closed, after
+        /// each use.
+        std::unordered_map<std::string, WT_CURSOR *> cursors;
+    };
+
+    /**
+     * @class SessionLease
+     * @brief Gives the calling thread exclusive use of a cached session for one operation.
+     * @details The session is returned to the pool of idle sessions when the lease is destroyed.
+     * A lease is empty if no session could be obtained.
+     */
+    class SessionLease {
+      public:
+        /**
+         * @brief Takes ownership of a cached session on behalf of a store.
+         * @param store The store whose pool the session is returned to.
+         * @param cached The leased session, or `nullptr` for an empty lease.
+         */
+        SessionLease(WiredTigerStore &store, std::unique_ptr<CachedSession> cached);
+
+        /**
+         * @brief Returns the session to the pool of idle sessions and adds the time it was held to
+         * the store's counters.
+         */
+        ~SessionLease();
+
+        SessionLease(const SessionLease &) = delete;
+        SessionLease &operator=(const SessionLease &) = delete;
+        SessionLease(SessionLease &&) = delete;
+        SessionLease &operator=(SessionLease &&) = delete;
+
+        /**
+         * @brief Checks whether the lease holds a session.
+         * @return `true` if a session is held.
+         */
+        explicit operator bool() const noexcept { return cached_ != nullptr; }
+
+        /**
+         * @brief Returns the leased WiredTiger session.
+         * @return The session pointer. Must not be called on an empty lease.
+         */
+        [[nodiscard]] WT_SESSION *session() const noexcept { return cached_->session; }
+
+        /**
+         * @brief Returns the session's cursor on a collection's table, opening it on first use.
+         * @details The table is created if it does not exist yet. The cursor stays owned by the
+         * session; the caller must `reset` it when done, but never close it.
+         * @param collection The collection whose table the cursor is opened on.
+         * @param cursor Receives the cursor on success.
+         * @return `aevum::util::Status::OK()` on success, or the status of the failed operation.
+         */
+        [[nodiscard]] aevum::util::Status cursor(std::string_view collection, WT_CURSOR **cursor);
+
+        /**
+         * @brief Closes the session's cached cursor on a table, if it has one.
+         * @param uri The URI of the table.
+         */
+        void close_cursor(const std::string &uri);
+
+        /**
+         * @brief Stops counting the time the session is held, while it runs a caller's callback.
+         */
+        void pause_timing() noexcept { busy_.stop(); }
+
+        /**
+         * @brief Resumes counting the time the session is held.
+         */
+        void resume_timing() noexcept { busy_.start(); }
+
+      private:
+        /// The store that owns the pool.
+        WiredTigerStore &store_;
+        /// The leased session.
+        std::unique_ptr<CachedSession> cached_;
+        /// Measures the time the session is held on behalf of the store.
+        aevum::util::time::Stopwatch busy_;
+    };
+
     /// The root filesystem path for the WiredTiger database files.
     std::string base_path_;
+    /// The journaling and durability configuration of the store.
+    StorageOptions options_;
     /// A pointer to the active WiredTiger database connection instance.
     WT_CONNECTION *conn_{nullptr};
+    /// Flushes the journal on behalf of waiting writers, or `nullptr` if the journal is disabled.
+    std::unique_ptr<GroupCommitter> committer_;
+
+    /// Guards `idle_sessions_`.
+    std::mutex sessions_mutex_;
+    /// The sessions that are currently not leased to any thread. Their number is bounded by the
+    /// peak number of concurrent storage operations.
+    std::vector<std::unique_ptr<CachedSession>> idle_sessions_;
+
+    /// The operations that held a session, for `stats`.
+    std::atomic<uint64_t> operations_{0};
+    /// The time sessions were held, in microseconds.
+    std::atomic<uint64_t> busy_us_{0};
+    /// The `make_durable` calls that waited on the group committer.
+    std::atomic<uint64_t> durability_waits_{0};
+    /// The time spent in those waits, in microseconds.
+    std::atomic<uint64_t> durability_wait_us_{0};
+
+    /// Guards `known_tables_`, `catalog_`, and `key_formats_`.
+    std::shared_mutex tables_mutex_;
+    /// The URIs of the tables known to exist, so that `ensure_table` can skip `session->create`.
+    std::unordered_set<std::string> known_tables_;
+    /// The names of the tables recorded in the `_catalog` table, loaded by `init` and kept in
+    /// step with it by `ensure_table` and `drop_collection`.
+    std::unordered_set<std::string> catalog_;
+    /// The key formats of the existing tables read by `key_format`, keyed by collection name.
+    std::unordered_map<std::string, KeyFormat> key_formats_;
+
+    /// Guards `dictionaries_`.
+    std::mutex dictionaries_mutex_;
+    /// The field dictionaries loaded so far, keyed by collection name. A dictionary is never
+    /// removed, so the pointers handed out by `dictionary` stay valid.
+    std::unordered_map<std::string, std::unique_ptr<aevum::bson::doc::FieldDictionary>>
+        dictionaries_;
+
+    /**
+     * @brief Leases an idle session to the calling thread, opening a new one if none is idle.
+     * @return The lease, which is empty if there is no connection or the session cannot be opened.
+     */
+    [[nodiscard]] SessionLease acquire_session();
+
+    /**
+     * @brief Loads the `_catalog` table into `catalog_`, creating it on first use.
+     * @details A data directory written before the catalog existed has its tables listed once
+     * from WiredTiger's `metadata:` table; the catalog is filled in one transaction that also
+     * writes a completion marker, so an interrupted migration is simply redone.
+     * @return `aevum::util::Status::OK()` on success, or an `IOError` if the catalog cannot be
+     *         read or written.
+     */
+    [[nodiscard]] aevum::util::Status load_catalog();
+
+    /**
+     * @brief Records the creation or the drop of a table in the `_catalog` table.
+     * @details The row is written through a session of its own, outside any transaction of the
+     * caller, and flushed to the journal before returning, since a table missing from the
+     * catalog would not be listed at the next startup.
+     * @param collection The name of the table.
+     * @param remove `true` to remove the row of a dropped table.
+     * @return `aevum::util::Status::OK()` on success, or an `IOError` if the write fails.
+     */
+    [[nodiscard]] aevum::util::Status write_catalog(std::string_view collection, bool remove);
+
+    /**
+     * @brief Returns the key format a collection's table is created with.
+     * @param collection The name of the collection.
+     * @return The collection's `StorageOptions::collection_key_formats` entry, or
+     *         `KeyFormat::STRING` for a collection without one and for system collections.
+     */
+    [[nodiscard]] KeyFormat configured_key_format(std::string_view collection) const;
+
+    /**
+     * @brief Returns the field dictionary of a collection, loading it from `_schemas` on first
+     * use.
+     * @param collection The name of the collection.
+     * @return The dictionary, empty if none was persisted, or `nullptr` if the persisted one
+     *         cannot be read. A dictionary is never replaced by an empty one after a failed read,
+     *         since that would assign its ids anew.
+     */
+    [[nodiscard]] aevum::bson::doc::FieldDictionary *dictionary(std::string_view collection);
+
+    /**
+     * @brief Rebuilds a document from a stored value, which is either BSON or encoded with the
+     * collection's field dictionary.
+     * @param collection The name of the collection the value belongs to.
+     * @param data The value.
+     * @param size The size of the value in bytes.
+     * @param dict The collection's dictionary, looked up on the first encoded value and kept
+     *        for the next ones. Callers start with `nullptr`.
+     * @return The document, owned by the caller, or `nullptr` if the value is corrupt.
+     */
+    [[nodiscard]] bson_t *decode_value(std::string_view collection, const void *data, size_t size,
+                                       aevum::bson::doc::FieldDictionary *&dict);
 
     /**
      * @brief A private utility to ensure that a WiredTiger table for a given collection exists.
-     * @details If the table does not already exist, it is created with a default configuration
-     * (`key_format=S` for string keys, `value_format=u` for raw BSON byte arrays).
+     * @details If the table does not already exist, it is created with the configuration built by
+     * `table_config`. Tables in the known-tables set are accepted without calling into WiredTiger.
      * @param session The active WiredTiger session in which to perform the operation.
      * @param collection The name of the collection (table) to check for existence.
      * @return `aevum::util::Status::OK()` on success or if the table already exists.
@@ -164,6 +652,35 @@ class WiredTigerStore {
     [[nodiscard]] aevum::util::Status ensure_table(WT_SESSION *session,
                                                    std::string_view collection);
 
+    /**
+     * @brief Checks that tables can be created with the configured block compressor.
+     * @return `aevum::util::Status::OK()` if the compressor is usable, or an `IOError` otherwise.
+     */
+    [[nodiscard]] aevum::util::Status probe_compressor();
+
+    /**
+     * @brief Logs why the configured block compressor is unusable and switches to `NONE`.
+     * @param reason Why the compressor cannot be used.
+     */
+    void disable_compression(const std::string &reason);
+
+    /**
+     * @brief Builds the `wiredtiger_open` configuration string from the options.
+     * @return The configuration string, e.g. `"create,cache_size=128MB,..."`.
+     */
+    [[nodiscard]] std::string open_config() const;
+
+    /**
+     * @brief Builds the `WT_SESSION::create` configuration string of a collection's table.
+     * @details Keys are strings (`key_format=S`), or 64-bit integers (`key_format=q`) for a
+     * collection configured for them, and values raw BSON bytes (`value_format=u`). The
+     * configured block compressor and the collection's leaf page size are applied as well; they
+     * only take effect when the table is created, so existing tables keep their layout.
+     * @param collection The name of the collection.
+     * @return The configuration string.
+     */
+    [[nodiscard]] std::string table_config(std::string_view collection) const;
+
     /**
      * @brief A private helper to construct the standard WiredTiger URI for a table.
      * @param collection The name of the collection.
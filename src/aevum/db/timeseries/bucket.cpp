@@ -0,0 +1,295 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bucket.cpp
+ * @brief Implements the parsing of time-series points and the encoding of their buckets.
+ */
+#include "aevum/db/timeseries/bucket.hpp"
+
+#include <algorithm>
+#include <bson/bson.h>
+#include <string_view>
+
+namespace aevum::db::timeseries {
+
+namespace {
+
+/**
+ * @brief Reads an integer field of a bucket record.
+ * @param it An iterator on the field.
+ * @param value Receives the value.
+ * @return `false` if the field is not a 64-bit integer.
+ */
+bool read_int64(const bson_iter_t &it, int64_t &value) {
+    if (!BSON_ITER_HOLDS_INT64(&it)) return false;
+    value = bson_iter_int64(&it);
+    return true;
+}
+
+/**
+ * @brief Reads a binary field of a bucket record.
+ * @param it An iterator on the field.
+ * @param bytes Receives a view of the bytes, valid as long as the record.
+ * @return `false` if the field is not binary.
+ */
+bool read_binary(const bson_iter_t &it, std::string_view &bytes) {
+    if (!BSON_ITER_HOLDS_BINARY(&it)) return false;
+    bson_subtype_t subtype;
+    uint32_t length = 0;
+    const uint8_t *data = nullptr;
+    bson_iter_binary(&it, &subtype, &length, &data);
+    bytes = std::string_view(reinterpret_cast<const char *>(data), length);
+    return true;
+}
+
+/**
+ * @brief Appends a column to a bucket record as binary.
+ * @param b The record being built.
+ * @param key The field name.
+ * @param bytes The encoded column.
+ */
+void append_column(bson_t *b, const char *key, const std::string &bytes) {
+    bson_append_binary(b, key, -1, BSON_SUBTYPE_BINARY,
+                       reinterpret_cast<const uint8_t *>(bytes.data()),
+                       static_cast<uint32_t>(bytes.size()));
+}
+
+}  // namespace
+
+/**
+ * @brief Parses an inserted document into a point.
+ * @param doc The document.
+ * @param options The options of the collection.
+ * @param point Receives the point.
+ * @return `OK`, or `InvalidArgument` naming the offending field.
+ */
+aevum::util::Status parse_point(const aevum::bson::doc::Document &doc,
+                                const TimeSeriesOptions &options, Point &point) {
+    point = Point{};
+    bool has_time = false;
+    bson_iter_t it;
+    if (doc.get() == nullptr || !bson_iter_init(&it, doc.get())) {
+        return aevum::util::Status::InvalidArgument("A time-series point must be a document");
+    }
+    while (bson_iter_next(&it)) {
+        std::string_view key = bson_iter_key(&it);
+        if (key == options.time_field) {
+            if (BSON_ITER_HOLDS_INT64(&it)) {
+                point.time = bson_iter_int64(&it);
+            } else if (BSON_ITER_HOLDS_INT32(&it)) {
+                point.time = bson_iter_int32(&it);
+            } else {
+                return aevum::util::Status::InvalidArgument("The time field '" +
+                                                            options.time_field +
+                                                            "' must be an integer");
+            }
+            has_time = true;
+        } else if (!options.meta_field.empty() && key == options.meta_field) {
+            if (BSON_ITER_HOLDS_NULL(&it)) continue;
+            if (!BSON_ITER_HOLDS_UTF8(&it)) {
+                return aevum::util::Status::InvalidArgument("The meta field '" +
+                                                            options.meta_field +
+                                                            "' must be a string");
+            }
+            uint32_t length = 0;
+            const char *meta = bson_iter_utf8(&it, &length);
+            point.meta.assign(meta, length);
+            point.has_meta = true;
+        } else if (key != "_id") {
+            double value = 0.0;
+            if (BSON_ITER_HOLDS_DOUBLE(&it)) {
+                value = bson_iter_double(&it);
+            } else if (BSON_ITER_HOLDS_INT64(&it)) {
+                value = static_cast<double>(bson_iter_int64(&it));
+            } else if (BSON_ITER_HOLDS_INT32(&it)) {
+                value = bson_iter_int32(&it);
+            } else if (BSON_ITER_HOLDS_BOOL(&it)) {
+                value = bson_iter_bool(&it) ? 1.0 : 0.0;
+            } else {
+                return aevum::util::Status::InvalidArgument(
+                    "The measurement '" + std::string(key) + "' must be a number");
+            }
+            point.values.emplace_back(std::string(key), value);
+        }
+    }
+    if (!has_time) {
+        return aevum::util::Status::InvalidArgument("A time-series point requires the field '" +
+                                                    options.time_field + "'");
+    }
+    std::sort(point.values.begin(), point.values.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Computes the start of the window a timestamp falls in.
+ * @details The division rounds towards negative infinity, so negative timestamps fall in the
+ * same windows as they would on a continuous time line.
+ * @param time The timestamp.
+ * @param span The length of a window, at least 1.
+ * @return The greatest multiple of `span` not above `time`.
+ */
+int64_t window_start(int64_t time, int64_t span) noexcept {
+    int64_t remainder = time % span;
+    if (remainder < 0) remainder += span;
+    return time - remainder;
+}
+
+/**
+ * @brief Reads the header of a stored bucket.
+ * @param doc The bucket's record.
+ * @param header Receives the header.
+ * @return `OK`, or `Corruption` if the record is not a bucket.
+ */
+aevum::util::Status read_header(const aevum::bson::doc::Document &doc, BucketHeader &header) {
+    header = BucketHeader{};
+    unsigned seen = 0;
+    bson_iter_t it;
+    if (doc.get() != nullptr && bson_iter_init(&it, doc.get())) {
+        while (bson_iter_next(&it)) {
+            std::string_view key = bson_iter_key(&it);
+            int64_t count = 0;
+            if (key == "_id" && BSON_ITER_HOLDS_UTF8(&it)) {
+                header.id = bson_iter_utf8(&it, nullptr);
+            } else if (key == "meta") {
+                if (BSON_ITER_HOLDS_UTF8(&it)) {
+                    uint32_t length = 0;
+                    const char *meta = bson_iter_utf8(&it, &length);
+                    header.meta.assign(meta, length);
+                    header.has_meta = true;
+                }
+            } else if (key == "start" && read_int64(it, header.start)) {
+                seen |= 1;
+            } else if (key == "min" && read_int64(it, header.min_time)) {
+                seen |= 2;
+            } else if (key == "max" && read_int64(it, header.max_time)) {
+                seen |= 4;
+            } else if (key == "count" && read_int64(it, count) && count >= 0) {
+                header.count = static_cast<uint32_t>(count);
+                seen |= 8;
+            }
+        }
+    }
+    if (seen != 15) {
+        return aevum::util::Status::Corruption("A time-series bucket record is malformed");
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Decodes a stored bucket.
+ * @param doc The bucket's record.
+ * @param bucket Receives the header and the columns.
+ * @return `OK`, or `Corruption` if the record is not a bucket or a column is truncated.
+ */
+aevum::util::Status decode_bucket(const aevum::bson::doc::Document &doc, DecodedBucket &bucket) {
+    if (auto status = read_header(doc, bucket.header); !status.ok()) return status;
+    const uint32_t count = bucket.header.count;
+    auto corrupt = [&] {
+        return aevum::util::Status::Corruption("The columns of time-series bucket '" +
+                                               bucket.header.id + "' are truncated");
+    };
+
+    bucket.times.clear();
+    bucket.fields.clear();
+    bucket.columns.clear();
+    bson_iter_t it;
+    bson_iter_t fields;
+    std::string_view bytes;
+    if (!bson_iter_init_find(&it, doc.get(), "time") || !read_binary(it, bytes)) return corrupt();
+    TimestampDecoder times(bytes);
+    bucket.times.resize(count);
+    for (auto &time : bucket.times) {
+        if (!times.next(time)) return corrupt();
+    }
+    if (!bson_iter_init_find(&it, doc.get(), "fields") || !BSON_ITER_HOLDS_DOCUMENT(&it) ||
+        !bson_iter_recurse(&it, &fields)) {
+        return corrupt();
+    }
+    while (bson_iter_next(&fields)) {
+        if (!read_binary(fields, bytes)) return corrupt();
+        ValueDecoder values(bytes);
+        std::vector<double> column(count);
+        for (auto &value : column) {
+            if (!values.next(value)) return corrupt();
+        }
+        bucket.fields.emplace_back(bson_iter_key(&fields));
+        bucket.columns.push_back(std::move(column));
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Opens a bucket for a point.
+ * @param id The key of the bucket's record.
+ * @param point The first point, which is not appended yet.
+ * @param start The start of the point's window.
+ */
+Bucket::Bucket(std::string id, const Point &point, int64_t start) : columns_(point.values.size()) {
+    header_.id = std::move(id);
+    header_.has_meta = point.has_meta;
+    header_.meta = point.meta;
+    header_.start = start;
+    header_.min_time = point.time;
+    header_.max_time = point.time;
+    fields_.reserve(point.values.size());
+    for (const auto &[field, value] : point.values) fields_.push_back(field);
+}
+
+/**
+ * @brief Checks whether a point can be appended.
+ * @param point The point, of the bucket's series and window.
+ * @param max_points The most points a bucket holds.
+ * @return `true` if the bucket has room and the point has the bucket's fields.
+ */
+bool Bucket::accepts(const Point &point, size_t max_points) const {
+    if (header_.count >= max_points || point.values.size() != fields_.size()) return false;
+    for (size_t i = 0; i < fields_.size(); ++i) {
+        if (point.values[i].first != fields_[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends a point accepted by `accepts`.
+ * @param point The point.
+ */
+void Bucket::append(const Point &point) {
+    times_.append(point.time);
+    for (size_t i = 0; i < columns_.size(); ++i) columns_[i].append(point.values[i].second);
+    header_.min_time = std::min(header_.min_time, point.time);
+    header_.max_time = std::max(header_.max_time, point.time);
+    ++header_.count;
+}
+
+/**
+ * @brief Builds the record that stores the bucket.
+ * @return `{_id, meta, start, min, max, count, time, fields: {<name>: <column>}}`, where the
+ * columns are binary and `meta` is null for the unnamed series.
+ */
+aevum::bson::doc::Document Bucket::to_document() const {
+    bson_t *b = bson_new();
+    BSON_APPEND_UTF8(b, "_id", header_.id.c_str());
+    if (header_.has_meta) {
+        bson_append_utf8(b, "meta", -1, header_.meta.data(),
+                         static_cast<int>(header_.meta.size()));
+    } else {
+        BSON_APPEND_NULL(b, "meta");
+    }
+    BSON_APPEND_INT64(b, "start", header_.start);
+    BSON_APPEND_INT64(b, "min", header_.min_time);
+    BSON_APPEND_INT64(b, "max", header_.max_time);
+    BSON_APPEND_INT64(b, "count", header_.count);
+    append_column(b, "time", times_.bytes());
+    bson_t columns;
+    BSON_APPEND_DOCUMENT_BEGIN(b, "fields", &columns);
+    for (size_t i = 0; i < fields_.size(); ++i) {
+        append_column(&columns, fields_[i].c_str(), columns_[i].bytes());
+    }
+    bson_append_document_end(b, &columns);
+    return aevum::bson::doc::Document(b);
+}
+
+}  // namespace aevum::db::timeseries
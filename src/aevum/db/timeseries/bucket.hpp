@@ -0,0 +1,172 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bucket.hpp
+ * @brief Declares the points of a time-series collection and the buckets that store them.
+ * @details A bucket holds the points of one series within one time window, column by column:
+ * the timestamps in one delta-of-delta encoded column and each measurement in an XOR-encoded
+ * column of its own (see `gorilla.hpp`). It is stored as a single record whose header, the
+ * series, the window, and the time range of its points, can be read without decoding a column.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/timeseries/gorilla.hpp"
+#include "aevum/db/timeseries/time_series_options.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::timeseries {
+
+/**
+ * @struct Point
+ * @brief One measurement of a series, as parsed from an inserted document.
+ */
+struct Point {
+    /// The timestamp.
+    int64_t time = 0;
+    /// `true` if the point names its series.
+    bool has_meta = false;
+    /// The series, if `has_meta` is set.
+    std::string meta;
+    /// The measurements, sorted by field name.
+    std::vector<std::pair<std::string, double>> values;
+};
+
+/**
+ * @brief Parses an inserted document into a point.
+ * @details The time field must be a 32- or 64-bit integer and the meta field, if present, a
+ * string. Every other field but `_id`, which is discarded, is a measurement and must be a number
+ * or a boolean; it is stored as a double.
+ * @param doc The document.
+ * @param options The options of the collection.
+ * @param point Receives the point.
+ * @return `OK`, or `InvalidArgument` naming the offending field.
+ */
+[[nodiscard]] aevum::util::Status parse_point(const aevum::bson::doc::Document &doc,
+                                              const TimeSeriesOptions &options, Point &point);
+
+/**
+ * @brief Computes the start of the window a timestamp falls in.
+ * @param time The timestamp.
+ * @param span The length of a window, at least 1.
+ * @return The greatest multiple of `span` not above `time`.
+ */
+[[nodiscard]] int64_t window_start(int64_t time, int64_t span) noexcept;
+
+/**
+ * @struct BucketHeader
+ * @brief The fields of a stored bucket that are read without decoding its columns.
+ */
+struct BucketHeader {
+    /// The key of the bucket's record.
+    std::string id;
+    /// `true` if the bucket's series is named.
+    bool has_meta = false;
+    /// The series, if `has_meta` is set.
+    std::string meta;
+    /// The start of the bucket's window.
+    int64_t start = 0;
+    /// The smallest timestamp of the bucket.
+    int64_t min_time = 0;
+    /// The largest timestamp of the bucket.
+    int64_t max_time = 0;
+    /// The number of points.
+    uint32_t count = 0;
+};
+
+/**
+ * @struct DecodedBucket
+ * @brief The points of a stored bucket, column by column.
+ */
+struct DecodedBucket {
+    /// The header of the bucket.
+    BucketHeader header;
+    /// The timestamp of every point, in insertion order.
+    std::vector<int64_t> times;
+    /// The names of the measurements, sorted.
+    std::vector<std::string> fields;
+    /// One column per entry of `fields`, with one value per point.
+    std::vector<std::vector<double>> columns;
+};
+
+/**
+ * @brief Reads the header of a stored bucket.
+ * @param doc The bucket's record.
+ * @param header Receives the header.
+ * @return `OK`, or `Corruption` if the record is not a bucket.
+ */
+[[nodiscard]] aevum::util::Status read_header(const aevum::bson::doc::Document &doc,
+                                              BucketHeader &header);
+
+/**
+ * @brief Decodes a stored bucket.
+ * @param doc The bucket's record.
+ * @param bucket Receives the header and the columns.
+ * @return `OK`, or `Corruption` if the record is not a bucket or a column is truncated.
+ */
+[[nodiscard]] aevum::util::Status decode_bucket(const aevum::bson::doc::Document &doc,
+                                                DecodedBucket &bucket);
+
+/**
+ * @class Bucket
+ * @brief A bucket being filled, with its columns encoded as the points arrive.
+ * @details All points of a bucket have the same measurement fields, so that every column has a
+ * value for every point; a point with other fields goes to another bucket of its window.
+ */
+class Bucket {
+  public:
+    /**
+     * @brief Opens a bucket for a point.
+     * @param id The key of the bucket's record.
+     * @param point The first point, which is not appended yet.
+     * @param start The start of the point's window.
+     */
+    Bucket(std::string id, const Point &point, int64_t start);
+
+    /**
+     * @brief Checks whether a point can be appended.
+     * @param point The point, of the bucket's series and window.
+     * @param max_points The most points a bucket holds.
+     * @return `true` if the bucket has room and the point has the bucket's fields.
+     */
+    [[nodiscard]] bool accepts(const Point &point, size_t max_points) const;
+
+    /**
+     * @brief Appends a point accepted by `accepts`.
+     * @param point The point.
+     */
+    void append(const Point &point);
+
+    /// The key of the bucket's record.
+    [[nodiscard]] const std::string &id() const noexcept { return header_.id; }
+
+    /// The start of the bucket's window.
+    [[nodiscard]] int64_t start() const noexcept { return header_.start; }
+
+    /**
+     * @brief Builds the record that stores the bucket.
+     * @return `{_id, meta, start, min, max, count, time, fields: {<name>: <column>}}`, where the
+     * columns are binary and `meta` is null for the unnamed series.
+     */
+    [[nodiscard]] aevum::bson::doc::Document to_document() const;
+
+  private:
+    /// The header, kept up to date as points are appended.
+    BucketHeader header_;
+    /// The names of the measurements, sorted.
+    std::vector<std::string> fields_;
+    /// The timestamp column.
+    TimestampEncoder times_;
+    /// One column per entry of `fields_`.
+    std::vector<ValueEncoder> columns_;
+};
+
+}  // namespace aevum::db::timeseries
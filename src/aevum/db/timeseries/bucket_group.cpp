@@ -0,0 +1,403 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bucket_group.cpp
+ * @brief Implements the evaluation of a `$group` stage on the columns of time-series buckets.
+ * @details The stage is read with simdjson, like `query::split_pipeline` reads the pipeline. A
+ * stage it does not recognize is left to the pipeline executor, so compiling never fails.
+ */
+#include "aevum/db/timeseries/bucket_group.hpp"
+
+#include <algorithm>
+#include <bson/bson.h>
+#include <cmath>
+#include <cstring>
+#include <simdjson.h>
+#include <utility>
+
+namespace aevum::db::timeseries {
+
+namespace {
+
+/**
+ * @brief Resolves a field path of the form `"$name"` to a measurement.
+ * @param value The expression.
+ * @param options The options of the collection.
+ * @param field Receives the name of the measurement.
+ * @return `false` if the expression is not a top-level field other than the time and meta fields.
+ */
+bool measurement_path(simdjson::dom::element value, const TimeSeriesOptions &options,
+                      std::string &field) {
+    std::string_view path;
+    if (value.get_string().get(path) != simdjson::SUCCESS || path.size() < 2 || path[0] != '$') {
+        return false;
+    }
+    path.remove_prefix(1);
+    if (path.find('.') != std::string_view::npos || path[0] == '$' ||
+        path == options.time_field || path == options.meta_field) {
+        return false;
+    }
+    field = std::string(path);
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Compiles the leading `$group` stage of a pipeline, if it can be pushed down.
+ * @param pipeline_json The stages after the leading `$match`, as a JSON array.
+ * @param options The options of the collection.
+ * @param rest_json Receives the stages after the `$group`, as a JSON array.
+ * @return The compiled stage, or an empty optional if the pipeline does not start with a `$group`
+ * of the supported form.
+ */
+std::optional<BucketGroup> BucketGroup::compile(std::string_view pipeline_json,
+                                                const TimeSeriesOptions &options,
+                                                std::string &rest_json) {
+    simdjson::dom::parser parser;
+    simdjson::dom::element root;
+    simdjson::dom::array stages;
+    if (parser.parse(pipeline_json.data(), pipeline_json.size()).get(root) != simdjson::SUCCESS ||
+        root.get_array().get(stages) != simdjson::SUCCESS || stages.size() == 0) {
+        return std::nullopt;
+    }
+    simdjson::dom::object stage;
+    simdjson::dom::object spec;
+    if (stages.at(0).get_object().get(stage) != simdjson::SUCCESS || stage.size() != 1 ||
+        stage["$group"].get_object().get(spec) != simdjson::SUCCESS) {
+        return std::nullopt;
+    }
+
+    const std::string meta_path = "$" + options.meta_field;
+    const std::string time_path = "$" + options.time_field;
+    // Parses a scalar key expression into a component of the key.
+    auto parse_part = [&](simdjson::dom::element value, KeyPart &part) {
+        std::string_view path;
+        simdjson::dom::object object;
+        int64_t span = 0;
+        if (value.is_null()) {
+            part.null = true;
+        } else if (value.get_string().get(path) == simdjson::SUCCESS) {
+            if (!options.meta_field.empty() && path == meta_path) {
+                part.meta = true;
+            } else if (path != time_path) {
+                return false;
+            }
+        } else if (value.get_object().get(object) == simdjson::SUCCESS && object.size() == 1 &&
+                   object[TIME_WINDOW_OPERATOR].get_int64().get(span) == simdjson::SUCCESS &&
+                   span > 0) {
+            part.span = span;
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    BucketGroup group;
+    bool has_key = false;
+    for (auto [name, value] : spec) {
+        if (name == "_id") {
+            has_key = true;
+            simdjson::dom::object object;
+            KeyPart part;
+            if (parse_part(value, part)) {
+                group.key_.push_back(std::move(part));
+                continue;
+            }
+            if (value.get_object().get(object) != simdjson::SUCCESS || object.size() == 0) {
+                return std::nullopt;
+            }
+            group.compound_ = true;
+            for (auto [field, expression] : object) {
+                KeyPart component;
+                component.name = std::string(field);
+                if (field.empty() || field[0] == '$' || !parse_part(expression, component)) {
+                    return std::nullopt;
+                }
+                group.key_.push_back(std::move(component));
+            }
+            continue;
+        }
+
+        simdjson::dom::object body;
+        if (name.empty() || name[0] == '$' ||
+            value.get_object().get(body) != simdjson::SUCCESS || body.size() != 1) {
+            return std::nullopt;
+        }
+        auto [op_name, argument] = *body.begin();
+        Accumulator accumulator;
+        accumulator.name = std::string(name);
+        if (op_name == "$count") {
+            simdjson::dom::object empty;
+            if (argument.get_object().get(empty) != simdjson::SUCCESS || empty.size() != 0) {
+                return std::nullopt;
+            }
+            accumulator.op = Op::COUNT;
+        } else if (op_name == "$sum" && argument.is_number()) {
+            accumulator.op = Op::SUM;
+            accumulator.integral = argument.is_int64();
+            if (argument.get_double().get(accumulator.constant) != simdjson::SUCCESS) {
+                return std::nullopt;
+            }
+        } else {
+            static const std::pair<std::string_view, Op> ops[] = {
+                {"$sum", Op::SUM}, {"$avg", Op::AVG},     {"$min", Op::MIN},
+                {"$max", Op::MAX}, {"$first", Op::FIRST}, {"$last", Op::LAST}};
+            auto op = std::find_if(std::begin(ops), std::end(ops),
+                                   [&](const auto &entry) { return entry.first == op_name; });
+            if (op == std::end(ops) || !measurement_path(argument, options, accumulator.field)) {
+                return std::nullopt;
+            }
+            accumulator.op = op->second;
+        }
+        group.accumulators_.push_back(std::move(accumulator));
+    }
+    if (!has_key) return std::nullopt;
+
+    rest_json = "[";
+    for (size_t i = 1; i < stages.size(); ++i) {
+        if (i > 1) rest_json += ",";
+        rest_json += simdjson::to_string(stages.at(i));
+    }
+    rest_json += "]";
+    return group;
+}
+
+/**
+ * @brief Folds the points of a bucket that pass a filter into the groups.
+ * @details A bucket whose points all pass the filter and share one window of every time window
+ * of the key is folded into its group in one call. Otherwise the bucket is folded in runs of
+ * consecutive points of the same group.
+ * @param bucket The decoded bucket.
+ * @param filter The filter whose time range the points must lie in.
+ */
+void BucketGroup::add(const DecodedBucket &bucket, const BucketFilter &filter) {
+    const size_t count = bucket.times.size();
+    if (count == 0) return;
+    std::vector<int> columns;
+    columns.reserve(accumulators_.size());
+    for (const auto &accumulator : accumulators_) {
+        auto it = std::lower_bound(bucket.fields.begin(), bucket.fields.end(), accumulator.field);
+        bool found = !accumulator.field.empty() && it != bucket.fields.end() &&
+                     *it == accumulator.field;
+        columns.push_back(found ? static_cast<int>(it - bucket.fields.begin()) : -1);
+    }
+    auto same_group = [&](int64_t a, int64_t b) {
+        for (const auto &part : key_) {
+            if (part.meta || part.null) continue;
+            if (window_start(a, part.span) != window_start(b, part.span)) return false;
+        }
+        return true;
+    };
+
+    const BucketHeader &header = bucket.header;
+    if (filter.admits(header.min_time) && filter.admits(header.max_time) &&
+        same_group(header.min_time, header.max_time)) {
+        fold(group_of(bucket, bucket.times.front()), bucket, columns, 0, count);
+        return;
+    }
+    size_t begin = 0;
+    while (begin < count) {
+        if (!filter.admits(bucket.times[begin])) {
+            ++begin;
+            continue;
+        }
+        size_t end = begin + 1;
+        while (end < count && filter.admits(bucket.times[end]) &&
+               same_group(bucket.times[begin], bucket.times[end])) {
+            ++end;
+        }
+        fold(group_of(bucket, bucket.times[begin]), bucket, columns, begin, end);
+        begin = end;
+    }
+}
+
+/**
+ * @brief Finds or creates the group of a point.
+ * @details The key is encoded as the series, if the key has it, followed by the 8 bytes of each
+ * of the point's windows.
+ * @param bucket The bucket of the point.
+ * @param time The timestamp of the point.
+ * @return The group.
+ */
+BucketGroup::Group &BucketGroup::group_of(const DecodedBucket &bucket, int64_t time) {
+    std::string encoded;
+    std::vector<int64_t> windows;
+    bool has_meta_part = false;
+    for (const auto &part : key_) {
+        if (part.null) continue;
+        if (part.meta) {
+            has_meta_part = true;
+            encoded += bucket.header.has_meta ? 's' : 'n';
+            encoded += bucket.header.meta;
+            encoded += '\0';
+            continue;
+        }
+        int64_t window = window_start(time, part.span);
+        char bytes[sizeof(window)];
+        std::memcpy(bytes, &window, sizeof(window));
+        encoded.append(bytes, sizeof(bytes));
+        windows.push_back(window);
+    }
+
+    auto [it, inserted] = positions_.try_emplace(std::move(encoded), groups_.size());
+    if (inserted) {
+        Group group;
+        if (has_meta_part) {
+            group.has_meta = bucket.header.has_meta;
+            group.meta = bucket.header.meta;
+        }
+        group.windows = std::move(windows);
+        group.states.resize(accumulators_.size());
+        groups_.push_back(std::move(group));
+    }
+    return groups_[it->second];
+}
+
+/**
+ * @brief Folds a range of points of a bucket into a group.
+ * @param group The group.
+ * @param bucket The bucket.
+ * @param columns The column of each accumulator in the bucket, or -1 if it has none.
+ * @param begin The first point.
+ * @param end The point after the last.
+ */
+void BucketGroup::fold(Group &group, const DecodedBucket &bucket, const std::vector<int> &columns,
+                       size_t begin, size_t end) {
+    for (size_t k = 0; k < accumulators_.size(); ++k) {
+        const Accumulator &accumulator = accumulators_[k];
+        State &state = group.states[k];
+        const std::vector<double> *column =
+            columns[k] >= 0 ? &bucket.columns[static_cast<size_t>(columns[k])] : nullptr;
+        switch (accumulator.op) {
+            case Op::COUNT:
+                state.count += end - begin;
+                break;
+            case Op::SUM:
+            case Op::AVG:
+                if (accumulator.field.empty()) {
+                    state.count += end - begin;
+                } else if (column) {
+                    double sum = 0.0;
+                    for (size_t i = begin; i < end; ++i) sum += (*column)[i];
+                    state.sum += sum;
+                    state.count += end - begin;
+                }
+                break;
+            case Op::MIN:
+            case Op::MAX:
+                if (!column) break;
+                for (size_t i = begin; i < end; ++i) {
+                    double value = (*column)[i];
+                    if (state.count == 0) {
+                        state.min = state.max = value;
+                    } else {
+                        state.min = std::min(state.min, value);
+                        state.max = std::max(state.max, value);
+                    }
+                    ++state.count;
+                }
+                break;
+            case Op::FIRST:
+                if (state.seen) break;
+                state.seen = true;
+                state.has_first = column != nullptr;
+                if (column) state.first = (*column)[begin];
+                break;
+            case Op::LAST:
+                state.seen = true;
+                state.has_last = column != nullptr;
+                if (column) state.last = (*column)[end - 1];
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Builds the output of the stage.
+ * @return One document per group, in the order of the groups' first points.
+ */
+std::vector<aevum::bson::doc::Document> BucketGroup::results() const {
+    std::vector<aevum::bson::doc::Document> results;
+    results.reserve(groups_.size());
+    for (const auto &group : groups_) {
+        bson_t *b = bson_new();
+        size_t window = 0;
+        auto append_part = [&](bson_t *target, const KeyPart &part, const char *key) {
+            if (part.null || (part.meta && !group.has_meta)) {
+                bson_append_null(target, key, -1);
+            } else if (part.meta) {
+                bson_append_utf8(target, key, -1, group.meta.data(),
+                                 static_cast<int>(group.meta.size()));
+            } else {
+                bson_append_int64(target, key, -1, group.windows[window++]);
+            }
+        };
+        if (compound_) {
+            bson_t id;
+            BSON_APPEND_DOCUMENT_BEGIN(b, "_id", &id);
+            for (const auto &part : key_) append_part(&id, part, part.name.c_str());
+            bson_append_document_end(b, &id);
+        } else {
+            append_part(b, key_.front(), "_id");
+        }
+
+        for (size_t k = 0; k < accumulators_.size(); ++k) {
+            const Accumulator &accumulator = accumulators_[k];
+            const State &state = group.states[k];
+            const char *name = accumulator.name.c_str();
+            switch (accumulator.op) {
+                case Op::COUNT:
+                    BSON_APPEND_INT64(b, name, static_cast<int64_t>(state.count));
+                    break;
+                case Op::SUM:
+                    if (!accumulator.field.empty()) {
+                        BSON_APPEND_DOUBLE(b, name, state.sum);
+                        break;
+                    }
+                    if (double total = accumulator.constant * static_cast<double>(state.count);
+                        accumulator.integral && std::fabs(total) < 9.0e18) {
+                        BSON_APPEND_INT64(b, name,
+                                          static_cast<int64_t>(accumulator.constant) *
+                                              static_cast<int64_t>(state.count));
+                    } else {
+                        BSON_APPEND_DOUBLE(b, name, total);
+                    }
+                    break;
+                case Op::AVG:
+                    if (state.count == 0) {
+                        BSON_APPEND_NULL(b, name);
+                    } else {
+                        BSON_APPEND_DOUBLE(b, name, state.sum / static_cast<double>(state.count));
+                    }
+                    break;
+                case Op::MIN:
+                case Op::MAX:
+                    if (state.count == 0) {
+                        BSON_APPEND_NULL(b, name);
+                    } else {
+                        BSON_APPEND_DOUBLE(b, name,
+                                           accumulator.op == Op::MIN ? state.min : state.max);
+                    }
+                    break;
+                case Op::FIRST:
+                case Op::LAST: {
+                    bool has = accumulator.op == Op::FIRST ? state.has_first : state.has_last;
+                    if (!has) {
+                        BSON_APPEND_NULL(b, name);
+                    } else {
+                        BSON_APPEND_DOUBLE(b, name,
+                                           accumulator.op == Op::FIRST ? state.first : state.last);
+                    }
+                    break;
+                }
+            }
+        }
+        results.emplace_back(b);
+    }
+    return results;
+}
+
+}  // namespace aevum::db::timeseries
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bucket_group.hpp
+ * @brief Declares the `BucketGroup`, which evaluates a `$group` stage of a time-series
+ * aggregation directly on the decoded columns of its buckets.
+ * @details The usual rollup of a metrics collection groups points by series and time window and
+ * accumulates a few measurements. Run by the pipeline executor, every point would first be built
+ * into a document and lent to Rust. Pushed down into bucket processing, the stage instead folds
+ * the decoded columns into its groups, and a bucket whose points all fall into one group is
+ * folded column by column without looking at a single point's other fields.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/timeseries/bucket.hpp"
+#include "aevum/db/timeseries/time_series_options.hpp"
+#include "aevum/db/timeseries/time_series_store.hpp"
+
+namespace aevum::db::timeseries {
+
+/// The name of the group key expression that truncates the time field to a window.
+constexpr std::string_view TIME_WINDOW_OPERATOR = "$timeWindow";
+
+/**
+ * @class BucketGroup
+ * @brief A `$group` stage compiled for the buckets of one time-series collection.
+ *
+ * @details The stage's `_id` may be `null`, `"$<meta field>"`, `"$<time field>"`,
+ * `{"$timeWindow": <span>}`, which is the start of the `span`-aligned window of the point's
+ * timestamp, or an object whose fields are each one of those. Its accumulators may be `$sum`,
+ * `$avg`, `$min`, `$max`, `$first`, and `$last` of `"$<measurement>"`, `$sum` of a number, and
+ * `$count` of `{}`. The results are those of the pipeline executor on the points: the groups come
+ * in the order of their first point, `$first` and `$last` follow the order the points are read
+ * in, and an accumulator with no value yields `null`, except `$sum`, which yields 0.
+ */
+class BucketGroup {
+  public:
+    /**
+     * @brief Compiles the leading `$group` stage of a pipeline, if it can be pushed down.
+     * @param pipeline_json The stages after the leading `$match`, as a JSON array.
+     * @param options The options of the collection.
+     * @param rest_json Receives the stages after the `$group`, as a JSON array.
+     * @return The compiled stage, or an empty optional if the pipeline does not start with a
+     * `$group` of the supported form.
+     */
+    [[nodiscard]] static std::optional<BucketGroup> compile(std::string_view pipeline_json,
+                                                            const TimeSeriesOptions &options,
+                                                            std::string &rest_json);
+
+    /**
+     * @brief Folds the points of a bucket that pass a filter into the groups.
+     * @param bucket The decoded bucket.
+     * @param filter The filter whose time range the points must lie in.
+     */
+    void add(const DecodedBucket &bucket, const BucketFilter &filter);
+
+    /**
+     * @brief Builds the output of the stage.
+     * @return One document per group, in the order of the groups' first points.
+     */
+    [[nodiscard]] std::vector<aevum::bson::doc::Document> results() const;
+
+  private:
+    /**
+     * @struct KeyPart
+     * @brief One component of the group key.
+     */
+    struct KeyPart {
+        /// The field of the compound key, or empty for a scalar key.
+        std::string name;
+        /// `true` for the series, `false` for a time window.
+        bool meta = false;
+        /// `true` for the `null` key.
+        bool null = false;
+        /// The length of the time window.
+        int64_t span = 1;
+    };
+
+    /**
+     * @enum Op
+     * @brief The supported accumulators.
+     */
+    enum class Op : uint8_t { SUM, AVG, MIN, MAX, FIRST, LAST, COUNT };
+
+    /**
+     * @struct Accumulator
+     * @brief One output field of the stage.
+     */
+    struct Accumulator {
+        /// The output field.
+        std::string name;
+        /// The accumulator.
+        Op op = Op::COUNT;
+        /// The measurement it reads, or empty for `$count` or the `$sum` of a number.
+        std::string field;
+        /// The number a `$sum` adds per point if `field` is empty.
+        double constant = 0.0;
+        /// `true` if `constant` is an integer, so the sum is one as well.
+        bool integral = false;
+    };
+
+    /**
+     * @struct State
+     * @brief The running state of one accumulator within one group.
+     */
+    struct State {
+        /// The sum of the values.
+        double sum = 0.0;
+        /// The number of values, or of points for `$count` and the `$sum` of a number.
+        uint64_t count = 0;
+        /// The smallest value.
+        double min = 0.0;
+        /// The largest value.
+        double max = 0.0;
+        /// The value of the first point, if `has_first` is set.
+        double first = 0.0;
+        /// The value of the last point, if `has_last` is set.
+        double last = 0.0;
+        /// `true` once the first point has been seen; its value may be missing.
+        bool seen = false;
+        /// `true` if the first point had a value.
+        bool has_first = false;
+        /// `true` if the last point had a value.
+        bool has_last = false;
+    };
+
+    /**
+     * @struct Group
+     * @brief One group under construction.
+     */
+    struct Group {
+        /// The series of the group's points, if the key has the series.
+        bool has_meta = false;
+        /// The series, if `has_meta` is set.
+        std::string meta;
+        /// The window of each `KeyPart` that is a time window.
+        std::vector<int64_t> windows;
+        /// One state per accumulator.
+        std::vector<State> states;
+    };
+
+    /**
+     * @brief Finds or creates the group of a point.
+     * @param bucket The bucket of the point.
+     * @param time The timestamp of the point.
+     * @return The group.
+     */
+    Group &group_of(const DecodedBucket &bucket, int64_t time);
+
+    /**
+     * @brief Folds a range of points of a bucket into a group.
+     * @param group The group.
+     * @param bucket The bucket.
+     * @param columns The column of each accumulator in the bucket, or -1 if it has none.
+     * @param begin The first point.
+     * @param end The point after the last.
+     */
+    void fold(Group &group, const DecodedBucket &bucket, const std::vector<int> &columns,
+              size_t begin, size_t end);
+
+    /// The components of the group key.
+    std::vector<KeyPart> key_;
+    /// `true` if the key is an object of `key_`, `false` if it is the single `key_[0]`.
+    bool compound_ = false;
+    /// The output fields.
+    std::vector<Accumulator> accumulators_;
+    /// The groups, in the order of their first points.
+    std::vector<Group> groups_;
+    /// The position in `groups_` of each group, by its encoded key.
+    std::unordered_map<std::string, size_t> positions_;
+};
+
+}  // namespace aevum::db::timeseries
@@ -0,0 +1,248 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file gorilla.cpp
+ * @brief Implements the delta-of-delta timestamp and XOR value codecs of time-series buckets.
+ * @details Deltas are computed with unsigned, wrapping arithmetic, so that any pair of 64-bit
+ * timestamps round-trips; a delta that overflows simply falls into the 64-bit case.
+ */
+#include "aevum/db/timeseries/gorilla.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace aevum::db::timeseries {
+
+namespace {
+
+/**
+ * @brief Subtracts two integers with two's complement wrap-around.
+ * @param a The minuend.
+ * @param b The subtrahend.
+ * @return `a - b` modulo 2^64.
+ */
+int64_t wrapping_sub(int64_t a, int64_t b) noexcept {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+/**
+ * @brief Adds two integers with two's complement wrap-around.
+ * @param a The first addend.
+ * @param b The second addend.
+ * @return `a + b` modulo 2^64.
+ */
+int64_t wrapping_add(int64_t a, int64_t b) noexcept {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+/**
+ * @brief Reinterprets the bits of a double as an integer.
+ * @param value The double.
+ * @return Its IEEE 754 bits.
+ */
+uint64_t to_bits(double value) noexcept {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Reinterprets an integer as the bits of a double.
+ * @param bits The IEEE 754 bits.
+ * @return The double.
+ */
+double from_bits(uint64_t bits) noexcept {
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+/**
+ * @brief Appends the low bits of a value.
+ * @details The bits are copied into the free low bits of the last byte, a new byte being started
+ * whenever it is full, so a field of `bits` bits touches at most `bits / 8 + 2` bytes.
+ * @param value The value; only its `bits` low bits are written.
+ * @param bits The number of bits to write, from 1 to 64.
+ */
+void BitWriter::write(uint64_t value, unsigned bits) {
+    while (bits > 0) {
+        if (free_bits_ == 0) {
+            bytes_.push_back('\0');
+            free_bits_ = 8;
+        }
+        unsigned take = std::min(bits, free_bits_);
+        uint64_t chunk = (value >> (bits - take)) & ((uint64_t{1} << take) - 1);
+        bytes_.back() = static_cast<char>(static_cast<uint8_t>(bytes_.back()) |
+                                          static_cast<uint8_t>(chunk << (free_bits_ - take)));
+        free_bits_ -= take;
+        bits -= take;
+    }
+}
+
+/**
+ * @brief Reads a bit field.
+ * @param bits The number of bits to read, from 1 to 64.
+ * @param value Receives the field, in its low bits.
+ * @return `false` if fewer than `bits` bits are left.
+ */
+bool BitReader::read(unsigned bits, uint64_t &value) noexcept {
+    if (bits > bytes_.size() * 8 - position_) return false;
+    value = 0;
+    while (bits > 0) {
+        unsigned available = 8 - static_cast<unsigned>(position_ % 8);
+        unsigned take = std::min(bits, available);
+        auto byte = static_cast<uint8_t>(bytes_[position_ / 8]);
+        uint64_t chunk = (byte >> (available - take)) & ((1u << take) - 1);
+        value = (value << take) | chunk;
+        position_ += take;
+        bits -= take;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends a timestamp.
+ * @param time The timestamp.
+ */
+void TimestampEncoder::append(int64_t time) {
+    if (count_ == 0) {
+        writer_.write(static_cast<uint64_t>(time), 64);
+    } else {
+        int64_t delta = wrapping_sub(time, previous_);
+        int64_t dod = wrapping_sub(delta, delta_);
+        if (dod == 0) {
+            writer_.write(0b0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            writer_.write(0b10, 2);
+            writer_.write(static_cast<uint64_t>(dod + 63), 7);
+        } else if (dod >= -255 && dod <= 256) {
+            writer_.write(0b110, 3);
+            writer_.write(static_cast<uint64_t>(dod + 255), 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            writer_.write(0b1110, 4);
+            writer_.write(static_cast<uint64_t>(dod + 2047), 12);
+        } else {
+            writer_.write(0b1111, 4);
+            writer_.write(static_cast<uint64_t>(dod), 64);
+        }
+        delta_ = delta;
+    }
+    previous_ = time;
+    ++count_;
+}
+
+/**
+ * @brief Decodes the next timestamp.
+ * @details The width prefix is read one bit at a time, up to its four bits.
+ * @param time Receives the timestamp.
+ * @return `false` if the encoding ends before a whole timestamp.
+ */
+bool TimestampDecoder::next(int64_t &time) noexcept {
+    uint64_t bits = 0;
+    if (count_ == 0) {
+        if (!reader_.read(64, bits)) return false;
+        time = static_cast<int64_t>(bits);
+    } else {
+        unsigned ones = 0;
+        for (; ones < 4; ++ones) {
+            if (!reader_.read(1, bits)) return false;
+            if (bits == 0) break;
+        }
+        int64_t dod = 0;
+        switch (ones) {
+            case 0:
+                break;
+            case 1:
+                if (!reader_.read(7, bits)) return false;
+                dod = static_cast<int64_t>(bits) - 63;
+                break;
+            case 2:
+                if (!reader_.read(9, bits)) return false;
+                dod = static_cast<int64_t>(bits) - 255;
+                break;
+            case 3:
+                if (!reader_.read(12, bits)) return false;
+                dod = static_cast<int64_t>(bits) - 2047;
+                break;
+            default:
+                if (!reader_.read(64, bits)) return false;
+                dod = static_cast<int64_t>(bits);
+                break;
+        }
+        delta_ = wrapping_add(delta_, dod);
+        time = wrapping_add(previous_, delta_);
+    }
+    previous_ = time;
+    ++count_;
+    return true;
+}
+
+/**
+ * @brief Appends a value.
+ * @details The number of leading zeros is capped at 31 so that it fits its 5 bits; the capped
+ * zeros are then written as part of the meaningful bits.
+ * @param value The value.
+ */
+void ValueEncoder::append(double value) {
+    uint64_t bits = to_bits(value);
+    if (count_ == 0) {
+        writer_.write(bits, 64);
+    } else if (uint64_t x = bits ^ previous_; x == 0) {
+        writer_.write(0b0, 1);
+    } else {
+        auto leading = std::min(static_cast<unsigned>(__builtin_clzll(x)), 31u);
+        auto trailing = static_cast<unsigned>(__builtin_ctzll(x));
+        if (leading_ != 64 && leading >= leading_ && trailing >= trailing_) {
+            writer_.write(0b10, 2);
+            writer_.write(x >> trailing_, 64 - leading_ - trailing_);
+        } else {
+            unsigned meaningful = 64 - leading - trailing;
+            writer_.write(0b11, 2);
+            writer_.write(leading, 5);
+            writer_.write(meaningful - 1, 6);
+            writer_.write(x >> trailing, meaningful);
+            leading_ = leading;
+            trailing_ = trailing;
+        }
+    }
+    previous_ = bits;
+    ++count_;
+}
+
+/**
+ * @brief Decodes the next value.
+ * @param value Receives the value.
+ * @return `false` if the encoding ends before a whole value or is malformed.
+ */
+bool ValueDecoder::next(double &value) noexcept {
+    uint64_t bits = 0;
+    if (count_ == 0) {
+        if (!reader_.read(64, bits)) return false;
+        previous_ = bits;
+    } else {
+        if (!reader_.read(1, bits)) return false;
+        if (bits != 0) {
+            if (!reader_.read(1, bits)) return false;
+            if (bits != 0) {
+                uint64_t leading = 0;
+                uint64_t meaningful = 0;
+                if (!reader_.read(5, leading) || !reader_.read(6, meaningful)) return false;
+                if (leading + meaningful + 1 > 64) return false;
+                leading_ = static_cast<unsigned>(leading);
+                trailing_ = static_cast<unsigned>(64 - leading - meaningful - 1);
+            }
+            uint64_t x = 0;
+            if (!reader_.read(64 - leading_ - trailing_, x)) return false;
+            previous_ ^= x << trailing_;
+        }
+    }
+    value = from_bits(previous_);
+    ++count_;
+    return true;
+}
+
+}  // namespace aevum::db::timeseries
@@ -0,0 +1,199 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file gorilla.hpp
+ * @brief Declares the bit-level codecs that compress the columns of a time-series bucket.
+ * @details The points of one series arrive at a near-constant rate and their measurements change
+ * slowly, which is what the encodings of Facebook's Gorilla paper exploit. A timestamp is stored
+ * as the difference between its delta to the previous one and the delta before it, so a regular
+ * series costs one bit per point. A measurement is stored as the XOR of its IEEE 754 bits with
+ * those of the previous value, keeping only the meaningful bits between the leading and trailing
+ * zeros; an unchanged value costs one bit, and a slowly changing one usually a dozen.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace aevum::db::timeseries {
+
+/**
+ * @class BitWriter
+ * @brief Appends bit fields to a byte string, most significant bit first.
+ */
+class BitWriter {
+  public:
+    /**
+     * @brief Appends the low bits of a value.
+     * @param value The value; only its `bits` low bits are written.
+     * @param bits The number of bits to write, from 1 to 64.
+     */
+    void write(uint64_t value, unsigned bits);
+
+    /// The written bytes; the unused low bits of the last byte are zero.
+    [[nodiscard]] const std::string &bytes() const noexcept { return bytes_; }
+
+  private:
+    /// The written bytes.
+    std::string bytes_;
+    /// The number of bits of the last byte still free, 0 if it is full or there is none.
+    unsigned free_bits_ = 0;
+};
+
+/**
+ * @class BitReader
+ * @brief Reads the bit fields written by a `BitWriter`.
+ */
+class BitReader {
+  public:
+    /**
+     * @brief Constructs a reader positioned on the first bit.
+     * @param bytes The bytes to read; must outlive the reader.
+     */
+    explicit BitReader(std::string_view bytes) noexcept : bytes_(bytes) {}
+
+    /**
+     * @brief Reads a bit field.
+     * @param bits The number of bits to read, from 1 to 64.
+     * @param value Receives the field, in its low bits.
+     * @return `false` if fewer than `bits` bits are left.
+     */
+    [[nodiscard]] bool read(unsigned bits, uint64_t &value) noexcept;
+
+  private:
+    /// The bytes being read.
+    std::string_view bytes_;
+    /// The position of the next bit.
+    size_t position_ = 0;
+};
+
+/**
+ * @class TimestampEncoder
+ * @brief Compresses a sequence of timestamps with delta-of-delta encoding.
+ * @details The first timestamp is written in 64 bits. Every later one is written as the
+ * difference `dod` between its delta to the previous timestamp and the previous delta (0 for the
+ * second timestamp), with a prefix selecting the width: `0` for a `dod` of 0, `10` and 7 bits for
+ * [-63, 64], `110` and 9 bits for [-255, 256], `1110` and 12 bits for [-2047, 2048], and `1111`
+ * and 64 bits for anything else. Timestamps need not be increasing.
+ */
+class TimestampEncoder {
+  public:
+    /**
+     * @brief Appends a timestamp.
+     * @param time The timestamp.
+     */
+    void append(int64_t time);
+
+    /// The encoded timestamps.
+    [[nodiscard]] const std::string &bytes() const noexcept { return writer_.bytes(); }
+
+  private:
+    /// The encoded bits.
+    BitWriter writer_;
+    /// The number of timestamps appended.
+    uint64_t count_ = 0;
+    /// The last timestamp appended.
+    int64_t previous_ = 0;
+    /// The delta between the last two timestamps appended.
+    int64_t delta_ = 0;
+};
+
+/**
+ * @class TimestampDecoder
+ * @brief Decodes the timestamps written by a `TimestampEncoder`.
+ */
+class TimestampDecoder {
+  public:
+    /**
+     * @brief Constructs a decoder positioned on the first timestamp.
+     * @param bytes The encoded timestamps; must outlive the decoder.
+     */
+    explicit TimestampDecoder(std::string_view bytes) noexcept : reader_(bytes) {}
+
+    /**
+     * @brief Decodes the next timestamp.
+     * @param time Receives the timestamp.
+     * @return `false` if the encoding ends before a whole timestamp.
+     */
+    [[nodiscard]] bool next(int64_t &time) noexcept;
+
+  private:
+    /// The encoded bits.
+    BitReader reader_;
+    /// The number of timestamps decoded.
+    uint64_t count_ = 0;
+    /// The last timestamp decoded.
+    int64_t previous_ = 0;
+    /// The delta between the last two timestamps decoded.
+    int64_t delta_ = 0;
+};
+
+/**
+ * @class ValueEncoder
+ * @brief Compresses a sequence of doubles by XOR with their predecessor.
+ * @details The first value is written in 64 bits. For every later one, the XOR of its bits with
+ * those of the previous value is written as `0` if it is zero. Otherwise it is prefixed with `1`
+ * and then either `0` and its meaningful bits, if they fit within the window of leading and
+ * trailing zeros of the last XOR written this way, or `1`, the number of leading zeros in 5 bits,
+ * the number of meaningful bits less one in 6 bits, and the meaningful bits, opening a new window.
+ */
+class ValueEncoder {
+  public:
+    /**
+     * @brief Appends a value.
+     * @param value The value.
+     */
+    void append(double value);
+
+    /// The encoded values.
+    [[nodiscard]] const std::string &bytes() const noexcept { return writer_.bytes(); }
+
+  private:
+    /// The encoded bits.
+    BitWriter writer_;
+    /// The number of values appended.
+    uint64_t count_ = 0;
+    /// The bits of the last value appended.
+    uint64_t previous_ = 0;
+    /// The leading zeros of the current window, or 64 if no window is open.
+    unsigned leading_ = 64;
+    /// The trailing zeros of the current window.
+    unsigned trailing_ = 0;
+};
+
+/**
+ * @class ValueDecoder
+ * @brief Decodes the values written by a `ValueEncoder`.
+ */
+class ValueDecoder {
+  public:
+    /**
+     * @brief Constructs a decoder positioned on the first value.
+     * @param bytes The encoded values; must outlive the decoder.
+     */
+    explicit ValueDecoder(std::string_view bytes) noexcept : reader_(bytes) {}
+
+    /**
+     * @brief Decodes the next value.
+     * @param value Receives the value.
+     * @return `false` if the encoding ends before a whole value or is malformed.
+     */
+    [[nodiscard]] bool next(double &value) noexcept;
+
+  private:
+    /// The encoded bits.
+    BitReader reader_;
+    /// The number of values decoded.
+    uint64_t count_ = 0;
+    /// The bits of the last value decoded.
+    uint64_t previous_ = 0;
+    /// The leading zeros of the current window.
+    unsigned leading_ = 0;
+    /// The trailing zeros of the current window.
+    unsigned trailing_ = 0;
+};
+
+}  // namespace aevum::db::timeseries
@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file time_series_options.hpp
+ * @brief Defines `TimeSeriesOptions`, the configuration of one time-series collection.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace aevum::db::timeseries {
+
+/**
+ * @struct TimeSeriesOptions
+ * @brief How the points of a time-series collection are read and grouped into buckets.
+ */
+struct TimeSeriesOptions {
+    /// The field holding each point's timestamp, which must be an integer.
+    std::string time_field = "ts";
+    /**
+     * @brief The field naming the series a point belongs to, or empty if the collection holds a
+     * single series. Its value must be a string; a point without it belongs to the null series.
+     */
+    std::string meta_field;
+    /**
+     * @brief The length of a bucket's time window, in the unit of the timestamps.
+     * @details The windows are aligned on multiples of the span, so a bucket holds the points of
+     * one series whose timestamps fall in `[start, start + span)`.
+     */
+    int64_t bucket_span = 3600;
+    /// The most points a bucket holds before the next point of its window opens another one.
+    size_t bucket_points = 1000;
+};
+
+}  // namespace aevum::db::timeseries
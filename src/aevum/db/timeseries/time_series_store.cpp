@@ -0,0 +1,378 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file time_series_store.cpp
+ * @brief Implements the bucketing, persistence, and range scans of time-series collections.
+ */
+#include "aevum/db/timeseries/time_series_store.hpp"
+
+#include <algorithm>
+#include <bson/bson.h>
+#include <chrono>
+
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::db::timeseries {
+
+namespace {
+
+/**
+ * @brief Writes a 64-bit value as 16 lowercase hexadecimal digits.
+ * @param value The value.
+ * @param out The string to append to.
+ */
+void append_hex(uint64_t value, std::string &out) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    for (int shift = 60; shift >= 0; shift -= 4) out += DIGITS[(value >> shift) & 0xF];
+}
+
+/**
+ * @brief Maps a window start to an unsigned value with the same order.
+ * @param start The window start.
+ * @return `start` with its sign bit flipped.
+ */
+uint64_t biased(int64_t start) noexcept {
+    return static_cast<uint64_t>(start) ^ (uint64_t{1} << 63);
+}
+
+/**
+ * @brief Builds the key of the series and window of a point among the open buckets.
+ * @param point The point.
+ * @param start The start of the point's window.
+ * @return The window followed by the series.
+ */
+std::string series_key(const Point &point, int64_t start) {
+    std::string key;
+    append_hex(biased(start), key);
+    key += point.has_meta ? 's' : 'n';
+    key += point.meta;
+    return key;
+}
+
+/**
+ * @brief Reads an integer operand of a time predicate.
+ * @param it An iterator on the operand.
+ * @param value Receives the operand.
+ * @return `false` if the operand is not an integer.
+ */
+bool read_time(const bson_iter_t &it, int64_t &value) {
+    if (BSON_ITER_HOLDS_INT64(&it)) {
+        value = bson_iter_int64(&it);
+    } else if (BSON_ITER_HOLDS_INT32(&it)) {
+        value = bson_iter_int32(&it);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Narrows the time range of a filter with one comparison.
+ * @param filter The filter.
+ * @param op The operator: `$eq`, `$gt`, `$gte`, `$lt`, or `$lte`.
+ * @param value The operand.
+ * @return `false` if the operator is not one of these.
+ */
+bool narrow_time(BucketFilter &filter, std::string_view op, int64_t value) {
+    constexpr int64_t MIN = std::numeric_limits<int64_t>::min();
+    constexpr int64_t MAX = std::numeric_limits<int64_t>::max();
+    if (op == "$eq" || op == "$gte" || op == "$gt") {
+        if (op == "$gt" && value == MAX) {
+            filter.min_time = MAX;
+            filter.max_time = MIN;
+            return true;
+        }
+        filter.min_time = std::max(filter.min_time, op == "$gt" ? value + 1 : value);
+    }
+    if (op == "$eq" || op == "$lte" || op == "$lt") {
+        if (op == "$lt" && value == MIN) {
+            filter.min_time = MAX;
+            filter.max_time = MIN;
+            return true;
+        }
+        filter.max_time = std::min(filter.max_time, op == "$lt" ? value - 1 : value);
+    }
+    return op == "$eq" || op == "$gt" || op == "$gte" || op == "$lt" || op == "$lte";
+}
+
+/**
+ * @brief Restricts a filter to one series.
+ * @param filter The filter.
+ * @param it An iterator on the wanted series.
+ * @return `false` if the operand is not a string.
+ */
+bool narrow_meta(BucketFilter &filter, const bson_iter_t &it) {
+    if (!BSON_ITER_HOLDS_UTF8(&it)) return false;
+    uint32_t length = 0;
+    const char *meta = bson_iter_utf8(&it, &length);
+    if (filter.has_meta && filter.meta != std::string_view(meta, length)) {
+        filter.min_time = std::numeric_limits<int64_t>::max();
+        filter.max_time = std::numeric_limits<int64_t>::min();
+    }
+    filter.has_meta = true;
+    filter.meta.assign(meta, length);
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Extracts the bucket filter of a query on a time-series collection.
+ * @details A predicate that is not recognized is ignored, which only widens the filter.
+ * @param query The parsed query.
+ * @param options The options of the collection.
+ * @return The filter; a bucket it rejects holds no point the query matches.
+ */
+BucketFilter extract_filter(const aevum::bson::doc::Document &query,
+                            const TimeSeriesOptions &options) {
+    BucketFilter filter;
+    bson_iter_t it;
+    if (query.get() == nullptr || !bson_iter_init(&it, query.get())) return filter;
+    while (bson_iter_next(&it)) {
+        std::string_view key = bson_iter_key(&it);
+        bool understood = false;
+        bson_iter_t ops;
+        if (key == options.time_field) {
+            int64_t value = 0;
+            if (read_time(it, value)) {
+                understood = narrow_time(filter, "$eq", value);
+            } else if (BSON_ITER_HOLDS_DOCUMENT(&it) && bson_iter_recurse(&it, &ops)) {
+                understood = true;
+                while (bson_iter_next(&ops)) {
+                    understood = read_time(ops, value) &&
+                                 narrow_time(filter, bson_iter_key(&ops), value) && understood;
+                }
+            }
+        } else if (!options.meta_field.empty() && key == options.meta_field) {
+            if (BSON_ITER_HOLDS_DOCUMENT(&it) && bson_iter_recurse(&it, &ops)) {
+                understood = true;
+                while (bson_iter_next(&ops)) {
+                    understood = std::string_view(bson_iter_key(&ops)) == "$eq" &&
+                                 narrow_meta(filter, ops) && understood;
+                }
+            } else {
+                understood = narrow_meta(filter, it);
+            }
+        }
+        filter.exact = filter.exact && understood;
+    }
+    return filter;
+}
+
+/**
+ * @brief Builds the documents of the points of a bucket that pass a filter.
+ * @param bucket The decoded bucket.
+ * @param options The options of the collection.
+ * @param filter The filter whose time range the points must lie in.
+ * @param out Receives one document per point.
+ */
+void materialize(const DecodedBucket &bucket, const TimeSeriesOptions &options,
+                 const BucketFilter &filter, std::vector<aevum::bson::doc::Document> &out) {
+    const BucketHeader &header = bucket.header;
+    for (size_t i = 0; i < bucket.times.size(); ++i) {
+        if (!filter.admits(bucket.times[i])) continue;
+        bson_t *b = bson_new();
+        BSON_APPEND_INT64(b, options.time_field.c_str(), bucket.times[i]);
+        if (header.has_meta && !options.meta_field.empty()) {
+            bson_append_utf8(b, options.meta_field.c_str(), -1, header.meta.data(),
+                             static_cast<int>(header.meta.size()));
+        }
+        for (size_t f = 0; f < bucket.fields.size(); ++f) {
+            BSON_APPEND_DOUBLE(b, bucket.fields[f].c_str(), bucket.columns[f][i]);
+        }
+        out.emplace_back(b);
+    }
+}
+
+/**
+ * @brief Constructs the store of a set of collections.
+ * @details The sequence of bucket keys starts at the current time in nanoseconds, which is
+ * beyond every sequence number handed out by an earlier run.
+ * @param storage The persistence layer.
+ * @param collections The time-series collections and their options.
+ */
+TimeSeriesStore::TimeSeriesStore(storage::WiredTigerStore &storage, Collections collections)
+    : storage_(storage),
+      collections_(std::move(collections)),
+      sequence_(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::system_clock::now().time_since_epoch())
+                                          .count())) {
+    for (const auto &entry : collections_) open_[entry.first];
+}
+
+/**
+ * @brief Looks up the options of a collection.
+ * @param coll The name of the collection.
+ * @return The options, or null if the collection is not a time-series collection.
+ */
+const TimeSeriesOptions *TimeSeriesStore::options(std::string_view coll) const {
+    if (collections_.empty()) return nullptr;
+    auto it = collections_.find(std::string(coll));
+    return it == collections_.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Names the storage table of a collection's buckets.
+ * @param coll The name of the collection.
+ * @return `_buckets.<coll>`.
+ */
+std::string TimeSeriesStore::bucket_table(std::string_view coll) {
+    return std::string(TABLE_PREFIX) + std::string(coll);
+}
+
+/**
+ * @brief Checks whether a storage table holds buckets.
+ * @param name The name of the table.
+ * @return `true` if the name starts with `TABLE_PREFIX`.
+ */
+bool TimeSeriesStore::is_bucket_table(std::string_view name) noexcept {
+    return name.substr(0, TABLE_PREFIX.size()) == TABLE_PREFIX;
+}
+
+/**
+ * @brief Builds the key of a bucket's record.
+ * @param start The start of the bucket's window.
+ * @return The window prefix and a fresh sequence number.
+ */
+std::string TimeSeriesStore::next_key(int64_t start) {
+    std::string key;
+    key.reserve(32);
+    append_hex(biased(start), key);
+    append_hex(sequence_.fetch_add(1, std::memory_order_relaxed), key);
+    return key;
+}
+
+/**
+ * @brief Appends points to a collection.
+ * @details The open buckets the batch appends to are copied, the points are appended to the
+ * copies, and the copies are stored. Only once the transaction has committed do they replace the
+ * open buckets, so a failed write leaves the collection as it was. A bucket that fills up within
+ * the batch is stored as well, and its successor becomes the open bucket.
+ * @param coll The name of a time-series collection.
+ * @param docs The points.
+ * @return One pair per point, in input order, holding its status and the key of its bucket.
+ */
+std::vector<std::pair<aevum::util::Status, std::string>> TimeSeriesStore::insert(
+    std::string_view coll, const std::vector<aevum::bson::doc::Document> &docs) {
+    std::vector<std::pair<aevum::util::Status, std::string>> results;
+    results.reserve(docs.size());
+    const TimeSeriesOptions *collection = options(coll);
+    if (collection == nullptr) {
+        auto status = aevum::util::Status::NotFound("'" + std::string(coll) +
+                                                    "' is not a time-series collection");
+        results.assign(docs.size(), {status, ""});
+        return results;
+    }
+    OpenBuckets &open = open_.find(std::string(coll))->second;
+    const int64_t span = std::max<int64_t>(collection->bucket_span, 1);
+    const size_t max_points = std::max<size_t>(collection->bucket_points, 1);
+
+    std::unordered_map<std::string, Bucket> staged;
+    std::vector<Bucket> filled;
+    int64_t latest = open.latest;
+    for (const auto &doc : docs) {
+        Point point;
+        if (auto status = parse_point(doc, *collection, point); !status.ok()) {
+            results.emplace_back(std::move(status), "");
+            continue;
+        }
+        int64_t start = window_start(point.time, span);
+        std::string series = series_key(point, start);
+        auto it = staged.find(series);
+        if (it == staged.end()) {
+            auto previous = open.buckets.find(series);
+            if (previous != open.buckets.end()) {
+                it = staged.emplace(series, previous->second).first;
+            }
+        }
+        if (it == staged.end()) {
+            it = staged.emplace(series, Bucket(next_key(start), point, start)).first;
+        } else if (!it->second.accepts(point, max_points)) {
+            filled.push_back(std::move(it->second));
+            it->second = Bucket(next_key(start), point, start);
+        }
+        it->second.append(point);
+        results.emplace_back(aevum::util::Status::OK(), it->second.id());
+        latest = std::max(latest, start);
+    }
+    if (staged.empty()) return results;
+
+    std::vector<std::pair<std::string, aevum::bson::doc::Document>> puts;
+    puts.reserve(filled.size() + staged.size());
+    for (const auto &bucket : filled) puts.emplace_back(bucket.id(), bucket.to_document());
+    for (const auto &[series, bucket] : staged) {
+        puts.emplace_back(bucket.id(), bucket.to_document());
+    }
+    if (auto status = storage_.apply_batch(bucket_table(coll), puts, {}, {},
+                                           storage::Durability::NONE);
+        !status.ok()) {
+        AEVUM_LOG_ERROR("TimeSeriesStore: Writing the buckets of collection '" +
+                        std::string(coll) + "' failed. Status: " + status.to_string());
+        for (auto &result : results) {
+            if (result.first.ok()) result = {status, ""};
+        }
+        return results;
+    }
+
+    for (auto &[series, bucket] : staged) open.buckets.insert_or_assign(series, std::move(bucket));
+    // Points rarely arrive for a window older than the one before the latest, so the buckets of
+    // older windows are closed.
+    open.latest = latest;
+    for (auto it = open.buckets.begin(); it != open.buckets.end();) {
+        if (biased(latest) - biased(it->second.start()) > static_cast<uint64_t>(span)) {
+            it = open.buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Decodes the buckets of a collection that can hold points passing a filter.
+ * @details The bucket of a point starts in the point's window, so the buckets that can hold a
+ * point of `[min_time, max_time]` are those whose keys lie between the windows of the two bounds.
+ * @param coll The name of a time-series collection.
+ * @param filter The filter.
+ * @param visit Called with each decoded bucket; returning `false` ends the scan.
+ * @param stats Receives what the scan read, if not null.
+ * @return `OK`, or `Corruption` if a record cannot be decoded.
+ */
+aevum::util::Status TimeSeriesStore::scan(
+    std::string_view coll, const BucketFilter &filter,
+    const std::function<bool(const DecodedBucket &)> &visit, BucketScanStats *stats) const {
+    const TimeSeriesOptions *collection = options(coll);
+    if (collection == nullptr || filter.empty()) return aevum::util::Status::OK();
+    const int64_t span = std::max<int64_t>(collection->bucket_span, 1);
+
+    std::string lower;
+    std::string upper;
+    if (filter.min_time != std::numeric_limits<int64_t>::min()) {
+        append_hex(biased(window_start(filter.min_time, span)), lower);
+    }
+    uint64_t last = biased(window_start(filter.max_time, span));
+    if (last != std::numeric_limits<uint64_t>::max()) append_hex(last + 1, upper);
+
+    std::vector<aevum::bson::doc::Document> records =
+        storage_.load_collection_range(bucket_table(coll), lower, upper);
+    BucketScanStats scanned;
+    scanned.buckets = records.size();
+    DecodedBucket bucket;
+    aevum::util::Status status = aevum::util::Status::OK();
+    for (const auto &record : records) {
+        BucketHeader header;
+        if (status = read_header(record, header); !status.ok()) break;
+        if (filter.has_meta && (!header.has_meta || header.meta != filter.meta)) continue;
+        if (header.max_time < filter.min_time || header.min_time > filter.max_time) continue;
+        if (status = decode_bucket(record, bucket); !status.ok()) break;
+        ++scanned.decoded;
+        scanned.points += bucket.times.size();
+        if (!visit(bucket)) break;
+    }
+    if (stats) *stats = scanned;
+    return status;
+}
+
+}  // namespace aevum::db::timeseries
@@ -0,0 +1,217 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file time_series_store.hpp
+ * @brief Declares the `TimeSeriesStore`, which groups the points of time-series collections
+ * into compressed buckets and reads them back by time range.
+ * @details Stored one document per point, a metrics collection spends most of its space on
+ * repeated field names and its reads on walking one record per sample. A time-series collection
+ * instead keeps the points of one series and time window together in a bucket, a single
+ * WiredTiger record whose columns are compressed with the Gorilla encodings (see `gorilla.hpp`),
+ * typically to a few bytes per point. The records are keyed by window, so a query on a time range
+ * reads only the buckets of the windows it overlaps and decodes only those whose points do.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/db/timeseries/bucket.hpp"
+#include "aevum/db/timeseries/time_series_options.hpp"
+#include "aevum/util/status.hpp"
+
+namespace aevum::db::timeseries {
+
+/**
+ * @struct BucketFilter
+ * @brief The part of a query that selects buckets: a time range and a series.
+ */
+struct BucketFilter {
+    /// The smallest timestamp a point may have, inclusive.
+    int64_t min_time = std::numeric_limits<int64_t>::min();
+    /// The largest timestamp a point may have, inclusive.
+    int64_t max_time = std::numeric_limits<int64_t>::max();
+    /// `true` if only the series `meta` is wanted.
+    bool has_meta = false;
+    /// The wanted series, if `has_meta` is set.
+    std::string meta;
+    /// `true` if the query has no predicate but the time range and the series.
+    bool exact = true;
+
+    /// Reports whether the time range is empty, so that no point can match.
+    [[nodiscard]] bool empty() const noexcept { return min_time > max_time; }
+
+    /**
+     * @brief Checks whether a point passes the filter.
+     * @param time The timestamp of the point.
+     * @return `true` if `time` lies in the range; the series is checked per bucket.
+     */
+    [[nodiscard]] bool admits(int64_t time) const noexcept {
+        return time >= min_time && time <= max_time;
+    }
+};
+
+/**
+ * @brief Extracts the bucket filter of a query on a time-series collection.
+ * @details Only top-level predicates are considered. The time field may be compared with an
+ * integer or double through equality, `$eq`, `$gt`, `$gte`, `$lt`, and `$lte`, and the meta field
+ * with a string through equality or `$eq`. Anything else leaves `exact` unset, as the matcher
+ * still has to evaluate it on the points of the selected buckets.
+ * @param query The parsed query.
+ * @param options The options of the collection.
+ * @return The filter; a bucket it rejects holds no point the query matches.
+ */
+[[nodiscard]] BucketFilter extract_filter(const aevum::bson::doc::Document &query,
+                                          const TimeSeriesOptions &options);
+
+/**
+ * @brief Builds the documents of the points of a bucket that pass a filter.
+ * @param bucket The decoded bucket.
+ * @param options The options of the collection.
+ * @param filter The filter whose time range the points must lie in.
+ * @param out Receives one document per point, `{<time>, <meta>, <measurements>...}`, without
+ * `_id` and with the meta field only for a named series.
+ */
+void materialize(const DecodedBucket &bucket, const TimeSeriesOptions &options,
+                 const BucketFilter &filter, std::vector<aevum::bson::doc::Document> &out);
+
+/**
+ * @struct BucketScanStats
+ * @brief What a scan of a time-series collection read.
+ */
+struct BucketScanStats {
+    /// The buckets read from storage, those of the windows the time range overlaps.
+    size_t buckets = 0;
+    /// The buckets decoded, those of the wanted series whose points overlap the time range.
+    size_t decoded = 0;
+    /// The points of the decoded buckets.
+    size_t points = 0;
+};
+
+/**
+ * @class TimeSeriesStore
+ * @brief Stores the time-series collections configured by `CoreOptions`.
+ *
+ * @details The buckets of a collection are the records of the storage table `_buckets.<name>`.
+ * A record's key is the start of the bucket's window, biased to sort as unsigned and written as
+ * 16 hexadecimal digits, followed by a 16-digit sequence number, so that the buckets of a range of
+ * windows are one range of keys. The sequence is seeded from the clock at startup and keeps the
+ * keys of buckets of the same window unique across restarts.
+ *
+ * For each collection the store keeps its open buckets in memory: for every series, those of the
+ * latest two windows that have received points. A point is appended to the open bucket of its
+ * series and window if that one has room and the same measurement fields, and opens a new bucket
+ * otherwise. Every insert rewrites the records of the buckets it appended to, so batching points
+ * amortizes the write. Buckets are never reopened after a restart; the first point of each
+ * series opens a new one.
+ *
+ * The store has no lock of its own. Its set of collections is fixed at construction; `Core`
+ * serializes the inserts into one collection with the collection's exclusive lock, and scans only
+ * read storage.
+ */
+class TimeSeriesStore {
+  public:
+    /// The options of each time-series collection, by name.
+    using Collections = std::unordered_map<std::string, TimeSeriesOptions>;
+
+    /// The prefix of the storage tables holding buckets.
+    static constexpr std::string_view TABLE_PREFIX = "_buckets.";
+
+    /**
+     * @brief Constructs the store of a set of collections.
+     * @param storage The persistence layer.
+     * @param collections The time-series collections and their options.
+     */
+    TimeSeriesStore(storage::WiredTigerStore &storage, Collections collections);
+
+    /**
+     * @brief Looks up the options of a collection.
+     * @param coll The name of the collection.
+     * @return The options, or null if the collection is not a time-series collection.
+     */
+    [[nodiscard]] const TimeSeriesOptions *options(std::string_view coll) const;
+
+    /**
+     * @brief Names the storage table of a collection's buckets.
+     * @param coll The name of the collection.
+     * @return `_buckets.<coll>`.
+     */
+    [[nodiscard]] static std::string bucket_table(std::string_view coll);
+
+    /**
+     * @brief Checks whether a storage table holds buckets.
+     * @param name The name of the table.
+     * @return `true` if the name starts with `TABLE_PREFIX`.
+     */
+    [[nodiscard]] static bool is_bucket_table(std::string_view name) noexcept;
+
+    /**
+     * @brief Appends points to a collection.
+     * @details The records of every bucket the batch appends to are written in one transaction
+     * without waiting for the journal; the open buckets are only updated once it has committed.
+     * @param coll The name of a time-series collection.
+     * @param docs The points.
+     * @return One pair per point, in input order, holding its status and the key of the bucket
+     * it was appended to.
+     */
+    [[nodiscard]] std::vector<std::pair<aevum::util::Status, std::string>> insert(
+        std::string_view coll, const std::vector<aevum::bson::doc::Document> &docs);
+
+    /**
+     * @brief Decodes the buckets of a collection that can hold points passing a filter.
+     * @details Only the records of the windows the time range overlaps are read, in key order.
+     * A bucket of another series, or whose points all lie outside the range, is skipped on its
+     * header alone.
+     * @param coll The name of a time-series collection.
+     * @param filter The filter.
+     * @param visit Called with each decoded bucket; returning `false` ends the scan.
+     * @param stats Receives what the scan read, if not null.
+     * @return `OK`, or `Corruption` if a record cannot be decoded.
+     */
+    [[nodiscard]] aevum::util::Status scan(
+        std::string_view coll, const BucketFilter &filter,
+        const std::function<bool(const DecodedBucket &)> &visit,
+        BucketScanStats *stats = nullptr) const;
+
+  private:
+    /**
+     * @struct OpenBuckets
+     * @brief The buckets of one collection that points are still appended to.
+     */
+    struct OpenBuckets {
+        /// The open bucket of each series and window, keyed by `series_key`.
+        std::unordered_map<std::string, Bucket> buckets;
+        /// The latest window that has received a point.
+        int64_t latest = std::numeric_limits<int64_t>::min();
+    };
+
+    /**
+     * @brief Builds the key of a bucket's record.
+     * @param start The start of the bucket's window.
+     * @return The window prefix and a fresh sequence number.
+     */
+    [[nodiscard]] std::string next_key(int64_t start);
+
+    /// The persistence layer.
+    storage::WiredTigerStore &storage_;
+    /// The options of each time-series collection.
+    Collections collections_;
+    /// The open buckets of each time-series collection; its keys are those of `collections_`.
+    std::unordered_map<std::string, OpenBuckets> open_;
+    /// The next sequence number of a bucket key.
+    std::atomic<uint64_t> sequence_;
+};
+
+}  // namespace aevum::db::timeseries
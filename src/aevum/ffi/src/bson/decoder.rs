@@ -0,0 +1,363 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Strict Raw BSON Decoder
+//!
+//! This module provides a minimal, dependency-free reader for the BSON binary format
+//! (<https://bsonspec.org/spec.html>). It is purpose-built for the zero-copy query path: the
+//! C++ side hands over borrowed buffers straight from its primary index, and this decoder
+//! turns each one into a `serde_json::Value` that the existing `matcher`, `comparator`, and
+//! `projection` modules can evaluate unchanged.
+//!
+//! ## Type Mapping
+//!
+//! To guarantee that a query behaves identically whether it arrives through the JSON path or the
+//! raw BSON path, every element type is mapped to the shape emitted by libbson's *relaxed*
+//! extended JSON serializer (`bson_as_relaxed_extended_json`):
+//!
+//! - `double`, `int32`, `int64` become plain JSON numbers (non-finite doubles become
+//!   `{"$numberDouble": "..."}`).
+//! - `string`, `symbol` become JSON strings; `bool` and `null` map directly.
+//! - Embedded documents and arrays are decoded recursively.
+//! - `ObjectId`, `datetime`, `binary`, `regex`, `timestamp`, `code`, `minKey` and `maxKey` become
+//!   their canonical `$`-prefixed wrapper objects.
+//! - `decimal128`, `undefined`, `DBPointer` and code-with-scope, which the query engine cannot
+//!   evaluate, decode to `null`.
+//!
+//! ## Safety Philosophy
+//!
+//! Every length prefix is validated against the enclosing buffer before it is trusted. A
+//! truncated or corrupted buffer yields `None` rather than a panic, allowing the caller to treat
+//! the document as non-matching without tearing down the process.
+
+use serde_json::{Map, Number, Value};
+
+/// The BSON element type tags, as defined by the BSON specification.
+mod tag {
+    pub(super) const DOUBLE: u8 = 0x01;
+    pub(super) const STRING: u8 = 0x02;
+    pub(super) const DOCUMENT: u8 = 0x03;
+    pub(super) const ARRAY: u8 = 0x04;
+    pub(super) const BINARY: u8 = 0x05;
+    pub(super) const UNDEFINED: u8 = 0x06;
+    pub(super) const OBJECT_ID: u8 = 0x07;
+    pub(super) const BOOL: u8 = 0x08;
+    pub(super) const DATETIME: u8 = 0x09;
+    pub(super) const NULL: u8 = 0x0A;
+    pub(super) const REGEX: u8 = 0x0B;
+    pub(super) const DB_POINTER: u8 = 0x0C;
+    pub(super) const CODE: u8 = 0x0D;
+    pub(super) const SYMBOL: u8 = 0x0E;
+    pub(super) const CODE_WITH_SCOPE: u8 = 0x0F;
+    pub(super) const INT32: u8 = 0x10;
+    pub(super) const TIMESTAMP: u8 = 0x11;
+    pub(super) const INT64: u8 = 0x12;
+    pub(super) const DECIMAL128: u8 = 0x13;
+    pub(super) const MIN_KEY: u8 = 0xFF;
+    pub(super) const MAX_KEY: u8 = 0x7F;
+}
+
+/// The minimum size of a valid BSON document: a 4-byte length prefix and a trailing null byte.
+const MIN_DOCUMENT_LEN: usize = 5;
+
+/// Decodes a complete BSON document from a raw byte buffer into a `serde_json::Value::Object`.
+///
+/// # Arguments
+///
+/// * `bytes` - A byte slice that begins with a BSON document. The slice may be longer than the
+///   document itself; only the number of bytes declared by the document's length prefix is read.
+///
+/// # Returns
+///
+/// `Some(Value::Object)` containing the decoded document on success, or `None` if the buffer is
+/// truncated, its length prefix is inconsistent, or it contains an unknown element type.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::bson::decode_document;
+/// use serde_json::json;
+///
+/// // The BSON encoding of `{"a": 1}`.
+/// let raw: [u8; 12] = [12, 0, 0, 0, 0x10, b'a', 0, 1, 0, 0, 0, 0];
+/// assert_eq!(decode_document(&raw), Some(json!({ "a": 1 })));
+/// assert_eq!(decode_document(&raw[..6]), None);
+/// ```
+pub fn decode_document(bytes: &[u8]) -> Option<Value> {
+    let len = read_len(bytes, 0)?;
+    read_container(bytes.get(..len)?, false)
+}
+
+/// Decodes the elements of a single BSON document or array whose bytes are exactly `buf`.
+///
+/// # Arguments
+///
+/// * `buf` - The exact byte range of the container, including its length prefix and terminator.
+/// * `as_array` - When `true`, element keys are discarded and the values are collected into a
+///   `Value::Array` in their stored order.
+///
+/// # Returns
+///
+/// The decoded container, or `None` if any element is malformed.
+fn read_container(buf: &[u8], as_array: bool) -> Option<Value> {
+    if buf.len() < MIN_DOCUMENT_LEN || *buf.last()? != 0 {
+        return None;
+    }
+
+    let mut object = Map::new();
+    let mut array = Vec::new();
+    let mut pos = 4;
+
+    loop {
+        let element_type = *buf.get(pos)?;
+        pos += 1;
+        if element_type == 0 {
+            break;
+        }
+
+        let key = read_cstring(buf, &mut pos)?;
+        let value = read_value(buf, &mut pos, element_type)?;
+
+        if as_array {
+            array.push(value);
+        } else {
+            object.insert(key.to_string(), value);
+        }
+    }
+
+    // The terminator must be the final byte of the declared container.
+    if pos != buf.len() {
+        return None;
+    }
+
+    Some(if as_array { Value::Array(array) } else { Value::Object(object) })
+}
+
+/// Decodes the value of a single element of the given type, advancing `pos` past it.
+///
+/// # Arguments
+///
+/// * `buf` - The enclosing container's bytes.
+/// * `pos` - The offset of the first byte of the value; updated to point past the value.
+/// * `element_type` - The BSON type tag that preceded the element's key.
+///
+/// # Returns
+///
+/// The decoded value, or `None` if the value is truncated or the type tag is unknown.
+fn read_value(buf: &[u8], pos: &mut usize, element_type: u8) -> Option<Value> {
+    let value = match element_type {
+        tag::DOUBLE => double_to_value(f64::from_le_bytes(read_array::<8>(buf, pos)?)),
+        tag::STRING | tag::SYMBOL => Value::String(read_string(buf, pos)?.to_string()),
+        tag::DOCUMENT | tag::ARRAY => {
+            let len = read_len(buf, *pos)?;
+            let sub = buf.get(*pos..pos.checked_add(len)?)?;
+            *pos += len;
+            read_container(sub, element_type == tag::ARRAY)?
+        }
+        tag::BINARY => {
+            let len = usize::try_from(i32::from_le_bytes(read_array::<4>(buf, pos)?)).ok()?;
+            let subtype = *buf.get(*pos)?;
+            *pos += 1;
+            let data = buf.get(*pos..pos.checked_add(len)?)?;
+            *pos += len;
+            wrap(
+                "$binary",
+                wrap_pair(
+                    ("base64", Value::String(encode_base64(data))),
+                    ("subType", Value::String(format!("{:02x}", subtype))),
+                ),
+            )
+        }
+        tag::UNDEFINED | tag::NULL => Value::Null,
+        tag::OBJECT_ID => {
+            let oid = read_array::<12>(buf, pos)?;
+            let hex: String = oid.iter().map(|b| format!("{:02x}", b)).collect();
+            wrap("$oid", Value::String(hex))
+        }
+        tag::BOOL => {
+            let b = *buf.get(*pos)?;
+            *pos += 1;
+            Value::Bool(b != 0)
+        }
+        tag::DATETIME => datetime_to_value(i64::from_le_bytes(read_array::<8>(buf, pos)?)),
+        tag::REGEX => {
+            let pattern = read_cstring(buf, pos)?.to_string();
+            let options = read_cstring(buf, pos)?.to_string();
+            wrap(
+                "$regularExpression",
+                wrap_pair(("pattern", Value::String(pattern)), ("options", Value::String(options))),
+            )
+        }
+        tag::DB_POINTER => {
+            read_string(buf, pos)?;
+            read_array::<12>(buf, pos)?;
+            Value::Null
+        }
+        tag::CODE => wrap("$code", Value::String(read_string(buf, pos)?.to_string())),
+        tag::CODE_WITH_SCOPE => {
+            let len = read_len(buf, *pos)?;
+            buf.get(*pos..pos.checked_add(len)?)?;
+            *pos += len;
+            Value::Null
+        }
+        tag::INT32 => Value::from(i32::from_le_bytes(read_array::<4>(buf, pos)?)),
+        tag::TIMESTAMP => {
+            let increment = u32::from_le_bytes(read_array::<4>(buf, pos)?);
+            let seconds = u32::from_le_bytes(read_array::<4>(buf, pos)?);
+            wrap(
+                "$timestamp",
+                wrap_pair(("t", Value::from(seconds)), ("i", Value::from(increment))),
+            )
+        }
+        tag::INT64 => Value::from(i64::from_le_bytes(read_array::<8>(buf, pos)?)),
+        tag::DECIMAL128 => {
+            read_array::<16>(buf, pos)?;
+            Value::Null
+        }
+        tag::MIN_KEY => wrap("$minKey", Value::from(1)),
+        tag::MAX_KEY => wrap("$maxKey", Value::from(1)),
+        _ => return None,
+    };
+    Some(value)
+}
+
+/// Reads a little-endian `int32` length prefix at `pos` without advancing, validating that it is
+/// at least the minimum document size.
+fn read_len(buf: &[u8], pos: usize) -> Option<usize> {
+    let raw = buf.get(pos..pos.checked_add(4)?)?;
+    let len = usize::try_from(i32::from_le_bytes([raw[0], raw[1], raw[2], raw[3]])).ok()?;
+    if len < MIN_DOCUMENT_LEN {
+        return None;
+    }
+    Some(len)
+}
+
+/// Reads exactly `N` bytes at `pos` into a fixed-size array, advancing `pos`.
+fn read_array<const N: usize>(buf: &[u8], pos: &mut usize) -> Option<[u8; N]> {
+    let bytes = buf.get(*pos..pos.checked_add(N)?)?;
+    *pos += N;
+    let mut out = [0u8; N];
+    out.copy_from_slice(bytes);
+    Some(out)
+}
+
+/// Reads a null-terminated UTF-8 string (a BSON `cstring`), advancing `pos` past the terminator.
+fn read_cstring<'a>(buf: &'a [u8], pos: &mut usize) -> Option<&'a str> {
+    let rest = buf.get(*pos..)?;
+    let nul = rest.iter().position(|&b| b == 0)?;
+    let s = std::str::from_utf8(&rest[..nul]).ok()?;
+    *pos += nul + 1;
+    Some(s)
+}
+
+/// Reads a length-prefixed BSON `string`, advancing `pos` past its trailing null byte.
+fn read_string<'a>(buf: &'a [u8], pos: &mut usize) -> Option<&'a str> {
+    let len = usize::try_from(i32::from_le_bytes(read_array::<4>(buf, pos)?)).ok()?;
+    if len == 0 {
+        return None;
+    }
+    let bytes = buf.get(*pos..pos.checked_add(len)?)?;
+    if bytes[len - 1] != 0 {
+        return None;
+    }
+    let s = std::str::from_utf8(&bytes[..len - 1]).ok()?;
+    *pos += len;
+    Some(s)
+}
+
+/// Converts a BSON double into a JSON number, falling back to the extended JSON wrapper for
+/// values (NaN, ±Infinity) that JSON cannot represent.
+fn double_to_value(d: f64) -> Value {
+    match Number::from_f64(d) {
+        Some(n) => Value::Number(n),
+        None => {
+            let repr = if d.is_nan() {
+                "NaN"
+            } else if d.is_sign_positive() {
+                "Infinity"
+            } else {
+                "-Infinity"
+            };
+            wrap("$numberDouble", Value::String(repr.to_string()))
+        }
+    }
+}
+
+/// Converts a BSON UTC datetime (milliseconds since the Unix epoch) into relaxed extended JSON.
+///
+/// Dates between the years 1970 and 9999 are rendered as ISO-8601 strings, with a millisecond
+/// fraction only when it is non-zero; all other dates use the canonical `$numberLong` form. This
+/// mirrors libbson's relaxed serializer.
+fn datetime_to_value(millis: i64) -> Value {
+    const MAX_RELAXED_MILLIS: i64 = 253_402_300_799_999; // 9999-12-31T23:59:59.999Z
+    if !(0..=MAX_RELAXED_MILLIS).contains(&millis) {
+        return wrap("$date", wrap("$numberLong", Value::String(millis.to_string())));
+    }
+
+    let secs = millis / 1000;
+    let ms = millis % 1000;
+    let days = secs / 86_400;
+    let rem = secs % 86_400;
+    let (year, month, day) = civil_from_days(days);
+
+    let mut iso = format!(
+        "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}",
+        year,
+        month,
+        day,
+        rem / 3600,
+        (rem % 3600) / 60,
+        rem % 60
+    );
+    if ms != 0 {
+        iso.push_str(&format!(".{:03}", ms));
+    }
+    iso.push('Z');
+    wrap("$date", Value::String(iso))
+}
+
+/// Converts a count of days since 1970-01-01 into a proleptic Gregorian `(year, month, day)`.
+///
+/// This is Howard Hinnant's `civil_from_days` algorithm, restricted to non-negative inputs.
+fn civil_from_days(days: i64) -> (i64, i64, i64) {
+    let z = days + 719_468;
+    let era = z / 146_097;
+    let doe = z - era * 146_097;
+    let yoe = (doe - doe / 1460 + doe / 36_524 - doe / 146_096) / 365;
+    let doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    let mp = (5 * doy + 2) / 153;
+    let day = doy - (153 * mp + 2) / 5 + 1;
+    let month = if mp < 10 { mp + 3 } else { mp - 9 };
+    let year = yoe + era * 400 + i64::from(month <= 2);
+    (year, month, day)
+}
+
+/// Encodes a byte slice as standard, padded base64 for the `$binary` wrapper.
+fn encode_base64(data: &[u8]) -> String {
+    const ALPHABET: &[u8; 64] = b"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    let mut out = String::with_capacity(data.len().div_ceil(3) * 4);
+    for chunk in data.chunks(3) {
+        let b = [chunk[0], *chunk.get(1).unwrap_or(&0), *chunk.get(2).unwrap_or(&0)];
+        let n = (u32::from(b[0]) << 16) | (u32::from(b[1]) << 8) | u32::from(b[2]);
+        out.push(ALPHABET[(n >> 18) as usize & 63] as char);
+        out.push(ALPHABET[(n >> 12) as usize & 63] as char);
+        out.push(if chunk.len() > 1 { ALPHABET[(n >> 6) as usize & 63] as char } else { '=' });
+        out.push(if chunk.len() > 2 { ALPHABET[n as usize & 63] as char } else { '=' });
+    }
+    out
+}
+
+/// Builds the single-key object `{ key: value }` used by extended JSON type wrappers.
+fn wrap(key: &str, value: Value) -> Value {
+    let mut map = Map::new();
+    map.insert(key.to_string(), value);
+    Value::Object(map)
+}
+
+/// Builds a two-key object, preserving the order in which the pairs are given.
+fn wrap_pair(first: (&str, Value), second: (&str, Value)) -> Value {
+    let mut map = Map::new();
+    map.insert(first.0.to_string(), first.1);
+    map.insert(second.0.to_string(), second.1);
+    Value::Object(map)
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Raw BSON Ingestion for the Query Engine
+//!
+//! This module allows the query engine to operate directly on the binary BSON buffers owned by
+//! the C++ primary index, bypassing the extended-JSON round-trip that previously preceded every
+//! query. The C++ caller lends an array of `(pointer, length)` pairs for the duration of a single
+//! FFI call; the engine decodes each buffer into a `serde_json::Value` in parallel, evaluates the
+//! query, and reports back only the positions of the matching buffers. No document is ever
+//! re-encoded or copied back across the boundary.
+//!
+//! ## Core Components
+//!
+//! - **`decoder`**: A self-contained, bounds-checked BSON reader that translates the BSON
+//!   specification's element types into the same `serde_json::Value` shapes that libbson's
+//!   relaxed extended JSON produces, so that query semantics are identical on both paths.
+
+/// Implements a strict, bounds-checked decoder from raw BSON bytes to `serde_json::Value`.
+pub mod decoder;
+
+pub use decoder::decode_document;
@@ -67,10 +67,21 @@ pub mod util;
 /// document matching, operator evaluation, sorting, and field projection.
 pub mod query;
 
+/// Provides raw BSON ingestion, allowing the query engine to evaluate documents directly from
+/// C++-owned binary buffers without an intermediate JSON representation.
+pub mod bson;
+
+/// Configures the thread pools on which the query engine parallelizes its work, including one
+/// pool per NUMA node whose threads are pinned to that node's CPUs.
+pub mod pool;
+
 // Re-export public FFI functions and modules to create a flattened, more accessible API surface.
 // This design choice simplifies linking and usage from external C/C++ code, as consumers
 // do not need to be aware of the internal module structure.
-pub use crate::query::operations::{count, delete_docs, find, update, validate};
+pub use crate::query::aggregate::aggregate_raw;
+pub use crate::query::operations::{
+    count, count_raw, delete_docs, find, find_raw, update, update_delta, validate, validate_raw,
+};
 pub use query::*;
 pub use util::*;
 
@@ -83,6 +94,38 @@ pub struct rust_update_result {
     pub modified_count: c_int,
 }
 
+/// Represents the result of a delta update returned through the FFI: the positions of the modified
+/// documents within the caller's input, and their post-update images.
+#[repr(C)]
+pub struct rust_update_delta_result {
+    /// A pointer to a Rust-allocated array of `len` input positions, or null if `len` is `0`.
+    pub indices: *mut u32,
+    /// A pointer to a JSON array holding the post-update image of each position, in order.
+    pub data: *mut c_char,
+    /// The number of modified documents.
+    pub len: usize,
+}
+
+/// Represents the result of a zero-copy query returned through the FFI: a list of positions into
+/// the caller's BSON buffer array.
+#[repr(C)]
+pub struct rust_index_result {
+    /// A pointer to a Rust-allocated array of `len` document positions, or null if `len` is `0`.
+    pub indices: *mut u32,
+    /// The number of positions in `indices`.
+    pub len: usize,
+}
+
+/// Represents the outcome of an aggregation returned through the FFI. Exactly one of the two
+/// pointers is non-null.
+#[repr(C)]
+pub struct rust_aggregate_result {
+    /// A pointer to the JSON array of results, or null if the pipeline was rejected.
+    pub data: *mut c_char,
+    /// A pointer to a description of what is wrong with the pipeline, or null on success.
+    pub error: *mut c_char,
+}
+
 /// FFI-exposed function to validate a JSON document against a specified JSON schema query.
 ///
 /// This function serves as the C-compatible entry point for AevumDB's schema validation logic. It
@@ -154,7 +197,7 @@ pub unsafe extern "C" fn rust_validate(doc: *const c_char, schema: *const c_char
 pub unsafe extern "C" fn rust_count(data: *const c_char, query: *const c_char) -> c_int {
     let data_str = crate::from_c_str(data);
     let query_str = crate::from_c_str(query);
-    count(&data_str, &query_str) as c_int
+    crate::pool::install(|| count(&data_str, &query_str)) as c_int
 }
 
 /// FFI-exposed function to find and retrieve documents from a dataset based on a comprehensive
@@ -199,14 +242,9 @@ pub unsafe extern "C" fn rust_find(
     let l = if limit < 0 { 0 } else { limit as usize };
     let s = if skip < 0 { 0 } else { skip as usize };
 
-    let result_string = find(
-        &crate::from_c_str(data),
-        &crate::from_c_str(query),
-        &crate::from_c_str(sort),
-        &crate::from_c_str(projection),
-        l,
-        s,
-    );
+    let (data, query) = (crate::from_c_str(data), crate::from_c_str(query));
+    let (sort, projection) = (crate::from_c_str(sort), crate::from_c_str(projection));
+    let result_string = crate::pool::install(|| find(&data, &query, &sort, &projection, l, s));
 
     crate::to_c_string(result_string)
 }
@@ -219,7 +257,7 @@ pub unsafe extern "C" fn rust_find(
 /// * `data` - A C string representing the JSON array of documents to be modified.
 /// * `query` - A C string representing the JSON object query to select which documents to update.
 /// * `update_doc_str` - A C string representing the JSON object that defines the fields to set or
-///   overwrite in the matched documents.
+///   overwrite in the matched documents, or the `$set` and `$inc` operators to apply to them.
 /// * `schema_str` - A C string representing the JSON schema to validate updated documents against.
 ///
 /// # Returns
@@ -237,12 +275,10 @@ pub unsafe extern "C" fn rust_update(
     update_doc_str: *const c_char,
     schema_str: *const c_char,
 ) -> rust_update_result {
-    let (result_string, count) = update(
-        &crate::from_c_str(data),
-        &crate::from_c_str(query),
-        &crate::from_c_str(update_doc_str),
-        &crate::from_c_str(schema_str),
-    );
+    let (data, query) = (crate::from_c_str(data), crate::from_c_str(query));
+    let (update_doc, schema) = (crate::from_c_str(update_doc_str), crate::from_c_str(schema_str));
+    let (result_string, count) =
+        crate::pool::install(|| update(&data, &query, &update_doc, &schema));
     rust_update_result { data: crate::to_c_string(result_string), modified_count: count as c_int }
 }
 
@@ -260,6 +296,71 @@ pub unsafe extern "C" fn rust_free_update_result(res: rust_update_result) {
     }
 }
 
+/// FFI-exposed function to update the documents of a dataset that match a query, reporting only
+/// the modified documents.
+///
+/// Unlike `rust_update`, which returns the whole dataset, this function returns the input positions
+/// of the documents that were actually modified together with their post-update images. Because
+/// the caller still holds the input, it has both images of every change and can persist and
+/// re-index only those documents.
+///
+/// # Arguments
+///
+/// * `data` - A C string representing the JSON array of documents to be modified.
+/// * `query` - A C string representing the JSON object query to select which documents to update.
+/// * `update_doc_str` - A C string representing the JSON object that defines the fields to set or
+///   overwrite in the matched documents, or the `$set` and `$inc` operators to apply to them.
+/// * `schema_str` - A C string representing the JSON schema to validate updated documents against.
+///
+/// # Returns
+///
+/// A `rust_update_delta_result` owned by the caller, which **must** be released with
+/// `rust_free_update_delta_result`.
+///
+/// # Safety
+///
+/// The caller must ensure all input C strings are valid for the duration of the call.
+#[no_mangle]
+pub unsafe extern "C" fn rust_update_delta(
+    data: *const c_char,
+    query: *const c_char,
+    update_doc_str: *const c_char,
+    schema_str: *const c_char,
+) -> rust_update_delta_result {
+    let (data, query) = (crate::from_c_str(data), crate::from_c_str(query));
+    let (update_doc, schema) = (crate::from_c_str(update_doc_str), crate::from_c_str(schema_str));
+    let (indices, images) =
+        crate::pool::install(|| update_delta(&data, &query, &update_doc, &schema));
+    let data = crate::to_c_string(images);
+
+    if indices.is_empty() {
+        return rust_update_delta_result { indices: std::ptr::null_mut(), data, len: 0 };
+    }
+    let boxed = indices.into_boxed_slice();
+    let len = boxed.len();
+    rust_update_delta_result { indices: Box::into_raw(boxed) as *mut u32, data, len }
+}
+
+/// Frees the position array and the image string held by a `rust_update_delta_result`.
+///
+/// # Safety
+///
+/// The provided struct must have been returned by `rust_update_delta` and must not have been freed
+/// before. Null members are skipped.
+#[no_mangle]
+pub unsafe extern "C" fn rust_free_update_delta_result(res: rust_update_delta_result) {
+    if !res.indices.is_null() {
+        unsafe {
+            drop(Box::from_raw(std::ptr::slice_from_raw_parts_mut(res.indices, res.len)));
+        }
+    }
+    if !res.data.is_null() {
+        unsafe {
+            crate::rust_free_string(res.data);
+        }
+    }
+}
+
 /// FFI-exposed function to delete documents from a dataset that match a given query.
 ///
 /// # Arguments
@@ -279,6 +380,284 @@ pub unsafe extern "C" fn rust_free_update_result(res: rust_update_result) {
 /// deallocate the returned pointer using `rust_free_string`.
 #[no_mangle]
 pub unsafe extern "C" fn rust_delete(data: *const c_char, query: *const c_char) -> *mut c_char {
-    let result_string = delete_docs(&crate::from_c_str(data), &crate::from_c_str(query));
+    let (data, query) = (crate::from_c_str(data), crate::from_c_str(query));
+    let result_string = crate::pool::install(|| delete_docs(&data, &query));
     crate::to_c_string(result_string)
 }
+
+/// FFI-exposed function to count the BSON documents in a borrowed buffer array that match a query.
+///
+/// This is the zero-copy counterpart of `rust_count`. The documents are read directly from the
+/// caller's memory; nothing is serialized to JSON or copied.
+///
+/// # Arguments
+///
+/// * `docs` - A pointer to an array of `num_docs` pointers, each addressing a BSON document.
+/// * `lens` - A pointer to an array of `num_docs` document lengths, in bytes.
+/// * `num_docs` - The number of documents in the arrays.
+/// * `query` - A C string representing the JSON object that defines the filter conditions.
+///
+/// # Returns
+///
+/// A `c_int` with the number of matching documents. Returns `0` if the query is malformed.
+///
+/// # Safety
+///
+/// The caller **must** ensure that `docs` and `lens` each hold `num_docs` elements, that every
+/// buffer is readable for its stated length, and that all of this memory, together with `query`,
+/// remains valid and unmodified for the duration of the call.
+#[no_mangle]
+pub unsafe extern "C" fn rust_count_bson(
+    docs: *const *const u8,
+    lens: *const u32,
+    num_docs: usize,
+    query: *const c_char,
+) -> c_int {
+    let buffers = unsafe { crate::from_bson_buffers(docs, lens, num_docs) };
+    let query = crate::from_c_str(query);
+    crate::pool::install(|| count_raw(&buffers, &query)) as c_int
+}
+
+/// FFI-exposed function to filter, sort, and paginate a borrowed array of BSON documents,
+/// returning the positions of the results instead of re-encoded documents.
+///
+/// This is the zero-copy counterpart of `rust_find`. Because the caller already owns every
+/// document, only their positions within `docs` are reported, in result order. Projection is not
+/// applied, since it would require materializing new documents.
+///
+/// # Arguments
+///
+/// * `docs` - A pointer to an array of `num_docs` pointers, each addressing a BSON document.
+/// * `lens` - A pointer to an array of `num_docs` document lengths, in bytes.
+/// * `num_docs` - The number of documents in the arrays.
+/// * `query` - A C string representing the JSON object that defines the filtering conditions.
+/// * `sort` - A C string representing the JSON object that defines the sort order.
+/// * `limit` - The maximum number of positions to return. `0` signifies no limit.
+/// * `skip` - The number of matches to skip at the beginning of the sorted result set.
+///
+/// # Returns
+///
+/// A `rust_index_result` describing a Rust-allocated array of positions. This array is owned by
+/// the caller and **must** be released with `rust_free_index_result`.
+///
+/// # Safety
+///
+/// The same buffer validity contract as `rust_count_bson` applies. The caller also assumes
+/// ownership of the returned array.
+#[no_mangle]
+pub unsafe extern "C" fn rust_find_bson(
+    docs: *const *const u8,
+    lens: *const u32,
+    num_docs: usize,
+    query: *const c_char,
+    sort: *const c_char,
+    limit: c_int,
+    skip: c_int,
+) -> rust_index_result {
+    let l = if limit < 0 { 0 } else { limit as usize };
+    let s = if skip < 0 { 0 } else { skip as usize };
+
+    let buffers = unsafe { crate::from_bson_buffers(docs, lens, num_docs) };
+    let (query, sort) = (crate::from_c_str(query), crate::from_c_str(sort));
+    let indices = crate::pool::install(|| find_raw(&buffers, &query, &sort, l, s));
+
+    if indices.is_empty() {
+        return rust_index_result { indices: std::ptr::null_mut(), len: 0 };
+    }
+    let boxed = indices.into_boxed_slice();
+    let len = boxed.len();
+    rust_index_result { indices: Box::into_raw(boxed) as *mut u32, len }
+}
+
+/// FFI-exposed function to validate a borrowed array of BSON documents against a schema in one
+/// call, returning the positions of the documents that fail it.
+///
+/// This is the zero-copy, batched counterpart of `rust_validate`, intended for bulk inserts. The
+/// documents are validated in parallel.
+///
+/// # Arguments
+///
+/// * `docs` - A pointer to an array of `num_docs` pointers, each addressing a BSON document.
+/// * `lens` - A pointer to an array of `num_docs` document lengths, in bytes.
+/// * `num_docs` - The number of documents in the arrays.
+/// * `schema` - A C string representing the JSON schema query to validate against.
+///
+/// # Returns
+///
+/// A `rust_index_result` listing, in ascending order, the positions of the invalid documents. An
+/// empty result means every document is valid. It **must** be released with
+/// `rust_free_index_result`.
+///
+/// # Safety
+///
+/// The same buffer validity contract as `rust_count_bson` applies. The caller also assumes
+/// ownership of the returned array.
+#[no_mangle]
+pub unsafe extern "C" fn rust_validate_bson(
+    docs: *const *const u8,
+    lens: *const u32,
+    num_docs: usize,
+    schema: *const c_char,
+) -> rust_index_result {
+    let buffers = unsafe { crate::from_bson_buffers(docs, lens, num_docs) };
+    let schema = crate::from_c_str(schema);
+    let indices = crate::pool::install(|| validate_raw(&buffers, &schema));
+
+    if indices.is_empty() {
+        return rust_index_result { indices: std::ptr::null_mut(), len: 0 };
+    }
+    let boxed = indices.into_boxed_slice();
+    let len = boxed.len();
+    rust_index_result { indices: Box::into_raw(boxed) as *mut u32, len }
+}
+
+/// FFI-exposed function to run an aggregation pipeline over a borrowed array of BSON documents.
+///
+/// The documents are read in place, as in `rust_find_bson`; only the pipeline's results are
+/// serialized, so a rollup over a large collection returns kilobytes rather than the documents.
+///
+/// # Arguments
+///
+/// * `docs` - A pointer to an array of `num_docs` pointers, each addressing a BSON document.
+/// * `lens` - A pointer to an array of `num_docs` document lengths, in bytes.
+/// * `num_docs` - The number of documents in the arrays.
+/// * `pipeline` - A C string holding the JSON array of pipeline stages.
+///
+/// # Returns
+///
+/// A `rust_aggregate_result` holding either the results or an error message. It **must** be
+/// released with `rust_free_aggregate_result`.
+///
+/// # Safety
+///
+/// The same buffer validity contract as `rust_count_bson` applies.
+#[no_mangle]
+pub unsafe extern "C" fn rust_aggregate_bson(
+    docs: *const *const u8,
+    lens: *const u32,
+    num_docs: usize,
+    pipeline: *const c_char,
+) -> rust_aggregate_result {
+    let buffers = unsafe { crate::from_bson_buffers(docs, lens, num_docs) };
+    let pipeline = crate::from_c_str(pipeline);
+    match crate::pool::install(|| aggregate_raw(&buffers, &pipeline)) {
+        Ok(results) => {
+            rust_aggregate_result { data: crate::to_c_string(results), error: std::ptr::null_mut() }
+        }
+        Err(message) => {
+            rust_aggregate_result { data: std::ptr::null_mut(), error: crate::to_c_string(message) }
+        }
+    }
+}
+
+/// Frees the strings held by a `rust_aggregate_result`.
+///
+/// # Safety
+///
+/// The provided struct must have been returned by `rust_aggregate_bson` and must not have been
+/// freed before. Null members are skipped.
+#[no_mangle]
+pub unsafe extern "C" fn rust_free_aggregate_result(res: rust_aggregate_result) {
+    if !res.data.is_null() {
+        unsafe {
+            crate::rust_free_string(res.data);
+        }
+    }
+    if !res.error.is_null() {
+        unsafe {
+            crate::rust_free_string(res.error);
+        }
+    }
+}
+
+/// Frees the position array held by a `rust_index_result`.
+///
+/// # Safety
+///
+/// The provided struct must have been returned by `rust_find_bson` or `rust_validate_bson` and must
+/// not have been freed before. Passing a result with a null `indices` pointer is a no-op.
+#[no_mangle]
+pub unsafe extern "C" fn rust_free_index_result(res: rust_index_result) {
+    if !res.indices.is_null() {
+        unsafe {
+            drop(Box::from_raw(std::ptr::slice_from_raw_parts_mut(res.indices, res.len)));
+        }
+    }
+}
+
+/// FFI-exposed function to build the engine's thread pools: a global pool and, optionally, one
+/// pool per NUMA node whose threads are pinned to the node's CPUs.
+///
+/// It must be called once, before any other function of this library, since the global pool is
+/// otherwise built implicitly by the first parallel query and cannot be rebuilt. Once node pools
+/// exist, each query runs on the pool of the node its calling thread is running on, unless
+/// `rust_set_pool_node` selects another node.
+///
+/// # Arguments
+///
+/// * `threads` - The number of threads of the global pool, or `0` for one per CPU. With node
+///   pools, each node gets an equal share, or one thread per CPU of the node if `threads` is `0`.
+/// * `name_prefix` - A C string with the prefix of the thread names, or null for the default.
+/// * `cpus` - The CPU ids of all nodes, node after node. May be null if `num_nodes` is `0`.
+/// * `node_sizes` - An array of `num_nodes` counts: the number of CPU ids of each node.
+/// * `num_nodes` - The number of NUMA nodes, or `0` to build the global pool only.
+///
+/// # Returns
+///
+/// `1` if the pools were built, `0` if they were already built or could not be created.
+///
+/// # Safety
+///
+/// `name_prefix` must be null or a valid C string. `node_sizes` must hold `num_nodes` elements
+/// and `cpus` as many elements as their sum.
+#[no_mangle]
+pub unsafe extern "C" fn rust_configure_pool(
+    threads: usize,
+    name_prefix: *const c_char,
+    cpus: *const u32,
+    node_sizes: *const usize,
+    num_nodes: usize,
+) -> c_int {
+    let prefix = if name_prefix.is_null() { String::new() } else { crate::from_c_str(name_prefix) };
+    let mut nodes: Vec<Vec<usize>> = Vec::new();
+    if num_nodes > 0 && !node_sizes.is_null() {
+        // SAFETY: The caller guarantees that `node_sizes` holds `num_nodes` elements.
+        let sizes = unsafe { std::slice::from_raw_parts(node_sizes, num_nodes) };
+        let total: usize = sizes.iter().sum();
+        let ids: &[u32] = if cpus.is_null() || total == 0 {
+            &[]
+        } else {
+            // SAFETY: The caller guarantees that `cpus` holds the sum of `sizes` elements.
+            unsafe { std::slice::from_raw_parts(cpus, total) }
+        };
+        let mut offset = 0;
+        for &size in sizes {
+            let end = (offset + size).min(ids.len());
+            nodes.push(ids[offset..end].iter().map(|&cpu| cpu as usize).collect());
+            offset = end;
+        }
+    }
+    match crate::pool::configure(threads, &prefix, &nodes) {
+        Ok(()) => 1,
+        Err(_) => 0,
+    }
+}
+
+/// FFI-exposed function to select the NUMA node whose pool runs the calling thread's queries.
+///
+/// The selection is per thread and lasts until it is changed, so a caller that scopes one query
+/// restores the returned value afterwards. It has no effect unless `rust_configure_pool` built
+/// node pools.
+///
+/// # Arguments
+///
+/// * `node` - A node index as passed to `rust_configure_pool`, or `-1` to follow the CPU the
+///   thread is running on, which is the default.
+///
+/// # Returns
+///
+/// The previous selection.
+#[no_mangle]
+pub extern "C" fn rust_set_pool_node(node: c_int) -> c_int {
+    crate::pool::set_node(node)
+}
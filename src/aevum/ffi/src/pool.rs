@@ -0,0 +1,183 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Engine Thread Pools
+//!
+//! The parallel operators of the engine run on `rayon`. Left alone, `rayon` builds an implicit
+//! global pool on first use, with one unnamed and unpinned thread per CPU. On a multi-socket host,
+//! its threads then read documents across the interconnect as often as locally, and they compete
+//! with the daemon's own request and scan pools for every core.
+//!
+//! `configure` replaces the implicit pool with a global pool of a chosen size and thread name,
+//! and can add one pool per NUMA node whose threads are pinned to the CPUs of that node. Each FFI
+//! entry point runs its work through `install`, which selects the pool of the node the calling
+//! thread is running on, or the node set with `set_node`, so that a query is parallelized on the
+//! node that holds its caller's caches.
+
+use std::cell::Cell;
+use std::sync::OnceLock;
+
+use rayon::{ThreadPool, ThreadPoolBuilder};
+
+/// The thread name prefix used when the caller gives none.
+const DEFAULT_NAME_PREFIX: &str = "Engine";
+
+/// The value of `set_node` that selects the node of the calling thread's CPU.
+pub const LOCAL_NODE: i32 = -1;
+
+/// The per-node pools and the node of each CPU.
+struct NodePools {
+    /// One pool per node, pinned to the node's CPUs.
+    pools: Vec<ThreadPool>,
+    /// The node of each CPU id, or `usize::MAX` for a CPU that belongs to no configured node.
+    node_of_cpu: Vec<usize>,
+}
+
+/// The per-node pools, set at most once by `configure`.
+static NODE_POOLS: OnceLock<NodePools> = OnceLock::new();
+
+thread_local! {
+    /// The node whose pool the calling thread's FFI calls run on, or `LOCAL_NODE`.
+    static SCOPED_NODE: Cell<i32> = const { Cell::new(LOCAL_NODE) };
+}
+
+/// Builds the global pool and, if `nodes` is not empty, one pinned pool per NUMA node.
+///
+/// This must be called before the first parallel operation of the process, because `rayon`
+/// builds its global pool implicitly on first use and never rebuilds it.
+///
+/// # Arguments
+///
+/// * `threads` - The number of threads of the global pool, or `0` for one per CPU. With node
+///   pools, each node gets an equal share of `threads`, or one thread per CPU of the node if
+///   `threads` is `0` or smaller than the number of nodes.
+/// * `name_prefix` - The prefix of the thread names; threads are named `<prefix>-<i>` in the global
+///   pool and `<prefix>-n<node>-<i>` in a node pool. An empty prefix selects `Engine`.
+/// * `nodes` - The CPU ids of each NUMA node. An empty node keeps its index, so that node indexes
+///   match the caller's, and gets an unpinned pool.
+///
+/// # Returns
+///
+/// `Ok(())`, or a description of why the pools could not be built, such as the global pool
+/// having already been built.
+pub fn configure(threads: usize, name_prefix: &str, nodes: &[Vec<usize>]) -> Result<(), String> {
+    let prefix = if name_prefix.is_empty() { DEFAULT_NAME_PREFIX } else { name_prefix };
+    let global_prefix = prefix.to_string();
+    ThreadPoolBuilder::new()
+        .num_threads(threads)
+        .thread_name(move |i| format!("{global_prefix}-{i}"))
+        .build_global()
+        .map_err(|e| e.to_string())?;
+    if nodes.is_empty() {
+        return Ok(());
+    }
+
+    let share = threads / nodes.len();
+    let mut pools = Vec::with_capacity(nodes.len());
+    let mut node_of_cpu = Vec::new();
+    for (node, cpus) in nodes.iter().enumerate() {
+        for &cpu in cpus {
+            if cpu >= node_of_cpu.len() {
+                node_of_cpu.resize(cpu + 1, usize::MAX);
+            }
+            node_of_cpu[cpu] = node;
+        }
+        let size = if share > 0 { share } else { cpus.len().max(1) };
+        let node_prefix = prefix.to_string();
+        let mask = cpus.clone();
+        let pool = ThreadPoolBuilder::new()
+            .num_threads(size)
+            .thread_name(move |i| format!("{node_prefix}-n{node}-{i}"))
+            .start_handler(move |_| pin_current_thread(&mask))
+            .build()
+            .map_err(|e| e.to_string())?;
+        pools.push(pool);
+    }
+    NODE_POOLS
+        .set(NodePools { pools, node_of_cpu })
+        .map_err(|_| "The node pools are already configured".to_string())
+}
+
+/// Selects the node whose pool the calling thread's subsequent FFI calls run on.
+///
+/// # Arguments
+///
+/// * `node` - A node index as given to `configure`, or `LOCAL_NODE` to follow the CPU the thread
+///   is running on. Indexes beyond the configured nodes wrap around.
+///
+/// # Returns
+///
+/// The previous selection, so that a caller can restore it once its query is done.
+pub fn set_node(node: i32) -> i32 {
+    SCOPED_NODE.with(|scoped| scoped.replace(node))
+}
+
+/// Runs an operation on the pool of the calling thread's node.
+///
+/// Without node pools, or on a CPU that belongs to no node, the operation runs on the calling
+/// thread and its parallel iterators use the global pool. A worker of the selected pool runs the
+/// operation directly.
+///
+/// # Arguments
+///
+/// * `op` - The operation.
+///
+/// # Returns
+///
+/// The result of the operation.
+pub fn install<R, F>(op: F) -> R
+where
+    F: FnOnce() -> R + Send,
+    R: Send,
+{
+    let Some(nodes) = NODE_POOLS.get() else {
+        return op();
+    };
+    let scoped = SCOPED_NODE.with(Cell::get);
+    let node = if scoped >= 0 {
+        scoped as usize % nodes.pools.len()
+    } else {
+        match current_cpu().and_then(|cpu| nodes.node_of_cpu.get(cpu)) {
+            Some(&node) if node != usize::MAX => node,
+            _ => return op(),
+        }
+    };
+    nodes.pools[node].install(op)
+}
+
+/// Returns the CPU the calling thread is running on, if the platform reports it.
+#[cfg(target_os = "linux")]
+fn current_cpu() -> Option<usize> {
+    // SAFETY: `sched_getcpu` takes no arguments and only reads the calling thread's state.
+    let cpu = unsafe { libc::sched_getcpu() };
+    usize::try_from(cpu).ok()
+}
+
+/// Returns the CPU the calling thread is running on, if the platform reports it.
+#[cfg(not(target_os = "linux"))]
+fn current_cpu() -> Option<usize> {
+    None
+}
+
+/// Restricts the calling thread to a set of CPUs. Ids beyond `CPU_SETSIZE` are ignored, and an
+/// empty set leaves the thread unpinned.
+#[cfg(target_os = "linux")]
+fn pin_current_thread(cpus: &[usize]) {
+    let limit = libc::CPU_SETSIZE as usize;
+    if !cpus.iter().any(|&cpu| cpu < limit) {
+        return;
+    }
+    // SAFETY: `cpu_set_t` is a plain bit mask for which all zeroes is the empty set, every id set
+    // is below `CPU_SETSIZE`, and the mask outlives the call that reads it.
+    unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        for &cpu in cpus.iter().filter(|&&cpu| cpu < limit) {
+            libc::CPU_SET(cpu, &mut set);
+        }
+        let _ = libc::sched_setaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &set);
+    }
+}
+
+/// Restricts the calling thread to a set of CPUs; pinning is not supported on this platform.
+#[cfg(not(target_os = "linux"))]
+fn pin_current_thread(_cpus: &[usize]) {}
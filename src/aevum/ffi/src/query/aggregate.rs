@@ -0,0 +1,564 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Aggregation Pipelines
+//!
+//! This module executes aggregation pipelines: JSON arrays of stages, each an object with a
+//! single key naming the stage, that transform a stream of documents into a (usually much
+//! smaller) stream of results. The supported stages are:
+//!
+//! - **`$match`**: Keeps the documents that satisfy a query, compiled through the plan cache with
+//!   the usual [`matches_query`](super::matcher::matches_query) semantics.
+//! - **`$group`**: Groups documents by the value of an `_id` expression and computes one
+//!   accumulator per output field: `$sum`, `$avg`, `$min`, `$max`, `$first`, `$last`, `$push`,
+//!   and `$count`.
+//! - **`$sort`**: Orders documents with the sort keys of [`SortSpec`]. A `$sort` directly
+//!   followed by a `$limit` keeps only the best `limit` documents instead of ordering them all.
+//! - **`$skip`** and **`$limit`**: Paginate the stream.
+//! - **`$project`**: Shapes every document with [`apply_projection`].
+//! - **`$count`**: Replaces the stream by a single document holding its length.
+//!
+//! Expressions name a top-level field of the input document as `"$field"`; any other value is a
+//! literal, and an object of expressions builds a compound value, such as a compound group key.
+//!
+//! `$group` runs in parallel: every `rayon` task folds one chunk of the input into partial groups
+//! of its own, and the partial groups are merged at the end. Each accumulator keeps the
+//! input position of the values it depends on, so `$first`, `$last`, and `$push` are
+//! deterministic, and the groups are emitted in the order of their first document.
+
+use rayon::prelude::*;
+use serde_json::{Map, Number, Value};
+use std::borrow::Cow;
+use std::cmp::Ordering;
+use std::collections::HashMap;
+
+use crate::bson::decode_document;
+
+use super::comparator::compare_values;
+use super::plan::{compile_cached, CompiledQuery};
+use super::projection::apply_projection;
+use super::sort::{chunk_len, SortSpec};
+
+/// A value computed from a document.
+#[derive(Debug, Clone)]
+enum Expr {
+    /// The value of a top-level field, written `"$field"`.
+    Field(String),
+    /// An object whose fields are expressions.
+    Object(Vec<(String, Expr)>),
+    /// A constant.
+    Literal(Value),
+}
+
+impl Expr {
+    /// Parses an expression.
+    fn parse(value: &Value) -> Expr {
+        match value {
+            Value::String(s) if s.len() > 1 && s.starts_with('$') => {
+                Expr::Field(s[1..].to_string())
+            }
+            Value::Object(map) => {
+                Expr::Object(map.iter().map(|(k, v)| (k.clone(), Expr::parse(v))).collect())
+            }
+            other => Expr::Literal(other.clone()),
+        }
+    }
+
+    /// Evaluates the expression against a document.
+    ///
+    /// # Returns
+    ///
+    /// The value, or `None` if it names a field the document does not have. Missing fields are
+    /// left out of an object expression.
+    fn evaluate(&self, doc: &Value) -> Option<Value> {
+        match self {
+            Expr::Field(field) => doc.get(field).cloned(),
+            Expr::Object(fields) => {
+                let mut map = Map::new();
+                for (key, expr) in fields {
+                    if let Some(value) = expr.evaluate(doc) {
+                        map.insert(key.clone(), value);
+                    }
+                }
+                Some(Value::Object(map))
+            }
+            Expr::Literal(value) => Some(value.clone()),
+        }
+    }
+}
+
+/// The accumulators of `$group`.
+#[derive(Debug, Clone, Copy, PartialEq)]
+enum AccumulatorKind {
+    Sum,
+    Avg,
+    Min,
+    Max,
+    First,
+    Last,
+    Push,
+    Count,
+}
+
+impl AccumulatorKind {
+    /// Resolves an accumulator by its name, such as `"$sum"`.
+    fn from_name(name: &str) -> Option<AccumulatorKind> {
+        Some(match name {
+            "$sum" => AccumulatorKind::Sum,
+            "$avg" => AccumulatorKind::Avg,
+            "$min" => AccumulatorKind::Min,
+            "$max" => AccumulatorKind::Max,
+            "$first" => AccumulatorKind::First,
+            "$last" => AccumulatorKind::Last,
+            "$push" => AccumulatorKind::Push,
+            "$count" => AccumulatorKind::Count,
+            _ => return None,
+        })
+    }
+}
+
+/// The running state of one accumulator within one group.
+#[derive(Debug, Clone)]
+enum Accumulator {
+    /// The sum of the numeric values; integers are summed exactly until one is not an integer or
+    /// the sum overflows.
+    Sum { int: i64, float: f64, exact: bool },
+    /// The sum and number of the numeric values.
+    Avg { sum: f64, count: u64 },
+    /// The extreme value seen so far, ignoring `null` and missing values.
+    Extreme(Option<Value>),
+    /// The value of the earliest or latest document, with its input position.
+    Positioned(Option<(usize, Value)>),
+    /// Every value, with the input position of its document.
+    Push(Vec<(usize, Value)>),
+    /// The number of documents.
+    Count(u64),
+}
+
+impl Accumulator {
+    /// Returns the state of an accumulator that has seen nothing yet.
+    fn new(kind: AccumulatorKind) -> Accumulator {
+        match kind {
+            AccumulatorKind::Sum => Accumulator::Sum { int: 0, float: 0.0, exact: true },
+            AccumulatorKind::Avg => Accumulator::Avg { sum: 0.0, count: 0 },
+            AccumulatorKind::Min | AccumulatorKind::Max => Accumulator::Extreme(None),
+            AccumulatorKind::First | AccumulatorKind::Last => Accumulator::Positioned(None),
+            AccumulatorKind::Push => Accumulator::Push(Vec::new()),
+            AccumulatorKind::Count => Accumulator::Count(0),
+        }
+    }
+
+    /// Adds a number to a running sum.
+    fn add_to_sum(int: &mut i64, float: &mut f64, exact: &mut bool, number: &Number) {
+        match number.as_i64().filter(|_| *exact) {
+            Some(i) => match int.checked_add(i) {
+                Some(sum) => *int = sum,
+                None => {
+                    *exact = false;
+                    *float = *int as f64 + i as f64;
+                }
+            },
+            None => {
+                if *exact {
+                    *exact = false;
+                    *float = *int as f64;
+                }
+                *float += number.as_f64().unwrap_or(0.0);
+            }
+        }
+    }
+
+    /// Folds the value of one document into the state.
+    ///
+    /// # Arguments
+    ///
+    /// * `kind` - The accumulator.
+    /// * `position` - The input position of the document.
+    /// * `value` - The value of the accumulator's expression, or `None` if it is missing.
+    fn add(&mut self, kind: AccumulatorKind, position: usize, value: Option<Value>) {
+        match self {
+            Accumulator::Sum { int, float, exact } => {
+                if let Some(Value::Number(n)) = &value {
+                    Self::add_to_sum(int, float, exact, n);
+                }
+            }
+            Accumulator::Avg { sum, count } => {
+                if let Some(n) = value.as_ref().and_then(Value::as_f64) {
+                    *sum += n;
+                    *count += 1;
+                }
+            }
+            Accumulator::Extreme(best) => {
+                if let Some(value) = value.filter(|v| !v.is_null()) {
+                    Self::keep_extreme(kind, best, value);
+                }
+            }
+            Accumulator::Positioned(kept) => {
+                let replace = match kept {
+                    None => true,
+                    Some((p, _)) => (kind == AccumulatorKind::Last) == (position > *p),
+                };
+                if replace {
+                    *kept = Some((position, value.unwrap_or(Value::Null)));
+                }
+            }
+            Accumulator::Push(values) => {
+                if let Some(value) = value {
+                    values.push((position, value));
+                }
+            }
+            Accumulator::Count(count) => *count += 1,
+        }
+    }
+
+    /// Replaces `best` by `value` if it is smaller (`$min`) or larger (`$max`).
+    fn keep_extreme(kind: AccumulatorKind, best: &mut Option<Value>, value: Value) {
+        let wanted = if kind == AccumulatorKind::Min { Ordering::Less } else { Ordering::Greater };
+        let replace = match best {
+            None => true,
+            Some(b) => compare_values(&value, b) == wanted,
+        };
+        if replace {
+            *best = Some(value);
+        }
+    }
+
+    /// Merges the state another task accumulated for the same group into this one.
+    fn merge(&mut self, kind: AccumulatorKind, other: Accumulator) {
+        match (self, other) {
+            (
+                Accumulator::Sum { int, float, exact },
+                Accumulator::Sum { int: other_int, float: other_float, exact: other_exact },
+            ) => {
+                if other_exact {
+                    Self::add_to_sum(int, float, exact, &Number::from(other_int));
+                } else if let Some(n) = Number::from_f64(other_float) {
+                    Self::add_to_sum(int, float, exact, &n);
+                } else {
+                    // A non-finite partial sum stays non-finite.
+                    if *exact {
+                        *exact = false;
+                        *float = *int as f64;
+                    }
+                    *float += other_float;
+                }
+            }
+            (Accumulator::Avg { sum, count }, Accumulator::Avg { sum: s, count: c }) => {
+                *sum += s;
+                *count += c;
+            }
+            (Accumulator::Extreme(best), Accumulator::Extreme(Some(value))) => {
+                Self::keep_extreme(kind, best, value);
+            }
+            (this @ Accumulator::Positioned(_), Accumulator::Positioned(Some((p, value)))) => {
+                this.add(kind, p, Some(value));
+            }
+            (Accumulator::Push(values), Accumulator::Push(other)) => values.extend(other),
+            (Accumulator::Count(count), Accumulator::Count(c)) => *count += c,
+            _ => {}
+        }
+    }
+
+    /// Produces the accumulator's output value.
+    fn finish(self) -> Value {
+        match self {
+            Accumulator::Sum { int, exact: true, .. } => Value::from(int),
+            Accumulator::Sum { float, .. } => {
+                Number::from_f64(float).map_or(Value::Null, Value::Number)
+            }
+            Accumulator::Avg { count: 0, .. } => Value::Null,
+            Accumulator::Avg { sum, count } => {
+                Number::from_f64(sum / count as f64).map_or(Value::Null, Value::Number)
+            }
+            Accumulator::Extreme(best) => best.unwrap_or(Value::Null),
+            Accumulator::Positioned(kept) => kept.map_or(Value::Null, |(_, value)| value),
+            Accumulator::Push(mut values) => {
+                values.sort_by_key(|(position, _)| *position);
+                Value::Array(values.into_iter().map(|(_, value)| value).collect())
+            }
+            Accumulator::Count(count) => Value::from(count),
+        }
+    }
+}
+
+/// A compiled `$group` stage.
+#[derive(Debug, Clone)]
+struct GroupSpec {
+    /// The group key.
+    id: Expr,
+    /// The output fields, each with its accumulator and the accumulator's expression.
+    fields: Vec<(String, AccumulatorKind, Expr)>,
+}
+
+/// One group under construction.
+#[derive(Debug, Clone)]
+struct Group {
+    /// The input position of the group's first document.
+    first: usize,
+    /// The value of the group key.
+    id: Value,
+    /// One state per output field.
+    accumulators: Vec<Accumulator>,
+}
+
+/// The groups a task has built, by the canonical JSON text of their key.
+type Groups = HashMap<String, Group>;
+
+impl GroupSpec {
+    /// Compiles the body of a `$group` stage.
+    fn parse(spec: &Value) -> Result<GroupSpec, String> {
+        let map = spec.as_object().ok_or("$group must be an object")?;
+        let id = map.get("_id").ok_or("$group requires an '_id' expression")?;
+        let mut fields = Vec::new();
+        for (name, accumulator) in map.iter().filter(|(name, _)| *name != "_id") {
+            let (op, operand) = accumulator
+                .as_object()
+                .filter(|ops| ops.len() == 1)
+                .and_then(|ops| ops.iter().next())
+                .ok_or_else(|| format!("$group field '{name}' must be a single accumulator"))?;
+            let kind = AccumulatorKind::from_name(op)
+                .ok_or_else(|| format!("unknown $group accumulator '{op}'"))?;
+            fields.push((name.clone(), kind, Expr::parse(operand)));
+        }
+        Ok(GroupSpec { id: Expr::parse(id), fields })
+    }
+
+    /// Folds one document into a task's groups.
+    fn add(&self, groups: &mut Groups, position: usize, doc: &Value) {
+        let id = self.id.evaluate(doc).unwrap_or(Value::Null);
+        let key = serde_json::to_string(&id).unwrap_or_default();
+        let group = groups.entry(key).or_insert_with(|| Group {
+            first: position,
+            id,
+            accumulators: self.fields.iter().map(|(_, kind, _)| Accumulator::new(*kind)).collect(),
+        });
+        for ((_, kind, expr), accumulator) in self.fields.iter().zip(&mut group.accumulators) {
+            let value = if *kind == AccumulatorKind::Count { None } else { expr.evaluate(doc) };
+            accumulator.add(*kind, position, value);
+        }
+    }
+
+    /// Merges the groups of two tasks.
+    fn merge(&self, mut left: Groups, right: Groups) -> Groups {
+        if left.len() < right.len() {
+            return self.merge(right, left);
+        }
+        for (key, group) in right {
+            match left.get_mut(&key) {
+                Some(existing) => {
+                    existing.first = existing.first.min(group.first);
+                    for ((_, kind, _), (mine, theirs)) in self
+                        .fields
+                        .iter()
+                        .zip(existing.accumulators.iter_mut().zip(group.accumulators))
+                    {
+                        mine.merge(*kind, theirs);
+                    }
+                }
+                None => {
+                    left.insert(key, group);
+                }
+            }
+        }
+        left
+    }
+
+    /// Groups a slice of inputs in parallel.
+    ///
+    /// # Arguments
+    ///
+    /// * `inputs` - The inputs; their positions order `$first`, `$last`, `$push`, and the output.
+    /// * `doc_of` - Returns the document of an input, or `None` to skip it.
+    ///
+    /// # Returns
+    ///
+    /// One document per group, in the order of the groups' first inputs.
+    fn run<T, F>(&self, inputs: &[T], doc_of: F) -> Vec<Value>
+    where
+        T: Sync,
+        F: for<'a> Fn(&'a T) -> Option<Cow<'a, Value>> + Sync,
+    {
+        let chunk = chunk_len(inputs.len());
+        let partials: Vec<Groups> = inputs
+            .par_chunks(chunk)
+            .enumerate()
+            .map(|(c, items)| {
+                let mut groups = Groups::new();
+                for (offset, input) in items.iter().enumerate() {
+                    if let Some(doc) = doc_of(input) {
+                        self.add(&mut groups, c * chunk + offset, &doc);
+                    }
+                }
+                groups
+            })
+            .collect();
+        let groups =
+            partials.into_iter().fold(Groups::new(), |left, right| self.merge(left, right));
+
+        let mut groups: Vec<Group> = groups.into_values().collect();
+        groups.sort_unstable_by_key(|group| group.first);
+        groups
+            .into_iter()
+            .map(|group| {
+                let mut out = Map::new();
+                out.insert("_id".to_string(), group.id);
+                for ((name, _, _), accumulator) in self.fields.iter().zip(group.accumulators) {
+                    out.insert(name.clone(), accumulator.finish());
+                }
+                Value::Object(out)
+            })
+            .collect()
+    }
+}
+
+/// A compiled pipeline stage.
+#[derive(Debug, Clone)]
+enum Stage {
+    Match(std::sync::Arc<CompiledQuery>),
+    Group(GroupSpec),
+    Sort(SortSpec),
+    Skip(usize),
+    Limit(usize),
+    Project(Value),
+    Count(String),
+}
+
+impl Stage {
+    /// Compiles one stage of a pipeline.
+    fn parse(stage: &Value) -> Result<Stage, String> {
+        let (name, body) = stage
+            .as_object()
+            .filter(|map| map.len() == 1)
+            .and_then(|map| map.iter().next())
+            .ok_or("every pipeline stage must be an object with exactly one field")?;
+        let count_of = |what: &str| {
+            body.as_u64()
+                .map(|n| n as usize)
+                .ok_or_else(|| format!("{what} must be a non-negative integer"))
+        };
+        match name.as_str() {
+            "$match" if body.is_object() => Ok(Stage::Match(
+                compile_cached(&body.to_string()).ok_or("$match must be a query object")?,
+            )),
+            "$match" => Err("$match must be a query object".to_string()),
+            "$group" => GroupSpec::parse(body).map(Stage::Group),
+            "$sort" => SortSpec::parse(body)
+                .map(Stage::Sort)
+                .ok_or_else(|| "$sort must map fields to 1 or -1".to_string()),
+            "$skip" => count_of("$skip").map(Stage::Skip),
+            "$limit" => match count_of("$limit")? {
+                0 => Err("$limit must be positive".to_string()),
+                n => Ok(Stage::Limit(n)),
+            },
+            "$project" if body.is_object() => Ok(Stage::Project(body.clone())),
+            "$project" => Err("$project must be an object".to_string()),
+            "$count" => match body.as_str() {
+                Some(field) if !field.is_empty() && !field.starts_with('$') => {
+                    Ok(Stage::Count(field.to_string()))
+                }
+                _ => Err("$count must be a non-empty field name".to_string()),
+            },
+            other => Err(format!("unknown pipeline stage '{other}'")),
+        }
+    }
+}
+
+/// Compiles a pipeline.
+///
+/// # Returns
+///
+/// The stages, or a description of the first problem found.
+fn parse_pipeline(pipeline_str: &str) -> Result<Vec<Stage>, String> {
+    let pipeline: Value =
+        serde_json::from_str(pipeline_str).map_err(|_| "the pipeline is not valid JSON")?;
+    pipeline.as_array().ok_or("the pipeline must be an array")?.iter().map(Stage::parse).collect()
+}
+
+/// Orders documents, keeping only the best `bound` of them if a `$limit` follows.
+fn sort_documents(docs: Vec<Value>, spec: &SortSpec, bound: Option<usize>) -> Vec<Value> {
+    let ranked = docs.par_iter().enumerate().map(|(i, doc)| (i as u32, spec.key_of(doc))).collect();
+    let order = spec.paginate(ranked, bound.unwrap_or(0), 0);
+    let mut slots: Vec<Option<Value>> = docs.into_iter().map(Some).collect();
+    order.into_iter().filter_map(|i| slots[i as usize].take()).collect()
+}
+
+/// Runs a pipeline over a batch of raw BSON documents.
+///
+/// The documents are decoded lazily: a leading `$match` filters them as they are decoded, and a
+/// `$group` that comes first folds them one at a time, so neither holds the decoded input in
+/// memory. Buffers that fail to decode are skipped.
+///
+/// # Arguments
+///
+/// * `docs` - A slice of borrowed BSON document buffers.
+/// * `pipeline_str` - The pipeline, as a JSON array of stages.
+///
+/// # Returns
+///
+/// The results as a JSON array, or a description of what is wrong with the pipeline.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::aggregate::aggregate_raw;
+///
+/// // The BSON encodings of `{"v": 1}`, `{"v": 3}` and `{"v": 2}`.
+/// let a: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 1, 0, 0, 0, 0];
+/// let b: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 3, 0, 0, 0, 0];
+/// let c: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 2, 0, 0, 0, 0];
+/// let docs: Vec<&[u8]> = vec![&a, &b, &c];
+/// let pipeline = r#"[{"$match": {"v": {"$gt": 1}}}, {"$group": {"_id": null, "n": {"$sum": "$v"}}}]"#;
+/// assert_eq!(aggregate_raw(&docs, pipeline).unwrap(), r#"[{"_id":null,"n":5}]"#);
+/// ```
+pub fn aggregate_raw(docs: &[&[u8]], pipeline_str: &str) -> Result<String, String> {
+    let stages = parse_pipeline(pipeline_str)?;
+    let mut rest = stages.as_slice();
+
+    let mut current: Vec<Value> = match rest.first() {
+        Some(Stage::Group(spec)) => {
+            rest = &rest[1..];
+            spec.run(docs, |raw| decode_document(raw).map(Cow::Owned))
+        }
+        Some(Stage::Match(query)) => {
+            rest = &rest[1..];
+            docs.par_iter()
+                .filter_map(|raw| decode_document(raw))
+                .filter(|d| query.matches(d))
+                .collect()
+        }
+        _ => docs.par_iter().filter_map(|raw| decode_document(raw)).collect(),
+    };
+
+    while let Some((stage, tail)) = rest.split_first() {
+        rest = tail;
+        current = match stage {
+            Stage::Match(query) => {
+                current.into_par_iter().filter(|doc| query.matches(doc)).collect()
+            }
+            Stage::Group(spec) => spec.run(&current, |doc| Some(Cow::Borrowed(doc))),
+            Stage::Sort(spec) => {
+                let bound = match rest.first() {
+                    Some(Stage::Limit(n)) => Some(*n),
+                    _ => None,
+                };
+                sort_documents(current, spec, bound)
+            }
+            Stage::Skip(n) => current.into_iter().skip(*n).collect(),
+            Stage::Limit(n) => current.into_iter().take(*n).collect(),
+            Stage::Project(projection) => {
+                current.par_iter().map(|doc| apply_projection(doc, projection)).collect()
+            }
+            Stage::Count(field) => {
+                if current.is_empty() {
+                    Vec::new()
+                } else {
+                    let mut out = Map::new();
+                    out.insert(field.clone(), Value::from(current.len() as u64));
+                    vec![Value::Object(out)]
+                }
+            }
+        };
+    }
+
+    serde_json::to_string(&current).map_err(|e| e.to_string())
+}
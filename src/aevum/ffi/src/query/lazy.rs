@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Lazy Decoding of JSON Datasets
+//!
+//! The JSON entry points (`count`, `find`, `update`, `update_delta`, and `delete_docs`) receive a
+//! whole dataset as one JSON array. Parsing it into a `serde_json::Value` tree allocates every
+//! string, number, array, and map of every document, although a query only reads a handful of
+//! top-level fields and most documents usually do not match.
+//!
+//! This module instead splits the array into borrowed [`RawValue`] slices, which validates the
+//! input without building anything, and decodes from each document only the top-level fields that
+//! a query or sort references; every other value is skipped by the parser without being
+//! allocated. A document is decoded in full only once it is known to be part of the result.
+//!
+//! Decoding a referenced field follows `serde_json` exactly, including the last occurrence of a
+//! repeated key winning, so a query sees the same values in a partial document as in a full one.
+
+use serde::de::{self, DeserializeSeed, IgnoredAny, MapAccess, Visitor};
+use serde_json::value::RawValue;
+use serde_json::{Map, Value};
+use std::fmt;
+
+use super::plan::CompiledQuery;
+use super::sort::SortSpec;
+
+/// Splits a JSON array into its elements without decoding them.
+///
+/// # Returns
+///
+/// The raw elements in order, borrowed from `data_str`, or `None` if `data_str` is not a valid
+/// JSON array.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::lazy::split_array;
+///
+/// let docs = split_array(r#"[{"a": 1}, {"b": [2, 3]}]"#).unwrap();
+/// assert_eq!(docs[1].get(), r#"{"b": [2, 3]}"#);
+/// assert!(split_array(r#"{"a": 1}"#).is_none());
+/// ```
+pub fn split_array(data_str: &str) -> Option<Vec<&RawValue>> {
+    serde_json::from_str(data_str).ok()
+}
+
+/// Decodes a raw document in full.
+///
+/// # Returns
+///
+/// The document, or `Value::Null` if it is not valid JSON, which cannot happen for an element
+/// returned by [`split_array`].
+pub fn decode_full(raw: &RawValue) -> Value {
+    serde_json::from_str(raw.get()).unwrap_or(Value::Null)
+}
+
+/// Decodes the parts of raw documents that an operation needs to look at.
+#[derive(Debug, Clone)]
+pub struct FieldReader {
+    /// The top-level fields to decode, or `None` to decode documents in full.
+    fields: Option<Vec<String>>,
+}
+
+impl FieldReader {
+    /// Creates a reader for the fields a query reads and, optionally, the fields of a sort.
+    ///
+    /// A query that compares whole documents, rather than some of their fields, makes the reader
+    /// decode documents in full.
+    pub fn new(query: &CompiledQuery, sort: Option<&SortSpec>) -> FieldReader {
+        let fields = query.referenced_fields().map(|fields| {
+            let mut fields: Vec<String> = fields.into_iter().map(str::to_owned).collect();
+            if let Some(spec) = sort {
+                fields.extend(spec.field_names().map(str::to_owned));
+            }
+            fields
+        });
+        FieldReader { fields }
+    }
+
+    /// Decodes a raw document, keeping only the reader's fields.
+    ///
+    /// A document that is not an object is decoded in full; a query never reads its fields.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use aevum_ffi::query::lazy::{split_array, FieldReader};
+    /// use aevum_ffi::query::plan::CompiledQuery;
+    /// use serde_json::json;
+    ///
+    /// let query = CompiledQuery::new(&json!({ "age": { "$gt": 30 } }));
+    /// let reader = FieldReader::new(&query, None);
+    /// let docs = split_array(r#"[{"name": "Alice", "tags": ["x"], "age": 35}]"#).unwrap();
+    /// let partial = reader.decode(docs[0]);
+    /// assert_eq!(partial, json!({ "age": 35 }));
+    /// assert!(query.matches(&partial));
+    /// ```
+    pub fn decode(&self, raw: &RawValue) -> Value {
+        let text = raw.get().trim_start();
+        let decoded = match &self.fields {
+            Some(fields) if text.starts_with('{') => {
+                let mut deserializer = serde_json::Deserializer::from_str(text);
+                Subset(fields).deserialize(&mut deserializer)
+            }
+            _ => serde_json::from_str(text),
+        };
+        decoded.unwrap_or(Value::Null)
+    }
+}
+
+/// Deserializes a JSON object into a `Value::Object` holding only the listed fields.
+struct Subset<'a>(&'a [String]);
+
+impl<'de> DeserializeSeed<'de> for Subset<'_> {
+    type Value = Value;
+
+    fn deserialize<D: de::Deserializer<'de>>(self, deserializer: D) -> Result<Value, D::Error> {
+        deserializer.deserialize_map(self)
+    }
+}
+
+impl<'de> Visitor<'de> for Subset<'_> {
+    type Value = Value;
+
+    fn expecting(&self, formatter: &mut fmt::Formatter) -> fmt::Result {
+        formatter.write_str("a JSON object")
+    }
+
+    fn visit_map<A: MapAccess<'de>>(self, mut map: A) -> Result<Value, A::Error> {
+        let mut kept = Map::new();
+        while let Some(key) = map.next_key_seed(Referenced(self.0))? {
+            match key {
+                Some(key) => {
+                    kept.insert(key, map.next_value()?);
+                }
+                None => {
+                    map.next_value::<IgnoredAny>()?;
+                }
+            }
+        }
+        Ok(Value::Object(kept))
+    }
+}
+
+/// Deserializes an object key into `Some(key)` if it is one of the listed fields, and into
+/// `None`, without allocating, otherwise.
+struct Referenced<'a>(&'a [String]);
+
+impl<'de> DeserializeSeed<'de> for Referenced<'_> {
+    type Value = Option<String>;
+
+    fn deserialize<D: de::Deserializer<'de>>(
+        self,
+        deserializer: D,
+    ) -> Result<Option<String>, D::Error> {
+        deserializer.deserialize_str(self)
+    }
+}
+
+impl<'de> Visitor<'de> for Referenced<'_> {
+    type Value = Option<String>;
+
+    fn expecting(&self, formatter: &mut fmt::Formatter) -> fmt::Result {
+        formatter.write_str("an object key")
+    }
+
+    fn visit_str<E: de::Error>(self, key: &str) -> Result<Option<String>, E> {
+        Ok(self.0.iter().any(|field| field == key).then(|| key.to_owned()))
+    }
+}
@@ -14,7 +14,7 @@
 //! rather than causing a panic or an error, which is the correct and expected behavior for a
 //! document-oriented database.
 
-use super::operators;
+use super::plan::CompiledQuery;
 use serde_json::Value;
 
 /// Recursively evaluates if a document (`doc`) satisfies all conditions within a `query`.
@@ -37,6 +37,15 @@ use serde_json::Value;
 /// - **Missing Fields**: If a query specifies a condition on a field that does not exist within the
 ///   `doc`, that specific condition evaluates to `false`, and therefore the document does not match.
 ///
+/// - **Dotted Paths**: A key such as `"address.city"` names the `city` field of the object under
+///   `address`. Paths lead through objects only; a path that meets any other value is missing.
+///
+/// - **Array Elements**: `{"tags": {"$all": ["a", "b"]}}` requires `tags` to be an array holding
+///   each listed value (compared by exact equality), in any order and among any others.
+///
+/// - **Membership**: `{"id": {"$in": [1, 2, 3]}}` requires `id` to equal one of the listed values.
+///   The list is hashed once per query, so its length does not slow down matching.
+///
 /// - **Operator-Based Queries**: If a query value for a given key is a JSON object, and the first key
 ///   within that object begins with a `$` character, it is interpreted as an operator expression
 ///   (e.g., `{"age": {"$gt": 30}}`). The evaluation is then delegated to the `operators::evaluate`
@@ -46,6 +55,10 @@ use serde_json::Value;
 ///   comparison (`==`) is performed between the document's field value and the query's value.
 ///   This includes comparisons of nested documents and arrays.
 ///
+/// The query is compiled for this one evaluation. Callers matching many documents against the
+/// same query compile it once with [`CompiledQuery`] (or
+/// [`compile_cached`](super::plan::compile_cached)) and evaluate that instead.
+///
 /// # Arguments
 ///
 /// * `doc` - A reference to the `serde_json::Value` representing the document to be evaluated.
@@ -82,50 +95,5 @@ use serde_json::Value;
 /// assert!(!matches_query(&doc, &json!({ "state": "NY" })));
 /// ```
 pub fn matches_query(doc: &Value, query: &Value) -> bool {
-    // A null or empty query is treated as a universal match. This is a standard convention.
-    if query.is_null() || (query.is_object() && query.as_object().unwrap().is_empty()) {
-        return true;
-    }
-
-    if let Some(q_obj) = query.as_object() {
-        // All conditions in the query object must be satisfied (implicit AND semantics).
-        for (key, q_val) in q_obj {
-            // Safely retrieve the value from the document corresponding to the query key.
-            // If the key does not exist in the document, it cannot satisfy the condition.
-            let doc_val = match doc.get(key) {
-                Some(v) => v,
-                None => return false,
-            };
-
-            if let Some(operator_map) = q_val.as_object() {
-                // Heuristically determine if a nested object represents an operator map.
-                // This is done by checking if the first key in the object starts with '$'.
-                let is_operator_query =
-                    operator_map.keys().next().map_or(false, |k| k.starts_with('$'));
-
-                if is_operator_query {
-                    // If it is an operator query, evaluate each operator within the map.
-                    for (op, target) in operator_map {
-                        if !operators::evaluate(op, doc_val, target) {
-                            return false; // If any single operator condition fails, the entire document fails to match.
-                        }
-                    }
-                } else if doc_val != q_val {
-                    // This is not an operator map, but a nested object. Perform a deep equality check.
-                    return false;
-                }
-            } else if doc_val != q_val {
-                // This is a direct primitive value comparison. If they are not equal, the match fails.
-                return false;
-            }
-        }
-    } else {
-        // If the query itself is not an object (e.g., just a string or number), the match
-        // only succeeds if the entire document is equal to that primitive value. This is an
-        // edge case but is handled for completeness.
-        return doc == query;
-    }
-    // If the function has not returned `false` after checking all conditions, it means
-    // the document is a valid match.
-    true
+    CompiledQuery::new(query).matches(doc)
 }
@@ -17,9 +17,16 @@
 //!   operations that correspond to standard database interactions like `find`, `count`, `update`,
 //!   and `delete`. It orchestrates the functionalities of the other modules to fulfill these requests.
 //!
+//! - **`lazy`**: Splits the JSON datasets of the JSON entry points into borrowed raw documents
+//!   and decodes only the top-level fields a query or sort reads, so unmatched documents are never
+//!   materialized.
+//!
 //! - **`matcher`**: Contains the core document-matching logic. It is responsible for recursively
 //!   evaluating a query document against a data document to determine if it meets the specified criteria.
 //!
+//! - **`plan`**: Compiles a query once into typed per-field tests with resolved operators, which
+//!   are then evaluated against every document, and caches the compiled forms of recent queries.
+//!
 //! - **`operators`**: Implements the evaluation logic for a rich set of MongoDB-style query operators
 //!   (e.g., comparison operators like `$eq`, `$gt`, `$lt`, and type-checking operators like `$type`).
 //!   This module gives the query language its expressive power.
@@ -28,16 +35,30 @@
 //!   `serde_json::Value` types. This is essential for implementing correct and stable sorting
 //!   behavior across heterogeneous data.
 //!
+//! - **`sort`**: Turns a sort specification into compact per-document sort keys and selects the
+//!   top `skip + limit` results of a query without ordering or retaining every match.
+//!
+//! - **`aggregate`**: Runs aggregation pipelines, reusing the compiled queries of `plan` for
+//!   `$match`, the sort keys of `sort` for `$sort`, and `projection` for `$project`, and adds a
+//!   parallel, hash-based `$group`.
+//!
 //! - **`projection`**: Provides the functionality for shaping the output documents by selecting,
 //!   including, or excluding specific fields from the result set.
 //!
 //! This modular design ensures that each component can be reasoned about, tested, and maintained
 //! independently, while also allowing them to be composed into a powerful and flexible query processor.
 
+/// Executes aggregation pipelines (`$match`, `$group`, `$sort`, `$skip`, `$limit`, `$project`,
+/// `$count`) over raw BSON documents, grouping in parallel.
+pub mod aggregate;
+
 /// Defines a consistent, total ordering for comparing different BSON/JSON value types,
 /// which is fundamental for correct sorting behavior.
 pub mod comparator;
 
+/// Splits JSON datasets into raw documents and decodes only the fields a query or sort reads.
+pub mod lazy;
+
 /// Implements the core filtering logic, determining if a given document satisfies the
 /// conditions specified in a query object.
 pub mod matcher;
@@ -46,6 +67,9 @@ pub mod matcher;
 /// operations by composing the functionalities of the other query modules.
 pub mod operations;
 
+/// Compiles query documents into reusable, typed matchers and caches them by query text.
+pub mod plan;
+
 /// Contains the implementation for evaluating a rich set of query operators
 /// (e.g., `$gt`, `$eq`, `$type`) against document fields.
 pub mod operators;
@@ -53,3 +77,7 @@ pub mod operators;
 /// Provides the logic for document projection, allowing for the selective inclusion or
 /// exclusion of fields in query results.
 pub mod projection;
+
+/// Implements the ordering stage of `find`: precomputed sort keys and bounded top-K selection
+/// over parallel chunks of the input.
+pub mod sort;
@@ -15,7 +15,8 @@
 //! They are designed to be directly consumed by the FFI layer, which then exposes them to external
 //! C/C++ clients. Each function is responsible for parsing input data (typically JSON strings),
 //! performing the requested operation in parallel using `rayon`, and serializing the results back
-//! into a string format.
+//! into a string format. JSON datasets are split into raw documents by the `lazy` module, and only
+//! the fields a query reads are decoded until a document is known to be part of the result.
 //!
 //! ## Implementation Philosophy and Caveats
 //!
@@ -33,11 +34,27 @@
 //! - **Transactional Semantics**: To ensure atomicity for write operations.
 
 use rayon::prelude::*;
-use serde_json::Value;
+use serde_json::value::RawValue;
+use serde_json::{Map, Value};
+use std::borrow::Cow;
+use std::sync::Arc;
 
-use super::comparator::compare_values;
-use super::matcher::matches_query;
+use crate::bson::decode_document;
+
+use super::lazy::{decode_full, split_array, FieldReader};
+use super::plan::{compile_cached, CompiledQuery};
 use super::projection::apply_projection;
+use super::sort::{collect_ranked, SortSpec};
+
+/// Compiles the query of a find, count, update, or delete operation.
+///
+/// # Returns
+///
+/// The compiled query, shared through the plan cache, or `None` if `query_str` is not valid JSON
+/// or is `null`, which these operations reject.
+fn compile_query(query_str: &str) -> Option<Arc<CompiledQuery>> {
+    compile_cached(query_str).filter(|query| !query.is_null())
+}
 
 /// Validates a document represented as a string against a schema query string.
 ///
@@ -75,15 +92,53 @@ pub fn validate(doc_str: &str, schema_str: &str) -> bool {
         Ok(d) => d,
         Err(_) => return false,
     };
-    let schema: Value = match serde_json::from_str(schema_str) {
-        Ok(s) => s,
-        Err(_) => return false,
+    let Some(schema) = compile_cached(schema_str) else {
+        return false;
+    };
+
+    // The schema is an ordinary query, which allows for both simple type-checking style
+    // "schemas" and complex, operator-based criteria.
+    schema.matches(&doc)
+}
+
+/// Validates a batch of raw BSON documents against a schema and returns the positions of the
+/// documents that fail it.
+///
+/// This is the zero-copy, batched counterpart of [`validate`]. The documents are checked in
+/// parallel with `rayon`, each one with the same `matches_query` semantics as `validate`, so that
+/// a bulk insert pays for a single FFI call instead of one JSON round-trip per document.
+///
+/// # Arguments
+///
+/// * `docs` - A slice of borrowed BSON document buffers.
+/// * `schema_str` - The JSON schema query every document must satisfy.
+///
+/// # Returns
+///
+/// A `Vec<u32>` with the positions, in ascending order, of the documents that are malformed or do
+/// not satisfy the schema. If the schema itself is not valid JSON, every position is returned.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::operations::validate_raw;
+///
+/// // { "v": 1 } and { "v": 2 }
+/// let one: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 1, 0, 0, 0, 0];
+/// let two: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 2, 0, 0, 0, 0];
+/// let docs: Vec<&[u8]> = vec![&one, &two];
+/// assert_eq!(validate_raw(&docs, r#"{ "v": { "$gt": 1 } }"#), vec![0]);
+/// ```
+pub fn validate_raw(docs: &[&[u8]], schema_str: &str) -> Vec<u32> {
+    let Some(schema) = compile_cached(schema_str) else {
+        return (0..docs.len() as u32).collect();
     };
 
-    // Use the robust `matches_query` logic to perform validation.
-    // This allows for both simple type-checking style "schemas" and
-    // complex, operator-based criteria.
-    matches_query(&doc, &schema)
+    docs.par_iter()
+        .enumerate()
+        .filter(|(_, raw)| !decode_document(raw).is_some_and(|doc| schema.matches(&doc)))
+        .map(|(i, _)| i as u32)
+        .collect()
 }
 
 /// Counts the number of documents in a dataset that satisfy a given query.
@@ -114,18 +169,13 @@ pub fn validate(doc_str: &str, schema_str: &str) -> bool {
 /// assert_eq!(count(data, "{}"), 3); // Counts all documents.
 /// ```
 pub fn count(data_str: &str, query_str: &str) -> i32 {
-    let data: Value = serde_json::from_str(data_str).unwrap_or(Value::Null);
-    let query: Value = serde_json::from_str(query_str).unwrap_or(Value::Null);
-
-    if !data.is_array() || query.is_null() {
+    let (Some(docs), Some(query)) = (split_array(data_str), compile_query(query_str)) else {
         return 0; // Robustly handle invalid input by returning a zero count.
-    }
+    };
 
-    data.as_array()
-        .unwrap() // This is safe due to the `is_array` check above.
-        .par_iter()
-        .filter(|doc| matches_query(doc, &query))
-        .count() as i32
+    // Only the fields the query reads are decoded from each document.
+    let reader = FieldReader::new(&query, None);
+    docs.par_iter().filter(|raw| query.matches(&reader.decode(raw))).count() as i32
 }
 
 /// Finds and retrieves a filtered, sorted, and projected subset of documents from a dataset.
@@ -165,70 +215,304 @@ pub fn find(
     limit: usize,
     skip: usize,
 ) -> String {
-    let data: Value = serde_json::from_str(data_str).unwrap_or(Value::Null);
-    let query: Value = serde_json::from_str(query_str).unwrap_or(Value::Null);
     let sort: Value = serde_json::from_str(sort_str).unwrap_or(Value::Null);
     let projection: Value = serde_json::from_str(projection_str).unwrap_or(Value::Null);
 
-    if !data.is_array() || query.is_null() {
+    let (Some(docs), Some(query)) = (split_array(data_str), compile_query(query_str)) else {
         return "[]".to_string();
-    }
+    };
 
-    // Step 1: Filter the documents in parallel based on the query.
-    let mut filtered_docs: Vec<Value> = data
-        .as_array()
-        .unwrap()
-        .par_iter()
-        .filter(|doc| matches_query(doc, &query))
-        .cloned() // `cloned()` is necessary to get owned `Value`s for sorting and modification.
-        .collect();
+    let spec = SortSpec::parse(&sort);
+    let reader = FieldReader::new(&query, spec.as_ref());
+    let take = if limit == 0 { usize::MAX } else { limit }; // A limit of 0 means no limit.
 
-    // Step 2: Apply sorting if a valid sort specification is provided.
-    if let Some(sort_obj) = sort.as_object() {
-        if !sort_obj.is_empty() {
-            // `par_sort_unstable_by` is used for performance. The sort is "unstable" in that
-            // elements that compare as equal are not guaranteed to preserve their original order.
-            filtered_docs.par_sort_unstable_by(|a, b| {
-                for (key, order_val) in sort_obj {
-                    let order = if order_val.as_i64() == Some(1) {
-                        std::cmp::Ordering::Less // Ascending sort order.
-                    } else if order_val.as_i64() == Some(-1) {
-                        std::cmp::Ordering::Greater // Descending sort order.
-                    } else {
-                        // An invalid sort direction value is ignored.
-                        return std::cmp::Ordering::Equal;
-                    };
-
-                    // Handle cases where a document may not contain the sort key.
-                    // Missing fields are treated as `Null` for consistent sorting.
-                    let val_a = a.get(key).unwrap_or(&Value::Null);
-                    let val_b = b.get(key).unwrap_or(&Value::Null);
-
-                    let cmp_result = compare_values(val_a, val_b);
-                    if cmp_result != std::cmp::Ordering::Equal {
-                        // Apply the sort direction (ascending or descending).
-                        return if order == std::cmp::Ordering::Less {
-                            cmp_result
-                        } else {
-                            cmp_result.reverse()
-                        };
-                    }
-                }
-                // If documents are equal according to all sort criteria, their relative order is not guaranteed.
-                std::cmp::Ordering::Equal
+    // Step 1: Filter in parallel on the fields the query and sort read. With a sort, only the sort
+    // keys of the matches are collected, and with a limit only the best `skip + limit` of them;
+    // documents are decoded in full and projected once the window of results is known.
+    let final_docs: Vec<Value> = match spec {
+        Some(spec) => {
+            let bound = (limit != 0).then(|| skip.saturating_add(limit));
+            let ranked = collect_ranked(&docs, &spec, bound, |raw| {
+                let doc = reader.decode(raw);
+                query.matches(&doc).then(|| spec.key_of(&doc))
             });
+            // Step 2: Order the candidates and paginate.
+            spec.paginate(ranked, limit, skip)
+                .into_iter()
+                .map(|i| apply_projection(&decode_full(docs[i as usize]), &projection))
+                .collect()
+        }
+        None => {
+            let matched: Vec<&RawValue> =
+                docs.par_iter().copied().filter(|raw| query.matches(&reader.decode(raw))).collect();
+            matched
+                .into_par_iter()
+                .skip(skip)
+                .take(take)
+                .map(|raw| apply_projection(&decode_full(raw), &projection))
+                .collect()
+        }
+    };
+
+    serde_json::to_string(&final_docs).unwrap_or_else(|_| "[]".to_string())
+}
+
+/// Counts the raw BSON documents that satisfy a given query.
+///
+/// This is the zero-copy counterpart of [`count`]. Instead of a JSON array, it receives the
+/// binary BSON buffers borrowed from the caller's primary index and decodes each one in
+/// parallel. Buffers that fail to decode are treated as non-matching.
+///
+/// # Arguments
+///
+/// * `docs` - A slice of borrowed BSON document buffers.
+/// * `query_str` - A string slice representing the filter query. An empty JSON object `{}`
+///   counts every decodable document.
+///
+/// # Returns
+///
+/// An `i32` with the number of matching documents, or `0` if the query is malformed.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::operations::count_raw;
+///
+/// // The BSON encodings of `{"v": 1}` and `{"v": 2}`.
+/// let one: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 1, 0, 0, 0, 0];
+/// let two: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 2, 0, 0, 0, 0];
+/// let docs: Vec<&[u8]> = vec![&one, &two];
+/// assert_eq!(count_raw(&docs, r#"{ "v": { "$gt": 1 } }"#), 1);
+/// ```
+pub fn count_raw(docs: &[&[u8]], query_str: &str) -> i32 {
+    let Some(query) = compile_query(query_str) else {
+        return 0;
+    };
+
+    docs.par_iter()
+        .filter(|raw| decode_document(raw).is_some_and(|doc| query.matches(&doc)))
+        .count() as i32
+}
+
+/// Finds the raw BSON documents that satisfy a query and returns their positions.
+///
+/// This is the zero-copy counterpart of [`find`]. It filters, sorts, and paginates exactly like
+/// `find`, but rather than re-encoding the resulting documents it returns the indices of the
+/// matching buffers within `docs`, in result order. The caller already owns those documents and
+/// can hand them out directly. Projection is intentionally not applied here, since it would
+/// require producing new documents; callers apply it on their side.
+///
+/// # Arguments
+///
+/// * `docs` - A slice of borrowed BSON document buffers.
+/// * `query_str` - The filter conditions.
+/// * `sort_str` - The sort order specification (e.g., `{"field": 1}` for ascending).
+/// * `limit` - The maximum number of indices to return (`0` for no limit).
+/// * `skip` - The number of matches to skip from the beginning of the sorted set.
+///
+/// # Returns
+///
+/// A `Vec<u32>` of positions into `docs`. Without a sort specification, the positions are in
+/// ascending order. Returns an empty vector if the query is malformed or nothing matches.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::operations::find_raw;
+///
+/// // The BSON encodings of `{"v": 1}`, `{"v": 3}` and `{"v": 2}`.
+/// let a: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 1, 0, 0, 0, 0];
+/// let b: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 3, 0, 0, 0, 0];
+/// let c: [u8; 12] = [12, 0, 0, 0, 0x10, b'v', 0, 2, 0, 0, 0, 0];
+/// let docs: Vec<&[u8]> = vec![&a, &b, &c];
+/// assert_eq!(find_raw(&docs, "{}", r#"{ "v": -1 }"#, 2, 0), vec![1, 2]);
+/// ```
+pub fn find_raw(
+    docs: &[&[u8]],
+    query_str: &str,
+    sort_str: &str,
+    limit: usize,
+    skip: usize,
+) -> Vec<u32> {
+    let sort: Value = serde_json::from_str(sort_str).unwrap_or(Value::Null);
+    let Some(query) = compile_query(query_str) else {
+        return Vec::new();
+    };
+
+    let take = if limit == 0 { usize::MAX } else { limit }; // A limit of 0 means no limit.
+
+    let Some(spec) = SortSpec::parse(&sort) else {
+        // Without a sort, matches are returned in storage order.
+        let matched: Vec<u32> = docs
+            .par_iter()
+            .enumerate()
+            .filter(|(_, raw)| decode_document(raw).is_some_and(|doc| query.matches(&doc)))
+            .map(|(i, _)| i as u32)
+            .collect();
+        return matched.into_iter().skip(skip).take(take).collect();
+    };
+
+    // Step 1: Decode and filter in parallel chunks. Each match contributes only its sort key and
+    // is dropped right after; with a limit, each chunk keeps just its best `skip + limit` keys.
+    let bound = (limit != 0).then(|| skip.saturating_add(limit));
+    let ranked = collect_ranked(docs, &spec, bound, |raw| {
+        let doc = decode_document(raw)?;
+        query.matches(&doc).then(|| spec.key_of(&doc))
+    });
+
+    // Step 2: Merge the chunks' candidates, order them, and paginate.
+    spec.paginate(ranked, limit, skip)
+}
+
+/// Applies an update specification to a single document, respecting an optional schema.
+///
+/// Every top-level key of `update_doc` is set on (or overwrites the value in) a copy of `doc`.
+/// The candidate is accepted only if there is no `schema` or the candidate satisfies it.
+///
+/// # Returns
+///
+/// The post-update image if `doc` matches `query` and the candidate passes validation, or `None`
+/// if the document is left unchanged.
+fn apply_update(
+    doc: &Value,
+    query: &CompiledQuery,
+    update_doc: &Value,
+    schema: Option<&CompiledQuery>,
+) -> Option<Value> {
+    if !query.matches(doc) {
+        return None;
+    }
+    let mut candidate_doc = doc.clone();
+    if let (Some(candidate_obj), Some(update_obj)) =
+        (candidate_doc.as_object_mut(), update_doc.as_object())
+    {
+        if update_obj.keys().any(|key| key.starts_with('$')) {
+            if !apply_operators(candidate_obj, update_obj) {
+                return None;
+            }
+        } else {
+            for (key, val) in update_obj {
+                candidate_obj.insert(key.clone(), val.clone());
+            }
         }
     }
 
-    // Step 3: Apply pagination (skip/limit) and projection.
-    let final_docs: Vec<Value> = filtered_docs
-        .into_par_iter()
-        .skip(skip)
-        .take(if limit == 0 { usize::MAX } else { limit }) // A limit of 0 means no limit.
-        .map(|doc| apply_projection(&doc, &projection))
-        .collect();
+    // Validate the candidate update against the schema if provided.
+    if schema.map_or(true, |schema| schema.matches(&candidate_doc)) {
+        Some(candidate_doc)
+    } else {
+        None
+    }
+}
 
-    serde_json::to_string(&final_docs).unwrap_or_else(|_| "[]".to_string())
+/// Applies the operators of an update document to a document.
+///
+/// `$set` assigns each of its field paths, creating the embedded documents a dotted path leads
+/// through, and `$inc` adds each of its numbers to its field, which is taken as 0 if missing. Two
+/// integers add as a 64-bit integer, and as a double if that overflows or either is a double.
+///
+/// # Returns
+///
+/// `false`, with `doc` possibly partly modified, if the update mixes operators with plain fields,
+/// names another operator, gives an operator anything but an object, increments by or a value
+/// that is not a number, or has a path lead through a value that is not a document.
+fn apply_operators(doc: &mut Map<String, Value>, update: &Map<String, Value>) -> bool {
+    for (operator, fields) in update {
+        let increment = match operator.as_str() {
+            "$set" => false,
+            "$inc" => true,
+            _ => return false,
+        };
+        let Some(fields) = fields.as_object() else {
+            return false;
+        };
+        for (path, value) in fields {
+            let Some((parent, key)) = field_parent(doc, path) else {
+                return false;
+            };
+            let assigned =
+                if increment { add_numbers(parent.get(key), value) } else { Some(value.clone()) };
+            let Some(assigned) = assigned else {
+                return false;
+            };
+            parent.insert(key.to_string(), assigned);
+        }
+    }
+    true
+}
+
+/// Locates the document holding the last field of a dotted path, creating the embedded documents
+/// the path leads through.
+///
+/// # Returns
+///
+/// The document and the name of the last field, or `None` if the path has an empty name or leads
+/// through a value that is not a document.
+fn field_parent<'a, 'p>(
+    doc: &'a mut Map<String, Value>,
+    path: &'p str,
+) -> Option<(&'a mut Map<String, Value>, &'p str)> {
+    let (parents, key) = match path.rsplit_once('.') {
+        Some((parents, key)) => (Some(parents), key),
+        None => (None, path),
+    };
+    if key.is_empty() {
+        return None;
+    }
+    let mut parent = doc;
+    for name in parents.into_iter().flat_map(|parents| parents.split('.')) {
+        if name.is_empty() {
+            return None;
+        }
+        parent = parent
+            .entry(name.to_string())
+            .or_insert_with(|| Value::Object(Map::new()))
+            .as_object_mut()?;
+    }
+    Some((parent, key))
+}
+
+/// Adds an increment to a numeric value, as `$inc` does.
+///
+/// # Returns
+///
+/// The sum, the increment itself if `current` is missing, or `None` if either is not a number
+/// or the sum of doubles is not finite.
+fn add_numbers(current: Option<&Value>, delta: &Value) -> Option<Value> {
+    if !delta.is_number() {
+        return None;
+    }
+    let Some(current) = current else {
+        return Some(delta.clone());
+    };
+    if let (Some(a), Some(b)) = (current.as_i64(), delta.as_i64()) {
+        if let Some(sum) = a.checked_add(b) {
+            return Some(Value::from(sum));
+        }
+    }
+    let sum = current.as_f64()? + delta.as_f64()?;
+    serde_json::Number::from_f64(sum).map(Value::Number)
+}
+
+/// Applies an update to a raw JSON document if it matches the query.
+///
+/// The match is decided on the fields the query reads, so a document the update does not select
+/// is never decoded in full.
+///
+/// # Returns
+///
+/// The post-update image, or `None` if the document does not match or a schema rejects the image.
+fn update_raw(
+    raw: &RawValue,
+    reader: &FieldReader,
+    query: &CompiledQuery,
+    update_doc: &Value,
+    schema: Option<&CompiledQuery>,
+) -> Option<Value> {
+    if !query.matches(&reader.decode(raw)) {
+        return None;
+    }
+    apply_update(&decode_full(raw), query, update_doc, schema)
 }
 
 /// Updates all documents in a dataset that match a given query, respecting an optional schema.
@@ -238,13 +522,14 @@ pub fn find(
 /// * `data_str` - A JSON array of documents.
 /// * `query_str` - A query to select which documents to update.
 /// * `update_str` - A JSON object where each key-value pair will be set or overwritten
-///   in the matched documents.
+///   in the matched documents, or a document of `$set` and `$inc` operators.
 /// * `schema_str` - An optional JSON schema query to validate documents after update.
 ///
 /// # Returns
 ///
 /// A tuple containing:
 /// 1. A `String` containing the JSON representation of the entire dataset after the updates.
+///    Documents that were not modified appear exactly as they did in `data_str`.
 /// 2. The number of documents that were actually modified.
 pub fn update(
     data_str: &str,
@@ -252,45 +537,94 @@ pub fn update(
     update_str: &str,
     schema_str: &str,
 ) -> (String, i32) {
-    let data: Value = serde_json::from_str(data_str).unwrap_or(Value::Null);
-    let query: Value = serde_json::from_str(query_str).unwrap_or(Value::Null);
     let update_doc: Value = serde_json::from_str(update_str).unwrap_or(Value::Null);
-    let schema: Value = serde_json::from_str(schema_str).unwrap_or(Value::Null);
+    let schema = compile_cached(schema_str);
 
-    if !data.is_array() || query.is_null() || !update_doc.is_object() {
+    let query = compile_query(query_str).filter(|_| update_doc.is_object());
+    let (Some(docs), Some(query)) = (split_array(data_str), query) else {
         return ("[]".to_string(), 0);
-    }
-
-    let data_array = data.as_array().unwrap();
+    };
+    let reader = FieldReader::new(&query, None);
 
     // We use a regular iterator here because we need to count accurately,
     // and simple atomic counters in parallel iterators can be slightly more complex.
+    // Documents that are left unchanged are copied through verbatim, without being decoded.
     let mut modified_count = 0;
-    let updated_docs: Vec<Value> = data_array
+    let updated_docs: Vec<Cow<str>> = docs
         .iter()
-        .map(|doc| {
-            let mut current_doc = doc.clone();
-            if matches_query(&current_doc, &query) {
-                let mut candidate_doc = current_doc.clone();
-                if let (Some(candidate_obj), Some(update_obj)) =
-                    (candidate_doc.as_object_mut(), update_doc.as_object())
-                {
-                    for (key, val) in update_obj {
-                        candidate_obj.insert(key.clone(), val.clone());
-                    }
-                }
-
-                // Validate the candidate update against the schema if provided.
-                if schema.is_null() || matches_query(&candidate_doc, &schema) {
-                    current_doc = candidate_doc;
-                    modified_count += 1;
-                }
+        .map(|raw| match update_raw(raw, &reader, &query, &update_doc, schema.as_deref()) {
+            Some(updated) => {
+                modified_count += 1;
+                Cow::Owned(updated.to_string())
             }
-            current_doc
+            None => Cow::Borrowed(raw.get()),
         })
         .collect();
 
-    (serde_json::to_string(&updated_docs).unwrap_or_else(|_| "[]".to_string()), modified_count)
+    (format!("[{}]", updated_docs.join(",")), modified_count)
+}
+
+/// Updates the documents of a dataset that match a given query and reports only what changed.
+///
+/// This is the delta-producing counterpart of `update`. Instead of re-serializing the whole
+/// dataset, it returns the positions of the modified documents within the input array together
+/// with their post-update images. The caller, which still holds the input, thereby has both the
+/// before and the after image of every modified document and can apply the change
+/// incrementally. Documents that do not match, or whose candidate fails schema validation, are
+/// omitted.
+///
+/// # Arguments
+///
+/// * `data_str` - A JSON array of documents.
+/// * `query_str` - A query to select which documents to update.
+/// * `update_str` - A JSON object where each key-value pair will be set or overwritten
+///   in the matched documents, or a document of `$set` and `$inc` operators.
+/// * `schema_str` - An optional JSON schema query to validate documents after update.
+///
+/// # Returns
+///
+/// A tuple containing:
+/// 1. The positions of the modified documents within `data_str`, in ascending order.
+/// 2. A `String` containing a JSON array with the post-update image of each modified document,
+///    in the same order as the positions.
+///
+/// Returns an empty vector and `[]` if any input is invalid.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::operations::update_delta;
+///
+/// let data = r#"[{"name": "Alice", "age": 30}, {"name": "Bob", "age": 25}]"#;
+/// let (positions, images) = update_delta(data, r#"{ "name": "Bob" }"#, r#"{ "age": 26 }"#, "");
+/// assert_eq!(positions, vec![1]);
+/// assert_eq!(images, r#"[{"age":26,"name":"Bob"}]"#);
+/// ```
+pub fn update_delta(
+    data_str: &str,
+    query_str: &str,
+    update_str: &str,
+    schema_str: &str,
+) -> (Vec<u32>, String) {
+    let update_doc: Value = serde_json::from_str(update_str).unwrap_or(Value::Null);
+    let schema = compile_cached(schema_str);
+
+    let query = compile_query(query_str).filter(|_| update_doc.is_object());
+    let (Some(docs), Some(query)) = (split_array(data_str), query) else {
+        return (Vec::new(), "[]".to_string());
+    };
+    let reader = FieldReader::new(&query, None);
+
+    let (positions, images): (Vec<u32>, Vec<Value>) = docs
+        .par_iter()
+        .enumerate()
+        .filter_map(|(i, raw)| {
+            update_raw(raw, &reader, &query, &update_doc, schema.as_deref())
+                .map(|updated| (i as u32, updated))
+        })
+        .unzip();
+
+    (positions, serde_json::to_string(&images).unwrap_or_else(|_| "[]".to_string()))
 }
 
 /// Deletes all documents from a dataset that match a given query.
@@ -302,8 +636,8 @@ pub fn update(
 ///
 /// # Returns
 ///
-/// A `String` containing the JSON representation of the dataset after the deletions.
-/// Returns `[]` if any input is invalid.
+/// A `String` containing the JSON representation of the dataset after the deletions, with each
+/// remaining document exactly as it appeared in `data_str`. Returns `[]` if any input is invalid.
 ///
 /// # Example
 ///
@@ -313,24 +647,21 @@ pub fn update(
 /// let data = r#"[{"name": "Alice"}, {"name": "Bob"}]"#;
 /// let query = r#"{ "name": "Bob" }"#;
 /// let result = delete_docs(data, query);
-/// assert_eq!(result, r#"[{"name":"Alice"}]"#);
+/// assert_eq!(result, r#"[{"name": "Alice"}]"#);
 /// ```
 pub fn delete_docs(data_str: &str, query_str: &str) -> String {
-    let data: Value = serde_json::from_str(data_str).unwrap_or(Value::Null);
-    let query: Value = serde_json::from_str(query_str).unwrap_or(Value::Null);
-
-    if !data.is_array() || query.is_null() {
+    let (Some(docs), Some(query)) = (split_array(data_str), compile_query(query_str)) else {
         return "[]".to_string();
-    }
+    };
+    let reader = FieldReader::new(&query, None);
 
-    // `filter` is used to retain only the documents that do *not* match the query.
-    let remaining_docs: Vec<Value> = data
-        .as_array()
-        .unwrap()
+    // `filter` is used to retain only the documents that do *not* match the query, which are
+    // copied through verbatim.
+    let remaining_docs: Vec<&str> = docs
         .par_iter()
-        .filter(|doc| !matches_query(doc, &query))
-        .cloned()
+        .filter(|raw| !query.matches(&reader.decode(raw)))
+        .map(|raw| raw.get())
         .collect();
 
-    serde_json::to_string(&remaining_docs).unwrap_or_else(|_| "[]".to_string())
+    format!("[{}]", remaining_docs.join(","))
 }
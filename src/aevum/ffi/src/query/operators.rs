@@ -18,7 +18,10 @@
 //! - **Comparison Operators**: `$eq` (equal), `$ne` (not equal), `$gt` (greater than),
 //!   `$lt` (less than), `$gte` (greater than or equal), `$lte` (less than or equal).
 //! - **Element Operators**: `$type` (checks the BSON/JSON type of a field).
+//! - **Membership Operators**: `$in` (equals one of a list of values), `$all` (an array holding
+//!   every one of a list of values).
 
+use super::plan;
 use serde_json::Value;
 
 /// Evaluates a specified query operator between a document field and a target value.
@@ -37,6 +40,9 @@ use serde_json::Value;
 /// - The `$type` operator validates that the `field_val` matches the BSON/JSON type specified by
 ///   the `target_val` (which must be a string like `"string"`, `"number"`, etc.).
 ///
+/// The operator is resolved and its operand classified by the same code that compiles queries
+/// in [`plan`](super::plan), so a one-off evaluation and a compiled query always agree.
+///
 /// # Arguments
 ///
 /// * `op` - A string slice representing the operator (e.g., `"$eq"`, `"$gt"`).
@@ -63,63 +69,5 @@ use serde_json::Value;
 /// assert!(!evaluate("$type", &json!(123), &json!("string")));
 /// ```
 pub fn evaluate(op: &str, field_val: &Value, target_val: &Value) -> bool {
-    match op {
-        "$eq" => field_val == target_val,
-        "$ne" => field_val != target_val,
-
-        "$gt" => {
-            if let (Some(d), Some(t)) = (field_val.as_f64(), target_val.as_f64()) {
-                d > t
-            } else if let (Some(d), Some(t)) = (field_val.as_str(), target_val.as_str()) {
-                d > t
-            } else {
-                false
-            }
-        }
-        "$lt" => {
-            if let (Some(d), Some(t)) = (field_val.as_f64(), target_val.as_f64()) {
-                d < t
-            } else if let (Some(d), Some(t)) = (field_val.as_str(), target_val.as_str()) {
-                d < t
-            } else {
-                false
-            }
-        }
-        "$gte" => {
-            if let (Some(d), Some(t)) = (field_val.as_f64(), target_val.as_f64()) {
-                d >= t
-            } else if let (Some(d), Some(t)) = (field_val.as_str(), target_val.as_str()) {
-                d >= t
-            } else {
-                false
-            }
-        }
-        "$lte" => {
-            if let (Some(d), Some(t)) = (field_val.as_f64(), target_val.as_f64()) {
-                d <= t
-            } else if let (Some(d), Some(t)) = (field_val.as_str(), target_val.as_str()) {
-                d <= t
-            } else {
-                false
-            }
-        }
-        "$type" => {
-            if let Some(target_type_str) = target_val.as_str() {
-                match target_type_str {
-                    "string" => field_val.is_string(),
-                    "number" | "int" | "float" | "double" => field_val.is_number(),
-                    "boolean" | "bool" => field_val.is_boolean(),
-                    "array" => field_val.is_array(),
-                    "object" => field_val.is_object(),
-                    "null" => field_val.is_null(),
-                    _ => false, // An unknown type string results in a failed match.
-                }
-            } else {
-                // The `$type` operator requires its target value to be a string.
-                false
-            }
-        }
-        // Any operator not explicitly recognized is treated as a non-match.
-        _ => false,
-    }
+    plan::evaluate_operator(op, field_val, target_val)
 }
@@ -0,0 +1,502 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Compiled Query Plans
+//!
+//! Interpreting a query document for every document it is matched against repeats the same work
+//! over and over: walking the query object, telling operator maps from nested documents apart,
+//! dispatching on operator names, and inspecting the type of every operand. This module does that
+//! work once. A query is compiled into a [`CompiledQuery`], a flat list of typed per-field tests
+//! whose operators are resolved to an enum and whose relational operands are pre-classified as
+//! numbers or strings, and the compiled query is then evaluated against every document.
+//!
+//! An `$in` list is turned into a [`ValueSet`] when the query is compiled, so that testing a value
+//! against it is one hash lookup however long the list is.
+//!
+//! Since a request's query is matched in several calls (one per batch of documents) and
+//! applications send the same few queries again and again, compiled queries are also kept in a
+//! small process-wide cache keyed by the query text; see [`compile_cached`].
+//!
+//! A compiled query matches exactly the documents [`matches_query`](super::matcher::matches_query)
+//! does, since that function is itself implemented on top of this module.
+
+use serde_json::Value;
+use std::collections::{HashMap, HashSet};
+use std::sync::{Arc, Mutex, OnceLock};
+
+/// A query operator, resolved from its name.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Operator {
+    /// `$eq`: deep equality.
+    Eq,
+    /// `$ne`: deep inequality.
+    Ne,
+    /// `$gt`: greater than.
+    Gt,
+    /// `$gte`: greater than or equal.
+    Gte,
+    /// `$lt`: less than.
+    Lt,
+    /// `$lte`: less than or equal.
+    Lte,
+    /// `$type`: the field has a given type.
+    Type,
+    /// `$all`: the field is an array holding every given element.
+    All,
+    /// `$in`: the field equals one of the given elements.
+    In,
+}
+
+impl Operator {
+    /// Resolves an operator name such as `"$gt"`.
+    ///
+    /// # Returns
+    ///
+    /// The operator, or `None` if the name is not a supported operator.
+    pub fn from_name(name: &str) -> Option<Operator> {
+        match name {
+            "$eq" => Some(Operator::Eq),
+            "$ne" => Some(Operator::Ne),
+            "$gt" => Some(Operator::Gt),
+            "$gte" => Some(Operator::Gte),
+            "$lt" => Some(Operator::Lt),
+            "$lte" => Some(Operator::Lte),
+            "$type" => Some(Operator::Type),
+            "$all" => Some(Operator::All),
+            "$in" => Some(Operator::In),
+            _ => None,
+        }
+    }
+}
+
+/// The class of values a `$type` operator accepts.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum TypeClass {
+    String,
+    Number,
+    Bool,
+    Array,
+    Object,
+    Null,
+}
+
+impl TypeClass {
+    /// Resolves a `$type` operand such as `"string"` or `"double"`.
+    fn from_name(name: &str) -> Option<TypeClass> {
+        match name {
+            "string" => Some(TypeClass::String),
+            "number" | "int" | "float" | "double" => Some(TypeClass::Number),
+            "boolean" | "bool" => Some(TypeClass::Bool),
+            "array" => Some(TypeClass::Array),
+            "object" => Some(TypeClass::Object),
+            "null" => Some(TypeClass::Null),
+            _ => None,
+        }
+    }
+
+    /// Returns whether a value belongs to the class.
+    fn contains(self, value: &Value) -> bool {
+        match self {
+            TypeClass::String => value.is_string(),
+            TypeClass::Number => value.is_number(),
+            TypeClass::Bool => value.is_boolean(),
+            TypeClass::Array => value.is_array(),
+            TypeClass::Object => value.is_object(),
+            TypeClass::Null => value.is_null(),
+        }
+    }
+}
+
+/// A relational comparison (`$gt`, `$gte`, `$lt`, `$lte`).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Relation {
+    Gt,
+    Gte,
+    Lt,
+    Lte,
+}
+
+impl Relation {
+    /// Applies the relation to two ordered values.
+    fn holds<T: PartialOrd + ?Sized>(self, field: &T, target: &T) -> bool {
+        match self {
+            Relation::Gt => field > target,
+            Relation::Gte => field >= target,
+            Relation::Lt => field < target,
+            Relation::Lte => field <= target,
+        }
+    }
+}
+
+/// A scalar other than a string, reduced to a key that is equal for exactly the values
+/// `serde_json::Value` considers equal.
+///
+/// Integers and floats stay apart, as `1` and `1.0` differ as values, and a float is keyed by its
+/// bits with `-0.0` folded into `0.0`, which it equals. JSON has no NaN, so no float is unequal to
+/// itself.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+enum ScalarKey {
+    Null,
+    Bool(bool),
+    Int(i64),
+    UInt(u64),
+    Float(u64),
+}
+
+impl ScalarKey {
+    /// Returns the key of a null, boolean, or number, or `None` for any other value.
+    fn of(value: &Value) -> Option<ScalarKey> {
+        match value {
+            Value::Null => Some(ScalarKey::Null),
+            Value::Bool(b) => Some(ScalarKey::Bool(*b)),
+            Value::Number(n) => Some(if let Some(i) = n.as_i64() {
+                ScalarKey::Int(i)
+            } else if let Some(u) = n.as_u64() {
+                ScalarKey::UInt(u)
+            } else {
+                // `-0.0 == 0.0`, so both share the bits of `0.0`.
+                let f = n.as_f64().unwrap_or_default();
+                let f = if f == 0.0 { 0.0 } else { f };
+                ScalarKey::Float(f.to_bits())
+            }),
+            _ => None,
+        }
+    }
+}
+
+/// The elements of an `$in` list, set up for membership tests that cost the same however many
+/// elements there are.
+///
+/// Strings and other scalars are hashed; arrays and objects, which are rare in such lists and
+/// cannot be hashed cheaply, are compared one by one.
+#[derive(Debug, Clone, Default)]
+pub struct ValueSet {
+    strings: HashSet<Box<str>>,
+    scalars: HashSet<ScalarKey>,
+    composites: Vec<Value>,
+}
+
+impl ValueSet {
+    /// Builds the set of a list of values.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use aevum_ffi::query::plan::ValueSet;
+    /// use serde_json::json;
+    ///
+    /// let set = ValueSet::new(&[json!("a"), json!(1), json!(-0.0), json!([1])]);
+    /// assert!(set.contains(&json!("a")) && set.contains(&json!(1)) && set.contains(&json!(0.0)));
+    /// assert!(set.contains(&json!([1])));
+    /// assert!(!set.contains(&json!(1.0)) && !set.contains(&json!("1")));
+    /// ```
+    pub fn new(elements: &[Value]) -> ValueSet {
+        let mut set = ValueSet::default();
+        for element in elements {
+            if let Some(s) = element.as_str() {
+                set.strings.insert(s.into());
+            } else if let Some(key) = ScalarKey::of(element) {
+                set.scalars.insert(key);
+            } else if !set.composites.contains(element) {
+                set.composites.push(element.clone());
+            }
+        }
+        set
+    }
+
+    /// Returns whether the set holds a value equal to `value`.
+    pub fn contains(&self, value: &Value) -> bool {
+        if let Some(s) = value.as_str() {
+            self.strings.contains(s)
+        } else if let Some(key) = ScalarKey::of(value) {
+            self.scalars.contains(&key)
+        } else {
+            self.composites.contains(value)
+        }
+    }
+}
+
+/// One compiled condition on the value of a field.
+#[derive(Debug, Clone)]
+enum Test {
+    /// The value equals the operand (a literal or `$eq`).
+    Equals(Value),
+    /// The value differs from the operand (`$ne`).
+    NotEquals(Value),
+    /// A relational operator with a numeric operand; only numbers can satisfy it.
+    CompareNumber(Relation, f64),
+    /// A relational operator with a string operand; only strings can satisfy it.
+    CompareString(Relation, Box<str>),
+    /// A `$type` operator.
+    IsType(TypeClass),
+    /// An `$all` operator with a non-empty list of elements.
+    ContainsAll(Vec<Value>),
+    /// An `$in` operator with a non-empty list of elements.
+    In(ValueSet),
+}
+
+impl Test {
+    /// Compiles an operator and its operand.
+    ///
+    /// # Returns
+    ///
+    /// The test, or `None` if no value can satisfy the condition: the operator is unknown, a
+    /// relational operand is neither a number nor a string, a `$type` operand names no type, or
+    /// an `$all` or `$in` operand is not a non-empty array.
+    fn compile(op: &str, target: &Value) -> Option<Test> {
+        let relation = match Operator::from_name(op)? {
+            Operator::Eq => return Some(Test::Equals(target.clone())),
+            Operator::Ne => return Some(Test::NotEquals(target.clone())),
+            Operator::Type => {
+                return target.as_str().and_then(TypeClass::from_name).map(Test::IsType)
+            }
+            Operator::All => {
+                return target
+                    .as_array()
+                    .filter(|elements| !elements.is_empty())
+                    .map(|elements| Test::ContainsAll(elements.clone()))
+            }
+            Operator::In => {
+                return target
+                    .as_array()
+                    .filter(|elements| !elements.is_empty())
+                    .map(|elements| Test::In(ValueSet::new(elements)))
+            }
+            Operator::Gt => Relation::Gt,
+            Operator::Gte => Relation::Gte,
+            Operator::Lt => Relation::Lt,
+            Operator::Lte => Relation::Lte,
+        };
+        if let Some(number) = target.as_f64() {
+            Some(Test::CompareNumber(relation, number))
+        } else {
+            target.as_str().map(|s| Test::CompareString(relation, s.into()))
+        }
+    }
+
+    /// Evaluates the test against the value of a field.
+    fn matches(&self, value: &Value) -> bool {
+        match self {
+            Test::Equals(target) => value == target,
+            Test::NotEquals(target) => value != target,
+            Test::CompareNumber(relation, target) => {
+                value.as_f64().is_some_and(|v| relation.holds(&v, target))
+            }
+            Test::CompareString(relation, target) => {
+                value.as_str().is_some_and(|v| relation.holds(v, &**target))
+            }
+            Test::IsType(class) => class.contains(value),
+            Test::ContainsAll(targets) => value
+                .as_array()
+                .is_some_and(|elements| targets.iter().all(|target| elements.contains(target))),
+            Test::In(set) => set.contains(value),
+        }
+    }
+}
+
+/// The compiled conditions on one field. The field must be present, and all tests must hold.
+///
+/// The field is a dotted path: `"address.city"` names the `city` of the object under `address`.
+#[derive(Debug, Clone)]
+struct FieldTests {
+    field: String,
+    tests: Vec<Test>,
+}
+
+impl FieldTests {
+    /// Looks up the value the field's path leads to, through objects only.
+    fn lookup<'a>(&self, doc: &'a Value) -> Option<&'a Value> {
+        self.field.split('.').try_fold(doc, |value, name| value.as_object()?.get(name))
+    }
+
+    /// Returns the top-level field the path starts with.
+    fn top_level(&self) -> &str {
+        self.field.split('.').next().unwrap_or_default()
+    }
+}
+
+/// The overall shape of a compiled query.
+#[derive(Debug, Clone)]
+enum Plan {
+    /// Matches every document: a null or empty query.
+    All,
+    /// Matches no document: some condition can never hold.
+    Nothing,
+    /// Matches documents equal to a value: a query that is not an object.
+    Whole(Value),
+    /// Matches documents satisfying every field's tests (implicit `AND`).
+    Fields(Vec<FieldTests>),
+}
+
+/// A query compiled for repeated evaluation.
+#[derive(Debug, Clone)]
+pub struct CompiledQuery {
+    plan: Plan,
+    null: bool,
+}
+
+impl CompiledQuery {
+    /// Compiles a query document.
+    ///
+    /// # Arguments
+    ///
+    /// * `query` - The query, with the semantics described on
+    ///   [`matches_query`](super::matcher::matches_query).
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use aevum_ffi::query::plan::CompiledQuery;
+    /// use serde_json::json;
+    ///
+    /// let query = json!({ "age": { "$gte": 18, "$lt": 65 }, "active": true });
+    /// let query = CompiledQuery::new(&query);
+    /// assert!(query.matches(&json!({ "age": 30, "active": true })));
+    /// assert!(!query.matches(&json!({ "age": 70, "active": true })));
+    /// assert!(!query.matches(&json!({ "active": true })));
+    /// ```
+    pub fn new(query: &Value) -> CompiledQuery {
+        let plan = match query {
+            Value::Null => Plan::All,
+            Value::Object(map) if map.is_empty() => Plan::All,
+            Value::Object(map) => Self::compile_fields(map),
+            other => Plan::Whole(other.clone()),
+        };
+        CompiledQuery { plan, null: query.is_null() }
+    }
+
+    /// Compiles the conditions of a non-empty query object.
+    fn compile_fields(map: &serde_json::Map<String, Value>) -> Plan {
+        let mut fields = Vec::with_capacity(map.len());
+        for (field, condition) in map {
+            let operators = condition
+                .as_object()
+                .filter(|ops| ops.keys().next().is_some_and(|k| k.starts_with('$')));
+            let tests = match operators {
+                Some(ops) => {
+                    let compiled: Option<Vec<Test>> =
+                        ops.iter().map(|(op, target)| Test::compile(op, target)).collect();
+                    match compiled {
+                        Some(tests) => tests,
+                        None => return Plan::Nothing,
+                    }
+                }
+                None => vec![Test::Equals(condition.clone())],
+            };
+            fields.push(FieldTests { field: field.clone(), tests });
+        }
+        Plan::Fields(fields)
+    }
+
+    /// Returns whether the compiled query was the JSON value `null`, which the find, count, update,
+    /// and delete operations reject as malformed.
+    pub fn is_null(&self) -> bool {
+        self.null
+    }
+
+    /// Returns the top-level fields the query reads, or `None` if it compares whole documents.
+    /// A dotted path reads the top-level field it starts with.
+    ///
+    /// [`matches`](Self::matches) gives the same answer for a document as for the object holding
+    /// only these of its fields, so an object document need not be decoded beyond them.
+    pub fn referenced_fields(&self) -> Option<Vec<&str>> {
+        match &self.plan {
+            Plan::All | Plan::Nothing => Some(Vec::new()),
+            Plan::Whole(_) => None,
+            Plan::Fields(fields) => Some(fields.iter().map(FieldTests::top_level).collect()),
+        }
+    }
+
+    /// Evaluates the query against a document.
+    ///
+    /// # Returns
+    ///
+    /// `true` if the document satisfies the query.
+    pub fn matches(&self, doc: &Value) -> bool {
+        match &self.plan {
+            Plan::All => true,
+            Plan::Nothing => false,
+            Plan::Whole(value) => doc == value,
+            Plan::Fields(fields) => fields.iter().all(|f| {
+                f.lookup(doc).is_some_and(|value| f.tests.iter().all(|t| t.matches(value)))
+            }),
+        }
+    }
+}
+
+/// Evaluates one operator against a value without keeping the compiled form.
+///
+/// This backs [`operators::evaluate`](super::operators::evaluate), so that one-off evaluations and
+/// compiled queries share their semantics.
+pub(crate) fn evaluate_operator(op: &str, value: &Value, target: &Value) -> bool {
+    Test::compile(op, target).is_some_and(|test| test.matches(value))
+}
+
+/// The most compiled queries [`compile_cached`] keeps.
+const PLAN_CACHE_CAPACITY: usize = 256;
+
+/// The process-wide cache of compiled queries, keyed by query text.
+struct PlanCache {
+    entries: HashMap<String, (Arc<CompiledQuery>, u64)>,
+    clock: u64,
+}
+
+/// Returns the process-wide plan cache.
+fn plan_cache() -> &'static Mutex<PlanCache> {
+    static CACHE: OnceLock<Mutex<PlanCache>> = OnceLock::new();
+    CACHE.get_or_init(|| Mutex::new(PlanCache { entries: HashMap::new(), clock: 0 }))
+}
+
+/// Parses and compiles a query, reusing the compiled form of an identical earlier query.
+///
+/// The cache holds up to 256 queries, keyed by their exact text, which the database produces
+/// canonically for a given query. When it is full, the least recently used query is evicted.
+/// A compiled query is immutable, so the handle can be shared across threads and calls.
+///
+/// # Arguments
+///
+/// * `query_str` - The JSON text of the query.
+///
+/// # Returns
+///
+/// The compiled query, or `None` if `query_str` is not valid JSON.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::query::plan::compile_cached;
+/// use serde_json::json;
+///
+/// let first = compile_cached(r#"{ "v": { "$gt": 1 } }"#).unwrap();
+/// let again = compile_cached(r#"{ "v": { "$gt": 1 } }"#).unwrap();
+/// assert!(std::sync::Arc::ptr_eq(&first, &again));
+/// assert!(first.matches(&json!({ "v": 2 })));
+/// assert!(compile_cached("{ not json").is_none());
+/// ```
+pub fn compile_cached(query_str: &str) -> Option<Arc<CompiledQuery>> {
+    {
+        let mut cache = plan_cache().lock().unwrap_or_else(|e| e.into_inner());
+        cache.clock += 1;
+        let now = cache.clock;
+        if let Some((plan, last_used)) = cache.entries.get_mut(query_str) {
+            *last_used = now;
+            return Some(Arc::clone(plan));
+        }
+    }
+
+    // Compile outside the lock; a concurrent miss on the same text merely compiles it twice.
+    let query: Value = serde_json::from_str(query_str).ok()?;
+    let plan = Arc::new(CompiledQuery::new(&query));
+
+    let mut cache = plan_cache().lock().unwrap_or_else(|e| e.into_inner());
+    if cache.entries.len() >= PLAN_CACHE_CAPACITY && !cache.entries.contains_key(query_str) {
+        let oldest =
+            cache.entries.iter().min_by_key(|(_, (_, used))| *used).map(|(k, _)| k.clone());
+        if let Some(oldest) = oldest {
+            cache.entries.remove(&oldest);
+        }
+    }
+    let now = cache.clock;
+    cache.entries.insert(query_str.to_owned(), (Arc::clone(&plan), now));
+    Some(plan)
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Sort Keys and Bounded Top-K Selection
+//!
+//! This module implements the ordering stage of `find`. A sort specification is parsed once per
+//! request into a [`SortSpec`], and every matching document contributes a compact [`SortKey`]
+//! holding only the values of its sort fields. Comparisons then work on those keys and never look
+//! fields up in, or even retain, the documents themselves.
+//!
+//! When a query carries a limit, at most `skip + limit` results can ever be returned, so only that
+//! many candidates are kept: each chunk of input is reduced to its best `skip + limit` entries as
+//! it is filtered, and the chunks' survivors are merged by a final selection. The memory held is then
+//! proportional to the window rather than to the number of matches, and the cost of ordering is
+//! linear in the matches rather than `n log n`.
+//!
+//! Entries that compare equal on every sort field are ordered by their position in the input, so
+//! results are deterministic and identical to those of a stable sort.
+
+use rayon::prelude::*;
+use serde_json::Value;
+use std::cmp::Ordering;
+
+/// The value of one sort field of a document, reduced to what the ordering of
+/// [`compare_values`](super::comparator::compare_values) depends on.
+///
+/// The variants are declared in type precedence order. As in `compare_values`, numbers compare as
+/// `f64`, and arrays and objects compare equal to any other array or object respectively, so their
+/// contents are not kept.
+#[derive(Debug, Clone, PartialEq)]
+pub enum SortValue {
+    /// A missing field or an explicit `null`.
+    Null,
+    /// A boolean.
+    Bool(bool),
+    /// A number, as `f64`.
+    Number(f64),
+    /// A string.
+    String(Box<str>),
+    /// Any array.
+    Array,
+    /// Any object.
+    Object,
+}
+
+impl SortValue {
+    /// Reduces a document value to its sort value.
+    fn from_value(value: Option<&Value>) -> SortValue {
+        match value {
+            None | Some(Value::Null) => SortValue::Null,
+            Some(Value::Bool(b)) => SortValue::Bool(*b),
+            Some(Value::Number(n)) => SortValue::Number(n.as_f64().unwrap_or(f64::NAN)),
+            Some(Value::String(s)) => SortValue::String(s.as_str().into()),
+            Some(Value::Array(_)) => SortValue::Array,
+            Some(Value::Object(_)) => SortValue::Object,
+        }
+    }
+
+    /// Returns the type precedence of the value: `Null` < `Bool` < `Number` < `String` <
+    /// `Array` < `Object`.
+    fn precedence(&self) -> u8 {
+        match self {
+            SortValue::Null => 0,
+            SortValue::Bool(_) => 1,
+            SortValue::Number(_) => 2,
+            SortValue::String(_) => 3,
+            SortValue::Array => 4,
+            SortValue::Object => 5,
+        }
+    }
+
+    /// Compares two sort values with the semantics of `compare_values`.
+    fn compare(&self, other: &SortValue) -> Ordering {
+        match (self, other) {
+            (SortValue::Bool(a), SortValue::Bool(b)) => a.cmp(b),
+            (SortValue::Number(a), SortValue::Number(b)) => {
+                a.partial_cmp(b).unwrap_or(Ordering::Equal)
+            }
+            (SortValue::String(a), SortValue::String(b)) => a.cmp(b),
+            _ => self.precedence().cmp(&other.precedence()),
+        }
+    }
+}
+
+/// The sort values of one document, one per field of the [`SortSpec`] that produced it.
+pub type SortKey = Vec<SortValue>;
+
+/// A candidate result: the position of a document in the input and its sort key.
+pub type Ranked = (u32, SortKey);
+
+/// A parsed sort specification.
+#[derive(Debug, Clone)]
+pub struct SortSpec {
+    /// The sort fields in order of significance, each with `true` for a descending direction.
+    fields: Vec<(String, bool)>,
+}
+
+impl SortSpec {
+    /// Parses a sort specification such as `{"age": -1, "name": 1}`.
+    ///
+    /// A direction of `1` sorts ascending and `-1` descending. An unrecognised direction ends the
+    /// specification, so it and the fields after it are ignored, as they always have been.
+    ///
+    /// # Returns
+    ///
+    /// `None` if the specification is not an object or has no usable fields, in which case
+    /// results keep their input order.
+    pub fn parse(sort: &Value) -> Option<SortSpec> {
+        let mut fields = Vec::new();
+        for (key, direction) in sort.as_object()? {
+            match direction.as_i64() {
+                Some(1) => fields.push((key.clone(), false)),
+                Some(-1) => fields.push((key.clone(), true)),
+                _ => break,
+            }
+        }
+        (!fields.is_empty()).then_some(SortSpec { fields })
+    }
+
+    /// Returns the sort fields in order of significance.
+    pub fn field_names(&self) -> impl Iterator<Item = &str> {
+        self.fields.iter().map(|(field, _)| field.as_str())
+    }
+
+    /// Extracts the sort key of a document. Missing fields sort as `null`.
+    pub fn key_of(&self, doc: &Value) -> SortKey {
+        self.fields.iter().map(|(field, _)| SortValue::from_value(doc.get(field))).collect()
+    }
+
+    /// Compares two candidates: by their sort keys and, when those are equal, by position.
+    pub fn compare(&self, a: &Ranked, b: &Ranked) -> Ordering {
+        for ((_, descending), (x, y)) in self.fields.iter().zip(a.1.iter().zip(b.1.iter())) {
+            let ordering = x.compare(y);
+            if ordering != Ordering::Equal {
+                return if *descending { ordering.reverse() } else { ordering };
+            }
+        }
+        a.0.cmp(&b.0)
+    }
+
+    /// Reduces a set of candidates to its best `bound` entries, in no particular order.
+    ///
+    /// This is a linear-time selection; callers that collect candidates incrementally invoke it
+    /// whenever the set has grown to twice the bound, which keeps the amortized cost per
+    /// candidate constant and the memory held below `2 * bound` entries.
+    pub fn retain_best(&self, candidates: &mut Vec<Ranked>, bound: usize) {
+        if candidates.len() <= bound {
+            return;
+        }
+        if bound == 0 {
+            candidates.clear();
+            return;
+        }
+        candidates.select_nth_unstable_by(bound - 1, |a, b| self.compare(a, b));
+        candidates.truncate(bound);
+    }
+
+    /// Orders candidates and applies pagination.
+    ///
+    /// # Arguments
+    ///
+    /// * `candidates` - The candidates, in any order. With a limit, only the best `skip + limit`
+    ///   of them are ordered.
+    /// * `limit` - The maximum number of positions to return (`0` for no limit).
+    /// * `skip` - The number of leading results to skip.
+    ///
+    /// # Returns
+    ///
+    /// The positions of the results, in sort order.
+    pub fn paginate(&self, mut candidates: Vec<Ranked>, limit: usize, skip: usize) -> Vec<u32> {
+        if limit != 0 {
+            self.retain_best(&mut candidates, skip.saturating_add(limit));
+        }
+        candidates.par_sort_unstable_by(|a, b| self.compare(a, b));
+        let take = if limit == 0 { usize::MAX } else { limit };
+        candidates.into_iter().skip(skip).take(take).map(|(i, _)| i).collect()
+    }
+}
+
+/// Returns the number of input documents each parallel chunk of a sorted query covers.
+///
+/// Chunks are large enough to amortize the per-chunk selection and small enough to give every
+/// worker thread several of them.
+pub fn chunk_len(total: usize) -> usize {
+    const MIN_CHUNK: usize = 1024;
+    let per_thread = total / (rayon::current_num_threads() * 4).max(1);
+    per_thread.max(MIN_CHUNK)
+}
+
+/// Filters a slice of inputs in parallel chunks and keeps the candidates a sorted, paginated query
+/// can return.
+///
+/// # Arguments
+///
+/// * `inputs` - The inputs; each chunk is scanned by one task.
+/// * `spec` - The sort specification.
+/// * `bound` - With `Some(skip + limit)`, each chunk keeps only its best `bound` candidates.
+/// * `key_of` - Returns the sort key of an input if it matches the query, or `None`.
+///
+/// # Returns
+///
+/// The surviving candidates of all chunks, with positions into `inputs`, in no particular order.
+pub fn collect_ranked<T, F>(
+    inputs: &[T],
+    spec: &SortSpec,
+    bound: Option<usize>,
+    key_of: F,
+) -> Vec<Ranked>
+where
+    T: Sync,
+    F: Fn(&T) -> Option<SortKey> + Sync,
+{
+    let chunk = chunk_len(inputs.len());
+    let per_chunk: Vec<Vec<Ranked>> = inputs
+        .par_chunks(chunk)
+        .enumerate()
+        .map(|(c, items)| {
+            let mut kept: Vec<Ranked> = Vec::new();
+            for (offset, item) in items.iter().enumerate() {
+                if let Some(key) = key_of(item) {
+                    kept.push(((c * chunk + offset) as u32, key));
+                    if let Some(bound) = bound {
+                        if kept.len() >= bound.saturating_mul(2).max(1) {
+                            spec.retain_best(&mut kept, bound);
+                        }
+                    }
+                }
+            }
+            if let Some(bound) = bound {
+                spec.retain_best(&mut kept, bound);
+            }
+            kept
+        })
+        .collect();
+    per_chunk.into_iter().flatten().collect()
+}
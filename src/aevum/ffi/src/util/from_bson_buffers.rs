@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+/// Borrows a C-side array of BSON buffers as a vector of Rust byte slices, without copying.
+///
+/// The zero-copy query functions receive their dataset as two parallel C arrays: one of pointers
+/// to the first byte of each BSON document, and one of the corresponding document lengths. This
+/// function pairs them up into `&[u8]` slices that reference the caller's memory directly.
+///
+/// # Safety
+///
+/// The caller **must** guarantee that:
+///
+/// 1.  `docs` and `lens` are either null or point to arrays of at least `count` elements.
+/// 2.  Every non-null `docs[i]` points to at least `lens[i]` readable bytes.
+/// 3.  All referenced memory remains valid and unmodified for the lifetime `'a`, which in practice
+///     is the duration of the FFI call that received the arrays.
+///
+/// # Arguments
+///
+/// * `docs` - A pointer to an array of `count` BSON buffer pointers.
+/// * `lens` - A pointer to an array of `count` buffer lengths, in bytes.
+/// * `count` - The number of documents in both arrays.
+///
+/// # Returns
+///
+/// A `Vec<&[u8]>` with one slice per document. If either array pointer is null, an empty vector
+/// is returned. An individual null buffer pointer yields an empty slice, which the decoder then
+/// rejects as malformed.
+///
+/// # Example
+///
+/// ```
+/// use aevum_ffi::util::from_bson_buffers;
+///
+/// let doc: [u8; 5] = [5, 0, 0, 0, 0];
+/// let ptrs = [doc.as_ptr()];
+/// let lens = [doc.len() as u32];
+/// let slices = unsafe { from_bson_buffers(ptrs.as_ptr(), lens.as_ptr(), 1) };
+/// assert_eq!(slices, vec![&doc[..]]);
+/// ```
+pub unsafe fn from_bson_buffers<'a>(
+    docs: *const *const u8,
+    lens: *const u32,
+    count: usize,
+) -> Vec<&'a [u8]> {
+    if docs.is_null() || lens.is_null() || count == 0 {
+        return Vec::new();
+    }
+
+    // SAFETY: The caller guarantees both arrays hold at least `count` elements.
+    let (ptrs, sizes) = unsafe {
+        (std::slice::from_raw_parts(docs, count), std::slice::from_raw_parts(lens, count))
+    };
+
+    ptrs.iter()
+        .zip(sizes)
+        .map(|(&ptr, &len)| {
+            if ptr.is_null() {
+                &[][..]
+            } else {
+                // SAFETY: The caller guarantees `ptr` addresses `len` readable bytes for `'a`.
+                unsafe { std::slice::from_raw_parts(ptr, len as usize) }
+            }
+        })
+        .collect()
+}
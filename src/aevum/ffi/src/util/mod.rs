@@ -20,6 +20,9 @@
 //! - **`from_c_str`**: Provides a function to safely convert a C-style string pointer (`*const c_char`)
 //!   into an owned Rust `String`, with robust handling of null pointers and potential UTF-8 errors.
 //!
+//! - **`from_bson_buffers`**: Provides a function to borrow a C-side array of `(pointer, length)`
+//!   BSON buffers as Rust byte slices, enabling the zero-copy query path.
+//!
 //! - **`rust_free_string`**: Exposes a C-callable function that allows the foreign code to return
 //!   ownership of a Rust-allocated string back to Rust for proper deallocation, thus preventing
 //!   memory leaks.
@@ -35,6 +38,10 @@ pub mod to_c_string;
 /// into an owned Rust `String`, with built-in error handling for nulls and invalid UTF-8.
 pub mod from_c_str;
 
+/// Provides the function `from_bson_buffers` for borrowing a C-side array of BSON document
+/// buffers as Rust byte slices without copying them.
+pub mod from_bson_buffers;
+
 /// Provides the C-callable function `rust_free_string` for deallocating a C-style string that was
 /// previously allocated by this Rust FFI layer, completing the memory management contract.
 pub mod rust_free_string;
@@ -42,6 +49,7 @@ pub mod rust_free_string;
 // Re-export all public functions from the sub-modules. This ergonomic choice allows consumers
 // of the `util` module to access these critical functions directly (e.g., `util::to_c_string`)
 // without needing to reference the specific sub-module in which they are defined.
+pub use from_bson_buffers::from_bson_buffers;
 pub use from_c_str::from_c_str;
 pub use rust_free_string::rust_free_string;
 pub use to_c_string::to_c_string;
@@ -62,3 +62,67 @@ pub unsafe fn from_c_char_ptr(ptr: *mut c_char) -> String {
     unsafe { rust_free_string(ptr) };
     s
 }
+
+/// A test-only utility function that encodes a `serde_json::Value` object into raw BSON bytes,
+/// producing the same binary layout that libbson stores in the C++ primary index.
+///
+/// This helper lets the zero-copy (`*_bson`) FFI tests construct their datasets from readable
+/// JSON literals. Integers that fit in 32 bits are encoded as BSON `int32`, other integers as
+/// `int64`, and all remaining numbers as `double`.
+///
+/// # Arguments
+///
+/// * `doc` - A `serde_json::Value` that must be an object. Nested objects and arrays are encoded
+///   recursively.
+///
+/// # Returns
+///
+/// A `Vec<u8>` containing the complete BSON document, including its length prefix and terminator.
+///
+/// # Panics
+///
+/// Panics if `doc` is not a JSON object, as only documents can be stored at the top level.
+pub fn to_bson_bytes(doc: &serde_json::Value) -> Vec<u8> {
+    fn encode_container(entries: Vec<(String, &serde_json::Value)>) -> Vec<u8> {
+        let mut body = Vec::new();
+        for (key, value) in entries {
+            let (tag, bytes): (u8, Vec<u8>) = match value {
+                serde_json::Value::Null => (0x0A, Vec::new()),
+                serde_json::Value::Bool(b) => (0x08, vec![u8::from(*b)]),
+                serde_json::Value::Number(n) => match n.as_i64() {
+                    Some(i) if i32::try_from(i).is_ok() => {
+                        (0x10, (i as i32).to_le_bytes().to_vec())
+                    }
+                    Some(i) => (0x12, i.to_le_bytes().to_vec()),
+                    None => (0x01, n.as_f64().unwrap_or(0.0).to_le_bytes().to_vec()),
+                },
+                serde_json::Value::String(s) => {
+                    let mut out = ((s.len() + 1) as i32).to_le_bytes().to_vec();
+                    out.extend_from_slice(s.as_bytes());
+                    out.push(0);
+                    (0x02, out)
+                }
+                serde_json::Value::Array(items) => (
+                    0x04,
+                    encode_container(
+                        items.iter().enumerate().map(|(i, v)| (i.to_string(), v)).collect(),
+                    ),
+                ),
+                serde_json::Value::Object(map) => {
+                    (0x03, encode_container(map.iter().map(|(k, v)| (k.clone(), v)).collect()))
+                }
+            };
+            body.push(tag);
+            body.extend_from_slice(key.as_bytes());
+            body.push(0);
+            body.extend_from_slice(&bytes);
+        }
+        let mut out = ((body.len() + 5) as i32).to_le_bytes().to_vec();
+        out.extend_from_slice(&body);
+        out.push(0);
+        out
+    }
+
+    let map = doc.as_object().expect("a BSON document must be encoded from a JSON object");
+    encode_container(map.iter().map(|(k, v)| (k.clone(), v)).collect())
+}
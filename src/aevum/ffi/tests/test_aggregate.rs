@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Aggregation Pipelines
+//!
+//! This test suite focuses on the `rust_aggregate_bson` FFI function, verifying that pipelines
+//! over borrowed BSON buffers filter, group, order, paginate, and shape documents, and that
+//! malformed pipelines are reported rather than silently answered.
+
+mod common;
+
+use aevum_ffi::{from_c_str, rust_aggregate_bson, rust_free_aggregate_result, rust_free_string};
+use common::{to_bson_bytes, to_c_char_ptr};
+use libc::c_char;
+use serde_json::{json, Value};
+
+#[test]
+/// Exercises the `rust_aggregate_bson` function across a variety of pipelines.
+///
+/// This test verifies:
+/// 1.  **Grouping**: `$sum`, `$avg`, `$min`, `$max`, and `$count` per group, with the groups in
+///     the order of their first document.
+/// 2.  **Order-Dependent Accumulators**: `$first`, `$last`, and `$push` follow the input order.
+/// 3.  **Filtering and Ordering**: `$match`, `$sort` with a fused `$limit`, `$skip`, `$project`,
+///     and `$count` compose in pipeline order.
+/// 4.  **Compound Keys**: An object `_id` groups on several fields, and a missing key is `null`.
+/// 5.  **Malformed Pipelines**: Invalid JSON and unknown stages or accumulators yield an error.
+fn test_ffi_aggregation_pipelines() {
+    let buffers = vec![
+        to_bson_bytes(&json!({ "_id": "a", "customer": "x", "region": "eu", "total": 10 })),
+        to_bson_bytes(&json!({ "_id": "b", "customer": "y", "region": "us", "total": 25.5 })),
+        to_bson_bytes(&json!({ "_id": "c", "customer": "x", "region": "eu", "total": 5 })),
+        to_bson_bytes(&json!({ "_id": "d", "customer": "z", "region": "eu", "total": 40 })),
+        to_bson_bytes(&json!({ "_id": "e", "customer": "y", "region": "us" })),
+    ];
+    let ptrs: Vec<*const u8> = buffers.iter().map(|b| b.as_ptr()).collect();
+    let lens: Vec<u32> = buffers.iter().map(|b| b.len() as u32).collect();
+
+    let aggregate = |pipeline: &str| -> Result<Value, String> {
+        let c_pipeline = to_c_char_ptr(pipeline);
+        let res =
+            unsafe { rust_aggregate_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_pipeline) };
+        unsafe { rust_free_string(c_pipeline as *mut c_char) };
+        let outcome = if res.error.is_null() {
+            Ok(serde_json::from_str(&from_c_str(res.data)).expect("results must be JSON"))
+        } else {
+            Err(from_c_str(res.error))
+        };
+        unsafe { rust_free_aggregate_result(res) };
+        outcome
+    };
+
+    // Scenario 1: Numeric accumulators per customer.
+    let totals = aggregate(
+        r#"[{"$group": {"_id": "$customer", "sum": {"$sum": "$total"}, "avg": {"$avg": "$total"},
+            "min": {"$min": "$total"}, "max": {"$max": "$total"}, "n": {"$count": {}}}}]"#,
+    );
+    assert_eq!(
+        totals.unwrap(),
+        json!([
+            { "_id": "x", "sum": 15, "avg": 7.5, "min": 5, "max": 10, "n": 2 },
+            { "_id": "y", "sum": 25.5, "avg": 25.5, "min": 25.5, "max": 25.5, "n": 2 },
+            { "_id": "z", "sum": 40, "avg": 40.0, "min": 40, "max": 40, "n": 1 }
+        ])
+    );
+
+    // Scenario 2: Order-dependent accumulators.
+    let ordered = aggregate(
+        r#"[{"$group": {"_id": "$region", "first": {"$first": "$_id"}, "last": {"$last": "$_id"},
+            "ids": {"$push": "$_id"}}}]"#,
+    );
+    assert_eq!(
+        ordered.unwrap(),
+        json!([
+            { "_id": "eu", "first": "a", "last": "d", "ids": ["a", "c", "d"] },
+            { "_id": "us", "first": "b", "last": "e", "ids": ["b", "e"] }
+        ])
+    );
+
+    // Scenario 3: Stages compose in order.
+    let top = aggregate(
+        r#"[{"$match": {"region": "eu"}}, {"$sort": {"total": -1}}, {"$limit": 2},
+            {"$project": {"total": 1, "_id": 0}}]"#,
+    );
+    assert_eq!(top.unwrap(), json!([{ "total": 40 }, { "total": 10 }]));
+    let rest = aggregate(r#"[{"$sort": {"total": 1}}, {"$skip": 3}, {"$count": "n"}]"#);
+    assert_eq!(rest.unwrap(), json!([{ "n": 2 }]));
+    let none = aggregate(r#"[{"$match": {"region": "apac"}}, {"$count": "n"}]"#);
+    assert_eq!(none.unwrap(), json!([]));
+
+    // Scenario 4: Compound keys, with a missing field left out of the key.
+    let compound = aggregate(
+        r#"[{"$match": {"customer": "y"}},
+            {"$group": {"_id": {"c": "$customer", "t": "$total"}, "n": {"$sum": 1}}}]"#,
+    );
+    assert_eq!(
+        compound.unwrap(),
+        json!([{ "_id": { "c": "y", "t": 25.5 }, "n": 1 }, { "_id": { "c": "y" }, "n": 1 }])
+    );
+    let everything = aggregate(r#"[{"$group": {"_id": null, "n": {"$sum": 1}}}]"#);
+    assert_eq!(everything.unwrap(), json!([{ "_id": null, "n": 5 }]));
+
+    // Scenario 5: Malformed pipelines are rejected with a message.
+    assert!(aggregate(r#"[{"$match": "#).is_err(), "Invalid JSON must be rejected.");
+    assert!(aggregate(r#"{"$match": {}}"#).is_err(), "A pipeline must be an array.");
+    assert!(aggregate(r#"[{"$lookup": {}}]"#).unwrap_err().contains("$lookup"));
+    assert!(aggregate(r#"[{"$group": {"_id": 1, "m": {"$median": "$total"}}}]"#).is_err());
+    assert!(aggregate(r#"[{"$limit": 0}]"#).is_err(), "A zero limit must be rejected.");
+}
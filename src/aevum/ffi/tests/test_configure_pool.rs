@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Engine Thread Pool Configuration
+//!
+//! This test suite focuses on the `rust_configure_pool` and `rust_set_pool_node` FFI functions,
+//! verifying that the engine's pools can be built once, before any query, and that queries return
+//! the same results whichever node pool runs them. Each integration test file is its own process,
+//! so the global pool configured here does not leak into the other suites.
+
+mod common;
+
+use aevum_ffi::{rust_configure_pool, rust_count, rust_free_string, rust_set_pool_node};
+use common::to_c_char_ptr;
+use libc::c_char;
+
+#[test]
+/// Exercises the configuration of the pools and the selection of a node.
+///
+/// This test verifies:
+/// 1.  **Configuration**: Two node pools, one of them empty, are built over the first CPU.
+/// 2.  **Single Configuration**: A second configuration is refused.
+/// 3.  **Node Selection**: The previous selection is returned, and a query gives the same count
+///     on the local node, on an explicit node, and on an out-of-range node, which wraps around.
+fn test_ffi_pool_configuration() {
+    let prefix = to_c_char_ptr("test-engine");
+    let cpus = [0u32];
+    let node_sizes = [1usize, 0];
+
+    // Scenarios 1 and 2: Configure once, then be refused.
+    let configured =
+        unsafe { rust_configure_pool(2, prefix, cpus.as_ptr(), node_sizes.as_ptr(), 2) };
+    assert_eq!(configured, 1, "The first configuration of the pools should succeed.");
+    let reconfigured =
+        unsafe { rust_configure_pool(2, prefix, cpus.as_ptr(), node_sizes.as_ptr(), 2) };
+    assert_eq!(reconfigured, 0, "The pools should not be configured twice.");
+
+    // Scenario 3: The same query on every selection of a node.
+    let c_data = to_c_char_ptr(r#"[{ "v": 1 }, { "v": 2 }, { "v": 3 }]"#);
+    let c_query = to_c_char_ptr(r#"{ "v": { "$gt": 1 } }"#);
+    let mut selected = -1;
+    for node in [-1, 0, 1, 7] {
+        assert_eq!(
+            rust_set_pool_node(node),
+            selected,
+            "The previous selection should be returned."
+        );
+        selected = node;
+        let count = unsafe { rust_count(c_data, c_query) };
+        assert_eq!(count, 2, "The count should not depend on the node pool (node {node}).");
+    }
+    assert_eq!(rust_set_pool_node(-1), selected, "The last selection should be returned.");
+
+    unsafe {
+        rust_free_string(prefix as *mut c_char);
+        rust_free_string(c_data as *mut c_char);
+        rust_free_string(c_query as *mut c_char);
+    }
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Zero-Copy Document Counting (Count over BSON)
+//!
+//! This test suite focuses on the `rust_count_bson` FFI function, verifying that documents
+//! borrowed as raw BSON buffers are counted with the same semantics as the JSON-based
+//! `rust_count`.
+
+mod common;
+
+use aevum_ffi::{rust_count_bson, rust_free_string};
+use common::{to_bson_bytes, to_c_char_ptr};
+use libc::c_char;
+use serde_json::json;
+
+#[test]
+/// Exercises the `rust_count_bson` function across a variety of query scenarios.
+///
+/// This test verifies:
+/// 1.  **Full Scan**: Every document is counted for an empty query.
+/// 2.  **Targeted Filtering**: Equality on a string field and a relational operator on a
+///     numeric field produce accurate counts.
+/// 3.  **Nested Values**: Documents with embedded objects and arrays decode and are counted.
+/// 4.  **Malformed Query**: An unparsable query yields a zero count.
+fn test_ffi_bson_document_counting() {
+    let buffers = vec![
+        to_bson_bytes(&json!({ "id": 1, "status": "active", "value": 10 })),
+        to_bson_bytes(&json!({ "id": 2, "status": "inactive", "value": 20 })),
+        to_bson_bytes(&json!({ "id": 3, "status": "active", "value": 15, "tags": ["a", "b"] })),
+        to_bson_bytes(&json!({ "id": 4, "status": "pending", "meta": { "owner": "ops" } })),
+    ];
+    let ptrs: Vec<*const u8> = buffers.iter().map(|b| b.as_ptr()).collect();
+    let lens: Vec<u32> = buffers.iter().map(|b| b.len() as u32).collect();
+
+    let count = |query: &str| {
+        let c_query = to_c_char_ptr(query);
+        let n = unsafe { rust_count_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_query) };
+        unsafe { rust_free_string(c_query as *mut c_char) };
+        n
+    };
+
+    // Scenario 1: Count every document.
+    assert_eq!(count("{}"), 4, "The engine should have counted every BSON document.");
+
+    // Scenario 2: Equality and relational filtering.
+    assert_eq!(count(r#"{ "status": "active" }"#), 2);
+    assert_eq!(count(r#"{ "value": { "$gt": 12 } }"#), 2);
+
+    // Scenario 3: Documents with nested structures are decoded and matched.
+    assert_eq!(count(r#"{ "status": "pending" }"#), 1);
+
+    // Scenario 4: A malformed query counts nothing.
+    assert_eq!(count(r#"{ "status": "#), 0, "A malformed query must yield a zero count.");
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Zero-Copy Document Retrieval (Find over BSON)
+//!
+//! This test suite focuses on the `rust_find_bson` FFI function, verifying that the query engine
+//! can filter, sort, and paginate raw BSON buffers borrowed from the caller and report the
+//! positions of the results, with the same semantics as the JSON-based `rust_find`.
+
+mod common;
+
+use aevum_ffi::{rust_find_bson, rust_free_index_result, rust_free_string};
+use common::{to_bson_bytes, to_c_char_ptr};
+use libc::c_char;
+use serde_json::json;
+
+/// Invokes `rust_find_bson` over the given buffers and copies the returned positions into a
+/// `Vec`, releasing the FFI allocation.
+fn find_positions(buffers: &[Vec<u8>], query: &str, sort: &str, limit: i32, skip: i32) -> Vec<u32> {
+    let ptrs: Vec<*const u8> = buffers.iter().map(|b| b.as_ptr()).collect();
+    let lens: Vec<u32> = buffers.iter().map(|b| b.len() as u32).collect();
+    let c_query = to_c_char_ptr(query);
+    let c_sort = to_c_char_ptr(sort);
+
+    let result = unsafe {
+        rust_find_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_query, c_sort, limit, skip)
+    };
+    let positions = if result.indices.is_null() {
+        Vec::new()
+    } else {
+        unsafe { std::slice::from_raw_parts(result.indices, result.len).to_vec() }
+    };
+
+    unsafe {
+        rust_free_index_result(result);
+        rust_free_string(c_query as *mut c_char);
+        rust_free_string(c_sort as *mut c_char);
+    }
+    positions
+}
+
+#[test]
+/// Exercises the `rust_find_bson` function across the core retrieval scenarios.
+///
+/// This test verifies:
+/// 1.  **Filtering**: Only positions of documents matching the query are returned, in their
+///     original order when no sort is given.
+/// 2.  **Sorting and Pagination**: A descending sort combined with `skip` and `limit` yields
+///     the expected window of positions.
+/// 3.  **Type Fidelity**: `int32`, `int64`, `double`, and nested values decode so that relational
+///     operators and string equality behave exactly as on the JSON path.
+/// 4.  **Corruption Tolerance**: A truncated buffer is treated as non-matching rather than
+///     aborting the whole query.
+/// 5.  **Empty Input**: A null dataset yields an empty, null result that is safe to free.
+fn test_ffi_bson_document_retrieval() {
+    let mut buffers = vec![
+        to_bson_bytes(&json!({ "_id": "A1", "name": "Alice", "age": 30, "city": "New York" })),
+        to_bson_bytes(&json!({ "_id": "B2", "name": "Bob", "age": 25, "city": "London" })),
+        to_bson_bytes(&json!({ "_id": "C3", "name": "Charlie", "age": 35, "city": "New York" })),
+        to_bson_bytes(
+            &json!({ "_id": "D4", "name": "David", "age": 5_000_000_000i64, "score": 1.5 }),
+        ),
+    ];
+
+    // Scenario 1: Filter by city with no sort; positions are reported in storage order.
+    assert_eq!(find_positions(&buffers, r#"{ "city": "New York" }"#, "{}", 0, 0), vec![0, 2]);
+
+    // Scenario 2: Sort by age descending, skip the first match and take two.
+    assert_eq!(find_positions(&buffers, "{}", r#"{ "age": -1 }"#, 2, 1), vec![2, 0]);
+
+    // Scenario 3: An int64 and a double participate in relational comparisons.
+    assert_eq!(find_positions(&buffers, r#"{ "age": { "$gt": 100 } }"#, "{}", 0, 0), vec![3]);
+    assert_eq!(find_positions(&buffers, r#"{ "score": { "$lte": 1.5 } }"#, "{}", 0, 0), vec![3]);
+
+    // Scenario 4: A truncated buffer is skipped without affecting the other documents.
+    buffers[1].truncate(10);
+    assert_eq!(find_positions(&buffers, "{}", "{}", 0, 0), vec![0, 2, 3]);
+
+    // Scenario 5: A null dataset produces an empty result.
+    let c_query = to_c_char_ptr("{}");
+    let c_sort = to_c_char_ptr("{}");
+    let empty =
+        unsafe { rust_find_bson(std::ptr::null(), std::ptr::null(), 0, c_query, c_sort, 0, 0) };
+    assert!(empty.indices.is_null(), "An empty dataset must not allocate a result array.");
+    assert_eq!(empty.len, 0);
+    unsafe {
+        rust_free_index_result(empty);
+        rust_free_string(c_query as *mut c_char);
+        rust_free_string(c_sort as *mut c_char);
+    }
+}
+
+#[test]
+/// Verifies that a sorted, paginated find over many documents returns exactly the window a full
+/// stable sort would.
+///
+/// The dataset spans several of the parallel chunks the matcher splits its input into and has
+/// many ties, so this exercises the per-chunk top-K selection, the merge of the chunks'
+/// candidates, and the positional tie-break, for windows at the start, in the middle, and past
+/// the end of the result set.
+fn test_ffi_bson_top_k_matches_full_sort() {
+    let values: Vec<(i64, i64)> = (0..5000).map(|i| ((i * 7919) % 101, i % 3)).collect();
+    let buffers: Vec<Vec<u8>> =
+        values.iter().map(|(v, w)| to_bson_bytes(&json!({ "v": v, "w": w }))).collect();
+
+    // The reference order: `v` descending, then `w` ascending, then storage order, restricted
+    // to the documents the query matches.
+    let mut expected: Vec<u32> =
+        (0..values.len() as u32).filter(|&i| values[i as usize].0 >= 20).collect();
+    expected.sort_by_key(|&i| (-values[i as usize].0, values[i as usize].1));
+
+    let (query, sort) = (r#"{ "v": { "$gte": 20 } }"#, r#"{ "v": -1, "w": 1 }"#);
+    for (limit, skip) in [(0, 0), (1, 0), (25, 0), (25, 40), (10, 2500), (10, 9000)] {
+        let take = if limit == 0 { usize::MAX } else { limit };
+        let window: Vec<u32> = expected.iter().copied().skip(skip).take(take).collect();
+        let actual = find_positions(&buffers, query, sort, limit as i32, skip as i32);
+        assert_eq!(actual, window, "limit {limit}, skip {skip}");
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Lazy JSON Decoding
+//!
+//! This test suite focuses on the JSON entry points (`rust_count`, `rust_find`, `rust_update`, and
+//! `rust_delete`), which decode only the fields a query or sort reads, verifying that a partially
+//! decoded document is evaluated exactly like a fully decoded one.
+
+mod common;
+
+use aevum_ffi::{
+    from_c_str, rust_count, rust_delete, rust_find, rust_free_string, rust_free_update_result,
+    rust_update,
+};
+use common::{from_c_char_ptr, to_c_char_ptr};
+use libc::c_char;
+use serde_json::{json, Value};
+
+#[test]
+/// Exercises the JSON entry points on documents whose unreferenced fields are skipped.
+///
+/// This test verifies:
+/// 1.  **Repeated Keys**: The last occurrence of a repeated field is the one a query sees.
+/// 2.  **Escaped Keys**: A field name written with escapes is recognized as the field it denotes.
+/// 3.  **Sort Fields**: A sort on a field the query does not read still orders by that field, and
+///     the results are returned in full.
+/// 4.  **Non-Object Documents**: Array elements that are not objects never match a field query,
+///     and are still matched by a whole-document query.
+/// 5.  **Verbatim Copies**: Documents left untouched by an update or delete are passed through.
+/// 6.  **Dotted Paths**: A path into an embedded document decodes the top-level field it starts
+///     with.
+fn test_ffi_lazy_json_decoding() {
+    let dataset = r#"[
+        { "k": 1, "nested": { "deep": [1, 2, { "k": 9 }] }, "k": 2, "rank": 3 },
+        { "\u006b": 2, "note": "say \"hi\"", "rank": 1 },
+        { "k": 3, "rank": 2 },
+        7,
+        [ { "k": 2 } ]
+    ]"#;
+    let c_data = to_c_char_ptr(dataset);
+
+    let count = |query: &str| -> i32 {
+        let c_query = to_c_char_ptr(query);
+        let n = unsafe { rust_count(c_data, c_query) };
+        unsafe { rust_free_string(c_query as *mut c_char) };
+        n
+    };
+
+    // Scenario 1 and 2: The repeated and the escaped key both hold 2.
+    assert_eq!(count(r#"{ "k": 2 }"#), 2, "Repeated and escaped keys must decode as usual.");
+    assert_eq!(count(r#"{ "k": 1 }"#), 0, "Only the last occurrence of a key counts.");
+    assert_eq!(count(r#"{ "k": { "$gte": 2 } }"#), 3);
+    assert_eq!(count("{}"), 5, "An empty query counts every element.");
+
+    // Scenario 6: Only `nested` is decoded, in full, for a path into it.
+    assert_eq!(count(r#"{ "nested.deep": { "$all": [2, 1] } }"#), 1);
+    assert_eq!(count(r#"{ "nested.deep.k": 9 }"#), 0, "Paths do not enter arrays.");
+
+    // Scenario 3: Sort on a field the query does not reference.
+    let c_query = to_c_char_ptr(r#"{ "k": { "$gte": 2 } }"#);
+    let c_sort = to_c_char_ptr(r#"{ "rank": 1 }"#);
+    let c_projection = to_c_char_ptr("{}");
+    let ptr = unsafe { rust_find(c_data, c_query, c_sort, c_projection, 2, 0) };
+    let found: Value = serde_json::from_str(&unsafe { from_c_char_ptr(ptr) }).unwrap();
+    assert_eq!(
+        found,
+        json!([
+            { "k": 2, "note": "say \"hi\"", "rank": 1 },
+            { "k": 3, "rank": 2 }
+        ]),
+        "Sorted results must be ordered by the sort field and returned in full."
+    );
+    unsafe {
+        rust_free_string(c_query as *mut c_char);
+        rust_free_string(c_sort as *mut c_char);
+        rust_free_string(c_projection as *mut c_char);
+    }
+
+    // Scenario 4: A whole-document query compares the non-object element.
+    assert_eq!(count("7"), 1, "A whole-document query must see the complete element.");
+
+    // Scenario 5: Untouched documents are copied verbatim.
+    let c_query = to_c_char_ptr(r#"{ "k": 3 }"#);
+    let c_update = to_c_char_ptr(r#"{ "rank": 0 }"#);
+    let c_schema = to_c_char_ptr("{}");
+    let res = unsafe { rust_update(c_data, c_query, c_update, c_schema) };
+    let updated_str = from_c_str(res.data);
+    assert_eq!(res.modified_count, 1);
+    assert!(updated_str.contains(r#"{ "\u006b": 2, "note": "say \"hi\"", "rank": 1 }"#));
+    let updated: Value = serde_json::from_str(&updated_str).unwrap();
+    assert_eq!(updated[2], json!({ "k": 3, "rank": 0 }));
+
+    let ptr = unsafe { rust_delete(c_data, c_query) };
+    let remaining: Value = serde_json::from_str(&unsafe { from_c_char_ptr(ptr) }).unwrap();
+    assert_eq!(remaining.as_array().unwrap().len(), 4);
+    assert_eq!(remaining[3], json!([{ "k": 2 }]));
+
+    unsafe {
+        rust_free_update_result(res);
+        rust_free_string(c_data as *mut c_char);
+        rust_free_string(c_query as *mut c_char);
+        rust_free_string(c_update as *mut c_char);
+        rust_free_string(c_schema as *mut c_char);
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Matcher Conformance Suite
+//!
+//! The C++ core evaluates simple queries natively (`bson/doc/matcher.hpp`) and hands everything
+//! else to `rust_find_bson`, so both engines must agree on what a query matches. The cases in
+//! `conformance/matcher_cases.json` pin those semantics down; this suite checks the Rust engine
+//! against them.
+
+mod common;
+
+use aevum_ffi::{rust_count_bson, rust_find_bson, rust_free_index_result, rust_free_string};
+use common::{to_bson_bytes, to_c_char_ptr};
+use libc::c_char;
+use serde_json::Value;
+
+/// The shared conformance cases.
+const CASES: &str = include_str!("conformance/matcher_cases.json");
+
+#[test]
+/// Runs every conformance case through `rust_find_bson` and `rust_count_bson`.
+///
+/// This test verifies that, for each case, the positions returned by `rust_find_bson` are exactly
+/// the expected ones, in input order, and that `rust_count_bson` counts the same documents.
+fn test_ffi_matcher_conformance() {
+    let suite: Value = serde_json::from_str(CASES).expect("conformance cases must be valid JSON");
+    let cases = suite["cases"].as_array().expect("conformance cases must be an array");
+    assert!(!cases.is_empty());
+
+    for case in cases {
+        let name = case["name"].as_str().unwrap();
+        let buffers: Vec<Vec<u8>> =
+            case["documents"].as_array().unwrap().iter().map(to_bson_bytes).collect();
+        let expected: Vec<u32> = case["matches"]
+            .as_array()
+            .unwrap()
+            .iter()
+            .map(|p| p.as_u64().unwrap() as u32)
+            .collect();
+
+        let ptrs: Vec<*const u8> = buffers.iter().map(|b| b.as_ptr()).collect();
+        let lens: Vec<u32> = buffers.iter().map(|b| b.len() as u32).collect();
+        let c_query = to_c_char_ptr(&case["query"].to_string());
+        let c_sort = to_c_char_ptr("{}");
+
+        let result = unsafe {
+            rust_find_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_query, c_sort, 0, 0)
+        };
+        let positions = if result.indices.is_null() {
+            Vec::new()
+        } else {
+            unsafe { std::slice::from_raw_parts(result.indices, result.len).to_vec() }
+        };
+        let count =
+            unsafe { rust_count_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_query) };
+
+        unsafe {
+            rust_free_index_result(result);
+            rust_free_string(c_query as *mut c_char);
+            rust_free_string(c_sort as *mut c_char);
+        }
+
+        assert_eq!(positions, expected, "case '{}'", name);
+        assert_eq!(count, expected.len() as i32, "case '{}' (count)", name);
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Delta Document Updates
+//!
+//! This test suite focuses on the `rust_update_delta` FFI function, verifying that the update
+//! engine reports exactly the documents it modified, by their position in the input, together with
+//! their post-update images, using the same matching and validation rules as `rust_update`.
+
+mod common;
+
+use aevum_ffi::{from_c_str, rust_free_string, rust_free_update_delta_result, rust_update_delta};
+use common::to_c_char_ptr;
+use libc::c_char;
+use serde_json::{json, Value};
+
+/// Invokes `rust_update_delta` and copies the reported positions and images into owned values,
+/// releasing every FFI allocation.
+fn update_delta(dataset: &str, query: &str, update: &str, schema: &str) -> (Vec<u32>, Value) {
+    let c_dataset = to_c_char_ptr(dataset);
+    let c_query = to_c_char_ptr(query);
+    let c_update = to_c_char_ptr(update);
+    let c_schema = to_c_char_ptr(schema);
+
+    let result = unsafe { rust_update_delta(c_dataset, c_query, c_update, c_schema) };
+    let positions = if result.indices.is_null() {
+        Vec::new()
+    } else {
+        unsafe { std::slice::from_raw_parts(result.indices, result.len).to_vec() }
+    };
+    let images = serde_json::from_str::<Value>(&from_c_str(result.data)).unwrap();
+
+    unsafe {
+        rust_free_update_delta_result(result);
+        rust_free_string(c_dataset as *mut c_char);
+        rust_free_string(c_query as *mut c_char);
+        rust_free_string(c_update as *mut c_char);
+        rust_free_string(c_schema as *mut c_char);
+    }
+    (positions, images)
+}
+
+#[test]
+/// Exercises the `rust_update_delta` function across the core modification scenarios.
+///
+/// This test verifies:
+/// 1.  **Selective Reporting**: Only the modified documents are returned, with positions that
+///     refer back to the input array and images in the same order.
+/// 2.  **Schema Enforcement**: A document whose candidate image fails the schema is omitted.
+/// 3.  **No-Op Update**: A query matching nothing yields no positions and an empty image array.
+/// 4.  **Error Resilience**: A malformed dataset yields an empty result that is safe to free.
+/// 5.  **Operators**: `$set` assigns dotted paths and `$inc` adds to numbers, starting from 0.
+/// 6.  **Invalid Operators**: An unknown operator, or `$inc` of a string, modifies nothing.
+fn test_ffi_document_update_delta() {
+    let dataset = r#"[
+        { "name": "Alice", "age": 30, "status": "active" },
+        { "name": "Bob", "age": 25, "status": "inactive" },
+        { "name": "Charlie", "age": 35, "status": "active" }
+    ]"#;
+
+    // Scenario 1: A bulk update reports the two active users and leaves Bob out.
+    let (positions, images) =
+        update_delta(dataset, r#"{ "status": "active" }"#, r#"{ "status": "archived" }"#, "");
+    assert_eq!(positions, vec![0, 2]);
+    assert_eq!(
+        images,
+        json!([
+            { "name": "Alice", "age": 30, "status": "archived" },
+            { "name": "Charlie", "age": 35, "status": "archived" }
+        ])
+    );
+
+    // Scenario 2: The schema rejects Alice's candidate image (age must stay above 32).
+    let (positions, images) = update_delta(
+        dataset,
+        r#"{ "status": "active" }"#,
+        r#"{ "status": "archived" }"#,
+        r#"{ "age": { "$gt": 32 } }"#,
+    );
+    assert_eq!(positions, vec![2]);
+    assert_eq!(images, json!([{ "name": "Charlie", "age": 35, "status": "archived" }]));
+
+    // Scenario 3: Nothing matches.
+    let (positions, images) =
+        update_delta(dataset, r#"{ "name": "David" }"#, r#"{ "status": "new" }"#, "");
+    assert!(positions.is_empty());
+    assert_eq!(images, json!([]));
+
+    // Scenario 4: A malformed dataset is rejected gracefully.
+    let (positions, images) =
+        update_delta("not json", r#"{ "name": "Alice" }"#, r#"{ "age": 31 }"#, "");
+    assert!(positions.is_empty());
+    assert_eq!(images, json!([]));
+
+    // Scenario 5: Bob's age is incremented, a visit counter is started, and a nested field set.
+    let (positions, images) = update_delta(
+        dataset,
+        r#"{ "name": "Bob" }"#,
+        r#"{ "$inc": { "age": 1, "visits": 1 }, "$set": { "address.city": "Oslo" } }"#,
+        "",
+    );
+    assert_eq!(positions, vec![1]);
+    assert_eq!(
+        images,
+        json!([{
+            "name": "Bob", "age": 26, "status": "inactive", "visits": 1,
+            "address": { "city": "Oslo" }
+        }])
+    );
+
+    // Scenario 6: Invalid operators leave every document as it was.
+    for update in [r#"{ "$push": { "tags": "x" } }"#, r#"{ "$inc": { "name": 1 } }"#] {
+        let (positions, images) = update_delta(dataset, "{}", update, "");
+        assert!(positions.is_empty(), "The update {update} should modify nothing.");
+        assert_eq!(images, json!([]));
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root directory.
+
+//! # Integration Tests for Batched Zero-Copy Validation (Validate over BSON)
+//!
+//! This test suite focuses on the `rust_validate_bson` FFI function, verifying that a batch of
+//! documents borrowed as raw BSON buffers is validated with the same semantics as the JSON-based
+//! `rust_validate`, and that exactly the failing positions are reported.
+
+mod common;
+
+use aevum_ffi::{rust_free_index_result, rust_free_string, rust_validate_bson};
+use common::{to_bson_bytes, to_c_char_ptr};
+use libc::c_char;
+use serde_json::json;
+
+#[test]
+/// Exercises the `rust_validate_bson` function across the core validation scenarios.
+///
+/// This test verifies:
+/// 1.  **Selective Reporting**: Only the documents violating the schema are reported, in
+///     ascending order.
+/// 2.  **Fully Valid Batch**: A batch in which every document passes yields an empty result.
+/// 3.  **Malformed Input**: A corrupt buffer is reported as invalid, and a malformed schema
+///     rejects every document.
+fn test_ffi_bson_batch_validation() {
+    let mut buffers = vec![
+        to_bson_bytes(&json!({ "name": "Alice", "age": 30 })),
+        to_bson_bytes(&json!({ "name": "Bob", "age": 17 })),
+        to_bson_bytes(&json!({ "name": "Charlie", "age": 45 })),
+        to_bson_bytes(&json!({ "name": "Dana" })),
+    ];
+
+    let validate = |buffers: &[Vec<u8>], schema: &str| {
+        let ptrs: Vec<*const u8> = buffers.iter().map(|b| b.as_ptr()).collect();
+        let lens: Vec<u32> = buffers.iter().map(|b| b.len() as u32).collect();
+        let c_schema = to_c_char_ptr(schema);
+        let res =
+            unsafe { rust_validate_bson(ptrs.as_ptr(), lens.as_ptr(), buffers.len(), c_schema) };
+        let positions = if res.indices.is_null() {
+            Vec::new()
+        } else {
+            unsafe { std::slice::from_raw_parts(res.indices, res.len).to_vec() }
+        };
+        unsafe {
+            rust_free_index_result(res);
+            rust_free_string(c_schema as *mut c_char);
+        }
+        positions
+    };
+
+    // Scenario 1: Bob is too young and Dana has no age at all.
+    assert_eq!(validate(&buffers, r#"{ "age": { "$gte": 18 } }"#), vec![1, 3]);
+
+    // Scenario 2: Every document has a string name.
+    assert!(validate(&buffers, r#"{ "name": { "$type": "string" } }"#).is_empty());
+
+    // Scenario 3: A truncated buffer fails, as does every document under a malformed schema.
+    buffers[2].truncate(3);
+    assert_eq!(validate(&buffers, r#"{ "name": { "$type": "string" } }"#), vec![2]);
+    assert_eq!(validate(&buffers, "not json"), vec![0, 1, 2, 3]);
+}
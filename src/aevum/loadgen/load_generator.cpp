@@ -0,0 +1,423 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file load_generator.cpp
+ * @brief Implements `LoadGenerator` and the rendering of its reports.
+ */
+#include "aevum/loadgen/load_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "aevum/bson/builder.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace aevum::loadgen {
+
+namespace {
+
+using LoadClock = std::chrono::steady_clock;
+
+/// The string fields of a generated record.
+constexpr int LOAD_FIELD_COUNT = 10;
+/// The length of each string field.
+constexpr size_t LOAD_FIELD_LENGTH = 100;
+/// The records inserted per `insert_many` by `prepare`.
+constexpr uint64_t LOAD_PRELOAD_BATCH = 500;
+/// The seed of the connections' random engines, combined with their index.
+constexpr uint64_t LOAD_SEED = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Converts seconds into a duration of the steady clock.
+ * @param seconds The seconds.
+ * @return The duration.
+ */
+LoadClock::duration load_seconds(double seconds) {
+    return std::chrono::duration_cast<LoadClock::duration>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+}
+
+/**
+ * @brief Builds a field value of `LOAD_FIELD_LENGTH` letters.
+ * @param rng The random engine of the connection.
+ * @return The value.
+ */
+std::string load_field_value(std::mt19937_64 &rng) {
+    std::string value(LOAD_FIELD_LENGTH, 'a');
+    uint64_t bits = rng();
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (i % 12 == 0) bits = rng();
+        value[i] = static_cast<char>('a' + bits % 26);
+        bits /= 26;
+    }
+    return value;
+}
+
+/**
+ * @brief Builds the JSON of a record.
+ * @param id The `_id`.
+ * @param seq The sequence number, which scans and counts select ranges of.
+ * @param rng The random engine of the connection.
+ * @return The JSON document.
+ */
+std::string load_record_json(std::string_view id, uint64_t seq, std::mt19937_64 &rng) {
+    std::string json = R"({"_id":")" + std::string(id) + R"(","seq":)" + std::to_string(seq);
+    for (int field = 0; field < LOAD_FIELD_COUNT; ++field) {
+        json += R"(,"field)" + std::to_string(field) + R"(":")" + load_field_value(rng) + '"';
+    }
+    json += '}';
+    return json;
+}
+
+/**
+ * @brief Returns the query that selects one preloaded record.
+ * @param key The key of the record.
+ * @return The JSON query on `_id`.
+ */
+std::string load_id_query(uint64_t key) {
+    return R"({"_id":"user)" + std::to_string(key) + R"("})";
+}
+
+/**
+ * @brief Checks whether a response reports an error, as the server and the client's connection
+ * errors both do with a `status` of `"error"`.
+ * @param response The JSON response, compact or as serialized from BSON.
+ * @return `true` for an error response or an empty one.
+ */
+bool is_error_response(std::string_view response) {
+    return response.empty() || response.find(R"("status":"error")") != std::string_view::npos ||
+           response.find(R"("status" : "error")") != std::string_view::npos;
+}
+
+/**
+ * @brief Adds one snapshot into another.
+ * @param into The snapshot that accumulates.
+ * @param from The snapshot to add.
+ */
+void merge_snapshot(aevum::util::metrics::LatencyHistogram::Snapshot &into,
+                    const aevum::util::metrics::LatencyHistogram::Snapshot &from) {
+    into.count += from.count;
+    into.sum_us += from.sum_us;
+    into.max_us = std::max(into.max_us, from.max_us);
+    for (size_t i = 0; i < into.buckets.size(); ++i) into.buckets[i] += from.buckets[i];
+}
+
+/**
+ * @brief Builds the summary of a set of latencies for the JSON report.
+ * @param latency The latencies.
+ * @param errors The failed requests among them.
+ * @param elapsed_sec The measured duration.
+ * @return The document.
+ */
+aevum::bson::doc::Document load_summary(
+    const aevum::util::metrics::LatencyHistogram::Snapshot &latency, uint64_t errors,
+    double elapsed_sec) {
+    double mean = latency.count == 0 ? 0.0
+                                     : static_cast<double>(latency.sum_us) /
+                                           static_cast<double>(latency.count);
+    double throughput = elapsed_sec > 0 ? static_cast<double>(latency.count) / elapsed_sec : 0.0;
+    return aevum::bson::Builder()
+        .append_int64("requests", static_cast<int64_t>(latency.count))
+        .append_int64("errors", static_cast<int64_t>(errors))
+        .append_double("throughput", throughput)
+        .append_double("mean_us", mean)
+        .append_int64("p50_us", static_cast<int64_t>(latency.percentile(0.5)))
+        .append_int64("p90_us", static_cast<int64_t>(latency.percentile(0.9)))
+        .append_int64("p99_us", static_cast<int64_t>(latency.percentile(0.99)))
+        .append_int64("p999_us", static_cast<int64_t>(latency.percentile(0.999)))
+        .append_int64("max_us", static_cast<int64_t>(latency.max_us))
+        .finalize();
+}
+
+/**
+ * @brief Appends one line of the text report.
+ * @param text The report.
+ * @param name The name of the line.
+ * @param latency The latencies.
+ * @param errors The failed requests among them.
+ * @param elapsed_sec The measured duration.
+ */
+void append_report_line(std::string &text, std::string_view name,
+                        const aevum::util::metrics::LatencyHistogram::Snapshot &latency,
+                        uint64_t errors, double elapsed_sec) {
+    char line[192];
+    double throughput = elapsed_sec > 0 ? static_cast<double>(latency.count) / elapsed_sec : 0.0;
+    std::snprintf(line, sizeof(line), "%-9.*s %10llu %8llu %10.1f %9llu %9llu %9llu %9llu %9llu\n",
+                  static_cast<int>(name.size()), name.data(),
+                  static_cast<unsigned long long>(latency.count),
+                  static_cast<unsigned long long>(errors), throughput,
+                  static_cast<unsigned long long>(latency.percentile(0.5)),
+                  static_cast<unsigned long long>(latency.percentile(0.9)),
+                  static_cast<unsigned long long>(latency.percentile(0.99)),
+                  static_cast<unsigned long long>(latency.percentile(0.999)),
+                  static_cast<unsigned long long>(latency.max_us));
+    text += line;
+}
+
+}  // namespace
+
+aevum::util::Status read_replay_log(const std::string &path, std::vector<std::string> &requests) {
+    std::ifstream file(path);
+    if (!file) return aevum::util::Status::NotFound("Cannot open replay log '" + path + "'");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        requests.push_back(std::move(line));
+    }
+    if (requests.empty()) {
+        return aevum::util::Status::InvalidArgument("Replay log '" + path + "' holds no request");
+    }
+    return aevum::util::Status::OK();
+}
+
+std::string format_report_text(const LoadReport &report) {
+    std::string text;
+    char header[192];
+    if (report.target_rate > 0) {
+        std::snprintf(header, sizeof(header), "Target rate %.1f req/s (open loop), ",
+                      report.target_rate);
+    } else {
+        std::snprintf(header, sizeof(header), "Closed loop, ");
+    }
+    text += header;
+    std::snprintf(header, sizeof(header), "measured for %.1f s. Latencies in microseconds.\n\n",
+                  report.elapsed_sec);
+    text += header;
+    text += "operation   requests   errors      req/s       p50       p90       p99     p99.9"
+            "       max\n";
+    uint64_t errors = 0;
+    for (const auto &operation : report.operations) {
+        append_report_line(text, to_string(operation.operation), operation.latency,
+                           operation.errors, report.elapsed_sec);
+        errors += operation.errors;
+    }
+    append_report_line(text, "total", report.overall, errors, report.elapsed_sec);
+    if (report.unsent > 0) {
+        text += "\n" + std::to_string(report.unsent) +
+                " requests were due but not sent before the run ended; the server did not "
+                "keep up with the target rate.\n";
+    }
+    if (report.failed_connections > 0) {
+        text += "\n" + std::to_string(report.failed_connections) +
+                " connections could not be established.\n";
+    }
+    return text;
+}
+
+std::string format_report_json(const LoadReport &report) {
+    aevum::bson::Builder operations;
+    uint64_t errors = 0;
+    for (const auto &operation : report.operations) {
+        operations.append_document(
+            std::string(to_string(operation.operation)).c_str(),
+            load_summary(operation.latency, operation.errors, report.elapsed_sec));
+        errors += operation.errors;
+    }
+    auto document =
+        aevum::bson::Builder()
+            .append_double("target_rate", report.target_rate)
+            .append_double("elapsed_sec", report.elapsed_sec)
+            .append_int64("failed_connections", static_cast<int64_t>(report.failed_connections))
+            .append_int64("unsent", static_cast<int64_t>(report.unsent))
+            .append_document("operations", operations.finalize())
+            .append_document("total", load_summary(report.overall, errors, report.elapsed_sec))
+            .finalize();
+    return aevum::bson::json::to_string(document);
+}
+
+LoadGenerator::LoadGenerator(LoadOptions options) : options_(std::move(options)) {
+    options_.connections = std::max<size_t>(options_.connections, 1);
+    options_.records = std::max<uint64_t>(options_.records, 1);
+    options_.max_scan_length = std::max<int64_t>(options_.max_scan_length, 1);
+}
+
+/**
+ * @brief Reads the replay log, or checks that the server answers and preloads the records.
+ * @details The records are inserted without waiting for the journal, in batches of
+ * `LOAD_PRELOAD_BATCH`, followed by an ordered index on `seq` for the scans and counts.
+ */
+aevum::util::Status LoadGenerator::prepare() {
+    if (!options_.replay_path.empty()) return read_replay_log(options_.replay_path, replay_);
+
+    aevum::client::AevumClient client(options_.host, options_.port, options_.api_key);
+    if (!client.connect()) {
+        return aevum::util::Status::IOError("Cannot connect to " + options_.host + ":" +
+                                            std::to_string(options_.port));
+    }
+    if (!options_.preload) return aevum::util::Status::OK();
+
+    std::mt19937_64 rng(LOAD_SEED);
+    for (uint64_t first = 0; first < options_.records; first += LOAD_PRELOAD_BATCH) {
+        std::string batch = "[";
+        uint64_t last = std::min(options_.records, first + LOAD_PRELOAD_BATCH);
+        for (uint64_t key = first; key < last; ++key) {
+            if (key > first) batch += ',';
+            batch += load_record_json("user" + std::to_string(key), key, rng);
+        }
+        batch += ']';
+        std::string response = client.insert_many(options_.collection, batch, "none");
+        if (is_error_response(response)) {
+            return aevum::util::Status::IOError("Preload failed: " + response);
+        }
+    }
+    std::string response = client.create_index(options_.collection, "seq", "ordered");
+    if (is_error_response(response)) {
+        AEVUM_LOG_WARN("Loadgen: Could not create the index on 'seq': " + response);
+    }
+    AEVUM_LOG_INFO("Loadgen: Preloaded " + std::to_string(options_.records) +
+                   " records into collection '" + options_.collection + "'.");
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Runs the warmup and the measured run.
+ * @details The start time is set only once every connection is established or has failed, so
+ * that connection setup is not charged to the first requests.
+ */
+LoadReport LoadGenerator::run() {
+    std::atomic<size_t> ready{0};
+    std::promise<LoadClock::time_point> start_promise;
+    std::shared_future<LoadClock::time_point> start = start_promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(options_.connections);
+    for (size_t i = 0; i < options_.connections; ++i) {
+        threads.emplace_back(&LoadGenerator::drive, this, i, std::ref(ready), start);
+    }
+    while (ready.load() < options_.connections) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    start_promise.set_value(LoadClock::now());
+    for (auto &thread : threads) thread.join();
+
+    LoadReport report;
+    report.target_rate = options_.rate;
+    report.elapsed_sec = options_.duration_sec;
+    report.failed_connections = failed_connections_.load();
+    report.unsent = unsent_.load();
+    for (size_t i = 0; i < LOAD_OPERATION_COUNT; ++i) {
+        OperationReport operation{static_cast<LoadOperation>(i), errors_[i].load(),
+                                  latency_[i].snapshot()};
+        if (operation.latency.count == 0 && operation.errors == 0) continue;
+        merge_snapshot(report.overall, operation.latency);
+        report.operations.push_back(std::move(operation));
+    }
+    return report;
+}
+
+/**
+ * @brief Sends the requests of one connection.
+ * @details In an open loop, request `i` of connection `c` is due at
+ * `start + (i + c / connections) * interval`, where `interval` is `connections / rate`, so the
+ * connections interleave evenly. Each request waits until it is due, unless it is already late,
+ * and its latency runs from that due time. Requests due during the warmup are sent but not
+ * recorded. When the run ends, the requests that were due but not yet sent are counted as
+ * unsent. In a closed loop every request is due when the previous response arrives.
+ */
+void LoadGenerator::drive(size_t index, std::atomic<size_t> &ready,
+                          std::shared_future<LoadClock::time_point> start_future) {
+    aevum::client::AevumClient client(options_.host, options_.port, options_.api_key);
+    bool connected = client.connect();
+    if (connected && options_.bson && !client.use_bson_protocol()) {
+        AEVUM_LOG_WARN("Loadgen: The server refused the BSON protocol; connection " +
+                       std::to_string(index) + " speaks JSON.");
+    }
+    ready.fetch_add(1);
+    const LoadClock::time_point start = start_future.get();
+    if (!connected) {
+        failed_connections_.fetch_add(1);
+        return;
+    }
+
+    std::mt19937_64 rng(LOAD_SEED ^ (index + 1));
+    const LoadClock::time_point measured_from = start + load_seconds(options_.warmup_sec);
+    const LoadClock::time_point end = measured_from + load_seconds(options_.duration_sec);
+    const bool open_loop = options_.rate > 0;
+    const auto interval = open_loop ? load_seconds(static_cast<double>(options_.connections) /
+                                                   options_.rate)
+                                    : LoadClock::duration::zero();
+    const LoadClock::time_point first_due =
+        start + interval * static_cast<LoadClock::rep>(index) /
+                    static_cast<LoadClock::rep>(options_.connections);
+
+    for (uint64_t sequence = 0;; ++sequence) {
+        LoadClock::time_point now = LoadClock::now();
+        LoadClock::time_point due =
+            open_loop ? first_due + interval * static_cast<LoadClock::rep>(sequence) : now;
+        if (due >= end) break;
+        if (now >= end) {
+            uint64_t unsent = 0;
+            for (; due < end; due += interval) {
+                if (due >= measured_from) ++unsent;
+            }
+            unsent_.fetch_add(unsent);
+            break;
+        }
+        if (due > now) std::this_thread::sleep_until(due);
+
+        LoadOperation operation = replay_.empty() ? choose(rng) : LoadOperation::REPLAY;
+        std::string response = send(client, operation, index, sequence, rng);
+        if (due < measured_from) continue;
+        auto latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(LoadClock::now() - due);
+        latency_[static_cast<size_t>(operation)].record(static_cast<uint64_t>(latency.count()));
+        if (is_error_response(response)) errors_[static_cast<size_t>(operation)].fetch_add(1);
+    }
+}
+
+std::string LoadGenerator::send(aevum::client::AevumClient &client, LoadOperation operation,
+                                size_t index, uint64_t sequence, std::mt19937_64 &rng) {
+    std::uniform_int_distribution<uint64_t> key_of(0, options_.records - 1);
+    std::uniform_int_distribution<int64_t> length_of(1, options_.max_scan_length);
+    switch (operation) {
+        case LoadOperation::READ:
+            return client.find(options_.collection, load_id_query(key_of(rng)));
+        case LoadOperation::UPDATE: {
+            std::string update = R"({"$set":{"field)" + std::to_string(rng() % LOAD_FIELD_COUNT) +
+                                 R"(":")" + load_field_value(rng) + R"("}})";
+            return client.update(options_.collection, load_id_query(key_of(rng)), update);
+        }
+        case LoadOperation::INSERT: {
+            // Inserted records follow the preloaded ones in `seq` and never collide in `_id`.
+            uint64_t seq = options_.records + sequence * options_.connections + index;
+            std::string id = "load" + std::to_string(index) + "-" + std::to_string(sequence);
+            return client.insert(options_.collection, load_record_json(id, seq, rng));
+        }
+        case LoadOperation::SCAN: {
+            std::string query = R"({"seq":{"$gte":)" + std::to_string(key_of(rng)) + "}}";
+            return client.find(options_.collection, query, R"({"seq":1})", length_of(rng));
+        }
+        case LoadOperation::COUNT: {
+            uint64_t from = key_of(rng);
+            std::string query = R"({"seq":{"$gte":)" + std::to_string(from) + R"(,"$lt":)" +
+                                std::to_string(from + static_cast<uint64_t>(length_of(rng))) +
+                                "}}";
+            return client.count(options_.collection, query);
+        }
+        case LoadOperation::REPLAY:
+        default:
+            return client.send_request(
+                replay_[next_replay_.fetch_add(1, std::memory_order_relaxed) % replay_.size()]);
+    }
+}
+
+LoadOperation LoadGenerator::choose(std::mt19937_64 &rng) const {
+    double total = 0;
+    for (size_t i = 0; i + 1 < LOAD_OPERATION_COUNT; ++i) total += std::max(options_.mix[i], 0.0);
+    if (total <= 0) return LoadOperation::READ;
+    double draw = std::uniform_real_distribution<double>(0.0, total)(rng);
+    for (size_t i = 0; i + 1 < LOAD_OPERATION_COUNT; ++i) {
+        draw -= std::max(options_.mix[i], 0.0);
+        if (draw < 0) return static_cast<LoadOperation>(i);
+    }
+    return LoadOperation::READ;
+}
+
+}  // namespace aevum::loadgen
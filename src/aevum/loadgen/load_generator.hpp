@@ -0,0 +1,253 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file load_generator.hpp
+ * @brief Declares `LoadGenerator`, the end-to-end load driver behind `aevum_loadgen`.
+ * @details The generator opens a number of `AevumClient` connections to a running server and
+ * sends either a generated mix of reads and writes or a replayed request log. Requests are
+ * scheduled open-loop: every connection sends on a fixed timetable derived from the target
+ * rate, and the latency of a request is measured from the time it was due rather than from the
+ * time it was actually sent. A server that stalls therefore shows the queueing delay its clients
+ * would have seen, instead of hiding it by slowing the load down (coordinated omission).
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/client/aevum_client.hpp"
+#include "aevum/util/metrics/latency_histogram.hpp"
+#include "aevum/util/status.hpp"
+
+/**
+ * @namespace aevum::loadgen
+ * @brief The network load generator `aevum_loadgen`.
+ */
+namespace aevum::loadgen {
+
+/**
+ * @enum LoadOperation
+ * @brief The kinds of requests the generator sends.
+ */
+enum class LoadOperation : uint8_t {
+    /// A `find` of one record by `_id`.
+    READ = 0,
+    /// A `$set` of one field of one record.
+    UPDATE = 1,
+    /// An `insert` of a new record.
+    INSERT = 2,
+    /// A `find` of a short range of records in `seq` order.
+    SCAN = 3,
+    /// A `count` of the records in a range of `seq`.
+    COUNT = 4,
+    /// A request read from a replay log.
+    REPLAY = 5
+};
+
+/// The number of `LoadOperation` enumerators.
+constexpr size_t LOAD_OPERATION_COUNT = 6;
+
+/**
+ * @brief Converts a `LoadOperation` into its name.
+ * @param operation The operation.
+ * @return The lowercase name of the operation (e.g., "read").
+ */
+[[nodiscard]] constexpr std::string_view to_string(LoadOperation operation) noexcept {
+    switch (operation) {
+        case LoadOperation::READ:
+            return "read";
+        case LoadOperation::UPDATE:
+            return "update";
+        case LoadOperation::INSERT:
+            return "insert";
+        case LoadOperation::SCAN:
+            return "scan";
+        case LoadOperation::COUNT:
+            return "count";
+        case LoadOperation::REPLAY:
+        default:
+            return "replay";
+    }
+}
+
+/**
+ * @struct LoadOptions
+ * @brief The configuration of a load run.
+ */
+struct LoadOptions {
+    /// The hostname or IPv4 address of the server.
+    std::string host = "127.0.0.1";
+    /// The port of the server.
+    int port = 55001;
+    /// The API key of every connection.
+    std::string api_key = "root";
+    /// `true` to speak the binary BSON protocol instead of JSON.
+    bool bson = false;
+    /// The number of concurrent connections, each driven by its own thread.
+    size_t connections = 16;
+    /// The total target rate in requests per second, or 0 to send as fast as the server answers
+    /// (closed loop, whose latencies are subject to coordinated omission).
+    double rate = 1000.0;
+    /// The duration of the measured run, in seconds.
+    double duration_sec = 30.0;
+    /// The time before the measured run during which requests are sent but not recorded.
+    double warmup_sec = 5.0;
+    /// The collection of the generated requests.
+    std::string collection = "loadgen";
+    /// The number of records the generated reads, updates, and scans choose from.
+    uint64_t records = 100000;
+    /// `true` to insert the records, and an ordered index on `seq`, before the run.
+    bool preload = false;
+    /// The relative weights of the generated operations, by `LoadOperation`; `REPLAY` is ignored.
+    std::array<double, LOAD_OPERATION_COUNT> mix{0.5, 0.5, 0.0, 0.0, 0.0, 0.0};
+    /// The longest range of a scan.
+    int64_t max_scan_length = 100;
+    /// A replay log to send instead of the generated mix, or empty.
+    std::string replay_path;
+};
+
+/**
+ * @struct OperationReport
+ * @brief The results of one kind of request.
+ */
+struct OperationReport {
+    /// The kind of request.
+    LoadOperation operation;
+    /// The requests whose response was an error, including lost connections.
+    uint64_t errors{0};
+    /// The latencies from the time each request was due until its response arrived.
+    aevum::util::metrics::LatencyHistogram::Snapshot latency;
+};
+
+/**
+ * @struct LoadReport
+ * @brief The results of a load run.
+ */
+struct LoadReport {
+    /// The target rate in requests per second, or 0 for a closed loop.
+    double target_rate{0.0};
+    /// The measured duration, in seconds.
+    double elapsed_sec{0.0};
+    /// The connections that could not be established.
+    uint64_t failed_connections{0};
+    /// The requests that were due during the measured run but not sent before it ended, because
+    /// their connection was still waiting for earlier responses.
+    uint64_t unsent{0};
+    /// The results of every kind of request that was sent.
+    std::vector<OperationReport> operations;
+    /// The latencies of all requests.
+    aevum::util::metrics::LatencyHistogram::Snapshot overall;
+};
+
+/**
+ * @brief Reads a replay log: one JSON request payload per line, as sent by clients in the
+ * framed JSON protocol (e.g., `{"action":"find","auth":"...","collection":"users",...}`).
+ * @details Empty lines and lines starting with `#` are skipped. The payloads are sent verbatim,
+ * including their `auth` field.
+ * @param path The file to read.
+ * @param requests Receives the payloads.
+ * @return `NotFound` if the file cannot be opened and `InvalidArgument` if it holds no request.
+ */
+[[nodiscard]] aevum::util::Status read_replay_log(const std::string &path,
+                                                  std::vector<std::string> &requests);
+
+/**
+ * @brief Renders a report as human-readable text.
+ * @param report The report.
+ * @return The text, one line per operation.
+ */
+[[nodiscard]] std::string format_report_text(const LoadReport &report);
+
+/**
+ * @brief Renders a report as JSON, for storing and comparing runs.
+ * @param report The report.
+ * @return The JSON object.
+ */
+[[nodiscard]] std::string format_report_json(const LoadReport &report);
+
+/**
+ * @class LoadGenerator
+ * @brief Drives a server with open-loop load over many connections.
+ *
+ * @details Each connection sends `rate / connections` requests per second on its own timetable,
+ * offset from the others so that the arrivals are evenly spread. A connection that falls behind
+ * its timetable, because the server answers slower than the rate, sends its overdue requests
+ * back to back and charges their waiting time to their latency.
+ */
+class LoadGenerator {
+  public:
+    /**
+     * @brief Constructs a generator.
+     * @param options The configuration of the run.
+     */
+    explicit LoadGenerator(LoadOptions options);
+
+    /**
+     * @brief Prepares the run: reads the replay log, or inserts the records if `preload` is set.
+     * @return An error if the log cannot be read or the server cannot be reached.
+     */
+    [[nodiscard]] aevum::util::Status prepare();
+
+    /**
+     * @brief Runs the warmup and the measured run and returns their results.
+     * @return The report of the measured run.
+     */
+    [[nodiscard]] LoadReport run();
+
+  private:
+    /**
+     * @brief The body of a connection's thread: connects, reports itself ready, and sends its
+     * requests from the common start time until the end of the run.
+     * @param index The index of the connection.
+     * @param ready Counts the connections that are ready to start.
+     * @param start When the warmup begins; set once every connection is ready.
+     */
+    void drive(size_t index, std::atomic<size_t> &ready,
+               std::shared_future<std::chrono::steady_clock::time_point> start);
+
+    /**
+     * @brief Sends one request.
+     * @param client The connection.
+     * @param operation The kind of request.
+     * @param index The index of the connection, for unique `_id`s of inserts.
+     * @param sequence The number of requests the connection sent before.
+     * @param rng The random engine of the connection.
+     * @return The response.
+     */
+    [[nodiscard]] std::string send(aevum::client::AevumClient &client, LoadOperation operation,
+                                   size_t index, uint64_t sequence, std::mt19937_64 &rng);
+
+    /**
+     * @brief Chooses the kind of the next generated request by the weights of the mix.
+     * @param rng The random engine of the connection.
+     * @return The kind of request.
+     */
+    [[nodiscard]] LoadOperation choose(std::mt19937_64 &rng) const;
+
+    /// The configuration.
+    LoadOptions options_;
+    /// The payloads of the replay log; empty for generated load.
+    std::vector<std::string> replay_;
+    /// The position of the next replayed payload, shared by the connections.
+    std::atomic<uint64_t> next_replay_{0};
+    /// The latencies of the measured requests, by `LoadOperation`.
+    std::array<aevum::util::metrics::LatencyHistogram, LOAD_OPERATION_COUNT> latency_;
+    /// The failed measured requests, by `LoadOperation`.
+    std::array<std::atomic<uint64_t>, LOAD_OPERATION_COUNT> errors_{};
+    /// The connections that could not be established.
+    std::atomic<uint64_t> failed_connections_{0};
+    /// The requests due during the measured run that were never sent.
+    std::atomic<uint64_t> unsent_{0};
+};
+
+}  // namespace aevum::loadgen
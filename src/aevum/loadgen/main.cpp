@@ -0,0 +1,180 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file main.cpp
+ * @brief Implements the entry point of `aevum_loadgen`, the network load generator.
+ * @details The tool drives a running AevumDB daemon over many connections at a fixed target
+ * rate, then prints the throughput and latency percentiles of every kind of request, as text or
+ * as JSON.
+ */
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "aevum/loadgen/load_generator.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace {
+
+/**
+ * @brief Prints the usage of the tool.
+ * @param program The name the tool was started with.
+ */
+void print_usage(const char *program) {
+    std::cout
+        << "AevumDB Load Generator\n\n"
+        << "Usage: " << program << " [options]\n\n"
+        << "Connection:\n"
+        << "  --host <host>        : Daemon hostname or IP (default: 127.0.0.1)\n"
+        << "  --port <port>        : Daemon port (default: 55001)\n"
+        << "  --key <api_key>      : API key of every connection (default: 'root')\n"
+        << "  --bson               : Speak the binary BSON protocol instead of JSON\n"
+        << "  --connections <n>    : Concurrent connections (default: 16)\n\n"
+        << "Schedule:\n"
+        << "  --rate <req/s>       : Total target rate; 0 sends as fast as possible, which\n"
+        << "                         hides queueing delay (default: 1000)\n"
+        << "  --duration <sec>     : Length of the measured run (default: 30)\n"
+        << "  --warmup <sec>       : Unrecorded load before the measured run (default: 5)\n\n"
+        << "Workload:\n"
+        << "  --collection <name>  : Target collection (default: loadgen)\n"
+        << "  --records <n>        : Records the requests choose from (default: 100000)\n"
+        << "  --preload            : Insert the records and an index on 'seq' first\n"
+        << "  --mix <weights>      : Weights of the operations, e.g.\n"
+        << "                         read=0.5,update=0.3,insert=0.1,scan=0.05,count=0.05\n"
+        << "                         (default: read=0.5,update=0.5)\n"
+        << "  --scan-length <n>    : Longest range of a scan or count (default: 100)\n"
+        << "  --replay <file>      : Send the JSON request payloads of a file, one per line,\n"
+        << "                         instead of the generated mix\n\n"
+        << "Output:\n"
+        << "  --json               : Print the report as JSON\n"
+        << "  --help               : Display this message\n";
+}
+
+/**
+ * @brief Parses the `--mix` weights into the options.
+ * @param text The comma-separated `operation=weight` pairs.
+ * @param options The options to update; operations not named get a weight of 0.
+ * @throws std::invalid_argument If an operation is unknown or a weight is not a number.
+ */
+void parse_mix(const std::string &text, aevum::loadgen::LoadOptions &options) {
+    options.mix.fill(0.0);
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find(',', begin);
+        if (end == std::string::npos) end = text.size();
+        std::string entry = text.substr(begin, end - begin);
+        size_t eq = entry.find('=');
+        if (eq == std::string::npos) throw std::invalid_argument("expected operation=weight");
+        std::string name = entry.substr(0, eq);
+        bool known = false;
+        for (size_t i = 0; i + 1 < aevum::loadgen::LOAD_OPERATION_COUNT; ++i) {
+            if (aevum::loadgen::to_string(static_cast<aevum::loadgen::LoadOperation>(i)) == name) {
+                options.mix[i] = std::stod(entry.substr(eq + 1));
+                known = true;
+            }
+        }
+        if (!known) throw std::invalid_argument("unknown operation '" + name + "'");
+        begin = end + 1;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief The entry point of the load generator.
+ * @param argc The count of command-line arguments.
+ * @param argv The command-line arguments.
+ * @return `0` after a run, `1` if the arguments are invalid or the run cannot be prepared.
+ */
+int main(int argc, char *argv[]) {
+    aevum::loadgen::LoadOptions options;
+    bool json = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::invalid_argument(arg + " requires a value");
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                return 0;
+            } else if (arg == "--host") {
+                options.host = value();
+            } else if (arg == "--port") {
+                options.port = std::stoi(value());
+                if (options.port < 1 || options.port > 65535) {
+                    throw std::out_of_range("port must be between 1 and 65535");
+                }
+            } else if (arg == "--key") {
+                options.api_key = value();
+            } else if (arg == "--bson") {
+                options.bson = true;
+            } else if (arg == "--connections") {
+                int connections = std::stoi(value());
+                if (connections < 1 || connections > 10000) {
+                    throw std::out_of_range("connections must be between 1 and 10000");
+                }
+                options.connections = static_cast<size_t>(connections);
+            } else if (arg == "--rate") {
+                options.rate = std::stod(value());
+                if (options.rate < 0) throw std::out_of_range("rate must not be negative");
+            } else if (arg == "--duration") {
+                options.duration_sec = std::stod(value());
+                if (options.duration_sec <= 0) throw std::out_of_range("duration must be positive");
+            } else if (arg == "--warmup") {
+                options.warmup_sec = std::stod(value());
+                if (options.warmup_sec < 0) throw std::out_of_range("warmup must not be negative");
+            } else if (arg == "--collection") {
+                options.collection = value();
+            } else if (arg == "--records") {
+                long long records = std::stoll(value());
+                if (records < 1) throw std::out_of_range("records must be positive");
+                options.records = static_cast<uint64_t>(records);
+            } else if (arg == "--preload") {
+                options.preload = true;
+            } else if (arg == "--mix") {
+                parse_mix(value(), options);
+            } else if (arg == "--scan-length") {
+                options.max_scan_length = std::stoll(value());
+                if (options.max_scan_length < 1) {
+                    throw std::out_of_range("scan length must be positive");
+                }
+            } else if (arg == "--replay") {
+                options.replay_path = value();
+            } else if (arg == "--json") {
+                json = true;
+            } else {
+                throw std::invalid_argument("unknown option '" + arg + "'");
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << ". Use --help for usage.\n";
+        return 1;
+    }
+
+    // Per-connection warnings are still shown; progress messages would interleave with the
+    // report.
+    aevum::util::log::Logger::set_level(aevum::util::log::LogLevel::WARN);
+
+    aevum::loadgen::LoadGenerator generator(options);
+    aevum::util::Status status = generator.prepare();
+    if (!status.ok()) {
+        std::cerr << "Error: " << status.to_string() << "\n";
+        return 1;
+    }
+    if (!json) {
+        std::cerr << "Running " << options.warmup_sec << " s of warmup and " << options.duration_sec
+                  << " s of load over " << options.connections << " connections...\n";
+    }
+    aevum::loadgen::LoadReport report = generator.run();
+    if (json) {
+        std::cout << aevum::loadgen::format_report_json(report) << "\n";
+    } else {
+        std::cout << aevum::loadgen::format_report_text(report);
+    }
+    return 0;
+}
@@ -13,18 +13,24 @@
  * sequence across all active subsystems.
  */
 #include <atomic>
+#include <chrono>
 #include <csignal>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <pthread.h>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <tuple>
+#include <utility>
 
 #include "aevum/client/net/server.hpp"
 #include "aevum/db/core/core.hpp"
 #include "aevum/util/log/logger.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
 
 /**
  * @namespace aevum::daemon
@@ -32,10 +38,154 @@
  */
 namespace aevum::daemon {
 
+/**
+ * @brief Removes leading and trailing spaces and tabs from a string.
+ * @param text The string to trim.
+ * @return The trimmed string, which is empty if `text` holds only whitespace.
+ */
+std::string trim(const std::string &text) {
+    size_t start = text.find_first_not_of(" \t");
+    size_t end = text.find_last_not_of(" \t");
+    if (start == std::string::npos || end == std::string::npos) return "";
+    return text.substr(start, end - start + 1);
+}
+
+/**
+ * @brief Returns the trimmed value that follows a key on a config file line.
+ * @param line The line containing the key.
+ * @param key The key, including its trailing colon.
+ * @return The value with surrounding whitespace removed, or an empty string if there is none.
+ */
+std::string config_value(const std::string &line, const std::string &key) {
+    return trim(line.substr(line.find(key) + key.size()));
+}
+
+/**
+ * @brief Returns the integer value that follows a key on a config file line.
+ * @param line The line containing the key.
+ * @param key The key, including its trailing colon.
+ * @param min The smallest accepted value.
+ * @param max The largest accepted value.
+ * @return The parsed value.
+ * @throws std::invalid_argument if the value is not a number.
+ * @throws std::out_of_range if the value lies outside `[min, max]`.
+ */
+long long config_number(const std::string &line, const std::string &key, long long min,
+                        long long max) {
+    long long value = std::stoll(config_value(line, key));
+    if (value < min || value > max) {
+        throw std::out_of_range(key + " must be between " + std::to_string(min) + " and " +
+                                std::to_string(max));
+    }
+    return value;
+}
+
+/**
+ * @brief Parses a leaf page size in kilobytes, which WiredTiger requires to be a multiple of 4.
+ * @param text The size to parse.
+ * @param key The config key the size belongs to, for error messages.
+ * @return The parsed size.
+ */
+uint32_t parse_leaf_page_kb(const std::string &text, const std::string &key) {
+    long long kb = std::stoll(text);
+    if (kb < 4 || kb > 524288 || kb % 4 != 0) {
+        throw std::out_of_range(key + " must be a multiple of 4 between 4 and 524288");
+    }
+    return static_cast<uint32_t>(kb);
+}
+
+/**
+ * @brief Parses a `host:port` address.
+ * @param text The address to parse.
+ * @param key The config key the address belongs to, for error messages.
+ * @return The host and the port.
+ * @throws std::invalid_argument if the address has no host or port.
+ * @throws std::out_of_range if the port lies outside `[1, 65535]`.
+ */
+std::pair<std::string, int> parse_host_port(const std::string &text, const std::string &key) {
+    std::string address = trim(text);
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+        throw std::invalid_argument(key + " must be host:port");
+    }
+    int port = std::stoi(address.substr(colon + 1));
+    if (port < 1 || port > 65535) {
+        throw std::out_of_range(key + " port must be between 1 and 65535");
+    }
+    return {address.substr(0, colon), port};
+}
+
+/**
+ * @brief Parses a `collection=timeField[:metaField[:bucketSpan]]` time-series collection entry.
+ * @param entry The entry to parse.
+ * @param options Receives the collection's options.
+ * @return The name of the collection.
+ * @throws std::invalid_argument if the entry has no collection or time field.
+ * @throws std::out_of_range if the bucket span is not positive.
+ */
+std::string parse_time_series(const std::string &entry,
+                              aevum::db::timeseries::TimeSeriesOptions &options) {
+    size_t eq = entry.find('=');
+    std::string coll = eq == std::string::npos ? "" : trim(entry.substr(0, eq));
+    std::stringstream parts(eq == std::string::npos ? "" : entry.substr(eq + 1));
+    std::string part;
+    if (coll.empty() || !std::getline(parts, part, ':') || trim(part).empty()) {
+        throw std::invalid_argument(
+            "timeSeriesCollections entries must be collection=timeField[:metaField[:bucketSpan]]");
+    }
+    options.time_field = trim(part);
+    if (std::getline(parts, part, ':')) options.meta_field = trim(part);
+    if (std::getline(parts, part, ':')) {
+        options.bucket_span = std::stoll(part);
+        if (options.bucket_span < 1) {
+            throw std::out_of_range("timeSeriesCollections bucket spans must be positive");
+        }
+    }
+    return coll;
+}
+
 /**
  * @brief A simple helper to parse basic key-value pairs from the config file.
+ * @details Besides `dbPath` and `port`, `lazyLoad` and `requireSessions` (`true`/`false`),
+ * `memoryBudgetMB` (0 for no limit) with `memoryCheckIntervalMs`, `indexImages`
+ * (`true`/`false`) with `indexImageIntervalSec` (0 writes images at shutdown only),
+ * `loadThreads` and `scanThreads` (0 for one per hardware thread), the query engine's
+ * `engineThreads` (0 for one per hardware thread), `engineThreadPrefix` (at most 8
+ * characters), and `engineNumaPools` (`true`/`false`), `cursorTimeoutSec` (0 for no timeout),
+ * `slowOpThresholdMs` (0 profiles every operation, -1 none), `profileEntries`, and the TTL
+ * sweeper's `ttlSweepIntervalSec` (0 disables it), `ttlBatchSize`, and `ttlBatchPauseMs`,
+ * `changeLogCapacity` (0 records no changes), the limits of one transaction's staged writes
+ * `transactionMaxWrites` and `transactionMaxMB`, and `idFormat` (`uuid4`/`uuid7`/`objectid`) with
+ * `collectionIdFormat`, a comma-separated list of `collection=format` overrides, are read into
+ * `options` and the following storage keys into `options.storage`: `journal` (`true`/`false`),
+ * `durability` (`none`/`journal`/`fsync`), `groupCommitWindowUs` (microseconds), `cacheSizeMB`,
+ * `evictionThreads`, `evictionTarget` (percent), `blockCompressor` (`none`/`snappy`/`zstd`),
+ * `leafPageMaxKB`, `collectionLeafPageMaxKB`, a comma-separated list of `collection=kilobytes`
+ * overrides, `collectionKeyFormat`, a comma-separated list of `collection=string|int64` entries,
+ * and `fieldDictionary` (`true`/`false`). `timeSeriesCollections`, a comma-separated list of
+ * `collection=timeField[:metaField[:bucketSpan]]` entries, is read into
+ * `options.time_series_collections`. The connection limits `maxConnections`,
+ * `maxConnectionsPerIp`, `idleTimeoutSec`, and `requestTimeoutSec` and the thread counts
+ * `ioThreads` and `workerThreads` (0 for the hardware-derived default) are read into `network`, as
+ * are `pinWorkerThreads` (`true`/`false`), the admission limits `maxPointRequests`,
+ * `maxScanRequests`, `maxAdminRequests`, and `maxQueuedRequests` (0 for the defaults derived from
+ * the worker count), `resultCacheMB` (0 disables the query result cache), `metricsPort` (0
+ * disables the Prometheus endpoint), `ioBackend` (`epoll`/`io_uring`),
+ * `zeroCopyThresholdKB` (0 disables `MSG_ZEROCOPY`), and the wire compression settings
+ * `wireCompression` (`true`/`false`), `wireCompressionMinBytes`, `wireCompressionLevel`, and
+ * `wireCompressionDictionary` (the path of a zstd dictionary). `replicaOf` (`host:port` of the
+ * primary) makes the server a read replica; `replicaAuth`, `replicaBatchSize`,
+ * `replicaPollWaitMs`, and `replicaApplyThreads` (0 for one per hardware thread) are read into
+ * `replication` with it.
+ * `shards` (a comma-separated list of `host:port`) makes the server a shard router; `shardKeys`
+ * (a comma-separated list of `collection=field`), `shardAuth`, and `shardConnections` are read
+ * into `sharding` with it.
  */
-void parse_config(const std::string &config_path, std::string &data_path, int &port) {
+void parse_config(const std::string &config_path, std::string &data_path, int &port,
+                  aevum::db::CoreOptions &options,
+                  aevum::net::server::ConnectionPoolConfig &network,
+                  aevum::net::server::ReplicationConfig &replication,
+                  aevum::net::server::ShardingConfig &sharding) {
     std::ifstream config_file(config_path);
     if (!config_file.is_open()) {
         throw std::runtime_error("Could not open configuration file: " + config_path);
@@ -69,6 +219,272 @@ void parse_config(const std::string &config_path, std::string &data_path, int &p
                 }
                 port = parsed_port;
             }
+        } else if (line.find("lazyLoad:") != std::string::npos) {
+            std::string value = config_value(line, "lazyLoad:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("lazyLoad must be true or false");
+            }
+            options.lazy_load = value == "true";
+        } else if (line.find("requireSessions:") != std::string::npos) {
+            std::string value = config_value(line, "requireSessions:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("requireSessions must be true or false");
+            }
+            options.require_sessions = value == "true";
+        } else if (line.find("memoryBudgetMB:") != std::string::npos) {
+            options.memory_budget_mb =
+                static_cast<size_t>(config_number(line, "memoryBudgetMB:", 0, 16777216));
+        } else if (line.find("memoryCheckIntervalMs:") != std::string::npos) {
+            options.memory_check_interval_ms =
+                config_number(line, "memoryCheckIntervalMs:", 10, 3600000);
+        } else if (line.find("indexImages:") != std::string::npos) {
+            std::string value = config_value(line, "indexImages:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("indexImages must be true or false");
+            }
+            options.index_images = value == "true";
+        } else if (line.find("indexImageIntervalSec:") != std::string::npos) {
+            options.index_image_interval_sec =
+                config_number(line, "indexImageIntervalSec:", 0, 86400);
+        } else if (line.find("loadThreads:") != std::string::npos) {
+            options.load_threads =
+                static_cast<size_t>(config_number(line, "loadThreads:", 0, 1024));
+        } else if (line.find("scanThreads:") != std::string::npos) {
+            options.scan_threads =
+                static_cast<size_t>(config_number(line, "scanThreads:", 0, 1024));
+        } else if (line.find("engineThreads:") != std::string::npos) {
+            options.engine_threads =
+                static_cast<size_t>(config_number(line, "engineThreads:", 0, 1024));
+        } else if (line.find("engineThreadPrefix:") != std::string::npos) {
+            std::string value = config_value(line, "engineThreadPrefix:");
+            if (value.empty() || value.size() > 8) {
+                throw std::invalid_argument("engineThreadPrefix must have 1 to 8 characters");
+            }
+            options.engine_thread_prefix = value;
+        } else if (line.find("engineNumaPools:") != std::string::npos) {
+            std::string value = config_value(line, "engineNumaPools:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("engineNumaPools must be true or false");
+            }
+            options.engine_numa_pools = value == "true";
+        } else if (line.find("cursorTimeoutSec:") != std::string::npos) {
+            options.cursor_timeout_sec = config_number(line, "cursorTimeoutSec:", 0, 86400);
+        } else if (line.find("slowOpThresholdMs:") != std::string::npos) {
+            options.slow_op_threshold_ms = config_number(line, "slowOpThresholdMs:", -1, 3600000);
+        } else if (line.find("profileEntries:") != std::string::npos) {
+            options.profile_entries =
+                static_cast<size_t>(config_number(line, "profileEntries:", 1, 100000));
+        } else if (line.find("ttlSweepIntervalSec:") != std::string::npos) {
+            options.ttl_sweep_interval_sec = config_number(line, "ttlSweepIntervalSec:", 0, 86400);
+        } else if (line.find("ttlBatchSize:") != std::string::npos) {
+            options.ttl_batch_size =
+                static_cast<size_t>(config_number(line, "ttlBatchSize:", 1, 1000000));
+        } else if (line.find("ttlBatchPauseMs:") != std::string::npos) {
+            options.ttl_batch_pause_ms = config_number(line, "ttlBatchPauseMs:", 0, 60000);
+        } else if (line.find("transactionMaxWrites:") != std::string::npos) {
+            options.transaction_max_writes =
+                static_cast<size_t>(config_number(line, "transactionMaxWrites:", 1, 10000000));
+        } else if (line.find("transactionMaxMB:") != std::string::npos) {
+            options.transaction_max_bytes =
+                static_cast<size_t>(config_number(line, "transactionMaxMB:", 1, 65536)) << 20;
+        } else if (line.find("changeLogCapacity:") != std::string::npos) {
+            options.change_log_capacity = static_cast<size_t>(
+                config_number(line, "changeLogCapacity:", 0, 1000000000));
+        } else if (line.find("collectionIdFormat:") != std::string::npos) {
+            std::stringstream entries(config_value(line, "collectionIdFormat:"));
+            std::string entry;
+            while (std::getline(entries, entry, ',')) {
+                size_t eq = entry.find('=');
+                auto format = eq == std::string::npos
+                                  ? std::nullopt
+                                  : aevum::util::uuid::id_format_from_string(
+                                        trim(entry.substr(eq + 1)));
+                if (!format) {
+                    throw std::invalid_argument(
+                        "collectionIdFormat entries must be collection=uuid4|uuid7|objectid");
+                }
+                options.collection_id_formats[trim(entry.substr(0, eq))] = *format;
+            }
+        } else if (line.find("idFormat:") != std::string::npos) {
+            auto format = aevum::util::uuid::id_format_from_string(config_value(line, "idFormat:"));
+            if (!format) throw std::invalid_argument("idFormat must be uuid4, uuid7 or objectid");
+            options.id_format = *format;
+        } else if (line.find("replicaOf:") != std::string::npos) {
+            std::tie(replication.primary_host, replication.primary_port) =
+                parse_host_port(config_value(line, "replicaOf:"), "replicaOf");
+        } else if (line.find("replicaAuth:") != std::string::npos) {
+            replication.primary_auth = config_value(line, "replicaAuth:");
+        } else if (line.find("replicaBatchSize:") != std::string::npos) {
+            replication.batch_size =
+                static_cast<int>(config_number(line, "replicaBatchSize:", 1, 10000));
+        } else if (line.find("replicaPollWaitMs:") != std::string::npos) {
+            replication.poll_wait_ms =
+                static_cast<int>(config_number(line, "replicaPollWaitMs:", 0, 30000));
+        } else if (line.find("replicaApplyThreads:") != std::string::npos) {
+            replication.apply_threads =
+                static_cast<int>(config_number(line, "replicaApplyThreads:", 0, 1024));
+        } else if (line.find("shards:") != std::string::npos) {
+            std::stringstream list(config_value(line, "shards:"));
+            std::string shard;
+            sharding.shards.clear();
+            while (std::getline(list, shard, ',')) {
+                sharding.shards.push_back(parse_host_port(shard, "shards"));
+            }
+        } else if (line.find("shardKeys:") != std::string::npos) {
+            std::stringstream list(config_value(line, "shardKeys:"));
+            std::string entry;
+            while (std::getline(list, entry, ',')) {
+                size_t equals = entry.find('=');
+                if (equals == std::string::npos || trim(entry.substr(0, equals)).empty() ||
+                    trim(entry.substr(equals + 1)).empty()) {
+                    throw std::invalid_argument("shardKeys entries must be collection=field");
+                }
+                sharding.shard_keys[trim(entry.substr(0, equals))] =
+                    trim(entry.substr(equals + 1));
+            }
+        } else if (line.find("shardAuth:") != std::string::npos) {
+            sharding.shard_auth = config_value(line, "shardAuth:");
+        } else if (line.find("shardConnections:") != std::string::npos) {
+            sharding.connections_per_shard =
+                static_cast<int>(config_number(line, "shardConnections:", 0, 1024));
+        } else if (line.find("maxConnections:") != std::string::npos) {
+            network.max_connections_total =
+                static_cast<int>(config_number(line, "maxConnections:", 1, 1000000));
+        } else if (line.find("maxConnectionsPerIp:") != std::string::npos) {
+            network.max_connections_per_ip =
+                static_cast<int>(config_number(line, "maxConnectionsPerIp:", 1, 1000000));
+        } else if (line.find("idleTimeoutSec:") != std::string::npos) {
+            network.max_idle_timeout_sec =
+                static_cast<int>(config_number(line, "idleTimeoutSec:", 0, 86400));
+        } else if (line.find("requestTimeoutSec:") != std::string::npos) {
+            network.request_timeout_sec =
+                static_cast<int>(config_number(line, "requestTimeoutSec:", 1, 3600));
+        } else if (line.find("ioThreads:") != std::string::npos) {
+            network.io_threads = static_cast<int>(config_number(line, "ioThreads:", 0, 256));
+        } else if (line.find("workerThreads:") != std::string::npos) {
+            network.worker_threads =
+                static_cast<int>(config_number(line, "workerThreads:", 0, 1024));
+        } else if (line.find("pinWorkerThreads:") != std::string::npos) {
+            std::string value = config_value(line, "pinWorkerThreads:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("pinWorkerThreads must be true or false");
+            }
+            network.pin_worker_threads = value == "true";
+        } else if (line.find("maxPointRequests:") != std::string::npos) {
+            network.max_point_requests =
+                static_cast<int>(config_number(line, "maxPointRequests:", 0, 65536));
+        } else if (line.find("maxScanRequests:") != std::string::npos) {
+            network.max_scan_requests =
+                static_cast<int>(config_number(line, "maxScanRequests:", 0, 65536));
+        } else if (line.find("maxAdminRequests:") != std::string::npos) {
+            network.max_admin_requests =
+                static_cast<int>(config_number(line, "maxAdminRequests:", 0, 65536));
+        } else if (line.find("maxQueuedRequests:") != std::string::npos) {
+            network.max_queued_requests =
+                static_cast<int>(config_number(line, "maxQueuedRequests:", 0, 65536));
+        } else if (line.find("resultCacheMB:") != std::string::npos) {
+            network.result_cache_mb =
+                static_cast<int>(config_number(line, "resultCacheMB:", 0, 1048576));
+        } else if (line.find("metricsPort:") != std::string::npos) {
+            network.metrics_port = static_cast<int>(config_number(line, "metricsPort:", 0, 65535));
+        } else if (line.find("ioBackend:") != std::string::npos) {
+            std::string value = config_value(line, "ioBackend:");
+            if (value != "epoll" && value != "io_uring") {
+                throw std::invalid_argument("ioBackend must be epoll or io_uring");
+            }
+            network.io_backend = value == "io_uring" ? aevum::net::server::IoBackend::IO_URING
+                                                     : aevum::net::server::IoBackend::EPOLL;
+        } else if (line.find("zeroCopyThresholdKB:") != std::string::npos) {
+            network.zero_copy_threshold_kb =
+                static_cast<int>(config_number(line, "zeroCopyThresholdKB:", 0, 1048576));
+        } else if (line.find("wireCompression:") != std::string::npos) {
+            std::string value = config_value(line, "wireCompression:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("wireCompression must be true or false");
+            }
+            network.wire_compression = value == "true";
+        } else if (line.find("wireCompressionMinBytes:") != std::string::npos) {
+            network.wire_compression_min_bytes =
+                static_cast<int>(config_number(line, "wireCompressionMinBytes:", 0, 1073741824));
+        } else if (line.find("wireCompressionLevel:") != std::string::npos) {
+            network.wire_compression_level =
+                static_cast<int>(config_number(line, "wireCompressionLevel:", 1, 19));
+        } else if (line.find("wireCompressionDictionary:") != std::string::npos) {
+            network.wire_compression_dictionary = config_value(line, "wireCompressionDictionary:");
+        } else if (line.find("journal:") != std::string::npos) {
+            std::string value = config_value(line, "journal:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("journal must be true or false");
+            }
+            options.storage.journal = value == "true";
+        } else if (line.find("durability:") != std::string::npos) {
+            auto durability =
+                aevum::db::storage::durability_from_string(config_value(line, "durability:"));
+            if (!durability || *durability == aevum::db::storage::Durability::DEFAULT) {
+                throw std::invalid_argument("durability must be none, journal or fsync");
+            }
+            options.storage.durability = *durability;
+        } else if (line.find("groupCommitWindowUs:") != std::string::npos) {
+            options.storage.group_commit_window = std::chrono::microseconds(
+                config_number(line, "groupCommitWindowUs:", 0, 1000000));
+        } else if (line.find("cacheSizeMB:") != std::string::npos) {
+            options.storage.cache_size_mb = config_number(line, "cacheSizeMB:", 1, 1LL << 30);
+        } else if (line.find("evictionThreads:") != std::string::npos) {
+            options.storage.eviction_threads = config_number(line, "evictionThreads:", 1, 20);
+        } else if (line.find("evictionTarget:") != std::string::npos) {
+            options.storage.eviction_target = config_number(line, "evictionTarget:", 10, 99);
+        } else if (line.find("blockCompressor:") != std::string::npos) {
+            auto compressor = aevum::db::storage::block_compressor_from_string(
+                config_value(line, "blockCompressor:"));
+            if (!compressor) {
+                throw std::invalid_argument("blockCompressor must be none, snappy or zstd");
+            }
+            options.storage.block_compressor = *compressor;
+        } else if (line.find("collectionLeafPageMaxKB:") != std::string::npos) {
+            std::string overrides = config_value(line, "collectionLeafPageMaxKB:");
+            std::stringstream entries(overrides);
+            std::string entry;
+            while (std::getline(entries, entry, ',')) {
+                size_t eq = entry.find('=');
+                if (eq == std::string::npos) {
+                    throw std::invalid_argument(
+                        "collectionLeafPageMaxKB entries must be collection=kilobytes");
+                }
+                options.storage.collection_leaf_page_max_kb[trim(entry.substr(0, eq))] =
+                    parse_leaf_page_kb(entry.substr(eq + 1), "collectionLeafPageMaxKB");
+            }
+        } else if (line.find("collectionKeyFormat:") != std::string::npos) {
+            std::stringstream entries(config_value(line, "collectionKeyFormat:"));
+            std::string entry;
+            while (std::getline(entries, entry, ',')) {
+                size_t eq = entry.find('=');
+                auto format = eq == std::string::npos
+                                  ? std::nullopt
+                                  : aevum::db::storage::key_format_from_string(
+                                        trim(entry.substr(eq + 1)));
+                if (!format) {
+                    throw std::invalid_argument(
+                        "collectionKeyFormat entries must be collection=string|int64");
+                }
+                options.storage.collection_key_formats[trim(entry.substr(0, eq))] = *format;
+            }
+        } else if (line.find("timeSeriesCollections:") != std::string::npos) {
+            std::stringstream entries(config_value(line, "timeSeriesCollections:"));
+            std::string entry;
+            while (std::getline(entries, entry, ',')) {
+                aevum::db::timeseries::TimeSeriesOptions series;
+                std::string coll = parse_time_series(entry, series);
+                options.time_series_collections[coll] = std::move(series);
+            }
+        } else if (line.find("leafPageMaxKB:") != std::string::npos) {
+            options.storage.leaf_page_max_kb =
+                parse_leaf_page_kb(config_value(line, "leafPageMaxKB:"), "leafPageMaxKB");
+        } else if (line.find("fieldDictionary:") != std::string::npos) {
+            std::string value = config_value(line, "fieldDictionary:");
+            if (value != "true" && value != "false") {
+                throw std::invalid_argument("fieldDictionary must be true or false");
+            }
+            options.storage.field_dictionary = value == "true";
         }
     }
 }
@@ -96,15 +512,15 @@ void signal_wait_thread() {
     sigaddset(&signal_set, SIGINT);   // Intercept the interrupt signal (typically Ctrl+C).
     sigaddset(&signal_set, SIGTERM);  // Intercept the software termination signal.
 
-    aevum::util::log::Logger::info(
+    AEVUM_LOG_INFO(
         "System: Synchronous signal monitoring thread has been initialized and is now active.");
 
     int signal_number;
     // Block until one of the signals in the set is delivered to the process.
     if (sigwait(&signal_set, &signal_number) == 0) {
-        aevum::util::log::Logger::warn("System: Interruption event detected. Received signal " +
-                                       std::to_string(signal_number) +
-                                       ". Initiating the global graceful shutdown sequence...");
+        AEVUM_LOG_WARN("System: Interruption event detected. Received signal " +
+                       std::to_string(signal_number) +
+                       ". Initiating the global graceful shutdown sequence...");
         // Safely load the atomic pointer to the server instance
         auto server = g_server_instance.load(std::memory_order_acquire);
         if (server) {
@@ -167,10 +583,17 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
-    // Initialize global logging parameters.
+    // Initialize global logging parameters. The daemon's threads log through the background
+    // sink, so request paths never wait on the console, and read the time from the coarse clock.
     aevum::util::log::Logger::set_level(aevum::util::log::LogLevel::INFO);
+    aevum::util::time::CoarseClock::start();
+    aevum::util::log::Logger::start_async();
     std::string data_path = "./aevum_data";
     int port = 55001;
+    aevum::db::CoreOptions options;
+    aevum::net::server::ConnectionPoolConfig network_config;
+    aevum::net::server::ReplicationConfig replication_config;
+    aevum::net::server::ShardingConfig sharding_config;
 
     try {
         // Dynamically resolve configuration from command-line arguments.
@@ -178,9 +601,9 @@ int main(int argc, char *argv[]) {
             std::string arg1 = argv[1];
             if (arg1 == "--config" && argc > 2) {
                 // If --config is used, parse the data path and port from the config file.
-                aevum::util::log::Logger::info("Daemon: Configuration provided via file: " +
-                                               std::string(argv[2]));
-                aevum::daemon::parse_config(argv[2], data_path, port);
+                AEVUM_LOG_INFO("Daemon: Configuration provided via file: " + std::string(argv[2]));
+                aevum::daemon::parse_config(argv[2], data_path, port, options, network_config,
+                                            replication_config, sharding_config);
             } else {
                 // Otherwise, treat arguments as positional: [DATA_PATH] [PORT]
                 data_path = arg1;
@@ -195,18 +618,33 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        aevum::util::log::Logger::info(
-            "Daemon: Initiating AevumDB high-performance bootstrap sequence...");
+        AEVUM_LOG_INFO("Daemon: Initiating AevumDB high-performance bootstrap sequence...");
 
         // Initialize the central database orchestration engine.
-        aevum::db::Core database_instance(data_path);
-        aevum::util::log::Logger::info("Core: Storage engine initialized with data path: " +
-                                       data_path);
+        aevum::db::Core database_instance(data_path, options);
+        AEVUM_LOG_INFO("Core: Storage engine initialized with data path: " + data_path);
+
+        // A read replica pulls its documents from the primary before serving reads.
+        std::unique_ptr<aevum::net::server::Replicator> replicator;
+        if (!replication_config.primary_host.empty()) {
+            replicator = std::make_unique<aevum::net::server::Replicator>(database_instance,
+                                                                         replication_config);
+        }
+
+        // A shard router answers data requests from its shards.
+        std::unique_ptr<aevum::net::server::ShardRouter> router;
+        if (!sharding_config.shards.empty()) {
+            if (replicator) {
+                throw std::invalid_argument("A shard router cannot also be a read replica");
+            }
+            router = std::make_unique<aevum::net::server::ShardRouter>(sharding_config);
+        }
 
         // Configure the high-performance network server subsystem.
-        aevum::net::server::Server network_server(database_instance, port);
-        aevum::util::log::Logger::info("Network: Listening for incoming connections on port " +
-                                       std::to_string(port));
+        aevum::net::server::Server network_server(database_instance, port, network_config,
+                                                  replicator.get(), router.get());
+        AEVUM_LOG_INFO("Network: Listening for incoming connections on port " +
+                       std::to_string(port));
 
         // Register the server instance with the global signal manager using atomic store
         // for thread-safe access from the signal handling thread.
@@ -233,12 +671,14 @@ int main(int argc, char *argv[]) {
         }
 
     } catch (const std::exception &e) {
-        aevum::util::log::Logger::fatal("Daemon: A critical runtime exception has occurred: " +
-                                        std::string(e.what()));
+        AEVUM_LOG_FATAL("Daemon: A critical runtime exception has occurred: " +
+                        std::string(e.what()));
+        aevum::util::log::Logger::stop_async();
         return 1;
     }
 
-    aevum::util::log::Logger::info(
+    AEVUM_LOG_INFO(
         "Daemon: AevumDB daemon has successfully concluded all operations. Exiting gracefully.");
+    aevum::util::log::Logger::stop_async();
     return 0;
 }
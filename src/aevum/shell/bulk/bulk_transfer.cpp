@@ -0,0 +1,590 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bulk_transfer.cpp
+ * @brief Implements the shell's `import` and `export` of files of documents.
+ */
+#include "aevum/shell/bulk/bulk_transfer.hpp"
+
+#include <bson/bson.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/bson/json/serializer.hpp"
+#include "aevum/client/async_aevum_client.hpp"
+#include "aevum/util/string/trim.hpp"
+#include "simdjson.h"
+
+namespace aevum::shell::bulk {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using aevum::util::Status;
+
+/// The errors of one transfer printed in full; later ones are only counted.
+constexpr uint64_t MAX_REPORTED_ERRORS = 10;
+
+/// The bytes of a MiB, for the rates reported.
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+/// The largest BSON document, as for MongoDB; a longer length prefix means a corrupt file.
+constexpr uint32_t MAX_BSON_DOCUMENT_BYTES = 16U << 20;
+
+/**
+ * @brief Reads the status of a server response.
+ * @param parser The parser to use.
+ * @param response The JSON response.
+ * @param doc Receives the parsed response.
+ * @param message Receives the server's message if the status is not "ok".
+ * @return `true` if the response parsed and its status is "ok".
+ */
+bool response_ok(simdjson::dom::parser &parser, const std::string &response,
+                 simdjson::dom::element &doc, std::string_view &message) {
+    message = "Malformed response from the server.";
+    if (parser.parse(response).get(doc) != simdjson::SUCCESS || !doc.is_object()) return false;
+    std::string_view status;
+    if (doc["status"].get_string().get(status) == simdjson::SUCCESS && status == "ok") return true;
+    (void)doc["message"].get_string().get(message);
+    return false;
+}
+
+/**
+ * @brief Formats the counts of a transfer and their rates.
+ * @param stats The counts.
+ * @param seconds The time they took.
+ * @return e.g. `"120000 document(s), 48.2 MiB in 1.3 s (92307 docs/s, 37.1 MiB/s)"`.
+ */
+std::string format_stats(const TransferStats &stats, double seconds) {
+    double mib = static_cast<double>(stats.bytes) / BYTES_PER_MIB;
+    double elapsed = seconds > 0.0 ? seconds : 1e-9;
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "%llu document(s), %.1f MiB in %.1f s (%.0f docs/s, %.1f MiB/s)",
+                  static_cast<unsigned long long>(stats.documents), mib, seconds,
+                  static_cast<double>(stats.documents) / elapsed, mib / elapsed);
+    return line;
+}
+
+/**
+ * @class Progress
+ * @brief Reports the counts of a running transfer and its errors on standard error, the counts
+ * at most once a second.
+ * @details On a terminal the report rewrites a single line; otherwise each report is a line of
+ * its own, so that a log of a script shows the throughput over time.
+ */
+class Progress {
+  public:
+    /**
+     * @brief Starts the clock of a transfer.
+     * @param verb The word leading each report, e.g. `"Imported"`.
+     * @param enabled `false` to time the transfer without reporting.
+     */
+    Progress(const char *verb, bool enabled)
+        : verb_(verb),
+          enabled_(enabled),
+          terminal_(isatty(STDERR_FILENO) == 1),
+          start_(Clock::now()),
+          last_(start_) {}
+
+    /**
+     * @brief Reports the counts if a second has passed since the last report.
+     * @param stats The counts so far.
+     */
+    void update(const TransferStats &stats) {
+        if (!enabled_) return;
+        Clock::time_point now = Clock::now();
+        if (now - last_ < std::chrono::seconds(1)) return;
+        last_ = now;
+        reported_ = true;
+        std::string line = std::string(verb_) + " " + format_stats(stats, seconds(now));
+        if (terminal_) {
+            std::cerr << "\r" << line << "\033[K" << std::flush;
+        } else {
+            std::cerr << line << std::endl;
+        }
+    }
+
+    /**
+     * @brief Reports an error of the transfer unless enough have been reported already.
+     * @param stats The counts, whose errors are incremented.
+     * @param where Where the document was found, e.g. `"line 12"`.
+     * @param message The error.
+     */
+    void error(TransferStats &stats, const std::string &where, std::string_view message) {
+        ++stats.errors;
+        if (stats.errors > MAX_REPORTED_ERRORS + 1) return;
+        if (terminal_ && reported_) std::cerr << "\r\033[K";
+        if (stats.errors <= MAX_REPORTED_ERRORS) {
+            std::cerr << "  " << where << ": " << message << std::endl;
+        } else {
+            std::cerr << "  Further errors are counted but not shown." << std::endl;
+        }
+    }
+
+    /**
+     * @brief Stops the clock and ends the line of reports.
+     * @param stats Receives the time of the transfer.
+     */
+    void finish(TransferStats &stats) {
+        stats.seconds = seconds(Clock::now());
+        if (reported_ && terminal_) std::cerr << std::endl;
+    }
+
+  private:
+    /**
+     * @brief Returns the time since the transfer started.
+     * @param now The current time.
+     * @return The time in seconds.
+     */
+    [[nodiscard]] double seconds(Clock::time_point now) const {
+        return std::chrono::duration<double>(now - start_).count();
+    }
+
+    /// The word leading each report.
+    const char *verb_;
+    /// `false` if nothing is reported.
+    bool enabled_;
+    /// `true` if standard error is a terminal.
+    bool terminal_;
+    /// `true` once a report was printed.
+    bool reported_{false};
+    /// When the transfer started.
+    Clock::time_point start_;
+    /// When the last report was printed.
+    Clock::time_point last_;
+};
+
+/**
+ * @brief Appends the next chunk of a file to a buffer.
+ * @param in The file.
+ * @param size The most bytes to read.
+ * @param buffer The buffer to append to.
+ * @param eof Set to `true` once the end of the file is reached.
+ * @param stats The counts, whose bytes are incremented.
+ * @return `Status::OK()`, or `IOError` if the file cannot be read.
+ */
+Status read_chunk(std::ifstream &in, size_t size, std::string &buffer, bool &eof,
+                  TransferStats &stats) {
+    size_t used = buffer.size();
+    buffer.resize(used + size);
+    in.read(buffer.data() + used, static_cast<std::streamsize>(size));
+    auto read = static_cast<size_t>(in.gcount());
+    buffer.resize(used + read);
+    stats.bytes += read;
+    if (in.bad()) return Status::IOError("Failed to read the file.");
+    eof = in.eof();
+    return Status::OK();
+}
+
+/**
+ * @class InsertPipeline
+ * @brief Gathers documents into `insert_many` batches and keeps several of them in flight.
+ */
+class InsertPipeline {
+  public:
+    /**
+     * @brief Prepares the first batch.
+     * @param client The client whose pool carries the batches.
+     * @param collection The target collection.
+     * @param options The batching.
+     * @param stats The counts to update as responses arrive.
+     * @param progress The report to refresh as responses arrive.
+     * @param unit What locates a document in the file, `"line"` or `"document"`.
+     */
+    InsertPipeline(client::AsyncAevumClient &client, std::string_view collection,
+                   const TransferOptions &options, TransferStats &stats, Progress &progress,
+                   const char *unit)
+        : client_(client),
+          collection_(collection),
+          options_(options),
+          stats_(stats),
+          progress_(progress),
+          unit_(unit) {
+        batch_.reserve(options_.batch_bytes + 2);
+    }
+
+    /**
+     * @brief Adds a document to the current batch, sending the batch first if it is full.
+     * @param json The document as a JSON object.
+     * @param location Its line or position in the file, for error reports.
+     * @return `Status::OK()`, or the failure of a batch that had to be awaited.
+     */
+    Status add(std::string_view json, uint64_t location) {
+        if (!locations_.empty() && (locations_.size() >= options_.batch_documents ||
+                                    batch_.size() + json.size() + 2 > options_.batch_bytes)) {
+            Status status = send();
+            if (!status.ok()) return status;
+        }
+        batch_ += locations_.empty() ? '[' : ',';
+        batch_.append(json);
+        locations_.push_back(location);
+        return Status::OK();
+    }
+
+    /**
+     * @brief Sends the last batch and waits for every response.
+     * @return `Status::OK()`, or the failure of the first batch refused as a whole.
+     */
+    Status finish() {
+        Status status = send();
+        while (status.ok() && !pending_.empty()) status = collect();
+        while (!pending_.empty()) {
+            pending_.front().response.wait();
+            pending_.pop_front();
+        }
+        return status;
+    }
+
+  private:
+    /**
+     * @struct Pending
+     * @brief A batch awaiting its response.
+     */
+    struct Pending {
+        /// The response.
+        std::future<std::string> response;
+        /// The location in the file of each document of the batch.
+        std::vector<uint64_t> locations;
+    };
+
+    /**
+     * @brief Sends the current batch, first awaiting the oldest one if enough are in flight.
+     * @return `Status::OK()`, or the failure of the batch awaited.
+     */
+    Status send() {
+        if (locations_.empty()) return Status::OK();
+        if (pending_.size() >= options_.in_flight) {
+            Status status = collect();
+            if (!status.ok()) return status;
+        }
+        batch_ += ']';
+        pending_.push_back({client_.insert_many(collection_, batch_), std::move(locations_)});
+        batch_.clear();
+        locations_.clear();
+        return Status::OK();
+    }
+
+    /**
+     * @brief Waits for the oldest batch in flight and counts its documents.
+     * @details A document the server refuses is reported and the import goes on; a batch
+     * refused as a whole, as for a lost connection or a missing permission, ends it.
+     * @return `Status::OK()`, or `IOError` with the server's message if the batch was refused.
+     */
+    Status collect() {
+        Pending pending = std::move(pending_.front());
+        pending_.pop_front();
+        std::string response = pending.response.get();
+
+        simdjson::dom::element doc;
+        std::string_view message;
+        if (!response_ok(parser_, response, doc, message)) {
+            stats_.errors += pending.locations.size();
+            return Status::IOError(message);
+        }
+        int64_t inserted = 0;
+        (void)doc["inserted"].get_int64().get(inserted);
+        stats_.documents += static_cast<uint64_t>(inserted);
+        simdjson::dom::array results;
+        if (doc["results"].get_array().get(results) == simdjson::SUCCESS) {
+            size_t position = 0;
+            for (simdjson::dom::element result : results) {
+                std::string_view message;
+                if (result["message"].get_string().get(message) == simdjson::SUCCESS &&
+                    position < pending.locations.size()) {
+                    progress_.error(stats_,
+                                    std::string(unit_) + " " +
+                                        std::to_string(pending.locations[position]),
+                                    message);
+                }
+                ++position;
+            }
+        }
+        progress_.update(stats_);
+        return Status::OK();
+    }
+
+    /// The client whose pool carries the batches.
+    client::AsyncAevumClient &client_;
+    /// The target collection.
+    std::string_view collection_;
+    /// The batching.
+    const TransferOptions &options_;
+    /// The counts to update.
+    TransferStats &stats_;
+    /// The report to refresh.
+    Progress &progress_;
+    /// What locates a document in the file.
+    const char *unit_;
+    /// The JSON array of the current batch, without its closing bracket.
+    std::string batch_;
+    /// The location of each document of the current batch.
+    std::vector<uint64_t> locations_;
+    /// The batches in flight, oldest first.
+    std::deque<Pending> pending_;
+    /// Parses the responses.
+    simdjson::dom::parser parser_;
+};
+
+/**
+ * @brief Feeds the lines of an NDJSON file to a pipeline.
+ * @details Each line is checked to be a JSON object before it joins a batch, so one malformed
+ * line costs that line alone rather than the whole batch the server would refuse.
+ * @param in The file.
+ * @param options The batching.
+ * @param pipeline The pipeline.
+ * @param stats The counts.
+ * @param progress The report.
+ * @return `Status::OK()`, or the first failure of the file or of a batch.
+ */
+Status import_ndjson(std::ifstream &in, const TransferOptions &options, InsertPipeline &pipeline,
+                     TransferStats &stats, Progress &progress) {
+    simdjson::dom::parser parser;
+    std::string buffer;
+    uint64_t line_number = 0;
+    bool eof = false;
+    auto process = [&](std::string_view line) -> Status {
+        ++line_number;
+        line = aevum::util::string::trim(line);
+        if (line.empty()) return Status::OK();
+        simdjson::dom::element element;
+        if (parser.parse(line.data(), line.size()).get(element) != simdjson::SUCCESS ||
+            !element.is_object()) {
+            progress.error(stats, "line " + std::to_string(line_number), "Not a JSON object.");
+            return Status::OK();
+        }
+        return pipeline.add(line, line_number);
+    };
+    while (!eof) {
+        Status status = read_chunk(in, options.chunk_bytes, buffer, eof, stats);
+        if (!status.ok()) return status;
+        size_t start = 0;
+        for (size_t end; (end = buffer.find('\n', start)) != std::string::npos; start = end + 1) {
+            status = process(std::string_view(buffer).substr(start, end - start));
+            if (!status.ok()) return status;
+        }
+        buffer.erase(0, start);
+        progress.update(stats);
+    }
+    return buffer.empty() ? Status::OK() : process(buffer);
+}
+
+/**
+ * @brief Feeds the documents of a BSON file to a pipeline.
+ * @param in The file.
+ * @param options The batching.
+ * @param pipeline The pipeline.
+ * @param stats The counts.
+ * @param progress The report.
+ * @return `Status::OK()`, `InvalidArgument` if the file is truncated or holds an impossible
+ *         length, or the first failure of the file or of a batch.
+ */
+Status import_bson(std::ifstream &in, const TransferOptions &options, InsertPipeline &pipeline,
+                   TransferStats &stats, Progress &progress) {
+    std::string buffer;
+    std::string json;
+    size_t offset = 0;
+    uint64_t position = 0;
+    bool eof = false;
+    while (true) {
+        size_t available = buffer.size() - offset;
+        uint32_t length = 0;
+        if (available >= 4) {
+            const auto *bytes = reinterpret_cast<const uint8_t *>(buffer.data() + offset);
+            length = static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+                     static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+        }
+        if (available >= 4 && (length < 5 || length > MAX_BSON_DOCUMENT_BYTES)) {
+            return Status::InvalidArgument("Document " + std::to_string(position + 1) +
+                                           " has an invalid length.");
+        }
+        if (available < 4 || available < length) {
+            if (eof) {
+                if (available == 0) return Status::OK();
+                return Status::InvalidArgument("The file ends inside document " +
+                                               std::to_string(position + 1) + ".");
+            }
+            buffer.erase(0, offset);
+            offset = 0;
+            Status status = read_chunk(in, options.chunk_bytes, buffer, eof, stats);
+            if (!status.ok()) return status;
+            progress.update(stats);
+            continue;
+        }
+        ++position;
+        bson_t *raw = bson_new_from_data(
+            reinterpret_cast<const uint8_t *>(buffer.data() + offset), length);
+        offset += length;
+        if (raw == nullptr) {
+            progress.error(stats, "document " + std::to_string(position), "Not a BSON document.");
+            continue;
+        }
+        aevum::bson::doc::Document doc(raw);
+        json.clear();
+        aevum::bson::json::append_json(doc, json);
+        Status status = pipeline.add(json, position);
+        if (!status.ok()) return status;
+    }
+}
+
+/**
+ * @brief Appends the documents of a cursor batch to the output buffer.
+ * @param data The documents.
+ * @param format The format of the file.
+ * @param out The buffer.
+ * @return `Status::OK()`, or `InvalidArgument` if a document cannot be converted to BSON.
+ */
+Status append_batch(simdjson::dom::array data, FileFormat format, std::string &out) {
+    for (simdjson::dom::element item : data) {
+        std::string json = simdjson::to_string(item);
+        if (format == FileFormat::NDJSON) {
+            out += json;
+            out += '\n';
+            continue;
+        }
+        aevum::bson::doc::Document doc;
+        Status status = aevum::bson::json::parse(json, doc);
+        if (!status.ok()) return status;
+        out.append(reinterpret_cast<const char *>(bson_get_data(doc.get())), doc.length());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+/**
+ * @brief Chooses the format of a file by its extension.
+ * @param path The path of the file.
+ * @return `FileFormat::BSON` for a `.bson` file, `FileFormat::NDJSON` otherwise.
+ */
+FileFormat format_of(std::string_view path) noexcept {
+    constexpr std::string_view suffix = ".bson";
+    bool bson = path.size() >= suffix.size() &&
+                path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    return bson ? FileFormat::BSON : FileFormat::NDJSON;
+}
+
+/**
+ * @brief Streams a file into a collection through a pipeline of `insert_many` batches.
+ * @param client The client whose pool carries the batches.
+ * @param collection The target collection.
+ * @param path The file to read.
+ * @param options The batching.
+ * @param stats Receives the counts of the import.
+ * @return `Status::OK()` if every document was inserted, or the reason it was not.
+ */
+Status import_file(client::AsyncAevumClient &client, std::string_view collection,
+                   const std::string &path, const TransferOptions &options, TransferStats &stats) {
+    stats = TransferStats{};
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return Status::IOError("Cannot open '" + path + "' for reading.");
+
+    FileFormat format = format_of(path);
+    Progress progress("Imported", options.progress);
+    InsertPipeline pipeline(client, collection, options, stats, progress,
+                            format == FileFormat::BSON ? "document" : "line");
+    Status status = format == FileFormat::BSON
+                        ? import_bson(in, options, pipeline, stats, progress)
+                        : import_ndjson(in, options, pipeline, stats, progress);
+    Status finished = pipeline.finish();
+    progress.finish(stats);
+    if (!status.ok()) return status;
+    if (!finished.ok()) return finished;
+    if (stats.errors > 0) {
+        return Status::InvalidArgument(std::to_string(stats.errors) +
+                                       " document(s) were not imported.");
+    }
+    return Status::OK();
+}
+
+/**
+ * @brief Streams the matches of a query into a file through a cursor, one batch ahead.
+ * @param client The client whose pool carries the cursor's requests.
+ * @param collection The source collection.
+ * @param query_json The filter.
+ * @param path The file to write.
+ * @param options The batching.
+ * @param stats Receives the counts of the export.
+ * @return `Status::OK()`, or the reason the export stopped.
+ */
+Status export_file(client::AsyncAevumClient &client, std::string_view collection,
+                   std::string_view query_json, const std::string &path,
+                   const TransferOptions &options, TransferStats &stats) {
+    stats = TransferStats{};
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return Status::IOError("Cannot open '" + path + "' for writing.");
+
+    FileFormat format = format_of(path);
+    auto batch_size = static_cast<int64_t>(options.batch_documents);
+    Progress progress("Exported", options.progress);
+    simdjson::dom::parser parser;
+    std::string buffer;
+    buffer.reserve(options.chunk_bytes);
+    std::future<std::string> next = client.open_cursor(collection, query_json, batch_size);
+    Status status = Status::OK();
+    while (next.valid()) {
+        std::string response = next.get();
+        simdjson::dom::element doc;
+        std::string_view message;
+        if (!response_ok(parser, response, doc, message)) {
+            status = Status::InvalidArgument(message);
+            break;
+        }
+        int64_t cursor = 0;
+        (void)doc["cursor"].get_int64().get(cursor);
+        // The next batch is read by the server while this one is written.
+        if (cursor != 0) next = client.get_more(cursor, batch_size);
+
+        simdjson::dom::array data;
+        if (doc["data"].get_array().get(data) == simdjson::SUCCESS) {
+            status = append_batch(data, format, buffer);
+            stats.documents += data.size();
+        }
+        if (status.ok() && buffer.size() >= options.chunk_bytes) {
+            if (!out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                status = Status::IOError("Failed to write '" + path + "'.");
+            }
+            stats.bytes += buffer.size();
+            buffer.clear();
+        }
+        if (!status.ok()) {
+            if (cursor != 0) {
+                next.wait();
+                client.kill_cursor(cursor).wait();
+            }
+            break;
+        }
+        progress.update(stats);
+    }
+    if (status.ok() && !buffer.empty()) {
+        if (!out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            status = Status::IOError("Failed to write '" + path + "'.");
+        }
+        stats.bytes += buffer.size();
+    }
+    out.close();
+    if (status.ok() && out.fail()) status = Status::IOError("Failed to write '" + path + "'.");
+    progress.finish(stats);
+    return status;
+}
+
+/**
+ * @brief Formats the outcome of a transfer for the shell.
+ * @param stats The counts of the transfer.
+ * @return The counts, the time, and the rates.
+ */
+std::string describe(const TransferStats &stats) { return format_stats(stats, stats.seconds); }
+
+}  // namespace aevum::shell::bulk
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bulk_transfer.hpp
+ * @brief Declares the shell's `import` and `export` commands, which move whole files of
+ * documents between the client's disk and a collection.
+ * @details Files hold one document per line as JSON (NDJSON), or concatenated BSON documents as
+ * written by `mongodump` and `aevum_dump`; a path ending in `.bson` selects BSON. Both commands
+ * stream the file in chunks, so its size is bounded by the disk only, and both go through an
+ * `AsyncAevumClient`: an import keeps several `insert_many` batches in flight over its pool of
+ * connections, and an export requests the next batch of its cursor while it writes the current
+ * one. While they run, a line on standard error reports the documents and bytes moved and their
+ * rates.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "aevum/util/status.hpp"
+
+namespace aevum::client {
+class AsyncAevumClient;
+}
+
+/**
+ * @namespace aevum::shell::bulk
+ * @brief The shell's bulk transfer of documents between files and collections.
+ */
+namespace aevum::shell::bulk {
+
+/**
+ * @enum FileFormat
+ * @brief The layouts of a file of documents.
+ */
+enum class FileFormat {
+    /// One JSON object per line; blank lines are skipped.
+    NDJSON,
+    /// BSON documents, each prefixed by its own little-endian length, back to back.
+    BSON
+};
+
+/**
+ * @brief Chooses the format of a file by its name.
+ * @param path The path of the file.
+ * @return `FileFormat::BSON` if it ends in `.bson`, `FileFormat::NDJSON` otherwise.
+ */
+[[nodiscard]] FileFormat format_of(std::string_view path) noexcept;
+
+/**
+ * @struct TransferOptions
+ * @brief Tunes the batches of an import or export.
+ */
+struct TransferOptions {
+    /// The most documents per `insert_many` request or cursor batch.
+    size_t batch_documents{1000};
+    /// The most JSON bytes per `insert_many` request, well below the server's 8 MB request limit.
+    size_t batch_bytes{4U << 20};
+    /// The most `insert_many` requests an import keeps in flight.
+    size_t in_flight{8};
+    /// The bytes read from or written to the file at a time.
+    size_t chunk_bytes{4U << 20};
+    /// `true` to report progress on standard error while the transfer runs.
+    bool progress{true};
+};
+
+/**
+ * @struct TransferStats
+ * @brief The outcome of an import or export.
+ */
+struct TransferStats {
+    /// The documents inserted or written.
+    uint64_t documents{0};
+    /// The bytes of the file read or written.
+    uint64_t bytes{0};
+    /// The documents that could not be read from the file or were refused by the server.
+    uint64_t errors{0};
+    /// The wall-clock time of the transfer, in seconds.
+    double seconds{0.0};
+};
+
+/**
+ * @brief Inserts every document of a file into a collection.
+ * @details The documents are sent in `insert_many` batches of at most `batch_documents`
+ * documents and `batch_bytes` bytes, with up to `in_flight` batches awaiting their response; a
+ * batch may thus be applied before the one read ahead of it. A line of NDJSON that is not a JSON
+ * object is counted as an error and reported with its line number, as is every document the
+ * server refuses, and the import goes on. The batches are not part of any transaction the shell
+ * has open.
+ * @param client The client whose pool carries the batches.
+ * @param collection The target collection.
+ * @param path The file to read.
+ * @param options The batching.
+ * @param stats Receives the counts of the import.
+ * @return `aevum::util::Status::OK()` if every document was inserted; `IOError` if the file
+ *         cannot be read or the server refuses a whole batch, as for a lost connection or a
+ *         missing permission, which ends the import; or `InvalidArgument` if some documents were
+ *         not inserted or the BSON file is truncated.
+ */
+[[nodiscard]] aevum::util::Status import_file(client::AsyncAevumClient &client,
+                                              std::string_view collection, const std::string &path,
+                                              const TransferOptions &options,
+                                              TransferStats &stats);
+
+/**
+ * @brief Writes every document of a collection that matches a query to a file.
+ * @details The documents are read through a cursor of `batch_documents` documents per batch. The
+ * request for the next batch is sent before the current one is written, so the server reads
+ * while the client writes. An existing file is replaced.
+ * @param client The client whose pool carries the cursor's requests.
+ * @param collection The source collection.
+ * @param query_json The filter, e.g. `"{}"` for every document.
+ * @param path The file to write.
+ * @param options The batching.
+ * @param stats Receives the counts of the export.
+ * @return `aevum::util::Status::OK()`, `IOError` if the file cannot be written or the
+ *         connection fails, or `InvalidArgument` if the server refuses the query.
+ */
+[[nodiscard]] aevum::util::Status export_file(client::AsyncAevumClient &client,
+                                              std::string_view collection,
+                                              std::string_view query_json, const std::string &path,
+                                              const TransferOptions &options,
+                                              TransferStats &stats);
+
+/**
+ * @brief Formats the outcome of an import or export for the shell.
+ * @param stats The counts of the transfer.
+ * @return e.g. `"120000 document(s), 48.2 MiB in 1.3 s (92307 docs/s, 37.1 MiB/s)"`.
+ */
+[[nodiscard]] std::string describe(const TransferStats &stats);
+
+}  // namespace aevum::shell::bulk
@@ -7,13 +7,18 @@
  * @brief Implements the primary entry point for the AevumDB interactive shell client.
  * @details This file contains the `main` function that initializes the client, parses command-line
  * arguments, establishes a connection to an AevumDB daemon, and launches the interactive
- * Read-Eval-Print Loop (REPL) for direct user interaction with the database.
+ * Read-Eval-Print Loop (REPL) for direct user interaction with the database. With `--eval` or
+ * `--file`, it runs the given commands instead and exits with their outcome.
  */
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "aevum/client/aevum_client.hpp"
+#include "aevum/client/async_aevum_client.hpp"
 #include "aevum/shell/repl/repl.hpp"
 
 /**
@@ -28,34 +33,69 @@
  * interactive session. Upon the user's exit from the REPL, it ensures a graceful disconnection
  * before terminating.
  *
+ * In batch mode, selected by `--eval <command>` (repeatable) or `--file <script>` (`-` for
+ * standard input), the commands given are run by `aevum::shell::repl::run_script` instead of the
+ * REPL: first those of `--eval`, in order, then those of the script. Only the commands' output
+ * is printed, so it can be piped.
+ *
  * @param argc The count of command-line arguments supplied to the program.
  * @param argv A pointer to an array of C-style strings representing the command-line arguments.
  * @return Returns `0` on successful execution and graceful shutdown.
- * @return Returns `1` if command-line arguments are invalid or if a connection to the
- *         database server cannot be established.
+ * @return Returns `1` if command-line arguments are invalid, if a connection to the
+ *         database server cannot be established, or if a command of batch mode fails.
  */
 int main(int argc, char *argv[]) {
     std::string host = "127.0.0.1";
     int port = 55001;
     std::string api_key = "root";
+    std::vector<std::string> positional;
+    std::vector<std::string> eval_commands;
+    std::string script_path;
 
-    // Provide a helpful usage message if requested via command-line flags.
-    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
-        std::cout << "AevumDB Shell Client\n\n"
-                  << "Usage: " << argv[0] << " [host] [port] [api_key]\n\n"
-                  << "Arguments:\n"
-                  << "  host    : AevumDB daemon hostname or IP (default: 127.0.0.1)\n"
-                  << "  port    : Port number of the daemon (default: 55001)\n"
-                  << "  api_key : API key for authentication (default: 'root')\n\n"
-                  << "Documentation: https://github.com/aevumdb/aevum\n";
-        return 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // Provide a helpful usage message if requested via command-line flags.
+        if (arg == "--help" || arg == "-h") {
+            std::cout << "AevumDB Shell Client\n\n"
+                      << "Usage: " << argv[0]
+                      << " [--eval <command>]... [--file <script>] [host] [port] [api_key]\n\n"
+                      << "Arguments:\n"
+                      << "  host    : AevumDB daemon hostname or IP (default: 127.0.0.1)\n"
+                      << "  port    : Port number of the daemon (default: 55001)\n"
+                      << "  api_key : API key for authentication (default: 'root')\n\n"
+                      << "Batch Mode:\n"
+                      << "  --eval <command> : Run a command and exit; may be repeated\n"
+                      << "  --file <script>  : Run the commands of a file, one per line, and\n"
+                      << "                     exit; '-' reads standard input\n"
+                      << "  The exit status is 1 if a command fails; the rest are skipped.\n\n"
+                      << "Documentation: https://github.com/aevumdb/aevum\n";
+            return 0;
+        }
+        if (arg == "--eval" || arg == "--file") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value." << std::endl;
+                return 1;
+            }
+            if (arg == "--eval") {
+                eval_commands.emplace_back(argv[++i]);
+            } else {
+                script_path = argv[++i];
+            }
+            continue;
+        }
+        positional.push_back(arg);
+    }
+    if (positional.size() > 3) {
+        std::cerr << "Error: Unexpected argument '" << positional[3] << "'. See --help."
+                  << std::endl;
+        return 1;
     }
 
     // Safely parse command-line arguments with robust error handling.
     try {
-        if (argc > 1) host = argv[1];
-        if (argc > 2) {
-            int parsed_port = std::stoi(argv[2]);
+        if (positional.size() > 0) host = positional[0];
+        if (positional.size() > 1) {
+            int parsed_port = std::stoi(positional[1]);
             // Validate port is within valid range [1, 65535]
             if (parsed_port < 1 || parsed_port > 65535) {
                 std::cerr << "Error: Port number must be between 1 and 65535." << std::endl;
@@ -63,7 +103,7 @@ int main(int argc, char *argv[]) {
             }
             port = parsed_port;
         }
-        if (argc > 3) api_key = argv[3];
+        if (positional.size() > 2) api_key = positional[2];
     } catch (const std::invalid_argument &e) {
         std::cerr << "Error: Invalid number format for port. " << e.what() << std::endl;
         return 1;
@@ -72,19 +112,49 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    // Initialize the high-level database client.
+    bool batch = !eval_commands.empty() || !script_path.empty();
+    std::ifstream script_file;
+    if (!script_path.empty() && script_path != "-") {
+        script_file.open(script_path);
+        if (!script_file) {
+            std::cerr << "Error: Cannot open script '" << script_path << "'." << std::endl;
+            return 1;
+        }
+    }
+
+    // Initialize the high-level database client, and the pipelined one that bulk transfers
+    // use; the latter connects on its first request.
     aevum::client::AevumClient client(host, port, api_key);
+    aevum::client::AsyncAevumClient bulk_client(host, port, api_key);
 
-    std::cout << "Connecting to AevumDB at " << host << ":" << port << "..." << std::endl;
+    if (!batch) {
+        std::cout << "Connecting to AevumDB at " << host << ":" << port << "..." << std::endl;
+    }
     if (!client.connect()) {
         std::cerr << "Failed to connect to the AevumDB daemon. Is it running?\n"
                   << "Please ensure the AevumDB daemon is started and accessible." << std::endl;
         return 1;
     }
+
+    if (batch) {
+        bool succeeded = true;
+        if (!eval_commands.empty()) {
+            std::ostringstream joined;
+            for (const std::string &command : eval_commands) joined << command << '\n';
+            std::istringstream commands(joined.str());
+            succeeded = aevum::shell::repl::run_script(commands, client, bulk_client);
+        }
+        if (succeeded && !script_path.empty()) {
+            std::istream &script = script_path == "-" ? std::cin : script_file;
+            succeeded = aevum::shell::repl::run_script(script, client, bulk_client);
+        }
+        client.disconnect();
+        return succeeded ? 0 : 1;
+    }
     std::cout << "Connection successful. Type 'help' for a list of commands." << std::endl;
 
     // Enter the main interactive loop.
-    aevum::shell::repl::run(client);
+    aevum::shell::repl::run(client, bulk_client);
 
     // Gracefully disconnect upon exiting the REPL.
     client.disconnect();
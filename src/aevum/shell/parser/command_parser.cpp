@@ -13,9 +13,11 @@
 #include "aevum/shell/parser/command_parser.hpp"
 
 #include <iostream>
+#include <optional>
 #include <regex>
 #include <string>
 
+#include "aevum/shell/bulk/bulk_transfer.hpp"
 #include "aevum/util/string/trim.hpp"
 #include "simdjson.h"
 
@@ -67,6 +69,65 @@ size_t find_matching_brace(const std::string &str, size_t start_pos, char open_c
     return std::string::npos;  // Unbalanced braces.
 }
 
+/**
+ * @brief Prints a raw server response and reports whether it succeeded.
+ * @param response The JSON response.
+ * @return `true` if its status is "ok".
+ */
+bool print_response(const std::string &response) {
+    std::cout << response << std::endl;
+    simdjson::dom::parser parser;
+    simdjson::dom::element doc;
+    std::string_view status;
+    return parser.parse(response).get(doc) == simdjson::SUCCESS &&
+           doc["status"].get_string().get(status) == simdjson::SUCCESS && status == "ok";
+}
+
+/**
+ * @brief Runs `db.<coll>.import("<path>")` or `db.<coll>.export("<path>"[, <query>])`.
+ * @details The transfer goes through the shell's asynchronous client, so that several batches
+ * are in flight at once; its progress is reported on standard error and its outcome on
+ * standard output.
+ * @param operation `"import"` or `"export"`.
+ * @param collection The collection.
+ * @param args_str The arguments of the command.
+ * @param bulk_client The client that carries the batches.
+ * @return `true` if every document was transferred.
+ */
+bool run_transfer(const std::string &operation, const std::string &collection,
+                  const std::string &args_str, client::AsyncAevumClient &bulk_client) {
+    const std::regex transfer_regex(R"(\"([^\"]+)\"\s*(?:,\s*(\{.*\}))?)");
+    std::smatch transfer_matches;
+    if (!std::regex_match(args_str, transfer_matches, transfer_regex) ||
+        (transfer_matches[2].matched && operation == "import") ||
+        (transfer_matches[2].matched &&
+         find_matching_brace(transfer_matches[2].str(), 0, '{', '}') !=
+             transfer_matches[2].str().size() - 1)) {
+        std::cerr << "Error: Invalid format. Expected: db.<coll>.import(\"<path>\") or "
+                     "db.<coll>.export(\"<path>\"[, <query>])\n";
+        return false;
+    }
+    std::string path = transfer_matches[1].str();
+    std::string query = transfer_matches[2].matched ? transfer_matches[2].str() : "{}";
+
+    bulk::TransferOptions options;
+    bulk::TransferStats stats;
+    auto status = operation == "import"
+                      ? bulk::import_file(bulk_client, collection, path, options, stats)
+                      : bulk::export_file(bulk_client, collection, query, path, options, stats);
+    if (status.ok() || stats.documents > 0 || stats.errors > 0) {
+        std::cout << (operation == "import" ? "Imported " : "Exported ")
+                  << bulk::describe(stats)
+                  << (stats.errors > 0 ? ", " + std::to_string(stats.errors) + " error(s)" : "")
+                  << ".\n";
+    }
+    if (!status.ok()) {
+        std::cerr << "Error: " << status.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Parses, executes, and formats the output for a single user command.
  * @details This is the shell's primary command-and-control function. It performs a multi-stage
@@ -86,24 +147,29 @@ size_t find_matching_brace(const std::string &str, size_t start_pos, char open_c
  *
  * @param line The raw, trimmed command string from the user.
  * @param client The client instance used to communicate with the AevumDB daemon.
+ * @param bulk_client The pipelined client used by `import` and `export`.
+ * @return `true` if the command succeeded.
  */
-void process_command(const std::string &line, client::AevumClient &client) {
+bool process_command(const std::string &line, client::AevumClient &client,
+                     client::AsyncAevumClient &bulk_client) {
     try {
         // Built-in infrastructure commands that don't require database context
         if (line == "/health") {
             std::cout << "Health Check: aevumsh is healthy and connected" << std::endl;
-            return;
+            return true;
         }
 
         if (line == "/metrics") {
             std::string metrics_payload = R"({"action":"metrics","auth":"default_client"})";
             std::string response = client.send_request(metrics_payload);
 
+            bool succeeded = false;
             simdjson::dom::parser parser;
             try {
                 simdjson::dom::element doc = parser.parse(response);
                 std::string_view status;
                 if (doc["status"].get_string().get(status) == simdjson::SUCCESS && status == "ok") {
+                    succeeded = true;
                     std::cout << "\nAevumDB Metrics:\n";
                     std::cout << "  Total Requests: "
                               << value_or<int64_t>(doc["metrics"]["total_requests"].get_int64(), 0)
@@ -121,6 +187,16 @@ void process_command(const std::string &line, client::AevumClient &client) {
                     std::cout << "  Bytes Sent: "
                               << value_or<int64_t>(doc["metrics"]["bytes_sent"].get_int64(), 0)
                               << " bytes" << std::endl;
+                    std::cout << "  Result Cache: "
+                              << value_or<int64_t>(
+                                     doc["metrics"]["result_cache_hits"].get_int64(), 0)
+                              << " hits, "
+                              << value_or<int64_t>(
+                                     doc["metrics"]["result_cache_misses"].get_int64(), 0)
+                              << " misses, "
+                              << value_or<int64_t>(
+                                     doc["metrics"]["result_cache_entries"].get_int64(), 0)
+                              << " entries" << std::endl;
                     std::cout << "  Uptime: "
                               << value_or<int64_t>(doc["metrics"]["uptime_seconds"].get_int64(), 0)
                               << " seconds\n"
@@ -134,7 +210,7 @@ void process_command(const std::string &line, client::AevumClient &client) {
             } catch (const simdjson::simdjson_error &e) {
                 std::cerr << "Error parsing metrics response: " << e.what() << std::endl;
             }
-            return;
+            return succeeded;
         }
 
         if (line.rfind("db.create_user(", 0) == 0) {
@@ -144,13 +220,41 @@ void process_command(const std::string &line, client::AevumClient &client) {
             if (std::regex_match(line, user_matches, user_regex) && user_matches.size() == 3) {
                 std::string extra = R"("key":")" + user_matches[1].str() + R"(", "role":")" +
                                     user_matches[2].str() + R"(")";
-                std::cout << client.send_request(client.build_payload("create_user", "", extra))
-                          << std::endl;
-            } else {
-                std::cerr << "Error: Invalid format. Expected: db.create_user(\"<key>\", "
-                             "\"<ADMIN|READ_WRITE|READ_ONLY>\")\n";
+                return print_response(
+                    client.send_request(client.build_payload("create_user", "", extra)));
             }
-            return;
+            std::cerr << "Error: Invalid format. Expected: db.create_user(\"<key>\", "
+                         "\"<ADMIN|READ_WRITE|READ_ONLY>\")\n";
+            return false;
+        }
+
+        if (line.rfind("db.backup(", 0) == 0) {
+            const std::regex backup_regex(
+                R"(db\.backup\(\s*\"([^\"]+)\"\s*(?:,\s*(true|false)\s*)?\))");
+            std::smatch backup_matches;
+            if (std::regex_match(line, backup_matches, backup_regex)) {
+                return print_response(
+                    client.backup(backup_matches[1].str(), backup_matches[2].str() == "true"));
+            }
+            std::cerr << "Error: Invalid format. Expected: db.backup(\"<path>\"[, "
+                         "<incremental>])\n";
+            return false;
+        }
+
+        if (line == "db.backup_status()") {
+            return print_response(client.backup_status());
+        }
+
+        if (line == "db.begin()") {
+            return print_response(client.begin_transaction());
+        }
+
+        if (line == "db.commit()") {
+            return print_response(client.commit_transaction());
+        }
+
+        if (line == "db.abort()") {
+            return print_response(client.abort_transaction());
         }
 
         size_t collection_end = line.find('.', 3);
@@ -162,7 +266,7 @@ void process_command(const std::string &line, client::AevumClient &client) {
         if (line.rfind("db.", 0) != 0 || paren_start == std::string::npos || line.back() != ')' ||
             collection_end == std::string::npos || collection_end <= 3) {
             std::cerr << "Error: Invalid command format. Type 'help' for usage.\n";
-            return;
+            return false;
         }
 
         std::string collection = line.substr(3, collection_end - 3);
@@ -173,6 +277,8 @@ void process_command(const std::string &line, client::AevumClient &client) {
         std::string response;
         if (operation == "insert") {
             response = client.insert(collection, args_str);
+        } else if (operation == "insert_many") {
+            response = client.insert_many(collection, args_str);
         } else if (operation == "find") {
             std::string query = "{}";
             if (!args_str.empty() && args_str[0] == '{') {
@@ -182,36 +288,115 @@ void process_command(const std::string &line, client::AevumClient &client) {
                 }
             }
             response = client.find(collection, query);
-        } else if (operation == "update") {
+        } else if (operation == "update" || operation == "upsert") {
             size_t query_end = find_matching_brace(args_str, 0, '{', '}');
             if (query_end == std::string::npos) {
-                std::cerr << "Error: Malformed query object in update command.\n";
-                return;
+                std::cerr << "Error: Malformed query object in " << operation << " command.\n";
+                return false;
             }
             std::string query = args_str.substr(0, query_end + 1);
 
             size_t update_start = args_str.find('{', query_end + 1);
             if (update_start == std::string::npos) {
-                std::cerr << "Error: Missing update object in update command.\n";
-                return;
+                std::cerr << "Error: Missing update object in " << operation << " command.\n";
+                return false;
             }
             size_t update_end = find_matching_brace(args_str, update_start, '{', '}');
             if (update_end == std::string::npos) {
-                std::cerr << "Error: Malformed update object in update command.\n";
-                return;
+                std::cerr << "Error: Malformed update object in " << operation << " command.\n";
+                return false;
             }
             std::string update = args_str.substr(update_start, update_end - update_start + 1);
-            response = client.update(collection, query, update);
+            response = operation == "update" ? client.update(collection, query, update)
+                                             : client.upsert(collection, query, update);
+        } else if (operation == "explain") {
+            std::string query = "{}", sort = "{}";
+            size_t query_end = std::string::npos;
+            if (!args_str.empty() && args_str[0] == '{') {
+                query_end = find_matching_brace(args_str, 0, '{', '}');
+                if (query_end != std::string::npos) {
+                    query = args_str.substr(0, query_end + 1);
+                }
+            }
+            if (query_end != std::string::npos) {
+                size_t sort_start = args_str.find('{', query_end + 1);
+                if (sort_start != std::string::npos) {
+                    size_t sort_end = find_matching_brace(args_str, sort_start, '{', '}');
+                    if (sort_end == std::string::npos) {
+                        std::cerr << "Error: Malformed sort object in explain command.\n";
+                        return false;
+                    }
+                    sort = args_str.substr(sort_start, sort_end - sort_start + 1);
+                }
+            }
+            response = client.explain(collection, query, sort);
+        } else if (operation == "create_index") {
+            // A trailing options object carries `sparse` and `partial_filter`.
+            std::string index_args = args_str;
+            bool sparse = false;
+            std::string partial_filter;
+            if (size_t options_start = args_str.find('{'); options_start != std::string::npos) {
+                simdjson::dom::parser parser;
+                simdjson::dom::element options;
+                if (find_matching_brace(args_str, options_start, '{', '}') != args_str.size() - 1 ||
+                    parser.parse(args_str.substr(options_start)).get(options) !=
+                        simdjson::SUCCESS ||
+                    !options.is_object()) {
+                    std::cerr << "Error: Malformed options object in create_index command.\n";
+                    return false;
+                }
+                sparse = value_or(options["sparse"].get_bool(), false);
+                if (auto filter = options["partial_filter"]; filter.is_object()) {
+                    partial_filter = simdjson::to_string(filter);
+                }
+                std::string_view prefix = aevum::util::string::trim(
+                    std::string_view(args_str).substr(0, options_start));
+                if (prefix.empty() || prefix.back() != ',') {
+                    std::cerr << "Error: Expected ',' before the create_index options.\n";
+                    return false;
+                }
+                prefix.remove_suffix(1);
+                index_args = std::string(aevum::util::string::trim(prefix));
+            }
+            const std::regex index_regex(
+                R"(\"([^\"]+)\"\s*(?:,\s*\"(hash|ordered|columnar|text)\"\s*)"
+                R"((?:,\s*(\d{1,12})\s*)?)?)");
+            std::smatch index_matches;
+            if (!std::regex_match(index_args, index_matches, index_regex)) {
+                std::cerr << "Error: Invalid format. Expected: db.<coll>.create_index(\"<field>\""
+                             "[, \"hash\"|\"ordered\"|\"columnar\"|\"text\""
+                             "[, <expire_after_seconds>]]"
+                             "[, {\"sparse\": true, \"partial_filter\": {...}}])\n";
+                return false;
+            }
+            std::optional<int64_t> expire_after_seconds;
+            if (index_matches[3].matched) {
+                expire_after_seconds = std::stoll(index_matches[3].str());
+            }
+            response = client.create_index(
+                collection, index_matches[1].str(),
+                index_matches[2].matched ? index_matches[2].str() : std::string("hash"),
+                expire_after_seconds, sparse, partial_filter);
+        } else if (operation == "aggregate") {
+            if (args_str.empty() || args_str[0] != '[' ||
+                find_matching_brace(args_str, 0, '[', ']') != args_str.size() - 1) {
+                std::cerr << "Error: Invalid format. Expected: "
+                             "db.<coll>.aggregate([<stage>, ...])\n";
+                return false;
+            }
+            response = client.aggregate(collection, args_str);
         } else if (operation == "count" || operation == "delete") {
             response = (operation == "count") ? client.count(collection, args_str)
                                               : client.remove(collection, args_str);
+        } else if (operation == "import" || operation == "export") {
+            return run_transfer(operation, collection, args_str, bulk_client);
         } else if (operation == "set_schema") {
             std::string extra = R"("schema":)" + args_str;
             response = client.send_request(client.build_payload("set_schema", collection, extra));
         } else {
             std::cerr << "ERROR: Unknown operation '" << operation
                       << "'. Type 'help' for a list of commands.\n";
-            return;
+            return false;
         }
 
         simdjson::dom::parser parser;
@@ -219,7 +404,7 @@ void process_command(const std::string &line, client::AevumClient &client) {
             simdjson::dom::element doc = parser.parse(response);
             std::string_view status;
             if (doc["status"].get_string().get(status) == simdjson::SUCCESS && status == "ok") {
-                if (operation == "find") {
+                if (operation == "find" || operation == "aggregate") {
                     simdjson::dom::array arr;
                     if (doc["data"].get_array().get(arr) == simdjson::SUCCESS) {
                         std::cout << "Found " << arr.size() << " document(s).\n";
@@ -230,25 +415,52 @@ void process_command(const std::string &line, client::AevumClient &client) {
                 } else if (operation == "insert") {
                     std::cout << "Success: Document inserted with _id: \""
                               << value_or<std::string_view>(doc["_id"].get_string(), "") << "\".\n";
+                } else if (operation == "insert_many") {
+                    std::cout << "Success: "
+                              << value_or<int64_t>(doc["inserted"].get_int64(), 0)
+                              << " document(s) inserted.\n";
+                    simdjson::dom::array results;
+                    if (doc["results"].get_array().get(results) == simdjson::SUCCESS) {
+                        size_t position = 0;
+                        for (auto item : results) {
+                            std::string_view message;
+                            if (item["message"].get_string().get(message) == simdjson::SUCCESS) {
+                                std::cerr << "  [" << position << "] Error: " << message << "\n";
+                            }
+                            ++position;
+                        }
+                    }
                 } else if (operation == "update") {
                     std::cout << "Success: "
                               << value_or<int64_t>(doc["updated_count"].get_int64(), 0)
                               << " document(s) updated.\n";
+                } else if (operation == "upsert") {
+                    std::string_view upserted_id;
+                    if (doc["upserted_id"].get_string().get(upserted_id) == simdjson::SUCCESS) {
+                        std::cout << "Success: Document inserted with _id: \"" << upserted_id
+                                  << "\".\n";
+                    } else {
+                        std::cout << "Success: "
+                                  << value_or<int64_t>(doc["updated_count"].get_int64(), 0)
+                                  << " document(s) updated.\n";
+                    }
                 } else if (operation == "delete") {
                     std::cout << "Success: "
                               << value_or<int64_t>(doc["deleted_count"].get_int64(), 0)
                               << " document(s) removed.\n";
                 } else if (operation == "count") {
                     std::cout << value_or<int64_t>(doc["count"].get_int64(), 0) << std::endl;
+                } else if (operation == "explain") {
+                    std::cout << simdjson::to_string(doc["plan"]) << std::endl;
                 } else {
                     std::cout << "Success: Operation '" << operation << "' completed.\n";
                 }
-            } else {
-                std::cerr << "Error: "
-                          << value_or<std::string_view>(doc["message"].get_string(),
-                                                        "An unknown error occurred.")
-                          << std::endl;
+                return true;
             }
+            std::cerr << "Error: "
+                      << value_or<std::string_view>(doc["message"].get_string(),
+                                                    "An unknown error occurred.")
+                      << std::endl;
         } catch (...) {
             std::cout << response << std::endl;
         }
@@ -256,6 +468,7 @@ void process_command(const std::string &line, client::AevumClient &client) {
     } catch (const std::exception &e) {
         std::cerr << "An unexpected internal error occurred: " << e.what() << std::endl;
     }
+    return false;
 }
 
 }  // namespace aevum::shell::parser
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "aevum/client/aevum_client.hpp"
+#include "aevum/client/async_aevum_client.hpp"
 
 /**
  * @namespace aevum::shell::parser
@@ -35,10 +36,18 @@ namespace aevum::shell::parser {
  * from the client, parses it, and formats it into a human-readable summary for printing to
  * the console.
  *
+ * `import` and `export` stream a file of documents through `bulk_client` instead, with several
+ * batches in flight (see `bulk_transfer.hpp`).
+ *
  * @param line The complete, trimmed command line string provided by the user.
  * @param client A reference to the active `AevumClient` instance, which will be used to
  *        execute the command against the database server.
+ * @param bulk_client The pipelined client that carries the batches of `import` and `export`.
+ * @return `true` if the command succeeded; `false` if it was malformed, the server reported an
+ *         error, or a transfer did not move every document. Batch mode exits with an error
+ *         status if any command returned `false`.
  */
-void process_command(const std::string &line, client::AevumClient &client);
+bool process_command(const std::string &line, client::AevumClient &client,
+                     client::AsyncAevumClient &bulk_client);
 
 }  // namespace aevum::shell::parser
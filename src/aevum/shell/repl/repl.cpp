@@ -38,13 +38,33 @@ void print_help() {
               << "Data Operations:\n"
               << "  db.<coll>.find(<query>)       Find documents matching the query\n"
               << "  db.<coll>.insert(<doc>)       Insert a new document into the collection\n"
+              << "  db.<coll>.insert_many([...])  Insert an array of documents in one batch\n"
               << "  db.<coll>.update(<q>, <u>)    Update documents matching the query\n"
+              << "  db.<coll>.upsert(<q>, <d>)    Update matches, or insert <d> if none\n"
               << "  db.<coll>.delete(<query>)     Delete documents matching the query\n"
-              << "  db.<coll>.count(<query>)      Count documents matching the query\n\n"
+              << "  db.<coll>.count(<query>)      Count documents matching the query\n"
+              << "  db.<coll>.aggregate([...])    Run an aggregation pipeline on the server\n"
+              << "  db.<coll>.explain(<q>, <s>)   Show the access path chosen for the query\n\n"
+              << "Transactions:\n"
+              << "  db.begin()                    Stage the following writes in a transaction\n"
+              << "  db.commit()                   Apply the staged writes together\n"
+              << "  db.abort()                    Discard the staged writes\n\n"
               << "Administrative:\n"
               << "  db.<coll>.set_schema(<json>)  Set validation schema for a collection\n"
+              << "  db.<coll>.create_index(f, t)  Index field f; t is hash/ordered/columnar/text\n"
+              << "  db.<coll>.create_index(f, \"ordered\", s)\n"
+              << "                                TTL index: expire s seconds after time f\n"
+              << "  db.<coll>.create_index(f, t, {\"sparse\": true})\n"
+              << "                                Sparse or partial (\"partial_filter\") index\n"
               << "  db.create_user(u, r)          Create a database user with a role\n"
-              << "                                Roles: ADMIN, READ_WRITE, READ_ONLY\n\n"
+              << "                                Roles: ADMIN, READ_WRITE, READ_ONLY\n"
+              << "  db.backup(p[, incremental])   Back up the data directory into server path p\n"
+              << "  db.backup_status()            Show the progress of the last backup\n\n"
+              << "Bulk Transfer:\n"
+              << "  db.<coll>.import(\"<file>\")    Insert every document of an NDJSON or .bson\n"
+              << "                                file, several batches in flight\n"
+              << "  db.<coll>.export(\"<file>\"[, <query>])\n"
+              << "                                Write the matching documents to a file\n\n"
               << "Infrastructure:\n"
               << "  /health                       Display shell and server health status\n"
               << "  /metrics                      Retrieve real-time performance metrics\n\n"
@@ -58,8 +78,9 @@ void print_help() {
  *
  * @param client A reference to the initialized `AevumClient` which maintains the active
  *        network session with the AevumDB daemon.
+ * @param bulk_client The pipelined client used by `import` and `export`.
  */
-void run(client::AevumClient &client) {
+void run(client::AevumClient &client, client::AsyncAevumClient &bulk_client) {
     const char *history_file = ".aevum_history";
     std::string history_path;
 
@@ -118,10 +139,38 @@ void run(client::AevumClient &client) {
             }
 
             // Delegate database-specific operations to the dedicated command parser.
-            parser::process_command(trimmed_line, client);
+            parser::process_command(trimmed_line, client, bulk_client);
         }
         free(line);
     }
 }
 
+/**
+ * @brief Runs a script of shell commands, stopping at the first that fails.
+ * @param script The commands, one per line.
+ * @param client The connected client that runs the commands.
+ * @param bulk_client The pipelined client used by `import` and `export`.
+ * @return `true` if every command run succeeded.
+ */
+bool run_script(std::istream &script, client::AevumClient &client,
+                client::AsyncAevumClient &bulk_client) {
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(script, line)) {
+        ++line_number;
+        std::string trimmed_line(aevum::util::string::trim(line));
+        if (trimmed_line.empty() || trimmed_line[0] == '#' || trimmed_line.rfind("//", 0) == 0) {
+            continue;
+        }
+        if (trimmed_line == "exit" || trimmed_line == "quit") break;
+        if (trimmed_line == "help" || trimmed_line == "clear") continue;
+        if (!parser::process_command(trimmed_line, client, bulk_client)) {
+            std::cerr << "Error: Command on line " << line_number << " failed; stopping."
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace aevum::shell::repl
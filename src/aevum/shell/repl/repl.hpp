@@ -12,12 +12,14 @@
  */
 #pragma once
 
+#include <istream>
 #include <string>
 
 // Forward-declare AevumClient to avoid including the full header, which helps
 // reduce compilation times and prevent potential circular dependencies.
 namespace aevum::client {
 class AevumClient;
+class AsyncAevumClient;
 }
 
 namespace aevum::shell::repl {
@@ -40,7 +42,21 @@ void print_help();
  * The loop continues until the user signals an exit (e.g., by typing 'exit' or via Ctrl+D).
  * @param client A reference to an active and connected `AevumClient` instance, which will be
  *        used to send all database commands to the server.
+ * @param bulk_client The pipelined client used by `import` and `export`.
  */
-void run(client::AevumClient &client);
+void run(client::AevumClient &client, client::AsyncAevumClient &bulk_client);
+
+/**
+ * @brief Runs the commands of a script without prompting, for the shell's batch mode.
+ * @details Each line holds one command, as typed at the prompt. Blank lines and lines starting
+ * with `#` or `//` are skipped, `exit` and `quit` end the script, and `help` and `clear` are
+ * ignored. The script stops at the first command that fails, naming its line on standard error.
+ * @param script The commands, one per line.
+ * @param client The connected client that runs the commands.
+ * @param bulk_client The pipelined client used by `import` and `export`.
+ * @return `true` if every command run succeeded.
+ */
+bool run_script(std::istream &script, client::AevumClient &client,
+                client::AsyncAevumClient &bulk_client);
 
 }  // namespace aevum::shell::repl
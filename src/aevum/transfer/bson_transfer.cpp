@@ -0,0 +1,752 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bson_transfer.cpp
+ * @brief Implements the dump and restore of collections as BSON stream files.
+ */
+#include "aevum/transfer/bson_transfer.hpp"
+
+#include <bson/bson.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include "aevum/bson/doc/document.hpp"
+#include "aevum/db/core/core.hpp"
+#include "aevum/db/index/index_image.hpp"
+#include "aevum/db/index/index_key.hpp"
+#include "aevum/db/index/index_persistor.hpp"
+#include "aevum/db/index/primary_indexer.hpp"
+#include "aevum/db/storage/wiredtiger_store.hpp"
+#include "aevum/util/concurrency/thread_pool.hpp"
+#include "aevum/util/defer.hpp"
+#include "aevum/util/log/logger.hpp"
+#include "aevum/util/memory/mapped_file.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+#include "aevum/util/uuid/v4.hpp"
+
+namespace aevum::transfer {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// The documents a dump reads from its cursor at a time.
+constexpr size_t DUMP_BATCH_SIZE = 1024;
+
+/// The write buffer of a dump file, large enough to keep the writes sequential and few.
+constexpr size_t DUMP_BUFFER_SIZE = 4 << 20;
+
+/// The smallest BSON document: its length and the terminating NUL.
+constexpr uint32_t MIN_DOCUMENT_SIZE = 5;
+
+/**
+ * @brief Returns the message of the current `errno`.
+ * @param what The operation that failed.
+ * @param path The file it failed on.
+ * @return `"<what> '<path>': <strerror>"`.
+ */
+std::string errno_message(const char *what, const std::string &path) {
+    return std::string(what) + " '" + path + "': " + std::strerror(errno);
+}
+
+/**
+ * @brief Returns the path of a dump file of a collection.
+ * @param directory The dump directory.
+ * @param collection The name of the collection.
+ * @param extension `DOCUMENTS_EXTENSION` or `METADATA_EXTENSION`.
+ * @return The path.
+ */
+std::string dump_path(const std::string &directory, const std::string &collection,
+                      const char *extension) {
+    return (fs::path(directory) / (collection + extension)).string();
+}
+
+/**
+ * @brief Checks whether a file name ends with an extension and has a stem before it.
+ * @param name The file name.
+ * @param extension The extension.
+ * @return `true` if `name` is longer than `extension` and ends with it.
+ */
+bool has_suffix(std::string_view name, std::string_view extension) {
+    return name.size() > extension.size() &&
+           name.substr(name.size() - extension.size()) == extension;
+}
+
+/**
+ * @brief Returns the number of workers of a transfer.
+ * @param threads The configured number, or 0 for one per hardware thread.
+ * @param collections The number of collections to transfer.
+ * @return The number of workers, between 1 and `collections`.
+ */
+size_t worker_count(size_t threads, size_t collections) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(threads, collections));
+}
+
+/**
+ * @brief Picks the collections of a transfer from those available.
+ * @param requested The collections asked for; empty for all of them.
+ * @param available The collections available, in name order.
+ * @param selected Receives the collections to transfer, in name order.
+ * @return `aevum::util::Status::OK()`, or `NotFound` naming a requested collection that is not
+ *         available.
+ */
+aevum::util::Status select_collections(const std::vector<std::string> &requested,
+                                       const std::vector<std::string> &available,
+                                       std::vector<std::string> &selected) {
+    if (requested.empty()) {
+        selected = available;
+        return aevum::util::Status::OK();
+    }
+    for (const auto &name : requested) {
+        if (!std::binary_search(available.begin(), available.end(), name)) {
+            return aevum::util::Status::NotFound("Collection '" + name + "' not found");
+        }
+        selected.push_back(name);
+    }
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Runs a transfer over collections on a pool of workers.
+ * @param collections The collections, in name order.
+ * @param threads The configured number of workers.
+ * @param name_prefix The name of the workers.
+ * @param transfer Transfers one collection into its result.
+ * @param results Receives the result of every collection, in the order of `collections`.
+ * @return `aevum::util::Status::OK()` if every transfer succeeded, or the status of the first
+ *         failed one, in collection order.
+ */
+template <typename F>
+aevum::util::Status run_transfers(const std::vector<std::string> &collections, size_t threads,
+                                  const std::string &name_prefix, F &&transfer,
+                                  std::vector<CollectionTransfer> &results) {
+    results.assign(collections.size(), CollectionTransfer{});
+    std::vector<std::future<aevum::util::Status>> futures;
+    futures.reserve(collections.size());
+    {
+        aevum::util::concurrency::ThreadPool pool(name_prefix,
+                                                  worker_count(threads, collections.size()));
+        for (size_t i = 0; i < collections.size(); ++i) {
+            futures.push_back(pool.enqueue([&, i]() {
+                aevum::util::time::Stopwatch stopwatch;
+                results[i].collection = collections[i];
+                aevum::util::Status status = transfer(collections[i], results[i]);
+                results[i].elapsed_ms = stopwatch.elapsed_ms();
+                return status;
+            }));
+        }
+    }
+    for (auto &future : futures) {
+        if (aevum::util::Status status = future.get(); !status.ok()) return status;
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @class DumpFile
+ * @brief A dump file written under a temporary name and renamed into place once complete, so an
+ * interrupted dump never leaves a truncated file behind under the final name.
+ */
+class DumpFile {
+  public:
+    /**
+     * @brief Creates the temporary file.
+     * @param path The final path of the file.
+     */
+    explicit DumpFile(std::string path)
+        : path_(std::move(path)), temp_path_(path_ + ".tmp"),
+          file_(std::fopen(temp_path_.c_str(), "wb")) {
+        if (file_) std::setvbuf(file_, nullptr, _IOFBF, DUMP_BUFFER_SIZE);
+    }
+
+    /**
+     * @brief Removes the temporary file unless it was committed.
+     */
+    ~DumpFile() {
+        if (file_) {
+            std::fclose(file_);
+            std::remove(temp_path_.c_str());
+        }
+    }
+
+    DumpFile(const DumpFile &) = delete;
+    DumpFile &operator=(const DumpFile &) = delete;
+
+    /**
+     * @brief Returns whether the file was created.
+     * @return `true` if it can be written.
+     */
+    [[nodiscard]] bool is_open() const noexcept { return file_ != nullptr; }
+
+    /**
+     * @brief Appends bytes to the file.
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * @return `true` if they were written.
+     */
+    bool write(const void *data, size_t size) noexcept {
+        return std::fwrite(data, 1, size, file_) == size;
+    }
+
+    /**
+     * @brief Closes the file and renames it to its final path.
+     * @return `aevum::util::Status::OK()`, or an `IOError` if the file cannot be completed.
+     */
+    aevum::util::Status commit() {
+        FILE *file = file_;
+        file_ = nullptr;
+        if (std::fclose(file) != 0) {
+            std::remove(temp_path_.c_str());
+            return aevum::util::Status::IOError(errno_message("Cannot write", temp_path_));
+        }
+        if (std::rename(temp_path_.c_str(), path_.c_str()) != 0) {
+            std::remove(temp_path_.c_str());
+            return aevum::util::Status::IOError(errno_message("Cannot rename", temp_path_));
+        }
+        return aevum::util::Status::OK();
+    }
+
+    /**
+     * @brief Returns the path of the file being written, for messages.
+     * @return The temporary path.
+     */
+    [[nodiscard]] const std::string &temp_path() const noexcept { return temp_path_; }
+
+  private:
+    /// The final path of the file.
+    std::string path_;
+    /// The path the file is written under.
+    std::string temp_path_;
+    /// The open file, or `nullptr` once committed or if it could not be created.
+    FILE *file_;
+};
+
+/**
+ * @brief Builds the metadata document of a collection.
+ * @param collection The name of the collection.
+ * @param documents The number of documents dumped.
+ * @param indexes The indexed fields of the collection and their types, in field order.
+ * @param ttls The `expire_after_seconds` of the collection's TTL indexes.
+ * @param options The options of the collection's sparse and partial indexes.
+ * @param schema The `_schemas` record of the collection, or `nullptr` if it has no schema.
+ * @param key_format The key format of the collection's table.
+ * @return The metadata document.
+ */
+aevum::bson::doc::Document metadata_document(
+    const std::string &collection, uint64_t documents,
+    const std::map<std::string, aevum::db::index::IndexType> &indexes,
+    const std::unordered_map<std::string, int64_t> *ttls,
+    const std::unordered_map<std::string, aevum::db::index::IndexOptions> *options,
+    const bson_t *schema, aevum::db::storage::KeyFormat key_format) {
+    bson_t *b = bson_new();
+    BSON_APPEND_UTF8(b, "collection", collection.c_str());
+    BSON_APPEND_INT64(b, "count", static_cast<int64_t>(documents));
+    std::string key_format_name(aevum::db::storage::to_string(key_format));
+    BSON_APPEND_UTF8(b, "keyFormat", key_format_name.c_str());
+
+    bson_t array;
+    BSON_APPEND_ARRAY_BEGIN(b, "indexes", &array);
+    size_t position = 0;
+    for (const auto &[field, type] : indexes) {
+        std::string key = std::to_string(position++);
+        bson_t index;
+        bson_append_document_begin(&array, key.c_str(), -1, &index);
+        BSON_APPEND_UTF8(&index, "field", field.c_str());
+        std::string type_name(aevum::db::index::to_string(type));
+        BSON_APPEND_UTF8(&index, "type", type_name.c_str());
+        if (ttls) {
+            if (auto it = ttls->find(field); it != ttls->end()) {
+                BSON_APPEND_INT64(&index, "expire_after_seconds", it->second);
+            }
+        }
+        if (options) {
+            if (auto it = options->find(field); it != options->end()) {
+                if (it->second.sparse) BSON_APPEND_BOOL(&index, "sparse", true);
+                if (!it->second.partial_filter.empty()) {
+                    BSON_APPEND_UTF8(&index, "partial_filter", it->second.partial_filter.c_str());
+                }
+            }
+        }
+        bson_append_document_end(&array, &index);
+    }
+    bson_append_array_end(b, &array);
+
+    if (schema) {
+        bson_t rules;
+        BSON_APPEND_DOCUMENT_BEGIN(b, "schema", &rules);
+        bson_copy_to_excluding_noinit(schema, &rules, "collection", nullptr);
+        bson_append_document_end(b, &rules);
+    }
+    return aevum::bson::doc::Document(b);
+}
+
+/**
+ * @brief Splits a document stream into documents keyed by `_id`.
+ * @details Every document is validated. In a string-keyed collection, a document without a
+ * string `_id` is copied with a generated UUIDv4 `_id` first, as `insert` would give it; the
+ * copies are kept in `owned`. In an integer-keyed collection every document must have an integer
+ * `_id`, keyed by its decimal form, since none can be generated. The other documents are
+ * referenced in place.
+ * @param data The stream.
+ * @param size The length of the stream.
+ * @param path The path of the stream, for messages.
+ * @param key_format The key format of the collection.
+ * @param documents Receives the `(_id, BSON bytes)` pairs, in stream order.
+ * @param owned Receives the rewritten documents.
+ * @return `aevum::util::Status::OK()`, or `Corruption` at the first malformed document or, in an
+ *         integer-keyed collection, the first document without an integer `_id`.
+ */
+aevum::util::Status split_documents(
+    const uint8_t *data, size_t size, const std::string &path,
+    aevum::db::storage::KeyFormat key_format,
+    std::vector<std::pair<std::string, std::string_view>> &documents,
+    std::deque<std::string> &owned) {
+    size_t offset = 0;
+    while (offset < size) {
+        uint32_t length = 0;
+        if (size - offset >= sizeof(length)) std::memcpy(&length, data + offset, sizeof(length));
+        length = BSON_UINT32_FROM_LE(length);
+        if (length < MIN_DOCUMENT_SIZE || length > size - offset) {
+            return aevum::util::Status::Corruption("Truncated document at offset " +
+                                                   std::to_string(offset) + " of '" + path + "'");
+        }
+
+        bson_t doc;
+        size_t error_offset = 0;
+        if (!bson_init_static(&doc, data + offset, length) ||
+            !bson_validate(&doc, BSON_VALIDATE_NONE, &error_offset)) {
+            return aevum::util::Status::Corruption("Invalid document at offset " +
+                                                   std::to_string(offset) + " of '" + path + "'");
+        }
+
+        std::string_view bytes(reinterpret_cast<const char *>(data + offset), length);
+        bson_iter_t iter;
+        bool has_id = bson_iter_init_find(&iter, &doc, "_id");
+        if (key_format == aevum::db::storage::KeyFormat::INT64) {
+            if (!has_id || !(BSON_ITER_HOLDS_INT32(&iter) || BSON_ITER_HOLDS_INT64(&iter))) {
+                return aevum::util::Status::Corruption("Document without an integer _id at "
+                                                       "offset " + std::to_string(offset) +
+                                                       " of '" + path + "'");
+            }
+            documents.emplace_back(aevum::db::index::PrimaryIndexer::to_id_key(iter), bytes);
+        } else if (has_id && BSON_ITER_HOLDS_UTF8(&iter)) {
+            documents.emplace_back(bson_iter_utf8(&iter, nullptr), bytes);
+        } else {
+            std::string id = aevum::util::uuid::generate_v4();
+            bson_t *with_id = bson_new();
+            BSON_APPEND_UTF8(with_id, "_id", id.c_str());
+            bson_copy_to_excluding_noinit(&doc, with_id, "_id", nullptr);
+            owned.emplace_back(reinterpret_cast<const char *>(bson_get_data(with_id)),
+                               with_id->len);
+            bson_destroy(with_id);
+            documents.emplace_back(std::move(id), owned.back());
+        }
+        offset += length;
+    }
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Sorts documents by `_id` and keeps the last of each run of equal ids, as re-inserting
+ * them one at a time in stream order would.
+ * @details The order is the one the table's bulk cursor expects: byte order for string keys,
+ * numeric order for the decimal keys of an integer-keyed collection.
+ * @param documents The documents; sorted and deduplicated in place.
+ * @param key_format The key format of the collection.
+ */
+void sort_by_id(std::vector<std::pair<std::string, std::string_view>> &documents,
+                aevum::db::storage::KeyFormat key_format) {
+    if (key_format == aevum::db::storage::KeyFormat::INT64) {
+        std::vector<std::pair<int64_t, size_t>> order;
+        order.reserve(documents.size());
+        for (size_t i = 0; i < documents.size(); ++i) {
+            order.emplace_back(std::stoll(documents[i].first), i);
+        }
+        std::sort(order.begin(), order.end());
+        std::vector<std::pair<std::string, std::string_view>> sorted;
+        sorted.reserve(documents.size());
+        for (const auto &[value, position] : order) {
+            sorted.push_back(std::move(documents[position]));
+        }
+        documents = std::move(sorted);
+    } else {
+        std::stable_sort(documents.begin(), documents.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (i + 1 < documents.size() && documents[i + 1].first == documents[i].first) continue;
+        if (kept != i) documents[kept] = std::move(documents[i]);
+        ++kept;
+    }
+    documents.resize(kept);
+}
+
+/**
+ * @brief Reads the metadata document of a collection.
+ * @param path The path of the metadata file.
+ * @param metadata Receives the document.
+ * @return `aevum::util::Status::OK()`, `NotFound` if the file does not exist, or `Corruption` if
+ *         it does not hold one valid document.
+ */
+aevum::util::Status read_metadata(const std::string &path, aevum::bson::doc::Document &metadata) {
+    if (!fs::exists(path)) return aevum::util::Status::NotFound("No metadata file '" + path + "'");
+    aevum::util::memory::MappedFile file;
+    if (auto status = file.open(path); !status.ok()) return status;
+
+    uint32_t length = 0;
+    if (file.size() >= sizeof(length)) std::memcpy(&length, file.data(), sizeof(length));
+    length = BSON_UINT32_FROM_LE(length);
+    bson_t doc;
+    size_t error_offset = 0;
+    if (length != file.size() || !bson_init_static(&doc, file.data(), length) ||
+        !bson_validate(&doc, BSON_VALIDATE_NONE, &error_offset)) {
+        return aevum::util::Status::Corruption("Invalid metadata file '" + path + "'");
+    }
+    metadata = aevum::bson::doc::Document(bson_copy(&doc));
+    return aevum::util::Status::OK();
+}
+
+/**
+ * @brief Reads the key format a metadata document records.
+ * @param metadata The metadata document, empty if the collection has none.
+ * @return The key format; `STRING` for dumps that predate integer-keyed collections.
+ */
+aevum::db::storage::KeyFormat metadata_key_format(const aevum::bson::doc::Document &metadata) {
+    bson_iter_t iter;
+    if (!metadata.empty() && bson_iter_init_find(&iter, metadata.get(), "keyFormat") &&
+        BSON_ITER_HOLDS_UTF8(&iter)) {
+        if (auto format =
+                aevum::db::storage::key_format_from_string(bson_iter_utf8(&iter, nullptr))) {
+            return *format;
+        }
+    }
+    return aevum::db::storage::KeyFormat::STRING;
+}
+
+/**
+ * @brief Creates the schema and the indexes a metadata document records.
+ * @param core The engine of the restored data directory.
+ * @param collection The name of the collection.
+ * @param metadata The metadata document.
+ * @param indexes Receives the number of indexes created.
+ * @return `aevum::util::Status::OK()`, `Corruption` for a malformed index, or the status of the
+ *         failed creation.
+ */
+aevum::util::Status apply_metadata(aevum::db::Core &core, const std::string &collection,
+                                   const aevum::bson::doc::Document &metadata, size_t &indexes) {
+    bson_iter_t iter;
+    bson_iter_t child;
+    if (bson_iter_init_find(&iter, metadata.get(), "schema") && BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+        uint32_t length = 0;
+        const uint8_t *data = nullptr;
+        bson_iter_document(&iter, &length, &data);
+        aevum::bson::doc::Document schema(bson_new_from_data(data, length));
+        if (auto status = core.set_schema(collection, schema); !status.ok()) return status;
+    }
+
+    if (!bson_iter_init_find(&iter, metadata.get(), "indexes") || !BSON_ITER_HOLDS_ARRAY(&iter) ||
+        !bson_iter_recurse(&iter, &child)) {
+        return aevum::util::Status::OK();
+    }
+    while (bson_iter_next(&child)) {
+        bson_iter_t field;
+        std::string name;
+        std::optional<aevum::db::index::IndexType> type;
+        std::optional<int64_t> expire_after_seconds;
+        aevum::db::index::IndexOptions index_options;
+        if (BSON_ITER_HOLDS_DOCUMENT(&child) && bson_iter_recurse(&child, &field)) {
+            while (bson_iter_next(&field)) {
+                std::string_view key = bson_iter_key(&field);
+                if (key == "field" && BSON_ITER_HOLDS_UTF8(&field)) {
+                    name = bson_iter_utf8(&field, nullptr);
+                } else if (key == "type" && BSON_ITER_HOLDS_UTF8(&field)) {
+                    type = aevum::db::index::index_type_from_string(
+                        bson_iter_utf8(&field, nullptr));
+                } else if (key == "expire_after_seconds" &&
+                           (BSON_ITER_HOLDS_INT64(&field) || BSON_ITER_HOLDS_INT32(&field))) {
+                    expire_after_seconds = bson_iter_as_int64(&field);
+                } else if (key == "sparse" && BSON_ITER_HOLDS_BOOL(&field)) {
+                    index_options.sparse = bson_iter_bool(&field);
+                } else if (key == "partial_filter" && BSON_ITER_HOLDS_UTF8(&field)) {
+                    index_options.partial_filter = bson_iter_utf8(&field, nullptr);
+                }
+            }
+        }
+        if (name.empty() || !type) {
+            return aevum::util::Status::Corruption("Malformed index in the metadata of '" +
+                                                   collection + "'");
+        }
+        if (auto status =
+                core.create_index(collection, name, *type, expire_after_seconds, index_options);
+            !status.ok()) {
+            return status;
+        }
+        ++indexes;
+    }
+    return aevum::util::Status::OK();
+}
+
+}  // namespace
+
+/**
+ * @brief Writes the user collections of a data directory to dump files.
+ * @details The index definitions and schemas are read once up front; each worker then streams
+ * its collection's table through `scan_collection` and writes the raw BSON of every document.
+ * @param options The data directory, the target directory, and the collections.
+ * @param results Receives the outcome of every collection dumped.
+ * @return `aevum::util::Status::OK()` once every collection is dumped, or the first failure.
+ */
+aevum::util::Status dump(const TransferOptions &options,
+                         std::vector<CollectionTransfer> &results) {
+    if (!fs::is_directory(options.db_path)) {
+        return aevum::util::Status::NotFound("Data directory '" + options.db_path +
+                                             "' not found");
+    }
+    std::error_code ec;
+    fs::create_directories(options.directory, ec);
+    if (ec) {
+        return aevum::util::Status::IOError("Cannot create '" + options.directory +
+                                            "': " + ec.message());
+    }
+
+    aevum::db::storage::WiredTigerStore store(options.db_path);
+    if (auto status = store.init(); !status.ok()) return status;
+
+    std::vector<std::string> available;
+    for (auto &name : store.list_collections()) {
+        if (!name.empty() && name[0] != '_') available.push_back(std::move(name));
+    }
+    std::sort(available.begin(), available.end());
+    std::vector<std::string> collections;
+    if (auto status = select_collections(options.collections, available, collections);
+        !status.ok()) {
+        return status;
+    }
+
+    aevum::db::index::IndexDefinitions definitions;
+    aevum::db::index::TtlDefinitions ttls;
+    aevum::db::index::IndexOptionDefinitions index_options;
+    aevum::db::index::IndexPersistor persistor(store);
+    if (!persistor.load_index_definitions(definitions, ttls, index_options)) {
+        return aevum::util::Status::IOError("Failed to read the index definitions");
+    }
+    std::unordered_map<std::string, aevum::bson::doc::Document> schemas;
+    for (auto &doc : store.load_collection("_schemas")) {
+        bson_iter_t iter;
+        if (bson_iter_init_find(&iter, doc.get(), "collection") && BSON_ITER_HOLDS_UTF8(&iter)) {
+            schemas.emplace(bson_iter_utf8(&iter, nullptr), std::move(doc));
+        }
+    }
+
+    auto dump_collection = [&](const std::string &collection, CollectionTransfer &result) {
+        DumpFile documents(dump_path(options.directory, collection, DOCUMENTS_EXTENSION));
+        if (!documents.is_open()) {
+            return aevum::util::Status::IOError(errno_message("Cannot create",
+                                                              documents.temp_path()));
+        }
+        bool written = true;
+        auto status = store.scan_collection(
+            collection, DUMP_BATCH_SIZE, [&](std::vector<aevum::bson::doc::Document> &batch) {
+                for (const auto &doc : batch) {
+                    const bson_t *b = doc.get();
+                    if (!documents.write(bson_get_data(b), b->len)) return written = false;
+                    result.bytes += b->len;
+                }
+                result.documents += batch.size();
+                return true;
+            });
+        if (!status.ok()) return status;
+        if (!written) {
+            return aevum::util::Status::IOError(errno_message("Cannot write",
+                                                              documents.temp_path()));
+        }
+
+        std::map<std::string, aevum::db::index::IndexType> indexes;
+        if (auto it = definitions.find(collection); it != definitions.end()) {
+            indexes.insert(it->second.begin(), it->second.end());
+        }
+        auto ttl_it = ttls.find(collection);
+        auto options_it = index_options.find(collection);
+        auto schema_it = schemas.find(collection);
+        aevum::bson::doc::Document metadata = metadata_document(
+            collection, result.documents, indexes,
+            ttl_it != ttls.end() ? &ttl_it->second : nullptr,
+            options_it != index_options.end() ? &options_it->second : nullptr,
+            schema_it != schemas.end() ? schema_it->second.get() : nullptr,
+            store.key_format(collection));
+        result.indexes = indexes.size();
+
+        DumpFile metadata_file(dump_path(options.directory, collection, METADATA_EXTENSION));
+        if (!metadata_file.is_open() ||
+            !metadata_file.write(bson_get_data(metadata.get()), metadata.get()->len)) {
+            return aevum::util::Status::IOError(errno_message("Cannot write",
+                                                              metadata_file.temp_path()));
+        }
+        if (auto commit_status = documents.commit(); !commit_status.ok()) return commit_status;
+        return metadata_file.commit();
+    };
+
+    AEVUM_LOG_INFO("Transfer: Dumping " + std::to_string(collections.size()) +
+                   " collections from '" + options.db_path + "' to '" + options.directory + "'.");
+    return run_transfers(collections, options.threads, "Dump", dump_collection, results);
+}
+
+/**
+ * @brief Loads the dump files of a directory into a data directory.
+ * @details The tables are loaded by a bare `WiredTigerStore`, which is closed before a `Core` is
+ * opened on the directory to create the schemas and indexes, since WiredTiger allows one
+ * connection per directory. The `_id` filters stored by the directory's last server are
+ * discarded, as they do not cover the restored documents; the server rebuilds them.
+ * @param options The data directory, the dump directory, and the collections.
+ * @param results Receives the outcome of every collection restored.
+ * @return `aevum::util::Status::OK()` once every collection is restored, or the first failure.
+ */
+aevum::util::Status restore(const TransferOptions &options,
+                            std::vector<CollectionTransfer> &results) {
+    std::error_code ec;
+    std::vector<std::string> available;
+    for (const auto &entry : fs::directory_iterator(options.directory, ec)) {
+        std::string name = entry.path().filename().string();
+        if (!entry.is_regular_file() || !has_suffix(name, DOCUMENTS_EXTENSION) ||
+            has_suffix(name, METADATA_EXTENSION)) {
+            continue;
+        }
+        available.push_back(name.substr(0, name.size() - std::strlen(DOCUMENTS_EXTENSION)));
+    }
+    if (ec) {
+        return aevum::util::Status::IOError("Cannot read '" + options.directory +
+                                            "': " + ec.message());
+    }
+    std::sort(available.begin(), available.end());
+    std::vector<std::string> collections;
+    if (auto status = select_collections(options.collections, available, collections);
+        !status.ok()) {
+        return status;
+    }
+    for (const auto &collection : collections) {
+        if (collection.empty() || collection[0] == '_') {
+            return aevum::util::Status::InvalidArgument("Cannot restore system collection '" +
+                                                        collection + "'");
+        }
+    }
+
+    std::vector<aevum::bson::doc::Document> metadata(collections.size());
+    for (size_t i = 0; i < collections.size(); ++i) {
+        std::string path = dump_path(options.directory, collections[i], METADATA_EXTENSION);
+        auto status = read_metadata(path, metadata[i]);
+        if (status.code() == aevum::util::StatusCode::kNotFound) continue;
+        if (!status.ok()) return status;
+    }
+
+    // The tables are created with the key formats of the dumped ones.
+    aevum::db::storage::StorageOptions storage_options;
+    for (size_t i = 0; i < collections.size(); ++i) {
+        auto key_format = metadata_key_format(metadata[i]);
+        if (key_format != aevum::db::storage::KeyFormat::STRING) {
+            storage_options.collection_key_formats[collections[i]] = key_format;
+        }
+    }
+
+    {
+        aevum::db::storage::WiredTigerStore store(options.db_path, storage_options);
+        if (auto status = store.init(); !status.ok()) return status;
+
+        aevum::db::index::IndexDefinitions definitions;
+        aevum::db::index::TtlDefinitions ttls;
+        aevum::db::index::IndexOptionDefinitions index_options;
+        aevum::db::index::IndexPersistor persistor(store);
+        if (!persistor.load_index_definitions(definitions, ttls, index_options)) {
+            return aevum::util::Status::IOError("Failed to read the index definitions");
+        }
+        std::vector<std::string> tables = store.list_collections();
+        std::unordered_set<std::string> existing(tables.begin(), tables.end());
+
+        // The tables are checked before any is loaded, so a refused restore writes nothing.
+        for (const auto &collection : collections) {
+            if (definitions.count(collection) != 0) {
+                return aevum::util::Status::InvalidArgument("Collection '" + collection +
+                                                            "' already has indexes");
+            }
+            if (existing.count(collection) == 0) continue;
+            bool empty = true;
+            auto status = store.scan_keys(collection, [&](std::string_view) {
+                return empty = false;
+            });
+            if (!status.ok()) return status;
+            if (!empty) {
+                return aevum::util::Status::InvalidArgument("Collection '" + collection +
+                                                            "' is not empty");
+            }
+            // Dropping the empty table closes the cursors cached on it, which would otherwise
+            // keep the bulk cursor from opening.
+            if (status = store.drop_collection(collection); !status.ok()) return status;
+        }
+        // The restored documents bypass the change log, so an image left by an earlier server
+        // of an empty collection would still look current.
+        for (const auto &collection : collections) {
+            fs::remove(aevum::db::index::IndexImage::path(options.db_path, collection), ec);
+        }
+
+        auto load_collection = [&](const std::string &collection, CollectionTransfer &result) {
+            std::string path = dump_path(options.directory, collection, DOCUMENTS_EXTENSION);
+            aevum::util::memory::MappedFile file;
+            if (auto status = file.open(path); !status.ok()) return status;
+
+            auto key_format = store.key_format(collection);
+            std::vector<std::pair<std::string, std::string_view>> documents;
+            std::deque<std::string> owned;
+            auto status =
+                split_documents(file.data(), file.size(), path, key_format, documents, owned);
+            if (!status.ok()) return status;
+            sort_by_id(documents, key_format);
+            for (const auto &[id, bytes] : documents) result.bytes += bytes.size();
+            result.documents = documents.size();
+            return store.bulk_load_documents(collection, documents);
+        };
+
+        AEVUM_LOG_INFO("Transfer: Restoring " + std::to_string(collections.size()) +
+                       " collections from '" + options.directory + "' into '" + options.db_path +
+                       "'.");
+        auto status =
+            run_transfers(collections, options.threads, "Restore", load_collection, results);
+        if (!status.ok()) return status;
+
+        aevum::db::index::IndexPersistor::IdFilterImages stale_filters;
+        if (!persistor.take_id_filters(stale_filters)) {
+            return aevum::util::Status::IOError("Failed to discard the stored _id filters");
+        }
+    }
+
+    // Only the collections with indexes are loaded, to build them.
+    aevum::db::CoreOptions core_options;
+    core_options.lazy_load = true;
+    aevum::db::Core core(options.db_path, core_options);
+    for (size_t i = 0; i < collections.size(); ++i) {
+        if (metadata[i].empty()) continue;
+        aevum::util::time::Stopwatch stopwatch;
+        auto status = apply_metadata(core, collections[i], metadata[i], results[i].indexes);
+        if (!status.ok()) return status;
+        results[i].elapsed_ms += stopwatch.elapsed_ms();
+    }
+    return aevum::util::Status::OK();
+}
+
+}  // namespace aevum::transfer
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bson_transfer.hpp
+ * @brief Declares the dump and restore of collections as BSON stream files.
+ * @details A dump writes every collection of a data directory to a directory of its own, as two
+ * files per collection:
+ * - `<collection>.bson` holds the documents back to back. Every BSON document starts with its
+ *   own little-endian `int32` length, so the file is a length-prefixed stream that can be walked
+ *   without an index, the layout `mongodump` writes.
+ * - `<collection>.metadata.bson` holds one document, `{collection, count, indexes: [{field,
+ *   type, expire_after_seconds?, sparse?, partial_filter?}], schema?}`, describing what the
+ *   restore rebuilds.
+ *
+ * Both tools work on a data directory rather than through a server, since a WiredTiger
+ * directory is opened by one process at a time: the source is a stopped server's directory or a
+ * copy taken with the `backup` action, and the target is started as a server once restored. This
+ * avoids the request path altogether: a dump streams a cursor per collection, and a restore
+ * bulk-loads each table and builds its indexes from the sorted keys.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aevum/util/status.hpp"
+
+namespace aevum::transfer {
+
+/**
+ * @struct TransferOptions
+ * @brief What a dump or restore transfers, and where.
+ */
+struct TransferOptions {
+    /// The data directory to dump from or restore into.
+    std::string db_path;
+    /// The directory holding the dump files.
+    std::string directory;
+    /// The collections to transfer; empty for every collection.
+    std::vector<std::string> collections;
+    /// The collections transferred concurrently, or 0 for one per hardware thread.
+    size_t threads = 0;
+};
+
+/**
+ * @struct CollectionTransfer
+ * @brief The outcome of the transfer of one collection.
+ */
+struct CollectionTransfer {
+    /// The name of the collection.
+    std::string collection;
+    /// The documents written.
+    uint64_t documents = 0;
+    /// The bytes of BSON written.
+    uint64_t bytes = 0;
+    /// The secondary indexes recorded or built.
+    size_t indexes = 0;
+    /// The time the transfer took, in milliseconds.
+    double elapsed_ms = 0.0;
+};
+
+/// The extension of the document stream of a collection.
+inline constexpr const char *DOCUMENTS_EXTENSION = ".bson";
+/// The extension of the metadata document of a collection.
+inline constexpr const char *METADATA_EXTENSION = ".metadata.bson";
+
+/**
+ * @brief Writes the user collections of a data directory to dump files.
+ * @details Collections are dumped concurrently, each by streaming its table in batches into its
+ * files through a large buffer; `_`-prefixed system collections are skipped. The directory is
+ * created if needed, and the files of a collection are replaced.
+ * @param options The data directory, the target directory, and the collections.
+ * @param results Receives the outcome of every collection dumped, in name order.
+ * @return `aevum::util::Status::OK()` once every collection is dumped, `NotFound` if a named
+ *         collection does not exist, or the status of the first failure.
+ */
+[[nodiscard]] aevum::util::Status dump(const TransferOptions &options,
+                                       std::vector<CollectionTransfer> &results);
+
+/**
+ * @brief Loads the dump files of a directory into a data directory.
+ * @details Every collection is restored in three steps:
+ * 1. Its `.bson` file is mapped into memory and walked; every document is validated, and given
+ *    a UUIDv4 `_id` if it has no string one.
+ * 2. The documents are sorted by `_id`, keeping the last of duplicates, and appended to the
+ *    empty table through a bulk cursor straight from the mapping.
+ * 3. Once every table is loaded, the schema and the indexes of the metadata are created through
+ *    a `Core`, which builds each index from the documents and writes its entries sorted, through
+ *    a bulk cursor as well.
+ * A collection that already has documents or indexes is refused, so a restore never merges into
+ * live data. The restored documents are not recorded in the change log, so the index images of
+ * the restored collections are deleted.
+ * @param options The data directory, the dump directory, and the collections.
+ * @param results Receives the outcome of every collection restored, in name order.
+ * @return `aevum::util::Status::OK()` once every collection is restored, `InvalidArgument` if a
+ *         target collection is not empty, `Corruption` if a file is malformed, or the status of
+ *         the first failure.
+ */
+[[nodiscard]] aevum::util::Status restore(const TransferOptions &options,
+                                          std::vector<CollectionTransfer> &results);
+
+}  // namespace aevum::transfer
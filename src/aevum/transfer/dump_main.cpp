@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file dump_main.cpp
+ * @brief Implements the entry point of `aevum_dump`, which writes collections to BSON files.
+ * @details The tool reads a data directory that no server has open, such as that of a stopped
+ * server or a hot backup, and writes every user collection, or the named ones, as a BSON stream
+ * and a metadata file that `aevum_restore` loads.
+ */
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aevum/transfer/bson_transfer.hpp"
+#include "aevum/util/log/logger.hpp"
+
+namespace {
+
+/**
+ * @brief Prints the usage of the tool.
+ * @param program The name the tool was started with.
+ */
+void print_usage(const char *program) {
+    std::cout << "AevumDB Dump\n\n"
+              << "Usage: " << program << " --db <dbPath> --out <dir> [options]\n\n"
+              << "  --db <dbPath>        : Data directory to read; no server may have it open\n"
+              << "  --out <dir>          : Directory the dump files are written to\n"
+              << "  --collection <name>  : Dump this collection only; may be repeated\n"
+              << "  --threads <n>        : Collections dumped concurrently, 0 for one per\n"
+              << "                         hardware thread (default: 0)\n"
+              << "  --help               : Display this message\n";
+}
+
+}  // namespace
+
+/**
+ * @brief The entry point of the dump tool.
+ * @param argc The count of command-line arguments.
+ * @param argv The command-line arguments.
+ * @return `0` after a dump, `1` if the arguments are invalid or the dump fails.
+ */
+int main(int argc, char *argv[]) {
+    aevum::transfer::TransferOptions options;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::invalid_argument(arg + " requires a value");
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                return 0;
+            } else if (arg == "--db") {
+                options.db_path = value();
+            } else if (arg == "--out") {
+                options.directory = value();
+            } else if (arg == "--collection") {
+                options.collections.push_back(value());
+            } else if (arg == "--threads") {
+                int threads = std::stoi(value());
+                if (threads < 0) throw std::out_of_range("threads must not be negative");
+                options.threads = static_cast<size_t>(threads);
+            } else {
+                throw std::invalid_argument("unknown option '" + arg + "'");
+            }
+        }
+        if (options.db_path.empty() || options.directory.empty()) {
+            throw std::invalid_argument("--db and --out are required");
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << ". Use --help for usage.\n";
+        return 1;
+    }
+
+    aevum::util::log::Logger::set_level(aevum::util::log::LogLevel::WARN);
+
+    std::vector<aevum::transfer::CollectionTransfer> results;
+    aevum::util::Status status = aevum::transfer::dump(options, results);
+    for (const auto &result : results) {
+        if (result.collection.empty()) continue;
+        std::cout << result.collection << ": " << result.documents << " documents, "
+                  << result.bytes << " bytes, " << result.indexes << " indexes in "
+                  << result.elapsed_ms << " ms\n";
+    }
+    if (!status.ok()) {
+        std::cerr << "Error: " << status.to_string() << "\n";
+        return 1;
+    }
+    return 0;
+}
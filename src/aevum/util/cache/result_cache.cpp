@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file result_cache.cpp
+ * @brief Implements the generation-validated `ResultCache`.
+ */
+#include "aevum/util/cache/result_cache.hpp"
+
+#include <random>
+
+namespace aevum::util::cache {
+
+namespace {
+
+/**
+ * @brief Returns the bytes an entry is charged for.
+ * @param value The value of the entry.
+ * @return The size of the value plus a fixed allowance for the key hash and the list and map
+ *         nodes.
+ */
+size_t entry_charge(std::string_view value) {
+    constexpr size_t NODE_OVERHEAD = 96;
+    return value.size() + NODE_OVERHEAD;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructs an empty cache and divides the capacity evenly between the shards.
+ * @param capacity_bytes The most bytes the cache holds.
+ * @param shards The number of shards.
+ */
+ResultCache::ResultCache(size_t capacity_bytes, size_t shards) {
+    std::random_device random;
+    seed_ = (static_cast<uint64_t>(random()) << 32) | random();
+    if (shards == 0) shards = 1;
+    shard_capacity_ = capacity_bytes / shards;
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+/**
+ * @brief Looks up a result.
+ * @details A stale entry is removed on the spot, so that entries of frequently written
+ * collections do not occupy the cache until they are evicted.
+ * @param key The key of the result.
+ * @param generation The current generation.
+ * @param value Receives the result.
+ * @return `true` on a hit.
+ */
+bool ResultCache::get(std::string_view key, uint64_t generation, std::string &value) {
+    if (!enabled()) return false;
+    auto key_hash = hash(key);
+    Shard &shard = shard_for(key_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key_hash);
+    if (it == shard.index.end()) {
+        ++shard.misses;
+        return false;
+    }
+    if (it->second->generation != generation) {
+        erase(shard, it->second);
+        ++shard.misses;
+        return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    value = it->second->value;
+    ++shard.hits;
+    return true;
+}
+
+/**
+ * @brief Caches a result, evicting least recently used entries to make room.
+ * @param key The key of the result.
+ * @param generation The generation the result was computed under.
+ * @param value The result.
+ */
+void ResultCache::put(std::string_view key, uint64_t generation, std::string value) {
+    size_t charge = entry_charge(value);
+    if (!enabled() || charge > shard_capacity_) return;
+
+    auto key_hash = hash(key);
+    Shard &shard = shard_for(key_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (auto it = shard.index.find(key_hash); it != shard.index.end()) erase(shard, it->second);
+    while (!shard.lru.empty() && shard.bytes + charge > shard_capacity_) {
+        erase(shard, std::prev(shard.lru.end()));
+        ++shard.evictions;
+    }
+    shard.lru.push_front(Entry{key_hash, generation, std::move(value)});
+    shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+    shard.bytes += charge;
+}
+
+/**
+ * @brief Evicts least recently used entries from every shard.
+ * @param bytes The bytes to free.
+ * @return The bytes freed.
+ */
+size_t ResultCache::shrink(size_t bytes) {
+    size_t share = (bytes + shards_.size() - 1) / shards_.size();
+    size_t freed = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size_t before = shard->bytes;
+        while (!shard->lru.empty() && before - shard->bytes < share) {
+            erase(*shard, std::prev(shard->lru.end()));
+            ++shard->evictions;
+        }
+        freed += before - shard->bytes;
+    }
+    return freed;
+}
+
+/**
+ * @brief Returns a snapshot of the cache's counters.
+ * @details The shards are locked one at a time, so the sums are not an atomic snapshot.
+ * @return The counters.
+ */
+ResultCacheStats ResultCache::stats() const {
+    ResultCacheStats stats;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.entries += shard->lru.size();
+        stats.bytes += shard->bytes;
+    }
+    return stats;
+}
+
+/**
+ * @brief Hashes a key.
+ * @param key The key.
+ * @return The 128-bit hash of `key`.
+ */
+aevum::util::hash::Hash128 ResultCache::hash(std::string_view key) const noexcept {
+    return aevum::util::hash::wyhash128(key, seed_);
+}
+
+/**
+ * @brief Returns the shard a key belongs to.
+ * @details The shard is taken from the high half of the hash, since the shard's index buckets
+ * entries by the low half.
+ * @param key The hash of the key.
+ * @return The shard.
+ */
+ResultCache::Shard &ResultCache::shard_for(const aevum::util::hash::Hash128 &key) {
+    return *shards_[key.high % shards_.size()];
+}
+
+/**
+ * @brief Removes an entry from a shard.
+ * @param shard The shard.
+ * @param it The entry.
+ */
+void ResultCache::erase(Shard &shard, std::list<Entry>::iterator it) {
+    shard.bytes -= entry_charge(it->value);
+    shard.index.erase(it->key);
+    shard.lru.erase(it);
+}
+
+}  // namespace aevum::util::cache
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file result_cache.hpp
+ * @brief Declares `ResultCache`, a sharded, size-bounded LRU cache of query results that are
+ * validated by a write generation.
+ * @details Each entry records the write generation of its collection at the time the result was
+ * computed. A lookup presents the current generation, and an entry computed under an older one
+ * is discarded instead of returned, so a write invalidates every cached result of its collection
+ * in O(1), without the cache having to know which entries it affects. Keys are kept as 128-bit
+ * hashes rather than as the strings they were given as, so a long query costs 16 bytes of key
+ * and a lookup compares two integers.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/util/hash/wyhash.hpp"
+
+/**
+ * @namespace aevum::util::cache
+ * @brief Bounded in-memory caches.
+ */
+namespace aevum::util::cache {
+
+/**
+ * @struct ResultCacheStats
+ * @brief A snapshot of the counters of a `ResultCache`.
+ */
+struct ResultCacheStats {
+    /// Lookups that returned a result.
+    uint64_t hits{0};
+    /// Lookups that found no entry, or only a stale one.
+    uint64_t misses{0};
+    /// Entries discarded to stay within the capacity.
+    uint64_t evictions{0};
+    /// The number of entries currently held.
+    uint64_t entries{0};
+    /// The bytes currently held, counting keys and values.
+    uint64_t bytes{0};
+};
+
+/**
+ * @class ResultCache
+ * @brief Caches serialized query results by key, validated by a generation number.
+ *
+ * @details The cache is split into shards by key hash, each with its own mutex, LRU list, and
+ * share of the capacity, so concurrent lookups of different keys rarely contend. A shard evicts
+ * its least recently used entries when an insertion would exceed its share. The class is
+ * thread-safe.
+ *
+ * Entries are identified by the 128-bit wyhash of their key under a seed drawn at construction,
+ * so colliding keys cannot be computed ahead of time, and an accidental collision among even a
+ * billion keys is far less likely than a memory error.
+ */
+class ResultCache {
+  public:
+    /**
+     * @brief Constructs an empty cache.
+     * @param capacity_bytes The most bytes of keys and values the cache holds, or 0 to disable it.
+     * @param shards The number of independently locked shards (at least one).
+     */
+    explicit ResultCache(size_t capacity_bytes, size_t shards = 16);
+
+    ResultCache(const ResultCache &) = delete;
+    ResultCache &operator=(const ResultCache &) = delete;
+
+    /**
+     * @brief Looks up a result.
+     * @param key The key of the result.
+     * @param generation The current write generation of the result's source.
+     * @param value Receives a copy of the result on a hit.
+     * @return `true` if a result computed under `generation` is cached.
+     */
+    [[nodiscard]] bool get(std::string_view key, uint64_t generation, std::string &value);
+
+    /**
+     * @brief Caches a result, replacing any entry with the same key.
+     * @details A result larger than a shard's share of the capacity is not cached.
+     * @param key The key of the result.
+     * @param generation The write generation the result was computed under, read before the
+     * computation started.
+     * @param value The result.
+     */
+    void put(std::string_view key, uint64_t generation, std::string value);
+
+    /**
+     * @brief Reports whether the cache holds anything at all.
+     * @return `false` if the cache was constructed with a capacity of 0.
+     */
+    [[nodiscard]] bool enabled() const noexcept { return shard_capacity_ > 0; }
+
+    /**
+     * @brief Evicts least recently used entries to give memory back.
+     * @details Each shard evicts its share of `bytes`, so the capacity is unchanged and the cache
+     * fills up again as results are put.
+     * @param bytes The bytes to free.
+     * @return The bytes freed, which may be less if the cache holds less.
+     */
+    size_t shrink(size_t bytes);
+
+    /**
+     * @brief Returns a snapshot of the cache's counters.
+     * @return The counters, summed over all shards.
+     */
+    [[nodiscard]] ResultCacheStats stats() const;
+
+  private:
+    /// A cached result.
+    struct Entry {
+        /// The hash of the key.
+        aevum::util::hash::Hash128 key;
+        /// The generation the result was computed under.
+        uint64_t generation;
+        /// The result.
+        std::string value;
+    };
+
+    /// Hashes a key hash for the shard's index, whose buckets take its low half.
+    struct KeyHash {
+        size_t operator()(const aevum::util::hash::Hash128 &key) const noexcept {
+            return static_cast<size_t>(key.low);
+        }
+    };
+
+    /// A part of the cache with its own lock.
+    struct Shard {
+        /// Guards all members below.
+        std::mutex mutex;
+        /// The entries, most recently used first.
+        std::list<Entry> lru;
+        /// The entries by key hash.
+        std::unordered_map<aevum::util::hash::Hash128, std::list<Entry>::iterator, KeyHash> index;
+        /// The bytes held by the shard.
+        size_t bytes{0};
+        /// The shard's share of the counters.
+        uint64_t hits{0};
+        /// Lookups that missed.
+        uint64_t misses{0};
+        /// Entries evicted for space.
+        uint64_t evictions{0};
+    };
+
+    /**
+     * @brief Hashes a key.
+     * @param key The key.
+     * @return The 128-bit hash of `key` under the cache's seed.
+     */
+    [[nodiscard]] aevum::util::hash::Hash128 hash(std::string_view key) const noexcept;
+
+    /**
+     * @brief Returns the shard a key belongs to.
+     * @param key The hash of the key.
+     * @return The shard, chosen by the high half of the hash.
+     */
+    Shard &shard_for(const aevum::util::hash::Hash128 &key);
+
+    /**
+     * @brief Removes an entry from a shard. The caller holds the shard's mutex.
+     * @param shard The shard.
+     * @param it The entry.
+     */
+    static void erase(Shard &shard, std::list<Entry>::iterator it);
+
+    /// The seed of the key hashes.
+    uint64_t seed_;
+    /// The bytes each shard may hold.
+    size_t shard_capacity_;
+    /// The shards.
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace aevum::util::cache
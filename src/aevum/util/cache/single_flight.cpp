@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file single_flight.cpp
+ * @brief Implements the `SingleFlight` coalescer.
+ */
+#include "aevum/util/cache/single_flight.hpp"
+
+#include <random>
+#include <utility>
+
+namespace aevum::util::cache {
+
+/**
+ * @brief Constructs a coalescer with no call in flight.
+ * @param shards The number of shards.
+ */
+SingleFlight::SingleFlight(size_t shards) {
+    std::random_device random;
+    seed_ = (static_cast<uint64_t>(random()) << 32) | random();
+    if (shards == 0) shards = 1;
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+/**
+ * @brief Computes a result, or shares that of an identical call in flight.
+ * @details The first caller of a key registers a flight and computes; it removes the flight
+ * before publishing the result, so a caller arriving after that starts a new flight rather than
+ * receiving a result whose computation it did not overlap with.
+ * @param key The key of the computation.
+ * @param generation The generation of the source.
+ * @param compute Computes the result.
+ * @return The result.
+ */
+SingleFlight::Result SingleFlight::run(std::string_view key, uint64_t generation,
+                                       const std::function<std::string()> &compute) {
+    auto key_hash = aevum::util::hash::wyhash128(key, seed_);
+    Shard &shard = *shards_[key_hash.high % shards_.size()];
+
+    std::shared_ptr<Flight> flight;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.flights.find(key_hash);
+        if (it == shard.flights.end()) {
+            flight = std::make_shared<Flight>();
+            flight->generation = generation;
+            shard.flights.emplace(key_hash, flight);
+            leader = true;
+        } else if (it->second->generation == generation) {
+            flight = it->second;
+            ++shard.followers;
+        }
+        if (leader || !flight) ++shard.leaders;
+    }
+
+    // Another generation is in flight: compute alone rather than wait for an older result.
+    if (!flight) return std::make_shared<const std::string>(compute());
+
+    if (!leader) {
+        std::unique_lock<std::mutex> lock(flight->mutex);
+        flight->finished.wait(lock, [&] { return flight->done; });
+        if (flight->error) std::rethrow_exception(flight->error);
+        return flight->result;
+    }
+
+    Result result;
+    std::exception_ptr error;
+    try {
+        result = std::make_shared<const std::string>(compute());
+    } catch (...) {
+        error = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.flights.erase(key_hash);
+    }
+    {
+        std::lock_guard<std::mutex> lock(flight->mutex);
+        flight->result = result;
+        flight->error = error;
+        flight->done = true;
+    }
+    flight->finished.notify_all();
+    if (error) std::rethrow_exception(error);
+    return result;
+}
+
+/**
+ * @brief Returns a snapshot of the counters.
+ * @details The shards are locked one at a time, so the sums are not an atomic snapshot.
+ * @return The counters.
+ */
+SingleFlightStats SingleFlight::stats() const {
+    SingleFlightStats stats;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.leaders += shard->leaders;
+        stats.followers += shard->followers;
+    }
+    return stats;
+}
+
+}  // namespace aevum::util::cache
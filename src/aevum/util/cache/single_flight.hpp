@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file single_flight.hpp
+ * @brief Declares `SingleFlight`, which runs concurrent identical computations once and shares
+ * the result.
+ * @details When many clients ask the same expensive question at the same instant, typically
+ * because its cached answer has just gone stale, every one of them would otherwise compute it.
+ * With single-flight coalescing, the first caller computes the answer and the callers that
+ * arrive with the same key and generation while it does wait for it and receive the same
+ * buffer.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace aevum::util::cache {
+
+/**
+ * @struct SingleFlightStats
+ * @brief A snapshot of the counters of a `SingleFlight`.
+ */
+struct SingleFlightStats {
+    /// Calls that computed their result.
+    uint64_t leaders{0};
+    /// Calls that received the result of a call in flight instead of computing it.
+    uint64_t followers{0};
+};
+
+/**
+ * @class SingleFlight
+ * @brief Coalesces concurrent calls with the same key and generation into one computation.
+ *
+ * @details A call is in flight from the moment it finds no other call with its key until its
+ * computation returns. Calls with the same key and the same generation that arrive meanwhile
+ * block until then and share its result, or rethrow its exception. A call whose generation
+ * differs from that of the call in flight, because the source was written in between, computes
+ * its own result without joining or replacing it, so no call ever receives a result older than
+ * the generation it read.
+ *
+ * Keys are identified by their seeded 128-bit wyhash, as in `ResultCache`. Flights are kept in
+ * independently locked shards, and the locks are held only to look up and remove flights, never
+ * while computing. The class is thread-safe.
+ */
+class SingleFlight {
+  public:
+    /// A shared, immutable result.
+    using Result = std::shared_ptr<const std::string>;
+
+    /**
+     * @brief Constructs a coalescer with no call in flight.
+     * @param shards The number of independently locked shards (at least one).
+     */
+    explicit SingleFlight(size_t shards = 16);
+
+    SingleFlight(const SingleFlight &) = delete;
+    SingleFlight &operator=(const SingleFlight &) = delete;
+
+    /**
+     * @brief Computes a result, or shares that of an identical call in flight.
+     * @param key The key of the computation.
+     * @param generation The generation of the source the computation reads.
+     * @param compute Computes the result; called at most once, on the calling thread.
+     * @return The result.
+     * @throws Whatever `compute` throws, in its caller and in every caller sharing its flight.
+     */
+    [[nodiscard]] Result run(std::string_view key, uint64_t generation,
+                             const std::function<std::string()> &compute);
+
+    /**
+     * @brief Returns a snapshot of the counters.
+     * @return The counters, summed over all shards.
+     */
+    [[nodiscard]] SingleFlightStats stats() const;
+
+  private:
+    /// A computation in flight.
+    struct Flight {
+        /// The generation the computation reads.
+        uint64_t generation{0};
+        /// Guards `done`, `result`, and `error`.
+        std::mutex mutex;
+        /// Signalled once the computation has finished.
+        std::condition_variable finished;
+        /// `true` once the computation has finished.
+        bool done{false};
+        /// The result, once computed.
+        Result result;
+        /// The exception the computation threw, if it did.
+        std::exception_ptr error;
+    };
+
+    /// Hashes a key hash for the shard's map, whose buckets take its low half.
+    struct KeyHash {
+        size_t operator()(const aevum::util::hash::Hash128 &key) const noexcept {
+            return static_cast<size_t>(key.low);
+        }
+    };
+
+    /// A part of the flights with its own lock.
+    struct Shard {
+        /// Guards all members below.
+        std::mutex mutex;
+        /// The flights by key hash.
+        std::unordered_map<aevum::util::hash::Hash128, std::shared_ptr<Flight>, KeyHash> flights;
+        /// The shard's share of the counters.
+        uint64_t leaders{0};
+        /// Calls that shared a result.
+        uint64_t followers{0};
+    };
+
+    /// The seed of the key hashes.
+    uint64_t seed_;
+    /// The shards, chosen by the high half of the key hash.
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace aevum::util::cache
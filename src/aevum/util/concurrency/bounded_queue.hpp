@@ -0,0 +1,399 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file bounded_queue.hpp
+ * @brief Defines `BoundedQueue`, a lock-free multi-producer, multi-consumer ring buffer.
+ * @details Unlike `ConcurrentQueue`, the queue has a fixed capacity, so a producer that outpaces
+ * its consumers is told so (`try_push` fails) or made to wait (`push`) instead of growing memory
+ * without limit. Handing an element over takes one compare-and-swap on each side and no lock,
+ * and blocked threads park on a futex after a short spin, so the fast path never enters the
+ * kernel.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aevum/util/concurrency/cpu_relax.hpp"
+#include "aevum/util/concurrency/futex.hpp"
+
+/**
+ * @namespace aevum::util::concurrency
+ * @brief A curated collection of advanced utilities and primitives for concurrent programming and
+ * high-performance multithreading.
+ * @details This namespace encapsulates a suite of tools designed to abstract away the complexities
+ * of thread synchronization, atomic operations, and parallel execution, providing developers with
+ * robust, reusable, and efficient building blocks for concurrent software architectures.
+ */
+namespace aevum::util::concurrency {
+
+/**
+ * @class BoundedQueue
+ * @brief A fixed-capacity FIFO queue for any number of producers and consumers, after Dmitry
+ * Vyukov's bounded MPMC queue.
+ *
+ * @details Each cell carries a sequence number that says whether it is free for the producer of
+ * a given position or filled for its consumer. Producers and consumers claim positions with a
+ * compare-and-swap on their own index, each on its own cache line, and publish the cell by
+ * advancing its sequence. The blocking `push` and `pop` spin for `SPIN_LIMIT` attempts, then
+ * register as waiters and park on a futex word that the other side advances, and only wakes,
+ * when it sees a waiter. `close` releases every blocked thread.
+ *
+ * @tparam T The element type, which must be nothrow move constructible so that a claimed cell is
+ * always filled.
+ */
+template <typename T>
+class BoundedQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "BoundedQueue elements must be nothrow move constructible");
+
+  public:
+    /// The failed attempts of a blocking call before it parks.
+    static constexpr int SPIN_LIMIT = 64;
+
+    /**
+     * @brief Constructs an empty queue.
+     * @param capacity The capacity, rounded up to a power of two of at least 2.
+     */
+    explicit BoundedQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) rounded <<= 1;
+        mask_ = rounded - 1;
+        cells_.reset(new Cell[rounded]);
+        for (size_t i = 0; i < rounded; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroys the queue and the elements still in it.
+     * @warning No thread may use the queue while it is destroyed.
+     */
+    ~BoundedQueue() {
+        size_t position;
+        while (Cell *cell = claim_front(position)) release_front(*cell, position);
+    }
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    /**
+     * @brief Appends an element if the queue is not full.
+     * @param value The element; moved from only if the call succeeds.
+     * @return `false` if the queue is full.
+     */
+    [[nodiscard]] bool try_push(T &&value) {
+        size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void *>(cell->storage)) T(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        notify(not_empty_, pop_waiters_, 1);
+        return true;
+    }
+
+    /**
+     * @brief Appends a copy of an element if the queue is not full.
+     * @param value The element.
+     * @return `false` if the queue is full.
+     */
+    [[nodiscard]] bool try_push(const T &value) {
+        T copy(value);
+        return try_push(std::move(copy));
+    }
+
+    /**
+     * @brief Appends an element, waiting while the queue is full.
+     * @param value The element; moved from only if the call succeeds.
+     * @return `false` if the queue was closed before there was room.
+     */
+    [[nodiscard]] bool push(T &&value) {
+        return wait_for([&] { return try_push(std::move(value)); }, not_full_, push_waiters_);
+    }
+
+    /**
+     * @brief Removes the oldest element if there is one.
+     * @param value Receives the element.
+     * @return `false` if the queue is empty.
+     */
+    [[nodiscard]] bool try_pop(T &value) {
+        size_t position;
+        Cell *cell = claim_front(position);
+        if (cell == nullptr) return false;
+        value = std::move(*element(*cell));
+        release_front(*cell, position);
+        notify(not_full_, push_waiters_, 1);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element if there is one.
+     * @return The element, or `std::nullopt` if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> try_pop() {
+        std::optional<T> value;
+        (void)try_pop_into(value);
+        return value;
+    }
+
+    /**
+     * @brief Removes up to `max` of the oldest elements with one compare-and-swap.
+     * @details Claims the run of consecutive filled cells at the head of the queue, so a consumer
+     * that drains a backlog pays for the shared index once per batch instead of once per element.
+     * @param out Receives the elements, appended in order.
+     * @param max The most elements to remove.
+     * @return The number of elements removed; 0 if the queue is empty.
+     */
+    size_t try_pop_batch(std::vector<T> &out, size_t max) {
+        if (max == 0) return 0;
+        size_t position = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (true) {
+            count = 0;
+            while (count < max) {
+                size_t sequence =
+                    cells_[(position + count) & mask_].sequence.load(std::memory_order_acquire);
+                if (sequence != position + count + 1) break;
+                ++count;
+            }
+            if (count == 0) {
+                size_t sequence = cells_[position & mask_].sequence.load(std::memory_order_acquire);
+                if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0) {
+                    return 0;
+                }
+                position = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(position, position + count,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        out.reserve(out.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            Cell &cell = cells_[(position + i) & mask_];
+            out.push_back(std::move(*element(cell)));
+            release_front(cell, position + i);
+        }
+        notify(not_full_, push_waiters_, static_cast<int>(count));
+        return count;
+    }
+
+    /**
+     * @brief Removes the oldest element, waiting while the queue is empty.
+     * @return The element, or `std::nullopt` once the queue is closed and empty.
+     */
+    [[nodiscard]] std::optional<T> pop() {
+        std::optional<T> value;
+        (void)wait_for([&] { return try_pop_into(value); }, not_empty_, pop_waiters_);
+        return value;
+    }
+
+    /**
+     * @brief Removes between 1 and `max` elements, waiting while the queue is empty.
+     * @param out Receives the elements, appended in order.
+     * @param max The most elements to remove.
+     * @return The number of elements removed; 0 once the queue is closed and empty.
+     */
+    size_t pop_batch(std::vector<T> &out, size_t max) {
+        size_t count = 0;
+        (void)wait_for([&] { return (count = try_pop_batch(out, max)) > 0; }, not_empty_,
+                       pop_waiters_);
+        return count;
+    }
+
+    /**
+     * @brief Closes the queue: blocked and future `push` calls fail, and `pop` calls return
+     * `std::nullopt` once the queue is empty.
+     * @details Elements already in the queue can still be popped, and `try_push` still succeeds
+     * while there is room.
+     */
+    void close() noexcept {
+        closed_.store(true, std::memory_order_release);
+        not_empty_.fetch_add(1, std::memory_order_release);
+        not_full_.fetch_add(1, std::memory_order_release);
+        futex_wake_all(not_empty_);
+        futex_wake_all(not_full_);
+    }
+
+    /**
+     * @brief Checks whether the queue was closed.
+     * @return `true` after `close`.
+     */
+    [[nodiscard]] bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Returns the capacity.
+     * @return The number of elements the queue holds when full.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return mask_ + 1; }
+
+    /**
+     * @brief Estimates the number of elements.
+     * @return The number of claimed positions not yet consumed, which may include elements
+     * still being written.
+     */
+    [[nodiscard]] size_t size_approx() const noexcept {
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+  private:
+    /**
+     * @struct Cell
+     * @brief One slot of the ring.
+     */
+    struct Cell {
+        /// `position` when free for the producer of `position`, `position + 1` when filled.
+        std::atomic<size_t> sequence{0};
+        /// The element while the cell is filled.
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * @brief Returns the element of a filled cell.
+     * @param cell The cell.
+     * @return The element.
+     */
+    static T *element(Cell &cell) noexcept {
+        return std::launder(reinterpret_cast<T *>(cell.storage));
+    }
+
+    /**
+     * @brief Claims the oldest filled cell.
+     * @param position Receives the position the cell was claimed at.
+     * @return The cell, or `nullptr` if the queue is empty.
+     */
+    Cell *claim_front(size_t &position) noexcept {
+        position = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell *cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (lag == 0) {
+                if (dequeue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    return cell;
+                }
+            } else if (lag < 0) {
+                return nullptr;
+            } else {
+                position = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Destroys the element of a claimed cell and frees the cell for the next lap.
+     * @param cell The cell, whose element was moved from.
+     * @param position The position the cell was claimed at.
+     */
+    void release_front(Cell &cell, size_t position) noexcept {
+        element(cell)->~T();
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Moves the oldest element, if there is one, into an empty optional.
+     * @param value Receives the element.
+     * @return `false` if the queue is empty.
+     */
+    bool try_pop_into(std::optional<T> &value) {
+        size_t position;
+        Cell *cell = claim_front(position);
+        if (cell == nullptr) return false;
+        value.emplace(std::move(*element(*cell)));
+        release_front(*cell, position);
+        notify(not_full_, push_waiters_, 1);
+        return true;
+    }
+
+    /**
+     * @brief Wakes threads parked on one side of the queue if any is registered.
+     * @details The fence pairs with the one in `wait_for`: either the waiter's recheck sees this
+     * side's change, or this load sees the waiter.
+     * @param word The futex word of the waiting side.
+     * @param waiters The waiters registered on it.
+     * @param count The number of threads to wake at most.
+     */
+    static void notify(std::atomic<uint32_t> &word, std::atomic<uint32_t> &waiters, int count) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) return;
+        word.fetch_add(1, std::memory_order_release);
+        futex_wake(word, count);
+    }
+
+    /**
+     * @brief Retries an attempt, first spinning, then parked on a futex word, until it succeeds
+     * or the queue is closed.
+     * @tparam Attempt A callable returning `true` on success.
+     * @param attempt The attempt.
+     * @param word The futex word advanced by the other side.
+     * @param waiters The waiters registered on `word`.
+     * @return `true` if the attempt succeeded; `false` if the queue was closed.
+     */
+    template <typename Attempt>
+    bool wait_for(Attempt &&attempt, std::atomic<uint32_t> &word, std::atomic<uint32_t> &waiters) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (attempt()) return true;
+            if (closed()) break;
+            cpu_relax();
+        }
+        while (true) {
+            uint32_t observed = word.load(std::memory_order_acquire);
+            bool was_closed = closed();
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool done = attempt();
+            if (!done && !was_closed) futex_wait(word, observed);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (done) return true;
+            if (was_closed) return false;
+        }
+    }
+
+    /// The cells; their number is a power of two.
+    std::unique_ptr<Cell[]> cells_;
+    /// The number of cells minus one.
+    size_t mask_{0};
+    /// The next position to fill, claimed by producers.
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    /// The next position to consume, claimed by consumers.
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    /// Advanced when an element is pushed while a consumer waits; the consumers' futex word.
+    alignas(64) std::atomic<uint32_t> not_empty_{0};
+    /// The consumers registered as waiting on `not_empty_`.
+    std::atomic<uint32_t> pop_waiters_{0};
+    /// Advanced when an element is popped while a producer waits; the producers' futex word.
+    alignas(64) std::atomic<uint32_t> not_full_{0};
+    /// The producers registered as waiting on `not_full_`.
+    std::atomic<uint32_t> push_waiters_{0};
+    /// Set by `close`.
+    std::atomic<bool> closed_{false};
+};
+
+}  // namespace aevum::util::concurrency
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file cpu_relax.hpp
+ * @brief Defines `cpu_relax`, the pause hint of spin-wait loops, and `SpinBackoff`, the
+ * exponential backoff built on it.
+ */
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @namespace aevum::util::concurrency
+ * @brief A curated collection of advanced utilities and primitives for concurrent programming and
+ * high-performance multithreading.
+ * @details This namespace encapsulates a suite of tools designed to abstract away the complexities
+ * of thread synchronization, atomic operations, and parallel execution, providing developers with
+ * robust, reusable, and efficient building blocks for concurrent software architectures.
+ */
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Tells the CPU that the calling thread is spinning on a memory location.
+ * @details On x86-64 this is `pause`, which frees execution resources for the sibling
+ * hyper-thread and avoids the pipeline flush caused by the memory-order violation when the
+ * awaited value changes; on AArch64 it is `yield`. Elsewhere it does nothing.
+ */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @class SpinBackoff
+ * @brief Exponential backoff for the contended path of a spin-wait loop.
+ *
+ * @details Each call to `spin` pauses twice as long as the previous one, up to `PAUSE_LIMIT`
+ * pauses, so that threads retrying a contended cache line spread out instead of hammering it in
+ * lockstep. Once the budget is spent, `spin` reports it and `pause` yields the CPU instead, which
+ * is what lets a waiting thread make room for the lock holder on an oversubscribed machine.
+ */
+class SpinBackoff {
+  public:
+    /// The most pauses of one backoff step.
+    static constexpr uint32_t PAUSE_LIMIT = 64;
+
+    /**
+     * @brief Pauses for the current step and doubles the next one while the budget lasts.
+     * @return `false`, without pausing, once the steps reached `PAUSE_LIMIT`.
+     */
+    bool spin() noexcept {
+        if (pauses_ > PAUSE_LIMIT) return false;
+        for (uint32_t i = 0; i < pauses_; ++i) cpu_relax();
+        pauses_ <<= 1;
+        return true;
+    }
+
+    /**
+     * @brief Backs off once: spins while the budget lasts, then yields the CPU.
+     */
+    void pause() noexcept {
+        if (!spin()) std::this_thread::yield();
+    }
+
+    /**
+     * @brief Restarts the backoff from a single pause.
+     */
+    void reset() noexcept { pauses_ = 1; }
+
+  private:
+    /// The pauses of the next step.
+    uint32_t pauses_{1};
+};
+
+}  // namespace aevum::util::concurrency
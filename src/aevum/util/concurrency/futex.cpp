@@ -0,0 +1,51 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file futex.cpp
+ * @brief Implements the parking of threads on a 32-bit atomic word.
+ */
+#include "aevum/util/concurrency/futex.hpp"
+
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace aevum::util::concurrency {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "A futex word must be a plain lock-free 32-bit integer");
+
+void futex_wait(std::atomic<uint32_t> &word, uint32_t expected) noexcept {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr,
+            nullptr, 0);
+#else
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+#endif
+}
+
+void futex_wake(std::atomic<uint32_t> &word, int count) noexcept {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, count, nullptr,
+            nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+void futex_wake_all(std::atomic<uint32_t> &word) noexcept { futex_wake(word, INT_MAX); }
+
+}  // namespace aevum::util::concurrency
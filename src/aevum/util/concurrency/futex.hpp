@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file futex.hpp
+ * @brief Declares the parking of threads on a 32-bit atomic word.
+ * @details Lock-free structures need a way to put waiters to sleep without a mutex around their
+ * fast path. A futex lets a thread sleep until a word changes, at the cost of one system call for
+ * the waiter and, only when someone is waiting, one for the waker.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @namespace aevum::util::concurrency
+ * @brief A curated collection of advanced utilities and primitives for concurrent programming and
+ * high-performance multithreading.
+ * @details This namespace encapsulates a suite of tools designed to abstract away the complexities
+ * of thread synchronization, atomic operations, and parallel execution, providing developers with
+ * robust, reusable, and efficient building blocks for concurrent software architectures.
+ */
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Blocks the calling thread while a word holds an expected value.
+ * @details Returns immediately if the word no longer holds `expected`, and may return spuriously,
+ * so callers recheck their condition in a loop.
+ * @param word The word to wait on.
+ * @param expected The value the caller last read from the word.
+ *
+ * @b Platform-Specific-Behavior
+ *   - On **Linux**, uses `futex(FUTEX_WAIT_PRIVATE)`.
+ *   - On other platforms, sleeps for 50 microseconds.
+ */
+void futex_wait(std::atomic<uint32_t> &word, uint32_t expected) noexcept;
+
+/**
+ * @brief Wakes threads blocked in `futex_wait` on a word.
+ * @details Callers change the word before waking, so that a thread about to wait sees the change.
+ * @param word The word.
+ * @param count The number of threads to wake at most.
+ */
+void futex_wake(std::atomic<uint32_t> &word, int count) noexcept;
+
+/**
+ * @brief Wakes every thread blocked in `futex_wait` on a word.
+ * @param word The word.
+ */
+void futex_wake_all(std::atomic<uint32_t> &word) noexcept;
+
+}  // namespace aevum::util::concurrency
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file named_registry.hpp
+ * @brief Defines `NamedRegistry`, an append-only map from names to objects that is read without
+ * locking.
+ * @details Per-collection state such as a collection's lock or its primary index is looked up by
+ * name on every request, but a collection is added only once in its lifetime. A map behind a
+ * reader-writer lock makes every lookup write to the lock's cache line, so concurrent requests
+ * contend even when they touch different collections. `NamedRegistry` never moves or removes an
+ * entry, which lets readers traverse it with acquire loads alone.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "aevum/util/hash/string_hash.hpp"
+
+namespace aevum::util::concurrency {
+
+/**
+ * @class NamedRegistry
+ * @brief Maps names to default-constructed objects that live as long as the registry.
+ *
+ * @details The registry is a fixed array of buckets, each the atomic head of a singly linked
+ * list. An object is added by prepending a node with a release store, under a mutex that only
+ * adders take, so that a name is never added twice; lookups traverse the lists with acquire loads
+ * and take no lock. References to the objects stay valid until the registry is destroyed.
+ *
+ * @tparam T The type of the objects; default-constructible. Its own members synchronize whatever
+ * state changes after it is added.
+ * @tparam Buckets The number of buckets.
+ */
+template <typename T, size_t Buckets = 256>
+class NamedRegistry {
+  public:
+    /**
+     * @brief Constructs an empty registry.
+     */
+    NamedRegistry() = default;
+
+    /**
+     * @brief Destroys every object. No other thread may use the registry any longer.
+     */
+    ~NamedRegistry() {
+        for (auto &bucket : buckets_) {
+            Node *node = bucket.load(std::memory_order_relaxed);
+            while (node) {
+                Node *next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    NamedRegistry(const NamedRegistry &) = delete;
+    NamedRegistry &operator=(const NamedRegistry &) = delete;
+
+    /**
+     * @brief Looks up an object without locking.
+     * @param name The name.
+     * @return The object, or null if no object was added under `name`.
+     */
+    [[nodiscard]] T *find(std::string_view name) const noexcept {
+        const auto &bucket = buckets_[bucket_of(name)];
+        for (Node *node = bucket.load(std::memory_order_acquire); node; node = node->next) {
+            if (node->name == name) return &node->value;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Looks up an object, adding a default-constructed one if absent.
+     * @details The lookup is repeated under the adders' mutex before adding, so that two threads
+     * racing to add the same name agree on one object.
+     * @param name The name.
+     * @return The object.
+     */
+    T &find_or_add(std::string_view name) {
+        if (T *found = find(name)) return *found;
+        std::lock_guard<std::mutex> lock(add_mutex_);
+        if (T *found = find(name)) return *found;
+        auto &bucket = buckets_[bucket_of(name)];
+        Node *node = new Node(name, bucket.load(std::memory_order_relaxed));
+        bucket.store(node, std::memory_order_release);
+        return node->value;
+    }
+
+    /**
+     * @brief Visits every object without locking.
+     * @details Objects added during the traversal may or may not be visited.
+     * @param visit Called with each name and its object, in no particular order.
+     */
+    void for_each(const std::function<void(std::string_view, T &)> &visit) const {
+        for (const auto &bucket : buckets_) {
+            for (Node *node = bucket.load(std::memory_order_acquire); node; node = node->next) {
+                visit(node->name, node->value);
+            }
+        }
+    }
+
+  private:
+    /// An entry of a bucket's list.
+    struct Node {
+        /**
+         * @brief Constructs an entry.
+         * @param name The name.
+         * @param next The bucket's previous head.
+         */
+        Node(std::string_view name, Node *next) : name(name), next(next) {}
+
+        /// The name.
+        const std::string name;
+        /// The next entry of the bucket.
+        Node *const next;
+        /// The object.
+        T value;
+    };
+
+    /**
+     * @brief Returns the bucket of a name.
+     * @param name The name.
+     * @return The index of the bucket.
+     */
+    [[nodiscard]] static size_t bucket_of(std::string_view name) noexcept {
+        return aevum::util::hash::StringHash{}(name) % Buckets;
+    }
+
+    /// The heads of the buckets' lists.
+    std::array<std::atomic<Node *>, Buckets> buckets_{};
+    /// Serializes additions.
+    std::mutex add_mutex_;
+};
+
+}  // namespace aevum::util::concurrency
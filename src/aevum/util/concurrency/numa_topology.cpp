@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file numa_topology.cpp
+ * @brief Implements the discovery of the CPUs of each NUMA node.
+ */
+#include "aevum/util/concurrency/numa_topology.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#endif
+
+namespace aevum::util::concurrency {
+
+#if defined(__linux__)
+namespace {
+
+/// The most NUMA nodes probed; node ids are dense in practice, so probing stops at the first gap.
+constexpr int MAX_NUMA_NODES = 1024;
+
+/**
+ * @brief Parses a kernel CPU list such as `0-3,8-11,16`.
+ * @param list The list.
+ * @param allowed The CPUs the process may run on; other CPUs are dropped.
+ * @return The CPU ids, in ascending order.
+ */
+std::vector<uint32_t> parse_cpu_list(const std::string &list, const cpu_set_t &allowed) {
+    std::vector<uint32_t> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty()) continue;
+        size_t dash = range.find('-');
+        unsigned long first = 0;
+        unsigned long last = 0;
+        try {
+            first = std::stoul(range.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        } catch (const std::exception &) {
+            return {};
+        }
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+    }
+    return cpus;
+}
+
+}  // namespace
+#endif
+
+/**
+ * @brief Lists the CPUs of each NUMA node that the process may run on.
+ * @details Nodes without an available CPU, such as memory-only nodes or nodes excluded by
+ * `taskset` or a cgroup, are left out.
+ */
+std::vector<std::vector<uint32_t>> numa_node_cpus() {
+    std::vector<std::vector<uint32_t>> nodes;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return nodes;
+    for (int node = 0; node < MAX_NUMA_NODES; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) break;
+        std::string list;
+        std::getline(file, list);
+        std::vector<uint32_t> cpus = parse_cpu_list(list, allowed);
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+#endif
+    return nodes;
+}
+
+}  // namespace aevum::util::concurrency
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file numa_topology.hpp
+ * @brief Declares a cross-platform utility for listing the CPUs of each NUMA node.
+ * @details On a multi-socket host, memory is attached to one socket, and reading it from another
+ * crosses the interconnect. Pools whose threads stay on one node keep their reads local.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Lists the CPUs of each NUMA node that the process may run on.
+ *
+ * @return The CPU ids of each node with at least one CPU available to the process, in node
+ * order, or an empty list if the topology cannot be read. A host with a single node yields one
+ * list.
+ *
+ * @b Platform-Specific-Behavior
+ *   - On **Linux**, reads `/sys/devices/system/node/node<N>/cpulist` and keeps the CPUs of the
+ *     process's affinity mask.
+ *   - On other platforms, returns an empty list.
+ */
+std::vector<std::vector<uint32_t>> numa_node_cpus();
+
+}  // namespace aevum::util::concurrency
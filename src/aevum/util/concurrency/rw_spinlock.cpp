@@ -0,0 +1,46 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file rw_spinlock.cpp
+ * @brief Implements the contended paths of the `RWSpinlock` reader-writer spinlock.
+ */
+#include "aevum/util/concurrency/rw_spinlock.hpp"
+
+#include "aevum/util/concurrency/cpu_relax.hpp"
+
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Acquires the exclusive lock after `try_lock` failed.
+ * @details The writer announces itself with the pending bit before every wait, since a competing
+ * writer that gets in first clears it. `try_lock` reads the word before its compare-and-swap, so
+ * the retries do not take the cache line from the readers while they are inside.
+ */
+void RWSpinlock::lock_contended() noexcept {
+    SpinBackoff backoff;
+    while (true) {
+        state_.fetch_or(WRITER_PENDING, std::memory_order_relaxed);
+        backoff.pause();
+        if (try_lock()) return;
+    }
+}
+
+/**
+ * @brief Acquires a shared lock after `try_lock_shared` failed.
+ * @details The reader waits by reading the word until no writer holds or awaits the lock, so it
+ * does not disturb the reader count, which the waiting writer watches, while it waits.
+ */
+void RWSpinlock::lock_shared_contended() noexcept {
+    SpinBackoff backoff;
+    while (true) {
+        backoff.pause();
+        if ((state_.load(std::memory_order_relaxed) & (WRITER | WRITER_PENDING)) == 0 &&
+            try_lock_shared()) {
+            return;
+        }
+    }
+}
+
+}  // namespace aevum::util::concurrency
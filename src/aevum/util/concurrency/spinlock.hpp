@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 /**
  * @namespace aevum::util::concurrency
@@ -29,13 +30,17 @@ namespace aevum::util::concurrency {
  * @brief Implements a low-level, high-performance synchronization primitive that utilizes
  * a busy-waiting loop.
  *
- * @details A `Spinlock` repeatedly and atomically tests a lock variable until it becomes available,
- * thereby avoiding the significant performance overhead associated with operating system-level
- * thread suspension and rescheduling. This characteristic renders it exceptionally efficient for
- * protecting very brief, non-blocking critical sections where the expected wait duration is less
- * than the time required for a context switch. The implementation is based on `std::atomic_flag`,
- * which is guaranteed to be lock-free, ensuring maximum efficiency and portability.
+ * @details An uncontended `lock` is a single compare-and-swap, inlined at the call site, so the
+ * lock is exceptionally cheap for protecting very brief, non-blocking critical sections where the
+ * expected wait duration is less than the time required for a context switch. A contended `lock`
+ * waits in three stages:
+ *   1. It spins with `SpinBackoff`, reading the lock word and retrying the compare-and-swap only
+ *      once it looks free (test-and-test-and-set), so waiters share the cache line instead of
+ *      bouncing it between cores.
+ *   2. It yields the CPU for up to `YIELD_LIMIT` more attempts, in case the holder was preempted.
+ *   3. It marks the lock as contended and parks on a futex, which `unlock` then wakes.
  *
+
  * @note This class is designed to satisfy the `BasicLockable` and `Lockable` named requirements
  * from the C++ standard library. Consequently, it can be seamlessly integrated with standard RAII
  * lock wrappers such as `std::lock_guard` and `std::unique_lock` to ensure exception-safe
@@ -43,18 +48,20 @@ namespace aevum::util::concurrency {
  */
 class Spinlock {
   public:
+    /// The yields of a contended `lock` after its spinning and before it parks.
+    static constexpr int YIELD_LIMIT = 16;
+
     /**
-     * @brief Initializes the spinlock to a default, unlocked (clear) state.
-     * @details The constructor leverages `ATOMIC_FLAG_INIT` to guarantee that the underlying
-     * `std::atomic_flag` is initialized to a clear state before any operations are performed.
-     * The `noexcept` specification guarantees that the constructor will not throw any exceptions.
+     * @brief Initializes the spinlock to a default, unlocked state.
+     * @details The `noexcept` specification guarantees that the constructor will not throw any
+     * exceptions.
      */
     Spinlock() noexcept;
 
     /**
      * @brief Default destructor.
-     * @details The destructor requires no special actions, as the underlying `std::atomic_flag`
-     * manages its own state.
+     * @details The destructor requires no special actions, as the underlying atomic word manages
+     * its own state.
      */
     ~Spinlock() = default;
 
@@ -77,46 +84,74 @@ class Spinlock {
     Spinlock &operator=(const Spinlock &) = delete;
 
     /**
-     * @brief Acquires the lock, spinning (busy-waiting) until it becomes available.
-     * @details This method executes a tight loop that continuously attempts to atomically set the
-     * lock flag. If contention is high or the critical section is long, this may consume
-     * considerable CPU resources. It is therefore optimally employed for critical sections with
-     * minimal and predictable execution times. The operation uses appropriate memory ordering
-     * to ensure correctness.
+     * @brief Acquires the lock, spinning with backoff and finally parking until it is available.
+     * @details The uncontended case is one compare-and-swap with acquire ordering; the waiting
+     * stages described for the class are out of line in `lock_contended`.
      * @see lock()
      */
-    void lock() noexcept;
+    void lock() noexcept {
+        uint32_t expected = UNLOCKED;
+        if (state_.compare_exchange_weak(expected, LOCKED, std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+            return;
+        }
+        lock_contended();
+    }
 
     /**
      * @brief Attempts to acquire the lock once without spinning.
      * @details This method performs a single, non-blocking attempt to acquire the lock. It is
      * useful in scenarios where a thread can perform alternative work if the lock is not
      * immediately available, thus preventing wasted CPU cycles from spinning.
+     * It reads the lock word first and only attempts the compare-and-swap when the lock looks
+     * free, so polling a held lock does not take its cache line away from the holder.
      * @return `true` if the lock was successfully acquired, and `false` if it is currently held
      * by another thread.
      * @see try_lock()
      */
-    [[nodiscard]] bool try_lock() noexcept;
+    [[nodiscard]] bool try_lock() noexcept {
+        uint32_t expected = UNLOCKED;
+        return state_.load(std::memory_order_relaxed) == UNLOCKED &&
+               state_.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
 
     /**
      * @brief Releases the lock, allowing another spinning thread to acquire it.
-     * @details This operation atomically clears the lock flag, making it available for other
-     * threads. It is imperative that `unlock()` is called only by the thread that currently
+     * @details This operation atomically clears the lock word with release ordering, making it
+     * available for other threads, and wakes one parked waiter if any thread marked the lock as
+     * contended. It is imperative that `unlock()` is called only by the thread that currently
      * holds the lock. Failure to do so results in undefined behavior.
      * @see unlock()
      */
-    void unlock() noexcept;
+    void unlock() noexcept {
+        if (state_.exchange(UNLOCKED, std::memory_order_release) == CONTENDED) wake_waiter();
+    }
 
   private:
+    /// The lock is free.
+    static constexpr uint32_t UNLOCKED = 0;
+    /// The lock is held and no thread is parked on it.
+    static constexpr uint32_t LOCKED = 1;
+    /// The lock is held and threads may be parked on it.
+    static constexpr uint32_t CONTENDED = 2;
+
+    /**
+     * @brief Waits for the lock after the fast path of `lock` failed.
+     */
+    void lock_contended() noexcept;
+
+    /**
+     * @brief Wakes one thread parked in `lock_contended`.
+     */
+    void wake_waiter() noexcept;
+
     /**
-     * @var flag_
-     * @brief The core `std::atomic_flag` that represents the state of the lock.
-     * @details `std::atomic_flag` is specified by the C++ standard as the premier type for
-     * building synchronization primitives. It is guaranteed to be lock-free and provides the
-     * necessary atomic test-and-set operations, making it the ideal foundation for an efficient
-     * and portable spinlock.
+     * @var state_
+     * @brief The lock word: `UNLOCKED`, `LOCKED` or `CONTENDED`.
+     * @details A 32-bit word, so that waiters can park on it with a futex.
      */
-    std::atomic_flag flag_;
+    std::atomic<uint32_t> state_;
 };
 
 }  // namespace aevum::util::concurrency
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file task.hpp
+ * @brief Defines `Task`, a move-only callable with inline storage for small closures.
+ * @details `std::function` requires copyable targets and allocates for anything larger than two
+ * pointers. The closures submitted to a `ThreadPool` are move-only (they own a `packaged_task`)
+ * and usually capture a few pointers, so `Task` stores up to `Task::INLINE_SIZE` bytes in place
+ * and only allocates for larger ones.
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @namespace aevum::util::concurrency
+ * @brief A curated collection of advanced utilities and primitives for concurrent programming and
+ * high-performance multithreading.
+ * @details This namespace encapsulates a suite of tools designed to abstract away the complexities
+ * of thread synchronization, atomic operations, and parallel execution, providing developers with
+ * robust, reusable, and efficient building blocks for concurrent software architectures.
+ */
+namespace aevum::util::concurrency {
+
+/**
+ * @class Task
+ * @brief A type-erased, move-only `void()` callable that fits one cache line.
+ *
+ * @details Callables of at most `INLINE_SIZE` bytes whose move constructor does not throw are
+ * stored inside the `Task`; others are moved to the heap. An empty `Task` must not be invoked.
+ */
+class Task {
+  public:
+    /// The bytes of closure state stored without allocating.
+    static constexpr size_t INLINE_SIZE = 64 - sizeof(void *);
+
+    /**
+     * @brief Constructs an empty task.
+     */
+    Task() noexcept = default;
+
+    /**
+     * @brief Constructs a task that owns a callable.
+     * @tparam F The type of the callable, invocable without arguments.
+     * @param f The callable, moved or copied into the task.
+     */
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> &&
+                                                      std::is_invocable_v<std::decay_t<F> &>>>
+    Task(F &&f) {
+        using Callable = std::decay_t<F>;
+        if constexpr (fits_inline<Callable>()) {
+            ::new (static_cast<void *>(storage_)) Callable(std::forward<F>(f));
+            ops_ = &INLINE_OPS<Callable>;
+        } else {
+            ::new (static_cast<void *>(storage_)) Callable *(new Callable(std::forward<F>(f)));
+            ops_ = &HEAP_OPS<Callable>;
+        }
+    }
+
+    /**
+     * @brief Moves the callable of another task into a new one.
+     * @param other The task to move from; left empty.
+     */
+    Task(Task &&other) noexcept : ops_(other.ops_) {
+        if (ops_ != nullptr) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief Replaces the callable by that of another task.
+     * @param other The task to move from; left empty.
+     * @return This task.
+     */
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_ != nullptr) {
+                other.ops_->relocate(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    /**
+     * @brief Destroys the callable.
+     */
+    ~Task() { reset(); }
+
+    /**
+     * @brief Invokes the callable.
+     */
+    void operator()() { ops_->invoke(storage_); }
+
+    /**
+     * @brief Checks whether the task holds a callable.
+     * @return `true` if it does.
+     */
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /**
+     * @brief Destroys the callable, leaving the task empty.
+     */
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+  private:
+    /**
+     * @struct Ops
+     * @brief The operations of one type of callable.
+     */
+    struct Ops {
+        /// Calls the callable in the storage.
+        void (*invoke)(void *storage);
+        /// Moves the callable from one storage to another and destroys the source.
+        void (*relocate)(void *to, void *from) noexcept;
+        /// Destroys the callable in the storage.
+        void (*destroy)(void *storage) noexcept;
+    };
+
+    /**
+     * @brief Checks whether a callable is stored inline.
+     * @tparam Callable The type of the callable.
+     * @return `true` if it fits the storage and moves without throwing.
+     */
+    template <typename Callable>
+    static constexpr bool fits_inline() noexcept {
+        return sizeof(Callable) <= INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    /// The operations of a callable stored inline.
+    template <typename Callable>
+    static constexpr Ops INLINE_OPS{
+        [](void *storage) { (*std::launder(static_cast<Callable *>(storage)))(); },
+        [](void *to, void *from) noexcept {
+            Callable *source = std::launder(static_cast<Callable *>(from));
+            ::new (to) Callable(std::move(*source));
+            source->~Callable();
+        },
+        [](void *storage) noexcept { std::launder(static_cast<Callable *>(storage))->~Callable(); },
+    };
+
+    /// The operations of a callable stored on the heap, through a pointer stored inline.
+    template <typename Callable>
+    static constexpr Ops HEAP_OPS{
+        [](void *storage) { (**std::launder(static_cast<Callable **>(storage)))(); },
+        [](void *to, void *from) noexcept {
+            ::new (to) Callable *(*std::launder(static_cast<Callable **>(from)));
+        },
+        [](void *storage) noexcept { delete *std::launder(static_cast<Callable **>(storage)); },
+    };
+
+    /// The inline callable, or a pointer to one on the heap.
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    /// The operations of the callable; `nullptr` for an empty task.
+    const Ops *ops_{nullptr};
+};
+
+}  // namespace aevum::util::concurrency
@@ -0,0 +1,47 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file thread_affinity.cpp
+ * @brief Implements the pinning of threads to CPUs.
+ */
+#include "aevum/util/concurrency/thread_affinity.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Restricts the currently executing thread to one CPU.
+ * @details The index counts the CPUs the process is allowed on rather than all CPUs, so that a
+ * daemon started under `taskset` or in a container pins its workers to the CPUs it was given.
+ */
+bool set_current_thread_affinity(size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+    const int available = CPU_COUNT(&allowed);
+    if (available <= 0) return false;
+
+    size_t wanted = cpu % static_cast<size_t>(available);
+    for (int id = 0; id < CPU_SETSIZE; ++id) {
+        if (!CPU_ISSET(id, &allowed)) continue;
+        if (wanted-- > 0) continue;
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(id, &pinned);
+        return pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned) == 0;
+    }
+    return false;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+}  // namespace aevum::util::concurrency
@@ -0,0 +1,38 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file thread_affinity.hpp
+ * @brief Declares a cross-platform utility for pinning the calling thread to one CPU.
+ * @details Pinning keeps a long-lived worker on the core whose caches hold its data, and keeps the
+ * scheduler from stacking two busy workers on one core while another is idle.
+ */
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @namespace aevum::util::concurrency
+ * @brief A curated collection of advanced utilities and primitives for concurrent programming and
+ * high-performance multithreading.
+ * @details This namespace encapsulates a suite of tools designed to abstract away the complexities
+ * of thread synchronization, atomic operations, and parallel execution, providing developers with
+ * robust, reusable, and efficient building blocks for concurrent software architectures.
+ */
+namespace aevum::util::concurrency {
+
+/**
+ * @brief Restricts the currently executing thread to one CPU.
+ *
+ * @param cpu The index of the CPU, taken modulo the number of CPUs the process may run on.
+ * @return `true` if the thread was pinned, `false` if the platform does not support pinning or
+ * the CPU is not available to the process (e.g., excluded by a cgroup or `taskset`).
+ *
+ * @b Platform-Specific-Behavior
+ *   - On **Linux**, uses `pthread_setaffinity_np` on the n-th CPU of the process's affinity mask.
+ *   - On other platforms, the function has no effect and returns `false`.
+ */
+bool set_current_thread_affinity(size_t cpu);
+
+}  // namespace aevum::util::concurrency
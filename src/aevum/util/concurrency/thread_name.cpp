@@ -17,9 +17,28 @@
 #if defined(__linux__) || defined(__APPLE__)
 #include <pthread.h>
 #endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <sstream>
 
 namespace aevum::util::concurrency {
 
+namespace {
+
+/**
+ * @brief Returns the calling thread's label storage, empty until it is first needed.
+ * @return The thread-local label.
+ */
+std::string &thread_label() {
+    thread_local std::string label;
+    return label;
+}
+
+}  // namespace
+
 /**
  * @brief Assigns a specified name to the currently executing thread by dispatching to the
  * appropriate OS-specific implementation.
@@ -33,6 +52,7 @@ namespace aevum::util::concurrency {
  * underlying operating system constraints.
  */
 void set_current_thread_name(const std::string &name) {
+    thread_label() = name;
 #if defined(__linux__)
     // On Linux, the pthread_setname_np function is used. The 'np' suffix denotes that this is a
     // non-portable extension, common in glibc. The kernel imposes a strict limit of 16 bytes
@@ -58,4 +78,23 @@ void set_current_thread_name(const std::string &name) {
 #endif
 }
 
+/**
+ * @brief Returns the name of the calling thread, or its id, formatted on first use.
+ * @details On Linux, the id is the kernel's thread id, as shown by `top -H` and `gdb`; elsewhere
+ * it is `std::this_thread::get_id()` as the standard library prints it.
+ */
+const std::string &current_thread_name() {
+    std::string &label = thread_label();
+    if (label.empty()) {
+#if defined(__linux__)
+        label = std::to_string(static_cast<long>(syscall(SYS_gettid)));
+#else
+        std::ostringstream ss;
+        ss << std::this_thread::get_id();
+        label = ss.str();
+#endif
+    }
+    return label;
+}
+
 }  // namespace aevum::util::concurrency
@@ -48,4 +48,15 @@ namespace aevum::util::concurrency {
  */
 void set_current_thread_name(const std::string &name);
 
+/**
+ * @brief Returns a label of the currently executing thread, formatted once per thread.
+ *
+ * @details The label is the name given to `set_current_thread_name`, untruncated, or the
+ * kernel's thread id if the thread was never named. It is cached in thread-local storage, so
+ * that hot paths such as the logger can print it without formatting anything.
+ *
+ * @return The label; valid until the thread exits or is named again.
+ */
+const std::string &current_thread_name();
+
 }  // namespace aevum::util::concurrency
@@ -5,82 +5,167 @@
 /**
  * @file thread_pool.cpp
  * @brief Provides the concrete implementation of the high-performance `ThreadPool` class.
- * @details This source file contains the definitions for the `ThreadPool` constructor and
- * destructor, detailing the logic for thread creation, the worker's main execution loop, and the
- * graceful shutdown procedure. The implementation focuses on robust synchronization and efficient
- * task processing.
+ * @details This source file contains the workers' queues, their main loop with its stealing and
+ * sleeping protocol, the range splitting of `parallel_for`, and the graceful shutdown procedure.
  */
 #include "aevum/util/concurrency/thread_pool.hpp"
 
+#include <exception>
 #include <string>
 
+#include "aevum/util/concurrency/bounded_queue.hpp"
+#include "aevum/util/concurrency/thread_affinity.hpp"
 #include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/concurrency/work_stealing_deque.hpp"
 
 namespace aevum::util::concurrency {
 
+namespace {
+
+/// The recycled task slots of each worker's deque; a power of two.
+constexpr size_t POOL_SLOT_COUNT = 256;
+/// The slots probed for a free one before a slot is allocated.
+constexpr size_t POOL_SLOT_PROBES = 4;
+/// The capacity of each worker's inbox; a power of two.
+constexpr size_t POOL_INBOX_CAPACITY = 1024;
+
+/// The pool whose worker is the current thread, if any.
+thread_local const ThreadPool *pool_current = nullptr;
+/// The index of the current thread in `pool_current`.
+thread_local size_t pool_current_worker = 0;
+
+}  // namespace
+
+/**
+ * @struct ThreadPool::TaskSlot
+ * @brief Holds a task while its pointer is in a worker's deque.
+ * @details A slot belongs to the worker that filled it. Whichever thread takes the task moves it
+ * out and marks the slot free, after which its owner may fill it again.
+ */
+struct ThreadPool::TaskSlot {
+    /// The task.
+    Task task;
+    /// `true` while the slot holds a task.
+    std::atomic<bool> used{false};
+    /// `true` for a slot allocated because every probed slot was in use; deleted once taken.
+    bool heap{false};
+};
+
+/**
+ * @struct ThreadPool::Worker
+ * @brief The queues and thread of one worker.
+ */
+struct ThreadPool::Worker {
+    /// The tasks submitted by the tasks this worker runs.
+    WorkStealingDeque<TaskSlot *> deque;
+    /// The slots of `deque`, filled only by this worker.
+    std::unique_ptr<TaskSlot[]> slots{new TaskSlot[POOL_SLOT_COUNT]};
+    /// The slot probed first by `acquire_slot`.
+    size_t next_slot{0};
+    /// The tasks submitted from outside the pool, taken by this worker and stolen by others.
+    BoundedQueue<Task> inbox{POOL_INBOX_CAPACITY};
+    /// The thread.
+    std::thread thread;
+
+    /**
+     * @brief Returns a free slot for a task, allocating one if the probed slots are in use.
+     * @return The slot, marked as used. Called only by the worker's thread.
+     */
+    TaskSlot *acquire_slot() {
+        for (size_t probe = 0; probe < POOL_SLOT_PROBES; ++probe) {
+            TaskSlot &slot = slots[next_slot++ & (POOL_SLOT_COUNT - 1)];
+            if (!slot.used.load(std::memory_order_acquire)) {
+                slot.used.store(true, std::memory_order_relaxed);
+                return &slot;
+            }
+        }
+        auto *slot = new TaskSlot;
+        slot->heap = true;
+        return slot;
+    }
+};
+
+/**
+ * @struct ThreadPool::RangeJob
+ * @brief The shared state of one `parallel_for`.
+ * @details Helper tasks hold the job by `shared_ptr`, so one that starts after the call returned
+ * finds no chunk left and exits without touching the caller's function.
+ */
+struct ThreadPool::RangeJob {
+    /// The first index.
+    size_t begin{0};
+    /// The index after the last.
+    size_t end{0};
+    /// The length of a chunk.
+    size_t grain{1};
+    /// The number of chunks.
+    size_t chunks{0};
+    /// Calls the function on one chunk.
+    void (*call)(void *context, size_t begin, size_t end){nullptr};
+    /// The function.
+    void *context{nullptr};
+    /// The next chunk to claim.
+    std::atomic<size_t> next_chunk{0};
+    /// The chunks that were run or skipped.
+    std::atomic<size_t> done_chunks{0};
+    /// Set when a chunk threw; the remaining chunks are skipped.
+    std::atomic<bool> failed{false};
+    /// The first exception thrown by a chunk. Written under `mutex`.
+    std::exception_ptr error;
+    /// Guards `error` and the waiting of the caller.
+    std::mutex mutex;
+    /// Notified when the last chunk is done.
+    std::condition_variable finished;
+
+    /**
+     * @brief Claims and runs chunks until none is left.
+     */
+    void drain() {
+        while (true) {
+            size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) return;
+            if (!failed.load(std::memory_order_relaxed)) {
+                size_t chunk_begin = begin + chunk * grain;
+                try {
+                    call(context, chunk_begin, std::min(end, chunk_begin + grain));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            if (done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
 /**
  * @brief Constructs the `ThreadPool` and initializes its worker threads.
  *
- * @details This constructor is responsible for bringing the thread pool to life. It reserves space
- * for the worker threads to prevent vector reallocations and then proceeds to spawn the requested
- * number of threads. Each thread is given a unique, descriptive name derived from the provided
- * `name_prefix` to aid in diagnostics and debugging.
- *
- * The core of each worker thread is an infinite loop that forms the consumer part of a
- * producer-consumer pattern. Inside this loop, a worker attempts to acquire a lock and waits on a
- * `std::condition_variable`. The thread sleeps efficiently until it is either notified of a new
- * task or the pool is instructed to shut down. This wait-notify mechanism is crucial for
- * preventing busy-waiting and minimizing CPU consumption when the task queue is empty.
+ * @details Every worker's queues are created before the first thread starts, because workers
+ * steal from each other as soon as they run. Each thread is given a unique, descriptive name
+ * derived from the provided `name_prefix` to aid in diagnostics and debugging. A pool always has
+ * at least one worker, even if `std::thread::hardware_concurrency()` reports 0.
  *
  * @param name_prefix A string prefix used to generate unique names for the worker threads
  *                    (e.g., "Worker" results in "Worker-0", "Worker-1", etc.).
  * @param threads The total number of worker threads to create and maintain in the pool.
+ * @param pin_threads `true` to pin each worker to its own CPU.
  */
-ThreadPool::ThreadPool(const std::string &name_prefix, size_t threads) : stop_(false) {
-    // Pre-allocating the vector's capacity is a performance optimization that avoids
-    // potential reallocations and moves of `std::thread` objects during the loop.
+ThreadPool::ThreadPool(const std::string &name_prefix, size_t threads, bool pin_threads) {
+    threads = std::max<size_t>(threads, 1);
     workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
 
     for (size_t i = 0; i < threads; ++i) {
-        // Generate a unique and descriptive name for the underlying OS-level thread. This greatly
-        // simplifies debugging and performance analysis in complex systems.
         std::string worker_name = name_prefix + "-" + std::to_string(i);
-
-        workers_.emplace_back([this, worker_name] {
-            // Immediately set the thread's name upon its creation for superior diagnostics.
+        workers_[i]->thread = std::thread([this, worker_name, i, pin_threads] {
             set_current_thread_name(worker_name);
-
-            // This is the main execution loop for each worker thread in the pool.
-            while (true) {
-                std::function<void()> task;
-
-                {  // This block defines the critical section for accessing the shared task queue.
-                    std::unique_lock<std::mutex> lock(this->queue_mutex_);
-
-                    // The thread waits on the condition variable. The wait is predicated on a
-                    // lambda that checks for the stop signal or a non-empty queue. This predicate
-                    // is essential for correctly handling spurious wakeups.
-                    this->condition_.wait(lock, [this] {
-                        return this->stop_.load(std::memory_order_relaxed) || !this->tasks_.empty();
-                    });
-
-                    // The exit condition for the worker thread: the pool is stopping, and all
-                    // pending tasks have been processed. This ensures a graceful shutdown.
-                    if (this->stop_.load(std::memory_order_relaxed) && this->tasks_.empty()) {
-                        return;
-                    }
-
-                    // Dequeue the next available task from the front of the queue. `std::move`
-                    // is used for efficiency.
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop();
-                }  // The mutex is automatically released here by the `unique_lock` destructor.
-
-                // The task is executed outside the critical section. This is a critical design
-                // choice that maximizes concurrency by allowing other worker threads to access the
-                // queue while the current task is being processed.
-                task();
-            }
+            if (pin_threads) (void)set_current_thread_affinity(i);
+            work(i);
         });
     }
 }
@@ -90,34 +175,208 @@ ThreadPool::ThreadPool(const std::string &name_prefix, size_t threads) : stop_(f
  *
  * @details The destructor orchestrates a multi-step shutdown process to guarantee that all
  * submitted work is completed and all thread resources are cleanly released.
- * 1.  It first acquires a lock and sets the atomic `stop_` flag to `true`. This action
- *     prevents any new tasks from being enqueued and signals to the worker threads that
- *     they should begin terminating.
- * 2.  It then broadcasts a notification on the condition variable (`condition_.notify_all()`).
- *     This is crucial to wake up any worker threads that are currently sleeping and waiting for
- * tasks.
- * 3.  Finally, it iterates through the `workers_` vector and calls `join()` on each thread.
- *     This blocks the destructor until each worker thread has finished its current task,
- *     checked the `stop_` flag, and exited its main loop. This guarantees that the `ThreadPool`
- *     object is not fully destroyed until all worker activity has ceased.
+ * 1.  It sets the atomic `stop_` flag under the sleep mutex, so that no worker can miss it
+ *     between checking for work and going to sleep.
+ * 2.  It then wakes every sleeping worker. Workers keep running tasks until none is pending.
+ * 3.  Finally, it joins each thread, so the `ThreadPool` is not destroyed until all worker
+ *     activity has ceased.
  */
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_.store(true, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
     }
+    wakeup_.notify_all();
 
-    // Wake up all threads, including those that may be waiting on the condition variable, so
-    // they can re-evaluate the stop condition and begin their exit process.
-    condition_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
 
-    // Block and wait for each worker thread to complete its execution. This ensures that
-    // all resources are properly released and no threads are left running detachably.
-    for (std::thread &worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+/**
+ * @brief Submits a task to the current worker's deque or to an inbox.
+ * @details `pending_` is raised before the task is published, so it never drops below the number
+ * of visible tasks; a worker that sees it raised early spins briefly until the task appears.
+ */
+void ThreadPool::push(Task &&task) {
+    if (pool_current == this) {
+        Worker &worker = *workers_[pool_current_worker];
+        TaskSlot *slot = worker.acquire_slot();
+        slot->task = std::move(task);
+        pending_.fetch_add(1);
+        worker.deque.push(slot);
+    } else {
+        if (stop_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Cannot enqueue on a stopped ThreadPool");
         }
+        pending_.fetch_add(1);
+        post(next_inbox_.fetch_add(1, std::memory_order_relaxed), std::move(task));
+    }
+    wake(1);
+}
+
+void ThreadPool::submit_bulk(std::vector<Task> &tasks) {
+    const size_t count = tasks.size();
+    if (count == 0) return;
+
+    if (pool_current == this) {
+        Worker &worker = *workers_[pool_current_worker];
+        pending_.fetch_add(count);
+        for (Task &task : tasks) {
+            TaskSlot *slot = worker.acquire_slot();
+            slot->task = std::move(task);
+            worker.deque.push(slot);
+        }
+    } else {
+        if (stop_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Cannot enqueue on a stopped ThreadPool");
+        }
+        const size_t first = next_inbox_.fetch_add(count, std::memory_order_relaxed);
+        pending_.fetch_add(count);
+        for (size_t i = 0; i < count; ++i) post(first + i, std::move(tasks[i]));
+    }
+    tasks.clear();
+    wake(count);
+}
+
+/**
+ * @brief Places a task submitted from outside the pool in an inbox.
+ * @details The inbox chosen round-robin is tried first, then the following ones, so a burst
+ * spills over to the other workers before the submitting thread waits for room in the first.
+ * The workers are woken before that wait, since the tasks already posted may not have been
+ * announced yet.
+ */
+void ThreadPool::post(size_t first, Task &&task) {
+    const size_t workers = workers_.size();
+    for (size_t k = 0; k < workers; ++k) {
+        if (workers_[(first + k) % workers]->inbox.try_push(std::move(task))) return;
+    }
+    wake(workers);
+    (void)workers_[first % workers]->inbox.push(std::move(task));
+}
+
+/**
+ * @brief Wakes sleeping workers after tasks were queued.
+ * @details A worker registers in `idle_` before it rechecks `pending_` and sleeps, and a
+ * producer raises `pending_` before it reads `idle_`, so either the worker sees the task or the
+ * producer sees the worker. Taking the mutex orders the notification after the worker's wait.
+ */
+void ThreadPool::wake(size_t count) {
+    size_t idle = idle_.load();
+    if (idle == 0) return;
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    if (count >= idle) {
+        wakeup_.notify_all();
+    } else {
+        for (size_t i = 0; i < count; ++i) wakeup_.notify_one();
+    }
+}
+
+/**
+ * @brief Takes a task from the worker's own queues or steals one from another worker.
+ * @details The own deque comes first and is popped newest first, so nested tasks run while
+ * their data is still in cache; then the own inbox, oldest first. Other workers' deques and
+ * inboxes are then tried from the next worker on.
+ */
+bool ThreadPool::take(size_t index, Task &task) {
+    auto claim = [this, &task](TaskSlot *slot) {
+        task = std::move(slot->task);
+        if (slot->heap) {
+            delete slot;
+        } else {
+            slot->used.store(false, std::memory_order_release);
+        }
+        pending_.fetch_sub(1);
+        return true;
+    };
+
+    Worker &self = *workers_[index];
+    TaskSlot *slot = nullptr;
+    if (self.deque.pop(slot)) return claim(slot);
+    if (self.inbox.try_pop(task)) {
+        pending_.fetch_sub(1);
+        return true;
+    }
+
+    const size_t workers = workers_.size();
+    for (size_t k = 1; k < workers; ++k) {
+        Worker &victim = *workers_[(index + k) % workers];
+        if (victim.deque.steal(slot)) return claim(slot);
+        if (victim.inbox.try_pop(task)) {
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The main loop of a worker thread.
+ * @details A worker runs tasks while it finds any. While tasks are pending that it could not
+ * take, because they are still being published, it yields and retries;
+ * only when none is pending does it sleep. It exits once the pool stops and no task is pending.
+ */
+void ThreadPool::work(size_t index) {
+    pool_current = this;
+    pool_current_worker = index;
+
+    Task task;
+    while (true) {
+        if (take(index, task)) {
+            task();
+            task.reset();
+            continue;
+        }
+        if (pending_.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        idle_.fetch_add(1);
+        wakeup_.wait(lock, [this] { return pending_.load() > 0 || stop_.load(); });
+        idle_.fetch_sub(1);
+        if (stop_.load() && pending_.load() == 0) return;
+    }
+}
+
+/**
+ * @brief Runs `parallel_for` on a type-erased function.
+ * @details One helper task per worker, up to one fewer than the chunks, is submitted with
+ * `submit_bulk`; the calling thread then claims chunks itself and finally waits for the chunks
+ * still running on helpers.
+ */
+void ThreadPool::run_range(size_t begin, size_t end, size_t grain,
+                           void (*call)(void *context, size_t begin, size_t end), void *context) {
+    const size_t count = end - begin;
+    if (grain == 0) grain = std::max<size_t>(1, count / ((workers_.size() + 1) * 4));
+
+    auto job = std::make_shared<RangeJob>();
+    job->begin = begin;
+    job->end = end;
+    job->grain = grain;
+    job->chunks = (count + grain - 1) / grain;
+    job->call = call;
+    job->context = context;
+
+    const size_t helpers = std::min(workers_.size(), job->chunks - 1);
+    if (helpers > 0) {
+        std::vector<Task> tasks;
+        tasks.reserve(helpers);
+        for (size_t i = 0; i < helpers; ++i) tasks.emplace_back([job] { job->drain(); });
+        submit_bulk(tasks);
+    }
+    job->drain();
+
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->finished.wait(lock, [&job] {
+            return job->done_chunks.load(std::memory_order_acquire) == job->chunks;
+        });
     }
+    if (job->error) std::rethrow_exception(job->error);
 }
 
 }  // namespace aevum::util::concurrency
@@ -14,13 +14,14 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -28,6 +29,8 @@
 #include <utility>
 #include <vector>
 
+#include "aevum/util/concurrency/task.hpp"
+
 /**
  * @namespace aevum::util::concurrency
  * @brief A curated collection of advanced utilities and primitives for concurrent programming and
@@ -42,18 +45,18 @@ namespace aevum::util::concurrency {
  * @class ThreadPool
  * @brief Manages a pool of persistent worker threads to execute asynchronous tasks efficiently.
  *
- * @details This class implements a fixed-size thread pool, a powerful pattern for concurrent task
- * execution. It maintains a central queue of tasks, which are `std::function` objects, and a
- * collection of worker threads that continuously dequeue and execute these tasks. By reusing
-threads,
- * the pool avoids the high overhead of creating new threads for each task. Synchronization between
- * the producer (enqueuing thread) and consumers (worker threads) is handled gracefully using a
- * `std::mutex` and a `std::condition_variable`, which allows worker threads to sleep efficiently
- * when no tasks are available, thus conserving CPU resources. The `ThreadPool` is designed for
- * graceful shutdown; its destructor ensures that all enqueued tasks are completed before the
-- * application exits.
-+ * application exits. The `enqueue` method returns a `std::future`, enabling the caller to
-+ * retrieve the result of the asynchronous operation at a later time.
+ * @details Every worker owns two queues: a `WorkStealingDeque` for the tasks submitted by the
+ * tasks it runs, which it pops newest first without locking, and a lock-free `BoundedQueue` inbox
+ * for the tasks submitted from other threads, which are spread round-robin over the workers. A
+ * worker whose queues are empty steals the oldest tasks of the others before it sleeps. When
+ * every inbox is full, a submitting thread outside the pool waits for room, so a producer that
+ * outpaces the workers is slowed down instead of queueing without limit. Tasks are stored as
+ * `Task`s, inline when their closure is small, and the slots of the deques are recycled per
+ * worker, so submitting does not allocate in the common case.
+ *
+ * `enqueue` returns a `std::future` for the result; `submit` and `submit_bulk` run fire-and-forget
+ * tasks; `parallel_for` splits an index range into chunks that the workers and the calling thread
+ * claim until none is left. The destructor completes every submitted task before it returns.
  */
 class ThreadPool {
   public:
@@ -67,16 +70,20 @@ class ThreadPool {
      * @param threads The number of worker threads to create in the pool. If this parameter is
      * omitted, it judiciously defaults to the number of concurrent threads supported by the
      *                hardware, as determined by `std::thread::hardware_concurrency()`.
+     * @param pin_threads `true` to pin worker `i` to the `i`-th CPU available to the process (see
+     * `set_current_thread_affinity`). Pools that own the machine's cores, such as the request
+     * workers, benefit; pools that run alongside others should not pin.
      */
     explicit ThreadPool(const std::string &name_prefix = "Worker",
-                        size_t threads = std::thread::hardware_concurrency());
+                        size_t threads = std::thread::hardware_concurrency(),
+                        bool pin_threads = false);
 
     /**
      * @brief Destroys the `ThreadPool`, initiating a graceful shutdown sequence.
-     * @details The destructor ensures that no new tasks can be enqueued, then notifies all worker
-     *          threads to wake up. The workers will process any remaining tasks in the queue before
-     *          exiting their main loop. The destructor then blocks, joining each thread to
-     * guarantee a clean and orderly termination.
+     * @details The destructor ensures that no new tasks can be enqueued from outside the pool,
+     *          then wakes all worker threads. The workers run every remaining task, including the
+     *          tasks those tasks submit, before exiting their main loop. The destructor then
+     *          blocks, joining each thread to guarantee a clean and orderly termination.
      */
     ~ThreadPool();
 
@@ -119,10 +126,9 @@ class ThreadPool {
      *
      * @details This variadic template method accepts a callable entity (e.g., a function, lambda,
      * or functor) and its arguments. It perfectly forwards these arguments and packages the call
-     * into a `std::packaged_task`. The task is then type-erased into a `std::function<void()>`
-     * and placed onto the thread-safe queue. The method returns a `std::future` which will
-     * eventually hold the result of the function's execution, allowing the caller to synchronize
-     * with the task's completion and retrieve its return value.
+     * into a `std::packaged_task`, which is moved into a `Task` and submitted like `submit` does.
+     * The method returns a `std::future` which will eventually hold the result of the function's
+     * execution, or the exception it threw.
      *
      * @tparam F The type of the callable object.
      * @tparam Args The types of the arguments to be passed to the callable.
@@ -130,85 +136,149 @@ class ThreadPool {
      * @param args The arguments to be forwarded to the callable object.
      * @return A `std::future<return_type>` where `return_type` is the result type of the callable.
      *         This future can be used to wait for the task and get its result.
-     * @throws `std::runtime_error` if `enqueue` is called after the thread pool has been signaled
-     *         to stop, preventing new work from being added during shutdown.
+     * @throws `std::runtime_error` if `enqueue` is called from outside the pool after the thread
+     *         pool has been signaled to stop, preventing new work from being added during shutdown.
      */
-    template <class F, class... Args>
+    template <typename F, typename... Args>
     [[nodiscard]] auto enqueue(F &&f, Args &&...args)
         -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
-        // `std::invoke_result_t` (C++17) is used to elegantly deduce the return type of the
-        // callable `F` when invoked with the given `Args...`. `std::decay_t` removes cv-qualifiers
-        // and references.
         using return_type = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
 
-        // A `std::packaged_task` is created to bundle the callable and a `std::promise`, which will
-        // store the result or exception. A shared pointer is used to manage its lifetime across
-        // threads.
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-
-        // The `std::future` is retrieved from the packaged_task before it is moved into the queue.
-        // This future is the handle that the caller will use to interact with the asynchronous
-        // result.
-        std::future<return_type> res = task->get_future();
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-
-            // A critical check to ensure that no new tasks are accepted once the pool has initiated
-            // its shutdown sequence. This prevents race conditions during destruction.
-            if (stop_.load(std::memory_order_relaxed)) {
-                throw std::runtime_error("Cannot enqueue on a stopped ThreadPool");
-            }
-
-            // The packaged_task, captured by a lambda, is type-erased into a
-            // `std::function<void()>` and enqueued. This allows the queue to hold heterogeneous
-            // tasks.
-            tasks_.emplace([task]() {
-                (*task)();
-            });
+        std::packaged_task<return_type()> task;
+        if constexpr (sizeof...(Args) == 0) {
+            task = std::packaged_task<return_type()>(std::forward<F>(f));
+        } else {
+            task = std::packaged_task<return_type()>(
+                std::bind(std::forward<F>(f), std::forward<Args>(args)...));
         }
-
-        // A single waiting worker thread is notified that a new task is available. `notify_one` is
-        // more efficient than `notify_all` when only one task is added.
-        condition_.notify_one();
+        std::future<return_type> res = task.get_future();
+        push(Task(std::move(task)));
         return res;
     }
 
+    /**
+     * @brief Submits a task without a future.
+     * @details Saves the shared state of `enqueue`'s future. An exception escaping the task
+     * terminates the program, as it would on a `std::thread`.
+     * @tparam F The type of the callable, invocable without arguments.
+     * @param f The callable.
+     * @throws `std::runtime_error` if called from outside the pool after it has been signaled to
+     *         stop.
+     */
+    template <typename F>
+    void submit(F &&f) {
+        push(Task(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Submits a batch of tasks at once.
+     * @details From outside the pool, the tasks are spread round-robin over the workers' inboxes
+     * and as many sleeping workers are woken as there are tasks. From a worker, they are pushed
+     * onto its own deque, from which idle workers steal.
+     * @param tasks The tasks; left empty.
+     * @throws `std::runtime_error` if called from outside the pool after it has been signaled to
+     *         stop.
+     */
+    void submit_bulk(std::vector<Task> &tasks);
+
+    /**
+     * @brief Runs a function over consecutive chunks of an index range and waits for all of them.
+     *
+     * @details The chunks are claimed dynamically by the calling thread and by up to `size()`
+     * helper tasks, so uneven chunks balance out and a call from a busy pool, or from one of its
+     * own workers, still progresses on the calling thread. If `body` throws, the chunks not yet
+     * started are skipped and the first exception is rethrown here.
+     *
+     * @tparam F The type of the function, invocable as `body(size_t begin, size_t end)`.
+     * @param begin The first index.
+     * @param end The index after the last.
+     * @param grain The length of a chunk; 0 chooses about four chunks per thread.
+     * @param body The function, called once per chunk, concurrently from several threads.
+     */
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F &&body) {
+        if (begin >= end) return;
+        auto call = [](void *context, size_t chunk_begin, size_t chunk_end) {
+            (*static_cast<std::remove_reference_t<F> *>(context))(chunk_begin, chunk_end);
+        };
+        run_range(begin, end, grain, call, static_cast<void *>(std::addressof(body)));
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     * @return The number of workers.
+     */
+    [[nodiscard]] size_t size() const noexcept { return workers_.size(); }
+
   private:
+    struct Worker;
+    struct TaskSlot;
+    struct RangeJob;
+
+    /**
+     * @brief Submits a task to the current worker's deque or to an inbox.
+     * @param task The task.
+     */
+    void push(Task &&task);
+
     /**
-     * @var workers_
-     * @brief A vector of `std::thread` objects representing the pool of worker threads.
+     * @brief Places a task submitted from outside the pool in an inbox, waiting while all are full.
+     * @param first The index of the inbox to try first, modulo the number of workers.
+     * @param task The task.
      */
-    std::vector<std::thread> workers_;
+    void post(size_t first, Task &&task);
 
     /**
-     * @var tasks_
-     * @brief A queue of `std::function<void()>` objects. This serves as the task queue where
-     * producers place work to be consumed by the worker threads.
+     * @brief The main loop of a worker thread.
+     * @param index The index of the worker.
      */
-    std::queue<std::function<void()>> tasks_;
+    void work(size_t index);
 
     /**
-     * @var queue_mutex_
-     * @brief A `std::mutex` to ensure exclusive, thread-safe access to the shared `tasks_` queue.
-     * It must be locked before any modification or inspection of the queue.
+     * @brief Takes a task from the worker's own queues or steals one from another worker.
+     * @param index The index of the worker.
+     * @param task Receives the task.
+     * @return `true` if a task was taken.
      */
-    mutable std::mutex queue_mutex_;
+    bool take(size_t index, Task &task);
 
     /**
-     * @var condition_
-     * @brief A `std::condition_variable` used for efficient synchronization between producer and
-     * consumer threads. Workers wait on this variable when the task queue is empty.
+     * @brief Wakes sleeping workers after tasks were queued.
+     * @param count The number of tasks queued.
      */
-    std::condition_variable condition_;
+    void wake(size_t count);
 
     /**
-     * @var stop_
-     * @brief An atomic boolean flag used to signal the termination state to all worker threads.
-     * When set to `true`, workers will cease fetching new tasks and begin to exit.
+     * @brief Runs `parallel_for` on a type-erased function.
+     * @param begin The first index.
+     * @param end The index after the last.
+     * @param grain The length of a chunk, or 0.
+     * @param call Calls the function stored at `context` on one chunk.
+     * @param context The function.
      */
-    std::atomic<bool> stop_;
+    void run_range(size_t begin, size_t end, size_t grain,
+                   void (*call)(void *context, size_t begin, size_t end), void *context);
+
+    /// The workers, each with its queues and thread.
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /// The queued tasks that no worker has taken yet; workers sleep only while it is 0.
+    alignas(64) std::atomic<size_t> pending_{0};
+
+    /// The workers that are sleeping or about to sleep.
+    alignas(64) std::atomic<size_t> idle_{0};
+
+    /// The inbox that receives the next task submitted from outside the pool.
+    std::atomic<size_t> next_inbox_{0};
+
+    /// Guards the sleeping of workers together with `wakeup_`.
+    std::mutex sleep_mutex_;
+
+    /// Wakes sleeping workers when tasks are queued or the pool stops.
+    std::condition_variable wakeup_;
+
+    /// Set by the destructor; the workers exit once no task is pending.
+    std::atomic<bool> stop_{false};
 };
 
 }  // namespace aevum::util::concurrency
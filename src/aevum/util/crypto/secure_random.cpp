@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file secure_random.cpp
+ * @brief Implements `secure_random_bytes` over `getrandom(2)`, falling back to `/dev/urandom`.
+ */
+#include "aevum/util/crypto/secure_random.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+namespace aevum::util::crypto {
+
+/**
+ * @brief Returns bytes from the operating system's cryptographically secure generator.
+ * @details `getrandom` may return fewer bytes than asked when interrupted, so it is called until
+ * the buffer is full. If the kernel does not provide it, the bytes are read from
+ * `/dev/urandom`.
+ * @param count The number of bytes.
+ * @return The bytes.
+ * @throws std::runtime_error If the generator cannot be read.
+ */
+std::string secure_random_bytes(size_t count) {
+    std::string bytes(count, '\0');
+    size_t filled = 0;
+#if defined(__linux__)
+    while (filled < count) {
+        ssize_t got = getrandom(bytes.data() + filled, count - filled, 0);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        filled += static_cast<size_t>(got);
+    }
+#endif
+    if (filled < count) {
+        std::ifstream urandom("/dev/urandom", std::ios::binary);
+        if (!urandom.read(bytes.data() + filled, static_cast<std::streamsize>(count - filled))) {
+            throw std::runtime_error("Cannot read the system's secure random generator");
+        }
+    }
+    return bytes;
+}
+
+}  // namespace aevum::util::crypto
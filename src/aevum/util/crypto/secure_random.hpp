@@ -0,0 +1,28 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file secure_random.hpp
+ * @brief Declares the source of unpredictable bytes for salts and session tokens.
+ * @details `aevum::util::uuid` seeds a fast pseudo-random generator, whose future output can be
+ * predicted from its past output; a token that grants access must instead come from the
+ * operating system's cryptographically secure generator.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace aevum::util::crypto {
+
+/**
+ * @brief Returns bytes from the operating system's cryptographically secure generator.
+ * @details Reads `getrandom(2)`, or `/dev/urandom` where the system call is not available.
+ * @param count The number of bytes.
+ * @return The bytes.
+ * @throws std::runtime_error If the generator cannot be read.
+ */
+[[nodiscard]] std::string secure_random_bytes(size_t count);
+
+}  // namespace aevum::util::crypto
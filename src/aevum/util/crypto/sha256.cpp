@@ -0,0 +1,305 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file sha256.cpp
+ * @brief Implements SHA-256, HMAC-SHA-256, PBKDF2-HMAC-SHA-256, and their helpers.
+ */
+#include "aevum/util/crypto/sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace aevum::util::crypto {
+
+namespace {
+
+/// The round constants of SHA-256.
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+/// The size of a SHA-256 block, in bytes.
+constexpr size_t BLOCK_SIZE = 64;
+
+/**
+ * @brief Rotates a word right.
+ * @param x The word.
+ * @param n The distance, between 1 and 31.
+ * @return The rotated word.
+ */
+constexpr uint32_t rotr(uint32_t x, unsigned n) noexcept { return (x >> n) | (x << (32 - n)); }
+
+/**
+ * @brief Returns the inner and outer hashes of HMAC-SHA-256, keyed and ready for a message.
+ * @param key The key, of any length.
+ * @param inner Receives the hash keyed with the inner pad.
+ * @param outer Receives the hash keyed with the outer pad.
+ */
+void hmac_key(std::string_view key, Sha256 &inner, Sha256 &outer) noexcept {
+    std::array<uint8_t, BLOCK_SIZE> block{};
+    if (key.size() > BLOCK_SIZE) {
+        Sha256Digest digest = sha256(key);
+        std::memcpy(block.data(), digest.data(), digest.size());
+    } else {
+        std::memcpy(block.data(), key.data(), key.size());
+    }
+    std::array<char, BLOCK_SIZE> pad{};
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) pad[i] = static_cast<char>(block[i] ^ 0x36);
+    inner.update({pad.data(), pad.size()});
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) pad[i] = static_cast<char>(block[i] ^ 0x5c);
+    outer.update({pad.data(), pad.size()});
+}
+
+/**
+ * @brief Finishes an HMAC from its keyed hashes.
+ * @param inner The keyed inner hash, copied.
+ * @param outer The keyed outer hash, copied.
+ * @param message The message.
+ * @return The authentication code.
+ */
+Sha256Digest hmac_finish(Sha256 inner, Sha256 outer, std::string_view message) noexcept {
+    inner.update(message);
+    Sha256Digest digest = inner.finalize();
+    outer.update({reinterpret_cast<const char *>(digest.data()), digest.size()});
+    return outer.finalize();
+}
+
+/**
+ * @brief Returns the value of a hexadecimal digit.
+ * @param c The character.
+ * @return The value, or -1 if `c` is not a hexadecimal digit.
+ */
+int hex_value(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructs a hash of the empty message, with the initial state of FIPS 180-4.
+ */
+Sha256::Sha256() noexcept
+    : state_{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab,
+             0x5be0cd19} {}
+
+/**
+ * @brief Appends data to the message, compressing each block as it is completed.
+ * @details Whole blocks of `data` are compressed in place, without going through the buffer.
+ * @param data The data.
+ */
+void Sha256::update(std::string_view data) noexcept {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+    size_t remaining = data.size();
+    length_ += remaining;
+    if (buffered_ > 0) {
+        size_t take = std::min(remaining, BLOCK_SIZE - buffered_);
+        std::memcpy(buffer_.data() + buffered_, bytes, take);
+        buffered_ += take;
+        bytes += take;
+        remaining -= take;
+        if (buffered_ < BLOCK_SIZE) return;
+        compress(buffer_.data());
+        buffered_ = 0;
+    }
+    for (; remaining >= BLOCK_SIZE; bytes += BLOCK_SIZE, remaining -= BLOCK_SIZE) {
+        compress(bytes);
+    }
+    std::memcpy(buffer_.data(), bytes, remaining);
+    buffered_ = remaining;
+}
+
+/**
+ * @brief Pads the message with a one bit, zeroes, and its length in bits, and returns the
+ * digest.
+ * @return The digest, big-endian.
+ */
+Sha256Digest Sha256::finalize() noexcept {
+    uint64_t bits = length_ * 8;
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > BLOCK_SIZE - 8) {
+        std::fill(buffer_.begin() + static_cast<std::ptrdiff_t>(buffered_), buffer_.end(), 0);
+        compress(buffer_.data());
+        buffered_ = 0;
+    }
+    std::fill(buffer_.begin() + static_cast<std::ptrdiff_t>(buffered_), buffer_.end() - 8, 0);
+    for (int i = 0; i < 8; ++i) {
+        buffer_[BLOCK_SIZE - 1 - static_cast<size_t>(i)] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    compress(buffer_.data());
+
+    Sha256Digest digest;
+    for (size_t i = 0; i < state_.size(); ++i) {
+        digest[4 * i] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return digest;
+}
+
+/**
+ * @brief Compresses one block into the state, with the 64 rounds of FIPS 180-4.
+ * @param block The 64-byte block.
+ */
+void Sha256::compress(const uint8_t *block) noexcept {
+    std::array<uint32_t, 64> w;
+    for (size_t i = 0; i < 16; ++i) {
+        w[i] = (uint32_t{block[4 * i]} << 24) | (uint32_t{block[4 * i + 1]} << 16) |
+               (uint32_t{block[4 * i + 2]} << 8) | uint32_t{block[4 * i + 3]};
+    }
+    for (size_t i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+    for (size_t i = 0; i < 64; ++i) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + majority;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+    state_[5] += f;
+    state_[6] += g;
+    state_[7] += h;
+}
+
+/**
+ * @brief Computes the SHA-256 digest of a message.
+ * @param data The message.
+ * @return The digest.
+ */
+Sha256Digest sha256(std::string_view data) noexcept {
+    Sha256 hash;
+    hash.update(data);
+    return hash.finalize();
+}
+
+/**
+ * @brief Computes the HMAC-SHA-256 of a message, as in RFC 2104.
+ * @param key The key; a key longer than a block is hashed first.
+ * @param message The message.
+ * @return The authentication code.
+ */
+Sha256Digest hmac_sha256(std::string_view key, std::string_view message) noexcept {
+    Sha256 inner, outer;
+    hmac_key(key, inner, outer);
+    return hmac_finish(inner, outer, message);
+}
+
+/**
+ * @brief Derives a key with PBKDF2-HMAC-SHA-256, as in RFC 8018.
+ * @details The HMAC is keyed with the password once; every iteration then copies the two keyed
+ * states and compresses one block into each, rather than rehashing the padded password.
+ * @param password The password.
+ * @param salt The salt.
+ * @param iterations The number of iterations; 0 is treated as 1.
+ * @param length The length of the derived key, in bytes.
+ * @return The derived key, as raw bytes.
+ */
+std::string pbkdf2_sha256(std::string_view password, std::string_view salt, uint32_t iterations,
+                          size_t length) {
+    Sha256 inner, outer;
+    hmac_key(password, inner, outer);
+
+    std::string derived;
+    derived.reserve(length);
+    std::string first(salt);
+    first.resize(salt.size() + 4);
+    for (uint32_t block = 1; derived.size() < length; ++block) {
+        first[salt.size()] = static_cast<char>(block >> 24);
+        first[salt.size() + 1] = static_cast<char>(block >> 16);
+        first[salt.size() + 2] = static_cast<char>(block >> 8);
+        first[salt.size() + 3] = static_cast<char>(block);
+        Sha256Digest u = hmac_finish(inner, outer, first);
+        Sha256Digest t = u;
+        for (uint32_t i = 1; i < iterations; ++i) {
+            u = hmac_finish(inner, outer, {reinterpret_cast<const char *>(u.data()), u.size()});
+            for (size_t j = 0; j < t.size(); ++j) t[j] ^= u[j];
+        }
+        size_t take = std::min(t.size(), length - derived.size());
+        derived.append(reinterpret_cast<const char *>(t.data()), take);
+    }
+    return derived;
+}
+
+/**
+ * @brief Compares two byte strings without branching on their contents.
+ * @param a The first string.
+ * @param b The second string.
+ * @return `true` if the strings are equal.
+ */
+bool constant_time_equal(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size()) return false;
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        difference |= static_cast<unsigned char>(a[i] ^ b[i]);
+    }
+    return difference == 0;
+}
+
+/**
+ * @brief Encodes bytes as lowercase hexadecimal.
+ * @param bytes The bytes.
+ * @return Two hexadecimal digits per byte.
+ */
+std::string to_hex(std::string_view bytes) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string hex(bytes.size() * 2, '\0');
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        auto byte = static_cast<unsigned char>(bytes[i]);
+        hex[2 * i] = DIGITS[byte >> 4];
+        hex[2 * i + 1] = DIGITS[byte & 0x0f];
+    }
+    return hex;
+}
+
+/**
+ * @brief Decodes hexadecimal into bytes.
+ * @param hex The hexadecimal digits, of either case.
+ * @param out Receives the bytes.
+ * @return `false` if `hex` has an odd length or a character that is not a hexadecimal digit.
+ */
+bool from_hex(std::string_view hex, std::string &out) {
+    if (hex.size() % 2 != 0) return false;
+    out.resize(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); ++i) {
+        int high = hex_value(hex[2 * i]);
+        int low = hex_value(hex[2 * i + 1]);
+        if (high < 0 || low < 0) return false;
+        out[i] = static_cast<char>((high << 4) | low);
+    }
+    return true;
+}
+
+}  // namespace aevum::util::crypto
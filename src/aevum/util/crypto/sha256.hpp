@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file sha256.hpp
+ * @brief Declares SHA-256, HMAC-SHA-256, and the PBKDF2-HMAC-SHA-256 key derivation function.
+ * @details Credentials are verified with a deliberately slow key derivation function, so that
+ * a copy of the stored verifiers does not let an attacker test guesses at hash-table speed.
+ * These are the portable FIPS 180-4, RFC 2104, and RFC 8018 constructions; PBKDF2 keys its
+ * HMAC once and reuses the keyed states, so that each iteration costs two compressions.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace aevum::util::crypto
+ * @brief Cryptographic primitives: hashing, key derivation, and secure randomness.
+ * @details Unlike `aevum::util::hash`, whose functions are built for hash tables, the functions
+ * of this namespace are meant for credentials and tokens.
+ */
+namespace aevum::util::crypto {
+
+/// The size of a SHA-256 digest, in bytes.
+constexpr size_t SHA256_DIGEST_SIZE = 32;
+
+/// A SHA-256 digest.
+using Sha256Digest = std::array<uint8_t, SHA256_DIGEST_SIZE>;
+
+/**
+ * @class Sha256
+ * @brief An incremental SHA-256 hash.
+ * @details The state is a plain value, so a partially fed hash can be copied and continued,
+ * which HMAC and PBKDF2 use to key a hash once.
+ */
+class Sha256 {
+  public:
+    /**
+     * @brief Constructs a hash of the empty message.
+     */
+    Sha256() noexcept;
+
+    /**
+     * @brief Appends data to the message.
+     * @param data The data.
+     */
+    void update(std::string_view data) noexcept;
+
+    /**
+     * @brief Pads the message and returns its digest.
+     * @details The hash must not be updated afterwards.
+     * @return The digest.
+     */
+    [[nodiscard]] Sha256Digest finalize() noexcept;
+
+  private:
+    /**
+     * @brief Compresses one 64-byte block into the state.
+     * @param block The block.
+     */
+    void compress(const uint8_t *block) noexcept;
+
+    /// The chaining state.
+    std::array<uint32_t, 8> state_;
+    /// The bytes of the current, incomplete block.
+    std::array<uint8_t, 64> buffer_{};
+    /// The number of bytes in `buffer_`.
+    size_t buffered_{0};
+    /// The length of the message so far, in bytes.
+    uint64_t length_{0};
+};
+
+/**
+ * @brief Computes the SHA-256 digest of a message.
+ * @param data The message.
+ * @return The digest.
+ */
+[[nodiscard]] Sha256Digest sha256(std::string_view data) noexcept;
+
+/**
+ * @brief Computes the HMAC-SHA-256 of a message.
+ * @param key The key, of any length.
+ * @param message The message.
+ * @return The authentication code.
+ */
+[[nodiscard]] Sha256Digest hmac_sha256(std::string_view key, std::string_view message) noexcept;
+
+/**
+ * @brief Derives a key from a password with PBKDF2-HMAC-SHA-256.
+ * @param password The password.
+ * @param salt The salt.
+ * @param iterations The number of iterations, at least 1.
+ * @param length The length of the derived key, in bytes.
+ * @return The derived key, as raw bytes.
+ */
+[[nodiscard]] std::string pbkdf2_sha256(std::string_view password, std::string_view salt,
+                                        uint32_t iterations, size_t length);
+
+/**
+ * @brief Compares two byte strings in time that depends only on their lengths.
+ * @param a The first string.
+ * @param b The second string.
+ * @return `true` if the strings are equal.
+ */
+[[nodiscard]] bool constant_time_equal(std::string_view a, std::string_view b) noexcept;
+
+/**
+ * @brief Encodes bytes as lowercase hexadecimal.
+ * @param bytes The bytes.
+ * @return Two hexadecimal digits per byte.
+ */
+[[nodiscard]] std::string to_hex(std::string_view bytes);
+
+/**
+ * @brief Decodes hexadecimal into bytes.
+ * @param hex The hexadecimal digits, of either case.
+ * @param out Receives the bytes.
+ * @return `false` if `hex` has an odd length or a character that is not a hexadecimal digit.
+ */
+[[nodiscard]] bool from_hex(std::string_view hex, std::string &out);
+
+}  // namespace aevum::util::crypto
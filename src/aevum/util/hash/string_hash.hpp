@@ -0,0 +1,40 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file string_hash.hpp
+ * @brief Declares `StringHash`, the wyhash-based hasher of the engine's string-keyed hash maps.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "aevum/util/hash/wyhash.hpp"
+
+namespace aevum::util::hash {
+
+/**
+ * @struct StringHash
+ * @brief Hashes strings and string views alike with `wyhash`.
+ *
+ * @details The hasher is transparent: a `std::string` and a `std::string_view` of the same
+ * characters hash equally, so maps that declare it together with `std::equal_to<>` accept views
+ * for lookups once the standard library allows heterogeneous lookups in unordered containers.
+ * Tables built on it, such as `IdTable`, already search by view.
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    /**
+     * @brief Hashes a string.
+     * @param value The string.
+     * @return Its wyhash.
+     */
+    [[nodiscard]] size_t operator()(std::string_view value) const noexcept {
+        return static_cast<size_t>(wyhash(value));
+    }
+};
+
+}  // namespace aevum::util::hash
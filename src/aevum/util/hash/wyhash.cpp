@@ -0,0 +1,151 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file wyhash.cpp
+ * @brief Provides the concrete implementation of the wyhash hashing algorithm.
+ * @details This follows the final version 4 of Wang Yi's reference implementation with its
+ * default secret, so the values match those of the reference `wyhash(key, len, seed, _wyp)` on
+ * little-endian hosts.
+ */
+#include "aevum/util/hash/wyhash.hpp"
+
+#include <cstring>
+
+namespace aevum::util::hash {
+
+namespace {
+
+/// The default secret of the reference implementation: four odd 64-bit constants.
+constexpr uint64_t SECRET[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+/// Derives the seed of the high half of `wyhash128` from that of the low half.
+constexpr uint64_t HIGH_SEED_SALT = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * @brief Multiplies two 64-bit values into 128 bits.
+ * @param a Receives the low half of the product.
+ * @param b Receives the high half of the product.
+ */
+inline void multiply(uint64_t &a, uint64_t &b) noexcept {
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+}
+
+/**
+ * @brief Folds the 128-bit product of two values into 64 bits.
+ * @param a The first value.
+ * @param b The second value.
+ * @return The exclusive or of the halves of the product.
+ */
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+    multiply(a, b);
+    return a ^ b;
+}
+
+/**
+ * @brief Reads 8 bytes as a little-endian integer.
+ * @param p The bytes.
+ * @return The integer.
+ */
+inline uint64_t read8(const uint8_t *p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Reads 4 bytes as a little-endian integer.
+ * @param p The bytes.
+ * @return The integer.
+ */
+inline uint64_t read4(const uint8_t *p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Reads 1 to 3 bytes into an integer, touching each byte at most once.
+ * @param p The bytes.
+ * @param k The number of bytes, 1 to 3.
+ * @return The integer.
+ */
+inline uint64_t read3(const uint8_t *p, size_t k) noexcept {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) |
+           p[k - 1];
+}
+
+}  // namespace
+
+/**
+ * @brief Computes the 64-bit wyhash of a given block of data.
+ * @details Keys of up to 16 bytes are read as two overlapping words with no loop at all; longer
+ * keys are consumed 48 bytes per iteration in three independent lanes, then 16 bytes at a time,
+ * and finish with the last 16 bytes, which may overlap those already read.
+ * @param data The data to be hashed.
+ * @param seed The seed.
+ * @return The calculated 64-bit hash value.
+ */
+uint64_t wyhash(std::string_view data, uint64_t seed) noexcept {
+    const auto *p = reinterpret_cast<const uint8_t *>(data.data());
+    size_t length = data.size();
+    seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t step = (length >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + step);
+            b = (read4(p + length - 4) << 32) | read4(p + length - 4 - step);
+        } else if (length > 0) {
+            a = read3(p, length);
+        }
+    } else {
+        size_t remaining = length;
+        if (remaining >= 48) {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do {
+                seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+                lane1 = mix(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ lane1);
+                lane2 = mix(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining >= 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16) {
+            seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = read8(p + remaining - 16);
+        b = read8(p + remaining - 8);
+    }
+    a ^= SECRET[1];
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+}
+
+/**
+ * @brief Computes a 128-bit hash of a given block of data.
+ * @param data The data to be hashed.
+ * @param seed The seed of the low half; the high half uses a seed derived from it.
+ * @return The calculated 128-bit hash value.
+ */
+Hash128 wyhash128(std::string_view data, uint64_t seed) noexcept {
+    return Hash128{wyhash(data, seed), wyhash(data, seed ^ HIGH_SEED_SALT)};
+}
+
+}  // namespace aevum::util::hash
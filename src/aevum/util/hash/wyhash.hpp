@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file wyhash.hpp
+ * @brief Declares the interface for the wyhash non-cryptographic hashing algorithm.
+ * @details wyhash consumes its input eight and sixteen bytes at a time and mixes them with 64x64
+ * to 128-bit multiplications, so it hashes short keys in a handful of instructions and long ones
+ * at several bytes per cycle, with a distribution that passes SMHasher. It is the hash of the
+ * in-memory index tables, the `_id` filters, and the result cache keys.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @namespace aevum::util::hash
+ * @brief A collection of fast, non-cryptographic hashing algorithms.
+ * @details This namespace provides implementations of various hashing utilities that are optimized
+ * for speed and are suitable for use in data structures like hash tables, but not for
+ * security-sensitive applications.
+ */
+namespace aevum::util::hash {
+
+/**
+ * @struct Hash128
+ * @brief A 128-bit hash value, as two 64-bit halves.
+ */
+struct Hash128 {
+    /// The low half.
+    uint64_t low{0};
+    /// The high half.
+    uint64_t high{0};
+
+    /**
+     * @brief Compares two hash values.
+     * @param other The other value.
+     * @return `true` if both halves are equal.
+     */
+    [[nodiscard]] bool operator==(const Hash128 &other) const noexcept {
+        return low == other.low && high == other.high;
+    }
+};
+
+/**
+ * @brief Computes the 64-bit wyhash of a given block of data.
+ *
+ * @details The input is read in little-endian order whatever the host's byte order, so the hash
+ * of a key is the same on every platform and may be stored, as the `_id` filters are.
+ *
+ * @param data The data to be hashed.
+ * @param seed Selects one of a family of independent hash functions; 0 unless the hash must not
+ *             be predictable.
+ * @return The calculated 64-bit unsigned hash value.
+ */
+[[nodiscard]] uint64_t wyhash(std::string_view data, uint64_t seed = 0) noexcept;
+
+/**
+ * @brief Computes a 128-bit hash of a given block of data.
+ *
+ * @details The halves are the wyhash of the data under two seeds derived from `seed`. With 128
+ * bits, the chance that two of a billion distinct keys collide is below 10^-20, so the hash can
+ * stand in for a key that is never compared in full.
+ *
+ * @param data The data to be hashed.
+ * @param seed Selects the pair of seeds.
+ * @return The calculated 128-bit hash value.
+ */
+[[nodiscard]] Hash128 wyhash128(std::string_view data, uint64_t seed = 0) noexcept;
+
+}  // namespace aevum::util::hash
@@ -6,26 +6,36 @@
  * @file logger.cpp
  * @brief Implements the concrete logic for the thread-safe, static logging engine.
  * @details This source file provides the definitions for the `Logger` class's static methods.
- * It manages a global log level and employs a global mutex to ensure that log messages from
- * multiple threads are written atomically to the appropriate output streams (`std::cout` or
- * `std::cerr`), preventing interleaved and corrupted output. The log output is enhanced with
- * color-coding and includes timestamps and thread IDs for comprehensive diagnostics.
+ * It manages a global log level and two ways of emitting a message. Synchronously, a global mutex
+ * ensures that log messages from multiple threads are written atomically to the appropriate
+ * output streams (`std::cout` or `std::cerr`). Asynchronously, each thread records its messages
+ * into a single-producer, single-consumer ring buffer of its own, and a background sink thread
+ * drains every ring, orders the records by time, and writes them in batches. The log output is
+ * enhanced with color-coding and includes timestamps and thread IDs for comprehensive
+ * diagnostics.
  */
 #include "aevum/util/log/logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <mutex>
-#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
-#include "aevum/util/time/timestamp.hpp"
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/time/coarse_clock.hpp"
 
 namespace aevum::util::log {
 
-// A file-static global variable that holds the current minimum log level.
-// Messages with a severity below this level will be discarded. It is initialized
-// to `LogLevel::INFO` as a sensible default for most applications.
-static LogLevel g_current_level = LogLevel::INFO;
+// The minimum log level, initialized to `LogLevel::INFO` as a sensible default for most
+// applications. Messages with a severity below this level are discarded.
+std::atomic<uint8_t> Logger::min_level_{static_cast<uint8_t>(LogLevel::INFO)};
 
 // A file-static global mutex to protect against data races when multiple threads
 // attempt to write to the standard output streams simultaneously. This ensures that
@@ -42,80 +52,353 @@ constexpr std::string_view RED = "\033[31m";
 constexpr std::string_view BOLDRED = "\033[1;31m";
 }  // namespace colors
 
+namespace {
+
+/// The number of records a thread's ring holds; a power of two.
+constexpr size_t LOG_RING_CAPACITY = 256;
+/// The longest message a ring slot holds; longer ones are written synchronously.
+constexpr size_t LOG_RECORD_TEXT_SIZE = 232;
+/// How long the sink sleeps when it finds every ring empty.
+constexpr auto LOG_SINK_IDLE_WAIT = std::chrono::milliseconds(10);
+
+/**
+ * @brief Returns the ANSI color code of a severity level.
+ * @param level The severity level.
+ * @return The escape sequence that starts the level's color.
+ */
+std::string_view level_color(LogLevel level) noexcept {
+    switch (level) {
+        case LogLevel::DEBUG:
+            return colors::BLUE;
+        case LogLevel::INFO:
+            return colors::GREEN;
+        case LogLevel::WARN:
+            return colors::YELLOW;
+        case LogLevel::ERROR:
+            return colors::RED;
+        case LogLevel::FATAL:
+            return colors::BOLDRED;
+        default:
+            return colors::RESET;
+    }
+}
+
+/**
+ * @brief Returns the label of the calling thread in log entries.
+ * @return The thread's name, or its id if it was never named, formatted once per thread.
+ */
+const std::string &log_thread_label() { return aevum::util::concurrency::current_thread_name(); }
+
+/**
+ * @brief Appends a fully formatted log entry, terminated by a newline, to a buffer.
+ * @param out The buffer.
+ * @param unix_ms The time the message was logged.
+ * @param level The severity level.
+ * @param thread_label The ID of the thread that logged the message.
+ * @param message The message.
+ */
+void format_log_entry(std::string &out, uint64_t unix_ms, LogLevel level,
+                      std::string_view thread_label, std::string_view message) {
+    out += '[';
+    aevum::util::time::CoarseClock::append_iso8601(unix_ms, out);
+    out += "] ";
+    out += level_color(level);
+    out += '[';
+    out += to_string(level);
+    out += ']';
+    out += colors::RESET;
+    out += " [";
+    out += thread_label;
+    out += "] ";
+    out += message;
+    out += '\n';
+}
+
+/**
+ * @brief Writes formatted entries to the stream of their severity, under the output mutex.
+ * @param level The severity level, which selects `stderr` for errors and `stdout` otherwise.
+ * @param text The formatted entries.
+ * @param flush Whether to flush the stream afterwards.
+ */
+void write_log_text(LogLevel level, std::string_view text, bool flush) {
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    std::ostream &out = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (flush) out.flush();
+}
+
+/**
+ * @struct LogRecord
+ * @brief A message recorded by a thread for the sink to format later.
+ */
+struct LogRecord {
+    /// The time the message was logged, in milliseconds since the UNIX epoch.
+    uint64_t unix_ms;
+    /// The severity level.
+    LogLevel level;
+    /// The number of used bytes of `text`.
+    uint16_t length;
+    /// The message, not terminated.
+    char text[LOG_RECORD_TEXT_SIZE];
+};
+
+/**
+ * @class LogRing
+ * @brief A bounded single-producer, single-consumer queue of the records of one thread.
+ * @details The owning thread is the only producer, and `push` neither locks nor allocates: it
+ * fills the next slot and publishes it with a release store of `head_`. The sink is the only
+ * consumer, under `LogSink::drain_mutex`; it publishes the slots it has copied out with a release
+ * store of `tail_`. The indices only grow, and are reduced modulo the capacity on access.
+ */
+class LogRing {
+  public:
+    explicit LogRing(std::string thread_label) : thread_label_(std::move(thread_label)) {}
+
+    /**
+     * @brief Records a message.
+     * @return `false` if the ring is full or the message does not fit into a slot.
+     */
+    bool push(uint64_t unix_ms, LogLevel level, std::string_view message) noexcept {
+        if (message.size() > LOG_RECORD_TEXT_SIZE) return false;
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == LOG_RING_CAPACITY) return false;
+        LogRecord &record = records_[head % LOG_RING_CAPACITY];
+        record.unix_ms = unix_ms;
+        record.level = level;
+        record.length = static_cast<uint16_t>(message.size());
+        std::memcpy(record.text, message.data(), message.size());
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves every published record out of the ring. Called by the consumer only.
+     * @param out Receives the records, after any it already holds.
+     */
+    void drain(std::vector<std::pair<const LogRing *, LogRecord>> &out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) out.emplace_back(this, records_[tail % LOG_RING_CAPACITY]);
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    /// Tells whether every published record has been drained.
+    [[nodiscard]] bool empty() const noexcept {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    /// The ID of the owning thread, formatted once.
+    [[nodiscard]] const std::string &thread_label() const noexcept { return thread_label_; }
+
+    /// Set when the owning thread exits; the sink forgets the ring once it is drained.
+    std::atomic<bool> retired{false};
+
+  private:
+    std::array<LogRecord, LOG_RING_CAPACITY> records_;
+    const std::string thread_label_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/**
+ * @class LogSink
+ * @brief The registry of the threads' rings and the background thread that drains them.
+ */
+class LogSink {
+  public:
+    ~LogSink() { stop(); }
+
+    /// Tells whether messages should be recorded rather than written synchronously.
+    [[nodiscard]] bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (running_.load(std::memory_order_relaxed)) return;
+        stopping_ = false;
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop() noexcept {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (!running_.load(std::memory_order_relaxed)) return;
+        running_.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) thread_.join();
+        // Records pushed between the last drain and the flag change are written here.
+        drain_all();
+    }
+
+    /// Registers the ring of a thread that logs for the first time.
+    void add(const std::shared_ptr<LogRing> &ring) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings_.push_back(ring);
+    }
+
+    /**
+     * @brief Drains every ring and writes their records in time order.
+     * @details Rings of exited threads are forgotten once they are empty. Records are sorted
+     * stably by time, so each thread's messages stay in the order it logged them.
+     * @return `true` if any record was written.
+     */
+    bool drain_all() noexcept {
+        try {
+            std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+            batch_.clear();
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                for (const auto &ring : rings_) ring->drain(batch_);
+            }
+            if (batch_.empty()) {
+                forget_retired_rings();
+                return false;
+            }
+
+            std::stable_sort(batch_.begin(), batch_.end(), [](const auto &a, const auto &b) {
+                return a.second.unix_ms < b.second.unix_ms;
+            });
+            std::string out, err;
+            for (const auto &[ring, record] : batch_) {
+                format_log_entry(record.level >= LogLevel::ERROR ? err : out, record.unix_ms,
+                             record.level, ring->thread_label(),
+                             std::string_view(record.text, record.length));
+            }
+            // The batch points into the rings, so they are only forgotten once it is formatted.
+            batch_.clear();
+            forget_retired_rings();
+            if (!out.empty()) write_log_text(LogLevel::INFO, out, true);
+            if (!err.empty()) write_log_text(LogLevel::ERROR, err, true);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+  private:
+    /// Forgets the rings of exited threads that have been drained completely.
+    void forget_retired_rings() {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const std::shared_ptr<LogRing> &ring) {
+                                        return ring->retired.load(std::memory_order_acquire) &&
+                                               ring->empty();
+                                    }),
+                     rings_.end());
+    }
+
+    void run() {
+        for (;;) {
+            if (drain_all()) continue;
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            if (wake_.wait_for(lock, LOG_SINK_IDLE_WAIT, [this] { return stopping_; })) return;
+        }
+    }
+
+    std::atomic<bool> running_{false};
+    /// Serializes `start` and `stop`.
+    std::mutex control_mutex_;
+    /// Makes `drain_all` the only consumer of the rings at any time.
+    std::mutex drain_mutex_;
+    /// The records of the current drain; reused to keep its capacity.
+    std::vector<std::pair<const LogRing *, LogRecord>> batch_;
+    /// Guards `rings_`.
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<LogRing>> rings_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::thread thread_;
+};
+
+/// The sink; a static, so that it is stopped, and its records written, at program exit.
+LogSink g_log_sink;
+
+/**
+ * @brief Returns the ring of the calling thread, creating and registering it on first use.
+ * @details The thread-local handle marks the ring retired when the thread exits; the sink keeps
+ * it alive through its own reference until the remaining records have been written.
+ */
+LogRing &current_log_ring() {
+    struct RingHandle {
+        std::shared_ptr<LogRing> ring;
+        ~RingHandle() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+    thread_local RingHandle handle;
+    if (!handle.ring) {
+        handle.ring = std::make_shared<LogRing>(log_thread_label());
+        g_log_sink.add(handle.ring);
+    }
+    return *handle.ring;
+}
+
+}  // namespace
+
 /**
  * @brief Sets the global minimum log level threshold.
  * @details This function provides a thread-safe way to dynamically control the verbosity of the
- * logger. It updates the `g_current_level` variable, which is then used by the `write`
- * function to filter messages.
+ * logger. It updates the atomic `min_level_`, which `enabled` and `write` read to filter
+ * messages.
  * @param level The new minimum `LogLevel` to apply for all subsequent logging calls.
  */
 void Logger::set_level(LogLevel level) noexcept {
-    // This operation is simple and atomic on most platforms for `uint8_t`,
-    // but explicit synchronization would be required for more complex state.
-    g_current_level = level;
+    min_level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
 }
 
 /**
- * @brief The core function for writing a formatted, color-coded log message if its level meets the
+ * @brief Starts the background sink; subsequent messages are recorded into per-thread rings.
+ */
+void Logger::start_async() { g_log_sink.start(); }
+
+/**
+ * @brief Stops the background sink after writing every pending message.
+ */
+void Logger::stop_async() noexcept { g_log_sink.stop(); }
+
+/**
+ * @brief Writes every pending message of every thread.
+ */
+void Logger::flush() noexcept { (void)g_log_sink.drain_all(); }
+
+/**
+ * @brief The core function for recording or writing a log message if its level meets the
  * threshold.
- * @details This is the centralized sink for all log messages. It performs the following sequence
- * of operations in a thread-safe manner:
+ * @details This is the centralized sink for all log messages:
  * 1. It first performs a quick check against the global log level. If the message's severity
  *    is below the threshold, the function returns immediately.
- * 2. It generates a current timestamp, the string representation of the level, and the current
- * thread ID.
- * 3. It acquires a `std::lock_guard` on the global mutex for exclusive access to the console
- * output.
- * 4. It selects the appropriate output stream (`stderr` for errors, `stdout` for others).
- * 5. It selects an ANSI color code based on the severity level.
- * 6. It writes the fully formatted log message, including timestamp, level, thread ID, and content.
- * 7. For `FATAL` errors, it explicitly flushes the stream to guarantee visibility before a crash.
+ * 2. While the background sink runs, a message other than `FATAL` is copied, with the current
+ *    time, into the calling thread's ring buffer, and the function returns.
+ * 3. Otherwise the entry is formatted with a timestamp, the color-coded level, and the thread ID,
+ *    and written under the global mutex to `stderr` for errors or `stdout` for others. Messages
+ *    still in the rings are written first, so a `FATAL` message is never followed by earlier
+ *    ones, and a `FATAL` message flushes its stream to guarantee visibility before a crash.
  * @param level The severity level of the message being logged.
  * @param message The content of the log message.
  */
 void Logger::write(LogLevel level, std::string_view message) noexcept {
     // Discard the message immediately if its level is below the configured threshold.
-    if (level < g_current_level) return;
-
-    // Generate the components of the log entry.
-    std::string timestamp = aevum::util::time::now_iso8601();
-    std::string_view level_str = to_string(level);
-    std::stringstream thread_id_ss;
-    thread_id_ss << std::this_thread::get_id();
-
-    const std::string_view *color;
-    switch (level) {
-        case LogLevel::DEBUG:
-            color = &colors::BLUE;
-            break;
-        case LogLevel::INFO:
-            color = &colors::GREEN;
-            break;
-        case LogLevel::WARN:
-            color = &colors::YELLOW;
-            break;
-        case LogLevel::ERROR:
-            color = &colors::RED;
-            break;
-        case LogLevel::FATAL:
-            color = &colors::BOLDRED;
-            break;
-        default:
-            color = &colors::RESET;
-            break;
-    }
-
-    // Acquire a lock to ensure the integrity of the output stream.
-    std::lock_guard<std::mutex> lock(g_log_mutex);
-
-    // Direct error and fatal messages to stderr, others to stdout.
-    std::ostream &out = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
+    if (!enabled(level)) return;
 
-    out << "[" << timestamp << "] " << *color << "[" << level_str << "]" << colors::RESET << " ["
-        << thread_id_ss.str() << "] " << message << "\n";
+    try {
+        const uint64_t unix_ms = aevum::util::time::CoarseClock::now_unix_ms();
+        if (g_log_sink.running()) {
+            if (level != LogLevel::FATAL && current_log_ring().push(unix_ms, level, message)) {
+                return;
+            }
+            (void)g_log_sink.drain_all();
+        }
 
-    if (level == LogLevel::FATAL) {
-        out.flush();
+        std::string entry;
+        entry.reserve(message.size() + 64);
+        format_log_entry(entry, unix_ms, level, log_thread_label(), message);
+        write_log_text(level, entry, level == LogLevel::FATAL);
+    } catch (...) {
+        // Logging must never throw into the caller; a message that cannot be formatted is lost.
     }
 }
 
@@ -8,14 +8,59 @@
  * @details This header file declares the `Logger` class, which provides a simple yet powerful
  * static interface for application-wide logging. It is designed as a utility class (i.e., not
  * meant to be instantiated) and offers a set of methods for logging messages at various
- * severity levels.
+ * severity levels. It also defines the `AEVUM_LOG_*` macros, which skip building a message
+ * altogether when its level is disabled, and compile it out when the level is below the build's
+ * `AEVUM_LOG_MIN_LEVEL`.
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string_view>
 
 #include "aevum/util/log/log_level.hpp"
 
+/**
+ * @def AEVUM_LOG_MIN_LEVEL
+ * @brief The lowest `LogLevel`, as an integer, whose `AEVUM_LOG_*` statements are compiled in.
+ * @details Defaults to 0 (`DEBUG`), which keeps every statement. The build sets it from the
+ * `AEVUM_LOG_MIN_LEVEL` CMake cache variable; a release build that never logs below `INFO` can
+ * set it to 1 to remove the debug statements, their formatting included, from the binary.
+ */
+#ifndef AEVUM_LOG_MIN_LEVEL
+#define AEVUM_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @def AEVUM_LOG
+ * @brief Logs a message built by an expression, evaluating the expression only if `level` is
+ * enabled.
+ * @details Unlike `Logger::write`, whose argument has already been built when it is called, the
+ * message expression here is evaluated after the level checks, so a disabled statement costs one
+ * relaxed atomic load and never allocates. A level below `AEVUM_LOG_MIN_LEVEL` folds the
+ * condition to `false` at compile time and the statement is removed.
+ * @param level The `LogLevel` of the message.
+ * @param ... An expression convertible to `std::string_view`, typically a string concatenation.
+ */
+#define AEVUM_LOG(level, ...)                                                                      \
+    do {                                                                                           \
+        if (::aevum::util::log::Logger::compiled_in(level) &&                                      \
+            ::aevum::util::log::Logger::enabled(level)) {                                          \
+            ::aevum::util::log::Logger::write(level, __VA_ARGS__);                                 \
+        }                                                                                          \
+    } while (false)
+
+/// Logs a message with `DEBUG` severity; see `AEVUM_LOG`.
+#define AEVUM_LOG_DEBUG(...) AEVUM_LOG(::aevum::util::log::LogLevel::DEBUG, __VA_ARGS__)
+/// Logs a message with `INFO` severity; see `AEVUM_LOG`.
+#define AEVUM_LOG_INFO(...) AEVUM_LOG(::aevum::util::log::LogLevel::INFO, __VA_ARGS__)
+/// Logs a message with `WARN` severity; see `AEVUM_LOG`.
+#define AEVUM_LOG_WARN(...) AEVUM_LOG(::aevum::util::log::LogLevel::WARN, __VA_ARGS__)
+/// Logs a message with `ERROR` severity; see `AEVUM_LOG`.
+#define AEVUM_LOG_ERROR(...) AEVUM_LOG(::aevum::util::log::LogLevel::ERROR, __VA_ARGS__)
+/// Logs a message with `FATAL` severity; see `AEVUM_LOG`.
+#define AEVUM_LOG_FATAL(...) AEVUM_LOG(::aevum::util::log::LogLevel::FATAL, __VA_ARGS__)
+
 namespace aevum::util::log {
 
 /**
@@ -31,14 +76,21 @@ namespace aevum::util::log {
  * diagnostics.
  *
  * Each log entry is meticulously formatted to include critical diagnostic information:
- * - A high-resolution timestamp (ISO 8601 format).
+ * - A timestamp (ISO 8601 format), read from the `CoarseClock` and copied from its cached
+ * rendering of the current second.
  * - A color-coded severity level, improving visual parsing in terminal environments.
- * - The ID of the thread that generated the log message, crucial for debugging concurrent
- * operations.
+ * - The name of the thread that generated the log message, or its id if it was never named,
+ * crucial for debugging concurrent operations.
  * - The actual log message content.
  *
- * The standard log output format is: `[<timestamp>] [<COLOR_CODE><LEVEL><RESET>] [<thread_id>]
+ * The standard log output format is: `[<timestamp>] [<COLOR_CODE><LEVEL><RESET>] [<thread>]
  * <message>`
+ *
+ * By default every message is written synchronously by the thread that logs it. Once
+ * `start_async()` has been called, messages are instead recorded, with their level, time, and
+ * thread, into a lock-free ring buffer owned by the logging thread, and formatted and written by
+ * a background sink thread. Messages too long for a ring slot, messages logged while the thread's
+ * ring is full, and `FATAL` messages are still written synchronously, so nothing is dropped.
  */
 class Logger {
   public:
@@ -61,12 +113,50 @@ class Logger {
     static void set_level(LogLevel level) noexcept;
 
     /**
-     * @brief The core, low-level logging function that formats and writes a message.
-     * @details This function is the final destination for all log messages. It is thread-safe,
-     * using a global mutex to serialize access to the output streams. Before writing, it
-     * prepends a timestamp, thread ID, and the message's severity level string (which is also
-     * color-coded). It is not typically called directly; developers should use the level-specific
-     * convenience wrappers like `info()`, `warn()`, etc., for better readability and intent.
+     * @brief Tells whether `AEVUM_LOG_*` statements of a level are compiled in.
+     * @param level The severity level.
+     * @return `true` if `level` is at or above `AEVUM_LOG_MIN_LEVEL`.
+     */
+    [[nodiscard]] static constexpr bool compiled_in(LogLevel level) noexcept {
+        return level >= static_cast<LogLevel>(AEVUM_LOG_MIN_LEVEL);
+    }
+
+    /**
+     * @brief Tells whether messages of a level are currently recorded.
+     * @details This is the check the `AEVUM_LOG_*` macros perform before building a message.
+     * @param level The severity level.
+     * @return `true` if `level` is at or above the level set with `set_level`.
+     */
+    [[nodiscard]] static bool enabled(LogLevel level) noexcept {
+        return static_cast<uint8_t>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Starts the background sink thread and switches to asynchronous logging.
+     * @details Has no effect if the sink is already running.
+     */
+    static void start_async();
+
+    /**
+     * @brief Writes every pending message and stops the background sink thread.
+     * @details Logging is synchronous again afterwards. The sink is also stopped at program exit,
+     * so pending messages are not lost if this is never called.
+     */
+    static void stop_async() noexcept;
+
+    /**
+     * @brief Writes every message recorded so far, from every thread, before returning.
+     */
+    static void flush() noexcept;
+
+    /**
+     * @brief The core, low-level logging function that records or writes a message.
+     * @details This function is the final destination for all log messages. It is thread-safe:
+     * in asynchronous mode the message is copied into the calling thread's ring buffer without
+     * taking a lock, and otherwise it is written under a global mutex that serializes access to
+     * the output streams. Either way the written entry carries a timestamp, thread ID, and the
+     * message's color-coded severity level. It is not typically called directly; developers
+     * should use the `AEVUM_LOG_*` macros or the level-specific wrappers like `info()`.
      * @param level The `LogLevel` severity of the message.
      * @param message The content of the message to be logged.
      */
@@ -108,6 +198,10 @@ class Logger {
      * @param msg The message to log, provided as a `std::string_view`.
      */
     static void fatal(std::string_view msg) noexcept { write(LogLevel::FATAL, msg); }
+
+  private:
+    /// The level set with `set_level`, as its underlying integer.
+    static std::atomic<uint8_t> min_level_;
 };
 
 }  // namespace aevum::util::log
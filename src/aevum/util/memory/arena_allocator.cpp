@@ -6,101 +6,134 @@
  * @file arena_allocator.cpp
  * @brief Implements the `ArenaAllocator` class for high-performance, region-based memory
  * management.
- * @details This source file provides the concrete definitions for the `ArenaAllocator` methods.
- * It details the logic for chunk management, alignment calculation, and the "bump-pointer"
- * allocation strategy that makes this allocator highly efficient.
+ * @details This source file provides the concrete definitions for the `ArenaAllocator` methods
+ * that leave the inlined bump-pointer fast path: moving between chunks, their geometric growth,
+ * the direct allocation of oversized blocks, rewinding to a mark, and the trim on reset.
  */
 #include "aevum/util/memory/arena_allocator.hpp"
 
-#include <algorithm>
 #include <new>
 
 namespace aevum::util::memory {
 
 /**
  * @brief Constructs an `ArenaAllocator` and allocates its initial memory chunk.
- * @param chunk_size The size in bytes for each large memory block (chunk) that the arena will
- *                   manage. This size is fixed for the lifetime of the allocator.
+ * @param chunk_size The size in bytes of the first chunk.
+ * @param max_chunk_size The size at which chunks stop doubling.
  */
-ArenaAllocator::ArenaAllocator(size_t chunk_size) : chunk_size_(chunk_size) { add_chunk(); }
+ArenaAllocator::ArenaAllocator(size_t chunk_size, size_t max_chunk_size)
+    : chunk_size_(std::max<size_t>(chunk_size, 1)),
+      max_chunk_size_(std::max(max_chunk_size, chunk_size_)) {
+    add_chunk(chunk_size_);
+    use_chunk(0);
+}
+
+/**
+ * @brief Destroys the arena; the chunks free themselves, the directly allocated blocks are freed
+ * here.
+ */
+ArenaAllocator::~ArenaAllocator() { free_large_blocks(0); }
 
 /**
- * @brief Allocates a block of memory from the current chunk, handling alignment and
- * chunk-switching.
- * @details This method implements the core "bump-pointer" allocation logic. It first calculates the
- * padding required to ensure that the returned pointer meets the specified alignment requirement.
- * If the current chunk has insufficient space for the requested size plus padding, it advances to
- * the next available chunk. If no more chunks are available, it allocates a new one. A request
- * that is larger than the chunk size itself will result in an exception.
+ * @brief Serves a request that does not fit into the rest of the current chunk.
+ * @details A request above `large_threshold()` gets a block of its own, which would otherwise
+ * waste the better part of a chunk and could exceed the largest one. Any other request moves to
+ * the next chunk that can hold it, skipping the tail of the current one; the chunks kept from
+ * earlier cycles are reused before a new one, twice the size of the last, is allocated.
+ * Alignment is computed on the actual address, so requests aligned beyond the heap's default
+ * are honored as well.
  *
  * @param bytes The number of bytes to allocate.
  * @param alignment The required memory alignment for the allocation.
  * @return A `void*` pointer to the start of the newly allocated, properly aligned block of memory.
- * @throws `std::bad_alloc` if a new chunk cannot be allocated from the system or if the requested
- *         allocation size (including alignment padding) exceeds the `chunk_size_`.
+ * @throws `std::bad_alloc` if a new chunk or block cannot be allocated from the system.
  */
-void *ArenaAllocator::allocate(size_t bytes, size_t alignment) {
-    // The padding calculation is a common and efficient bit of pointer arithmetic. It determines
-    // the number of bytes needed to advance the current offset to the next address that is a
-    // multiple of `alignment`. The outer modulo handles the case where the offset is already
-    // aligned.
-    size_t padding = (alignment - (current_offset_ % alignment)) % alignment;
-    size_t required_space = bytes + padding;
-
-    // Check if the current chunk can satisfy the request.
-    if (current_offset_ + required_space > chunk_size_) {
-        // A single allocation cannot be larger than the chunk size. This is a design limitation
-        // of this simple arena. More advanced implementations might handle this by allocating a
-        // special, oversized chunk just for this request.
-        if (required_space > chunk_size_) {
-            throw std::bad_alloc();
-        }
-
-        // If the current chunk is full, advance to the next one.
-        current_chunk_idx_++;
-        // If we have exhausted all existing chunks, allocate a new one.
-        if (current_chunk_idx_ >= chunks_.size()) {
-            add_chunk();
-        }
-
-        // After switching to a new chunk, reset the offset and recalculate padding.
-        current_offset_ = 0;
-        padding = (alignment - (current_offset_ % alignment)) % alignment;
-        required_space = bytes + padding;
+void *ArenaAllocator::allocate_slow(size_t bytes, size_t alignment) {
+    const size_t required_space = bytes + alignment;
+    if (required_space > large_threshold()) {
+        const size_t block_alignment = std::max(alignment, alignof(std::max_align_t));
+        large_.reserve(large_.size() + 1);
+        void *block = ::operator new(std::max<size_t>(bytes, 1), std::align_val_t(block_alignment));
+        large_.push_back(LargeBlock{block, std::max<size_t>(bytes, 1), block_alignment});
+        reserved_bytes_ += large_.back().size;
+        return block;
     }
 
-    // Apply the alignment padding by advancing the offset.
-    current_offset_ += padding;
-
-    // The final, aligned pointer is the base address of the current chunk plus the new offset.
-    void *ptr = chunks_[current_chunk_idx_].get() + current_offset_;
+    size_t next = current_chunk_idx_ + 1;
+    while (next < chunks_.size() && chunks_[next].size < required_space) ++next;
+    if (next == chunks_.size()) add_chunk(required_space);
+    use_chunk(next);
+    return allocate(bytes, alignment);
+}
 
-    // Advance the offset by the number of bytes requested to "claim" the memory block.
-    current_offset_ += bytes;
+/**
+ * @brief Makes a chunk the current one and records how far the cycle reached.
+ * @param index The index of the chunk in `chunks_`.
+ */
+void ArenaAllocator::use_chunk(size_t index) noexcept {
+    current_chunk_idx_ = index;
+    high_water_chunk_ = std::max(high_water_chunk_, index);
+    cursor_ = chunks_[index].data.get();
+    limit_ = cursor_ + chunks_[index].size;
+}
 
-    return ptr;
+/**
+ * @brief Returns to a mark, freeing the blocks allocated directly since.
+ * @param mark The mark.
+ */
+void ArenaAllocator::rewind(const Mark &mark) noexcept {
+    free_large_blocks(mark.large_blocks);
+    current_chunk_idx_ = mark.chunk;
+    cursor_ = mark.cursor;
+    limit_ = chunks_[mark.chunk].data.get() + chunks_[mark.chunk].size;
 }
 
 /**
- * @brief Resets the allocator, making all its memory available for immediate reuse.
- * @details This is an extremely fast, O(1) operation. It invalidates all previously allocated
- * pointers by simply resetting the internal state, effectively moving the allocation pointer
- * back to the beginning of the very first chunk. No memory is deallocated or returned to the
- * operating system, but the entire arena becomes ready for a new wave of allocations.
+ * @brief Resets the allocator, making all its memory available for reuse, and trims it to the
+ * chunks the finished cycle used.
+ * @details The chunks past the high-water mark were added by an earlier, larger cycle and sat
+ * unused through this one, so they are returned to the operating system. Like before, every
+ * previously allocated pointer is invalidated.
  */
 void ArenaAllocator::reset() noexcept {
-    current_chunk_idx_ = 0;
-    current_offset_ = 0;
+    free_large_blocks(0);
+    while (chunks_.size() > high_water_chunk_ + 1) {
+        reserved_bytes_ -= chunks_.back().size;
+        chunks_.pop_back();
+    }
+    high_water_chunk_ = 0;
+    use_chunk(0);
 }
 
 /**
  * @brief Allocates a new memory chunk from the heap and adds it to the arena's list of chunks.
- * @details This helper function is called when the arena is first constructed or when an
- * allocation request cannot be satisfied by any of the existing chunks. It uses
- * `std::make_unique<std::byte[]>` to perform a heap allocation, ensuring that the memory
- * is correctly managed and will be automatically released when the `ArenaAllocator` is destroyed.
+ * @details The chunk doubles the size of the last one, capped at `max_chunk_size_`, and is at
+ * least `min_size`. The memory is left uninitialized and is released when the chunk is trimmed
+ * by `reset` or when the `ArenaAllocator` is destroyed.
+ * @param min_size The smallest acceptable size.
  * @throws `std::bad_alloc` if the underlying system memory allocation fails.
  */
-void ArenaAllocator::add_chunk() { chunks_.push_back(std::make_unique<std::byte[]>(chunk_size_)); }
+void ArenaAllocator::add_chunk(size_t min_size) {
+    size_t size = chunk_size_;
+    if (!chunks_.empty()) size = std::min(chunks_.back().size * 2, max_chunk_size_);
+    size = std::max(size, min_size);
+    chunks_.reserve(chunks_.size() + 1);
+    // Not `make_unique`, which would zero the whole chunk.
+    chunks_.push_back(Chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    reserved_bytes_ += size;
+}
+
+/**
+ * @brief Frees the directly allocated blocks after the first `keep`.
+ * @param keep The number of blocks to keep.
+ */
+void ArenaAllocator::free_large_blocks(size_t keep) noexcept {
+    while (large_.size() > keep) {
+        const LargeBlock &block = large_.back();
+        ::operator delete(block.data, std::align_val_t(block.alignment));
+        reserved_bytes_ -= block.size;
+        large_.pop_back();
+    }
+}
 
 }  // namespace aevum::util::memory
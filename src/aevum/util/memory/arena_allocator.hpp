@@ -14,9 +14,11 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 /**
@@ -39,9 +41,18 @@ namespace aevum::util::memory {
  * pointer" approach is exceptionally fast and eliminates the overhead associated with managing
  * individual memory blocks on the heap, thereby mitigating heap fragmentation.
  *
- * Deallocation of all objects within the arena is an extremely fast, constant-time O(1) operation
- * that simply resets the internal pointers. This makes arenas ideal for phased computations where
- * all objects created during a phase can be discarded simultaneously.
+ * Chunks grow geometrically: each new chunk is twice the size of the previous one, up to
+ * `max_chunk_size`, so a unit of work that needs a lot of memory makes a logarithmic number of
+ * trips to the heap. A request larger than `large_threshold()` would waste most of a chunk and is
+ * allocated directly from the heap instead; such blocks are freed by the next `reset` or
+ * `rewind` past them.
+ *
+ * Deallocation of all objects within the arena is a fast operation that simply resets the
+ * internal pointers, and `rewind` does the same back to a `Mark` taken earlier, so scopes can
+ * nest. `reset` also trims the arena: chunks beyond the last one the finished cycle reached are
+ * returned to the heap, so one unusually large unit of work does not pin its memory for the life
+ * of the arena. This makes arenas ideal for phased computations where all objects created during
+ * a phase can be discarded simultaneously.
  *
  * @warning A critical characteristic of this allocator is that it does not call destructors for
  * the objects it manages when the arena is reset or destroyed. Therefore, it is best suited for
@@ -51,22 +62,36 @@ namespace aevum::util::memory {
  */
 class ArenaAllocator {
   public:
+    /**
+     * @struct Mark
+     * @brief A position of the bump pointer, taken by `mark` and restored by `rewind`.
+     */
+    struct Mark {
+        /// The index of the chunk in use.
+        size_t chunk{0};
+        /// The next free byte of that chunk.
+        std::byte *cursor{nullptr};
+        /// The number of directly allocated blocks.
+        size_t large_blocks{0};
+    };
+
     /**
      * @brief Constructs an `ArenaAllocator` and pre-allocates the first memory chunk.
-     * @param chunk_size The size in bytes of each large memory block to be allocated from the OS.
+     * @param chunk_size The size in bytes of the first memory block allocated from the OS.
      *                   This value should be chosen based on the expected memory usage patterns.
-     *                   A larger chunk size reduces the frequency of OS allocations but may waste
-     *                   memory if usage is low. It defaults to 64KB, a common and effective size.
+     *                   It defaults to 64KB, a common and effective size.
+     * @param max_chunk_size The size at which the doubling of chunks stops; raised to
+     *                       `chunk_size` if smaller. It defaults to 1MB.
      */
-    explicit ArenaAllocator(size_t chunk_size = 64 * 1024);
+    explicit ArenaAllocator(size_t chunk_size = 64 * 1024, size_t max_chunk_size = 1024 * 1024);
 
     /**
      * @brief Destroys the `ArenaAllocator`, releasing all of its allocated memory chunks back to
      * the OS.
      * @details The destructor safely deallocates all memory blocks that were acquired from the heap
-     * during the allocator's lifetime.
+     * during the allocator's lifetime, including the directly allocated ones.
      */
-    ~ArenaAllocator() = default;
+    ~ArenaAllocator();
 
     // The `ArenaAllocator` is made non-copyable and non-movable. This is a critical design choice
     // to maintain pointer stability and prevent complex lifetime and ownership issues. If an arena
@@ -81,18 +106,26 @@ class ArenaAllocator {
      *
      * @details This is the core allocation function. It returns a pointer to a block of memory
      * satisfying the requested size and alignment. The allocation is served from the current chunk
-     * if space is available; otherwise, a new chunk is allocated. The method correctly handles
-     * alignment by calculating and adding the necessary padding.
+     * if space is available, which is inlined and costs an alignment and a comparison; otherwise
+     * `allocate_slow` moves to the next chunk, adds one, or allocates the block directly.
      *
      * @param bytes The number of bytes to allocate.
      * @param alignment The required memory alignment for the allocated block, specified in bytes.
      *                  This must be a power of two. Defaults to the maximum fundamental alignment
      *                  supported by the platform (`alignof(std::max_align_t)`).
      * @return A non-null pointer to the beginning of the allocated memory block.
-     * @throws `std::bad_alloc` if the requested size exceeds the chunk size or if a new chunk
-     *         cannot be allocated from the OS.
+     * @throws `std::bad_alloc` if a new chunk or block cannot be allocated from the OS.
      */
-    [[nodiscard]] void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    [[nodiscard]] void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        auto current = reinterpret_cast<uintptr_t>(cursor_);
+        auto limit = reinterpret_cast<uintptr_t>(limit_);
+        uintptr_t aligned = (current + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (aligned >= current && aligned <= limit && bytes <= limit - aligned) {
+            cursor_ = reinterpret_cast<std::byte *>(aligned + bytes);
+            return reinterpret_cast<void *>(aligned);
+        }
+        return allocate_slow(bytes, alignment);
+    }
 
     /**
      * @brief A convenience method to allocate memory and construct an object in-place within the
@@ -114,37 +147,133 @@ class ArenaAllocator {
         return new (ptr) T(std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Returns the current position of the bump pointer.
+     * @return A mark that `rewind` returns to.
+     */
+    [[nodiscard]] Mark mark() const noexcept {
+        return Mark{current_chunk_idx_, cursor_, large_.size()};
+    }
+
+    /**
+     * @brief Deallocates everything allocated since a mark was taken.
+     * @details The chunks stay with the arena; the blocks allocated directly since the mark are
+     * freed. Marks taken after `mark` become invalid, and so does any mark once `reset` runs.
+     * @param mark A mark of this arena, taken since the last `reset`.
+     */
+    void rewind(const Mark &mark) noexcept;
+
     /**
      * @brief Resets the allocator, effectively deallocating all memory within the arena for reuse.
      *
-     * @details This is a constant-time O(1) operation that makes the entire allocated region
-     * available for new allocations by simply resetting the internal chunk index and offset
-     * pointers. It does not release memory back to the operating system and, crucially, does
-     * not invoke destructors on any objects previously created in the arena.
+     * @details Makes the entire arena available for new allocations by resetting the chunk index
+     * and bump pointer, and frees the directly allocated blocks. Chunks past the furthest one
+     * used since the previous reset are returned to the heap; the rest are kept for the next
+     * cycle. Crucially, it does not invoke destructors on any objects previously created in the
+     * arena.
      */
     void reset() noexcept;
 
+    /**
+     * @brief Returns the size of the arena's first chunk.
+     * @return The initial chunk size in bytes.
+     */
+    [[nodiscard]] size_t chunk_size() const noexcept { return chunk_size_; }
+
+    /**
+     * @brief Returns the size above which a request is allocated directly instead of from a
+     * chunk.
+     * @return Half of `max_chunk_size`, or the first chunk size if that is larger.
+     */
+    [[nodiscard]] size_t large_threshold() const noexcept {
+        return std::max(chunk_size_, max_chunk_size_ / 2);
+    }
+
+    /**
+     * @brief Returns the memory the arena holds: its chunks and its directly allocated blocks.
+     * @return The number of bytes.
+     */
+    [[nodiscard]] size_t bytes_reserved() const noexcept { return reserved_bytes_; }
+
   private:
+    /**
+     * @struct Chunk
+     * @brief One block of memory that allocations are carved from.
+     */
+    struct Chunk {
+        /// The memory.
+        std::unique_ptr<std::byte[]> data;
+        /// The size of `data` in bytes.
+        size_t size{0};
+    };
+
+    /**
+     * @struct LargeBlock
+     * @brief A block allocated directly for a request above `large_threshold()`.
+     */
+    struct LargeBlock {
+        /// The memory, from the aligned `operator new`.
+        void *data{nullptr};
+        /// The size it was allocated with.
+        size_t size{0};
+        /// The alignment it was allocated with.
+        size_t alignment{0};
+    };
+
+    /**
+     * @brief Serves a request that does not fit into the rest of the current chunk.
+     * @param bytes The number of bytes to allocate.
+     * @param alignment The required alignment, a power of two.
+     * @return The block.
+     * @throws `std::bad_alloc` if memory cannot be allocated from the OS.
+     */
+    [[nodiscard]] void *allocate_slow(size_t bytes, size_t alignment);
+
+    /**
+     * @brief Makes a chunk the current one.
+     * @param index The index of the chunk in `chunks_`.
+     */
+    void use_chunk(size_t index) noexcept;
+
     /**
      * @brief Allocates a new memory chunk from the heap and adds it to the arena's pool.
-     * @details This internal helper function is invoked by the constructor or when the current
-     * memory chunk is exhausted.
+     * @details This internal helper function is invoked by the constructor or when the existing
+     * memory chunks are exhausted.
+     * @param min_size The smallest acceptable size; the chunk is otherwise twice the last one,
+     *                 capped at `max_chunk_size_`.
      */
-    void add_chunk();
+    void add_chunk(size_t min_size);
+
+    /**
+     * @brief Frees the directly allocated blocks after the first `keep`.
+     * @param keep The number of blocks to keep.
+     */
+    void free_large_blocks(size_t keep) noexcept;
 
     /**
      * @var chunk_size_
-     * @brief The prescribed size in bytes for each new memory chunk allocated by the arena.
+     * @brief The size in bytes of the first memory chunk allocated by the arena.
      */
     size_t chunk_size_;
 
+    /**
+     * @var max_chunk_size_
+     * @brief The size in bytes at which chunks stop doubling.
+     */
+    size_t max_chunk_size_;
+
     /**
      * @var chunks_
-     * @brief A vector of smart pointers, each managing the lifetime of a large, heap-allocated
-     * memory chunk. `std::unique_ptr<std::byte[]>` is used for correct, exception-safe memory
-     * management.
+     * @brief The chunks in order of allocation, each managing the lifetime of a large,
+     * heap-allocated memory block. Their sizes never decrease.
+     */
+    std::vector<Chunk> chunks_;
+
+    /**
+     * @var large_
+     * @brief The blocks allocated directly since the last `reset`, in order of allocation.
      */
-    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::vector<LargeBlock> large_;
 
     /**
      * @var current_chunk_idx_
@@ -154,11 +283,29 @@ class ArenaAllocator {
     size_t current_chunk_idx_{0};
 
     /**
-     * @var current_offset_
-     * @brief The byte offset within the current chunk. This acts as the "bump pointer," indicating
-     * the start of the next available free memory.
+     * @var high_water_chunk_
+     * @brief The furthest chunk used since the last `reset`; `reset` frees the chunks after it.
+     */
+    size_t high_water_chunk_{0};
+
+    /**
+     * @var cursor_
+     * @brief The "bump pointer," indicating the start of the next available free memory in the
+     * current chunk.
+     */
+    std::byte *cursor_{nullptr};
+
+    /**
+     * @var limit_
+     * @brief The end of the current chunk.
+     */
+    std::byte *limit_{nullptr};
+
+    /**
+     * @var reserved_bytes_
+     * @brief The bytes of all chunks and directly allocated blocks.
      */
-    size_t current_offset_{0};
+    size_t reserved_bytes_{0};
 };
 
 }  // namespace aevum::util::memory
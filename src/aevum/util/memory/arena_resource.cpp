@@ -0,0 +1,35 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file arena_resource.cpp
+ * @brief Implements the `ArenaResource` adapter between `ArenaAllocator` and `std::pmr`.
+ */
+#include "aevum/util/memory/arena_resource.hpp"
+
+namespace aevum::util::memory {
+
+/**
+ * @brief Allocates a block from the arena, or from upstream if it does not fit in a chunk.
+ * @param bytes The size of the block.
+ * @param alignment The alignment of the block, a power of two.
+ * @return The block.
+ * @throws `std::bad_alloc` if the memory cannot be obtained.
+ */
+void *ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+    if (is_oversized(bytes, alignment)) return upstream_->allocate(bytes, alignment);
+    return arena_.allocate(bytes, alignment);
+}
+
+/**
+ * @brief Returns an oversized block to upstream; blocks of the arena wait for `release()`.
+ * @param p The block.
+ * @param bytes The size the block was allocated with.
+ * @param alignment The alignment the block was allocated with.
+ */
+void ArenaResource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    if (is_oversized(bytes, alignment)) upstream_->deallocate(p, bytes, alignment);
+}
+
+}  // namespace aevum::util::memory
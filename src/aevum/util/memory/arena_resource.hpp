@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file arena_resource.hpp
+ * @brief Defines a `std::pmr::memory_resource` that allocates from an `ArenaAllocator`.
+ * @details This header provides the `ArenaResource` adapter, which lets the standard `std::pmr`
+ * containers (`std::pmr::string`, `std::pmr::vector`, and so on) place their storage in an arena,
+ * so that the transient containers of one unit of work are released together by a single reset.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "aevum/util/memory/arena_allocator.hpp"
+
+namespace aevum::util::memory {
+
+/**
+ * @class ArenaResource
+ * @brief A memory resource that bump-allocates from an `ArenaAllocator`.
+ *
+ * @details Deallocation is a no-op, as with `std::pmr::monotonic_buffer_resource`: memory is only
+ * reclaimed when `release()` rewinds the arena. A request above the arena's
+ * `large_threshold()` is passed to an upstream resource instead, and is returned to it when
+ * deallocated, so a container that grows large gives its old buffers back as it reallocates
+ * rather than leaving them in the arena until the next reset.
+ *
+ * @warning `release()` invalidates everything allocated from the arena. Every container using the
+ * resource must have been destroyed before it is called, or the oversized blocks they hold leak.
+ */
+class ArenaResource final : public std::pmr::memory_resource {
+  public:
+    /**
+     * @brief Constructs a resource over an arena.
+     * @param arena The arena to allocate from, which must outlive the resource.
+     * @param upstream The resource that serves requests above the arena's `large_threshold()`.
+     */
+    explicit ArenaResource(ArenaAllocator &arena,
+                           std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : arena_(arena), upstream_(upstream) {}
+
+    ArenaResource(const ArenaResource &) = delete;
+    ArenaResource &operator=(const ArenaResource &) = delete;
+
+    /**
+     * @brief Rewinds the arena, making all of its memory available again.
+     * @details The arena keeps the chunks this unit of work used, so the next one allocates from
+     * memory that is already owned, and frees those only a larger, earlier one needed.
+     */
+    void release() noexcept { arena_.reset(); }
+
+    /**
+     * @brief Returns the arena the resource allocates from.
+     * @return The arena, e.g. to `mark` and `rewind` it.
+     */
+    [[nodiscard]] ArenaAllocator &arena() const noexcept { return arena_; }
+
+  private:
+    /**
+     * @brief Tells whether a request is too large to be carved from a chunk of the arena.
+     * @details The decision depends only on the size and alignment, so `do_deallocate` makes the
+     * same one as `do_allocate` did for the same block.
+     */
+    [[nodiscard]] bool is_oversized(size_t bytes, size_t alignment) const noexcept {
+        return bytes + alignment > arena_.large_threshold();
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    /// The arena that serves requests.
+    ArenaAllocator &arena_;
+    /// The resource that serves requests above the arena's `large_threshold()`.
+    std::pmr::memory_resource *upstream_;
+};
+
+}  // namespace aevum::util::memory
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file mapped_file.cpp
+ * @brief Implements `MappedFile`.
+ */
+#include "aevum/util/memory/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "aevum/util/defer.hpp"
+
+namespace aevum::util::memory {
+
+namespace {
+
+/**
+ * @brief Formats the message of a failed system call on a file.
+ * @param what What failed.
+ * @param path The file.
+ * @return The message, ending with the description of `errno`.
+ */
+std::string errno_message(const char *what, const std::string &path) {
+    return std::string(what) + " '" + path + "': " + std::strerror(errno);
+}
+
+}  // namespace
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedFile::~MappedFile() {
+    if (data_) munmap(data_, size_);
+}
+
+/**
+ * @brief Maps a file.
+ * @param path The path of the file.
+ * @return `aevum::util::Status::OK()`, or an `IOError` if it cannot be opened or mapped.
+ */
+aevum::util::Status MappedFile::open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return aevum::util::Status::IOError(errno_message("Cannot open", path));
+    AEVUM_DEFER([&]() { ::close(fd); });
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        return aevum::util::Status::IOError(errno_message("Cannot stat", path));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) return aevum::util::Status::OK();  // Nothing to map.
+
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        size_ = 0;
+        return aevum::util::Status::IOError(errno_message("Cannot map", path));
+    }
+    data_ = data;
+    madvise(data_, size_, MADV_WILLNEED);
+    return aevum::util::Status::OK();
+}
+
+}  // namespace aevum::util::memory
@@ -8,12 +8,19 @@
  * @details This header provides the `ObjectPool` class, a sophisticated memory management utility
  * that reduces the overhead of frequent dynamic memory allocation and deallocation. By maintaining
  * a cache of pre-allocated, reusable objects, it is ideal for performance-critical applications
- * that repeatedly create and destroy objects of the same type.
+ * that repeatedly create and destroy objects of the same type. Objects are cached per thread in
+ * magazines, after Bonwick and Adams, "Magazines and Vmem" (USENIX 2001), so that the common
+ * `acquire` and `release` touch no shared state.
  */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include "aevum/util/concurrency/spinlock.hpp"
@@ -26,16 +33,22 @@ namespace aevum::util::memory {
  * objects.
  *
  * @details This class provides a powerful mechanism to mitigate the significant performance cost
- * associated with frequent dynamic memory operations (`new` and `delete`). It maintains an internal
- * cache (a "pool") of pre-allocated objects. When an object is requested via `acquire()`, the pool
- * first attempts to provide a recycled object from its cache. If no objects are available, it
- * allocates a new one. When an object is no longer needed, it can be returned to the pool via
- * `release()` for subsequent reuse, avoiding the deallocation and potential heap fragmentation.
+ * associated with frequent dynamic memory operations (`new` and `delete`). When an object is
+ * requested via `acquire()`, the pool first attempts to provide a recycled object from its cache.
+ * If no objects are available, it allocates a new one. When an object is no longer needed, it can
+ * be returned to the pool via `release()` for subsequent reuse, avoiding the deallocation and
+ * potential heap fragmentation. `borrow()` wraps the pair in a `Handle` that releases on
+ * destruction.
  *
- * To ensure correctness in multithreaded environments, all access to the internal object cache is
- * synchronized using a low-latency `aevum::util::concurrency::Spinlock`. This makes the pool
- * particularly suitable for high-performance, highly concurrent applications where contention on
- * the global heap allocator could become a bottleneck.
+ * Every thread caches up to two magazines of `magazine_size` objects for each pool it uses, and
+ * `acquire` and `release` work on them without atomics or locks. Only when both of a thread's
+ * magazines are empty, or both are full, does it exchange a whole magazine with the shared depot,
+ * under a low-latency `aevum::util::concurrency::Spinlock`, so the lock is taken at most once per
+ * `magazine_size` operations. The depot retains at most `capacity` objects; full magazines beyond
+ * that are freed, which bounds the memory a burst can leave behind.
+ *
+ * A thread's magazines are returned to the depot when the thread exits, or freed if the pool is
+ * gone by then. Destroying the pool frees the depot and the calling thread's magazines at once.
  *
  * @tparam T The type of object to be managed by the pool. This type `T` must be
  * default-constructible to allow the pool to create new instances when necessary.
@@ -43,25 +56,121 @@ namespace aevum::util::memory {
 template <typename T>
 class ObjectPool {
   public:
+    /// The objects the shared depot retains by default.
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    /// The objects of one magazine by default.
+    static constexpr size_t DEFAULT_MAGAZINE_SIZE = 16;
+
+    /**
+     * @brief Prepares a released object for reuse.
+     * @details Called by `release` on the releasing thread, outside any lock. Returning `false`
+     * frees the object instead of caching it, e.g. when it has grown too large to keep.
+     */
+    using ResetFunction = std::function<bool(T &)>;
+
+    /**
+     * @class Handle
+     * @brief Owns an object borrowed from a pool and releases it when destroyed.
+     */
+    class Handle {
+      public:
+        /**
+         * @brief Constructs an empty handle.
+         */
+        Handle() noexcept = default;
+
+        /**
+         * @brief Takes over the object of another handle.
+         * @param other The handle to move from; left empty.
+         */
+        Handle(Handle &&other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)),
+              object_(std::exchange(other.object_, nullptr)) {}
+
+        /**
+         * @brief Releases the current object and takes over that of another handle.
+         * @param other The handle to move from; left empty.
+         * @return This handle.
+         */
+        Handle &operator=(Handle &&other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = std::exchange(other.pool_, nullptr);
+                object_ = std::exchange(other.object_, nullptr);
+            }
+            return *this;
+        }
+
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+
+        /**
+         * @brief Releases the object to its pool.
+         */
+        ~Handle() { reset(); }
+
+        /**
+         * @brief Releases the object to its pool now, leaving the handle empty.
+         */
+        void reset() {
+            if (object_ != nullptr) pool_->release(std::exchange(object_, nullptr));
+        }
+
+        /**
+         * @brief Returns the object.
+         * @return The object, or `nullptr` for an empty handle.
+         */
+        [[nodiscard]] T *get() const noexcept { return object_; }
+
+        T &operator*() const noexcept { return *object_; }
+        T *operator->() const noexcept { return object_; }
+
+      private:
+        friend class ObjectPool;
+
+        Handle(ObjectPool *pool, T *object) noexcept : pool_(pool), object_(object) {}
+
+        /// The pool the object is released to.
+        ObjectPool *pool_{nullptr};
+        /// The borrowed object.
+        T *object_{nullptr};
+    };
+
     /**
      * @brief Constructs an empty `ObjectPool`.
-     * @details The constructor initializes the internal storage and synchronization primitives.
-     * The pool starts with no cached objects.
+     * @details The pool starts with no cached objects.
+     * @param capacity The most objects the shared depot retains.
+     * @param reset Called on every released object before it is cached; empty to cache objects
+     * as they are.
+     * @param magazine_size The objects per magazine, at least 1. Larger magazines take the depot
+     * lock less often but leave more idle objects with each thread.
      */
-    ObjectPool() = default;
+    explicit ObjectPool(size_t capacity = DEFAULT_CAPACITY, ResetFunction reset = {},
+                        size_t magazine_size = DEFAULT_MAGAZINE_SIZE)
+        : id_(next_pool_id()),
+          reset_(std::move(reset)),
+          depot_(std::make_shared<Depot>(capacity, std::max<size_t>(magazine_size, 1))) {}
 
     /**
      * @brief Destroys the `ObjectPool` and deallocates all cached objects within it.
-     * @details The destructor acquires a lock to ensure thread-safe cleanup, then iterates through
-     * all objects currently stored in the pool and calls `delete` on each one, ensuring that all
-     * memory is returned to the system.
+     * @details The depot and the calling thread's magazines are freed immediately. Other threads'
+     * magazines are freed when those threads exit, since they cannot be reached from here without
+     * a lock on their hot path.
      */
     ~ObjectPool() {
-        std::lock_guard<aevum::util::concurrency::Spinlock> lock(spinlock_);
-        for (T *obj : pool_) {
-            delete obj;
+        auto &caches = thread_caches();
+        for (auto it = caches.begin(); it != caches.end(); ++it) {
+            if ((*it)->pool_id == id_) {
+                if (last_cache() == it->get()) last_cache() = nullptr;
+                caches.erase(it);
+                break;
+            }
         }
-        pool_.clear();
+        std::lock_guard<aevum::util::concurrency::Spinlock> lock(depot_->lock);
+        depot_->closed = true;
+        for (auto &magazine : depot_->full) free_all(magazine);
+        depot_->full.clear();
+        depot_->empty.clear();
     }
 
     // The copy and move semantics are explicitly deleted. An `ObjectPool` has unique ownership of
@@ -75,68 +184,257 @@ class ObjectPool {
 
     /**
      * @brief Acquires an object from the pool, creating one if necessary.
-     * @details This method is the primary way to obtain an object. It first attempts to retrieve a
-     *          recycled object from the internal cache. If the cache is empty, it dynamically
-     *          allocates a new object of type `T` on the heap. The entire operation is performed
-     *          atomically under the protection of a spinlock.
+     * @details Pops the calling thread's loaded magazine. When it is empty, the other magazine is
+     * tried, then a full magazine is fetched from the depot, and only then is a new object
+     * allocated on the heap.
      * @return A non-null pointer to an initialized object of type `T`. The caller assumes
      *         ownership of this pointer until it is returned via `release()`.
      */
     [[nodiscard]] T *acquire() {
-        std::lock_guard<aevum::util::concurrency::Spinlock> lock(spinlock_);
-        if (pool_.empty()) {
-            return new T();
+        ThreadCache &cache = local_cache();
+        if (cache.loaded.empty()) {
+            if (!cache.previous.empty()) {
+                cache.loaded.swap(cache.previous);
+            } else if (!refill(cache)) {
+                return new T();
+            }
         }
-
-        T *obj = pool_.back();
-        pool_.pop_back();
+        T *obj = cache.loaded.back();
+        cache.loaded.pop_back();
         return obj;
     }
 
+    /**
+     * @brief Acquires an object wrapped in a handle that releases it.
+     * @return The handle.
+     */
+    [[nodiscard]] Handle borrow() { return Handle(this, acquire()); }
+
     /**
      * @brief Releases an object, returning it to the pool for future reuse.
      * @details The provided object pointer is relinquished by the caller and returned to the pool's
-     *          internal cache. The caller must not access the object through this pointer after
-     *          the call, as its ownership has been transferred back to the pool. The operation is
-     *          thread-safe.
+     *          cache. The caller must not access the object through this pointer after the call,
+     *          as its ownership has been transferred back to the pool. The reset function runs
+     *          first; the object is then pushed onto the calling thread's loaded magazine, and
+     *          when both magazines are full, one is handed to the depot, or freed if the depot is
+     *          at capacity. It may be called from any thread, not only the one that acquired it.
      * @param obj A pointer to the object to be returned to the pool. If `nullptr` is provided,
      *            the function has no effect and safely returns.
-     * @note For objects that hold state, it is the caller's responsibility to reset the object to a
-     *       clean state before releasing it, or alternatively, the `release` method could be
-     * modified to call a `reset()` method on the object before caching it.
      */
     void release(T *obj) {
         if (obj == nullptr) return;
+        if (reset_ && !reset_(*obj)) {
+            delete obj;
+            return;
+        }
 
-        std::lock_guard<aevum::util::concurrency::Spinlock> lock(spinlock_);
-        pool_.push_back(obj);
+        ThreadCache &cache = local_cache();
+        const size_t magazine_size = depot_->magazine_size;
+        if (cache.loaded.size() == magazine_size) {
+            if (cache.previous.size() < magazine_size) {
+                cache.loaded.swap(cache.previous);
+            } else {
+                spill(cache);
+            }
+        }
+        cache.loaded.push_back(obj);
     }
 
     /**
-     * @brief Atomically retrieves the number of available objects currently cached in the pool.
-     * @details This method provides a thread-safe way to query the current number of recycled
-     * objects available for immediate acquisition without allocation.
+     * @brief Retrieves the number of available objects for the calling thread.
+     * @details Counts the objects in the depot and in the calling thread's magazines, which are
+     * those `acquire` can return without allocating. Other threads' magazines are not counted.
      * @return The number of available objects as a `size_t`.
      */
     [[nodiscard]] size_t available_count() const noexcept {
-        std::lock_guard<aevum::util::concurrency::Spinlock> lock(spinlock_);
-        return pool_.size();
+        size_t count = 0;
+        for (const auto &cache : thread_caches()) {
+            if (cache->pool_id == id_) count = cache->loaded.size() + cache->previous.size();
+        }
+        std::lock_guard<aevum::util::concurrency::Spinlock> lock(depot_->lock);
+        return count + depot_->full.size() * depot_->magazine_size;
     }
 
+    /**
+     * @brief Returns the most objects the depot retains.
+     * @return The capacity.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return depot_->capacity; }
+
   private:
     /**
-     * @var pool_
-     * @brief A vector that stores pointers to the available, recycled objects. It acts as a LIFO
-     * stack, as objects are pushed to the back and popped from the back.
+     * @struct Depot
+     * @brief The magazines shared by all threads, outliving the pool while threads still cache
+     * objects of it.
+     */
+    struct Depot {
+        Depot(size_t capacity, size_t magazine_size)
+            : capacity(capacity), magazine_size(magazine_size) {}
+
+        /// Guards the other members.
+        aevum::util::concurrency::Spinlock lock;
+        /// Full magazines, exchanged with threads whose magazines ran empty.
+        std::vector<std::vector<T *>> full;
+        /// Empty magazines with reserved storage, exchanged with threads whose magazines filled.
+        std::vector<std::vector<T *>> empty;
+        /// The most objects kept in `full`.
+        size_t capacity;
+        /// The objects per magazine.
+        size_t magazine_size;
+        /// Set when the pool is destroyed; threads then free their magazines instead.
+        bool closed{false};
+    };
+
+    /**
+     * @struct ThreadCache
+     * @brief The magazines of one thread for one pool.
+     */
+    struct ThreadCache {
+        ThreadCache(uint64_t pool_id, std::shared_ptr<Depot> depot)
+            : pool_id(pool_id), depot(std::move(depot)) {
+            loaded.reserve(this->depot->magazine_size);
+            previous.reserve(this->depot->magazine_size);
+        }
+
+        ThreadCache(const ThreadCache &) = delete;
+        ThreadCache &operator=(const ThreadCache &) = delete;
+
+        /**
+         * @brief Returns full magazines to the depot and frees the other objects.
+         */
+        ~ThreadCache() {
+            std::lock_guard<aevum::util::concurrency::Spinlock> lock(depot->lock);
+            for (auto *magazine : {&loaded, &previous}) {
+                if (!depot->closed && magazine->size() == depot->magazine_size &&
+                    (depot->full.size() + 1) * depot->magazine_size <= depot->capacity) {
+                    depot->full.push_back(std::move(*magazine));
+                } else {
+                    free_all(*magazine);
+                }
+            }
+        }
+
+        /// The `id_` of the pool.
+        uint64_t pool_id;
+        /// The pool's depot.
+        std::shared_ptr<Depot> depot;
+        /// The magazine `acquire` pops and `release` pushes.
+        std::vector<T *> loaded;
+        /// The magazine swapped in when `loaded` runs empty or full.
+        std::vector<T *> previous;
+    };
+
+    /**
+     * @brief Returns a unique identifier for a new pool.
+     * @details Thread caches are matched by identifier rather than address, so a pool created
+     * where a destroyed one lived does not inherit its caches.
+     * @return The identifier.
      */
-    std::vector<T *> pool_;
+    static uint64_t next_pool_id() noexcept {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the calling thread's caches of the pools of `T`.
+     * @return The caches.
+     */
+    static std::vector<std::unique_ptr<ThreadCache>> &thread_caches() noexcept {
+        static thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+        return caches;
+    }
+
+    /**
+     * @brief Returns the calling thread's most recently used cache.
+     * @return A reference to the pointer, `nullptr` before one is used.
+     */
+    static ThreadCache *&last_cache() noexcept {
+        static thread_local ThreadCache *last = nullptr;
+        return last;
+    }
 
     /**
-     * @var spinlock_
-     * @brief A mutable spinlock that ensures thread-safe, serialized access to the `pool_` vector.
-     * It is marked `mutable` to be lockable within the `const` `available_count` method.
+     * @brief Returns the calling thread's cache of this pool, creating it on first use.
+     * @details The common case is the most recently used cache and costs one comparison. Caches
+     * of destroyed pools are dropped when a new one is created.
+     * @return The cache.
      */
-    mutable aevum::util::concurrency::Spinlock spinlock_;
+    ThreadCache &local_cache() {
+        ThreadCache *last = last_cache();
+        if (last != nullptr && last->pool_id == id_) return *last;
+
+        auto &caches = thread_caches();
+        for (auto &cache : caches) {
+            if (cache->pool_id == id_) return *(last_cache() = cache.get());
+        }
+        caches.erase(std::remove_if(caches.begin(), caches.end(),
+                                    [](const std::unique_ptr<ThreadCache> &cache) {
+                                        std::lock_guard<aevum::util::concurrency::Spinlock> lock(
+                                            cache->depot->lock);
+                                        return cache->depot->closed;
+                                    }),
+                     caches.end());
+        caches.push_back(std::make_unique<ThreadCache>(id_, depot_));
+        return *(last_cache() = caches.back().get());
+    }
+
+    /**
+     * @brief Replaces the empty loaded magazine of a cache by a full one from the depot.
+     * @param cache The cache, both of whose magazines are empty.
+     * @return `false` if the depot has no full magazine.
+     */
+    bool refill(ThreadCache &cache) {
+        std::lock_guard<aevum::util::concurrency::Spinlock> lock(depot_->lock);
+        if (depot_->full.empty()) return false;
+        depot_->empty.push_back(std::move(cache.loaded));
+        cache.loaded = std::move(depot_->full.back());
+        depot_->full.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Hands the full previous magazine of a cache to the depot and makes room in `loaded`.
+     * @details Afterwards `previous` holds the full loaded magazine and `loaded` is empty. If the
+     * depot is at capacity the handed magazine's objects are freed instead.
+     * @param cache The cache, both of whose magazines are full.
+     */
+    void spill(ThreadCache &cache) {
+        std::vector<T *> excess;
+        {
+            std::lock_guard<aevum::util::concurrency::Spinlock> lock(depot_->lock);
+            if ((depot_->full.size() + 1) * depot_->magazine_size <= depot_->capacity) {
+                depot_->full.push_back(std::move(cache.previous));
+            } else {
+                excess = std::move(cache.previous);
+            }
+            if (!depot_->empty.empty()) {
+                cache.previous = std::move(depot_->empty.back());
+                depot_->empty.pop_back();
+            } else {
+                cache.previous = std::vector<T *>();
+            }
+        }
+        free_all(excess);
+        cache.previous.clear();
+        cache.previous.reserve(depot_->magazine_size);
+        cache.loaded.swap(cache.previous);
+    }
+
+    /**
+     * @brief Frees the objects of a magazine and empties it.
+     * @param magazine The magazine.
+     */
+    static void free_all(std::vector<T *> &magazine) noexcept {
+        for (T *obj : magazine) delete obj;
+        magazine.clear();
+    }
+
+    /// The identifier of the pool's thread caches.
+    const uint64_t id_;
+    /// Prepares released objects for reuse; may be empty.
+    ResetFunction reset_;
+    /// The shared magazines.
+    std::shared_ptr<Depot> depot_;
 };
 
 }  // namespace aevum::util::memory
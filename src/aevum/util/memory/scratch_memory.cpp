@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file scratch_memory.cpp
+ * @brief Implements the per-thread scratch arena and its scopes.
+ */
+#include "aevum/util/memory/scratch_memory.hpp"
+
+#include <cstddef>
+
+namespace aevum::util::memory {
+
+namespace {
+
+/// The size of the first chunk of a thread's scratch arena.
+constexpr size_t SCRATCH_CHUNK_SIZE = 64 * 1024;
+/// The size at which the chunks of a scratch arena stop doubling.
+constexpr size_t SCRATCH_MAX_CHUNK_SIZE = 1024 * 1024;
+
+/// The number of `ScratchScope`s open on the calling thread.
+thread_local size_t scratch_scope_depth = 0;
+
+}  // namespace
+
+ArenaResource &scratch_memory() {
+    thread_local ArenaAllocator arena(SCRATCH_CHUNK_SIZE, SCRATCH_MAX_CHUNK_SIZE);
+    thread_local ArenaResource resource(arena);
+    return resource;
+}
+
+ScratchScope::ScratchScope()
+    : mark_(scratch_memory().arena().mark()), outermost_(scratch_scope_depth++ == 0) {}
+
+ScratchScope::~ScratchScope() {
+    --scratch_scope_depth;
+    if (outermost_) {
+        scratch_memory().release();
+    } else {
+        scratch_memory().arena().rewind(mark_);
+    }
+}
+
+}  // namespace aevum::util::memory
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file scratch_memory.hpp
+ * @brief Declares the per-thread scratch arena for transient `std::pmr` containers.
+ * @details The vectors and strings a request or query builds and throws away again, such as FFI
+ * buffer arrays and sort keys, are carved out of memory the thread already holds instead of
+ * coming from the global heap, where concurrent workers contend. `ScratchScope` bounds their
+ * lifetime.
+ */
+#pragma once
+
+#include "aevum/util/memory/arena_allocator.hpp"
+#include "aevum/util/memory/arena_resource.hpp"
+
+/**
+ * @namespace aevum::util::memory
+ * @brief Provides components for specialized and high-performance memory management strategies.
+ * @details This namespace contains utilities that offer alternatives to standard heap allocation,
+ * targeting specific use cases like object pooling and region-based memory management to improve
+ * application performance and predictability.
+ */
+namespace aevum::util::memory {
+
+/**
+ * @brief Returns the calling thread's scratch memory.
+ * @details Allocate from it only inside a `ScratchScope`, which reclaims the memory; outside one
+ * it is reclaimed only when the thread exits.
+ * @return The thread's arena as a memory resource for `std::pmr` containers.
+ */
+ArenaResource &scratch_memory();
+
+/**
+ * @class ScratchScope
+ * @brief Reclaims the scratch memory allocated on the calling thread during its lifetime.
+ *
+ * @details Declare the scope before the containers that use `scratch_memory()`, so they are
+ * destroyed first. Scopes nest: an inner scope rewinds the arena to where it found it, and the
+ * outermost one resets it, which also trims the arena's chunks to what the finished unit of work
+ * needed.
+ *
+ * @warning A container of an enclosing scope must not grow while an inner scope is open, since
+ * its new buffer would be placed past the inner scope's mark and reclaimed with it.
+ */
+class ScratchScope {
+  public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope &) = delete;
+    ScratchScope &operator=(const ScratchScope &) = delete;
+
+  private:
+    /// Where the arena was when the scope opened.
+    ArenaAllocator::Mark mark_;
+    /// `true` for the outermost scope of the thread.
+    bool outermost_;
+};
+
+}  // namespace aevum::util::memory
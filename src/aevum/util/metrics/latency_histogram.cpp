@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file latency_histogram.cpp
+ * @brief Implements `LatencyHistogram` and `HistogramFamily`.
+ */
+#include "aevum/util/metrics/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aevum::util::metrics {
+
+namespace {
+
+/// Durations below this many microseconds have a bucket each.
+constexpr uint64_t HISTOGRAM_LINEAR_LIMIT = 16;
+/// The sub-buckets of a power of two, as a number of bits.
+constexpr unsigned HISTOGRAM_SUB_BUCKET_BITS = 3;
+/// The longest duration told apart from longer ones, in microseconds.
+constexpr uint64_t HISTOGRAM_MAX_TRACKED_US = (uint64_t{1} << 40) - 1;
+
+/**
+ * @brief Returns the shard the calling thread records into.
+ * @details Threads are assigned shards round-robin on their first recording, so the request
+ * workers of a pool spread evenly over them.
+ * @return The index of the shard.
+ */
+size_t histogram_shard_of_thread() noexcept {
+    static std::atomic<size_t> next_shard{0};
+    thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % LatencyHistogram::SHARD_COUNT;
+    return shard;
+}
+
+}  // namespace
+
+/**
+ * @brief Maps a duration to its bucket.
+ * @details For a duration of at least 16 µs whose highest set bit is `msb`, the three bits below
+ * `msb` select one of the 8 sub-buckets of the power of two `2^msb`.
+ */
+size_t LatencyHistogram::bucket_of(uint64_t micros) noexcept {
+    if (micros < HISTOGRAM_LINEAR_LIMIT) return static_cast<size_t>(micros);
+    micros = std::min(micros, HISTOGRAM_MAX_TRACKED_US);
+    const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(micros));
+    const unsigned shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+    const uint64_t sub = (micros >> shift) & ((1u << HISTOGRAM_SUB_BUCKET_BITS) - 1);
+    return HISTOGRAM_LINEAR_LIMIT + (msb - 4) * (size_t{1} << HISTOGRAM_SUB_BUCKET_BITS) + sub;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t bucket) noexcept {
+    if (bucket < HISTOGRAM_LINEAR_LIMIT) return bucket;
+    const size_t offset = bucket - HISTOGRAM_LINEAR_LIMIT;
+    const unsigned msb = 4 + static_cast<unsigned>(offset >> HISTOGRAM_SUB_BUCKET_BITS);
+    const uint64_t sub = offset & ((size_t{1} << HISTOGRAM_SUB_BUCKET_BITS) - 1);
+    const unsigned shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+    return (((uint64_t{1} << HISTOGRAM_SUB_BUCKET_BITS) + sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Counts a duration in the calling thread's shard.
+ * @details The maximum is raised with a compare-and-swap loop that gives up as soon as the
+ * stored maximum is at least as large, which after warm-up is almost always the first load.
+ */
+void LatencyHistogram::record(uint64_t micros) noexcept {
+    Shard &shard = shards_[histogram_shard_of_thread()];
+    shard.buckets[bucket_of(micros)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(micros, std::memory_order_relaxed);
+    uint64_t max = shard.max_us.load(std::memory_order_relaxed);
+    while (micros > max &&
+           !shard.max_us.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const noexcept {
+    Snapshot merged;
+    for (const auto &shard : shards_) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t n = shard.buckets[i].load(std::memory_order_relaxed);
+            merged.buckets[i] += n;
+            merged.count += n;
+        }
+        merged.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+        merged.max_us = std::max(merged.max_us, shard.max_us.load(std::memory_order_relaxed));
+    }
+    return merged;
+}
+
+/**
+ * @brief Walks the buckets until the percentile's rank is reached.
+ * @details The rank is rounded up, so p50 of two durations is the first of them and p100 the
+ * last. A bucket's upper bound can exceed every duration it holds, hence the cap at `max_us`.
+ */
+uint64_t LatencyHistogram::Snapshot::percentile(double quantile) const noexcept {
+    if (count == 0) return 0;
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(bucket_upper_bound(i), max_us);
+    }
+    return max_us;
+}
+
+uint64_t LatencyHistogram::Snapshot::count_at_or_below(uint64_t bound_us) const noexcept {
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT && bucket_upper_bound(i) <= bound_us; ++i) {
+        total += buckets[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the histogram of a name, or adds one while the family has room.
+ * @details The count of names is checked and raised outside the registry's lock, so concurrent
+ * additions may take the family a few names past `max_names`; that bounds its memory just as
+ * well. `OVERFLOW_NAME` itself is always admitted.
+ */
+LatencyHistogram &HistogramFamily::get(std::string_view name) {
+    if (LatencyHistogram *found = histograms_.find(name)) return *found;
+    if (names_.load(std::memory_order_relaxed) >= max_names_ && name != OVERFLOW_NAME) {
+        return get(OVERFLOW_NAME);
+    }
+    names_.fetch_add(1, std::memory_order_relaxed);
+    return histograms_.find_or_add(name);
+}
+
+void HistogramFamily::for_each(
+    const std::function<void(std::string_view, const LatencyHistogram::Snapshot &)> &visit)
+    const {
+    histograms_.for_each([&](std::string_view name, const LatencyHistogram &histogram) {
+        visit(name, histogram.snapshot());
+    });
+}
+
+}  // namespace aevum::util::metrics
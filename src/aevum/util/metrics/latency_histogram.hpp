@@ -0,0 +1,190 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file latency_histogram.hpp
+ * @brief Declares `LatencyHistogram`, a lock-free log-linear histogram of durations, and
+ * `HistogramFamily`, a set of histograms keyed by name.
+ * @details Averages hide the requests that users notice. A histogram keeps the whole distribution
+ * at a bounded relative error, so tail percentiles such as p99 can be read at any time without
+ * storing individual samples. Recording is a few relaxed atomic increments on a stripe of
+ * counters chosen per thread, so request threads never contend on one cache line; a reader
+ * merges the stripes.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "aevum/util/concurrency/named_registry.hpp"
+#include "aevum/util/time/stopwatch.hpp"
+
+/**
+ * @namespace aevum::util::metrics
+ * @brief Instruments for measuring the server at runtime.
+ */
+namespace aevum::util::metrics {
+
+/**
+ * @class LatencyHistogram
+ * @brief Counts durations in microseconds in log-linear buckets.
+ *
+ * @details Durations below 16 µs each have a bucket of their own. Above that, every power of two
+ * is split into 8 equal sub-buckets, so a bucket is never wider than 12.5% of the values it
+ * holds, up to 2^40 µs (about 12 days); longer durations are counted in the last bucket. This is
+ * the bucketing of HDR histograms with three significant bits. The counters are striped over
+ * `SHARD_COUNT` cache-aligned shards, each thread writing to one of them. The class is
+ * thread-safe.
+ */
+class LatencyHistogram {
+  public:
+    /// The number of buckets.
+    static constexpr size_t BUCKET_COUNT = 16 + (40 - 4) * 8;
+    /// The number of independently updated stripes of counters.
+    static constexpr size_t SHARD_COUNT = 8;
+
+    /**
+     * @struct Snapshot
+     * @brief The merged counters of a histogram at one point in time.
+     */
+    struct Snapshot {
+        /// The number of recorded durations.
+        uint64_t count{0};
+        /// The sum of the recorded durations, in microseconds.
+        uint64_t sum_us{0};
+        /// The longest recorded duration, in microseconds.
+        uint64_t max_us{0};
+        /// The number of durations in each bucket.
+        std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+        /**
+         * @brief Estimates a percentile.
+         * @param quantile The quantile, between 0 and 1 (0.99 for p99).
+         * @return The upper bound of the bucket holding the percentile, capped at `max_us`, in
+         * microseconds; 0 for an empty histogram.
+         */
+        [[nodiscard]] uint64_t percentile(double quantile) const noexcept;
+
+        /**
+         * @brief Counts the durations at or below a bound.
+         * @details Buckets are counted whole, so the result is exact for bounds that fall on a
+         * bucket boundary and otherwise omits the bucket that straddles the bound.
+         * @param bound_us The bound, in microseconds.
+         * @return The number of durations of the buckets whose upper bound is at most `bound_us`.
+         */
+        [[nodiscard]] uint64_t count_at_or_below(uint64_t bound_us) const noexcept;
+    };
+
+    /**
+     * @brief Constructs an empty histogram.
+     */
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    /**
+     * @brief Records a duration.
+     * @param micros The duration, in microseconds.
+     */
+    void record(uint64_t micros) noexcept;
+
+    /**
+     * @brief Records the time elapsed on a stopwatch.
+     * @param stopwatch The stopwatch.
+     */
+    void record(const aevum::util::time::Stopwatch &stopwatch) noexcept {
+        record(stopwatch.elapsed_ns() / 1000);
+    }
+
+    /**
+     * @brief Merges the shards into a snapshot.
+     * @details Durations recorded while the snapshot is taken may be partly included, e.g. in
+     * `count` but not yet in `sum_us`.
+     * @return The snapshot.
+     */
+    [[nodiscard]] Snapshot snapshot() const noexcept;
+
+    /**
+     * @brief Returns the bucket a duration is counted in.
+     * @param micros The duration, in microseconds.
+     * @return The index of the bucket.
+     */
+    [[nodiscard]] static size_t bucket_of(uint64_t micros) noexcept;
+
+    /**
+     * @brief Returns the largest duration a bucket holds.
+     * @param bucket The index of the bucket.
+     * @return The inclusive upper bound of the bucket, in microseconds.
+     */
+    [[nodiscard]] static uint64_t bucket_upper_bound(size_t bucket) noexcept;
+
+  private:
+    /// One stripe of the counters, on cache lines of its own.
+    struct alignas(64) Shard {
+        /// The number of durations in each bucket.
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        /// The sum of the durations, in microseconds.
+        std::atomic<uint64_t> sum_us{0};
+        /// The longest duration, in microseconds.
+        std::atomic<uint64_t> max_us{0};
+    };
+
+    /// The stripes of the counters.
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+
+/**
+ * @class HistogramFamily
+ * @brief Maps names, such as actions or collections, to latency histograms.
+ *
+ * @details Histograms are added on first use and live as long as the family. Names come from
+ * requests, so the family holds at most `max_names` of them (approximately, when threads race to
+ * add the last few); durations of any further name are recorded under `OVERFLOW_NAME`. The class
+ * is thread-safe, and looking up an existing name takes no lock.
+ */
+class HistogramFamily {
+  public:
+    /// The name that durations are recorded under once the family is full.
+    static constexpr std::string_view OVERFLOW_NAME = "_other";
+
+    /**
+     * @brief Constructs an empty family.
+     * @param max_names The most names the family tracks separately.
+     */
+    explicit HistogramFamily(size_t max_names) : max_names_(max_names) {}
+
+    HistogramFamily(const HistogramFamily &) = delete;
+    HistogramFamily &operator=(const HistogramFamily &) = delete;
+
+    /**
+     * @brief Returns the histogram of a name, adding it if there is room.
+     * @param name The name.
+     * @return The histogram of `name`, or that of `OVERFLOW_NAME` if the family is full.
+     */
+    LatencyHistogram &get(std::string_view name);
+
+    /**
+     * @brief Takes a snapshot of every histogram.
+     * @param visit Called with each name and its snapshot, in no particular order.
+     */
+    void for_each(
+        const std::function<void(std::string_view, const LatencyHistogram::Snapshot &)> &visit)
+        const;
+
+  private:
+    /// The histograms by name.
+    aevum::util::concurrency::NamedRegistry<LatencyHistogram, 64> histograms_;
+    /// The number of names added, counting `OVERFLOW_NAME`.
+    std::atomic<size_t> names_{0};
+    /// The most names tracked separately.
+    const size_t max_names_;
+};
+
+}  // namespace aevum::util::metrics
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file prometheus_text.cpp
+ * @brief Implements `PrometheusText`.
+ */
+#include "aevum/util/metrics/prometheus_text.hpp"
+
+#include <cstdio>
+
+namespace aevum::util::metrics {
+
+namespace {
+
+/**
+ * @struct PrometheusBucketBound
+ * @brief An upper bound of the exposed histogram buckets.
+ */
+struct PrometheusBucketBound {
+    /// The bound, in microseconds.
+    uint64_t micros;
+    /// The bound in seconds, as written in the `le` label.
+    std::string_view seconds;
+};
+
+/// The bucket bounds of exposed latency histograms.
+constexpr PrometheusBucketBound PROMETHEUS_BUCKET_BOUNDS[] = {
+    {100, "0.0001"},     {250, "0.00025"},   {500, "0.0005"},   {1000, "0.001"},
+    {2500, "0.0025"},    {5000, "0.005"},    {10000, "0.01"},   {25000, "0.025"},
+    {50000, "0.05"},     {100000, "0.1"},    {250000, "0.25"},  {500000, "0.5"},
+    {1000000, "1"},      {2500000, "2.5"},   {5000000, "5"},    {10000000, "10"},
+};
+
+}  // namespace
+
+void PrometheusText::family(std::string_view name, std::string_view type, std::string_view help) {
+    text_.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    text_.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void PrometheusText::sample(std::string_view name, Labels labels, int64_t value) {
+    begin_sample(name, labels);
+    text_.append(std::to_string(value)).append("\n");
+}
+
+/**
+ * @brief Writes a sample with a fractional value.
+ * @details Nine significant digits keep microsecond resolution for durations of up to about
+ * 15 minutes, and more than enough for ratios and byte counts.
+ */
+void PrometheusText::sample(std::string_view name, Labels labels, double value) {
+    begin_sample(name, labels);
+    char buffer[32];
+    int written = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    text_.append(buffer, written > 0 ? static_cast<size_t>(written) : 0).append("\n");
+}
+
+void PrometheusText::histogram(std::string_view name, std::string_view label,
+                               std::string_view value,
+                               const LatencyHistogram::Snapshot &snapshot) {
+    const std::string bucket = std::string(name) + "_bucket";
+    for (const auto &bound : PROMETHEUS_BUCKET_BOUNDS) {
+        begin_sample(bucket, {{label, value}}, "le", bound.seconds);
+        text_.append(std::to_string(snapshot.count_at_or_below(bound.micros))).append("\n");
+    }
+    begin_sample(bucket, {{label, value}}, "le", "+Inf");
+    text_.append(std::to_string(snapshot.count)).append("\n");
+    sample(std::string(name) + "_sum", {{label, value}},
+           static_cast<double>(snapshot.sum_us) / 1e6);
+    sample(std::string(name) + "_count", {{label, value}}, static_cast<int64_t>(snapshot.count));
+}
+
+std::string PrometheusText::metric_name(std::string_view prefix, std::string_view description) {
+    std::string name(prefix);
+    bool pending_separator = false;
+    for (char c : description) {
+        bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (!alnum) {
+            pending_separator = true;
+            continue;
+        }
+        if (pending_separator && name.size() > prefix.size()) name += '_';
+        pending_separator = false;
+        name += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    return name;
+}
+
+void PrometheusText::begin_sample(std::string_view name, Labels labels,
+                                  std::string_view extra_name, std::string_view extra_value) {
+    text_.append(name);
+    if (labels.size() == 0 && extra_name.empty()) {
+        text_ += ' ';
+        return;
+    }
+    char separator = '{';
+    for (const auto &[label, value] : labels) {
+        text_.append(1, separator).append(label).append("=\"");
+        append_label_value(value);
+        text_ += '"';
+        separator = ',';
+    }
+    if (!extra_name.empty()) {
+        text_.append(1, separator).append(extra_name).append("=\"");
+        append_label_value(extra_value);
+        text_ += '"';
+    }
+    text_.append("} ");
+}
+
+void PrometheusText::append_label_value(std::string_view value) {
+    for (char c : value) {
+        if (c == '\\') {
+            text_ += "\\\\";
+        } else if (c == '"') {
+            text_ += "\\\"";
+        } else if (c == '\n') {
+            text_ += "\\n";
+        } else {
+            text_ += c;
+        }
+    }
+}
+
+}  // namespace aevum::util::metrics
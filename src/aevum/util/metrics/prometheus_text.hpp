@@ -0,0 +1,115 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file prometheus_text.hpp
+ * @brief Declares `PrometheusText`, a writer of the Prometheus text exposition format.
+ * @details The format (version 0.0.4) is a list of samples, one per line, each a metric name,
+ * optional labels in braces, and a value, preceded by `# HELP` and `# TYPE` lines for each metric
+ * family. It is what Prometheus and compatible scrapers read from a `/metrics` endpoint.
+ */
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "aevum/util/metrics/latency_histogram.hpp"
+
+namespace aevum::util::metrics {
+
+/**
+ * @class PrometheusText
+ * @brief Appends metric families and their samples to a text exposition.
+ *
+ * @details Every sample must follow the `family` call that declares its metric, and the samples
+ * of one family must be written together. Label values are escaped; metric and label names are
+ * written as given and must already be valid (see `metric_name`).
+ */
+class PrometheusText {
+  public:
+    /// The labels of a sample, as name and value pairs.
+    using Labels = std::initializer_list<std::pair<std::string_view, std::string_view>>;
+
+    /// The `Content-Type` of the exposition.
+    static constexpr std::string_view CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+    /**
+     * @brief Declares a metric family.
+     * @param name The name of the metric.
+     * @param type The metric type: `"counter"`, `"gauge"`, or `"histogram"`.
+     * @param help The description of the metric.
+     */
+    void family(std::string_view name, std::string_view type, std::string_view help);
+
+    /**
+     * @brief Writes an integer sample.
+     * @param name The name of the metric.
+     * @param labels The labels of the sample.
+     * @param value The value.
+     */
+    void sample(std::string_view name, Labels labels, int64_t value);
+
+    /**
+     * @brief Writes a sample with a fractional value.
+     * @param name The name of the metric.
+     * @param labels The labels of the sample.
+     * @param value The value.
+     */
+    void sample(std::string_view name, Labels labels, double value);
+
+    /**
+     * @brief Writes the samples of a latency histogram, in seconds.
+     * @details Writes the cumulative `_bucket` samples at fixed bounds from 100 µs to 10 s and
+     * `+Inf`, followed by `_sum` and `_count`. A bound that falls inside a bucket of the histogram
+     * counts only the buckets below it (see `LatencyHistogram::Snapshot::count_at_or_below`).
+     * @param name The name of the metric, declared as a `"histogram"` family.
+     * @param label The name of the label that tells the histograms of the family apart.
+     * @param value The value of that label.
+     * @param snapshot The snapshot of the histogram.
+     */
+    void histogram(std::string_view name, std::string_view label, std::string_view value,
+                   const LatencyHistogram::Snapshot &snapshot);
+
+    /**
+     * @brief Returns the exposition written so far.
+     * @return The text.
+     */
+    [[nodiscard]] const std::string &text() const noexcept { return text_; }
+
+    /**
+     * @brief Turns a free-form description into a valid metric name.
+     * @details ASCII letters are lowercased, digits are kept, and every run of other characters
+     * becomes one underscore; leading and trailing underscores are dropped.
+     * @param prefix The prefix of the name, such as `"aevum_wiredtiger_"`, written as is.
+     * @param description The description, such as `"cache: bytes read into cache"`.
+     * @return The name, e.g. `"aevum_wiredtiger_cache_bytes_read_into_cache"`.
+     */
+    [[nodiscard]] static std::string metric_name(std::string_view prefix,
+                                                 std::string_view description);
+
+  private:
+    /**
+     * @brief Writes the name and labels of a sample.
+     * @param name The name of the metric, including any suffix such as `_bucket`.
+     * @param labels The labels.
+     * @param extra_name The name of one more label after `labels`, or empty for none.
+     * @param extra_value The value of that label.
+     */
+    void begin_sample(std::string_view name, Labels labels, std::string_view extra_name = {},
+                      std::string_view extra_value = {});
+
+    /**
+     * @brief Appends a label value, escaping backslashes, double quotes, and line feeds.
+     * @param value The value.
+     */
+    void append_label_value(std::string_view value);
+
+    /// The exposition written so far.
+    std::string text_;
+};
+
+}  // namespace aevum::util::metrics
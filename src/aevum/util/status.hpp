@@ -42,7 +42,8 @@ enum class StatusCode : uint8_t {
     kIOError = 5,  ///< A low-level I/O error occurred (e.g., file system read/write error, network
                    ///< failure).
     kUnauthorized =
-        6  ///< The caller lacks the necessary permissions to perform the requested operation.
+        6,  ///< The caller lacks the necessary permissions to perform the requested operation.
+    kConflict = 7  ///< A concurrent change won a race; the operation may succeed if retried.
 };
 
 /**
@@ -99,6 +100,8 @@ class Status {
     static Status Unauthorized(std::string_view msg) {
         return Status(StatusCode::kUnauthorized, msg);
     }
+    /** @brief A static factory method for creating a `kConflict` status with a message. */
+    static Status Conflict(std::string_view msg) { return Status(StatusCode::kConflict, msg); }
 
     /** @brief Checks if the status represents a successful outcome. @return `true` if code is
      * `kOk`. */
@@ -137,6 +140,9 @@ class Status {
             case StatusCode::kUnauthorized:
                 result = "Unauthorized: ";
                 break;
+            case StatusCode::kConflict:
+                result = "Conflict: ";
+                break;
             default:
                 result = "Unknown Error: ";
                 break;
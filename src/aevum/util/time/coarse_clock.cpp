@@ -0,0 +1,193 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file coarse_clock.cpp
+ * @brief Implements the `CoarseClock` and its background ticker.
+ */
+#include "aevum/util/time/coarse_clock.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "aevum/util/concurrency/thread_name.hpp"
+#include "aevum/util/time/cycle_clock.hpp"
+#include "aevum/util/time/timestamp.hpp"
+
+namespace aevum::util::time {
+
+namespace {
+
+/// How often the ticker refreshes the cached readings.
+constexpr auto TICK_INTERVAL = std::chrono::milliseconds(1);
+
+/// The number of 64-bit words that hold a formatted timestamp.
+constexpr size_t ISO8601_WORDS = (ISO8601_LENGTH + 7) / 8;
+
+/**
+ * @brief Reads the steady clock directly.
+ * @return The milliseconds since the clock's epoch.
+ */
+int64_t read_steady_ms() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @class Ticker
+ * @brief The cached readings and the background thread that refreshes them.
+ * @details The rendering of the current second is published under a sequence lock: the ticker
+ * makes the sequence odd, rewrites the second and its characters, and makes it even again, and a
+ * reader keeps its copy only if it saw the same even sequence before and after. The characters
+ * are held in atomic words so that a copy racing with a rewrite is discarded rather than being a
+ * data race.
+ */
+class Ticker {
+  public:
+    ~Ticker() { stop(); }
+
+    [[nodiscard]] bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (running_.load(std::memory_order_relaxed)) return;
+        CycleClock::calibrate();
+        refresh();
+        stopping_ = false;
+        thread_ = std::thread([this] { run(); });
+        running_.store(true, std::memory_order_release);
+    }
+
+    void stop() noexcept {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (!running_.load(std::memory_order_relaxed)) return;
+        running_.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    [[nodiscard]] uint64_t unix_ms() const noexcept {
+        return unix_ms_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] int64_t steady_ms() const noexcept {
+        return steady_ms_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copies the rendering of a second, if it is the cached one.
+     * @param second The seconds since the UNIX epoch.
+     * @param out Receives the characters.
+     * @return `false` if another second is cached, or the rendering was being rewritten.
+     */
+    bool copy_second(uint64_t second, char (&out)[ISO8601_LENGTH]) const noexcept {
+        const uint32_t before = sequence_.load(std::memory_order_acquire);
+        if ((before & 1) != 0 || second_.load(std::memory_order_relaxed) != second) return false;
+        std::array<uint64_t, ISO8601_WORDS> words;
+        for (size_t i = 0; i < ISO8601_WORDS; ++i) {
+            words[i] = text_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(out, words.data(), ISO8601_LENGTH);
+        return true;
+    }
+
+  private:
+    /// Reads both clocks, and renders the second again if it changed.
+    void refresh() noexcept {
+        const uint64_t now_ms = aevum::util::time::now_unix_ms();
+        steady_ms_.store(read_steady_ms(), std::memory_order_relaxed);
+        unix_ms_.store(now_ms, std::memory_order_relaxed);
+        const uint64_t second = now_ms / 1000;
+        if (second_.load(std::memory_order_relaxed) == second) return;
+
+        std::array<uint64_t, ISO8601_WORDS> words{};
+        char text[ISO8601_LENGTH];
+        format_iso8601(now_ms, text);
+        std::memcpy(words.data(), text, ISO8601_LENGTH);
+        const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        second_.store(second, std::memory_order_relaxed);
+        for (size_t i = 0; i < ISO8601_WORDS; ++i) {
+            text_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    void run() {
+        aevum::util::concurrency::set_current_thread_name("CoarseClock");
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        while (!wake_.wait_for(lock, TICK_INTERVAL, [this] { return stopping_; })) refresh();
+    }
+
+    std::atomic<bool> running_{false};
+    /// The wall-clock time of the last refresh, in milliseconds since the UNIX epoch.
+    std::atomic<uint64_t> unix_ms_{0};
+    /// The steady time of the last refresh, in milliseconds.
+    std::atomic<int64_t> steady_ms_{0};
+    /// Odd while the rendering below is being rewritten.
+    std::atomic<uint32_t> sequence_{0};
+    /// The second whose rendering is cached, or `UINT64_MAX` before the first refresh.
+    std::atomic<uint64_t> second_{UINT64_MAX};
+    /// The rendering of `second_`, padded with zero bytes.
+    std::array<std::atomic<uint64_t>, ISO8601_WORDS> text_{};
+    /// Serializes `start` and `stop`.
+    std::mutex control_mutex_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::thread thread_;
+};
+
+/// The ticker; a static, so that it is stopped at program exit.
+Ticker g_ticker;
+
+}  // namespace
+
+/**
+ * @brief Starts the background ticker.
+ */
+void CoarseClock::start() { g_ticker.start(); }
+
+/**
+ * @brief Stops the background ticker.
+ */
+void CoarseClock::stop() noexcept { g_ticker.stop(); }
+
+/**
+ * @brief Returns the cached wall-clock time, or reads it if the ticker is not running.
+ */
+uint64_t CoarseClock::now_unix_ms() noexcept {
+    return g_ticker.running() ? g_ticker.unix_ms() : aevum::util::time::now_unix_ms();
+}
+
+/**
+ * @brief Returns the cached steady time, or reads it if the ticker is not running.
+ */
+int64_t CoarseClock::steady_ms() noexcept {
+    return g_ticker.running() ? g_ticker.steady_ms() : read_steady_ms();
+}
+
+/**
+ * @brief Appends a formatted wall-clock time, from the cached rendering when it matches.
+ */
+void CoarseClock::append_iso8601(uint64_t unix_ms, std::string &out) {
+    char text[ISO8601_LENGTH];
+    if (!g_ticker.copy_second(unix_ms / 1000, text)) format_iso8601(unix_ms, text);
+    out.append(text, ISO8601_LENGTH);
+}
+
+}  // namespace aevum::util::time
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file coarse_clock.hpp
+ * @brief Defines `CoarseClock`, a millisecond clock refreshed by a background thread, with a
+ * cached ISO 8601 rendering of the current second.
+ * @details Log entries, cursor and connection timeouts, and the TTL sweeper need the time to the
+ * millisecond at best, yet each of them read the system clock, and the logger formatted a full
+ * calendar date, for every use. While it runs, `CoarseClock` reads both clocks once per
+ * millisecond and formats the date once per second, so those paths read an atomic and copy 20
+ * characters instead.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace aevum::util::time {
+
+/**
+ * @class CoarseClock
+ * @brief A process-wide wall and steady clock with millisecond resolution.
+ *
+ * @details Until `start` is called, and after `stop`, every function reads the system clocks and
+ * formats directly, so the clock can be used by code that runs outside the daemon. While the
+ * ticker runs, readings lag the true time by at most about a millisecond. The class is
+ * thread-safe.
+ */
+class CoarseClock {
+  public:
+    CoarseClock() = delete;
+
+    /**
+     * @brief Starts the background ticker that refreshes the cached readings.
+     * @details Also calibrates the `CycleClock`, so that the first timed request does not pay for
+     * it. Has no effect if the ticker is already running.
+     */
+    static void start();
+
+    /**
+     * @brief Stops the background ticker; readings are taken directly again afterwards.
+     * @details The ticker is also stopped at program exit.
+     */
+    static void stop() noexcept;
+
+    /**
+     * @brief Returns the wall-clock time.
+     * @return The milliseconds since the UNIX epoch, as `now_unix_ms` returns them.
+     */
+    [[nodiscard]] static uint64_t now_unix_ms() noexcept;
+
+    /**
+     * @brief Returns the time of the steady clock.
+     * @return The milliseconds since the epoch of `std::chrono::steady_clock`.
+     */
+    [[nodiscard]] static int64_t steady_ms() noexcept;
+
+    /**
+     * @brief Appends a wall-clock time, formatted as `to_iso8601` formats it, to a string.
+     * @details A time within the current second is copied from the ticker's cached rendering;
+     * any other time is formatted with `format_iso8601`.
+     * @param unix_ms The milliseconds since the UNIX epoch.
+     * @param out The string to append to.
+     */
+    static void append_iso8601(uint64_t unix_ms, std::string &out);
+};
+
+}  // namespace aevum::util::time
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file cycle_clock.cpp
+ * @brief Implements the `CycleClock` and the calibration of the timestamp counter.
+ */
+#include "aevum/util/time/cycle_clock.hpp"
+
+#include <chrono>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace aevum::util::time {
+
+namespace {
+
+/// How long the timestamp counter is compared against the steady clock to measure its rate.
+constexpr auto CALIBRATION_INTERVAL = std::chrono::milliseconds(5);
+
+/**
+ * @struct Calibration
+ * @brief How readings of the `CycleClock` are taken and converted.
+ */
+struct Calibration {
+    /// `true` if readings are taken from the timestamp counter.
+    bool use_tsc{false};
+    /// The nanoseconds per tick.
+    double ns_per_tick{1.0};
+};
+
+/**
+ * @brief Reads the steady clock.
+ * @return The nanoseconds since the clock's epoch.
+ */
+uint64_t steady_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/**
+ * @brief Checks whether the CPU's timestamp counter ticks at a constant rate in every power
+ * state, which makes it usable as a clock.
+ * @return `true` if the counter is invariant.
+ */
+bool has_invariant_tsc() noexcept {
+#if defined(__x86_64__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Measures the rate of the timestamp counter against the steady clock.
+ * @return The calibration, or the steady clock's identity conversion if the counter is unusable.
+ */
+Calibration measure() noexcept {
+    Calibration calibration;
+#if defined(__x86_64__)
+    if (!has_invariant_tsc()) return calibration;
+    const uint64_t start_ns = steady_ns();
+    const uint64_t start_ticks = __rdtsc();
+    const uint64_t interval_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(CALIBRATION_INTERVAL).count();
+    uint64_t end_ns = start_ns;
+    while (end_ns - start_ns < interval_ns) end_ns = steady_ns();
+    const uint64_t ticks = __rdtsc() - start_ticks;
+    if (ticks == 0) return calibration;
+    calibration.use_tsc = true;
+    calibration.ns_per_tick = static_cast<double>(end_ns - start_ns) / static_cast<double>(ticks);
+#endif
+    return calibration;
+}
+
+/**
+ * @brief Returns the calibration, measuring it on first use.
+ * @return The calibration.
+ */
+const Calibration &calibration() noexcept {
+    static const Calibration measured = measure();
+    return measured;
+}
+
+}  // namespace
+
+/**
+ * @brief Reads the timestamp counter, or the steady clock if the counter is unusable.
+ */
+uint64_t CycleClock::now() noexcept {
+#if defined(__x86_64__)
+    if (calibration().use_tsc) return __rdtsc();
+#endif
+    return steady_ns();
+}
+
+/**
+ * @brief Converts ticks to nanoseconds at the measured rate.
+ */
+uint64_t CycleClock::to_ns(uint64_t ticks) noexcept {
+    const Calibration &measured = calibration();
+    if (!measured.use_tsc) return ticks;
+    return static_cast<uint64_t>(static_cast<double>(ticks) * measured.ns_per_tick);
+}
+
+/**
+ * @brief Measures the rate of the timestamp counter on the first call.
+ */
+void CycleClock::calibrate() noexcept { (void)calibration(); }
+
+}  // namespace aevum::util::time
@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file cycle_clock.hpp
+ * @brief Defines `CycleClock`, a monotonic clock read from the CPU's timestamp counter.
+ * @details Every request is timed several times over, by its latency histogram, its profile, and
+ * the FFI counters. Reading `std::chrono::steady_clock` costs a `clock_gettime` call each time,
+ * while the timestamp counter is one instruction. `CycleClock` reads the counter where it ticks
+ * at a constant rate on every core, and converts ticks to nanoseconds with a rate measured once.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace aevum::util::time {
+
+/**
+ * @class CycleClock
+ * @brief A monotonic clock for measuring short durations in CPU cycles.
+ *
+ * @details Readings are only meaningful relative to each other, and only within the process. On
+ * x86-64 CPUs with an invariant timestamp counter, a reading is the counter itself; elsewhere it
+ * is the steady clock in nanoseconds, and the conversion is the identity. The class is
+ * thread-safe.
+ */
+class CycleClock {
+  public:
+    CycleClock() = delete;
+
+    /**
+     * @brief Reads the clock.
+     * @return The current reading, in ticks.
+     */
+    [[nodiscard]] static uint64_t now() noexcept;
+
+    /**
+     * @brief Converts a number of ticks to nanoseconds.
+     * @param ticks The difference between two readings.
+     * @return The duration in nanoseconds.
+     */
+    [[nodiscard]] static uint64_t to_ns(uint64_t ticks) noexcept;
+
+    /**
+     * @brief Measures the rate of the timestamp counter, if it has not been measured yet.
+     * @details The measurement spins for a few milliseconds on its first call; calling this at
+     * startup keeps the first timed request from paying for it.
+     */
+    static void calibrate() noexcept;
+};
+
+}  // namespace aevum::util::time
@@ -11,6 +11,8 @@
  */
 #include "aevum/util/time/stopwatch.hpp"
 
+#include "aevum/util/time/cycle_clock.hpp"
+
 namespace aevum::util::time {
 
 /**
@@ -23,30 +25,29 @@ Stopwatch::Stopwatch() noexcept { start(); }
 /**
  * @brief Starts or resumes the stopwatch's measurement interval.
  * @details This method checks if the stopwatch is already running. If it is not, it captures the
- * current time point from the high-resolution clock, stores it as the new start time for the
- * interval, and sets the `running_` flag to `true`. This idempotency prevents accidental
- * resets of the start time during an active timing interval.
+ * current reading of the `CycleClock`, stores it as the start of the interval, and sets the
+ * `running_` flag to `true`. This idempotency prevents accidental resets of the start time
+ * during an active timing interval.
  */
 void Stopwatch::start() noexcept {
     if (!running_) {
-        start_time_ = Clock::now();
+        start_ticks_ = CycleClock::now();
         running_ = true;
     }
 }
 
 /**
  * @brief Stops or pauses the stopwatch's measurement interval.
- * @details If the stopwatch is in a running state, this method captures the current time point.
- * It then calculates the duration of the just-completed interval by subtracting `start_time_`
- * from the current time. This duration is cast to nanoseconds for consistent internal storage
+ * @details If the stopwatch is in a running state, this method reads the `CycleClock` again.
+ * It then calculates the duration of the just-completed interval by subtracting `start_ticks_`
+ * from the reading. This duration is converted to nanoseconds for consistent internal storage
  * and added to the `accumulated_duration_`. Finally, the `running_` flag is set to `false`.
  * If the stopwatch is already stopped, this method does nothing.
  */
 void Stopwatch::stop() noexcept {
     if (running_) {
-        auto end_time = Clock::now();
         accumulated_duration_ +=
-            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time_);
+            std::chrono::nanoseconds(CycleClock::to_ns(CycleClock::now() - start_ticks_));
         running_ = false;
     }
 }
@@ -73,9 +74,8 @@ void Stopwatch::reset() noexcept {
  */
 uint64_t Stopwatch::elapsed_ns() const noexcept {
     if (running_) {
-        auto current_time = Clock::now();
         auto current_duration =
-            std::chrono::duration_cast<std::chrono::nanoseconds>(current_time - start_time_);
+            std::chrono::nanoseconds(CycleClock::to_ns(CycleClock::now() - start_ticks_));
         return (accumulated_duration_ + current_duration).count();
     }
     return accumulated_duration_.count();
@@ -7,9 +7,9 @@
  * @brief Defines a high-resolution `Stopwatch` class for precision performance profiling and
  * timing.
  * @details This header file provides the declaration for the `Stopwatch` class, a versatile utility
- * for measuring elapsed time with high accuracy. It is built upon
- * `std::chrono::high_resolution_clock` and is designed for tasks such as benchmarking code
- * sections, measuring operation latencies, and general performance monitoring.
+ * for measuring elapsed time with high accuracy. It is built upon `CycleClock`, which reads the
+ * CPU's timestamp counter, and is designed for tasks such as benchmarking code sections,
+ * measuring operation latencies, and general performance monitoring.
  */
 #pragma once
 
@@ -30,12 +30,12 @@ namespace aevum::util::time {
  * @brief Implements a precision timer for accurately measuring elapsed time durations.
  *
  * @details This class provides a simple yet powerful interface for timing events and code
- * execution. It leverages `std::chrono::high_resolution_clock` to achieve the highest possible
- * timing precision available on the platform. The stopwatch can be started, stopped (which
- * effectively pauses the measurement), resumed, and reset. This allows for the accumulation of time
- * over multiple, non-contiguous intervals, making it flexible for a wide range of profiling
- * scenarios. The internal state correctly handles both running and paused states when reporting
- * elapsed time.
+ * execution. It reads `CycleClock`, which costs one instruction where the CPU has an invariant
+ * timestamp counter, so that timing every request adds no measurable overhead. The stopwatch
+ * can be started, stopped (which effectively pauses the measurement), resumed, and reset. This
+ * allows for the accumulation of time over multiple, non-contiguous intervals, making it
+ * flexible for a wide range of profiling scenarios. The internal state correctly handles both
+ * running and paused states when reporting elapsed time.
  */
 class Stopwatch {
   public:
@@ -48,7 +48,7 @@ class Stopwatch {
 
     /**
      * @brief Starts or resumes the stopwatch's time measurement.
-     * @details If the stopwatch is currently paused, this method records a new `start_time_`
+     * @details If the stopwatch is currently paused, this method records a new `start_ticks_`
      *          and marks the stopwatch as running. If the stopwatch is already running, this
      *          call has no effect, preventing the start time from being incorrectly reset.
      */
@@ -98,22 +98,10 @@ class Stopwatch {
 
   private:
     /**
-     * @typedef Clock
-     * @brief An alias for `std::chrono::high_resolution_clock`, the most precise clock available.
+     * @var start_ticks_
+     * @brief The `CycleClock` reading recorded when the stopwatch was last started or resumed.
      */
-    using Clock = std::chrono::high_resolution_clock;
-
-    /**
-     * @typedef TimePoint
-     * @brief An alias for a time point measured by the high-resolution `Clock`.
-     */
-    using TimePoint = std::chrono::time_point<Clock>;
-
-    /**
-     * @var start_time_
-     * @brief The time point recorded when the stopwatch was last started or resumed.
-     */
-    TimePoint start_time_;
+    uint64_t start_ticks_{0};
 
     /**
      * @var accumulated_duration_
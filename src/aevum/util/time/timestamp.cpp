@@ -12,8 +12,7 @@
 #include "aevum/util/time/timestamp.hpp"
 
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
 
 namespace aevum::util::time {
 
@@ -35,19 +34,54 @@ uint64_t now_unix_ms() noexcept {
 
 /**
  * @brief Retrieves the current system time and formats it as a UTC-based ISO 8601 string.
- * @details This function first obtains the current time from `std::chrono::system_clock`. It then
- * converts this high-resolution time point into a `std::time_t` value, which is a more traditional
- * calendar time representation. A critical step is the conversion of this `time_t` into a
- * broken-down time structure (`std::tm`) corresponding to UTC. This is handled using
- * platform-specific, thread-safe functions (`gmtime_s` on Windows, `gmtime_r` on POSIX systems) to
- * avoid the data races associated with the non-thread-safe `std::gmtime`. Finally, `std::put_time`
- * is used to format the `std::tm` struct into the standard "YYYY-MM-DDTHH:MM:SSZ" format.
+ * @details This function obtains the current time with `now_unix_ms` and formats it with
+ * `to_iso8601`, which avoids the data races of the non-thread-safe `std::gmtime`.
  *
  * @return A `std::string` containing the fully formatted, null-terminated UTC datetime string.
  */
-std::string now_iso8601() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t time_now_t = std::chrono::system_clock::to_time_t(now);
+std::string now_iso8601() { return to_iso8601(now_unix_ms()); }
+
+namespace {
+
+/**
+ * @brief Writes a number as a fixed count of decimal digits.
+ * @param value The number, which must have at most `digits` digits.
+ * @param digits The number of digits, padded with leading zeros.
+ * @param out The first character to write.
+ */
+void write_digits(int value, int digits, char *out) noexcept {
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Formats a UNIX epoch timestamp in milliseconds as a UTC-based ISO 8601 string.
+ * @details Delegates to `format_iso8601`.
+ * @param unix_ms The number of milliseconds since the UNIX epoch.
+ * @return A `std::string` containing the formatted UTC datetime.
+ */
+std::string to_iso8601(uint64_t unix_ms) {
+    char text[ISO8601_LENGTH];
+    format_iso8601(unix_ms, text);
+    return std::string(text, ISO8601_LENGTH);
+}
+
+/**
+ * @brief Formats a UNIX epoch timestamp in milliseconds as a UTC-based ISO 8601 string, into a
+ * caller's buffer.
+ * @details The timestamp is truncated to whole seconds and converted to a `std::time_t`, which
+ * is broken down into UTC calendar time with the platform's thread-safe conversion (`gmtime_s` on
+ * Windows, `gmtime_r` on POSIX systems). The fields are then written as digits directly, rather
+ * than through a stream and `std::put_time`, which allocate and consult the locale.
+ * @param unix_ms The number of milliseconds since the UNIX epoch.
+ * @param out Receives the timestamp.
+ */
+void format_iso8601(uint64_t unix_ms, char (&out)[ISO8601_LENGTH]) noexcept {
+    auto time_now_t = static_cast<std::time_t>(unix_ms / 1000);
 
     // Create a struct to hold the broken-down UTC time.
     std::tm tm_utc{};
@@ -63,10 +97,19 @@ std::string now_iso8601() {
     gmtime_r(&time_now_t, &tm_utc);
 #endif
 
-    // Use an `ostringstream` and `std::put_time` for robust and locale-independent formatting.
-    std::ostringstream ss;
-    ss << std::put_time(&tm_utc, "%Y-%m-%dT%H:%M:%SZ");
-    return ss.str();
+    // "YYYY-MM-DDTHH:MM:SSZ"
+    write_digits((tm_utc.tm_year + 1900) % 10000, 4, out);
+    out[4] = '-';
+    write_digits(tm_utc.tm_mon + 1, 2, out + 5);
+    out[7] = '-';
+    write_digits(tm_utc.tm_mday, 2, out + 8);
+    out[10] = 'T';
+    write_digits(tm_utc.tm_hour, 2, out + 11);
+    out[13] = ':';
+    write_digits(tm_utc.tm_min, 2, out + 14);
+    out[16] = ':';
+    write_digits(tm_utc.tm_sec, 2, out + 17);
+    out[19] = 'Z';
 }
 
 }  // namespace aevum::util::time
@@ -12,11 +12,15 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
 namespace aevum::util::time {
 
+/// The length of a timestamp formatted by `to_iso8601`, e.g. "2026-01-31T23:59:59Z".
+inline constexpr size_t ISO8601_LENGTH = 20;
+
 /**
  * @brief Retrieves the current system time as a UNIX epoch timestamp, measured in milliseconds.
  *
@@ -45,4 +49,27 @@ namespace aevum::util::time {
  */
 [[nodiscard]] std::string now_iso8601();
 
+/**
+ * @brief Formats a UNIX epoch timestamp in milliseconds as an ISO 8601 string in UTC.
+ *
+ * @details This produces the same "YYYY-MM-DDTHH:MM:SSZ" format as `now_iso8601`, for a time
+ * that was recorded earlier, such as the moment a deferred log record was created.
+ *
+ * @param unix_ms The number of milliseconds since the UNIX epoch, as from `now_unix_ms`.
+ * @return A `std::string` containing the formatted UTC datetime.
+ */
+[[nodiscard]] std::string to_iso8601(uint64_t unix_ms);
+
+/**
+ * @brief Formats a UNIX epoch timestamp in milliseconds as an ISO 8601 string in UTC, into a
+ * caller's buffer.
+ *
+ * @details This is the allocation-free form of `to_iso8601`, for callers that format many
+ * timestamps, such as the log sink and `CoarseClock`.
+ *
+ * @param unix_ms The number of milliseconds since the UNIX epoch.
+ * @param out Receives the `ISO8601_LENGTH` characters of the timestamp, not terminated.
+ */
+void format_iso8601(uint64_t unix_ms, char (&out)[ISO8601_LENGTH]) noexcept;
+
 }  // namespace aevum::util::time
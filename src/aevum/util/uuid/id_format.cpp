@@ -0,0 +1,34 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file id_format.cpp
+ * @brief Implements the dispatch from an `IdFormat` to its generator.
+ */
+#include "aevum/util/uuid/id_format.hpp"
+
+#include "aevum/util/uuid/object_id.hpp"
+#include "aevum/util/uuid/v4.hpp"
+#include "aevum/util/uuid/v7.hpp"
+
+namespace aevum::util::uuid {
+
+/**
+ * @brief Generates a new identifier in the given format.
+ * @param format The generator to use.
+ * @return The identifier.
+ */
+std::string generate(IdFormat format) {
+    switch (format) {
+        case IdFormat::UUID_V7:
+            return generate_v7();
+        case IdFormat::OBJECT_ID:
+            return generate_object_id();
+        case IdFormat::UUID_V4:
+        default:
+            return generate_v4();
+    }
+}
+
+}  // namespace aevum::util::uuid
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file id_format.hpp
+ * @brief Defines `IdFormat`, the choice of generator for the `_id` of new documents.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace aevum::util::uuid {
+
+/**
+ * @enum IdFormat
+ * @brief The generators a collection's missing `_id`s can be drawn from.
+ */
+enum class IdFormat {
+    /// Random Version 4 UUIDs, which spread inserts over the whole `_id` range.
+    UUID_V4,
+    /// Time-ordered Version 7 UUIDs, which append inserts at the end of the `_id` range.
+    UUID_V7,
+    /// 24-digit time-ordered ObjectId-style identifiers.
+    OBJECT_ID,
+};
+
+/**
+ * @brief Converts an `IdFormat` into its canonical string representation.
+ * @param format The format to convert.
+ * @return `"uuid4"`, `"uuid7"`, or `"objectid"`.
+ */
+[[nodiscard]] constexpr std::string_view to_string(IdFormat format) noexcept {
+    switch (format) {
+        case IdFormat::UUID_V7:
+            return "uuid7";
+        case IdFormat::OBJECT_ID:
+            return "objectid";
+        case IdFormat::UUID_V4:
+        default:
+            return "uuid4";
+    }
+}
+
+/**
+ * @brief Parses the canonical string representation of an `IdFormat`.
+ * @param name The string to parse (`"uuid4"`, `"uuid7"`, or `"objectid"`).
+ * @return The parsed format, or `std::nullopt` if `name` is not recognized.
+ */
+[[nodiscard]] constexpr std::optional<IdFormat> id_format_from_string(
+    std::string_view name) noexcept {
+    if (name == "uuid4") return IdFormat::UUID_V4;
+    if (name == "uuid7") return IdFormat::UUID_V7;
+    if (name == "objectid") return IdFormat::OBJECT_ID;
+    return std::nullopt;
+}
+
+/**
+ * @brief Generates a new identifier in the given format.
+ * @param format The generator to use.
+ * @return The identifier.
+ */
+[[nodiscard]] std::string generate(IdFormat format);
+
+}  // namespace aevum::util::uuid
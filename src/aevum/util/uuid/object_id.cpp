@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file object_id.cpp
+ * @brief Implements the generator of ObjectId-style identifiers.
+ */
+#include "aevum/util/uuid/object_id.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "aevum/util/uuid/random_engine.hpp"
+
+namespace aevum::util::uuid {
+
+/**
+ * @brief Generates a new ObjectId-style identifier.
+ * @details The timestamp occupies the first 8 digits, the thread's 40-bit random value the next
+ * 10, and the thread's 24-bit counter, which wraps around, the last 6.
+ * @return The identifier as 24 lowercase hexadecimal characters.
+ */
+std::string generate_object_id() {
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    thread_local const uint64_t thread_random = detail::next_uint64() >> 24;
+    thread_local uint32_t counter = static_cast<uint32_t>(detail::next_uint64());
+
+    uint64_t seconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    // timestamp (32) | thread random (32 of 40), then thread random (8 of 40) | counter (24).
+    uint64_t high = ((seconds & 0xFFFFFFFFULL) << 32) | (thread_random >> 8);
+    uint32_t low = ((static_cast<uint32_t>(thread_random) & 0xFF) << 24) |
+                   (++counter & 0xFFFFFF);
+
+    std::string id(24, '0');
+    for (int i = 15; i >= 0; --i, high >>= 4) id[i] = hex_digits[high & 0x0F];
+    for (int i = 23; i >= 16; --i, low >>= 4) id[i] = hex_digits[low & 0x0F];
+    return id;
+}
+
+}  // namespace aevum::util::uuid
@@ -0,0 +1,30 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file object_id.hpp
+ * @brief Declares the generator of 12-byte, time-ordered ObjectId-style identifiers.
+ */
+#pragma once
+
+#include <string>
+
+namespace aevum::util::uuid {
+
+/**
+ * @brief Generates a new ObjectId-style identifier, whose leading bytes are the current Unix time.
+ *
+ * @details The 12 bytes follow the layout of MongoDB's ObjectId: a 4-byte big-endian timestamp in
+ * seconds, a 5-byte random value, and a 3-byte big-endian counter. The random value and the
+ * counter's random start are drawn once per thread, so a thread increments its counter without
+ * synchronizing with other threads, and two threads never share the middle five bytes.
+ *
+ * The identifier is shorter than a UUID and, being fixed-width lowercase hexadecimal, sorts by
+ * its creation second.
+ *
+ * @return The identifier as 24 lowercase hexadecimal characters.
+ */
+[[nodiscard]] std::string generate_object_id();
+
+}  // namespace aevum::util::uuid
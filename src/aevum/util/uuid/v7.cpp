@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file v7.cpp
+ * @brief Implements the generator of Version 7 (time-ordered) UUIDs.
+ */
+#include "aevum/util/uuid/v7.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "aevum/util/uuid/random_engine.hpp"
+
+namespace aevum::util::uuid {
+
+namespace {
+
+/// The lowercase hexadecimal digits.
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+/// The largest value of the 12-bit `rand_a` counter.
+constexpr uint64_t COUNTER_MAX = 0xFFF;
+
+/**
+ * @brief Writes the hexadecimal digits of the low `4 * count` bits of a value.
+ * @param out The first character to write.
+ * @param value The value to format.
+ * @param count The number of digits to write, most significant first.
+ */
+void put_hex(char *out, uint64_t value, int count) noexcept {
+    for (int i = count - 1; i >= 0; --i) {
+        out[i] = HEX_DIGITS[value & 0x0F];
+        value >>= 4;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Generates a new Version 7 UUID.
+ * @details Each thread remembers the timestamp and counter of its last UUID. A later millisecond
+ * restarts the counter at a random value in `[0, 2047]`, which leaves at least 2048 increments
+ * before it overflows; the same or an earlier millisecond, as after a clock step, increments the
+ * counter instead, and an overflowing counter carries into the timestamp.
+ * @return The UUID in the canonical 36-character form.
+ */
+std::string generate_v7() {
+    thread_local uint64_t last_ms = 0;
+    thread_local uint64_t counter = 0;
+
+    uint64_t now_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    if (now_ms > last_ms) {
+        last_ms = now_ms;
+        counter = detail::next_uint64() >> 53;
+    } else if (++counter > COUNTER_MAX) {
+        ++last_ms;
+        counter = 0;
+    }
+
+    // unix_ts_ms (48) | ver (4) | rand_a (12), then var (2) | rand_b (62).
+    uint64_t high = (last_ms << 16) | 0x7000ULL | counter;
+    uint64_t low = (detail::next_uint64() & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+    std::string uuid(36, '-');
+    put_hex(&uuid[0], high >> 32, 8);
+    put_hex(&uuid[9], high >> 16, 4);
+    put_hex(&uuid[14], high, 4);
+    put_hex(&uuid[19], low >> 48, 4);
+    put_hex(&uuid[24], low, 12);
+    return uuid;
+}
+
+}  // namespace aevum::util::uuid
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file v7.hpp
+ * @brief Declares the generator of Version 7 (time-ordered) UUIDs.
+ */
+#pragma once
+
+#include <string>
+
+namespace aevum::util::uuid {
+
+/**
+ * @brief Generates a new Version 7 UUID, whose leading bits are the current Unix time.
+ *
+ * @details The UUID follows RFC 9562: a 48-bit millisecond timestamp, the version nibble `7`, a
+ * 12-bit counter in `rand_a`, the variant bits, and 62 random bits. The counter is kept per
+ * thread and starts at a random value below 2048 each millisecond, so the UUIDs one thread
+ * generates strictly increase, also when the clock steps back or more than 2048 are generated in
+ * a millisecond: the timestamp is then carried forward from the last UUID instead.
+ *
+ * Because the canonical form is fixed-width lowercase hexadecimal, the strings sort in the same
+ * order as the UUIDs, so documents keyed by them are appended to the right edge of a B-tree
+ * rather than scattered over it.
+ *
+ * @return The UUID in the canonical 36-character `xxxxxxxx-xxxx-7xxx-yxxx-xxxxxxxxxxxx` form.
+ */
+[[nodiscard]] std::string generate_v7();
+
+}  // namespace aevum::util::uuid
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file covered_projection_test.cpp
+ * @brief Checks that a query answered from the entries of an ordered index returns the `_id`s of
+ * an integer-keyed collection as integers.
+ * @details The index entries hold the primary keys, which for an integer-keyed collection are the
+ * decimal strings of the `_id`s; `Core::find_from_index` must turn them back into integers, as
+ * every path that reads the documents returns them.
+ */
+#include <bson/bson.h>
+#include <stdlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/db/core/core.hpp"
+
+namespace {
+
+/// The number of failed checks.
+int failures = 0;
+
+/**
+ * @brief Records a check, printing it if it failed.
+ * @param ok The outcome of the check.
+ * @param what The check.
+ */
+void check(bool ok, std::string_view what) {
+    if (ok) return;
+    ++failures;
+    std::cerr << "FAILED: " << what << std::endl;
+}
+
+/**
+ * @brief Checks that the only result of a query has the integer `_id` 42.
+ * @param docs The results.
+ * @return `true` if there is one result and its `_id` is the integer 42.
+ */
+bool has_integer_id(const std::vector<aevum::bson::doc::Document> &docs) {
+    bson_iter_t iter;
+    return docs.size() == 1 && bson_iter_init_find(&iter, docs[0].get(), "_id") &&
+           (BSON_ITER_HOLDS_INT32(&iter) || BSON_ITER_HOLDS_INT64(&iter)) &&
+           bson_iter_as_int64(&iter) == 42;
+}
+
+}  // namespace
+
+/**
+ * @brief Runs the checks in a temporary data directory.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    char pattern[] = "/tmp/aevum_covered_projection_XXXXXX";
+    const char *data_dir = mkdtemp(pattern);
+    if (data_dir == nullptr) {
+        std::cerr << "Cannot create a temporary directory." << std::endl;
+        return 1;
+    }
+
+    {
+        aevum::db::CoreOptions options;
+        options.storage.collection_key_formats["tickets"] = aevum::db::storage::KeyFormat::INT64;
+        aevum::db::Core core(data_dir, options);
+        check(core.create_index("tickets", "status", aevum::db::index::IndexType::ORDERED).ok(),
+              "create the ordered index on status");
+        aevum::bson::doc::Document doc;
+        check(aevum::bson::json::parse(R"({"_id":42,"status":"open","title":"x"})", doc).ok(),
+              "parse the document");
+        check(core.insert("tickets", std::move(doc)).first.ok(), "insert the document");
+
+        check(has_integer_id(core.find("tickets", R"({"status":"open"})")),
+              "a query reading the documents returns an integer _id");
+        check(has_integer_id(core.find("tickets", R"({"status":"open"})", "{}", R"({"status":1})")),
+              "a query answered from the index entries returns an integer _id");
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove_all(data_dir, ignored);
+    if (failures == 0) std::cout << "covered_projection_test: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file transaction_test.cpp
+ * @brief Checks that a transaction reads its own writes, loses a write-write race with a
+ * `kConflict` status, and refuses writes beyond its limits.
+ */
+#include <bson/bson.h>
+#include <stdlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/db/core/core.hpp"
+#include "aevum/db/core/transaction.hpp"
+
+namespace {
+
+/// The number of failed checks.
+int failures = 0;
+
+/**
+ * @brief Records a check, printing it if it failed.
+ * @param ok The outcome of the check.
+ * @param what The check.
+ */
+void check(bool ok, std::string_view what) {
+    if (ok) return;
+    ++failures;
+    std::cerr << "FAILED: " << what << std::endl;
+}
+
+/**
+ * @brief Parses a JSON document.
+ * @param json The document.
+ * @return The BSON document, empty if it does not parse.
+ */
+aevum::bson::doc::Document parse(std::string_view json) {
+    aevum::bson::doc::Document doc;
+    check(aevum::bson::json::parse(json, doc).ok(), "parse a test document");
+    return doc;
+}
+
+/**
+ * @brief Reads the `balance` of a single result.
+ * @param docs The results.
+ * @return The balance, or -1 unless there is exactly one result with a balance.
+ */
+int64_t balance_of(const std::vector<aevum::bson::doc::Document> &docs) {
+    bson_iter_t iter;
+    if (docs.size() != 1 || !bson_iter_init_find(&iter, docs[0].get(), "balance")) return -1;
+    return bson_iter_as_int64(&iter);
+}
+
+/**
+ * @brief Checks that a transaction sees its inserts and updates before commit, and no one else
+ * does.
+ * @param core The engine.
+ */
+void check_read_your_own_writes(aevum::db::Core &core) {
+    aevum::db::Transaction txn;
+    check(core.insert(txn, "accounts", parse(R"({"_id":"a","balance":10})")).first.ok(),
+          "stage an insert");
+    check(balance_of(core.find(txn, "accounts", R"({"_id":"a"})")) == 10,
+          "the transaction reads its staged insert");
+    check(core.find("accounts", R"({"_id":"a"})").empty(),
+          "the staged insert is invisible outside the transaction");
+
+    auto [status, modified] =
+        core.update(txn, "accounts", R"({"_id":"a"})", R"({"$inc":{"balance":5}})");
+    check(status.ok() && modified == 1, "stage an update of the staged insert");
+    check(balance_of(core.find(txn, "accounts", R"({"balance":15})")) == 15,
+          "the transaction matches its staged update");
+
+    check(core.commit(txn).ok(), "commit the transaction");
+    check(balance_of(core.find("accounts", R"({"_id":"a"})")) == 15,
+          "the committed writes are visible outside the transaction");
+}
+
+/**
+ * @brief Checks that of two transactions writing the same document, the second to commit fails
+ * with `kConflict` and applies nothing.
+ * @param core The engine.
+ */
+void check_write_conflict(aevum::db::Core &core) {
+    aevum::db::Transaction first;
+    aevum::db::Transaction second;
+    check(balance_of(core.find(first, "accounts", R"({"_id":"a"})")) == 15,
+          "the first transaction pins the document");
+    check(core.update(second, "accounts", R"({"_id":"a"})", R"({"$inc":{"balance":1}})").first.ok(),
+          "the second transaction stages an update");
+    check(core.commit(second).ok(), "the second transaction commits first");
+
+    check(balance_of(core.find(first, "accounts", R"({"_id":"a"})")) == 15,
+          "the first transaction still reads the version it pinned");
+    check(core.insert(first, "accounts", parse(R"({"_id":"b","balance":1})")).first.ok(),
+          "the first transaction stages an unrelated insert");
+    auto [status, modified] =
+        core.update(first, "accounts", R"({"_id":"a"})", R"({"$inc":{"balance":100}})");
+    check(status.ok() && modified == 1,
+          "the first transaction stages an update of the same document");
+    check(core.commit(first).code() == aevum::util::StatusCode::kConflict,
+          "the later commit fails with kConflict");
+
+    check(balance_of(core.find("accounts", R"({"_id":"a"})")) == 16,
+          "the conflicting update is not applied");
+    check(core.find("accounts", R"({"_id":"b"})").empty(),
+          "no write of the conflicting transaction is applied");
+}
+
+/**
+ * @brief Checks that a transaction refuses writes beyond `transaction_max_writes` and stays
+ * usable.
+ * @param core The engine, limited to two writes per transaction.
+ */
+void check_write_limit(aevum::db::Core &core) {
+    aevum::db::Transaction txn;
+    check(core.insert(txn, "limited", parse(R"({"_id":"1"})")).first.ok(), "stage a first write");
+    check(core.insert(txn, "limited", parse(R"({"_id":"2"})")).first.ok(), "stage a second write");
+    check(core.insert(txn, "limited", parse(R"({"_id":"3"})")).first.code() ==
+              aevum::util::StatusCode::kInvalidArgument,
+          "a third write exceeds the limit");
+    check(core.update(txn, "limited", R"({"_id":"1"})", R"({"$set":{"x":1}})").first.ok(),
+          "a document already written may be written again");
+    check(core.commit(txn).ok(), "commit the writes within the limit");
+    check(core.count("limited", "{}") == 2, "only the writes within the limit are applied");
+}
+
+}  // namespace
+
+/**
+ * @brief Runs the checks in a temporary data directory.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    char pattern[] = "/tmp/aevum_transaction_XXXXXX";
+    const char *data_dir = mkdtemp(pattern);
+    if (data_dir == nullptr) {
+        std::cerr << "Cannot create a temporary directory." << std::endl;
+        return 1;
+    }
+
+    {
+        aevum::db::CoreOptions options;
+        options.transaction_max_writes = 2;
+        aevum::db::Core core(data_dir, options);
+        check_read_your_own_writes(core);
+        check_write_conflict(core);
+        check_write_limit(core);
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove_all(data_dir, ignored);
+    if (failures == 0) std::cout << "transaction_test: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
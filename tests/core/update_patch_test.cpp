@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file update_patch_test.cpp
+ * @brief Checks that an in-place `$inc` is persisted, re-indexed, and leaves shared copies of the
+ * old document untouched.
+ * @details `UpdatePatcher` overwrites fixed-size values in a copy of the document. Copies share
+ * their buffer, so the copy must take a private one first; otherwise the primary index's document
+ * is modified in place, the patch comes out empty, and nothing reaches storage or the secondary
+ * indexes. The test updates a document through `Core`, reopens the data directory, and reads the
+ * value back.
+ */
+#include <bson/bson.h>
+#include <stdlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aevum/bson/json/parser.hpp"
+#include "aevum/db/core/core.hpp"
+
+namespace {
+
+/// The number of failed checks.
+int failures = 0;
+
+/**
+ * @brief Records a check, printing it if it failed.
+ * @param ok The outcome of the check.
+ * @param what The check.
+ */
+void check(bool ok, std::string_view what) {
+    if (ok) return;
+    ++failures;
+    std::cerr << "FAILED: " << what << std::endl;
+}
+
+/**
+ * @brief Reads an integer field of a document.
+ * @param doc The document.
+ * @param field The name of the field.
+ * @return The value, or -1 if the field is missing.
+ */
+int64_t integer_field(const aevum::bson::doc::Document &doc, const char *field) {
+    bson_iter_t iter;
+    if (!bson_iter_init_find(&iter, doc.get(), field)) return -1;
+    return bson_iter_as_int64(&iter);
+}
+
+/**
+ * @brief Returns the document of `_id` "a" of the test collection.
+ * @param core The engine.
+ * @param docs Receives the matches.
+ * @return `true` if exactly one document matched.
+ */
+bool find_a(aevum::db::Core &core, std::vector<aevum::bson::doc::Document> &docs) {
+    docs = core.find("counters", R"({"_id":"a"})");
+    return docs.size() == 1;
+}
+
+}  // namespace
+
+/**
+ * @brief Runs the checks in a temporary data directory.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    char pattern[] = "/tmp/aevum_update_patch_XXXXXX";
+    const char *data_dir = mkdtemp(pattern);
+    if (data_dir == nullptr) {
+        std::cerr << "Cannot create a temporary directory." << std::endl;
+        return 1;
+    }
+
+    {
+        aevum::db::Core core(data_dir);
+        check(core.create_index("counters", "n", aevum::db::index::IndexType::ORDERED).ok(),
+              "create the ordered index on n");
+        aevum::bson::doc::Document doc;
+        check(aevum::bson::json::parse(R"({"_id":"a","n":1,"tag":"x"})", doc).ok(),
+              "parse the document");
+        check(core.insert("counters", std::move(doc)).first.ok(), "insert the document");
+
+        std::vector<aevum::bson::doc::Document> held;
+        check(find_a(core, held), "find the document before the update");
+
+        auto [status, modified] = core.update("counters", R"({"_id":"a"})", R"({"$inc":{"n":5}})");
+        check(status.ok(), "run the $inc");
+        check(modified == 1, "the $inc reports one modified document");
+
+        check(!held.empty() && integer_field(held[0], "n") == 1,
+              "a copy taken before the update keeps the old value");
+        std::vector<aevum::bson::doc::Document> current;
+        check(find_a(core, current) && integer_field(current[0], "n") == 6,
+              "the updated value is read back");
+        check(core.count("counters", R"({"n":6})") == 1, "the ordered index holds the new value");
+        check(core.count("counters", R"({"n":1})") == 0, "the ordered index drops the old value");
+    }
+
+    {
+        aevum::db::Core core(data_dir);
+        std::vector<aevum::bson::doc::Document> reopened;
+        check(find_a(core, reopened) && integer_field(reopened[0], "n") == 6,
+              "the updated value is persisted across a restart");
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove_all(data_dir, ignored);
+    if (failures == 0) std::cout << "update_patch_test: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
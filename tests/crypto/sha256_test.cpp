@@ -0,0 +1,186 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file sha256_test.cpp
+ * @brief Checks SHA-256, HMAC-SHA-256, and PBKDF2-HMAC-SHA-256 against published known answers.
+ * @details The vectors are those of FIPS 180-4 (via the NIST examples), RFC 4231, and the
+ * PBKDF2-HMAC-SHA-256 variant of the RFC 6070 vectors. The incremental hash is also fed in
+ * uneven pieces, so that the buffering across block boundaries is exercised.
+ */
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "aevum/util/crypto/sha256.hpp"
+
+namespace {
+
+using aevum::util::crypto::Sha256Digest;
+
+/// The number of failed checks.
+int failures = 0;
+
+/**
+ * @brief Compares a result with its expected hexadecimal, printing it if it differs.
+ * @param bytes The result, as raw bytes.
+ * @param expected The expected result, in lowercase hexadecimal.
+ * @param what The vector.
+ */
+void check_hex(std::string_view bytes, std::string_view expected, std::string_view what) {
+    std::string actual = aevum::util::crypto::to_hex(bytes);
+    if (actual == expected) return;
+    ++failures;
+    std::cerr << "FAILED: " << what << "\n  expected " << expected << "\n  got      " << actual
+              << std::endl;
+}
+
+/**
+ * @brief Views a digest as raw bytes.
+ * @param digest The digest.
+ * @return The view.
+ */
+std::string_view bytes_of(const Sha256Digest &digest) {
+    return {reinterpret_cast<const char *>(digest.data()), digest.size()};
+}
+
+/**
+ * @brief Checks SHA-256 against the NIST examples, in one piece and in uneven pieces.
+ */
+void check_sha256() {
+    struct Vector {
+        std::string message;
+        std::string_view digest;
+    };
+    const Vector vectors[] = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+         "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+         "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+        {std::string(1000000, 'a'),
+         "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+    for (const Vector &vector : vectors) {
+        std::string what = "SHA-256 of " + std::to_string(vector.message.size()) + " bytes";
+        check_hex(bytes_of(aevum::util::crypto::sha256(vector.message)), vector.digest, what);
+
+        aevum::util::crypto::Sha256 hash;
+        std::string_view rest = vector.message;
+        for (size_t piece = 1; !rest.empty(); piece = piece * 3 % 97 + 1) {
+            size_t size = piece < rest.size() ? piece : rest.size();
+            hash.update(rest.substr(0, size));
+            rest.remove_prefix(size);
+        }
+        check_hex(bytes_of(hash.finalize()), vector.digest, what + ", fed in pieces");
+    }
+}
+
+/**
+ * @brief Checks HMAC-SHA-256 against the test cases of RFC 4231, except the truncated case 5.
+ */
+void check_hmac() {
+    struct Vector {
+        std::string key;
+        std::string message;
+        std::string_view mac;
+    };
+    std::string key_1_to_25;
+    for (char c = 1; c <= 25; ++c) key_1_to_25.push_back(c);
+    const Vector vectors[] = {
+        {std::string(20, '\x0b'), "Hi There",
+         "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+        {"Jefe", "what do ya want for nothing?",
+         "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"},
+        {std::string(20, '\xaa'), std::string(50, '\xdd'),
+         "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe"},
+        {key_1_to_25, std::string(50, '\xcd'),
+         "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b"},
+        {std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First",
+         "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"},
+        {std::string(131, '\xaa'),
+         "This is a test using a larger than block-size key and a larger than block-size data. "
+         "The key needs to be hashed before being used by the HMAC algorithm.",
+         "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2"},
+    };
+    int test_case = 0;
+    for (const Vector &vector : vectors) {
+        ++test_case;
+        check_hex(bytes_of(aevum::util::crypto::hmac_sha256(vector.key, vector.message)),
+                  vector.mac, "HMAC-SHA-256, RFC 4231 vector " + std::to_string(test_case));
+    }
+}
+
+/**
+ * @brief Checks PBKDF2-HMAC-SHA-256 against the SHA-256 variant of the RFC 6070 vectors.
+ */
+void check_pbkdf2() {
+    struct Vector {
+        std::string password;
+        std::string salt;
+        uint32_t iterations;
+        size_t length;
+        std::string_view key;
+    };
+    const Vector vectors[] = {
+        {"password", "salt", 1, 32,
+         "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b"},
+        {"password", "salt", 2, 32,
+         "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43"},
+        {"password", "salt", 4096, 32,
+         "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"},
+        {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 40,
+         "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c4e2a1fb8dd53e1c635518c7dac47e9"},
+        {std::string("pass\0word", 9), std::string("sa\0lt", 5), 4096, 16,
+         "89b69d0516f829893c696226650a8687"},
+    };
+    for (const Vector &vector : vectors) {
+        check_hex(aevum::util::crypto::pbkdf2_sha256(vector.password, vector.salt,
+                                                     vector.iterations, vector.length),
+                  vector.key,
+                  "PBKDF2-HMAC-SHA-256, " + std::to_string(vector.iterations) +
+                      " iteration(s), " + std::to_string(vector.length) + " bytes");
+    }
+}
+
+/**
+ * @brief Checks the hexadecimal codec and the constant-time comparison.
+ */
+void check_helpers() {
+    std::string decoded;
+    if (!aevum::util::crypto::from_hex("00ff7Fa0", decoded) ||
+        decoded != std::string("\x00\xff\x7f\xa0", 4)) {
+        ++failures;
+        std::cerr << "FAILED: from_hex of mixed-case digits" << std::endl;
+    }
+    if (aevum::util::crypto::from_hex("abc", decoded) ||
+        aevum::util::crypto::from_hex("zz", decoded)) {
+        ++failures;
+        std::cerr << "FAILED: from_hex refuses odd lengths and non-digits" << std::endl;
+    }
+    if (!aevum::util::crypto::constant_time_equal("key", "key") ||
+        aevum::util::crypto::constant_time_equal("key", "kez") ||
+        aevum::util::crypto::constant_time_equal("key", "keys")) {
+        ++failures;
+        std::cerr << "FAILED: constant_time_equal" << std::endl;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Runs the known-answer checks.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    check_sha256();
+    check_hmac();
+    check_pbkdf2();
+    check_helpers();
+    if (failures == 0) std::cout << "sha256_test: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
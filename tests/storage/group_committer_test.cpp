@@ -0,0 +1,113 @@
+// Copyright (c) 2026 Ananda Firmansyah.
+// Licensed under the AEVUMDB COMMUNITY LICENSE, Version 1.0. See LICENSE file in the root
+// directory.
+
+/**
+ * @file group_committer_test.cpp
+ * @brief Checks that the `GroupCommitter` shares journal flushes between concurrent writers and
+ * flushes for a lone writer once its window has passed.
+ * @details The committer runs on a journaled WiredTiger connection in a temporary directory. The
+ * window is long compared to the time it takes to start the writer threads, so the writers that
+ * arrive while the flusher lingers must share a flush.
+ */
+#include <stdlib.h>
+#include <wiredtiger.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "aevum/db/storage/group_commit.hpp"
+
+namespace {
+
+using aevum::db::storage::Durability;
+using aevum::db::storage::GroupCommitter;
+
+/// The number of failed checks.
+int failures = 0;
+
+/**
+ * @brief Records a check, printing it if it failed.
+ * @param ok The outcome of the check.
+ * @param what The check.
+ */
+void check(bool ok, std::string_view what) {
+    if (ok) return;
+    ++failures;
+    std::cerr << "FAILED: " << what << std::endl;
+}
+
+/**
+ * @brief Checks that writers waiting together are acknowledged by fewer flushes than writers.
+ * @param conn The journaled connection.
+ */
+void check_batching(WT_CONNECTION *conn) {
+    constexpr int kWriters = 8;
+    GroupCommitter committer(conn, std::chrono::milliseconds(200));
+    std::vector<int> ok(kWriters, 0);
+    std::vector<std::thread> writers;
+    for (int i = 0; i < kWriters; ++i) {
+        writers.emplace_back([&committer, &ok, i]() {
+            ok[i] = committer.wait(i % 2 == 0 ? Durability::JOURNAL : Durability::FSYNC).ok();
+        });
+    }
+    for (auto &writer : writers) writer.join();
+
+    int acknowledged = 0;
+    for (int result : ok) acknowledged += result;
+    check(acknowledged == kWriters, "every writer is acknowledged");
+    check(committer.flush_count() >= 1, "the writers were flushed");
+    check(committer.flush_count() < kWriters, "concurrent writers share flushes");
+}
+
+/**
+ * @brief Checks that a lone writer is flushed once the window passes, without waiting for more.
+ * @param conn The journaled connection.
+ */
+void check_flush_on_timeout(WT_CONNECTION *conn) {
+    const auto window = std::chrono::milliseconds(50);
+    GroupCommitter committer(conn, window);
+    check(committer.wait(Durability::NONE).ok(), "NONE returns at once");
+    check(committer.flush_count() == 0, "NONE issues no flush");
+
+    const auto start = std::chrono::steady_clock::now();
+    check(committer.wait(Durability::FSYNC).ok(), "a lone writer is acknowledged");
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    check(committer.flush_count() == 1, "a lone writer is flushed once");
+    check(elapsed >= window, "the flusher lingers for the window");
+    check(elapsed < std::chrono::seconds(5), "the flusher does not wait past the window");
+}
+
+}  // namespace
+
+/**
+ * @brief Runs the checks on a journaled connection in a temporary directory.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    char pattern[] = "/tmp/aevum_group_commit_XXXXXX";
+    const char *data_dir = mkdtemp(pattern);
+    if (data_dir == nullptr) {
+        std::cerr << "Cannot create a temporary directory." << std::endl;
+        return 1;
+    }
+
+    WT_CONNECTION *conn = nullptr;
+    int ret = wiredtiger_open(data_dir, nullptr, "create,log=(enabled=true)", &conn);
+    if (ret != 0) {
+        std::cerr << "Cannot open WiredTiger: " << wiredtiger_strerror(ret) << std::endl;
+        return 1;
+    }
+    check_batching(conn);
+    check_flush_on_timeout(conn);
+    conn->close(conn, nullptr);
+
+    std::error_code ignored;
+    std::filesystem::remove_all(data_dir, ignored);
+    if (failures == 0) std::cout << "group_committer_test: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}